@@ -112,3 +112,31 @@ bool ArchDirect::valid_direct_id(const ArchDirectId& direct_id) const {
   return (size_t(direct_id) < direct_ids_.size()) &&
          (direct_id == direct_ids_[direct_id]);
 }
+
+/************************************************************************
+ * Public binary image writer/reader
+ ***********************************************************************/
+/* Write all the internal data to a binary image, in the order of
+ * declaration */
+void ArchDirect::write_to_binary_image(
+  openfpga::BinaryImageWriter& writer) const {
+  using openfpga::write_binary_image;
+  write_binary_image(writer, direct_ids_);
+  write_binary_image(writer, names_);
+  write_binary_image(writer, circuit_models_);
+  write_binary_image(writer, types_);
+  write_binary_image(writer, directions_);
+  write_binary_image(writer, direct_name2ids_);
+}
+
+/* Replace all the internal data with the data of a binary image, which is
+ * written by write_to_binary_image() */
+void ArchDirect::read_from_binary_image(openfpga::BinaryImageReader& reader) {
+  using openfpga::read_binary_image;
+  read_binary_image(reader, direct_ids_);
+  read_binary_image(reader, names_);
+  read_binary_image(reader, circuit_models_);
+  read_binary_image(reader, types_);
+  read_binary_image(reader, directions_);
+  read_binary_image(reader, direct_name2ids_);
+}
@@ -6,6 +6,7 @@
 
 #include "arch_direct_fwd.h"
 #include "circuit_library_fwd.h"
+#include "openfpga_binary_image.h"
 #include "vtr_geometry.h"
 #include "vtr_vector.h"
 
@@ -78,6 +79,12 @@ class ArchDirect {
  public: /* Public invalidators/validators */
   bool valid_direct_id(const ArchDirectId& direct_id) const;
 
+ public: /* Public binary image writer/reader */
+  /* Write all the internal data to a binary image */
+  void write_to_binary_image(openfpga::BinaryImageWriter& writer) const;
+  /* Replace all the internal data with the data of a binary image */
+  void read_from_binary_image(openfpga::BinaryImageReader& reader);
+
  private: /* Internal data */
   vtr::vector<ArchDirectId, ArchDirectId> direct_ids_;
 
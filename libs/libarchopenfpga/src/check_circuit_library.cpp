@@ -9,6 +9,11 @@
 /* Headers from vtrutil library */
 #include "check_circuit_library.h"
 
+#include <numeric>
+#include <string>
+#include <unordered_map>
+
+#include "openfpga_parallel.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -16,67 +21,59 @@
 /************************************************************************
  * Circuit models have unique names, return the number of errors
  *  If not found, we give an error
+ * Each circuit model is compared to the first circuit model with the
+ * same name, which is found in a hash table in a single pass
  ***********************************************************************/
 static size_t check_circuit_library_unique_names(
   const CircuitLibrary& circuit_lib) {
   size_t num_err = 0;
 
-  for (size_t i = 0; i < circuit_lib.num_models(); ++i) {
-    /* Skip for the last element, because the inner loop will access it */
-    if (i == circuit_lib.num_models() - 1) {
+  std::unordered_map<std::string, size_t> first_models;
+  first_models.reserve(circuit_lib.num_models());
+  for (size_t j = 0; j < circuit_lib.num_models(); ++j) {
+    const std::string& j_name = circuit_lib.model_name(CircuitModelId(j));
+    auto result = first_models.emplace(j_name, j);
+    /* Skip for a new name */
+    if (true == result.second) {
       continue;
     }
-    /* Get the name of reference */
-    const std::string& i_name = circuit_lib.model_name(CircuitModelId(i));
-    for (size_t j = i + 1; j < circuit_lib.num_models(); ++j) {
-      /* Compare the name of candidate */
-      const std::string& j_name = circuit_lib.model_name(CircuitModelId(j));
-      /* Compare the name and skip for different names */
-      if (0 != i_name.compare(j_name)) {
-        continue;
-      }
-      VTR_LOG_ERROR(
-        "Circuit model(index=%d) and (index=%d) share the same name, which is "
-        "invalid!\n",
-        i, j, i_name.c_str());
-      /* Incremental the counter for errors */
-      num_err++;
-    }
+    VTR_LOG_ERROR(
+      "Circuit model(index=%lu) and (index=%lu) share the same name '%s', "
+      "which is invalid!\n",
+      result.first->second, j, j_name.c_str());
+    /* Incremental the counter for errors */
+    num_err++;
   }
 
   return num_err;
 }
 
 /************************************************************************
- * Circuit models have unique names, return the number of errors
+ * Circuit models have unique prefix, return the number of errors
  *  If not found, we give an error
+ * Each circuit model is compared to the first circuit model with the
+ * same prefix, which is found in a hash table in a single pass
  ***********************************************************************/
 static size_t check_circuit_library_unique_prefix(
   const CircuitLibrary& circuit_lib) {
   size_t num_err = 0;
 
-  for (size_t i = 0; i < circuit_lib.num_models(); ++i) {
-    /* Skip for the last element, because the inner loop will access it */
-    if (i == circuit_lib.num_models() - 1) {
+  std::unordered_map<std::string, size_t> first_models;
+  first_models.reserve(circuit_lib.num_models());
+  for (size_t j = 0; j < circuit_lib.num_models(); ++j) {
+    const std::string& j_prefix = circuit_lib.model_prefix(CircuitModelId(j));
+    auto result = first_models.emplace(j_prefix, j);
+    /* Skip for a new prefix */
+    if (true == result.second) {
       continue;
     }
-    /* Get the name of reference */
-    const std::string& i_prefix = circuit_lib.model_prefix(CircuitModelId(i));
-    for (size_t j = i + 1; j < circuit_lib.num_models(); ++j) {
-      /* Compare the name of candidate */
-      const std::string& j_prefix = circuit_lib.model_prefix(CircuitModelId(j));
-      /* Compare the name and skip for different prefix */
-      if (0 != i_prefix.compare(j_prefix)) {
-        continue;
-      }
-      VTR_LOG_ERROR(
-        "Circuit model(name=%s) and (name=%s) share the same prefix, which is "
-        "invalid!\n",
-        circuit_lib.model_name(CircuitModelId(i)).c_str(),
-        circuit_lib.model_name(CircuitModelId(j)).c_str(), i_prefix.c_str());
-      /* Incremental the counter for errors */
-      num_err++;
-    }
+    VTR_LOG_ERROR(
+      "Circuit model(name=%s) and (name=%s) share the same prefix '%s', which "
+      "is invalid!\n",
+      circuit_lib.model_name(CircuitModelId(result.first->second)).c_str(),
+      circuit_lib.model_name(CircuitModelId(j)).c_str(), j_prefix.c_str());
+    /* Incremental the counter for errors */
+    num_err++;
   }
 
   return num_err;
@@ -181,25 +178,6 @@ size_t check_one_circuit_model_port_type_and_size_required(
   return num_err;
 }
 
-/************************************************************************
- * A generic function to check the port list of circuit models in a given type
- *  If not found, we give an error
- ***********************************************************************/
-static size_t check_circuit_model_port_required(
-  const CircuitLibrary& circuit_lib,
-  const enum e_circuit_model_type& circuit_model_type_to_check,
-  const std::vector<enum e_circuit_model_port_type>& port_types_to_check) {
-  size_t num_err = 0;
-
-  for (const auto& id :
-       circuit_lib.models_by_type(circuit_model_type_to_check)) {
-    num_err += check_one_circuit_model_port_required(circuit_lib, id,
-                                                     port_types_to_check);
-  }
-
-  return num_err;
-}
-
 /************************************************************************
  *  A generic function to search each default circuit model by types
  *  that have been defined by users.
@@ -558,73 +536,76 @@ static size_t check_circuit_library_ports(const CircuitLibrary& circuit_lib) {
     global_ports.push_back(port);
   }
 
-  for (size_t iport = 0; iport < global_ports.size() - 1; ++iport) {
-    for (size_t jport = iport + 1; jport < global_ports.size(); ++jport) {
-      /* Bypass those do not share the same name */
-      if (0 != circuit_lib.port_prefix(global_ports[iport])
-                 .compare(circuit_lib.port_prefix(global_ports[jport]))) {
-        continue;
-      }
+  /* Each global port is compared to the first global port with the same
+   * name, which is found in a hash table in a single pass */
+  std::unordered_map<std::string, size_t> first_global_ports;
+  for (size_t jport = 0; jport < global_ports.size(); ++jport) {
+    auto result = first_global_ports.emplace(
+      circuit_lib.port_prefix(global_ports[jport]), jport);
+    /* Bypass the first port of each name */
+    if (true == result.second) {
+      continue;
+    }
+    size_t iport = result.first->second;
 
-      /* Check if a same port share the same attributes */
-      CircuitModelId iport_parent_model =
-        circuit_lib.port_parent_model(global_ports[iport]);
-      CircuitModelId jport_parent_model =
-        circuit_lib.port_parent_model(global_ports[jport]);
-
-      if (circuit_lib.port_default_value(global_ports[iport]) !=
-          circuit_lib.port_default_value(global_ports[jport])) {
-        VTR_LOG_ERROR(
-          "Global ports %s from circuit model %s and %s share the same name "
-          "but have different dfefault values(%lu and %lu)!\n",
-          circuit_lib.port_prefix(global_ports[iport]).c_str(),
-          circuit_lib.model_name(iport_parent_model).c_str(),
-          circuit_lib.model_name(jport_parent_model).c_str(),
-          circuit_lib.port_default_value(global_ports[iport]),
-          circuit_lib.port_default_value(global_ports[jport]));
-        num_err++;
-      }
+    /* Check if a same port share the same attributes */
+    CircuitModelId iport_parent_model =
+      circuit_lib.port_parent_model(global_ports[iport]);
+    CircuitModelId jport_parent_model =
+      circuit_lib.port_parent_model(global_ports[jport]);
 
-      if (circuit_lib.port_is_reset(global_ports[iport]) !=
-          circuit_lib.port_is_reset(global_ports[jport])) {
-        VTR_LOG_ERROR(
-          "Global ports %s from circuit model %s and %s share the same name "
-          "but have different is_reset attributes!\n",
-          circuit_lib.port_prefix(global_ports[iport]).c_str(),
-          circuit_lib.model_name(iport_parent_model).c_str(),
-          circuit_lib.model_name(jport_parent_model).c_str());
-        num_err++;
-      }
-      if (circuit_lib.port_is_set(global_ports[iport]) !=
-          circuit_lib.port_is_set(global_ports[jport])) {
-        VTR_LOG_ERROR(
-          "Global ports %s from circuit model %s and %s share the same name "
-          "but have different is_set attributes!\n",
-          circuit_lib.port_prefix(global_ports[iport]).c_str(),
-          circuit_lib.model_name(iport_parent_model).c_str(),
-          circuit_lib.model_name(jport_parent_model).c_str());
-        num_err++;
-      }
-      if (circuit_lib.port_is_config_enable(global_ports[iport]) !=
-          circuit_lib.port_is_config_enable(global_ports[jport])) {
-        VTR_LOG_ERROR(
-          "Global ports %s from circuit model %s and %s share the same name "
-          "but have different is_config_enable attributes!\n",
-          circuit_lib.port_prefix(global_ports[iport]).c_str(),
-          circuit_lib.model_name(iport_parent_model).c_str(),
-          circuit_lib.model_name(jport_parent_model).c_str());
-        num_err++;
-      }
-      if (circuit_lib.port_is_prog(global_ports[iport]) !=
-          circuit_lib.port_is_prog(global_ports[jport])) {
-        VTR_LOG_ERROR(
-          "Global ports %s from circuit model %s and %s share the same name "
-          "but have different is_prog attributes!\n",
-          circuit_lib.port_prefix(global_ports[iport]).c_str(),
-          circuit_lib.model_name(iport_parent_model).c_str(),
-          circuit_lib.model_name(jport_parent_model).c_str());
-        num_err++;
-      }
+    if (circuit_lib.port_default_value(global_ports[iport]) !=
+        circuit_lib.port_default_value(global_ports[jport])) {
+      VTR_LOG_ERROR(
+        "Global ports %s from circuit model %s and %s share the same name "
+        "but have different dfefault values(%lu and %lu)!\n",
+        circuit_lib.port_prefix(global_ports[iport]).c_str(),
+        circuit_lib.model_name(iport_parent_model).c_str(),
+        circuit_lib.model_name(jport_parent_model).c_str(),
+        circuit_lib.port_default_value(global_ports[iport]),
+        circuit_lib.port_default_value(global_ports[jport]));
+      num_err++;
+    }
+
+    if (circuit_lib.port_is_reset(global_ports[iport]) !=
+        circuit_lib.port_is_reset(global_ports[jport])) {
+      VTR_LOG_ERROR(
+        "Global ports %s from circuit model %s and %s share the same name "
+        "but have different is_reset attributes!\n",
+        circuit_lib.port_prefix(global_ports[iport]).c_str(),
+        circuit_lib.model_name(iport_parent_model).c_str(),
+        circuit_lib.model_name(jport_parent_model).c_str());
+      num_err++;
+    }
+    if (circuit_lib.port_is_set(global_ports[iport]) !=
+        circuit_lib.port_is_set(global_ports[jport])) {
+      VTR_LOG_ERROR(
+        "Global ports %s from circuit model %s and %s share the same name "
+        "but have different is_set attributes!\n",
+        circuit_lib.port_prefix(global_ports[iport]).c_str(),
+        circuit_lib.model_name(iport_parent_model).c_str(),
+        circuit_lib.model_name(jport_parent_model).c_str());
+      num_err++;
+    }
+    if (circuit_lib.port_is_config_enable(global_ports[iport]) !=
+        circuit_lib.port_is_config_enable(global_ports[jport])) {
+      VTR_LOG_ERROR(
+        "Global ports %s from circuit model %s and %s share the same name "
+        "but have different is_config_enable attributes!\n",
+        circuit_lib.port_prefix(global_ports[iport]).c_str(),
+        circuit_lib.model_name(iport_parent_model).c_str(),
+        circuit_lib.model_name(jport_parent_model).c_str());
+      num_err++;
+    }
+    if (circuit_lib.port_is_prog(global_ports[iport]) !=
+        circuit_lib.port_is_prog(global_ports[jport])) {
+      VTR_LOG_ERROR(
+        "Global ports %s from circuit model %s and %s share the same name "
+        "but have different is_prog attributes!\n",
+        circuit_lib.port_prefix(global_ports[iport]).c_str(),
+        circuit_lib.model_name(iport_parent_model).c_str(),
+        circuit_lib.model_name(jport_parent_model).c_str());
+      num_err++;
     }
   }
 
@@ -710,28 +691,16 @@ static int check_power_gated_circuit_model(
 }
 
 /************************************************************************
- * Check the port requirements for each power-gated circuit model
- ***********************************************************************/
-static int check_power_gated_circuit_models(const CircuitLibrary& circuit_lib) {
-  int num_err = 0;
-
-  for (const CircuitModelId& circuit_model : circuit_lib.models()) {
-    if (true == circuit_lib.is_power_gated(circuit_model)) {
-      num_err += check_power_gated_circuit_model(circuit_lib, circuit_model);
-    }
-  }
-
-  return num_err;
-}
-
-/************************************************************************
- * Check io has been defined and has input and output ports
+ * Check an io circuit model has input and output ports
  * - We must have global I/O port, either its type is inout, input or output
- * - For each IOPAD, we must have at least an input an output
+ * - We must have at least an input an output
  ***********************************************************************/
-static size_t check_io_circuit_model(const CircuitLibrary& circuit_lib) {
+static size_t check_one_io_circuit_model(const CircuitLibrary& circuit_lib,
+                                         const CircuitModelId& io_model) {
   size_t num_err = 0;
 
+  VTR_ASSERT(CIRCUIT_MODEL_IOPAD == circuit_lib.model_type(io_model));
+
   /* Each I/O cell must have
    *  - One of the following ports
    *    - At least 1 ASIC-to-FPGA (A2F) port that is defined as global data I/O
@@ -739,64 +708,115 @@ static size_t check_io_circuit_model(const CircuitLibrary& circuit_lib) {
    *  - At least 1 regular port that is non-global which is connected to global
    * routing architecture
    */
-  for (const auto& io_model : circuit_lib.models_by_type(CIRCUIT_MODEL_IOPAD)) {
-    bool has_data_io = false;
-    bool has_data_input_only_io = false;
-    bool has_data_output_only_io = false;
-    bool has_internal_connection = false;
-
-    for (const auto& port : circuit_lib.model_ports(io_model)) {
-      if ((true == circuit_lib.port_is_io(port)) &&
-          (true == circuit_lib.port_is_data_io(port)) &&
-          (CIRCUIT_MODEL_PORT_INOUT == circuit_lib.port_type(port)) &&
-          (true == circuit_lib.port_is_global(port))) {
-        has_data_io = true;
-        continue; /* Go to next */
-      }
-      if ((true == circuit_lib.port_is_io(port)) &&
-          (true == circuit_lib.port_is_data_io(port)) &&
-          (CIRCUIT_MODEL_PORT_INPUT == circuit_lib.port_type(port)) &&
-          (true == circuit_lib.port_is_global(port))) {
-        has_data_input_only_io = true;
-        continue; /* Go to next */
-      }
-      if ((true == circuit_lib.port_is_io(port)) &&
-          (true == circuit_lib.port_is_data_io(port)) &&
-          (CIRCUIT_MODEL_PORT_OUTPUT == circuit_lib.port_type(port)) &&
-          (true == circuit_lib.port_is_global(port))) {
-        has_data_output_only_io = true;
-        continue; /* Go to next */
-      }
-
-      if ((false == circuit_lib.port_is_io(port) &&
-           (false == circuit_lib.port_is_global(port))) &&
-          (CIRCUIT_MODEL_PORT_SRAM != circuit_lib.port_type(port))) {
-        has_internal_connection = true;
-        continue; /* Go to next */
-      }
+  bool has_data_io = false;
+  bool has_data_input_only_io = false;
+  bool has_data_output_only_io = false;
+  bool has_internal_connection = false;
+
+  for (const auto& port : circuit_lib.model_ports(io_model)) {
+    if ((true == circuit_lib.port_is_io(port)) &&
+        (true == circuit_lib.port_is_data_io(port)) &&
+        (CIRCUIT_MODEL_PORT_INOUT == circuit_lib.port_type(port)) &&
+        (true == circuit_lib.port_is_global(port))) {
+      has_data_io = true;
+      continue; /* Go to next */
     }
-
-    /* Error out when
-     *   - there is no data io, data input-only io and data output-only io
-     */
-    if ((false == has_data_io) && (false == has_data_input_only_io) &&
-        (false == has_data_output_only_io)) {
-      VTR_LOGF_ERROR(
-        __FILE__, __LINE__,
-        "I/O circuit model '%s' does not have any data I/O port defined!\n",
-        circuit_lib.model_name(io_model).c_str());
-      num_err++;
+    if ((true == circuit_lib.port_is_io(port)) &&
+        (true == circuit_lib.port_is_data_io(port)) &&
+        (CIRCUIT_MODEL_PORT_INPUT == circuit_lib.port_type(port)) &&
+        (true == circuit_lib.port_is_global(port))) {
+      has_data_input_only_io = true;
+      continue; /* Go to next */
+    }
+    if ((true == circuit_lib.port_is_io(port)) &&
+        (true == circuit_lib.port_is_data_io(port)) &&
+        (CIRCUIT_MODEL_PORT_OUTPUT == circuit_lib.port_type(port)) &&
+        (true == circuit_lib.port_is_global(port))) {
+      has_data_output_only_io = true;
+      continue; /* Go to next */
     }
 
-    if (false == has_internal_connection) {
-      VTR_LOGF_ERROR(__FILE__, __LINE__,
-                     "I/O circuit model '%s' does not have any port connected "
-                     "to FPGA core!\n",
-                     circuit_lib.model_name(io_model).c_str());
-      num_err++;
+    if ((false == circuit_lib.port_is_io(port) &&
+         (false == circuit_lib.port_is_global(port))) &&
+        (CIRCUIT_MODEL_PORT_SRAM != circuit_lib.port_type(port))) {
+      has_internal_connection = true;
+      continue; /* Go to next */
     }
   }
 
+  /* Error out when
+   *   - there is no data io, data input-only io and data output-only io
+   */
+  if ((false == has_data_io) && (false == has_data_input_only_io) &&
+      (false == has_data_output_only_io)) {
+    VTR_LOGF_ERROR(
+      __FILE__, __LINE__,
+      "I/O circuit model '%s' does not have any data I/O port defined!\n",
+      circuit_lib.model_name(io_model).c_str());
+    num_err++;
+  }
+
+  if (false == has_internal_connection) {
+    VTR_LOGF_ERROR(__FILE__, __LINE__,
+                   "I/O circuit model '%s' does not have any port connected "
+                   "to FPGA core!\n",
+                   circuit_lib.model_name(io_model).c_str());
+    num_err++;
+  }
+
+  return num_err;
+}
+
+/************************************************************************
+ * Check the ports of a circuit model as required by its type, and the
+ * ports for power gating if the circuit model is power-gated
+ * - MUX must have at least an input, an output and a SRAM ports
+ * - SRAM must have at least an output port
+ * - CCFF and FF must have at least a clock, an input and an output ports
+ * - LUT must have at least an input, an output and a SRAM ports
+ * - IOPAD must have data I/O ports and ports connected to FPGA core
+ * A circuit model is checked without looking at other circuit models,
+ * so that circuit models can be checked in parallel
+ ***********************************************************************/
+static size_t check_one_circuit_model(const CircuitLibrary& circuit_lib,
+                                      const CircuitModelId& circuit_model) {
+  size_t num_err = 0;
+
+  switch (circuit_lib.model_type(circuit_model)) {
+    case CIRCUIT_MODEL_MUX:
+      num_err += check_one_circuit_model_port_required(
+        circuit_lib, circuit_model,
+        {CIRCUIT_MODEL_PORT_INPUT, CIRCUIT_MODEL_PORT_OUTPUT,
+         CIRCUIT_MODEL_PORT_SRAM});
+      break;
+    case CIRCUIT_MODEL_SRAM:
+      num_err += check_one_circuit_model_port_required(
+        circuit_lib, circuit_model, {CIRCUIT_MODEL_PORT_OUTPUT});
+      break;
+    case CIRCUIT_MODEL_CCFF:
+    case CIRCUIT_MODEL_FF:
+      num_err += check_one_circuit_model_port_required(
+        circuit_lib, circuit_model,
+        {CIRCUIT_MODEL_PORT_CLOCK, CIRCUIT_MODEL_PORT_INPUT,
+         CIRCUIT_MODEL_PORT_OUTPUT});
+      break;
+    case CIRCUIT_MODEL_LUT:
+      num_err += check_one_circuit_model_port_required(
+        circuit_lib, circuit_model,
+        {CIRCUIT_MODEL_PORT_SRAM, CIRCUIT_MODEL_PORT_INPUT,
+         CIRCUIT_MODEL_PORT_OUTPUT});
+      break;
+    case CIRCUIT_MODEL_IOPAD:
+      num_err += check_one_io_circuit_model(circuit_lib, circuit_model);
+      break;
+    default:
+      break;
+  }
+
+  if (true == circuit_lib.is_power_gated(circuit_model)) {
+    num_err += check_power_gated_circuit_model(circuit_lib, circuit_model);
+  }
+
   return num_err;
 }
 
@@ -805,21 +825,19 @@ static size_t check_io_circuit_model(const CircuitLibrary& circuit_lib) {
  * Detailed checkpoints:
  * 1. Circuit models have unique names
  * 2. Circuit models have unique prefix
- * 3. Check IOPADs have input and output ports
- * 4. Check MUXes has been defined and has input and output ports
- * 5. We must have at least one SRAM or CCFF
- * 6. SRAM must have at least an input and an output ports
- * 7. CCFF must have at least a clock, an input and an output ports
- * 8. FF must have at least a clock, an input and an output ports
- * 9. LUT must have at least an input, an output and a SRAM ports
- * 10. We must have default circuit models for these types: MUX, channel wires
+ * 3. We must have IOPADs, MUXes and at least one SRAM or CCFF
+ * 4. Each circuit model has the ports required by its type
+ *    (see check_one_circuit_model()), which are checked on a given number
+ *    of threads
+ * 5. We must have default circuit models for these types: MUX, channel wires
  *and wires
  *
  * Note:
  *   - NO modification on the circuit library is allowed!
  *     The circuit library should be read-only!!!
  ***********************************************************************/
-bool check_circuit_library(const CircuitLibrary& circuit_lib) {
+bool check_circuit_library(const CircuitLibrary& circuit_lib,
+                           const size_t& num_threads) {
   size_t num_err = 0;
 
   vtr::ScopedStartFinishTimer timer("Check circuit library");
@@ -839,29 +857,10 @@ bool check_circuit_library(const CircuitLibrary& circuit_lib) {
   /* Check global ports */
   num_err += check_circuit_library_ports(circuit_lib);
 
-  /* 3. Check io has been defined and has input and output ports
-   * [a] We must have global I/O port, either its type is inout, input or output
-   * [b] For each IOPAD, we must have at least an input an output
-   */
+  /* 3. We must have an IOPAD and a MUX, and at least one SRAM or CCFF */
   num_err += check_circuit_model_required(circuit_lib, CIRCUIT_MODEL_IOPAD);
-  num_err += check_io_circuit_model(circuit_lib);
-
-  /* 4. Check mux has been defined and has input and output ports
-   * [a] We must have a MUX!
-   * [b] For each MUX, we must have at least an input, an output, and an SRAM
-   * port
-   */
   num_err += check_circuit_model_required(circuit_lib, CIRCUIT_MODEL_MUX);
 
-  std::vector<enum e_circuit_model_port_type> mux_port_types_required;
-  mux_port_types_required.push_back(CIRCUIT_MODEL_PORT_INPUT);
-  mux_port_types_required.push_back(CIRCUIT_MODEL_PORT_OUTPUT);
-  mux_port_types_required.push_back(CIRCUIT_MODEL_PORT_SRAM);
-
-  num_err += check_circuit_model_port_required(circuit_lib, CIRCUIT_MODEL_MUX,
-                                               mux_port_types_required);
-
-  /* 5. We must have at least one SRAM or CCFF */
   if ((0 == circuit_lib.models_by_type(CIRCUIT_MODEL_SRAM).size()) &&
       (0 == circuit_lib.models_by_type(CIRCUIT_MODEL_CCFF).size())) {
     VTR_LOG_ERROR("At least one %s or %s circuit model is required!\n",
@@ -871,41 +870,21 @@ bool check_circuit_library(const CircuitLibrary& circuit_lib) {
     num_err++;
   }
 
-  /* 6. SRAM must have at least an input and an output ports*/
-  std::vector<enum e_circuit_model_port_type> sram_port_types_required;
-  sram_port_types_required.push_back(CIRCUIT_MODEL_PORT_OUTPUT);
-
-  num_err += check_circuit_model_port_required(circuit_lib, CIRCUIT_MODEL_SRAM,
-                                               sram_port_types_required);
-
-  /* 7. CCFF must have at least a clock, an input and an output ports*/
-  std::vector<enum e_circuit_model_port_type> ccff_port_types_required;
-  ccff_port_types_required.push_back(CIRCUIT_MODEL_PORT_CLOCK);
-  ccff_port_types_required.push_back(CIRCUIT_MODEL_PORT_INPUT);
-  ccff_port_types_required.push_back(CIRCUIT_MODEL_PORT_OUTPUT);
-
-  num_err += check_circuit_model_port_required(circuit_lib, CIRCUIT_MODEL_CCFF,
-                                               ccff_port_types_required);
-
-  /* 8. FF must have at least a clock, an input and an output ports*/
-  std::vector<enum e_circuit_model_port_type> ff_port_types_required;
-  ff_port_types_required.push_back(CIRCUIT_MODEL_PORT_CLOCK);
-  ff_port_types_required.push_back(CIRCUIT_MODEL_PORT_INPUT);
-  ff_port_types_required.push_back(CIRCUIT_MODEL_PORT_OUTPUT);
-
-  num_err += check_circuit_model_port_required(circuit_lib, CIRCUIT_MODEL_FF,
-                                               ff_port_types_required);
-
-  /* 9. LUT must have at least an input, an output and a SRAM ports*/
-  std::vector<enum e_circuit_model_port_type> lut_port_types_required;
-  lut_port_types_required.push_back(CIRCUIT_MODEL_PORT_SRAM);
-  lut_port_types_required.push_back(CIRCUIT_MODEL_PORT_INPUT);
-  lut_port_types_required.push_back(CIRCUIT_MODEL_PORT_OUTPUT);
-
-  num_err += check_circuit_model_port_required(circuit_lib, CIRCUIT_MODEL_LUT,
-                                               lut_port_types_required);
-
-  /* 10. For each type of circuit models that are define, we must have 1 default
+  /* 4. Check the ports of each circuit model as required by its type, i.e.,
+   * IOPAD, MUX, SRAM, CCFF, FF and LUT, and the ports of power-gated
+   * inverter/buffer models.
+   * Circuit models are checked independently, each with its own error counter
+   */
+  std::vector<size_t> num_model_errs(circuit_lib.num_models(), 0);
+  openfpga::parallel_for_dynamic(
+    circuit_lib.num_models(), num_threads, [&](const size_t& imodel) {
+      num_model_errs[imodel] =
+        check_one_circuit_model(circuit_lib, CircuitModelId(imodel));
+    });
+  num_err += std::accumulate(num_model_errs.begin(), num_model_errs.end(),
+                             size_t(0));
+
+  /* 5. For each type of circuit models that are define, we must have 1 default
    * model We must have default circuit models for these types: MUX, channel
    * wires and wires
    */
@@ -917,9 +896,6 @@ bool check_circuit_library(const CircuitLibrary& circuit_lib) {
   num_err +=
     check_required_default_circuit_model(circuit_lib, CIRCUIT_MODEL_WIRE);
 
-  /* 11. Check power-gated inverter/buffer models */
-  num_err += check_power_gated_circuit_models(circuit_lib);
-
   /* If we have any errors, exit */
 
   if (0 < num_err) {
@@ -48,6 +48,7 @@ size_t check_sram_circuit_model_ports(const CircuitLibrary& circuit_lib,
                                       const CircuitModelId& circuit_model,
                                       const bool& check_blwl);
 
-bool check_circuit_library(const CircuitLibrary& circuit_lib);
+bool check_circuit_library(const CircuitLibrary& circuit_lib,
+                           const size_t& num_threads);
 
 #endif
@@ -7,6 +7,49 @@
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
+/************************************************************************
+ * Helpers to maintain the fast look-ups by names
+ * Empty names are not indexed
+ ***********************************************************************/
+template <class T_id>
+static void add_name_to_lookup(
+  std::unordered_map<std::string, std::vector<T_id>>& lookup,
+  const std::string& name, const T_id& id) {
+  if (true == name.empty()) {
+    return;
+  }
+  lookup[name].push_back(id);
+}
+
+template <class T_id>
+static void remove_name_from_lookup(
+  std::unordered_map<std::string, std::vector<T_id>>& lookup,
+  const std::string& name, const T_id& id) {
+  auto result = lookup.find(name);
+  if (result == lookup.end()) {
+    return;
+  }
+  std::vector<T_id>& ids = result->second;
+  ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+  if (true == ids.empty()) {
+    lookup.erase(result);
+  }
+}
+
+/* Find the unique id of a name, or an invalid id if not found */
+template <class T_id>
+static T_id find_name_in_lookup(
+  const std::unordered_map<std::string, std::vector<T_id>>& lookup,
+  const std::string& name) {
+  auto result = lookup.find(name);
+  if (result == lookup.end()) {
+    return T_id::INVALID();
+  }
+  /* Make sure we will not find two ids with the same name */
+  VTR_ASSERT(1 == result->second.size());
+  return result->second.front();
+}
+
 /************************************************************************
  * Member functions for class CircuitLibrary
  ***********************************************************************/
@@ -585,21 +628,7 @@ CircuitPortId CircuitLibrary::model_port(const CircuitModelId& model_id,
                                          const std::string& name) const {
   /* validate the model_id */
   VTR_ASSERT(valid_model_id(model_id));
-  /* Walk through the ports and try to find a matched name */
-  CircuitPortId ret = CircuitPortId::INVALID();
-  size_t num_found = 0;
-  for (auto model_ports_by_type : model_port_lookup_[model_id]) {
-    for (auto port_id : model_ports_by_type) {
-      if (0 != name.compare(port_prefix(port_id))) {
-        continue; /* Not the one, go to the next*/
-      }
-      ret = port_id; /* Find one */
-      num_found++;
-    }
-  }
-  /* Make sure we will not find two ports with the same name */
-  VTR_ASSERT((0 == num_found) || (1 == num_found));
-  return ret;
+  return find_name_in_lookup(model_port_name2ids_[model_id], name);
 }
 
 /* Access the type of a port of a circuit model */
@@ -1168,22 +1197,7 @@ CircuitModelId CircuitLibrary::model(const char* name) const {
 
 /* Find a circuit model by a given name and return its id */
 CircuitModelId CircuitLibrary::model(const std::string& name) const {
-  CircuitModelId ret = CircuitModelId::INVALID();
-  size_t num_found = 0;
-  for (circuit_model_string_iterator it = model_names_.begin();
-       it != model_names_.end(); it++) {
-    /* Bypass unmatched names */
-    if (0 != name.compare(*it)) {
-      continue;
-    }
-    /* Find one and record it
-     * FIXME: I feel that we may have a better way in getting the CircuitModelId
-     */
-    ret = CircuitModelId(it - model_names_.begin());
-    num_found++;
-  }
-  VTR_ASSERT((0 == num_found) || (1 == num_found));
-  return ret;
+  return find_name_in_lookup(model_name2ids_, name);
 }
 
 /* Get the CircuitModelId of a default circuit model with a given type */
@@ -1314,6 +1328,7 @@ CircuitModelId CircuitLibrary::add_model(
    */
   model_port_lookup_.resize(model_ids_.size());
   model_port_lookup_[model_id].resize(NUM_CIRCUIT_MODEL_PORT_TYPES);
+  model_port_name2ids_.emplace_back();
 
   return model_id;
 }
@@ -1323,7 +1338,9 @@ void CircuitLibrary::set_model_name(const CircuitModelId& model_id,
                                     const std::string& name) {
   /* validate the model_id */
   VTR_ASSERT(valid_model_id(model_id));
+  remove_name_from_lookup(model_name2ids_, model_names_[model_id], model_id);
   model_names_[model_id] = name;
+  add_name_to_lookup(model_name2ids_, name, model_id);
   return;
 }
 
@@ -1527,8 +1544,9 @@ CircuitPortId CircuitLibrary::add_model_port(
   port_in_edge_ids_.emplace_back();
   port_out_edge_ids_.emplace_back();
 
-  /* Build the fast look-up for circuit model ports */
-  build_model_port_lookup();
+  /* Update the fast look-up for circuit model ports. The new port is always
+   * the last one, so there is no need to rebuild the look-up */
+  model_port_lookup_[model_id][port_type].push_back(circuit_port_id);
 
   return circuit_port_id;
 }
@@ -1547,7 +1565,12 @@ void CircuitLibrary::set_port_prefix(const CircuitPortId& circuit_port_id,
                                      const std::string& port_prefix) {
   /* validate the circuit_port_id */
   VTR_ASSERT(valid_circuit_port_id(circuit_port_id));
+  CircuitModelId model_id = port_model_ids_[circuit_port_id];
+  remove_name_from_lookup(model_port_name2ids_[model_id],
+                          port_prefix_[circuit_port_id], circuit_port_id);
   port_prefix_[circuit_port_id] = port_prefix;
+  add_name_to_lookup(model_port_name2ids_[model_id], port_prefix,
+                     circuit_port_id);
   return;
 }
 
@@ -2536,6 +2559,26 @@ void CircuitLibrary::build_model_port_lookup() {
   return;
 }
 
+/* Build fast look-up for circuit models by names */
+void CircuitLibrary::build_model_name_lookup() {
+  model_name2ids_.clear();
+  for (const auto& model_id : model_ids_) {
+    add_name_to_lookup(model_name2ids_, model_names_[model_id], model_id);
+  }
+  return;
+}
+
+/* Build fast look-up for circuit model ports by names */
+void CircuitLibrary::build_model_port_name_lookup() {
+  model_port_name2ids_.clear();
+  model_port_name2ids_.resize(model_ids_.size());
+  for (const auto& port : port_ids_) {
+    add_name_to_lookup(model_port_name2ids_[port_model_ids_[port]],
+                       port_prefix_[port], port);
+  }
+  return;
+}
+
 /************************************************************************
  * Internal invalidators/validators
  ***********************************************************************/
@@ -2623,6 +2666,263 @@ void CircuitLibrary::invalidate_model_timing_graph() {
   return;
 }
 
+/************************************************************************
+ * Public binary image writer/reader
+ ***********************************************************************/
+/* Write all the internal data to a binary image, in the order of
+ * declaration */
+void CircuitLibrary::write_to_binary_image(
+  openfpga::BinaryImageWriter& writer) const {
+  using openfpga::write_binary_image;
+  write_binary_image(writer, model_ids_);
+  write_binary_image(writer, model_types_);
+  write_binary_image(writer, model_names_);
+  write_binary_image(writer, model_prefix_);
+  write_binary_image(writer, model_verilog_netlists_);
+  write_binary_image(writer, model_spice_netlists_);
+  write_binary_image(writer, model_is_default_);
+  write_binary_image(writer, sub_models_);
+  write_binary_image(writer, model_lookup_);
+  write_binary_image(writer, model_port_lookup_);
+  write_binary_image(writer, model_name2ids_);
+  write_binary_image(writer, model_port_name2ids_);
+  write_binary_image(writer, dump_structural_verilog_);
+  write_binary_image(writer, dump_explicit_port_map_);
+  write_binary_image(writer, design_tech_types_);
+  write_binary_image(writer, is_power_gated_);
+  write_binary_image(writer, device_model_names_);
+  write_binary_image(writer, buffer_existence_);
+  write_binary_image(writer, buffer_model_names_);
+  write_binary_image(writer, buffer_model_ids_);
+  write_binary_image(writer, buffer_location_maps_);
+  write_binary_image(writer, pass_gate_logic_model_names_);
+  write_binary_image(writer, pass_gate_logic_model_ids_);
+  write_binary_image(writer, port_ids_);
+  write_binary_image(writer, port_model_ids_);
+  write_binary_image(writer, port_types_);
+  write_binary_image(writer, port_sizes_);
+  write_binary_image(writer, port_prefix_);
+  write_binary_image(writer, port_lib_names_);
+  write_binary_image(writer, port_inv_prefix_);
+  write_binary_image(writer, port_default_values_);
+  write_binary_image(writer, port_is_io_);
+  write_binary_image(writer, port_is_data_io_);
+  write_binary_image(writer, port_is_mode_select_);
+  write_binary_image(writer, port_is_global_);
+  write_binary_image(writer, port_is_reset_);
+  write_binary_image(writer, port_is_set_);
+  write_binary_image(writer, port_is_config_enable_);
+  write_binary_image(writer, port_is_prog_);
+  write_binary_image(writer, port_is_shift_register_);
+  write_binary_image(writer, port_tri_state_model_names_);
+  write_binary_image(writer, port_tri_state_model_ids_);
+  write_binary_image(writer, port_inv_model_names_);
+  write_binary_image(writer, port_inv_model_ids_);
+  write_binary_image(writer, port_tri_state_maps_);
+  write_binary_image(writer, port_lut_frac_level_);
+  write_binary_image(writer, port_is_harden_lut_port_);
+  write_binary_image(writer, port_lut_output_masks_);
+  write_binary_image(writer, port_sram_orgz_);
+  write_binary_image(writer, edge_ids_);
+  write_binary_image(writer, edge_parent_model_ids_);
+  write_binary_image(writer, port_in_edge_ids_);
+  write_binary_image(writer, port_out_edge_ids_);
+  write_binary_image(writer, edge_src_port_ids_);
+  write_binary_image(writer, edge_src_pin_ids_);
+  write_binary_image(writer, edge_sink_port_ids_);
+  write_binary_image(writer, edge_sink_pin_ids_);
+  write_binary_image(writer, edge_timing_info_);
+  write_binary_image(writer, delay_types_);
+  write_binary_image(writer, delay_in_port_names_);
+  write_binary_image(writer, delay_out_port_names_);
+  write_binary_image(writer, delay_values_);
+  write_binary_image(writer, buffer_types_);
+  write_binary_image(writer, buffer_sizes_);
+  write_binary_image(writer, buffer_num_levels_);
+  write_binary_image(writer, buffer_f_per_stage_);
+  write_binary_image(writer, pass_gate_logic_types_);
+  write_binary_image(writer, pass_gate_logic_sizes_);
+  write_binary_image(writer, mux_structure_);
+  write_binary_image(writer, mux_num_levels_);
+  write_binary_image(writer, mux_const_input_values_);
+  write_binary_image(writer, mux_use_local_encoder_);
+  write_binary_image(writer, mux_use_advanced_rram_design_);
+  write_binary_image(writer, lut_is_fracturable_);
+  write_binary_image(writer, gate_types_);
+  write_binary_image(writer, rram_res_);
+  write_binary_image(writer, wprog_set_);
+  write_binary_image(writer, wprog_reset_);
+  write_binary_image(writer, wire_types_);
+  write_binary_image(writer, wire_rc_);
+  write_binary_image(writer, wire_num_levels_);
+}
+
+/* Write the data of a circuit model and its ports, in the order of
+ * declaration */
+void CircuitLibrary::write_model_to_binary_image(
+  openfpga::BinaryImageWriter& writer, const CircuitModelId& model_id) const {
+  using openfpga::write_binary_image;
+  VTR_ASSERT(true == valid_model_id(model_id));
+  write_binary_image(writer, model_types_[model_id]);
+  write_binary_image(writer, model_names_[model_id]);
+  write_binary_image(writer, model_prefix_[model_id]);
+  write_binary_image(writer, model_verilog_netlists_[model_id]);
+  write_binary_image(writer, model_spice_netlists_[model_id]);
+  write_binary_image(writer, bool(model_is_default_[model_id]));
+  write_binary_image(writer, sub_models_[model_id].size());
+  for (const CircuitModelId& sub_model : sub_models_[model_id]) {
+    write_binary_image(writer, model_names_[sub_model]);
+  }
+  write_binary_image(writer, bool(dump_structural_verilog_[model_id]));
+  write_binary_image(writer, bool(dump_explicit_port_map_[model_id]));
+  write_binary_image(writer, design_tech_types_[model_id]);
+  write_binary_image(writer, bool(is_power_gated_[model_id]));
+  write_binary_image(writer, device_model_names_[model_id]);
+  write_binary_image(writer, buffer_existence_[model_id]);
+  write_binary_image(writer, buffer_model_names_[model_id]);
+  write_binary_image(writer, buffer_location_maps_[model_id]);
+  write_binary_image(writer, pass_gate_logic_model_names_[model_id]);
+
+  std::vector<CircuitPortId> ports = model_ports(model_id);
+  write_binary_image(writer, ports.size());
+  for (const CircuitPortId& port : ports) {
+    write_binary_image(writer, port_types_[port]);
+    write_binary_image(writer, port_sizes_[port]);
+    write_binary_image(writer, port_prefix_[port]);
+    write_binary_image(writer, port_lib_names_[port]);
+    write_binary_image(writer, port_inv_prefix_[port]);
+    write_binary_image(writer, port_default_values_[port]);
+    write_binary_image(writer, bool(port_is_io_[port]));
+    write_binary_image(writer, bool(port_is_data_io_[port]));
+    write_binary_image(writer, bool(port_is_mode_select_[port]));
+    write_binary_image(writer, bool(port_is_global_[port]));
+    write_binary_image(writer, bool(port_is_reset_[port]));
+    write_binary_image(writer, bool(port_is_set_[port]));
+    write_binary_image(writer, bool(port_is_config_enable_[port]));
+    write_binary_image(writer, bool(port_is_prog_[port]));
+    write_binary_image(writer, bool(port_is_shift_register_[port]));
+    write_binary_image(writer, port_tri_state_model_names_[port]);
+    write_binary_image(writer, port_inv_model_names_[port]);
+    write_binary_image(writer, port_tri_state_maps_[port]);
+    write_binary_image(writer, port_lut_frac_level_[port]);
+    write_binary_image(writer, bool(port_is_harden_lut_port_[port]));
+    write_binary_image(writer, port_lut_output_masks_[port]);
+    write_binary_image(writer, port_sram_orgz_[port]);
+  }
+
+  write_binary_image(writer, delay_types_[model_id]);
+  write_binary_image(writer, delay_in_port_names_[model_id]);
+  write_binary_image(writer, delay_out_port_names_[model_id]);
+  write_binary_image(writer, delay_values_[model_id]);
+  write_binary_image(writer, buffer_types_[model_id]);
+  write_binary_image(writer, buffer_sizes_[model_id]);
+  write_binary_image(writer, buffer_num_levels_[model_id]);
+  write_binary_image(writer, buffer_f_per_stage_[model_id]);
+  write_binary_image(writer, pass_gate_logic_types_[model_id]);
+  write_binary_image(writer, pass_gate_logic_sizes_[model_id]);
+  write_binary_image(writer, mux_structure_[model_id]);
+  write_binary_image(writer, mux_num_levels_[model_id]);
+  write_binary_image(writer, mux_const_input_values_[model_id]);
+  write_binary_image(writer, bool(mux_use_local_encoder_[model_id]));
+  write_binary_image(writer, bool(mux_use_advanced_rram_design_[model_id]));
+  write_binary_image(writer, bool(lut_is_fracturable_[model_id]));
+  write_binary_image(writer, gate_types_[model_id]);
+  write_binary_image(writer, rram_res_[model_id]);
+  write_binary_image(writer, wprog_set_[model_id]);
+  write_binary_image(writer, wprog_reset_[model_id]);
+  write_binary_image(writer, wire_types_[model_id]);
+  write_binary_image(writer, wire_rc_[model_id]);
+  write_binary_image(writer, wire_num_levels_[model_id]);
+}
+
+/* Replace all the internal data with the data of a binary image, which is
+ * written by write_to_binary_image() */
+void CircuitLibrary::read_from_binary_image(
+  openfpga::BinaryImageReader& reader) {
+  using openfpga::read_binary_image;
+  read_binary_image(reader, model_ids_);
+  read_binary_image(reader, model_types_);
+  read_binary_image(reader, model_names_);
+  read_binary_image(reader, model_prefix_);
+  read_binary_image(reader, model_verilog_netlists_);
+  read_binary_image(reader, model_spice_netlists_);
+  read_binary_image(reader, model_is_default_);
+  read_binary_image(reader, sub_models_);
+  read_binary_image(reader, model_lookup_);
+  read_binary_image(reader, model_port_lookup_);
+  read_binary_image(reader, model_name2ids_);
+  read_binary_image(reader, model_port_name2ids_);
+  read_binary_image(reader, dump_structural_verilog_);
+  read_binary_image(reader, dump_explicit_port_map_);
+  read_binary_image(reader, design_tech_types_);
+  read_binary_image(reader, is_power_gated_);
+  read_binary_image(reader, device_model_names_);
+  read_binary_image(reader, buffer_existence_);
+  read_binary_image(reader, buffer_model_names_);
+  read_binary_image(reader, buffer_model_ids_);
+  read_binary_image(reader, buffer_location_maps_);
+  read_binary_image(reader, pass_gate_logic_model_names_);
+  read_binary_image(reader, pass_gate_logic_model_ids_);
+  read_binary_image(reader, port_ids_);
+  read_binary_image(reader, port_model_ids_);
+  read_binary_image(reader, port_types_);
+  read_binary_image(reader, port_sizes_);
+  read_binary_image(reader, port_prefix_);
+  read_binary_image(reader, port_lib_names_);
+  read_binary_image(reader, port_inv_prefix_);
+  read_binary_image(reader, port_default_values_);
+  read_binary_image(reader, port_is_io_);
+  read_binary_image(reader, port_is_data_io_);
+  read_binary_image(reader, port_is_mode_select_);
+  read_binary_image(reader, port_is_global_);
+  read_binary_image(reader, port_is_reset_);
+  read_binary_image(reader, port_is_set_);
+  read_binary_image(reader, port_is_config_enable_);
+  read_binary_image(reader, port_is_prog_);
+  read_binary_image(reader, port_is_shift_register_);
+  read_binary_image(reader, port_tri_state_model_names_);
+  read_binary_image(reader, port_tri_state_model_ids_);
+  read_binary_image(reader, port_inv_model_names_);
+  read_binary_image(reader, port_inv_model_ids_);
+  read_binary_image(reader, port_tri_state_maps_);
+  read_binary_image(reader, port_lut_frac_level_);
+  read_binary_image(reader, port_is_harden_lut_port_);
+  read_binary_image(reader, port_lut_output_masks_);
+  read_binary_image(reader, port_sram_orgz_);
+  read_binary_image(reader, edge_ids_);
+  read_binary_image(reader, edge_parent_model_ids_);
+  read_binary_image(reader, port_in_edge_ids_);
+  read_binary_image(reader, port_out_edge_ids_);
+  read_binary_image(reader, edge_src_port_ids_);
+  read_binary_image(reader, edge_src_pin_ids_);
+  read_binary_image(reader, edge_sink_port_ids_);
+  read_binary_image(reader, edge_sink_pin_ids_);
+  read_binary_image(reader, edge_timing_info_);
+  read_binary_image(reader, delay_types_);
+  read_binary_image(reader, delay_in_port_names_);
+  read_binary_image(reader, delay_out_port_names_);
+  read_binary_image(reader, delay_values_);
+  read_binary_image(reader, buffer_types_);
+  read_binary_image(reader, buffer_sizes_);
+  read_binary_image(reader, buffer_num_levels_);
+  read_binary_image(reader, buffer_f_per_stage_);
+  read_binary_image(reader, pass_gate_logic_types_);
+  read_binary_image(reader, pass_gate_logic_sizes_);
+  read_binary_image(reader, mux_structure_);
+  read_binary_image(reader, mux_num_levels_);
+  read_binary_image(reader, mux_const_input_values_);
+  read_binary_image(reader, mux_use_local_encoder_);
+  read_binary_image(reader, mux_use_advanced_rram_design_);
+  read_binary_image(reader, lut_is_fracturable_);
+  read_binary_image(reader, gate_types_);
+  read_binary_image(reader, rram_res_);
+  read_binary_image(reader, wprog_set_);
+  read_binary_image(reader, wprog_reset_);
+  read_binary_image(reader, wire_types_);
+  read_binary_image(reader, wire_rc_);
+  read_binary_image(reader, wire_num_levels_);
+}
+
 /************************************************************************
  * End of file : circuit_library.cpp
  ***********************************************************************/
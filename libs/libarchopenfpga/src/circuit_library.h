@@ -13,9 +13,12 @@
 /* Header files should be included in a sequence */
 /* Standard header files required go first */
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "circuit_library_fwd.h"
 #include "circuit_types.h"
+#include "openfpga_binary_image.h"
 #include "vtr_geometry.h"
 #include "vtr_range.h"
 #include "vtr_vector.h"
@@ -63,6 +66,13 @@
  *the default model in the first element for each type.
  *  2. model_port_lookup_: A multi-dimension vector to provide fast look-up on
  *ports of circuit models for users It classifies Ports by their types
+ *  3. model_name2ids_: A hash map to find circuit models by their names.
+ *Models without a name are not indexed.
+ *  4. model_port_name2ids_: A hash map for each circuit model to find its ports
+ *by their names. Ports without a name are not indexed.
+ *  Both hash maps are updated when a name is set. A name may temporarily be
+ *shared by several models (or ports of a model), which is only reported when
+ *the name is looked up.
  *
  *  ------ Verilog generation options -----
  * 1. dump_structural_verilog_: if Verilog generator will output structural
@@ -598,6 +608,8 @@ class CircuitLibrary {
  public: /* Internal mutators: build fast look-ups */
   void build_model_lookup();
   void build_model_port_lookup();
+  void build_model_name_lookup();
+  void build_model_port_name_lookup();
 
  public: /* Public invalidators/validators */
   bool valid_model_id(const CircuitModelId& model_id) const;
@@ -618,6 +630,18 @@ class CircuitLibrary {
   void invalidate_model_port_lookup() const;
   void invalidate_model_timing_graph();
 
+ public: /* Public binary image writer/reader */
+  /* Write all the internal data to a binary image */
+  void write_to_binary_image(openfpga::BinaryImageWriter& writer) const;
+  /* Write the data of a circuit model and its ports to a binary image, so
+   * that a circuit model can be compared with the one of another library.
+   * Other circuit models are referred by their names rather than by ids.
+   * The timing graph is not included */
+  void write_model_to_binary_image(openfpga::BinaryImageWriter& writer,
+                                   const CircuitModelId& model_id) const;
+  /* Replace all the internal data with the data of a binary image */
+  void read_from_binary_image(openfpga::BinaryImageReader& reader);
+
  private: /* Internal data */
   /* Fundamental information */
   vtr::vector<CircuitModelId, CircuitModelId> model_ids_;
@@ -642,6 +666,17 @@ class CircuitLibrary {
     CircuitModelPortLookup;
   mutable CircuitModelPortLookup
     model_port_lookup_; /* [model_id][port_type][port_ids] */
+  /* fast look-up for circuit models and their ports by names
+   * Each name is expected to be mapped to a unique id */
+  typedef std::unordered_map<std::string, std::vector<CircuitModelId>>
+    CircuitModelNameLookup;
+  CircuitModelNameLookup model_name2ids_; /* [name][model_ids] */
+  typedef vtr::vector<
+    CircuitModelId,
+    std::unordered_map<std::string, std::vector<CircuitPortId>>>
+    CircuitModelPortNameLookup;
+  CircuitModelPortNameLookup
+    model_port_name2ids_; /* [model_id][name][port_ids] */
 
   /* Verilog generator options */
   vtr::vector<CircuitModelId, bool> dump_structural_verilog_;
@@ -154,3 +154,44 @@ void ConfigProtocol::set_wl_num_banks(const size_t& num_banks) {
   }
   wl_num_banks_ = num_banks;
 }
+
+/************************************************************************
+ * Public binary image writer/reader
+ ***********************************************************************/
+/* Write all the internal data to a binary image, in the order of
+ * declaration */
+void ConfigProtocol::write_to_binary_image(
+  openfpga::BinaryImageWriter& writer) const {
+  using openfpga::write_binary_image;
+  write_binary_image(writer, type_);
+  write_binary_image(writer, memory_model_name_);
+  write_binary_image(writer, memory_model_);
+  write_binary_image(writer, num_regions_);
+  write_binary_image(writer, bl_protocol_type_);
+  write_binary_image(writer, bl_memory_model_name_);
+  write_binary_image(writer, bl_memory_model_);
+  write_binary_image(writer, bl_num_banks_);
+  write_binary_image(writer, wl_protocol_type_);
+  write_binary_image(writer, wl_memory_model_name_);
+  write_binary_image(writer, wl_memory_model_);
+  write_binary_image(writer, wl_num_banks_);
+}
+
+/* Replace all the internal data with the data of a binary image, which is
+ * written by write_to_binary_image() */
+void ConfigProtocol::read_from_binary_image(
+  openfpga::BinaryImageReader& reader) {
+  using openfpga::read_binary_image;
+  read_binary_image(reader, type_);
+  read_binary_image(reader, memory_model_name_);
+  read_binary_image(reader, memory_model_);
+  read_binary_image(reader, num_regions_);
+  read_binary_image(reader, bl_protocol_type_);
+  read_binary_image(reader, bl_memory_model_name_);
+  read_binary_image(reader, bl_memory_model_);
+  read_binary_image(reader, bl_num_banks_);
+  read_binary_image(reader, wl_protocol_type_);
+  read_binary_image(reader, wl_memory_model_name_);
+  read_binary_image(reader, wl_memory_model_);
+  read_binary_image(reader, wl_num_banks_);
+}
@@ -5,6 +5,7 @@
 
 #include "circuit_library_fwd.h"
 #include "circuit_types.h"
+#include "openfpga_binary_image.h"
 
 /* Data type to define the protocol through which BL/WL can be manipulated */
 enum e_blwl_protocol_type {
@@ -53,6 +54,12 @@ class ConfigProtocol {
   void set_wl_memory_model(const CircuitModelId& memory_model);
   void set_wl_num_banks(const size_t& num_banks);
 
+ public: /* Public binary image writer/reader */
+  /* Write all the internal data to a binary image */
+  void write_to_binary_image(openfpga::BinaryImageWriter& writer) const;
+  /* Replace all the internal data with the data of a binary image */
+  void read_from_binary_image(openfpga::BinaryImageReader& reader);
+
  private: /* Internal data */
   /* The type of configuration protocol.
    * In other words, it is about how to organize and access each configurable
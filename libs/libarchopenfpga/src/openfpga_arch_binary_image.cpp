@@ -0,0 +1,140 @@
+/********************************************************************
+ * This file includes functions to save an OpenFPGA architecture into a
+ * binary image and to restore it in another run.
+ * The image stores the architecture after it has been parsed, linked and
+ * checked, so that restoring it skips the XML parser, the linker and the
+ * checks of the circuit library, which become noticeable for
+ * architectures with many circuit models.
+ *
+ * The image is organized as follows:
+ * - A magic header, a format version and the size of a size_t, which
+ *   identify an image written on the same kind of machine
+ * - The technology library, the circuit library and their bindings
+ * - The configuration protocol
+ * - The circuit models of the routing resources and direct connections
+ * - The tile annotations and the pb_type annotations, in this order
+ *******************************************************************/
+#include "openfpga_arch_binary_image.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_binary_image.h"
+#include "openfpga_digest.h"
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+
+/* Magic header and version of the image.
+ * Increase the version when the data of any object in the image is changed */
+constexpr const char* OPENFPGA_ARCH_BINARY_IMAGE_MAGIC = "OFPGAARC";
+constexpr size_t OPENFPGA_ARCH_BINARY_IMAGE_MAGIC_SIZE = 8;
+constexpr uint32_t OPENFPGA_ARCH_BINARY_IMAGE_VERSION = 1;
+
+/********************************************************************
+ * Write an OpenFPGA architecture to a binary image
+ *******************************************************************/
+void write_binary_openfpga_arch(const char* fname,
+                                const openfpga::Arch& openfpga_arch) {
+  vtr::ScopedStartFinishTimer timer(
+    "Write OpenFPGA architecture to binary image");
+
+  /* Create a file handler */
+  std::fstream fp;
+  /* Open the file stream */
+  fp.open(std::string(fname),
+          std::fstream::out | std::fstream::binary | std::fstream::trunc);
+
+  /* Validate the file stream */
+  openfpga::check_file_stream(fname, fp);
+
+  openfpga::BinaryImageWriter writer(fp);
+  writer.write_bytes(OPENFPGA_ARCH_BINARY_IMAGE_MAGIC,
+                     OPENFPGA_ARCH_BINARY_IMAGE_MAGIC_SIZE);
+  openfpga::write_binary_image(writer, OPENFPGA_ARCH_BINARY_IMAGE_VERSION);
+  openfpga::write_binary_image(writer, static_cast<uint32_t>(sizeof(size_t)));
+
+  openfpga_arch.tech_lib.write_to_binary_image(writer);
+  openfpga_arch.circuit_lib.write_to_binary_image(writer);
+  openfpga::write_binary_image(writer, openfpga_arch.circuit_tech_binding);
+  openfpga_arch.config_protocol.write_to_binary_image(writer);
+  openfpga::write_binary_image(writer, openfpga_arch.cb_switch2circuit);
+  openfpga::write_binary_image(writer, openfpga_arch.sb_switch2circuit);
+  openfpga::write_binary_image(writer, openfpga_arch.routing_seg2circuit);
+  openfpga_arch.arch_direct.write_to_binary_image(writer);
+  openfpga_arch.tile_annotations.write_to_binary_image(writer);
+  openfpga::write_binary_image(writer,
+                               openfpga_arch.pb_type_annotations.size());
+  for (const openfpga::PbTypeAnnotation& pb_type_annotation :
+       openfpga_arch.pb_type_annotations) {
+    pb_type_annotation.write_to_binary_image(writer);
+  }
+
+  /* Close the file stream */
+  fp.close();
+  if (false == openfpga::valid_file_stream(fp)) {
+    archfpga_throw(fname, 0, "Fail to write binary architecture '%s'!\n",
+                   fname);
+  }
+}
+
+/********************************************************************
+ * Restore an OpenFPGA architecture from a binary image
+ * The image is expected to be written by write_binary_openfpga_arch()
+ * with the same format version on the same kind of machine.
+ *******************************************************************/
+openfpga::Arch read_binary_openfpga_arch(const char* fname) {
+  vtr::ScopedStartFinishTimer timer(
+    "Read OpenFPGA architecture from binary image");
+
+  openfpga::Arch openfpga_arch;
+
+  openfpga::BinaryImageReader reader(fname);
+
+  char magic[OPENFPGA_ARCH_BINARY_IMAGE_MAGIC_SIZE];
+  uint32_t version = 0;
+  uint32_t size_of_size_t = 0;
+  reader.read_bytes(magic, OPENFPGA_ARCH_BINARY_IMAGE_MAGIC_SIZE);
+  if (0 != std::memcmp(magic, OPENFPGA_ARCH_BINARY_IMAGE_MAGIC,
+                       OPENFPGA_ARCH_BINARY_IMAGE_MAGIC_SIZE)) {
+    archfpga_throw(fname, 0, "Invalid binary architecture '%s'!\n", fname);
+  }
+  openfpga::read_binary_image(reader, version);
+  openfpga::read_binary_image(reader, size_of_size_t);
+  if ((OPENFPGA_ARCH_BINARY_IMAGE_VERSION != version) ||
+      (sizeof(size_t) != size_of_size_t)) {
+    archfpga_throw(fname, 0,
+                   "Binary architecture '%s' is written by an incompatible "
+                   "version or machine!\n",
+                   fname);
+  }
+
+  openfpga_arch.tech_lib.read_from_binary_image(reader);
+  openfpga_arch.circuit_lib.read_from_binary_image(reader);
+  openfpga::read_binary_image(reader, openfpga_arch.circuit_tech_binding);
+  openfpga_arch.config_protocol.read_from_binary_image(reader);
+  openfpga::read_binary_image(reader, openfpga_arch.cb_switch2circuit);
+  openfpga::read_binary_image(reader, openfpga_arch.sb_switch2circuit);
+  openfpga::read_binary_image(reader, openfpga_arch.routing_seg2circuit);
+  openfpga_arch.arch_direct.read_from_binary_image(reader);
+  openfpga_arch.tile_annotations.read_from_binary_image(reader);
+  openfpga_arch.pb_type_annotations.resize(
+    openfpga::read_binary_image_size(reader));
+  for (openfpga::PbTypeAnnotation& pb_type_annotation :
+       openfpga_arch.pb_type_annotations) {
+    pb_type_annotation.read_from_binary_image(reader);
+  }
+
+  if (0 != reader.num_remaining_bytes()) {
+    archfpga_throw(fname, 0,
+                   "Unexpected data at the end of binary architecture '%s'!\n",
+                   fname);
+  }
+
+  return openfpga_arch;
+}
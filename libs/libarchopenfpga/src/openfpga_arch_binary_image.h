@@ -0,0 +1,19 @@
+#ifndef OPENFPGA_ARCH_BINARY_IMAGE_H
+#define OPENFPGA_ARCH_BINARY_IMAGE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+#include "openfpga_arch.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+void write_binary_openfpga_arch(const char* fname,
+                                const openfpga::Arch& openfpga_arch);
+
+openfpga::Arch read_binary_openfpga_arch(const char* fname);
+
+#endif
@@ -286,4 +286,45 @@ void PbTypeAnnotation::add_interconnect_circuit_model_pair(
   interconnect_circuit_model_names_[interc_name] = circuit_model_name;
 }
 
+/************************************************************************
+ * Public binary image writer/reader
+ ***********************************************************************/
+/* Write all the internal data to a binary image, in the order of
+ * declaration */
+void PbTypeAnnotation::write_to_binary_image(BinaryImageWriter& writer) const {
+  write_binary_image(writer, operating_pb_type_name_);
+  write_binary_image(writer, operating_parent_pb_type_names_);
+  write_binary_image(writer, operating_parent_mode_names_);
+  write_binary_image(writer, physical_pb_type_name_);
+  write_binary_image(writer, physical_parent_pb_type_names_);
+  write_binary_image(writer, physical_parent_mode_names_);
+  write_binary_image(writer, physical_mode_name_);
+  write_binary_image(writer, idle_mode_name_);
+  write_binary_image(writer, mode_bits_);
+  write_binary_image(writer, circuit_model_name_);
+  write_binary_image(writer, physical_pb_type_index_factor_);
+  write_binary_image(writer, physical_pb_type_index_offset_);
+  write_binary_image(writer, operating_pb_type_ports_);
+  write_binary_image(writer, interconnect_circuit_model_names_);
+}
+
+/* Replace all the internal data with the data of a binary image, which is
+ * written by write_to_binary_image() */
+void PbTypeAnnotation::read_from_binary_image(BinaryImageReader& reader) {
+  read_binary_image(reader, operating_pb_type_name_);
+  read_binary_image(reader, operating_parent_pb_type_names_);
+  read_binary_image(reader, operating_parent_mode_names_);
+  read_binary_image(reader, physical_pb_type_name_);
+  read_binary_image(reader, physical_parent_pb_type_names_);
+  read_binary_image(reader, physical_parent_mode_names_);
+  read_binary_image(reader, physical_mode_name_);
+  read_binary_image(reader, idle_mode_name_);
+  read_binary_image(reader, mode_bits_);
+  read_binary_image(reader, circuit_model_name_);
+  read_binary_image(reader, physical_pb_type_index_factor_);
+  read_binary_image(reader, physical_pb_type_index_offset_);
+  read_binary_image(reader, operating_pb_type_ports_);
+  read_binary_image(reader, interconnect_circuit_model_names_);
+}
+
 }  // namespace openfpga
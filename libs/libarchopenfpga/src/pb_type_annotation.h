@@ -8,6 +8,7 @@
 #include <map>
 #include <vector>
 
+#include "openfpga_binary_image.h"
 #include "openfpga_port.h"
 
 /* namespace openfpga begins */
@@ -84,6 +85,12 @@ class PbTypeAnnotation {
   void add_interconnect_circuit_model_pair(
     const std::string& interc_name, const std::string& circuit_model_name);
 
+ public: /* Public binary image writer/reader */
+  /* Write all the internal data to a binary image */
+  void write_to_binary_image(BinaryImageWriter& writer) const;
+  /* Replace all the internal data with the data of a binary image */
+  void read_from_binary_image(BinaryImageReader& reader);
+
  private: /* Internal data */
   /* Binding between physical pb_type and operating pb_type
    * both operating and physial pb_type names contain the full names
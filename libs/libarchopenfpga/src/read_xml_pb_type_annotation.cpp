@@ -57,14 +57,15 @@ static void read_xml_pb_port_annotation(
   const std::string& physical_mode_port_attr =
     get_attribute(xml_port, "physical_mode_port", loc_data).as_string();
 
-  /* Split the physical mode port attributes with space */
-  openfpga::StringToken port_tokenizer(physical_mode_port_attr);
-  const std::vector<std::string> physical_mode_ports = port_tokenizer.split();
+  /* Split the physical mode port attributes with space and parse the mode
+   * ports using openfpga port parser. The ports are parsed only once and
+   * used by all the offsets below
+   */
+  const std::vector<openfpga::BasicPort> physical_mode_ports =
+    openfpga::MultiPortParser(physical_mode_port_attr).ports();
 
-  /* Parse the mode port using openfpga port parser */
   for (const auto& physical_mode_port : physical_mode_ports) {
-    openfpga::PortParser port_parser(physical_mode_port);
-    pb_type_annotation.add_pb_type_port_pair(name_attr, port_parser.port());
+    pb_type_annotation.add_pb_type_port_pair(name_attr, physical_mode_port);
   }
 
   /* We have an optional attribute: physical_mode_pin_initial_offset
@@ -89,9 +90,9 @@ static void read_xml_pb_port_annotation(
     }
 
     for (size_t iport = 0; iport < physical_mode_ports.size(); ++iport) {
-      openfpga::PortParser port_parser(physical_mode_ports[iport]);
       pb_type_annotation.set_physical_pin_initial_offset(
-        name_attr, port_parser.port(), std::stoi(initial_offsets[iport]));
+        name_attr, physical_mode_ports[iport],
+        std::stoi(initial_offsets[iport]));
     }
   }
 
@@ -117,9 +118,9 @@ static void read_xml_pb_port_annotation(
     }
 
     for (size_t iport = 0; iport < physical_mode_ports.size(); ++iport) {
-      openfpga::PortParser port_parser(physical_mode_ports[iport]);
       pb_type_annotation.set_physical_pin_rotate_offset(
-        name_attr, port_parser.port(), std::stoi(rotate_offsets[iport]));
+        name_attr, physical_mode_ports[iport],
+        std::stoi(rotate_offsets[iport]));
     }
   }
 
@@ -145,9 +146,9 @@ static void read_xml_pb_port_annotation(
     }
 
     for (size_t iport = 0; iport < physical_mode_ports.size(); ++iport) {
-      openfpga::PortParser port_parser(physical_mode_ports[iport]);
       pb_type_annotation.set_physical_port_rotate_offset(
-        name_attr, port_parser.port(), std::stoi(rotate_offsets[iport]));
+        name_attr, physical_mode_ports[iport],
+        std::stoi(rotate_offsets[iport]));
     }
   }
 }
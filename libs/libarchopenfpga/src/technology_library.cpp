@@ -597,3 +597,68 @@ bool TechnologyLibrary::valid_variation_id(
   return (size_t(variation_id) < variation_ids_.size()) &&
          (variation_id == variation_ids_[variation_id]);
 }
+
+/************************************************************************
+ * Public binary image writer/reader
+ ***********************************************************************/
+/* Write all the internal data to a binary image, in the order of
+ * declaration */
+void TechnologyLibrary::write_to_binary_image(
+  openfpga::BinaryImageWriter& writer) const {
+  using openfpga::write_binary_image;
+  write_binary_image(writer, model_ids_);
+  write_binary_image(writer, model_names_);
+  write_binary_image(writer, model_types_);
+  write_binary_image(writer, model_lib_types_);
+  write_binary_image(writer, model_corners_);
+  write_binary_image(writer, model_refs_);
+  write_binary_image(writer, model_lib_paths_);
+  write_binary_image(writer, model_vdds_);
+  write_binary_image(writer, model_pn_ratios_);
+  write_binary_image(writer, transistor_model_names_);
+  write_binary_image(writer, transistor_model_chan_lengths_);
+  write_binary_image(writer, transistor_model_min_widths_);
+  write_binary_image(writer, transistor_model_max_widths_);
+  write_binary_image(writer, transistor_model_variation_names_);
+  write_binary_image(writer, transistor_model_variation_ids_);
+  write_binary_image(writer, rram_resistances_);
+  write_binary_image(writer, rram_variation_names_);
+  write_binary_image(writer, rram_variation_ids_);
+  write_binary_image(writer, variation_ids_);
+  write_binary_image(writer, variation_names_);
+  write_binary_image(writer, variation_abs_values_);
+  write_binary_image(writer, variation_num_sigmas_);
+  write_binary_image(writer, model_name2ids_);
+  write_binary_image(writer, variation_name2ids_);
+}
+
+/* Replace all the internal data with the data of a binary image, which is
+ * written by write_to_binary_image() */
+void TechnologyLibrary::read_from_binary_image(
+  openfpga::BinaryImageReader& reader) {
+  using openfpga::read_binary_image;
+  read_binary_image(reader, model_ids_);
+  read_binary_image(reader, model_names_);
+  read_binary_image(reader, model_types_);
+  read_binary_image(reader, model_lib_types_);
+  read_binary_image(reader, model_corners_);
+  read_binary_image(reader, model_refs_);
+  read_binary_image(reader, model_lib_paths_);
+  read_binary_image(reader, model_vdds_);
+  read_binary_image(reader, model_pn_ratios_);
+  read_binary_image(reader, transistor_model_names_);
+  read_binary_image(reader, transistor_model_chan_lengths_);
+  read_binary_image(reader, transistor_model_min_widths_);
+  read_binary_image(reader, transistor_model_max_widths_);
+  read_binary_image(reader, transistor_model_variation_names_);
+  read_binary_image(reader, transistor_model_variation_ids_);
+  read_binary_image(reader, rram_resistances_);
+  read_binary_image(reader, rram_variation_names_);
+  read_binary_image(reader, rram_variation_ids_);
+  read_binary_image(reader, variation_ids_);
+  read_binary_image(reader, variation_names_);
+  read_binary_image(reader, variation_abs_values_);
+  read_binary_image(reader, variation_num_sigmas_);
+  read_binary_image(reader, model_name2ids_);
+  read_binary_image(reader, variation_name2ids_);
+}
@@ -9,6 +9,7 @@
 #include <string>
 
 /* Headers from vtrutil library */
+#include "openfpga_binary_image.h"
 #include "technology_library_fwd.h"
 #include "vtr_geometry.h"
 #include "vtr_vector.h"
@@ -189,6 +190,12 @@ class TechnologyLibrary {
   bool valid_model_id(const TechnologyModelId& model_id) const;
   bool valid_variation_id(const TechnologyVariationId& variation_id) const;
 
+ public: /* Public binary image writer/reader */
+  /* Write all the internal data to a binary image */
+  void write_to_binary_image(openfpga::BinaryImageWriter& writer) const;
+  /* Replace all the internal data with the data of a binary image */
+  void read_from_binary_image(openfpga::BinaryImageReader& reader);
+
  private: /* Internal data */
   /* Transistor-related fundamental information */
   /* Unique identifier for each model
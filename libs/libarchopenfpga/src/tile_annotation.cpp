@@ -165,4 +165,37 @@ bool TileAnnotation::valid_global_port_attributes(
   return ((0 == attribute_counter) || (1 == attribute_counter));
 }
 
+/************************************************************************
+ * Public binary image writer/reader
+ ***********************************************************************/
+/* Write all the internal data to a binary image, in the order of
+ * declaration */
+void TileAnnotation::write_to_binary_image(BinaryImageWriter& writer) const {
+  write_binary_image(writer, global_port_ids_);
+  write_binary_image(writer, global_port_names_);
+  write_binary_image(writer, global_port_tile_names_);
+  write_binary_image(writer, global_port_tile_coordinates_);
+  write_binary_image(writer, global_port_tile_ports_);
+  write_binary_image(writer, global_port_is_clock_);
+  write_binary_image(writer, global_port_is_reset_);
+  write_binary_image(writer, global_port_is_set_);
+  write_binary_image(writer, global_port_default_values_);
+  write_binary_image(writer, global_port_name2ids_);
+}
+
+/* Replace all the internal data with the data of a binary image, which is
+ * written by write_to_binary_image() */
+void TileAnnotation::read_from_binary_image(BinaryImageReader& reader) {
+  read_binary_image(reader, global_port_ids_);
+  read_binary_image(reader, global_port_names_);
+  read_binary_image(reader, global_port_tile_names_);
+  read_binary_image(reader, global_port_tile_coordinates_);
+  read_binary_image(reader, global_port_tile_ports_);
+  read_binary_image(reader, global_port_is_clock_);
+  read_binary_image(reader, global_port_is_reset_);
+  read_binary_image(reader, global_port_is_set_);
+  read_binary_image(reader, global_port_default_values_);
+  read_binary_image(reader, global_port_name2ids_);
+}
+
 }  // namespace openfpga
@@ -8,6 +8,7 @@
 #include <map>
 #include <vector>
 
+#include "openfpga_binary_image.h"
 #include "openfpga_port.h"
 #include "tile_annotation_fwd.h"
 #include "vtr_geometry.h"
@@ -81,6 +82,12 @@ class TileAnnotation {
   bool valid_global_port_attributes(
     const TileGlobalPortId& global_port_id) const;
 
+ public: /* Public binary image writer/reader */
+  /* Write all the internal data to a binary image */
+  void write_to_binary_image(BinaryImageWriter& writer) const;
+  /* Replace all the internal data with the data of a binary image */
+  void read_from_binary_image(BinaryImageReader& reader);
+
  private: /* Internal data */
   /* Global port information for tiles */
   vtr::vector<TileGlobalPortId, TileGlobalPortId> global_port_ids_;
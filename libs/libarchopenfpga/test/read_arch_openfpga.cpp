@@ -3,15 +3,30 @@
  * 1. parser of data structures
  * 2. writer of data structures
  *******************************************************************/
+#include <fstream>
+#include <iterator>
+#include <string>
+
 /* Headers from vtrutils */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
 /* Headers from readarchopenfpga */
 #include "check_circuit_library.h"
+#include "openfpga_arch_binary_image.h"
 #include "read_xml_openfpga_arch.h"
 #include "write_xml_openfpga_arch.h"
 
+/********************************************************************
+ * Return the content of a file, which is compared byte by byte
+ *******************************************************************/
+static std::string read_file_content(const std::string& fname) {
+  std::ifstream fp(fname, std::ifstream::binary);
+  VTR_ASSERT(true == fp.is_open());
+  return std::string(std::istreambuf_iterator<char>(fp),
+                     std::istreambuf_iterator<char>());
+}
+
 int main(int argc, const char** argv) {
   /* Ensure we have only one or two argument */
   VTR_ASSERT((2 == argc) || (3 == argc));
@@ -22,7 +37,7 @@ int main(int argc, const char** argv) {
           openfpga_arch.circuit_lib.num_models());
 
   /* Check the circuit library */
-  check_circuit_library(openfpga_arch.circuit_lib);
+  check_circuit_library(openfpga_arch.circuit_lib, 1);
 
   /* Output the circuit library to an XML file
    * This is optional only used when there is a second argument
@@ -30,5 +45,26 @@ int main(int argc, const char** argv) {
   if (3 <= argc) {
     write_xml_openfpga_arch(argv[2], openfpga_arch);
     VTR_LOG("Echo the OpenFPGA architecture to an XML file: %s.\n", argv[2]);
+
+    /* Round-trip the architecture through a binary image */
+    std::string bin_fname = std::string(argv[2]) + ".bin";
+    write_binary_openfpga_arch(bin_fname.c_str(), openfpga_arch);
+    const openfpga::Arch& bin_arch =
+      read_binary_openfpga_arch(bin_fname.c_str());
+    VTR_LOG("Echo the OpenFPGA architecture to a binary file: %s.\n",
+            bin_fname.c_str());
+
+    /* The restored architecture should be echoed to the same XML file */
+    std::string bin_xml_fname = bin_fname + ".xml";
+    write_xml_openfpga_arch(bin_xml_fname.c_str(), bin_arch);
+    VTR_ASSERT(read_file_content(argv[2]) == read_file_content(bin_xml_fname));
+
+    /* The fields which are not in the XML file, e.g., the bindings to the
+     * technology library, should be saved to the same binary image */
+    std::string bin_echo_fname = bin_fname + ".echo";
+    write_binary_openfpga_arch(bin_echo_fname.c_str(), bin_arch);
+    VTR_ASSERT(read_file_content(bin_fname) ==
+               read_file_content(bin_echo_fname));
+    VTR_LOG("Restored the same OpenFPGA architecture from the binary file.\n");
   }
 }
@@ -36,7 +36,8 @@ bool BusGroup::is_big_endian(const BusGroupId& bus_id) const {
   return bus_big_endians_[bus_id];
 }
 
-std::vector<BusPinId> BusGroup::bus_pins(const BusGroupId& bus_id) const {
+const std::vector<BusPinId>& BusGroup::bus_pins(
+  const BusGroupId& bus_id) const {
   VTR_ASSERT(valid_bus_id(bus_id));
   return bus_pin_ids_[bus_id];
 }
@@ -52,8 +53,7 @@ std::string BusGroup::pin_name(const BusPinId& pin_id) const {
 }
 
 BusGroupId BusGroup::find_pin_bus(const std::string& pin_name) const {
-  std::map<std::string, BusPinId>::const_iterator result =
-    pin_name2id_map_.find(pin_name);
+  auto result = pin_name2id_map_.find(pin_name);
   if (result == pin_name2id_map_.end()) {
     /* Not found, return an invalid id */
     return BusGroupId::INVALID();
@@ -64,8 +64,7 @@ BusGroupId BusGroup::find_pin_bus(const std::string& pin_name) const {
 }
 
 BusGroupId BusGroup::find_bus(const std::string& bus_name) const {
-  std::map<std::string, BusGroupId>::const_iterator result =
-    bus_name2id_map_.find(bus_name);
+  auto result = bus_name2id_map_.find(bus_name);
   if (result == bus_name2id_map_.end()) {
     /* Not found, return an invalid id */
     return BusGroupId::INVALID();
@@ -75,8 +74,7 @@ BusGroupId BusGroup::find_bus(const std::string& bus_name) const {
 }
 
 BusPinId BusGroup::find_pin(const std::string& pin_name) const {
-  std::map<std::string, BusPinId>::const_iterator result =
-    pin_name2id_map_.find(pin_name);
+  auto result = pin_name2id_map_.find(pin_name);
   if (result == pin_name2id_map_.end()) {
     /* Not found, return an invalid id */
     return BusPinId::INVALID();
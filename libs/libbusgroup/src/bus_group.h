@@ -5,8 +5,9 @@
  * This file include the declaration of pin constraints
  *******************************************************************/
 #include <array>
-#include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_vector.h"
@@ -57,7 +58,7 @@ class BusGroup {
   bool is_big_endian(const BusGroupId& bus_id) const;
 
   /* Get the pins under a specific bus */
-  std::vector<BusPinId> bus_pins(const BusGroupId& bus_id) const;
+  const std::vector<BusPinId>& bus_pins(const BusGroupId& bus_id) const;
 
   /* Get the index of a pin */
   int pin_index(const BusPinId& pin_id) const;
@@ -129,8 +130,8 @@ class BusGroup {
   vtr::vector<BusPinId, BusGroupId> pin_parent_bus_ids_;
 
   /* Fast look-up */
-  std::map<std::string, BusGroupId> bus_name2id_map_;
-  std::map<std::string, BusPinId> pin_name2id_map_;
+  std::unordered_map<std::string, BusGroupId> bus_name2id_map_;
+  std::unordered_map<std::string, BusPinId> pin_name2id_map_;
 };
 
 }  // End of namespace openfpga
@@ -185,8 +185,12 @@ int write_xml_fabric_key(const char* fname, const FabricKey& fabric_key) {
   /* Validate the file stream */
   openfpga::check_file_stream(fname, fp);
 
-  /* Write the root node */
-  fp << "<fabric_key>"
+  /* Write the root node. The sizes of the fabric key are given so that
+   * readers can reserve memory in advance */
+  fp << "<fabric_key";
+  write_xml_attribute(fp, "num_regions", fabric_key.regions().size());
+  write_xml_attribute(fp, "num_keys", fabric_key.keys().size());
+  fp << ">"
      << "\n";
 
   int err_code = 0;
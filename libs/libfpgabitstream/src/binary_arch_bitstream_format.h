@@ -0,0 +1,32 @@
+#ifndef BINARY_ARCH_BITSTREAM_FORMAT_H
+#define BINARY_ARCH_BITSTREAM_FORMAT_H
+
+/********************************************************************
+ * Constants of the binary file format of architecture bitstreams,
+ * which are shared by the reader and the writer.
+ * The file is organized as follows, where all the integers are
+ * unsigned and in little endian, unless specified otherwise
+ *   <magic 4 bytes><version 4 bytes>
+ *   <num_blocks 8 bytes><num_bits 8 bytes>
+ *   For each block, in the sequence of block ids:
+ *     <lsb bit id 8 bytes><num_bits 4 bytes><path id 4 bytes (signed)>
+ *     <name length 4 bytes><name>
+ *     <input net ids length 4 bytes><input net ids>
+ *     <output net ids length 4 bytes><output net ids>
+ *   For each block, in the sequence of block ids:
+ *     <num_children 4 bytes><child block id 8 bytes>...
+ *   <bit values, packed by 64 bits per word, (num_bits + 63) / 64 words>
+ * The lsb bit id of a block without bits is BINARY_ARCH_BITSTREAM_NO_BIT
+ *******************************************************************/
+#include <cstdint>
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr char BINARY_ARCH_BITSTREAM_MAGIC[] = "OABS";
+constexpr uint32_t BINARY_ARCH_BITSTREAM_VERSION = 1;
+constexpr uint64_t BINARY_ARCH_BITSTREAM_NO_BIT = UINT64_MAX;
+
+} /* end namespace openfpga */
+
+#endif
@@ -4,7 +4,9 @@
 #include "bitstream_manager.h"
 
 #include <algorithm>
+#include <atomic>
 
+#include "openfpga_memory_usage.h"
 #include "vtr_assert.h"
 
 /* begin namespace openfpga */
@@ -18,6 +20,8 @@ BitstreamManager::BitstreamManager() {
   num_bits_ = 0;
   invalid_block_ids_.clear();
   invalid_bit_ids_.clear();
+  /* Blocks are created with an empty name */
+  intern_block_name(std::string());
 }
 
 /**************************************************
@@ -32,6 +36,12 @@ BitstreamManager::config_bit_range BitstreamManager::bits() const {
     config_bit_iterator(ConfigBitId(num_bits_), invalid_bit_ids_));
 }
 
+BitstreamManager::config_bit_dense_range BitstreamManager::dense_bits() const {
+  VTR_ASSERT(true == invalid_bit_ids_.empty());
+  return vtr::make_range(config_bit_dense_iterator(ConfigBitId(0)),
+                         config_bit_dense_iterator(ConfigBitId(num_bits_)));
+}
+
 size_t BitstreamManager::num_blocks() const { return num_blocks_; }
 
 /* Find all the configuration blocks */
@@ -48,7 +58,11 @@ bool BitstreamManager::bit_value(const ConfigBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return '1' == bit_values_[bit_id];
+  return 1 == ((bit_values_[size_t(bit_id) / 64] >> (size_t(bit_id) % 64)) & 1);
+}
+
+const std::vector<uint64_t>& BitstreamManager::bit_value_words() const {
+  return bit_values_;
 }
 
 ConfigBlockId BitstreamManager::bit_parent_block(
@@ -56,14 +70,28 @@ ConfigBlockId BitstreamManager::bit_parent_block(
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return bit_parent_blocks_[bit_id];
+  /* Find the last block whose first bit is not after the bit */
+  auto result = std::upper_bound(
+    bit_blocks_.begin(), bit_blocks_.end(), size_t(bit_id),
+    [&](const size_t& bit, const ConfigBlockId& block) {
+      return bit < block_bit_id_lsbs_[block];
+    });
+  VTR_ASSERT(result != bit_blocks_.begin());
+  return *(result - 1);
 }
 
-std::string BitstreamManager::block_name(const ConfigBlockId& block_id) const {
+size_t BitstreamManager::bit_index_in_parent_block(
+  const ConfigBitId& bit_id) const {
+  /* The bits of a block are contiguous, starting from its lsb */
+  return size_t(bit_id) - block_bit_id_lsbs_[bit_parent_block(bit_id)];
+}
+
+const std::string& BitstreamManager::block_name(
+  const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
-  return block_names_[block_id];
+  return block_name_pool_[block_name_ids_[block_id]];
 }
 
 ConfigBlockId BitstreamManager::block_parent(
@@ -74,12 +102,93 @@ ConfigBlockId BitstreamManager::block_parent(
   return parent_block_ids_[block_id];
 }
 
+ConfigBlockId BitstreamManager::block_top(
+  const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  ConfigBlockId top_block = block_id;
+  while (true == parent_block_ids_[top_block].is_valid()) {
+    top_block = parent_block_ids_[top_block];
+  }
+  return top_block;
+}
+
+size_t BitstreamManager::block_depth(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  size_t depth = 0;
+  for (ConfigBlockId parent = parent_block_ids_[block_id];
+       true == parent.is_valid(); parent = parent_block_ids_[parent]) {
+    depth++;
+  }
+  return depth;
+}
+
+std::string BitstreamManager::block_path(const ConfigBlockId& block_id) const {
+  std::string path;
+  append_block_path(path, block_id);
+  return path;
+}
+
+void BitstreamManager::append_block_path(std::string& path,
+                                         const ConfigBlockId& block_id,
+                                         const bool& skip_top_block) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  /* Find the length of the path at first, so that the path is filled from
+   * its tail to its head while walking up again, without a stack of the
+   * blocks */
+  size_t path_length = 0;
+  for (ConfigBlockId block = block_id; true == block.is_valid();
+       block = parent_block_ids_[block]) {
+    if ((true == skip_top_block) &&
+        (false == parent_block_ids_[block].is_valid())) {
+      break;
+    }
+    path_length += block_name(block).size() + 1;
+  }
+  if (0 == path_length) {
+    return;
+  }
+  /* No dot is before the first block */
+  path_length--;
+
+  size_t path_end = path.size() + path_length;
+  path.resize(path_end);
+  for (ConfigBlockId block = block_id; true == block.is_valid();
+       block = parent_block_ids_[block]) {
+    if ((true == skip_top_block) &&
+        (false == parent_block_ids_[block].is_valid())) {
+      break;
+    }
+    const std::string& name = block_name(block);
+    path_end -= name.size();
+    path.replace(path_end, name.size(), name);
+    if (path_end > path.size() - path_length) {
+      path[--path_end] = '.';
+    }
+  }
+}
+
 std::vector<ConfigBlockId> BitstreamManager::block_children(
   const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
-  return child_block_ids_[block_id];
+  auto children = child_block_span(block_id);
+  return std::vector<ConfigBlockId>(children.first, children.second);
+}
+
+size_t BitstreamManager::block_num_children(
+  const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  auto children = child_block_span(block_id);
+  return children.second - children.first;
 }
 
 std::vector<ConfigBitId> BitstreamManager::block_bits(
@@ -103,27 +212,65 @@ std::vector<ConfigBitId> BitstreamManager::block_bits(
   return bits;
 }
 
+size_t BitstreamManager::block_num_bits(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  return block_bit_lengths_[block_id];
+}
+
+ConfigBitId BitstreamManager::block_lsb_bit(
+  const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+  VTR_ASSERT(0 < block_bit_lengths_[block_id]);
+
+  return ConfigBitId(block_bit_id_lsbs_[block_id]);
+}
+
 /* Find the child block in a bitstream manager with a given name */
 ConfigBlockId BitstreamManager::find_child_block(
   const ConfigBlockId& block_id, const std::string& child_block_name) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
-  std::vector<ConfigBlockId> candidates;
+  /* A name which is not in the pool is not used by any block */
+  auto result = block_name_pool_ids_.find(child_block_name);
+  if (result == block_name_pool_ids_.end()) {
+    return ConfigBlockId::INVALID();
+  }
 
-  for (const ConfigBlockId& child : block_children(block_id)) {
-    if (0 == child_block_name.compare(block_name(child))) {
-      candidates.push_back(child);
+  /* Packed children are sorted by names, whose ids are unique among the
+   * children of a block */
+  if (false == child_block_offsets_.empty()) {
+    auto begin = packed_child_block_ids_by_name_.begin() +
+                 child_block_offsets_[size_t(block_id)];
+    auto end = packed_child_block_ids_by_name_.begin() +
+               child_block_offsets_[size_t(block_id) + 1];
+    auto child = std::lower_bound(
+      begin, end, result->second,
+      [&](const ConfigBlockId& block, const size_t& name_id) {
+        return block_name_ids_[block] < name_id;
+      });
+    if (child == end || result->second != block_name_ids_[*child]) {
+      return ConfigBlockId::INVALID();
     }
+    return *child;
   }
 
-  /* We should have 0 or 1 candidate! */
-  VTR_ASSERT(0 == candidates.size() || 1 == candidates.size());
-  if (0 == candidates.size()) {
-    /* Not found, return an invalid value */
-    return ConfigBlockId::INVALID();
+  /* Names are compared by their ids in the pool */
+  ConfigBlockId candidate = ConfigBlockId::INVALID();
+  auto children = child_block_span(block_id);
+  for (const ConfigBlockId* child = children.first; child != children.second;
+       ++child) {
+    if (result->second == block_name_ids_[*child]) {
+      /* We should have 0 or 1 candidate! */
+      VTR_ASSERT(ConfigBlockId::INVALID() == candidate);
+      candidate = *child;
+    }
   }
-  return candidates[0];
+
+  return candidate;
 }
 
 int BitstreamManager::block_path_id(const ConfigBlockId& block_id) const {
@@ -149,27 +296,70 @@ std::string BitstreamManager::block_output_net_ids(
   return block_output_net_ids_[block_id];
 }
 
+bool BitstreamManager::record_net_ids() const { return record_net_ids_; }
+
+/* Stamps are taken on demand, so that building a database does not touch a
+ * counter shared by all the threads for each block */
+size_t BitstreamManager::stamp() const {
+  static std::atomic<size_t> num_stamps(0);
+  if (0 == stamp_) {
+    stamp_ = ++num_stamps;
+  }
+  return stamp_;
+}
+
+size_t BitstreamManager::update_generation() const {
+  return update_generation_;
+}
+
+/* Estimate the memory used by the bitstream manager, in bytes */
+size_t BitstreamManager::memory_usage() const {
+  return sizeof(BitstreamManager) + heap_memory_usage(invalid_block_ids_) +
+         heap_memory_usage(block_bit_id_lsbs_) +
+         heap_memory_usage(block_bit_lengths_) +
+         heap_memory_usage(block_name_ids_) +
+         heap_memory_usage(block_name_pool_) +
+         heap_memory_usage(block_name_pool_ids_) +
+         heap_memory_usage(parent_block_ids_) +
+         heap_memory_usage(child_block_ids_) +
+         heap_memory_usage(child_block_offsets_) +
+         heap_memory_usage(packed_child_block_ids_) +
+         heap_memory_usage(packed_child_block_ids_by_name_) +
+         heap_memory_usage(block_path_ids_) +
+         heap_memory_usage(block_input_net_ids_) +
+         heap_memory_usage(block_output_net_ids_) +
+         heap_memory_usage(invalid_bit_ids_) + heap_memory_usage(bit_values_) +
+         heap_memory_usage(bit_blocks_);
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
 ConfigBitId BitstreamManager::add_bit(const ConfigBlockId& parent_block,
                                       const bool& bit_value) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(parent_block));
+
   ConfigBitId bit = ConfigBitId(num_bits_);
-  /* Add a new bit, and allocate associated data structures */
-  num_bits_++;
-  if (true == bit_value) {
-    bit_values_.push_back('1');
-  } else {
-    bit_values_.push_back('0');
+
+  /* Register the bit in the range of its parent block. The bits of a block
+   * must be contiguous */
+  if (0 == block_bit_lengths_[parent_block]) {
+    block_bit_id_lsbs_[parent_block] = num_bits_;
+    bit_blocks_.push_back(parent_block);
   }
+  VTR_ASSERT(num_bits_ == block_bit_id_lsbs_[parent_block] +
+                            block_bit_lengths_[parent_block]);
+  block_bit_lengths_[parent_block]++;
 
-  bit_parent_blocks_.push_back(parent_block);
+  /* Add a new bit, and allocate associated data structures */
+  add_bit_values(uint64_t(bit_value), 1);
 
   return bit;
 }
 
 void BitstreamManager::reserve_blocks(const size_t& num_blocks) {
-  block_names_.reserve(num_blocks);
+  block_name_ids_.reserve(num_blocks);
   block_bit_id_lsbs_.reserve(num_blocks);
   block_bit_lengths_.reserve(num_blocks);
   block_path_ids_.reserve(num_blocks);
@@ -180,14 +370,19 @@ void BitstreamManager::reserve_blocks(const size_t& num_blocks) {
 }
 
 void BitstreamManager::reserve_bits(const size_t& num_bits) {
-  bit_values_.reserve(num_bits);
+  bit_values_.reserve((num_bits + 63) / 64);
 }
 
 ConfigBlockId BitstreamManager::create_block() {
+  expand_child_blocks();
+
   ConfigBlockId block = ConfigBlockId(num_blocks_);
+  invalidate_stamp();
+
   /* Add a new bit, and allocate associated data structures */
   num_blocks_++;
-  block_names_.emplace_back();
+  /* The empty name is always the first in the pool */
+  block_name_ids_.push_back(0);
   block_bit_id_lsbs_.emplace_back(-1);
   block_bit_lengths_.emplace_back(0);
   block_path_ids_.push_back(-2);
@@ -210,7 +405,12 @@ void BitstreamManager::set_block_name(const ConfigBlockId& block_id,
                                       const std::string& block_name) {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
-  block_names_[block_id] = block_name;
+
+  /* Renaming a block breaks the order of packed children */
+  expand_child_blocks();
+  invalidate_stamp();
+
+  block_name_ids_[block_id] = intern_block_name(block_name);
 }
 
 void BitstreamManager::reserve_child_blocks(const ConfigBlockId& parent_block,
@@ -218,6 +418,8 @@ void BitstreamManager::reserve_child_blocks(const ConfigBlockId& parent_block,
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(parent_block));
 
+  expand_child_blocks();
+
   /* Add the child_block to the parent_block */
   child_block_ids_[parent_block].reserve(num_children);
 }
@@ -228,15 +430,15 @@ void BitstreamManager::add_child_block(const ConfigBlockId& parent_block,
   VTR_ASSERT(true == valid_block_id(parent_block));
   VTR_ASSERT(true == valid_block_id(child_block));
 
-  /* We should have only a parent block for each block! */
+  /* We should have only a parent block for each block!
+   * This also ensures that the child block is not in the list of children of
+   * the parent block yet, so the list does not have to be searched, which is
+   * slow for blocks with many children
+   */
   VTR_ASSERT(ConfigBlockId::INVALID() == parent_block_ids_[child_block]);
 
-  /* Ensure the child block is not in the list of children of the parent block
-   */
-  std::vector<ConfigBlockId>::iterator it =
-    std::find(child_block_ids_[parent_block].begin(),
-              child_block_ids_[parent_block].end(), child_block);
-  VTR_ASSERT(it == child_block_ids_[parent_block].end());
+  expand_child_blocks();
+  invalidate_stamp();
 
   /* Add the child_block to the parent_block */
   child_block_ids_[parent_block].push_back(child_block);
@@ -244,17 +446,100 @@ void BitstreamManager::add_child_block(const ConfigBlockId& parent_block,
   parent_block_ids_[child_block] = parent_block;
 }
 
+void BitstreamManager::compact_child_blocks() {
+  if (false == child_block_offsets_.empty()) {
+    return;
+  }
+
+  size_t num_children = 0;
+  for (const auto& children : child_block_ids_) {
+    num_children += children.size();
+  }
+
+  child_block_offsets_.reserve(num_blocks_ + 1);
+  packed_child_block_ids_.reserve(num_children);
+  for (const auto& children : child_block_ids_) {
+    child_block_offsets_.push_back(packed_child_block_ids_.size());
+    packed_child_block_ids_.insert(packed_child_block_ids_.end(),
+                                   children.begin(), children.end());
+  }
+  child_block_offsets_.push_back(packed_child_block_ids_.size());
+
+  /* Index the children of each block by their names */
+  packed_child_block_ids_by_name_ = packed_child_block_ids_;
+  for (size_t iblock = 0; iblock < num_blocks_; ++iblock) {
+    auto begin =
+      packed_child_block_ids_by_name_.begin() + child_block_offsets_[iblock];
+    auto end = packed_child_block_ids_by_name_.begin() +
+               child_block_offsets_[iblock + 1];
+    std::sort(begin, end,
+              [&](const ConfigBlockId& lhs, const ConfigBlockId& rhs) {
+                return block_name_ids_[lhs] < block_name_ids_[rhs];
+              });
+  }
+
+  /* Release the storage of each block */
+  vtr::vector<ConfigBlockId, std::vector<ConfigBlockId>>().swap(
+    child_block_ids_);
+}
+
 void BitstreamManager::add_block_bits(
   const ConfigBlockId& block, const std::vector<bool>& block_bitstream) {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block));
 
+  /* A block can only get its bits once */
+  VTR_ASSERT(0 == block_bit_lengths_[block]);
+
   /* Add the bit to the block, record anchors in bit indexing for block-level
    * searching */
   block_bit_id_lsbs_[block] = num_bits_;
   block_bit_lengths_[block] = block_bitstream.size();
+  if (0 < block_bitstream.size()) {
+    bit_blocks_.push_back(block);
+  }
+
+  /* Pack the bits into words, and add them a word at a time */
+  uint64_t word = 0;
+  size_t word_length = 0;
   for (const bool& bit : block_bitstream) {
-    add_bit(block, bit);
+    word |= uint64_t(bit) << word_length;
+    word_length++;
+    if (64 == word_length) {
+      add_bit_values(word, word_length);
+      word = 0;
+      word_length = 0;
+    }
+  }
+  if (0 < word_length) {
+    add_bit_values(word, word_length);
+  }
+}
+
+void BitstreamManager::add_block_bits(
+  const ConfigBlockId& block, const std::vector<uint64_t>& block_bit_words,
+  const size_t& num_bits) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block));
+  VTR_ASSERT((num_bits + 63) / 64 == block_bit_words.size());
+
+  /* A block can only get its bits once */
+  VTR_ASSERT(0 == block_bit_lengths_[block]);
+
+  block_bit_id_lsbs_[block] = num_bits_;
+  block_bit_lengths_[block] = num_bits;
+  if (0 < num_bits) {
+    bit_blocks_.push_back(block);
+  }
+
+  for (size_t iword = 0; iword < block_bit_words.size(); ++iword) {
+    size_t num_word_bits = std::min(size_t(64), num_bits - iword * 64);
+    /* Drop the unused bits of the last word */
+    uint64_t word = block_bit_words[iword];
+    if (64 > num_word_bits) {
+      word &= (uint64_t(1) << num_word_bits) - 1;
+    }
+    add_bit_values(word, num_word_bits);
   }
 }
 
@@ -285,6 +570,247 @@ void BitstreamManager::add_output_net_id_to_block(
   block_output_net_ids_[block] = output_net_id;
 }
 
+void BitstreamManager::set_record_net_ids(const bool& enabled) {
+  record_net_ids_ = enabled;
+}
+
+void BitstreamManager::add_child_bitstream(
+  const ConfigBlockId& parent_block, const BitstreamManager& child_bitstream,
+  const ConfigBlockId& child_top_block) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(parent_block));
+  VTR_ASSERT(true == child_bitstream.valid_block_id(child_top_block));
+  /* The top block is replaced by the parent block, so it can not own bits */
+  VTR_ASSERT(0 == child_bitstream.block_bit_lengths_[child_top_block]);
+  VTR_ASSERT(true == child_bitstream.invalid_block_ids_.empty());
+
+  expand_child_blocks();
+
+  /* Find the ids of the names of the child bitstream in the pool here */
+  std::vector<size_t> name_ids;
+  name_ids.reserve(child_bitstream.block_name_pool_.size());
+  for (const std::string& name : child_bitstream.block_name_pool_) {
+    name_ids.push_back(intern_block_name(name));
+  }
+
+  /* Find the id of a block of the child bitstream in this bitstream */
+  size_t block_offset = num_blocks_;
+  size_t bit_offset = num_bits_;
+  auto new_block_id = [&](const ConfigBlockId& child_block) {
+    if (child_block == child_top_block) {
+      return parent_block;
+    }
+    if (false == child_bitstream.valid_block_id(child_block)) {
+      return ConfigBlockId::INVALID();
+    }
+    size_t block_index = size_t(child_block);
+    if (block_index > size_t(child_top_block)) {
+      block_index--;
+    }
+    return ConfigBlockId(block_offset + block_index);
+  };
+
+  for (const ConfigBlockId& child_block : child_bitstream.blocks()) {
+    if (child_block == child_top_block) {
+      continue;
+    }
+    ConfigBlockId block = create_block();
+    VTR_ASSERT(block == new_block_id(child_block));
+    block_name_ids_[block] =
+      name_ids[child_bitstream.block_name_ids_[child_block]];
+    block_bit_lengths_[block] = child_bitstream.block_bit_lengths_[child_block];
+    if (0 < block_bit_lengths_[block]) {
+      block_bit_id_lsbs_[block] =
+        bit_offset + child_bitstream.block_bit_id_lsbs_[child_block];
+    }
+    block_path_ids_[block] = child_bitstream.block_path_ids_[child_block];
+    block_input_net_ids_[block] =
+      child_bitstream.block_input_net_ids_[child_block];
+    block_output_net_ids_[block] =
+      child_bitstream.block_output_net_ids_[child_block];
+    parent_block_ids_[block] =
+      new_block_id(child_bitstream.parent_block_ids_[child_block]);
+    auto grandchildren = child_bitstream.child_block_span(child_block);
+    child_block_ids_[block].reserve(grandchildren.second -
+                                    grandchildren.first);
+    for (const ConfigBlockId* grandchild = grandchildren.first;
+         grandchild != grandchildren.second; ++grandchild) {
+      child_block_ids_[block].push_back(new_block_id(*grandchild));
+    }
+  }
+
+  /* Register the children of the top block under the parent block */
+  auto top_children = child_bitstream.child_block_span(child_top_block);
+  for (const ConfigBlockId* child_block = top_children.first;
+       child_block != top_children.second; ++child_block) {
+    child_block_ids_[parent_block].push_back(new_block_id(*child_block));
+  }
+
+  /* Append the bits, which are already in the sequence of their blocks */
+  for (const ConfigBlockId& child_block : child_bitstream.bit_blocks_) {
+    bit_blocks_.push_back(new_block_id(child_block));
+  }
+  for (size_t iword = 0; iword < child_bitstream.bit_values_.size(); ++iword) {
+    size_t num_word_bits =
+      std::min(size_t(64), child_bitstream.num_bits_ - iword * 64);
+    add_bit_values(child_bitstream.bit_values_[iword], num_word_bits);
+  }
+}
+
+bool BitstreamManager::update_block_bits(
+  const ConfigBlockId& block, const BitstreamManager& bitstream_manager,
+  const ConfigBlockId& src_block, size_t& num_changed_bits) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block));
+  VTR_ASSERT(true == bitstream_manager.valid_block_id(src_block));
+
+  if (false == same_block_hierarchy(block, bitstream_manager, src_block)) {
+    return false;
+  }
+
+  /* Walk through both sub-hierarchies in the same order */
+  size_t num_flipped_bits = 0;
+  std::vector<std::pair<ConfigBlockId, ConfigBlockId>> blocks_to_visit;
+  blocks_to_visit.emplace_back(block, src_block);
+  while (false == blocks_to_visit.empty()) {
+    ConfigBlockId curr_block = blocks_to_visit.back().first;
+    ConfigBlockId curr_src_block = blocks_to_visit.back().second;
+    blocks_to_visit.pop_back();
+
+    block_path_ids_[curr_block] =
+      bitstream_manager.block_path_ids_[curr_src_block];
+    block_input_net_ids_[curr_block] =
+      bitstream_manager.block_input_net_ids_[curr_src_block];
+    block_output_net_ids_[curr_block] =
+      bitstream_manager.block_output_net_ids_[curr_src_block];
+
+    for (size_t ibit = 0; ibit < size_t(block_bit_lengths_[curr_block]);
+         ++ibit) {
+      size_t bit = block_bit_id_lsbs_[curr_block] + ibit;
+      size_t src_bit = bitstream_manager.block_bit_id_lsbs_[curr_src_block] +
+                       ibit;
+      uint64_t src_value =
+        (bitstream_manager.bit_values_[src_bit / 64] >> (src_bit % 64)) & 1;
+      if (src_value != ((bit_values_[bit / 64] >> (bit % 64)) & 1)) {
+        bit_values_[bit / 64] ^= uint64_t(1) << (bit % 64);
+        num_flipped_bits++;
+      }
+    }
+
+    auto children = child_block_span(curr_block);
+    auto src_children = bitstream_manager.child_block_span(curr_src_block);
+    for (size_t ichild = 0; ichild < size_t(children.second - children.first);
+         ++ichild) {
+      blocks_to_visit.emplace_back(children.first[ichild],
+                                   src_children.first[ichild]);
+    }
+  }
+
+  if (0 < num_flipped_bits) {
+    update_generation_++;
+  }
+  num_changed_bits += num_flipped_bits;
+
+  return true;
+}
+
+/******************************************************************************
+ * Private Accessors
+ ******************************************************************************/
+std::pair<const ConfigBlockId*, const ConfigBlockId*>
+BitstreamManager::child_block_span(const ConfigBlockId& block_id) const {
+  if (true == child_block_offsets_.empty()) {
+    const std::vector<ConfigBlockId>& children = child_block_ids_[block_id];
+    return std::make_pair(children.data(), children.data() + children.size());
+  }
+  const ConfigBlockId* packed_children = packed_child_block_ids_.data();
+  return std::make_pair(
+    packed_children + child_block_offsets_[size_t(block_id)],
+    packed_children + child_block_offsets_[size_t(block_id) + 1]);
+}
+
+bool BitstreamManager::same_block_hierarchy(
+  const ConfigBlockId& block_id, const BitstreamManager& bitstream_manager,
+  const ConfigBlockId& other_block_id) const {
+  std::vector<std::pair<ConfigBlockId, ConfigBlockId>> blocks_to_visit;
+  blocks_to_visit.emplace_back(block_id, other_block_id);
+  while (false == blocks_to_visit.empty()) {
+    ConfigBlockId curr_block = blocks_to_visit.back().first;
+    ConfigBlockId curr_other_block = blocks_to_visit.back().second;
+    blocks_to_visit.pop_back();
+
+    auto children = child_block_span(curr_block);
+    auto other_children = bitstream_manager.child_block_span(curr_other_block);
+    if ((block_bit_lengths_[curr_block] !=
+         bitstream_manager.block_bit_lengths_[curr_other_block]) ||
+        (children.second - children.first !=
+         other_children.second - other_children.first) ||
+        (block_name(curr_block) !=
+         bitstream_manager.block_name(curr_other_block))) {
+      return false;
+    }
+    for (size_t ichild = 0; ichild < size_t(children.second - children.first);
+         ++ichild) {
+      blocks_to_visit.emplace_back(children.first[ichild],
+                                   other_children.first[ichild]);
+    }
+  }
+
+  return true;
+}
+
+/******************************************************************************
+ * Private Mutators
+ ******************************************************************************/
+/* Append the lowest bits of a word to the bit values */
+void BitstreamManager::add_bit_values(const uint64_t& word,
+                                      const size_t& num_bits) {
+  VTR_ASSERT(0 < num_bits && 64 >= num_bits);
+  invalidate_stamp();
+  size_t offset = num_bits_ % 64;
+  if (0 == offset) {
+    bit_values_.push_back(word);
+  } else {
+    bit_values_.back() |= word << offset;
+    /* Spill the rest of the bits to a new word */
+    if (64 < offset + num_bits) {
+      bit_values_.push_back(word >> (64 - offset));
+    }
+  }
+  num_bits_ += num_bits;
+}
+
+size_t BitstreamManager::intern_block_name(const std::string& block_name) {
+  auto result =
+    block_name_pool_ids_.emplace(block_name, block_name_pool_.size());
+  if (true == result.second) {
+    block_name_pool_.push_back(block_name);
+  }
+  return result.first->second;
+}
+
+void BitstreamManager::invalidate_stamp() {
+  stamp_ = 0;
+  update_generation_ = 0;
+}
+
+void BitstreamManager::expand_child_blocks() {
+  if (true == child_block_offsets_.empty()) {
+    return;
+  }
+
+  child_block_ids_.resize(num_blocks_);
+  for (size_t iblock = 0; iblock < num_blocks_; ++iblock) {
+    child_block_ids_[ConfigBlockId(iblock)].assign(
+      packed_child_block_ids_.begin() + child_block_offsets_[iblock],
+      packed_child_block_ids_.begin() + child_block_offsets_[iblock + 1]);
+  }
+
+  child_block_offsets_.clear();
+  packed_child_block_ids_.clear();
+  packed_child_block_ids_by_name_.clear();
+}
+
 /******************************************************************************
  * Public Validators
  ******************************************************************************/
@@ -301,4 +827,36 @@ bool BitstreamManager::valid_block_path_id(
   return (true == valid_block_id(block_id)) && (-2 != block_path_id(block_id));
 }
 
+bool BitstreamManager::same_blocks(
+  const BitstreamManager& bitstream_manager) const {
+  if ((num_blocks_ != bitstream_manager.num_blocks_) ||
+      (num_bits_ != bitstream_manager.num_bits_) ||
+      (invalid_block_ids_ != bitstream_manager.invalid_block_ids_) ||
+      (false == std::equal(parent_block_ids_.begin(), parent_block_ids_.end(),
+                           bitstream_manager.parent_block_ids_.begin())) ||
+      (false ==
+       std::equal(block_bit_lengths_.begin(), block_bit_lengths_.end(),
+                  bitstream_manager.block_bit_lengths_.begin())) ||
+      (bit_blocks_ != bitstream_manager.bit_blocks_)) {
+    return false;
+  }
+
+  /* Name ids depend on the order that names are added to each pool, so the
+   * names themselves are compared. Children may be packed in either one */
+  for (size_t iblock = 0; iblock < num_blocks_; ++iblock) {
+    ConfigBlockId block(iblock);
+    if (block_name(block) != bitstream_manager.block_name(block)) {
+      return false;
+    }
+    auto children = child_block_span(block);
+    auto other_children = bitstream_manager.child_block_span(block);
+    if (false == std::equal(children.first, children.second,
+                            other_children.first, other_children.second)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 } /* end namespace openfpga */
@@ -37,12 +37,16 @@
 #ifndef BITSTREAM_MANAGER_H
 #define BITSTREAM_MANAGER_H
 
+#include <cstdint>
 #include <map>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "bitstream_manager_fwd.h"
+#include "openfpga_dense_id_iterator.h"
 #include "vtr_vector.h"
 
 /* begin namespace openfpga */
@@ -122,12 +126,18 @@ class BitstreamManager {
   typedef lazy_id_iterator<ConfigBlockId> config_block_iterator;
 
   typedef vtr::Range<config_bit_iterator> config_bit_range;
+  typedef dense_id_iterator<ConfigBitId> config_bit_dense_iterator;
+  typedef vtr::Range<config_bit_dense_iterator> config_bit_dense_range;
   typedef vtr::Range<config_block_iterator> config_block_range;
 
  public: /* Public aggregators */
   /* Find all the configuration bits */
   size_t num_bits() const;
   config_bit_range bits() const;
+  /* Find all the configuration bits, without checking invalid ids.
+   * Bits are never removed, so this is always safe and faster than bits()
+   */
+  config_bit_dense_range dense_bits() const;
 
   size_t num_blocks() const;
   config_block_range blocks() const;
@@ -136,22 +146,65 @@ class BitstreamManager {
   /* Find the value of bitstream */
   bool bit_value(const ConfigBitId& bit_id) const;
 
+  /* The values of all the bits, packed by 64 bits per word, where the value
+   * of bit i is the (i % 64)-th bit of the (i / 64)-th word. It is a view of
+   * the internal storage, so that the values are read without any copy */
+  const std::vector<uint64_t>& bit_value_words() const;
+
   /* Find the parent block of a configuration bit */
   ConfigBlockId bit_parent_block(const ConfigBitId& bit_id) const;
 
+  /* Find the index of a configuration bit among the bits of its parent
+   * block. A bit is thus addressed by the path of its parent block and
+   * this index, e.g., <block_path>.mem_out[<index>] */
+  size_t bit_index_in_parent_block(const ConfigBitId& bit_id) const;
+
   /* Find a name of a block */
-  std::string block_name(const ConfigBlockId& block_id) const;
+  const std::string& block_name(const ConfigBlockId& block_id) const;
 
   /* Find the parent of a block */
   ConfigBlockId block_parent(const ConfigBlockId& block_id) const;
 
+  /* Find the top block of the hierarchy where a block locates */
+  ConfigBlockId block_top(const ConfigBlockId& block_id) const;
+
+  /* Find the number of parents of a block, i.e., 0 for a top block */
+  size_t block_depth(const ConfigBlockId& block_id) const;
+
+  /* Find the hierarchical path of a block, which is the names of the blocks
+   * from the top block to the block, separated by dots, e.g.,
+   * <top>.<block>.<block>
+   * The blocks form a trie of the paths, where each block only stores its
+   * parent and the id of its name in the pool, and a path is generated on
+   * demand by walking up to the top block. No per-block path is stored.
+   */
+  std::string block_path(const ConfigBlockId& block_id) const;
+
+  /* Append the hierarchical path of a block to a string, so that a caller
+   * builds the paths of many blocks in the same buffer without any other
+   * memory allocated. The top block is skipped on request, e.g., to be
+   * replaced by the instance name of a fabric in a testbench, where the path
+   * of a top block is empty */
+  void append_block_path(std::string& path, const ConfigBlockId& block_id,
+                         const bool& skip_top_block = false) const;
+
   /* Find the children of a block */
   std::vector<ConfigBlockId> block_children(
     const ConfigBlockId& block_id) const;
 
+  /* Find the number of children of a block */
+  size_t block_num_children(const ConfigBlockId& block_id) const;
+
   /* Find all the bits that belong to a block */
   std::vector<ConfigBitId> block_bits(const ConfigBlockId& block_id) const;
 
+  /* Find the number of bits that belong to a block */
+  size_t block_num_bits(const ConfigBlockId& block_id) const;
+
+  /* Find the first bit that belongs to a block, which is only valid when
+   * the block owns bits */
+  ConfigBitId block_lsb_bit(const ConfigBlockId& block_id) const;
+
   /* Find the child block in a bitstream manager with a given name */
   ConfigBlockId find_child_block(const ConfigBlockId& block_id,
                                  const std::string& child_block_name) const;
@@ -162,11 +215,30 @@ class BitstreamManager {
   /* Find input net ids of a block */
   std::string block_input_net_ids(const ConfigBlockId& block_id) const;
 
+  /* Check if the net ids of blocks are recorded, see set_record_net_ids() */
+  bool record_net_ids() const;
+
   /* Find input net ids of a block */
   std::string block_output_net_ids(const ConfigBlockId& block_id) const;
 
+  /* Estimate the memory used by the bitstream manager, in bytes */
+  size_t memory_usage() const;
+
+  /* A stamp which identifies the blocks and bits of the database. It is
+   * unique in a process, and is renewed whenever blocks or bits are added,
+   * so that data built on top of the block and bit ids, e.g., a fabric
+   * bitstream, can record it and detect that the database is replaced */
+  size_t stamp() const;
+
+  /* The number of in-place updates which changed bit values since the
+   * blocks and bits of the database were last changed, see
+   * update_block_bits() */
+  size_t update_generation() const;
+
  public: /* Public Mutators */
-  /* Add a new configuration bit to the bitstream manager */
+  /* Add a new configuration bit to the bitstream manager
+   * The bits of a block must be added contiguously
+   */
   ConfigBitId add_bit(const ConfigBlockId& parent_block, const bool& bit_value);
 
   /* Reserve memory for a number of clocks */
@@ -193,10 +265,27 @@ class BitstreamManager {
   void add_child_block(const ConfigBlockId& parent_block,
                        const ConfigBlockId& child_block);
 
+  /* Pack the child blocks of all the blocks into a single array, which
+   * saves a heap allocation per block and is faster to visit.
+   * The children are also indexed by their names, so that finding a child
+   * block by name is a binary search rather than a linear one.
+   * It should be called once all the blocks are added, e.g., at the end of
+   * building a device bitstream. Adding blocks later is still allowed,
+   * which unpacks the child blocks again
+   */
+  void compact_child_blocks();
+
   /* Add a bitstream to a block */
   void add_block_bits(const ConfigBlockId& block,
                       const std::vector<bool>& block_bitstream);
 
+  /* Add a bitstream to a block, which is packed by 64 bits per word in
+   * the same way as the bit values, i.e., bit i is the (i % 64)-th bit of
+   * the (i / 64)-th word */
+  void add_block_bits(const ConfigBlockId& block,
+                      const std::vector<uint64_t>& block_bit_words,
+                      const size_t& num_bits);
+
   /* Add a path id to a block */
   void add_path_id_to_block(const ConfigBlockId& block, const int& path_id);
 
@@ -208,6 +297,39 @@ class BitstreamManager {
   void add_output_net_id_to_block(const ConfigBlockId& block,
                                   const std::string& output_net_id);
 
+  /* Enable or disable recording the input and output net ids of blocks.
+   * The net ids are only used by the writers of the database, while they
+   * take a large part of its memory on large devices. Builders should skip
+   * generating the net ids when they are not recorded. Enabled by default
+   */
+  void set_record_net_ids(const bool& enabled);
+
+  /* Append all the blocks and bits of another bitstream manager, where
+   * the children of its top block become the children of a parent block
+   * here. The top block itself is not copied and should own no bits.
+   * Blocks and bits keep their relative order, so that building parts of
+   * a bitstream separately and then adding them in sequence results in
+   * the same ids as building the whole bitstream in place
+   */
+  void add_child_bitstream(const ConfigBlockId& parent_block,
+                           const BitstreamManager& child_bitstream,
+                           const ConfigBlockId& child_top_block);
+
+  /* Overwrite the bit values and the annotations (path ids and net ids) of
+   * a block and its descendants by those of a block of another bitstream
+   * manager, which should have the same sub-hierarchy, i.e., the same names
+   * and the same number of bits for each block. Block and bit ids are kept,
+   * so that any data built on top of them remains valid, and the update
+   * generation is increased if any bit value is changed.
+   * Return false without changing anything if the sub-hierarchies differ.
+   * Otherwise, the number of bits whose values are changed is added to
+   * num_changed_bits
+   */
+  bool update_block_bits(const ConfigBlockId& block,
+                         const BitstreamManager& bitstream_manager,
+                         const ConfigBlockId& src_block,
+                         size_t& num_changed_bits);
+
  public: /* Public Validators */
   bool valid_bit_id(const ConfigBitId& bit_id) const;
 
@@ -215,6 +337,37 @@ class BitstreamManager {
 
   bool valid_block_path_id(const ConfigBlockId& block_id) const;
 
+  /* Check if another bitstream manager has exactly the same blocks,
+   * i.e., block names, hierarchy and bits of each block, so that their
+   * blocks and bits correspond one to one
+   */
+  bool same_blocks(const BitstreamManager& bitstream_manager) const;
+
+ private: /* Private Accessors */
+  /* Find the first and the past-the-last child blocks of a block, in either
+   * the packed or the unpacked storage */
+  std::pair<const ConfigBlockId*, const ConfigBlockId*> child_block_span(
+    const ConfigBlockId& block_id) const;
+
+  /* Check if a block and a block of another bitstream manager have the same
+   * names, numbers of bits and children, recursively */
+  bool same_block_hierarchy(const ConfigBlockId& block_id,
+                            const BitstreamManager& bitstream_manager,
+                            const ConfigBlockId& other_block_id) const;
+
+ private: /* Private Mutators */
+  /* Append a number of bits, which are the lowest bits of a word */
+  void add_bit_values(const uint64_t& word, const size_t& num_bits);
+
+  /* Find the id of a name in the pool, which is added if not found */
+  size_t intern_block_name(const std::string& block_name);
+
+  /* Move the packed child blocks back to the storage of each block */
+  void expand_child_blocks();
+
+  /* Drop the stamp and the update generation when blocks or bits change */
+  void invalidate_stamp();
+
  private: /* Internal data */
   /* Unique id of a block of bits in the Bitstream */
   size_t num_blocks_;
@@ -230,9 +383,22 @@ class BitstreamManager {
    * can be instanciated Therefore, this block graph can be considered as a
    * flattened graph of ModuleGraph
    */
-  vtr::vector<ConfigBlockId, std::string> block_names_;
+  vtr::vector<ConfigBlockId, size_t> block_name_ids_;
+  /* Each unique block name is stored once, as most of the names repeat across
+   * tiles, e.g., mem_* and mux_* */
+  std::vector<std::string> block_name_pool_;
+  std::unordered_map<std::string, size_t> block_name_pool_ids_;
   vtr::vector<ConfigBlockId, ConfigBlockId> parent_block_ids_;
+  /* Child blocks are stored per block while blocks are added. Once packed,
+   * the children of a block are
+   * packed_child_block_ids_[child_block_offsets_[block],
+   * child_block_offsets_[block + 1]), while child_block_ids_ is empty */
   vtr::vector<ConfigBlockId, std::vector<ConfigBlockId>> child_block_ids_;
+  std::vector<size_t> child_block_offsets_;
+  std::vector<ConfigBlockId> packed_child_block_ids_;
+  /* The same packed child blocks, where the children of each block are
+   * sorted by the ids of their names */
+  std::vector<ConfigBlockId> packed_child_block_ids_by_name_;
 
   /* The ids of the inputs of routing multiplexer blocks which is propagated to
    * outputs By default, it will be -2 (which is invalid) A valid id starts from
@@ -254,13 +420,26 @@ class BitstreamManager {
    */
   vtr::vector<ConfigBlockId, std::string> block_input_net_ids_;
   vtr::vector<ConfigBlockId, std::string> block_output_net_ids_;
+  bool record_net_ids_ = true;
+
+  /* Stamp of the blocks and bits, which is taken on demand. 0 means that
+   * no stamp is taken since the blocks or bits were last changed */
+  mutable size_t stamp_ = 0;
+  size_t update_generation_ = 0;
 
   /* Unique id of a bit in the Bitstream */
   size_t num_bits_;
   std::unordered_set<ConfigBitId> invalid_bit_ids_;
-  /* value of a bit in the Bitstream */
-  vtr::vector<ConfigBitId, char> bit_values_;
-  vtr::vector<ConfigBitId, ConfigBlockId> bit_parent_blocks_;
+  /* value of a bit in the Bitstream, packed by 64 bits per word
+   * The value of bit i is the (i % 64)-th bit of the (i / 64)-th word
+   */
+  std::vector<uint64_t> bit_values_;
+  /* Blocks which own bits, in the sequence of their bits.
+   * Each block owns a contiguous range of bits, starting from
+   * block_bit_id_lsbs_, so the parent block of a bit is found by a
+   * binary search, rather than being stored for each bit
+   */
+  std::vector<ConfigBlockId> bit_blocks_;
 };
 
 } /* end namespace openfpga */
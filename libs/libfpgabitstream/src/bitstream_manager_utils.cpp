@@ -9,6 +9,7 @@
 
 /* Headers from vtrutil library */
 #include "bitstream_manager_utils.h"
+#include "openfpga_parallel.h"
 #include "vtr_assert.h"
 
 /* begin namespace openfpga */
@@ -61,16 +62,7 @@ std::vector<ConfigBlockId> find_bitstream_manager_top_blocks(
  *******************************************************************/
 size_t find_bitstream_manager_config_bit_index_in_parent_block(
   const BitstreamManager& bitstream_manager, const ConfigBitId& bit_id) {
-  size_t curr_index = 0;
-  for (const ConfigBitId& cand_bit : bitstream_manager.block_bits(
-         bitstream_manager.bit_parent_block(bit_id))) {
-    if (cand_bit == bit_id) {
-      break;
-    }
-    curr_index++;
-  }
-
-  return curr_index;
+  return bitstream_manager.bit_index_in_parent_block(bit_id);
 }
 
 /********************************************************************
@@ -99,4 +91,147 @@ size_t rec_find_bitstream_manager_block_sum_of_bits(
   return sum_of_bits;
 }
 
+/********************************************************************
+ * Find the total number of configuration bits under a block and
+ * under each of its child blocks, which are stored in the given vector.
+ * Each block is visited only once, from the leaf blocks to the top
+ *******************************************************************/
+static size_t rec_find_bitstream_manager_blocks_sum_of_bits(
+  const BitstreamManager& bitstream_manager, const ConfigBlockId& block,
+  vtr::vector<ConfigBlockId, size_t>& block_sum_of_bits) {
+  size_t sum_of_bits = bitstream_manager.block_bits(block).size();
+  for (const ConfigBlockId& child_block :
+       bitstream_manager.block_children(block)) {
+    sum_of_bits += rec_find_bitstream_manager_blocks_sum_of_bits(
+      bitstream_manager, child_block, block_sum_of_bits);
+  }
+  block_sum_of_bits[block] = sum_of_bits;
+  return sum_of_bits;
+}
+
+/********************************************************************
+ * Find the total number of configuration bits under every block
+ * in a single bottom-up pass, so that reporting blocks at different
+ * hierarchy levels does not count the bits again and again
+ * The subtrees of the child blocks of top blocks, e.g., tiles, are
+ * independent and are counted in parallel. Each subtree writes
+ * only the entries of its own blocks.
+ *******************************************************************/
+vtr::vector<ConfigBlockId, size_t> find_bitstream_manager_blocks_sum_of_bits(
+  const BitstreamManager& bitstream_manager, const size_t& num_threads) {
+  vtr::vector<ConfigBlockId, size_t> block_sum_of_bits(
+    bitstream_manager.num_blocks(), 0);
+
+  for (const ConfigBlockId& top_block :
+       find_bitstream_manager_top_blocks(bitstream_manager)) {
+    std::vector<ConfigBlockId> child_blocks =
+      bitstream_manager.block_children(top_block);
+    parallel_for_dynamic(child_blocks.size(), num_threads,
+                         [&](const size_t& ichild) {
+                           rec_find_bitstream_manager_blocks_sum_of_bits(
+                             bitstream_manager, child_blocks[ichild],
+                             block_sum_of_bits);
+                         });
+    size_t sum_of_bits = bitstream_manager.block_bits(top_block).size();
+    for (const ConfigBlockId& child_block : child_blocks) {
+      sum_of_bits += block_sum_of_bits[child_block];
+    }
+    block_sum_of_bits[top_block] = sum_of_bits;
+  }
+
+  return block_sum_of_bits;
+}
+
+/********************************************************************
+ * Build the child blocks of a parent block through a number of
+ * independent tasks, e.g., one task per tile of a fabric.
+ * Each task adds its blocks under the block it is given.
+ * - With a single thread, tasks are built in place and in order
+ * - Otherwise, each task builds its blocks into a standalone bitstream
+ *   manager on worker threads, under a placeholder of the parent block.
+ *   The bitstreams are then added to the parent block in the sequence
+ *   of tasks, so that the block and bit ids are the same as those
+ *   built with a single thread
+ *******************************************************************/
+void build_bitstream_manager_child_blocks(
+  BitstreamManager& bitstream_manager, const ConfigBlockId& parent_block,
+  const size_t& num_tasks, const size_t& num_threads,
+  const std::function<void(BitstreamManager&, const ConfigBlockId&,
+                           const size_t&)>& build_task) {
+  VTR_ASSERT(true == bitstream_manager.valid_block_id(parent_block));
+
+  if (1 >= num_threads) {
+    for (size_t itask = 0; itask < num_tasks; ++itask) {
+      build_task(bitstream_manager, parent_block, itask);
+    }
+    return;
+  }
+
+  std::vector<BitstreamManager> task_bitstreams(num_tasks);
+  parallel_for_dynamic(num_tasks, num_threads, [&](const size_t& itask) {
+    task_bitstreams[itask].set_record_net_ids(
+      bitstream_manager.record_net_ids());
+    ConfigBlockId task_parent_block = task_bitstreams[itask].add_block(
+      bitstream_manager.block_name(parent_block));
+    build_task(task_bitstreams[itask], task_parent_block, itask);
+  });
+
+  for (size_t itask = 0; itask < num_tasks; ++itask) {
+    bitstream_manager.add_child_bitstream(parent_block, task_bitstreams[itask],
+                                          ConfigBlockId(0));
+    /* Release the memory as early as possible */
+    task_bitstreams[itask] = BitstreamManager();
+  }
+}
+
+/********************************************************************
+ * Update some child blocks of a parent block in place, by running the
+ * tasks which built them through build_bitstream_manager_child_blocks(),
+ * e.g., for the tiles whose implementation results are changed.
+ * Each task builds its blocks into a standalone bitstream manager on
+ * worker threads. The bits and the annotations of each block are then
+ * copied to the child block with the same name under the parent block,
+ * so that all the block and bit ids are kept.
+ * The number of bits whose values are changed is added to num_changed_bits
+ *
+ * Return false if a task builds a block which is not found, or whose
+ * hierarchy differs from the existing one. The blocks of the previous
+ * tasks may have been updated in this case
+ *******************************************************************/
+bool update_bitstream_manager_child_blocks(
+  BitstreamManager& bitstream_manager, const ConfigBlockId& parent_block,
+  const size_t& num_tasks, const size_t& num_threads,
+  const std::function<void(BitstreamManager&, const ConfigBlockId&,
+                           const size_t&)>& build_task,
+  size_t& num_changed_bits) {
+  VTR_ASSERT(true == bitstream_manager.valid_block_id(parent_block));
+
+  std::vector<BitstreamManager> task_bitstreams(num_tasks);
+  parallel_for_dynamic(num_tasks, num_threads, [&](const size_t& itask) {
+    task_bitstreams[itask].set_record_net_ids(
+      bitstream_manager.record_net_ids());
+    ConfigBlockId task_parent_block = task_bitstreams[itask].add_block(
+      bitstream_manager.block_name(parent_block));
+    build_task(task_bitstreams[itask], task_parent_block, itask);
+  });
+
+  for (size_t itask = 0; itask < num_tasks; ++itask) {
+    const BitstreamManager& task_bitstream = task_bitstreams[itask];
+    for (const ConfigBlockId& task_block :
+         task_bitstream.block_children(ConfigBlockId(0))) {
+      ConfigBlockId block = bitstream_manager.find_child_block(
+        parent_block, task_bitstream.block_name(task_block));
+      if ((false == bitstream_manager.valid_block_id(block)) ||
+          (false == bitstream_manager.update_block_bits(
+                      block, task_bitstream, task_block, num_changed_bits))) {
+        return false;
+      }
+    }
+    /* Release the memory as early as possible */
+    task_bitstreams[itask] = BitstreamManager();
+  }
+
+  return true;
+}
+
 } /* end namespace openfpga */
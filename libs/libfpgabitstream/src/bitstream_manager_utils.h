@@ -4,9 +4,11 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <functional>
 #include <vector>
 
 #include "bitstream_manager.h"
+#include "vtr_vector.h"
 
 /********************************************************************
  * Function declaration
@@ -27,6 +29,22 @@ size_t find_bitstream_manager_config_bit_index_in_parent_block(
 size_t rec_find_bitstream_manager_block_sum_of_bits(
   const BitstreamManager& bitstream_manager, const ConfigBlockId& block);
 
+vtr::vector<ConfigBlockId, size_t> find_bitstream_manager_blocks_sum_of_bits(
+  const BitstreamManager& bitstream_manager, const size_t& num_threads = 1);
+
+void build_bitstream_manager_child_blocks(
+  BitstreamManager& bitstream_manager, const ConfigBlockId& parent_block,
+  const size_t& num_tasks, const size_t& num_threads,
+  const std::function<void(BitstreamManager&, const ConfigBlockId&,
+                           const size_t&)>& build_task);
+
+bool update_bitstream_manager_child_blocks(
+  BitstreamManager& bitstream_manager, const ConfigBlockId& parent_block,
+  const size_t& num_tasks, const size_t& num_threads,
+  const std::function<void(BitstreamManager&, const ConfigBlockId&,
+                           const size_t&)>& build_task,
+  size_t& num_changed_bits);
+
 } /* end namespace openfpga */
 
 #endif
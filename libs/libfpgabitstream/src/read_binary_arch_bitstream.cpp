@@ -0,0 +1,200 @@
+/********************************************************************
+ * This file includes the functions to read a binary file of an
+ * architecture bitstream to the associated data structures.
+ * The file is memory-mapped and decoded in a single pass, so that
+ * loading a large bitstream is much faster than parsing its XML file.
+ * See the file format in binary_arch_bitstream_format.h
+ *******************************************************************/
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+#include "binary_arch_bitstream_format.h"
+#include "read_binary_arch_bitstream.h"
+
+/* Headers from libopenfpgautil */
+#include "openfpga_mapped_file.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A cursor to decode the content of a memory-mapped file in sequence,
+ * which errors out when reading beyond the end of file
+ *******************************************************************/
+class BinaryFileCursor {
+ public:
+  BinaryFileCursor(const char* fname, const MappedFile& file)
+    : fname_(fname),
+      data_(reinterpret_cast<const unsigned char*>(file.data())),
+      size_(file.size()),
+      offset_(0) {}
+
+  /* Read an unsigned integer in little endian */
+  uint64_t read_uint(const size_t& num_bytes) {
+    const unsigned char* bytes = read_bytes(num_bytes);
+    uint64_t value = 0;
+    for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+      value |= uint64_t(bytes[ibyte]) << (8 * ibyte);
+    }
+    return value;
+  }
+
+  /* Read a string led by its length */
+  std::string read_string() {
+    size_t length = read_uint(4);
+    const unsigned char* bytes = read_bytes(length);
+    return std::string(reinterpret_cast<const char*>(bytes), length);
+  }
+
+  /* Skip a number of bytes, and return the start of them */
+  const unsigned char* read_bytes(const size_t& num_bytes) {
+    if (num_bytes > size_ - offset_) {
+      archfpga_throw(fname_, 0, "Unexpected end of file '%s'!\n", fname_);
+    }
+    const unsigned char* bytes = data_ + offset_;
+    offset_ += num_bytes;
+    return bytes;
+  }
+
+ private:
+  const char* fname_;
+  const unsigned char* data_;
+  size_t size_;
+  size_t offset_;
+};
+
+/********************************************************************
+ * Extract a number of bits, starting from a given bit, from the packed
+ * bit values in a file, and pack them again from the LSB of a word
+ *******************************************************************/
+static std::vector<uint64_t> extract_binary_bit_words(
+  const unsigned char* bit_words, const size_t& lsb, const size_t& num_bits) {
+  auto read_word = [&](const size_t& iword) {
+    uint64_t word = 0;
+    for (size_t ibyte = 0; ibyte < 8; ++ibyte) {
+      word |= uint64_t(bit_words[8 * iword + ibyte]) << (8 * ibyte);
+    }
+    return word;
+  };
+
+  size_t offset = lsb % 64;
+  size_t last_word = (lsb + num_bits - 1) / 64;
+  std::vector<uint64_t> words((num_bits + 63) / 64, 0);
+  for (size_t iword = 0; iword < words.size(); ++iword) {
+    size_t src_word = lsb / 64 + iword;
+    words[iword] = read_word(src_word) >> offset;
+    if ((0 < offset) && (src_word + 1 <= last_word)) {
+      words[iword] |= read_word(src_word + 1) << (64 - offset);
+    }
+  }
+  return words;
+}
+
+/********************************************************************
+ * Read a binary file of an architecture bitstream.
+ * Block and bit ids are the same as the bitstream database which is
+ * written to the file
+ *******************************************************************/
+BitstreamManager read_binary_architecture_bitstream(const char* fname) {
+  vtr::ScopedStartFinishTimer timer("Read Architecture Bitstream binary file");
+
+  BitstreamManager bitstream_manager;
+
+  MappedFile file(fname);
+  if (false == file.is_open()) {
+    archfpga_throw(fname, 0, "Fail to map file '%s' to memory!\n", fname);
+  }
+  BinaryFileCursor cursor(fname, file);
+
+  const unsigned char* magic = cursor.read_bytes(4);
+  if (0 != std::memcmp(magic, BINARY_ARCH_BITSTREAM_MAGIC, 4)) {
+    archfpga_throw(fname, 0,
+                   "File '%s' is not a binary architecture bitstream!\n",
+                   fname);
+  }
+  uint64_t version = cursor.read_uint(4);
+  if (BINARY_ARCH_BITSTREAM_VERSION != version) {
+    archfpga_throw(fname, 0, "Unsupported version %lu of file '%s'!\n",
+                   version, fname);
+  }
+  size_t num_blocks = cursor.read_uint(8);
+  size_t num_bits = cursor.read_uint(8);
+
+  /* Create the blocks, and record where their bits are */
+  bitstream_manager.reserve_blocks(num_blocks);
+  bitstream_manager.reserve_bits(num_bits);
+  std::vector<std::pair<size_t, ConfigBlockId>> bit_blocks;
+  std::vector<size_t> block_num_bits(num_blocks, 0);
+  for (size_t iblk = 0; iblk < num_blocks; ++iblk) {
+    size_t lsb = cursor.read_uint(8);
+    size_t num_block_bits = cursor.read_uint(4);
+    int path_id = static_cast<int32_t>(cursor.read_uint(4));
+    ConfigBlockId block = bitstream_manager.add_block(cursor.read_string());
+    VTR_ASSERT(size_t(block) == iblk);
+    bitstream_manager.add_path_id_to_block(block, path_id);
+    bitstream_manager.add_input_net_id_to_block(block, cursor.read_string());
+    bitstream_manager.add_output_net_id_to_block(block, cursor.read_string());
+    if (0 < num_block_bits) {
+      if ((BINARY_ARCH_BITSTREAM_NO_BIT == lsb) ||
+          (lsb + num_block_bits > num_bits)) {
+        archfpga_throw(fname, 0, "Invalid bits of block '%s'!\n",
+                       bitstream_manager.block_name(block).c_str());
+      }
+      bit_blocks.push_back(std::make_pair(lsb, block));
+      block_num_bits[iblk] = num_block_bits;
+    }
+  }
+
+  /* Build the hierarchy */
+  for (size_t iblk = 0; iblk < num_blocks; ++iblk) {
+    size_t num_children = cursor.read_uint(4);
+    bitstream_manager.reserve_child_blocks(ConfigBlockId(iblk), num_children);
+    for (size_t ichild = 0; ichild < num_children; ++ichild) {
+      size_t child = cursor.read_uint(8);
+      if ((child >= num_blocks) ||
+          (bitstream_manager.valid_block_id(
+            bitstream_manager.block_parent(ConfigBlockId(child))))) {
+        archfpga_throw(fname, 0, "Invalid child block %lu of block '%s'!\n",
+                       child,
+                       bitstream_manager.block_name(ConfigBlockId(iblk))
+                         .c_str());
+      }
+      bitstream_manager.add_child_block(ConfigBlockId(iblk),
+                                        ConfigBlockId(child));
+    }
+  }
+
+  /* Add the bits block by block, in the sequence of their bits */
+  const unsigned char* bit_words =
+    cursor.read_bytes(8 * ((num_bits + 63) / 64));
+  std::sort(bit_blocks.begin(), bit_blocks.end());
+  for (const auto& bit_block : bit_blocks) {
+    if (bit_block.first != bitstream_manager.num_bits()) {
+      archfpga_throw(fname, 0, "Bits of block '%s' are not contiguous!\n",
+                     bitstream_manager.block_name(bit_block.second).c_str());
+    }
+    size_t num_block_bits = block_num_bits[size_t(bit_block.second)];
+    bitstream_manager.add_block_bits(
+      bit_block.second,
+      extract_binary_bit_words(bit_words, bit_block.first, num_block_bits),
+      num_block_bits);
+  }
+  if (num_bits != bitstream_manager.num_bits()) {
+    archfpga_throw(fname, 0, "Expect %lu bits but only %lu bits are found!\n",
+                   num_bits, bitstream_manager.num_bits());
+  }
+
+  /* All the blocks are read, pack their children */
+  bitstream_manager.compact_child_blocks();
+
+  return bitstream_manager;
+}
+
+} /* end namespace openfpga */
@@ -1,146 +1,121 @@
 /********************************************************************
  * This file includes the top-level function of this library
- * which reads an XML of a fabric key to the associated
- * data structures
+ * which reads an XML of an architecture bitstream to the associated
+ * data structures.
+ * The file is read as a stream, and each block is added to the bitstream
+ * manager as soon as it is found, so that the memory does not grow with
+ * the size of the file.
  *******************************************************************/
 #include <string>
 
-/* Headers from pugi XML library */
-#include "pugixml.hpp"
-#include "pugixml_util.hpp"
-
 /* Headers from vtr util library */
 #include "vtr_assert.h"
 #include "vtr_time.h"
 
+/* Headers from openfpga util library */
+#include "openfpga_xml_stream_reader.h"
+
 /* Headers from libarchfpga */
 #include "arch_error.h"
 #include "openfpga_reserved_words.h"
 #include "read_xml_arch_bitstream.h"
-#include "read_xml_util.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
 /********************************************************************
- * Parse XML codes of a <bitstream_block> to an object of BitstreamManager
- * This function goes recursively until we reach the leaf node
+ * Parse XML codes of <input_nets> or <output_nets> to a string of net
+ * names separated by spaces, ordered by the ids of the paths
  *******************************************************************/
-static void rec_read_xml_bitstream_block(pugi::xml_node& xml_bitstream_block,
-                                         const pugiutil::loc_data& loc_data,
-                                         BitstreamManager& bitstream_manager,
-                                         const ConfigBlockId& parent_block) {
-  /* Find the name of this bitstream block */
-  const std::string& block_name =
-    get_attribute(xml_bitstream_block, "name", loc_data).as_string();
-
-  /* Create the bitstream block */
-  ConfigBlockId curr_block = bitstream_manager.add_block(block_name);
-
-  /* Add it to parent block */
-  bitstream_manager.add_child_block(parent_block, curr_block);
-
-  /* Parse input nets if defined */
-  pugi::xml_node xml_input_nets = get_single_child(
-    xml_bitstream_block, "input_nets", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_input_nets) {
-    std::vector<std::string> input_nets;
-    size_t num_input_nets = count_children(xml_input_nets, "path", loc_data,
-                                           pugiutil::ReqOpt::OPTIONAL);
-    input_nets.resize(num_input_nets);
-
-    /* Find the child paths/nets */
-    for (pugi::xml_node xml_input_net : xml_input_nets.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_input_net.name() != std::string("path")) {
-        bad_tag(xml_input_net, loc_data, xml_input_nets, {"path"});
-      }
-      const int& id = get_attribute(xml_input_net, "id", loc_data).as_int();
-      const std::string& net_name =
-        get_attribute(xml_input_net, "net_name", loc_data).as_string();
-      VTR_ASSERT((size_t)id < input_nets.size());
-      input_nets[id] = net_name;
+static std::string read_xml_bitstream_block_nets(XmlStreamReader& reader) {
+  const std::string parent_name = reader.name();
+  std::vector<std::string> nets;
+  while (XmlStreamReader::END_ELEMENT != reader.next()) {
+    if (false == reader.is_start_element("path")) {
+      reader.throw_error(std::string("Unexpected <") + reader.name() +
+                         std::string("> under <") + parent_name +
+                         std::string(">, expect <path>"));
     }
-
-    std::string input_nets_str;
-    bool need_splitter = false;
-    for (const std::string& input_net : input_nets) {
-      if (true == need_splitter) {
-        input_nets_str += std::string(" ");
-      }
-      input_nets_str += input_net;
-      need_splitter = true;
+    const int& id = reader.required_int_attribute("id");
+    if (0 > id) {
+      reader.throw_error(std::string("Invalid path id '") +
+                         std::to_string(id) + std::string("'"));
     }
-    bitstream_manager.add_input_net_id_to_block(curr_block, input_nets_str);
-  }
-
-  /* Parse output nets if defined */
-  pugi::xml_node xml_output_nets = get_single_child(
-    xml_bitstream_block, "output_nets", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_output_nets) {
-    std::vector<std::string> output_nets;
-    size_t num_output_nets = count_children(xml_output_nets, "path", loc_data,
-                                            pugiutil::ReqOpt::OPTIONAL);
-    output_nets.resize(num_output_nets);
-
-    /* Find the child paths/nets */
-    for (pugi::xml_node xml_output_net : xml_output_nets.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_output_net.name() != std::string("path")) {
-        bad_tag(xml_output_net, loc_data, xml_output_nets, {"path"});
-      }
-      const int& id = get_attribute(xml_output_net, "id", loc_data).as_int();
-      const std::string& net_name =
-        get_attribute(xml_output_net, "net_name", loc_data).as_string();
-      VTR_ASSERT((size_t)id < output_nets.size());
-      output_nets[id] = net_name;
+    if (nets.size() <= size_t(id)) {
+      nets.resize(id + 1);
     }
+    nets[id] = reader.required_attribute("net_name");
+    reader.skip_element();
+  }
 
-    std::string output_nets_str;
-    bool need_splitter = false;
-    for (const std::string& output_net : output_nets) {
-      if (true == need_splitter) {
-        output_nets_str += std::string(" ");
-      }
-      output_nets_str += output_net;
-      need_splitter = true;
+  std::string nets_str;
+  bool need_splitter = false;
+  for (const std::string& net : nets) {
+    if (true == need_splitter) {
+      nets_str += std::string(" ");
     }
-    bitstream_manager.add_output_net_id_to_block(curr_block, output_nets_str);
+    nets_str += net;
+    need_splitter = true;
   }
+  return nets_str;
+}
 
-  /* Parse configuration bits */
-  pugi::xml_node xml_bitstream = get_single_child(
-    xml_bitstream_block, "bitstream", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_bitstream) {
-    /* Parse path_id: -2 is an invalid value defined in the bitstream manager
-     * internally */
-    const int& path_id = get_attribute(xml_bitstream, "path_id", loc_data,
-                                       pugiutil::ReqOpt::OPTIONAL)
-                           .as_int(-2);
-    if (-2 < path_id) {
-      bitstream_manager.add_path_id_to_block(curr_block, path_id);
-    }
+/********************************************************************
+ * Parse XML codes of a <bitstream> to the bits of a block
+ *******************************************************************/
+static void read_xml_bitstream_block_bits(XmlStreamReader& reader,
+                                          BitstreamManager& bitstream_manager,
+                                          const ConfigBlockId& curr_block) {
+  /* Parse path_id: -2 is an invalid value defined in the bitstream manager
+   * internally */
+  const int& path_id = reader.int_attribute("path_id", -2);
+  if (-2 < path_id) {
+    bitstream_manager.add_path_id_to_block(curr_block, path_id);
+  }
 
-    /* Find the child paths/nets */
-    std::vector<bool> block_bits;
-    for (pugi::xml_node xml_bit : xml_bitstream.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_bit.name() != std::string("bit")) {
-        bad_tag(xml_bit, loc_data, xml_bitstream, {"bit"});
-      }
-      const int& bit_value = get_attribute(xml_bit, "value", loc_data).as_int();
-      block_bits.push_back(1 == bit_value);
+  std::vector<bool> block_bits;
+  while (XmlStreamReader::END_ELEMENT != reader.next()) {
+    if (false == reader.is_start_element("bit")) {
+      reader.throw_error(std::string("Unexpected <") + reader.name() +
+                         std::string("> under <bitstream>, expect <bit>"));
     }
-    /* Link the bit to parent block */
-    bitstream_manager.add_block_bits(curr_block, block_bits);
+    block_bits.push_back(1 == reader.required_int_attribute("value"));
+    reader.skip_element();
   }
+  /* Link the bit to parent block */
+  bitstream_manager.add_block_bits(curr_block, block_bits);
+}
+
+/********************************************************************
+ * Parse XML codes of a <bitstream_block> to an object of BitstreamManager
+ * The reader is at the start of the block, and is moved to its end.
+ * This function goes recursively until we reach the leaf node
+ *******************************************************************/
+static void rec_read_xml_bitstream_block(XmlStreamReader& reader,
+                                         BitstreamManager& bitstream_manager,
+                                         const ConfigBlockId& parent_block) {
+  /* Create the bitstream block */
+  ConfigBlockId curr_block =
+    bitstream_manager.add_block(reader.required_attribute("name"));
+
+  /* Add it to parent block */
+  bitstream_manager.add_child_block(parent_block, curr_block);
 
-  /* Go recursively: find all the child blocks and parse */
-  for (pugi::xml_node xml_child : xml_bitstream_block.children()) {
-    /* We only care child bitstream blocks here */
-    if (xml_child.name() == std::string("bitstream_block")) {
-      rec_read_xml_bitstream_block(xml_child, loc_data, bitstream_manager,
-                                   curr_block);
+  /* Parse the child nodes in the order of the file. Other nodes, e.g.,
+   * <hierarchy>, are skipped */
+  while (XmlStreamReader::END_ELEMENT != reader.next()) {
+    if (reader.is_start_element("bitstream_block")) {
+      rec_read_xml_bitstream_block(reader, bitstream_manager, curr_block);
+    } else if (reader.is_start_element("input_nets")) {
+      bitstream_manager.add_input_net_id_to_block(
+        curr_block, read_xml_bitstream_block_nets(reader));
+    } else if (reader.is_start_element("output_nets")) {
+      bitstream_manager.add_output_net_id_to_block(
+        curr_block, read_xml_bitstream_block_nets(reader));
+    } else if (reader.is_start_element("bitstream")) {
+      read_xml_bitstream_block_bits(reader, bitstream_manager, curr_block);
+    } else {
+      reader.skip_element();
     }
   }
 }
@@ -153,52 +128,43 @@ BitstreamManager read_xml_architecture_bitstream(const char* fname) {
 
   BitstreamManager bitstream_manager;
 
-  /* Parse the file */
-  pugi::xml_document doc;
-  pugiutil::loc_data loc_data;
-
-  try {
-    loc_data = pugiutil::load_xml(doc, fname);
-
-    /* Count the child <bitstream_block> */
-
-    pugi::xml_node xml_root =
-      get_single_child(doc, "bitstream_block", loc_data);
-
-    /* Find the name of the top block*/
-    const std::string& top_block_name =
-      get_attribute(xml_root, "name", loc_data).as_string();
+  XmlStreamReader reader(fname);
+  reader.next();
+  if (false == reader.is_start_element("bitstream_block")) {
+    reader.throw_error(std::string("Unexpected root <") + reader.name() +
+                       std::string(">, expect <bitstream_block>"));
+  }
 
-    if (top_block_name != std::string(FPGA_TOP_MODULE_NAME)) {
-      archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_root),
-                     "Top-level block must be named as '%s'!\n",
-                     FPGA_TOP_MODULE_NAME);
-    }
+  /* Find the name of the top block*/
+  const std::string top_block_name = reader.required_attribute("name");
+  if (top_block_name != std::string(FPGA_TOP_MODULE_NAME)) {
+    archfpga_throw(fname, reader.line(),
+                   "Top-level block must be named as '%s'!\n",
+                   FPGA_TOP_MODULE_NAME);
+  }
 
-    /* Create the top-level block */
-    ConfigBlockId top_block = bitstream_manager.add_block(top_block_name);
-
-    size_t num_blks = count_children(xml_root, "bitstream_block", loc_data,
-                                     pugiutil::ReqOpt::OPTIONAL);
-
-    /* Reserve bitstream blocks in the data base */
-    bitstream_manager.reserve_blocks(num_blks);
-
-    /* Iterate over the children under this node,
-     * each child should be named after circuit_model
-     */
-    for (pugi::xml_node xml_blk : xml_root.children()) {
-      /* Error out if the XML child has an invalid name! */
-      if (xml_blk.name() != std::string("bitstream_block")) {
-        bad_tag(xml_blk, loc_data, xml_root, {"bitstream_block"});
-      }
-      rec_read_xml_bitstream_block(xml_blk, loc_data, bitstream_manager,
-                                   top_block);
+  /* Reserve bitstream blocks and bits in the data base, when the sizes are
+   * given by the writer */
+  bitstream_manager.reserve_blocks(reader.int_attribute("num_blocks", 0));
+  bitstream_manager.reserve_bits(reader.int_attribute("num_bits", 0));
+
+  /* Create the top-level block */
+  ConfigBlockId top_block = bitstream_manager.add_block(top_block_name);
+
+  /* Iterate over the children under this node, which are all blocks */
+  while (XmlStreamReader::END_ELEMENT != reader.next()) {
+    /* Error out if the XML child has an invalid name! */
+    if (false == reader.is_start_element("bitstream_block")) {
+      reader.throw_error(std::string("Unexpected <") + reader.name() +
+                         std::string("> under the top block, expect "
+                                     "<bitstream_block>"));
     }
-  } catch (pugiutil::XmlError& e) {
-    archfpga_throw(fname, e.line(), "%s", e.what());
+    rec_read_xml_bitstream_block(reader, bitstream_manager, top_block);
   }
 
+  /* All the blocks are read, pack their children */
+  bitstream_manager.compact_child_blocks();
+
   return bitstream_manager;
 }
 
@@ -31,6 +31,7 @@ namespace openfpga {
  *******************************************************************/
 static void rec_report_block_bitstream_distribution_to_xml_file(
   std::fstream& fp, const BitstreamManager& bitstream_manager,
+  const vtr::vector<ConfigBlockId, size_t>& block_sum_of_bits,
   const ConfigBlockId& block, const size_t& max_hierarchy_level,
   const size_t& hierarchy_level) {
   valid_file_stream(fp);
@@ -43,21 +44,19 @@ static void rec_report_block_bitstream_distribution_to_xml_file(
   write_tab_to_file(fp, hierarchy_level);
   fp << "<block";
   fp << " name=\"" << bitstream_manager.block_name(block) << "\"";
-  fp << " number_of_bits=\""
-     << rec_find_bitstream_manager_block_sum_of_bits(bitstream_manager, block)
-     << "\"";
-  fp << ">" << std::endl;
+  fp << " number_of_bits=\"" << block_sum_of_bits[block] << "\"";
+  fp << ">" << '\n';
 
   /* Dive to child blocks if this block has any */
   for (const ConfigBlockId& child_block :
        bitstream_manager.block_children(block)) {
     rec_report_block_bitstream_distribution_to_xml_file(
-      fp, bitstream_manager, child_block, max_hierarchy_level,
-      hierarchy_level + 1);
+      fp, bitstream_manager, block_sum_of_bits, child_block,
+      max_hierarchy_level, hierarchy_level + 1);
   }
 
   write_tab_to_file(fp, hierarchy_level);
-  fp << "</block>" << std::endl;
+  fp << "</block>" << '\n';
 }
 
 /********************************************************************
@@ -67,10 +66,12 @@ static void rec_report_block_bitstream_distribution_to_xml_file(
  *
  * Notes:
  *   - The output format is a table whose format is compatible with RST files
+ *   - The number of bits of each block is counted once before reporting
  *******************************************************************/
 int report_architecture_bitstream_distribution(
   std::fstream& fp, const BitstreamManager& bitstream_manager,
-  const size_t& max_hierarchy_level, const size_t& hierarchy_level) {
+  const size_t& max_hierarchy_level, const size_t& hierarchy_level,
+  const size_t& num_threads) {
   std::string timer_message =
     std::string("Report architecture bitstream distribution");
   vtr::ScopedStartFinishTimer timer(timer_message);
@@ -80,7 +81,7 @@ int report_architecture_bitstream_distribution(
 
   int curr_level = hierarchy_level;
   write_tab_to_file(fp, curr_level);
-  fp << "<blocks>" << std::endl;
+  fp << "<blocks>" << '\n';
 
   /* Find the top block, which has not parents */
   std::vector<ConfigBlockId> top_block =
@@ -88,13 +89,16 @@ int report_architecture_bitstream_distribution(
   /* Make sure we have only 1 top block */
   VTR_ASSERT(1 == top_block.size());
 
+  vtr::vector<ConfigBlockId, size_t> block_sum_of_bits =
+    find_bitstream_manager_blocks_sum_of_bits(bitstream_manager, num_threads);
+
   /* Write bitstream, block by block, in a recursive way */
   rec_report_block_bitstream_distribution_to_xml_file(
-    fp, bitstream_manager, top_block[0], max_hierarchy_level + 2,
-    curr_level + 1);
+    fp, bitstream_manager, block_sum_of_bits, top_block[0],
+    max_hierarchy_level + 2, curr_level + 1);
 
   write_tab_to_file(fp, curr_level);
-  fp << "</blocks>" << std::endl;
+  fp << "</blocks>" << '\n';
 
   return 0;
 }
@@ -0,0 +1,119 @@
+/********************************************************************
+ * This file includes functions that output bitstream database
+ * to a compact binary file, which can be loaded much faster than
+ * the XML file. See the file format in binary_arch_bitstream_format.h
+ *******************************************************************/
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "binary_arch_bitstream_format.h"
+#include "openfpga_buffered_stream.h"
+#include "openfpga_digest.h"
+#include "write_binary_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Write an unsigned integer to a binary file in little endian
+ *******************************************************************/
+static void write_binary_uint(std::fstream& fp, const uint64_t& value,
+                              const size_t& num_bytes) {
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    fp.put(static_cast<char>((value >> (8 * ibyte)) & 0xff));
+  }
+}
+
+/********************************************************************
+ * Write a string to a binary file, led by its length
+ *******************************************************************/
+static void write_binary_string(std::fstream& fp, const std::string& str) {
+  write_binary_uint(fp, str.size(), 4);
+  fp.write(str.data(), str.size());
+}
+
+/********************************************************************
+ * Write the bitstream database to a binary file
+ * Block and bit ids are kept, so that reading the file results in
+ * exactly the same database
+ *******************************************************************/
+void write_binary_architecture_bitstream(
+  const BitstreamManager& bitstream_manager, const std::string& fname) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR(
+      "Received empty file name to output bitstream!\n\tPlease specify a valid "
+      "file name.\n");
+  }
+
+  std::string timer_message =
+    std::string("Write ") + std::to_string(bitstream_manager.num_bits()) +
+    std::string(" architecture independent bitstream into binary file '") +
+    fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(fname,
+          std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  check_file_stream(fname.c_str(), fp);
+
+  fp.write(BINARY_ARCH_BITSTREAM_MAGIC, 4);
+  write_binary_uint(fp, BINARY_ARCH_BITSTREAM_VERSION, 4);
+  write_binary_uint(fp, bitstream_manager.num_blocks(), 8);
+  write_binary_uint(fp, bitstream_manager.num_bits(), 8);
+
+  for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+    /* Blocks are never removed, so that ids are contiguous */
+    VTR_ASSERT(true == bitstream_manager.valid_block_id(block));
+    size_t num_block_bits = bitstream_manager.block_num_bits(block);
+    if (0 < num_block_bits) {
+      write_binary_uint(fp, size_t(bitstream_manager.block_lsb_bit(block)),
+                        8);
+    } else {
+      write_binary_uint(fp, BINARY_ARCH_BITSTREAM_NO_BIT, 8);
+    }
+    write_binary_uint(fp, num_block_bits, 4);
+    write_binary_uint(
+      fp, static_cast<uint32_t>(bitstream_manager.block_path_id(block)), 4);
+    write_binary_string(fp, bitstream_manager.block_name(block));
+    write_binary_string(fp, bitstream_manager.block_input_net_ids(block));
+    write_binary_string(fp, bitstream_manager.block_output_net_ids(block));
+  }
+
+  for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+    std::vector<ConfigBlockId> children =
+      bitstream_manager.block_children(block);
+    write_binary_uint(fp, children.size(), 4);
+    for (const ConfigBlockId& child : children) {
+      write_binary_uint(fp, size_t(child), 8);
+    }
+  }
+
+  /* Pack the bits into words */
+  uint64_t word = 0;
+  size_t word_length = 0;
+  for (const ConfigBitId& bit : bitstream_manager.dense_bits()) {
+    word |= uint64_t(bitstream_manager.bit_value(bit)) << word_length;
+    word_length++;
+    if (64 == word_length) {
+      write_binary_uint(fp, word, 8);
+      word = 0;
+      word_length = 0;
+    }
+  }
+  if (0 < word_length) {
+    write_binary_uint(fp, word, 8);
+  }
+
+  /* Close file handler */
+  fp.close();
+}
+
+} /* end namespace openfpga */
@@ -2,7 +2,9 @@
  * This file includes functions that output bitstream database
  * to files in different formats
  *******************************************************************/
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <ctime>
 #include <fstream>
 
@@ -13,7 +15,9 @@
 
 /* Headers from openfpgautil library */
 #include "bitstream_manager_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_tokenizer.h"
 #include "write_xml_arch_bitstream.h"
@@ -28,10 +32,10 @@ static void write_bitstream_xml_file_head(std::fstream& fp,
                                           const bool& include_time_stamp) {
   valid_file_stream(fp);
 
-  fp << "<!--" << std::endl;
-  fp << "\t- Architecture independent bitstream" << std::endl;
-  fp << "\t- Author: Xifan TANG" << std::endl;
-  fp << "\t- Organization: University of Utah" << std::endl;
+  fp << "<!--" << '\n';
+  fp << "\t- Architecture independent bitstream" << '\n';
+  fp << "\t- Author: Xifan TANG" << '\n';
+  fp << "\t- Organization: University of Utah" << '\n';
 
   if (include_time_stamp) {
     auto end = std::chrono::system_clock::now();
@@ -39,102 +43,98 @@ static void write_bitstream_xml_file_head(std::fstream& fp,
     fp << "\t- Date: " << std::ctime(&end_time);
   }
 
-  fp << "-->" << std::endl;
-  fp << std::endl;
+  fp << "-->" << '\n';
+  fp << '\n';
 }
 
 /********************************************************************
- * Recursively write the bitstream of a block to a xml file
- * This function will use a Depth-First Search in outputting bitstream
- * for each block
- * 1. For block with bits as children, we will output the XML lines
- * 2. For block without bits/child blocks, we can return
- * 3. For block with child blocks, we visit each child recursively
+ * Write the start tag of a block to a xml file
  *******************************************************************/
-static void rec_write_block_bitstream_to_xml_file(
+static void write_block_bitstream_head_to_xml_file(
   std::fstream& fp, const BitstreamManager& bitstream_manager,
   const ConfigBlockId& block, const size_t& hierarchy_level) {
-  valid_file_stream(fp);
-
-  /* Write the bits of this block */
   write_tab_to_file(fp, hierarchy_level);
   fp << "<bitstream_block";
   fp << " name=\"" << bitstream_manager.block_name(block) << "\"";
   fp << " hierarchy_level=\"" << hierarchy_level << "\"";
-  fp << ">" << std::endl;
+  /* The sizes of the bitstream are given on the top block, so that readers
+   * can reserve memory in advance */
+  if (0 == hierarchy_level) {
+    fp << " num_blocks=\"" << bitstream_manager.num_blocks() << "\"";
+    fp << " num_bits=\"" << bitstream_manager.num_bits() << "\"";
+  }
+  fp << ">" << '\n';
+}
 
-  /* Dive to child blocks if this block has any */
-  for (const ConfigBlockId& child_block :
-       bitstream_manager.block_children(block)) {
-    rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, child_block,
-                                          hierarchy_level + 1);
+/********************************************************************
+ * Write the nets of a block, which are given in a string separated by
+ * spaces, to a xml file
+ *******************************************************************/
+static void write_block_nets_to_xml_file(std::fstream& fp,
+                                         const std::string& net_ids,
+                                         const std::string& tag,
+                                         const size_t& hierarchy_level) {
+  if (true == net_ids.empty()) {
+    return;
+  }
+  write_tab_to_file(fp, hierarchy_level);
+  fp << "<" << tag << ">\n";
+  size_t path_counter = 0;
+  /* Split with space */
+  StringToken net_tokenizer(net_ids);
+  for (const std::string& net : net_tokenizer.split(std::string(" "))) {
+    write_tab_to_file(fp, hierarchy_level + 1);
+    fp << "<path id=\"" << path_counter << "\"";
+    fp << " net_name=\"";
+    fp << net;
+    fp << "\"/>";
+    fp << "\n";
+
+    path_counter++;
   }
+  write_tab_to_file(fp, hierarchy_level);
+  fp << "</" << tag << ">\n";
+}
 
-  if (0 == bitstream_manager.block_bits(block).size()) {
+/********************************************************************
+ * Write the bits of a block and its end tag to a xml file
+ * The nets and the path id of the block are skipped unless required
+ * The hierarchy of the block, from the top block to the block itself,
+ * is given by the caller, which keeps it while visiting the blocks
+ *******************************************************************/
+static void write_block_bitstream_body_to_xml_file(
+  std::fstream& fp, const BitstreamManager& bitstream_manager,
+  const std::vector<ConfigBlockId>& block_hierarchy,
+  const size_t& hierarchy_level, const bool& include_net_ids) {
+  const ConfigBlockId& block = block_hierarchy.back();
+  if (0 == bitstream_manager.block_num_bits(block)) {
     write_tab_to_file(fp, hierarchy_level);
-    fp << "</bitstream_block>" << std::endl;
+    fp << "</bitstream_block>" << '\n';
     return;
   }
 
-  std::vector<ConfigBlockId> block_hierarchy =
-    find_bitstream_manager_block_hierarchy(bitstream_manager, block);
-
   /* Output hierarchy of this parent*/
   write_tab_to_file(fp, hierarchy_level + 1);
-  fp << "<hierarchy>" << std::endl;
+  fp << "<hierarchy>" << '\n';
   size_t hierarchy_counter = 0;
   for (const ConfigBlockId& temp_block : block_hierarchy) {
     write_tab_to_file(fp, hierarchy_level + 2);
     fp << "<instance level=\"" << hierarchy_counter << "\"";
     fp << " name=\"" << bitstream_manager.block_name(temp_block) << "\"";
-    fp << "/>" << std::endl;
+    fp << "/>" << '\n';
     hierarchy_counter++;
   }
   write_tab_to_file(fp, hierarchy_level + 1);
-  fp << "</hierarchy>" << std::endl;
+  fp << "</hierarchy>" << '\n';
 
   /* Output input/output nets if there are any */
-  if (false == bitstream_manager.block_input_net_ids(block).empty()) {
-    write_tab_to_file(fp, hierarchy_level + 1);
-    fp << "<input_nets>\n";
-    size_t path_counter = 0;
-    /* Split with space */
-    StringToken input_net_tokenizer(
-      bitstream_manager.block_input_net_ids(block));
-    for (const std::string& net : input_net_tokenizer.split(std::string(" "))) {
-      write_tab_to_file(fp, hierarchy_level + 2);
-      fp << "<path id=\"" << path_counter << "\"";
-      fp << " net_name=\"";
-      fp << net;
-      fp << "\"/>";
-      fp << "\n";
-
-      path_counter++;
-    }
-    write_tab_to_file(fp, hierarchy_level + 1);
-    fp << "</input_nets>\n";
-  }
-
-  if (false == bitstream_manager.block_output_net_ids(block).empty()) {
-    write_tab_to_file(fp, hierarchy_level + 1);
-    fp << "<output_nets>\n";
-    size_t path_counter = 0;
-    /* Split with space */
-    StringToken output_net_tokenizer(
-      bitstream_manager.block_output_net_ids(block));
-    for (const std::string& net :
-         output_net_tokenizer.split(std::string(" "))) {
-      write_tab_to_file(fp, hierarchy_level + 2);
-      fp << "<path id=\"" << path_counter << "\"";
-      fp << " net_name=\"";
-      fp << net;
-      fp << "\"/>";
-      fp << "\n";
-
-      path_counter++;
-    }
-    write_tab_to_file(fp, hierarchy_level + 1);
-    fp << "</output_nets>\n";
+  if (true == include_net_ids) {
+    write_block_nets_to_xml_file(
+      fp, bitstream_manager.block_input_net_ids(block),
+      std::string("input_nets"), hierarchy_level + 1);
+    write_block_nets_to_xml_file(
+      fp, bitstream_manager.block_output_net_ids(block),
+      std::string("output_nets"), hierarchy_level + 1);
   }
 
   /* Output child bits under this block */
@@ -142,10 +142,11 @@ static void rec_write_block_bitstream_to_xml_file(
   write_tab_to_file(fp, hierarchy_level + 1);
   fp << "<bitstream";
   /* Output path id only when it is valid */
-  if (true == bitstream_manager.valid_block_path_id(block)) {
+  if ((true == include_net_ids) &&
+      (true == bitstream_manager.valid_block_path_id(block))) {
     fp << " path_id=\"" << bitstream_manager.block_path_id(block) << "\"";
   }
-  fp << ">" << std::endl;
+  fp << ">" << '\n';
 
   for (const ConfigBitId& child_bit : bitstream_manager.block_bits(block)) {
     write_tab_to_file(fp, hierarchy_level + 2);
@@ -154,14 +155,109 @@ static void rec_write_block_bitstream_to_xml_file(
        << bit_counter << "]"
        << "\"";
     fp << " value=\"" << bitstream_manager.bit_value(child_bit) << "\"";
-    fp << "/>" << std::endl;
+    fp << "/>" << '\n';
     bit_counter++;
   }
   write_tab_to_file(fp, hierarchy_level + 1);
-  fp << "</bitstream>" << std::endl;
+  fp << "</bitstream>" << '\n';
 
   write_tab_to_file(fp, hierarchy_level);
-  fp << "</bitstream_block>" << std::endl;
+  fp << "</bitstream_block>" << '\n';
+}
+
+/********************************************************************
+ * Recursively write the bitstream of a block to a xml file
+ * This function will use a Depth-First Search in outputting bitstream
+ * for each block
+ * 1. For block with bits as children, we will output the XML lines
+ * 2. For block without bits/child blocks, we can return
+ * 3. For block with child blocks, we visit each child recursively
+ *******************************************************************/
+static void rec_write_block_bitstream_to_xml_file(
+  std::fstream& fp, const BitstreamManager& bitstream_manager,
+  const ConfigBlockId& block, std::vector<ConfigBlockId>& block_hierarchy,
+  const size_t& hierarchy_level, const bool& include_net_ids) {
+  valid_file_stream(fp);
+
+  write_block_bitstream_head_to_xml_file(fp, bitstream_manager, block,
+                                         hierarchy_level);
+
+  block_hierarchy.push_back(block);
+
+  /* Dive to child blocks if this block has any */
+  for (const ConfigBlockId& child_block :
+       bitstream_manager.block_children(block)) {
+    rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, child_block,
+                                          block_hierarchy, hierarchy_level + 1,
+                                          include_net_ids);
+  }
+
+  write_block_bitstream_body_to_xml_file(fp, bitstream_manager,
+                                         block_hierarchy, hierarchy_level,
+                                         include_net_ids);
+
+  block_hierarchy.pop_back();
+}
+
+/********************************************************************
+ * Write the child blocks of the top block to a xml file, in chunks.
+ * When multiple threads are used, each thread writes the subtrees of a
+ * contiguous range of child blocks to a chunk file <fname>.part<i>, and
+ * the chunks are then appended to the file in order and removed. As a
+ * result, the file is the same regardless of the number of threads.
+ *******************************************************************/
+static void write_top_block_children_to_xml_file(
+  std::fstream& fp, const std::string& fname,
+  const BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
+  const bool& include_net_ids, const size_t& num_threads) {
+  std::vector<ConfigBlockId> child_blocks =
+    bitstream_manager.block_children(top_block);
+
+  size_t num_parts = std::min(num_threads, child_blocks.size());
+  if (1 >= num_parts) {
+    std::vector<ConfigBlockId> block_hierarchy(1, top_block);
+    for (const ConfigBlockId& child_block : child_blocks) {
+      rec_write_block_bitstream_to_xml_file(
+        fp, bitstream_manager, child_block, block_hierarchy, 1,
+        include_net_ids);
+    }
+    return;
+  }
+
+  size_t chunk_size = (child_blocks.size() + num_parts - 1) / num_parts;
+  std::vector<std::string> part_fnames(num_parts);
+  for (size_t ipart = 0; ipart < num_parts; ++ipart) {
+    part_fnames[ipart] = fname + std::string(".part") + std::to_string(ipart);
+  }
+
+  parallel_for(num_parts, num_threads, [&](const size_t& ipart) {
+    BufferedFileStream part_fp;
+    /* Parts are read back as they are, and only the final file is
+     * compressed */
+    part_fp.set_compressible(false);
+    part_fp.open(part_fnames[ipart], std::fstream::out | std::fstream::trunc);
+    check_file_stream(part_fnames[ipart].c_str(), part_fp);
+    size_t begin = ipart * chunk_size;
+    size_t end = std::min(begin + chunk_size, child_blocks.size());
+    std::vector<ConfigBlockId> block_hierarchy(1, top_block);
+    for (size_t iblk = begin; iblk < end; ++iblk) {
+      rec_write_block_bitstream_to_xml_file(part_fp, bitstream_manager,
+                                            child_blocks[iblk],
+                                            block_hierarchy, 1,
+                                            include_net_ids);
+    }
+    part_fp.close();
+  });
+
+  for (const std::string& part_fname : part_fnames) {
+    std::ifstream part_fp(part_fname);
+    /* Appending an empty part would set the failbit of the file */
+    if (part_fp.peek() != std::ifstream::traits_type::eof()) {
+      fp << part_fp.rdbuf();
+    }
+    part_fp.close();
+    std::remove(part_fname.c_str());
+  }
 }
 
 /********************************************************************
@@ -177,10 +273,15 @@ static void rec_write_block_bitstream_to_xml_file(
  * 2. Create an intermediate file to reorganize a bitstream for
  *    specific FPGAs
  * 3. TODO: support FASM format
+ *
+ * The nets and the path ids of the blocks, which take a large part of
+ * the file on large devices, are only written when required.
  *******************************************************************/
 void write_xml_architecture_bitstream(const BitstreamManager& bitstream_manager,
                                       const std::string& fname,
-                                      const bool& include_time_stamp) {
+                                      const bool& include_time_stamp,
+                                      const bool& include_net_ids,
+                                      const size_t& num_threads) {
   /* Ensure that we have a valid file name */
   if (true == fname.empty()) {
     VTR_LOG_ERROR(
@@ -189,13 +290,13 @@ void write_xml_architecture_bitstream(const BitstreamManager& bitstream_manager,
   }
 
   std::string timer_message =
-    std::string("Write ") + std::to_string(bitstream_manager.bits().size()) +
+    std::string("Write ") + std::to_string(bitstream_manager.num_bits()) +
     std::string(" architecture independent bitstream into XML file '") + fname +
     std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(fname.c_str(), fp);
@@ -209,8 +310,16 @@ void write_xml_architecture_bitstream(const BitstreamManager& bitstream_manager,
   /* Make sure we have only 1 top block */
   VTR_ASSERT(1 == top_block.size());
 
-  /* Write bitstream, block by block, in a recursive way */
-  rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, top_block[0], 0);
+  /* Write bitstream, block by block, in a recursive way. The subtrees
+   * under the top block are written in chunks */
+  write_block_bitstream_head_to_xml_file(fp, bitstream_manager, top_block[0],
+                                         0);
+  write_top_block_children_to_xml_file(fp, fname, bitstream_manager,
+                                       top_block[0], include_net_ids,
+                                       num_threads);
+  write_block_bitstream_body_to_xml_file(
+    fp, bitstream_manager, std::vector<ConfigBlockId>(1, top_block[0]), 0,
+    include_net_ids);
 
   /* Close file handler */
   fp.close();
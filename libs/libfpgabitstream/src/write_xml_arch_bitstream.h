@@ -17,7 +17,9 @@ namespace openfpga {
 
 void write_xml_architecture_bitstream(const BitstreamManager& bitstream_manager,
                                       const std::string& fname,
-                                      const bool& include_time_stamp);
+                                      const bool& include_time_stamp,
+                                      const bool& include_net_ids,
+                                      const size_t& num_threads);
 
 } /* end namespace openfpga */
 
@@ -4,15 +4,30 @@
  * 2. writer of data structures
  *******************************************************************/
 #include <fstream>
+#include <iterator>
+#include <string>
+
 /* Headers from vtrutils */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
 /* Headers from fabric key */
+#include "read_binary_arch_bitstream.h"
 #include "read_xml_arch_bitstream.h"
 #include "report_arch_bitstream_distribution.h"
+#include "write_binary_arch_bitstream.h"
 #include "write_xml_arch_bitstream.h"
 
+/********************************************************************
+ * Return the content of a file, which is compared byte by byte
+ *******************************************************************/
+static std::string read_file_content(const std::string& fname) {
+  std::ifstream fp(fname, std::ifstream::binary);
+  VTR_ASSERT(true == fp.is_open());
+  return std::string(std::istreambuf_iterator<char>(fp),
+                     std::istreambuf_iterator<char>());
+}
+
 int main(int argc, const char** argv) {
   /* Ensure we have only one or two or 3 argument */
   VTR_ASSERT((2 == argc) || (3 == argc) || (4 == argc) || (5 == argc));
@@ -26,12 +41,19 @@ int main(int argc, const char** argv) {
    * This is optional only used when there is a second argument
    */
   if (3 <= argc) {
-    openfpga::write_xml_architecture_bitstream(test_bitstream, argv[2], true);
-    VTR_LOG("Echo the bitstream (with time stamp) to an XML file: %s.\n",
-            argv[2]);
-    openfpga::write_xml_architecture_bitstream(test_bitstream, argv[2], false);
+    openfpga::write_xml_architecture_bitstream(test_bitstream, argv[2], false,
+                                               true, 1);
     VTR_LOG("Echo the bitstream (w/o time stamp) to an XML file: %s.\n",
             argv[2]);
+
+    /* The chunks written in parallel should make up the same file */
+    std::string chunked_fname = std::string(argv[2]) + ".chunked";
+    openfpga::write_xml_architecture_bitstream(
+      test_bitstream, chunked_fname, false, true, 2);
+    VTR_ASSERT(read_file_content(argv[2]) == read_file_content(chunked_fname));
+    VTR_LOG(
+      "Echo the bitstream (w/o time stamp) to an XML file in chunks: %s.\n",
+      chunked_fname.c_str());
   }
   /* Output the bitstream distribution to an XML file
    * This is optional only used when there is a third argument
@@ -45,4 +67,19 @@ int main(int argc, const char** argv) {
                                                          0);
     VTR_LOG("Echo the bitstream distribution to an XML file: %s.\n", argv[3]);
   }
+  /* Output the bitstream database to a binary file and read it back
+   * This is optional only used when there is a fourth argument
+   */
+  if (5 <= argc) {
+    openfpga::write_binary_architecture_bitstream(test_bitstream, argv[4]);
+    openfpga::BitstreamManager binary_bitstream =
+      openfpga::read_binary_architecture_bitstream(argv[4]);
+    VTR_ASSERT(true == binary_bitstream.same_blocks(test_bitstream));
+    for (const openfpga::ConfigBitId& bit : test_bitstream.dense_bits()) {
+      VTR_ASSERT(binary_bitstream.bit_value(bit) ==
+                 test_bitstream.bit_value(bit));
+    }
+    VTR_LOG("Echo the bitstream to a binary file and read it back: %s.\n",
+            argv[4]);
+  }
 }
@@ -44,22 +44,20 @@ std::vector<CommandOptionId> Command::require_value_options() const {
 
 CommandOptionId Command::option(const std::string& name) const {
   /* Ensure that the name is unique in the option list */
-  std::map<std::string, CommandOptionId>::const_iterator name_it =
-    option_name2ids_.find(name);
+  auto name_it = option_name2ids_.find(name);
   if (name_it == option_name2ids_.end()) {
     return CommandOptionId::INVALID();
   }
-  return option_name2ids_.at(name);
+  return name_it->second;
 }
 
 CommandOptionId Command::short_option(const std::string& name) const {
   /* Ensure that the name is unique in the option list */
-  std::map<std::string, CommandOptionId>::const_iterator name_it =
-    option_short_name2ids_.find(name);
+  auto name_it = option_short_name2ids_.find(name);
   if (name_it == option_short_name2ids_.end()) {
     return CommandOptionId::INVALID();
   }
-  return option_short_name2ids_.at(name);
+  return name_it->second;
 }
 
 std::string Command::option_name(const CommandOptionId& option_id) const {
@@ -109,8 +107,7 @@ CommandOptionId Command::add_option(const char* name,
                                     const bool& option_required,
                                     const char* description) {
   /* Ensure that the name is unique in the option list */
-  std::map<std::string, CommandOptionId>::const_iterator name_it =
-    option_name2ids_.find(std::string(name));
+  auto name_it = option_name2ids_.find(std::string(name));
   if (name_it != option_name2ids_.end()) {
     return CommandOptionId::INVALID();
   }
@@ -143,8 +140,7 @@ bool Command::set_option_short_name(const CommandOptionId& option_id,
     return false;
   }
 
-  std::map<std::string, CommandOptionId>::const_iterator short_name_it =
-    option_short_name2ids_.find(std::string(short_name));
+  auto short_name_it = option_short_name2ids_.find(std::string(short_name));
   if (short_name_it != option_short_name2ids_.end()) {
     return false;
   }
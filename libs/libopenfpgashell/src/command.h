@@ -15,8 +15,8 @@
  * This is not only used by each command available in the shell
  * but also the interface of the shell, such as interactive mode
  ********************************************************************/
-#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "command_fwd.h"
@@ -144,8 +144,8 @@ class Command {
   vtr::vector<CommandOptionId, std::string> option_description_;
 
   /* Fast name look-up */
-  std::map<std::string, CommandOptionId> option_name2ids_;
-  std::map<std::string, CommandOptionId> option_short_name2ids_;
+  std::unordered_map<std::string, CommandOptionId> option_name2ids_;
+  std::unordered_map<std::string, CommandOptionId> option_short_name2ids_;
 };
 
 } /* End namespace openfpga */
@@ -0,0 +1,224 @@
+/*********************************************************************
+ * This file includes functions to profile the commands executed in a
+ * shell, and to output the profiling results to a JSON file
+ ********************************************************************/
+#include "command_profile.h"
+
+#include <sys/resource.h>
+
+#include <cstdio>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
+#include "openfpga_digest.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/*********************************************************************
+ * Public constructors
+ ********************************************************************/
+CommandProfileTimer::CommandProfileTimer() {
+  wall_start_ = std::chrono::steady_clock::now();
+  cpu_start_ = std::clock();
+  peak_rss_start_ = find_peak_resident_set_size();
+  alloc_start_ = find_allocation_counts();
+}
+
+/*********************************************************************
+ * Public mutators
+ ********************************************************************/
+void CommandProfileTimer::finish(CommandProfile& profile) const {
+  std::chrono::duration<double> wall_time =
+    std::chrono::steady_clock::now() - wall_start_;
+  profile.wall_time = wall_time.count();
+  profile.cpu_time =
+    (double)(std::clock() - cpu_start_) / (double)CLOCKS_PER_SEC;
+  profile.peak_rss = find_peak_resident_set_size();
+  profile.peak_rss_delta = profile.peak_rss - peak_rss_start_;
+  AllocationCounts alloc_end = find_allocation_counts();
+  profile.num_allocations =
+    alloc_end.num_allocations - alloc_start_.num_allocations;
+  profile.allocated_bytes = alloc_end.num_bytes - alloc_start_.num_bytes;
+}
+
+/*********************************************************************
+ * Find the peak resident set size (in KiB) of the current process
+ * Return 0 if the system does not provide it
+ ********************************************************************/
+long find_peak_resident_set_size() {
+  struct rusage usage;
+  if (0 != getrusage(RUSAGE_SELF, &usage)) {
+    return 0;
+  }
+  return usage.ru_maxrss;
+}
+
+/*********************************************************************
+ * Find the options that have been selected in the parsing results of
+ * a command, in the sequence of the options defined in the command
+ ********************************************************************/
+std::vector<std::pair<std::string, std::string>> find_command_profile_options(
+  const Command& cmd, const CommandContext& cmd_context) {
+  std::vector<std::pair<std::string, std::string>> options;
+  for (const CommandOptionId& opt : cmd.options()) {
+    if (false == cmd_context.option_enable(cmd, opt)) {
+      continue;
+    }
+    if (false == cmd.option_require_value(opt)) {
+      options.push_back(std::make_pair(cmd.option_name(opt), "on"));
+    } else {
+      options.push_back(std::make_pair(cmd.option_name(opt),
+                                       cmd_context.option_value(cmd, opt)));
+    }
+  }
+  return options;
+}
+
+/*********************************************************************
+ * Find the changes of the memory used by each data structure, from the
+ * memory usage reported before and after a command. The data structures
+ * are reported in the same sequence each time.
+ * Data structures whose memory does not change are skipped
+ ********************************************************************/
+std::vector<std::pair<std::string, long>> find_memory_usage_deltas(
+  const std::vector<std::pair<std::string, size_t>>& memory_usage_start,
+  const std::vector<std::pair<std::string, size_t>>& memory_usage_end) {
+  VTR_ASSERT(memory_usage_start.size() == memory_usage_end.size());
+  std::vector<std::pair<std::string, long>> deltas;
+  for (size_t idata = 0; idata < memory_usage_end.size(); ++idata) {
+    VTR_ASSERT(memory_usage_start[idata].first ==
+               memory_usage_end[idata].first);
+    long delta = (long)memory_usage_end[idata].second -
+                 (long)memory_usage_start[idata].second;
+    if (0 != delta) {
+      deltas.push_back(std::make_pair(memory_usage_end[idata].first, delta));
+    }
+  }
+  return deltas;
+}
+
+/*********************************************************************
+ * Quote a string for a JSON file, escaping the special characters
+ ********************************************************************/
+static std::string json_string(const std::string& str) {
+  std::string quoted("\"");
+  for (const char& c : str) {
+    switch (c) {
+      case '"':
+        quoted += "\\\"";
+        break;
+      case '\\':
+        quoted += "\\\\";
+        break;
+      case '\n':
+        quoted += "\\n";
+        break;
+      case '\r':
+        quoted += "\\r";
+        break;
+      case '\t':
+        quoted += "\\t";
+        break;
+      default:
+        if (0x20 > static_cast<unsigned char>(c)) {
+          char escaped[8];
+          snprintf(escaped, sizeof(escaped), "\\u%04x",
+                   static_cast<unsigned char>(c));
+          quoted += escaped;
+        } else {
+          quoted.push_back(c);
+        }
+    }
+  }
+  quoted.push_back('"');
+  return quoted;
+}
+
+/*********************************************************************
+ * Write the profiling results of commands to a JSON file, in the
+ * sequence of the commands being executed
+ * Return 0 if successful
+ ********************************************************************/
+int write_command_profiles_to_json_file(
+  const std::string& fname, const std::vector<CommandProfile>& profiles) {
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output command profiles!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::string dir_path = format_dir_path(find_path_dir_name(fname));
+  create_directory(dir_path);
+
+  BufferedFileStream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(fname.c_str(), fp);
+
+  fp << "{\n";
+  fp << "  \"commands\": [";
+  for (size_t iprof = 0; iprof < profiles.size(); ++iprof) {
+    const CommandProfile& profile = profiles[iprof];
+    fp << (0 == iprof ? "\n" : ",\n");
+    fp << "    {\n";
+    fp << "      \"name\": " << json_string(profile.command_name) << ",\n";
+    fp << "      \"command_line\": " << json_string(profile.command_line)
+       << ",\n";
+    fp << "      \"options\": {";
+    for (size_t iopt = 0; iopt < profile.options.size(); ++iopt) {
+      fp << (0 == iopt ? "" : ", ") << json_string(profile.options[iopt].first)
+         << ": " << json_string(profile.options[iopt].second);
+    }
+    fp << "},\n";
+    fp << "      \"status\": " << profile.status << ",\n";
+    fp << "      \"wall_time\": " << profile.wall_time << ",\n";
+    fp << "      \"cpu_time\": " << profile.cpu_time << ",\n";
+    fp << "      \"peak_rss_delta_kb\": " << profile.peak_rss_delta << ",\n";
+    fp << "      \"peak_rss_kb\": " << profile.peak_rss << ",\n";
+    if (true == allocation_counting_enabled()) {
+      fp << "      \"num_allocations\": " << profile.num_allocations << ",\n";
+      fp << "      \"allocated_bytes\": " << profile.allocated_bytes << ",\n";
+    }
+    fp << "      \"memory_usage_delta_bytes\": {";
+    for (size_t idata = 0; idata < profile.memory_usage_deltas.size();
+         ++idata) {
+      fp << (0 == idata ? "" : ", ")
+         << json_string(profile.memory_usage_deltas[idata].first) << ": "
+         << profile.memory_usage_deltas[idata].second;
+    }
+    fp << "},\n";
+    fp << "      \"progress\": [";
+    for (size_t iprog = 0; iprog < profile.progress.size(); ++iprog) {
+      const ProgressRecord& record = profile.progress[iprog];
+      double throughput = 0. < record.wall_time
+                            ? (double)record.num_units / record.wall_time
+                            : 0.;
+      fp << (0 == iprog ? "" : ", ") << "{\"name\": "
+         << json_string(record.name)
+         << ", \"unit\": " << json_string(record.unit)
+         << ", \"num_units\": " << record.num_units
+         << ", \"total\": " << record.total
+         << ", \"wall_time\": " << record.wall_time
+         << ", \"throughput\": " << throughput << "}";
+    }
+    fp << "]\n";
+    fp << "    }";
+  }
+  fp << (profiles.empty() ? "]\n" : "\n  ]\n");
+  fp << "}\n";
+
+  fp.close();
+
+  VTR_LOG("Wrote profiles of %lu commands to file '%s'\n", profiles.size(),
+          fname.c_str());
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* End namespace openfpga */
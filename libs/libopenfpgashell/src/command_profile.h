@@ -0,0 +1,92 @@
+#ifndef COMMAND_PROFILE_H
+#define COMMAND_PROFILE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "command.h"
+#include "command_context.h"
+#include "openfpga_alloc_counter.h"
+#include "openfpga_progress.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Profiling results of a command executed in a shell
+ * - The command line as well as the options selected by users
+ * - The execution status of the command
+ * - The wall time and CPU time (in seconds) spent by the command
+ * - The increase of peak resident set size (in KiB) during the command.
+ *   This is zero when the command reuses the memory freed by others
+ * - The peak resident set size (in KiB) when the command finishes
+ * - The number of allocations and the bytes allocated by the command,
+ *   which are only counted when built with OPENFPGA_WITH_ALLOC_COUNTING
+ * - The changes of the memory (in bytes) used by the data structures
+ *   which are reported to the shell, e.g., the module graph, so that the
+ *   memory of a command is attributed to the data structures it builds
+ * - The loops whose progress is tracked inside the command, e.g., the
+ *   clusters repacked, with the units completed and their throughput
+ *******************************************************************/
+struct CommandProfile {
+  std::string command_name;
+  std::string command_line;
+  /* Pairs of <option name, option value> of the selected options.
+   * Option which requires no value is recorded as 'on' */
+  std::vector<std::pair<std::string, std::string>> options;
+  int status = 0;
+  double wall_time = 0.;
+  double cpu_time = 0.;
+  long peak_rss_delta = 0;
+  long peak_rss = 0;
+  size_t num_allocations = 0;
+  size_t allocated_bytes = 0;
+  /* Pairs of <data structure name, change of memory usage in bytes> */
+  std::vector<std::pair<std::string, long>> memory_usage_deltas;
+  std::vector<ProgressRecord> progress;
+};
+
+/********************************************************************
+ * A timer which records the wall time, the CPU time and the peak
+ * resident set size when it is created, and finds their changes
+ * when a command finishes
+ *******************************************************************/
+class CommandProfileTimer {
+ public: /* Constructor */
+  CommandProfileTimer();
+
+ public: /* Public mutators */
+  /* Fill the time and memory spent since the timer is created */
+  void finish(CommandProfile& profile) const;
+
+ private: /* Internal data */
+  std::chrono::steady_clock::time_point wall_start_;
+  std::clock_t cpu_start_;
+  long peak_rss_start_;
+  AllocationCounts alloc_start_;
+};
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+long find_peak_resident_set_size();
+
+std::vector<std::pair<std::string, std::string>> find_command_profile_options(
+  const Command& cmd, const CommandContext& cmd_context);
+
+std::vector<std::pair<std::string, long>> find_memory_usage_deltas(
+  const std::vector<std::pair<std::string, size_t>>& memory_usage_start,
+  const std::vector<std::pair<std::string, size_t>>& memory_usage_end);
+
+int write_command_profiles_to_json_file(
+  const std::string& fname, const std::vector<CommandProfile>& profiles);
+
+} /* End namespace openfpga */
+
+#endif
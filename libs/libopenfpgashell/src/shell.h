@@ -3,13 +3,16 @@
 
 #include <ctime>
 #include <functional>
+#include <istream>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "command.h"
 #include "command_context.h"
 #include "command_exit_codes.h"
+#include "command_profile.h"
 #include "shell_fwd.h"
 #include "vtr_range.h"
 #include "vtr_vector.h"
@@ -105,6 +108,9 @@ class Shell {
     const ShellCommandId& cmd_id) const;
   std::vector<ShellCommandId> commands_by_class(
     const ShellCommandClassId& cmd_class_id) const;
+  /* Profiling results of the executed commands, in the sequence of execution
+   */
+  const std::vector<CommandProfile>& command_profiles() const;
 
  public: /* Public mutators */
   void set_name(const char* name);
@@ -183,7 +189,42 @@ class Shell {
   void set_command_dependency(
     const ShellCommandId& cmd_id,
     const std::vector<ShellCommandId>& cmd_dependency);
+  /* Link a function to be run right before a command is executed, which may
+   * modify the data exchange <T> even for constant commands. This is designed
+   * to build on demand the data that a command requires. The function should
+   * do nothing when the data has already been built.
+   */
+  void set_command_prerequisite(const ShellCommandId& cmd_id,
+                                std::function<int(T&)> prereq_func);
   ShellCommandClassId add_command_class(const char* name);
+  /* Mark a command as if it has been executed with a given exit code.
+   * This is designed for plug-in functions which restore the results of
+   * other commands, so that the commands depending on them can be executed
+   */
+  void set_command_status(const ShellCommandId& cmd_id, const int& status);
+  /* Specify a file where the profiling results of the executed commands
+   * are written when quitting the shell */
+  void set_profile_file(const std::string& fname);
+  /* Record the profile of a command line which has not been profiled by
+   * the shell, e.g., a command line from a server client which is
+   * rejected before being executed */
+  void record_command_profile(const CommandProfile& profile);
+  /* Specify a function which reports the memory (in bytes) used by each
+   * data structure of the common context, as pairs of <name, bytes>.
+   * The changes of memory are recorded in the profile of each command */
+  void set_memory_usage_reporter(
+    std::function<std::vector<std::pair<std::string, size_t>>(const T&)>
+      reporter);
+  /* Specify a function which is called after each command which may modify
+   * the common context, with the tokens of its command line. This is
+   * designed to track the history of the common context, e.g., to digest
+   * the commands which have built it */
+  void set_command_observer(
+    std::function<void(T&, const std::vector<std::string>&)> observer);
+  /* Specify the maximum number of commands which can run at the same time
+   * in script mode. Consecutive commands which only read the common
+   * context are executed concurrently when it is larger than 1 */
+  void set_num_script_jobs(const size_t& num_jobs);
 
  public: /* Public validators */
   bool valid_command_id(const ShellCommandId& cmd_id) const;
@@ -196,6 +237,14 @@ class Shell {
    * commands to run */
   void run_script_mode(const char* script_file_name, T& context,
                        const bool& batch_mode = false);
+  /* Execute the commands of a script file, without entering the interactive
+   * mode. The variables in the form of ${NAME} in the script are replaced by
+   * their values, when any variable is given. Stop at the first command
+   * with a fatal error.
+   * Return CMD_EXEC_FATAL_ERROR if any command fails in a fatal way
+   */
+  int execute_script(const char* script_file_name, T& context,
+                     const std::map<std::string, std::string>& variables);
   /* Print all the commands by their classes. This is actually the help desk */
   void print_commands(const bool& show_hidden = false) const;
   /* Find the exit code (assume quit shell now) */
@@ -211,6 +260,49 @@ class Shell {
    */
   int execute_command(const char* cmd_line, T& common_context,
                       const bool& allow_hidden_command = true);
+  /* Write the profiling results of the executed commands to a JSON file */
+  int write_command_profiles(const std::string& fname) const;
+
+ private: /* Internal executors */
+  int execute_script_stream(
+    std::istream& fp, T& context,
+    const std::map<std::string, std::string>& variables);
+  bool read_script_command_lines(
+    std::istream& fp, const std::map<std::string, std::string>& variables,
+    std::vector<std::string>& cmd_lines,
+    std::vector<size_t>& cmd_line_nums) const;
+  bool check_script_command_lines(
+    const std::vector<std::string>& cmd_lines,
+    const std::vector<size_t>& cmd_line_nums) const;
+  bool expand_script_variables(
+    std::string& cmd_line,
+    const std::map<std::string, std::string>& variables) const;
+  bool split_command_line(const char* cmd_line,
+                          std::vector<std::string>& tokens) const;
+  /* Find if a command line calls a command which only reads the common
+   * context, i.e., whose execute function is a constant one */
+  bool is_const_command_line(const std::string& cmd_line) const;
+  /* Run the prerequisite function of the command called by a command line,
+   * if any */
+  int execute_command_prerequisite(const std::string& cmd_line, T& context);
+  /* Execute a group of command lines calling constant commands, where
+   * independent commands run concurrently in child processes. The logs are
+   * output and the status are updated in the sequence of the command lines
+   */
+  int execute_const_command_group(const std::vector<std::string>& cmd_lines,
+                                  T& context);
+
+ private: /* Internal mutators */
+  void add_command_profile(
+    const ShellCommandId& cmd_id, const char* cmd_line,
+    const CommandProfileTimer& timer,
+    const std::vector<std::pair<std::string, size_t>>& memory_usage_start,
+    const T& common_context);
+  /* Call the command observer, if any, when the command may have modified
+   * the common context */
+  void observe_command(const ShellCommandId& cmd_id,
+                       const std::vector<std::string>& tokens,
+                       T& common_context);
 
  private: /* Internal data */
   /* Name of the shell, this will appear in the interactive mode */
@@ -279,6 +371,9 @@ class Shell {
    */
   vtr::vector<ShellCommandId, e_exec_func_type> command_execute_function_types_;
 
+  /* Functions to run before executing each command, if any */
+  vtr::vector<ShellCommandId, std::function<int(T&)>> command_prerequisites_;
+
   /* A flag to indicate if the command has been executed */
   vtr::vector<ShellCommandId, int> command_status_;
 
@@ -290,13 +385,29 @@ class Shell {
     command_dependencies_;
 
   /* Fast name look-up */
-  std::map<std::string, ShellCommandId> command_name2ids_;
-  std::map<std::string, ShellCommandClassId> command_class2ids_;
+  std::unordered_map<std::string, ShellCommandId> command_name2ids_;
+  std::unordered_map<std::string, ShellCommandClassId> command_class2ids_;
   vtr::vector<ShellCommandClassId, std::vector<ShellCommandId>>
     commands_by_classes_;
 
   /* Timer */
   std::clock_t time_start_;
+
+  /* Profiling results of each executed command, in the sequence of
+   * execution. A command which is executed multiple times has multiple
+   * results
+   */
+  std::vector<CommandProfile> command_profiles_;
+  /* File to write the profiling results when quitting the shell */
+  std::string profile_file_;
+  /* Report the memory used by the data structures of the common context */
+  std::function<std::vector<std::pair<std::string, size_t>>(const T&)>
+    memory_usage_reporter_;
+  /* Observe the commands which may modify the common context */
+  std::function<void(T&, const std::vector<std::string>&)> command_observer_;
+
+  /* Maximum number of commands which run at the same time in script mode */
+  size_t num_script_jobs_;
 };
 
 } /* End namespace openfpga */
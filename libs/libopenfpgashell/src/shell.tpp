@@ -3,13 +3,23 @@
  ********************************************************************/
 #include <fstream>
 #include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+/* Headers from POSIX to run commands in child processes */
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
+#include "openfpga_parallel.h"
 #include "openfpga_tokenizer.h"
+#include "openfpga_trace.h"
 
 /* Headers from readline library */
 #include <readline/readline.h>
@@ -29,6 +39,7 @@ template<class T>
 Shell<T>::Shell() {
   name_ = std::string("shell_no_name");
   time_start_ = 0;
+  num_script_jobs_ = 1;
 }
 
 /************************************************************************
@@ -52,11 +63,11 @@ typename Shell<T>::shell_command_range Shell<T>::commands() const {
 template<class T>
 ShellCommandId Shell<T>::command(const std::string& name) const {
   /* Ensure that the name is unique in the command list */
-  std::map<std::string, ShellCommandId>::const_iterator name_it = command_name2ids_.find(name);
+  auto name_it = command_name2ids_.find(name);
   if (name_it == command_name2ids_.end()) {
     return ShellCommandId::INVALID();
   }
-  return command_name2ids_.at(name);
+  return name_it->second;
 }
 
 template<class T>
@@ -101,6 +112,11 @@ std::vector<ShellCommandId> Shell<T>::commands_by_class(const ShellCommandClassI
   return commands_by_classes_[cmd_class_id];
 }
 
+template<class T>
+const std::vector<CommandProfile>& Shell<T>::command_profiles() const {
+  return command_profiles_;
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
@@ -118,7 +134,7 @@ void Shell<T>::add_title(const char* title) {
 template<class T>
 ShellCommandId Shell<T>::add_command(const Command& cmd, const char* descr, const bool& hidden) {
   /* Ensure that the name is unique in the command list */
-  std::map<std::string, ShellCommandId>::const_iterator name_it = command_name2ids_.find(std::string(cmd.name()));
+  auto name_it = command_name2ids_.find(std::string(cmd.name()));
   if (name_it != command_name2ids_.end()) {
     return ShellCommandId::INVALID();
   }
@@ -142,6 +158,7 @@ ShellCommandId Shell<T>::add_command(const Command& cmd, const char* descr, cons
   command_macro_execute_functions_.emplace_back();
   command_status_.push_back(CMD_EXEC_NONE); /* By default, the command should be marked as fatal error as it has been never executed */
   command_dependencies_.emplace_back();
+  command_prerequisites_.emplace_back();
 
   /* Register the name in the name2id map */
   command_name2ids_[cmd.name()] = shell_cmd;
@@ -237,11 +254,25 @@ void Shell<T>::set_command_dependency(const ShellCommandId& cmd_id,
   command_dependencies_[cmd_id] = dependent_cmds;
 }
 
+template<class T>
+void Shell<T>::set_command_prerequisite(const ShellCommandId& cmd_id,
+                                        std::function<int(T&)> prereq_func) {
+  VTR_ASSERT(true == valid_command_id(cmd_id));
+  command_prerequisites_[cmd_id] = prereq_func;
+}
+
+template<class T>
+void Shell<T>::set_command_status(const ShellCommandId& cmd_id,
+                                  const int& status) {
+  VTR_ASSERT(true == valid_command_id(cmd_id));
+  command_status_[cmd_id] = status;
+}
+
 /* Add a command with it description */
 template<class T>
 ShellCommandClassId Shell<T>::add_command_class(const char* name) {
   /* Ensure that the name is unique in the command list */
-  std::map<std::string, ShellCommandClassId>::const_iterator name_it = command_class2ids_.find(std::string(name));
+  auto name_it = command_class2ids_.find(std::string(name));
   if (name_it != command_class2ids_.end()) {
     return ShellCommandClassId::INVALID();
   }
@@ -260,6 +291,33 @@ ShellCommandClassId Shell<T>::add_command_class(const char* name) {
   return cmd_class;
 } 
 
+template<class T>
+void Shell<T>::set_profile_file(const std::string& fname) {
+  profile_file_ = fname;
+}
+
+template<class T>
+void Shell<T>::record_command_profile(const CommandProfile& profile) {
+  command_profiles_.push_back(profile);
+}
+
+template<class T>
+void Shell<T>::set_memory_usage_reporter(
+  std::function<std::vector<std::pair<std::string, size_t>>(const T&)> reporter) {
+  memory_usage_reporter_ = reporter;
+}
+
+template<class T>
+void Shell<T>::set_command_observer(
+  std::function<void(T&, const std::vector<std::string>&)> observer) {
+  command_observer_ = observer;
+}
+
+template<class T>
+void Shell<T>::set_num_script_jobs(const size_t& num_jobs) {
+  num_script_jobs_ = std::max(num_jobs, size_t(1));
+}
+
 /************************************************************************
  * Public executors
  ***********************************************************************/
@@ -310,8 +368,6 @@ void Shell<T>::run_script_mode(const char* script_file_name,
     VTR_LOG("%s\n", title().c_str());
   } 
 
-  std::string line;
-
   /* Create an input file stream */
   std::ifstream fp(script_file_name);
 
@@ -322,13 +378,121 @@ void Shell<T>::run_script_mode(const char* script_file_name,
     return; 
   }
 
+  int status = execute_script_stream(fp, context, std::map<std::string, std::string>());
+  fp.close();
+
+  /* Check the execution status of the script, 
+   * if fatal error happened, we should abort immediately 
+   */
+  if (CMD_EXEC_FATAL_ERROR == status) {
+    VTR_LOG("Fatal error occurred!\n");
+    /* If in the batch mode, we will exit with errors */ 
+    VTR_LOGV(batch_mode, "%s Abort\n", name_.c_str());
+    if (batch_mode) {
+      exit(CMD_EXEC_FATAL_ERROR);
+    }
+    /* If not in the batch mode, we will got to interactive mode */ 
+    VTR_LOGV(!batch_mode, "Enter interactive mode\n");
+  }
+
+  /* If not in batch mode, switch to interactive mode, stay tuned */
+  if (!batch_mode) {
+    run_interactive_mode(context, true); 
+  }
+}
+
+template <class T>
+int Shell<T>::execute_script(const char* script_file_name,
+                             T& context,
+                             const std::map<std::string, std::string>& variables) {
+  std::ifstream fp(script_file_name);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open the script file: %s! Please check its location\n",
+                  script_file_name);
+    return CMD_EXEC_FATAL_ERROR; 
+  }
+
+  int status = execute_script_stream(fp, context, variables);
+  fp.close();
+
+  return status;
+}
+
+template <class T>
+int Shell<T>::execute_script_stream(std::istream& fp,
+                                    T& context,
+                                    const std::map<std::string, std::string>& variables) {
+  /* Read and check all the command lines before executing any of them,
+   * so that errors in a script are found without running the commands
+   * in front of them
+   */
+  std::vector<std::string> cmd_lines;
+  std::vector<size_t> cmd_line_nums;
+  if (false == read_script_command_lines(fp, variables, cmd_lines, cmd_line_nums)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if (false == check_script_command_lines(cmd_lines, cmd_line_nums)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Consecutive command lines calling constant commands, which are
+   * executed together when a non-constant command or the end of script is
+   * reached. Only used when multiple jobs are allowed
+   */
+  std::vector<std::string> const_cmd_lines;
+
+  for (const std::string& cmd_line : cmd_lines) {
+    /* Defer the constant commands, so that they can run concurrently.
+     * Their prerequisites may modify the context, so they are run here in
+     * the sequence of the script and shared by the child processes */
+    if ((1 < num_script_jobs_) && (true == is_const_command_line(cmd_line))) {
+      if (CMD_EXEC_FATAL_ERROR == execute_command_prerequisite(cmd_line, context)) {
+        return CMD_EXEC_FATAL_ERROR;
+      }
+      const_cmd_lines.push_back(cmd_line);
+      continue;
+    }
+    if (CMD_EXEC_FATAL_ERROR == execute_const_command_group(const_cmd_lines, context)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    const_cmd_lines.clear();
+    VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
+    /* Do not allow any hidden command to be directly called by users */
+    int status = execute_command(cmd_line.c_str(), context, false);
+
+    /* Check the execution status of the command, 
+     * if fatal error happened, we should abort immediately 
+     */
+    if (CMD_EXEC_FATAL_ERROR == status) {
+      return status;
+    }
+  }
+
+  return execute_const_command_group(const_cmd_lines, context);
+}
+
+/* Read all the command lines of a script, where comments are removed,
+ * continued lines are joined and variables are replaced by their values.
+ * The number of the line where each command line starts is recorded
+ * for error messages
+ */
+template <class T>
+bool Shell<T>::read_script_command_lines(std::istream& fp,
+                                         const std::map<std::string, std::string>& variables,
+                                         std::vector<std::string>& cmd_lines,
+                                         std::vector<size_t>& cmd_line_nums) const {
+  std::string line;
+  size_t line_num = 0;
+
   /* Consider that each line may not end due to the continued line charactor 
    * Use cmd_line to conjunct multiple lines 
    */
   std::string cmd_line;
+  size_t cmd_line_num = 0;
 
   /* Read line by line */
   while (getline(fp, line)) {
+    line_num++;
     /* Skip empty line */
     if (true == line.empty()) {
       continue;
@@ -353,8 +517,12 @@ void Shell<T>::run_script_mode(const char* script_file_name,
     cmd_part_tokenizer.rtrim(std::string(" "));
     cmd_part = cmd_part_tokenizer.data();
 
+    if (true == cmd_line.empty()) {
+      cmd_line_num = line_num;
+    }
+
     /* If the line ends with '\', this is a continued line, parse the next until it ends */
-    if ('\\' == cmd_part.back()) {
+    if (!cmd_part.empty() && '\\' == cmd_part.back()) {
       /* Pop up the last charactor and conjunct to cmd_line */
       cmd_part.pop_back();
  
@@ -378,34 +546,308 @@ void Shell<T>::run_script_mode(const char* script_file_name,
 
     /* Process the command only when the full command line in ended */
     if (!cmd_line.empty()) {
-      VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
-      /* Do not allow any hidden command to be directly called by users */
-      int status = execute_command(cmd_line.c_str(), context, false);
+      /* Replace the variables with their values, if any is defined */
+      if ((false == variables.empty())
+         && (false == expand_script_variables(cmd_line, variables))) {
+        VTR_LOG_ERROR("Invalid variable at line %lu of the script!\n", cmd_line_num);
+        return false;
+      }
+      cmd_lines.push_back(cmd_line);
+      cmd_line_nums.push_back(cmd_line_num);
       /* Empty the line ready to start a new line */
       cmd_line.clear();
+    }
+  }
 
-      /* Check the execution status of the command, 
-       * if fatal error happened, we should abort immediately 
-       */
-      if (CMD_EXEC_FATAL_ERROR == status) {
-        VTR_LOG("Fatal error occurred!\n");
-        /* If in the batch mode, we will exit with errors */ 
-        VTR_LOGV(batch_mode, "%s Abort\n", name_.c_str());
-        if (batch_mode) {
-          exit(CMD_EXEC_FATAL_ERROR);
-        }
-        /* If not in the batch mode, we will got to interactive mode */ 
-        VTR_LOGV(!batch_mode, "Enter interactive mode\n");
+  return true;
+}
+
+/* Check that each command line calls a command which is defined and not
+ * hidden, with valid options. All the invalid command lines are reported.
+ * Note that the dependency between commands is checked when executing
+ * the commands, as a command may be executed by commands before it,
+ * e.g., when restoring a context
+ */
+template <class T>
+bool Shell<T>::check_script_command_lines(const std::vector<std::string>& cmd_lines,
+                                          const std::vector<size_t>& cmd_line_nums) const {
+  size_t num_errors = 0;
+  for (size_t iline = 0; iline < cmd_lines.size(); ++iline) {
+    std::vector<std::string> tokens;
+    bool valid = split_command_line(cmd_lines[iline].c_str(), tokens) && !tokens.empty();
+    ShellCommandId cmd_id = valid ? command(tokens[0]) : ShellCommandId::INVALID();
+    if (valid && (ShellCommandId::INVALID() == cmd_id || command_hidden_[cmd_id])) {
+      VTR_LOG("Try to call a command '%s' which is not defined!\n",
+              tokens[0].c_str());
+      valid = false;
+    }
+    /* Macro command has its own parser */
+    if (valid && MACRO != command_execute_function_types_[cmd_id]) {
+      CommandContext cmd_context(commands_[cmd_id]);
+      valid = parse_command(tokens, commands_[cmd_id], cmd_context);
+    }
+    if (!valid) {
+      VTR_LOG_ERROR("Invalid command line at line %lu of the script: %s\n",
+                    cmd_line_nums[iline], cmd_lines[iline].c_str());
+      num_errors++;
+    }
+  }
+
+  if (0 < num_errors) {
+    VTR_LOG_ERROR("Found %lu invalid command lines in the script. No command is executed!\n",
+                  num_errors);
+    return false;
+  }
+  return true;
+}
+
+template <class T>
+bool Shell<T>::is_const_command_line(const std::string& cmd_line) const {
+  StringToken tokenizer(cmd_line);
+  std::vector<std::string> tokens = tokenizer.split(" ");
+  if (tokens.empty()) {
+    return false;
+  }
+  ShellCommandId cmd_id = command(tokens[0]);
+  if (ShellCommandId::INVALID() == cmd_id) {
+    return false;
+  }
+  return (CONST_STANDARD == command_execute_function_types_[cmd_id])
+      || (CONST_SHORT == command_execute_function_types_[cmd_id]);
+}
+
+template <class T>
+int Shell<T>::execute_command_prerequisite(const std::string& cmd_line,
+                                           T& context) {
+  StringToken tokenizer(cmd_line);
+  std::vector<std::string> tokens = tokenizer.split(" ");
+  if (tokens.empty()) {
+    return CMD_EXEC_SUCCESS;
+  }
+  ShellCommandId cmd_id = command(tokens[0]);
+  if ((ShellCommandId::INVALID() == cmd_id) || (!command_prerequisites_[cmd_id])) {
+    return CMD_EXEC_SUCCESS;
+  }
+  return command_prerequisites_[cmd_id](context);
+}
+
+/* Execute a group of constant commands. A constant command cannot modify
+ * the common context, so that a command only waits for the commands in the
+ * group which it depends on. Each command runs in a child process, which
+ * shares the common context with the shell, and whose output is captured
+ * in a temporary file. Once all the commands finish, the outputs are
+ * replayed and the status are updated in the sequence of the command lines.
+ * Therefore, the logs and the exit code do not depend on the scheduling.
+ *
+ * Different from executing commands one by one, all the commands of the
+ * group are executed even when one of them fails in a fatal way.
+ * The CPU time of a command in the profiles comes from its child process,
+ * while the memory of child processes is not accounted.
+ *
+ * A child process only has the thread which forks it. The commands are
+ * executed one by one when other threads of the shell are still working,
+ * e.g., writing a file in the background, as their locks and buffers
+ * would be copied in an undefined state. The idle workers of TBB are not
+ * used by the child processes, which run all their tasks on a single thread.
+ */
+template <class T>
+int Shell<T>::execute_const_command_group(const std::vector<std::string>& cmd_lines,
+                                          T& context) {
+  if (cmd_lines.empty()) {
+    return CMD_EXEC_SUCCESS;
+  }
+  /* Nothing to run concurrently */
+  if (1 == cmd_lines.size()) {
+    VTR_LOG("\nCommand line to execute: %s\n", cmd_lines.front().c_str());
+    return execute_command(cmd_lines.front().c_str(), context, false);
+  }
+
+  if ((0 < num_running_parallel_loops()) || (0 < num_async_output_files())) {
+    VTR_LOG_WARN("Background threads are running. Execute the commands one by one!\n");
+    for (const std::string& cmd_line : cmd_lines) {
+      VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
+      if (CMD_EXEC_FATAL_ERROR == execute_command(cmd_line.c_str(), context, false)) {
+        return CMD_EXEC_FATAL_ERROR;
+      }
+    }
+    return CMD_EXEC_SUCCESS;
+  }
+
+  ScopedTrace group_trace("concurrent commands");
+
+  /* Find the commands in the group that each command depends on */
+  std::vector<ShellCommandId> cmd_ids;
+  for (const std::string& cmd_line : cmd_lines) {
+    cmd_ids.push_back(command(StringToken(cmd_line).split(" ").front()));
+  }
+  std::vector<std::vector<size_t>> job_dependencies(cmd_lines.size());
+  for (size_t ijob = 0; ijob < cmd_lines.size(); ++ijob) {
+    const std::vector<ShellCommandId>& cmd_deps = command_dependencies_[cmd_ids[ijob]];
+    for (size_t idep = 0; idep < ijob; ++idep) {
+      if (cmd_deps.end() != std::find(cmd_deps.begin(), cmd_deps.end(), cmd_ids[idep])) {
+        job_dependencies[ijob].push_back(idep);
+      }
+    }
+  }
+
+  std::vector<pid_t> job_pids(cmd_lines.size(), -1);
+  std::vector<std::FILE*> job_logs(cmd_lines.size(), nullptr);
+  std::vector<CommandProfileTimer> job_timers(cmd_lines.size());
+  std::vector<CommandProfile> job_profiles(cmd_lines.size());
+  std::vector<int> job_status(cmd_lines.size(), CMD_EXEC_NONE);
+  size_t num_running = 0;
+  size_t num_finished = 0;
+
+  /* Avoid the buffered outputs being duplicated in the child processes,
+   * including those of the log file of VTR */
+  std::cout.flush();
+  std::fflush(nullptr);
+
+  while (num_finished < cmd_lines.size()) {
+    /* Launch the commands whose dependencies have finished */
+    for (size_t ijob = 0; ijob < cmd_lines.size(); ++ijob) {
+      if (num_running == num_script_jobs_) {
         break;
       }
+      if (-1 != job_pids[ijob] || CMD_EXEC_NONE != job_status[ijob]) {
+        continue;
+      }
+      bool ready = true;
+      for (const size_t& idep : job_dependencies[ijob]) {
+        ready = ready && (CMD_EXEC_NONE != job_status[idep]);
+      }
+      if (!ready) {
+        continue;
+      }
+      job_logs[ijob] = std::tmpfile();
+      job_timers[ijob] = CommandProfileTimer();
+      pid_t pid = (nullptr == job_logs[ijob]) ? -1 : fork();
+      if (0 == pid) {
+        /* Child process: run the command and exit with its status.
+         * The tasks and the files are handled by this thread only. The log
+         * file of VTR is left to the shell, which replays the output */
+        disable_parallel_threads();
+        set_async_output(false);
+        vtr::set_log_file(nullptr);
+        dup2(fileno(job_logs[ijob]), STDOUT_FILENO);
+        dup2(fileno(job_logs[ijob]), STDERR_FILENO);
+        int status = execute_command(cmd_lines[ijob].c_str(), context, false);
+        std::cout.flush();
+        std::fflush(stdout);
+        std::fflush(stderr);
+        _exit(status);
+      }
+      if (-1 == pid) {
+        /* Fail to launch, the error is reported in the sequence */
+        if (nullptr != job_logs[ijob]) {
+          std::fclose(job_logs[ijob]);
+          job_logs[ijob] = nullptr;
+        }
+        job_status[ijob] = CMD_EXEC_FATAL_ERROR;
+        num_finished++;
+        continue;
+      }
+      job_pids[ijob] = pid;
+      num_running++;
     }
+
+    /* Nothing is running when the rest of commands fail to launch */
+    if (0 == num_running) {
+      continue;
+    }
+
+    /* Wait for any command to finish */
+    int wait_status = 0;
+    struct rusage usage;
+    pid_t pid = wait4(-1, &wait_status, 0, &usage);
+    auto result = std::find(job_pids.begin(), job_pids.end(), pid);
+    if (job_pids.end() == result) {
+      continue;
+    }
+    size_t ijob = result - job_pids.begin();
+    job_pids[ijob] = -1;
+    job_status[ijob] = CMD_EXEC_FATAL_ERROR;
+    if (WIFEXITED(wait_status)) {
+      job_status[ijob] = WEXITSTATUS(wait_status);
+    }
+    job_timers[ijob].finish(job_profiles[ijob]);
+    job_profiles[ijob].cpu_time = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+                                + 1e-6 * (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+    /* The status is required by the commands depending on it */
+    command_status_[cmd_ids[ijob]] = job_status[ijob];
+    num_running--;
+    num_finished++;
   }
-  fp.close();
 
-  /* If not in batch mode, switch to interactive mode, stay tuned */
-  if (!batch_mode) {
-    run_interactive_mode(context, true); 
+  /* Replay the outputs and record the profiles in the sequence */
+  int group_status = CMD_EXEC_SUCCESS;
+  for (size_t ijob = 0; ijob < cmd_lines.size(); ++ijob) {
+    VTR_LOG("\nCommand line to execute: %s\n", cmd_lines[ijob].c_str());
+    if (nullptr == job_logs[ijob]) {
+      VTR_LOG_ERROR("Fail to launch command '%s' in a child process!\n",
+                    commands_[cmd_ids[ijob]].name().c_str());
+    } else {
+      std::rewind(job_logs[ijob]);
+      char buffer[4096];
+      size_t num_chars = 0;
+      while (0 < (num_chars = std::fread(buffer, 1, sizeof(buffer) - 1, job_logs[ijob]))) {
+        buffer[num_chars] = '\0';
+        VTR_LOG("%s", buffer);
+      }
+      std::fclose(job_logs[ijob]);
+    }
+
+    /* The options are parsed in the child process. Parse them again so that
+     * the command context is the same as executing the command here.
+     * A command with invalid options has failed in a fatal way */
+    const ShellCommandId& cmd_id = cmd_ids[ijob];
+    std::vector<std::string> tokens;
+    if ((CMD_EXEC_FATAL_ERROR != job_status[ijob])
+       && (true == split_command_line(cmd_lines[ijob].c_str(), tokens))) {
+      command_contexts_[cmd_id].reset();
+      parse_command(tokens, commands_[cmd_id], command_contexts_[cmd_id]);
+      job_profiles[ijob].options = find_command_profile_options(commands_[cmd_id],
+                                                                command_contexts_[cmd_id]);
+    }
+    command_status_[cmd_id] = job_status[ijob];
+    job_profiles[ijob].command_name = commands_[cmd_id].name();
+    job_profiles[ijob].command_line = cmd_lines[ijob];
+    job_profiles[ijob].status = job_status[ijob];
+    command_profiles_.push_back(job_profiles[ijob]);
+
+    if (CMD_EXEC_FATAL_ERROR == job_status[ijob]) {
+      group_status = CMD_EXEC_FATAL_ERROR;
+    }
   }
+
+  return group_status;
+}
+
+/* Replace each variable in the form of ${NAME} in a command line
+ * with its value. Error out if a variable is not defined */
+template <class T>
+bool Shell<T>::expand_script_variables(std::string& cmd_line,
+                                       const std::map<std::string, std::string>& variables) const {
+  size_t var_start = cmd_line.find("${");
+  while (std::string::npos != var_start) {
+    size_t var_end = cmd_line.find('}', var_start);
+    if (std::string::npos == var_end) {
+      VTR_LOG_ERROR("Unterminated variable in command line: %s\n",
+                    cmd_line.c_str());
+      return false;
+    }
+    std::string var_name = cmd_line.substr(var_start + 2, var_end - var_start - 2);
+    auto var_it = variables.find(var_name);
+    if (var_it == variables.end()) {
+      VTR_LOG_ERROR("Undefined variable '%s' in command line: %s\n",
+                    var_name.c_str(), cmd_line.c_str());
+      return false;
+    }
+    cmd_line.replace(var_start, var_end - var_start + 1, var_it->second);
+    /* Values are not expanded again */
+    var_start = cmd_line.find("${", var_start + var_it->second.size());
+  }
+  return true;
 }
 
 template <class T>
@@ -498,6 +940,12 @@ void Shell<T>::exit(const int& init_err) const {
           name_.c_str(),
           (double)(std::clock() - time_start_) / (double)CLOCKS_PER_SEC);
 
+  /* Output the profiling results and traces if required */
+  if (!profile_file_.empty()) {
+    write_command_profiles(profile_file_);
+  }
+  finish_trace();
+
   VTR_LOG("\nThank you for using %s!\n",
           name().c_str());
 
@@ -507,9 +955,10 @@ void Shell<T>::exit(const int& init_err) const {
 /************************************************************************
  * Private executors
  ***********************************************************************/
+/* Split a command line into tokens, where a string in quotes "" is a token */
 template <class T>
-int Shell<T>::execute_command(const char* cmd_line,
-                               T& common_context, const bool& allow_hidden_command) {
+bool Shell<T>::split_command_line(const char* cmd_line,
+                                  std::vector<std::string>& tokens) const {
   openfpga::StringToken tokenizer(cmd_line);  
   tokenizer.add_delim(' ');
   /* Do not split the string in each quote "", as they should be a piece */
@@ -517,20 +966,29 @@ int Shell<T>::execute_command(const char* cmd_line,
   /* Quote should be not be started with! */
   if (!quote_anchors.empty() && quote_anchors.front() == 0) {
     VTR_LOG("Quotes (\") should NOT be the first charactor in command line: '%s'\n", cmd_line);
-    return CMD_EXEC_FATAL_ERROR;
+    return false;
   }
   /* Quotes must be in pairs! */
   if (0 != quote_anchors.size() % 2) {
     VTR_LOG("Quotes (\") are not in pair in command line: '%s'\n", cmd_line);
-    return CMD_EXEC_FATAL_ERROR;
+    return false;
   }
   /* Tokenize the line based on anchors */
-  std::vector<std::string> tokens;
   if (quote_anchors.empty()) {
     tokens = tokenizer.split(" ");
   } else {
     tokens = tokenizer.split_by_chunks('\"');
   } 
+  return true;
+}
+
+template <class T>
+int Shell<T>::execute_command(const char* cmd_line,
+                               T& common_context, const bool& allow_hidden_command) {
+  std::vector<std::string> tokens;
+  if (false == split_command_line(cmd_line, tokens)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
 
   /* Find if the command name is valid */
   ShellCommandId cmd_id = command(tokens[0]);
@@ -561,6 +1019,14 @@ int Shell<T>::execute_command(const char* cmd_line,
     } 
   }
 
+  /* Start profiling the command, including the parsing of its options */
+  CommandProfileTimer profile_timer;
+  std::vector<std::pair<std::string, size_t>> memory_usage_start;
+  if (memory_usage_reporter_) {
+    memory_usage_start = memory_usage_reporter_(common_context);
+  }
+  ScopedTrace command_trace(commands_[cmd_id].name());
+
   /* Find the command! Parse the options 
    * Note:
    * Macro command will not be parsed! It will be directly executed
@@ -580,6 +1046,10 @@ int Shell<T>::execute_command(const char* cmd_line,
     }
     free(argv);
 
+    add_command_profile(cmd_id, cmd_line, profile_timer, memory_usage_start,
+                        common_context);
+    observe_command(cmd_id, tokens, common_context);
+
     /* Finish for macro command, return */
     return command_status_[cmd_id];
   }
@@ -592,12 +1062,24 @@ int Shell<T>::execute_command(const char* cmd_line,
     /* Echo the command */
     print_command_options(commands_[cmd_id]);
     command_status_[cmd_id] = CMD_EXEC_FATAL_ERROR;
+    add_command_profile(cmd_id, cmd_line, profile_timer, memory_usage_start,
+                        common_context);
     return CMD_EXEC_FATAL_ERROR;
   }
  
   /* Parse succeed. Let user to confirm selected options */ 
   print_command_context(commands_[cmd_id], command_contexts_[cmd_id]);
 
+  /* Build the data required by the command, if not yet */
+  if (command_prerequisites_[cmd_id]) {
+    if (CMD_EXEC_FATAL_ERROR == command_prerequisites_[cmd_id](common_context)) {
+      command_status_[cmd_id] = CMD_EXEC_FATAL_ERROR;
+      add_command_profile(cmd_id, cmd_line, profile_timer, memory_usage_start,
+                          common_context);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
   /* Execute the command depending on the type of function ! */ 
   switch (command_execute_function_types_[cmd_id]) {
   case PLUGIN:
@@ -632,6 +1114,10 @@ int Shell<T>::execute_command(const char* cmd_line,
     return CMD_EXEC_FATAL_ERROR;
   }
 
+  add_command_profile(cmd_id, cmd_line, profile_timer, memory_usage_start,
+                      common_context);
+  observe_command(cmd_id, tokens, common_context);
+
   /* Forbid users to return the status CMD_EXEC_NONE */
   if (CMD_EXEC_NONE == command_status_[cmd_id]) {
     VTR_LOG_ERROR("It is illegal to return never-executed status for an executed command!\n");
@@ -641,6 +1127,65 @@ int Shell<T>::execute_command(const char* cmd_line,
   return command_status_[cmd_id];
 }
 
+template <class T>
+int Shell<T>::write_command_profiles(const std::string& fname) const {
+  return write_command_profiles_to_json_file(fname, command_profiles_);
+}
+
+/************************************************************************
+ * Private mutators
+ ***********************************************************************/
+/* Record the profiling results of a command which has just finished.
+ * Note that a command calling other commands, e.g., source, is
+ * recorded after the commands it calls, and its time includes them
+ */
+template <class T>
+void Shell<T>::add_command_profile(const ShellCommandId& cmd_id,
+                                   const char* cmd_line,
+                                   const CommandProfileTimer& timer,
+                                   const std::vector<std::pair<std::string, size_t>>& memory_usage_start,
+                                   const T& common_context) {
+  CommandProfile profile;
+  profile.command_name = commands_[cmd_id].name();
+  profile.command_line = std::string(cmd_line);
+  /* Options of a macro command are not parsed by the shell */
+  if (MACRO != command_execute_function_types_[cmd_id]) {
+    profile.options = find_command_profile_options(commands_[cmd_id],
+                                                   command_contexts_[cmd_id]);
+  }
+  profile.status = command_status_[cmd_id];
+  timer.finish(profile);
+  if (memory_usage_reporter_) {
+    profile.memory_usage_deltas = find_memory_usage_deltas(
+      memory_usage_start, memory_usage_reporter_(common_context));
+  }
+  /* Loops finished by the commands called by this one are taken already */
+  profile.progress = take_progress_records();
+  command_profiles_.push_back(profile);
+}
+
+template <class T>
+void Shell<T>::observe_command(const ShellCommandId& cmd_id,
+                               const std::vector<std::string>& tokens,
+                               T& common_context) {
+  if (!command_observer_) {
+    return;
+  }
+  /* Constant, floating and built-in commands cannot modify the common
+   * context. Macro commands are observed as they build the data that the
+   * common context refers to, e.g., the results of VPR */
+  switch (command_execute_function_types_[cmd_id]) {
+  case PLUGIN:
+  case STANDARD:
+  case SHORT:
+  case MACRO:
+    command_observer_(common_context, tokens);
+    break;
+  default:
+    break;
+  }
+}
+
 /************************************************************************
  * Public invalidators/validators 
  ***********************************************************************/
@@ -0,0 +1,97 @@
+/********************************************************************
+ * This file includes the counters of memory allocations, and the
+ * replacement of the global operator new and delete which updates
+ * them when OPENFPGA_WITH_ALLOC_COUNTING is defined
+ *******************************************************************/
+#include "openfpga_alloc_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* The counters are updated by every thread, without any ordering */
+static std::atomic<size_t> num_allocations_(0);
+static std::atomic<size_t> num_allocated_bytes_(0);
+
+/********************************************************************
+ * Identify if the allocations are counted in this build
+ *******************************************************************/
+bool allocation_counting_enabled() {
+#ifdef OPENFPGA_WITH_ALLOC_COUNTING
+  return true;
+#else
+  return false;
+#endif
+}
+
+/********************************************************************
+ * Find the number of allocations and the number of bytes allocated
+ * since the program starts
+ *******************************************************************/
+AllocationCounts find_allocation_counts() {
+  AllocationCounts counts;
+  counts.num_allocations = num_allocations_.load(std::memory_order_relaxed);
+  counts.num_bytes = num_allocated_bytes_.load(std::memory_order_relaxed);
+  return counts;
+}
+
+#ifdef OPENFPGA_WITH_ALLOC_COUNTING
+/********************************************************************
+ * Allocate memory and count it, which is shared by all the variants
+ * of operator new. Return nullptr if the allocation fails
+ *******************************************************************/
+static void* counted_malloc(size_t num_bytes) {
+  void* ptr = std::malloc(0 == num_bytes ? 1 : num_bytes);
+  if (nullptr != ptr) {
+    num_allocations_.fetch_add(1, std::memory_order_relaxed);
+    num_allocated_bytes_.fetch_add(num_bytes, std::memory_order_relaxed);
+  }
+  return ptr;
+}
+#endif
+
+} /* namespace openfpga ends */
+
+#ifdef OPENFPGA_WITH_ALLOC_COUNTING
+/********************************************************************
+ * Replacements of the global operator new and delete.
+ * The aligned variants are not replaced, as they are paired with
+ * their own operator delete in the standard library
+ *******************************************************************/
+void* operator new(size_t num_bytes) {
+  void* ptr = openfpga::counted_malloc(num_bytes);
+  if (nullptr == ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new[](size_t num_bytes) { return operator new(num_bytes); }
+
+void* operator new(size_t num_bytes, const std::nothrow_t&) noexcept {
+  return openfpga::counted_malloc(num_bytes);
+}
+
+void* operator new[](size_t num_bytes, const std::nothrow_t&) noexcept {
+  return openfpga::counted_malloc(num_bytes);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+#endif
@@ -0,0 +1,31 @@
+#ifndef OPENFPGA_ALLOC_COUNTER_H
+#define OPENFPGA_ALLOC_COUNTER_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+
+/********************************************************************
+ * Counters of the memory allocations made through operator new.
+ * The counters are only available when the code is compiled with
+ * OPENFPGA_WITH_ALLOC_COUNTING, which replaces the global operator
+ * new and delete. Otherwise, the counters are always zero.
+ * The counters are cumulative, so the allocations made by a piece of
+ * code are the difference of the counters before and after it
+ *******************************************************************/
+/* namespace openfpga begins */
+namespace openfpga {
+
+struct AllocationCounts {
+  size_t num_allocations = 0;
+  size_t num_bytes = 0;
+};
+
+bool allocation_counting_enabled();
+
+AllocationCounts find_allocation_counts();
+
+} /* namespace openfpga ends */
+
+#endif
@@ -0,0 +1,113 @@
+/********************************************************************
+ * This file includes the member functions of the writer and the reader
+ * of binary images, as well as the overloads for non-template types
+ *******************************************************************/
+#include "openfpga_binary_image.h"
+
+#include <cstring>
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * Member functions of class BinaryImageWriter
+ *******************************************************************/
+BinaryImageWriter::BinaryImageWriter(std::fstream& fp)
+  : fp_(&fp), digest_(0xcbf29ce484222325ULL) {}
+
+BinaryImageWriter::BinaryImageWriter()
+  : fp_(nullptr), digest_(0xcbf29ce484222325ULL) {}
+
+uint64_t BinaryImageWriter::digest() const { return digest_; }
+
+void BinaryImageWriter::write_bytes(const void* data,
+                                    const size_t& num_bytes) {
+  if (nullptr != fp_) {
+    fp_->write(static_cast<const char*>(data), num_bytes);
+    return;
+  }
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    digest_ ^= bytes[ibyte];
+    digest_ *= 0x100000001b3ULL;
+  }
+}
+
+/********************************************************************
+ * Member functions of class BinaryImageReader
+ *******************************************************************/
+BinaryImageReader::BinaryImageReader(const std::string& fname)
+  : fname_(fname), file_(fname.c_str()), offset_(0) {
+  if (false == file_.is_open()) {
+    archfpga_throw(fname.c_str(), 0, "Fail to map file '%s' to memory!\n",
+                   fname.c_str());
+  }
+}
+
+size_t BinaryImageReader::num_remaining_bytes() const {
+  return file_.size() - offset_;
+}
+
+void BinaryImageReader::read_bytes(void* data, const size_t& num_bytes) {
+  if (num_bytes > num_remaining_bytes()) {
+    archfpga_throw(fname_.c_str(), 0, "Unexpected end of file '%s'!\n",
+                   fname_.c_str());
+  }
+  if (0 < num_bytes) {
+    std::memcpy(data, file_.data() + offset_, num_bytes);
+  }
+  offset_ += num_bytes;
+}
+
+/********************************************************************
+ * Overloads for non-template types
+ *******************************************************************/
+void write_binary_image(BinaryImageWriter& writer, const std::string& data) {
+  write_binary_image(writer, static_cast<uint64_t>(data.size()));
+  writer.write_bytes(data.data(), data.size());
+}
+
+void write_binary_image(BinaryImageWriter& writer, const BasicPort& data) {
+  write_binary_image(writer, data.get_name());
+  write_binary_image(writer, static_cast<uint64_t>(data.get_lsb()));
+  write_binary_image(writer, static_cast<uint64_t>(data.get_msb()));
+  write_binary_image(writer,
+                     static_cast<uint64_t>(data.get_origin_port_width()));
+}
+
+size_t read_binary_image_size(BinaryImageReader& reader) {
+  uint64_t size = 0;
+  read_binary_image(reader, size);
+  if (size > reader.num_remaining_bytes()) {
+    /* Trigger the error on the end of file */
+    reader.read_bytes(nullptr, size);
+  }
+  return size;
+}
+
+void read_binary_image(BinaryImageReader& reader, std::string& data) {
+  data.resize(read_binary_image_size(reader));
+  reader.read_bytes(&data[0], data.size());
+}
+
+/* Set the internal data of the port as it is, as the constructors
+ * would make a port invalid when its LSB is larger than its MSB */
+void read_binary_image(BinaryImageReader& reader, BasicPort& data) {
+  std::string name;
+  uint64_t lsb = 0;
+  uint64_t msb = 0;
+  uint64_t origin_port_width = 0;
+  read_binary_image(reader, name);
+  read_binary_image(reader, lsb);
+  read_binary_image(reader, msb);
+  read_binary_image(reader, origin_port_width);
+  data.set_name(name);
+  data.set_lsb(lsb);
+  data.set_msb(msb);
+  data.set_origin_port_width(origin_port_width);
+}
+
+}  // namespace openfpga
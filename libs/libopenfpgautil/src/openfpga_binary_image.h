@@ -0,0 +1,328 @@
+#ifndef OPENFPGA_BINARY_IMAGE_H
+#define OPENFPGA_BINARY_IMAGE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "openfpga_mapped_file.h"
+#include "openfpga_port.h"
+#include "vtr_vector.h"
+
+/********************************************************************
+ * Writer and reader of binary images, which store the internal data of
+ * objects so that the objects can be restored exactly in another run.
+ *
+ * All the numbers are stored in the native byte order of the machine,
+ * so that plain data and arrays of plain data are copied as they are.
+ * An image is only expected to be read on the same kind of machine,
+ * which is checked by the header of the image.
+ * Containers are led by their sizes, and nested containers are stored
+ * recursively.
+ *
+ * The image is memory-mapped when being read, and any read beyond the
+ * end of the image errors out.
+ *******************************************************************/
+/* namespace openfpga begins */
+namespace openfpga {
+
+class BinaryImageWriter {
+ public: /* Constructors */
+  explicit BinaryImageWriter(std::fstream& fp);
+  /* A writer without any file, which only computes a digest of the bytes
+   * written, so that objects can be compared by their images */
+  BinaryImageWriter();
+
+ public: /* Public accessors */
+  /* The 64-bit FNV-1a digest of the bytes written by a writer without any
+   * file. Writers to files do not compute digests */
+  uint64_t digest() const;
+
+ public: /* Public mutators */
+  void write_bytes(const void* data, const size_t& num_bytes);
+
+ private: /* Internal data */
+  std::fstream* fp_;
+  uint64_t digest_;
+};
+
+class BinaryImageReader {
+ public: /* Constructors */
+  /* Map a file to memory. Error out if the file cannot be mapped */
+  explicit BinaryImageReader(const std::string& fname);
+  BinaryImageReader(const BinaryImageReader&) = delete;
+  BinaryImageReader& operator=(const BinaryImageReader&) = delete;
+
+ public: /* Public accessors */
+  /* Number of bytes which have not been read yet */
+  size_t num_remaining_bytes() const;
+
+ public: /* Public mutators */
+  void read_bytes(void* data, const size_t& num_bytes);
+
+ private: /* Internal data */
+  std::string fname_;
+  MappedFile file_;
+  size_t offset_;
+};
+
+/* Declare all the overloads first, so that they can find each other
+ * when nested */
+template <class T>
+typename std::enable_if<std::is_trivially_copyable<T>::value>::type
+write_binary_image(BinaryImageWriter& writer, const T& data);
+void write_binary_image(BinaryImageWriter& writer, const std::string& data);
+void write_binary_image(BinaryImageWriter& writer, const BasicPort& data);
+template <class T1, class T2>
+void write_binary_image(BinaryImageWriter& writer,
+                        const std::pair<T1, T2>& data);
+template <class T, size_t N>
+typename std::enable_if<!std::is_trivially_copyable<T>::value>::type
+write_binary_image(BinaryImageWriter& writer, const std::array<T, N>& data);
+template <class T, class A>
+void write_binary_image(BinaryImageWriter& writer,
+                        const std::vector<T, A>& data);
+template <class A>
+void write_binary_image(BinaryImageWriter& writer,
+                        const std::vector<bool, A>& data);
+template <class K, class V, class A>
+void write_binary_image(BinaryImageWriter& writer,
+                        const vtr::vector<K, V, A>& data);
+template <class K, class V, class C, class A>
+void write_binary_image(BinaryImageWriter& writer,
+                        const std::map<K, V, C, A>& data);
+template <class K, class V, class H, class E, class A>
+void write_binary_image(BinaryImageWriter& writer,
+                        const std::unordered_map<K, V, H, E, A>& data);
+template <class K, class H, class E, class A>
+void write_binary_image(BinaryImageWriter& writer,
+                        const std::unordered_set<K, H, E, A>& data);
+
+template <class T>
+typename std::enable_if<std::is_trivially_copyable<T>::value>::type
+read_binary_image(BinaryImageReader& reader, T& data);
+void read_binary_image(BinaryImageReader& reader, std::string& data);
+void read_binary_image(BinaryImageReader& reader, BasicPort& data);
+template <class T1, class T2>
+void read_binary_image(BinaryImageReader& reader, std::pair<T1, T2>& data);
+template <class T, size_t N>
+typename std::enable_if<!std::is_trivially_copyable<T>::value>::type
+read_binary_image(BinaryImageReader& reader, std::array<T, N>& data);
+template <class T, class A>
+void read_binary_image(BinaryImageReader& reader, std::vector<T, A>& data);
+template <class A>
+void read_binary_image(BinaryImageReader& reader,
+                       std::vector<bool, A>& data);
+template <class K, class V, class A>
+void read_binary_image(BinaryImageReader& reader, vtr::vector<K, V, A>& data);
+template <class K, class V, class C, class A>
+void read_binary_image(BinaryImageReader& reader,
+                       std::map<K, V, C, A>& data);
+template <class K, class V, class H, class E, class A>
+void read_binary_image(BinaryImageReader& reader,
+                       std::unordered_map<K, V, H, E, A>& data);
+template <class K, class H, class E, class A>
+void read_binary_image(BinaryImageReader& reader,
+                       std::unordered_set<K, H, E, A>& data);
+
+/* Read the size of a container, which cannot be larger than the rest of
+ * the image, so that a corrupted image does not exhaust the memory */
+size_t read_binary_image_size(BinaryImageReader& reader);
+
+/********************************************************************
+ * Writers
+ *******************************************************************/
+/* Plain data is copied as it is */
+template <class T>
+typename std::enable_if<std::is_trivially_copyable<T>::value>::type
+write_binary_image(BinaryImageWriter& writer, const T& data) {
+  writer.write_bytes(&data, sizeof(T));
+}
+
+template <class T1, class T2>
+void write_binary_image(BinaryImageWriter& writer,
+                        const std::pair<T1, T2>& data) {
+  write_binary_image(writer, data.first);
+  write_binary_image(writer, data.second);
+}
+
+template <class T, size_t N>
+typename std::enable_if<!std::is_trivially_copyable<T>::value>::type
+write_binary_image(BinaryImageWriter& writer, const std::array<T, N>& data) {
+  for (const T& elem : data) {
+    write_binary_image(writer, elem);
+  }
+}
+
+/* Arrays of plain data are copied in a single shot */
+template <class T, class A>
+void write_binary_image(BinaryImageWriter& writer,
+                        const std::vector<T, A>& data) {
+  write_binary_image(writer, static_cast<uint64_t>(data.size()));
+  if (std::is_trivially_copyable<T>::value) {
+    writer.write_bytes(data.data(), data.size() * sizeof(T));
+    return;
+  }
+  for (const T& elem : data) {
+    write_binary_image(writer, elem);
+  }
+}
+
+template <class A>
+void write_binary_image(BinaryImageWriter& writer,
+                        const std::vector<bool, A>& data) {
+  write_binary_image(writer, static_cast<uint64_t>(data.size()));
+  for (const bool elem : data) {
+    write_binary_image(writer, static_cast<bool>(elem));
+  }
+}
+
+template <class K, class V, class A>
+void write_binary_image(BinaryImageWriter& writer,
+                        const vtr::vector<K, V, A>& data) {
+  write_binary_image(writer, static_cast<uint64_t>(data.size()));
+  for (const auto& elem : data) {
+    write_binary_image(writer, static_cast<const V&>(elem));
+  }
+}
+
+template <class K, class V, class C, class A>
+void write_binary_image(BinaryImageWriter& writer,
+                        const std::map<K, V, C, A>& data) {
+  write_binary_image(writer, static_cast<uint64_t>(data.size()));
+  for (const auto& elem : data) {
+    write_binary_image(writer, elem.first);
+    write_binary_image(writer, elem.second);
+  }
+}
+
+template <class K, class V, class H, class E, class A>
+void write_binary_image(BinaryImageWriter& writer,
+                        const std::unordered_map<K, V, H, E, A>& data) {
+  write_binary_image(writer, static_cast<uint64_t>(data.size()));
+  for (const auto& elem : data) {
+    write_binary_image(writer, elem.first);
+    write_binary_image(writer, elem.second);
+  }
+}
+
+template <class K, class H, class E, class A>
+void write_binary_image(BinaryImageWriter& writer,
+                        const std::unordered_set<K, H, E, A>& data) {
+  write_binary_image(writer, static_cast<uint64_t>(data.size()));
+  for (const K& elem : data) {
+    write_binary_image(writer, elem);
+  }
+}
+
+/********************************************************************
+ * Readers
+ *******************************************************************/
+template <class T>
+typename std::enable_if<std::is_trivially_copyable<T>::value>::type
+read_binary_image(BinaryImageReader& reader, T& data) {
+  reader.read_bytes(&data, sizeof(T));
+}
+
+template <class T1, class T2>
+void read_binary_image(BinaryImageReader& reader, std::pair<T1, T2>& data) {
+  read_binary_image(reader, data.first);
+  read_binary_image(reader, data.second);
+}
+
+template <class T, size_t N>
+typename std::enable_if<!std::is_trivially_copyable<T>::value>::type
+read_binary_image(BinaryImageReader& reader, std::array<T, N>& data) {
+  for (T& elem : data) {
+    read_binary_image(reader, elem);
+  }
+}
+
+template <class T, class A>
+void read_binary_image(BinaryImageReader& reader, std::vector<T, A>& data) {
+  data.clear();
+  data.resize(read_binary_image_size(reader));
+  if (std::is_trivially_copyable<T>::value) {
+    reader.read_bytes(data.data(), data.size() * sizeof(T));
+    return;
+  }
+  for (T& elem : data) {
+    read_binary_image(reader, elem);
+  }
+}
+
+template <class A>
+void read_binary_image(BinaryImageReader& reader,
+                       std::vector<bool, A>& data) {
+  data.clear();
+  data.resize(read_binary_image_size(reader));
+  for (size_t ielem = 0; ielem < data.size(); ++ielem) {
+    bool elem = false;
+    read_binary_image(reader, elem);
+    data[ielem] = elem;
+  }
+}
+
+template <class K, class V, class A>
+void read_binary_image(BinaryImageReader& reader,
+                       vtr::vector<K, V, A>& data) {
+  data.clear();
+  data.resize(read_binary_image_size(reader));
+  for (size_t ielem = 0; ielem < data.size(); ++ielem) {
+    V elem;
+    read_binary_image(reader, elem);
+    data[K(ielem)] = std::move(elem);
+  }
+}
+
+template <class K, class V, class C, class A>
+void read_binary_image(BinaryImageReader& reader,
+                       std::map<K, V, C, A>& data) {
+  data.clear();
+  size_t num_elems = read_binary_image_size(reader);
+  for (size_t ielem = 0; ielem < num_elems; ++ielem) {
+    K key;
+    read_binary_image(reader, key);
+    read_binary_image(reader, data[key]);
+  }
+}
+
+template <class K, class V, class H, class E, class A>
+void read_binary_image(BinaryImageReader& reader,
+                       std::unordered_map<K, V, H, E, A>& data) {
+  data.clear();
+  size_t num_elems = read_binary_image_size(reader);
+  data.reserve(num_elems);
+  for (size_t ielem = 0; ielem < num_elems; ++ielem) {
+    K key;
+    read_binary_image(reader, key);
+    read_binary_image(reader, data[key]);
+  }
+}
+
+template <class K, class H, class E, class A>
+void read_binary_image(BinaryImageReader& reader,
+                       std::unordered_set<K, H, E, A>& data) {
+  data.clear();
+  size_t num_elems = read_binary_image_size(reader);
+  data.reserve(num_elems);
+  for (size_t ielem = 0; ielem < num_elems; ++ielem) {
+    K elem;
+    read_binary_image(reader, elem);
+    data.insert(elem);
+  }
+}
+
+}  // namespace openfpga
+
+#endif
@@ -0,0 +1,483 @@
+/********************************************************************
+ * This file includes member functions for BufferedFileStream
+ *******************************************************************/
+#include "openfpga_buffered_stream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#ifdef OPENFPGA_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+#include "openfpga_digest.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Enabled by ScopedOutputCompression */
+static std::atomic<bool> output_compression_enabled(false);
+
+/* Enabled by set_async_output() */
+static std::atomic<bool> async_output_enabled(false);
+
+/* Number of the background threads of AsyncStreamBuf */
+static std::atomic<size_t> num_async_output_buffers(0);
+
+/* The innermost ScopedOutputFileRecord, which links to the outer ones */
+static ScopedOutputFileRecord* output_file_record = nullptr;
+static std::mutex output_file_record_mutex;
+
+#ifdef OPENFPGA_WITH_ZLIB
+/********************************************************************
+ * A stream buffer which compresses its content with zlib in gzip
+ * format, and writes the compressed data to another stream buffer.
+ * The fastest level of compression is used, as the writers are expected
+ * to be limited by the speed of the disk rather than by the size.
+ * The gzip header has no time stamp, so that the same content is always
+ * compressed into the same file.
+ *******************************************************************/
+class GzipStreamBuf : public std::streambuf {
+ public: /* Constructors */
+  explicit GzipStreamBuf(std::streambuf* sink)
+    : sink_(sink), in_(1 << 16), out_(1 << 16) {
+    stream_.zalloc = Z_NULL;
+    stream_.zfree = Z_NULL;
+    stream_.opaque = Z_NULL;
+    /* 16 is added to the window bits to write a gzip header */
+    deflateInit2(&stream_, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8,
+                 Z_DEFAULT_STRATEGY);
+    setp(in_.data(), in_.data() + in_.size());
+  }
+  ~GzipStreamBuf() { deflateEnd(&stream_); }
+
+ public: /* Public mutators */
+  /* Compress the remaining content and end the gzip stream */
+  bool finish() { return deflate_input(Z_FINISH); }
+
+ protected: /* Overrides of std::streambuf */
+  int_type overflow(int_type c) override {
+    if (false == deflate_input(Z_NO_FLUSH)) {
+      return traits_type::eof();
+    }
+    if (false == traits_type::eq_int_type(c, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  /* Flushing in the middle of a stream, e.g., by std::endl, only
+   * compresses the pending content, which keeps the compression ratio */
+  int sync() override { return deflate_input(Z_NO_FLUSH) ? 0 : -1; }
+
+ private: /* Internal mutators */
+  /* Compress the content of the put area to the sink */
+  bool deflate_input(const int& flush) {
+    stream_.next_in = reinterpret_cast<Bytef*>(pbase());
+    stream_.avail_in = static_cast<uInt>(pptr() - pbase());
+    int status = Z_OK;
+    do {
+      stream_.next_out = reinterpret_cast<Bytef*>(out_.data());
+      stream_.avail_out = static_cast<uInt>(out_.size());
+      status = deflate(&stream_, flush);
+      if (Z_STREAM_ERROR == status) {
+        return false;
+      }
+      std::streamsize num_bytes = out_.size() - stream_.avail_out;
+      if (num_bytes != sink_->sputn(out_.data(), num_bytes)) {
+        return false;
+      }
+    } while ((0 == stream_.avail_out) ||
+             ((Z_FINISH == flush) && (Z_STREAM_END != status)));
+    setp(in_.data(), in_.data() + in_.size());
+    return true;
+  }
+
+ private: /* Internal data */
+  std::streambuf* sink_;
+  z_stream stream_;
+  std::vector<char> in_;
+  std::vector<char> out_;
+};
+#else
+/* Files are never compressed without zlib */
+class GzipStreamBuf : public std::streambuf {
+ public: /* Constructors */
+  explicit GzipStreamBuf(std::streambuf*) {}
+
+ public: /* Public mutators */
+  bool finish() { return false; }
+};
+#endif
+
+/********************************************************************
+ * A stream buffer which hands its content over to a background thread,
+ * which writes it to another stream buffer, e.g., the file buffer or
+ * the gzip buffer. The content is formatted into a ring of buffers:
+ * a full buffer is queued for the background thread, and formatting
+ * goes on in the next free buffer. The formatting thread only waits
+ * when all the buffers are queued, i.e., when the disk is slower than
+ * formatting.
+ *
+ * The buffers are allocated when they are needed, and the first one
+ * grows with the content up to the size of a buffer. The background
+ * thread is only started when the first buffer is full, so that small
+ * files, e.g., the netlists of most modules, are written synchronously
+ * when closing, without any thread or large buffer.
+ * Errors of the background thread are reported by finish()
+ *******************************************************************/
+class AsyncStreamBuf : public std::streambuf {
+ public: /* Constructors */
+  AsyncStreamBuf(std::streambuf* sink, const size_t& buffer_size,
+                 const size_t& num_buffers)
+    : sink_(sink),
+      buffer_size_(std::max(buffer_size, size_t(1))),
+      num_buffers_(std::max(num_buffers, size_t(1))),
+      current_(0),
+      writing_(false),
+      stopping_(false),
+      failed_(false) {
+    /* The ring is never reallocated, so the background thread can read a
+     * buffer while another one is added */
+    buffers_.reserve(num_buffers_);
+    buffers_.push_back(
+      std::vector<char>(std::min(INIT_BUFFER_SIZE, buffer_size_)));
+    set_put_area();
+  }
+  ~AsyncStreamBuf() { finish(); }
+
+ public: /* Public mutators */
+  /* Write the remaining content and stop the background thread, if any */
+  bool finish() {
+    if (false == thread_.joinable()) {
+      write_put_area();
+      return !failed_;
+    }
+    submit_buffer();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    cond_.notify_all();
+    thread_.join();
+    num_async_output_buffers--;
+    return !failed_;
+  }
+
+ protected: /* Overrides of std::streambuf */
+  int_type overflow(int_type c) override {
+    if ((false == thread_.joinable()) &&
+        (buffers_[current_].size() < buffer_size_)) {
+      /* Grow the first buffer, keeping its content */
+      size_t num_bytes = pptr() - pbase();
+      buffers_[current_].resize(
+        std::min(2 * buffers_[current_].size(), buffer_size_));
+      set_put_area();
+      pbump(int(num_bytes));
+    } else {
+      if (false == thread_.joinable()) {
+        thread_ = std::thread([this]() { write_buffers(); });
+        num_async_output_buffers++;
+      }
+      submit_buffer();
+    }
+    if (false == traits_type::eq_int_type(c, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  /* Flushing, e.g., by std::endl, waits until the content reaches the
+   * sink, as a synchronous stream does */
+  int sync() override {
+    if (false == thread_.joinable()) {
+      write_put_area();
+    } else {
+      submit_buffer();
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock,
+                 [this]() { return (true == queue_.empty()) && !writing_; });
+    }
+    /* The background thread is idle, so the sink can be flushed here */
+    if ((true == failed_) || (-1 == sink_->pubsync())) {
+      return -1;
+    }
+    return 0;
+  }
+
+ private: /* Internal mutators */
+  void set_put_area() {
+    setp(buffers_[current_].data(),
+         buffers_[current_].data() + buffers_[current_].size());
+  }
+
+  /* Write the content of the put area on the formatting thread, when the
+   * background thread is not started */
+  void write_put_area() {
+    std::streamsize num_bytes = pptr() - pbase();
+    if ((0 < num_bytes) && (num_bytes != sink_->sputn(pbase(), num_bytes))) {
+      failed_ = true;
+    }
+    set_put_area();
+  }
+
+  /* Queue the content of the put area, and take the next free buffer.
+   * A new buffer is allocated if all the buffers are queued and the ring
+   * is not complete */
+  void submit_buffer() {
+    size_t num_bytes = pptr() - pbase();
+    if (0 == num_bytes) {
+      return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    queue_.push_back(std::make_pair(current_, num_bytes));
+    cond_.notify_all();
+    if ((true == free_buffers_.empty()) && (buffers_.size() < num_buffers_)) {
+      /* Only the formatting thread resizes the ring, while the background
+       * thread only accesses the buffers in the queue */
+      lock.unlock();
+      current_ = buffers_.size();
+      std::vector<char> buffer(buffer_size_);
+      lock.lock();
+      buffers_.push_back(std::move(buffer));
+    } else {
+      cond_.wait(lock, [this]() { return false == free_buffers_.empty(); });
+      current_ = free_buffers_.front();
+      free_buffers_.pop_front();
+    }
+    lock.unlock();
+    set_put_area();
+  }
+
+  /* Body of the background thread: write the queued buffers in order */
+  void write_buffers() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cond_.wait(lock,
+                 [this]() { return stopping_ || (false == queue_.empty()); });
+      if (true == queue_.empty()) {
+        /* Stopping, and all the buffers are written */
+        break;
+      }
+      std::pair<size_t, size_t> buffer = queue_.front();
+      queue_.pop_front();
+      writing_ = true;
+      const char* data = buffers_[buffer.first].data();
+      lock.unlock();
+      std::streamsize num_bytes = buffer.second;
+      bool written = (num_bytes == sink_->sputn(data, num_bytes));
+      lock.lock();
+      writing_ = false;
+      if (false == written) {
+        failed_ = true;
+      }
+      free_buffers_.push_back(buffer.first);
+      cond_.notify_all();
+    }
+  }
+
+ private: /* Internal constants */
+  /* Size of the first buffer, which grows with the content */
+  static constexpr size_t INIT_BUFFER_SIZE = 1 << 12;
+
+ private: /* Internal data */
+  std::streambuf* sink_;
+  size_t buffer_size_;
+  /* Maximum number of buffers in the ring */
+  size_t num_buffers_;
+  std::vector<std::vector<char>> buffers_;
+  /* The buffer of the put area */
+  size_t current_;
+  /* Buffers waiting for the background thread, as <buffer, size> */
+  std::deque<std::pair<size_t, size_t>> queue_;
+  std::deque<size_t> free_buffers_;
+  /* If the background thread is writing a buffer */
+  bool writing_;
+  bool stopping_;
+  bool failed_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::thread thread_;
+};
+
+constexpr size_t AsyncStreamBuf::INIT_BUFFER_SIZE;
+
+constexpr size_t BufferedFileStream::DEFAULT_BUFFER_SIZE;
+constexpr size_t BufferedFileStream::NUM_ASYNC_BUFFERS;
+
+/* The buffer must be installed before the file is opened */
+BufferedFileStream::BufferedFileStream(const size_t& buffer_size)
+  : buffer_(buffer_size), file_changed_(true), compressible_(true) {
+  rdbuf()->pubsetbuf(buffer_.data(), buffer_.size());
+}
+
+BufferedFileStream::~BufferedFileStream() {
+  if (is_open()) {
+    close();
+  }
+}
+
+void BufferedFileStream::open(const std::string& fname,
+                              std::ios_base::openmode mode) {
+  open(fname, mode, false);
+}
+
+void BufferedFileStream::open(const std::string& fname,
+                              std::ios_base::openmode mode,
+                              const bool& incremental) {
+  file_changed_ = true;
+
+  /* Find if the file should be compressed, and its actual name */
+  std::string actual_fname = fname;
+  bool compress = false;
+  if ((true == compressible_) && (true == output_compression_supported())) {
+    std::string gzip_ext(".gz");
+    bool gzip_fname = (fname.size() >= gzip_ext.size()) &&
+                      (0 == fname.compare(fname.size() - gzip_ext.size(),
+                                          gzip_ext.size(), gzip_ext));
+    compress = gzip_fname || output_compression();
+    if ((true == compress) && (false == gzip_fname)) {
+      actual_fname += gzip_ext;
+    }
+  }
+
+  std::ios_base::openmode actual_mode = mode;
+  if (true == compress) {
+    actual_mode |= std::fstream::binary;
+  }
+
+  if (false == incremental) {
+    incremental_fname_.clear();
+    std::fstream::open(actual_fname, actual_mode);
+  } else {
+    incremental_fname_ = actual_fname;
+    std::fstream::open(actual_fname + std::string(".tmp"), actual_mode);
+  }
+
+  /* The compressed data are written to the file buffer */
+  if ((true == compress) && (true == is_open())) {
+    gzip_buffer_.reset(new GzipStreamBuf(std::fstream::rdbuf()));
+    std::ios::rdbuf(gzip_buffer_.get());
+  }
+
+  /* The background thread writes to the gzip buffer, if any, so that
+   * compression also overlaps with formatting */
+  if ((true == async_output()) && (true == is_open())) {
+    async_buffer_.reset(new AsyncStreamBuf(std::ios::rdbuf(), buffer_.size(),
+                                           NUM_ASYNC_BUFFERS));
+    std::ios::rdbuf(async_buffer_.get());
+  }
+
+  if ((true == is_open()) && (0 != (mode & std::ios_base::out))) {
+    std::lock_guard<std::mutex> lock(output_file_record_mutex);
+    if (nullptr != output_file_record) {
+      output_file_record->add_fname(actual_fname);
+    }
+  }
+}
+
+void BufferedFileStream::close() {
+  /* Buffers are released in the reverse order of open() */
+  if (nullptr != async_buffer_) {
+    bool finished = async_buffer_->finish();
+    if (nullptr != gzip_buffer_) {
+      std::ios::rdbuf(gzip_buffer_.get());
+    } else {
+      std::ios::rdbuf(std::fstream::rdbuf());
+    }
+    async_buffer_.reset();
+    if (false == finished) {
+      setstate(std::ios::badbit);
+    }
+  }
+  if (nullptr != gzip_buffer_) {
+    bool finished = gzip_buffer_->finish();
+    std::ios::rdbuf(std::fstream::rdbuf());
+    gzip_buffer_.reset();
+    if (false == finished) {
+      setstate(std::ios::badbit);
+    }
+  }
+  std::fstream::close();
+  if (true == incremental_fname_.empty()) {
+    return;
+  }
+  file_changed_ = replace_file_if_changed(
+    incremental_fname_ + std::string(".tmp"), incremental_fname_);
+  incremental_fname_.clear();
+}
+
+void BufferedFileStream::set_compressible(const bool& compressible) {
+  compressible_ = compressible;
+}
+
+bool BufferedFileStream::file_changed() const { return file_changed_; }
+
+/********************************************************************
+ * Member functions for ScopedOutputCompression
+ *******************************************************************/
+ScopedOutputCompression::ScopedOutputCompression(const bool& enabled)
+  : prev_enabled_(output_compression_enabled.exchange(enabled)) {}
+
+ScopedOutputCompression::~ScopedOutputCompression() {
+  output_compression_enabled = prev_enabled_;
+}
+
+/********************************************************************
+ * Member functions for ScopedOutputFileRecord
+ *******************************************************************/
+ScopedOutputFileRecord::ScopedOutputFileRecord() {
+  std::lock_guard<std::mutex> lock(output_file_record_mutex);
+  prev_record_ = output_file_record;
+  output_file_record = this;
+}
+
+ScopedOutputFileRecord::~ScopedOutputFileRecord() {
+  std::lock_guard<std::mutex> lock(output_file_record_mutex);
+  output_file_record = prev_record_;
+}
+
+std::vector<std::string> ScopedOutputFileRecord::fnames() const {
+  std::lock_guard<std::mutex> lock(output_file_record_mutex);
+  std::vector<std::string> unique_fnames;
+  std::unordered_set<std::string> found_fnames;
+  for (const std::string& fname : fnames_) {
+    if (true == found_fnames.insert(fname).second) {
+      unique_fnames.push_back(fname);
+    }
+  }
+  return unique_fnames;
+}
+
+/* Called with the records locked */
+void ScopedOutputFileRecord::add_fname(const std::string& fname) {
+  fnames_.push_back(fname);
+  if (nullptr != prev_record_) {
+    prev_record_->add_fname(fname);
+  }
+}
+
+bool output_compression_supported() {
+#ifdef OPENFPGA_WITH_ZLIB
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool output_compression() { return output_compression_enabled; }
+
+void set_async_output(const bool& enabled) { async_output_enabled = enabled; }
+
+bool async_output() { return async_output_enabled; }
+
+size_t num_async_output_files() { return num_async_output_buffers; }
+
+}  // namespace openfpga
@@ -0,0 +1,156 @@
+#ifndef OPENFPGA_BUFFERED_STREAM_H
+#define OPENFPGA_BUFFERED_STREAM_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Stream buffer compressing the content in gzip format */
+class GzipStreamBuf;
+
+/* Stream buffer writing the content to the file on a background thread */
+class AsyncStreamBuf;
+
+/********************************************************************
+ * A file stream with a large output buffer, which is written to the
+ * file only when it is full or when the file is closed.
+ * It can be used anywhere a std::fstream is expected, e.g., by
+ * check_file_stream(), so writers only need to change the declaration
+ * of their file stream. Note that std::endl still flushes the buffer,
+ * so writers should end lines with '\n' to benefit from it.
+ *
+ * In incremental mode, the content is written to a temporary file,
+ * which replaces the file only if their contents differ when the
+ * stream is closed. An unchanged file is then left untouched, so that
+ * tools which check file timestamps can reuse it.
+ *
+ * The content is compressed in gzip format when the name of the file
+ * ends with '.gz', or when output compression is enabled, in which case
+ * '.gz' is appended to the name of the file. See ScopedOutputCompression.
+ *
+ * When asynchronous output is enabled, the content is formatted into a
+ * ring of buffers, which are written to the file, and compressed if
+ * required, by a background thread. The thread and the buffers are only
+ * created when the content exceeds the size of a buffer. Formatting then
+ * overlaps with the latency of the disk, e.g., on network file systems.
+ * See set_async_output().
+ *******************************************************************/
+class BufferedFileStream : public std::fstream {
+ public: /* Public constants */
+  static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+  /* Number of buffers in the ring of asynchronous output */
+  static constexpr size_t NUM_ASYNC_BUFFERS = 4;
+
+ public: /* Constructors */
+  explicit BufferedFileStream(const size_t& buffer_size = DEFAULT_BUFFER_SIZE);
+  BufferedFileStream(const BufferedFileStream&) = delete;
+  BufferedFileStream& operator=(const BufferedFileStream&) = delete;
+  /* Close the file before the buffer is released */
+  ~BufferedFileStream();
+
+ public: /* Public mutators */
+  /* Open a file, compressed if required */
+  void open(const std::string& fname,
+            std::ios_base::openmode mode = std::ios_base::in |
+                                           std::ios_base::out);
+  /* Open a file, through a temporary file in incremental mode */
+  void open(const std::string& fname, std::ios_base::openmode mode,
+            const bool& incremental);
+  /* Close the file, and replace the original file if incremental */
+  void close();
+  /* Allow or forbid compressing the file, which is allowed by default.
+   * Temporary files which are read back by the writers, e.g., partial
+   * files, should not be compressed */
+  void set_compressible(const bool& compressible);
+
+ public: /* Public accessors */
+  /* Return false only if an incremental file is closed unchanged */
+  bool file_changed() const;
+
+ private: /* Internal data */
+  std::vector<char> buffer_;
+  /* The file to be replaced in incremental mode, empty otherwise */
+  std::string incremental_fname_;
+  bool file_changed_;
+  bool compressible_;
+  /* Compress the content before it reaches the file buffer, if required */
+  std::unique_ptr<GzipStreamBuf> gzip_buffer_;
+  /* Hand the content over to a background thread, if required */
+  std::unique_ptr<AsyncStreamBuf> async_buffer_;
+};
+
+/********************************************************************
+ * Enable the compression of the files written by BufferedFileStream
+ * until going out of scope, e.g., when a command writing large text
+ * files is called with option '--compress'. The previous setting is
+ * restored afterwards. Compression requires OpenFPGA to be built with
+ * zlib, see output_compression_supported()
+ *******************************************************************/
+class ScopedOutputCompression {
+ public: /* Constructors */
+  explicit ScopedOutputCompression(const bool& enabled);
+  ~ScopedOutputCompression();
+  ScopedOutputCompression(const ScopedOutputCompression&) = delete;
+  ScopedOutputCompression& operator=(const ScopedOutputCompression&) = delete;
+
+ private: /* Internal data */
+  bool prev_enabled_;
+};
+
+/********************************************************************
+ * Record the names of the files opened for output by BufferedFileStream
+ * until going out of scope, on any thread, e.g., to find the outputs of
+ * a command. Compressed files are recorded by their actual names, and
+ * incremental files by the names of the files they replace. The records
+ * may be nested, in which case each file is recorded by all of them
+ *******************************************************************/
+class ScopedOutputFileRecord {
+ public: /* Constructors */
+  ScopedOutputFileRecord();
+  ~ScopedOutputFileRecord();
+  ScopedOutputFileRecord(const ScopedOutputFileRecord&) = delete;
+  ScopedOutputFileRecord& operator=(const ScopedOutputFileRecord&) = delete;
+
+ public: /* Public accessors */
+  /* The files in the order they are first opened, without duplication */
+  std::vector<std::string> fnames() const;
+
+ private: /* Internal mutators */
+  /* Called by BufferedFileStream when opening a file */
+  friend class BufferedFileStream;
+  void add_fname(const std::string& fname);
+
+ private: /* Internal data */
+  ScopedOutputFileRecord* prev_record_;
+  std::vector<std::string> fnames_;
+};
+
+/* If OpenFPGA is built with zlib, so that files can be compressed */
+bool output_compression_supported();
+
+/* If the files written by BufferedFileStream are compressed */
+bool output_compression();
+
+/* Enable or disable writing the files opened by BufferedFileStream on
+ * background threads, e.g., by the option '--async_write' of the shell.
+ * Disabled by default */
+void set_async_output(const bool& enabled);
+
+/* If the files written by BufferedFileStream are written asynchronously */
+bool async_output();
+
+/* Number of the files which are being written on background threads.
+ * Small files are written when closing, without any background thread */
+size_t num_async_output_files();
+
+}  // namespace openfpga
+
+#endif
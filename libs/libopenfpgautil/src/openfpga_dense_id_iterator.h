@@ -0,0 +1,61 @@
+#ifndef OPENFPGA_DENSE_ID_ITERATOR_H
+#define OPENFPGA_DENSE_ID_ITERATOR_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+#include <iterator>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * A dense iterator over a contiguous ID space, which is used when no ID
+ * has been invalidated. In contrast to the lazy_id_iterator of the
+ * data structures, dereferencing it does NOT probe any set of invalid IDs,
+ * so that walking all the IDs is a tight linear scan.
+ *******************************************************************/
+template <class ID>
+class dense_id_iterator
+  : public std::iterator<std::bidirectional_iterator_tag, ID> {
+ public:
+  typedef
+    typename std::iterator<std::bidirectional_iterator_tag, ID>::value_type
+      value_type;
+  typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::iterator
+    iterator;
+
+  explicit dense_id_iterator(value_type init) : value_(init) {}
+
+  // Advance to the next ID value
+  iterator operator++() {
+    value_ = ID(size_t(value_) + 1);
+    return *this;
+  }
+
+  // Advance to the previous ID value
+  iterator operator--() {
+    value_ = ID(size_t(value_) - 1);
+    return *this;
+  }
+
+  // Dereference the iterator
+  value_type operator*() const { return value_; }
+
+  friend bool operator==(const dense_id_iterator<ID> lhs,
+                         const dense_id_iterator<ID> rhs) {
+    return lhs.value_ == rhs.value_;
+  }
+  friend bool operator!=(const dense_id_iterator<ID> lhs,
+                         const dense_id_iterator<ID> rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  value_type value_;
+};
+
+}  // namespace openfpga
+
+#endif
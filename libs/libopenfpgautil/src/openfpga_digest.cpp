@@ -5,6 +5,8 @@
 #include <sys/stat.h>
 
 #include <algorithm>
+#include <cstdio>
+#include <iterator>
 #include <vector>
 
 /* Headers from vtrutil library */
@@ -264,4 +266,67 @@ bool write_tab_to_file(std::fstream& fp, const size_t& num_tab) {
   return true;
 }
 
+/********************************************************************
+ * Replace a file by a newly written file only if their contents differ.
+ * Otherwise, the new file is removed and the original file is kept
+ * untouched, so that tools which check file timestamps can reuse it.
+ * Return true if the file is replaced
+ ********************************************************************/
+bool replace_file_if_changed(const std::string& new_fname,
+                             const std::string& fname) {
+  std::ifstream new_fp(new_fname, std::ios::binary);
+  std::ifstream fp(fname, std::ios::binary);
+  bool same = false;
+  if (new_fp.is_open() && fp.is_open()) {
+    same = std::equal(std::istreambuf_iterator<char>(new_fp),
+                      std::istreambuf_iterator<char>(),
+                      std::istreambuf_iterator<char>(fp),
+                      std::istreambuf_iterator<char>());
+  }
+  new_fp.close();
+  fp.close();
+
+  if (true == same) {
+    std::remove(new_fname.c_str());
+    return false;
+  }
+
+  if (0 != std::rename(new_fname.c_str(), fname.c_str())) {
+    VTR_LOG_ERROR("Fail to rename file '%s' to '%s'\n", new_fname.c_str(),
+                  fname.c_str());
+    exit(1);
+  }
+  return true;
+}
+
+/********************************************************************
+ * Compute a 64-bit FNV-1a digest of the content of a file.
+ * A file which can not be opened has the digest of an empty file
+ ********************************************************************/
+uint64_t compute_file_digest(const std::string& fname) {
+  uint64_t digest = 0xcbf29ce484222325ULL;
+  std::ifstream fp(fname, std::ios::binary);
+  if (!fp.is_open()) {
+    return digest;
+  }
+  std::vector<char> buffer(1 << 16);
+  while (fp.read(buffer.data(), buffer.size()) || (0 < fp.gcount())) {
+    for (std::streamsize ibyte = 0; ibyte < fp.gcount(); ++ibyte) {
+      digest ^= static_cast<unsigned char>(buffer[ibyte]);
+      digest *= 0x100000001b3ULL;
+    }
+  }
+  return digest;
+}
+
+/********************************************************************
+ * Format a file digest as a fixed-width hexadecimal string
+ ********************************************************************/
+std::string format_file_digest(const uint64_t& digest) {
+  char digest_str[17];
+  snprintf(digest_str, sizeof(digest_str), "%016llx",
+           static_cast<unsigned long long>(digest));
+  return std::string(digest_str);
+}
+
 }  // namespace openfpga
@@ -4,7 +4,9 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <cstdint>
 #include <fstream>
+#include <string>
 
 /********************************************************************
  * Function declaration
@@ -29,6 +31,13 @@ bool write_space_to_file(std::fstream& fp, const size_t& num_space);
 
 bool write_tab_to_file(std::fstream& fp, const size_t& num_tab);
 
+bool replace_file_if_changed(const std::string& new_fname,
+                             const std::string& fname);
+
+uint64_t compute_file_digest(const std::string& fname);
+
+std::string format_file_digest(const uint64_t& digest);
+
 }  // namespace openfpga
 
 #endif
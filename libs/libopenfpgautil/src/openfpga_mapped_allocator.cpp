@@ -0,0 +1,134 @@
+/********************************************************************
+ * This file includes the functions of out-of-core allocations, whose
+ * blocks are backed by temporary files
+ *******************************************************************/
+#include "openfpga_mapped_allocator.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Each block starts with a header, which records how the block is
+ * allocated. The size of the header keeps the alignment of the data */
+struct MappedBlockHeader {
+  size_t num_bytes; /* Size of the block, including the header */
+  bool mapped;      /* Backed by a file or allocated on the heap */
+};
+static constexpr size_t MAPPED_BLOCK_HEADER_SIZE = 64;
+static_assert(sizeof(MappedBlockHeader) <= MAPPED_BLOCK_HEADER_SIZE,
+              "Header of mapped blocks is too large");
+
+/* Set by ScopedMappedAllocation. An empty directory disables the
+ * out-of-core allocation */
+static std::mutex mapped_allocation_mutex;
+static std::string mapped_allocation_dir;
+static size_t mapped_allocation_min_block_size = 0;
+static std::atomic<size_t> mapped_allocation_usage(0);
+
+/********************************************************************
+ * Map a block of a new temporary file under a directory.
+ * Return nullptr when the file cannot be created or mapped
+ *******************************************************************/
+static void* map_temporary_file(const std::string& dir,
+                                const size_t& num_bytes) {
+  std::string fname_template = dir + "/openfpga_mapped_XXXXXX";
+  std::vector<char> fname(fname_template.begin(), fname_template.end());
+  fname.push_back('\0');
+  int fd = mkstemp(fname.data());
+  if (-1 == fd) {
+    return nullptr;
+  }
+  /* The file is kept alive by the mapping only */
+  unlink(fname.data());
+  if (0 != ftruncate(fd, num_bytes)) {
+    close(fd);
+    return nullptr;
+  }
+  void* data =
+    mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (MAP_FAILED == data) {
+    return nullptr;
+  }
+  return data;
+}
+
+void* allocate_mapped_memory(const size_t& num_bytes) {
+  size_t block_size = num_bytes + MAPPED_BLOCK_HEADER_SIZE;
+
+  std::string dir;
+  size_t min_block_size = 0;
+  {
+    std::lock_guard<std::mutex> lock(mapped_allocation_mutex);
+    dir = mapped_allocation_dir;
+    min_block_size = mapped_allocation_min_block_size;
+  }
+
+  void* block = nullptr;
+  bool mapped = false;
+  if ((false == dir.empty()) && (block_size >= min_block_size)) {
+    block = map_temporary_file(dir, block_size);
+    mapped = (nullptr != block);
+  }
+  /* Fall back to the heap when the block cannot be backed by a file */
+  if (nullptr == block) {
+    block = std::malloc(block_size);
+    if (nullptr == block) {
+      throw std::bad_alloc();
+    }
+  }
+  if (true == mapped) {
+    mapped_allocation_usage += block_size;
+  }
+
+  MappedBlockHeader* header = static_cast<MappedBlockHeader*>(block);
+  header->num_bytes = block_size;
+  header->mapped = mapped;
+  return static_cast<char*>(block) + MAPPED_BLOCK_HEADER_SIZE;
+}
+
+void deallocate_mapped_memory(void* data) {
+  if (nullptr == data) {
+    return;
+  }
+  void* block = static_cast<char*>(data) - MAPPED_BLOCK_HEADER_SIZE;
+  MappedBlockHeader* header = static_cast<MappedBlockHeader*>(block);
+  if (true == header->mapped) {
+    size_t block_size = header->num_bytes;
+    mapped_allocation_usage -= block_size;
+    munmap(block, block_size);
+  } else {
+    std::free(block);
+  }
+}
+
+size_t mapped_memory_usage() { return mapped_allocation_usage; }
+
+/********************************************************************
+ * Member functions for ScopedMappedAllocation
+ *******************************************************************/
+ScopedMappedAllocation::ScopedMappedAllocation(const std::string& dir,
+                                               const size_t& min_block_size) {
+  std::lock_guard<std::mutex> lock(mapped_allocation_mutex);
+  prev_dir_ = mapped_allocation_dir;
+  prev_min_block_size_ = mapped_allocation_min_block_size;
+  mapped_allocation_dir = dir;
+  mapped_allocation_min_block_size = min_block_size;
+}
+
+ScopedMappedAllocation::~ScopedMappedAllocation() {
+  std::lock_guard<std::mutex> lock(mapped_allocation_mutex);
+  mapped_allocation_dir = prev_dir_;
+  mapped_allocation_min_block_size = prev_min_block_size_;
+}
+
+}  // namespace openfpga
@@ -0,0 +1,95 @@
+#ifndef OPENFPGA_MAPPED_ALLOCATOR_H
+#define OPENFPGA_MAPPED_ALLOCATOR_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <cstddef>
+#include <string>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Allocate a block of memory, which is backed by a file when out-of-core
+ * allocation is enabled and the block is large enough. Otherwise, the block
+ * is allocated on the heap. Throw std::bad_alloc when failed */
+void* allocate_mapped_memory(const size_t& num_bytes);
+/* Release a block of memory from allocate_mapped_memory() */
+void deallocate_mapped_memory(void* data);
+
+/********************************************************************
+ * Enable out-of-core allocation until going out of scope: the blocks of
+ * at least a given size, which are allocated by MappedAllocator, are
+ * backed by temporary files under a directory. The files are removed
+ * from the directory as soon as they are created, so that their disk
+ * space is released when the blocks are released, even if the process
+ * is killed.
+ * The operating system writes the pages of such blocks to their files
+ * and drops them from the memory when the memory is short, and reads
+ * them back when they are accessed again. As a result, large arrays
+ * which do not fit in the memory can still be built and visited, at the
+ * cost of disk I/O. Arrays should be visited in their sequence to limit
+ * the I/O.
+ * Blocks which are allocated when the scope is gone remain valid.
+ *******************************************************************/
+class ScopedMappedAllocation {
+ public: /* Public constants */
+  static constexpr size_t DEFAULT_MIN_BLOCK_SIZE = 1 << 24;
+
+ public: /* Constructors */
+  explicit ScopedMappedAllocation(
+    const std::string& dir,
+    const size_t& min_block_size = DEFAULT_MIN_BLOCK_SIZE);
+  ~ScopedMappedAllocation();
+  ScopedMappedAllocation(const ScopedMappedAllocation&) = delete;
+  ScopedMappedAllocation& operator=(const ScopedMappedAllocation&) = delete;
+
+ private: /* Internal data */
+  std::string prev_dir_;
+  size_t prev_min_block_size_;
+};
+
+/* Total size of the blocks which are currently backed by files */
+size_t mapped_memory_usage();
+
+/********************************************************************
+ * A standard allocator for containers, e.g., std::vector, whose large
+ * blocks may be backed by files. See ScopedMappedAllocation.
+ * The allocator is stateless, so that containers with this allocator
+ * behave the same as containers with the default allocator, except
+ * when they are assigned to containers with another allocator.
+ * Growing a file-backed block copies it to a new file. Containers which
+ * use the allocator should be reserved to their final sizes, or grow
+ * geometrically, e.g., by std::vector::push_back(), so that the copies
+ * are amortized.
+ *******************************************************************/
+template <class T>
+class MappedAllocator {
+ public: /* Types */
+  typedef T value_type;
+
+ public: /* Constructors */
+  MappedAllocator() = default;
+  template <class U>
+  MappedAllocator(const MappedAllocator<U>&) {}
+
+ public: /* Allocations */
+  T* allocate(const size_t num_elements) {
+    return static_cast<T*>(allocate_mapped_memory(num_elements * sizeof(T)));
+  }
+  void deallocate(T* data, const size_t) { deallocate_mapped_memory(data); }
+};
+
+template <class T, class U>
+bool operator==(const MappedAllocator<T>&, const MappedAllocator<U>&) {
+  return true;
+}
+
+template <class T, class U>
+bool operator!=(const MappedAllocator<T>&, const MappedAllocator<U>&) {
+  return false;
+}
+
+}  // namespace openfpga
+
+#endif
@@ -0,0 +1,79 @@
+/********************************************************************
+ * This file includes the member functions of class MappedFile
+ *******************************************************************/
+#include "openfpga_mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * Constructors
+ *******************************************************************/
+MappedFile::MappedFile() : data_(nullptr), size_(0), is_open_(false) {}
+
+MappedFile::MappedFile(const char* fname) : MappedFile() { open(fname); }
+
+MappedFile::~MappedFile() { close(); }
+
+/********************************************************************
+ * Public accessors
+ *******************************************************************/
+bool MappedFile::is_open() const { return is_open_; }
+
+const char* MappedFile::data() const { return data_; }
+
+size_t MappedFile::size() const { return size_; }
+
+const char* MappedFile::begin() const { return data_; }
+
+const char* MappedFile::end() const { return data_ + size_; }
+
+/********************************************************************
+ * Public mutators
+ *******************************************************************/
+bool MappedFile::open(const char* fname) {
+  close();
+
+  int fd = ::open(fname, O_RDONLY);
+  if (-1 == fd) {
+    return false;
+  }
+  struct stat file_stat;
+  if (-1 == fstat(fd, &file_stat)) {
+    ::close(fd);
+    return false;
+  }
+  size_t size = file_stat.st_size;
+  /* A file of 0 byte cannot be mapped, but is still a valid file */
+  if (0 < size) {
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED == data) {
+      ::close(fd);
+      return false;
+    }
+    /* Most readers walk through the file from its beginning */
+    madvise(data, size, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(data);
+    size_ = size;
+  }
+  /* The mapping remains valid after the file is closed */
+  ::close(fd);
+  is_open_ = true;
+  return true;
+}
+
+void MappedFile::close() {
+  if (nullptr != data_) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  is_open_ = false;
+}
+
+}  // namespace openfpga
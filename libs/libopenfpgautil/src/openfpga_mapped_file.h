@@ -0,0 +1,52 @@
+#ifndef OPENFPGA_MAPPED_FILE_H
+#define OPENFPGA_MAPPED_FILE_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <cstddef>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * A read-only memory mapping of a whole file, which is unmapped when
+ * going out of scope.
+ * Readers can walk through the content of the file with pointers,
+ * rather than copying it line by line through a stream, and stop as
+ * soon as they have found what they need: the pages which are never
+ * touched are never read from the disk.
+ *
+ * Opening a file does not error out, so that each reader can report
+ * the failure in its own way. An empty file is opened with a size of 0.
+ *******************************************************************/
+class MappedFile {
+ public: /* Constructors */
+  MappedFile();
+  explicit MappedFile(const char* fname);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+ public: /* Public accessors */
+  bool is_open() const;
+  const char* data() const;
+  size_t size() const;
+  /* Range of the content, to be used as iterators */
+  const char* begin() const;
+  const char* end() const;
+
+ public: /* Public mutators */
+  /* Map a file to memory, return false if it cannot be mapped */
+  bool open(const char* fname);
+  void close();
+
+ private: /* Internal data */
+  const char* data_;
+  size_t size_;
+  bool is_open_;
+};
+
+}  // namespace openfpga
+
+#endif
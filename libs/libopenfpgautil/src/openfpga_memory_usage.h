@@ -0,0 +1,132 @@
+#ifndef OPENFPGA_MEMORY_USAGE_H
+#define OPENFPGA_MEMORY_USAGE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "vtr_vector.h"
+
+/********************************************************************
+ * Estimate the heap memory owned by an object, i.e., the memory
+ * which is NOT included in sizeof() of the object.
+ * Nested containers are counted recursively.
+ * Hash tables and trees are estimated from the typical node layout
+ * of the standard library implementations, which is good enough to
+ * size machines and track regressions, but is not exact.
+ *******************************************************************/
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Declare all the overloads first, so that they can find each other
+ * when nested */
+template <class T>
+size_t heap_memory_usage(const T& data);
+inline size_t heap_memory_usage(const std::string& data);
+template <class T1, class T2>
+size_t heap_memory_usage(const std::pair<T1, T2>& data);
+template <class T, class A>
+size_t heap_memory_usage(const std::vector<T, A>& data);
+template <class A>
+size_t heap_memory_usage(const std::vector<bool, A>& data);
+template <class K, class V, class A>
+size_t heap_memory_usage(const vtr::vector<K, V, A>& data);
+template <class K, class H, class E, class A>
+size_t heap_memory_usage(const std::unordered_set<K, H, E, A>& data);
+template <class K, class V, class H, class E, class A>
+size_t heap_memory_usage(const std::unordered_map<K, V, H, E, A>& data);
+template <class K, class V, class C, class A>
+size_t heap_memory_usage(const std::map<K, V, C, A>& data);
+
+/* Plain data owns no heap memory */
+template <class T>
+size_t heap_memory_usage(const T& /* data */) {
+  return 0;
+}
+
+/* Short strings are stored inside the object itself */
+inline size_t heap_memory_usage(const std::string& data) {
+  if (data.capacity() < sizeof(std::string)) {
+    return 0;
+  }
+  return data.capacity() + 1;
+}
+
+template <class T1, class T2>
+size_t heap_memory_usage(const std::pair<T1, T2>& data) {
+  return heap_memory_usage(data.first) + heap_memory_usage(data.second);
+}
+
+template <class T, class A>
+size_t heap_memory_usage(const std::vector<T, A>& data) {
+  size_t num_bytes = data.capacity() * sizeof(T);
+  for (const T& elem : data) {
+    num_bytes += heap_memory_usage(elem);
+  }
+  return num_bytes;
+}
+
+template <class A>
+size_t heap_memory_usage(const std::vector<bool, A>& data) {
+  return data.capacity() / 8;
+}
+
+template <class K, class V, class A>
+size_t heap_memory_usage(const vtr::vector<K, V, A>& data) {
+  size_t num_bytes = data.capacity() * sizeof(V);
+  for (const V& elem : data) {
+    num_bytes += heap_memory_usage(elem);
+  }
+  return num_bytes;
+}
+
+/* Each element is a node with a pointer to the next one,
+ * plus a bucket array of pointers */
+template <class K, class H, class E, class A>
+size_t heap_memory_usage(const std::unordered_set<K, H, E, A>& data) {
+  size_t num_bytes = data.bucket_count() * sizeof(void*) +
+                     data.size() * (sizeof(K) + 2 * sizeof(void*));
+  for (const K& elem : data) {
+    num_bytes += heap_memory_usage(elem);
+  }
+  return num_bytes;
+}
+
+template <class K, class V, class H, class E, class A>
+size_t heap_memory_usage(const std::unordered_map<K, V, H, E, A>& data) {
+  size_t num_bytes =
+    data.bucket_count() * sizeof(void*) +
+    data.size() * (sizeof(std::pair<const K, V>) + 2 * sizeof(void*));
+  for (const auto& elem : data) {
+    num_bytes += heap_memory_usage(elem.first) + heap_memory_usage(elem.second);
+  }
+  return num_bytes;
+}
+
+/* Each element is a tree node with three pointers and a color */
+template <class K, class V, class C, class A>
+size_t heap_memory_usage(const std::map<K, V, C, A>& data) {
+  size_t num_bytes =
+    data.size() * (sizeof(std::pair<const K, V>) + 4 * sizeof(void*));
+  for (const auto& elem : data) {
+    num_bytes += heap_memory_usage(elem.first) + heap_memory_usage(elem.second);
+  }
+  return num_bytes;
+}
+
+/* Total memory of an object, including the object itself */
+template <class T>
+size_t object_memory_usage(const T& data) {
+  return sizeof(T) + heap_memory_usage(data);
+}
+
+}  // namespace openfpga
+
+#endif
@@ -0,0 +1,195 @@
+/********************************************************************
+ * This file includes functions to run independent tasks on multiple
+ * threads in OpenFPGA framework
+ * The tasks are executed by TBB when it is available (OPENFPGA_USE_TBB),
+ * or by threads of the standard library otherwise
+ *******************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#ifdef OPENFPGA_USE_TBB
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/partitioner.h"
+#include "tbb/task_arena.h"
+#endif
+
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
+namespace openfpga {
+
+/********************************************************************
+ * Find the number of threads to be used from a user-defined value
+ * - A positive number is used as it is
+ * - Zero or a negative number means using all the hardware threads
+ *   that are available in the system
+ *******************************************************************/
+size_t find_num_threads(const int& num_threads) {
+  if (0 < num_threads) {
+    return num_threads;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/********************************************************************
+ * The number of threads used by commands when they do not specify it.
+ * It is initialized from the environment variable OPENFPGA_NUM_THREADS,
+ * following the same rule as find_num_threads(), or a single thread
+ * when the variable is not defined
+ *******************************************************************/
+static size_t& default_num_threads_storage() {
+  static size_t num_threads = []() {
+    const char* env_num_threads = std::getenv("OPENFPGA_NUM_THREADS");
+    if (nullptr == env_num_threads) {
+      return size_t(1);
+    }
+    return find_num_threads(std::atoi(env_num_threads));
+  }();
+  return num_threads;
+}
+
+size_t default_num_threads() { return default_num_threads_storage(); }
+
+/* Set by disable_parallel_threads() */
+static std::atomic<bool> parallel_threads_disabled(false);
+/* Number of the parallel loops which are running tasks on threads */
+static std::atomic<size_t> num_parallel_loops(0);
+
+void disable_parallel_threads() { parallel_threads_disabled = true; }
+
+size_t num_running_parallel_loops() { return num_parallel_loops; }
+
+/* Count a parallel loop until going out of scope */
+class ScopedParallelLoop {
+ public:
+  ScopedParallelLoop() { num_parallel_loops++; }
+  ~ScopedParallelLoop() { num_parallel_loops--; }
+};
+
+/********************************************************************
+ * Overwrite the number of threads used by commands when they do not
+ * specify it, e.g., by the option '--num_threads' of the shell
+ *******************************************************************/
+void set_default_num_threads(const int& num_threads) {
+  default_num_threads_storage() = find_num_threads(num_threads);
+}
+
+/********************************************************************
+ * Run a number of independent tasks, indexed by [0, num_tasks), on
+ * a given number of threads.
+ * Each thread takes care of a contiguous range of task indices.
+ * When only one thread is required, tasks are executed in order on the
+ * calling thread, which is the same as a plain for-loop.
+ * The function returns only when all the tasks are finished
+ *******************************************************************/
+void parallel_for(const size_t& num_tasks, const size_t& num_threads,
+                  const std::function<void(const size_t&)>& task) {
+  size_t num_workers = std::min(num_threads, num_tasks);
+  if ((1 >= num_workers) || (true == parallel_threads_disabled)) {
+    for (size_t itask = 0; itask < num_tasks; ++itask) {
+      task(itask);
+    }
+    return;
+  }
+  ScopedParallelLoop parallel_loop;
+
+  size_t chunk_size = (num_tasks + num_workers - 1) / num_workers;
+#ifdef OPENFPGA_USE_TBB
+  tbb::task_arena arena(num_workers);
+  arena.execute([&]() {
+    tbb::parallel_for(
+      tbb::blocked_range<size_t>(0, num_tasks, chunk_size),
+      [&task](const tbb::blocked_range<size_t>& range) {
+        for (size_t itask = range.begin(); itask < range.end(); ++itask) {
+          task(itask);
+        }
+      },
+      tbb::static_partitioner());
+  });
+#else
+  std::vector<std::thread> workers;
+  workers.reserve(num_workers);
+  for (size_t iworker = 0; iworker < num_workers; ++iworker) {
+    size_t begin = iworker * chunk_size;
+    size_t end = std::min(begin + chunk_size, num_tasks);
+    workers.emplace_back([&task, begin, end]() {
+      for (size_t itask = begin; itask < end; ++itask) {
+        task(itask);
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+#endif
+}
+
+/********************************************************************
+ * Run a number of independent tasks, indexed by [0, num_tasks), on
+ * a given number of threads with dynamic load balancing.
+ * Unlike parallel_for(), threads do not own a fixed range of tasks.
+ * Each idle thread claims the next unprocessed task from a shared counter,
+ * so that threads which finish early steal the remaining work from the
+ * others. This suits tasks whose runtime varies a lot.
+ * Tasks must be independent from each other, so that the results do not
+ * depend on which thread executes which task
+ *******************************************************************/
+void parallel_for_dynamic(const size_t& num_tasks, const size_t& num_threads,
+                          const std::function<void(const size_t&)>& task) {
+  size_t num_workers = std::min(num_threads, num_tasks);
+  if ((1 >= num_workers) || (true == parallel_threads_disabled)) {
+    for (size_t itask = 0; itask < num_tasks; ++itask) {
+      task(itask);
+    }
+    return;
+  }
+  ScopedParallelLoop parallel_loop;
+
+#ifdef OPENFPGA_USE_TBB
+  tbb::task_arena arena(num_workers);
+  arena.execute([&]() {
+    tbb::parallel_for(size_t(0), num_tasks,
+                      [&task](const size_t& itask) { task(itask); });
+  });
+#else
+  std::atomic<size_t> next_task(0);
+  std::vector<std::thread> workers;
+  workers.reserve(num_workers);
+  for (size_t iworker = 0; iworker < num_workers; ++iworker) {
+    workers.emplace_back([&task, &next_task, num_tasks]() {
+      for (size_t itask = next_task.fetch_add(1); itask < num_tasks;
+           itask = next_task.fetch_add(1)) {
+        task(itask);
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+#endif
+}
+
+/********************************************************************
+ * Task group
+ *******************************************************************/
+ParallelTaskGroup::ParallelTaskGroup(const size_t& num_threads)
+  : num_threads_(num_threads) {}
+
+/* Collect a task, which is executed by wait() */
+void ParallelTaskGroup::run(const std::function<void()>& task) {
+  tasks_.push_back(task);
+}
+
+/* Execute all the collected tasks with dynamic load balancing, since
+ * tasks of different kinds usually have different runtime */
+void ParallelTaskGroup::wait() {
+  parallel_for_dynamic(tasks_.size(), num_threads_,
+                       [&](const size_t& itask) { tasks_[itask](); });
+  tasks_.clear();
+}
+
+}  // namespace openfpga
@@ -0,0 +1,82 @@
+#ifndef OPENFPGA_PARALLEL_H
+#define OPENFPGA_PARALLEL_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+/* namespace openfpga begins */
+namespace openfpga {
+
+size_t find_num_threads(const int& num_threads);
+
+size_t default_num_threads();
+
+void set_default_num_threads(const int& num_threads);
+/* Run all the tasks on the calling thread from now on, e.g., in a process
+ * forked from a multi-threaded process, where the threads of the parent,
+ * including the workers of TBB, do not exist */
+void disable_parallel_threads();
+/* Number of parallel_for() and parallel_for_dynamic() which are running
+ * tasks on threads */
+size_t num_running_parallel_loops();
+
+void parallel_for(const size_t& num_tasks, const size_t& num_threads,
+                  const std::function<void(const size_t&)>& task);
+
+void parallel_for_dynamic(const size_t& num_tasks, const size_t& num_threads,
+                          const std::function<void(const size_t&)>& task);
+
+/********************************************************************
+ * A group of independent tasks of different kinds, which are collected
+ * by run() and executed on a given number of threads by wait().
+ * The function returns only when all the tasks are finished
+ *******************************************************************/
+class ParallelTaskGroup {
+ public: /* Constructor */
+  ParallelTaskGroup(const size_t& num_threads);
+
+ public: /* Public mutators */
+  void run(const std::function<void()>& task);
+  void wait();
+
+ private: /* Internal data */
+  size_t num_threads_;
+  std::vector<std::function<void()>> tasks_;
+};
+
+/********************************************************************
+ * Map a number of independent tasks, indexed by [0, num_tasks), on a
+ * given number of threads, and reduce their results in the sequence of
+ * task indices. The reduction does not depend on the number of threads,
+ * so that the result is deterministic even when the reduction is not
+ * associative, e.g., concatenating strings or summing floats
+ *******************************************************************/
+template <typename T>
+T parallel_ordered_reduce(const size_t& num_tasks, const size_t& num_threads,
+                          const T& identity,
+                          const std::function<T(const size_t&)>& map,
+                          const std::function<T(const T&, const T&)>& reduce) {
+  /* A deque avoids the bit packing of std::vector<bool>, so that each
+   * task writes its own result */
+  std::deque<T> results(num_tasks, identity);
+  parallel_for(num_tasks, num_threads,
+               [&](const size_t& itask) { results[itask] = map(itask); });
+
+  T result = identity;
+  for (const T& task_result : results) {
+    result = reduce(result, task_result);
+  }
+  return result;
+}
+
+}  // namespace openfpga
+
+#endif
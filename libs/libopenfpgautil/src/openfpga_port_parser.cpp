@@ -4,6 +4,7 @@
 #include "openfpga_port_parser.h"
 
 #include <cstring>
+#include <utility>
 
 #include "openfpga_tokenizer.h"
 #include "vtr_assert.h"
@@ -45,47 +46,56 @@ void PortParser::set_data(const std::string& data) {
 /************************************************************************
  * Internal Mutators
  ***********************************************************************/
-/* Parse the data */
+/* Parse the data
+ * The tokens are stored in the internal buffers, so that a parser which
+ * is reused for many ports does not allocate memory for each of them
+ */
 void PortParser::parse() {
-  /* Create a tokenizer */
-  StringToken tokenizer(data_);
+  /* Start from an invalid port, in case the parser is reused */
+  port_ = BasicPort();
 
   /* Split the data into <port_name> and <pin_string> */
-  std::vector<std::string> port_tokens = tokenizer.split(bracket_.x());
+  split_string(data_, bracket_.x(), port_tokens_);
+  /* Nothing to parse, leave an invalid port */
+  if (port_tokens_.empty()) {
+    return;
+  }
   /* Make sure we have a port name! */
-  VTR_ASSERT_SAFE((1 == port_tokens.size()) || (2 == port_tokens.size()));
+  VTR_ASSERT_SAFE((1 == port_tokens_.size()) || (2 == port_tokens_.size()));
   /* Store the port name! */
-  port_.set_name(port_tokens[0]);
+  port_.set_name(port_tokens_[0]);
 
   /* If we only have one token */
-  if (1 == port_tokens.size()) {
+  if (1 == port_tokens_.size()) {
     port_.set_width(1);
     return; /* We can finish here */
   }
 
   /* Chomp the ']' */
-  tokenizer.set_data(port_tokens[1]);
-  std::vector<std::string> pin_tokens = tokenizer.split(bracket_.y());
-  /* Make sure we have a valid string! */
-  VTR_ASSERT_SAFE(1 == port_tokens.size());
+  split_string(port_tokens_[1], bracket_.y(), pin_tokens_);
+  /* Nothing inside the brackets */
+  if (pin_tokens_.empty()) {
+    return;
+  }
 
   /* Split the pin string now */
-  tokenizer.set_data(pin_tokens[0]);
-  pin_tokens = tokenizer.split(delim_);
+  split_string(pin_tokens_[0], delim_, port_tokens_);
 
   /* Check if we have LSB and MSB or just one */
-  if (1 == pin_tokens.size()) {
+  if (1 == port_tokens_.size()) {
     /* Single pin */
-    port_.set_width(std::stoi(pin_tokens[0]), std::stoi(pin_tokens[0]));
-  } else if (2 == pin_tokens.size()) {
+    int pin = std::stoi(port_tokens_[0]);
+    port_.set_width(pin, pin);
+  } else if (2 == port_tokens_.size()) {
     /* A number of pins.
      * Note that we always use the LSB for token[0] and MSB for token[1]
      */
-    if (std::stoi(pin_tokens[1]) < std::stoi(pin_tokens[0])) {
-      port_.set_width(std::stoi(pin_tokens[1]), std::stoi(pin_tokens[0]));
-    } else {
-      port_.set_width(std::stoi(pin_tokens[0]), std::stoi(pin_tokens[1]));
+    int lsb = std::stoi(port_tokens_[0]);
+    int msb = std::stoi(port_tokens_[1]);
+    if (msb < lsb) {
+      std::swap(lsb, msb);
     }
+    port_.set_width(lsb, msb);
   }
 
   return;
@@ -109,11 +119,18 @@ void PortParser::set_default_delim() {
 /************************************************************************
  * Constructors
  ***********************************************************************/
-MultiPortParser::MultiPortParser(const std::string& data) {
+MultiPortParser::MultiPortParser(const std::string& data)
+  : port_parser_(std::string()) {
   set_default_delim();
   set_data(data);
 }
 
+MultiPortParser::MultiPortParser(const std::string& data, const char& delim)
+  : port_parser_(std::string()) {
+  delim_ = delim;
+  set_data(data);
+}
+
 /************************************************************************
  * Public Accessors
  ***********************************************************************/
@@ -139,17 +156,15 @@ void MultiPortParser::parse() {
   /* Clear content */
   clear();
 
-  /* Create a tokenizer */
-  StringToken tokenizer(data_);
-
-  /* Split the data into <port_name> and <pin_string> */
-  std::vector<std::string> port_tokens = tokenizer.split(delim_);
+  /* Split the data into ports */
+  split_string(data_, delim_, port_tokens_);
 
-  /* Use PortParser for each token */
-  for (const auto& port : port_tokens) {
-    PortParser port_parser(port);
+  /* Use the same PortParser for each token */
+  ports_.reserve(port_tokens_.size());
+  for (const auto& port : port_tokens_) {
+    port_parser_.set_data(port);
     /* Get the port name, LSB and MSB */
-    ports_.push_back(port_parser.port());
+    ports_.push_back(port_parser_.port());
   }
 
   return;
@@ -52,6 +52,9 @@ class PortParser {
   vtr::Point<char> bracket_;
   char delim_;
   BasicPort port_;
+  /* Buffers of tokens, which are reused between ports */
+  std::vector<std::string> port_tokens_;
+  std::vector<std::string> pin_tokens_;
 };
 
 /************************************************************************
@@ -60,6 +63,8 @@ class PortParser {
 class MultiPortParser {
  public: /* Constructors*/
   MultiPortParser(const std::string& data);
+  /* Ports are separated by the given delimiter rather than spaces */
+  MultiPortParser(const std::string& data, const char& delim);
 
  public: /* Public Accessors */
   std::string data() const;
@@ -77,6 +82,9 @@ class MultiPortParser {
   std::string data_; /* Lines to be splited */
   char delim_;
   std::vector<BasicPort> ports_;
+  /* Buffer of tokens and parser of each port, which are reused */
+  std::vector<std::string> port_tokens_;
+  PortParser port_parser_;
 };
 
 /************************************************************************
@@ -0,0 +1,123 @@
+/********************************************************************
+ * This file includes functions to report the progress of long loops
+ *******************************************************************/
+#include "openfpga_progress.h"
+
+#include <mutex>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Interval in nanoseconds */
+static std::atomic<int64_t> PROGRESS_INTERVAL(0);
+
+/********************************************************************
+ * The loops which have finished, and are not yet taken
+ *******************************************************************/
+struct t_progress_state {
+  std::mutex mutex;
+  std::vector<ProgressRecord> records;
+};
+
+static t_progress_state& progress_state() {
+  static t_progress_state state;
+  return state;
+}
+
+void set_progress_interval(const double& seconds) {
+  int64_t interval = 0;
+  if (0. < seconds) {
+    interval = static_cast<int64_t>(seconds * 1e9);
+  }
+  PROGRESS_INTERVAL.store(interval, std::memory_order_relaxed);
+}
+
+double progress_interval() {
+  return 1e-9 * (double)PROGRESS_INTERVAL.load(std::memory_order_relaxed);
+}
+
+std::vector<ProgressRecord> take_progress_records() {
+  t_progress_state& state = progress_state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  std::vector<ProgressRecord> records;
+  records.swap(state.records);
+  return records;
+}
+
+/********************************************************************
+ * Member functions of class ScopedProgress
+ *******************************************************************/
+ScopedProgress::ScopedProgress(const std::string& name,
+                               const std::string& unit, const size_t& total)
+  : name_(name),
+    unit_(unit),
+    total_(total),
+    interval_(PROGRESS_INTERVAL.load(std::memory_order_relaxed)),
+    start_(std::chrono::steady_clock::now()),
+    num_done_(0),
+    next_report_(interval_),
+    reported_(false) {}
+
+ScopedProgress::~ScopedProgress() {
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start_;
+
+  /* Close a loop which has been reported, so that the last line shows it
+   * has finished */
+  if (true == reported_.load()) {
+    report(num_done_.load(), elapsed.count());
+  }
+
+  ProgressRecord record;
+  record.name = name_;
+  record.unit = unit_;
+  record.num_units = num_done_.load();
+  record.total = total_;
+  record.wall_time = elapsed.count();
+
+  t_progress_state& state = progress_state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.records.push_back(record);
+}
+
+void ScopedProgress::advance(const size_t& num_units) {
+  size_t num_done = num_done_.fetch_add(num_units) + num_units;
+  if (0 == interval_) {
+    return;
+  }
+
+  int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - start_)
+                  .count();
+  int64_t next_report = next_report_.load(std::memory_order_relaxed);
+  if (now < next_report) {
+    return;
+  }
+  /* Only the thread which moves the next report forward prints */
+  if (false == next_report_.compare_exchange_strong(next_report,
+                                                    now + interval_)) {
+    return;
+  }
+  reported_.store(true);
+  report(num_done, 1e-9 * (double)now);
+}
+
+void ScopedProgress::report(const size_t& num_done,
+                            const double& elapsed) const {
+  double throughput = 0. < elapsed ? (double)num_done / elapsed : 0.;
+  if ((0 == total_) || (num_done >= total_) || (0. == throughput)) {
+    VTR_LOG("%s: %lu/%lu %s in %.1f s (%.1f %s/s)\n", name_.c_str(), num_done,
+            total_, unit_.c_str(), elapsed, throughput, unit_.c_str());
+    return;
+  }
+  double eta = (double)(total_ - num_done) / throughput;
+  VTR_LOG("%s: %lu/%lu %s (%.1f%%) in %.1f s (%.1f %s/s), ETA %.1f s\n",
+          name_.c_str(), num_done, total_, unit_.c_str(),
+          100. * (double)num_done / (double)total_, elapsed, throughput,
+          unit_.c_str(), eta);
+}
+
+}  // namespace openfpga
@@ -0,0 +1,90 @@
+#ifndef OPENFPGA_PROGRESS_H
+#define OPENFPGA_PROGRESS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/********************************************************************
+ * A lightweight facility to report the progress of long loops, e.g.,
+ * the switch blocks built by a builder or the clusters repacked, so
+ * that long commands keep printing while they run.
+ *
+ * Reporting is disabled by default. When enabled, a loop prints the
+ * number of units completed, the throughput and the estimated time to
+ * finish, at most once per interval. Units can be completed by
+ * multiple threads. A loop is also recorded when it finishes, whether
+ * reporting is enabled or not, so that its throughput can be exported,
+ * e.g., to the profiles of commands.
+ *
+ * An example of how to use
+ * -----------------------
+ *   ScopedProgress progress("Build switch blocks", "GSBs", gsbs.size());
+ *   for (const RRGSB& gsb : gsbs) {
+ *     ...
+ *     progress.advance();
+ *   }
+ *******************************************************************/
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Set the interval (in seconds) to report progress. 0 disables reporting */
+void set_progress_interval(const double& seconds);
+
+double progress_interval();
+
+/********************************************************************
+ * A loop which has finished, with the units completed and the wall
+ * time (in seconds) spent
+ *******************************************************************/
+struct ProgressRecord {
+  std::string name;
+  std::string unit;
+  size_t num_units = 0;
+  size_t total = 0;
+  double wall_time = 0.;
+};
+
+/* Take the loops which have finished since the last call */
+std::vector<ProgressRecord> take_progress_records();
+
+/********************************************************************
+ * The progress of a loop, which is reported by the thread completing
+ * units when an interval has passed, and is recorded when destroyed
+ *******************************************************************/
+class ScopedProgress {
+ public: /* Constructors */
+  ScopedProgress(const std::string& name, const std::string& unit,
+                 const size_t& total);
+  ~ScopedProgress();
+  ScopedProgress(const ScopedProgress&) = delete;
+  ScopedProgress& operator=(const ScopedProgress&) = delete;
+
+ public: /* Public mutators */
+  /* Complete a number of units. Thread-safe */
+  void advance(const size_t& num_units = 1);
+
+ private: /* Internal mutators */
+  void report(const size_t& num_done, const double& elapsed) const;
+
+ private: /* Internal data */
+  std::string name_;
+  std::string unit_;
+  size_t total_;
+  /* Interval in nanoseconds, which is 0 when reporting is disabled */
+  int64_t interval_;
+  std::chrono::steady_clock::time_point start_;
+  std::atomic<size_t> num_done_;
+  /* Nanoseconds since the start when the next report is due */
+  std::atomic<int64_t> next_report_;
+  std::atomic<bool> reported_;
+};
+
+}  // namespace openfpga
+
+#endif
@@ -1,8 +1,6 @@
 /************************************************************************
  * Member functions for StringToken class
  ***********************************************************************/
-#include <cstring>
-
 /* Headers from vtrutil library */
 #include "openfpga_tokenizer.h"
 #include "vtr_assert.h"
@@ -25,24 +23,7 @@ std::string StringToken::data() const { return data_; }
 std::vector<std::string> StringToken::split(const std::string& delims) const {
   /* Return vector */
   std::vector<std::string> ret;
-
-  /* Get a writable char array */
-  char* tmp = new char[data_.size() + 1];
-  std::copy(data_.begin(), data_.end(), tmp);
-  tmp[data_.size()] = '\0';
-  /* Split using strtok */
-  char* result = std::strtok(tmp, delims.c_str());
-  while (NULL != result) {
-    std::string result_str(result);
-    /* Store the token */
-    ret.push_back(result_str);
-    /* Got to next */
-    result = std::strtok(NULL, delims.c_str());
-  }
-
-  /* Free the tmp */
-  delete[] tmp;
-
+  split_string(data_, delims, ret);
   return ret;
 }
 
@@ -164,4 +145,41 @@ void StringToken::add_default_delim() {
   return;
 }
 
+/************************************************************************
+ * Split a string into the tokens between any of the given delimiters,
+ * where empty tokens are skipped. The tokens are written to a list given
+ * by the caller, whose strings are overwritten in place. When the same
+ * list is reused for many strings, e.g., by parsers, the memory of the
+ * tokens is allocated only once.
+ * Unlike strtok(), the string is not copied and no state is shared
+ * between calls, so that it can be called by multiple threads.
+ ***********************************************************************/
+void split_string(const std::string& data, const std::string& delims,
+                  std::vector<std::string>& tokens) {
+  size_t num_tokens = 0;
+  size_t token_start = data.find_first_not_of(delims);
+  while (std::string::npos != token_start) {
+    size_t token_end = data.find_first_of(delims, token_start);
+    size_t token_size = (std::string::npos == token_end)
+                          ? data.size() - token_start
+                          : token_end - token_start;
+    if (num_tokens < tokens.size()) {
+      tokens[num_tokens].assign(data, token_start, token_size);
+    } else {
+      tokens.emplace_back(data, token_start, token_size);
+    }
+    num_tokens++;
+    if (std::string::npos == token_end) {
+      break;
+    }
+    token_start = data.find_first_not_of(delims, token_end);
+  }
+  tokens.resize(num_tokens);
+}
+
+void split_string(const std::string& data, const char& delim,
+                  std::vector<std::string>& tokens) {
+  split_string(data, std::string(1, delim), tokens);
+}
+
 }  // namespace openfpga
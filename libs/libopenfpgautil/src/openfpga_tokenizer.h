@@ -65,6 +65,14 @@ class StringToken {
   std::vector<char> delims_;
 };
 
+/* Split a string with any of the given delimiters into a list of tokens
+ * given by the caller, reusing the memory of the list. Empty tokens are
+ * skipped, in the same way as StringToken::split() */
+void split_string(const std::string& data, const std::string& delims,
+                  std::vector<std::string>& tokens);
+void split_string(const std::string& data, const char& delim,
+                  std::vector<std::string>& tokens);
+
 }  // namespace openfpga
 
 #endif
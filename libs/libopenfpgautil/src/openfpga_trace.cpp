@@ -0,0 +1,180 @@
+/********************************************************************
+ * This file includes functions to trace the time spent in scopes and
+ * to output the traces in the Chrome trace event format
+ *******************************************************************/
+#include "openfpga_trace.h"
+
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
+#include "openfpga_digest.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * A scope which has been traced, where the start time and the duration
+ * are in microseconds since tracing starts
+ *******************************************************************/
+struct t_trace_event {
+  std::string name;
+  double start;
+  double duration;
+  size_t thread_id;
+};
+
+/********************************************************************
+ * The traces of the process. Scopes may be traced by multiple threads,
+ * so that events are recorded under a lock. Threads are numbered in
+ * the sequence that they record their first event
+ *******************************************************************/
+struct t_trace_state {
+  std::mutex mutex;
+  std::string fname;
+  std::chrono::steady_clock::time_point start;
+  std::vector<t_trace_event> events;
+  std::map<std::thread::id, size_t> thread_ids;
+};
+
+static std::atomic<bool> TRACE_ENABLED(false);
+
+static t_trace_state& trace_state() {
+  static t_trace_state state;
+  return state;
+}
+
+void start_trace(const std::string& fname) {
+  t_trace_state& state = trace_state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.fname = fname;
+  state.start = std::chrono::steady_clock::now();
+  state.events.clear();
+  state.thread_ids.clear();
+  TRACE_ENABLED.store(true, std::memory_order_release);
+}
+
+bool trace_enabled() { return TRACE_ENABLED.load(std::memory_order_relaxed); }
+
+/********************************************************************
+ * Record a scope which has been traced
+ *******************************************************************/
+static void add_trace_event(const std::string& name,
+                            const std::chrono::steady_clock::time_point& begin,
+                            const std::chrono::steady_clock::time_point& end) {
+  t_trace_state& state = trace_state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  /* Tracing may have been finished or restarted when the scope ends */
+  if (false == trace_enabled() || begin < state.start) {
+    return;
+  }
+  auto thread_result = state.thread_ids.insert(
+    std::make_pair(std::this_thread::get_id(), state.thread_ids.size()));
+  t_trace_event event;
+  event.name = name;
+  event.start =
+    std::chrono::duration<double, std::micro>(begin - state.start).count();
+  event.duration =
+    std::chrono::duration<double, std::micro>(end - begin).count();
+  event.thread_id = thread_result.first->second;
+  state.events.push_back(event);
+}
+
+/********************************************************************
+ * Quote a string for a JSON file, escaping the special characters
+ *******************************************************************/
+static std::string trace_json_string(const std::string& str) {
+  std::string quoted("\"");
+  for (const char& c : str) {
+    if ('"' == c || '\\' == c) {
+      quoted.push_back('\\');
+      quoted.push_back(c);
+    } else if (0x20 > static_cast<unsigned char>(c)) {
+      /* Control characters, e.g., new lines in timer messages */
+      char escaped[8];
+      snprintf(escaped, sizeof(escaped), "\\u%04x",
+               static_cast<unsigned char>(c));
+      quoted += escaped;
+    } else {
+      quoted.push_back(c);
+    }
+  }
+  quoted.push_back('"');
+  return quoted;
+}
+
+/********************************************************************
+ * Write the traces to a file in the Chrome trace event format, where
+ * each scope is a complete event ("ph": "X")
+ *******************************************************************/
+int finish_trace() {
+  if (false == trace_enabled()) {
+    return 0;
+  }
+
+  t_trace_state& state = trace_state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  TRACE_ENABLED.store(false, std::memory_order_release);
+
+  std::string dir_path = format_dir_path(find_path_dir_name(state.fname));
+  create_directory(dir_path);
+
+  BufferedFileStream fp;
+  fp.open(state.fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(state.fname.c_str(), fp);
+
+  fp << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  for (size_t ievent = 0; ievent < state.events.size(); ++ievent) {
+    const t_trace_event& event = state.events[ievent];
+    fp << (0 == ievent ? "\n" : ",\n");
+    fp << "{\"name\": " << trace_json_string(event.name)
+       << ", \"cat\": \"openfpga\", \"ph\": \"X\", \"ts\": " << event.start
+       << ", \"dur\": " << event.duration
+       << ", \"pid\": 0, \"tid\": " << event.thread_id << "}";
+  }
+  fp << "\n]}\n";
+
+  fp.close();
+
+  VTR_LOG("Wrote %lu traces to file '%s'\n", state.events.size(),
+          state.fname.c_str());
+
+  state.events.clear();
+  state.thread_ids.clear();
+
+  return 0;
+}
+
+/********************************************************************
+ * Member functions of class ScopedTrace
+ *******************************************************************/
+ScopedTrace::ScopedTrace(const char* name) : enabled_(trace_enabled()) {
+  if (enabled_) {
+    name_ = name;
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+ScopedTrace::ScopedTrace(const std::string& name)
+  : enabled_(trace_enabled()) {
+  if (enabled_) {
+    name_ = name;
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+ScopedTrace::~ScopedTrace() {
+  if (enabled_) {
+    add_trace_event(name_, start_, std::chrono::steady_clock::now());
+  }
+}
+
+}  // namespace openfpga
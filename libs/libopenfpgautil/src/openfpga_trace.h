@@ -0,0 +1,75 @@
+#ifndef OPENFPGA_TRACE_H
+#define OPENFPGA_TRACE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <chrono>
+#include <string>
+
+/********************************************************************
+ * A lightweight facility to trace the time spent in scopes, e.g., the
+ * functions of builders and writers. Scopes which are nested in the
+ * same thread appear as a hierarchy in the trace.
+ *
+ * Tracing is disabled by default. When disabled, a scope only costs
+ * a check of a flag. When enabled, the traces are written to a JSON file
+ * in the Chrome trace event format, which can be opened directly by
+ * chrome://tracing or https://ui.perfetto.dev
+ *
+ * An example of how to use
+ * -----------------------
+ *   void build_something() {
+ *     OPENFPGA_TRACE_FUNCTION();
+ *     ...
+ *     {
+ *       OPENFPGA_TRACE_SCOPE("build a part of something");
+ *       ...
+ *     }
+ *   }
+ *******************************************************************/
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Start tracing, and the traces will be written to the file given when
+ * tracing is finished. Traces recorded before are discarded */
+void start_trace(const std::string& fname);
+
+/* Whether tracing is enabled */
+bool trace_enabled();
+
+/* Stop tracing and write the traces to the file given when tracing
+ * starts. Return 0 if successful or if tracing is not enabled */
+int finish_trace();
+
+/********************************************************************
+ * A scope to trace, which is recorded when it is destroyed
+ *******************************************************************/
+class ScopedTrace {
+ public: /* Constructors */
+  explicit ScopedTrace(const char* name);
+  explicit ScopedTrace(const std::string& name);
+  ~ScopedTrace();
+  ScopedTrace(const ScopedTrace&) = delete;
+  ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+ private: /* Internal data */
+  bool enabled_;
+  /* Name is copied only when tracing is enabled */
+  std::string name_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace openfpga
+
+/* Create a unique name for the trace object in a scope */
+#define OPENFPGA_TRACE_CONCAT_IMPL(a, b) a##b
+#define OPENFPGA_TRACE_CONCAT(a, b) OPENFPGA_TRACE_CONCAT_IMPL(a, b)
+
+#define OPENFPGA_TRACE_SCOPE(name)               \
+  openfpga::ScopedTrace OPENFPGA_TRACE_CONCAT( \
+    openfpga_scoped_trace_, __LINE__)(name)
+
+#define OPENFPGA_TRACE_FUNCTION() OPENFPGA_TRACE_SCOPE(__func__)
+
+#endif
@@ -0,0 +1,390 @@
+/********************************************************************
+ * This file includes the member functions of the streaming XML reader
+ *******************************************************************/
+#include "openfpga_xml_stream_reader.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * Helpers
+ *******************************************************************/
+static bool is_xml_space(const int& c) {
+  return (' ' == c) || ('\t' == c) || ('\n' == c) || ('\r' == c);
+}
+
+static bool is_xml_name_char(const int& c) {
+  return (-1 != c) && (false == is_xml_space(c)) && ('=' != c) &&
+         ('/' != c) && ('>' != c) && ('<' != c) && ('"' != c) &&
+         ('\'' != c);
+}
+
+/* Append a character given by its code to a string in UTF-8 */
+static void append_utf8(std::string& str, const unsigned long& code) {
+  if (code < 0x80) {
+    str.push_back(static_cast<char>(code));
+  } else if (code < 0x800) {
+    str.push_back(static_cast<char>(0xc0 | (code >> 6)));
+    str.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+  } else if (code < 0x10000) {
+    str.push_back(static_cast<char>(0xe0 | (code >> 12)));
+    str.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+    str.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+  } else {
+    str.push_back(static_cast<char>(0xf0 | (code >> 18)));
+    str.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3f)));
+    str.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+    str.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+  }
+}
+
+/********************************************************************
+ * Constructors
+ *******************************************************************/
+constexpr size_t XmlStreamReader::DEFAULT_BUFFER_SIZE;
+
+XmlStreamReader::XmlStreamReader(const std::string& fname,
+                                 const size_t& buffer_size)
+  : fname_(fname),
+    buffer_(buffer_size),
+    buffer_pos_(0),
+    buffer_end_(0),
+    curr_line_(1),
+    event_(END_DOCUMENT),
+    line_(0),
+    num_attributes_(0),
+    element_depth_(0),
+    num_open_elements_(0),
+    pending_end_(false),
+    found_root_(false) {
+  fp_.open(fname, std::ifstream::in | std::ifstream::binary);
+  if (!fp_.is_open()) {
+    archfpga_throw(fname.c_str(), 0, "Fail to open file '%s'!\n",
+                   fname.c_str());
+  }
+}
+
+/********************************************************************
+ * Public accessors
+ *******************************************************************/
+const std::string& XmlStreamReader::fname() const { return fname_; }
+
+XmlStreamReader::e_event XmlStreamReader::event() const { return event_; }
+
+const std::string& XmlStreamReader::name() const { return name_; }
+
+size_t XmlStreamReader::depth() const { return element_depth_; }
+
+size_t XmlStreamReader::line() const { return line_; }
+
+bool XmlStreamReader::is_start_element(const char* name) const {
+  return (START_ELEMENT == event_) && (0 == name_.compare(name));
+}
+
+const char* XmlStreamReader::attribute(const char* name) const {
+  if (START_ELEMENT != event_) {
+    return nullptr;
+  }
+  for (size_t iattr = 0; iattr < num_attributes_; ++iattr) {
+    if (0 == attributes_[iattr].first.compare(name)) {
+      return attributes_[iattr].second.c_str();
+    }
+  }
+  return nullptr;
+}
+
+const char* XmlStreamReader::required_attribute(const char* name) const {
+  const char* value = attribute(name);
+  if (nullptr == value) {
+    throw_error(std::string("Expected attribute '") + name +
+                std::string("' on <") + name_ + std::string(">"));
+  }
+  return value;
+}
+
+int XmlStreamReader::int_attribute(const char* name,
+                                   const int& default_value) const {
+  const char* value = attribute(name);
+  if (nullptr == value) {
+    return default_value;
+  }
+  char* end = nullptr;
+  errno = 0;
+  long int_value = std::strtol(value, &end, 10);
+  if ((end == value) || ('\0' != *end) || (0 != errno)) {
+    throw_error(std::string("Invalid integer '") + value +
+                std::string("' of attribute '") + name + std::string("' on <") +
+                name_ + std::string(">"));
+  }
+  return static_cast<int>(int_value);
+}
+
+int XmlStreamReader::required_int_attribute(const char* name) const {
+  required_attribute(name);
+  return int_attribute(name, 0);
+}
+
+/********************************************************************
+ * Public mutators
+ *******************************************************************/
+XmlStreamReader::e_event XmlStreamReader::next() {
+  if (true == pending_end_) {
+    pending_end_ = false;
+    event_ = END_ELEMENT;
+    return event_;
+  }
+
+  while (true) {
+    /* Skip the text in between elements */
+    int c = get_char();
+    while ((-1 != c) && ('<' != c)) {
+      c = get_char();
+    }
+    if (-1 == c) {
+      if (0 < num_open_elements_) {
+        line_ = curr_line_;
+        throw_error(std::string("Unexpected end of file while <") +
+                    open_elements_[num_open_elements_ - 1] +
+                    std::string("> is not closed"));
+      }
+      if (false == found_root_) {
+        line_ = curr_line_;
+        throw_error("No element is found");
+      }
+      event_ = END_DOCUMENT;
+      element_depth_ = 0;
+      return event_;
+    }
+
+    line_ = curr_line_;
+    c = peek_char();
+    if ('?' == c) {
+      skip_until("?>");
+      continue;
+    }
+    if ('!' == c) {
+      get_char();
+      if ('-' == peek_char()) {
+        skip_until("-->");
+      } else if ('[' == peek_char()) {
+        skip_until("]]>");
+      } else {
+        skip_until(">");
+      }
+      continue;
+    }
+    if ('/' == c) {
+      get_char();
+      read_end_element();
+      return event_;
+    }
+    read_start_element();
+    return event_;
+  }
+}
+
+void XmlStreamReader::skip_element() {
+  if (START_ELEMENT != event_) {
+    return;
+  }
+  size_t depth = element_depth_;
+  while ((END_ELEMENT != next()) || (depth != element_depth_)) {
+  }
+}
+
+void XmlStreamReader::throw_error(const std::string& msg) const {
+  archfpga_throw(fname_.c_str(), line_, "%s!\n", msg.c_str());
+}
+
+/********************************************************************
+ * Internal readers
+ *******************************************************************/
+int XmlStreamReader::get_char() {
+  int c = peek_char();
+  if (-1 != c) {
+    buffer_pos_++;
+    if ('\n' == c) {
+      curr_line_++;
+    }
+  }
+  return c;
+}
+
+int XmlStreamReader::peek_char() {
+  if (buffer_pos_ == buffer_end_) {
+    fp_.read(buffer_.data(), buffer_.size());
+    buffer_pos_ = 0;
+    buffer_end_ = fp_.gcount();
+    if (0 == buffer_end_) {
+      return -1;
+    }
+  }
+  return static_cast<unsigned char>(buffer_[buffer_pos_]);
+}
+
+int XmlStreamReader::get_required_char() {
+  int c = get_char();
+  if (-1 == c) {
+    line_ = curr_line_;
+    throw_error("Unexpected end of file");
+  }
+  return c;
+}
+
+void XmlStreamReader::skip_spaces() {
+  while (is_xml_space(peek_char())) {
+    get_char();
+  }
+}
+
+/* Skip the characters until the end token, which is also skipped */
+void XmlStreamReader::skip_until(const char* end_token) {
+  size_t token_size = std::strlen(end_token);
+  /* The last characters read, as many as the token */
+  std::string window;
+  while (window != end_token) {
+    window.push_back(static_cast<char>(get_required_char()));
+    if (token_size < window.size()) {
+      window.erase(0, 1);
+    }
+  }
+}
+
+void XmlStreamReader::read_name(std::string& name) {
+  name.clear();
+  while (is_xml_name_char(peek_char())) {
+    name.push_back(static_cast<char>(get_char()));
+  }
+  if (true == name.empty()) {
+    line_ = curr_line_;
+    throw_error("Expected a name");
+  }
+}
+
+/* Read a quoted value and decode the entity references in it */
+void XmlStreamReader::read_attribute_value(std::string& value) {
+  value.clear();
+  int quote = get_required_char();
+  if (('"' != quote) && ('\'' != quote)) {
+    throw_error("Expected a quoted attribute value");
+  }
+  int c = get_required_char();
+  while (quote != c) {
+    if ('<' == c) {
+      throw_error("Unexpected '<' in an attribute value");
+    }
+    if ('&' != c) {
+      value.push_back(static_cast<char>(c));
+      c = get_required_char();
+      continue;
+    }
+    std::string entity;
+    c = get_required_char();
+    while ((';' != c) && (entity.size() < 16)) {
+      entity.push_back(static_cast<char>(c));
+      c = get_required_char();
+    }
+    if ("lt" == entity) {
+      value.push_back('<');
+    } else if ("gt" == entity) {
+      value.push_back('>');
+    } else if ("amp" == entity) {
+      value.push_back('&');
+    } else if ("quot" == entity) {
+      value.push_back('"');
+    } else if ("apos" == entity) {
+      value.push_back('\'');
+    } else if ((1 < entity.size()) && ('#' == entity[0])) {
+      bool hex = ('x' == entity[1]);
+      const char* digits = entity.c_str() + (hex ? 2 : 1);
+      char* end = nullptr;
+      unsigned long code = std::strtoul(digits, &end, hex ? 16 : 10);
+      if ((end == digits) || ('\0' != *end) || (0x10ffff < code)) {
+        throw_error(std::string("Invalid character reference '&") + entity +
+                    std::string(";'"));
+      }
+      append_utf8(value, code);
+    } else {
+      throw_error(std::string("Unknown entity '&") + entity +
+                  std::string(";'"));
+    }
+    c = get_required_char();
+  }
+}
+
+void XmlStreamReader::read_start_element() {
+  if ((0 == num_open_elements_) && (true == found_root_)) {
+    throw_error("Only one root element is allowed");
+  }
+  found_root_ = true;
+
+  read_name(name_);
+  num_attributes_ = 0;
+  while (true) {
+    skip_spaces();
+    int c = peek_char();
+    if ('/' == c) {
+      get_char();
+      if ('>' != get_required_char()) {
+        throw_error(std::string("Expected '/>' to close <") + name_ +
+                    std::string(">"));
+      }
+      pending_end_ = true;
+      break;
+    }
+    if ('>' == c) {
+      get_char();
+      break;
+    }
+    if (num_attributes_ == attributes_.size()) {
+      attributes_.emplace_back();
+    }
+    std::pair<std::string, std::string>& attr = attributes_[num_attributes_];
+    read_name(attr.first);
+    skip_spaces();
+    if ('=' != get_required_char()) {
+      throw_error(std::string("Expected '=' after attribute '") + attr.first +
+                  std::string("'"));
+    }
+    skip_spaces();
+    read_attribute_value(attr.second);
+    num_attributes_++;
+  }
+
+  element_depth_ = num_open_elements_ + 1;
+  if (false == pending_end_) {
+    if (num_open_elements_ == open_elements_.size()) {
+      open_elements_.emplace_back();
+    }
+    open_elements_[num_open_elements_] = name_;
+    num_open_elements_++;
+  }
+  event_ = START_ELEMENT;
+}
+
+void XmlStreamReader::read_end_element() {
+  read_name(name_);
+  skip_spaces();
+  if ('>' != get_required_char()) {
+    throw_error(std::string("Expected '>' to close </") + name_ +
+                std::string(">"));
+  }
+  if ((0 == num_open_elements_) ||
+      (name_ != open_elements_[num_open_elements_ - 1])) {
+    throw_error(std::string("Unexpected closing tag </") + name_ +
+                std::string(">"));
+  }
+  element_depth_ = num_open_elements_;
+  num_open_elements_--;
+  num_attributes_ = 0;
+  event_ = END_ELEMENT;
+}
+
+}  // namespace openfpga
@@ -0,0 +1,119 @@
+#ifndef OPENFPGA_XML_STREAM_READER_H
+#define OPENFPGA_XML_STREAM_READER_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * A streaming reader of XML files, which reports the start and the end
+ * of elements one by one in the order of the file, without building
+ * the tree of the document. The file is read through a buffer of fixed
+ * size, so that the memory does not grow with the size of the file.
+ * It is meant for large files generated by OpenFPGA, e.g., fabric keys
+ * and architecture bitstreams, whose data are all in attributes.
+ *
+ * Typical usage:
+ * --------------
+ *   XmlStreamReader reader(fname);
+ *   while (XmlStreamReader::END_DOCUMENT != reader.next()) {
+ *     if (reader.is_start_element("bit")) {
+ *       const char* value = reader.attribute("value");
+ *     }
+ *   }
+ *
+ * Limitations:
+ * - Text and CDATA sections are skipped, as well as comments,
+ *   processing instructions and document type declarations
+ * - Only the predefined entities and character references are decoded
+ * Errors, e.g., unbalanced tags, are thrown with the line number
+ *******************************************************************/
+class XmlStreamReader {
+ public: /* Types */
+  enum e_event { START_ELEMENT, END_ELEMENT, END_DOCUMENT };
+
+ public: /* Public constants */
+  static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 16;
+
+ public: /* Constructors */
+  explicit XmlStreamReader(const std::string& fname,
+                           const size_t& buffer_size = DEFAULT_BUFFER_SIZE);
+  XmlStreamReader(const XmlStreamReader&) = delete;
+  XmlStreamReader& operator=(const XmlStreamReader&) = delete;
+
+ public: /* Public accessors */
+  const std::string& fname() const;
+  /* The event found by the last call of next() */
+  e_event event() const;
+  /* Name of the current element, also valid at its end */
+  const std::string& name() const;
+  /* Depth of the current element, which is 1 for the root element */
+  size_t depth() const;
+  /* Line of the current element in the file */
+  size_t line() const;
+  bool is_start_element(const char* name) const;
+  /* Value of an attribute of the current element at its start, or
+   * nullptr if the element does not have the attribute */
+  const char* attribute(const char* name) const;
+  /* Value of a required attribute, error out if it is not defined */
+  const char* required_attribute(const char* name) const;
+  /* Integer value of an attribute, or the default value if the element
+   * does not have the attribute. Error out if it is not an integer */
+  int int_attribute(const char* name, const int& default_value) const;
+  int required_int_attribute(const char* name) const;
+
+ public: /* Public mutators */
+  /* Move to the start or the end of the next element */
+  e_event next();
+  /* Move to the end of the current element, skipping its children */
+  void skip_element();
+  /* Error out with the line of the current element */
+  [[noreturn]] void throw_error(const std::string& msg) const;
+
+ private: /* Internal readers */
+  /* Next character of the file, or -1 at the end of the file */
+  int get_char();
+  int peek_char();
+  int get_required_char();
+  void skip_spaces();
+  void skip_until(const char* end_token);
+  void read_name(std::string& name);
+  void read_attribute_value(std::string& value);
+  void read_start_element();
+  void read_end_element();
+
+ private: /* Internal data */
+  std::string fname_;
+  std::ifstream fp_;
+  std::vector<char> buffer_;
+  size_t buffer_pos_;
+  size_t buffer_end_;
+  size_t curr_line_;
+
+  e_event event_;
+  std::string name_;
+  size_t line_;
+  /* Attributes of the current element. The strings are kept between
+   * elements so that their memory is reused */
+  std::vector<std::pair<std::string, std::string>> attributes_;
+  size_t num_attributes_;
+  size_t element_depth_;
+  /* Names of the open elements. The strings are kept as well */
+  std::vector<std::string> open_elements_;
+  size_t num_open_elements_;
+  /* An empty element <a/> is reported as a start and then an end */
+  bool pending_end_;
+  bool found_root_;
+};
+
+}  // namespace openfpga
+
+#endif
@@ -10,6 +10,7 @@
 
 /* Headers from openfpgautil library */
 #include "io_location_map.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 
 /* begin namespace openfpga */
@@ -40,39 +41,51 @@ size_t IoLocationMap::io_index(const size_t& x, const size_t& y,
   return size_t(-1);
 }
 
-size_t IoLocationMap::io_x(const BasicPort& io_port) const {
-  for (auto pair : io_indices_) {
-    for (const BasicPort& candidate : pair.second) {
-      if (candidate == io_port) {
-        return pair.first[0];
-      }
-    }
+const std::vector<BasicPort>& IoLocationMap::io_ports(const size_t& x,
+                                                      const size_t& y,
+                                                      const size_t& z) const {
+  static const std::vector<BasicPort> empty_ports;
+  std::array<size_t, 3> coord = {x, y, z};
+  auto result = io_indices_.find(coord);
+  if (result == io_indices_.end()) {
+    return empty_ports;
   }
-  return size_t(-1);
+  return result->second;
+}
+
+size_t IoLocationMap::io_x(const BasicPort& io_port) const {
+  return find_io_coordinate(io_port)[0];
 }
 
 size_t IoLocationMap::io_y(const BasicPort& io_port) const {
-  for (auto pair : io_indices_) {
-    for (const BasicPort& candidate : pair.second) {
-      if (candidate == io_port) {
-        return pair.first[1];
-      }
-    }
-  }
-  return size_t(-1);
+  return find_io_coordinate(io_port)[1];
 }
 
 size_t IoLocationMap::io_z(const BasicPort& io_port) const {
-  for (auto pair : io_indices_) {
-    for (const BasicPort& candidate : pair.second) {
-      if (candidate == io_port) {
-        return pair.first[2];
-      }
-    }
+  return find_io_coordinate(io_port)[2];
+}
+
+/**************************************************
+ * Private Accessors
+ *************************************************/
+std::array<size_t, 3> IoLocationMap::find_io_coordinate(
+  const BasicPort& io_port) const {
+  std::array<size_t, 3> invalid_coord = {size_t(-1), size_t(-1), size_t(-1)};
+  /* Only single-bit I/Os are stored in the map */
+  if (io_port.get_lsb() != io_port.get_msb()) {
+    return invalid_coord;
   }
-  return size_t(-1);
+  auto result = io_coordinates_.find(io_port.get_name());
+  if (result == io_coordinates_.end() ||
+      io_port.get_lsb() >= result->second.size()) {
+    return invalid_coord;
+  }
+  return result->second[io_port.get_lsb()];
 }
 
+/**************************************************
+ * Public Mutators
+ *************************************************/
 void IoLocationMap::set_io_index(const size_t& x, const size_t& y,
                                  const size_t& z,
                                  const std::string& io_port_name,
@@ -92,6 +105,34 @@ void IoLocationMap::set_io_index(const size_t& x, const size_t& y,
   }
 
   io_indices_[coord].push_back(port_to_add);
+  add_io_coordinate(coord, port_to_add);
+}
+
+/**************************************************
+ * Private Mutators
+ *************************************************/
+void IoLocationMap::add_io_coordinate(const std::array<size_t, 3>& coord,
+                                      const BasicPort& io_port) {
+  std::vector<std::array<size_t, 3>>& coords =
+    io_coordinates_[io_port.get_name()];
+  if (io_port.get_lsb() >= coords.size()) {
+    coords.resize(io_port.get_lsb() + 1,
+                  {size_t(-1), size_t(-1), size_t(-1)});
+  }
+  /* Keep the smallest coordinate, as a search on io_indices_ would find */
+  std::array<size_t, 3>& curr_coord = coords[io_port.get_lsb()];
+  if (size_t(-1) == curr_coord[0] || coord < curr_coord) {
+    curr_coord = coord;
+  }
+}
+
+void IoLocationMap::build_io_coordinate_lookup() {
+  io_coordinates_.clear();
+  for (const auto& pair : io_indices_) {
+    for (const BasicPort& port : pair.second) {
+      add_io_coordinate(pair.first, port);
+    }
+  }
 }
 
 int IoLocationMap::write_to_xml_file(const std::string& fname,
@@ -112,8 +153,8 @@ int IoLocationMap::write_to_xml_file(const std::string& fname,
   /* Use default name if user does not provide one */
   VTR_ASSERT(true != fname.empty());
 
-  /* Create a file handler*/
-  std::fstream fp;
+  /* Create a file handler, whose buffer is only flushed when full */
+  BufferedFileStream fp;
   /* Open a file */
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
@@ -123,9 +164,9 @@ int IoLocationMap::write_to_xml_file(const std::string& fname,
   int err_code = 0;
 
   /* Write XML head */
-  fp << "<!--" << std::endl;
-  fp << "\t- FPGA Fabric I/O Information" << std::endl;
-  fp << "\t- Generated by OpenFPGA" << std::endl;
+  fp << "<!--\n";
+  fp << "\t- FPGA Fabric I/O Information\n";
+  fp << "\t- Generated by OpenFPGA\n";
 
   auto end = std::chrono::system_clock::now();
   std::time_t end_time = std::chrono::system_clock::to_time_t(end);
@@ -133,27 +174,32 @@ int IoLocationMap::write_to_xml_file(const std::string& fname,
     fp << "\t- Date: " << std::ctime(&end_time);
   }
 
-  fp << "-->" << std::endl;
-  fp << std::endl;
+  fp << "-->\n";
+  fp << "\n";
 
   fp << "<io_coordinates>\n";
 
   size_t io_cnt = 0;
 
-  /* Walk through the fabric I/O location map data structure */
-  for (auto pair : io_indices_) {
+  /* Walk through the fabric I/O location map data structure. Each line is
+   * formatted into a reused string rather than through the stream
+   * operators, which are slow for so many small pieces */
+  std::string line;
+  for (const auto& pair : io_indices_) {
     for (const BasicPort& port : pair.second) {
-      fp << "\t"
-         << "<io pad=\"" << port.get_name().c_str() << "[" << port.get_lsb()
-         << "]\"";
-      fp << " "
-         << "x=\"" << pair.first[0] << "\"";
-      fp << " "
-         << "y=\"" << pair.first[1] << "\"";
-      fp << " "
-         << "z=\"" << pair.first[2] << "\"";
-      fp << "/>";
-      fp << "\n";
+      line.clear();
+      line += "\t<io pad=\"";
+      line += port.get_name();
+      line += "[";
+      line += std::to_string(port.get_lsb());
+      line += "]\" x=\"";
+      line += std::to_string(pair.first[0]);
+      line += "\" y=\"";
+      line += std::to_string(pair.first[1]);
+      line += "\" z=\"";
+      line += std::to_string(pair.first[2]);
+      line += "\"/>\n";
+      fp.write(line.data(), line.size());
       io_cnt++;
     }
   }
@@ -170,4 +216,16 @@ int IoLocationMap::write_to_xml_file(const std::string& fname,
   return err_code;
 }
 
+/**************************************************
+ * Public binary image writer/reader
+ *************************************************/
+void IoLocationMap::write_to_binary_image(BinaryImageWriter& writer) const {
+  write_binary_image(writer, io_indices_);
+}
+
+void IoLocationMap::read_from_binary_image(BinaryImageReader& reader) {
+  read_binary_image(reader, io_indices_);
+  build_io_coordinate_lookup();
+}
+
 } /* end namespace openfpga */
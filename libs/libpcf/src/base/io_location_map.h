@@ -9,8 +9,10 @@
 #include <array>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "openfpga_binary_image.h"
 #include "openfpga_port.h"
 
 /* Begin namespace openfpga */
@@ -36,6 +38,11 @@ class IoLocationMap {
  public: /* Public aggregators */
   size_t io_index(const size_t& x, const size_t& y, const size_t& z,
                   const std::string& io_port_name) const;
+  /* All the I/Os at a (x, y, z) coordinate, each of which is a port of width
+   * 1. Finding the I/Os of all the ports through a single lookup is faster
+   * than calling io_index() for each port */
+  const std::vector<BasicPort>& io_ports(const size_t& x, const size_t& y,
+                                         const size_t& z) const;
   size_t io_x(const BasicPort& io_port) const;
   size_t io_y(const BasicPort& io_port) const;
   size_t io_z(const BasicPort& io_port) const;
@@ -49,11 +56,35 @@ class IoLocationMap {
                         const bool& include_time_stamp,
                         const bool& verbose) const;
 
+ public: /* Public binary image writer/reader */
+  /* Write all the internal data to a binary image */
+  void write_to_binary_image(BinaryImageWriter& writer) const;
+  /* Replace all the internal data with the data of a binary image */
+  void read_from_binary_image(BinaryImageReader& reader);
+
+ private: /* Private accessors */
+  /* Find the (x, y, z) coordinate of an I/O through the fast lookup.
+   * Return an array of size_t(-1) if not found */
+  std::array<size_t, 3> find_io_coordinate(const BasicPort& io_port) const;
+
+ private: /* Private mutators */
+  /* Add an I/O to the fast lookup of coordinates */
+  void add_io_coordinate(const std::array<size_t, 3>& coord,
+                         const BasicPort& io_port);
+  void build_io_coordinate_lookup();
+
  private: /* Internal Data */
   /* I/O index fast lookup by [x][y][z] location
    * Note that multiple I/Os may be assigned to the same coordinate!
    */
   std::map<std::array<size_t, 3>, std::vector<BasicPort>> io_indices_;
+
+  /* Fast lookup for the coordinate of an I/O: [io_port_name][io_index] ->
+   * (x, y, z). When an I/O is mapped to multiple coordinates, the smallest
+   * one is kept, which is the first one found in io_indices_
+   */
+  std::unordered_map<std::string, std::vector<std::array<size_t, 3>>>
+    io_coordinates_;
 };
 
 } /* End namespace openfpga*/
@@ -55,7 +55,11 @@ IoPinTable::e_io_direction IoPinTable::pin_direction(
 std::vector<IoPinTableId> IoPinTable::find_internal_pin(
   const BasicPort& ext_pin, const e_io_direction& pin_direction) const {
   std::vector<IoPinTableId> int_pin_ids;
-  for (auto pin_id : pin_ids_) {
+  auto result = external_pin_lookup_.find(ext_pin.get_name());
+  if (result == external_pin_lookup_.end()) {
+    return int_pin_ids;
+  }
+  for (auto pin_id : result->second) {
     if ((external_pins_[pin_id] == ext_pin) &&
         (pin_directions_[pin_id] == pin_direction)) {
       int_pin_ids.push_back(pin_id);
@@ -64,6 +68,21 @@ std::vector<IoPinTableId> IoPinTable::find_internal_pin(
   return int_pin_ids;
 }
 
+std::vector<IoPinTableId> IoPinTable::find_external_pin(
+  const BasicPort& int_pin) const {
+  std::vector<IoPinTableId> ext_pin_ids;
+  auto result = internal_pin_lookup_.find(int_pin.get_name());
+  if (result == internal_pin_lookup_.end()) {
+    return ext_pin_ids;
+  }
+  for (auto pin_id : result->second) {
+    if (internal_pins_[pin_id] == int_pin) {
+      ext_pin_ids.push_back(pin_id);
+    }
+  }
+  return ext_pin_ids;
+}
+
 bool IoPinTable::empty() const { return 0 == pin_ids_.size(); }
 
 /************************************************************************
@@ -93,12 +112,16 @@ IoPinTableId IoPinTable::create_pin() {
 void IoPinTable::set_internal_pin(const IoPinTableId& pin_id,
                                   const BasicPort& pin) {
   VTR_ASSERT(valid_pin_id(pin_id));
+  update_pin_lookup(internal_pin_lookup_, pin_id,
+                    internal_pins_[pin_id].get_name(), pin.get_name());
   internal_pins_[pin_id] = pin;
 }
 
 void IoPinTable::set_external_pin(const IoPinTableId& pin_id,
                                   const BasicPort& pin) {
   VTR_ASSERT(valid_pin_id(pin_id));
+  update_pin_lookup(external_pin_lookup_, pin_id,
+                    external_pins_[pin_id].get_name(), pin.get_name());
   external_pins_[pin_id] = pin;
 }
 
@@ -113,6 +136,28 @@ void IoPinTable::set_pin_direction(const IoPinTableId& pin_id,
   pin_directions_[pin_id] = direction;
 }
 
+/************************************************************************
+ * Private mutators
+ ***********************************************************************/
+void IoPinTable::update_pin_lookup(
+  std::unordered_map<std::string, std::vector<IoPinTableId>>& lookup,
+  const IoPinTableId& pin_id, const std::string& old_name,
+  const std::string& new_name) {
+  /* A pin which has never been set is not in the lookup */
+  auto old_result = lookup.find(old_name);
+  if (old_result != lookup.end()) {
+    std::vector<IoPinTableId>& old_pins = old_result->second;
+    auto old_pin = std::lower_bound(old_pins.begin(), old_pins.end(), pin_id);
+    if ((old_pin != old_pins.end()) && (*old_pin == pin_id)) {
+      old_pins.erase(old_pin);
+    }
+  }
+  /* Pins are mostly set in sequence, so they are appended in most cases */
+  std::vector<IoPinTableId>& new_pins = lookup[new_name];
+  new_pins.insert(std::lower_bound(new_pins.begin(), new_pins.end(), pin_id),
+                  pin_id);
+}
+
 /************************************************************************
  * Internal invalidators/validators
  ***********************************************************************/
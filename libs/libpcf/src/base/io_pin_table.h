@@ -7,6 +7,8 @@
 #include <array>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_geometry.h"
@@ -83,6 +85,8 @@ class IoPinTable {
   /* Given an external pin, find all the internal pin that is mapped */
   std::vector<IoPinTableId> find_internal_pin(
     const BasicPort& ext_pin, const e_io_direction& pin_direction) const;
+  /* Given an internal pin, find all the external pin that is mapped */
+  std::vector<IoPinTableId> find_external_pin(const BasicPort& int_pin) const;
   /* Check if there are any pins */
   bool empty() const;
 
@@ -102,6 +106,13 @@ class IoPinTable {
   /* Show if the pin id is a valid for data queries */
   bool valid_pin_id(const IoPinTableId& pin_id) const;
 
+ private: /* Private mutators */
+  /* Move a pin from a name to another in a fast lookup */
+  void update_pin_lookup(
+    std::unordered_map<std::string, std::vector<IoPinTableId>>& lookup,
+    const IoPinTableId& pin_id, const std::string& old_name,
+    const std::string& new_name);
+
  private: /* Internal data */
   /* Unique ids for each design constraint */
   vtr::vector<IoPinTableId, IoPinTableId> pin_ids_;
@@ -111,6 +122,14 @@ class IoPinTable {
   vtr::vector<IoPinTableId, BasicPort> external_pins_;
   vtr::vector<IoPinTableId, e_side> pin_sides_;
   vtr::vector<IoPinTableId, e_io_direction> pin_directions_;
+
+  /* Fast lookups for pins by the names of their external and internal pins.
+   * The pins of each name are sorted by their ids, so that searches return
+   * the same sequence as walking through all the pins */
+  std::unordered_map<std::string, std::vector<IoPinTableId>>
+    external_pin_lookup_;
+  std::unordered_map<std::string, std::vector<IoPinTableId>>
+    internal_pin_lookup_;
 };
 
 } /* end namespace openfpga */
@@ -1,7 +1,9 @@
 /******************************************************************************
  * Inspired from https://github.com/genbtc/VerilogPCFparser
  ******************************************************************************/
-#include <sstream>
+#include <array>
+#include <map>
+#include <unordered_set>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -10,14 +12,67 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 #include "pcf2place.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * The I/O of the fabric which a pcf constraint is resolved to
+ *******************************************************************/
+struct PcfIoResolution {
+  IoPinTable::e_io_direction pin_direction = IoPinTable::NUM_IO_DIRECTIONS;
+  /* Internal pins mapped to the external pin of the constraint */
+  std::vector<IoPinTableId> int_pin_ids;
+  /* Coordinate of the internal pin, when it is unique */
+  std::array<size_t, 3> coord = {{size_t(-1), size_t(-1), size_t(-1)}};
+};
+
+/********************************************************************
+ * Resolve a pcf constraint against the pin table and the I/O location
+ * map. This only reads shared data, so constraints can be resolved on
+ * multiple threads
+ *******************************************************************/
+static PcfIoResolution resolve_pcf_io_constraint(
+  const PcfData& pcf_data, const PcfIoConstraintId& io_id,
+  const std::unordered_set<std::string>& input_nets,
+  const std::unordered_set<std::string>& output_nets,
+  const IoPinTable& io_pin_table, const IoLocationMap& io_location_map) {
+  PcfIoResolution resolution;
+  /* Find the net name */
+  std::string net = pcf_data.io_net(io_id);
+  /* Find the pin direction from blif reader */
+  if (input_nets.end() != input_nets.find(net)) {
+    resolution.pin_direction = IoPinTable::INPUT;
+  } else if (output_nets.end() != output_nets.find(net)) {
+    resolution.pin_direction = IoPinTable::OUTPUT;
+  } else {
+    return resolution;
+  }
+  /* Find the internal pin name from pin table, currently we only support
+   * 1-to-1 mapping */
+  resolution.int_pin_ids = io_pin_table.find_internal_pin(
+    pcf_data.io_pin(io_id), resolution.pin_direction);
+  if (1 != resolution.int_pin_ids.size()) {
+    return resolution;
+  }
+  /* Find the coordinate from io location map */
+  BasicPort int_pin = io_pin_table.internal_pin(resolution.int_pin_ids[0]);
+  resolution.coord = {{io_location_map.io_x(int_pin),
+                       io_location_map.io_y(int_pin),
+                       io_location_map.io_z(int_pin)}};
+  return resolution;
+}
+
 /********************************************************************
  * Generate a .place file with the a few inputs
  *
+ * Constraints are resolved on multiple threads, while errors are
+ * reported and the I/O place is built in the sequence of constraints,
+ * so that the outputs do not depend on the number of threads.
+ * In the end, internal pins are checked not to be assigned to two nets.
+ *
  * Return 0 if successful
  * Return 1 if there are serious errors
  *******************************************************************/
@@ -25,7 +80,8 @@ int pcf2place(const PcfData& pcf_data,
               const std::vector<std::string>& input_nets,
               const std::vector<std::string>& output_nets,
               const IoPinTable& io_pin_table,
-              const IoLocationMap& io_location_map, IoNetPlace& io_net_place) {
+              const IoLocationMap& io_location_map, IoNetPlace& io_net_place,
+              const size_t& num_threads) {
   vtr::ScopedStartFinishTimer timer("Convert PCF data to VPR I/O place data");
 
   int num_err = 0;
@@ -41,21 +97,31 @@ int pcf2place(const PcfData& pcf_data,
     VTR_LOG("PCF basic check passed\n");
   }
 
+  /* Resolve all the constraints */
+  std::vector<PcfIoConstraintId> io_ids(pcf_data.io_constraints().begin(),
+                                        pcf_data.io_constraints().end());
+  std::unordered_set<std::string> input_net_lookup(input_nets.begin(),
+                                                   input_nets.end());
+  std::unordered_set<std::string> output_net_lookup(output_nets.begin(),
+                                                    output_nets.end());
+  std::vector<PcfIoResolution> resolutions(io_ids.size());
+  parallel_for(io_ids.size(), num_threads, [&](const size_t& iio) {
+    resolutions[iio] = resolve_pcf_io_constraint(
+      pcf_data, io_ids[iio], input_net_lookup, output_net_lookup,
+      io_pin_table, io_location_map);
+  });
+
   /* Build the I/O place */
-  for (const PcfIoConstraintId& io_id : pcf_data.io_constraints()) {
+  std::map<IoPinTableId, std::string> int_pin2net;
+  for (size_t iio = 0; iio < io_ids.size(); ++iio) {
+    const PcfIoConstraintId& io_id = io_ids[iio];
+    const PcfIoResolution& resolution = resolutions[iio];
     /* Find the net name */
     std::string net = pcf_data.io_net(io_id);
     /* Find the external pin name */
     BasicPort ext_pin = pcf_data.io_pin(io_id);
-    /* Find the pin direction from blif reader */
-    IoPinTable::e_io_direction pin_direction = IoPinTable::NUM_IO_DIRECTIONS;
-    if (input_nets.end() !=
-        std::find(input_nets.begin(), input_nets.end(), net)) {
-      pin_direction = IoPinTable::INPUT;
-    } else if (output_nets.end() !=
-               std::find(output_nets.begin(), output_nets.end(), net)) {
-      pin_direction = IoPinTable::OUTPUT;
-    } else {
+    IoPinTable::e_io_direction pin_direction = resolution.pin_direction;
+    if (IoPinTable::NUM_IO_DIRECTIONS == pin_direction) {
       /* Cannot find the pin, error out! */
       VTR_LOG_ERROR(
         "Net '%s' from .pcf is neither defined as input nor output in .blif!\n",
@@ -63,9 +129,7 @@ int pcf2place(const PcfData& pcf_data,
       num_err++;
       continue;
     }
-    /* Find the internal pin name from pin table, currently we only support
-     * 1-to-1 mapping */
-    auto int_pin_ids = io_pin_table.find_internal_pin(ext_pin, pin_direction);
+    const std::vector<IoPinTableId>& int_pin_ids = resolution.int_pin_ids;
     if (0 == int_pin_ids.size()) {
       VTR_LOG_ERROR(
         "Cannot find any internal pin that net '%s' is mapped through an "
@@ -88,10 +152,9 @@ int pcf2place(const PcfData& pcf_data,
     }
     VTR_ASSERT(1 == int_pin_ids.size());
     BasicPort int_pin = io_pin_table.internal_pin(int_pin_ids[0]);
-    /* Find the coordinate from io location map */
-    size_t x = io_location_map.io_x(int_pin);
-    size_t y = io_location_map.io_y(int_pin);
-    size_t z = io_location_map.io_z(int_pin);
+    size_t x = resolution.coord[0];
+    size_t y = resolution.coord[1];
+    size_t z = resolution.coord[2];
     /* Sanity check */
     if (size_t(-1) == x || size_t(-1) == y || size_t(-1) == z) {
       VTR_LOG_ERROR(
@@ -101,6 +164,17 @@ int pcf2place(const PcfData& pcf_data,
         int_pin.get_name().c_str(), int_pin.get_lsb());
       continue;
     }
+    /* Conflict check: an internal pin can only be assigned to one net */
+    auto conflict = int_pin2net.find(int_pin_ids[0]);
+    if (conflict != int_pin2net.end()) {
+      VTR_LOG_ERROR(
+        "Internal pin '%s[%lu]' is assigned to two nets '%s' and '%s'!\n",
+        int_pin.get_name().c_str(), int_pin.get_lsb(),
+        conflict->second.c_str(), net.c_str());
+      num_err++;
+      continue;
+    }
+    int_pin2net[int_pin_ids[0]] = net;
 
     /* Add a fixed prefix to net namei, this is hard coded by VPR */
     if (IoPinTable::OUTPUT == pin_direction) {
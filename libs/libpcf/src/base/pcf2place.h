@@ -19,12 +19,14 @@ namespace openfpga {
  * - Input and output lists from a netlist
  * - A chip I/O pin table file (.csv)
  * - An FPGA I/O location file (.xml)
+ * The constraints are resolved on a given number of threads
  */
 int pcf2place(const PcfData& pcf_data,
               const std::vector<std::string>& input_nets,
               const std::vector<std::string>& output_nets,
               const IoPinTable& io_pin_table,
-              const IoLocationMap& io_location_map, IoNetPlace& io_net_place);
+              const IoLocationMap& io_location_map, IoNetPlace& io_net_place,
+              const size_t& num_threads = 1);
 
 } /* End namespace openfpga*/
 
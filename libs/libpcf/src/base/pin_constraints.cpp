@@ -41,7 +41,11 @@ std::string PinConstraints::net(
 
 std::string PinConstraints::pin_net(const openfpga::BasicPort& pin) const {
   std::string constrained_net_name;
-  for (const PinConstraintId& pin_constraint : pin_constraints()) {
+  auto result = pin_name2constraints_.find(pin.get_name());
+  if (result == pin_name2constraints_.end()) {
+    return constrained_net_name;
+  }
+  for (const PinConstraintId& pin_constraint : result->second) {
     if (pin == pin_constraint_pins_[pin_constraint]) {
       constrained_net_name = net(pin_constraint);
       break;
@@ -52,11 +56,9 @@ std::string PinConstraints::pin_net(const openfpga::BasicPort& pin) const {
 
 openfpga::BasicPort PinConstraints::net_pin(const std::string& net) const {
   openfpga::BasicPort constrained_pin;
-  for (const PinConstraintId& pin_constraint : pin_constraints()) {
-    if (net == pin_constraint_nets_[pin_constraint]) {
-      constrained_pin = pin(pin_constraint);
-      break;
-    }
+  auto result = net2constraint_.find(net);
+  if (result != net2constraint_.end()) {
+    constrained_pin = pin(result->second);
   }
   return constrained_pin;
 }
@@ -64,11 +66,9 @@ openfpga::BasicPort PinConstraints::net_pin(const std::string& net) const {
 PinConstraints::e_logic_level PinConstraints::net_default_value(
   const std::string& net) const {
   PinConstraints::e_logic_level logic_level = PinConstraints::NUM_LOGIC_LEVELS;
-  for (const PinConstraintId& pin_constraint : pin_constraints()) {
-    if (net == pin_constraint_nets_[pin_constraint]) {
-      logic_level = pin_constraint_net_default_values_[pin_constraint];
-      break;
-    }
+  auto result = net2constraint_.find(net);
+  if (result != net2constraint_.end()) {
+    logic_level = pin_constraint_net_default_values_[result->second];
   }
   return logic_level;
 }
@@ -120,6 +120,10 @@ PinConstraintId PinConstraints::create_pin_constraint(
   pin_constraint_net_default_values_.push_back(
     PinConstraints::NUM_LOGIC_LEVELS);
 
+  /* Register to fast look-up. Only the first constraint of a net is found */
+  pin_name2constraints_[pin.get_name()].push_back(pin_constraint_id);
+  net2constraint_.emplace(net, pin_constraint_id);
+
   return pin_constraint_id;
 }
 
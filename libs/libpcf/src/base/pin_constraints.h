@@ -7,6 +7,8 @@
 #include <array>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_geometry.h"
@@ -143,6 +145,14 @@ class PinConstraints {
   /* Default value of the nets to constraint */
   vtr::vector<PinConstraintId, e_logic_level>
     pin_constraint_net_default_values_;
+
+  /* Fast look-up, maintained when creating pin constraints:
+   * - the constraints on the pins of each name, in the sequence of creation
+   * - the first constraint of each net
+   */
+  std::unordered_map<std::string, std::vector<PinConstraintId>>
+    pin_name2constraints_;
+  std::unordered_map<std::string, PinConstraintId> net2constraint_;
 };
 
 #endif
@@ -57,14 +57,10 @@ std::string RepackDesignConstraints::net(
 std::string RepackDesignConstraints::find_constrained_pin_net(
   const std::string& pb_type, const openfpga::BasicPort& pin) const {
   std::string constrained_net_name;
-  for (const RepackDesignConstraintId& design_constraint :
-       design_constraints()) {
-    /* If found a constraint, record the net name */
-    if ((pb_type == repack_design_constraint_pb_types_[design_constraint]) &&
-        (pin == repack_design_constraint_pins_[design_constraint])) {
-      constrained_net_name = repack_design_constraint_nets_[design_constraint];
-      break;
-    }
+  /* Only the first constraint on a pin is considered */
+  auto result = pin_lookup_.find(pin_key(pb_type, pin));
+  if ((result != pin_lookup_.end()) && (false == result->second.empty())) {
+    constrained_net_name = repack_design_constraint_nets_[result->second[0]];
   }
   return constrained_net_name;
 }
@@ -72,12 +68,9 @@ std::string RepackDesignConstraints::find_constrained_pin_net(
 openfpga::BasicPort RepackDesignConstraints::net_pin(
   const std::string& net) const {
   openfpga::BasicPort constrained_pin;
-  for (const RepackDesignConstraintId& design_constraint :
-       design_constraints()) {
-    if (net == repack_design_constraint_nets_[design_constraint]) {
-      constrained_pin = pin(design_constraint);
-      break;
-    }
+  auto result = net_lookup_.find(net);
+  if ((result != net_lookup_.end()) && (false == result->second.empty())) {
+    constrained_pin = pin(result->second[0]);
   }
   return constrained_pin;
 }
@@ -96,6 +89,7 @@ void RepackDesignConstraints::reserve_design_constraints(
   repack_design_constraint_pb_types_.reserve(num_design_constraints);
   repack_design_constraint_pins_.reserve(num_design_constraints);
   repack_design_constraint_nets_.reserve(num_design_constraints);
+  net_lookup_.reserve(num_design_constraints);
 }
 
 RepackDesignConstraintId RepackDesignConstraints::create_design_constraint(
@@ -111,6 +105,13 @@ RepackDesignConstraintId RepackDesignConstraints::create_design_constraint(
   repack_design_constraint_pins_.emplace_back();
   repack_design_constraint_nets_.emplace_back();
 
+  /* Register the empty pin and net to fast lookups */
+  pin_lookup_[pin_key(repack_design_constraint_pb_types_.back(),
+                      repack_design_constraint_pins_.back())]
+    .push_back(repack_design_constraint_id);
+  net_lookup_[repack_design_constraint_nets_.back()].push_back(
+    repack_design_constraint_id);
+
   return repack_design_constraint_id;
 }
 
@@ -119,6 +120,13 @@ void RepackDesignConstraints::set_pb_type(
   const std::string& pb_type) {
   /* validate the design_constraint_id */
   VTR_ASSERT(valid_design_constraint_id(repack_design_constraint_id));
+  const openfpga::BasicPort& pin =
+    repack_design_constraint_pins_[repack_design_constraint_id];
+  update_lookup(
+    pin_lookup_, repack_design_constraint_id,
+    pin_key(repack_design_constraint_pb_types_[repack_design_constraint_id],
+            pin),
+    pin_key(pb_type, pin));
   repack_design_constraint_pb_types_[repack_design_constraint_id] = pb_type;
 }
 
@@ -127,6 +135,13 @@ void RepackDesignConstraints::set_pin(
   const openfpga::BasicPort& pin) {
   /* validate the design_constraint_id */
   VTR_ASSERT(valid_design_constraint_id(repack_design_constraint_id));
+  const std::string& pb_type =
+    repack_design_constraint_pb_types_[repack_design_constraint_id];
+  update_lookup(
+    pin_lookup_, repack_design_constraint_id,
+    pin_key(pb_type,
+            repack_design_constraint_pins_[repack_design_constraint_id]),
+    pin_key(pb_type, pin));
   repack_design_constraint_pins_[repack_design_constraint_id] = pin;
 }
 
@@ -135,9 +150,44 @@ void RepackDesignConstraints::set_net(
   const std::string& net) {
   /* validate the design_constraint_id */
   VTR_ASSERT(valid_design_constraint_id(repack_design_constraint_id));
+  update_lookup(net_lookup_, repack_design_constraint_id,
+                repack_design_constraint_nets_[repack_design_constraint_id],
+                net);
   repack_design_constraint_nets_[repack_design_constraint_id] = net;
 }
 
+/************************************************************************
+ * Private mutators
+ ***********************************************************************/
+RepackDesignConstraints::t_pin_key RepackDesignConstraints::pin_key(
+  const std::string& pb_type, const openfpga::BasicPort& pin) {
+  return std::make_tuple(pb_type, pin.get_name(), pin.get_lsb(),
+                         pin.get_msb());
+}
+
+template <class K, class M>
+void RepackDesignConstraints::update_lookup(
+  M& lookup, const RepackDesignConstraintId& repack_design_constraint_id,
+  const K& old_key, const K& new_key) {
+  if (old_key == new_key) {
+    return;
+  }
+  std::vector<RepackDesignConstraintId>& old_ids = lookup.at(old_key);
+  auto old_id = std::lower_bound(old_ids.begin(), old_ids.end(),
+                                 repack_design_constraint_id);
+  VTR_ASSERT((old_id != old_ids.end()) &&
+             (*old_id == repack_design_constraint_id));
+  old_ids.erase(old_id);
+  if (true == old_ids.empty()) {
+    lookup.erase(old_key);
+  }
+  /* Constraints are mostly set in sequence, so they are appended */
+  std::vector<RepackDesignConstraintId>& new_ids = lookup[new_key];
+  new_ids.insert(std::lower_bound(new_ids.begin(), new_ids.end(),
+                                  repack_design_constraint_id),
+                 repack_design_constraint_id);
+}
+
 /************************************************************************
  * Internal invalidators/validators
  ***********************************************************************/
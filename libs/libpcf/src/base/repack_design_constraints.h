@@ -7,6 +7,9 @@
 #include <array>
 #include <map>
 #include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_geometry.h"
@@ -115,6 +118,19 @@ class RepackDesignConstraints {
    */
   bool unmapped_net(const std::string& net) const;
 
+ private: /* Types */
+  /* A pin of a pb_type as <pb_type, pin name, lsb, msb> */
+  typedef std::tuple<std::string, std::string, size_t, size_t> t_pin_key;
+
+ private: /* Private mutators */
+  static t_pin_key pin_key(const std::string& pb_type,
+                           const openfpga::BasicPort& pin);
+  /* Move a design constraint from a key to another in a fast lookup */
+  template <class K, class M>
+  static void update_lookup(
+    M& lookup, const RepackDesignConstraintId& repack_design_constraint_id,
+    const K& old_key, const K& new_key);
+
  private: /* Internal data */
   /* Unique ids for each design constraint */
   vtr::vector<RepackDesignConstraintId, RepackDesignConstraintId>
@@ -135,6 +151,14 @@ class RepackDesignConstraints {
   /* Nets to constraint */
   vtr::vector<RepackDesignConstraintId, std::string>
     repack_design_constraint_nets_;
+
+  /* Fast lookups for design constraints by their pins and by their nets,
+   * maintained when the constraints are modified. The constraints of each
+   * key are sorted by their ids, so that the first one is the same as
+   * walking through all the constraints */
+  std::map<t_pin_key, std::vector<RepackDesignConstraintId>> pin_lookup_;
+  std::unordered_map<std::string, std::vector<RepackDesignConstraintId>>
+    net_lookup_;
 };
 
 #endif
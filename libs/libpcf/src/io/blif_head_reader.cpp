@@ -1,10 +1,145 @@
 #include "blif_head_reader.h"
 
 #include <cassert>
+#include <cctype>
 #include <cstdio>
+#include <utility>
+
+/* Headers from openfpgautil library */
+#include "openfpga_mapped_file.h"
 
 namespace blifparse {
 
+/* Tokens of a line of a BLIF file, as ranges in the content of the file */
+typedef std::vector<std::pair<const char*, const char*>> BlifTokens;
+
+static bool is_blif_space(const char& c) {
+  return ('\n' != c) && (0 != std::isspace(static_cast<unsigned char>(c)));
+}
+
+/* Return the number of characters of a line continuation, i.e., a '\' at
+ * the end of a line, starting from a given character, or 0 if none */
+static size_t blif_line_continuation_length(const char* cur,
+                                            const char* end) {
+  if ((cur == end) || ('\\' != *cur)) {
+    return 0;
+  }
+  const char* next = cur + 1;
+  if ((next != end) && ('\r' == *next)) {
+    ++next;
+  }
+  if ((next != end) && ('\n' == *next)) {
+    return next - cur + 1;
+  }
+  return 0;
+}
+
+/* Find the tokens of the line which starts from a given character, where
+ * lines ending with a '\' are joined with the next line, and comments are
+ * skipped. The character and the line number are moved to the next line */
+static void find_blif_line_tokens(const char*& cur, const char* end,
+                                  int& line_num, BlifTokens& tokens) {
+  tokens.clear();
+  while (cur != end) {
+    size_t continuation = blif_line_continuation_length(cur, end);
+    if (0 < continuation) {
+      cur += continuation;
+      ++line_num;
+    } else if ('\n' == *cur) {
+      ++cur;
+      ++line_num;
+      return;
+    } else if ('#' == *cur) {
+      while ((cur != end) && ('\n' != *cur)) {
+        ++cur;
+      }
+    } else if (true == is_blif_space(*cur)) {
+      ++cur;
+    } else {
+      const char* token_begin = cur;
+      while ((cur != end) && ('#' != *cur) && ('\n' != *cur) &&
+             (false == is_blif_space(*cur)) &&
+             (0 == blif_line_continuation_length(cur, end))) {
+        ++cur;
+      }
+      tokens.push_back(std::make_pair(token_begin, cur));
+    }
+  }
+}
+
+/* Copy the tokens from a given index to strings */
+static std::vector<std::string> blif_token_strings(const BlifTokens& tokens,
+                                                   const size_t& first) {
+  std::vector<std::string> strings;
+  for (size_t itoken = first; itoken < tokens.size(); ++itoken) {
+    strings.emplace_back(tokens[itoken].first, tokens[itoken].second);
+  }
+  return strings;
+}
+
+/********************************************************************
+ * Read the head of the first model of a BLIF file, i.e., its name, inputs
+ * and outputs, without parsing the netlist.
+ * The file is memory-mapped and tokenized in place. Reading stops at the
+ * first line of the body of the model, e.g., .names or .subckt, so that
+ * the rest of the file is never read from the disk.
+ *******************************************************************/
+void blif_parse_head_filename(const char* fname, BlifHeadReader& callback) {
+  callback.start_parse();
+  callback.filename(fname);
+
+  openfpga::MappedFile file(fname);
+  if (!file.is_open()) {
+    callback.parse_error(0, std::string(fname), "Fail to open file");
+    callback.finish_parse();
+    return;
+  }
+
+  bool model_found = false;
+  int line_num = 1;
+  BlifTokens tokens;
+  const char* cur = file.begin();
+  while (cur != file.end()) {
+    int curr_line_num = line_num;
+    find_blif_line_tokens(cur, file.end(), line_num, tokens);
+    if (tokens.empty()) {
+      continue;
+    }
+    callback.lineno(curr_line_num);
+    std::string directive(tokens[0].first, tokens[0].second);
+    if (directive == ".model") {
+      /* Only the first model, i.e., the top-level one, is read */
+      if (model_found) {
+        break;
+      }
+      model_found = true;
+      std::string model_name;
+      if (1 < tokens.size()) {
+        model_name.assign(tokens[1].first, tokens[1].second);
+      }
+      callback.begin_model(model_name);
+    } else if (!model_found) {
+      callback.parse_error(curr_line_num, directive, "Expect a .model first");
+      break;
+    } else if (directive == ".inputs") {
+      callback.inputs(blif_token_strings(tokens, 1));
+    } else if (directive == ".outputs") {
+      callback.outputs(blif_token_strings(tokens, 1));
+    } else {
+      /* Reach the body of the model */
+      break;
+    }
+  }
+  if (!model_found && !callback.had_error()) {
+    callback.parse_error(line_num, std::string(), "No .model is found");
+  }
+
+  callback.finish_parse();
+}
+
+/********************************************************************
+ * Member functions of class BlifHeadReader
+ *******************************************************************/
 void BlifHeadReader::start_parse() {
   // Pass
 }
@@ -56,5 +56,10 @@ class BlifHeadReader : public Callback {
   bool had_error_ = false;
 };
 
+/* Read only the name, inputs and outputs of the first model of a BLIF
+ * file, stopping before the netlist of the model. This is much faster
+ * than blif_parse_filename() on large netlists */
+void blif_parse_head_filename(const char* fname, BlifHeadReader& callback);
+
 }  // namespace blifparse
 #endif
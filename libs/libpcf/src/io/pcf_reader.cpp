@@ -1,7 +1,9 @@
 /******************************************************************************
  * Inspired from https://github.com/genbtc/VerilogPCFparser
  ******************************************************************************/
-#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <string>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -10,6 +12,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_mapped_file.h"
 #include "pcf_reader.h"
 
 /* begin namespace openfpga */
@@ -20,9 +23,37 @@ namespace openfpga {
  *************************************************/
 constexpr const char COMMENT = '#';
 
+static bool is_pcf_space(const char& c) {
+  return 0 != std::isspace(static_cast<unsigned char>(c));
+}
+
+/********************************************************************
+ * Find the next word of a line, where words are separated by white spaces.
+ * Return false if the end of line is reached.
+ * The word is a range in the content of the file, which is not copied
+ *******************************************************************/
+static bool find_pcf_word(const char*& cur, const char* line_end,
+                          const char*& word_begin, const char*& word_end) {
+  while ((cur != line_end) && (true == is_pcf_space(*cur))) {
+    ++cur;
+  }
+  if (cur == line_end) {
+    return false;
+  }
+  word_begin = cur;
+  while ((cur != line_end) && (false == is_pcf_space(*cur))) {
+    ++cur;
+  }
+  word_end = cur;
+  return true;
+}
+
 /********************************************************************
  * A writer to output a repack pin constraint object to XML format
  *
+ * The file is memory-mapped and tokenized in place, so that only the
+ * names of nets and pins are copied.
+ *
  * Return 0 if successful
  * Return 1 if there are serious errors when parsing data
  * Return 2 if fail when opening files
@@ -30,9 +61,9 @@ constexpr const char COMMENT = '#';
 int read_pcf(const char* fname, PcfData& pcf_data) {
   vtr::ScopedStartFinishTimer timer("Read " + std::string(fname));
 
-  /* Create a file handler */
-  std::ifstream fp(fname);
-  if (!fp.is_open()) {
+  /* Map the file to memory */
+  MappedFile file(fname);
+  if (!file.is_open()) {
     VTR_LOG_ERROR("Fail to open pcf file '%s'!", fname);
     return 2;
   }
@@ -40,32 +71,40 @@ int read_pcf(const char* fname, PcfData& pcf_data) {
   int num_err = 0;
 
   /* Get line by line */
-  std::string line;
-  while (std::getline(fp, line)) {
-    std::stringstream ss(line);
-    while (ss) {
-      std::string word;
-      /* TODO: Use command parser */
-      if (ss >> word) {
-        if (word.find("set_io") == 0) {
-          std::string net_name;
-          std::string pin_name;
-          ss >> net_name >> pin_name;
-          /* Decode data */
-          PcfIoConstraintId io_id = pcf_data.create_io_constraint();
-          pcf_data.set_io_net(io_id, net_name);
-          pcf_data.set_io_pin(io_id, pin_name);
-        } else if (word[0] == COMMENT) {  // if it's a comment
-          break;  // or ignore the full line comment and move on
-        } else {
-          /* Reach unknown command, error out */
-          VTR_LOG_ERROR("Unknown command '%s'!\n", word.c_str());
-          num_err++;
-          break;  // and move onto next line. without this, it will accept more
-                  // following values on this line
+  const char* line_begin = file.begin();
+  while (line_begin != file.end()) {
+    const char* line_end = std::find(line_begin, file.end(), '\n');
+    const char* cur = line_begin;
+    const char* word_begin = nullptr;
+    const char* word_end = nullptr;
+    /* TODO: Use command parser */
+    while (find_pcf_word(cur, line_end, word_begin, word_end)) {
+      std::string word(word_begin, word_end);
+      if (word.find("set_io") == 0) {
+        /* A missing net or pin name is left empty */
+        std::string net_name;
+        std::string pin_name;
+        if (find_pcf_word(cur, line_end, word_begin, word_end)) {
+          net_name.assign(word_begin, word_end);
+        }
+        if (find_pcf_word(cur, line_end, word_begin, word_end)) {
+          pin_name.assign(word_begin, word_end);
         }
+        /* Decode data */
+        PcfIoConstraintId io_id = pcf_data.create_io_constraint();
+        pcf_data.set_io_net(io_id, net_name);
+        pcf_data.set_io_pin(io_id, pin_name);
+      } else if (word[0] == COMMENT) {  // if it's a comment
+        break;  // or ignore the full line comment and move on
+      } else {
+        /* Reach unknown command, error out */
+        VTR_LOG_ERROR("Unknown command '%s'!\n", word.c_str());
+        num_err++;
+        break;  // and move onto next line. without this, it will accept more
+                // following values on this line
       }
     }
+    line_begin = (line_end == file.end()) ? line_end : line_end + 1;
   }
 
   if (num_err) {
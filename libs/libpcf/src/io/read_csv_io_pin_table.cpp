@@ -47,16 +47,18 @@ IoPinTable read_csv_io_pin_table(
   io_pin_table.reserve_pins(num_rows);
 
   for (int irow = 1; irow < num_rows; irow++) {
-    std::vector<std::string> row_vec = doc.GetRow<std::string>(irow);
+    /* Only the cells in use are copied, rather than the whole row */
     IoPinTableId pin_id = io_pin_table.create_pin();
     /* Fill pin-level information */
-    PortParser internal_pin_parser(row_vec.at(ROW_INDEX_INTERNAL_PIN));
+    PortParser internal_pin_parser(
+      doc.GetCell<std::string>(ROW_INDEX_INTERNAL_PIN, irow));
     io_pin_table.set_internal_pin(pin_id, internal_pin_parser.port());
 
-    PortParser external_pin_parser(row_vec.at(ROW_INDEX_EXTERNAL_PIN));
+    PortParser external_pin_parser(
+      doc.GetCell<std::string>(ROW_INDEX_EXTERNAL_PIN, irow));
     io_pin_table.set_external_pin(pin_id, external_pin_parser.port());
 
-    std::string pin_side_str = row_vec.at(ROW_INDEX_SIDE);
+    std::string pin_side_str = doc.GetCell<std::string>(ROW_INDEX_SIDE, irow);
     if (side_str_map.end() == side_str_map.find(pin_side_str)) {
       VTR_LOG(
         "Invalid side defintion (='%s')! Expect [TOP|RIGHT|LEFT|BOTTOM]\n",
@@ -84,7 +86,8 @@ IoPinTable read_csv_io_pin_table(
 
     /* Parse pin direction from a specific column, this has a higher priority
      * than inferring from pin names */
-    std::string port_dir_str = row_vec.at(ROW_INDEX_DIRECTION);
+    std::string port_dir_str =
+      doc.GetCell<std::string>(ROW_INDEX_DIRECTION, irow);
     if (port_dir_str == std::string(DIRECTION_INPUT)) {
       io_pin_table.set_pin_direction(pin_id, IoPinTable::INPUT);
     } else if (port_dir_str == std::string(DIRECTION_OUTPUT)) {
@@ -16,7 +16,7 @@ int main(int argc, const char** argv) {
 
   /* Parse the blif */
   blifparse::BlifHeadReader callback;
-  blifparse::blif_parse_filename(argv[1], callback);
+  blifparse::blif_parse_head_filename(argv[1], callback);
   VTR_LOG("Read the blif from a file: %s.\n", argv[1]);
 
   if (callback.had_error()) {
@@ -31,7 +31,7 @@ int main(int argc, const char** argv) {
   VTR_LOG("Read the design constraints from a pcf file: %s.\n", argv[1]);
 
   blifparse::BlifHeadReader callback;
-  blifparse::blif_parse_filename(argv[2], callback);
+  blifparse::blif_parse_head_filename(argv[2], callback);
   VTR_LOG("Read the blif from a file: %s.\n", argv[2]);
   if (callback.had_error()) {
     VTR_LOG("Read the blif ends with errors\n", argv[2]);
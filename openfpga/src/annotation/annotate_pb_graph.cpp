@@ -5,6 +5,10 @@
 /* Headers from vtrutil library */
 #include "annotate_pb_graph.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
 #include "check_pb_graph_annotation.h"
 #include "pb_graph_utils.h"
 #include "pb_type_utils.h"
@@ -336,63 +340,140 @@ static void annotate_primitive_pb_graph_node_unique_index(
 }
 
 /********************************************************************
- * Evaluate if the two pb_graph pins are matched by
- *  - pb_type port annotation
- *  - LSB/MSB and pin offset
+ * Group of ports in a pb_graph_node, in the order that pins are visited
  *******************************************************************/
-static bool try_match_pb_graph_pin(
-  t_pb_graph_pin* operating_pb_graph_pin, t_pb_graph_pin* physical_pb_graph_pin,
-  const VprDeviceAnnotation& vpr_device_annotation) {
-  /* If the parent ports of the two pins are not paired, fail */
-  for (t_port* candidate_port :
-       vpr_device_annotation.physical_pb_port(operating_pb_graph_pin->port)) {
-    if (physical_pb_graph_pin->port != candidate_port) {
-      /* Not the one we want, try the next candidate */
-      continue;
+enum e_pb_graph_port_group {
+  PB_GRAPH_INPUT_PORT,
+  PB_GRAPH_OUTPUT_PORT,
+  PB_GRAPH_CLOCK_PORT
+};
+
+/********************************************************************
+ * A physical port paired to an operating port, with
+ * - the location of the physical port among the pins of any
+ *   pb_graph_node of the physical pb_type
+ * - the part of the pin offset which does not change during pin pairing
+ * The pairs only depend on the pb_type ports, so they are built once for
+ * each operating port and applied to all its pb_graph_node instances
+ *******************************************************************/
+struct t_physical_pb_port_match {
+  t_port* physical_port;
+  e_pb_graph_port_group port_group;
+  int port_index;
+  int static_offset;
+};
+
+typedef std::unordered_map<t_port*, std::vector<t_physical_pb_port_match>>
+  t_physical_pb_port_match_cache;
+
+/********************************************************************
+ * Find the group and index of a port among the pins of a pb_graph_node
+ * Return false if the port has no pins in the pb_graph_node
+ *******************************************************************/
+static bool find_pb_graph_node_port_location(
+  const t_pb_graph_node* pb_graph_node, const t_port* port,
+  e_pb_graph_port_group& port_group, int& port_index) {
+  for (int iport = 0; iport < pb_graph_node->num_input_ports; ++iport) {
+    if ((0 < pb_graph_node->num_input_pins[iport]) &&
+        (port == pb_graph_node->input_pins[iport][0].port)) {
+      port_group = PB_GRAPH_INPUT_PORT;
+      port_index = iport;
+      return true;
     }
-    /* Check the pin number of physical pb_graph_pin matches the pin number of
-     * operating pb_graph_pin plus a rotation offset with an initial offset,
-     * which is to align the lsb between operating and physical ports
-     *
-     * For example:
-     *   We can align the operating_port[32] to physical_port[0] with an initial
-     * offset which is -32
-     *
-     *                                              operating port physical port
-     *                      LSB  port_range.lsb()    pin_number pin_number MSB
-     *                                 |                  | init_offset   |
-     *    Operating port     |         |                  +------         + | |
-     * |<----acc_offset--->| Physical port      |         + + +
-     *
-     * Note:
-     *   - accumulated offset is NOT the pin rotate offset specified by users
-     *     It is an aggregation of the offset during pin pairing
-     *     Each time, we manage to pair two pins, the accumulated offset will be
-     * incremented by the pin rotate offset value The accumulated offset will be
-     * reset to 0 when it exceeds the msb() of the physical port
-     */
-    int acc_offset = vpr_device_annotation.physical_pb_pin_offset(
-                       operating_pb_graph_pin->port, candidate_port) +
-                     vpr_device_annotation.physical_pb_port_offset(
-                       operating_pb_graph_pin->port, candidate_port);
-    int init_offset = vpr_device_annotation.physical_pb_pin_initial_offset(
-      operating_pb_graph_pin->port, candidate_port);
-    const BasicPort& physical_port_range =
-      vpr_device_annotation.physical_pb_port_range(operating_pb_graph_pin->port,
-                                                   candidate_port);
-    if (physical_pb_graph_pin->pin_number !=
-        operating_pb_graph_pin->pin_number +
-          (int)physical_port_range.get_lsb() + init_offset + acc_offset) {
-      /* Not the one we want, try the next candidate */
-      continue;
+  }
+  for (int iport = 0; iport < pb_graph_node->num_output_ports; ++iport) {
+    if ((0 < pb_graph_node->num_output_pins[iport]) &&
+        (port == pb_graph_node->output_pins[iport][0].port)) {
+      port_group = PB_GRAPH_OUTPUT_PORT;
+      port_index = iport;
+      return true;
     }
+  }
+  for (int iport = 0; iport < pb_graph_node->num_clock_ports; ++iport) {
+    if ((0 < pb_graph_node->num_clock_pins[iport]) &&
+        (port == pb_graph_node->clock_pins[iport][0].port)) {
+      port_group = PB_GRAPH_CLOCK_PORT;
+      port_index = iport;
+      return true;
+    }
+  }
+  return false;
+}
 
-    /* Reach here, it means all the requirements have been met */
-    return true;
+/********************************************************************
+ * Find the pin of a pb_graph_node with a given pin number in a port
+ * Return nullptr if the pin number is out of the port
+ *******************************************************************/
+static t_pb_graph_pin* find_pb_graph_node_port_pin(
+  t_pb_graph_node* pb_graph_node, const t_physical_pb_port_match& port_match,
+  const int& pin_number) {
+  t_pb_graph_pin* pins = nullptr;
+  int num_pins = 0;
+  switch (port_match.port_group) {
+    case PB_GRAPH_INPUT_PORT:
+      pins = pb_graph_node->input_pins[port_match.port_index];
+      num_pins = pb_graph_node->num_input_pins[port_match.port_index];
+      break;
+    case PB_GRAPH_OUTPUT_PORT:
+      pins = pb_graph_node->output_pins[port_match.port_index];
+      num_pins = pb_graph_node->num_output_pins[port_match.port_index];
+      break;
+    case PB_GRAPH_CLOCK_PORT:
+      pins = pb_graph_node->clock_pins[port_match.port_index];
+      num_pins = pb_graph_node->num_clock_pins[port_match.port_index];
+      break;
+    default:
+      VTR_ASSERT_MSG(false, "Invalid pb_graph port group");
+  }
+  if ((pin_number < 0) || (pin_number >= num_pins) ||
+      (pin_number != pins[pin_number].pin_number)) {
+    return nullptr;
   }
+  return &(pins[pin_number]);
+}
 
-  /* If we reach here, we failed */
-  return false;
+/********************************************************************
+ * Find the physical ports paired to an operating port by pb_type port
+ * annotation, in the order that the pins of the physical pb_graph_node
+ * are visited. Results are cached for each operating port.
+ *******************************************************************/
+static const std::vector<t_physical_pb_port_match>&
+find_physical_pb_port_matches(
+  t_port* operating_port, const t_pb_graph_node* physical_pb_graph_node,
+  const VprDeviceAnnotation& vpr_device_annotation,
+  t_physical_pb_port_match_cache& port_match_cache) {
+  auto result = port_match_cache.find(operating_port);
+  if (result != port_match_cache.end()) {
+    return result->second;
+  }
+
+  std::vector<t_physical_pb_port_match> port_matches;
+  for (t_port* candidate_port :
+       vpr_device_annotation.physical_pb_port(operating_port)) {
+    t_physical_pb_port_match port_match;
+    port_match.physical_port = candidate_port;
+    if (false == find_pb_graph_node_port_location(
+                   physical_pb_graph_node, candidate_port,
+                   port_match.port_group, port_match.port_index)) {
+      continue;
+    }
+    port_match.static_offset =
+      (int)vpr_device_annotation
+        .physical_pb_port_range(operating_port, candidate_port)
+        .get_lsb() +
+      vpr_device_annotation.physical_pb_pin_initial_offset(operating_port,
+                                                           candidate_port);
+    port_matches.push_back(port_match);
+  }
+  std::stable_sort(
+    port_matches.begin(), port_matches.end(),
+    [](const t_physical_pb_port_match& a, const t_physical_pb_port_match& b) {
+      return std::make_pair(a.port_group, a.port_index) <
+             std::make_pair(b.port_group, b.port_index);
+    });
+
+  return port_match_cache.emplace(operating_port, std::move(port_matches))
+    .first->second;
 }
 
 /********************************************************************
@@ -417,87 +498,65 @@ static void print_success_bind_pb_graph_pin(
  * Bind a pb_graph_pin from an operating pb_graph_node to
  * a pb_graph_pin from a physical pb_graph_node
  * - the name matching rules are already defined in the vpr_device_annotation
+ *
+ * For each physical port paired to the port of the operating pin, the pin
+ * number of the physical pb_graph_pin is the pin number of the operating
+ * pb_graph_pin plus a rotation offset with an initial offset, which is to
+ * align the lsb between operating and physical ports
+ *
+ * For example:
+ *   We can align the operating_port[32] to physical_port[0] with an initial
+ * offset which is -32
+ *
+ *                                              operating port physical port
+ *                      LSB  port_range.lsb()    pin_number pin_number MSB
+ *                                 |                  | init_offset   |
+ *    Operating port     |         |                  +------         + | |
+ * |<----acc_offset--->| Physical port      |         + + +
+ *
+ * Note:
+ *   - accumulated offset is NOT the pin rotate offset specified by users
+ *     It is an aggregation of the offset during pin pairing
+ *     Each time, we manage to pair two pins, the accumulated offset will be
+ * incremented by the pin rotate offset value The accumulated offset will be
+ * reset to 0 when it exceeds the msb() of the physical port
+ *   - the first physical pin in the order of input, output and clock ports
+ *     is selected when several physical ports are paired
  *******************************************************************/
 static void annotate_physical_pb_graph_pin(
   t_pb_graph_pin* operating_pb_graph_pin,
   t_pb_graph_node* physical_pb_graph_node,
-  VprDeviceAnnotation& vpr_device_annotation, const bool& verbose_output) {
-  /* Iterate over every port and pin of the operating pb_graph_node
-   * and find the physical pins
-   */
-  for (int iport = 0; iport < physical_pb_graph_node->num_input_ports;
-       ++iport) {
-    for (int ipin = 0; ipin < physical_pb_graph_node->num_input_pins[iport];
-         ++ipin) {
-      if (false == try_match_pb_graph_pin(
-                     operating_pb_graph_pin,
-                     &(physical_pb_graph_node->input_pins[iport][ipin]),
-                     vpr_device_annotation)) {
-        continue;
-      }
-      /* Reach here, it means the pins are matched by the annotation
-       * requirements We can pair the pin and return
-       */
-      vpr_device_annotation.add_physical_pb_graph_pin(
-        operating_pb_graph_pin,
-        &(physical_pb_graph_node->input_pins[iport][ipin]));
-      if (true == verbose_output) {
-        print_success_bind_pb_graph_pin(
-          operating_pb_graph_pin,
-          vpr_device_annotation.physical_pb_graph_pin(operating_pb_graph_pin));
-      }
-      return;
-    }
-  }
-
-  for (int iport = 0; iport < physical_pb_graph_node->num_output_ports;
-       ++iport) {
-    for (int ipin = 0; ipin < physical_pb_graph_node->num_output_pins[iport];
-         ++ipin) {
-      if (false == try_match_pb_graph_pin(
-                     operating_pb_graph_pin,
-                     &(physical_pb_graph_node->output_pins[iport][ipin]),
-                     vpr_device_annotation)) {
-        continue;
-      }
-      /* Reach here, it means the pins are matched by the annotation
-       * requirements We can pair the pin and return
-       */
-      vpr_device_annotation.add_physical_pb_graph_pin(
-        operating_pb_graph_pin,
-        &(physical_pb_graph_node->output_pins[iport][ipin]));
-      if (true == verbose_output) {
-        print_success_bind_pb_graph_pin(
-          operating_pb_graph_pin,
-          vpr_device_annotation.physical_pb_graph_pin(operating_pb_graph_pin));
-      }
-      return;
+  VprDeviceAnnotation& vpr_device_annotation,
+  t_physical_pb_port_match_cache& port_match_cache,
+  const bool& verbose_output) {
+  t_port* operating_port = operating_pb_graph_pin->port;
+  for (const t_physical_pb_port_match& port_match :
+       find_physical_pb_port_matches(operating_port, physical_pb_graph_node,
+                                     vpr_device_annotation,
+                                     port_match_cache)) {
+    /* The accumulated offset is updated during pin pairing */
+    int acc_offset = vpr_device_annotation.physical_pb_pin_offset(
+                       operating_port, port_match.physical_port) +
+                     vpr_device_annotation.physical_pb_port_offset(
+                       operating_port, port_match.physical_port);
+    t_pb_graph_pin* physical_pb_graph_pin = find_pb_graph_node_port_pin(
+      physical_pb_graph_node, port_match,
+      operating_pb_graph_pin->pin_number + port_match.static_offset +
+        acc_offset);
+    if (nullptr == physical_pb_graph_pin) {
+      /* Not the one we want, try the next candidate */
+      continue;
     }
-  }
-
-  for (int iport = 0; iport < physical_pb_graph_node->num_clock_ports;
-       ++iport) {
-    for (int ipin = 0; ipin < physical_pb_graph_node->num_clock_pins[iport];
-         ++ipin) {
-      if (false == try_match_pb_graph_pin(
-                     operating_pb_graph_pin,
-                     &(physical_pb_graph_node->clock_pins[iport][ipin]),
-                     vpr_device_annotation)) {
-        continue;
-      }
-      /* Reach here, it means the pins are matched by the annotation
-       * requirements We can pair the pin and return
-       */
-      vpr_device_annotation.add_physical_pb_graph_pin(
-        operating_pb_graph_pin,
-        &(physical_pb_graph_node->clock_pins[iport][ipin]));
-      if (true == verbose_output) {
-        print_success_bind_pb_graph_pin(
-          operating_pb_graph_pin,
-          vpr_device_annotation.physical_pb_graph_pin(operating_pb_graph_pin));
-      }
-      return;
+    /* Reach here, it means the pins are matched by the annotation
+     * requirements We can pair the pin and return
+     */
+    vpr_device_annotation.add_physical_pb_graph_pin(operating_pb_graph_pin,
+                                                    physical_pb_graph_pin);
+    if (true == verbose_output) {
+      print_success_bind_pb_graph_pin(operating_pb_graph_pin,
+                                      physical_pb_graph_pin);
     }
+    return;
   }
 
   /* If we reach here, it means that pin pairing fails, error out! */
@@ -516,7 +575,9 @@ static void annotate_physical_pb_graph_pin(
 static void annotate_physical_pb_graph_node_pins(
   t_pb_graph_node* operating_pb_graph_node,
   t_pb_graph_node* physical_pb_graph_node,
-  VprDeviceAnnotation& vpr_device_annotation, const bool& verbose_output) {
+  VprDeviceAnnotation& vpr_device_annotation,
+  t_physical_pb_port_match_cache& port_match_cache,
+  const bool& verbose_output) {
   /* Iterate over every port and pin of the operating pb_graph_node
    * and find the physical pins
    */
@@ -526,7 +587,8 @@ static void annotate_physical_pb_graph_node_pins(
          ++ipin) {
       annotate_physical_pb_graph_pin(
         &(operating_pb_graph_node->input_pins[iport][ipin]),
-        physical_pb_graph_node, vpr_device_annotation, verbose_output);
+        physical_pb_graph_node, vpr_device_annotation, port_match_cache,
+        verbose_output);
     }
     /* Finish a port, accumulate the port-level offset affiliated to the port */
     if (0 == operating_pb_graph_node->num_input_pins[iport]) {
@@ -547,7 +609,8 @@ static void annotate_physical_pb_graph_node_pins(
          ++ipin) {
       annotate_physical_pb_graph_pin(
         &(operating_pb_graph_node->output_pins[iport][ipin]),
-        physical_pb_graph_node, vpr_device_annotation, verbose_output);
+        physical_pb_graph_node, vpr_device_annotation, port_match_cache,
+        verbose_output);
     }
     /* Finish a port, accumulate the port-level offset affiliated to the port */
     if (0 == operating_pb_graph_node->num_output_pins[iport]) {
@@ -568,7 +631,8 @@ static void annotate_physical_pb_graph_node_pins(
          ++ipin) {
       annotate_physical_pb_graph_pin(
         &(operating_pb_graph_node->clock_pins[iport][ipin]),
-        physical_pb_graph_node, vpr_device_annotation, verbose_output);
+        physical_pb_graph_node, vpr_device_annotation, port_match_cache,
+        verbose_output);
     }
     /* Finish a port, accumulate the port-level offset affiliated to the port */
     if (0 == operating_pb_graph_node->num_clock_pins[iport]) {
@@ -594,6 +658,7 @@ static void annotate_physical_pb_graph_node_pins(
  *******************************************************************/
 static void rec_build_vpr_physical_pb_graph_node_annotation(
   t_pb_graph_node* pb_graph_node, VprDeviceAnnotation& vpr_device_annotation,
+  t_physical_pb_port_match_cache& port_match_cache,
   const bool& verbose_output) {
   /* Go recursive first until we touch the primitive node */
   if (false == is_primitive_pb_type(pb_graph_node->pb_type)) {
@@ -608,7 +673,7 @@ static void rec_build_vpr_physical_pb_graph_node_annotation(
              ++jpb) {
           rec_build_vpr_physical_pb_graph_node_annotation(
             &(pb_graph_node->child_pb_graph_nodes[imode][ipb][jpb]),
-            vpr_device_annotation, verbose_output);
+            vpr_device_annotation, port_match_cache, verbose_output);
         }
       }
     }
@@ -652,7 +717,8 @@ static void rec_build_vpr_physical_pb_graph_node_annotation(
 
   /* Try to bind each pins under this pb_graph_node to physical_pb_graph_node */
   annotate_physical_pb_graph_node_pins(pb_graph_node, physical_pb_graph_node,
-                                       vpr_device_annotation, verbose_output);
+                                       vpr_device_annotation, port_match_cache,
+                                       verbose_output);
 }
 
 /********************************************************************
@@ -663,6 +729,8 @@ static void rec_build_vpr_physical_pb_graph_node_annotation(
 static void annotate_physical_pb_graph_node(
   const DeviceContext& vpr_device_ctx,
   VprDeviceAnnotation& vpr_device_annotation, const bool& verbose_output) {
+  /* Pairs of operating and physical ports are shared by all the instances */
+  t_physical_pb_port_match_cache port_match_cache;
   for (const t_logical_block_type& lb_type :
        vpr_device_ctx.logical_block_types) {
     /* By pass nullptr for pb_graph head */
@@ -670,7 +738,8 @@ static void annotate_physical_pb_graph_node(
       continue;
     }
     rec_build_vpr_physical_pb_graph_node_annotation(
-      lb_type.pb_graph_head, vpr_device_annotation, verbose_output);
+      lb_type.pb_graph_head, vpr_device_annotation, port_match_cache,
+      verbose_output);
   }
 }
 
@@ -682,7 +751,7 @@ static void annotate_physical_pb_graph_node(
  *******************************************************************/
 void annotate_pb_graph(const DeviceContext& vpr_device_ctx,
                        VprDeviceAnnotation& vpr_device_annotation,
-                       const bool& verbose_output) {
+                       const size_t& num_threads, const bool& verbose_output) {
   VTR_LOG("Assigning unique indices for primitive pb_graph nodes...");
   VTR_LOGV(verbose_output, "\n");
   annotate_primitive_pb_graph_node_unique_index(vpr_device_ctx,
@@ -700,7 +769,8 @@ void annotate_pb_graph(const DeviceContext& vpr_device_ctx,
    * node and pin */
   check_physical_pb_graph_node_annotation(
     vpr_device_ctx,
-    const_cast<const VprDeviceAnnotation&>(vpr_device_annotation));
+    const_cast<const VprDeviceAnnotation&>(vpr_device_annotation),
+    num_threads);
 }
 
 } /* end namespace openfpga */
@@ -21,7 +21,7 @@ void annotate_pb_graph_interconnect_physical_type(
 
 void annotate_pb_graph(const DeviceContext& vpr_device_ctx,
                        VprDeviceAnnotation& vpr_pb_type_annotation,
-                       const bool& verbose_output);
+                       const size_t& num_threads, const bool& verbose_output);
 
 } /* end namespace openfpga */
 
@@ -1103,7 +1103,7 @@ static void link_vpr_pb_type_to_mode_bits_explicit_annotation(
 void annotate_pb_types(const DeviceContext& vpr_device_ctx,
                        const Arch& openfpga_arch,
                        VprDeviceAnnotation& vpr_device_annotation,
-                       const bool& verbose_output) {
+                       const size_t& num_threads, const bool& verbose_output) {
   /* Annotate physical mode to pb_type in the VPR pb_type graph */
   VTR_LOG("\n");
   VTR_LOG("Building annotation for physical modes in pb_type...");
@@ -1117,7 +1117,8 @@ void annotate_pb_types(const DeviceContext& vpr_device_ctx,
 
   check_vpr_physical_pb_mode_annotation(
     vpr_device_ctx,
-    const_cast<const VprDeviceAnnotation&>(vpr_device_annotation));
+    const_cast<const VprDeviceAnnotation&>(vpr_device_annotation),
+    num_threads);
 
   /* Annotate the physical type for each interconnect under physical modes
    * Must run AFTER physical mode annotation is done and
@@ -1149,7 +1150,8 @@ void annotate_pb_types(const DeviceContext& vpr_device_ctx,
 
   check_vpr_physical_pb_type_annotation(
     vpr_device_ctx,
-    const_cast<const VprDeviceAnnotation&>(vpr_device_annotation));
+    const_cast<const VprDeviceAnnotation&>(vpr_device_annotation),
+    num_threads);
 
   /* Link
    * - physical pb_type to circuit model
@@ -1172,7 +1174,8 @@ void annotate_pb_types(const DeviceContext& vpr_device_ctx,
 
   check_vpr_pb_type_circuit_model_annotation(
     vpr_device_ctx, openfpga_arch.circuit_lib,
-    const_cast<const VprDeviceAnnotation&>(vpr_device_annotation));
+    const_cast<const VprDeviceAnnotation&>(vpr_device_annotation),
+    num_threads);
 
   /* Link physical pb_type to mode_bits */
   VTR_LOG("\n");
@@ -1185,7 +1188,8 @@ void annotate_pb_types(const DeviceContext& vpr_device_ctx,
 
   check_vpr_pb_type_mode_bits_annotation(
     vpr_device_ctx, openfpga_arch.circuit_lib,
-    const_cast<const VprDeviceAnnotation&>(vpr_device_annotation));
+    const_cast<const VprDeviceAnnotation&>(vpr_device_annotation),
+    num_threads);
 }
 
 } /* end namespace openfpga */
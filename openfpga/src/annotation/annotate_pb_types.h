@@ -18,7 +18,7 @@ namespace openfpga {
 void annotate_pb_types(const DeviceContext& vpr_device_ctx,
                        const Arch& openfpga_arch,
                        VprDeviceAnnotation& vpr_device_annotation,
-                       const bool& verbose_output);
+                       const size_t& num_threads, const bool& verbose_output);
 
 } /* end namespace openfpga */
 
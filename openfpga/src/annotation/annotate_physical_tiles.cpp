@@ -5,6 +5,7 @@
 /* Headers from vtrutil library */
 #include "annotate_physical_tiles.h"
 
+#include "openfpga_trace.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -21,6 +22,7 @@ void build_physical_tile_pin2port_info(
   VprDeviceAnnotation& vpr_device_annotation) {
   vtr::ScopedStartFinishTimer timer(
     "Build fast look-up for physical tile pins");
+  OPENFPGA_TRACE_FUNCTION();
 
   for (const t_physical_tile_type& physical_tile :
        vpr_device_ctx.physical_tile_types) {
@@ -2,13 +2,17 @@
  * This file includes functions that are used to annotate device-level
  * information, in particular the routing resource graph
  *******************************************************************/
+#include <utility>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
 #include "openfpga_side_manager.h"
+#include "openfpga_trace.h"
 
 /* Headers from vpr library */
 #include "annotate_rr_graph.h"
@@ -405,10 +409,12 @@ static RRGSB build_rr_gsb(const DeviceContext& vpr_device_ctx,
  *******************************************************************/
 void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
                             DeviceRRGSB& device_rr_gsb,
+                            const size_t& num_threads,
                             const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer(
     "Build General Switch Block(GSB) annotation on top of routing resource "
     "graph");
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Note that the GSB array is smaller than the grids by 1 column and 1 row!!!
    */
@@ -418,29 +424,44 @@ void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
 
   VTR_LOGV(verbose_output, "Start annotation GSB up to [%lu][%lu]\n",
            gsb_range.x(), gsb_range.y());
+  VTR_LOGV(verbose_output, "Build GSBs with %lu thread(s)\n", num_threads);
 
-  size_t gsb_cnt = 0;
-  /* For each switch block, determine the size of array */
-  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+  /* Each GSB only reads the routing resource graph and the grid, so the GSBs
+   * of different columns can be built in parallel. The results are committed
+   * to the device_rr_gsb in order afterwards
+   */
+  std::vector<std::vector<RRGSB>> rr_gsbs(gsb_range.x());
+  parallel_for(gsb_range.x(), num_threads, [&](const size_t& ix) {
+    rr_gsbs[ix].reserve(gsb_range.y());
     for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
       /* Here we give the builder the fringe coordinates so that it can handle
        * the GSBs at the borderside correctly sort drive_rr_nodes should be
        * called if required by users
        */
-      const RRGSB& rr_gsb =
+      rr_gsbs[ix].push_back(
         build_rr_gsb(vpr_device_ctx,
                      vtr::Point<size_t>(vpr_device_ctx.grid.width() - 2,
                                         vpr_device_ctx.grid.height() - 2),
-                     vtr::Point<size_t>(ix, iy));
+                     vtr::Point<size_t>(ix, iy)));
+    }
+  });
 
-      /* Add to device_rr_gsb */
+  size_t gsb_cnt = 0;
+  /* For each switch block, determine the size of array */
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      RRGSB& rr_gsb = rr_gsbs[ix][iy];
+
+      /* Move to device_rr_gsb, as the built GSB is no longer used */
       vtr::Point<size_t> gsb_coordinate = rr_gsb.get_sb_coordinate();
-      device_rr_gsb.add_rr_gsb(gsb_coordinate, rr_gsb);
+      device_rr_gsb.add_rr_gsb(gsb_coordinate, std::move(rr_gsb));
       gsb_cnt++; /* Update counter */
       /* Print info */
       VTR_LOG("[%lu%] Backannotated GSB[%lu][%lu]\r",
               100 * gsb_cnt / (gsb_range.x() * gsb_range.y()), ix, iy);
     }
+    /* Release the memory of the column as soon as it is committed */
+    std::vector<RRGSB>().swap(rr_gsbs[ix]);
   }
   /* Report number of unique mirrors */
   VTR_LOG("Backannotated %d General Switch Blocks (GSBs).\n",
@@ -453,10 +474,12 @@ void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
  *******************************************************************/
 void sort_device_rr_gsb_chan_node_in_edges(const RRGraphView& rr_graph,
                                            DeviceRRGSB& device_rr_gsb,
+                                           const size_t& num_threads,
                                            const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer(
     "Sort incoming edges for each routing track output node of General Switch "
     "Block(GSB)");
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Note that the GSB array is smaller than the grids by 1 column and 1 row!!!
    */
@@ -465,24 +488,16 @@ void sort_device_rr_gsb_chan_node_in_edges(const RRGraphView& rr_graph,
   VTR_LOGV(verbose_output, "Start sorting edges for GSBs up to [%lu][%lu]\n",
            gsb_range.x(), gsb_range.y());
 
-  size_t gsb_cnt = 0;
-
-  /* For each switch block, determine the size of array */
-  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
-      vtr::Point<size_t> gsb_coordinate(ix, iy);
+  /* Sorting is local to each GSB, so the GSBs can be sorted in parallel.
+   * The sorted results of a GSB do not depend on which thread handles it */
+  VTR_LOGV(verbose_output, "Sort edges with %lu thread(s)\n", num_threads);
+  parallel_for_dynamic(
+    gsb_range.x() * gsb_range.y(), num_threads, [&](const size_t& igsb) {
+      vtr::Point<size_t> gsb_coordinate(igsb / gsb_range.y(),
+                                        igsb % gsb_range.y());
       RRGSB& rr_gsb = device_rr_gsb.get_mutable_gsb(gsb_coordinate);
       rr_gsb.sort_chan_node_in_edges(rr_graph);
-
-      gsb_cnt++; /* Update counter */
-
-      /* Print info */
-      VTR_LOG(
-        "[%lu%] Sorted incoming edges for each routing track output node of "
-        "GSB[%lu][%lu]\r",
-        100 * gsb_cnt / (gsb_range.x() * gsb_range.y()), ix, iy);
-    }
-  }
+    });
 
   /* Report number of unique mirrors */
   VTR_LOG(
@@ -497,9 +512,11 @@ void sort_device_rr_gsb_chan_node_in_edges(const RRGraphView& rr_graph,
  *******************************************************************/
 void sort_device_rr_gsb_ipin_node_in_edges(const RRGraphView& rr_graph,
                                            DeviceRRGSB& device_rr_gsb,
+                                           const size_t& num_threads,
                                            const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer(
     "Sort incoming edges for each input pin node of General Switch Block(GSB)");
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Note that the GSB array is smaller than the grids by 1 column and 1 row!!!
    */
@@ -508,24 +525,16 @@ void sort_device_rr_gsb_ipin_node_in_edges(const RRGraphView& rr_graph,
   VTR_LOGV(verbose_output, "Start sorting edges for GSBs up to [%lu][%lu]\n",
            gsb_range.x(), gsb_range.y());
 
-  size_t gsb_cnt = 0;
-
-  /* For each switch block, determine the size of array */
-  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
-      vtr::Point<size_t> gsb_coordinate(ix, iy);
+  /* Sorting is local to each GSB, so the GSBs can be sorted in parallel.
+   * The sorted results of a GSB do not depend on which thread handles it */
+  VTR_LOGV(verbose_output, "Sort edges with %lu thread(s)\n", num_threads);
+  parallel_for_dynamic(
+    gsb_range.x() * gsb_range.y(), num_threads, [&](const size_t& igsb) {
+      vtr::Point<size_t> gsb_coordinate(igsb / gsb_range.y(),
+                                        igsb % gsb_range.y());
       RRGSB& rr_gsb = device_rr_gsb.get_mutable_gsb(gsb_coordinate);
       rr_gsb.sort_ipin_node_in_edges(rr_graph);
-
-      gsb_cnt++; /* Update counter */
-
-      /* Print info */
-      VTR_LOG(
-        "[%lu%] Sorted incoming edges for each input pin node of "
-        "GSB[%lu][%lu]\r",
-        100 * gsb_cnt / (gsb_range.x() * gsb_range.y()), ix, iy);
-    }
-  }
+    });
 
   /* Report number of unique mirrors */
   VTR_LOG(
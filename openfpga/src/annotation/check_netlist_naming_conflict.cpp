@@ -3,8 +3,12 @@
  * in the users' BLIF netlist that violates the syntax of OpenFPGA
  * fabric generator, i.e., Verilog generator and SPICE generator
  *******************************************************************/
+#include <algorithm>
+#include <array>
 #include <fstream>
+#include <functional>
 #include <string>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -19,7 +23,9 @@
 
 /* Headers from openfpgautil library */
 #include "check_netlist_naming_conflict.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 
 /* Include global variables of VPR */
 #include "globals.h"
@@ -27,20 +33,92 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Lookup table of sensitive characters, indexed by the characters.
+ * An entry is the position of the character in the list of sensitive
+ * characters plus one, or zero if the character is not sensitive
+ *******************************************************************/
+typedef std::array<size_t, 256> t_sensitive_char_table;
+
+static t_sensitive_char_table build_sensitive_char_table(
+  const std::string& sensitive_chars) {
+  t_sensitive_char_table table;
+  table.fill(0);
+  for (size_t ichar = 0; ichar < sensitive_chars.length(); ++ichar) {
+    unsigned char sensitive_char = sensitive_chars[ichar];
+    if (0 == table[sensitive_char]) {
+      table[sensitive_char] = ichar + 1;
+    }
+  }
+  return table;
+}
+
+/********************************************************************
+ * Lookup table to fix characters, indexed by the characters.
+ * Each sensitive character is mapped to its fix, which is applied in the
+ * order of the sensitive characters. Other characters are kept.
+ *******************************************************************/
+typedef std::array<char, 256> t_fix_char_table;
+
+static t_fix_char_table build_fix_char_table(const std::string& sensitive_chars,
+                                             const std::string& fix_chars) {
+  VTR_ASSERT(sensitive_chars.length() == fix_chars.length());
+
+  t_fix_char_table table;
+  for (size_t ichar = 0; ichar < table.size(); ++ichar) {
+    char fixed_char = static_cast<char>(ichar);
+    for (size_t isens = 0; isens < sensitive_chars.length(); ++isens) {
+      if (fixed_char == sensitive_chars[isens]) {
+        fixed_char = fix_chars[isens];
+      }
+    }
+    table[ichar] = fixed_char;
+  }
+  return table;
+}
+
+/********************************************************************
+ * Check if a name contains any of the sensitive characters, where the
+ * name is scanned once and the scan stops at the first one found
+ *******************************************************************/
+static bool name_has_sensitive_char(
+  const std::string& name, const t_sensitive_char_table& sensitive_char_table) {
+  for (const char& name_char : name) {
+    if (0 != sensitive_char_table[static_cast<unsigned char>(name_char)]) {
+      return true;
+    }
+  }
+  return false;
+}
+
 /********************************************************************
  * This function aims to check if the name contains any of the
  * sensitive characters in the list
  * Return a string of sensitive characters which are contained
- * in the name
+ * in the name, in the order of the list
  *******************************************************************/
 static std::string name_contain_sensitive_chars(
-  const std::string& name, const std::string& sensitive_chars) {
+  const std::string& name, const std::string& sensitive_chars,
+  const t_sensitive_char_table& sensitive_char_table) {
   std::string violation;
 
-  for (const char& sensitive_char : sensitive_chars) {
-    /* Return true since we find a characters */
-    if (std::string::npos != name.find(sensitive_char)) {
-      violation.push_back(sensitive_char);
+  /* Most names are legal: scan the name once and exit early */
+  if (false == name_has_sensitive_char(name, sensitive_char_table)) {
+    return violation;
+  }
+
+  std::vector<bool> contained(sensitive_chars.length(), false);
+  for (const char& name_char : name) {
+    size_t pos = sensitive_char_table[static_cast<unsigned char>(name_char)];
+    if (0 != pos) {
+      contained[pos - 1] = true;
+    }
+  }
+
+  for (size_t ichar = 0; ichar < sensitive_chars.length(); ++ichar) {
+    /* Characters listed more than once are only reported once */
+    if (true == contained[ichar]) {
+      violation.push_back(sensitive_chars[ichar]);
     }
   }
 
@@ -53,23 +131,81 @@ static std::string name_contain_sensitive_chars(
  * Return a string the fixed name
  *******************************************************************/
 static std::string fix_name_contain_sensitive_chars(
-  const std::string& name, const std::string& sensitive_chars,
-  const std::string& fix_chars) {
+  const std::string& name, const t_fix_char_table& fix_char_table) {
   std::string fixed_name = name;
 
-  VTR_ASSERT(sensitive_chars.length() == fix_chars.length());
+  for (char& name_char : fixed_name) {
+    name_char = fix_char_table[static_cast<unsigned char>(name_char)];
+  }
 
-  for (size_t ichar = 0; ichar < sensitive_chars.length(); ++ichar) {
-    /* Keep fixing the characters until we cannot find anymore */
-    std::string::size_type pos = 0u;
-    while (std::string::npos !=
-           (pos = fixed_name.find(sensitive_chars[ichar], pos))) {
-      fixed_name.replace(pos, 1, std::string(1, fix_chars[ichar]));
-      pos += 1;
+  return fixed_name;
+}
+
+/********************************************************************
+ * Find the ids whose names contain any sensitive character, in the
+ * sequence of the ids. Names are checked in parallel by chunks of
+ * ids, where each chunk collects its own ids, and the chunks are then
+ * joined in sequence, so that the result does not depend on the number
+ * of threads. As most names are legal, only a few ids are collected,
+ * and they are reported or fixed afterwards by the caller
+ *******************************************************************/
+template <class T>
+static std::vector<T> find_ids_with_sensitive_chars(
+  const std::vector<T>& ids,
+  const std::function<const std::string&(const T&)>& id_name,
+  const t_sensitive_char_table& sensitive_char_table,
+  const size_t& num_threads) {
+  constexpr size_t CHUNK_SIZE = 4096;
+  size_t num_chunks = (ids.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+  std::vector<std::vector<T>> chunk_ids(num_chunks);
+  parallel_for(num_chunks, num_threads, [&](const size_t& ichunk) {
+    size_t end = std::min(ids.size(), (ichunk + 1) * CHUNK_SIZE);
+    for (size_t iid = ichunk * CHUNK_SIZE; iid < end; ++iid) {
+      if (true ==
+          name_has_sensitive_char(id_name(ids[iid]), sensitive_char_table)) {
+        chunk_ids[ichunk].push_back(ids[iid]);
+      }
     }
+  });
+
+  std::vector<T> found_ids;
+  for (const std::vector<T>& chunk : chunk_ids) {
+    found_ids.insert(found_ids.end(), chunk.begin(), chunk.end());
   }
+  return found_ids;
+}
 
-  return fixed_name;
+/********************************************************************
+ * Find the blocks and the nets of a netlist whose names contain any
+ * sensitive character, in the sequence of their ids
+ *******************************************************************/
+static std::vector<AtomBlockId> find_blocks_with_sensitive_chars(
+  const AtomNetlist& atom_netlist,
+  const t_sensitive_char_table& sensitive_char_table,
+  const size_t& num_threads) {
+  std::vector<AtomBlockId> blocks(atom_netlist.blocks().begin(),
+                                  atom_netlist.blocks().end());
+  return find_ids_with_sensitive_chars<AtomBlockId>(
+    blocks,
+    [&](const AtomBlockId& block) -> const std::string& {
+      return atom_netlist.block_name(block);
+    },
+    sensitive_char_table, num_threads);
+}
+
+static std::vector<AtomNetId> find_nets_with_sensitive_chars(
+  const AtomNetlist& atom_netlist,
+  const t_sensitive_char_table& sensitive_char_table,
+  const size_t& num_threads) {
+  std::vector<AtomNetId> nets(atom_netlist.nets().begin(),
+                              atom_netlist.nets().end());
+  return find_ids_with_sensitive_chars<AtomNetId>(
+    nets,
+    [&](const AtomNetId& net) -> const std::string& {
+      return atom_netlist.net_name(net);
+    },
+    sensitive_char_table, num_threads);
 }
 
 /********************************************************************
@@ -79,33 +215,37 @@ static std::string fix_name_contain_sensitive_chars(
  *   any sensitive character
  * - Iterate over all the nets and see if any net name contain
  *   any sensitive character
+ * Each name is scanned once against a lookup table of the sensitive
+ * characters
  *******************************************************************/
 size_t detect_netlist_naming_conflict(const AtomNetlist& atom_netlist,
-                                      const std::string& sensitive_chars) {
+                                      const std::string& sensitive_chars,
+                                      const size_t& num_threads) {
   size_t num_conflicts = 0;
 
-  /* Walk through blocks in the netlist */
-  for (const auto& block : atom_netlist.blocks()) {
+  const t_sensitive_char_table& sensitive_char_table =
+    build_sensitive_char_table(sensitive_chars);
+
+  /* Report the blocks in the netlist with illegal names */
+  for (const AtomBlockId& block : find_blocks_with_sensitive_chars(
+         atom_netlist, sensitive_char_table, num_threads)) {
     const std::string& block_name = atom_netlist.block_name(block);
-    const std::string& violation =
-      name_contain_sensitive_chars(block_name, sensitive_chars);
-    if (false == violation.empty()) {
-      VTR_LOG("Block '%s' contains illegal characters '%s'\n",
-              block_name.c_str(), violation.c_str());
-      num_conflicts++;
-    }
+    const std::string& violation = name_contain_sensitive_chars(
+      block_name, sensitive_chars, sensitive_char_table);
+    VTR_LOG("Block '%s' contains illegal characters '%s'\n",
+            block_name.c_str(), violation.c_str());
+    num_conflicts++;
   }
 
-  /* Walk through nets in the netlist */
-  for (const auto& net : atom_netlist.nets()) {
+  /* Report the nets in the netlist with illegal names */
+  for (const AtomNetId& net : find_nets_with_sensitive_chars(
+         atom_netlist, sensitive_char_table, num_threads)) {
     const std::string& net_name = atom_netlist.net_name(net);
-    const std::string& violation =
-      name_contain_sensitive_chars(net_name, sensitive_chars);
-    if (false == violation.empty()) {
-      VTR_LOG("Net '%s' contains illegal characters '%s'\n", net_name.c_str(),
-              violation.c_str());
-      num_conflicts++;
-    }
+    const std::string& violation = name_contain_sensitive_chars(
+      net_name, sensitive_chars, sensitive_char_table);
+    VTR_LOG("Net '%s' contains illegal characters '%s'\n", net_name.c_str(),
+            violation.c_str());
+    num_conflicts++;
   }
 
   return num_conflicts;
@@ -122,36 +262,33 @@ size_t detect_netlist_naming_conflict(const AtomNetlist& atom_netlist,
 void fix_netlist_naming_conflict(const AtomNetlist& atom_netlist,
                                  const std::string& sensitive_chars,
                                  const std::string& fix_chars,
-                                 VprNetlistAnnotation& vpr_netlist_annotation) {
+                                 VprNetlistAnnotation& vpr_netlist_annotation,
+                                 const size_t& num_threads) {
   size_t num_fixes = 0;
 
-  /* Walk through blocks in the netlist */
-  for (const auto& block : atom_netlist.blocks()) {
-    const std::string& block_name = atom_netlist.block_name(block);
-    const std::string& violation =
-      name_contain_sensitive_chars(block_name, sensitive_chars);
-
-    if (false == violation.empty()) {
-      /* Apply fix-up here */
-      vpr_netlist_annotation.rename_block(
-        block, fix_name_contain_sensitive_chars(block_name, sensitive_chars,
-                                                fix_chars));
-      num_fixes++;
-    }
+  const t_sensitive_char_table& sensitive_char_table =
+    build_sensitive_char_table(sensitive_chars);
+  const t_fix_char_table& fix_char_table =
+    build_fix_char_table(sensitive_chars, fix_chars);
+
+  /* The names are checked in parallel, while the annotation is only
+   * updated in sequence */
+  for (const AtomBlockId& block : find_blocks_with_sensitive_chars(
+         atom_netlist, sensitive_char_table, num_threads)) {
+    /* Apply fix-up here */
+    vpr_netlist_annotation.rename_block(
+      block, fix_name_contain_sensitive_chars(atom_netlist.block_name(block),
+                                              fix_char_table));
+    num_fixes++;
   }
 
-  /* Walk through nets in the netlist */
-  for (const auto& net : atom_netlist.nets()) {
-    const std::string& net_name = atom_netlist.net_name(net);
-    const std::string& violation =
-      name_contain_sensitive_chars(net_name, sensitive_chars);
-    if (false == violation.empty()) {
-      /* Apply fix-up here */
-      vpr_netlist_annotation.rename_net(
-        net,
-        fix_name_contain_sensitive_chars(net_name, sensitive_chars, fix_chars));
-      num_fixes++;
-    }
+  for (const AtomNetId& net : find_nets_with_sensitive_chars(
+         atom_netlist, sensitive_char_table, num_threads)) {
+    /* Apply fix-up here */
+    vpr_netlist_annotation.rename_net(
+      net, fix_name_contain_sensitive_chars(atom_netlist.net_name(net),
+                                            fix_char_table));
+    num_fixes++;
   }
 
   if (0 < num_fixes) {
@@ -167,7 +304,7 @@ void print_netlist_naming_fix_report(
   const std::string& fname, const AtomNetlist& atom_netlist,
   const VprNetlistAnnotation& vpr_netlist_annotation) {
   /* Create a file handler */
-  std::fstream fp;
+  BufferedFileStream fp;
   /* Open the file stream */
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
@@ -19,12 +19,14 @@
 namespace openfpga {
 
 size_t detect_netlist_naming_conflict(const AtomNetlist& atom_netlist,
-                                      const std::string& sensitive_chars);
+                                      const std::string& sensitive_chars,
+                                      const size_t& num_threads = 1);
 
 void fix_netlist_naming_conflict(const AtomNetlist& atom_netlist,
                                  const std::string& sensitive_chars,
                                  const std::string& fix_chars,
-                                 VprNetlistAnnotation& vpr_netlist_annotation);
+                                 VprNetlistAnnotation& vpr_netlist_annotation,
+                                 const size_t& num_threads = 1);
 
 void print_netlist_naming_fix_report(
   const std::string& fname, const AtomNetlist& atom_netlist,
@@ -8,6 +8,8 @@
 #include "command.h"
 #include "command_context.h"
 #include "command_exit_codes.h"
+#include "openfpga_parallel.h"
+#include "openfpga_trace.h"
 #include "vtr_time.h"
 
 /********************************************************************
@@ -28,18 +30,28 @@ int check_netlist_naming_conflict_template(T& openfpga_context,
                                            const CommandContext& cmd_context) {
   vtr::ScopedStartFinishTimer timer(
     "Check naming violations of netlist blocks and nets");
+  OPENFPGA_TRACE_FUNCTION();
 
   /* By default, we replace all the illegal characters with '_' */
   std::string sensitive_chars(".,:;\'\"+-<>()[]{}!@#$%^&*~`?/");
   std::string fix_chars("____________________________");
 
   CommandOptionId opt_fix = cmd.option("fix");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
+
+  /* Use the number of threads of the shell by default */
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
 
   /* Do the main job first: detect any naming in the BLIF netlist that violates
    * the syntax */
   if (false == cmd_context.option_enable(cmd, opt_fix)) {
     size_t num_conflicts =
-      detect_netlist_naming_conflict(g_vpr_ctx.atom().nlist, sensitive_chars);
+      detect_netlist_naming_conflict(g_vpr_ctx.atom().nlist, sensitive_chars,
+                                     find_num_threads(num_threads));
     VTR_LOGV_ERROR(
       (0 < num_conflicts && (false == cmd_context.option_enable(cmd, opt_fix))),
       "Found %ld naming conflicts in the netlist. Please correct so as to use "
@@ -62,7 +74,8 @@ int check_netlist_naming_conflict_template(T& openfpga_context,
   if (true == cmd_context.option_enable(cmd, opt_fix)) {
     fix_netlist_naming_conflict(
       g_vpr_ctx.atom().nlist, sensitive_chars, fix_chars,
-      openfpga_context.mutable_vpr_netlist_annotation());
+      openfpga_context.mutable_vpr_netlist_annotation(),
+      find_num_threads(num_threads));
 
     CommandOptionId opt_report = cmd.option("report");
     if (true == cmd_context.option_enable(cmd, opt_report)) {
@@ -5,6 +5,10 @@
 /* Headers from vtrutil library */
 #include "check_pb_graph_annotation.h"
 
+#include <numeric>
+#include <vector>
+
+#include "openfpga_parallel.h"
 #include "pb_type_utils.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -120,18 +124,23 @@ static void rec_check_vpr_physical_pb_graph_node_annotation(
  *******************************************************************/
 void check_physical_pb_graph_node_annotation(
   const DeviceContext& vpr_device_ctx,
-  const VprDeviceAnnotation& vpr_device_annotation) {
-  size_t num_err = 0;
-
-  for (const t_logical_block_type& lb_type :
-       vpr_device_ctx.logical_block_types) {
+  const VprDeviceAnnotation& vpr_device_annotation,
+  const size_t& num_threads) {
+  const std::vector<t_logical_block_type>& lb_types =
+    vpr_device_ctx.logical_block_types;
+  /* Logical block types are checked independently, each with its own
+   * error counter */
+  std::vector<size_t> num_errs(lb_types.size(), 0);
+  parallel_for_dynamic(lb_types.size(), num_threads, [&](const size_t& itype) {
     /* By pass nullptr for pb_graph head */
-    if (nullptr == lb_type.pb_graph_head) {
-      continue;
+    if (nullptr == lb_types[itype].pb_graph_head) {
+      return;
     }
     rec_check_vpr_physical_pb_graph_node_annotation(
-      lb_type.pb_graph_head, vpr_device_annotation, num_err);
-  }
+      lb_types[itype].pb_graph_head, vpr_device_annotation,
+      num_errs[itype]);
+  });
+  size_t num_err = std::accumulate(num_errs.begin(), num_errs.end(), size_t(0));
 
   if (0 == num_err) {
     VTR_LOG("Check pb_graph annotation for physical nodes and pins passed.\n");
@@ -17,7 +17,8 @@ namespace openfpga {
 
 void check_physical_pb_graph_node_annotation(
   const DeviceContext& vpr_device_ctx,
-  const VprDeviceAnnotation& vpr_device_annotation);
+  const VprDeviceAnnotation& vpr_device_annotation,
+  const size_t& num_threads);
 
 } /* end namespace openfpga */
 
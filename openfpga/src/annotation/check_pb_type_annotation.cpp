@@ -5,7 +5,11 @@
 /* Headers from vtrutil library */
 #include "check_pb_type_annotation.h"
 
+#include <numeric>
+#include <vector>
+
 #include "circuit_library_utils.h"
+#include "openfpga_parallel.h"
 #include "pb_type_utils.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -80,19 +84,24 @@ static void rec_check_vpr_physical_pb_mode_annotation(
  *******************************************************************/
 void check_vpr_physical_pb_mode_annotation(
   const DeviceContext& vpr_device_ctx,
-  const VprDeviceAnnotation& vpr_device_annotation) {
-  size_t num_err = 0;
-
-  for (const t_logical_block_type& lb_type :
-       vpr_device_ctx.logical_block_types) {
+  const VprDeviceAnnotation& vpr_device_annotation,
+  const size_t& num_threads) {
+  const std::vector<t_logical_block_type>& lb_types =
+    vpr_device_ctx.logical_block_types;
+  /* Logical block types are checked independently, each with its own
+   * error counter */
+  std::vector<size_t> num_errs(lb_types.size(), 0);
+  parallel_for_dynamic(lb_types.size(), num_threads, [&](const size_t& itype) {
     /* By pass nullptr for pb_type head */
-    if (nullptr == lb_type.pb_type) {
-      continue;
+    if (nullptr == lb_types[itype].pb_type) {
+      return;
     }
     /* Top pb_type should always has a physical mode! */
-    rec_check_vpr_physical_pb_mode_annotation(lb_type.pb_type, true,
-                                              vpr_device_annotation, num_err);
-  }
+    rec_check_vpr_physical_pb_mode_annotation(
+      lb_types[itype].pb_type, true, vpr_device_annotation,
+      num_errs[itype]);
+  });
+  size_t num_err = std::accumulate(num_errs.begin(), num_errs.end(), size_t(0));
   if (0 == num_err) {
     VTR_LOG("Check physical mode annotation for pb_types passed.\n");
   } else {
@@ -169,19 +178,23 @@ static void rec_check_vpr_physical_pb_type_annotation(
  *******************************************************************/
 void check_vpr_physical_pb_type_annotation(
   const DeviceContext& vpr_device_ctx,
-  const VprDeviceAnnotation& vpr_device_annotation) {
-  size_t num_err = 0;
-
-  for (const t_logical_block_type& lb_type :
-       vpr_device_ctx.logical_block_types) {
+  const VprDeviceAnnotation& vpr_device_annotation,
+  const size_t& num_threads) {
+  const std::vector<t_logical_block_type>& lb_types =
+    vpr_device_ctx.logical_block_types;
+  /* Logical block types are checked independently, each with its own
+   * error counter */
+  std::vector<size_t> num_errs(lb_types.size(), 0);
+  parallel_for_dynamic(lb_types.size(), num_threads, [&](const size_t& itype) {
     /* By pass nullptr for pb_type head */
-    if (nullptr == lb_type.pb_type) {
-      continue;
+    if (nullptr == lb_types[itype].pb_type) {
+      return;
     }
     /* Top pb_type should always has a physical mode! */
-    rec_check_vpr_physical_pb_type_annotation(lb_type.pb_type,
-                                              vpr_device_annotation, num_err);
-  }
+    rec_check_vpr_physical_pb_type_annotation(
+      lb_types[itype].pb_type, vpr_device_annotation, num_errs[itype]);
+  });
+  size_t num_err = std::accumulate(num_errs.begin(), num_errs.end(), size_t(0));
   if (0 == num_err) {
     VTR_LOG("Check physical pb_type annotation for pb_types passed.\n");
   } else {
@@ -281,19 +294,24 @@ static void rec_check_vpr_pb_type_circuit_model_annotation(
  *******************************************************************/
 void check_vpr_pb_type_circuit_model_annotation(
   const DeviceContext& vpr_device_ctx, const CircuitLibrary& circuit_lib,
-  const VprDeviceAnnotation& vpr_device_annotation) {
-  size_t num_err = 0;
-
-  for (const t_logical_block_type& lb_type :
-       vpr_device_ctx.logical_block_types) {
+  const VprDeviceAnnotation& vpr_device_annotation,
+  const size_t& num_threads) {
+  const std::vector<t_logical_block_type>& lb_types =
+    vpr_device_ctx.logical_block_types;
+  /* Logical block types are checked independently, each with its own
+   * error counter */
+  std::vector<size_t> num_errs(lb_types.size(), 0);
+  parallel_for_dynamic(lb_types.size(), num_threads, [&](const size_t& itype) {
     /* By pass nullptr for pb_type head */
-    if (nullptr == lb_type.pb_type) {
-      continue;
+    if (nullptr == lb_types[itype].pb_type) {
+      return;
     }
     /* Top pb_type should always has a physical mode! */
     rec_check_vpr_pb_type_circuit_model_annotation(
-      lb_type.pb_type, circuit_lib, vpr_device_annotation, num_err);
-  }
+      lb_types[itype].pb_type, circuit_lib, vpr_device_annotation,
+      num_errs[itype]);
+  });
+  size_t num_err = std::accumulate(num_errs.begin(), num_errs.end(), size_t(0));
   if (0 == num_err) {
     VTR_LOG("Check physical pb_type annotation for circuit model passed.\n");
   } else {
@@ -406,19 +424,24 @@ static void rec_check_vpr_pb_type_mode_bits_annotation(
  *******************************************************************/
 void check_vpr_pb_type_mode_bits_annotation(
   const DeviceContext& vpr_device_ctx, const CircuitLibrary& circuit_lib,
-  const VprDeviceAnnotation& vpr_device_annotation) {
-  size_t num_err = 0;
-
-  for (const t_logical_block_type& lb_type :
-       vpr_device_ctx.logical_block_types) {
+  const VprDeviceAnnotation& vpr_device_annotation,
+  const size_t& num_threads) {
+  const std::vector<t_logical_block_type>& lb_types =
+    vpr_device_ctx.logical_block_types;
+  /* Logical block types are checked independently, each with its own
+   * error counter */
+  std::vector<size_t> num_errs(lb_types.size(), 0);
+  parallel_for_dynamic(lb_types.size(), num_threads, [&](const size_t& itype) {
     /* By pass nullptr for pb_type head */
-    if (nullptr == lb_type.pb_type) {
-      continue;
+    if (nullptr == lb_types[itype].pb_type) {
+      return;
     }
     /* Top pb_type should always has a physical mode! */
-    rec_check_vpr_pb_type_mode_bits_annotation(lb_type.pb_type, circuit_lib,
-                                               vpr_device_annotation, num_err);
-  }
+    rec_check_vpr_pb_type_mode_bits_annotation(
+      lb_types[itype].pb_type, circuit_lib, vpr_device_annotation,
+      num_errs[itype]);
+  });
+  size_t num_err = std::accumulate(num_errs.begin(), num_errs.end(), size_t(0));
   if (0 == num_err) {
     VTR_LOG("Check pb_type annotation for mode selection bits passed.\n");
   } else {
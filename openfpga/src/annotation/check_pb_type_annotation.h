@@ -17,19 +17,23 @@ namespace openfpga {
 
 void check_vpr_physical_pb_mode_annotation(
   const DeviceContext& vpr_device_ctx,
-  const VprDeviceAnnotation& vpr_device_annotation);
+  const VprDeviceAnnotation& vpr_device_annotation,
+  const size_t& num_threads);
 
 void check_vpr_physical_pb_type_annotation(
   const DeviceContext& vpr_device_ctx,
-  const VprDeviceAnnotation& vpr_device_annotation);
+  const VprDeviceAnnotation& vpr_device_annotation,
+  const size_t& num_threads);
 
 void check_vpr_pb_type_circuit_model_annotation(
   const DeviceContext& vpr_device_ctx, const CircuitLibrary& circuit_lib,
-  const VprDeviceAnnotation& vpr_device_annotation);
+  const VprDeviceAnnotation& vpr_device_annotation,
+  const size_t& num_threads);
 
 void check_vpr_pb_type_mode_bits_annotation(
   const DeviceContext& vpr_device_ctx, const CircuitLibrary& circuit_lib,
-  const VprDeviceAnnotation& vpr_device_annotation);
+  const VprDeviceAnnotation& vpr_device_annotation,
+  const size_t& num_threads);
 
 } /* end namespace openfpga */
 
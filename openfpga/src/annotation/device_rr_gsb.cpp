@@ -3,6 +3,15 @@
  ***********************************************************************/
 #include "device_rr_gsb.h"
 
+#include <algorithm>
+#include <array>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+#include "openfpga_memory_usage.h"
+#include "openfpga_parallel.h"
+#include "openfpga_side_manager.h"
 #include "rr_gsb_utils.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -155,6 +164,97 @@ const RRGSB& DeviceRRGSB::get_sb_unique_module(
   return get_sb_unique_module(sb_unique_module_id);
 }
 
+/* Get the index of the unique mirror of a GSB at a given coordinate */
+size_t DeviceRRGSB::get_gsb_unique_module_index(
+  const vtr::Point<size_t>& coordinate) const {
+  VTR_ASSERT(validate_coordinate(coordinate));
+  return gsb_unique_module_id_[coordinate.x()][coordinate.y()];
+}
+
+/* Get the index of the unique mirror of a switch block at a given coordinate */
+size_t DeviceRRGSB::get_sb_unique_module_index(
+  const vtr::Point<size_t>& coordinate) const {
+  VTR_ASSERT(validate_coordinate(coordinate));
+  return sb_unique_module_id_[coordinate.x()][coordinate.y()];
+}
+
+/* Get the index of the unique mirror of a connection block at a given
+ * coordinate */
+size_t DeviceRRGSB::get_cb_unique_module_index(
+  const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate) const {
+  VTR_ASSERT(validate_cb_type(cb_type));
+  VTR_ASSERT(validate_coordinate(coordinate));
+  switch (cb_type) {
+    case CHANX:
+      return cbx_unique_module_id_[coordinate.x()][coordinate.y()];
+    case CHANY:
+      return cby_unique_module_id_[coordinate.x()][coordinate.y()];
+    default:
+      VTR_LOG_ERROR("Invalid type of connection block!\n");
+      exit(1);
+  }
+}
+
+/* Estimate the memory used by the GSB array, in bytes
+ * The RRGSB objects are estimated from their number of nodes: each node
+ * costs a node id, a direction or a grid side, a segment id and an
+ * in-edge list. The in-edges themselves are not counted.
+ */
+size_t DeviceRRGSB::memory_usage() const {
+  size_t num_bytes = sizeof(DeviceRRGSB) + heap_memory_usage(rr_gsb_);
+  for (const auto& rr_gsb_col : rr_gsb_) {
+    for (const RRGSB& rr_gsb : rr_gsb_col) {
+      for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+        SideManager side_manager(side);
+        e_side side_type = side_manager.get_side();
+        num_bytes += rr_gsb.get_chan_width(side_type) *
+                     (sizeof(RRNodeId) + sizeof(RRSegmentId) + sizeof(PORTS) +
+                      sizeof(std::vector<RREdgeId>));
+        num_bytes += rr_gsb.get_num_ipin_nodes(side_type) *
+                     (sizeof(RRNodeId) + sizeof(e_side) +
+                      sizeof(std::vector<RREdgeId>));
+        num_bytes += rr_gsb.get_num_opin_nodes(side_type) *
+                     (sizeof(RRNodeId) + sizeof(e_side));
+      }
+    }
+  }
+  num_bytes += heap_memory_usage(gsb_unique_module_id_) +
+               heap_memory_usage(gsb_unique_module_) +
+               heap_memory_usage(sb_unique_module_id_) +
+               heap_memory_usage(sb_unique_module_) +
+               heap_memory_usage(cbx_unique_module_id_) +
+               heap_memory_usage(cbx_unique_module_) +
+               heap_memory_usage(cby_unique_module_id_) +
+               heap_memory_usage(cby_unique_module_) +
+               heap_memory_usage(sb_rotatable_module_) +
+               heap_memory_usage(sb_unique_module_rotatable_id_) +
+               heap_memory_usage(sb_unique_module_side_map_);
+  return num_bytes;
+}
+
+/* get the number of rotatable switch blocks */
+size_t DeviceRRGSB::get_num_sb_rotatable_module() const {
+  return sb_rotatable_module_.size();
+}
+
+/* Get the unique switch block representing a rotatable switch block */
+const RRGSB& DeviceRRGSB::get_sb_rotatable_module(const size_t& index) const {
+  VTR_ASSERT(validate_sb_rotatable_module_index(index));
+  return get_sb_unique_module(sb_rotatable_module_[index]);
+}
+
+size_t DeviceRRGSB::get_sb_rotatable_module_index(
+  const size_t& unique_index) const {
+  VTR_ASSERT(unique_index < sb_unique_module_rotatable_id_.size());
+  return sb_unique_module_rotatable_id_[unique_index];
+}
+
+const t_rr_gsb_side_map& DeviceRRGSB::get_sb_rotatable_module_side_map(
+  const size_t& unique_index) const {
+  VTR_ASSERT(unique_index < sb_unique_module_side_map_.size());
+  return sb_unique_module_side_map_[unique_index];
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
@@ -213,6 +313,15 @@ void DeviceRRGSB::add_rr_gsb(const vtr::Point<size_t>& coordinate,
   rr_gsb_[coordinate.x()][coordinate.y()] = rr_gsb;
 }
 
+void DeviceRRGSB::add_rr_gsb(const vtr::Point<size_t>& coordinate,
+                             RRGSB&& rr_gsb) {
+  /* Resize upon needs*/
+  resize_upon_need(coordinate);
+
+  /* The nodes of the switch block are taken over rather than copied */
+  rr_gsb_[coordinate.x()][coordinate.y()] = std::move(rr_gsb);
+}
+
 /* Get a rr switch block in the array with a coordinate */
 RRGSB& DeviceRRGSB::get_mutable_gsb(const vtr::Point<size_t>& coordinate) {
   VTR_ASSERT(validate_coordinate(coordinate));
@@ -225,82 +334,282 @@ RRGSB& DeviceRRGSB::get_mutable_gsb(const size_t& x, const size_t& y) {
   return get_mutable_gsb(coordinate);
 }
 
+/* Check if the hashes of the parts of a candidate match those of a unique
+ * module, where a part whose hash is 0 matches any part */
+static bool is_part_hash_match(const std::vector<size_t>& cand_hashes,
+                               const std::vector<size_t>& unique_hashes) {
+  if (cand_hashes.size() != unique_hashes.size()) {
+    return false;
+  }
+  for (size_t ipart = 0; ipart < cand_hashes.size(); ++ipart) {
+    if ((0 != cand_hashes[ipart]) &&
+        (cand_hashes[ipart] != unique_hashes[ipart])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Find the unique modules among a list of candidate GSBs.
+ * For each candidate, return the index (in the candidate list) of the first
+ * candidate which it is a mirror of. A candidate is a unique module when it is
+ * its own representative.
+ *
+ * The hasher splits a candidate into parts, e.g., the sides of a switch block,
+ * and hashes each part, in the same way as the mirror check compares them
+ * when the candidate is the base: a candidate is a mirror of another one only
+ * when each part has the same hash as the part of the other one. A part whose
+ * hash is 0 is not compared and matches any part, while a part which is
+ * compared only matches a part which is compared.
+ *
+ * The result is the same as comparing each candidate against all the unique
+ * modules found so far in the order of the list:
+ * - Candidates whose parts are all compared are bucketed by their hashes, so
+ *   that the full mirror check is only required within a bucket. Such a
+ *   candidate can only be a mirror of another one in the same bucket.
+ * - Inside a bucket, candidates are visited in their original order, so the
+ *   first mirror is always found
+ * - Buckets are independent from each other and can be processed in parallel.
+ *   The mirror checks inside a large bucket are also run in parallel
+ * - The other candidates, e.g., the switch blocks on the borders of the
+ *   fabric, are few. They are visited in their original order at last, and
+ *   compared against all the unique modules before them whose hashes match
+ */
+std::vector<size_t> DeviceRRGSB::find_unique_module_representatives(
+  const std::vector<vtr::Point<size_t>>& candidates,
+  const std::function<std::vector<size_t>(const RRGSB&)>& hasher,
+  const std::function<bool(const RRGSB&, const RRGSB&)>& is_mirror,
+  const size_t& num_threads) const {
+  /* Hash values are independent from each other */
+  std::vector<std::vector<size_t>> hashes(candidates.size());
+  parallel_for(candidates.size(), num_threads, [&](const size_t& icand) {
+    hashes[icand] =
+      hasher(rr_gsb_[candidates[icand].x()][candidates[icand].y()]);
+  });
+
+  /* Group the candidates by hash values, in the order of first appearance */
+  std::vector<std::vector<size_t>> buckets;
+  std::map<std::vector<size_t>, size_t> bucket_lookup;
+  std::vector<bool> partial(candidates.size(), false);
+  for (size_t icand = 0; icand < candidates.size(); ++icand) {
+    if (hashes[icand].end() !=
+        std::find(hashes[icand].begin(), hashes[icand].end(), 0)) {
+      partial[icand] = true;
+      continue;
+    }
+    auto result = bucket_lookup.find(hashes[icand]);
+    if (result == bucket_lookup.end()) {
+      bucket_lookup[hashes[icand]] = buckets.size();
+      buckets.push_back(std::vector<size_t>(1, icand));
+    } else {
+      buckets[result->second].push_back(icand);
+    }
+  }
+
+  std::vector<size_t> representatives(candidates.size());
+  /* Traverse a range of the unique_mirror list and find the first one which a
+   * candidate is a mirror of, or the candidate itself if none */
+  auto find_first_mirror = [&](const size_t& icand,
+                               std::vector<size_t>::const_iterator begin,
+                               std::vector<size_t>::const_iterator end) {
+    const RRGSB& cand = rr_gsb_[candidates[icand].x()][candidates[icand].y()];
+    for (auto iunique = begin; iunique != end; ++iunique) {
+      const RRGSB& unique_module =
+        rr_gsb_[candidates[*iunique].x()][candidates[*iunique].y()];
+      if (true == is_mirror(cand, unique_module)) {
+        return *iunique;
+      }
+    }
+    return icand;
+  };
+  /* The candidates of a bucket are visited by blocks. The candidates of a
+   * block are compared against the unique modules found before the block in
+   * parallel. Afterwards, the candidates without any mirror are compared in
+   * order against the unique modules found inside the block, which are few
+   * as most candidates of a bucket are mirrors. With a single thread, the
+   * block is the whole bucket */
+  auto find_bucket_representatives = [&](const std::vector<size_t>& bucket,
+                                         const size_t& bucket_num_threads) {
+    std::vector<size_t> unique_candidates;
+    size_t block_size =
+      (1 < bucket_num_threads) ? 64 * bucket_num_threads : bucket.size();
+    for (size_t block_begin = 0; block_begin < bucket.size();
+         block_begin += block_size) {
+      size_t block_end = std::min(bucket.size(), block_begin + block_size);
+      size_t num_known_uniques = unique_candidates.size();
+      parallel_for(block_end - block_begin, bucket_num_threads,
+                   [&](const size_t& ioffset) {
+                     size_t icand = bucket[block_begin + ioffset];
+                     representatives[icand] = find_first_mirror(
+                       icand, unique_candidates.begin(),
+                       unique_candidates.begin() + num_known_uniques);
+                   });
+      for (size_t ipos = block_begin; ipos < block_end; ++ipos) {
+        size_t icand = bucket[ipos];
+        if (icand != representatives[icand]) {
+          continue;
+        }
+        representatives[icand] = find_first_mirror(
+          icand, unique_candidates.begin() + num_known_uniques,
+          unique_candidates.end());
+        if (icand == representatives[icand]) {
+          unique_candidates.push_back(icand);
+        }
+      }
+    }
+  };
+
+  /* A bucket which holds more than an even share of candidates per thread,
+   * e.g., the core tiles of a uniform fabric, is compared in parallel on its
+   * own. The other buckets are processed in parallel, each on a thread */
+  std::vector<size_t> small_buckets;
+  for (size_t ibkt = 0; ibkt < buckets.size(); ++ibkt) {
+    if ((1 < num_threads) &&
+        (buckets[ibkt].size() * num_threads > candidates.size())) {
+      find_bucket_representatives(buckets[ibkt], num_threads);
+      continue;
+    }
+    small_buckets.push_back(ibkt);
+  }
+  parallel_for_dynamic(small_buckets.size(), num_threads,
+                       [&](const size_t& ismall) {
+                         find_bucket_representatives(
+                           buckets[small_buckets[ismall]], 1);
+                       });
+
+  /* The unique modules are kept in the order of candidates */
+  std::vector<size_t> unique_candidates;
+  for (size_t icand = 0; icand < candidates.size(); ++icand) {
+    if ((false == partial[icand]) && (icand == representatives[icand])) {
+      unique_candidates.push_back(icand);
+    }
+  }
+  for (size_t icand = 0; icand < candidates.size(); ++icand) {
+    if (false == partial[icand]) {
+      continue;
+    }
+    const RRGSB& cand = rr_gsb_[candidates[icand].x()][candidates[icand].y()];
+    representatives[icand] = icand;
+    for (const size_t& iunique : unique_candidates) {
+      if (iunique > icand) {
+        break;
+      }
+      if (false == is_part_hash_match(hashes[icand], hashes[iunique])) {
+        continue;
+      }
+      const RRGSB& unique_module =
+        rr_gsb_[candidates[iunique].x()][candidates[iunique].y()];
+      if (true == is_mirror(cand, unique_module)) {
+        representatives[icand] = iunique;
+        break;
+      }
+    }
+    if (icand == representatives[icand]) {
+      unique_candidates.insert(std::upper_bound(unique_candidates.begin(),
+                                                unique_candidates.end(), icand),
+                               icand);
+    }
+  }
+
+  return representatives;
+}
+
 /* Add a switch block to the array, which will automatically identify and update
  * the lists of unique mirrors and rotatable mirrors */
 void DeviceRRGSB::build_cb_unique_module(const RRGraphView& rr_graph,
-                                         const t_rr_type& cb_type) {
+                                         const t_rr_type& cb_type,
+                                         const size_t& num_threads) {
   /* Make sure a clean start */
   clear_cb_unique_module(cb_type);
 
+  /* Bypass non-exist CB */
+  std::vector<vtr::Point<size_t>> candidates;
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
-      bool is_unique_module = true;
-      vtr::Point<size_t> gsb_coordinate(ix, iy);
-
-      /* Bypass non-exist CB */
       if (false == rr_gsb_[ix][iy].is_cb_exist(cb_type)) {
         continue;
       }
+      candidates.push_back(vtr::Point<size_t>(ix, iy));
+    }
+  }
 
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_cb_unique_module(cb_type); ++id) {
-        const RRGSB& unique_module = get_cb_unique_module(cb_type, id);
-        if (true == is_cb_mirror(rr_graph, device_annotation_, rr_gsb_[ix][iy],
-                                 unique_module, cb_type)) {
-          /* This is a mirror, raise the flag and we finish */
-          is_unique_module = false;
-          /* Record the id of unique mirror */
-          set_cb_unique_module_id(cb_type, gsb_coordinate, id);
-          break;
-        }
-      }
-      /* Add to list if this is a unique mirror*/
-      if (true == is_unique_module) {
-        add_cb_unique_module(cb_type, gsb_coordinate);
-        /* Record the id of unique mirror */
-        set_cb_unique_module_id(cb_type, gsb_coordinate,
-                                get_num_cb_unique_module(cb_type) - 1);
-      }
+  std::vector<size_t> representatives = find_unique_module_representatives(
+    candidates,
+    [&](const RRGSB& rr_gsb) {
+      /* The connection block is compared as a whole */
+      size_t hash = compute_cb_structural_hash(rr_graph, device_annotation_,
+                                               rr_gsb, cb_type);
+      return std::vector<size_t>(1, (0 == hash) ? 1 : hash);
+    },
+    [&](const RRGSB& cand, const RRGSB& unique_module) {
+      return is_cb_mirror(rr_graph, device_annotation_, cand, unique_module,
+                          cb_type);
+    },
+    num_threads);
+
+  /* Assign unique module ids in the order of candidates, so that the ids do
+   * not depend on the number of threads. A representative always comes before
+   * its mirrors and therefore has its id already */
+  for (size_t icand = 0; icand < candidates.size(); ++icand) {
+    const vtr::Point<size_t>& gsb_coordinate = candidates[icand];
+    /* Add to list if this is a unique mirror*/
+    if (icand == representatives[icand]) {
+      add_cb_unique_module(cb_type, gsb_coordinate);
+      /* Record the id of unique mirror */
+      set_cb_unique_module_id(cb_type, gsb_coordinate,
+                              get_num_cb_unique_module(cb_type) - 1);
+      continue;
     }
+    /* This is a mirror, record the id of unique mirror */
+    set_cb_unique_module_id(
+      cb_type, gsb_coordinate,
+      get_cb_unique_module_index(cb_type, candidates[representatives[icand]]));
   }
 }
 
 /* Add a switch block to the array, which will automatically identify and update
  * the lists of unique mirrors and rotatable mirrors */
-void DeviceRRGSB::build_sb_unique_module(const RRGraphView& rr_graph) {
+void DeviceRRGSB::build_sb_unique_module(const RRGraphView& rr_graph,
+                                         const size_t& num_threads) {
   /* Make sure a clean start */
   clear_sb_unique_module();
 
-  /* Build the unique module */
+  std::vector<vtr::Point<size_t>> candidates;
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
-      bool is_unique_module = true;
-      vtr::Point<size_t> sb_coordinate(ix, iy);
-
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_sb_unique_module(); ++id) {
-        /* Check if the two modules have the same submodules,
-         * if so, these two modules are the same, indicating the sb is not
-         * unique. else the sb is unique
-         */
-        const RRGSB& unique_module = get_sb_unique_module(id);
-        if (true == is_sb_mirror(rr_graph, device_annotation_, rr_gsb_[ix][iy],
-                                 unique_module)) {
-          /* This is a mirror, raise the flag and we finish */
-          is_unique_module = false;
-          /* Record the id of unique mirror */
-          sb_unique_module_id_[ix][iy] = id;
-          break;
-        }
-      }
+      candidates.push_back(vtr::Point<size_t>(ix, iy));
+    }
+  }
 
-      /* Add to list if this is a unique mirror*/
-      if (true == is_unique_module) {
-        sb_unique_module_.push_back(sb_coordinate);
-        /* Record the id of unique mirror */
-        sb_unique_module_id_[ix][iy] = sb_unique_module_.size() - 1;
-      }
+  /* Check if the two modules have the same submodules,
+   * if so, these two modules are the same, indicating the sb is not
+   * unique. else the sb is unique
+   */
+  std::vector<size_t> representatives = find_unique_module_representatives(
+    candidates,
+    [&](const RRGSB& rr_gsb) {
+      return compute_sb_side_structural_hashes(rr_graph, device_annotation_,
+                                               rr_gsb);
+    },
+    [&](const RRGSB& cand, const RRGSB& unique_module) {
+      return is_sb_mirror(rr_graph, device_annotation_, cand, unique_module);
+    },
+    num_threads);
+
+  /* Build the unique module, see build_cb_unique_module() */
+  for (size_t icand = 0; icand < candidates.size(); ++icand) {
+    const vtr::Point<size_t>& sb_coordinate = candidates[icand];
+    /* Add to list if this is a unique mirror*/
+    if (icand == representatives[icand]) {
+      sb_unique_module_.push_back(sb_coordinate);
+      /* Record the id of unique mirror */
+      set_sb_unique_module_id(sb_coordinate, sb_unique_module_.size() - 1);
+      continue;
     }
+    /* This is a mirror, record the id of unique mirror */
+    set_sb_unique_module_id(
+      sb_coordinate,
+      get_sb_unique_module_index(candidates[representatives[icand]]));
   }
 }
 
@@ -312,50 +621,89 @@ void DeviceRRGSB::build_gsb_unique_module() {
   /* Make sure a clean start */
   clear_gsb_unique_module();
 
+  /* We have alreay built sb and cb unique module list
+   * A GSB is a mirror of another if the unique module id of SBs, CBX and CBY
+   * are the same. Index the unique GSBs by the id triplet so that each GSB
+   * requires only a single lookup
+   */
+  std::map<std::array<size_t, 3>, size_t> unique_module_lookup;
+
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
-      bool is_unique_module = true;
       vtr::Point<size_t> gsb_coordinate(ix, iy);
+      std::array<size_t, 3> unique_ids = {sb_unique_module_id_[ix][iy],
+                                          cbx_unique_module_id_[ix][iy],
+                                          cby_unique_module_id_[ix][iy]};
+
+      auto result = unique_module_lookup.find(unique_ids);
+      if (result != unique_module_lookup.end()) {
+        /* This is a mirror, record the id of unique mirror */
+        gsb_unique_module_id_[ix][iy] = result->second;
+        continue;
+      }
+      /* Add to list if this is a unique mirror*/
+      add_gsb_unique_module(gsb_coordinate);
+      /* Record the id of unique mirror */
+      gsb_unique_module_id_[ix][iy] = get_num_gsb_unique_module() - 1;
+      unique_module_lookup[unique_ids] = get_num_gsb_unique_module() - 1;
+    }
+  }
+}
 
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_gsb_unique_module(); ++id) {
-        /* We have alreay built sb and cb unique module list
-         * We just need to check if the unique module id of SBs, CBX and CBY are
-         * the same or not
-         */
-        const vtr::Point<size_t>& gsb_unique_module_coordinate =
-          gsb_unique_module_[id];
-        if ((sb_unique_module_id_[ix][iy] ==
-             sb_unique_module_id_[gsb_unique_module_coordinate.x()]
-                                 [gsb_unique_module_coordinate.y()]) &&
-            (cbx_unique_module_id_[ix][iy] ==
-             cbx_unique_module_id_[gsb_unique_module_coordinate.x()]
-                                  [gsb_unique_module_coordinate.y()]) &&
-            (cby_unique_module_id_[ix][iy] ==
-             cby_unique_module_id_[gsb_unique_module_coordinate.x()]
-                                  [gsb_unique_module_coordinate.y()])) {
-          /* This is a mirror, raise the flag and we finish */
-          is_unique_module = false;
-          /* Record the id of unique mirror */
-          gsb_unique_module_id_[ix][iy] = id;
+/* Group the unique switch blocks which are the same once rotated or
+ * reflected, e.g., the switch blocks on the sides of the fabric which are
+ * reflections of each other. Each group is represented by its first unique
+ * switch block, and each unique switch block records the map from the sides
+ * of the representative to its own sides.
+ * The unique switch blocks are few, so that they are compared one by one
+ * among those which share a hash invariant to rotations and reflections */
+void DeviceRRGSB::build_sb_rotatable_module(const RRGraphView& rr_graph) {
+  /* Make sure a clean start */
+  clear_sb_rotatable_module();
+
+  std::vector<t_rr_gsb_side_map> side_maps =
+    get_rr_gsb_rotation_reflection_side_maps();
+  std::unordered_map<size_t, std::vector<size_t>> rotatable_lookup;
+
+  for (size_t isb = 0; isb < get_num_sb_unique_module(); ++isb) {
+    const RRGSB& cand = get_sb_unique_module(isb);
+    std::vector<size_t>& bucket =
+      rotatable_lookup[compute_sb_side_map_invariant_hash(
+        rr_graph, device_annotation_, cand)];
+
+    bool found = false;
+    for (const size_t& irot : bucket) {
+      const RRGSB& base = get_sb_rotatable_module(irot);
+      for (const t_rr_gsb_side_map& side_map : side_maps) {
+        if (true == is_sb_side_map_mirror(rr_graph, device_annotation_, base,
+                                          cand, side_map)) {
+          sb_unique_module_rotatable_id_.push_back(irot);
+          sb_unique_module_side_map_.push_back(side_map);
+          found = true;
           break;
         }
       }
-      /* Add to list if this is a unique mirror*/
-      if (true == is_unique_module) {
-        add_gsb_unique_module(gsb_coordinate);
-        /* Record the id of unique mirror */
-        gsb_unique_module_id_[ix][iy] = get_num_gsb_unique_module() - 1;
+      if (true == found) {
+        break;
       }
     }
+    if (true == found) {
+      continue;
+    }
+    /* A new rotatable switch block, which is its own representative */
+    sb_rotatable_module_.push_back(isb);
+    bucket.push_back(sb_rotatable_module_.size() - 1);
+    sb_unique_module_rotatable_id_.push_back(sb_rotatable_module_.size() - 1);
+    sb_unique_module_side_map_.push_back(side_maps.front());
   }
 }
 
-void DeviceRRGSB::build_unique_module(const RRGraphView& rr_graph) {
-  build_sb_unique_module(rr_graph);
+void DeviceRRGSB::build_unique_module(const RRGraphView& rr_graph,
+                                      const size_t& num_threads) {
+  build_sb_unique_module(rr_graph, num_threads);
 
-  build_cb_unique_module(rr_graph, CHANX);
-  build_cb_unique_module(rr_graph, CHANY);
+  build_cb_unique_module(rr_graph, CHANX, num_threads);
+  build_cb_unique_module(rr_graph, CHANY, num_threads);
 
   build_gsb_unique_module();
 }
@@ -364,6 +712,10 @@ void DeviceRRGSB::add_gsb_unique_module(const vtr::Point<size_t>& coordinate) {
   gsb_unique_module_.push_back(coordinate);
 }
 
+void DeviceRRGSB::add_sb_unique_module(const vtr::Point<size_t>& coordinate) {
+  sb_unique_module_.push_back(coordinate);
+}
+
 void DeviceRRGSB::add_cb_unique_module(const t_rr_type& cb_type,
                                        const vtr::Point<size_t>& coordinate) {
   VTR_ASSERT(validate_cb_type(cb_type));
@@ -380,6 +732,18 @@ void DeviceRRGSB::add_cb_unique_module(const t_rr_type& cb_type,
   }
 }
 
+void DeviceRRGSB::set_gsb_unique_module_id(
+  const vtr::Point<size_t>& coordinate, size_t id) {
+  VTR_ASSERT(validate_coordinate(coordinate));
+  gsb_unique_module_id_[coordinate.x()][coordinate.y()] = id;
+}
+
+void DeviceRRGSB::set_sb_unique_module_id(const vtr::Point<size_t>& coordinate,
+                                          size_t id) {
+  VTR_ASSERT(validate_coordinate(coordinate));
+  sb_unique_module_id_[coordinate.x()][coordinate.y()] = id;
+}
+
 void DeviceRRGSB::set_cb_unique_module_id(const t_rr_type& cb_type,
                                           const vtr::Point<size_t>& coordinate,
                                           size_t id) {
@@ -420,6 +784,14 @@ void DeviceRRGSB::clear() {
   clear_sb_unique_module_id();
 }
 
+/* clean the unique module lists while keeping the GSB array */
+void DeviceRRGSB::clear_unique_module() {
+  clear_gsb_unique_module();
+  clear_sb_unique_module();
+  clear_cb_unique_module(CHANX);
+  clear_cb_unique_module(CHANY);
+}
+
 void DeviceRRGSB::clear_gsb() {
   /* clean gsb array */
   for (size_t x = 0; x < rr_gsb_.size(); ++x) {
@@ -471,6 +843,15 @@ void DeviceRRGSB::clear_gsb_unique_module() {
 void DeviceRRGSB::clear_sb_unique_module() {
   /* clean unique mirror */
   sb_unique_module_.clear();
+  /* The rotatable switch blocks are built upon the unique mirrors */
+  clear_sb_rotatable_module();
+}
+
+/* clean the content related to rotatable switch blocks */
+void DeviceRRGSB::clear_sb_rotatable_module() {
+  sb_rotatable_module_.clear();
+  sb_unique_module_rotatable_id_.clear();
+  sb_unique_module_side_map_.clear();
 }
 
 void DeviceRRGSB::clear_cb_unique_module(const t_rr_type& cb_type) {
@@ -510,6 +891,11 @@ bool DeviceRRGSB::validate_sb_unique_module_index(const size_t& index) const {
   return (index < sb_unique_module_.size());
 }
 
+bool DeviceRRGSB::validate_sb_rotatable_module_index(
+  const size_t& index) const {
+  return (index < sb_rotatable_module_.size());
+}
+
 bool DeviceRRGSB::validate_cb_unique_module_index(const t_rr_type& cb_type,
                                                   const size_t& index) const {
   VTR_ASSERT(validate_cb_type(cb_type));
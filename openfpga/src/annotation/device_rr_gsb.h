@@ -4,12 +4,16 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <functional>
+#include <vector>
+
 /* Header files from vtrutil library */
 #include "vtr_geometry.h"
 
 /* Header files from vpr library */
 #include "rr_graph_view.h"
 #include "rr_gsb.h"
+#include "rr_gsb_utils.h"
 #include "vpr_device_annotation.h"
 
 /* namespace openfpga begins */
@@ -56,6 +60,26 @@ class DeviceRRGSB {
   size_t get_num_cb_unique_module(const t_rr_type& cb_type)
     const; /* get the number of unique mirrors of CBs */
   bool is_gsb_exist(const vtr::Point<size_t> coord) const;
+  size_t get_gsb_unique_module_index(const vtr::Point<size_t>& coordinate)
+    const; /* Get the index of the unique mirror of a GSB */
+  size_t get_sb_unique_module_index(const vtr::Point<size_t>& coordinate)
+    const; /* Get the index of the unique mirror of a switch block */
+  size_t get_cb_unique_module_index(const t_rr_type& cb_type,
+                                    const vtr::Point<size_t>& coordinate)
+    const; /* Get the index of the unique mirror of a connection block */
+  size_t memory_usage()
+    const; /* Estimate the memory used by the GSB array, in bytes */
+  /* Rotatable switch blocks: the unique switch blocks which are the same
+   * once rotated or reflected, see build_sb_rotatable_module() */
+  size_t get_num_sb_rotatable_module() const;
+  /* Get the unique switch block representing a rotatable switch block */
+  const RRGSB& get_sb_rotatable_module(const size_t& index) const;
+  /* Get the index of the rotatable switch block of a unique switch block */
+  size_t get_sb_rotatable_module_index(const size_t& unique_index) const;
+  /* Get the map from the sides of the rotatable switch block to the sides of
+   * a unique switch block, whose pins keep their indices on the mapped side */
+  const t_rr_gsb_side_map& get_sb_rotatable_module_side_map(
+    const size_t& unique_index) const;
 
  public: /* Mutators */
   void reserve(
@@ -73,6 +97,9 @@ class DeviceRRGSB {
     const RRGSB& rr_gsb); /* Add a switch block to the array, which will
                              automatically identify and update the lists of
                              unique mirrors and rotatable mirrors */
+  void add_rr_gsb(const vtr::Point<size_t>& coordinate,
+                  RRGSB&& rr_gsb); /* Move a switch block into the array,
+                                      which avoids copying its nodes */
   RRGSB& get_mutable_gsb(
     const vtr::Point<size_t>&
       coordinate); /* Get a rr switch block in the array with a coordinate */
@@ -80,17 +107,36 @@ class DeviceRRGSB {
     const size_t& x,
     const size_t& y); /* Get a rr switch block in the array with a coordinate */
   void build_unique_module(
-    const RRGraphView& rr_graph); /* Add a switch block to the array, which will
-                                     automatically identify and update the lists
-                                     of unique mirrors and rotatable mirrors */
-  void clear();                   /* clean the content */
- private:                         /* Internal cleaners */
+    const RRGraphView& rr_graph,
+    const size_t& num_threads =
+      1); /* Add a switch block to the array, which will automatically identify
+             and update the lists of unique mirrors and rotatable mirrors */
+  void build_sb_rotatable_module(
+    const RRGraphView&
+      rr_graph); /* Group the unique switch blocks which are rotations or
+                    reflections of each other */
+  /* Directly set the unique module lists, when they are known in advance,
+   * e.g., loaded from a cache file */
+  void add_gsb_unique_module(const vtr::Point<size_t>& coordinate);
+  void add_sb_unique_module(const vtr::Point<size_t>& coordinate);
+  void add_cb_unique_module(const t_rr_type& cb_type,
+                            const vtr::Point<size_t>& coordinate);
+  void set_gsb_unique_module_id(const vtr::Point<size_t>& coordinate,
+                                size_t id);
+  void set_sb_unique_module_id(const vtr::Point<size_t>& coordinate,
+                               size_t id);
+  void set_cb_unique_module_id(const t_rr_type& cb_type,
+                               const vtr::Point<size_t>& coordinate, size_t id);
+  void clear_unique_module(); /* clean the unique module lists */
+  void clear();               /* clean the content */
+ private:                     /* Internal cleaners */
   void clear_gsb();               /* clean the content */
   void clear_cb_unique_module(const t_rr_type& cb_type); /* clean the content */
   void clear_cb_unique_module_id(
     const t_rr_type& cb_type);       /* clean the content */
   void clear_sb_unique_module();     /* clean the content */
   void clear_sb_unique_module_id();  /* clean the content */
+  void clear_sb_rotatable_module();  /* clean the content */
   void clear_gsb_unique_module();    /* clean the content */
   void clear_gsb_unique_module_id(); /* clean the content */
  private:                            /* Validators */
@@ -102,26 +148,31 @@ class DeviceRRGSB {
     const; /* Validate if the index in the range of unique_mirror vector*/
   bool validate_sb_unique_module_index(const size_t& index)
     const; /* Validate if the index in the range of unique_mirror vector*/
+  bool validate_sb_rotatable_module_index(const size_t& index)
+    const; /* Validate if the index in the range of rotatable vector*/
   bool validate_cb_unique_module_index(const t_rr_type& cb_type,
                                        const size_t& index)
     const; /* Validate if the index in the range of unique_mirror vector*/
   bool validate_cb_type(const t_rr_type& cb_type) const;
 
  private: /* Internal builders */
-  void add_gsb_unique_module(const vtr::Point<size_t>& coordinate);
-  void add_cb_unique_module(const t_rr_type& cb_type,
-                            const vtr::Point<size_t>& coordinate);
-  void set_cb_unique_module_id(const t_rr_type& cb_type,
-                               const vtr::Point<size_t>& coordinate, size_t id);
+  std::vector<size_t> find_unique_module_representatives(
+    const std::vector<vtr::Point<size_t>>& candidates,
+    const std::function<std::vector<size_t>(const RRGSB&)>& hasher,
+    const std::function<bool(const RRGSB&, const RRGSB&)>& is_mirror,
+    const size_t& num_threads)
+    const; /* Find the first mirror of each candidate among the candidates */
   void build_sb_unique_module(
-    const RRGraphView& rr_graph); /* Add a switch block to the array, which will
-                                     automatically identify and update the lists
-                                     of unique mirrors and rotatable mirrors */
-  void build_cb_unique_module(
     const RRGraphView& rr_graph,
-    const t_rr_type&
-      cb_type); /* Add a switch block to the array, which will automatically
-                   identify and update the lists of unique side module */
+    const size_t& num_threads); /* Add a switch block to the array, which will
+                                   automatically identify and update the lists
+                                   of unique mirrors and rotatable mirrors */
+  void build_cb_unique_module(
+    const RRGraphView& rr_graph, const t_rr_type& cb_type,
+    const size_t&
+      num_threads); /* Add a switch block to the array, which will
+                       automatically identify and update the lists of unique
+                       side module */
   void build_gsb_unique_module(); /* Add a switch block to the array, which will
                                      automatically identify and update the lists
                                      of unique mirrors and rotatable mirrors */
@@ -136,6 +187,17 @@ class DeviceRRGSB {
     sb_unique_module_id_; /* A map from rr_gsb to its unique mirror */
   std::vector<vtr::Point<size_t>> sb_unique_module_;
 
+  std::vector<size_t>
+    sb_rotatable_module_; /* The unique switch block representing each
+                             rotatable switch block */
+  std::vector<size_t>
+    sb_unique_module_rotatable_id_; /* A map from unique switch blocks to
+                                       their rotatable switch blocks */
+  std::vector<t_rr_gsb_side_map>
+    sb_unique_module_side_map_; /* A map from the sides of the rotatable
+                                   switch block to the sides of each unique
+                                   switch block */
+
   std::vector<std::vector<size_t>>
     cbx_unique_module_id_; /* A map from rr_gsb to its unique mirror */
   std::vector<vtr::Point<size_t>>
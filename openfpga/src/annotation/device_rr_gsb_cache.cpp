@@ -0,0 +1,429 @@
+/********************************************************************
+ * This file includes functions to save the unique module results of
+ * a DeviceRRGSB into a compact binary file and to load them back.
+ * The unique module identification is the most time-consuming step of
+ * compressing the routing hierarchy. When the routing resource graph and
+ * the architecture are not changed between runs, the results can be
+ * reused instead of being recomputed.
+ *
+ * The cache file is organized as follows (all the numbers are stored
+ * in the native byte order of the machine):
+ * - A magic header and a format version
+ * - The digest of the routing resource graph and the architecture
+ * - The size of the GSB array
+ * - For SB, CBX, CBY and GSB, in this order:
+ *   - the number of unique modules
+ *   - the coordinates of unique modules
+ *   - the unique module id of each GSB in the array
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "openfpga_trace.h"
+
+#include "device_rr_gsb_cache.h"
+#include "openfpga_side_manager.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Magic header and version of the cache file.
+ * Increase the version when the format is changed */
+constexpr const char* DEVICE_RR_GSB_CACHE_MAGIC = "OFPGAGSB";
+constexpr size_t DEVICE_RR_GSB_CACHE_MAGIC_SIZE = 8;
+constexpr uint32_t DEVICE_RR_GSB_CACHE_VERSION = 2;
+
+/* Types of unique modules stored in the cache, in the order of storage */
+enum e_gsb_cache_module_type {
+  GSB_CACHE_SB,
+  GSB_CACHE_CBX,
+  GSB_CACHE_CBY,
+  GSB_CACHE_GSB,
+  NUM_GSB_CACHE_MODULE_TYPES
+};
+
+/********************************************************************
+ * Mix a value into a 64-bit FNV-1a digest
+ *******************************************************************/
+static void digest_value(uint64_t& digest, const uint64_t& value) {
+  for (size_t ibyte = 0; ibyte < sizeof(value); ++ibyte) {
+    digest ^= (value >> (8 * ibyte)) & 0xff;
+    digest *= 0x100000001b3ULL;
+  }
+}
+
+/********************************************************************
+ * Compute a digest which identifies the inputs of the unique module
+ * identification, i.e., the routing resource graph, the circuit models
+ * bound to routing switches and segments, the nodes which each GSB
+ * of the array gathers from the graph, and the order of the incoming
+ * edges of the output nodes of each GSB. The mirror checks compare the
+ * incoming edges by position, and the order differs from the graph when
+ * the edges are sorted, e.g., by link_openfpga_arch
+ * --sort_gsb_chan_node_in_edges, so a cache of the other order is never
+ * trusted.
+ * The digest is a single pass on the nodes and edges of the graph and of
+ * the GSBs, which is much cheaper than comparing the GSBs, so that a cache
+ * hit saves the identification entirely
+ *******************************************************************/
+uint64_t compute_device_rr_gsb_digest(
+  const RRGraphView& rr_graph, const VprDeviceAnnotation& device_annotation,
+  const DeviceRRGSB& device_rr_gsb) {
+  uint64_t digest = 0xcbf29ce484222325ULL;
+
+  digest_value(digest, rr_graph.num_nodes());
+  digest_value(digest, rr_graph.in_edges_count());
+  for (const RRNodeId& node : rr_graph.nodes()) {
+    t_rr_type node_type = rr_graph.node_type(node);
+    digest_value(digest, size_t(node_type));
+    if ((CHANX == node_type) || (CHANY == node_type)) {
+      digest_value(digest, size_t(rr_graph.node_direction(node)));
+      digest_value(digest, size_t(device_annotation.rr_segment_circuit_model(
+                             rr_graph.node_segment(node))));
+    }
+    for (const RREdgeId& edge : rr_graph.node_in_edges(node)) {
+      digest_value(digest, size_t(rr_graph.edge_src_node(edge)));
+      digest_value(digest, size_t(device_annotation.rr_switch_circuit_model(
+                             rr_graph.edge_switch(edge))));
+    }
+  }
+
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  digest_value(digest, gsb_range.x());
+  digest_value(digest, gsb_range.y());
+
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+      digest_value(digest, rr_gsb.get_num_sides());
+      for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+        e_side side_enum = SideManager(side).get_side();
+        digest_value(digest, rr_gsb.get_chan_width(side_enum));
+        for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_enum);
+             ++itrack) {
+          digest_value(digest,
+                       size_t(rr_gsb.get_chan_node(side_enum, itrack)));
+          digest_value(
+            digest, size_t(rr_gsb.get_chan_node_direction(side_enum, itrack)));
+          if (OUT_PORT != rr_gsb.get_chan_node_direction(side_enum, itrack)) {
+            continue;
+          }
+          for (const RREdgeId& edge :
+               rr_gsb.get_chan_node_in_edges(rr_graph, side_enum, itrack)) {
+            digest_value(digest, size_t(edge));
+          }
+        }
+        digest_value(digest, rr_gsb.get_num_opin_nodes(side_enum));
+        for (size_t inode = 0; inode < rr_gsb.get_num_opin_nodes(side_enum);
+             ++inode) {
+          digest_value(digest, size_t(rr_gsb.get_opin_node(side_enum, inode)));
+        }
+        digest_value(digest, rr_gsb.get_num_ipin_nodes(side_enum));
+        for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(side_enum);
+             ++inode) {
+          digest_value(digest, size_t(rr_gsb.get_ipin_node(side_enum, inode)));
+          for (const RREdgeId& edge :
+               rr_gsb.get_ipin_node_in_edges(rr_graph, side_enum, inode)) {
+            digest_value(digest, size_t(edge));
+          }
+        }
+      }
+      for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+        digest_value(digest, rr_gsb.is_cb_exist(cb_type));
+      }
+    }
+  }
+
+  return digest;
+}
+
+/********************************************************************
+ * Binary writers/readers for plain numbers
+ *******************************************************************/
+template <class T>
+static void write_bin_value(std::fstream& fp, const T& value) {
+  fp.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+static bool read_bin_value(const std::vector<char>& buffer, size_t& cursor,
+                           T& value) {
+  if (cursor + sizeof(T) > buffer.size()) {
+    return false;
+  }
+  std::memcpy(&value, buffer.data() + cursor, sizeof(T));
+  cursor += sizeof(T);
+  return true;
+}
+
+/********************************************************************
+ * Get the unique module id of a GSB for a given type of unique modules
+ *******************************************************************/
+static size_t get_cache_unique_module_index(
+  const DeviceRRGSB& device_rr_gsb, const e_gsb_cache_module_type& module_type,
+  const vtr::Point<size_t>& coord) {
+  switch (module_type) {
+    case GSB_CACHE_SB:
+      return device_rr_gsb.get_sb_unique_module_index(coord);
+    case GSB_CACHE_CBX:
+      return device_rr_gsb.get_cb_unique_module_index(CHANX, coord);
+    case GSB_CACHE_CBY:
+      return device_rr_gsb.get_cb_unique_module_index(CHANY, coord);
+    case GSB_CACHE_GSB:
+      return device_rr_gsb.get_gsb_unique_module_index(coord);
+    default:
+      VTR_LOG_ERROR("Invalid type of unique module!\n");
+      exit(1);
+  }
+}
+
+/********************************************************************
+ * Get the coordinate of a unique module for a given type
+ *******************************************************************/
+static vtr::Point<size_t> get_cache_unique_module_coordinate(
+  const DeviceRRGSB& device_rr_gsb, const e_gsb_cache_module_type& module_type,
+  const size_t& index) {
+  switch (module_type) {
+    case GSB_CACHE_SB:
+      return device_rr_gsb.get_sb_unique_module(index).get_sb_coordinate();
+    case GSB_CACHE_CBX:
+      return device_rr_gsb.get_cb_unique_module(CHANX, index)
+        .get_sb_coordinate();
+    case GSB_CACHE_CBY:
+      return device_rr_gsb.get_cb_unique_module(CHANY, index)
+        .get_sb_coordinate();
+    case GSB_CACHE_GSB:
+      return device_rr_gsb.get_gsb_unique_module(index).get_sb_coordinate();
+    default:
+      VTR_LOG_ERROR("Invalid type of unique module!\n");
+      exit(1);
+  }
+}
+
+/********************************************************************
+ * Get the number of unique modules for a given type
+ *******************************************************************/
+static size_t get_cache_num_unique_module(
+  const DeviceRRGSB& device_rr_gsb,
+  const e_gsb_cache_module_type& module_type) {
+  switch (module_type) {
+    case GSB_CACHE_SB:
+      return device_rr_gsb.get_num_sb_unique_module();
+    case GSB_CACHE_CBX:
+      return device_rr_gsb.get_num_cb_unique_module(CHANX);
+    case GSB_CACHE_CBY:
+      return device_rr_gsb.get_num_cb_unique_module(CHANY);
+    case GSB_CACHE_GSB:
+      return device_rr_gsb.get_num_gsb_unique_module();
+    default:
+      VTR_LOG_ERROR("Invalid type of unique module!\n");
+      exit(1);
+  }
+}
+
+/********************************************************************
+ * Write the unique module results of a DeviceRRGSB to a binary file
+ *******************************************************************/
+int write_device_rr_gsb_unique_module_cache(const std::string& fname,
+                                            const DeviceRRGSB& device_rr_gsb,
+                                            const uint64_t& digest,
+                                            const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer(
+    "Write unique General Switch Blocks (GSBs) to cache file");
+  OPENFPGA_TRACE_FUNCTION();
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::binary |
+                   std::fstream::trunc);
+  if (false == valid_file_stream(fp)) {
+    VTR_LOG_ERROR("Unable to open GSB cache file '%s' for writing!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+
+  fp.write(DEVICE_RR_GSB_CACHE_MAGIC, DEVICE_RR_GSB_CACHE_MAGIC_SIZE);
+  write_bin_value<uint32_t>(fp, DEVICE_RR_GSB_CACHE_VERSION);
+  write_bin_value<uint64_t>(fp, digest);
+  write_bin_value<uint64_t>(fp, gsb_range.x());
+  write_bin_value<uint64_t>(fp, gsb_range.y());
+
+  for (size_t itype = 0; itype < NUM_GSB_CACHE_MODULE_TYPES; ++itype) {
+    e_gsb_cache_module_type module_type = e_gsb_cache_module_type(itype);
+    size_t num_unique_modules =
+      get_cache_num_unique_module(device_rr_gsb, module_type);
+    write_bin_value<uint64_t>(fp, num_unique_modules);
+    for (size_t id = 0; id < num_unique_modules; ++id) {
+      vtr::Point<size_t> coord =
+        get_cache_unique_module_coordinate(device_rr_gsb, module_type, id);
+      write_bin_value<uint32_t>(fp, coord.x());
+      write_bin_value<uint32_t>(fp, coord.y());
+    }
+    for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+      for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+        write_bin_value<uint32_t>(
+          fp, get_cache_unique_module_index(device_rr_gsb, module_type,
+                                            vtr::Point<size_t>(ix, iy)));
+      }
+    }
+  }
+
+  fp.close();
+  if (true == fp.fail()) {
+    VTR_LOG_ERROR("Fail to write GSB cache file '%s'!\n", fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  VTR_LOGV(verbose, "Wrote unique GSB cache to '%s' (digest=0x%016lx)\n",
+           fname.c_str(), digest);
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Load the unique module results of a DeviceRRGSB from a binary file
+ * The GSB array should have been built already.
+ * Return true only when the cache matches the given digest, which covers
+ * the GSB array, so that the GSBs are not checked against their unique
+ * modules. Otherwise, the unique module lists are left empty and the
+ * caller should identify the unique modules again.
+ *******************************************************************/
+bool read_device_rr_gsb_unique_module_cache(const std::string& fname,
+                                            DeviceRRGSB& device_rr_gsb,
+                                            const uint64_t& digest,
+                                            const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer(
+    "Read unique General Switch Blocks (GSBs) from cache file");
+  OPENFPGA_TRACE_FUNCTION();
+
+  /* Load the whole file in one shot and decode it from memory */
+  std::ifstream fp(fname, std::ifstream::binary);
+  if (!fp.is_open()) {
+    VTR_LOGV(verbose, "GSB cache file '%s' does not exist\n", fname.c_str());
+    return false;
+  }
+  std::vector<char> buffer((std::istreambuf_iterator<char>(fp)),
+                           std::istreambuf_iterator<char>());
+  fp.close();
+
+  size_t cursor = 0;
+  if ((buffer.size() < DEVICE_RR_GSB_CACHE_MAGIC_SIZE) ||
+      (0 != std::memcmp(buffer.data(), DEVICE_RR_GSB_CACHE_MAGIC,
+                        DEVICE_RR_GSB_CACHE_MAGIC_SIZE))) {
+    VTR_LOG_WARN("Invalid GSB cache file '%s'! Ignore it.\n", fname.c_str());
+    return false;
+  }
+  cursor += DEVICE_RR_GSB_CACHE_MAGIC_SIZE;
+
+  uint32_t version = 0;
+  uint64_t cached_digest = 0;
+  uint64_t range_x = 0;
+  uint64_t range_y = 0;
+  if (!read_bin_value(buffer, cursor, version) ||
+      !read_bin_value(buffer, cursor, cached_digest) ||
+      !read_bin_value(buffer, cursor, range_x) ||
+      !read_bin_value(buffer, cursor, range_y)) {
+    VTR_LOG_WARN("Truncated GSB cache file '%s'! Ignore it.\n", fname.c_str());
+    return false;
+  }
+
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  if ((DEVICE_RR_GSB_CACHE_VERSION != version) || (digest != cached_digest) ||
+      (gsb_range.x() != range_x) || (gsb_range.y() != range_y)) {
+    VTR_LOGV(verbose,
+             "GSB cache file '%s' is outdated (digest=0x%016lx while "
+             "expect 0x%016lx)\n",
+             fname.c_str(), cached_digest, digest);
+    return false;
+  }
+
+  device_rr_gsb.clear_unique_module();
+
+  for (size_t itype = 0; itype < NUM_GSB_CACHE_MODULE_TYPES; ++itype) {
+    e_gsb_cache_module_type module_type = e_gsb_cache_module_type(itype);
+    uint64_t num_unique_modules = 0;
+    bool valid = read_bin_value(buffer, cursor, num_unique_modules);
+    for (size_t id = 0; valid && (id < num_unique_modules); ++id) {
+      uint32_t x = 0;
+      uint32_t y = 0;
+      valid = read_bin_value(buffer, cursor, x) &&
+              read_bin_value(buffer, cursor, y) && (x < range_x) &&
+              (y < range_y);
+      if (false == valid) {
+        break;
+      }
+      vtr::Point<size_t> coord(x, y);
+      switch (module_type) {
+        case GSB_CACHE_SB:
+          device_rr_gsb.add_sb_unique_module(coord);
+          break;
+        case GSB_CACHE_CBX:
+          device_rr_gsb.add_cb_unique_module(CHANX, coord);
+          break;
+        case GSB_CACHE_CBY:
+          device_rr_gsb.add_cb_unique_module(CHANY, coord);
+          break;
+        case GSB_CACHE_GSB:
+          device_rr_gsb.add_gsb_unique_module(coord);
+          break;
+        default:
+          VTR_LOG_ERROR("Invalid type of unique module!\n");
+          exit(1);
+      }
+    }
+    for (size_t ix = 0; valid && (ix < gsb_range.x()); ++ix) {
+      for (size_t iy = 0; valid && (iy < gsb_range.y()); ++iy) {
+        uint32_t id = 0;
+        valid = read_bin_value(buffer, cursor, id) &&
+                (id < num_unique_modules || 0 == num_unique_modules);
+        if (false == valid) {
+          break;
+        }
+        vtr::Point<size_t> coord(ix, iy);
+        switch (module_type) {
+          case GSB_CACHE_SB:
+            device_rr_gsb.set_sb_unique_module_id(coord, id);
+            break;
+          case GSB_CACHE_CBX:
+            device_rr_gsb.set_cb_unique_module_id(CHANX, coord, id);
+            break;
+          case GSB_CACHE_CBY:
+            device_rr_gsb.set_cb_unique_module_id(CHANY, coord, id);
+            break;
+          case GSB_CACHE_GSB:
+            device_rr_gsb.set_gsb_unique_module_id(coord, id);
+            break;
+          default:
+            VTR_LOG_ERROR("Invalid type of unique module!\n");
+            exit(1);
+        }
+      }
+    }
+    if (false == valid) {
+      VTR_LOG_WARN("Corrupted GSB cache file '%s'! Ignore it.\n",
+                   fname.c_str());
+      device_rr_gsb.clear_unique_module();
+      return false;
+    }
+  }
+
+  VTR_LOGV(verbose, "Loaded unique GSBs from cache file '%s'\n",
+           fname.c_str());
+
+  return true;
+}
+
+} /* end namespace openfpga */
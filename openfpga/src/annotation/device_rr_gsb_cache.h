@@ -0,0 +1,37 @@
+#ifndef DEVICE_RR_GSB_CACHE_H
+#define DEVICE_RR_GSB_CACHE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstdint>
+#include <string>
+
+#include "device_rr_gsb.h"
+#include "rr_graph_view.h"
+#include "vpr_device_annotation.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+uint64_t compute_device_rr_gsb_digest(
+  const RRGraphView& rr_graph, const VprDeviceAnnotation& device_annotation,
+  const DeviceRRGSB& device_rr_gsb);
+
+int write_device_rr_gsb_unique_module_cache(const std::string& fname,
+                                            const DeviceRRGSB& device_rr_gsb,
+                                            const uint64_t& digest,
+                                            const bool& verbose);
+
+bool read_device_rr_gsb_unique_module_cache(const std::string& fname,
+                                            DeviceRRGSB& device_rr_gsb,
+                                            const uint64_t& digest,
+                                            const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
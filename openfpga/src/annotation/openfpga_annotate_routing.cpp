@@ -5,7 +5,11 @@
 /* Headers from vtrutil library */
 #include "openfpga_annotate_routing.h"
 
+#include <limits>
+#include <unordered_map>
+
 #include "annotate_routing.h"
+#include "openfpga_parallel.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -39,9 +43,14 @@ void annotate_vpr_rr_node_nets(const DeviceContext& device_ctx,
  * It requires a candidate which provided by upstream functions
  * Try to validate a candidate by searching it from driving node list
  * If not validated, try to find a right one in the routing traces
+ *
+ * The first position of each node in the routing traces is pre-computed
+ * by the caller, so that the search only visits the incoming edges of
+ * the rr_node rather than walking the traces from the head again.
  *******************************************************************/
 static RRNodeId find_previous_node_from_routing_traces(
-  const RRGraphView& rr_graph, t_trace* routing_trace_head,
+  const RRGraphView& rr_graph,
+  const std::unordered_map<RRNodeId, size_t>& trace_node_first_index,
   const RRNodeId& prev_node_candidate, const RRNodeId& cur_rr_node) {
   RRNodeId prev_node = prev_node_candidate;
 
@@ -50,19 +59,13 @@ static RRNodeId find_previous_node_from_routing_traces(
   if (prev_node) {
     /* Try to spot the previous node in the incoming node list of this rr_node
      */
-    bool valid_prev_node = false;
     for (const RREdgeId& in_edge : rr_graph.node_in_edges(cur_rr_node)) {
       if (prev_node == rr_graph.edge_src_node(in_edge)) {
-        valid_prev_node = true;
-        break;
+        /* Early exit if we already validate the node */
+        return prev_node;
       }
     }
 
-    /* Early exit if we already validate the node */
-    if (true == valid_prev_node) {
-      return prev_node;
-    }
-
     /* If we cannot find one, it could be possible that this rr_node branches
      * from an earlier point in the routing tree
      *
@@ -72,33 +75,22 @@ static RRNodeId find_previous_node_from_routing_traces(
      *            |
      *            +-----+ rr_node
      *
-     * Our job now is to start from the head of the traces and find the
-     * prev_node that drives this rr_node
+     * Our job now is to find the prev_node that drives this rr_node and
+     * appears first in the routing traces
      *
      * This search will find the first-fit and finish.
      * This is reasonable because if there is a second-fit, it should be a
      * longer path which should be considered in routing optimization
      */
-    if (false == valid_prev_node) {
-      t_trace* tptr = routing_trace_head;
-      while (tptr != nullptr) {
-        RRNodeId cand_prev_node = RRNodeId(tptr->index);
-        bool is_good_cand = false;
-        for (const RREdgeId& in_edge : rr_graph.node_in_edges(cur_rr_node)) {
-          if (cand_prev_node == rr_graph.edge_src_node(in_edge)) {
-            is_good_cand = true;
-            break;
-          }
-        }
-
-        if (true == is_good_cand) {
-          /* Update prev_node */
-          prev_node = cand_prev_node;
-          break;
-        }
-
-        /* Move on to the next */
-        tptr = tptr->next;
+    size_t first_fit_index = std::numeric_limits<size_t>::max();
+    for (const RREdgeId& in_edge : rr_graph.node_in_edges(cur_rr_node)) {
+      RRNodeId cand_prev_node = rr_graph.edge_src_node(in_edge);
+      auto result = trace_node_first_index.find(cand_prev_node);
+      if ((result != trace_node_first_index.end()) &&
+          (result->second < first_fit_index)) {
+        /* Update prev_node */
+        first_fit_index = result->second;
+        prev_node = cand_prev_node;
       }
     }
   }
@@ -106,19 +98,70 @@ static RRNodeId find_previous_node_from_routing_traces(
   return prev_node;
 }
 
+/********************************************************************
+ * Find the previous node of each rr_node used by a net
+ * Return a list of pairs (rr_node, previous node) in the order of the
+ * routing traces.
+ * This function only reads the routing context, so that it can be called
+ * for different nets in parallel
+ *******************************************************************/
+static std::vector<std::pair<RRNodeId, RRNodeId>>
+find_net_rr_node_previous_nodes(const RRGraphView& rr_graph,
+                                t_trace* routing_trace_head) {
+  std::vector<std::pair<RRNodeId, RRNodeId>> prev_nodes;
+
+  /* Cache the first position of each node in the routing traces */
+  std::unordered_map<RRNodeId, size_t> trace_node_first_index;
+  size_t num_traces = 0;
+  for (t_trace* tptr = routing_trace_head; tptr != nullptr;
+       tptr = tptr->next) {
+    trace_node_first_index.emplace(RRNodeId(tptr->index), num_traces);
+    num_traces++;
+  }
+  prev_nodes.reserve(num_traces);
+
+  /* Cache Previous nodes */
+  RRNodeId prev_node = RRNodeId::INVALID();
+
+  for (t_trace* tptr = routing_trace_head; tptr != nullptr;
+       tptr = tptr->next) {
+    RRNodeId rr_node = RRNodeId(tptr->index);
+
+    /* Find the right previous node */
+    prev_node = find_previous_node_from_routing_traces(
+      rr_graph, trace_node_first_index, prev_node, rr_node);
+
+    /* Only record mapped nodes */
+    if (prev_node) {
+      prev_nodes.push_back(std::make_pair(rr_node, prev_node));
+    }
+
+    /* Update prev_node */
+    prev_node = rr_node;
+  }
+
+  return prev_nodes;
+}
+
 /********************************************************************
  * Create a mapping between each rr_node and its previous node
  * based on VPR routing results
  * - Unmapped rr_node will have an invalid id of previous rr_node
+ *
+ * Nets are traversed in parallel, each in a single pass over its routing
+ * traces. The results are then applied in the order of nets, so that the
+ * annotation does not depend on the number of threads
  *******************************************************************/
 void annotate_rr_node_previous_nodes(
   const DeviceContext& device_ctx, const ClusteringContext& clustering_ctx,
   const RoutingContext& routing_ctx,
-  VprRoutingAnnotation& vpr_routing_annotation, const bool& verbose) {
+  VprRoutingAnnotation& vpr_routing_annotation, const size_t& num_threads,
+  const bool& verbose) {
   size_t counter = 0;
   VTR_LOG("Annotating previous nodes for rr_node...");
   VTR_LOGV(verbose, "\n");
 
+  std::vector<ClusterNetId> routed_nets;
   for (auto net_id : clustering_ctx.clb_nlist.nets()) {
     /* Ignore nets that are not routed */
     if (true == clustering_ctx.clb_nlist.net_is_ignored(net_id)) {
@@ -128,31 +171,22 @@ void annotate_rr_node_previous_nodes(
     if (false == clustering_ctx.clb_nlist.net_sinks(net_id).size()) {
       continue;
     }
+    routed_nets.push_back(net_id);
+  }
 
-    /* Cache Previous nodes */
-    RRNodeId prev_node = RRNodeId::INVALID();
-
-    t_trace* tptr = routing_ctx.trace[net_id].head;
-    while (tptr != nullptr) {
-      RRNodeId rr_node = RRNodeId(tptr->index);
-
-      /* Find the right previous node */
-      prev_node = find_previous_node_from_routing_traces(
-        device_ctx.rr_graph, routing_ctx.trace[net_id].head, prev_node,
-        rr_node);
-
-      /* Only update mapped nodes */
-      if (prev_node) {
-        vpr_routing_annotation.set_rr_node_prev_node(device_ctx.rr_graph,
-                                                     rr_node, prev_node);
-        counter++;
-      }
-
-      /* Update prev_node */
-      prev_node = rr_node;
-
-      /* Move on to the next */
-      tptr = tptr->next;
+  std::vector<std::vector<std::pair<RRNodeId, RRNodeId>>> net_prev_nodes(
+    routed_nets.size());
+  parallel_for_dynamic(
+    routed_nets.size(), num_threads, [&](const size_t& inet) {
+      net_prev_nodes[inet] = find_net_rr_node_previous_nodes(
+        device_ctx.rr_graph, routing_ctx.trace[routed_nets[inet]].head);
+    });
+
+  for (const auto& prev_nodes : net_prev_nodes) {
+    for (const auto& node_pair : prev_nodes) {
+      vpr_routing_annotation.set_rr_node_prev_node(
+        device_ctx.rr_graph, node_pair.first, node_pair.second);
+      counter++;
     }
   }
 
@@ -21,6 +21,7 @@ RRGSBWriterOption::RRGSBWriterOption() {
   unique_module_only_ = false;
   exclude_content_ = {false, false, false, false};
   include_gsb_names_.clear();
+  num_threads_ = 1;
   verbose_output_ = false;
   num_parse_errors_ = 0;
 }
@@ -50,10 +51,12 @@ bool RRGSBWriterOption::include_sb_content() const {
   return !exclude_content_[3];
 }
 
-std::vector<std::string> RRGSBWriterOption::include_gsb_names() const {
+const std::vector<std::string>& RRGSBWriterOption::include_gsb_names() const {
   return include_gsb_names_;
 }
 
+size_t RRGSBWriterOption::num_threads() const { return num_threads_; }
+
 bool RRGSBWriterOption::verbose_output() const { return verbose_output_; }
 
 /******************************************************************************
@@ -105,6 +108,10 @@ void RRGSBWriterOption::set_include_gsb_names(const std::string& content) {
   include_gsb_names_ = tokenizer.split(',');
 }
 
+void RRGSBWriterOption::set_num_threads(const size_t& num_threads) {
+  num_threads_ = num_threads;
+}
+
 void RRGSBWriterOption::set_verbose_output(const bool& enabled) {
   verbose_output_ = enabled;
 }
@@ -26,7 +26,8 @@ class RRGSBWriterOption {
   bool include_rr_info() const;
   bool include_cb_content(const t_rr_type& cb_type) const;
   bool include_sb_content() const;
-  std::vector<std::string> include_gsb_names() const;
+  const std::vector<std::string>& include_gsb_names() const;
+  size_t num_threads() const;
   bool verbose_output() const;
 
  public: /* Public mutators */
@@ -40,6 +41,7 @@ class RRGSBWriterOption {
    */
   void set_exclude_content(const std::string& content);
   void set_include_gsb_names(const std::string& gsb_names);
+  void set_num_threads(const size_t& num_threads);
   void set_verbose_output(const bool& enabled);
 
  public: /* Public validators */
@@ -61,6 +63,7 @@ class RRGSBWriterOption {
   std::array<bool, 4> exclude_content_;
 
   std::vector<std::string> include_gsb_names_;
+  size_t num_threads_;
   bool verbose_output_;
 
   /* A flag to indicate if the data parse is invalid or not */
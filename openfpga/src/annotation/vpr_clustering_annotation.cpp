@@ -20,17 +20,18 @@ VprClusteringAnnotation::VprClusteringAnnotation() { return; }
 bool VprClusteringAnnotation::is_net_renamed(const ClusterBlockId& block_id,
                                              const int& pin_index) const {
   /* Ensure that the block_id is in the list */
-  if (net_names_.end() == net_names_.find(block_id)) {
+  if (size_t(block_id) >= net_renamed_.size()) {
     return false;
   }
-  return (net_names_.at(block_id).end() !=
-          net_names_.at(block_id).find(pin_index));
+  const std::vector<bool>& pin_renamed = net_renamed_[block_id];
+  return (0 <= pin_index) && (size_t(pin_index) < pin_renamed.size()) &&
+         (true == pin_renamed[pin_index]);
 }
 
 ClusterNetId VprClusteringAnnotation::net(const ClusterBlockId& block_id,
                                           const int& pin_index) const {
   VTR_ASSERT(true == is_net_renamed(block_id, pin_index));
-  return net_names_.at(block_id).at(pin_index);
+  return net_names_[block_id][pin_index];
 }
 
 bool VprClusteringAnnotation::is_truth_table_adapted(t_pb* pb) const {
@@ -43,13 +44,15 @@ AtomNetlist::TruthTable VprClusteringAnnotation::truth_table(t_pb* pb) const {
   return block_truth_tables_.at(pb);
 }
 
-PhysicalPb VprClusteringAnnotation::physical_pb(
+const PhysicalPb& VprClusteringAnnotation::physical_pb(
   const ClusterBlockId& block_id) const {
-  if (physical_pbs_.end() == physical_pbs_.find(block_id)) {
-    return PhysicalPb();
+  if ((size_t(block_id) >= physical_pb_added_.size()) ||
+      (0 == physical_pb_added_[block_id])) {
+    static const PhysicalPb empty_physical_pb;
+    return empty_physical_pb;
   }
 
-  return physical_pbs_.at(block_id);
+  return physical_pbs_[block_id];
 }
 
 /************************************************************************
@@ -58,17 +61,28 @@ PhysicalPb VprClusteringAnnotation::physical_pb(
 void VprClusteringAnnotation::rename_net(const ClusterBlockId& block_id,
                                          const int& pin_index,
                                          const ClusterNetId& net_id) {
+  VTR_ASSERT(0 <= pin_index);
+
   /* Warn any override attempt */
-  if ((net_names_.end() != net_names_.find(block_id)) &&
-      (net_names_.at(block_id).end() !=
-       net_names_.at(block_id).find(pin_index))) {
+  if (true == is_net_renamed(block_id, pin_index)) {
     VTR_LOG_WARN(
       "Override the net '%ld' for block '%ld' pin '%d' with in clustering "
       "context annotation!\n",
       size_t(net_id), size_t(block_id), pin_index);
   }
 
-  net_names_[block_id][pin_index] = net_id;
+  if (size_t(block_id) >= net_names_.size()) {
+    net_names_.resize(size_t(block_id) + 1);
+    net_renamed_.resize(size_t(block_id) + 1);
+  }
+  std::vector<ClusterNetId>& pin_nets = net_names_[block_id];
+  std::vector<bool>& pin_renamed = net_renamed_[block_id];
+  if (size_t(pin_index) >= pin_nets.size()) {
+    pin_nets.resize(pin_index + 1, ClusterNetId::INVALID());
+    pin_renamed.resize(pin_index + 1, false);
+  }
+  pin_nets[pin_index] = net_id;
+  pin_renamed[pin_index] = true;
 }
 
 void VprClusteringAnnotation::adapt_truth_table(
@@ -87,23 +101,48 @@ void VprClusteringAnnotation::adapt_truth_table(
 void VprClusteringAnnotation::add_physical_pb(const ClusterBlockId& block_id,
                                               const PhysicalPb& physical_pb) {
   /* Warn any override attempt */
-  if (physical_pbs_.end() != physical_pbs_.find(block_id)) {
+  if ((size_t(block_id) < physical_pb_added_.size()) &&
+      (0 != physical_pb_added_[block_id])) {
     VTR_LOG_WARN(
       "Override the physical pb for clustered block %lu in clustering context "
       "annotation!\n",
       size_t(block_id));
   }
 
+  if (size_t(block_id) >= physical_pbs_.size()) {
+    physical_pbs_.resize(size_t(block_id) + 1);
+    physical_pb_added_.resize(size_t(block_id) + 1, 0);
+  }
   physical_pbs_[block_id] = physical_pb;
+  physical_pb_added_[block_id] = 1;
 }
 
 PhysicalPb& VprClusteringAnnotation::mutable_physical_pb(
   const ClusterBlockId& block_id) {
-  VTR_ASSERT(physical_pbs_.end() != physical_pbs_.find(block_id));
+  VTR_ASSERT((size_t(block_id) < physical_pb_added_.size()) &&
+             (0 != physical_pb_added_[block_id]));
 
-  return physical_pbs_.at(block_id);
+  return physical_pbs_[block_id];
 }
 
-void VprClusteringAnnotation::clear_net_remapping() { net_names_.clear(); }
+void VprClusteringAnnotation::init_physical_pbs(
+  const ClusteredNetlist& clb_nlist) {
+  size_t num_blocks = clb_nlist.blocks().size();
+  physical_pbs_.clear();
+  physical_pbs_.resize(num_blocks);
+  physical_pb_added_.assign(num_blocks, 1);
+}
+
+void VprClusteringAnnotation::clear_net_remapping() {
+  net_names_.clear();
+  net_renamed_.clear();
+}
+
+void VprClusteringAnnotation::init_net_remapping(
+  const ClusteredNetlist& clb_nlist) {
+  clear_net_remapping();
+  net_names_.resize(clb_nlist.blocks().size());
+  net_renamed_.resize(clb_nlist.blocks().size());
+}
 
 } /* End namespace openfpga*/
@@ -4,11 +4,13 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
-#include <map>
+#include <unordered_map>
+#include <vector>
 
 /* Header from vpr library */
 #include "clustered_netlist.h"
 #include "physical_pb.h"
+#include "vtr_vector.h"
 
 /* Begin namespace openfpga */
 namespace openfpga {
@@ -37,7 +39,7 @@ class VprClusteringAnnotation {
   ClusterNetId net(const ClusterBlockId& block_id, const int& pin_index) const;
   bool is_truth_table_adapted(t_pb* pb) const;
   AtomNetlist::TruthTable truth_table(t_pb* pb) const;
-  PhysicalPb physical_pb(const ClusterBlockId& block_id) const;
+  const PhysicalPb& physical_pb(const ClusterBlockId& block_id) const;
 
  public: /* Public mutators */
   void rename_net(const ClusterBlockId& block_id, const int& pin_index,
@@ -46,17 +48,30 @@ class VprClusteringAnnotation {
   void add_physical_pb(const ClusterBlockId& block_id,
                        const PhysicalPb& physical_pb);
   PhysicalPb& mutable_physical_pb(const ClusterBlockId& block_id);
+  /* Allocate an empty physical pb for each clustered block. Afterwards, the
+   * physical pbs of different blocks can be built in place in parallel,
+   * through mutable_physical_pb() */
+  void init_physical_pbs(const ClusteredNetlist& clb_nlist);
 
  public: /* Clean-up */
   void clear_net_remapping();
+  /* Clear the net remapping and allocate it for each clustered block.
+   * Afterwards, the nets of different blocks can be renamed in parallel */
+  void init_net_remapping(const ClusteredNetlist& clb_nlist);
 
  private: /* Internal data */
-  /* Pair a regular pb_type to its physical pb_type */
-  std::map<ClusterBlockId, std::map<int, ClusterNetId>> net_names_;
-  std::map<t_pb*, AtomNetlist::TruthTable> block_truth_tables_;
+  /* Renamed nets of the pins of each clustered block, indexed by pins.
+   * A pin is renamed only if its flag is set, as a net may be renamed to an
+   * invalid id */
+  vtr::vector<ClusterBlockId, std::vector<ClusterNetId>> net_names_;
+  vtr::vector<ClusterBlockId, std::vector<bool>> net_renamed_;
+  std::unordered_map<t_pb*, AtomNetlist::TruthTable> block_truth_tables_;
 
   /* Link clustered blocks to physical pb (mapping results) */
-  std::map<ClusterBlockId, PhysicalPb> physical_pbs_;
+  vtr::vector<ClusterBlockId, PhysicalPb> physical_pbs_;
+  /* Flags of the blocks which own a physical pb. Not a vector of bool, so that
+   * different blocks can be flagged in parallel */
+  vtr::vector<ClusterBlockId, char> physical_pb_added_;
 };
 
 } /* End namespace openfpga*/
@@ -3,12 +3,17 @@
  ***********************************************************************/
 #include "vpr_netlist_annotation.h"
 
+#include <limits>
+
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
 /* namespace openfpga begins */
 namespace openfpga {
 
+/* Index of the name pool for blocks and nets which are not renamed */
+constexpr size_t INVALID_NAME_ID = std::numeric_limits<size_t>::max();
+
 /************************************************************************
  * Constructors
  ***********************************************************************/
@@ -18,26 +23,26 @@ VprNetlistAnnotation::VprNetlistAnnotation() { return; }
  * Public accessors
  ***********************************************************************/
 bool VprNetlistAnnotation::is_block_renamed(const AtomBlockId& block) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<AtomBlockId, std::string>::const_iterator it =
-    block_names_.find(block);
-  return it != block_names_.end();
+  /* Ensure that the block is in the list */
+  return (size_t(block) < block_name_ids_.size()) &&
+         (INVALID_NAME_ID != block_name_ids_[block]);
 }
 
-std::string VprNetlistAnnotation::block_name(const AtomBlockId& block) const {
+const std::string& VprNetlistAnnotation::block_name(
+  const AtomBlockId& block) const {
   VTR_ASSERT(true == is_block_renamed(block));
-  return block_names_.at(block);
+  return name_pool_[block_name_ids_[block]];
 }
 
 bool VprNetlistAnnotation::is_net_renamed(const AtomNetId& net) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<AtomNetId, std::string>::const_iterator it = net_names_.find(net);
-  return it != net_names_.end();
+  /* Ensure that the net is in the list */
+  return (size_t(net) < net_name_ids_.size()) &&
+         (INVALID_NAME_ID != net_name_ids_[net]);
 }
 
-std::string VprNetlistAnnotation::net_name(const AtomNetId& net) const {
+const std::string& VprNetlistAnnotation::net_name(const AtomNetId& net) const {
   VTR_ASSERT(true == is_net_renamed(net));
-  return net_names_.at(net);
+  return name_pool_[net_name_ids_[net]];
 }
 
 /************************************************************************
@@ -45,27 +50,43 @@ std::string VprNetlistAnnotation::net_name(const AtomNetId& net) const {
  ***********************************************************************/
 void VprNetlistAnnotation::rename_block(const AtomBlockId& block,
                                         const std::string& name) {
+  VTR_ASSERT(true == bool(block));
   /* Warn any override attempt */
-  std::map<AtomBlockId, std::string>::const_iterator it =
-    block_names_.find(block);
-  if (it != block_names_.end()) {
+  if (true == is_block_renamed(block)) {
     VTR_LOG_WARN("Override the block with name '%s' in netlist annotation!\n",
                  name.c_str());
   }
 
-  block_names_[block] = name;
+  if (size_t(block) >= block_name_ids_.size()) {
+    block_name_ids_.resize(size_t(block) + 1, INVALID_NAME_ID);
+  }
+  block_name_ids_[block] = intern_name(name);
 }
 
 void VprNetlistAnnotation::rename_net(const AtomNetId& net,
                                       const std::string& name) {
+  VTR_ASSERT(true == bool(net));
   /* Warn any override attempt */
-  std::map<AtomNetId, std::string>::const_iterator it = net_names_.find(net);
-  if (it != net_names_.end()) {
+  if (true == is_net_renamed(net)) {
     VTR_LOG_WARN("Override the net with name '%s' in netlist annotation!\n",
                  name.c_str());
   }
 
-  net_names_[net] = name;
+  if (size_t(net) >= net_name_ids_.size()) {
+    net_name_ids_.resize(size_t(net) + 1, INVALID_NAME_ID);
+  }
+  net_name_ids_[net] = intern_name(name);
+}
+
+/************************************************************************
+ * Internal utility
+ ***********************************************************************/
+size_t VprNetlistAnnotation::intern_name(const std::string& name) {
+  auto result = name_pool_ids_.emplace(name, name_pool_.size());
+  if (true == result.second) {
+    name_pool_.push_back(name);
+  }
+  return result.first->second;
 }
 
 } /* End namespace openfpga*/
@@ -4,10 +4,13 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
-#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 /* Header from vpr library */
 #include "atom_netlist.h"
+#include "vtr_vector.h"
 
 /* Begin namespace openfpga */
 namespace openfpga {
@@ -27,18 +30,26 @@ class VprNetlistAnnotation {
 
  public: /* Public accessors */
   bool is_block_renamed(const AtomBlockId& block) const;
-  std::string block_name(const AtomBlockId& block) const;
+  const std::string& block_name(const AtomBlockId& block) const;
   bool is_net_renamed(const AtomNetId& net) const;
-  std::string net_name(const AtomNetId& net) const;
+  const std::string& net_name(const AtomNetId& net) const;
 
  public: /* Public mutators */
   void rename_block(const AtomBlockId& block, const std::string& name);
   void rename_net(const AtomNetId& net, const std::string& name);
 
+ private: /* Internal utility */
+  size_t intern_name(const std::string& name);
+
  private: /* Internal data */
-  /* Pair a regular pb_type to its physical pb_type */
-  std::map<AtomBlockId, std::string> block_names_;
-  std::map<AtomNetId, std::string> net_names_;
+  /* New names of the renamed blocks and nets, as indices of the name pool.
+   * Blocks and nets which are not renamed have an invalid index */
+  vtr::vector<AtomBlockId, size_t> block_name_ids_;
+  vtr::vector<AtomNetId, size_t> net_name_ids_;
+
+  /* Pool of unique names, as fixed-up names are frequently shared */
+  std::vector<std::string> name_pool_;
+  std::unordered_map<std::string, size_t> name_pool_ids_;
 };
 
 } /* End namespace openfpga*/
@@ -8,8 +8,10 @@
 
 /* Headers from openfpgautil library */
 #include "build_routing_module_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "openfpga_rr_graph_utils.h"
 #include "openfpga_side_manager.h"
 #include "write_xml_device_rr_gsb.h"
@@ -41,7 +43,7 @@ static void write_rr_gsb_ipin_connection_to_xml(std::fstream& fp,
     }
     std::vector<RREdgeId> driver_rr_edges =
       rr_gsb.get_ipin_node_in_edges(rr_graph, gsb_side, inode);
-    fp << "\" mux_size=\"" << driver_rr_edges.size() << "\">" << std::endl;
+    fp << "\" mux_size=\"" << driver_rr_edges.size() << "\">" << '\n';
     /* General information of each driving nodes */
     for (const RREdgeId& edge : driver_rr_edges) {
       RRNodeId driver_node = rr_graph.edge_src_node(edge);
@@ -72,10 +74,10 @@ static void write_rr_gsb_ipin_connection_to_xml(std::fstream& fp,
         fp << "\" node_id=\"" << size_t(driver_node);
       }
       fp << "\" index=\"" << driver_node_index << "\" segment_id=\""
-         << size_t(des_segment_id) << "\"/>" << std::endl;
+         << size_t(des_segment_id) << "\"/>" << '\n';
     }
     fp << "\t</" << rr_node_typename[rr_graph.node_type(cur_rr_node)] << ">"
-       << std::endl;
+       << '\n';
   }
 }
 
@@ -128,7 +130,7 @@ static void write_rr_gsb_chan_connection_to_xml(
          << generate_sb_module_track_port_name(cur_node_type, gsb_side,
                                                OUT_PORT);
     }
-    fp << "\">" << std::endl;
+    fp << "\">" << '\n';
 
     /* Direct connection: output the node on the opposite side */
     if (0 == driver_rr_edges.size()) {
@@ -145,7 +147,7 @@ static void write_rr_gsb_chan_connection_to_xml(
            << generate_sb_module_track_port_name(cur_node_type,
                                                  oppo_side.get_side(), IN_PORT);
       }
-      fp << "\"/>" << std::endl;
+      fp << "\"/>" << '\n';
     } else {
       for (const RREdgeId& driver_rr_edge : driver_rr_edges) {
         const RRNodeId& driver_rr_node = rr_graph.edge_src_node(driver_rr_edge);
@@ -169,7 +171,7 @@ static void write_rr_gsb_chan_connection_to_xml(
                     gsb_side, driver_node_side, vpr_device_grid,
                     vpr_device_annotation, rr_graph, driver_rr_node);
           }
-          fp << "\"/>" << std::endl;
+          fp << "\"/>" << '\n';
         } else {
           const RRSegmentId& des_segment_id =
             rr_gsb.get_chan_node_segment(driver_node_side, driver_node_index);
@@ -187,12 +189,12 @@ static void write_rr_gsb_chan_connection_to_xml(
                     rr_graph.node_type(driver_rr_node), driver_side.get_side(),
                     IN_PORT);
           }
-          fp << "\"/>" << std::endl;
+          fp << "\"/>" << '\n';
         }
       }
     }
     fp << "\t</" << rr_node_typename[rr_graph.node_type(cur_rr_node)] << ">"
-       << std::endl;
+       << '\n';
   }
 }
 
@@ -212,7 +214,8 @@ static void write_rr_switch_block_to_xml(
   fname += ".xml";
 
   /* If there is a list of gsb list, we skip those which are not in the list */
-  std::vector<std::string> include_gsb_names = options.include_gsb_names();
+  const std::vector<std::string>& include_gsb_names =
+    options.include_gsb_names();
   if (!include_gsb_names.empty() &&
       include_gsb_names.end() == std::find(include_gsb_names.begin(),
                                            include_gsb_names.end(),
@@ -225,7 +228,7 @@ static void write_rr_switch_block_to_xml(
            fname.c_str());
 
   /* Create a file handler*/
-  std::fstream fp;
+  BufferedFileStream fp;
   /* Open a file */
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
@@ -234,7 +237,7 @@ static void write_rr_switch_block_to_xml(
 
   /* Output location of the Switch Block */
   fp << "<rr_sb x=\"" << rr_gsb.get_x() << "\" y=\"" << rr_gsb.get_y() << "\""
-     << " num_sides=\"" << rr_gsb.get_num_sides() << "\">" << std::endl;
+     << " num_sides=\"" << rr_gsb.get_num_sides() << "\">" << '\n';
 
   /* Output each side */
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
@@ -247,7 +250,7 @@ static void write_rr_switch_block_to_xml(
                                         gsb_side, options.include_rr_info());
   }
 
-  fp << "</rr_sb>" << std::endl;
+  fp << "</rr_sb>" << '\n';
 
   /* close a file */
   fp.close();
@@ -272,7 +275,8 @@ static void write_rr_connection_block_to_xml(const std::string fname_prefix,
   fname += ".xml";
 
   /* If there is a list of gsb list, we skip those which are not in the list */
-  std::vector<std::string> include_gsb_names = options.include_gsb_names();
+  const std::vector<std::string>& include_gsb_names =
+    options.include_gsb_names();
   if (!include_gsb_names.empty() &&
       include_gsb_names.end() == std::find(include_gsb_names.begin(),
                                            include_gsb_names.end(),
@@ -285,7 +289,7 @@ static void write_rr_connection_block_to_xml(const std::string fname_prefix,
            fname.c_str());
 
   /* Create a file handler*/
-  std::fstream fp;
+  BufferedFileStream fp;
   /* Open a file */
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
@@ -295,7 +299,7 @@ static void write_rr_connection_block_to_xml(const std::string fname_prefix,
   /* Output location of the Switch Block */
   fp << "<rr_cb x=\"" << rr_gsb.get_cb_x(cb_type) << "\" y=\""
      << rr_gsb.get_cb_y(cb_type) << "\""
-     << " num_sides=\"" << rr_gsb.get_num_sides() << "\">" << std::endl;
+     << " num_sides=\"" << rr_gsb.get_num_sides() << "\">" << '\n';
 
   /* Output each side */
   for (e_side side : rr_gsb.get_cb_ipin_sides(cb_type)) {
@@ -304,7 +308,80 @@ static void write_rr_connection_block_to_xml(const std::string fname_prefix,
                                         options.include_rr_info());
   }
 
-  fp << "</rr_cb>" << std::endl;
+  fp << "</rr_cb>" << '\n';
+
+  /* close a file */
+  fp.close();
+}
+
+/***************************************************************************************
+ * Output the index from the coordinate of each switch block and connection
+ * block to its unique module, when only unique modules are outputted
+ ***************************************************************************************/
+static void write_rr_gsb_unique_index_to_xml(const std::string& fname_prefix,
+                                             const DeviceRRGSB& device_rr_gsb,
+                                             const RRGSBWriterOption& options) {
+  std::string fname = fname_prefix + std::string("gsb_unique_index.xml");
+
+  VTR_LOGV(options.verbose_output(),
+           "Output index of unique General Switch Blocks to '%s'\n",
+           fname.c_str());
+
+  /* Create a file handler*/
+  BufferedFileStream fp;
+  /* Open a file */
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  /* Validate the file stream */
+  check_file_stream(fname.c_str(), fp);
+
+  fp << "<gsb_unique_index>" << '\n';
+
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      vtr::Point<size_t> gsb_coordinate(ix, iy);
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coordinate);
+      if (options.include_sb_content()) {
+        vtr::Point<size_t> sb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+        const RRGSB& unique_gsb =
+          device_rr_gsb.get_sb_unique_module(gsb_coordinate);
+        vtr::Point<size_t> unique_coordinate(unique_gsb.get_sb_x(),
+                                             unique_gsb.get_sb_y());
+        fp << "\t<sb x=\"" << sb_coordinate.x() << "\" y=\""
+           << sb_coordinate.y() << "\" name=\""
+           << generate_switch_block_module_name(sb_coordinate)
+           << "\" unique_id=\""
+           << device_rr_gsb.get_sb_unique_module_index(gsb_coordinate)
+           << "\" unique_name=\""
+           << generate_switch_block_module_name(unique_coordinate) << "\"/>"
+           << '\n';
+      }
+      for (t_rr_type cb_type : {CHANX, CHANY}) {
+        if ((!options.include_cb_content(cb_type)) ||
+            (false == rr_gsb.is_cb_exist(cb_type))) {
+          continue;
+        }
+        vtr::Point<size_t> cb_coordinate(rr_gsb.get_cb_x(cb_type),
+                                         rr_gsb.get_cb_y(cb_type));
+        const RRGSB& unique_gsb =
+          device_rr_gsb.get_cb_unique_module(cb_type, gsb_coordinate);
+        vtr::Point<size_t> unique_coordinate(unique_gsb.get_cb_x(cb_type),
+                                             unique_gsb.get_cb_y(cb_type));
+        std::string cb_tag = (CHANX == cb_type) ? "cbx" : "cby";
+        fp << "\t<" << cb_tag << " x=\"" << cb_coordinate.x() << "\" y=\""
+           << cb_coordinate.y() << "\" name=\""
+           << generate_connection_block_module_name(cb_type, cb_coordinate)
+           << "\" unique_id=\""
+           << device_rr_gsb.get_cb_unique_module_index(cb_type, gsb_coordinate)
+           << "\" unique_name=\""
+           << generate_connection_block_module_name(cb_type, unique_coordinate)
+           << "\"/>" << '\n';
+      }
+    }
+  }
+
+  fp << "</gsb_unique_index>" << '\n';
 
   /* close a file */
   fp.close();
@@ -313,6 +390,9 @@ static void write_rr_connection_block_to_xml(const std::string fname_prefix,
 /***************************************************************************************
  * Output internal structure (only the switch block part) of all the RRGSBs
  * in a DeviceRRGSB  to XML format
+ *
+ * Each block is written to its own file, so that the files are written
+ * concurrently with the number of threads given by the options
  ***************************************************************************************/
 void write_device_rr_gsb_to_xml(
   const DeviceGrid& vpr_device_grid,
@@ -330,7 +410,8 @@ void write_device_rr_gsb_to_xml(
   std::map<t_rr_type, std::string> cb_names = {{CHANX, "X-direction"},
                                                {CHANY, "Y-direction"}};
 
-  std::vector<std::string> include_gsb_names = options.include_gsb_names();
+  /* Collect the XML files to be written, each of which is independent */
+  ParallelTaskGroup write_tasks(options.num_threads());
 
   /* For each switch block, an XML file will be outputted */
   if (options.unique_module_only()) {
@@ -341,9 +422,11 @@ void write_device_rr_gsb_to_xml(
       const RRGSB& rr_gsb = device_rr_gsb.get_sb_unique_module(igsb);
       /* Write CBx, CBy, SB on need */
       if (options.include_sb_content()) {
-        write_rr_switch_block_to_xml(xml_dir_name, vpr_device_grid,
-                                     vpr_device_annotation, rr_graph, rr_gsb,
-                                     options);
+        write_tasks.run([&]() {
+          write_rr_switch_block_to_xml(xml_dir_name, vpr_device_grid,
+                                       vpr_device_annotation, rr_graph,
+                                       rr_gsb, options);
+        });
       }
       sb_counter++;
     }
@@ -352,12 +435,18 @@ void write_device_rr_gsb_to_xml(
            igsb < device_rr_gsb.get_num_cb_unique_module(cb_type); ++igsb) {
         const RRGSB& rr_gsb = device_rr_gsb.get_cb_unique_module(cb_type, igsb);
         if (options.include_cb_content(cb_type)) {
-          write_rr_connection_block_to_xml(xml_dir_name, rr_graph, rr_gsb,
-                                           cb_type, options);
+          write_tasks.run([&, cb_type]() {
+            write_rr_connection_block_to_xml(xml_dir_name, rr_graph, rr_gsb,
+                                             cb_type, options);
+          });
           cb_counters[cb_type]++;
         }
       }
     }
+    /* Map the coordinates of all the blocks to the unique modules */
+    write_tasks.run([&]() {
+      write_rr_gsb_unique_index_to_xml(xml_dir_name, device_rr_gsb, options);
+    });
   } else {
     /* Output all GSB instances in the fabric (some instances may share the same
      * module) */
@@ -366,15 +455,19 @@ void write_device_rr_gsb_to_xml(
         const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
         /* Write CBx, CBy, SB on need */
         if (options.include_sb_content()) {
-          write_rr_switch_block_to_xml(xml_dir_name, vpr_device_grid,
-                                       vpr_device_annotation, rr_graph, rr_gsb,
-                                       options);
+          write_tasks.run([&]() {
+            write_rr_switch_block_to_xml(xml_dir_name, vpr_device_grid,
+                                         vpr_device_annotation, rr_graph,
+                                         rr_gsb, options);
+          });
           sb_counter++;
         }
         for (t_rr_type cb_type : {CHANX, CHANY}) {
           if (options.include_cb_content(cb_type)) {
-            write_rr_connection_block_to_xml(xml_dir_name, rr_graph, rr_gsb,
-                                             cb_type, options);
+            write_tasks.run([&, cb_type]() {
+              write_rr_connection_block_to_xml(xml_dir_name, rr_graph, rr_gsb,
+                                               cb_type, options);
+            });
             cb_counters[cb_type]++;
           }
         }
@@ -382,6 +475,8 @@ void write_device_rr_gsb_to_xml(
     }
   }
 
+  write_tasks.wait();
+
   VTR_LOG("Output %lu Switch blocks to XML files under directory '%s'\n",
           sb_counter, xml_dir_name.c_str());
   for (t_rr_type cb_type : {CHANX, CHANY}) {
@@ -3,6 +3,7 @@
  * - exit
  * - version
  * - help
+ * - write_profile
  *******************************************************************/
 #include "basic_command.h"
 
@@ -80,6 +81,36 @@ static ShellCommandId add_openfpga_source_command(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: write_profile
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+static ShellCommandId add_openfpga_write_profile_command(
+  openfpga::Shell<OpenfpgaContext>& shell,
+  const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("write_profile");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option(
+    "file", true, "Specify the JSON file to write the command profiles");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add command to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Write the runtime and memory profiles of executed commands to a file");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, write_command_profile);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 void add_basic_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   /* Add a new class of commands */
   ShellCommandClassId basic_cmd_class = shell.add_command_class("Basic");
@@ -88,8 +119,15 @@ void add_basic_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   ShellCommandId shell_cmd_exit_id =
     shell.add_command(shell_cmd_exit, "Exit the shell");
   shell.set_command_class(shell_cmd_exit_id, basic_cmd_class);
-  shell.set_command_execute_function(shell_cmd_exit_id,
-                                     [shell]() { shell.exit(); });
+  /* Quit the shell itself rather than a snapshot of it, so that the
+   * timer and the command profiles are up-to-date */
+  shell.set_command_execute_function(
+    shell_cmd_exit_id,
+    [](openfpga::Shell<OpenfpgaContext>* exit_shell, OpenfpgaContext&,
+       const Command&, const CommandContext&) {
+      exit_shell->exit();
+      return CMD_EXEC_SUCCESS;
+    });
 
   /* Version */
   Command shell_cmd_version("version");
@@ -115,6 +153,10 @@ void add_basic_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   add_openfpga_ext_exec_command(shell, basic_cmd_class,
                                 std::vector<ShellCommandId>());
 
+  /* Add 'write_profile' command which outputs the command profiles */
+  add_openfpga_write_profile_command(shell, basic_cmd_class,
+                                     std::vector<ShellCommandId>());
+
   /* Note:
    * help MUST be the last to add because the linking to execute function will
    * do a snapshot on the shell
@@ -32,6 +32,13 @@ bool IoMap::is_io_input(IoMapId io_map_id) const {
   return IoMap::IO_MAP_DIR_INPUT == io_directionality_[io_map_id];
 }
 
+void IoMap::reserve_io_mappings(const size_t& num_io_mappings) {
+  io_map_ids_.reserve(num_io_mappings);
+  io_ports_.reserve(num_io_mappings);
+  mapped_nets_.reserve(num_io_mappings);
+  io_directionality_.reserve(num_io_mappings);
+}
+
 IoMapId IoMap::create_io_mapping(const BasicPort& port, const BasicPort& net,
                                  IoMap::e_direction dir) {
   /* Create a new id */
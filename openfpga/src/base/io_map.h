@@ -43,6 +43,8 @@ class IoMap {
   bool is_io_output(IoMapId io_map_id) const;
 
  public: /* Public mutators */
+  /* Reserve memory for a number of I/O mappings */
+  void reserve_io_mappings(const size_t& num_io_mappings);
   /* Create a new I/O mapping */
   IoMapId create_io_mapping(const BasicPort& port, const BasicPort& net,
                             e_direction dir);
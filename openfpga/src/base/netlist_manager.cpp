@@ -76,6 +76,13 @@ NetlistId NetlistManager::find_module_netlist(const ModuleId& module) const {
   return module_netlist_map_.at(module);
 }
 
+/* Find if the file of a netlist has been changed when it is written.
+ * A netlist is considered as changed unless it is marked otherwise */
+bool NetlistManager::netlist_changed(const NetlistId& netlist) const {
+  VTR_ASSERT(true == valid_netlist_id(netlist));
+  return netlist_changed_[netlist];
+}
+
 std::vector<NetlistId> NetlistManager::netlists_by_type(
   const NetlistManager::e_netlist_type& netlist_type) const {
   std::vector<NetlistId> nlists;
@@ -123,6 +130,7 @@ NetlistId NetlistManager::add_netlist(const std::string& name) {
   /* Allocate related attributes */
   netlist_names_.push_back(name);
   netlist_types_.push_back(NUM_NETLIST_TYPES);
+  netlist_changed_.push_back(true);
   included_module_ids_.emplace_back();
   included_preprocessing_flag_ids_.emplace_back();
 
@@ -138,6 +146,12 @@ void NetlistManager::set_netlist_type(const NetlistId& netlist,
   netlist_types_[netlist] = type;
 }
 
+void NetlistManager::set_netlist_changed(const NetlistId& netlist,
+                                         const bool& changed) {
+  VTR_ASSERT(true == valid_netlist_id(netlist));
+  netlist_changed_[netlist] = changed;
+}
+
 /* Add a module to a netlist in the library */
 bool NetlistManager::add_netlist_module(const NetlistId& netlist,
                                         const ModuleId& module) {
@@ -200,6 +214,23 @@ void NetlistManager::add_netlist_preprocessing_flag(
   }
 }
 
+void NetlistManager::add_netlists(const NetlistManager& other) {
+  for (const NetlistId& other_netlist : other.netlists()) {
+    NetlistId netlist = add_netlist(other.netlist_name(other_netlist));
+    /* Netlist names must be unique across the netlist managers */
+    VTR_ASSERT(true == valid_netlist_id(netlist));
+    set_netlist_type(netlist, other.netlist_type(other_netlist));
+    set_netlist_changed(netlist, other.netlist_changed(other_netlist));
+    for (const ModuleId& module : other.netlist_modules(other_netlist)) {
+      add_netlist_module(netlist, module);
+    }
+    for (const std::string& flag :
+         other.netlist_preprocessing_flags(other_netlist)) {
+      add_netlist_preprocessing_flag(netlist, flag);
+    }
+  }
+}
+
 /******************************************************************************
  * Public validators/invalidators
  ******************************************************************************/
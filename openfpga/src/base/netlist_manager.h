@@ -40,6 +40,9 @@ class NetlistManager {
     LOGIC_BLOCK_NETLIST,
     ROUTING_MODULE_NETLIST,
     TOP_MODULE_NETLIST,
+    /* Netlists included by the top module netlist, rather than by the
+     * netlist of all the fabric netlists */
+    TOP_MODULE_SLICE_NETLIST,
     TESTBENCH_NETLIST,
     NUM_NETLIST_TYPES
   };
@@ -72,17 +75,25 @@ class NetlistManager {
                             const ModuleId& module) const;
   /* Find the netlist that a module belongs to */
   NetlistId find_module_netlist(const ModuleId& module) const;
+  /* Find if the file of a netlist has been changed when it is written */
+  bool netlist_changed(const NetlistId& netlist) const;
 
  public: /* Public mutators */
   /* Add a netlist to the library */
   NetlistId add_netlist(const std::string& name);
   /* Set a netlist type */
   void set_netlist_type(const NetlistId& netlist, const e_netlist_type& type);
+  /* Mark if the file of a netlist has been changed */
+  void set_netlist_changed(const NetlistId& netlist, const bool& changed);
   /* Add a module to a netlist in the library */
   bool add_netlist_module(const NetlistId& netlist, const ModuleId& module);
   /* Add a pre-processing flag to a netlist */
   void add_netlist_preprocessing_flag(const NetlistId& netlist,
                                       const std::string& preprocessing_flag);
+  /* Add all the netlists of another netlist manager, in the sequence of
+   * its netlists, including their types, modules, pre-processing flags
+   * and whether they have been changed */
+  void add_netlists(const NetlistManager& other);
 
  public: /* Public validators/invalidators */
   bool valid_netlist_id(const NetlistId& netlist) const;
@@ -96,6 +107,7 @@ class NetlistManager {
   vtr::vector<NetlistId, NetlistId> netlist_ids_;
   vtr::vector<NetlistId, std::string> netlist_names_;
   vtr::vector<NetlistId, e_netlist_type> netlist_types_;
+  vtr::vector<NetlistId, bool> netlist_changed_;
 
   vtr::vector<NetlistId, std::vector<ModuleId>> included_module_ids_;
   vtr::vector<NetlistId, std::vector<PreprocessingFlagId>>
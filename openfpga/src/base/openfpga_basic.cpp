@@ -72,4 +72,15 @@ int call_external_command(const Command& cmd,
   return system(cmd_ss.c_str());
 }
 
+/** Write the profiling results of the commands which have been executed */
+int write_command_profile(openfpga::Shell<OpenfpgaContext>* shell,
+                          OpenfpgaContext& /* openfpga_ctx */,
+                          const Command& cmd,
+                          const CommandContext& cmd_context) {
+  CommandOptionId opt_file = cmd.option("file");
+
+  return shell->write_command_profiles(
+    cmd_context.option_value(cmd, opt_file));
+}
+
 } /* end namespace openfpga */
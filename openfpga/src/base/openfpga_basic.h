@@ -23,6 +23,10 @@ int source_existing_command(openfpga::Shell<OpenfpgaContext>* shell,
 int call_external_command(const Command& cmd,
                           const CommandContext& cmd_context);
 
+int write_command_profile(openfpga::Shell<OpenfpgaContext>* shell,
+                          OpenfpgaContext& openfpga_ctx, const Command& cmd,
+                          const CommandContext& cmd_context);
+
 } /* end namespace openfpga */
 
 #endif
@@ -7,6 +7,7 @@
  * - repack : create physical pbs and redo packing
  *******************************************************************/
 #include "openfpga_bitstream_template.h"
+#include "openfpga_link_arch_stage_template.h"
 #include "openfpga_repack_template.h"
 #include "shell.h"
 
@@ -38,6 +39,21 @@ ShellCommandId add_repack_command_template(
   shell_cmd.set_option_require_value(opt_ignore_global_nets,
                                      openfpga::OPT_STRING);
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to build the routing resource graphs of logical "
+    "tiles and to repack the clustered blocks. Use 0 to use all the available "
+    "threads. By default, the number of threads of the shell is used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
+  /* Add an option '--stats_file' */
+  CommandOptionId opt_stats_file = shell_cmd.add_option(
+    "stats_file", false,
+    "file path to report the statistics of repacking each clustered block in "
+    "CSV format");
+  shell_cmd.set_option_require_value(opt_stats_file, openfpga::OPT_STRING);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -47,6 +63,12 @@ ShellCommandId add_repack_command_template(
   shell.set_command_class(shell_cmd_id, cmd_class_id);
   shell.set_command_execute_function(shell_cmd_id, repack_template<T>);
 
+  /* Run the deferred annotation which the command requires */
+  shell.set_command_prerequisite(shell_cmd_id, [](T& openfpga_ctx) {
+    return require_link_arch_stages_template<T>(openfpga_ctx,
+                                                {LINK_ARCH_BITSTREAM_SETTING});
+  });
+
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
 
@@ -74,10 +96,39 @@ ShellCommandId add_build_arch_bitstream_command_template(
     "read_file", false, "file path to read the bitstream database");
   shell_cmd.set_option_require_value(opt_read_file, openfpga::OPT_STRING);
 
+  /* Add an option '--format' */
+  CommandOptionId opt_file_format = shell_cmd.add_option(
+    "format", false,
+    "file format of the bitstream database to read and write [xml|binary]. "
+    "Default: xml");
+  shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
+
   /* Add an option '--no_time_stamp' */
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
 
+  /* Add an option '--no_net_ids' */
+  shell_cmd.add_option(
+    "no_net_ids", false,
+    "Do not record the nets of blocks in the bitstream database, which saves "
+    "time and memory, and do not write the nets and path ids of blocks to "
+    "the XML file of the bitstream database");
+
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to build the bitstream. Use 0 to use all the "
+    "available threads. By default, the number of threads of the shell is "
+    "used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
+  /* Add an option '--incremental' */
+  shell_cmd.add_option(
+    "incremental", false,
+    "Rebuild only the grids and routing blocks whose VPR results are "
+    "changed since the last run with this option, and update the existing "
+    "bitstream database in place");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -87,6 +138,12 @@ ShellCommandId add_build_arch_bitstream_command_template(
   shell.set_command_class(shell_cmd_id, cmd_class_id);
   shell.set_command_execute_function(shell_cmd_id, fpga_bitstream_template<T>);
 
+  /* Run the deferred annotation which the command requires */
+  shell.set_command_prerequisite(shell_cmd_id, [](T& openfpga_ctx) {
+    return require_link_arch_stages_template<T>(
+      openfpga_ctx, {LINK_ARCH_ROUTING_RESULTS, LINK_ARCH_BITSTREAM_SETTING});
+  });
+
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
 
@@ -120,6 +177,14 @@ ShellCommandId add_report_bitstream_distribution_command_template(
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to count the bits of tiles. Use 0 to use all the "
+    "available threads. By default, the number of threads of the shell is "
+    "used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -136,6 +201,55 @@ ShellCommandId add_report_bitstream_distribution_command_template(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: report_bitstream_tile
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_report_bitstream_tile_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("report_bitstream_tile");
+
+  /* Add an option '--type' */
+  CommandOptionId opt_type = shell_cmd.add_option(
+    "type", false, "Type of the tile [grid|sb|cbx|cby]. Default: grid");
+  shell_cmd.set_option_require_value(opt_type, openfpga::OPT_STRING);
+
+  /* Add an option '--x' */
+  CommandOptionId opt_x =
+    shell_cmd.add_option("x", true, "X coordinate of the tile");
+  shell_cmd.set_option_require_value(opt_x, openfpga::OPT_INT);
+
+  /* Add an option '--y' */
+  CommandOptionId opt_y =
+    shell_cmd.add_option("y", true, "Y coordinate of the tile");
+  shell_cmd.set_option_require_value(opt_y, openfpga::OPT_INT);
+
+  /* Add an option '--subtile' */
+  CommandOptionId opt_subtile = shell_cmd.add_option(
+    "subtile", false,
+    "Subtile of a grid. By default, all the subtiles are reported");
+  shell_cmd.set_option_require_value(opt_subtile, openfpga::OPT_INT);
+
+  /* Add an option '--show_values' */
+  shell_cmd.add_option("show_values", false,
+                       "Show the values of the configuration bits");
+
+  /* Add command 'report_bitstream_tile' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd, "Report the configuration bits of a tile", hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id,
+                                     report_bitstream_tile_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 /********************************************************************
  * - Add a command to Shell environment: build_fabric_bitstream
  * - Add associated options
@@ -147,6 +261,27 @@ ShellCommandId add_build_fabric_bitstream_command_template(
   const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
   Command shell_cmd("build_fabric_bitstream");
 
+  /* Add an option '--read_file' */
+  CommandOptionId opt_read_file = shell_cmd.add_option(
+    "read_file", false,
+    "file path to read the fabric bitstream in XML format, which is written "
+    "by write_fabric_bitstream, rather than building it");
+  shell_cmd.set_option_require_value(opt_read_file, openfpga::OPT_STRING);
+
+  /* Add an option '--incremental' */
+  shell_cmd.add_option("incremental", false,
+                       "Patch the data values of the existing fabric "
+                       "bitstream when the bitstream database is updated "
+                       "in place since it is built");
+
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to build the configuration regions. Use 0 to use "
+    "all the available threads. By default, the number of threads of the shell "
+    "is used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -187,9 +322,18 @@ ShellCommandId add_write_fabric_bitstream_command_template(
   /* Add an option '--file_format'*/
   CommandOptionId opt_file_format = shell_cmd.add_option(
     "format", false,
-    "file format of fabric bitstream [plain_text|xml]. Default: plain_text");
+    "file format of fabric bitstream [plain_text|hex|xml|binary|image]. "
+    "Default: plain_text");
   shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
 
+  /* Add an option '--word_size'*/
+  CommandOptionId opt_word_size = shell_cmd.add_option(
+    "word_size", false,
+    "Size of the words in a programming image [32|64], where each region is "
+    "a bit lane of the words. Only applicable to the image format. Default: "
+    "32");
+  shell_cmd.set_option_require_value(opt_word_size, openfpga::OPT_INT);
+
   /* Add an option '--fast_configuration' */
   shell_cmd.add_option("fast_configuration", false,
                        "Reduce the size of bitstream to be downloaded");
@@ -204,6 +348,18 @@ ShellCommandId add_write_fabric_bitstream_command_template(
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to reshape the bitstream for shift register banks. "
+    "Use 0 to use all the available threads. By default, the number of threads "
+    "of the shell is used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
+  /* Add an option '--compress' */
+  shell_cmd.add_option("compress", false,
+                       "Compress the output files in gzip format");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -220,6 +376,138 @@ ShellCommandId add_write_fabric_bitstream_command_template(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: write_fabric_bitstream_diff
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_write_fabric_bitstream_diff_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("write_fabric_bitstream_diff");
+
+  /* Add an option '--reference'*/
+  CommandOptionId opt_reference = shell_cmd.add_option(
+    "reference", true,
+    "file path of the architecture bitstream which is already programmed "
+    "on the fabric");
+  shell_cmd.set_option_require_value(opt_reference, openfpga::OPT_STRING);
+
+  /* Add an option '--reference_format'*/
+  CommandOptionId opt_ref_format = shell_cmd.add_option(
+    "reference_format", false,
+    "file format of the reference architecture bitstream [xml|binary]. "
+    "Default: xml");
+  shell_cmd.set_option_require_value(opt_ref_format, openfpga::OPT_STRING);
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file = shell_cmd.add_option(
+    "file", true, "file path to output the bitstream difference");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--file_format'*/
+  CommandOptionId opt_file_format = shell_cmd.add_option(
+    "format", false,
+    "file format of the bitstream difference [plain_text|binary]. Default: "
+    "plain_text");
+  shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
+
+  /* Add an option '--no_time_stamp' */
+  shell_cmd.add_option("no_time_stamp", false,
+                       "Do not print time stamp in output files");
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Write the configuration addresses of the fabric-dependent bitstream "
+    "which differ from a reference bitstream",
+    hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id,
+                                     write_fabric_bitstream_diff_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: write_batch_fabric_bitstream
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_write_batch_fabric_bitstream_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("write_batch_fabric_bitstream");
+
+  /* Add an option '--design_list'*/
+  CommandOptionId opt_design_list = shell_cmd.add_option(
+    "design_list", true,
+    "file listing the architecture bitstream and the fabric bitstream of "
+    "each design, one design per line");
+  shell_cmd.set_option_require_value(opt_design_list, openfpga::OPT_STRING);
+
+  /* Add an option '--arch_bitstream_format'*/
+  CommandOptionId opt_arch_format = shell_cmd.add_option(
+    "arch_bitstream_format", false,
+    "file format of architecture bitstreams [xml|binary]. Default: xml");
+  shell_cmd.set_option_require_value(opt_arch_format, openfpga::OPT_STRING);
+
+  /* Add an option '--file_format'*/
+  CommandOptionId opt_file_format = shell_cmd.add_option(
+    "format", false,
+    "file format of fabric bitstreams [plain_text|hex|xml|binary]. Default: "
+    "plain_text");
+  shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
+
+  /* Add an option '--fast_configuration' */
+  shell_cmd.add_option("fast_configuration", false,
+                       "Reduce the size of bitstream to be downloaded");
+
+  /* Add an option '--keep_dont_care_bit' */
+  shell_cmd.add_option(
+    "keep_dont_care_bits", false,
+    "Keep don't care bits in bitstream file; If not enabled, don't care bits "
+    "are converted to logic '0' or '1'");
+
+  /* Add an option '--no_time_stamp' */
+  shell_cmd.add_option("no_time_stamp", false,
+                       "Do not print time stamp in output files");
+
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of designs to process in parallel. Use 0 for all the hardware "
+    "threads. By default, the number of threads of the shell is used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Build and write the fabric-dependent bitstreams of a batch of designs "
+    "from their architecture bitstreams",
+    hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id,
+                                     write_batch_fabric_bitstream_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 /********************************************************************
  * - Add a command to Shell environment: write_io_mapping
  * - Add associated options
@@ -241,6 +529,14 @@ ShellCommandId add_write_io_mapping_command_template(
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to find the I/O mapping and to write the file. "
+    "Use 0 to use all the available threads. By default, the number of "
+    "threads of the shell is used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -305,6 +601,18 @@ void add_bitstream_command_templates(openfpga::Shell<T>& shell,
     shell, openfpga_bitstream_cmd_class,
     cmd_dependency_report_bitstream_distribution, hidden);
 
+  /********************************
+   * Command 'report_bitstream_tile'
+   */
+  /* The 'report_bitstream_tile' command should NOT be executed before
+   * 'build_architecture_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_report_bitstream_tile;
+  cmd_dependency_report_bitstream_tile.push_back(
+    shell_cmd_build_arch_bitstream_id);
+  add_report_bitstream_tile_command_template(
+    shell, openfpga_bitstream_cmd_class, cmd_dependency_report_bitstream_tile,
+    hidden);
+
   /********************************
    * Command 'build_fabric_bitstream'
    */
@@ -330,6 +638,30 @@ void add_bitstream_command_templates(openfpga::Shell<T>& shell,
     shell, openfpga_bitstream_cmd_class, cmd_dependency_write_fabric_bitstream,
     hidden);
 
+  /********************************
+   * Command 'write_fabric_bitstream_diff'
+   */
+  /* The 'write_fabric_bitstream_diff' command should NOT be executed before
+   * 'build_fabric_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_write_fabric_bitstream_diff;
+  cmd_dependency_write_fabric_bitstream_diff.push_back(
+    shell_cmd_build_fabric_bitstream_id);
+  add_write_fabric_bitstream_diff_command_template(
+    shell, openfpga_bitstream_cmd_class,
+    cmd_dependency_write_fabric_bitstream_diff, hidden);
+
+  /********************************
+   * Command 'write_batch_fabric_bitstream'
+   */
+  /* The 'write_batch_fabric_bitstream' command should NOT be executed before
+   * 'build_fabric' */
+  std::vector<ShellCommandId> cmd_dependency_write_batch_fabric_bitstream;
+  cmd_dependency_write_batch_fabric_bitstream.push_back(
+    shell_cmd_build_fabric_id);
+  add_write_batch_fabric_bitstream_command_template(
+    shell, openfpga_bitstream_cmd_class,
+    cmd_dependency_write_batch_fabric_bitstream, hidden);
+
   /********************************
    * Command 'write_io_mapping'
    */
@@ -4,6 +4,8 @@
 /********************************************************************
  * This file includes functions to build bitstream database
  *******************************************************************/
+#include "batch_fabric_bitstream.h"
+#include "build_bitstream_tile_index.h"
 #include "build_device_bitstream.h"
 #include "build_fabric_bitstream.h"
 #include "build_io_mapping_info.h"
@@ -11,13 +13,21 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "openfpga_reserved_words.h"
+#include "read_binary_arch_bitstream.h"
 #include "read_xml_arch_bitstream.h"
+#include "read_xml_fabric_bitstream.h"
 #include "report_bitstream_distribution.h"
+#include "report_bitstream_tile.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
+#include "write_binary_arch_bitstream.h"
+#include "write_fabric_bitstream_diff.h"
+#include "write_image_fabric_bitstream.h"
 #include "write_text_fabric_bitstream.h"
 #include "write_xml_arch_bitstream.h"
 #include "write_xml_fabric_bitstream.h"
@@ -34,15 +44,79 @@ int fpga_bitstream_template(T& openfpga_ctx, const Command& cmd,
                             const CommandContext& cmd_context) {
   CommandOptionId opt_verbose = cmd.option("verbose");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
+  CommandOptionId opt_no_net_ids = cmd.option("no_net_ids");
   CommandOptionId opt_write_file = cmd.option("write_file");
   CommandOptionId opt_read_file = cmd.option("read_file");
+  CommandOptionId opt_file_format = cmd.option("format");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
+  CommandOptionId opt_incremental = cmd.option("incremental");
+
+  /* Use the number of threads of the shell by default */
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
+
+  /* Check file format requirements */
+  std::string file_format("xml");
+  if (true == cmd_context.option_enable(cmd, opt_file_format)) {
+    file_format = cmd_context.option_value(cmd, opt_file_format);
+  }
+  bool binary = (std::string("binary") == file_format);
 
+  bool keep_tile_index = false;
   if (true == cmd_context.option_enable(cmd, opt_read_file)) {
-    openfpga_ctx.mutable_bitstream_manager() = read_xml_architecture_bitstream(
-      cmd_context.option_value(cmd, opt_read_file).c_str());
+    if (binary) {
+      openfpga_ctx.mutable_bitstream_manager() =
+        read_binary_architecture_bitstream(
+          cmd_context.option_value(cmd, opt_read_file).c_str());
+    } else {
+      openfpga_ctx.mutable_bitstream_manager() =
+        read_xml_architecture_bitstream(
+          cmd_context.option_value(cmd, opt_read_file).c_str());
+    }
+    openfpga_ctx.mutable_bitstream_snapshot().clear();
+  } else if ((true == cmd_context.option_enable(cmd, opt_incremental)) &&
+             (0 < openfpga_ctx.bitstream_manager().num_blocks()) &&
+             (false == openfpga_ctx.bitstream_snapshot().empty())) {
+    /* Update the grids and routing blocks whose results are changed since
+     * the snapshot. Blocks and bits are kept if the database is updated in
+     * place, and so is the tile index. Otherwise, the database is rebuilt
+     * and the fabric bitstream refers to a database which is replaced */
+    keep_tile_index =
+      update_device_bitstream(
+        openfpga_ctx.mutable_bitstream_manager(),
+        openfpga_ctx.mutable_bitstream_snapshot(), g_vpr_ctx, openfpga_ctx,
+        find_num_threads(num_threads),
+        cmd_context.option_enable(cmd, opt_verbose),
+        !cmd_context.option_enable(cmd, opt_no_net_ids)) &&
+      (0 < openfpga_ctx.bitstream_tile_index().num_tiles());
   } else {
+    /* The net ids are only written to files, so they are skipped unless
+     * required */
     openfpga_ctx.mutable_bitstream_manager() = build_device_bitstream(
-      g_vpr_ctx, openfpga_ctx, cmd_context.option_enable(cmd, opt_verbose));
+      g_vpr_ctx, openfpga_ctx, find_num_threads(num_threads),
+      cmd_context.option_enable(cmd, opt_verbose),
+      !cmd_context.option_enable(cmd, opt_no_net_ids));
+    /* The snapshot is only taken when later runs may update the database */
+    if (true == cmd_context.option_enable(cmd, opt_incremental)) {
+      openfpga_ctx.mutable_bitstream_snapshot() =
+        build_device_bitstream_snapshot(
+          g_vpr_ctx, openfpga_ctx, find_num_threads(num_threads),
+          !cmd_context.option_enable(cmd, opt_no_net_ids));
+    } else {
+      openfpga_ctx.mutable_bitstream_snapshot().clear();
+    }
+  }
+
+  /* Index the tiles of the new database, whose fabric bits are indexed when
+   * the fabric bitstream is built */
+  if (false == keep_tile_index) {
+    openfpga_ctx.mutable_bitstream_tile_index() = build_bitstream_tile_index(
+      openfpga_ctx.bitstream_manager(), g_vpr_ctx.device().grid,
+      openfpga_ctx.vpr_device_annotation(), openfpga_ctx.device_rr_gsb(),
+      cmd_context.option_enable(cmd, opt_verbose));
   }
 
   if (true == cmd_context.option_enable(cmd, opt_write_file)) {
@@ -52,16 +126,89 @@ int fpga_bitstream_template(T& openfpga_ctx, const Command& cmd,
     /* Create directories */
     create_directory(src_dir_path);
 
-    write_xml_architecture_bitstream(
-      openfpga_ctx.bitstream_manager(),
-      cmd_context.option_value(cmd, opt_write_file),
-      !cmd_context.option_enable(cmd, opt_no_time_stamp));
+    if (binary) {
+      write_binary_architecture_bitstream(
+        openfpga_ctx.bitstream_manager(),
+        cmd_context.option_value(cmd, opt_write_file));
+    } else {
+      write_xml_architecture_bitstream(
+        openfpga_ctx.bitstream_manager(),
+        cmd_context.option_value(cmd, opt_write_file),
+        !cmd_context.option_enable(cmd, opt_no_time_stamp),
+        !cmd_context.option_enable(cmd, opt_no_net_ids),
+        find_num_threads(num_threads));
+    }
   }
 
   /* TODO: should identify the error code from internal function execution */
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * A wrapper function to report the configuration bits of the tiles at a
+ * coordinate, which are found from the bitstream tile index
+ *******************************************************************/
+template <class T>
+int report_bitstream_tile_template(const T& openfpga_ctx, const Command& cmd,
+                                   const CommandContext& cmd_context) {
+  CommandOptionId opt_type = cmd.option("type");
+  CommandOptionId opt_x = cmd.option("x");
+  CommandOptionId opt_y = cmd.option("y");
+  CommandOptionId opt_subtile = cmd.option("subtile");
+  CommandOptionId opt_show_values = cmd.option("show_values");
+
+  e_bitstream_tile_type tile_type = NUM_BITSTREAM_TILE_TYPES;
+  std::string type_name("grid");
+  if (true == cmd_context.option_enable(cmd, opt_type)) {
+    type_name = cmd_context.option_value(cmd, opt_type);
+  }
+  for (size_t itype = 0; itype < NUM_BITSTREAM_TILE_TYPES; ++itype) {
+    if (type_name == std::string(BITSTREAM_TILE_TYPE_STRING[itype])) {
+      tile_type = e_bitstream_tile_type(itype);
+    }
+  }
+  if (NUM_BITSTREAM_TILE_TYPES == tile_type) {
+    VTR_LOG_ERROR("Invalid tile type '%s'! Expect [grid|sb|cbx|cby]\n",
+                  type_name.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  vtr::Point<size_t> coord(
+    std::atoi(cmd_context.option_value(cmd, opt_x).c_str()),
+    std::atoi(cmd_context.option_value(cmd, opt_y).c_str()));
+  /* A grid which spans multiple coordinates is found at its root */
+  const DeviceGrid& grids = g_vpr_ctx.device().grid;
+  if ((BITSTREAM_TILE_GRID == tile_type) && (coord.x() < grids.width()) &&
+      (coord.y() < grids.height())) {
+    const t_grid_tile& grid = grids[coord.x()][coord.y()];
+    coord.set_x(coord.x() - grid.width_offset);
+    coord.set_y(coord.y() - grid.height_offset);
+  }
+
+  const BitstreamTileIndex& tile_index = openfpga_ctx.bitstream_tile_index();
+  std::vector<BitstreamTileId> tiles;
+  if (true == cmd_context.option_enable(cmd, opt_subtile)) {
+    BitstreamTileId tile_id = tile_index.find_tile(
+      tile_type, coord,
+      std::atoi(cmd_context.option_value(cmd, opt_subtile).c_str()));
+    if (true == tile_index.valid_tile_id(tile_id)) {
+      tiles.push_back(tile_id);
+    }
+  } else {
+    tiles = tile_index.find_tiles(tile_type, coord);
+  }
+  if (true == tiles.empty()) {
+    VTR_LOG_ERROR("No configuration bits are found for %s (%lu, %lu)!\n",
+                  type_name.c_str(), coord.x(), coord.y());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  report_bitstream_tiles(openfpga_ctx.bitstream_manager(), tile_index, tiles,
+                         cmd_context.option_enable(cmd, opt_show_values));
+
+  return CMD_EXEC_SUCCESS;
+}
+
 /********************************************************************
  * A wrapper function to call the build_fabric_bitstream() in FPGA bitstream
  *******************************************************************/
@@ -69,11 +216,62 @@ template <class T>
 int build_fabric_bitstream_template(T& openfpga_ctx, const Command& cmd,
                                     const CommandContext& cmd_context) {
   CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_read_file = cmd.option("read_file");
+  CommandOptionId opt_incremental = cmd.option("incremental");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
+
+  /* Read a fabric bitstream written before, which matches the fabric and
+   * the bitstream database */
+  if (true == cmd_context.option_enable(cmd, opt_read_file)) {
+    int status = read_xml_fabric_bitstream(
+      cmd_context.option_value(cmd, opt_read_file),
+      openfpga_ctx.bitstream_manager(), openfpga_ctx.arch().config_protocol,
+      openfpga_ctx.mutable_fabric_bitstream(),
+      cmd_context.option_enable(cmd, opt_verbose));
+    if (0 != status) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    openfpga_ctx.mutable_fabric_bitstream().set_database_version(
+      openfpga_ctx.bitstream_manager().stamp(),
+      openfpga_ctx.bitstream_manager().update_generation());
+    build_bitstream_tile_index_fabric_bits(
+      openfpga_ctx.mutable_bitstream_tile_index(),
+      openfpga_ctx.bitstream_manager(), openfpga_ctx.fabric_bitstream(),
+      cmd_context.option_enable(cmd, opt_verbose));
+    return CMD_EXEC_SUCCESS;
+  }
+
+  /* Use the number of threads of the shell by default */
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
+
+  /* Patch an existing fabric bitstream when it is built from the same
+   * database, which may have been updated in place since then.
+   * The fabric bits are kept, and so are the fabric bits of the tile index
+   */
+  if ((true == cmd_context.option_enable(cmd, opt_incremental)) &&
+      (openfpga_ctx.fabric_bitstream().database_stamp() ==
+       openfpga_ctx.bitstream_manager().stamp())) {
+    update_fabric_dependent_bitstream(
+      openfpga_ctx.mutable_fabric_bitstream(), openfpga_ctx.bitstream_manager(),
+      cmd_context.option_enable(cmd, opt_verbose));
+    return CMD_EXEC_SUCCESS;
+  }
 
   /* Build fabric bitstream here */
   openfpga_ctx.mutable_fabric_bitstream() = build_fabric_dependent_bitstream(
     openfpga_ctx.bitstream_manager(), openfpga_ctx.module_graph(),
-    openfpga_ctx.arch().circuit_lib, openfpga_ctx.arch().config_protocol,
+    openfpga_ctx.config_child_hierarchy(), openfpga_ctx.arch().circuit_lib,
+    openfpga_ctx.arch().config_protocol, find_num_threads(num_threads),
+    cmd_context.option_enable(cmd, opt_verbose));
+
+  /* Index the fabric bits of each tile */
+  build_bitstream_tile_index_fabric_bits(
+    openfpga_ctx.mutable_bitstream_tile_index(),
+    openfpga_ctx.bitstream_manager(), openfpga_ctx.fabric_bitstream(),
     cmd_context.option_enable(cmd, opt_verbose));
 
   /* TODO: should identify the error code from internal function execution */
@@ -92,6 +290,36 @@ int write_fabric_bitstream_template(const T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_fast_config = cmd.option("fast_configuration");
   CommandOptionId opt_keep_dont_care_bits = cmd.option("keep_dont_care_bits");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
+  CommandOptionId opt_word_size = cmd.option("word_size");
+  CommandOptionId opt_compress = cmd.option("compress");
+
+  /* Output files are compressed until the command returns */
+  if ((true == cmd_context.option_enable(cmd, opt_compress)) &&
+      (false == output_compression_supported())) {
+    VTR_LOG_ERROR(
+      "Option '--compress' requires OpenFPGA to be built with zlib!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  ScopedOutputCompression compression_scope(
+    cmd_context.option_enable(cmd, opt_compress));
+
+  /* Use the number of threads of the shell by default */
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
+
+  /* Words of programming images are 32-bit by default */
+  size_t word_size = 32;
+  if (true == cmd_context.option_enable(cmd, opt_word_size)) {
+    word_size = std::atoi(cmd_context.option_value(cmd, opt_word_size).c_str());
+    if (32 != word_size && 64 != word_size) {
+      VTR_LOG_ERROR("Invalid word size '%lu'! Expect [32|64]\n", word_size);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
 
   /* Write fabric bitstream if required */
   int status = CMD_EXEC_SUCCESS;
@@ -117,8 +345,16 @@ int write_fabric_bitstream_template(const T& openfpga_ctx, const Command& cmd,
       cmd_context.option_value(cmd, opt_file),
       !cmd_context.option_enable(cmd, opt_no_time_stamp),
       cmd_context.option_enable(cmd, opt_verbose));
+  } else if (std::string("image") == file_format) {
+    status = write_fabric_bitstream_to_image_file(
+      openfpga_ctx.bitstream_manager(), openfpga_ctx.fabric_bitstream(),
+      openfpga_ctx.arch().config_protocol,
+      openfpga_ctx.fabric_global_port_info(),
+      cmd_context.option_value(cmd, opt_file), word_size,
+      cmd_context.option_enable(cmd, opt_fast_config),
+      cmd_context.option_enable(cmd, opt_verbose));
   } else {
-    /* By default, output in plain text format */
+    /* By default, output in plain text format, unless binary is required */
     status = write_fabric_bitstream_to_text_file(
       openfpga_ctx.bitstream_manager(), openfpga_ctx.fabric_bitstream(),
       openfpga_ctx.blwl_shift_register_banks(),
@@ -127,13 +363,136 @@ int write_fabric_bitstream_template(const T& openfpga_ctx, const Command& cmd,
       cmd_context.option_value(cmd, opt_file),
       cmd_context.option_enable(cmd, opt_fast_config),
       cmd_context.option_enable(cmd, opt_keep_dont_care_bits),
+      std::string("binary") == file_format, std::string("hex") == file_format,
       !cmd_context.option_enable(cmd, opt_no_time_stamp),
+      find_num_threads(num_threads),
       cmd_context.option_enable(cmd, opt_verbose));
   }
 
   return status;
 }
 
+/********************************************************************
+ * A wrapper function to call the write_fabric_bitstream_diff() in FPGA
+ * bitstream. The reference fabric bitstream is built from an architecture
+ * bitstream on the current fabric
+ *******************************************************************/
+template <class T>
+int write_fabric_bitstream_diff_template(const T& openfpga_ctx,
+                                         const Command& cmd,
+                                         const CommandContext& cmd_context) {
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_reference = cmd.option("reference");
+  CommandOptionId opt_ref_format = cmd.option("reference_format");
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_file_format = cmd.option("format");
+  CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
+
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_reference));
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+
+  /* Check file format requirements */
+  std::string ref_format("xml");
+  if (true == cmd_context.option_enable(cmd, opt_ref_format)) {
+    ref_format = cmd_context.option_value(cmd, opt_ref_format);
+  }
+  std::string file_format("plain_text");
+  if (true == cmd_context.option_enable(cmd, opt_file_format)) {
+    file_format = cmd_context.option_value(cmd, opt_file_format);
+  }
+
+  /* Build the reference fabric bitstream */
+  std::string ref_fname = cmd_context.option_value(cmd, opt_reference);
+  BitstreamManager ref_bitstream_manager;
+  try {
+    ref_bitstream_manager =
+      std::string("binary") == ref_format
+        ? read_binary_architecture_bitstream(ref_fname.c_str())
+        : read_xml_architecture_bitstream(ref_fname.c_str());
+  } catch (const std::exception& error) {
+    VTR_LOG_ERROR("Failed to read reference bitstream '%s': %s\n",
+                  ref_fname.c_str(), error.what());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  FabricBitstream ref_fabric_bitstream = build_fabric_dependent_bitstream(
+    ref_bitstream_manager, openfpga_ctx.module_graph(),
+    openfpga_ctx.config_child_hierarchy(), openfpga_ctx.arch().circuit_lib,
+    openfpga_ctx.arch().config_protocol, 1,
+    cmd_context.option_enable(cmd, opt_verbose));
+
+  std::string src_dir_path =
+    find_path_dir_name(cmd_context.option_value(cmd, opt_file));
+
+  /* Create directories */
+  create_directory(src_dir_path);
+
+  int status = write_fabric_bitstream_diff_to_text_file(
+    openfpga_ctx.fabric_bitstream(), ref_fabric_bitstream,
+    openfpga_ctx.arch().config_protocol,
+    cmd_context.option_value(cmd, opt_file),
+    std::string("binary") == file_format,
+    !cmd_context.option_enable(cmd, opt_no_time_stamp),
+    cmd_context.option_enable(cmd, opt_verbose));
+
+  return 0 == status ? CMD_EXEC_SUCCESS : CMD_EXEC_FATAL_ERROR;
+}
+
+/********************************************************************
+ * A wrapper function to build and write the fabric bitstreams of a batch
+ * of designs on the current fabric, from their architecture bitstreams
+ *******************************************************************/
+template <class T>
+int write_batch_fabric_bitstream_template(T& openfpga_ctx, const Command& cmd,
+                                          const CommandContext& cmd_context) {
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_design_list = cmd.option("design_list");
+  CommandOptionId opt_arch_format = cmd.option("arch_bitstream_format");
+  CommandOptionId opt_file_format = cmd.option("format");
+  CommandOptionId opt_fast_config = cmd.option("fast_configuration");
+  CommandOptionId opt_keep_dont_care_bits = cmd.option("keep_dont_care_bits");
+  CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
+
+  /* Use the number of threads of the shell by default */
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
+
+  /* Check file format requirements */
+  std::string arch_format("xml");
+  if (true == cmd_context.option_enable(cmd, opt_arch_format)) {
+    arch_format = cmd_context.option_value(cmd, opt_arch_format);
+  }
+  std::string file_format("plain_text");
+  if (true == cmd_context.option_enable(cmd, opt_file_format)) {
+    file_format = cmd_context.option_value(cmd, opt_file_format);
+  }
+
+  std::vector<BatchFabricBitstreamFiles> files;
+  int status = read_batch_fabric_bitstream_list(
+    cmd_context.option_value(cmd, opt_design_list), files);
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+
+  /* The shift register banks are shared by the threads, whose fast look-ups
+   * should be ready before */
+  openfpga_ctx.mutable_blwl_shift_register_banks().build_fast_lookups();
+
+  return write_batch_fabric_bitstreams(
+    files, std::string("binary") == arch_format, file_format,
+    openfpga_ctx.module_graph(), openfpga_ctx.config_child_hierarchy(),
+    openfpga_ctx.arch().circuit_lib, openfpga_ctx.arch().config_protocol,
+    openfpga_ctx.blwl_shift_register_banks(),
+    openfpga_ctx.fabric_global_port_info(),
+    cmd_context.option_enable(cmd, opt_fast_config),
+    cmd_context.option_enable(cmd, opt_keep_dont_care_bits),
+    !cmd_context.option_enable(cmd, opt_no_time_stamp),
+    find_num_threads(num_threads), cmd_context.option_enable(cmd, opt_verbose));
+}
+
 /********************************************************************
  * A wrapper function to call the write_io_mapping() in FPGA bitstream
  *******************************************************************/
@@ -143,6 +502,14 @@ int write_io_mapping_template(const T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_verbose = cmd.option("verbose");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
   CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
+
+  /* Use the number of threads of the shell by default */
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
 
   /* Write fabric bitstream if required */
   int status = CMD_EXEC_SUCCESS;
@@ -171,12 +538,12 @@ int write_io_mapping_template(const T& openfpga_ctx, const Command& cmd,
     openfpga_ctx.module_graph(), top_module, g_vpr_ctx.atom(),
     g_vpr_ctx.placement(), openfpga_ctx.io_location_map(),
     openfpga_ctx.vpr_netlist_annotation(), std::string(), std::string(),
-    prefix_to_remove);
+    prefix_to_remove, find_num_threads(num_threads));
 
   status = write_io_mapping_to_xml_file(
     io_map, cmd_context.option_value(cmd, opt_file),
     !cmd_context.option_enable(cmd, opt_no_time_stamp),
-    cmd_context.option_enable(cmd, opt_verbose));
+    find_num_threads(num_threads), cmd_context.option_enable(cmd, opt_verbose));
 
   return status;
 }
@@ -191,6 +558,14 @@ int report_bitstream_distribution_template(const T& openfpga_ctx,
                                            const CommandContext& cmd_context) {
   CommandOptionId opt_file = cmd.option("file");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
+
+  /* Use the number of threads of the shell by default */
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
 
   int status = CMD_EXEC_SUCCESS;
 
@@ -218,7 +593,8 @@ int report_bitstream_distribution_template(const T& openfpga_ctx,
   status = report_bitstream_distribution(
     cmd_context.option_value(cmd, opt_file), openfpga_ctx.bitstream_manager(),
     openfpga_ctx.fabric_bitstream(),
-    !cmd_context.option_enable(cmd, opt_no_time_stamp), depth);
+    !cmd_context.option_enable(cmd, opt_no_time_stamp), depth,
+    find_num_threads(num_threads));
 
   return status;
 }
@@ -3,6 +3,10 @@
 /********************************************************************
  * This file includes functions to compress the hierachy of routing architecture
  *******************************************************************/
+#include <cstdio>
+#include <cstdlib>
+
+#include "build_config_child_hierarchy.h"
 #include "build_device_module.h"
 #include "build_fabric_global_port_info.h"
 #include "build_fabric_io_location_map.h"
@@ -10,11 +14,19 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "device_rr_gsb.h"
+#include "device_rr_gsb_cache.h"
 #include "device_rr_gsb_utils.h"
+#include "fabric_binary_image.h"
+#include "fabric_build_digest.h"
 #include "fabric_hierarchy_writer.h"
 #include "fabric_key_writer.h"
 #include "globals.h"
+#include "openfpga_digest.h"
+#include "openfpga_mapped_allocator.h"
+#include "openfpga_parallel.h"
+#include "openfpga_trace.h"
 #include "read_xml_fabric_key.h"
+#include "shell.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
 
@@ -27,13 +39,40 @@ namespace openfpga {
  *******************************************************************/
 template <class T>
 void compress_routing_hierarchy_template(T& openfpga_ctx,
+                                         const std::string& cache_fname,
+                                         const size_t& num_threads,
                                          const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer(
     "Identify unique General Switch Blocks (GSBs)");
+  OPENFPGA_TRACE_FUNCTION();
 
-  /* Build unique module lists */
-  openfpga_ctx.mutable_device_rr_gsb().build_unique_module(
-    g_vpr_ctx.device().rr_graph);
+  /* Reuse the unique module lists from a cache file when it matches the
+   * current routing resource graph and architecture. Otherwise, build the
+   * unique module lists and update the cache file if required */
+  bool cache_loaded = false;
+  uint64_t digest = 0;
+  if (false == cache_fname.empty()) {
+    digest = compute_device_rr_gsb_digest(
+      g_vpr_ctx.device().rr_graph, openfpga_ctx.vpr_device_annotation(),
+      openfpga_ctx.device_rr_gsb());
+    cache_loaded = read_device_rr_gsb_unique_module_cache(
+      cache_fname, openfpga_ctx.mutable_device_rr_gsb(), digest,
+      verbose_output);
+  }
+
+  if (false == cache_loaded) {
+    /* Build unique module lists */
+    openfpga_ctx.mutable_device_rr_gsb().build_unique_module(
+      g_vpr_ctx.device().rr_graph, num_threads);
+    /* A cache which cannot be written only costs the next run */
+    if ((false == cache_fname.empty()) &&
+        (CMD_EXEC_SUCCESS != write_device_rr_gsb_unique_module_cache(
+                               cache_fname, openfpga_ctx.device_rr_gsb(),
+                               digest, verbose_output))) {
+      VTR_LOG_WARN("Unable to update the GSB cache file '%s'!\n",
+                   cache_fname.c_str());
+    }
+  }
 
   /* Report the stats */
   VTR_LOGV(
@@ -71,6 +110,16 @@ void compress_routing_hierarchy_template(T& openfpga_ctx,
          (float)openfpga_ctx.device_rr_gsb().get_num_sb_unique_module() -
        1.));
 
+  /* Report how many switch block modules are left if the rotations and
+   * reflections of switch blocks share modules */
+  openfpga_ctx.mutable_device_rr_gsb().build_sb_rotatable_module(
+    g_vpr_ctx.device().rr_graph);
+  VTR_LOGV(verbose_output,
+           "Detected %lu rotatable switch blocks from %lu unique switch "
+           "blocks, which are rotations or reflections of each other\n",
+           openfpga_ctx.device_rr_gsb().get_num_sb_rotatable_module(),
+           openfpga_ctx.device_rr_gsb().get_num_sb_unique_module());
+
   VTR_LOG(
     "Detected %lu unique general switch blocks from a total of %d (compression "
     "rate=%.2f%)\n",
@@ -82,6 +131,157 @@ void compress_routing_hierarchy_template(T& openfpga_ctx,
        1.));
 }
 
+/********************************************************************
+ * Find the directory where the largest arrays of the module graph are
+ * backed by files, when option '--out_of_core' is enabled.
+ * Return an empty directory when disabled
+ *******************************************************************/
+inline std::string find_out_of_core_dir(const Command& cmd,
+                                        const CommandContext& cmd_context) {
+  CommandOptionId opt_out_of_core = cmd.option("out_of_core");
+  if (false == cmd_context.option_enable(cmd, opt_out_of_core)) {
+    return std::string();
+  }
+  std::string dir = cmd_context.option_value(cmd, opt_out_of_core);
+  create_directory(dir);
+  return dir;
+}
+
+/********************************************************************
+ * Find the size of the smallest blocks which are backed by files, when
+ * option '--out_of_core' is enabled.
+ * Return false when the size given by the user is invalid
+ *******************************************************************/
+inline bool find_out_of_core_min_block_size(const Command& cmd,
+                                            const CommandContext& cmd_context,
+                                            size_t& min_block_size) {
+  CommandOptionId opt_min_block_size =
+    cmd.option("out_of_core_min_block_size");
+  min_block_size = ScopedMappedAllocation::DEFAULT_MIN_BLOCK_SIZE;
+  if (false == cmd_context.option_enable(cmd, opt_min_block_size)) {
+    return true;
+  }
+  long long size = std::atoll(
+    cmd_context.option_value(cmd, opt_min_block_size).c_str());
+  if (0 > size) {
+    VTR_LOG_ERROR(
+      "Invalid minimum block size '%lld' which should be 0 or a positive "
+      "number!\n",
+      size);
+    return false;
+  }
+  min_block_size = size_t(size);
+  return true;
+}
+
+/********************************************************************
+ * Compute the digest of the device and the architecture, which a fabric
+ * image should match. The device digest is the one of the unique module
+ * cache, which also covers the order of the incoming edges of the GSBs,
+ * e.g., sorted by link_openfpga_arch
+ *******************************************************************/
+template <class T>
+uint64_t compute_fabric_binary_image_digest_template(const T& openfpga_ctx) {
+  return compute_fabric_binary_image_digest(
+    compute_device_rr_gsb_digest(g_vpr_ctx.device().rr_graph,
+                                 openfpga_ctx.vpr_device_annotation(),
+                                 openfpga_ctx.device_rr_gsb()),
+    g_vpr_ctx.device().grid, openfpga_ctx.arch().circuit_lib,
+    openfpga_ctx.arch().config_protocol);
+}
+
+/********************************************************************
+ * Compute the digests of the inputs of build_fabric for option
+ * '--fabric_cache'. The options which do not change the fabric are ignored
+ *******************************************************************/
+template <class T>
+FabricBuildDigest compute_fabric_build_digest_template(
+  const T& openfpga_ctx, const Command& cmd,
+  const CommandContext& cmd_context) {
+  return compute_fabric_build_digest(
+    compute_device_rr_gsb_digest(g_vpr_ctx.device().rr_graph,
+                                 openfpga_ctx.vpr_device_annotation(),
+                                 openfpga_ctx.device_rr_gsb()),
+    g_vpr_ctx.device().grid, openfpga_ctx.arch(), cmd, cmd_context,
+    {"fabric_cache", "num_threads", "out_of_core",
+     "out_of_core_min_block_size", "unique_module_cache", "write_fabric_key",
+     "verbose"});
+}
+
+/********************************************************************
+ * Restore the fabric from the image of option '--fabric_cache' when none
+ * of the inputs of build_fabric is edited since the image was written.
+ * Otherwise, report what has been edited and return false, so that the
+ * whole fabric is built. The circuit models which have been edited are
+ * returned, so that the modules they invalidate can be reported
+ *******************************************************************/
+template <class T>
+bool reuse_cached_fabric_template(
+  T& openfpga_ctx, const std::string& image_fname,
+  const FabricBuildDigest& curr_digest,
+  std::vector<std::string>& changed_circuit_models, const bool& verbose) {
+  FabricBuildDigest prev_digest;
+  if (CMD_EXEC_SUCCESS !=
+      read_fabric_build_digest(image_fname + ".digest", prev_digest)) {
+    VTR_LOG("No previous fabric found in '%s'. Build the whole fabric\n",
+            image_fname.c_str());
+    return false;
+  }
+  if (prev_digest.device != curr_digest.device) {
+    VTR_LOG(
+      "The routing resources of the device, or the order of the incoming "
+      "edges of the GSBs, e.g., sorted by link_openfpga_arch, are changed "
+      "since '%s' was written. Build the whole fabric\n",
+      image_fname.c_str());
+    return false;
+  }
+  if (prev_digest.others != curr_digest.others) {
+    VTR_LOG(
+      "The grids, the options or the architecture other than the circuit "
+      "models and the tile annotations are edited since '%s' was written. "
+      "Build the whole fabric\n",
+      image_fname.c_str());
+    return false;
+  }
+
+  changed_circuit_models =
+    find_fabric_build_digest_changed_circuit_models(prev_digest, curr_digest);
+  for (const std::string& model_name : changed_circuit_models) {
+    VTR_LOG("Circuit model '%s' is edited since '%s' was written\n",
+            model_name.c_str(), image_fname.c_str());
+  }
+  if (prev_digest.tile_annotation != curr_digest.tile_annotation) {
+    VTR_LOG("Tile annotations are edited since '%s' was written\n",
+            image_fname.c_str());
+  }
+  if ((false == changed_circuit_models.empty()) ||
+      (prev_digest.tile_annotation != curr_digest.tile_annotation)) {
+    return false;
+  }
+
+  /* The options stored in the image are the current ones, as the options
+   * are covered by the digests */
+  bool compress_routing = false;
+  bool bitstream_only = false;
+  bool gsb_nets_deferred = false;
+  bool duplicate_grid_pin = false;
+  int status = read_fabric_binary_image(
+    image_fname, compute_fabric_binary_image_digest_template<T>(openfpga_ctx),
+    compress_routing, bitstream_only, gsb_nets_deferred, duplicate_grid_pin,
+    openfpga_ctx.mutable_module_graph(), openfpga_ctx.mutable_decoder_lib(),
+    openfpga_ctx.mutable_blwl_shift_register_banks(),
+    openfpga_ctx.mutable_io_location_map(),
+    openfpga_ctx.mutable_fabric_global_port_info(), verbose);
+  if (CMD_EXEC_SUCCESS != status) {
+    VTR_LOG_WARN("Unable to reuse the fabric in '%s'. Build the whole fabric\n",
+                 image_fname.c_str());
+    return false;
+  }
+  VTR_LOG("Nothing is edited since '%s' was written. Reuse the fabric\n",
+          image_fname.c_str());
+  return true;
+}
+
 /********************************************************************
  * Build the module graph for FPGA device
  *******************************************************************/
@@ -89,23 +289,92 @@ template <class T>
 int build_fabric_template(T& openfpga_ctx, const Command& cmd,
                           const CommandContext& cmd_context) {
   CommandOptionId opt_frame_view = cmd.option("frame_view");
+  CommandOptionId opt_bitstream_only = cmd.option("bitstream_only");
+  CommandOptionId opt_defer_gsb_nets = cmd.option("defer_gsb_nets");
   CommandOptionId opt_compress_routing = cmd.option("compress_routing");
+  CommandOptionId opt_unique_module_cache = cmd.option("unique_module_cache");
   CommandOptionId opt_duplicate_grid_pin = cmd.option("duplicate_grid_pin");
   CommandOptionId opt_gen_random_fabric_key =
     cmd.option("generate_random_fabric_key");
+  CommandOptionId opt_gen_locality_fabric_key =
+    cmd.option("generate_locality_fabric_key");
+  CommandOptionId opt_balance_config_regions =
+    cmd.option("balance_config_regions");
   CommandOptionId opt_write_fabric_key = cmd.option("write_fabric_key");
   CommandOptionId opt_load_fabric_key = cmd.option("load_fabric_key");
+  CommandOptionId opt_memory_tile_size = cmd.option("memory_tile_size");
+  CommandOptionId opt_max_sr_bank_size =
+    cmd.option("max_shift_register_bank_size");
+  CommandOptionId opt_fabric_cache = cmd.option("fabric_cache");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Use the number of threads of the shell by default */
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
+
+  /* Memory modules are built flat by default */
+  int memory_tile_size = 0;
+  if (true == cmd_context.option_enable(cmd, opt_memory_tile_size)) {
+    memory_tile_size =
+      std::atoi(cmd_context.option_value(cmd, opt_memory_tile_size).c_str());
+    if (0 > memory_tile_size) {
+      VTR_LOG_ERROR(
+        "Invalid memory tile size '%d' which should be 0 or a positive "
+        "number!\n",
+        memory_tile_size);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if ((0 < memory_tile_size) &&
+        (CONFIG_MEM_SCAN_CHAIN !=
+         openfpga_ctx.arch().config_protocol.type())) {
+      VTR_LOG_WARN(
+        "Memory tiles are only applicable to configuration chains and are "
+        "ignored!\n");
+      memory_tile_size = 0;
+    }
+  }
+
+  /* Shift register banks follow the configuration protocol by default */
+  int max_sr_bank_size = 0;
+  if (true == cmd_context.option_enable(cmd, opt_max_sr_bank_size)) {
+    max_sr_bank_size =
+      std::atoi(cmd_context.option_value(cmd, opt_max_sr_bank_size).c_str());
+    if (0 > max_sr_bank_size) {
+      VTR_LOG_ERROR(
+        "Invalid shift register bank size '%d' which should be 0 or a "
+        "positive number!\n",
+        max_sr_bank_size);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
   if (true == cmd_context.option_enable(cmd, opt_compress_routing)) {
+    std::string cache_fname;
+    if (true == cmd_context.option_enable(cmd, opt_unique_module_cache)) {
+      cache_fname = cmd_context.option_value(cmd, opt_unique_module_cache);
+    }
     compress_routing_hierarchy_template<T>(
-      openfpga_ctx, cmd_context.option_enable(cmd, opt_verbose));
+      openfpga_ctx, cache_fname, find_num_threads(num_threads),
+      cmd_context.option_enable(cmd, opt_verbose));
     /* Update flow manager to enable compress routing */
     openfpga_ctx.mutable_flow_manager().set_compress_routing(true);
+    openfpga_ctx.mutable_flow_manager().set_unique_module_cache(cache_fname);
   }
 
   VTR_LOG("\n");
 
+  if ((true == cmd_context.option_enable(cmd, opt_gen_random_fabric_key)) &&
+      (true == cmd_context.option_enable(cmd, opt_gen_locality_fabric_key))) {
+    VTR_LOG_ERROR(
+      "Options '--generate_random_fabric_key' and "
+      "'--generate_locality_fabric_key' are mutually exclusive!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Record the execution status in curr_status for each command
    * and summarize them in the final status
    */
@@ -122,16 +391,59 @@ int build_fabric_template(T& openfpga_ctx, const Command& cmd,
 
   VTR_LOG("\n");
 
-  curr_status = build_device_module_graph(
-    openfpga_ctx.mutable_module_graph(), openfpga_ctx.mutable_decoder_lib(),
-    openfpga_ctx.mutable_blwl_shift_register_banks(),
-    const_cast<const T&>(openfpga_ctx), g_vpr_ctx.device(),
-    cmd_context.option_enable(cmd, opt_frame_view),
-    cmd_context.option_enable(cmd, opt_compress_routing),
-    cmd_context.option_enable(cmd, opt_duplicate_grid_pin),
-    predefined_fabric_key,
-    cmd_context.option_enable(cmd, opt_gen_random_fabric_key),
-    cmd_context.option_enable(cmd, opt_verbose));
+  /* Record if the nets are skipped, which the netlist writers require */
+  openfpga_ctx.mutable_flow_manager().set_bitstream_only(
+    cmd_context.option_enable(cmd, opt_bitstream_only));
+  openfpga_ctx.mutable_flow_manager().set_gsb_nets_deferred(
+    cmd_context.option_enable(cmd, opt_defer_gsb_nets));
+  openfpga_ctx.mutable_flow_manager().set_duplicate_grid_pin(
+    cmd_context.option_enable(cmd, opt_duplicate_grid_pin));
+
+  /* The largest arrays of nets are backed by files until the command
+   * returns. The arrays remain backed by files afterwards */
+  size_t out_of_core_min_block_size = 0;
+  if (false == find_out_of_core_min_block_size(cmd, cmd_context,
+                                               out_of_core_min_block_size)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  ScopedMappedAllocation mapped_scope(find_out_of_core_dir(cmd, cmd_context),
+                                      out_of_core_min_block_size);
+
+  /* Reuse the fabric of a previous run when nothing is edited */
+  std::string fabric_cache_fname;
+  FabricBuildDigest build_digest;
+  std::vector<std::string> changed_circuit_models;
+  bool fabric_reused = false;
+  if (true == cmd_context.option_enable(cmd, opt_fabric_cache)) {
+    fabric_cache_fname = cmd_context.option_value(cmd, opt_fabric_cache);
+    build_digest = compute_fabric_build_digest_template<T>(
+      const_cast<const T&>(openfpga_ctx), cmd, cmd_context);
+    fabric_reused = reuse_cached_fabric_template<T>(
+      openfpga_ctx, fabric_cache_fname, build_digest, changed_circuit_models,
+      cmd_context.option_enable(cmd, opt_verbose));
+  }
+
+  if (false == fabric_reused) {
+    curr_status = build_device_module_graph(
+      openfpga_ctx.mutable_module_graph(), openfpga_ctx.mutable_decoder_lib(),
+      openfpga_ctx.mutable_blwl_shift_register_banks(),
+      const_cast<const T&>(openfpga_ctx), g_vpr_ctx.device(),
+      cmd_context.option_enable(cmd, opt_frame_view),
+      cmd_context.option_enable(cmd, opt_bitstream_only),
+      cmd_context.option_enable(cmd, opt_defer_gsb_nets),
+      cmd_context.option_enable(cmd, opt_compress_routing),
+      cmd_context.option_enable(cmd, opt_duplicate_grid_pin),
+      predefined_fabric_key,
+      cmd_context.option_enable(cmd, opt_gen_random_fabric_key),
+      cmd_context.option_enable(cmd, opt_gen_locality_fabric_key),
+      cmd_context.option_enable(cmd, opt_balance_config_regions),
+      size_t(memory_tile_size), size_t(max_sr_bank_size),
+      find_num_threads(num_threads),
+      cmd_context.option_enable(cmd, opt_verbose));
+  }
+  VTR_LOGV(cmd_context.option_enable(cmd, opt_verbose),
+           "%.1f MB of the module graph are backed by files\n",
+           double(mapped_memory_usage()) / (1024. * 1024.));
 
   /* If there is any error, final status cannot be overwritten by a success flag
    */
@@ -149,6 +461,50 @@ int build_fabric_template(T& openfpga_ctx, const Command& cmd,
       openfpga_ctx.module_graph(), openfpga_ctx.arch().config_protocol,
       openfpga_ctx.arch().tile_annotations, openfpga_ctx.arch().circuit_lib);
 
+  /* Flatten the configurable children once for the bitstream builders and
+   * the writers */
+  openfpga_ctx.mutable_config_child_hierarchy() = build_config_child_hierarchy(
+    openfpga_ctx.module_graph(), openfpga_ctx.arch().config_protocol,
+    cmd_context.option_enable(cmd, opt_verbose));
+
+  /* Report the modules depending on the edited circuit models, which explain
+   * the cache miss, and save the fabric for the next run */
+  if ((false == fabric_cache_fname.empty()) && (false == fabric_reused) &&
+      (CMD_EXEC_SUCCESS == final_status)) {
+    if (false == changed_circuit_models.empty()) {
+      std::vector<ModuleId> dependent_modules =
+        find_circuit_model_dependent_modules(openfpga_ctx.module_graph(),
+                                             changed_circuit_models);
+      VTR_LOG("%lu modules depend on the edited circuit models\n",
+              dependent_modules.size());
+      for (const ModuleId& module : dependent_modules) {
+        VTR_LOGV(cmd_context.option_enable(cmd, opt_verbose), "\t%s\n",
+                 openfpga_ctx.module_graph().module_name(module).c_str());
+      }
+    }
+    /* Remove the previous digests first, so that they never describe a
+     * partially written image */
+    std::remove((fabric_cache_fname + ".digest").c_str());
+    curr_status = write_fabric_binary_image(
+      fabric_cache_fname,
+      compute_fabric_binary_image_digest_template<T>(openfpga_ctx),
+      openfpga_ctx.flow_manager().compress_routing(),
+      openfpga_ctx.flow_manager().bitstream_only(),
+      openfpga_ctx.flow_manager().gsb_nets_deferred(),
+      openfpga_ctx.flow_manager().duplicate_grid_pin(),
+      openfpga_ctx.module_graph(), openfpga_ctx.decoder_lib(),
+      openfpga_ctx.blwl_shift_register_banks(),
+      openfpga_ctx.io_location_map(), openfpga_ctx.fabric_global_port_info(),
+      cmd_context.option_enable(cmd, opt_verbose));
+    if (CMD_EXEC_SUCCESS == curr_status) {
+      curr_status =
+        write_fabric_build_digest(fabric_cache_fname + ".digest", build_digest);
+    }
+    if (CMD_EXEC_SUCCESS != curr_status) {
+      final_status = curr_status;
+    }
+  }
+
   /* Output fabric key if user requested */
   if (true == cmd_context.option_enable(cmd, opt_write_fabric_key)) {
     std::string fkey_fname =
@@ -203,6 +559,7 @@ int write_fabric_hierarchy_template(const T& openfpga_ctx, const Command& cmd,
   /* Write hierarchy to a file */
   return write_fabric_hierarchy_to_text_file(
     openfpga_ctx.module_graph(), hie_file_name, size_t(depth),
+    cmd_context.option_enable(cmd, cmd.option("dag")),
     cmd_context.option_enable(cmd, opt_verbose));
 }
 
@@ -231,6 +588,106 @@ int write_fabric_io_info_template(const T& openfpga_ctx, const Command& cmd,
     cmd_context.option_enable(cmd, opt_verbose));
 }
 
+/********************************************************************
+ * Save the fabric which is built by build_fabric to a binary image
+ *******************************************************************/
+template <class T>
+int save_context_template(const T& openfpga_ctx, const Command& cmd,
+                          const CommandContext& cmd_context) {
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+
+  return write_fabric_binary_image(
+    cmd_context.option_value(cmd, opt_file),
+    compute_fabric_binary_image_digest_template<T>(openfpga_ctx),
+    openfpga_ctx.flow_manager().compress_routing(),
+    openfpga_ctx.flow_manager().bitstream_only(),
+    openfpga_ctx.flow_manager().gsb_nets_deferred(),
+    openfpga_ctx.flow_manager().duplicate_grid_pin(),
+    openfpga_ctx.module_graph(), openfpga_ctx.decoder_lib(),
+    openfpga_ctx.blwl_shift_register_banks(), openfpga_ctx.io_location_map(),
+    openfpga_ctx.fabric_global_port_info(),
+    cmd_context.option_enable(cmd, opt_verbose));
+}
+
+/********************************************************************
+ * Restore the fabric from a binary image, which replaces build_fabric.
+ * The unique routing modules are not stored in the image, as they are
+ * bound to the routing resource graph of the current run. They are
+ * identified again (or loaded from a cache file) when the fabric is built
+ * with a compressed routing hierarchy.
+ * When succeed, build_fabric is considered as executed, so that the
+ * commands depending on it can be executed
+ *******************************************************************/
+template <class T>
+int load_context_template(openfpga::Shell<T>* shell, T& openfpga_ctx,
+                          const Command& cmd,
+                          const CommandContext& cmd_context) {
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_unique_module_cache = cmd.option("unique_module_cache");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+
+  bool compress_routing = false;
+  bool bitstream_only = false;
+  bool gsb_nets_deferred = false;
+  bool duplicate_grid_pin = false;
+  size_t out_of_core_min_block_size = 0;
+  if (false == find_out_of_core_min_block_size(cmd, cmd_context,
+                                               out_of_core_min_block_size)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  ScopedMappedAllocation mapped_scope(find_out_of_core_dir(cmd, cmd_context),
+                                      out_of_core_min_block_size);
+  int status = read_fabric_binary_image(
+    cmd_context.option_value(cmd, opt_file),
+    compute_fabric_binary_image_digest_template<T>(openfpga_ctx),
+    compress_routing, bitstream_only, gsb_nets_deferred, duplicate_grid_pin,
+    openfpga_ctx.mutable_module_graph(),
+    openfpga_ctx.mutable_decoder_lib(),
+    openfpga_ctx.mutable_blwl_shift_register_banks(),
+    openfpga_ctx.mutable_io_location_map(),
+    openfpga_ctx.mutable_fabric_global_port_info(),
+    cmd_context.option_enable(cmd, opt_verbose));
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+
+  openfpga_ctx.mutable_flow_manager().set_bitstream_only(bitstream_only);
+  openfpga_ctx.mutable_flow_manager().set_gsb_nets_deferred(gsb_nets_deferred);
+  openfpga_ctx.mutable_flow_manager().set_duplicate_grid_pin(
+    duplicate_grid_pin);
+
+  if (true == compress_routing) {
+    /* Use the number of threads of the shell by default */
+    int num_threads = default_num_threads();
+    if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+      num_threads =
+        std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+    }
+    std::string cache_fname;
+    if (true == cmd_context.option_enable(cmd, opt_unique_module_cache)) {
+      cache_fname = cmd_context.option_value(cmd, opt_unique_module_cache);
+    }
+    compress_routing_hierarchy_template<T>(
+      openfpga_ctx, cache_fname, find_num_threads(num_threads),
+      cmd_context.option_enable(cmd, opt_verbose));
+    openfpga_ctx.mutable_flow_manager().set_compress_routing(true);
+    openfpga_ctx.mutable_flow_manager().set_unique_module_cache(cache_fname);
+  }
+
+  /* The hierarchy of configurable children is not stored in the image */
+  openfpga_ctx.mutable_config_child_hierarchy() = build_config_child_hierarchy(
+    openfpga_ctx.module_graph(), openfpga_ctx.arch().config_protocol,
+    cmd_context.option_enable(cmd, opt_verbose));
+
+  shell->set_command_status(shell->command("build_fabric"), CMD_EXEC_SUCCESS);
+
+  return CMD_EXEC_SUCCESS;
+}
+
 } /* end namespace openfpga */
 
 #endif
@@ -0,0 +1,251 @@
+/********************************************************************
+ * This file includes functions to cache the outputs of commands which
+ * only read the context and write files, e.g., write_pnr_sdc, so that
+ * a rerun of a flow with the same inputs copies the outputs from the
+ * cache rather than generating them again.
+ *
+ * The cache is content-addressed. The context is identified by a digest
+ * of the commands which have built it, i.e., their command lines and the
+ * contents of the files named on the command lines, e.g., architectures
+ * and netlists, mixed with a digest of the data of the context after
+ * each of them, e.g., the module graph. The key of a command mixes the
+ * digest of the context, the version of OpenFPGA and the options of the
+ * command.
+ *
+ * Each entry of the cache is a directory named by the key, which
+ * includes a copy of each output file and a manifest listing their paths.
+ * The manifest is written last, so that an entry without a manifest is
+ * ignored.
+ *******************************************************************/
+#include "openfpga_command_cache.h"
+
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
+#include "openfpga_digest.h"
+#include "openfpga_version.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Name of the manifest of each cache entry */
+constexpr const char* COMMAND_CACHE_MANIFEST = "manifest";
+
+/********************************************************************
+ * Mix a value into a 64-bit FNV-1a digest
+ *******************************************************************/
+static void digest_value(uint64_t& digest, const uint64_t& value) {
+  for (size_t ibyte = 0; ibyte < sizeof(value); ++ibyte) {
+    digest ^= (value >> (8 * ibyte)) & 0xff;
+    digest *= 0x100000001b3ULL;
+  }
+}
+
+static void digest_string(uint64_t& digest, const std::string& str) {
+  digest_value(digest, str.size());
+  for (const char& c : str) {
+    digest ^= static_cast<unsigned char>(c);
+    digest *= 0x100000001b3ULL;
+  }
+}
+
+/* Mix the content of a string when it names a regular file */
+static void digest_file_content(uint64_t& digest, const std::string& fname) {
+  struct stat file_stat;
+  if ((0 == stat(fname.c_str(), &file_stat)) && S_ISREG(file_stat.st_mode)) {
+    digest_value(digest, compute_file_digest(fname));
+  }
+}
+
+/********************************************************************
+ * Mix a command line and the digest of the data of the context after
+ * the command into the digest of a context.
+ * Tokens naming files are also digested by the contents of the files.
+ * The digest is expected to be updated after the command is executed,
+ * so that its output files, if any, are digested by their new contents.
+ * The command lines cover the data which are not in the state digest,
+ * e.g., the results of VPR, while files which are not named on the
+ * command lines, e.g., the files included by other files, are not covered
+ *******************************************************************/
+uint64_t digest_context_command(const uint64_t& digest,
+                                const std::vector<std::string>& tokens,
+                                const uint64_t& state_digest) {
+  uint64_t new_digest = digest;
+  digest_value(new_digest, tokens.size());
+  for (const std::string& token : tokens) {
+    digest_string(new_digest, token);
+    digest_file_content(new_digest, token);
+  }
+  digest_value(new_digest, state_digest);
+  return new_digest;
+}
+
+/********************************************************************
+ * Compute the key of a command on a context. The output option is only
+ * digested by its value, as the output of a previous run may exist
+ *******************************************************************/
+uint64_t compute_command_cache_key(const uint64_t& context_digest,
+                                   const Command& cmd,
+                                   const CommandContext& cmd_context,
+                                   const CommandOptionId& output_option) {
+  uint64_t key = context_digest;
+  digest_string(key, VERSION);
+  digest_string(key, VCS_REVISION);
+  digest_string(key, BUILD_TIMESTAMP);
+  digest_string(key, cmd.name());
+  for (const CommandOptionId& option : cmd.options()) {
+    bool enabled = cmd_context.option_enable(cmd, option);
+    digest_value(key, enabled);
+    if (false == enabled) {
+      continue;
+    }
+    std::string value = cmd_context.option_value(cmd, option);
+    digest_string(key, value);
+    if (output_option != option) {
+      digest_file_content(key, value);
+    }
+  }
+  return key;
+}
+
+/********************************************************************
+ * Copy a file. Return false if the file cannot be copied
+ *******************************************************************/
+static bool copy_file(const std::string& src_fname,
+                      const std::string& dest_fname) {
+  std::ifstream src(src_fname, std::ios::binary);
+  std::ofstream dest(dest_fname, std::ios::binary | std::ios::trunc);
+  if (!src.is_open() || !dest.is_open()) {
+    return false;
+  }
+  std::vector<char> buffer(1 << 16);
+  while (src.read(buffer.data(), buffer.size()) || (0 < src.gcount())) {
+    dest.write(buffer.data(), src.gcount());
+  }
+  dest.close();
+  return !dest.fail();
+}
+
+/********************************************************************
+ * Copy the outputs of an entry to their paths.
+ * Return false if the entry is not complete or any output cannot be
+ * restored
+ *******************************************************************/
+static bool restore_command_outputs(const std::string& entry_dir,
+                                    size_t& num_outputs) {
+  std::ifstream manifest(entry_dir + COMMAND_CACHE_MANIFEST);
+  if (!manifest.is_open()) {
+    return false;
+  }
+  num_outputs = 0;
+  std::string line;
+  while (std::getline(manifest, line)) {
+    /* Each line is an index of the cached file and the path of the output,
+     * separated by the first space */
+    size_t delim_pos = line.find(' ');
+    if (std::string::npos == delim_pos) {
+      return false;
+    }
+    std::string fname = line.substr(delim_pos + 1);
+    std::string dir_name = find_path_dir_name(fname);
+    if (false == dir_name.empty()) {
+      create_directory(dir_name);
+    }
+    if (false == copy_file(entry_dir + line.substr(0, delim_pos), fname)) {
+      VTR_LOG_WARN("Fail to restore file '%s' from command cache!\n",
+                   fname.c_str());
+      return false;
+    }
+    ++num_outputs;
+  }
+  return true;
+}
+
+/********************************************************************
+ * Copy outputs to an entry and write its manifest.
+ * Return false if any output cannot be cached
+ *******************************************************************/
+static bool save_command_outputs(const std::string& entry_dir,
+                                 const std::vector<std::string>& fnames) {
+  create_directory(entry_dir);
+  std::string manifest_fname = entry_dir + COMMAND_CACHE_MANIFEST;
+  std::string temp_manifest_fname = manifest_fname + ".tmp";
+  std::ofstream manifest(temp_manifest_fname, std::ios::trunc);
+  if (!manifest.is_open()) {
+    return false;
+  }
+  for (size_t ifile = 0; ifile < fnames.size(); ++ifile) {
+    if (false ==
+        copy_file(fnames[ifile], entry_dir + std::to_string(ifile))) {
+      return false;
+    }
+    manifest << ifile << " " << fnames[ifile] << "\n";
+  }
+  manifest.close();
+  if (manifest.fail()) {
+    return false;
+  }
+  return 0 == std::rename(temp_manifest_fname.c_str(), manifest_fname.c_str());
+}
+
+/********************************************************************
+ * Run a command through the cache:
+ * - When the cache has an entry for the key, the outputs are copied from
+ *   the entry and the command is not executed
+ * - Otherwise, the command is executed, and the files which it opens
+ *   for output are saved as the entry of the key. Temporary files which
+ *   are removed by the command are not saved.
+ * A cache which cannot be written never fails the command.
+ * The files are recorded by BufferedFileStream, which all the cached
+ * commands use to write their outputs.
+ *******************************************************************/
+int run_cached_command(const std::string& cache_dir, const uint64_t& key,
+                       const std::string& cmd_name,
+                       const std::function<int()>& exec_func) {
+  std::string entry_dir =
+    format_dir_path(format_dir_path(cache_dir) + format_file_digest(key));
+
+  size_t num_outputs = 0;
+  if (true == restore_command_outputs(entry_dir, num_outputs)) {
+    VTR_LOG(
+      "Restored %lu output files of command '%s' from command cache '%s'\n",
+      num_outputs, cmd_name.c_str(), entry_dir.c_str());
+    return CMD_EXEC_SUCCESS;
+  }
+
+  std::vector<std::string> fnames;
+  int status = CMD_EXEC_SUCCESS;
+  {
+    ScopedOutputFileRecord output_file_record;
+    status = exec_func();
+    for (const std::string& fname : output_file_record.fnames()) {
+      struct stat file_stat;
+      if ((0 == stat(fname.c_str(), &file_stat)) &&
+          S_ISREG(file_stat.st_mode)) {
+        fnames.push_back(fname);
+      }
+    }
+  }
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+
+  if (false == save_command_outputs(entry_dir, fnames)) {
+    VTR_LOG_WARN("Fail to save the outputs of command '%s' to cache '%s'!\n",
+                 cmd_name.c_str(), entry_dir.c_str());
+  }
+
+  return status;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,37 @@
+#ifndef OPENFPGA_COMMAND_CACHE_H
+#define OPENFPGA_COMMAND_CACHE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "command.h"
+#include "command_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+uint64_t digest_context_command(const uint64_t& digest,
+                                const std::vector<std::string>& tokens,
+                                const uint64_t& state_digest);
+
+uint64_t compute_command_cache_key(const uint64_t& context_digest,
+                                   const Command& cmd,
+                                   const CommandContext& cmd_context,
+                                   const CommandOptionId& output_option);
+
+int run_cached_command(const std::string& cache_dir, const uint64_t& key,
+                       const std::string& cmd_name,
+                       const std::function<int()>& exec_func);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef OPENFPGA_COMMAND_CACHE_TEMPLATE_H
+#define OPENFPGA_COMMAND_CACHE_TEMPLATE_H
+/********************************************************************
+ * This file includes the wrapper to cache the outputs of constant
+ * commands, which is built on the functions of openfpga_command_cache.h
+ *******************************************************************/
+#include <functional>
+
+#include "command.h"
+#include "command_context.h"
+#include "device_rr_gsb_cache.h"
+#include "globals.h"
+#include "openfpga_binary_image.h"
+#include "openfpga_command_cache.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Compute the digest of the data of the context which the cached
+ * commands read, i.e., the architecture, the routing resources and the
+ * fabric. The objects are digested by their binary images, which store
+ * all their internal data. The data which have no binary image, e.g.,
+ * the results of VPR, are left to the digest of the command lines
+ *******************************************************************/
+template <class T>
+uint64_t compute_context_state_digest_template(const T& openfpga_ctx) {
+  BinaryImageWriter writer;
+
+  write_binary_image(
+    writer, compute_device_rr_gsb_digest(g_vpr_ctx.device().rr_graph,
+                                         openfpga_ctx.vpr_device_annotation(),
+                                         openfpga_ctx.device_rr_gsb()));
+
+  openfpga_ctx.arch().tech_lib.write_to_binary_image(writer);
+  openfpga_ctx.arch().circuit_lib.write_to_binary_image(writer);
+  write_binary_image(writer, openfpga_ctx.arch().circuit_tech_binding);
+  openfpga_ctx.arch().config_protocol.write_to_binary_image(writer);
+  write_binary_image(writer, openfpga_ctx.arch().cb_switch2circuit);
+  write_binary_image(writer, openfpga_ctx.arch().sb_switch2circuit);
+  write_binary_image(writer, openfpga_ctx.arch().routing_seg2circuit);
+  openfpga_ctx.arch().arch_direct.write_to_binary_image(writer);
+  openfpga_ctx.arch().tile_annotations.write_to_binary_image(writer);
+  write_binary_image(writer, openfpga_ctx.arch().pb_type_annotations.size());
+  for (const PbTypeAnnotation& pb_type_annotation :
+       openfpga_ctx.arch().pb_type_annotations) {
+    pb_type_annotation.write_to_binary_image(writer);
+  }
+
+  write_binary_image(writer, openfpga_ctx.flow_manager().compress_routing());
+  write_binary_image(writer, openfpga_ctx.flow_manager().bitstream_only());
+  write_binary_image(writer,
+                     openfpga_ctx.flow_manager().gsb_nets_deferred());
+  write_binary_image(writer,
+                     openfpga_ctx.flow_manager().duplicate_grid_pin());
+  openfpga_ctx.module_graph().write_to_binary_image(writer);
+  openfpga_ctx.decoder_lib().write_to_binary_image(writer);
+  openfpga_ctx.blwl_shift_register_banks().write_to_binary_image(writer);
+  openfpga_ctx.io_location_map().write_to_binary_image(writer);
+  openfpga_ctx.fabric_global_port_info().write_to_binary_image(writer);
+
+  return writer.digest();
+}
+
+/********************************************************************
+ * Wrap the execute function of a constant command which writes its
+ * outputs to the path given by option '--file', either a file or a
+ * directory. When the command cache is enabled, the outputs are copied
+ * from the cache if the command has been executed with the same options
+ * on the same context.
+ *******************************************************************/
+template <class T>
+std::function<int(const T&, const Command&, const CommandContext&)>
+cache_const_command_template(
+  std::function<int(const T&, const Command&, const CommandContext&)>
+    exec_func) {
+  return [exec_func](const T& openfpga_ctx, const Command& cmd,
+                     const CommandContext& cmd_context) {
+    std::string cache_dir = openfpga_ctx.flow_manager().command_cache_dir();
+    if (true == cache_dir.empty()) {
+      return exec_func(openfpga_ctx, cmd, cmd_context);
+    }
+    CommandOptionId opt_file = cmd.option("file");
+    uint64_t key = compute_command_cache_key(
+      openfpga_ctx.flow_manager().context_digest(), cmd, cmd_context,
+      opt_file);
+    return run_cached_command(
+      cache_dir, key, cmd.name(),
+      [&]() { return exec_func(openfpga_ctx, cmd, cmd_context); });
+  };
+}
+
+} /* end namespace openfpga */
+
+#endif
@@ -4,7 +4,10 @@
 #include <vector>
 
 #include "bitstream_manager.h"
+#include "bitstream_tile_index.h"
+#include "device_bitstream_snapshot.h"
 #include "bitstream_setting.h"
+#include "config_child_hierarchy.h"
 #include "decoder_library.h"
 #include "device_rr_gsb.h"
 #include "fabric_bitstream.h"
@@ -95,12 +98,21 @@ class OpenfpgaContext : public Context {
   const openfpga::FabricBitstream& fabric_bitstream() const {
     return fabric_bitstream_;
   }
+  const openfpga::BitstreamTileIndex& bitstream_tile_index() const {
+    return bitstream_tile_index_;
+  }
+  const openfpga::DeviceBitstreamSnapshot& bitstream_snapshot() const {
+    return bitstream_snapshot_;
+  }
   const openfpga::IoLocationMap& io_location_map() const {
     return io_location_map_;
   }
   const openfpga::FabricGlobalPortInfo& fabric_global_port_info() const {
     return fabric_global_port_info_;
   }
+  const openfpga::ConfigChildHierarchy& config_child_hierarchy() const {
+    return config_child_hierarchy_;
+  }
   const openfpga::NetlistManager& verilog_netlists() const {
     return verilog_netlists_;
   }
@@ -149,17 +161,54 @@ class OpenfpgaContext : public Context {
   openfpga::FabricBitstream& mutable_fabric_bitstream() {
     return fabric_bitstream_;
   }
+  openfpga::BitstreamTileIndex& mutable_bitstream_tile_index() {
+    return bitstream_tile_index_;
+  }
+  openfpga::DeviceBitstreamSnapshot& mutable_bitstream_snapshot() {
+    return bitstream_snapshot_;
+  }
   openfpga::IoLocationMap& mutable_io_location_map() {
     return io_location_map_;
   }
   openfpga::FabricGlobalPortInfo& mutable_fabric_global_port_info() {
     return fabric_global_port_info_;
   }
+  openfpga::ConfigChildHierarchy& mutable_config_child_hierarchy() {
+    return config_child_hierarchy_;
+  }
   openfpga::NetlistManager& mutable_verilog_netlists() {
     return verilog_netlists_;
   }
   openfpga::NetlistManager& mutable_spice_netlists() { return spice_netlists_; }
 
+ public: /* Public deconstructors */
+  /* Clear the data which depends on the design, as well as the annotations
+   * referring to the device of VPR, which is rebuilt whenever VPR runs.
+   * The architecture, the settings and the fabric are kept, so that another
+   * design can be implemented on the same fabric.
+   * The bitstreams are kept as well when a snapshot of the implementation
+   * results is taken, so that the bitstreams of the next design can be
+   * updated from them by 'build_architecture_bitstream --incremental'
+   */
+  void reset_design_context() {
+    vpr_device_annotation_ = openfpga::VprDeviceAnnotation();
+    vpr_netlist_annotation_ = openfpga::VprNetlistAnnotation();
+    vpr_clustering_annotation_ = openfpga::VprClusteringAnnotation();
+    vpr_placement_annotation_ = openfpga::VprPlacementAnnotation();
+    vpr_routing_annotation_ = openfpga::VprRoutingAnnotation();
+    vpr_bitstream_annotation_ = openfpga::VprBitstreamAnnotation();
+    device_rr_gsb_.clear();
+    mux_lib_ = openfpga::MuxLibrary();
+    tile_direct_ = openfpga::TileDirect();
+    if (true == bitstream_snapshot_.empty()) {
+      bitstream_manager_ = openfpga::BitstreamManager();
+      fabric_bitstream_ = openfpga::FabricBitstream();
+      bitstream_tile_index_.clear();
+    }
+    verilog_netlists_ = openfpga::NetlistManager();
+    spice_netlists_ = openfpga::NetlistManager();
+  }
+
  private: /* Internal data */
   /* Data structure to store information from read_openfpga_arch library */
   openfpga::Arch arch_;
@@ -205,10 +254,17 @@ class OpenfpgaContext : public Context {
   openfpga::ModuleManager module_graph_;
   openfpga::IoLocationMap io_location_map_;
   openfpga::FabricGlobalPortInfo fabric_global_port_info_;
+  /* Flattened configurable children of the top-level module */
+  openfpga::ConfigChildHierarchy config_child_hierarchy_;
 
   /* Bitstream database */
   openfpga::BitstreamManager bitstream_manager_;
   openfpga::FabricBitstream fabric_bitstream_;
+  /* Index from the tiles of the fabric to their configuration bits */
+  openfpga::BitstreamTileIndex bitstream_tile_index_;
+  /* Implementation results which the bitstream database is decoded from,
+   * which are only kept to update the database incrementally */
+  openfpga::DeviceBitstreamSnapshot bitstream_snapshot_;
 
   /* Netlist database
    * TODO: Each format should have an independent entry
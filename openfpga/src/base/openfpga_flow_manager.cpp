@@ -14,6 +14,15 @@ namespace openfpga {
 FlowManager::FlowManager() {
   /* Turn off compress_routing as default */
   compress_routing_ = false;
+  bitstream_only_ = false;
+  gsb_nets_deferred_ = false;
+  duplicate_grid_pin_ = false;
+  /* No stage is deferred until 'link_openfpga_arch' runs */
+  link_arch_stage_pending_.fill(false);
+  link_arch_num_threads_ = 1;
+  link_arch_verbose_ = false;
+  /* No command has been executed */
+  context_digest_ = 0xcbf29ce484222325ULL;
 }
 
 /**************************************************
@@ -21,6 +30,38 @@ FlowManager::FlowManager() {
  *************************************************/
 bool FlowManager::compress_routing() const { return compress_routing_; }
 
+std::string FlowManager::unique_module_cache() const {
+  return unique_module_cache_;
+}
+
+bool FlowManager::bitstream_only() const { return bitstream_only_; }
+
+bool FlowManager::gsb_nets_deferred() const { return gsb_nets_deferred_; }
+
+bool FlowManager::duplicate_grid_pin() const { return duplicate_grid_pin_; }
+
+bool FlowManager::link_arch_stage_pending(
+  const e_link_arch_stage& stage) const {
+  VTR_ASSERT(stage < NUM_LINK_ARCH_STAGES);
+  return link_arch_stage_pending_[stage];
+}
+
+std::string FlowManager::link_arch_activity_file() const {
+  return link_arch_activity_file_;
+}
+
+int FlowManager::link_arch_num_threads() const {
+  return link_arch_num_threads_;
+}
+
+bool FlowManager::link_arch_verbose() const { return link_arch_verbose_; }
+
+std::string FlowManager::command_cache_dir() const {
+  return command_cache_dir_;
+}
+
+uint64_t FlowManager::context_digest() const { return context_digest_; }
+
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
@@ -28,4 +69,42 @@ void FlowManager::set_compress_routing(const bool& enabled) {
   compress_routing_ = enabled;
 }
 
+void FlowManager::set_unique_module_cache(const std::string& fname) {
+  unique_module_cache_ = fname;
+}
+
+void FlowManager::set_bitstream_only(const bool& enabled) {
+  bitstream_only_ = enabled;
+}
+
+void FlowManager::set_gsb_nets_deferred(const bool& enabled) {
+  gsb_nets_deferred_ = enabled;
+}
+
+void FlowManager::set_duplicate_grid_pin(const bool& enabled) {
+  duplicate_grid_pin_ = enabled;
+}
+
+void FlowManager::set_link_arch_stage_pending(const e_link_arch_stage& stage,
+                                              const bool& pending) {
+  VTR_ASSERT(stage < NUM_LINK_ARCH_STAGES);
+  link_arch_stage_pending_[stage] = pending;
+}
+
+void FlowManager::set_link_arch_options(const std::string& activity_file,
+                                        const int& num_threads,
+                                        const bool& verbose) {
+  link_arch_activity_file_ = activity_file;
+  link_arch_num_threads_ = num_threads;
+  link_arch_verbose_ = verbose;
+}
+
+void FlowManager::set_command_cache_dir(const std::string& dir) {
+  command_cache_dir_ = dir;
+}
+
+void FlowManager::set_context_digest(const uint64_t& digest) {
+  context_digest_ = digest;
+}
+
 } /* end namespace openfpga */
@@ -4,9 +4,24 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <array>
+#include <cstdint>
+#include <string>
+
 /* Begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Stages of 'link_openfpga_arch' which can be deferred until the first
+ * command requiring them is executed
+ *******************************************************************/
+enum e_link_arch_stage {
+  LINK_ARCH_ROUTING_RESULTS,
+  LINK_ARCH_SIMULATION_SETTING,
+  LINK_ARCH_BITSTREAM_SETTING,
+  NUM_LINK_ARCH_STAGES
+};
+
 /********************************************************************
  * FlowManager aims to resolve the dependency between OpenFPGA functional
  * code blocks
@@ -20,12 +35,53 @@ class FlowManager {
 
  public: /* Public accessors */
   bool compress_routing() const;
+  /* The cache file of unique GSBs used when compressing routing, if any */
+  std::string unique_module_cache() const;
+  /* If the fabric is built for bitstream generation only, i.e., without the
+   * nets connecting the grids and the routing blocks */
+  bool bitstream_only() const;
+  /* If the nets connecting the grids and the routing blocks are not built
+   * in the module graph, but generated by the netlist writers */
+  bool gsb_nets_deferred() const;
+  /* If the pins on the same side of a grid are duplicated in the fabric */
+  bool duplicate_grid_pin() const;
+  /* If a stage of 'link_openfpga_arch' has been deferred and not run yet */
+  bool link_arch_stage_pending(const e_link_arch_stage& stage) const;
+  /* Options of 'link_openfpga_arch' which are used by the deferred stages */
+  std::string link_arch_activity_file() const;
+  int link_arch_num_threads() const;
+  bool link_arch_verbose() const;
+  /* The directory where the outputs of commands are cached, if any */
+  std::string command_cache_dir() const;
+  /* Digest of the commands which have built the context so far, and of
+   * the data of the context after each of them */
+  uint64_t context_digest() const;
 
  public: /* Public mutators */
   void set_compress_routing(const bool& enabled);
+  void set_unique_module_cache(const std::string& fname);
+  void set_bitstream_only(const bool& enabled);
+  void set_gsb_nets_deferred(const bool& enabled);
+  void set_duplicate_grid_pin(const bool& enabled);
+  void set_link_arch_stage_pending(const e_link_arch_stage& stage,
+                                   const bool& pending);
+  void set_link_arch_options(const std::string& activity_file,
+                             const int& num_threads, const bool& verbose);
+  void set_command_cache_dir(const std::string& dir);
+  void set_context_digest(const uint64_t& digest);
 
  private: /* Internal Data */
   bool compress_routing_;
+  std::string unique_module_cache_;
+  bool bitstream_only_;
+  bool gsb_nets_deferred_;
+  bool duplicate_grid_pin_;
+  std::array<bool, NUM_LINK_ARCH_STAGES> link_arch_stage_pending_;
+  std::string link_arch_activity_file_;
+  int link_arch_num_threads_;
+  bool link_arch_verbose_;
+  std::string command_cache_dir_;
+  uint64_t context_digest_;
 };
 
 } /* End namespace openfpga*/
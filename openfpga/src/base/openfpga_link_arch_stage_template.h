@@ -0,0 +1,115 @@
+#ifndef OPENFPGA_LINK_ARCH_STAGE_TEMPLATE_H
+#define OPENFPGA_LINK_ARCH_STAGE_TEMPLATE_H
+/********************************************************************
+ * This file includes functions to run the stages of 'link_openfpga_arch'
+ * which can be deferred until a command requires them
+ *******************************************************************/
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "annotate_bitstream_setting.h"
+#include "annotate_simulation_setting.h"
+#include "command_exit_codes.h"
+#include "globals.h"
+#include "openfpga_annotate_routing.h"
+#include "openfpga_flow_manager.h"
+#include "openfpga_parallel.h"
+#include "read_activity.h"
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Run a stage of 'link_openfpga_arch', using the options stored in the
+ * flow manager when the command was executed
+ * - routing results: net mapping and previous nodes of each rr_node
+ * - simulation setting: number of clock cycles and clock frequency
+ * - bitstream setting: annotation of bitstream settings to pb_types
+ *******************************************************************/
+template <class T>
+int run_link_arch_stage_template(T& openfpga_ctx,
+                                 const e_link_arch_stage& stage) {
+  const FlowManager& flow_manager = openfpga_ctx.flow_manager();
+
+  if (LINK_ARCH_ROUTING_RESULTS == stage) {
+    /* Annotate routing results:
+     * - net mapping to each rr_node
+     * - previous nodes driving each rr_node
+     */
+    openfpga_ctx.mutable_vpr_routing_annotation().init(
+      g_vpr_ctx.device().rr_graph);
+
+    annotate_vpr_rr_node_nets(g_vpr_ctx.device(), g_vpr_ctx.clustering(),
+                              g_vpr_ctx.routing(),
+                              openfpga_ctx.mutable_vpr_routing_annotation(),
+                              flow_manager.link_arch_verbose());
+
+    annotate_rr_node_previous_nodes(
+      g_vpr_ctx.device(), g_vpr_ctx.clustering(), g_vpr_ctx.routing(),
+      openfpga_ctx.mutable_vpr_routing_annotation(),
+      find_num_threads(flow_manager.link_arch_num_threads()),
+      flow_manager.link_arch_verbose());
+    return CMD_EXEC_SUCCESS;
+  }
+
+  if (LINK_ARCH_SIMULATION_SETTING == stage) {
+    /* Read activity file is manadatory in the following flow-run settings
+     * - When users specify that number of clock cycles
+     *   should be inferred from FPGA implmentation
+     * - When FPGA-SPICE is enabled
+     */
+    std::unordered_map<AtomNetId, t_net_power> net_activity;
+    if (false == flow_manager.link_arch_activity_file().empty()) {
+      net_activity =
+        read_activity(g_vpr_ctx.atom().nlist,
+                      flow_manager.link_arch_activity_file().c_str());
+    }
+
+    /* TODO: Annotate the number of clock cycles and clock frequency by
+     * following VPR results We SHOULD create a new simulation setting for
+     * OpenFPGA use only Avoid overwrite the raw data achieved when parsing!!!
+     */
+    return annotate_simulation_setting(
+      g_vpr_ctx.atom(), g_vpr_ctx.clustering(), net_activity,
+      openfpga_ctx.mutable_simulation_setting());
+  }
+
+  VTR_ASSERT(LINK_ARCH_BITSTREAM_SETTING == stage);
+  /* Build bitstream annotation based on bitstream settings */
+  return annotate_bitstream_setting(
+    openfpga_ctx.bitstream_setting(), g_vpr_ctx.device(),
+    openfpga_ctx.vpr_device_annotation(),
+    openfpga_ctx.mutable_vpr_bitstream_annotation());
+}
+
+/********************************************************************
+ * Run the deferred stages of 'link_openfpga_arch' which are required by
+ * a command. Stages which have already been run are skipped, so that
+ * each stage runs at most once after 'link_openfpga_arch'
+ *******************************************************************/
+template <class T>
+int require_link_arch_stages_template(
+  T& openfpga_ctx, const std::vector<e_link_arch_stage>& stages) {
+  for (const e_link_arch_stage& stage : stages) {
+    if (false == openfpga_ctx.flow_manager().link_arch_stage_pending(stage)) {
+      continue;
+    }
+    vtr::ScopedStartFinishTimer timer(
+      "Annotate implementation results to OpenFPGA architecture");
+    int status = run_link_arch_stage_template<T>(openfpga_ctx, stage);
+    if (CMD_EXEC_FATAL_ERROR == status) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    openfpga_ctx.mutable_flow_manager().set_link_arch_stage_pending(stage,
+                                                                    false);
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
+
+#endif
@@ -18,8 +18,11 @@
 #include "command_exit_codes.h"
 #include "globals.h"
 #include "mux_library_builder.h"
-#include "openfpga_annotate_routing.h"
+#include "openfpga_build_fabric_template.h"
+#include "openfpga_link_arch_stage_template.h"
+#include "openfpga_parallel.h"
 #include "openfpga_rr_graph_support.h"
+#include "openfpga_trace.h"
 #include "pb_type_utils.h"
 #include "read_activity.h"
 #include "vpr_device_annotation.h"
@@ -43,11 +46,35 @@ int link_arch_template(T& openfpga_ctx, const Command& cmd,
                        const CommandContext& cmd_context) {
   vtr::ScopedStartFinishTimer timer(
     "Link OpenFPGA architecture to VPR architecture");
+  OPENFPGA_TRACE_FUNCTION();
 
   CommandOptionId opt_activity_file = cmd.option("activity_file");
   CommandOptionId opt_sort_edge = cmd.option("sort_gsb_chan_node_in_edges");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
+  CommandOptionId opt_lazy = cmd.option("lazy");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Use the number of threads of the shell by default */
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
+
+  /* Keep the options required by the stages which can be deferred. In lazy
+   * mode, these stages are run by the first command requiring them */
+  std::string activity_file;
+  if (true == cmd_context.option_enable(cmd, opt_activity_file)) {
+    activity_file = cmd_context.option_value(cmd, opt_activity_file);
+  }
+  openfpga_ctx.mutable_flow_manager().set_link_arch_options(
+    activity_file, num_threads, cmd_context.option_enable(cmd, opt_verbose));
+  bool lazy = cmd_context.option_enable(cmd, opt_lazy);
+  for (size_t istage = 0; istage < NUM_LINK_ARCH_STAGES; ++istage) {
+    openfpga_ctx.mutable_flow_manager().set_link_arch_stage_pending(
+      e_link_arch_stage(istage), true);
+  }
+
   /* Build fast look-up between physical tile pin index and port information */
   build_physical_tile_pin2port_info(
     g_vpr_ctx.device(), openfpga_ctx.mutable_vpr_device_annotation());
@@ -59,6 +86,7 @@ int link_arch_template(T& openfpga_ctx, const Command& cmd,
    */
   annotate_pb_types(g_vpr_ctx.device(), openfpga_ctx.arch(),
                     openfpga_ctx.mutable_vpr_device_annotation(),
+                    find_num_threads(num_threads),
                     cmd_context.option_enable(cmd, opt_verbose));
 
   /* Annotate pb_graph_nodes
@@ -69,6 +97,7 @@ int link_arch_template(T& openfpga_ctx, const Command& cmd,
    */
   annotate_pb_graph(g_vpr_ctx.device(),
                     openfpga_ctx.mutable_vpr_device_annotation(),
+                    find_num_threads(num_threads),
                     cmd_context.option_enable(cmd, opt_verbose));
 
   /* Annotate routing architecture to circuit library */
@@ -80,18 +109,11 @@ int link_arch_template(T& openfpga_ctx, const Command& cmd,
    * - net mapping to each rr_node
    * - previous nodes driving each rr_node
    */
-  openfpga_ctx.mutable_vpr_routing_annotation().init(
-    g_vpr_ctx.device().rr_graph);
-
-  annotate_vpr_rr_node_nets(g_vpr_ctx.device(), g_vpr_ctx.clustering(),
-                            g_vpr_ctx.routing(),
-                            openfpga_ctx.mutable_vpr_routing_annotation(),
-                            cmd_context.option_enable(cmd, opt_verbose));
-
-  annotate_rr_node_previous_nodes(g_vpr_ctx.device(), g_vpr_ctx.clustering(),
-                                  g_vpr_ctx.routing(),
-                                  openfpga_ctx.mutable_vpr_routing_annotation(),
-                                  cmd_context.option_enable(cmd, opt_verbose));
+  if ((false == lazy) &&
+      (CMD_EXEC_FATAL_ERROR == require_link_arch_stages_template<T>(
+                                 openfpga_ctx, {LINK_ARCH_ROUTING_RESULTS}))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
 
   /* Build the routing graph annotation
    * - RRGSB
@@ -108,25 +130,39 @@ int link_arch_template(T& openfpga_ctx, const Command& cmd,
   VTR_ASSERT(g_vpr_ctx.device().rr_graph.validate_in_edges());
   annotate_device_rr_gsb(g_vpr_ctx.device(),
                          openfpga_ctx.mutable_device_rr_gsb(),
+                         find_num_threads(num_threads),
                          cmd_context.option_enable(cmd, opt_verbose));
 
   if (true == cmd_context.option_enable(cmd, opt_sort_edge)) {
     sort_device_rr_gsb_chan_node_in_edges(
       g_vpr_ctx.device().rr_graph, openfpga_ctx.mutable_device_rr_gsb(),
+      find_num_threads(num_threads),
       cmd_context.option_enable(cmd, opt_verbose));
     sort_device_rr_gsb_ipin_node_in_edges(
       g_vpr_ctx.device().rr_graph, openfpga_ctx.mutable_device_rr_gsb(),
+      find_num_threads(num_threads),
+      cmd_context.option_enable(cmd, opt_verbose));
+  }
+
+  /* When the fabric has been built on a compressed routing hierarchy, e.g.,
+   * before implementing another design on the same fabric, the unique
+   * modules have to be identified again on the GSBs just built */
+  if (true == openfpga_ctx.flow_manager().compress_routing()) {
+    compress_routing_hierarchy_template<T>(
+      openfpga_ctx, openfpga_ctx.flow_manager().unique_module_cache(),
+      find_num_threads(num_threads),
       cmd_context.option_enable(cmd, opt_verbose));
   }
 
   /* Build multiplexer library */
   openfpga_ctx.mutable_mux_lib() = build_device_mux_library(
-    g_vpr_ctx.device(), const_cast<const T&>(openfpga_ctx));
+    g_vpr_ctx.device(), const_cast<const T&>(openfpga_ctx),
+    find_num_threads(num_threads));
 
   /* Build tile direct annotation */
   openfpga_ctx.mutable_tile_direct() = build_device_tile_direct(
     g_vpr_ctx.device(), openfpga_ctx.arch().arch_direct,
-    cmd_context.option_enable(cmd, opt_verbose));
+    find_num_threads(num_threads), cmd_context.option_enable(cmd, opt_verbose));
 
   /* Annotate clustering results */
   if (CMD_EXEC_FATAL_ERROR ==
@@ -141,40 +177,18 @@ int link_arch_template(T& openfpga_ctx, const Command& cmd,
                          g_vpr_ctx.placement(),
                          openfpga_ctx.mutable_vpr_placement_annotation());
 
-  /* Read activity file is manadatory in the following flow-run settings
-   * - When users specify that number of clock cycles
-   *   should be inferred from FPGA implmentation
-   * - When FPGA-SPICE is enabled
-   */
-  std::unordered_map<AtomNetId, t_net_power> net_activity;
-  if (true == cmd_context.option_enable(cmd, opt_activity_file)) {
-    net_activity =
-      read_activity(g_vpr_ctx.atom().nlist,
-                    cmd_context.option_value(cmd, opt_activity_file).c_str());
-  }
-
-  /* TODO: Annotate the number of clock cycles and clock frequency by following
-   * VPR results We SHOULD create a new simulation setting for OpenFPGA use only
-   * Avoid overwrite the raw data achieved when parsing!!!
-   */
   /* OVERWRITE the simulation setting in openfpga context from the arch
    * TODO: This will be removed when openfpga flow is updated
    */
   // openfpga_ctx.mutable_simulation_setting() =
   // openfpga_ctx.mutable_arch().sim_setting;
-  if (CMD_EXEC_FATAL_ERROR ==
-      annotate_simulation_setting(g_vpr_ctx.atom(), g_vpr_ctx.clustering(),
-                                  net_activity,
-                                  openfpga_ctx.mutable_simulation_setting())) {
-    return CMD_EXEC_FATAL_ERROR;
-  }
-
-  /* Build bitstream annotation based on bitstream settings */
-  if (CMD_EXEC_FATAL_ERROR ==
-      annotate_bitstream_setting(
-        openfpga_ctx.bitstream_setting(), g_vpr_ctx.device(),
-        openfpga_ctx.vpr_device_annotation(),
-        openfpga_ctx.mutable_vpr_bitstream_annotation())) {
+  /* Annotate the simulation settings with the activity file and build
+   * bitstream annotation based on bitstream settings */
+  if ((false == lazy) &&
+      (CMD_EXEC_FATAL_ERROR ==
+       require_link_arch_stages_template<T>(
+         openfpga_ctx,
+         {LINK_ARCH_SIMULATION_SETTING, LINK_ARCH_BITSTREAM_SETTING}))) {
     return CMD_EXEC_FATAL_ERROR;
   }
 
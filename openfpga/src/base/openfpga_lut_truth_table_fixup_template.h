@@ -9,6 +9,7 @@
 #include "command_exit_codes.h"
 #include "openfpga_context.h"
 #include "openfpga_lut_truth_table_fixup.h"
+#include "openfpga_trace.h"
 #include "vtr_time.h"
 
 /********************************************************************
@@ -34,6 +35,7 @@ int lut_truth_table_fixup_template(T& openfpga_context, const Command& cmd,
                                    const CommandContext& cmd_context) {
   vtr::ScopedStartFinishTimer timer(
     "Fix up LUT truth tables after packing optimization");
+  OPENFPGA_TRACE_FUNCTION();
 
   CommandOptionId opt_verbose = cmd.option("verbose");
 
@@ -0,0 +1,73 @@
+#ifndef OPENFPGA_NAME_CACHE_H
+#define OPENFPGA_NAME_CACHE_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "circuit_library.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A cache which interns the names generated by the naming functions,
+ * keyed on the inputs of the names, e.g., the circuit model and the size
+ * of a multiplexer. Builders which generate the same names many times,
+ * e.g., once per routing multiplexer, look up the name rather than
+ * building it again.
+ *
+ * The references to the names stay valid until the cache is cleared.
+ * The cache is not thread-safe: each thread should own its cache.
+ * Since the keys are not bound to a database, e.g., a circuit library,
+ * a cache should not outlive the database that the names come from.
+ *******************************************************************/
+template <class Key, class Hash = std::hash<Key>>
+class NameCache {
+ public: /* Public accessors */
+  size_t size() const { return names_.size(); }
+
+ public: /* Public mutators */
+  /* Find the name of a key. The name is built by the builder, which
+   * appends the name to a given string, when it is not in the cache */
+  template <class Builder>
+  const std::string& find_or_build(const Key& key, const Builder& builder) {
+    auto result = names_.find(key);
+    if (names_.end() != result) {
+      return result->second;
+    }
+    std::string& name = names_[key];
+    builder(name);
+    return name;
+  }
+
+  void clear() { names_.clear(); }
+
+ private: /* Internal data */
+  std::unordered_map<Key, std::string, Hash> names_;
+};
+
+/********************************************************************
+ * Hash of the keys of multiplexer names, i.e., pairs of
+ * <circuit model, multiplexer size>
+ *******************************************************************/
+struct MuxNameKeyHash {
+  size_t operator()(const std::pair<CircuitModelId, size_t>& key) const {
+    return std::hash<CircuitModelId>()(key.first) * 31 +
+           std::hash<size_t>()(key.second);
+  }
+};
+
+/* Names of multiplexer modules, e.g., from generate_mux_subckt_name(),
+ * with a fixed postfix */
+typedef NameCache<std::pair<CircuitModelId, size_t>, MuxNameKeyHash>
+  MuxNameCache;
+
+} /* end namespace openfpga */
+
+#endif
@@ -17,6 +17,35 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/************************************************
+ * Append the decimal digits of an index to a name,
+ * without creating a temporary string as std::to_string() does
+ ***********************************************/
+void append_name_index(std::string& name, const size_t& index) {
+  char digits[24];
+  size_t num_digits = 0;
+  size_t value = index;
+  do {
+    digits[num_digits++] = char('0' + value % 10);
+    value /= 10;
+  } while (0 != value);
+  while (0 < num_digits) {
+    name.push_back(digits[--num_digits]);
+  }
+}
+
+/************************************************
+ * Append a signed index, e.g., a subtile index, to a name
+ ***********************************************/
+static void append_name_index(std::string& name, const int& index) {
+  if (0 > index) {
+    name.push_back('-');
+    append_name_index(name, size_t(-(long)index));
+    return;
+  }
+  append_name_index(name, size_t(index));
+}
+
 /************************************************
  * A generic function to generate the instance name
  * in the following format:
@@ -27,8 +56,22 @@ namespace openfpga {
  ***********************************************/
 std::string generate_instance_name(const std::string& instance_name,
                                    const size_t& instance_id) {
-  return instance_name + std::string("_") + std::to_string(instance_id) +
-         std::string("_");
+  std::string name;
+  name.reserve(instance_name.length() + 24);
+  append_instance_name(name, instance_name, instance_id);
+  return name;
+}
+
+/************************************************
+ * Append the instance name <instance_name>_<id>_ to a name,
+ * so that callers can reuse the buffer of the name
+ ***********************************************/
+void append_instance_name(std::string& name, const std::string& instance_name,
+                          const size_t& instance_id) {
+  name += instance_name;
+  name.push_back('_');
+  append_name_index(name, instance_id);
+  name.push_back('_');
 }
 
 /************************************************
@@ -89,22 +132,33 @@ std::string generate_mux_subckt_name(const CircuitLibrary& circuit_lib,
                                      const CircuitModelId& circuit_model,
                                      const size_t& mux_size,
                                      const std::string& postfix) {
-  std::string module_name = circuit_lib.model_name(circuit_model);
+  std::string module_name;
+  append_mux_subckt_name(module_name, circuit_lib, circuit_model, mux_size,
+                         postfix);
+  return module_name;
+}
+
+/************************************************
+ * Append the module name of a multiplexer to a name, following the same
+ * rules as generate_mux_subckt_name()
+ ***********************************************/
+void append_mux_subckt_name(std::string& name,
+                            const CircuitLibrary& circuit_lib,
+                            const CircuitModelId& circuit_model,
+                            const size_t& mux_size,
+                            const std::string& postfix) {
+  name += circuit_lib.model_name(circuit_model);
   /* Check the model type and give different names */
   if (CIRCUIT_MODEL_MUX == circuit_lib.model_type(circuit_model)) {
-    module_name += "_size";
-    module_name += std::to_string(mux_size);
+    name += "_size";
+    append_name_index(name, mux_size);
   } else {
     VTR_ASSERT(CIRCUIT_MODEL_LUT == circuit_lib.model_type(circuit_model));
-    module_name += "_mux";
+    name += "_mux";
   }
 
   /* Add postfix if it is not empty */
-  if (!postfix.empty()) {
-    module_name += postfix;
-  }
-
-  return module_name;
+  name += postfix;
 }
 
 /************************************************
@@ -187,6 +241,18 @@ std::string generate_memory_decoder_with_data_in_subckt_name(
   return subckt_name;
 }
 
+/************************************************
+ * Generate the module name of a parameterized decoder
+ * which implements the decoders of any size
+ ***********************************************/
+std::string generate_memory_decoder_template_subckt_name(
+  const bool& use_data_in) {
+  if (true == use_data_in) {
+    return std::string("decoder_with_data_in_template");
+  }
+  return std::string("decoder_template");
+}
+
 /************************************************
  * Generate the module name of a routing track wire
  ***********************************************/
@@ -234,6 +300,18 @@ std::string generate_memory_module_name(const CircuitLibrary& circuit_lib,
                      circuit_lib.model_name(sram_model) + postfix);
 }
 
+/*********************************************************************
+ * Generate the module name for a memory tile, i.e., a fixed-size memory
+ * sub-circuit which composes larger memory sub-circuits
+ ********************************************************************/
+std::string generate_memory_tile_module_name(const CircuitLibrary& circuit_lib,
+                                             const CircuitModelId& sram_model,
+                                             const size_t& tile_size,
+                                             const std::string& postfix) {
+  return std::string(circuit_lib.model_name(sram_model) + "_tile" +
+                     std::to_string(tile_size) + postfix);
+}
+
 /*********************************************************************
  * Generate the netlist name for a unique routing block
  * It could be
@@ -379,14 +457,7 @@ std::string generate_sb_module_track_port_name(const t_rr_type& chan_type,
   /* Channel must be either CHANX or CHANY */
   VTR_ASSERT((CHANX == chan_type) || (CHANY == chan_type));
 
-  /* Create a map between chan_type and module_prefix */
-  std::map<t_rr_type, std::string> module_prefix_map;
-  /* TODO: use a constexpr string to replace the fixed name? */
-  module_prefix_map[CHANX] = std::string("chanx");
-  module_prefix_map[CHANY] = std::string("chany");
-
-  std::string port_name = module_prefix_map[chan_type];
-  port_name += std::string("_");
+  std::string port_name((CHANX == chan_type) ? "chanx_" : "chany_");
 
   SideManager side_manager(module_side);
   port_name += std::string(side_manager.to_string());
@@ -432,16 +503,12 @@ std::string generate_cb_module_track_port_name(const t_rr_type& chan_type,
   /* Channel must be either CHANX or CHANY */
   VTR_ASSERT((CHANX == chan_type) || (CHANY == chan_type));
 
-  /* Create a map between chan_type and module_prefix */
-  std::map<t_rr_type, std::map<bool, std::string>> module_prefix_map;
-  /* TODO: use a constexpr string to replace the fixed name? */
-  module_prefix_map[CHANX][true] = std::string("chanx_left");
-  module_prefix_map[CHANX][false] = std::string("chanx_right");
-  module_prefix_map[CHANY][true] = std::string("chany_bottom");
-  module_prefix_map[CHANY][false] = std::string("chany_top");
-
-  std::string port_name = module_prefix_map[chan_type][upper_location];
-  port_name += std::string("_");
+  std::string port_name;
+  if (CHANX == chan_type) {
+    port_name = upper_location ? "chanx_left_" : "chanx_right_";
+  } else {
+    port_name = upper_location ? "chany_bottom_" : "chany_top_";
+  }
 
   switch (port_direction) {
     case OUT_PORT:
@@ -468,21 +535,15 @@ std::string generate_routing_track_middle_output_port_name(
   /* Channel must be either CHANX or CHANY */
   VTR_ASSERT((CHANX == chan_type) || (CHANY == chan_type));
 
-  /* Create a map between chan_type and module_prefix */
-  std::map<t_rr_type, std::string> module_prefix_map;
-  /* TODO: use a constexpr string to replace the fixed name? */
-  module_prefix_map[CHANX] = std::string("chanx");
-  module_prefix_map[CHANY] = std::string("chany");
-
-  std::string port_name = module_prefix_map[chan_type];
-  port_name +=
-    std::string("_" + std::to_string(coordinate.x()) + std::string("__") +
-                std::to_string(coordinate.y()) + std::string("__"));
-
-  port_name += std::string("midout_");
+  std::string port_name((CHANX == chan_type) ? "chanx_" : "chany_");
+  append_name_index(port_name, coordinate.x());
+  port_name += "__";
+  append_name_index(port_name, coordinate.y());
+  port_name += "__midout_";
 
   /* Add the track id to the port name */
-  port_name += std::to_string(track_id) + std::string("_");
+  append_name_index(port_name, track_id);
+  port_name.push_back('_');
 
   return port_name;
 }
@@ -492,9 +553,21 @@ std::string generate_routing_track_middle_output_port_name(
  *********************************************************************/
 std::string generate_switch_block_module_name(
   const vtr::Point<size_t>& coordinate) {
-  return std::string("sb_" + std::to_string(coordinate.x()) +
-                     std::string("__") + std::to_string(coordinate.y()) +
-                     std::string("_"));
+  std::string module_name;
+  append_switch_block_module_name(module_name, coordinate);
+  return module_name;
+}
+
+/*********************************************************************
+ * Append the module name of a switch block, sb_<x>__<y>_, to a name
+ *********************************************************************/
+void append_switch_block_module_name(std::string& name,
+                                     const vtr::Point<size_t>& coordinate) {
+  name += "sb_";
+  append_name_index(name, coordinate.x());
+  name += "__";
+  append_name_index(name, coordinate.y());
+  name.push_back('_');
 }
 
 /*********************************************************************
@@ -502,22 +575,33 @@ std::string generate_switch_block_module_name(
  *********************************************************************/
 std::string generate_connection_block_module_name(
   const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate) {
-  std::string prefix("cb");
+  std::string module_name;
+  append_connection_block_module_name(module_name, cb_type, coordinate);
+  return module_name;
+}
+
+/*********************************************************************
+ * Append the module name of a connection block, cb<x|y>_<x>__<y>_,
+ * to a name
+ *********************************************************************/
+void append_connection_block_module_name(std::string& name,
+                                         const t_rr_type& cb_type,
+                                         const vtr::Point<size_t>& coordinate) {
   switch (cb_type) {
     case CHANX:
-      prefix += std::string("x_");
+      name += "cbx_";
       break;
     case CHANY:
-      prefix += std::string("y_");
+      name += "cby_";
       break;
     default:
       VTR_LOG_ERROR("Invalid type of connection block!\n");
       exit(1);
   }
-
-  return std::string(prefix + std::to_string(coordinate.x()) +
-                     std::string("__") + std::to_string(coordinate.y()) +
-                     std::string("_"));
+  append_name_index(name, coordinate.x());
+  name += "__";
+  append_name_index(name, coordinate.y());
+  name.push_back('_');
 }
 
 /*********************************************************************
@@ -529,23 +613,35 @@ std::string generate_grid_port_name(const size_t& width, const size_t& height,
                                     const int& subtile_index,
                                     const e_side& side,
                                     const BasicPort& pin_info) {
+  std::string port_name;
+  append_grid_port_name(port_name, width, height, subtile_index, side,
+                        pin_info);
+  return port_name;
+}
+
+/*********************************************************************
+ * Append the port name of a grid in top-level netlists to a name,
+ * following the same rules as generate_grid_port_name()
+ *********************************************************************/
+void append_grid_port_name(std::string& name, const size_t& width,
+                           const size_t& height, const int& subtile_index,
+                           const e_side& side, const BasicPort& pin_info) {
   /* Ensure that the pin is 1-bit ONLY !!! */
   VTR_ASSERT(1 == pin_info.get_width());
 
   SideManager side_manager(side);
-  std::string port_name = std::string(side_manager.to_string());
-  port_name += std::string("_width_");
-  port_name += std::to_string(width);
-  port_name += std::string("_height_");
-  port_name += std::to_string(height);
-  port_name += std::string("_subtile_");
-  port_name += std::to_string(subtile_index);
-  port_name += std::string("__pin_");
-  port_name += pin_info.get_name();
-  port_name += std::string("_");
-  port_name += std::to_string(pin_info.get_lsb());
-  port_name += std::string("_");
-  return port_name;
+  name += side_manager.to_string();
+  name += "_width_";
+  append_name_index(name, width);
+  name += "_height_";
+  append_name_index(name, height);
+  name += "_subtile_";
+  append_name_index(name, subtile_index);
+  name += "__pin_";
+  name += pin_info.get_name();
+  name.push_back('_');
+  append_name_index(name, pin_info.get_lsb());
+  name.push_back('_');
 }
 
 /*********************************************************************
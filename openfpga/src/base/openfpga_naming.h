@@ -26,9 +26,16 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* The append_*() functions build a name at the end of a string owned by
+ * the caller, which can be reused for many names without allocations */
+void append_name_index(std::string& name, const size_t& index);
+
 std::string generate_instance_name(const std::string& instance_name,
                                    const size_t& instance_id);
 
+void append_instance_name(std::string& name, const std::string& instance_name,
+                          const size_t& instance_id);
+
 std::string generate_instance_wildcard_name(const std::string& instance_name,
                                             const std::string& wildcard_str);
 
@@ -44,6 +51,11 @@ std::string generate_mux_subckt_name(const CircuitLibrary& circuit_lib,
                                      const size_t& mux_size,
                                      const std::string& posfix);
 
+void append_mux_subckt_name(std::string& name,
+                            const CircuitLibrary& circuit_lib,
+                            const CircuitModelId& circuit_model,
+                            const size_t& mux_size, const std::string& postfix);
+
 std::string generate_mux_branch_subckt_name(const CircuitLibrary& circuit_lib,
                                             const CircuitModelId& circuit_model,
                                             const size_t& branch_mux_size,
@@ -59,6 +71,9 @@ std::string generate_memory_decoder_subckt_name(const size_t& addr_size,
 std::string generate_memory_decoder_with_data_in_subckt_name(
   const size_t& addr_size, const size_t& data_size);
 
+std::string generate_memory_decoder_template_subckt_name(
+  const bool& use_data_in);
+
 std::string generate_segment_wire_subckt_name(
   const std::string& wire_model_name, const size_t& segment_id);
 
@@ -70,6 +85,11 @@ std::string generate_memory_module_name(const CircuitLibrary& circuit_lib,
                                         const CircuitModelId& sram_model,
                                         const std::string& postfix);
 
+std::string generate_memory_tile_module_name(const CircuitLibrary& circuit_lib,
+                                             const CircuitModelId& sram_model,
+                                             const size_t& tile_size,
+                                             const std::string& postfix);
+
 std::string generate_routing_block_netlist_name(const std::string& prefix,
                                                 const size_t& block_id,
                                                 const std::string& postfix);
@@ -107,9 +127,16 @@ std::string generate_routing_track_middle_output_port_name(
 std::string generate_switch_block_module_name(
   const vtr::Point<size_t>& coordinate);
 
+void append_switch_block_module_name(std::string& name,
+                                     const vtr::Point<size_t>& coordinate);
+
 std::string generate_connection_block_module_name(
   const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate);
 
+void append_connection_block_module_name(std::string& name,
+                                         const t_rr_type& cb_type,
+                                         const vtr::Point<size_t>& coordinate);
+
 std::string generate_sb_mux_instance_name(const std::string& prefix,
                                           const e_side& sb_side,
                                           const size_t& track_id,
@@ -143,6 +170,10 @@ std::string generate_grid_port_name(const size_t& width, const size_t& height,
                                     const e_side& side,
                                     const BasicPort& pin_info);
 
+void append_grid_port_name(std::string& name, const size_t& width,
+                           const size_t& height, const int& subtile_index,
+                           const e_side& side, const BasicPort& pin_info);
+
 std::string generate_grid_duplicated_port_name(
   const size_t& width, const size_t& height, const int& subtile_index,
   const e_side& side, const BasicPort& pin_info, const bool& upper_port);
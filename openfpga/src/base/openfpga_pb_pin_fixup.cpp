@@ -15,6 +15,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_device_grid_utils.h"
+#include "openfpga_parallel.h"
 #include "openfpga_pb_pin_fixup.h"
 #include "openfpga_physical_tile_utils.h"
 #include "openfpga_side_manager.h"
@@ -178,18 +179,43 @@ static void update_cluster_pin_with_post_routing_results(
   }
 }
 
+/********************************************************************
+ * A grid where a clustered block is placed, whose pins should be fixed up
+ *******************************************************************/
+struct t_pb_pin_fixup_grid {
+  vtr::Point<size_t> grid_coord;
+  e_side border_side;
+};
+
 /********************************************************************
  * Main function to fix up the pb pin mapping results
- * This function will walk through each grid
+ * This function will walk through each grid, and collect the grids of
+ * each clustered block.
+ * Each block only updates its own net remapping, so the blocks are fixed
+ * up in parallel. The grids of a block are visited in the same sequence
+ * regardless of the number of threads
  *******************************************************************/
 void update_pb_pin_with_post_routing_results(
   const DeviceContext& device_ctx, const ClusteringContext& clustering_ctx,
   const PlacementContext& placement_ctx,
   const VprRoutingAnnotation& vpr_routing_annotation,
-  VprClusteringAnnotation& vpr_clustering_annotation, const bool& verbose) {
+  VprClusteringAnnotation& vpr_clustering_annotation,
+  const size_t& num_threads, const bool& verbose) {
   /* Ensure a clean start: remove all the remapping results from VTR's
    * post-routing clustering result sync-up */
-  vpr_clustering_annotation.clear_net_remapping();
+  vpr_clustering_annotation.init_net_remapping(clustering_ctx.clb_nlist);
+
+  std::vector<ClusterBlockId> blocks;
+  vtr::vector<ClusterBlockId, std::vector<t_pb_pin_fixup_grid>> block_grids(
+    clustering_ctx.clb_nlist.blocks().size());
+  auto add_block_grid = [&](const ClusterBlockId& cluster_blk_id,
+                            const vtr::Point<size_t>& grid_coord,
+                            const e_side& border_side) {
+    if (true == block_grids[cluster_blk_id].empty()) {
+      blocks.push_back(cluster_blk_id);
+    }
+    block_grids[cluster_blk_id].push_back({grid_coord, border_side});
+  };
 
   /* Update the core logic (center blocks of the FPGA) */
   for (size_t x = 1; x < device_ctx.grid.width() - 1; ++x) {
@@ -207,11 +233,7 @@ void update_pb_pin_with_post_routing_results(
         }
         /* We know the entrance to grid info and mapping results, do the fix-up
          * for this block */
-        vtr::Point<size_t> grid_coord(x, y);
-        update_cluster_pin_with_post_routing_results(
-          device_ctx, clustering_ctx, vpr_routing_annotation,
-          vpr_clustering_annotation, grid_coord, cluster_blk_id, NUM_SIDES,
-          placement_ctx.block_locs[cluster_blk_id].loc.sub_tile, verbose);
+        add_block_grid(cluster_blk_id, vtr::Point<size_t>(x, y), NUM_SIDES);
       }
     }
   }
@@ -235,13 +257,21 @@ void update_pb_pin_with_post_routing_results(
           continue;
         }
         /* Update on I/O grid */
-        update_cluster_pin_with_post_routing_results(
-          device_ctx, clustering_ctx, vpr_routing_annotation,
-          vpr_clustering_annotation, io_coord, cluster_blk_id, io_side,
-          placement_ctx.block_locs[cluster_blk_id].loc.sub_tile, verbose);
+        add_block_grid(cluster_blk_id, io_coord, io_side);
       }
     }
   }
+
+  parallel_for_dynamic(blocks.size(), num_threads, [&](const size_t& iblk) {
+    const ClusterBlockId& cluster_blk_id = blocks[iblk];
+    for (const t_pb_pin_fixup_grid& grid : block_grids[cluster_blk_id]) {
+      update_cluster_pin_with_post_routing_results(
+        device_ctx, clustering_ctx, vpr_routing_annotation,
+        vpr_clustering_annotation, grid.grid_coord, cluster_blk_id,
+        grid.border_side,
+        placement_ctx.block_locs[cluster_blk_id].loc.sub_tile, verbose);
+    }
+  });
 }
 
 } /* end namespace openfpga */
@@ -8,7 +8,9 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_parallel.h"
 #include "openfpga_pb_pin_fixup.h"
+#include "openfpga_trace.h"
 #include "vtr_time.h"
 
 /********************************************************************
@@ -34,15 +36,24 @@ int pb_pin_fixup_template(T& openfpga_context, const Command& cmd,
                           const CommandContext& cmd_context) {
   vtr::ScopedStartFinishTimer timer(
     "Fix up pb pin mapping results after routing optimization");
+  OPENFPGA_TRACE_FUNCTION();
 
   CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
+
+  /* Use the number of threads of the shell by default */
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
 
   /* Apply fix-up to each grid */
   update_pb_pin_with_post_routing_results(
     g_vpr_ctx.device(), g_vpr_ctx.clustering(), g_vpr_ctx.placement(),
     openfpga_context.vpr_routing_annotation(),
     openfpga_context.mutable_vpr_clustering_annotation(),
-    cmd_context.option_enable(cmd, opt_verbose));
+    find_num_threads(num_threads), cmd_context.option_enable(cmd, opt_verbose));
 
   /* TODO: should identify the error code from internal function execution */
   return CMD_EXEC_SUCCESS;
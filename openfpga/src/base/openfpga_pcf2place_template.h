@@ -9,6 +9,7 @@
 #include "command_exit_codes.h"
 #include "io_net_place.h"
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 #include "pcf2place.h"
 #include "pcf_reader.h"
 #include "read_csv_io_pin_table.h"
@@ -35,8 +36,16 @@ int pcf2place_wrapper_template(const Command& cmd,
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
   CommandOptionId opt_pin_table_dir_convention =
     cmd.option("pin_table_direction_convention");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Use the number of threads of the shell by default */
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
+
   std::string pcf_fname = cmd_context.option_value(cmd, opt_pcf);
   std::string blif_fname = cmd_context.option_value(cmd, opt_blif);
   std::string fpga_io_map_fname =
@@ -76,7 +85,7 @@ int pcf2place_wrapper_template(const Command& cmd,
           pcf_fname.c_str());
 
   blifparse::BlifHeadReader callback;
-  blifparse::blif_parse_filename(blif_fname.c_str(), callback);
+  blifparse::blif_parse_head_filename(blif_fname.c_str(), callback);
   VTR_LOG("Read the blif from a file: %s.\n", blif_fname.c_str());
   if (callback.had_error()) {
     VTR_LOG_ERROR("Read the blif ends with errors\n");
@@ -97,7 +106,8 @@ int pcf2place_wrapper_template(const Command& cmd,
   IoNetPlace io_net_place;
   int status =
     pcf2place(pcf_data, callback.input_pins(), callback.output_pins(),
-              io_pin_table, io_location_map, io_net_place);
+              io_pin_table, io_location_map, io_net_place,
+              find_num_threads(num_threads));
   if (status) {
     return status;
   }
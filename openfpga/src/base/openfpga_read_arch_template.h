@@ -11,6 +11,8 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_arch_binary_image.h"
+#include "openfpga_parallel.h"
 #include "read_xml_openfpga_arch.h"
 #include "vtr_log.h"
 #include "write_xml_openfpga_arch.h"
@@ -37,10 +39,18 @@ int read_openfpga_arch_template(T& openfpga_context, const Command& cmd,
   VTR_ASSERT(false == cmd_context.option_value(cmd, opt_file).empty());
 
   std::string arch_file_name = cmd_context.option_value(cmd, opt_file);
-
-  VTR_LOG("Reading XML architecture '%s'...\n", arch_file_name.c_str());
-  openfpga_context.mutable_arch() =
-    read_xml_openfpga_arch(arch_file_name.c_str());
+  bool binary = cmd_context.option_enable(cmd, cmd.option("binary"));
+
+  /* A binary architecture has been checked before it was written */
+  if (true == binary) {
+    VTR_LOG("Reading binary architecture '%s'...\n", arch_file_name.c_str());
+    openfpga_context.mutable_arch() =
+      read_binary_openfpga_arch(arch_file_name.c_str());
+  } else {
+    VTR_LOG("Reading XML architecture '%s'...\n", arch_file_name.c_str());
+    openfpga_context.mutable_arch() =
+      read_xml_openfpga_arch(arch_file_name.c_str());
+  }
 
   /* Check the architecture:
    * 1. Circuit library
@@ -48,7 +58,9 @@ int read_openfpga_arch_template(T& openfpga_context, const Command& cmd,
    * 3. Technology library (TODO)
    * 4. Simulation settings (TODO)
    */
-  if (false == check_circuit_library(openfpga_context.arch().circuit_lib)) {
+  if ((false == binary) &&
+      (false == check_circuit_library(openfpga_context.arch().circuit_lib,
+                                      default_num_threads()))) {
     return CMD_EXEC_FATAL_ERROR;
   }
 
@@ -87,8 +99,15 @@ int write_openfpga_arch_template(const T& openfpga_context, const Command& cmd,
 
   std::string arch_file_name = cmd_context.option_value(cmd, opt_file);
 
-  VTR_LOG("Writing XML architecture to '%s'...\n", arch_file_name.c_str());
-  write_xml_openfpga_arch(arch_file_name.c_str(), openfpga_context.arch());
+  if (true == cmd_context.option_enable(cmd, cmd.option("binary"))) {
+    VTR_LOG("Writing binary architecture to '%s'...\n",
+            arch_file_name.c_str());
+    write_binary_openfpga_arch(arch_file_name.c_str(),
+                               openfpga_context.arch());
+  } else {
+    VTR_LOG("Writing XML architecture to '%s'...\n", arch_file_name.c_str());
+    write_xml_openfpga_arch(arch_file_name.c_str(), openfpga_context.arch());
+  }
 
   /* TODO: should identify the error code from internal function execution */
   return CMD_EXEC_SUCCESS;
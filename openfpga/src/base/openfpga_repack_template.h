@@ -9,6 +9,7 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_parallel.h"
 #include "read_xml_repack_design_constraints.h"
 #include "repack.h"
 #include "repack_design_constraints.h"
@@ -27,6 +28,8 @@ int repack_template(T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_design_constraints = cmd.option("design_constraints");
   CommandOptionId opt_ignore_global_nets =
     cmd.option("ignore_global_nets_on_pins");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
+  CommandOptionId opt_stats_file = cmd.option("stats_file");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
   /* Load design constraints from file */
@@ -46,6 +49,17 @@ int repack_template(T& openfpga_ctx, const Command& cmd,
     cmd_context.option_value(cmd, opt_ignore_global_nets));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
 
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
+  options.set_num_threads(find_num_threads(num_threads));
+
+  if (true == cmd_context.option_enable(cmd, opt_stats_file)) {
+    options.set_stats_file(cmd_context.option_value(cmd, opt_stats_file));
+  }
+
   if (!options.valid()) {
     VTR_LOG("Detected errors when parsing options!\n");
     return CMD_EXEC_FATAL_ERROR;
@@ -61,7 +75,8 @@ int repack_template(T& openfpga_ctx, const Command& cmd,
   build_physical_lut_truth_tables(
     openfpga_ctx.mutable_vpr_clustering_annotation(), g_vpr_ctx.atom(),
     g_vpr_ctx.clustering(), openfpga_ctx.vpr_device_annotation(),
-    openfpga_ctx.arch().circuit_lib, options.verbose_output());
+    openfpga_ctx.arch().circuit_lib, options.num_threads(),
+    options.verbose_output());
 
   /* TODO: should identify the error code from internal function execution */
   return CMD_EXEC_SUCCESS;
@@ -0,0 +1,99 @@
+#ifndef OPENFPGA_REPORT_MEMORY_USAGE_TEMPLATE_H
+#define OPENFPGA_REPORT_MEMORY_USAGE_TEMPLATE_H
+/********************************************************************
+ * This file includes functions to report the memory footprint of
+ * the data structures in the OpenFPGA context
+ *******************************************************************/
+#include <array>
+#include <string>
+
+#include "command.h"
+#include "command_context.h"
+#include "command_exit_codes.h"
+#include "module_manager.h"
+#include "vtr_log.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Print a line of the memory report
+ *******************************************************************/
+inline void print_memory_usage_line(const std::string& name,
+                                    const size_t& num_bytes) {
+  VTR_LOG("%-32s %16lu bytes (%.2f MB)\n", name.c_str(), num_bytes,
+          (double)num_bytes / (1024. * 1024.));
+}
+
+/********************************************************************
+ * Report the estimated memory used by the major data structures in
+ * the OpenFPGA context, as well as the memory used by the module graph
+ * for each type of module usage.
+ * The numbers are estimated from the capacity of the containers, so
+ * they are useful to size machines and track regressions, but are not
+ * as precise as a memory profiler
+ *******************************************************************/
+template <class T>
+int report_memory_usage_template(const T& openfpga_ctx, const Command& cmd,
+                                 const CommandContext& cmd_context) {
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  bool verbose = cmd_context.option_enable(cmd, opt_verbose);
+
+  const ModuleManager& module_manager = openfpga_ctx.module_graph();
+
+  VTR_LOG("Memory usage of OpenFPGA data structures:\n");
+  size_t module_graph_bytes = module_manager.memory_usage();
+  size_t device_rr_gsb_bytes = openfpga_ctx.device_rr_gsb().memory_usage();
+  size_t bitstream_manager_bytes =
+    openfpga_ctx.bitstream_manager().memory_usage();
+  size_t fabric_bitstream_bytes =
+    openfpga_ctx.fabric_bitstream().memory_usage();
+  print_memory_usage_line("ModuleManager", module_graph_bytes);
+  print_memory_usage_line("DeviceRRGSB", device_rr_gsb_bytes);
+  print_memory_usage_line("BitstreamManager", bitstream_manager_bytes);
+  print_memory_usage_line("FabricBitstream", fabric_bitstream_bytes);
+  print_memory_usage_line("Total", module_graph_bytes + device_rr_gsb_bytes +
+                                     bitstream_manager_bytes +
+                                     fabric_bitstream_bytes);
+  VTR_LOG("\n");
+
+  /* Break down the module graph by the usage of modules */
+  std::array<const char*, ModuleManager::NUM_MODULE_USAGE_TYPES>
+    MODULE_USAGE_TYPE_STRING = {{"MODULE_TOP", "MODULE_CONFIG",
+                                 "MODULE_INTERC", "MODULE_GRID", "MODULE_LUT",
+                                 "MODULE_HARD_IP", "MODULE_SB", "MODULE_CB",
+                                 "MODULE_IO", "MODULE_VDD", "MODULE_VSS"}};
+  std::array<size_t, ModuleManager::NUM_MODULE_USAGE_TYPES> usage_bytes;
+  std::array<size_t, ModuleManager::NUM_MODULE_USAGE_TYPES> usage_counts;
+  usage_bytes.fill(0);
+  usage_counts.fill(0);
+
+  VTR_LOGV(verbose, "Memory usage of each module:\n");
+  for (const ModuleId& module : module_manager.modules()) {
+    size_t num_bytes = module_manager.module_memory_usage(module);
+    usage_bytes[module_manager.module_usage(module)] += num_bytes;
+    usage_counts[module_manager.module_usage(module)]++;
+    if (verbose) {
+      print_memory_usage_line(module_manager.module_name(module), num_bytes);
+    }
+  }
+  VTR_LOGV(verbose, "\n");
+
+  VTR_LOG("Memory usage of ModuleManager by module usage:\n");
+  for (size_t usage = 0; usage < ModuleManager::NUM_MODULE_USAGE_TYPES;
+       ++usage) {
+    if (0 == usage_counts[usage]) {
+      continue;
+    }
+    print_memory_usage_line(std::string(MODULE_USAGE_TYPE_STRING[usage]) +
+                              " (" + std::to_string(usage_counts[usage]) +
+                              " modules)",
+                            usage_bytes[usage]);
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
+
+#endif
@@ -6,6 +6,8 @@
  * - write_pnr_sdc : generate SDC to constrain the back-end flow for FPGA fabric
  * - write_analysis_sdc: TODO: generate SDC based on users' implementations
  *******************************************************************/
+#include "openfpga_command_cache_template.h"
+#include "openfpga_link_arch_stage_template.h"
 #include "openfpga_sdc_template.h"
 #include "shell.h"
 
@@ -94,6 +96,18 @@ ShellCommandId add_write_pnr_sdc_command_template(
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to write the SDC files of grids, SBs and CBs. Use "
+    "0 to use all the available threads. By default, the number of threads of "
+    "the shell is used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
+  /* Add an option '--compress' */
+  shell_cmd.add_option("compress", false,
+                       "Compress the output files in gzip format");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -102,8 +116,14 @@ ShellCommandId add_write_pnr_sdc_command_template(
     shell_cmd,
     "generate SDC files to constrain the backend flow for FPGA fabric", hidden);
   shell.set_command_class(shell_cmd_id, cmd_class_id);
-  shell.set_command_const_execute_function(shell_cmd_id,
-                                           write_pnr_sdc_template<T>);
+  shell.set_command_const_execute_function(
+    shell_cmd_id, cache_const_command_template<T>(write_pnr_sdc_template<T>));
+
+  /* Run the deferred annotation which the command requires */
+  shell.set_command_prerequisite(shell_cmd_id, [](T& openfpga_ctx) {
+    return require_link_arch_stages_template<T>(openfpga_ctx,
+                                                {LINK_ARCH_SIMULATION_SETTING});
+  });
 
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
@@ -145,6 +165,12 @@ ShellCommandId add_write_configuration_chain_sdc_command_template(
     "max_delay", false, "Specify the maximum delay to be used.");
   shell_cmd.set_option_require_value(max_dly_opt, openfpga::OPT_STRING);
 
+  /* Add an option '--unique_module_pairs' */
+  shell_cmd.add_option(
+    "unique_module_pairs", false,
+    "Write a single regular-expression constraint for each unique pair of "
+    "modules adjacent in the chain, rather than one per pair of instances");
+
   /* Add an option '--no_time_stamp' */
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
@@ -156,7 +182,8 @@ ShellCommandId add_write_configuration_chain_sdc_command_template(
     hidden);
   shell.set_command_class(shell_cmd_id, cmd_class_id);
   shell.set_command_const_execute_function(
-    shell_cmd_id, write_configuration_chain_sdc_template<T>);
+    shell_cmd_id,
+    cache_const_command_template<T>(write_configuration_chain_sdc_template<T>));
 
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
@@ -185,6 +212,12 @@ ShellCommandId add_write_sdc_disable_timing_configure_ports_command_template(
   shell_cmd.add_option("flatten_names", false,
                        "Use flatten names (no wildcards) in SDC files");
 
+  /* Add an option '--module_scoped' */
+  shell_cmd.add_option(
+    "module_scoped", false,
+    "Write the constraints once per module definition using current_design, "
+    "rather than once per instance in the fabric");
+
   /* Add an option '--no_time_stamp' */
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
@@ -200,7 +233,8 @@ ShellCommandId add_write_sdc_disable_timing_configure_ports_command_template(
                       hidden);
   shell.set_command_class(shell_cmd_id, cmd_class_id);
   shell.set_command_const_execute_function(
-    shell_cmd_id, write_sdc_disable_timing_configure_ports_template<T>);
+    shell_cmd_id, cache_const_command_template<T>(
+                    write_sdc_disable_timing_configure_ports_template<T>));
 
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
@@ -225,6 +259,10 @@ ShellCommandId add_write_analysis_sdc_command_template(
   shell_cmd.set_option_short_name(output_opt, "f");
   shell_cmd.set_option_require_value(output_opt, openfpga::OPT_STRING);
 
+  /* Add an option '--compress' */
+  shell_cmd.add_option("compress", false,
+                       "Compress the output files in gzip format");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -242,6 +280,20 @@ ShellCommandId add_write_analysis_sdc_command_template(
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to write the constraints of grids, SBs and CBs. "
+    "Use 0 to use all the available threads. By default, the number of threads "
+    "of the shell is used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
+  /* Add an option '--used_routing_pins' */
+  shell_cmd.add_option(
+    "used_routing_pins", false,
+    "Collect the routing pins used by the benchmark and disable the others in "
+    "a single command, rather than disabling each unused routing resource");
+
   /* Add command 'write_fabric_verilog' to the Shell */
   ShellCommandId shell_cmd_id =
     shell.add_command(shell_cmd,
@@ -249,8 +301,15 @@ ShellCommandId add_write_analysis_sdc_command_template(
                       "fabric mapped by a benchmark",
                       hidden);
   shell.set_command_class(shell_cmd_id, cmd_class_id);
-  shell.set_command_const_execute_function(shell_cmd_id,
-                                           write_analysis_sdc_template<T>);
+  shell.set_command_const_execute_function(
+    shell_cmd_id,
+    cache_const_command_template<T>(write_analysis_sdc_template<T>));
+
+  /* Run the deferred annotation which the command requires */
+  shell.set_command_prerequisite(shell_cmd_id, [](T& openfpga_ctx) {
+    return require_link_arch_stages_template<T>(
+      openfpga_ctx, {LINK_ARCH_ROUTING_RESULTS, LINK_ARCH_SIMULATION_SETTING});
+  });
 
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
@@ -11,7 +11,9 @@
 #include "configuration_chain_sdc_writer.h"
 #include "configure_port_sdc_writer.h"
 #include "globals.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 #include "openfpga_scale.h"
 #include "pnr_sdc_writer.h"
 #include "vtr_log.h"
@@ -47,6 +49,18 @@ int write_pnr_sdc_template(const T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_constrain_zero_delay_paths =
     cmd.option("constrain_zero_delay_paths");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
+  CommandOptionId opt_compress = cmd.option("compress");
+
+  /* Output files are compressed until the command returns */
+  if ((true == cmd_context.option_enable(cmd, opt_compress)) &&
+      (false == output_compression_supported())) {
+    VTR_LOG_ERROR(
+      "Option '--compress' requires OpenFPGA to be built with zlib!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  ScopedOutputCompression compression_scope(
+    cmd_context.option_enable(cmd, opt_compress));
 
   /* This is an intermediate data structure which is designed to modularize the
    * FPGA-SDC Keep it independent from any other outside data structures
@@ -88,6 +102,14 @@ int write_pnr_sdc_template(const T& openfpga_ctx, const Command& cmd,
     cmd_context.option_enable(cmd, opt_constrain_zero_delay_paths));
   options.set_time_stamp(!cmd_context.option_enable(cmd, opt_no_time_stamp));
 
+  /* Use the number of threads of the shell by default */
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
+  options.set_num_threads(find_num_threads(num_threads));
+
   /* We first turn on default sdc option and then disable part of them by
    * following users' options */
   if (false == options.generate_sdc_pnr()) {
@@ -132,6 +154,7 @@ int write_configuration_chain_sdc_template(const T& openfpga_ctx,
   CommandOptionId opt_time_unit = cmd.option("time_unit");
   CommandOptionId opt_min_delay = cmd.option("min_delay");
   CommandOptionId opt_max_delay = cmd.option("max_delay");
+  CommandOptionId opt_unique_module_pairs = cmd.option("unique_module_pairs");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
 
   std::string sdc_dir_path =
@@ -146,7 +169,8 @@ int write_configuration_chain_sdc_template(const T& openfpga_ctx,
     std::stof(cmd_context.option_value(cmd, opt_max_delay)),
     std::stof(cmd_context.option_value(cmd, opt_min_delay)),
     !cmd_context.option_enable(cmd, opt_no_time_stamp),
-    openfpga_ctx.module_graph());
+    cmd_context.option_enable(cmd, opt_unique_module_pairs),
+    openfpga_ctx.module_graph(), openfpga_ctx.config_child_hierarchy());
 
   return CMD_EXEC_SUCCESS;
 }
@@ -162,6 +186,7 @@ int write_sdc_disable_timing_configure_ports_template(
   /* Get command options */
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_flatten_names = cmd.option("flatten_names");
+  CommandOptionId opt_module_scoped = cmd.option("module_scoped");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
@@ -173,6 +198,7 @@ int write_sdc_disable_timing_configure_ports_template(
       print_sdc_disable_timing_configure_ports(
         cmd_context.option_value(cmd, opt_output_dir),
         cmd_context.option_enable(cmd, opt_flatten_names),
+        cmd_context.option_enable(cmd, opt_module_scoped),
         openfpga_ctx.mux_lib(), openfpga_ctx.arch().circuit_lib,
         openfpga_ctx.module_graph(),
         !cmd_context.option_enable(cmd, opt_no_time_stamp),
@@ -193,6 +219,19 @@ int write_analysis_sdc_template(const T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_flatten_names = cmd.option("flatten_names");
   CommandOptionId opt_time_unit = cmd.option("time_unit");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
+  CommandOptionId opt_used_routing_pins = cmd.option("used_routing_pins");
+  CommandOptionId opt_compress = cmd.option("compress");
+
+  /* Output files are compressed until the command returns */
+  if ((true == cmd_context.option_enable(cmd, opt_compress)) &&
+      (false == output_compression_supported())) {
+    VTR_LOG_ERROR(
+      "Option '--compress' requires OpenFPGA to be built with zlib!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  ScopedOutputCompression compression_scope(
+    cmd_context.option_enable(cmd, opt_compress));
 
   /* This is an intermediate data structure which is designed to modularize the
    * FPGA-SDC Keep it independent from any other outside data structures
@@ -206,6 +245,8 @@ int write_analysis_sdc_template(const T& openfpga_ctx, const Command& cmd,
   AnalysisSdcOption options(sdc_dir_path);
   options.set_generate_sdc_analysis(true);
   options.set_flatten_names(cmd_context.option_enable(cmd, opt_flatten_names));
+  options.set_used_routing_pins(
+    cmd_context.option_enable(cmd, opt_used_routing_pins));
   options.set_time_stamp(!cmd_context.option_enable(cmd, opt_no_time_stamp));
 
   if (true == cmd_context.option_enable(cmd, opt_time_unit)) {
@@ -213,6 +254,14 @@ int write_analysis_sdc_template(const T& openfpga_ctx, const Command& cmd,
       string_to_time_unit(cmd_context.option_value(cmd, opt_time_unit)));
   }
 
+  /* Use the number of threads of the shell by default */
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
+  options.set_num_threads(find_num_threads(num_threads));
+
   if (true == options.generate_sdc_analysis()) {
     print_analysis_sdc(
       options,
@@ -6,12 +6,14 @@
  * - read_openfpga_arch : read OpenFPGA architecture file
  *******************************************************************/
 #include "check_netlist_naming_conflict_template.h"
+#include "openfpga_command_cache_template.h"
 #include "openfpga_build_fabric_template.h"
 #include "openfpga_link_arch_template.h"
 #include "openfpga_lut_truth_table_fixup_template.h"
 #include "openfpga_pb_pin_fixup_template.h"
 #include "openfpga_pcf2place_template.h"
 #include "openfpga_read_arch_template.h"
+#include "openfpga_report_memory_usage_template.h"
 #include "openfpga_write_gsb_template.h"
 #include "shell.h"
 
@@ -35,6 +37,12 @@ ShellCommandId add_read_openfpga_arch_command_template(
   shell_cmd.set_option_short_name(opt_arch_file, "f");
   shell_cmd.set_option_require_value(opt_arch_file, openfpga::OPT_STRING);
 
+  /* Add an option '--binary' */
+  shell_cmd.add_option(
+    "binary", false,
+    "read the architecture from a binary image written by "
+    "write_openfpga_arch --binary");
+
   /* Add command 'read_openfpga_arch' to the Shell */
   ShellCommandId shell_cmd_id =
     shell.add_command(shell_cmd, "read OpenFPGA architecture file", hidden);
@@ -61,6 +69,11 @@ ShellCommandId add_write_openfpga_arch_command_template(
   shell_cmd.set_option_short_name(opt_file, "f");
   shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
 
+  /* Add an option '--binary' */
+  shell_cmd.add_option(
+    "binary", false,
+    "write the parsed and checked architecture to a binary image");
+
   /* Add command 'write_openfpga_arch' to the Shell */
   ShellCommandId shell_cmd_id =
     shell.add_command(shell_cmd, "write OpenFPGA architecture file", hidden);
@@ -124,6 +137,12 @@ ShellCommandId add_write_simulation_setting_command_template(
   shell.set_command_const_execute_function(
     shell_cmd_id, write_simulation_setting_template<T>);
 
+  /* Run the deferred annotation which the command requires */
+  shell.set_command_prerequisite(shell_cmd_id, [](T& openfpga_ctx) {
+    return require_link_arch_stages_template<T>(openfpga_ctx,
+                                                {LINK_ARCH_SIMULATION_SETTING});
+  });
+
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
 
@@ -207,6 +226,22 @@ ShellCommandId add_link_arch_command_template(
                        "Sort all the incoming edges for each routing track "
                        "output node in General Switch Blocks (GSBs)");
 
+  /* Add an option '--num_threads'*/
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to check pb_type annotation, annotate routing "
+    "results, build General Switch Blocks (GSBs), sort their incoming edges, "
+    "build the multiplexer library and the tile-to-tile direct connections. "
+    "Use 0 to use all the available threads. By default, the number of threads "
+    "of the shell is used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
+  /* Add an option '--lazy'*/
+  shell_cmd.add_option(
+    "lazy", false,
+    "Defer the annotation of routing results, simulation settings and "
+    "bitstream settings until a command requires them");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -262,6 +297,14 @@ ShellCommandId add_write_gsb_command_template(
                          "specify multiple GSBs by using a splitter ``,``");
   shell_cmd.set_option_require_value(opt_gsb_names, openfpga::OPT_STRING);
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to write the XML files. Use 0 to use all the "
+    "available threads. By default, the number of threads of the shell is "
+    "used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -270,7 +313,8 @@ ShellCommandId add_write_gsb_command_template(
     shell_cmd, "write internal structures of General Switch Blocks to XML file",
     hidden);
   shell.set_command_class(shell_cmd_id, cmd_class_id);
-  shell.set_command_const_execute_function(shell_cmd_id, write_gsb_template<T>);
+  shell.set_command_const_execute_function(
+    shell_cmd_id, cache_const_command_template<T>(write_gsb_template<T>));
 
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
@@ -297,6 +341,14 @@ ShellCommandId add_check_netlist_naming_conflict_command_template(
     "report", false, "Output a report file about what any correction applied");
   shell_cmd.set_option_require_value(opt_rpt, openfpga::OPT_STRING);
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to check the names of blocks and nets. Use 0 to "
+    "use all the available threads. By default, the number of threads of the "
+    "shell is used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add command 'check_netlist_naming_conflict' to the Shell */
   ShellCommandId shell_cmd_id =
     shell.add_command(shell_cmd,
@@ -324,6 +376,14 @@ ShellCommandId add_pb_pin_fixup_command_template(
   const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
   Command shell_cmd("pb_pin_fixup");
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to fix up the clustered blocks. Use 0 to use all "
+    "the available threads. By default, the number of threads of the shell is "
+    "used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -335,6 +395,12 @@ ShellCommandId add_pb_pin_fixup_command_template(
   shell.set_command_class(shell_cmd_id, cmd_class_id);
   shell.set_command_execute_function(shell_cmd_id, pb_pin_fixup_template<T>);
 
+  /* Run the deferred annotation which the command requires */
+  shell.set_command_prerequisite(shell_cmd_id, [](T& openfpga_ctx) {
+    return require_link_arch_stages_template<T>(openfpga_ctx,
+                                                {LINK_ARCH_ROUTING_RESULTS});
+  });
+
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
 
@@ -386,11 +452,33 @@ ShellCommandId add_build_fabric_command_template(
     "frame_view", false,
     "Build only frame view of the fabric (nets are skipped)");
 
+  /* Add an option '--bitstream_only' */
+  shell_cmd.add_option(
+    "bitstream_only", false,
+    "Build the fabric for bitstream generation only. The nets between grids "
+    "and routing blocks are skipped, so fabric netlists cannot be written");
+
+  /* Add an option '--defer_gsb_nets' */
+  shell_cmd.add_option(
+    "defer_gsb_nets", false,
+    "Do not build the nets between grids and routing blocks in the module "
+    "graph. The nets are generated on the fly when writing the fabric "
+    "Verilog netlists");
+
   /* Add an option '--compress_routing' */
   shell_cmd.add_option("compress_routing", false,
                        "Compress the number of unique routing modules by "
                        "identifying the unique GSBs");
 
+  /* Add an option '--unique_module_cache' */
+  CommandOptionId opt_unique_module_cache = shell_cmd.add_option(
+    "unique_module_cache", false,
+    "Reuse the unique GSBs from the given cache file when it matches the "
+    "current device. Otherwise, the cache file is (re)generated. Only "
+    "applicable when '--compress_routing' is enabled");
+  shell_cmd.set_option_require_value(opt_unique_module_cache,
+                                     openfpga::OPT_STRING);
+
   /* Add an option '--duplicate_grid_pin' */
   shell_cmd.add_option("duplicate_grid_pin", false,
                        "Duplicate the pins on the same side of a grid");
@@ -410,6 +498,71 @@ ShellCommandId add_build_fabric_command_template(
                        "Create a random fabric key which will shuffle the "
                        "memory address for encryption purpose");
 
+  /* Add an option '--generate_locality_fabric_key' */
+  shell_cmd.add_option(
+    "generate_locality_fabric_key", false,
+    "Create a fabric key which orders the configurable children of each "
+    "region along a Hilbert curve over their coordinates, in order to "
+    "reduce the wirelength of configuration networks");
+
+  /* Add an option '--balance_config_regions' */
+  shell_cmd.add_option(
+    "balance_config_regions", false,
+    "Split the configurable children of the top module into the "
+    "configuration regions so that the regions have similar numbers of "
+    "configuration bits, rather than similar numbers of children. Not "
+    "applicable when a fabric key is loaded");
+
+  /* Add an option '--memory_tile_size' */
+  CommandOptionId opt_memory_tile_size = shell_cmd.add_option(
+    "memory_tile_size", false,
+    "Build the memory modules of configuration chains which are longer than "
+    "the given number of memories from shared memory tiles of this size. Use "
+    "0 to build each memory module flat. Default: 0");
+  shell_cmd.set_option_require_value(opt_memory_tile_size, openfpga::OPT_INT);
+
+  /* Add an option '--max_shift_register_bank_size' */
+  CommandOptionId opt_max_sr_bank_size = shell_cmd.add_option(
+    "max_shift_register_bank_size", false,
+    "Add shift register banks for the BLs/WLs of each configuration region "
+    "until no bank is longer than the given size, and balance the lengths of "
+    "the banks. Use 0 to follow the number of banks of the configuration "
+    "protocol. Default: 0");
+  shell_cmd.set_option_require_value(opt_max_sr_bank_size, openfpga::OPT_INT);
+
+  /* Add an option '--out_of_core' */
+  CommandOptionId opt_out_of_core = shell_cmd.add_option(
+    "out_of_core", false,
+    "Back the largest arrays of nets, e.g., those of the top module, by "
+    "temporary files under the given directory, so that fabrics whose nets "
+    "do not fit in the memory can be built");
+  shell_cmd.set_option_require_value(opt_out_of_core, openfpga::OPT_STRING);
+
+  /* Add an option '--out_of_core_min_block_size' */
+  CommandOptionId opt_out_of_core_min_block_size = shell_cmd.add_option(
+    "out_of_core_min_block_size", false,
+    "Size of the smallest arrays, in bytes, which are backed by files when "
+    "option '--out_of_core' is enabled. By default, 16777216 (16 MB)");
+  shell_cmd.set_option_require_value(opt_out_of_core_min_block_size,
+                                     openfpga::OPT_INT);
+
+  /* Add an option '--fabric_cache' */
+  CommandOptionId opt_fabric_cache = shell_cmd.add_option(
+    "fabric_cache", false,
+    "Reuse the fabric saved in the given image when neither the device, the "
+    "architecture nor the options are edited since the image was written. "
+    "Otherwise, report the edits and the modules they invalidate, build the "
+    "whole fabric and (re)write the image");
+  shell_cmd.set_option_require_value(opt_fabric_cache, openfpga::OPT_STRING);
+
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to build the fabric. Use 0 to use all the "
+    "available threads. By default, the number of threads of the shell is "
+    "used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -448,6 +601,12 @@ ShellCommandId add_write_fabric_hierarchy_command_template(
     "Specify the depth of hierarchy to which the writer should stop");
   shell_cmd.set_option_require_value(opt_depth, openfpga::OPT_INT);
 
+  /* Add an option '--dag' */
+  shell_cmd.add_option(
+    "dag", false,
+    "Write the children of each unique module once, where repeated subtrees "
+    "are referred by the name of their modules");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -456,8 +615,9 @@ ShellCommandId add_write_fabric_hierarchy_command_template(
     shell_cmd, "Write the hierarchy of FPGA fabric graph to a plain-text file",
     hidden);
   shell.set_command_class(shell_cmd_id, cmd_class_id);
-  shell.set_command_const_execute_function(shell_cmd_id,
-                                           write_fabric_hierarchy_template<T>);
+  shell.set_command_const_execute_function(
+    shell_cmd_id,
+    cache_const_command_template<T>(write_fabric_hierarchy_template<T>));
 
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
@@ -505,6 +665,109 @@ ShellCommandId add_write_fabric_io_info_command_template(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: save_context
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_save_context_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("save_context");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file = shell_cmd.add_option(
+    "file", true, "file path to output the binary image of the fabric");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Save the fabric built by build_fabric to a binary image, which can be "
+    "restored by load_context in another run",
+    hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id,
+                                           save_context_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: load_context
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_load_context_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("load_context");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file = shell_cmd.add_option(
+    "file", true, "file path to the binary image of the fabric");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--unique_module_cache' */
+  CommandOptionId opt_unique_module_cache = shell_cmd.add_option(
+    "unique_module_cache", false,
+    "Reuse the unique GSBs from the given cache file when it matches the "
+    "current device. Otherwise, the cache file is (re)generated. Only "
+    "applicable when the fabric is built with '--compress_routing'");
+  shell_cmd.set_option_require_value(opt_unique_module_cache,
+                                     openfpga::OPT_STRING);
+
+  /* Add an option '--out_of_core' */
+  CommandOptionId opt_out_of_core = shell_cmd.add_option(
+    "out_of_core", false,
+    "Back the largest arrays of nets by temporary files under the given "
+    "directory. See the same option of build_fabric");
+  shell_cmd.set_option_require_value(opt_out_of_core, openfpga::OPT_STRING);
+
+  /* Add an option '--out_of_core_min_block_size' */
+  CommandOptionId opt_out_of_core_min_block_size = shell_cmd.add_option(
+    "out_of_core_min_block_size", false,
+    "Size of the smallest arrays, in bytes, which are backed by files. See "
+    "the same option of build_fabric");
+  shell_cmd.set_option_require_value(opt_out_of_core_min_block_size,
+                                     openfpga::OPT_INT);
+
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to identify the unique GSBs. Use 0 to use all the "
+    "available threads. By default, the number of threads of the shell is "
+    "used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Restore the fabric from a binary image saved by save_context, instead "
+    "of running build_fabric",
+    hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, load_context_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 /********************************************************************
  * - Add a command to Shell environment: pcf2place
  * - Add associated options
@@ -552,6 +815,14 @@ ShellCommandId add_pcf2place_command_template(
   shell_cmd.set_option_require_value(opt_pin_table_dir_convention,
                                      openfpga::OPT_STRING);
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to resolve the pin constraints. Use 0 to use all "
+    "the available threads. By default, the number of threads of the shell is "
+    "used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--no_time_stamp' */
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
@@ -570,6 +841,33 @@ ShellCommandId add_pcf2place_command_template(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: report_memory_usage
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_report_memory_usage_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const bool& hidden) {
+  Command shell_cmd("report_memory_usage");
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false,
+                       "Show the memory usage of each module");
+
+  /* Add command 'report_memory_usage' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Report the estimated memory usage of the data structures in OpenFPGA",
+    hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id,
+                                           report_memory_usage_template<T>);
+
+  return shell_cmd_id;
+}
+
 template <class T>
 void add_setup_command_templates(openfpga::Shell<T>& shell,
                                  const bool& hidden = false) {
@@ -720,6 +1018,34 @@ void add_setup_command_templates(openfpga::Shell<T>& shell,
   add_write_fabric_io_info_command_template<T>(
     shell, openfpga_setup_cmd_class, cmd_dependency_write_fabric_io_info,
     hidden);
+
+  /********************************
+   * Command 'save_context'
+   */
+  /* The 'save_context' command should NOT be executed before
+   * 'build_fabric' */
+  std::vector<ShellCommandId> save_context_dependent_cmds;
+  save_context_dependent_cmds.push_back(build_fabric_cmd_id);
+  add_save_context_command_template<T>(shell, openfpga_setup_cmd_class,
+                                       save_context_dependent_cmds, hidden);
+
+  /********************************
+   * Command 'load_context'
+   */
+  /* The 'load_context' command should NOT be executed before
+   * 'link_openfpga_arch' */
+  std::vector<ShellCommandId> load_context_dependent_cmds;
+  load_context_dependent_cmds.push_back(link_arch_cmd_id);
+  add_load_context_command_template<T>(shell, openfpga_setup_cmd_class,
+                                       load_context_dependent_cmds, hidden);
+
+  /********************************
+   * Command 'report_memory_usage'
+   */
+  /* The 'report_memory_usage' command can be executed at any time. Data
+   * structures which are not built yet are reported as empty */
+  add_report_memory_usage_command_template<T>(shell, openfpga_setup_cmd_class,
+                                              hidden);
 }
 
 } /* end namespace openfpga */
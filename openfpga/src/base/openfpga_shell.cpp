@@ -1,16 +1,37 @@
 #include "openfpga_shell.h"
 
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
 #include "basic_command.h"
 #include "command_echo.h"
 #include "command_parser.h"
+#include "openfpga_command_cache_template.h"
 #include "openfpga_bitstream_command.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_context.h"
+#include "openfpga_parallel.h"
+#include "openfpga_progress.h"
 #include "openfpga_sdc_command.h"
 #include "openfpga_setup_command.h"
 #include "openfpga_spice_command.h"
 #include "openfpga_title.h"
+#include "openfpga_tokenizer.h"
+#include "openfpga_trace.h"
 #include "openfpga_verilog_command.h"
 #include "vpr_command.h"
+#include "vtr_log.h"
 
 OpenfpgaShell::OpenfpgaShell() {
   shell_.set_name("OpenFPGA");
@@ -41,6 +62,35 @@ OpenfpgaShell::OpenfpgaShell() {
   openfpga::add_basic_commands(shell_);
 }
 
+/********************************************************************
+ * Report the memory used by the major data structures of the context,
+ * so that the profiles attribute the memory of each command to them,
+ * e.g., build_fabric to ModuleManager
+ *******************************************************************/
+static std::vector<std::pair<std::string, size_t>> find_context_memory_usage(
+  const OpenfpgaContext& openfpga_ctx) {
+  return {
+    {"ModuleManager", openfpga_ctx.module_graph().memory_usage()},
+    {"DeviceRRGSB", openfpga_ctx.device_rr_gsb().memory_usage()},
+    {"BitstreamManager", openfpga_ctx.bitstream_manager().memory_usage()},
+    {"FabricBitstream", openfpga_ctx.fabric_bitstream().memory_usage()}};
+}
+
+/********************************************************************
+ * Mix each command which may modify the context, and the data of the
+ * context after the command, into the digest of the context, which
+ * identifies the context in the command cache
+ *******************************************************************/
+static void digest_context_command(OpenfpgaContext& openfpga_ctx,
+                                   const std::vector<std::string>& tokens) {
+  uint64_t state_digest =
+    openfpga::compute_context_state_digest_template<OpenfpgaContext>(
+      openfpga_ctx);
+  openfpga::FlowManager& flow_manager = openfpga_ctx.mutable_flow_manager();
+  flow_manager.set_context_digest(openfpga::digest_context_command(
+    flow_manager.context_digest(), tokens, state_digest));
+}
+
 int OpenfpgaShell::run_command(const char* cmd_line) {
   return shell_.execute_command(cmd_line, openfpga_ctx_);
 }
@@ -50,6 +100,65 @@ void OpenfpgaShell::reset() {
   /* TODO: reset the data storage */
 }
 
+size_t OpenfpgaShell::num_config_bits() const {
+  return openfpga_ctx_.bitstream_manager().num_bits();
+}
+
+bool OpenfpgaShell::config_bit_value(const size_t& config_bit) const {
+  return openfpga_ctx_.bitstream_manager().bit_value(
+    openfpga::ConfigBitId(config_bit));
+}
+
+std::string OpenfpgaShell::config_bit_values() const {
+  const openfpga::BitstreamManager& bitstream_manager =
+    openfpga_ctx_.bitstream_manager();
+  const std::vector<uint64_t>& words = bitstream_manager.bit_value_words();
+  std::string values(bitstream_manager.num_bits(), '0');
+  for (size_t ibit = 0; ibit < values.size(); ++ibit) {
+    if (1 == ((words[ibit / 64] >> (ibit % 64)) & 1)) {
+      values[ibit] = '1';
+    }
+  }
+  return values;
+}
+
+size_t OpenfpgaShell::num_fabric_bits() const {
+  return openfpga_ctx_.fabric_bitstream().num_bits();
+}
+
+size_t OpenfpgaShell::fabric_bit_config_bit(const size_t& fabric_bit) const {
+  return size_t(openfpga_ctx_.fabric_bitstream().config_bit(
+    openfpga::FabricBitId(fabric_bit)));
+}
+
+std::string OpenfpgaShell::fabric_bit_address(const size_t& fabric_bit) const {
+  const openfpga::FabricBitstream& fabric_bitstream =
+    openfpga_ctx_.fabric_bitstream();
+  if (false == fabric_bitstream.use_address()) {
+    return std::string();
+  }
+  std::vector<char> address =
+    fabric_bitstream.bit_address(openfpga::FabricBitId(fabric_bit));
+  return std::string(address.begin(), address.end());
+}
+
+std::string OpenfpgaShell::fabric_bit_wl_address(
+  const size_t& fabric_bit) const {
+  const openfpga::FabricBitstream& fabric_bitstream =
+    openfpga_ctx_.fabric_bitstream();
+  if (false == fabric_bitstream.use_wl_address()) {
+    return std::string();
+  }
+  std::vector<char> address =
+    fabric_bitstream.bit_wl_address(openfpga::FabricBitId(fabric_bit));
+  return std::string(address.begin(), address.end());
+}
+
+bool OpenfpgaShell::fabric_bit_din(const size_t& fabric_bit) const {
+  return 0 != openfpga_ctx_.fabric_bitstream().bit_din(
+                 openfpga::FabricBitId(fabric_bit));
+}
+
 int OpenfpgaShell::start(int argc, char** argv) {
   reset();
 
@@ -75,6 +184,104 @@ int OpenfpgaShell::start(int argc, char** argv) {
                          "Launch OpenFPGA in batch  mode when running scripts");
   start_cmd.set_option_short_name(opt_batch_exec, "batch");
 
+  /* '--script_jobs': run read-only commands of scripts concurrently */
+  openfpga::CommandOptionId opt_script_jobs = start_cmd.add_option(
+    "script_jobs", false,
+    "Maximum number of consecutive commands in scripts which only read the "
+    "data and run at the same time. Use 0 to use all the available threads. "
+    "By default, commands run one by one");
+  start_cmd.set_option_require_value(opt_script_jobs, openfpga::OPT_INT);
+
+  /* '--num_threads': the default number of threads of commands */
+  openfpga::CommandOptionId opt_num_threads = start_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used by the commands which do not specify their "
+    "'--num_threads'. Use 0 to use all the available threads. By default, "
+    "the environment variable OPENFPGA_NUM_THREADS is used, or a single "
+    "thread when it is not defined");
+  start_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
+  /* '--async_write': write output files on background threads */
+  openfpga::CommandOptionId opt_async_write = start_cmd.add_option(
+    "async_write", false,
+    "Write the output files of commands, e.g., netlists, SDC files and "
+    "bitstreams, on background threads, so that formatting overlaps with "
+    "the latency of the disk");
+
+  /* '--progress_interval': report the progress of long loops */
+  openfpga::CommandOptionId opt_progress_interval = start_cmd.add_option(
+    "progress_interval", false,
+    "Report the progress of long loops inside commands, e.g., the clustered "
+    "blocks repacked, at most once per given number of seconds");
+  start_cmd.set_option_require_value(opt_progress_interval,
+                                     openfpga::OPT_FLOAT);
+
+  /* '--profile': write the profiles of executed commands when quitting */
+  openfpga::CommandOptionId opt_profile = start_cmd.add_option(
+    "profile", false,
+    "Write the runtime and memory profiles of executed commands to a JSON "
+    "file when quitting OpenFPGA");
+  start_cmd.set_option_require_value(opt_profile, openfpga::OPT_STRING);
+
+  /* '--profile_memory': attribute the memory of commands to data structures
+   */
+  openfpga::CommandOptionId opt_profile_memory = start_cmd.add_option(
+    "profile_memory", false,
+    "Record the changes of memory used by the major data structures, e.g., "
+    "ModuleManager, in the profile of each command. This walks through the "
+    "data structures before and after each command");
+
+  /* '--trace': trace the builders and writers when running commands */
+  openfpga::CommandOptionId opt_trace = start_cmd.add_option(
+    "trace", false,
+    "Trace the time spent inside commands and write the traces to a Chrome "
+    "trace JSON file when quitting OpenFPGA");
+  start_cmd.set_option_require_value(opt_trace, openfpga::OPT_STRING);
+
+  /* '--command_cache': reuse the outputs of commands from previous runs */
+  openfpga::CommandOptionId opt_command_cache = start_cmd.add_option(
+    "command_cache", false,
+    "Cache the outputs of the commands which only write files, e.g., "
+    "write_pnr_sdc, in the given directory. A command executed with the "
+    "same options after the same commands copies its outputs from the "
+    "cache");
+  start_cmd.set_option_require_value(opt_command_cache,
+                                     openfpga::OPT_STRING);
+
+  /* '--design_list': implement each design in the list on the fabric built
+   * by the script given by '--file'
+   */
+  openfpga::CommandOptionId opt_design_list = start_cmd.add_option(
+    "design_list", false,
+    "Implement each design in the given list by the script given by "
+    "'--design_script', on the fabric built by the script given by '--file'");
+  start_cmd.set_option_require_value(opt_design_list, openfpga::OPT_STRING);
+
+  /* '--design_queue': implement each design appended to a queue on the
+   * fabric built by the script given by '--file', until the queue ends
+   */
+  openfpga::CommandOptionId opt_design_queue = start_cmd.add_option(
+    "design_queue", false,
+    "Wait for the designs appended to the given file or named pipe, and "
+    "implement each of them by the script given by '--design_script', on "
+    "the fabric built by the script given by '--file'");
+  start_cmd.set_option_require_value(opt_design_queue, openfpga::OPT_STRING);
+
+  /* '--design_script': the script to implement each design of the list */
+  openfpga::CommandOptionId opt_design_script = start_cmd.add_option(
+    "design_script", false,
+    "Script to implement each design in the list given by '--design_list'");
+  start_cmd.set_option_require_value(opt_design_script, openfpga::OPT_STRING);
+
+  /* '--server': execute the commands received from a socket */
+  openfpga::CommandOptionId opt_server = start_cmd.add_option(
+    "server", false,
+    "Run OpenFPGA as a server, which keeps its data in memory and executes "
+    "the command lines received from the clients of the given Unix socket. "
+    "The script given by '--file', if any, is executed before accepting "
+    "clients");
+  start_cmd.set_option_require_value(opt_server, openfpga::OPT_STRING);
+
   /* '--version', -v': print version information */
   openfpga::CommandOptionId opt_version =
     start_cmd.add_option("version", false, "Show OpenFPGA version");
@@ -104,9 +311,109 @@ int OpenfpgaShell::start(int argc, char** argv) {
       print_openfpga_version_info();
       return 0;
     }
+    /* Profiles are written by the 'exit' command, or when the shell returns
+     */
+    std::string profile_file;
+    if (true == start_cmd_context.option_enable(start_cmd, opt_profile)) {
+      profile_file = start_cmd_context.option_value(start_cmd, opt_profile);
+      shell_.set_profile_file(profile_file);
+    }
+    if (true ==
+        start_cmd_context.option_enable(start_cmd, opt_profile_memory)) {
+      shell_.set_memory_usage_reporter(find_context_memory_usage);
+    }
+    if (true == start_cmd_context.option_enable(start_cmd, opt_script_jobs)) {
+      shell_.set_num_script_jobs(openfpga::find_num_threads(std::atoi(
+        start_cmd_context.option_value(start_cmd, opt_script_jobs).c_str())));
+    }
+    if (true == start_cmd_context.option_enable(start_cmd, opt_num_threads)) {
+      openfpga::set_default_num_threads(std::atoi(
+        start_cmd_context.option_value(start_cmd, opt_num_threads).c_str()));
+    }
+    if (true == start_cmd_context.option_enable(start_cmd, opt_async_write)) {
+      openfpga::set_async_output(true);
+    }
+    if (true ==
+        start_cmd_context.option_enable(start_cmd, opt_progress_interval)) {
+      openfpga::set_progress_interval(std::atof(
+        start_cmd_context.option_value(start_cmd, opt_progress_interval)
+          .c_str()));
+    }
+    /* Traces are written in the same way as profiles */
+    if (true == start_cmd_context.option_enable(start_cmd, opt_trace)) {
+      openfpga::start_trace(
+        start_cmd_context.option_value(start_cmd, opt_trace));
+    }
+    if (true == start_cmd_context.option_enable(start_cmd, opt_command_cache)) {
+      openfpga_ctx_.mutable_flow_manager().set_command_cache_dir(
+        start_cmd_context.option_value(start_cmd, opt_command_cache));
+      shell_.set_command_observer(digest_context_command);
+    }
+    /* Build the fabric once and implement a list of designs on it */
+    if (true == start_cmd_context.option_enable(start_cmd, opt_design_list)) {
+      if ((false ==
+           start_cmd_context.option_enable(start_cmd, opt_script_mode)) ||
+          (false ==
+           start_cmd_context.option_enable(start_cmd, opt_design_script))) {
+        VTR_LOG_ERROR(
+          "Option '--design_list' requires options '--file' and "
+          "'--design_script'!\n");
+        return 1;
+      }
+      int batch_status = run_design_batch(
+        start_cmd_context.option_value(start_cmd, opt_script_mode),
+        start_cmd_context.option_value(start_cmd, opt_design_script),
+        start_cmd_context.option_value(start_cmd, opt_design_list));
+      if (!profile_file.empty()) {
+        shell_.write_command_profiles(profile_file);
+      }
+      openfpga::finish_trace();
+      return batch_status;
+    }
+    /* Build the fabric once and implement designs as they are queued */
+    if (true == start_cmd_context.option_enable(start_cmd, opt_design_queue)) {
+      if ((false ==
+           start_cmd_context.option_enable(start_cmd, opt_script_mode)) ||
+          (false ==
+           start_cmd_context.option_enable(start_cmd, opt_design_script))) {
+        VTR_LOG_ERROR(
+          "Option '--design_queue' requires options '--file' and "
+          "'--design_script'!\n");
+        return 1;
+      }
+      int queue_status = run_design_queue(
+        start_cmd_context.option_value(start_cmd, opt_script_mode),
+        start_cmd_context.option_value(start_cmd, opt_design_script),
+        start_cmd_context.option_value(start_cmd, opt_design_queue));
+      if (!profile_file.empty()) {
+        shell_.write_command_profiles(profile_file);
+      }
+      openfpga::finish_trace();
+      return queue_status;
+    }
+    /* Keep the data in memory and execute the commands of clients */
+    if (true == start_cmd_context.option_enable(start_cmd, opt_server)) {
+      std::string init_script;
+      if (true == start_cmd_context.option_enable(start_cmd, opt_script_mode)) {
+        init_script =
+          start_cmd_context.option_value(start_cmd, opt_script_mode);
+      }
+      int server_status = run_server(
+        init_script, start_cmd_context.option_value(start_cmd, opt_server),
+        profile_file);
+      if (!profile_file.empty()) {
+        shell_.write_command_profiles(profile_file);
+      }
+      openfpga::finish_trace();
+      return server_status;
+    }
     /* Start a shell */
     if (true == start_cmd_context.option_enable(start_cmd, opt_interactive)) {
       shell_.run_interactive_mode(openfpga_ctx_);
+      if (!profile_file.empty()) {
+        shell_.write_command_profiles(profile_file);
+      }
+      openfpga::finish_trace();
       return shell_.exit_code();
     }
 
@@ -115,6 +422,10 @@ int OpenfpgaShell::start(int argc, char** argv) {
         start_cmd_context.option_value(start_cmd, opt_script_mode).c_str(),
         openfpga_ctx_,
         start_cmd_context.option_enable(start_cmd, opt_batch_exec));
+      if (!profile_file.empty()) {
+        shell_.write_command_profiles(profile_file);
+      }
+      openfpga::finish_trace();
       return shell_.exit_code();
     }
     /* Reach here there is something wrong, show the help desk */
@@ -126,3 +437,465 @@ int OpenfpgaShell::start(int argc, char** argv) {
    */
   return 1;
 }
+
+/********************************************************************
+ * Parse the variables of a design from a line of a design list or queue,
+ * which are pairs of names and values separated by spaces.
+ * Return false if the line is invalid. An empty set of variables is
+ * returned for blank lines and comments
+ *******************************************************************/
+static bool parse_design_variables(
+  const std::string& line, const std::string& source,
+  std::map<std::string, std::string>& variables) {
+  variables.clear();
+  openfpga::StringToken tokenizer(line);
+  std::vector<std::string> tokens = tokenizer.split(std::string(" \t\r"));
+  if (tokens.empty() || '#' == tokens[0].front()) {
+    return true;
+  }
+  for (const std::string& token : tokens) {
+    size_t delim_pos = token.find('=');
+    if (std::string::npos == delim_pos || 0 == delim_pos) {
+      VTR_LOG_ERROR("Invalid variable '%s' in the design list: %s!\n",
+                    token.c_str(), source.c_str());
+      variables.clear();
+      return false;
+    }
+    variables[token.substr(0, delim_pos)] = token.substr(delim_pos + 1);
+  }
+  return true;
+}
+
+/********************************************************************
+ * Each line of a design list defines the variables of a design, which are
+ * pairs of names and values separated by spaces, e.g.,
+ *   BENCHMARK=and2 BLIF_FILE=and2.blif
+ * The variables are referred as ${BENCHMARK} and ${BLIF_FILE} in the scripts.
+ * Lines starting with '#' are comments.
+ *
+ * The fabric script is executed once with the variables of the first design,
+ * e.g., to run VPR, link the architecture and build the fabric. Afterwards,
+ * the design script is executed for each design. The data depending on the
+ * design is reset before each design, while the architecture and the fabric
+ * are kept. The design script should run VPR and link the architecture again
+ * before building any bitstream. All the designs should target the same
+ * device, e.g., by using a fixed layout.
+ *******************************************************************/
+int OpenfpgaShell::run_design_batch(const std::string& fabric_script,
+                                    const std::string& design_script,
+                                    const std::string& design_list) {
+  std::ifstream fp(design_list);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open the design list: %s!\n", design_list.c_str());
+    return 1;
+  }
+  std::vector<std::map<std::string, std::string>> designs;
+  std::string line;
+  while (getline(fp, line)) {
+    std::map<std::string, std::string> variables;
+    if (false == parse_design_variables(line, design_list, variables)) {
+      return 1;
+    }
+    if (variables.empty()) {
+      continue;
+    }
+    designs.push_back(variables);
+  }
+  fp.close();
+
+  if (designs.empty()) {
+    VTR_LOG_ERROR("No design is found in the design list: %s!\n",
+                  design_list.c_str());
+    return 1;
+  }
+
+  VTR_LOG("Building the fabric by script file %s...\n", fabric_script.c_str());
+  if (CMD_EXEC_FATAL_ERROR ==
+      shell_.execute_script(fabric_script.c_str(), openfpga_ctx_,
+                            designs.front())) {
+    VTR_LOG_ERROR("Fail to build the fabric!\n");
+    return 1;
+  }
+
+  int num_failed_designs = 0;
+  for (size_t idesign = 0; idesign < designs.size(); ++idesign) {
+    VTR_LOG("\nImplementing design %lu/%lu by script file %s...\n",
+            idesign + 1, designs.size(), design_script.c_str());
+    openfpga_ctx_.reset_design_context();
+    if (CMD_EXEC_FATAL_ERROR ==
+        shell_.execute_script(design_script.c_str(), openfpga_ctx_,
+                              designs[idesign])) {
+      VTR_LOG_ERROR("Fail to implement design %lu/%lu!\n", idesign + 1,
+                    designs.size());
+      num_failed_designs++;
+    }
+  }
+
+  VTR_LOG("\nImplemented %lu designs on the fabric, where %d failed\n",
+          designs.size(), num_failed_designs);
+
+  return (0 == num_failed_designs) ? 0 : 1;
+}
+
+/********************************************************************
+ * Read the next line of a design queue, waiting for the line to be
+ * written. A queue is either a regular file, which is appended by other
+ * processes and polled for new lines, or a named pipe, which is reopened
+ * when all its writers close it. Only complete lines of a regular file
+ * are returned, as a writer may not have finished the last line.
+ *******************************************************************/
+static void read_design_queue_line(std::ifstream& fp, const std::string& fname,
+                                   const bool& is_pipe, std::string& line) {
+  std::string pending;
+  while (true) {
+    if (getline(fp, line)) {
+      if (false == fp.eof()) {
+        line = pending + line;
+        return;
+      }
+      /* The line is not terminated yet, wait for the rest */
+      pending += line;
+    }
+    fp.clear();
+    if (true == is_pipe) {
+      /* The writers are gone. The last line of a pipe is complete */
+      if (false == pending.empty()) {
+        line = pending;
+        fp.close();
+        fp.open(fname);
+        return;
+      }
+      fp.close();
+      /* Block until a new writer opens the pipe */
+      fp.open(fname);
+      continue;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  }
+}
+
+/********************************************************************
+ * Implement the designs of a queue, which are received while OpenFPGA
+ * runs, e.g., from the scheduler of a bitstream farm. The fabric is
+ * built only once, so that the cost of building the fabric is shared by
+ * all the designs implemented by the process.
+ *
+ * Each line of the queue defines the variables of a design, in the same
+ * format as a design list. The fabric script is executed with the
+ * variables of the first design. A line 'exit' ends the queue. Each
+ * design is reported as a line 'Design <index> <succeeded|failed>: <line>'
+ * in the log, so that the scheduler can collect the results.
+ *******************************************************************/
+int OpenfpgaShell::run_design_queue(const std::string& fabric_script,
+                                    const std::string& design_script,
+                                    const std::string& design_queue) {
+  struct stat queue_stat;
+  if (0 != stat(design_queue.c_str(), &queue_stat)) {
+    VTR_LOG_ERROR("Fail to find the design queue: %s!\n",
+                  design_queue.c_str());
+    return 1;
+  }
+  bool is_pipe = S_ISFIFO(queue_stat.st_mode);
+
+  /* Opening a named pipe blocks until a writer opens it */
+  std::ifstream fp(design_queue);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open the design queue: %s!\n",
+                  design_queue.c_str());
+    return 1;
+  }
+
+  VTR_LOG("Waiting for designs from queue %s...\n", design_queue.c_str());
+
+  bool fabric_built = false;
+  size_t num_designs = 0;
+  int num_failed_designs = 0;
+  std::string line;
+  while (true) {
+    read_design_queue_line(fp, design_queue, is_pipe, line);
+    if (std::string("exit") == line) {
+      break;
+    }
+    std::map<std::string, std::string> variables;
+    if (false == parse_design_variables(line, design_queue, variables)) {
+      num_designs++;
+      num_failed_designs++;
+      VTR_LOG("Design %lu failed: %s\n", num_designs, line.c_str());
+      continue;
+    }
+    if (variables.empty()) {
+      continue;
+    }
+
+    if (false == fabric_built) {
+      VTR_LOG("Building the fabric by script file %s...\n",
+              fabric_script.c_str());
+      if (CMD_EXEC_FATAL_ERROR ==
+          shell_.execute_script(fabric_script.c_str(), openfpga_ctx_,
+                                variables)) {
+        VTR_LOG_ERROR("Fail to build the fabric!\n");
+        return 1;
+      }
+      fabric_built = true;
+    }
+
+    num_designs++;
+    VTR_LOG("\nImplementing design %lu by script file %s...\n", num_designs,
+            design_script.c_str());
+    openfpga_ctx_.reset_design_context();
+    bool failed = (CMD_EXEC_FATAL_ERROR ==
+                   shell_.execute_script(design_script.c_str(), openfpga_ctx_,
+                                         variables));
+    if (true == failed) {
+      num_failed_designs++;
+    }
+    VTR_LOG("Design %lu %s: %s\n", num_designs,
+            failed ? "failed" : "succeeded", line.c_str());
+  }
+
+  VTR_LOG("\nImplemented %lu designs on the fabric, where %d failed\n",
+          num_designs, num_failed_designs);
+
+  return (0 == num_failed_designs) ? 0 : 1;
+}
+
+/********************************************************************
+ * Send all the bytes of a response to a client. A client which has
+ * disconnected does not raise SIGPIPE.
+ * Return false if the client cannot receive the response
+ *******************************************************************/
+static bool send_server_response(const int& client_fd,
+                                 const std::string& response) {
+  size_t num_sent = 0;
+  while (num_sent < response.size()) {
+    ssize_t num_bytes = send(client_fd, response.data() + num_sent,
+                             response.size() - num_sent, MSG_NOSIGNAL);
+    if (0 > num_bytes) {
+      return false;
+    }
+    num_sent += num_bytes;
+  }
+  return true;
+}
+
+/********************************************************************
+ * The output of a command, i.e., everything it writes to stdout and
+ * stderr, is redirected to a temporary file while the command runs, in
+ * the same way as the commands which run in child processes, and is
+ * read back once the command finishes.
+ * The profile of the command is the one recorded by the shell. A command
+ * line which the shell rejects before profiling it, e.g., an unknown
+ * command, is profiled here, so that the profiles cover all the command
+ * lines of the clients
+ *******************************************************************/
+int OpenfpgaShell::execute_server_command(const std::string& cmd_line,
+                                          std::string& output,
+                                          openfpga::CommandProfile& profile) {
+  output.clear();
+  std::FILE* log = std::tmpfile();
+  if (nullptr == log) {
+    output = "Fail to capture the output of the command!\n";
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::cout.flush();
+  std::fflush(stdout);
+  std::fflush(stderr);
+  int stdout_fd = dup(STDOUT_FILENO);
+  int stderr_fd = dup(STDERR_FILENO);
+  dup2(fileno(log), STDOUT_FILENO);
+  dup2(fileno(log), STDERR_FILENO);
+
+  size_t num_profiles = shell_.command_profiles().size();
+  openfpga::CommandProfileTimer timer;
+  int status = shell_.execute_command(cmd_line.c_str(), openfpga_ctx_);
+  if (num_profiles < shell_.command_profiles().size()) {
+    /* A command is recorded after the commands it calls, if any */
+    profile = shell_.command_profiles().back();
+  } else {
+    timer.finish(profile);
+    profile.command_line = cmd_line;
+    profile.status = status;
+    shell_.record_command_profile(profile);
+  }
+
+  std::cout.flush();
+  std::fflush(stdout);
+  std::fflush(stderr);
+  dup2(stdout_fd, STDOUT_FILENO);
+  dup2(stderr_fd, STDERR_FILENO);
+  close(stdout_fd);
+  close(stderr_fd);
+
+  std::rewind(log);
+  char buffer[4096];
+  size_t num_chars = 0;
+  while (0 < (num_chars = std::fread(buffer, 1, sizeof(buffer), log))) {
+    output.append(buffer, num_chars);
+  }
+  std::fclose(log);
+
+  return status;
+}
+
+/********************************************************************
+ * Serve the clients of a Unix socket, one after another, so that a
+ * sequence of tool calls, e.g., from a Python flow, reuses the data
+ * built by previous commands, e.g., the fabric, instead of launching
+ * OpenFPGA and rebuilding the data for each call.
+ *
+ * A client sends command lines, each terminated by a new line. Command
+ * lines can be pipelined, i.e., a client can send a batch of command
+ * lines without waiting for the responses, which are sent in the sequence
+ * of the command lines. Each response is a header line
+ *   <exit code> <wall time> <CPU time> <number of bytes>
+ * followed by the output of the command, in the given number of bytes.
+ * Times are in seconds. Blank lines and lines starting with '#' are
+ * skipped without a response. A line 'exit' is answered by an empty
+ * response, and stops the server once its client disconnects.
+ *******************************************************************/
+int OpenfpgaShell::run_server(const std::string& init_script,
+                              const std::string& socket_path,
+                              const std::string& profile_file) {
+  struct sockaddr_un address;
+  if (socket_path.size() >= sizeof(address.sun_path)) {
+    VTR_LOG_ERROR("The path of the server socket is too long: %s!\n",
+                  socket_path.c_str());
+    return 1;
+  }
+
+  if (false == init_script.empty()) {
+    VTR_LOG("Executing script file %s before serving...\n",
+            init_script.c_str());
+    if (CMD_EXEC_FATAL_ERROR ==
+        shell_.execute_script(init_script.c_str(), openfpga_ctx_,
+                              std::map<std::string, std::string>())) {
+      VTR_LOG_ERROR("Fail to execute the script before serving!\n");
+      return 1;
+    }
+  }
+
+  int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (0 > server_fd) {
+    VTR_LOG_ERROR("Fail to create the server socket: %s!\n",
+                  std::strerror(errno));
+    return 1;
+  }
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, socket_path.c_str(),
+               sizeof(address.sun_path) - 1);
+  /* Remove the socket left by a previous server, but never a file of
+   * another kind which happens to be given */
+  struct stat path_stat;
+  if (0 == lstat(socket_path.c_str(), &path_stat)) {
+    if (!S_ISSOCK(path_stat.st_mode)) {
+      VTR_LOG_ERROR("The path of the server socket exists and is not a "
+                    "socket: %s!\n",
+                    socket_path.c_str());
+      close(server_fd);
+      return 1;
+    }
+    unlink(socket_path.c_str());
+  }
+  /* Only the owner can connect to the socket, as its clients execute
+   * arbitrary commands, e.g., 'exit' or writing files */
+  mode_t prev_umask = umask(077);
+  int bind_status =
+    bind(server_fd, (struct sockaddr*)&address, sizeof(address));
+  umask(prev_umask);
+  if ((0 > bind_status) || (0 > listen(server_fd, 8))) {
+    VTR_LOG_ERROR("Fail to listen on the server socket %s: %s!\n",
+                  socket_path.c_str(), std::strerror(errno));
+    close(server_fd);
+    return 1;
+  }
+
+  VTR_LOG("Waiting for commands from socket %s...\n", socket_path.c_str());
+
+  size_t num_commands = 0;
+  int num_failed_commands = 0;
+  bool stop = false;
+  while (false == stop) {
+    int client_fd = accept(server_fd, nullptr, nullptr);
+    if (0 > client_fd) {
+      if (EINTR == errno) {
+        continue;
+      }
+      VTR_LOG_ERROR("Fail to accept a client of the server socket: %s!\n",
+                    std::strerror(errno));
+      break;
+    }
+
+    /* Read the command lines of the client as they arrive. A batch may end
+     * in the middle of a line, which is kept until the rest arrives */
+    std::string pending;
+    char buffer[4096];
+    bool connected = true;
+    while (true == connected) {
+      ssize_t num_bytes = recv(client_fd, buffer, sizeof(buffer), 0);
+      if (0 > num_bytes && EINTR == errno) {
+        continue;
+      }
+      if (0 >= num_bytes) {
+        break;
+      }
+      pending.append(buffer, num_bytes);
+
+      size_t line_start = 0;
+      size_t line_end = 0;
+      while (std::string::npos !=
+             (line_end = pending.find('\n', line_start))) {
+        std::string cmd_line =
+          pending.substr(line_start, line_end - line_start);
+        line_start = line_end + 1;
+        openfpga::StringToken tokenizer(cmd_line);
+        std::vector<std::string> tokens =
+          tokenizer.split(std::string(" \t\r"));
+        if (tokens.empty() || '#' == tokens[0].front()) {
+          continue;
+        }
+        /* The command 'exit' would quit the process without closing the
+         * socket */
+        if (std::string("exit") == tokens[0]) {
+          stop = true;
+          connected = send_server_response(client_fd, "0 0 0 0\n");
+          continue;
+        }
+
+        std::string output;
+        openfpga::CommandProfile profile;
+        int status = execute_server_command(cmd_line, output, profile);
+        num_commands++;
+        if (CMD_EXEC_FATAL_ERROR == status) {
+          num_failed_commands++;
+        }
+        /* Echo the command to the log of the server */
+        VTR_LOG("Command %lu (status %d, %g seconds): %s\n", num_commands,
+                status, profile.wall_time, cmd_line.c_str());
+
+        char header[128];
+        std::snprintf(header, sizeof(header), "%d %.6f %.6f %lu\n", status,
+                      profile.wall_time, profile.cpu_time, output.size());
+        if (false == send_server_response(client_fd, header + output)) {
+          connected = false;
+          break;
+        }
+      }
+      pending.erase(0, line_start);
+    }
+    close(client_fd);
+    /* Keep the profiles up to date while the server is alive */
+    if (false == profile_file.empty()) {
+      shell_.write_command_profiles(profile_file);
+    }
+  }
+
+  close(server_fd);
+  unlink(socket_path.c_str());
+
+  VTR_LOG("\nExecuted %lu commands from socket %s, where %d failed\n",
+          num_commands, socket_path.c_str(), num_failed_commands);
+
+  return (0 == num_failed_commands) ? 0 : 1;
+}
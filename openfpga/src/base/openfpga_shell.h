@@ -1,7 +1,9 @@
 #ifndef OPENFPGA_SHELL_H
 #define OPENFPGA_SHELL_H
 
+#include <map>
 #include <string>
+#include <vector>
 
 #include "openfpga_context.h"
 #include "shell.h"
@@ -39,6 +41,52 @@ class OpenfpgaShell {
   /* Reset the data storage and shell status, to ensure a clean start */
   void reset();
 
+ public: /* Accessors to the bitstreams in the data storage */
+  /* These APIs let high-level interfaces, e.g., Tcl, analyze the bitstreams
+   * built by commands, without writing them to files and parsing the files.
+   * Bits are indexed from 0, in the same sequence as they are written to
+   * files. Values are read from the storage directly, without any copy of
+   * the bitstreams. */
+  size_t num_config_bits() const;
+  bool config_bit_value(const size_t& config_bit) const;
+  /* The values of all the configuration bits, as a string of '0' and '1',
+   * which is the only copy made, so that a bitstream is fetched at once */
+  std::string config_bit_values() const;
+  size_t num_fabric_bits() const;
+  /* The configuration bit which is programmed by a fabric bit */
+  size_t fabric_bit_config_bit(const size_t& fabric_bit) const;
+  /* The address (BL address for memory banks), the WL address and the data
+   * input of a fabric bit. Addresses are empty when they are not used by the
+   * configuration protocol */
+  std::string fabric_bit_address(const size_t& fabric_bit) const;
+  std::string fabric_bit_wl_address(const size_t& fabric_bit) const;
+  bool fabric_bit_din(const size_t& fabric_bit) const;
+
+ private: /* Internal executors */
+  /* Build the fabric by a script, and then implement each design in a list
+   * by another script on the same fabric. Return 0 only when the fabric
+   * is built and all the designs are implemented successfully */
+  int run_design_batch(const std::string& fabric_script,
+                       const std::string& design_script,
+                       const std::string& design_list);
+  /* Same as run_design_batch(), but the designs are read from a queue, i.e.,
+   * a file or a named pipe written by other processes, until a line 'exit'.
+   * The fabric is built when the first design is received */
+  int run_design_queue(const std::string& fabric_script,
+                       const std::string& design_script,
+                       const std::string& design_queue);
+  /* Keep the data storage resident and execute the command lines received
+   * from the clients of a Unix socket, after an optional script, until a
+   * line 'exit'. The profiles, if required, are written after each client.
+   * Return 0 only when the server stops without errors */
+  int run_server(const std::string& init_script,
+                 const std::string& socket_path,
+                 const std::string& profile_file);
+  /* Execute a command line of a server client, where the output of the
+   * command is captured rather than printed. Return the exit code */
+  int execute_server_command(const std::string& cmd_line, std::string& output,
+                             openfpga::CommandProfile& profile);
+
  private: /* Internal data */
   openfpga::Shell<OpenfpgaContext> shell_;
   OpenfpgaContext openfpga_ctx_;
@@ -51,6 +51,29 @@ ShellCommandId add_write_fabric_spice_command_template(
   shell_cmd.add_option("explicit_port_mapping", false,
                        "Use explicit port mapping in Verilog netlists");
 
+  /* Add an option '--merge_transistor_bins' */
+  shell_cmd.add_option(
+    "merge_transistor_bins", false,
+    "Model the transistors of inverters and buffers which are sized to the "
+    "max width by a single transistor with a multiplier");
+
+  /* Add an option '--top_partition_size' */
+  CommandOptionId opt_top_partition_size = shell_cmd.add_option(
+    "top_partition_size", false,
+    "Partition the top-level netlist into regions of <int>x<int> tiles, "
+    "which are written to separated netlists and tied by the top-level "
+    "netlist. By default, the top-level netlist is not partitioned");
+  shell_cmd.set_option_require_value(opt_top_partition_size,
+                                     openfpga::OPT_INT);
+
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to write the netlists. Use 0 to use all the "
+    "available threads. By default, the number of threads of the shell is "
+    "used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -5,6 +5,7 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_parallel.h"
 #include "spice_api.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -21,8 +22,28 @@ int write_fabric_spice_template(T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_explicit_port_mapping =
     cmd.option("explicit_port_mapping");
+  CommandOptionId opt_merge_transistor_bins =
+    cmd.option("merge_transistor_bins");
+  CommandOptionId opt_top_partition_size = cmd.option("top_partition_size");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* The fabric netlists require the nets between grids and routing blocks,
+   * which are skipped by option '--bitstream_only' of build_fabric */
+  if (true == openfpga_ctx.flow_manager().bitstream_only()) {
+    VTR_LOG_ERROR(
+      "Fabric netlists cannot be written as the fabric is built with option "
+      "'--bitstream_only'!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  /* Only the Verilog writer can generate the nets which are deferred */
+  if (true == openfpga_ctx.flow_manager().gsb_nets_deferred()) {
+    VTR_LOG_ERROR(
+      "SPICE netlists cannot be written as the fabric is built with option "
+      "'--defer_gsb_nets'!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* This is an intermediate data structure which is designed to modularize the
    * FPGA-SPICE Keep it independent from any other outside data structures
    */
@@ -30,9 +51,28 @@ int write_fabric_spice_template(T& openfpga_ctx, const Command& cmd,
   options.set_output_directory(cmd_context.option_value(cmd, opt_output_dir));
   options.set_explicit_port_mapping(
     cmd_context.option_enable(cmd, opt_explicit_port_mapping));
+  options.set_merge_transistor_bins(
+    cmd_context.option_enable(cmd, opt_merge_transistor_bins));
+  if (true == cmd_context.option_enable(cmd, opt_top_partition_size)) {
+    int partition_size =
+      std::atoi(cmd_context.option_value(cmd, opt_top_partition_size).c_str());
+    if (0 > partition_size) {
+      VTR_LOG_ERROR("Invalid size '%d' of partitions of top-level netlist!\n",
+                    partition_size);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    options.set_top_partition_size(partition_size);
+  }
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_compress_routing(openfpga_ctx.flow_manager().compress_routing());
 
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
+  options.set_num_threads(find_num_threads(num_threads));
+
   int status = CMD_EXEC_SUCCESS;
   status = fpga_fabric_spice(
     openfpga_ctx.module_graph(), openfpga_ctx.mutable_spice_netlists(),
@@ -7,6 +7,7 @@
  * - generate_fabric_verilog : generate Verilog netlists about FPGA fabric
  * - generate_fabric_verilog_testbench : TODO: generate Verilog testbenches
  *******************************************************************/
+#include "openfpga_link_arch_stage_template.h"
 #include "openfpga_verilog_template.h"
 #include "shell.h"
 
@@ -59,6 +60,60 @@ ShellCommandId add_write_fabric_verilog_command_template(
     "use_relative_path", false,
     "Force to use relative path in netlists when including other netlists");
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option(
+    "num_threads", false,
+    "Number of threads used to write the netlists. Use 0 to use all the "
+    "available threads. By default, the number of threads of the shell is "
+    "used");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
+  /* Add an option '--dedup_routing_modules' */
+  shell_cmd.add_option(
+    "dedup_routing_modules", false,
+    "Write the routing modules which mirror others as wrappers of their "
+    "unique mirrors. Only applicable when routing is not compressed");
+
+  /* Add an option '--parameterized_decoders' */
+  shell_cmd.add_option(
+    "parameterized_decoders", false,
+    "Write the decoders of configuration protocols as instances of a "
+    "parameterized decoder, rather than a truth table per decoder size");
+
+  /* Add an option '--num_top_module_slices' */
+  CommandOptionId opt_num_top_module_slices = shell_cmd.add_option(
+    "num_top_module_slices", false,
+    "Split the instances of the top-level module into a number of netlists, "
+    "which are included by the top-level netlist. By default, the top-level "
+    "module is written to a single netlist");
+  shell_cmd.set_option_require_value(opt_num_top_module_slices,
+                                     openfpga::OPT_INT);
+
+  /* Add an option '--top_module_slice' */
+  CommandOptionId opt_top_module_slice = shell_cmd.add_option(
+    "top_module_slice", false,
+    "Only write the netlist of a slice of the top-level module, so that the "
+    "slices can be written by a number of processes. Require option "
+    "'--num_top_module_slices'");
+  shell_cmd.set_option_require_value(opt_top_module_slice, openfpga::OPT_INT);
+
+  /* Add an option '--skip_top_module_slices' */
+  shell_cmd.add_option(
+    "skip_top_module_slices", false,
+    "Write all the netlists except the slices of the top-level module, which "
+    "are written by other processes with option '--top_module_slice'. Require "
+    "option '--num_top_module_slices'");
+
+  /* Add an option '--incremental' */
+  shell_cmd.add_option(
+    "incremental", false,
+    "Only overwrite the netlists whose contents are changed, and list the "
+    "changed netlists in a manifest file");
+
+  /* Add an option '--compress' */
+  shell_cmd.add_option("compress", false,
+                       "Compress the output files in gzip format");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -148,6 +203,48 @@ ShellCommandId add_write_full_testbench_command_template(
   shell_cmd.add_option("include_signal_init", false,
                        "initialize all the signals in verilog testbenches");
 
+  /* add an option '--signal_init_per_module' */
+  shell_cmd.add_option(
+    "signal_init_per_module", false,
+    "Initialize the signals once per primitive module using SystemVerilog "
+    "bind directives, rather than once per primitive instance. Only "
+    "applicable when '--include_signal_init' is enabled");
+
+  /* add an option '--hex_bitstream' */
+  shell_cmd.add_option(
+    "hex_bitstream", false,
+    "Load the bitstream file by '$readmemh'. The bitstream file should be "
+    "written by 'write_fabric_bitstream --format hex'");
+
+  /* Add an option '--backdoor_configuration' */
+  CommandOptionId backdoor_opt = shell_cmd.add_option(
+    "backdoor_configuration", false,
+    "Impose the bitstream on the configuration memories in zero time "
+    "through hierarchical paths, rather than through the configuration "
+    "protocol. Specify the simulator syntax [iverilog|modelsim]");
+  shell_cmd.set_option_require_value(backdoor_opt, openfpga::OPT_STRING);
+
+  /* Add an option '--reuse_fabric_testbench' */
+  shell_cmd.add_option(
+    "reuse_fabric_testbench", false,
+    "Write the codes of the testbench which are independent from the "
+    "design, e.g., the FPGA instance, to a netlist shared by all the "
+    "designs. The netlist is written only when it does not exist");
+
+  /* Add an option '--vectorized_stimulus' */
+  shell_cmd.add_option(
+    "vectorized_stimulus", false,
+    "Generate the random stimulus of inputs by a '$urandom' call per group "
+    "of 32 inputs, rather than a '$random' call per input");
+
+  /* Add an option '--stimulus_vector_file' */
+  CommandOptionId stimulus_vector_opt = shell_cmd.add_option(
+    "stimulus_vector_file", false,
+    "Apply the stimulus of inputs from precomputed vectors in a file loaded "
+    "by '$readmemh', rather than random stimulus. One vector per clock cycle");
+  shell_cmd.set_option_require_value(stimulus_vector_opt,
+                                     openfpga::OPT_STRING);
+
   /* Add an option '--no_time_stamp' */
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print a time stamp in the output files");
@@ -157,6 +254,10 @@ ShellCommandId add_write_full_testbench_command_template(
     "use_relative_path", false,
     "Force to use relative path in netlists when including other netlists");
 
+  /* add an option '--compress' */
+  shell_cmd.add_option("compress", false,
+                       "Compress the output files in gzip format");
+
   /* add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "enable verbose output");
 
@@ -167,6 +268,12 @@ ShellCommandId add_write_full_testbench_command_template(
   shell.set_command_execute_function(shell_cmd_id,
                                      write_full_testbench_template<T>);
 
+  /* Run the deferred annotation which the command requires */
+  shell.set_command_prerequisite(shell_cmd_id, [](T& openfpga_ctx) {
+    return require_link_arch_stages_template<T>(openfpga_ctx,
+                                                {LINK_ARCH_SIMULATION_SETTING});
+  });
+
   /* add command dependency to the shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
 
@@ -227,14 +334,30 @@ ShellCommandId add_write_preconfigured_fabric_wrapper_command_template(
                          "may cause a large netlist file size");
   shell_cmd.set_option_require_value(embed_bitstream_opt, openfpga::OPT_STRING);
 
+  /* Add an option '--bitstream_memory_image' */
+  shell_cmd.add_option("bitstream_memory_image", false,
+                       "Load the embedded bitstream from a memory image file "
+                       "rather than writing the bit values to the netlist");
+
   /* add an option '--include_signal_init' */
   shell_cmd.add_option("include_signal_init", false,
                        "initialize all the signals in verilog testbenches");
 
+  /* add an option '--signal_init_per_module' */
+  shell_cmd.add_option(
+    "signal_init_per_module", false,
+    "Initialize the signals once per primitive module using SystemVerilog "
+    "bind directives, rather than once per primitive instance. Only "
+    "applicable when '--include_signal_init' is enabled");
+
   /* Add an option '--no_time_stamp' */
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print a time stamp in the output files");
 
+  /* add an option '--compress' */
+  shell_cmd.add_option("compress", false,
+                       "Compress the output files in gzip format");
+
   /* add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "enable verbose output");
 
@@ -305,6 +428,20 @@ ShellCommandId add_write_preconfigured_testbench_command_template(
   shell_cmd.set_option_require_value(default_net_type_opt,
                                      openfpga::OPT_STRING);
 
+  /* Add an option '--vectorized_stimulus' */
+  shell_cmd.add_option(
+    "vectorized_stimulus", false,
+    "Generate the random stimulus of inputs by a '$urandom' call per group "
+    "of 32 inputs, rather than a '$random' call per input");
+
+  /* Add an option '--stimulus_vector_file' */
+  CommandOptionId stimulus_vector_opt = shell_cmd.add_option(
+    "stimulus_vector_file", false,
+    "Apply the stimulus of inputs from precomputed vectors in a file loaded "
+    "by '$readmemh', rather than random stimulus. One vector per clock cycle");
+  shell_cmd.set_option_require_value(stimulus_vector_opt,
+                                     openfpga::OPT_STRING);
+
   /* Add an option '--no_time_stamp' */
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print a time stamp in the output files");
@@ -314,6 +451,10 @@ ShellCommandId add_write_preconfigured_testbench_command_template(
     "use_relative_path", false,
     "Force to use relative path in netlists when including other netlists");
 
+  /* Add an option '--compress' */
+  shell_cmd.add_option("compress", false,
+                       "Compress the output files in gzip format");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -324,6 +465,12 @@ ShellCommandId add_write_preconfigured_testbench_command_template(
   shell.set_command_execute_function(shell_cmd_id,
                                      write_preconfigured_testbench_template<T>);
 
+  /* Run the deferred annotation which the command requires */
+  shell.set_command_prerequisite(shell_cmd_id, [](T& openfpga_ctx) {
+    return require_link_arch_stages_template<T>(openfpga_ctx,
+                                                {LINK_ARCH_SIMULATION_SETTING});
+  });
+
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
 
@@ -386,6 +533,12 @@ ShellCommandId add_write_simulation_task_info_command_template(
   shell.set_command_execute_function(shell_cmd_id,
                                      write_simulation_task_info_template<T>);
 
+  /* Run the deferred annotation which the command requires */
+  shell.set_command_prerequisite(shell_cmd_id, [](T& openfpga_ctx) {
+    return require_link_arch_stages_template<T>(openfpga_ctx,
+                                                {LINK_ARCH_SIMULATION_SETTING});
+  });
+
   /* Add command dependency to the Shell */
   shell.set_command_dependency(shell_cmd_id, dependent_cmds);
 
@@ -8,7 +8,10 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_buffered_stream.h"
+#include "openfpga_parallel.h"
 #include "openfpga_scale.h"
+#include "openfpga_trace.h"
 #include "read_xml_bus_group.h"
 #include "read_xml_pin_constraints.h"
 #include "verilog_api.h"
@@ -33,7 +36,38 @@ int write_fabric_verilog_template(T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_default_net_type = cmd.option("default_net_type");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
   CommandOptionId opt_use_relative_path = cmd.option("use_relative_path");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
+  CommandOptionId opt_num_top_module_slices =
+    cmd.option("num_top_module_slices");
+  CommandOptionId opt_top_module_slice = cmd.option("top_module_slice");
+  CommandOptionId opt_skip_top_module_slices =
+    cmd.option("skip_top_module_slices");
+  CommandOptionId opt_dedup_routing_modules =
+    cmd.option("dedup_routing_modules");
+  CommandOptionId opt_parameterized_decoders =
+    cmd.option("parameterized_decoders");
+  CommandOptionId opt_incremental = cmd.option("incremental");
   CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_compress = cmd.option("compress");
+
+  /* Output files are compressed until the command returns */
+  if ((true == cmd_context.option_enable(cmd, opt_compress)) &&
+      (false == output_compression_supported())) {
+    VTR_LOG_ERROR(
+      "Option '--compress' requires OpenFPGA to be built with zlib!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  ScopedOutputCompression compression_scope(
+    cmd_context.option_enable(cmd, opt_compress));
+
+  /* The fabric netlists require the nets between grids and routing blocks,
+   * which are skipped by option '--bitstream_only' of build_fabric */
+  if (true == openfpga_ctx.flow_manager().bitstream_only()) {
+    VTR_LOG_ERROR(
+      "Fabric netlists cannot be written as the fabric is built with option "
+      "'--bitstream_only'!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
 
   /* This is an intermediate data structure which is designed to modularize the
    * FPGA-Verilog Keep it independent from any other outside data structures
@@ -53,8 +87,88 @@ int write_fabric_verilog_template(T& openfpga_ctx, const Command& cmd,
     options.set_default_net_type(
       cmd_context.option_value(cmd, opt_default_net_type));
   }
+  /* Use the number of threads of the shell by default */
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
+  options.set_num_threads(find_num_threads(num_threads));
+  if (true == cmd_context.option_enable(cmd, opt_num_top_module_slices)) {
+    int num_slices = std::atoi(
+      cmd_context.option_value(cmd, opt_num_top_module_slices).c_str());
+    if (1 > num_slices) {
+      VTR_LOG_ERROR("Invalid number of top-level module slices %d!\n",
+                    num_slices);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    options.set_num_top_module_slices(num_slices);
+  }
+  /* Slices can be distributed among processes only when there are slices */
+  if (((true == cmd_context.option_enable(cmd, opt_top_module_slice)) ||
+       (true == cmd_context.option_enable(cmd, opt_skip_top_module_slices))) &&
+      (1 == options.num_top_module_slices())) {
+    VTR_LOG_ERROR(
+      "Options '--top_module_slice' and '--skip_top_module_slices' require "
+      "option '--num_top_module_slices' with more than 1 slice!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if ((true == cmd_context.option_enable(cmd, opt_top_module_slice)) &&
+      (true == cmd_context.option_enable(cmd, opt_skip_top_module_slices))) {
+    VTR_LOG_ERROR(
+      "Option '--top_module_slice' conflicts with option "
+      "'--skip_top_module_slices'!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if (true == cmd_context.option_enable(cmd, opt_top_module_slice)) {
+    int slice = std::atoi(
+      cmd_context.option_value(cmd, opt_top_module_slice).c_str());
+    if (0 > slice) {
+      VTR_LOG_ERROR("Invalid top-level module slice %d!\n", slice);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    options.set_top_module_slice(slice);
+  }
+  options.set_skip_top_module_slices(
+    cmd_context.option_enable(cmd, opt_skip_top_module_slices));
+  options.set_parameterized_decoders(
+    cmd_context.option_enable(cmd, opt_parameterized_decoders));
+  options.set_incremental(cmd_context.option_enable(cmd, opt_incremental));
+  if ((true == options.incremental()) && (true == options.time_stamp())) {
+    VTR_LOG_WARN(
+      "Time stamps change the netlists of each run. Consider option "
+      "'--no_time_stamp' with option '--incremental'\n");
+  }
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_compress_routing(openfpga_ctx.flow_manager().compress_routing());
+  options.set_gsb_nets_deferred(
+    openfpga_ctx.flow_manager().gsb_nets_deferred());
+  options.set_duplicate_grid_pin(
+    openfpga_ctx.flow_manager().duplicate_grid_pin());
+  if (true == cmd_context.option_enable(cmd, opt_dedup_routing_modules)) {
+    if (true == options.compress_routing()) {
+      VTR_LOG_WARN(
+        "Routing modules are already unique as routing is compressed. Option "
+        "'--dedup_routing_modules' is ignored\n");
+    } else {
+      /* The unique mirrors are only identified when routing is compressed.
+       * Identify them here, which does not change the flatten modules */
+      if (0 == openfpga_ctx.device_rr_gsb().get_num_gsb_unique_module()) {
+        vtr::ScopedStartFinishTimer timer(
+          "Identify unique General Switch Blocks (GSBs)");
+        OPENFPGA_TRACE_FUNCTION();
+        openfpga_ctx.mutable_device_rr_gsb().build_unique_module(
+          g_vpr_ctx.device().rr_graph, options.num_threads());
+      }
+      options.set_dedup_routing_modules(true);
+    }
+  }
+
+  /* A process which writes a slice skips all the other netlists */
+  if (true == options.only_top_module_slice()) {
+    return fpga_fabric_verilog_top_module_slice(openfpga_ctx.module_graph(),
+                                                options);
+  }
 
   fpga_fabric_verilog(openfpga_ctx.mutable_module_graph(),
                       openfpga_ctx.mutable_verilog_netlists(),
@@ -86,9 +200,30 @@ int write_full_testbench_template(const T& openfpga_ctx, const Command& cmd,
     cmd.option("explicit_port_mapping");
   CommandOptionId opt_default_net_type = cmd.option("default_net_type");
   CommandOptionId opt_include_signal_init = cmd.option("include_signal_init");
+  CommandOptionId opt_signal_init_per_module =
+    cmd.option("signal_init_per_module");
+  CommandOptionId opt_hex_bitstream = cmd.option("hex_bitstream");
+  CommandOptionId opt_backdoor_configuration =
+    cmd.option("backdoor_configuration");
+  CommandOptionId opt_reuse_fabric_testbench =
+    cmd.option("reuse_fabric_testbench");
+  CommandOptionId opt_vectorized_stimulus = cmd.option("vectorized_stimulus");
+  CommandOptionId opt_stimulus_vector_file =
+    cmd.option("stimulus_vector_file");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
   CommandOptionId opt_use_relative_path = cmd.option("use_relative_path");
   CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_compress = cmd.option("compress");
+
+  /* Output files are compressed until the command returns */
+  if ((true == cmd_context.option_enable(cmd, opt_compress)) &&
+      (false == output_compression_supported())) {
+    VTR_LOG_ERROR(
+      "Option '--compress' requires OpenFPGA to be built with zlib!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  ScopedOutputCompression compression_scope(
+    cmd_context.option_enable(cmd, opt_compress));
 
   /* This is an intermediate data structure which is designed to modularize the
    * FPGA-Verilog Keep it independent from any other outside data structures
@@ -110,6 +245,23 @@ int write_full_testbench_template(const T& openfpga_ctx, const Command& cmd,
   options.set_print_top_testbench(true);
   options.set_include_signal_init(
     cmd_context.option_enable(cmd, opt_include_signal_init));
+  options.set_signal_init_per_module(
+    cmd_context.option_enable(cmd, opt_signal_init_per_module));
+  options.set_hex_bitstream(cmd_context.option_enable(cmd, opt_hex_bitstream));
+  if (true == cmd_context.option_enable(cmd, opt_backdoor_configuration)) {
+    options.set_embedded_bitstream_hdl_type(
+      cmd_context.option_value(cmd, opt_backdoor_configuration));
+    options.set_backdoor_configuration(NUM_EMBEDDED_BITSTREAM_HDL_TYPES !=
+                                       options.embedded_bitstream_hdl_type());
+  }
+  options.set_reuse_fabric_testbench(
+    cmd_context.option_enable(cmd, opt_reuse_fabric_testbench));
+  options.set_vectorized_stimulus(
+    cmd_context.option_enable(cmd, opt_vectorized_stimulus));
+  if (true == cmd_context.option_enable(cmd, opt_stimulus_vector_file)) {
+    options.set_stimulus_vector_file(
+      cmd_context.option_value(cmd, opt_stimulus_vector_file));
+  }
   if (true == cmd_context.option_enable(cmd, opt_default_net_type)) {
     options.set_default_net_type(
       cmd_context.option_value(cmd, opt_default_net_type));
@@ -156,9 +308,24 @@ int write_preconfigured_fabric_wrapper_template(
     cmd.option("explicit_port_mapping");
   CommandOptionId opt_default_net_type = cmd.option("default_net_type");
   CommandOptionId opt_include_signal_init = cmd.option("include_signal_init");
+  CommandOptionId opt_signal_init_per_module =
+    cmd.option("signal_init_per_module");
   CommandOptionId opt_embed_bitstream = cmd.option("embed_bitstream");
+  CommandOptionId opt_bitstream_memory_image =
+    cmd.option("bitstream_memory_image");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
   CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_compress = cmd.option("compress");
+
+  /* Output files are compressed until the command returns */
+  if ((true == cmd_context.option_enable(cmd, opt_compress)) &&
+      (false == output_compression_supported())) {
+    VTR_LOG_ERROR(
+      "Option '--compress' requires OpenFPGA to be built with zlib!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  ScopedOutputCompression compression_scope(
+    cmd_context.option_enable(cmd, opt_compress));
 
   /* This is an intermediate data structure which is designed to modularize the
    * FPGA-Verilog Keep it independent from any other outside data structures
@@ -173,6 +340,8 @@ int write_preconfigured_fabric_wrapper_template(
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_include_signal_init(
     cmd_context.option_enable(cmd, opt_include_signal_init));
+  options.set_signal_init_per_module(
+    cmd_context.option_enable(cmd, opt_signal_init_per_module));
   options.set_print_formal_verification_top_netlist(true);
 
   if (true == cmd_context.option_enable(cmd, opt_default_net_type)) {
@@ -185,6 +354,17 @@ int write_preconfigured_fabric_wrapper_template(
       cmd_context.option_value(cmd, opt_embed_bitstream));
   }
 
+  if (true == cmd_context.option_enable(cmd, opt_bitstream_memory_image)) {
+    if (NUM_EMBEDDED_BITSTREAM_HDL_TYPES ==
+        options.embedded_bitstream_hdl_type()) {
+      VTR_LOG_WARN(
+        "Option '--bitstream_memory_image' is ignored since no bitstream is "
+        "embedded!\n");
+    } else {
+      options.set_bitstream_memory_image(true);
+    }
+  }
+
   /* If pin constraints are enabled by command options, read the file */
   PinConstraints pin_constraints;
   if (true == cmd_context.option_enable(cmd, opt_pcf)) {
@@ -224,9 +404,23 @@ int write_preconfigured_testbench_template(const T& openfpga_ctx,
   CommandOptionId opt_explicit_port_mapping =
     cmd.option("explicit_port_mapping");
   CommandOptionId opt_default_net_type = cmd.option("default_net_type");
+  CommandOptionId opt_vectorized_stimulus = cmd.option("vectorized_stimulus");
+  CommandOptionId opt_stimulus_vector_file =
+    cmd.option("stimulus_vector_file");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
   CommandOptionId opt_use_relative_path = cmd.option("use_relative_path");
   CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_compress = cmd.option("compress");
+
+  /* Output files are compressed until the command returns */
+  if ((true == cmd_context.option_enable(cmd, opt_compress)) &&
+      (false == output_compression_supported())) {
+    VTR_LOG_ERROR(
+      "Option '--compress' requires OpenFPGA to be built with zlib!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  ScopedOutputCompression compression_scope(
+    cmd_context.option_enable(cmd, opt_compress));
 
   /* This is an intermediate data structure which is designed to modularize the
    * FPGA-Verilog Keep it independent from any other outside data structures
@@ -244,6 +438,12 @@ int write_preconfigured_testbench_template(const T& openfpga_ctx,
     cmd_context.option_enable(cmd, opt_use_relative_path));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_print_preconfig_top_testbench(true);
+  options.set_vectorized_stimulus(
+    cmd_context.option_enable(cmd, opt_vectorized_stimulus));
+  if (true == cmd_context.option_enable(cmd, opt_stimulus_vector_file)) {
+    options.set_stimulus_vector_file(
+      cmd_context.option_value(cmd, opt_stimulus_vector_file));
+  }
   if (true == cmd_context.option_enable(cmd, opt_default_net_type)) {
     options.set_default_net_type(
       cmd_context.option_value(cmd, opt_default_net_type));
@@ -328,9 +528,9 @@ int write_simulation_task_info_template(const T& openfpga_ctx,
 
   return fpga_verilog_simulation_task_info(
     openfpga_ctx.module_graph(), openfpga_ctx.bitstream_manager(),
-    g_vpr_ctx.atom(), g_vpr_ctx.placement(), openfpga_ctx.io_location_map(),
-    openfpga_ctx.simulation_setting(), openfpga_ctx.arch().config_protocol,
-    options);
+    openfpga_ctx.fabric_bitstream(), g_vpr_ctx.atom(), g_vpr_ctx.placement(),
+    openfpga_ctx.io_location_map(), openfpga_ctx.simulation_setting(),
+    openfpga_ctx.arch().config_protocol, options);
 }
 
 } /* end namespace openfpga */
@@ -7,6 +7,7 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_parallel.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
 #include "write_xml_device_rr_gsb.h"
@@ -33,6 +34,7 @@ int write_gsb_template(const T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_exclude_rr_info = cmd.option("exclude_rr_info");
   CommandOptionId opt_exclude = cmd.option("exclude");
   CommandOptionId opt_gsb_names = cmd.option("gsb_names");
+  CommandOptionId opt_num_threads = cmd.option("num_threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
   /* Build the options for the writer */
@@ -45,6 +47,13 @@ int write_gsb_template(const T& openfpga_ctx, const Command& cmd,
   options.set_include_gsb_names(cmd_context.option_value(cmd, opt_gsb_names));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
 
+  int num_threads = default_num_threads();
+  if (true == cmd_context.option_enable(cmd, opt_num_threads)) {
+    num_threads =
+      std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+  }
+  options.set_num_threads(find_num_threads(num_threads));
+
   if (!options.valid()) {
     VTR_LOG("Detected errors when parsing options!\n");
     return CMD_EXEC_FATAL_ERROR;
@@ -0,0 +1,101 @@
+/********************************************************************
+ * This file includes functions to flatten the configurable children of
+ * the top-level module of the FPGA fabric
+ *******************************************************************/
+#include <string>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+#include "build_config_child_hierarchy.h"
+#include "memory_utils.h"
+#include "openfpga_naming.h"
+#include "openfpga_trace.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Add a configurable child and all its descendants to the hierarchy,
+ * in the sequence of a Depth-First Search (DFS).
+ * The children to visit are the same as those counted when estimating the
+ * size of the device bitstream: the decoder, which is the last
+ * configurable child of a module using the frame-based protocol, is skipped
+ *******************************************************************/
+static void rec_add_config_child_hierarchy_nodes(
+  ConfigChildHierarchy& hierarchy, const ModuleManager& module_manager,
+  const ConfigProtocol& config_protocol, const ModuleId& parent_module,
+  const ConfigChildNodeId& parent_node, const ModuleId& child_module,
+  const size_t& child_instance, const ConfigRegionId& region) {
+  std::string name =
+    module_manager.instance_name(parent_module, child_module, child_instance);
+  if (true == name.empty()) {
+    append_instance_name(name, module_manager.module_name(child_module),
+                         child_instance);
+  }
+  ConfigChildNodeId node = hierarchy.add_node(child_module, child_instance,
+                                              name, parent_node, region);
+
+  const std::vector<ModuleId>& children =
+    module_manager.configurable_children(child_module);
+  const std::vector<size_t>& instances =
+    module_manager.configurable_child_instances(child_module);
+  size_t num_children = children.size();
+  if ((CONFIG_MEM_FRAME_BASED == config_protocol.type()) &&
+      (2 <= num_children)) {
+    num_children--;
+  }
+  for (size_t ichild = 0; ichild < num_children; ++ichild) {
+    rec_add_config_child_hierarchy_nodes(
+      hierarchy, module_manager, config_protocol, child_module, node,
+      children[ichild], instances[ichild], region);
+  }
+
+  hierarchy.close_node(node);
+}
+
+/********************************************************************
+ * Flatten the configurable children of the top-level module, region by
+ * region, where the decoders of each region are skipped
+ *******************************************************************/
+ConfigChildHierarchy build_config_child_hierarchy(
+  const ModuleManager& module_manager, const ConfigProtocol& config_protocol,
+  const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer(
+    "Build hierarchy of configurable children for top module");
+  OPENFPGA_TRACE_FUNCTION();
+
+  ConfigChildHierarchy hierarchy;
+
+  std::string top_module_name = generate_fpga_top_module_name();
+  ModuleId top_module = module_manager.find_module(top_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+  hierarchy.set_top_module(top_module);
+
+  for (const ConfigRegionId& region : module_manager.regions(top_module)) {
+    std::vector<ModuleId> children =
+      module_manager.region_configurable_children(top_module, region);
+    std::vector<size_t> instances =
+      module_manager.region_configurable_child_instances(top_module, region);
+    size_t num_children =
+      children.size() -
+      estimate_num_configurable_children_to_skip_by_config_protocol(
+        config_protocol, children.size());
+    for (size_t ichild = 0; ichild < num_children; ++ichild) {
+      rec_add_config_child_hierarchy_nodes(
+        hierarchy, module_manager, config_protocol, top_module,
+        ConfigChildNodeId::INVALID(), children[ichild], instances[ichild],
+        region);
+    }
+  }
+
+  VTR_LOGV(verbose,
+           "Flattened %lu configurable children with %lu configuration bits\n",
+           hierarchy.num_nodes(), hierarchy.num_bits());
+
+  return hierarchy;
+}
+
+} /* end namespace openfpga */
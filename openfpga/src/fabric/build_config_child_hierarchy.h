@@ -0,0 +1,24 @@
+#ifndef BUILD_CONFIG_CHILD_HIERARCHY_H
+#define BUILD_CONFIG_CHILD_HIERARCHY_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "config_child_hierarchy.h"
+#include "config_protocol.h"
+#include "module_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+ConfigChildHierarchy build_config_child_hierarchy(
+  const ModuleManager& module_manager, const ConfigProtocol& config_protocol,
+  const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -12,6 +12,7 @@
 #include "module_manager_utils.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -316,6 +317,7 @@ void build_mux_local_decoder_modules(ModuleManager& module_manager,
                                      const CircuitLibrary& circuit_lib) {
   vtr::ScopedStartFinishTimer timer(
     "Build local encoder (for multiplexers) modules");
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create a library for local encoders with different sizes */
   DecoderLibrary decoder_lib;
@@ -330,12 +332,11 @@ void build_mux_local_decoder_modules(ModuleManager& module_manager,
       continue;
     }
 
-    const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
-    /* Create a mux graph for the branch circuit */
-    std::vector<MuxGraph> branch_mux_graphs =
-      mux_graph.build_mux_branch_graphs();
+    /* Get the mux graphs of the branch circuits */
+    const std::vector<MuxGraph>& branch_mux_graphs =
+      mux_lib.mux_branch_graphs(mux);
     /* Add the decoder to the decoder library */
-    for (auto branch_mux_graph : branch_mux_graphs) {
+    for (const MuxGraph& branch_mux_graph : branch_mux_graphs) {
       /* The decoder size depends on the number of memories of a branch MUX.
        * Note that only when there are >=2 memories, a decoder is needed
        */
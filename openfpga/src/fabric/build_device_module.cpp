@@ -2,12 +2,19 @@
  * This file includes the main function to build module graphs
  * for the FPGA fabric
  *******************************************************************/
+#include <algorithm>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+#include "openfpga_progress.h"
+#include "openfpga_trace.h"
+
 /* Headers from openfpgashell library */
 #include "build_decoder_modules.h"
 #include "build_device_module.h"
@@ -24,6 +31,107 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Number of chunks of routing modules per thread. The unique routing
+ * modules differ a lot in size, so a few chunks per thread keep all the
+ * threads busy until the end. Each chunk costs a copy of the primitive
+ * modules, which is small */
+constexpr size_t NUM_ROUTING_MODULE_CHUNKS_PER_THREAD = 4;
+
+/********************************************************************
+ * Add the decoders of a staging decoder library, which are not in the
+ * decoder library it is copied from, to the decoder library
+ *******************************************************************/
+static void merge_staged_decoders(DecoderLibrary& decoder_lib,
+                                  const DecoderLibrary& staging_decoder_lib,
+                                  const size_t& num_base_decoders) {
+  for (const DecoderId& decoder : staging_decoder_lib.decoders()) {
+    if (size_t(decoder) < num_base_decoders) {
+      continue;
+    }
+    size_t addr_size = staging_decoder_lib.addr_size(decoder);
+    size_t data_size = staging_decoder_lib.data_size(decoder);
+    bool use_enable = staging_decoder_lib.use_enable(decoder);
+    bool use_data_in = staging_decoder_lib.use_data_in(decoder);
+    bool use_data_inv_port = staging_decoder_lib.use_data_inv_port(decoder);
+    bool use_readback = staging_decoder_lib.use_readback(decoder);
+    if (DecoderId::INVALID() ==
+        decoder_lib.find_decoder(addr_size, data_size, use_enable, use_data_in,
+                                 use_data_inv_port, use_readback)) {
+      decoder_lib.add_decoder(addr_size, data_size, use_enable, use_data_in,
+                              use_data_inv_port, use_readback);
+    }
+  }
+}
+
+/********************************************************************
+ * Build the grid modules and the routing modules with multiple threads
+ * The grid modules and the routing modules only instanciate the primitive
+ * modules, which are built in advance, so they can be built independently:
+ * - The grid modules are built by a task
+ * - The routing modules are split into chunks of similar cost, each of which
+ *   is built by a task
+ * Each task builds its modules in a staging module manager and a copy of
+ * the decoder library. Once all the tasks are done, the staged modules
+ * are merged in the order of the tasks, which is also the order of the
+ * sequential flow. Therefore, the module graph is the same regardless of
+ * the number of threads.
+ *******************************************************************/
+static void build_grid_and_routing_modules_in_parallel(
+  ModuleManager& module_manager, DecoderLibrary& decoder_lib,
+  const OpenfpgaContext& openfpga_ctx, const DeviceContext& vpr_device_ctx,
+  const CircuitModelId& sram_model, const bool& compress_routing,
+  const bool& duplicate_grid_pin, const size_t& num_threads,
+  const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer(
+    "Build grid and routing modules in parallel");
+  OPENFPGA_TRACE_FUNCTION();
+
+  std::vector<RoutingModuleGsb> gsbs =
+    find_routing_module_gsbs(openfpga_ctx.device_rr_gsb(), compress_routing);
+  std::vector<size_t> chunks = find_routing_module_gsb_chunks(
+    gsbs, NUM_ROUTING_MODULE_CHUNKS_PER_THREAD * num_threads);
+  size_t num_tasks = chunks.size();
+
+  std::vector<ModuleManager> staging_module_managers;
+  staging_module_managers.reserve(num_tasks);
+  for (size_t itask = 0; itask < num_tasks; ++itask) {
+    staging_module_managers.push_back(module_manager.create_staging());
+  }
+  std::vector<DecoderLibrary> staging_decoder_libs(num_tasks, decoder_lib);
+
+  ScopedProgress progress("Build routing modules", "GSBs", gsbs.size());
+  parallel_for_dynamic(
+    num_tasks, std::min(num_threads, num_tasks), [&](const size_t& itask) {
+      if (0 == itask) {
+        build_grid_modules(
+          staging_module_managers[itask], staging_decoder_libs[itask],
+          vpr_device_ctx, openfpga_ctx.vpr_device_annotation(),
+          openfpga_ctx.arch().circuit_lib, openfpga_ctx.mux_lib(),
+          openfpga_ctx.arch().config_protocol.type(), sram_model,
+          duplicate_grid_pin, verbose);
+        return;
+      }
+      build_routing_module_list(
+        staging_module_managers[itask], staging_decoder_libs[itask],
+        vpr_device_ctx, openfpga_ctx.vpr_device_annotation(),
+        openfpga_ctx.arch().circuit_lib,
+        openfpga_ctx.arch().config_protocol.type(), sram_model, gsbs,
+        chunks[itask - 1], chunks[itask], progress, verbose);
+    });
+
+  size_t num_base_decoders = decoder_lib.decoders().size();
+  for (size_t itask = 0; itask < num_tasks; ++itask) {
+    module_manager.merge_staged_modules(staging_module_managers[itask]);
+    merge_staged_decoders(decoder_lib, staging_decoder_libs[itask],
+                          num_base_decoders);
+  }
+
+  VTR_LOGV(verbose,
+           "Built grid modules and %lu routing modules in %lu chunks with %lu "
+           "threads\n",
+           gsbs.size(), num_tasks - 1, std::min(num_threads, num_tasks));
+}
+
 /********************************************************************
  * The main function to be called for building module graphs
  * for a FPGA fabric
@@ -32,10 +140,16 @@ int build_device_module_graph(
   ModuleManager& module_manager, DecoderLibrary& decoder_lib,
   MemoryBankShiftRegisterBanks& blwl_sr_banks,
   const OpenfpgaContext& openfpga_ctx, const DeviceContext& vpr_device_ctx,
-  const bool& frame_view, const bool& compress_routing,
+  const bool& frame_view, const bool& bitstream_only,
+  const bool& defer_gsb_nets, const bool& compress_routing,
   const bool& duplicate_grid_pin, const FabricKey& fabric_key,
-  const bool& generate_random_fabric_key, const bool& verbose) {
+  const bool& generate_random_fabric_key,
+  const bool& generate_locality_fabric_key,
+  const bool& balance_config_regions, const size_t& memory_tile_size,
+  const size_t& max_shift_register_bank_size, const size_t& num_threads,
+  const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build fabric module graph");
+  OPENFPGA_TRACE_FUNCTION();
 
   int status = CMD_EXEC_SUCCESS;
 
@@ -74,28 +188,36 @@ int build_device_module_graph(
   /* Build memory modules */
   build_memory_modules(module_manager, decoder_lib, openfpga_ctx.mux_lib(),
                        openfpga_ctx.arch().circuit_lib,
-                       openfpga_ctx.arch().config_protocol.type());
-
-  /* Build grid and programmable block modules */
-  build_grid_modules(module_manager, decoder_lib, vpr_device_ctx,
-                     openfpga_ctx.vpr_device_annotation(),
-                     openfpga_ctx.arch().circuit_lib, openfpga_ctx.mux_lib(),
-                     openfpga_ctx.arch().config_protocol.type(), sram_model,
-                     duplicate_grid_pin, verbose);
-
-  if (true == compress_routing) {
-    build_unique_routing_modules(
-      module_manager, decoder_lib, vpr_device_ctx,
-      openfpga_ctx.vpr_device_annotation(), openfpga_ctx.device_rr_gsb(),
-      openfpga_ctx.arch().circuit_lib,
-      openfpga_ctx.arch().config_protocol.type(), sram_model, verbose);
+                       openfpga_ctx.arch().config_protocol.type(),
+                       memory_tile_size);
+
+  if (1 < num_threads) {
+    /* Build grid, programmable block and routing modules */
+    build_grid_and_routing_modules_in_parallel(
+      module_manager, decoder_lib, openfpga_ctx, vpr_device_ctx, sram_model,
+      compress_routing, duplicate_grid_pin, num_threads, verbose);
   } else {
-    VTR_ASSERT_SAFE(false == compress_routing);
-    build_flatten_routing_modules(
-      module_manager, decoder_lib, vpr_device_ctx,
-      openfpga_ctx.vpr_device_annotation(), openfpga_ctx.device_rr_gsb(),
-      openfpga_ctx.arch().circuit_lib,
-      openfpga_ctx.arch().config_protocol.type(), sram_model, verbose);
+    /* Build grid and programmable block modules */
+    build_grid_modules(module_manager, decoder_lib, vpr_device_ctx,
+                       openfpga_ctx.vpr_device_annotation(),
+                       openfpga_ctx.arch().circuit_lib, openfpga_ctx.mux_lib(),
+                       openfpga_ctx.arch().config_protocol.type(), sram_model,
+                       duplicate_grid_pin, verbose);
+
+    if (true == compress_routing) {
+      build_unique_routing_modules(
+        module_manager, decoder_lib, vpr_device_ctx,
+        openfpga_ctx.vpr_device_annotation(), openfpga_ctx.device_rr_gsb(),
+        openfpga_ctx.arch().circuit_lib,
+        openfpga_ctx.arch().config_protocol.type(), sram_model, verbose);
+    } else {
+      VTR_ASSERT_SAFE(false == compress_routing);
+      build_flatten_routing_modules(
+        module_manager, decoder_lib, vpr_device_ctx,
+        openfpga_ctx.vpr_device_annotation(), openfpga_ctx.device_rr_gsb(),
+        openfpga_ctx.arch().circuit_lib,
+        openfpga_ctx.arch().config_protocol.type(), sram_model, verbose);
+    }
   }
 
   /* Build FPGA fabric top-level module */
@@ -105,8 +227,10 @@ int build_device_module_graph(
     openfpga_ctx.arch().tile_annotations, vpr_device_ctx.rr_graph,
     openfpga_ctx.device_rr_gsb(), openfpga_ctx.tile_direct(),
     openfpga_ctx.arch().arch_direct, openfpga_ctx.arch().config_protocol,
-    sram_model, frame_view, compress_routing, duplicate_grid_pin, fabric_key,
-    generate_random_fabric_key);
+    sram_model, frame_view, bitstream_only, defer_gsb_nets, compress_routing,
+    duplicate_grid_pin, fabric_key, generate_random_fabric_key,
+    generate_locality_fabric_key, balance_config_regions,
+    max_shift_register_bank_size, num_threads);
 
   if (CMD_EXEC_FATAL_ERROR == status) {
     return status;
@@ -122,6 +246,12 @@ int build_device_module_graph(
   rename_primitive_module_port_names(module_manager,
                                      openfpga_ctx.arch().circuit_lib);
 
+  /* The module graph is complete. Pack the nets of each module into flat
+   * arrays, which are read-only but much more compact. This is critical for
+   * the top-level module of large fabrics
+   */
+  module_manager.freeze_nets();
+
   return status;
 }
 
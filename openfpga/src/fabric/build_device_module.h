@@ -19,9 +19,14 @@ int build_device_module_graph(
   ModuleManager& module_manager, DecoderLibrary& decoder_lib,
   MemoryBankShiftRegisterBanks& blwl_sr_banks,
   const OpenfpgaContext& openfpga_ctx, const DeviceContext& vpr_device_ctx,
-  const bool& frame_view, const bool& compress_routing,
+  const bool& frame_view, const bool& bitstream_only,
+  const bool& defer_gsb_nets, const bool& compress_routing,
   const bool& duplicate_grid_pin, const FabricKey& fabric_key,
-  const bool& generate_random_fabric_key, const bool& verbose);
+  const bool& generate_random_fabric_key,
+  const bool& generate_locality_fabric_key,
+  const bool& balance_config_regions, const size_t& memory_tile_size,
+  const size_t& max_shift_register_bank_size, const size_t& num_threads,
+  const bool& verbose);
 
 } /* end namespace openfpga */
 
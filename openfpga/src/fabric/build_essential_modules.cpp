@@ -8,6 +8,7 @@
 
 #include "module_manager_utils.h"
 #include "openfpga_naming.h"
+#include "openfpga_trace.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -174,6 +175,7 @@ void build_essential_modules(ModuleManager& module_manager,
                              const CircuitLibrary& circuit_lib) {
   vtr::ScopedStartFinishTimer timer(
     "Build essential (inverter/buffer/logic gate) modules");
+  OPENFPGA_TRACE_FUNCTION();
 
   for (const auto& circuit_model : circuit_lib.models()) {
     /* Add essential modules upon on demand: only when it is not yet in the
@@ -207,6 +209,7 @@ void build_essential_modules(ModuleManager& module_manager,
 void build_user_defined_modules(ModuleManager& module_manager,
                                 const CircuitLibrary& circuit_lib) {
   vtr::ScopedStartFinishTimer timer("Build user-defined modules");
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Iterate over Verilog modules */
   for (const auto& model : circuit_lib.models()) {
@@ -264,6 +267,7 @@ static void build_constant_generator_module(ModuleManager& module_manager,
  ********************************************************************/
 void build_constant_generator_modules(ModuleManager& module_manager) {
   vtr::ScopedStartFinishTimer timer("Build constant generator modules");
+  OPENFPGA_TRACE_FUNCTION();
 
   /* VDD */
   build_constant_generator_module(module_manager, 1);
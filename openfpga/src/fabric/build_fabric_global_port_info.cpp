@@ -11,6 +11,7 @@
 #include "build_fabric_global_port_info.h"
 #include "circuit_library_utils.h"
 #include "openfpga_naming.h"
+#include "openfpga_trace.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -26,6 +27,7 @@ FabricGlobalPortInfo build_fabric_global_port_info(
   const ModuleManager& module_manager, const ConfigProtocol& config_protocol,
   const TileAnnotation& tile_annotation, const CircuitLibrary& circuit_lib) {
   vtr::ScopedStartFinishTimer timer("Create global port info for top module");
+  OPENFPGA_TRACE_FUNCTION();
 
   FabricGlobalPortInfo fabric_global_port_info;
 
@@ -114,6 +116,9 @@ FabricGlobalPortInfo build_fabric_global_port_info(
       fabric_port, tile_annotation.global_port_default_value(global_port));
   }
 
+  /* The writers find the global ports through the fast lookup */
+  fabric_global_port_info.build_fast_lookup(module_manager, top_module);
+
   return fabric_global_port_info;
 }
 
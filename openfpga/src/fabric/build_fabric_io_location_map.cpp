@@ -12,6 +12,9 @@
 #include "vtr_log.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_trace.h"
+
 /* Headers from vpr library */
 #include "build_fabric_io_location_map.h"
 #include "module_manager_utils.h"
@@ -35,6 +38,7 @@ IoLocationMap build_fabric_io_location_map(const ModuleManager& module_manager,
                                            const DeviceGrid& grids) {
   vtr::ScopedStartFinishTimer timer(
     "Create I/O location mapping for top module");
+  OPENFPGA_TRACE_FUNCTION();
 
   IoLocationMap io_location_map;
 
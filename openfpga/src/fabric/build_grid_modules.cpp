@@ -3,6 +3,7 @@
  * (CLBs, I/Os, heterogeneous blocks etc.)
  *******************************************************************/
 #include <ctime>
+#include <map>
 #include <vector>
 
 /* Headers from vtrutil library */
@@ -11,6 +12,9 @@
 #include "vtr_log.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_trace.h"
+
 /* Headers from vpr library */
 #include "build_grid_module_duplicated_pins.h"
 #include "build_grid_module_utils.h"
@@ -260,7 +264,7 @@ static void add_primitive_module_fpga_global_io_port(
  *     +---------------------------------------+
  *
  *******************************************************************/
-static void build_primitive_block_module(
+static ModuleId build_primitive_block_module(
   ModuleManager& module_manager, DecoderLibrary& decoder_lib,
   const VprDeviceAnnotation& device_annotation,
   const CircuitLibrary& circuit_lib,
@@ -401,6 +405,8 @@ static void build_primitive_block_module(
   }
 
   VTR_LOGV(verbose, "Done\n");
+
+  return primitive_module;
 }
 
 /********************************************************************
@@ -886,9 +892,15 @@ static void add_module_pb_graph_interc(
  * Note: DFS is the right way. Do NOT use BFS.
  * DFS can guarantee that all the sub-modules can be registered properly
  * to its parent in module manager
+ *
+ * Note: the modules which have been built are recorded in 'pb_modules'
+ * by their pb_type. A pb_type which is met again is not built twice,
+ * and its parent finds the child module from the record rather than by
+ * name.
  *******************************************************************/
 static void rec_build_logical_tile_modules(
   ModuleManager& module_manager, DecoderLibrary& decoder_lib,
+  std::map<t_pb_type*, ModuleId>& pb_modules,
   const VprDeviceAnnotation& device_annotation,
   const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
   const e_config_protocol_type& sram_orgz_type,
@@ -900,6 +912,11 @@ static void rec_build_logical_tile_modules(
   /* Get the pb_type definition related to the node */
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
 
+  /* Bypass the pb_type whose module has been built */
+  if (pb_modules.end() != pb_modules.find(physical_pb_type)) {
+    return;
+  }
+
   /* Find the mode that physical implementation of a pb_type */
   t_mode* physical_mode = device_annotation.physical_mode(physical_pb_type);
 
@@ -910,8 +927,8 @@ static void rec_build_logical_tile_modules(
     for (int ipb = 0; ipb < physical_mode->num_pb_type_children; ++ipb) {
       /* Go recursive to visit the children */
       rec_build_logical_tile_modules(
-        module_manager, decoder_lib, device_annotation, circuit_lib, mux_lib,
-        sram_orgz_type, sram_model,
+        module_manager, decoder_lib, pb_modules, device_annotation,
+        circuit_lib, mux_lib, sram_orgz_type, sram_model,
         &(physical_pb_graph_node
             ->child_pb_graph_nodes[physical_mode->index][ipb][0]),
         verbose);
@@ -920,9 +937,9 @@ static void rec_build_logical_tile_modules(
 
   /* For leaf node, a primitive Verilog module will be generated */
   if (true == is_primitive_pb_type(physical_pb_type)) {
-    build_primitive_block_module(module_manager, decoder_lib, device_annotation,
-                                 circuit_lib, sram_orgz_type, sram_model,
-                                 physical_pb_graph_node, verbose);
+    pb_modules[physical_pb_type] = build_primitive_block_module(
+      module_manager, decoder_lib, device_annotation, circuit_lib,
+      sram_orgz_type, sram_model, physical_pb_graph_node, verbose);
     /* Finish for primitive node, return */
     return;
   }
@@ -952,13 +969,22 @@ static void rec_build_logical_tile_modules(
 
   /* Add all the child Verilog modules as instances */
   for (int ichild = 0; ichild < physical_mode->num_pb_type_children; ++ichild) {
-    /* Get the name and module id for this child pb_type */
-    std::string child_pb_module_name = generate_physical_block_module_name(
-      &(physical_mode->pb_type_children[ichild]));
-    ModuleId child_pb_module = module_manager.find_module(child_pb_module_name);
+    /* Get the module id for this child pb_type, which has been built by DFS */
+    auto child_pb_module_it =
+      pb_modules.find(&(physical_mode->pb_type_children[ichild]));
+    VTR_ASSERT(pb_modules.end() != child_pb_module_it);
+    ModuleId child_pb_module = child_pb_module_it->second;
     /* We must have one valid id! */
     VTR_ASSERT(true == module_manager.valid_module_id(child_pb_module));
 
+    /* Identify if this sub module includes configuration bits. This is
+     * the same for all the instances of the child, so count it once
+     */
+    bool child_pb_module_configurable =
+      (0 < find_module_num_config_bits(module_manager, child_pb_module,
+                                       circuit_lib, sram_model,
+                                       sram_orgz_type));
+
     /* Each child may exist multiple times in the hierarchy*/
     for (int inst = 0; inst < physical_mode->pb_type_children[ichild].num_pb;
          ++inst) {
@@ -987,12 +1013,10 @@ static void rec_build_logical_tile_modules(
       module_manager.set_child_instance_name(
         pb_module, child_pb_module, child_instance_id, child_pb_instance_name);
 
-      /* Identify if this sub module includes configuration bits,
+      /* If this sub module includes configuration bits,
        * we will update the memory module and instance list
        */
-      if (0 < find_module_num_config_bits(module_manager, child_pb_module,
-                                          circuit_lib, sram_model,
-                                          sram_orgz_type)) {
+      if (true == child_pb_module_configurable) {
         module_manager.add_configurable_child(pb_module, child_pb_module,
                                               child_instance_id);
       }
@@ -1057,6 +1081,8 @@ static void rec_build_logical_tile_modules(
                                       circuit_lib.design_tech_type(sram_model));
   }
 
+  pb_modules[physical_pb_type] = pb_module;
+
   VTR_LOGV(verbose, "Done\n");
 }
 
@@ -1264,6 +1290,7 @@ void build_grid_modules(ModuleManager& module_manager,
                         const bool& duplicate_grid_pin, const bool& verbose) {
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Build grid modules");
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Enumerate the types of logical tiles, and build a module for each
    * Build modules for all the pb_types/pb_graph_nodes
@@ -1276,15 +1303,17 @@ void build_grid_modules(ModuleManager& module_manager,
    * traverse the graph in a recursive way */
   VTR_LOG("Building logical tiles...");
   VTR_LOGV(verbose, "\n");
+  std::map<t_pb_type*, ModuleId> pb_modules;
   for (const t_logical_block_type& logical_tile :
        device_ctx.logical_block_types) {
     /* Bypass empty pb_graph */
     if (nullptr == logical_tile.pb_graph_head) {
       continue;
     }
-    rec_build_logical_tile_modules(
-      module_manager, decoder_lib, device_annotation, circuit_lib, mux_lib,
-      sram_orgz_type, sram_model, logical_tile.pb_graph_head, verbose);
+    rec_build_logical_tile_modules(module_manager, decoder_lib, pb_modules,
+                                   device_annotation, circuit_lib, mux_lib,
+                                   sram_orgz_type, sram_model,
+                                   logical_tile.pb_graph_head, verbose);
   }
   VTR_LOG("Done\n");
 
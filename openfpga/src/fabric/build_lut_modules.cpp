@@ -13,6 +13,7 @@
 #include "module_manager_utils.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -509,6 +510,7 @@ static void build_lut_module(ModuleManager& module_manager,
 void build_lut_modules(ModuleManager& module_manager,
                        const CircuitLibrary& circuit_lib) {
   vtr::ScopedStartFinishTimer timer("Build Look-Up Table (LUT) modules");
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Search for each LUT circuit model */
   for (const auto& lut_model : circuit_lib.models()) {
@@ -18,6 +18,7 @@
 #include "mux_utils.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -663,6 +664,141 @@ static void build_memory_chain_module(ModuleManager& module_manager,
   add_module_global_ports_from_child_modules(module_manager, mem_module);
 }
 
+/*********************************************************************
+ * Scan-chain organization composed of memory tiles
+ *
+ *                +-------+    +-------+            +-------+
+ *  scan-chain--->| Tile  |--->| Tile  |--->... --->| Tile  |---->scan-chain
+ *  input&clock   |  [0]  |    |  [1]  |            | [M-1] |       output
+ *                +-------+    +-------+            +-------+
+ *                  | ... |      | ... |      ...     | ... | config-memory
+ *                  v     v      v     v              v     v output
+ *                +-----------------------------------------+
+ *                |   Multiplexer Configuration port        |
+ *
+ * Each tile is a scan-chain memory module of tile_size memories (see
+ * build_memory_chain_module()), except that the last tile holds the
+ * remaining memories. Tiles are shared by all the memory modules, so the
+ * nets of each memory are built once per tile rather than once per memory
+ * module. The chain order and the data outputs are the same as a flat
+ * scan-chain memory module of num_mems memories.
+ ********************************************************************/
+static void build_memory_chain_module_from_tiles(
+  ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
+  const std::string& module_name, const CircuitModelId& sram_model,
+  const size_t& num_mems, const size_t& tile_size) {
+  /* Find or build the tiles: full tiles and the tile of remaining memories */
+  std::vector<ModuleId> tile_modules;
+  std::vector<size_t> tile_sizes;
+  for (size_t mem_index = 0; mem_index < num_mems; mem_index += tile_size) {
+    size_t curr_tile_size = std::min(tile_size, num_mems - mem_index);
+    std::string tile_name = generate_memory_tile_module_name(
+      circuit_lib, sram_model, curr_tile_size,
+      std::string(MEMORY_MODULE_POSTFIX));
+    ModuleId tile_module = module_manager.find_module(tile_name);
+    if (false == module_manager.valid_module_id(tile_module)) {
+      build_memory_chain_module(module_manager, circuit_lib, tile_name,
+                                sram_model, curr_tile_size);
+      tile_module = module_manager.find_module(tile_name);
+    }
+    tile_modules.push_back(tile_module);
+    tile_sizes.push_back(curr_tile_size);
+  }
+
+  /* Create a module and add to the module manager */
+  ModuleId mem_module = module_manager.add_module(module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(mem_module));
+
+  /* Label module usage */
+  module_manager.set_module_usage(mem_module, ModuleManager::MODULE_CONFIG);
+
+  /* Add the chain ports and data output ports, which are the same as the
+   * tiles, except that the data outputs are as wide as the memories */
+  std::string chain_head_name = generate_configuration_chain_head_name();
+  std::string chain_tail_name = generate_configuration_chain_tail_name();
+  ModulePortId tile_head_port =
+    module_manager.find_module_port(tile_modules[0], chain_head_name);
+  ModulePortId tile_tail_port =
+    module_manager.find_module_port(tile_modules[0], chain_tail_name);
+  ModulePortId chain_head_port = module_manager.add_port(
+    mem_module, module_manager.module_port(tile_modules[0], tile_head_port),
+    ModuleManager::MODULE_INPUT_PORT);
+  ModulePortId chain_tail_port = module_manager.add_port(
+    mem_module, module_manager.module_port(tile_modules[0], tile_tail_port),
+    ModuleManager::MODULE_OUTPUT_PORT);
+
+  std::vector<std::string> data_port_names;
+  for (const std::string& port_name :
+       {generate_configurable_memory_data_out_name(),
+        generate_configurable_memory_inverted_data_out_name()}) {
+    if (true ==
+        module_manager.valid_module_port_id(
+          tile_modules[0],
+          module_manager.find_module_port(tile_modules[0], port_name))) {
+      module_manager.add_port(mem_module, BasicPort(port_name, num_mems),
+                              ModuleManager::MODULE_OUTPUT_PORT);
+      data_port_names.push_back(port_name);
+    }
+  }
+
+  /* Instanciate each tile and chain them from the head to the tail */
+  ModuleId prev_module = mem_module;
+  size_t prev_instance = 0;
+  ModulePortId prev_port = chain_head_port;
+  size_t mem_offset = 0;
+  for (size_t itile = 0; itile < tile_modules.size(); ++itile) {
+    const ModuleId& tile_module = tile_modules[itile];
+    size_t tile_instance = module_manager.num_instance(mem_module, tile_module);
+    module_manager.add_child_module(mem_module, tile_module);
+    module_manager.add_configurable_child(mem_module, tile_module,
+                                          tile_instance);
+
+    /* Wire the data outputs of the tile to a slice of the data outputs */
+    for (const std::string& port_name : data_port_names) {
+      ModulePortId src_port =
+        module_manager.find_module_port(tile_module, port_name);
+      ModulePortId sink_port =
+        module_manager.find_module_port(mem_module, port_name);
+      for (const size_t& pin :
+           module_manager.module_port(tile_module, src_port).pins()) {
+        ModuleNetId net = module_manager.create_module_net(mem_module);
+        module_manager.add_module_net_source(mem_module, net, tile_module,
+                                             tile_instance, src_port, pin);
+        module_manager.add_module_net_sink(mem_module, net, mem_module, 0,
+                                           sink_port, mem_offset + pin);
+      }
+    }
+    mem_offset += tile_sizes[itile];
+
+    /* Wire the previous tail (or the head) to the head of the tile */
+    ModulePortId head_port =
+      module_manager.find_module_port(tile_module, chain_head_name);
+    for (const size_t& pin :
+         module_manager.module_port(tile_module, head_port).pins()) {
+      ModuleNetId net =
+        create_module_source_pin_net(module_manager, mem_module, prev_module,
+                                     prev_instance, prev_port, pin);
+      module_manager.add_module_net_sink(mem_module, net, tile_module,
+                                         tile_instance, head_port, pin);
+    }
+    prev_module = tile_module;
+    prev_instance = tile_instance;
+    prev_port = module_manager.find_module_port(tile_module, chain_tail_name);
+  }
+
+  /* Wire the tail of the last tile to the tail of the chain */
+  for (const size_t& pin :
+       module_manager.module_port(mem_module, chain_tail_port).pins()) {
+    ModuleNetId net = create_module_source_pin_net(
+      module_manager, mem_module, prev_module, prev_instance, prev_port, pin);
+    module_manager.add_module_net_sink(mem_module, net, mem_module, 0,
+                                       chain_tail_port, pin);
+  }
+
+  /* Add global ports to the memory module from the tiles */
+  add_module_global_ports_from_child_modules(module_manager, mem_module);
+}
+
 /*********************************************************************
  * Frame-based Memory organization
  *
@@ -902,6 +1038,8 @@ static void build_frame_memory_module(ModuleManager& module_manager,
  * 1. Flat SRAM organization
  * 2. Configuration chain
  * 3. Memory bank (memory decoders)
+ * When a tile size is given, configuration chains which are longer than
+ * a tile are composed of memory tiles.
  ********************************************************************/
 static void build_memory_module(ModuleManager& module_manager,
                                 DecoderLibrary& arch_decoder_lib,
@@ -909,7 +1047,8 @@ static void build_memory_module(ModuleManager& module_manager,
                                 const e_config_protocol_type& sram_orgz_type,
                                 const std::string& module_name,
                                 const CircuitModelId& sram_model,
-                                const size_t& num_mems) {
+                                const size_t& num_mems,
+                                const size_t& memory_tile_size) {
   switch (sram_orgz_type) {
     case CONFIG_MEM_STANDALONE:
     case CONFIG_MEM_QL_MEMORY_BANK:
@@ -918,6 +1057,12 @@ static void build_memory_module(ModuleManager& module_manager,
                                   sram_model, num_mems);
       break;
     case CONFIG_MEM_SCAN_CHAIN:
+      if ((0 < memory_tile_size) && (memory_tile_size < num_mems)) {
+        build_memory_chain_module_from_tiles(module_manager, circuit_lib,
+                                             module_name, sram_model, num_mems,
+                                             memory_tile_size);
+        break;
+      }
       build_memory_chain_module(module_manager, circuit_lib, module_name,
                                 sram_model, num_mems);
       break;
@@ -949,7 +1094,7 @@ static void build_mux_memory_module(
   ModuleManager& module_manager, DecoderLibrary& arch_decoder_lib,
   const CircuitLibrary& circuit_lib,
   const e_config_protocol_type& sram_orgz_type, const CircuitModelId& mux_model,
-  const MuxGraph& mux_graph) {
+  const MuxGraph& mux_graph, const size_t& memory_tile_size) {
   /* Find the actual number of configuration bits, based on the mux graph
    * Due to the use of local decoders inside mux, this may be
    */
@@ -973,7 +1118,7 @@ static void build_mux_memory_module(
 
       build_memory_module(module_manager, arch_decoder_lib, circuit_lib,
                           sram_orgz_type, module_name, sram_models[0],
-                          num_config_bits);
+                          num_config_bits, memory_tile_size);
       break;
     }
     case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -1005,13 +1150,19 @@ static void build_mux_memory_module(
  * memory modules.
  * Take another example, the memory circuit can implement the scan-chain or
  * memory-bank organization for the memories.
+ *
+ * For configuration chains, a non-zero memory_tile_size builds the memory
+ * modules which are longer than a tile from shared memory tiles, so that
+ * many distinct memory sizes share most of their modules and nets.
  ********************************************************************/
 void build_memory_modules(ModuleManager& module_manager,
                           DecoderLibrary& arch_decoder_lib,
                           const MuxLibrary& mux_lib,
                           const CircuitLibrary& circuit_lib,
-                          const e_config_protocol_type& sram_orgz_type) {
+                          const e_config_protocol_type& sram_orgz_type,
+                          const size_t& memory_tile_size) {
   vtr::ScopedStartFinishTimer timer("Build memory modules");
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the memory circuits for the multiplexer */
   for (auto mux : mux_lib.muxes()) {
@@ -1026,7 +1177,8 @@ void build_memory_modules(ModuleManager& module_manager,
     }
     /* Create a Verilog module for the memories used by the multiplexer */
     build_mux_memory_module(module_manager, arch_decoder_lib, circuit_lib,
-                            sram_orgz_type, mux_model, mux_graph);
+                            sram_orgz_type, mux_model, mux_graph,
+                            memory_tile_size);
   }
 
   /* Create the memory circuits for non-MUX circuit models.
@@ -1062,7 +1214,8 @@ void build_memory_modules(ModuleManager& module_manager,
 
     /* Create a Verilog module for the memories used by the circuit model */
     build_memory_module(module_manager, arch_decoder_lib, circuit_lib,
-                        sram_orgz_type, module_name, sram_models[0], num_mems);
+                        sram_orgz_type, module_name, sram_models[0], num_mems,
+                        memory_tile_size);
   }
 }
 
@@ -19,6 +19,7 @@
 #include "mux_utils.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -1684,17 +1685,17 @@ static void build_mux_module(ModuleManager& module_manager,
 void build_mux_modules(ModuleManager& module_manager, const MuxLibrary& mux_lib,
                        const CircuitLibrary& circuit_lib) {
   vtr::ScopedStartFinishTimer timer("Building multiplexer modules");
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Generate basis sub-circuit for unique branches shared by the multiplexers
    */
   for (auto mux : mux_lib.muxes()) {
-    const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
     CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux);
-    /* Create a mux graph for the branch circuit */
-    std::vector<MuxGraph> branch_mux_graphs =
-      mux_graph.build_mux_branch_graphs();
+    /* Get the mux graphs of the branch circuits */
+    const std::vector<MuxGraph>& branch_mux_graphs =
+      mux_lib.mux_branch_graphs(mux);
     /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes */
-    for (auto branch_mux_graph : branch_mux_graphs) {
+    for (const MuxGraph& branch_mux_graph : branch_mux_graphs) {
       build_mux_branch_module(module_manager, circuit_lib, mux_circuit_model,
                               branch_mux_graph);
     }
@@ -5,6 +5,7 @@
  * 1. Connection blocks
  * 2. Switch blocks
  *******************************************************************/
+#include <algorithm>
 #include <vector>
 
 /* Headers from vtrutil library */
@@ -22,6 +23,7 @@
 #include "openfpga_reserved_words.h"
 #include "openfpga_rr_graph_utils.h"
 #include "openfpga_side_manager.h"
+#include "openfpga_trace.h"
 #include "rr_gsb_utils.h"
 
 /* begin namespace openfpga */
@@ -993,34 +995,155 @@ static void build_connection_block_module(
 }
 
 /********************************************************************
- * Iterate over all the connection blocks in a device
- * and build a module for each of them
+ * Find the switch blocks and connection blocks whose modules should be
+ * built, in the order of building:
+ * 1. Switch blocks
+ * 2. X-direction connection blocks
+ * 3. Y-direction connection blocks
+ * When the routing hierarchy is compressed, only the unique modules
+ * are listed. Otherwise, each switch block and connection block in the
+ * device is listed.
  *******************************************************************/
-static void build_flatten_connection_block_modules(
+std::vector<RoutingModuleGsb> find_routing_module_gsbs(
+  const DeviceRRGSB& device_rr_gsb, const bool& compress_routing) {
+  std::vector<RoutingModuleGsb> gsbs;
+  std::vector<t_rr_type> cb_types = {CHANX, CHANY};
+
+  if (true == compress_routing) {
+    for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module();
+         ++isb) {
+      gsbs.push_back(
+        {&device_rr_gsb.get_sb_unique_module(isb), NUM_RR_TYPES});
+    }
+    for (const t_rr_type& cb_type : cb_types) {
+      for (size_t icb = 0;
+           icb < device_rr_gsb.get_num_cb_unique_module(cb_type); ++icb) {
+        gsbs.push_back(
+          {&device_rr_gsb.get_cb_unique_module(cb_type, icb), cb_type});
+      }
+    }
+    return gsbs;
+  }
+
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+      if (true == rr_gsb.is_sb_exist()) {
+        gsbs.push_back({&rr_gsb, NUM_RR_TYPES});
+      }
+    }
+  }
+  for (const t_rr_type& cb_type : cb_types) {
+    for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+      for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+        /* Check if the connection block exists in the device!
+         * Some of them do NOT exist due to heterogeneous blocks (height > 1)
+         * We will skip those modules
+         */
+        const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+        if (true == rr_gsb.is_cb_exist(cb_type)) {
+          gsbs.push_back({&rr_gsb, cb_type});
+        }
+      }
+    }
+  }
+  return gsbs;
+}
+
+/********************************************************************
+ * Estimate the cost of building the module of a switch block or a
+ * connection block by the number of routing nodes it connects, each of
+ * which results in a port and, for outputs, a routing multiplexer
+ *******************************************************************/
+static size_t estimate_routing_module_cost(const RoutingModuleGsb& gsb) {
+  const RRGSB& rr_gsb = *gsb.rr_gsb;
+  size_t cost = 0;
+  if (NUM_RR_TYPES == gsb.cb_type) {
+    for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+      SideManager side_manager(side);
+      cost += rr_gsb.get_chan_width(side_manager.get_side());
+      cost += rr_gsb.get_num_opin_nodes(side_manager.get_side());
+    }
+  } else {
+    cost += rr_gsb.get_cb_chan_width(gsb.cb_type);
+    for (const e_side& cb_ipin_side : rr_gsb.get_cb_ipin_sides(gsb.cb_type)) {
+      cost += rr_gsb.get_num_ipin_nodes(cb_ipin_side);
+    }
+  }
+  /* Count the module itself, so that an empty block is not free */
+  return cost + 1;
+}
+
+/********************************************************************
+ * Split the switch blocks and connection blocks found by
+ * find_routing_module_gsbs() into at most a given number of contiguous
+ * chunks of similar cost, so that the chunks can be built in parallel
+ * and still be merged in order. The module sizes differ a lot across
+ * the device, e.g., between the borders and the core, so the chunks
+ * are balanced by the estimated cost rather than by the number of blocks.
+ * Return the boundaries of the chunks, where chunk i covers
+ * [boundaries[i], boundaries[i + 1])
+ *******************************************************************/
+std::vector<size_t> find_routing_module_gsb_chunks(
+  const std::vector<RoutingModuleGsb>& gsbs, const size_t& num_chunks) {
+  std::vector<size_t> costs;
+  costs.reserve(gsbs.size());
+  size_t total_cost = 0;
+  for (const RoutingModuleGsb& gsb : gsbs) {
+    costs.push_back(estimate_routing_module_cost(gsb));
+    total_cost += costs.back();
+  }
+
+  std::vector<size_t> boundaries(1, 0);
+  size_t chunk_count = std::max(size_t(1), num_chunks);
+  /* Cost of the blocks which are not in the closed chunks */
+  size_t remaining_cost = total_cost;
+  size_t chunk_cost = 0;
+  for (size_t igsb = 0; igsb < gsbs.size(); ++igsb) {
+    chunk_cost += costs[igsb];
+    /* Close the chunk once it reaches its share of the remaining cost */
+    size_t num_remaining_chunks = chunk_count - (boundaries.size() - 1);
+    if ((1 < num_remaining_chunks) &&
+        (chunk_cost * num_remaining_chunks >= remaining_cost)) {
+      boundaries.push_back(igsb + 1);
+      remaining_cost -= chunk_cost;
+      chunk_cost = 0;
+    }
+  }
+  if (boundaries.back() != gsbs.size()) {
+    boundaries.push_back(gsbs.size());
+  }
+  return boundaries;
+}
+
+/********************************************************************
+ * Build the modules of a range [first, last) of the switch blocks and
+ * connection blocks found by find_routing_module_gsbs()
+ * The ranges can be built independently, e.g., in staging module managers
+ *******************************************************************/
+void build_routing_module_list(
   ModuleManager& module_manager, DecoderLibrary& decoder_lib,
   const DeviceContext& device_ctx, const VprDeviceAnnotation& device_annotation,
-  const DeviceRRGSB& device_rr_gsb, const CircuitLibrary& circuit_lib,
+  const CircuitLibrary& circuit_lib,
   const e_config_protocol_type& sram_orgz_type,
-  const CircuitModelId& sram_model, const t_rr_type& cb_type,
+  const CircuitModelId& sram_model, const std::vector<RoutingModuleGsb>& gsbs,
+  const size_t& first, const size_t& last, ScopedProgress& progress,
   const bool& verbose) {
-  /* Build unique X-direction connection block modules */
-  vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
-
-  for (size_t ix = 0; ix < cb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < cb_range.y(); ++iy) {
-      /* Check if the connection block exists in the device!
-       * Some of them do NOT exist due to heterogeneous blocks (height > 1)
-       * We will skip those modules
-       */
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      if (false == rr_gsb.is_cb_exist(cb_type)) {
-        continue;
-      }
+  VTR_ASSERT(first <= last && last <= gsbs.size());
+  for (size_t igsb = first; igsb < last; ++igsb) {
+    if (NUM_RR_TYPES == gsbs[igsb].cb_type) {
+      build_switch_block_module(module_manager, decoder_lib, device_annotation,
+                                device_ctx.grid, device_ctx.rr_graph,
+                                circuit_lib, sram_orgz_type, sram_model,
+                                *gsbs[igsb].rr_gsb, verbose);
+    } else {
       build_connection_block_module(
         module_manager, decoder_lib, device_annotation, device_ctx.grid,
-        device_ctx.rr_graph, circuit_lib, sram_orgz_type, sram_model, rr_gsb,
-        cb_type, verbose);
+        device_ctx.rr_graph, circuit_lib, sram_orgz_type, sram_model,
+        *gsbs[igsb].rr_gsb, gsbs[igsb].cb_type, verbose);
     }
+    progress.advance();
   }
 }
 
@@ -1040,30 +1163,14 @@ void build_flatten_routing_modules(
   const e_config_protocol_type& sram_orgz_type,
   const CircuitModelId& sram_model, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build routing modules...");
-
-  vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
-
-  /* Build unique switch block modules */
-  for (size_t ix = 0; ix < sb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < sb_range.y(); ++iy) {
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      if (false == rr_gsb.is_sb_exist()) {
-        continue;
-      }
-      build_switch_block_module(module_manager, decoder_lib, device_annotation,
-                                device_ctx.grid, device_ctx.rr_graph,
-                                circuit_lib, sram_orgz_type, sram_model, rr_gsb,
-                                verbose);
-    }
-  }
-
-  build_flatten_connection_block_modules(
-    module_manager, decoder_lib, device_ctx, device_annotation, device_rr_gsb,
-    circuit_lib, sram_orgz_type, sram_model, CHANX, verbose);
-
-  build_flatten_connection_block_modules(
-    module_manager, decoder_lib, device_ctx, device_annotation, device_rr_gsb,
-    circuit_lib, sram_orgz_type, sram_model, CHANY, verbose);
+  OPENFPGA_TRACE_FUNCTION();
+
+  std::vector<RoutingModuleGsb> gsbs =
+    find_routing_module_gsbs(device_rr_gsb, false);
+  ScopedProgress progress("Build routing modules", "GSBs", gsbs.size());
+  build_routing_module_list(
+    module_manager, decoder_lib, device_ctx, device_annotation, circuit_lib,
+    sram_orgz_type, sram_model, gsbs, 0, gsbs.size(), progress, verbose);
 }
 
 /********************************************************************
@@ -1084,37 +1191,15 @@ void build_unique_routing_modules(
   const e_config_protocol_type& sram_orgz_type,
   const CircuitModelId& sram_model, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build unique routing modules...");
-
-  /* Build unique switch block modules */
-  for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    build_switch_block_module(module_manager, decoder_lib, device_annotation,
-                              device_ctx.grid, device_ctx.rr_graph, circuit_lib,
-                              sram_orgz_type, sram_model, unique_mirror,
-                              verbose);
-  }
-
-  /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX);
-       ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    build_connection_block_module(
-      module_manager, decoder_lib, device_annotation, device_ctx.grid,
-      device_ctx.rr_graph, circuit_lib, sram_orgz_type, sram_model,
-      unique_mirror, CHANX, verbose);
-  }
-
-  /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY);
-       ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    build_connection_block_module(
-      module_manager, decoder_lib, device_annotation, device_ctx.grid,
-      device_ctx.rr_graph, circuit_lib, sram_orgz_type, sram_model,
-      unique_mirror, CHANY, verbose);
-  }
+  OPENFPGA_TRACE_FUNCTION();
+
+  std::vector<RoutingModuleGsb> gsbs =
+    find_routing_module_gsbs(device_rr_gsb, true);
+  ScopedProgress progress("Build unique routing modules", "GSBs",
+                          gsbs.size());
+  build_routing_module_list(
+    module_manager, decoder_lib, device_ctx, device_annotation, circuit_lib,
+    sram_orgz_type, sram_model, gsbs, 0, gsbs.size(), progress, verbose);
 }
 
 } /* end namespace openfpga */
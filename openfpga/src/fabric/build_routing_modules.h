@@ -4,11 +4,14 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <vector>
+
 #include "circuit_library.h"
 #include "decoder_library.h"
 #include "device_rr_gsb.h"
 #include "module_manager.h"
 #include "mux_library.h"
+#include "openfpga_progress.h"
 #include "vpr_context.h"
 #include "vpr_device_annotation.h"
 
@@ -19,6 +22,28 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* A switch block or a connection block whose module is to be built */
+struct RoutingModuleGsb {
+  const RRGSB* rr_gsb;
+  /* CHANX or CHANY for a connection block, NUM_RR_TYPES for a switch block */
+  t_rr_type cb_type;
+};
+
+std::vector<RoutingModuleGsb> find_routing_module_gsbs(
+  const DeviceRRGSB& device_rr_gsb, const bool& compress_routing);
+
+std::vector<size_t> find_routing_module_gsb_chunks(
+  const std::vector<RoutingModuleGsb>& gsbs, const size_t& num_chunks);
+
+void build_routing_module_list(
+  ModuleManager& module_manager, DecoderLibrary& decoder_lib,
+  const DeviceContext& device_ctx, const VprDeviceAnnotation& device_annotation,
+  const CircuitLibrary& circuit_lib,
+  const e_config_protocol_type& sram_orgz_type,
+  const CircuitModelId& sram_model, const std::vector<RoutingModuleGsb>& gsbs,
+  const size_t& first, const size_t& last, ScopedProgress& progress,
+  const bool& verbose);
+
 void build_flatten_routing_modules(
   ModuleManager& module_manager, DecoderLibrary& decoder_lib,
   const DeviceContext& device_ctx, const VprDeviceAnnotation& device_annotation,
@@ -3,6 +3,7 @@
  * module for the FPGA fabric in Verilog format
  *******************************************************************/
 #include <algorithm>
+#include <functional>
 #include <map>
 
 /* Headers from vtrutil library */
@@ -10,6 +11,9 @@
 #include "vtr_log.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_trace.h"
+
 /* Headers from vpr library */
 #include "vpr_utils.h"
 
@@ -32,12 +36,51 @@
 namespace openfpga {
 
 /********************************************************************
- * Add a instance of a grid module to the top module
+ * A function which either adds an instance of a child module with a
+ * given name to the top module, or finds the instance with the name
+ * in the top module, and returns the instance id
  *******************************************************************/
-static size_t add_top_module_grid_instance(
-  ModuleManager& module_manager, const ModuleId& top_module,
-  t_physical_tile_type_ptr grid_type, const e_side& border_side,
-  const vtr::Point<size_t>& grid_coord) {
+typedef std::function<size_t(const ModuleId&, const std::string&)>
+  TopModuleInstanceVisitor;
+
+/********************************************************************
+ * Add an instance of a child module to the top module
+ *******************************************************************/
+static size_t add_top_module_child_instance(ModuleManager& module_manager,
+                                            const ModuleId& top_module,
+                                            const ModuleId& child_module,
+                                            const std::string& instance_name) {
+  /* Record the instance id */
+  size_t instance = module_manager.num_instance(top_module, child_module);
+  /* Add the module to top_module */
+  module_manager.add_child_module(top_module, child_module, false);
+  /* Set an unique name to the instance
+   * Note: it is your risk to gurantee the name is unique!
+   */
+  module_manager.set_child_instance_name(top_module, child_module, instance,
+                                         instance_name);
+  return instance;
+}
+
+/********************************************************************
+ * Find an instance of a child module in the top module by its name
+ *******************************************************************/
+static size_t find_top_module_child_instance(
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleId& child_module, const std::string& instance_name) {
+  size_t instance =
+    module_manager.instance_id(top_module, child_module, instance_name);
+  VTR_ASSERT(size_t(-1) != instance);
+  return instance;
+}
+
+/********************************************************************
+ * Visit an instance of a grid module in the top module
+ *******************************************************************/
+static size_t visit_top_module_grid_instance(
+  const ModuleManager& module_manager, t_physical_tile_type_ptr grid_type,
+  const e_side& border_side, const vtr::Point<size_t>& grid_coord,
+  const TopModuleInstanceVisitor& visitor) {
   /* Find the module name for this type of grid */
   std::string grid_module_name_prefix(GRID_MODULE_NAME_PREFIX);
   std::string grid_module_name = generate_grid_block_module_name(
@@ -45,31 +88,21 @@ static size_t add_top_module_grid_instance(
     is_io_type(grid_type), border_side);
   ModuleId grid_module = module_manager.find_module(grid_module_name);
   VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
-  /* Record the instance id */
-  size_t grid_instance = module_manager.num_instance(top_module, grid_module);
-  /* Add the module to top_module */
-  module_manager.add_child_module(top_module, grid_module, false);
-  /* Set an unique name to the instance
-   * Note: it is your risk to gurantee the name is unique!
-   */
   std::string instance_name = generate_grid_block_instance_name(
     grid_module_name_prefix, std::string(grid_type->name),
     is_io_type(grid_type), border_side, grid_coord);
-  module_manager.set_child_instance_name(top_module, grid_module, grid_instance,
-                                         instance_name);
-
-  return grid_instance;
+  return visitor(grid_module, instance_name);
 }
 
 /********************************************************************
- * Add all the grids as sub-modules across the fabric
+ * Visit all the grids as sub-modules across the fabric
  * The grid modules are created for each unique type of grid (based
  * on the type in data structure data_structure
  * Here, we will iterate over the full fabric (coordinates)
  * and instanciate the grid modules
  *
  * Return an 2-D array of instance ids of the grid modules that
- * have been added
+ * have been visited
  *
  * This function assumes an island-style floorplanning for FPGA fabric
  *
@@ -92,11 +125,9 @@ static size_t add_top_module_grid_instance(
  *                +-----------------------------------+
  *
  *******************************************************************/
-static vtr::Matrix<size_t> add_top_module_grid_instances(
-  ModuleManager& module_manager, const ModuleId& top_module,
-  const DeviceGrid& grids) {
-  vtr::ScopedStartFinishTimer timer("Add grid instances to top module");
-
+static vtr::Matrix<size_t> visit_top_module_grid_instances(
+  const ModuleManager& module_manager, const DeviceGrid& grids,
+  const TopModuleInstanceVisitor& visitor) {
   /* Reserve an array for the instance ids */
   vtr::Matrix<size_t> grid_instance_ids({grids.width(), grids.height()});
   grid_instance_ids.fill(size_t(-1));
@@ -133,10 +164,9 @@ static vtr::Matrix<size_t> add_top_module_grid_instances(
 
       /* Add a grid module to top_module*/
       grid_instance_ids[io_coordinate.x()][io_coordinate.y()] =
-        add_top_module_grid_instance(
-          module_manager, top_module,
-          grids[io_coordinate.x()][io_coordinate.y()].type, io_side,
-          io_coordinate);
+        visit_top_module_grid_instance(
+          module_manager, grids[io_coordinate.x()][io_coordinate.y()].type,
+          io_side, io_coordinate, visitor);
     }
   }
 
@@ -168,8 +198,8 @@ static vtr::Matrix<size_t> add_top_module_grid_instances(
       }
       /* Add a grid module to top_module*/
       vtr::Point<size_t> grid_coord(ix, iy);
-      grid_instance_ids[ix][iy] = add_top_module_grid_instance(
-        module_manager, top_module, grids[ix][iy].type, NUM_SIDES, grid_coord);
+      grid_instance_ids[ix][iy] = visit_top_module_grid_instance(
+        module_manager, grids[ix][iy].type, NUM_SIDES, grid_coord, visitor);
     }
   }
 
@@ -177,15 +207,14 @@ static vtr::Matrix<size_t> add_top_module_grid_instances(
 }
 
 /********************************************************************
- * Add switch blocks across the FPGA fabric to the top-level module
+ * Visit switch blocks across the FPGA fabric in the top-level module
  * Return an 2-D array of instance ids of the switch blocks that
- * have been added
+ * have been visited
  *******************************************************************/
-static vtr::Matrix<size_t> add_top_module_switch_block_instances(
-  ModuleManager& module_manager, const ModuleId& top_module,
-  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy) {
-  vtr::ScopedStartFinishTimer timer("Add switch block instances to top module");
-
+static vtr::Matrix<size_t> visit_top_module_switch_block_instances(
+  const ModuleManager& module_manager, const DeviceRRGSB& device_rr_gsb,
+  const bool& compact_routing_hierarchy,
+  const TopModuleInstanceVisitor& visitor) {
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
   /* Reserve an array for the instance ids */
@@ -216,17 +245,9 @@ static vtr::Matrix<size_t> add_top_module_switch_block_instances(
       VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
       /* Record the instance id */
       sb_instance_ids[rr_gsb.get_sb_x()][rr_gsb.get_sb_y()] =
-        module_manager.num_instance(top_module, sb_module);
-      /* Add the module to top_module */
-      module_manager.add_child_module(top_module, sb_module, false);
-      /* Set an unique name to the instance
-       * Note: it is your risk to gurantee the name is unique!
-       */
-      module_manager.set_child_instance_name(
-        top_module, sb_module,
-        sb_instance_ids[rr_gsb.get_sb_x()][rr_gsb.get_sb_y()],
-        generate_switch_block_module_name(
-          vtr::Point<size_t>(rr_gsb.get_sb_x(), rr_gsb.get_sb_y())));
+        visitor(sb_module,
+                generate_switch_block_module_name(
+                  vtr::Point<size_t>(rr_gsb.get_sb_x(), rr_gsb.get_sb_y())));
     }
   }
 
@@ -234,15 +255,14 @@ static vtr::Matrix<size_t> add_top_module_switch_block_instances(
 }
 
 /********************************************************************
- * Add switch blocks across the FPGA fabric to the top-level module
+ * Visit connection blocks across the FPGA fabric in the top-level module
+ * Return an 2-D array of instance ids of the connection blocks that
+ * have been visited
  *******************************************************************/
-static vtr::Matrix<size_t> add_top_module_connection_block_instances(
-  ModuleManager& module_manager, const ModuleId& top_module,
-  const DeviceRRGSB& device_rr_gsb, const t_rr_type& cb_type,
-  const bool& compact_routing_hierarchy) {
-  vtr::ScopedStartFinishTimer timer(
-    "Add connection block instances to top module");
-
+static vtr::Matrix<size_t> visit_top_module_connection_block_instances(
+  const ModuleManager& module_manager, const DeviceRRGSB& device_rr_gsb,
+  const t_rr_type& cb_type, const bool& compact_routing_hierarchy,
+  const TopModuleInstanceVisitor& visitor) {
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
   /* Reserve an array for the instance ids */
@@ -275,27 +295,104 @@ static vtr::Matrix<size_t> add_top_module_connection_block_instances(
         generate_connection_block_module_name(cb_type, cb_coordinate);
       ModuleId cb_module = module_manager.find_module(cb_module_name);
       VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
-      /* Record the instance id */
-      cb_instance_ids[rr_gsb.get_cb_x(cb_type)][rr_gsb.get_cb_y(cb_type)] =
-        module_manager.num_instance(top_module, cb_module);
-      /* Add the module to top_module */
-      module_manager.add_child_module(top_module, cb_module, false);
-      /* Set an unique name to the instance
-       * Note: it is your risk to gurantee the name is unique!
-       */
       std::string cb_instance_name = generate_connection_block_module_name(
         cb_type,
         vtr::Point<size_t>(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type)));
-      module_manager.set_child_instance_name(
-        top_module, cb_module,
-        cb_instance_ids[rr_gsb.get_cb_x(cb_type)][rr_gsb.get_cb_y(cb_type)],
-        cb_instance_name);
+      /* Record the instance id */
+      cb_instance_ids[rr_gsb.get_cb_x(cb_type)][rr_gsb.get_cb_y(cb_type)] =
+        visitor(cb_module, cb_instance_name);
     }
   }
 
   return cb_instance_ids;
 }
 
+/********************************************************************
+ * Add all the grids as sub-modules across the fabric
+ * Return an 2-D array of instance ids of the grid modules that
+ * have been added
+ *******************************************************************/
+static vtr::Matrix<size_t> add_top_module_grid_instances(
+  ModuleManager& module_manager, const ModuleId& top_module,
+  const DeviceGrid& grids) {
+  vtr::ScopedStartFinishTimer timer("Add grid instances to top module");
+  OPENFPGA_TRACE_FUNCTION();
+
+  return visit_top_module_grid_instances(
+    module_manager, grids,
+    [&](const ModuleId& child_module, const std::string& instance_name) {
+      return add_top_module_child_instance(module_manager, top_module,
+                                           child_module, instance_name);
+    });
+}
+
+/********************************************************************
+ * Add switch blocks across the FPGA fabric to the top-level module
+ * Return an 2-D array of instance ids of the switch blocks that
+ * have been added
+ *******************************************************************/
+static vtr::Matrix<size_t> add_top_module_switch_block_instances(
+  ModuleManager& module_manager, const ModuleId& top_module,
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy) {
+  vtr::ScopedStartFinishTimer timer("Add switch block instances to top module");
+  OPENFPGA_TRACE_FUNCTION();
+
+  return visit_top_module_switch_block_instances(
+    module_manager, device_rr_gsb, compact_routing_hierarchy,
+    [&](const ModuleId& child_module, const std::string& instance_name) {
+      return add_top_module_child_instance(module_manager, top_module,
+                                           child_module, instance_name);
+    });
+}
+
+/********************************************************************
+ * Add connection blocks across the FPGA fabric to the top-level module
+ *******************************************************************/
+static vtr::Matrix<size_t> add_top_module_connection_block_instances(
+  ModuleManager& module_manager, const ModuleId& top_module,
+  const DeviceRRGSB& device_rr_gsb, const t_rr_type& cb_type,
+  const bool& compact_routing_hierarchy) {
+  vtr::ScopedStartFinishTimer timer(
+    "Add connection block instances to top module");
+  OPENFPGA_TRACE_FUNCTION();
+
+  return visit_top_module_connection_block_instances(
+    module_manager, device_rr_gsb, cb_type, compact_routing_hierarchy,
+    [&](const ModuleId& child_module, const std::string& instance_name) {
+      return add_top_module_child_instance(module_manager, top_module,
+                                           child_module, instance_name);
+    });
+}
+
+/********************************************************************
+ * Find the instance ids of the grids, switch blocks and connection
+ * blocks in the top-level module, which are the same as the ones
+ * returned when the instances are added by build_top_module().
+ * This is required to find the connections of the GSBs when the nets
+ * are not stored in the top-level module
+ *******************************************************************/
+void find_top_module_instance_ids(
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const DeviceGrid& grids, const DeviceRRGSB& device_rr_gsb,
+  const bool& compact_routing_hierarchy,
+  vtr::Matrix<size_t>& grid_instance_ids,
+  vtr::Matrix<size_t>& sb_instance_ids,
+  std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids) {
+  TopModuleInstanceVisitor visitor = [&](const ModuleId& child_module,
+                                         const std::string& instance_name) {
+    return find_top_module_child_instance(module_manager, top_module,
+                                          child_module, instance_name);
+  };
+  grid_instance_ids =
+    visit_top_module_grid_instances(module_manager, grids, visitor);
+  sb_instance_ids = visit_top_module_switch_block_instances(
+    module_manager, device_rr_gsb, compact_routing_hierarchy, visitor);
+  cb_instance_ids[CHANX] = visit_top_module_connection_block_instances(
+    module_manager, device_rr_gsb, CHANX, compact_routing_hierarchy, visitor);
+  cb_instance_ids[CHANY] = visit_top_module_connection_block_instances(
+    module_manager, device_rr_gsb, CHANY, compact_routing_hierarchy, visitor);
+}
+
 /********************************************************************
  * Add the I/O children to the top-level module, which impacts the I/O indexing
  * This is the default function to build the I/O sequence/indexing
@@ -417,6 +514,31 @@ static void add_top_module_io_children(
   }
 }
 
+/********************************************************************
+ * Estimate the number of nets and net sinks to connect the grids,
+ * the routing blocks and the inter-tile direct connections in the
+ * top-level module, and reserve the storage in advance, so that the
+ * arrays of nets are not reallocated while the nets are added.
+ * Each direct connection adds two nets of one sink each, respectively
+ * from the source grid pin and to the sink grid pin.
+ * The nets of the GSBs are not counted when they are deferred
+ *******************************************************************/
+static TopModuleNetCount estimate_top_module_num_connection_nets(
+  ModuleManager& module_manager, const ModuleId& top_module,
+  const DeviceRRGSB& device_rr_gsb, const TileDirect& tile_direct,
+  const bool& defer_gsb_nets) {
+  TopModuleNetCount net_count = {0, 0};
+  if (false == defer_gsb_nets) {
+    net_count = estimate_top_module_num_gsb_nets(device_rr_gsb);
+  }
+  net_count.num_nets += 2 * tile_direct.directs().size();
+  net_count.num_sinks += 2 * tile_direct.directs().size();
+
+  module_manager.reserve_module_nets(top_module, net_count.num_nets);
+
+  return net_count;
+}
+
 /********************************************************************
  * Print the top-level module for the FPGA fabric in Verilog format
  * This function will
@@ -437,9 +559,14 @@ int build_top_module(
   const DeviceRRGSB& device_rr_gsb, const TileDirect& tile_direct,
   const ArchDirect& arch_direct, const ConfigProtocol& config_protocol,
   const CircuitModelId& sram_model, const bool& frame_view,
+  const bool& bitstream_only, const bool& defer_gsb_nets,
   const bool& compact_routing_hierarchy, const bool& duplicate_grid_pin,
-  const FabricKey& fabric_key, const bool& generate_random_fabric_key) {
+  const FabricKey& fabric_key,
+  const bool& generate_random_fabric_key,
+  const bool& generate_locality_fabric_key, const bool& balance_config_regions,
+  const size_t& max_shift_register_bank_size, const size_t& num_threads) {
   vtr::ScopedStartFinishTimer timer("Build FPGA fabric module");
+  OPENFPGA_TRACE_FUNCTION();
 
   int status = CMD_EXEC_SUCCESS;
 
@@ -474,20 +601,35 @@ int build_top_module(
 
   /* Add nets when we need a complete fabric modeling,
    * which is required by downstream functions
+   * The bitstream generation only requires the configurable children and
+   * the nets of the configuration bus, so these nets are skipped when
+   * building the fabric for bitstream generation only
    */
-  if (false == frame_view) {
+  if ((false == frame_view) && (false == bitstream_only)) {
     /* Reserve nets to be memory efficient */
-    reserve_module_manager_module_nets(module_manager, top_module);
-
-    /* Add module nets to connect the sub modules */
-    add_top_module_nets_connect_grids_and_gsbs(
-      module_manager, top_module, vpr_device_annotation, grids,
-      grid_instance_ids, rr_graph, device_rr_gsb, sb_instance_ids,
-      cb_instance_ids, compact_routing_hierarchy, duplicate_grid_pin);
+    TopModuleNetCount net_count = estimate_top_module_num_connection_nets(
+      module_manager, top_module, device_rr_gsb, tile_direct, defer_gsb_nets);
+
+    /* Add module nets to connect the sub modules. When deferred, the
+     * connections are found again by the netlist writers */
+    if (false == defer_gsb_nets) {
+      add_top_module_nets_connect_grids_and_gsbs(
+        module_manager, top_module, vpr_device_annotation, grids,
+        grid_instance_ids, rr_graph, device_rr_gsb, sb_instance_ids,
+        cb_instance_ids, compact_routing_hierarchy, duplicate_grid_pin,
+        num_threads);
+    }
     /* Add inter-CLB direct connections */
     add_top_module_nets_tile_direct_connections(
       module_manager, top_module, circuit_lib, vpr_device_annotation, grids,
       grid_instance_ids, tile_direct, arch_direct);
+
+    VTR_LOG(
+      "Reserved %lu nets for %lu estimated net sinks in the top module, while "
+      "%lu nets and %lu net sinks are added\n",
+      net_count.num_nets, net_count.num_sinks,
+      module_manager.num_nets(top_module),
+      module_manager.num_net_sinks(top_module));
   }
 
   /* Add global ports from grid ports that are defined as global in tile
@@ -513,7 +655,7 @@ int build_top_module(
     organize_top_module_memory_modules(
       module_manager, top_module, circuit_lib, config_protocol, sram_model,
       grids, grid_instance_ids, device_rr_gsb, sb_instance_ids, cb_instance_ids,
-      compact_routing_hierarchy);
+      compact_routing_hierarchy, balance_config_regions);
   } else {
     VTR_ASSERT_SAFE(false == fabric_key.empty());
     /* Throw a fatal error when the fabric key has a mismatch in region
@@ -542,13 +684,21 @@ int build_top_module(
 
   /* Shuffle the configurable children in a random sequence */
   if (true == generate_random_fabric_key) {
-    shuffle_top_module_configurable_children(module_manager, top_module,
-                                             config_protocol);
+    shuffle_top_module_configurable_children(
+      module_manager, top_module, circuit_lib, sram_model, config_protocol,
+      balance_config_regions);
+  }
+
+  /* Order the configurable children along a space-filling curve */
+  if (true == generate_locality_fabric_key) {
+    sort_top_module_configurable_children_by_location(module_manager,
+                                                      top_module);
   }
 
   /* Build shift register bank detailed connections */
   sync_memory_bank_shift_register_banks_with_config_protocol_settings(
-    module_manager, blwl_sr_banks, config_protocol, top_module, circuit_lib);
+    module_manager, blwl_sr_banks, config_protocol, top_module, circuit_lib,
+    max_shift_register_bank_size);
 
   /* Add shared SRAM ports from the sub-modules under this Verilog module
    * This is a much easier job after adding sub modules (instances),
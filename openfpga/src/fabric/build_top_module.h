@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 
+#include <map>
 #include <string>
 
 #include "arch_direct.h"
@@ -38,8 +39,19 @@ int build_top_module(
   const DeviceRRGSB& device_rr_gsb, const TileDirect& tile_direct,
   const ArchDirect& arch_direct, const ConfigProtocol& config_protocol,
   const CircuitModelId& sram_model, const bool& frame_view,
+  const bool& bitstream_only, const bool& defer_gsb_nets,
   const bool& compact_routing_hierarchy, const bool& duplicate_grid_pin,
-  const FabricKey& fabric_key, const bool& generate_random_fabric_key);
+  const FabricKey& fabric_key, const bool& generate_random_fabric_key,
+  const bool& generate_locality_fabric_key, const bool& balance_config_regions,
+  const size_t& max_shift_register_bank_size, const size_t& num_threads);
+
+void find_top_module_instance_ids(
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const DeviceGrid& grids, const DeviceRRGSB& device_rr_gsb,
+  const bool& compact_routing_hierarchy,
+  vtr::Matrix<size_t>& grid_instance_ids,
+  vtr::Matrix<size_t>& sb_instance_ids,
+  std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids);
 
 } /* end namespace openfpga */
 
@@ -2,6 +2,10 @@
  * This file include most utilized functions for building connections
  * inside the module graph for FPGA fabric
  *******************************************************************/
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_time.h"
@@ -10,7 +14,9 @@
 #include "command_exit_codes.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
 #include "openfpga_side_manager.h"
+#include "openfpga_trace.h"
 
 /* Headers from vpr library */
 #include "build_routing_module_utils.h"
@@ -30,11 +36,11 @@
 namespace openfpga {
 
 /********************************************************************
- * Add module nets to connect a GSB to adjacent grid ports/pins
+ * Enumerate the connections of the GSBs to adjacent grid ports/pins
  * as well as connection blocks
- * This function will create nets for the following types of connections
+ * This function will find the following types of connections
  * between grid output pins of Switch block and adjacent grids
- * In this case, the net source is the grid pin, while the net sink
+ * In this case, the source is the grid pin, while the sink
  * is the switch block pin
  *
  *    +------------+                +------------+
@@ -62,7 +68,8 @@ namespace openfpga {
  *
  *******************************************************************/
 static void add_top_module_nets_connect_grids_and_sb(
-  ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleManager& module_manager,
+  std::vector<TopModulePinConnection>& connections,
   const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
   const vtr::Matrix<size_t>& grid_instance_ids, const RRGraphView& rr_graph,
   const DeviceRRGSB& device_rr_gsb, const RRGSB& rr_gsb,
@@ -174,15 +181,12 @@ static void add_top_module_nets_connect_grids_and_sb(
       /* Source and sink port should match in size */
       VTR_ASSERT(src_grid_port.get_width() == sink_sb_port.get_width());
 
-      /* Create a net for each pin */
+      /* Connect each pin */
       for (size_t pin_id = 0; pin_id < src_grid_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, src_grid_module, src_grid_instance,
-          src_grid_port_id, src_grid_port.pins()[pin_id]);
-        /* Configure the net sink */
-        module_manager.add_module_net_sink(top_module, net, sink_sb_module,
-                                           sink_sb_instance, sink_sb_port_id,
-                                           sink_sb_port.pins()[pin_id]);
+        connections.push_back(
+          {src_grid_module, src_grid_instance, src_grid_port_id,
+           src_grid_port.pins()[pin_id], sink_sb_module, sink_sb_instance,
+           sink_sb_port_id, sink_sb_port.pins()[pin_id]});
       }
     }
   }
@@ -225,7 +229,8 @@ static void add_top_module_nets_connect_grids_and_sb(
  *
  *******************************************************************/
 static void add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(
-  ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleManager& module_manager,
+  std::vector<TopModulePinConnection>& connections,
   const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
   const vtr::Matrix<size_t>& grid_instance_ids, const RRGraphView& rr_graph,
   const DeviceRRGSB& device_rr_gsb, const RRGSB& rr_gsb,
@@ -365,15 +370,12 @@ static void add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(
       /* Source and sink port should match in size */
       VTR_ASSERT(src_grid_port.get_width() == sink_sb_port.get_width());
 
-      /* Create a net for each pin */
+      /* Connect each pin */
       for (size_t pin_id = 0; pin_id < src_grid_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, src_grid_module, src_grid_instance,
-          src_grid_port_id, src_grid_port.pins()[pin_id]);
-        /* Configure the net sink */
-        module_manager.add_module_net_sink(top_module, net, sink_sb_module,
-                                           sink_sb_instance, sink_sb_port_id,
-                                           sink_sb_port.pins()[pin_id]);
+        connections.push_back(
+          {src_grid_module, src_grid_instance, src_grid_port_id,
+           src_grid_port.pins()[pin_id], sink_sb_module, sink_sb_instance,
+           sink_sb_port_id, sink_sb_port.pins()[pin_id]});
       }
     }
   }
@@ -435,7 +437,8 @@ static void add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(
  *
  *******************************************************************/
 static void add_top_module_nets_connect_grids_and_cb(
-  ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleManager& module_manager,
+  std::vector<TopModulePinConnection>& connections,
   const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
   const vtr::Matrix<size_t>& grid_instance_ids, const RRGraphView& rr_graph,
   const DeviceRRGSB& device_rr_gsb, const RRGSB& rr_gsb,
@@ -548,15 +551,12 @@ static void add_top_module_nets_connect_grids_and_cb(
       /* Source and sink port should match in size */
       VTR_ASSERT(src_cb_port.get_width() == sink_grid_port.get_width());
 
-      /* Create a net for each pin */
+      /* Connect each pin */
       for (size_t pin_id = 0; pin_id < src_cb_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, src_cb_module, src_cb_instance,
-          src_cb_port_id, src_cb_port.pins()[pin_id]);
-        /* Configure the net sink */
-        module_manager.add_module_net_sink(
-          top_module, net, sink_grid_module, sink_grid_instance,
-          sink_grid_port_id, sink_grid_port.pins()[pin_id]);
+        connections.push_back(
+          {src_cb_module, src_cb_instance, src_cb_port_id,
+           src_cb_port.pins()[pin_id], sink_grid_module, sink_grid_instance,
+           sink_grid_port_id, sink_grid_port.pins()[pin_id]});
       }
     }
   }
@@ -602,7 +602,8 @@ static void add_top_module_nets_connect_grids_and_cb(
  *
  *******************************************************************/
 static void add_top_module_nets_connect_sb_and_cb(
-  ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleManager& module_manager,
+  std::vector<TopModulePinConnection>& connections,
   const RRGraphView& rr_graph, const DeviceRRGSB& device_rr_gsb,
   const RRGSB& rr_gsb, const vtr::Matrix<size_t>& sb_instance_ids,
   const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
@@ -748,24 +749,79 @@ static void add_top_module_nets_connect_sb_and_cb(
        */
       if (OUT_PORT ==
           module_sb.get_chan_node_direction(side_manager.get_side(), itrack)) {
-        ModuleNetId net =
-          create_module_source_pin_net(module_manager, top_module, sb_module_id,
-                                       sb_instance, sb_port_id, itrack / 2);
-        module_manager.add_module_net_sink(top_module, net, cb_module_id,
-                                           cb_instance, cb_port_id, itrack / 2);
+        connections.push_back({sb_module_id, sb_instance, sb_port_id,
+                               itrack / 2, cb_module_id, cb_instance,
+                               cb_port_id, itrack / 2});
       } else {
         VTR_ASSERT(IN_PORT == module_sb.get_chan_node_direction(
                                 side_manager.get_side(), itrack));
-        ModuleNetId net =
-          create_module_source_pin_net(module_manager, top_module, cb_module_id,
-                                       cb_instance, cb_port_id, itrack / 2);
-        module_manager.add_module_net_sink(top_module, net, sb_module_id,
-                                           sb_instance, sb_port_id, itrack / 2);
+        connections.push_back({cb_module_id, cb_instance, cb_port_id,
+                               itrack / 2, sb_module_id, sb_instance,
+                               sb_port_id, itrack / 2});
       }
     }
   }
 }
 
+/********************************************************************
+ * Estimate the number of module nets and net sinks which are added by
+ * add_top_module_nets_connect_grids_and_gsbs(), by counting the grid pins
+ * and the routing tracks of each GSB.
+ * Each connection adds a sink to at most one new net, so the estimation
+ * is an upper bound, which is only exceeded on the nets when a grid
+ * output pin drives the switch blocks of several GSBs
+ *******************************************************************/
+TopModuleNetCount estimate_top_module_num_gsb_nets(
+  const DeviceRRGSB& device_rr_gsb) {
+  TopModuleNetCount net_count = {0, 0};
+
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+
+      /* Connection block outputs to grid input pins */
+      for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+        if ((false == rr_gsb.is_cb_exist(cb_type)) ||
+            (true ==
+             connection_block_contain_only_routing_tracks(rr_gsb, cb_type))) {
+          continue;
+        }
+        for (const e_side& cb_ipin_side : rr_gsb.get_cb_ipin_sides(cb_type)) {
+          net_count.num_sinks += rr_gsb.get_num_ipin_nodes(cb_ipin_side);
+        }
+      }
+
+      if (false == rr_gsb.is_sb_exist()) {
+        continue;
+      }
+      for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+        SideManager side_manager(side);
+        /* Grid output pins to switch block */
+        net_count.num_sinks +=
+          rr_gsb.get_num_opin_nodes(side_manager.get_side());
+
+        /* Routing tracks between switch block and connection blocks */
+        if (0 == rr_gsb.get_chan_width(side_manager.get_side())) {
+          continue;
+        }
+        t_rr_type cb_type =
+          find_top_module_cb_type_by_sb_side(side_manager.get_side());
+        const RRGSB& cb_gsb =
+          device_rr_gsb.get_gsb(find_top_module_gsb_coordinate_by_sb_side(
+            rr_gsb, side_manager.get_side()));
+        if (true == cb_gsb.is_cb_exist(cb_type)) {
+          net_count.num_sinks +=
+            rr_gsb.get_chan_width(side_manager.get_side());
+        }
+      }
+    }
+  }
+  net_count.num_nets = net_count.num_sinks;
+
+  return net_count;
+}
+
 /********************************************************************
  * Add module nets to connect the grid ports/pins to Connection Blocks
  * and Switch Blocks
@@ -799,53 +855,99 @@ static void add_top_module_nets_connect_sb_and_cb(
  *  +-------------+              +---------------------------------+
  *                                             BOTTOM SIDE
  *******************************************************************/
-void add_top_module_nets_connect_grids_and_gsbs(
-  ModuleManager& module_manager, const ModuleId& top_module,
+void for_each_top_module_gsb_connection(
+  const ModuleManager& module_manager,
   const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
   const vtr::Matrix<size_t>& grid_instance_ids, const RRGraphView& rr_graph,
   const DeviceRRGSB& device_rr_gsb, const vtr::Matrix<size_t>& sb_instance_ids,
   const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
-  const bool& compact_routing_hierarchy, const bool& duplicate_grid_pin) {
-  vtr::ScopedStartFinishTimer timer("Add module nets between grids and GSBs");
-
+  const bool& compact_routing_hierarchy, const bool& duplicate_grid_pin,
+  const size_t& num_threads,
+  const std::function<void(const TopModulePinConnection&)>& consumer) {
   vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
 
+  /* The connections of each GSB only require look-ups on the child modules,
+   * which are collected in parallel, one column of GSBs at a time, so that
+   * only the connections of a column are held in memory. The connections
+   * are then consumed in the order of the GSBs, as a grid output pin may
+   * drive the switch blocks of several GSBs through the same net */
+  std::vector<std::vector<TopModulePinConnection>> gsb_connections(
+    gsb_range.y());
   for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
-      vtr::Point<size_t> gsb_coordinate(ix, iy);
+    parallel_for_dynamic(gsb_range.y(), num_threads, [&](const size_t& iy) {
       const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+      std::vector<TopModulePinConnection>& connections = gsb_connections[iy];
+      connections.clear();
 
       /* Connect the grid pins of the GSB to adjacent grids */
       if (false == duplicate_grid_pin) {
         add_top_module_nets_connect_grids_and_sb(
-          module_manager, top_module, vpr_device_annotation, grids,
+          module_manager, connections, vpr_device_annotation, grids,
           grid_instance_ids, rr_graph, device_rr_gsb, rr_gsb, sb_instance_ids,
           compact_routing_hierarchy);
       } else {
         VTR_ASSERT_SAFE(true == duplicate_grid_pin);
         add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(
-          module_manager, top_module, vpr_device_annotation, grids,
+          module_manager, connections, vpr_device_annotation, grids,
           grid_instance_ids, rr_graph, device_rr_gsb, rr_gsb, sb_instance_ids,
           compact_routing_hierarchy);
       }
 
       add_top_module_nets_connect_grids_and_cb(
-        module_manager, top_module, vpr_device_annotation, grids,
+        module_manager, connections, vpr_device_annotation, grids,
         grid_instance_ids, rr_graph, device_rr_gsb, rr_gsb, CHANX,
         cb_instance_ids.at(CHANX), compact_routing_hierarchy);
 
       add_top_module_nets_connect_grids_and_cb(
-        module_manager, top_module, vpr_device_annotation, grids,
+        module_manager, connections, vpr_device_annotation, grids,
         grid_instance_ids, rr_graph, device_rr_gsb, rr_gsb, CHANY,
         cb_instance_ids.at(CHANY), compact_routing_hierarchy);
 
       add_top_module_nets_connect_sb_and_cb(
-        module_manager, top_module, rr_graph, device_rr_gsb, rr_gsb,
+        module_manager, connections, rr_graph, device_rr_gsb, rr_gsb,
         sb_instance_ids, cb_instance_ids, compact_routing_hierarchy);
+    });
+
+    for (const std::vector<TopModulePinConnection>& connections :
+         gsb_connections) {
+      for (const TopModulePinConnection& connection : connections) {
+        consumer(connection);
+      }
     }
   }
 }
 
+/********************************************************************
+ * Add module nets to connect the GSBs to adjacent grid ports/pins
+ * as well as connection blocks, one net for each connection found by
+ * for_each_top_module_gsb_connection()
+ *******************************************************************/
+void add_top_module_nets_connect_grids_and_gsbs(
+  ModuleManager& module_manager, const ModuleId& top_module,
+  const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
+  const vtr::Matrix<size_t>& grid_instance_ids, const RRGraphView& rr_graph,
+  const DeviceRRGSB& device_rr_gsb, const vtr::Matrix<size_t>& sb_instance_ids,
+  const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
+  const bool& compact_routing_hierarchy, const bool& duplicate_grid_pin,
+  const size_t& num_threads) {
+  vtr::ScopedStartFinishTimer timer("Add module nets between grids and GSBs");
+  OPENFPGA_TRACE_FUNCTION();
+
+  for_each_top_module_gsb_connection(
+    module_manager, vpr_device_annotation, grids, grid_instance_ids, rr_graph,
+    device_rr_gsb, sb_instance_ids, cb_instance_ids, compact_routing_hierarchy,
+    duplicate_grid_pin, num_threads,
+    [&](const TopModulePinConnection& connection) {
+      ModuleNetId net = create_module_source_pin_net(
+        module_manager, top_module, connection.src_module,
+        connection.src_instance, connection.src_port, connection.src_pin);
+      /* Configure the net sink */
+      module_manager.add_module_net_sink(
+        top_module, net, connection.sink_module, connection.sink_instance,
+        connection.sink_port, connection.sink_pin);
+    });
+}
+
 /********************************************************************
  * Add global port connection for a given port of a physical tile
  * that are defined as global in tile annotation
@@ -974,9 +1076,35 @@ static int build_top_module_global_net_for_given_grid_module(
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * Coordinates of the tiles in a grid, indexed by the names of their tile
+ * types. Empty tiles and the non-root parts of tiles whose width or height
+ * is larger than 1 are excluded
+ *******************************************************************/
+typedef std::unordered_map<std::string, std::vector<vtr::Point<size_t>>>
+  t_tile_coordinates_by_type;
+
+static void index_tile_coordinate_by_type(
+  t_tile_coordinates_by_type& tile_coords, const DeviceGrid& grids,
+  const vtr::Point<size_t>& coord) {
+  const t_grid_tile& grid_tile = grids[coord.x()][coord.y()];
+  /* Bypass EMPTY tiles */
+  if (true == is_empty_type(grid_tile.type)) {
+    return;
+  }
+  /* Skip width or height > 1 tiles (mostly heterogeneous blocks) */
+  if ((0 < grid_tile.width_offset) || (0 < grid_tile.height_offset)) {
+    return;
+  }
+  tile_coords[std::string(grid_tile.type->name)].push_back(coord);
+}
+
 /********************************************************************
  * Add global ports from grid ports that are defined as global in tile
  *annotation
+ * The tiles of each type are indexed once, for the core grids and for the
+ * I/O grids of each side, so that each tile annotation only visits the
+ * tiles of its type, rather than scanning the whole grid
  *******************************************************************/
 int add_top_module_global_ports_from_grid_modules(
   ModuleManager& module_manager, const ModuleId& top_module,
@@ -1018,6 +1146,23 @@ int add_top_module_global_ports_from_grid_modules(
   std::map<e_side, std::vector<vtr::Point<size_t>>> io_coordinates =
     generate_perimeter_grid_coordinates(grids);
 
+  /* Index the core grids in the sequence of x then y coordinates, and the
+   * I/O grids in the sequence of the perimeter */
+  t_tile_coordinates_by_type core_tile_coords;
+  for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
+    for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
+      index_tile_coordinate_by_type(core_tile_coords, grids,
+                                    vtr::Point<size_t>(ix, iy));
+    }
+  }
+  std::map<e_side, t_tile_coordinates_by_type> io_tile_coords;
+  for (const e_side& io_side : FPGA_SIDES_CLOCKWISE) {
+    for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
+      index_tile_coordinate_by_type(io_tile_coords[io_side], grids,
+                                    io_coordinate);
+    }
+  }
+
   for (const TileGlobalPortId& tile_global_port :
        tile_annotation.global_ports()) {
     /* Must found one valid port! */
@@ -1073,57 +1218,29 @@ int add_top_module_global_ports_from_grid_modules(
       }
 
       /* Spot the port from child modules from core grids */
-      for (size_t ix = start_coord.x(); ix < end_coord.x(); ++ix) {
-        for (size_t iy = start_coord.y(); iy < end_coord.y(); ++iy) {
-          /* Bypass EMPTY tiles */
-          if (true == is_empty_type(grids[ix][iy].type)) {
-            continue;
-          }
-          /* Skip width or height > 1 tiles (mostly heterogeneous blocks) */
-          if ((0 < grids[ix][iy].width_offset) ||
-              (0 < grids[ix][iy].height_offset)) {
-            continue;
-          }
-
-          /* Bypass the tiles whose names do not match */
-          if (std::string(grids[ix][iy].type->name) != tile_name) {
-            continue;
-          }
+      for (const vtr::Point<size_t>& core_coordinate :
+           core_tile_coords[tile_name]) {
+        if ((core_coordinate.x() < start_coord.x()) ||
+            (core_coordinate.x() >= end_coord.x()) ||
+            (core_coordinate.y() < start_coord.y()) ||
+            (core_coordinate.y() >= end_coord.y())) {
+          continue;
+        }
 
-          /* Create nets and finish connection build-up */
-          status = build_top_module_global_net_for_given_grid_module(
-            module_manager, top_module, top_module_port, tile_annotation,
-            tile_global_port, tile_port, vpr_device_annotation, grids,
-            vtr::Point<size_t>(ix, iy), NUM_SIDES, grid_instance_ids);
-          if (CMD_EXEC_FATAL_ERROR == status) {
-            return status;
-          }
+        /* Create nets and finish connection build-up */
+        status = build_top_module_global_net_for_given_grid_module(
+          module_manager, top_module, top_module_port, tile_annotation,
+          tile_global_port, tile_port, vpr_device_annotation, grids,
+          core_coordinate, NUM_SIDES, grid_instance_ids);
+        if (CMD_EXEC_FATAL_ERROR == status) {
+          return status;
         }
       }
 
       /* Walk through all the grids on the perimeter, which are I/O grids */
       for (const e_side& io_side : FPGA_SIDES_CLOCKWISE) {
         for (const vtr::Point<size_t>& io_coordinate :
-             io_coordinates[io_side]) {
-          /* Bypass EMPTY grid */
-          if (true ==
-              is_empty_type(grids[io_coordinate.x()][io_coordinate.y()].type)) {
-            continue;
-          }
-
-          /* Skip width or height > 1 tiles (mostly heterogeneous blocks) */
-          if ((0 < grids[io_coordinate.x()][io_coordinate.y()].width_offset) ||
-              (0 < grids[io_coordinate.x()][io_coordinate.y()].height_offset)) {
-            continue;
-          }
-
-          /* Bypass the tiles whose names do not match */
-          if (std::string(
-                grids[io_coordinate.x()][io_coordinate.y()].type->name) !=
-              tile_name) {
-            continue;
-          }
-
+             io_tile_coords[io_side][tile_name]) {
           /* Check if the coordinate satisfy the tile coordinate defintion
            * - Bypass if the x is a specific number (!= -1), and io_coordinate
            * is different
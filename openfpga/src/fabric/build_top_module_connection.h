@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <functional>
+#include <map>
 #include <vector>
 
 #include "device_grid.h"
@@ -22,13 +24,50 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Numbers of module nets and net sinks in the top module */
+struct TopModuleNetCount {
+  size_t num_nets;
+  size_t num_sinks;
+};
+
+/********************************************************************
+ * A connection between a pin of a child instance and a pin of another
+ * child instance of the top module, which is found in a GSB. It is
+ * either added to the top module as a module net, or written to a
+ * netlist directly
+ *******************************************************************/
+struct TopModulePinConnection {
+  ModuleId src_module;
+  size_t src_instance;
+  ModulePortId src_port;
+  size_t src_pin;
+  ModuleId sink_module;
+  size_t sink_instance;
+  ModulePortId sink_port;
+  size_t sink_pin;
+};
+
+TopModuleNetCount estimate_top_module_num_gsb_nets(
+  const DeviceRRGSB& device_rr_gsb);
+
+void for_each_top_module_gsb_connection(
+  const ModuleManager& module_manager,
+  const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
+  const vtr::Matrix<size_t>& grid_instance_ids, const RRGraphView& rr_graph,
+  const DeviceRRGSB& device_rr_gsb, const vtr::Matrix<size_t>& sb_instance_ids,
+  const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
+  const bool& compact_routing_hierarchy, const bool& duplicate_grid_pin,
+  const size_t& num_threads,
+  const std::function<void(const TopModulePinConnection&)>& consumer);
+
 void add_top_module_nets_connect_grids_and_gsbs(
   ModuleManager& module_manager, const ModuleId& top_module,
   const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
   const vtr::Matrix<size_t>& grid_instance_ids, const RRGraphView& rr_graph,
   const DeviceRRGSB& device_rr_gsb, const vtr::Matrix<size_t>& sb_instance_ids,
   const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
-  const bool& compact_routing_hierarchy, const bool& duplicate_grid_pin);
+  const bool& compact_routing_hierarchy, const bool& duplicate_grid_pin,
+  const size_t& num_threads);
 
 int add_top_module_global_ports_from_grid_modules(
   ModuleManager& module_manager, const ModuleId& top_module,
@@ -12,6 +12,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_port.h"
+#include "openfpga_trace.h"
 
 /* Headers from vpr library */
 #include "build_top_module_directs.h"
@@ -213,6 +214,7 @@ void add_top_module_nets_tile_direct_connections(
   const ArchDirect& arch_direct) {
   vtr::ScopedStartFinishTimer timer(
     "Add module nets for inter-tile connections");
+  OPENFPGA_TRACE_FUNCTION();
 
   for (const TileDirectId& tile_direct_id : tile_direct.directs()) {
     add_module_nets_tile_direct_connection(
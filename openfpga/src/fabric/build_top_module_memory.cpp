@@ -2,13 +2,21 @@
  * This file includes functions that are used to organize memories
  * in the top module of FPGA fabric
  *******************************************************************/
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_trace.h"
+
 /* Headers from vpr library */
 #include "vpr_utils.h"
 
@@ -223,6 +231,148 @@ static void organize_top_module_tile_memory_modules(
   }
 }
 
+/********************************************************************
+ * Find the number of consecutive configurable children in each region,
+ * so that the largest number of configuration bits in a region is
+ * minimized. Each region contains at least one child.
+ * The smallest feasible capacity of a region is found by a binary search,
+ * where a capacity is feasible if the children can be greedily packed
+ * into no more than the given number of regions
+ *******************************************************************/
+static std::vector<size_t> find_top_module_balanced_region_sizes(
+  const std::vector<size_t>& child_num_bits, const size_t& num_regions) {
+  VTR_ASSERT(num_regions <= child_num_bits.size());
+
+  size_t lower_capacity = 0;
+  size_t upper_capacity = 0;
+  for (const size_t& num_bits : child_num_bits) {
+    lower_capacity = std::max(lower_capacity, num_bits);
+    upper_capacity += num_bits;
+  }
+
+  while (lower_capacity < upper_capacity) {
+    size_t capacity = lower_capacity + (upper_capacity - lower_capacity) / 2;
+    size_t num_required_regions = 1;
+    size_t region_num_bits = 0;
+    for (const size_t& num_bits : child_num_bits) {
+      if (region_num_bits + num_bits > capacity) {
+        num_required_regions++;
+        region_num_bits = 0;
+      }
+      region_num_bits += num_bits;
+    }
+    if (num_required_regions <= num_regions) {
+      upper_capacity = capacity;
+    } else {
+      lower_capacity = capacity + 1;
+    }
+  }
+
+  /* Pack the children under the capacity. A new region is also started
+   * when the remaining children are just enough to fill the remaining
+   * regions, so that no region is left empty */
+  std::vector<size_t> region_sizes(1, 0);
+  size_t region_num_bits = 0;
+  for (size_t ichild = 0; ichild < child_num_bits.size(); ++ichild) {
+    size_t num_remaining_children = child_num_bits.size() - ichild;
+    size_t num_remaining_regions = num_regions - region_sizes.size();
+    if ((0 < region_sizes.back()) && (0 < num_remaining_regions) &&
+        ((region_num_bits + child_num_bits[ichild] > upper_capacity) ||
+         (num_remaining_children == num_remaining_regions))) {
+      region_sizes.push_back(0);
+      region_num_bits = 0;
+    }
+    region_sizes.back()++;
+    region_num_bits += child_num_bits[ichild];
+  }
+  VTR_ASSERT(num_regions == region_sizes.size());
+
+  return region_sizes;
+}
+
+/********************************************************************
+ * Find the number of configurable children in each configurable region
+ * of the top module, following the sequence of configurable children.
+ * By default, each region contains the same number of configurable
+ * children. When balanced regions are required, the children are split
+ * so that the largest number of configuration bits in a region is
+ * minimized, which is the time to load the regions in parallel.
+ * Since the sequence of configurable children follows the physical
+ * location of tiles, each region still covers neighbouring tiles.
+ * The children beyond the regions, i.e., the decoders, are counted in
+ * the last region
+ *******************************************************************/
+static std::vector<size_t> find_top_module_config_region_sizes(
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const CircuitLibrary& circuit_lib, const CircuitModelId& sram_model,
+  const ConfigProtocol& config_protocol, const bool& balance_regions) {
+  /* Ensure we have valid configurable children */
+  VTR_ASSERT(false == module_manager.configurable_children(top_module).empty());
+
+  /* Ensure that our region definition is valid */
+  VTR_ASSERT(1 <= config_protocol.num_regions());
+
+  /* Exclude decoders from the list */
+  size_t num_children = module_manager.configurable_children(top_module).size();
+  size_t num_configurable_children = num_children;
+  if (CONFIG_MEM_MEMORY_BANK == config_protocol.type() ||
+      CONFIG_MEM_QL_MEMORY_BANK == config_protocol.type()) {
+    num_configurable_children -= 2;
+  } else if (CONFIG_MEM_FRAME_BASED == config_protocol.type()) {
+    num_configurable_children -= 1;
+  }
+
+  size_t num_regions = config_protocol.num_regions();
+
+  std::vector<size_t> region_sizes;
+  if ((true == balance_regions) && (num_regions <= num_configurable_children)) {
+    std::vector<size_t> child_num_bits;
+    child_num_bits.reserve(num_configurable_children);
+    for (size_t ichild = 0; ichild < num_configurable_children; ++ichild) {
+      child_num_bits.push_back(find_module_num_config_bits(
+        module_manager,
+        module_manager.configurable_children(top_module)[ichild], circuit_lib,
+        sram_model, config_protocol.type()));
+    }
+    region_sizes =
+      find_top_module_balanced_region_sizes(child_num_bits, num_regions);
+
+    /* Report the balance of the regions */
+    size_t min_region_num_bits = std::numeric_limits<size_t>::max();
+    size_t max_region_num_bits = 0;
+    size_t child_offset = 0;
+    for (const size_t& region_size : region_sizes) {
+      size_t region_num_bits = 0;
+      for (size_t ichild = child_offset; ichild < child_offset + region_size;
+           ++ichild) {
+        region_num_bits += child_num_bits[ichild];
+      }
+      min_region_num_bits = std::min(min_region_num_bits, region_num_bits);
+      max_region_num_bits = std::max(max_region_num_bits, region_num_bits);
+      child_offset += region_size;
+    }
+    VTR_LOG(
+      "Balanced %lu configurable regions: %lu to %lu configuration bits per "
+      "region\n",
+      num_regions, min_region_num_bits, max_region_num_bits);
+  } else {
+    /* Evenly place each configurable child to each region */
+    size_t num_children_per_region =
+      std::max(num_configurable_children / num_regions, (size_t)1);
+    region_sizes.assign(num_regions, num_children_per_region);
+  }
+
+  /* The last region takes all the remaining children */
+  size_t num_assigned_children = 0;
+  for (size_t iregion = 0; iregion < num_regions - 1; ++iregion) {
+    num_assigned_children += region_sizes[iregion];
+  }
+  VTR_ASSERT(num_assigned_children < num_children);
+  region_sizes.back() = num_children - num_assigned_children;
+
+  return region_sizes;
+}
+
 /********************************************************************
  * Split memory modules into different configurable regions
  * This function will create regions based on the definition
@@ -258,68 +408,41 @@ static void organize_top_module_tile_memory_modules(
  *  | +------+ +------+     |
  *  +-----------------------+
  *
+ * The number of configurable children in each region is given, whose
+ * sum should be the number of configurable children
+ *
  * Note:
  *   - This function should NOT modify configurable children
  *
  *******************************************************************/
 static void build_top_module_configurable_regions(
   ModuleManager& module_manager, const ModuleId& top_module,
-  const ConfigProtocol& config_protocol) {
+  const std::vector<size_t>& region_sizes) {
   vtr::ScopedStartFinishTimer timer(
     "Build configurable regions for the top module");
+  OPENFPGA_TRACE_FUNCTION();
 
-  /* Ensure we have valid configurable children */
-  VTR_ASSERT(false == module_manager.configurable_children(top_module).empty());
+  size_t num_children = module_manager.configurable_children(top_module).size();
 
-  /* Ensure that our region definition is valid */
-  VTR_ASSERT(1 <= config_protocol.num_regions());
-
-  /* Exclude decoders from the list */
-  size_t num_configurable_children =
-    module_manager.configurable_children(top_module).size();
-  if (CONFIG_MEM_MEMORY_BANK == config_protocol.type() ||
-      CONFIG_MEM_QL_MEMORY_BANK == config_protocol.type()) {
-    num_configurable_children -= 2;
-  } else if (CONFIG_MEM_FRAME_BASED == config_protocol.type()) {
-    num_configurable_children -= 1;
-  }
-
-  /* Evenly place each configurable child to each region */
-  size_t num_children_per_region =
-    num_configurable_children / config_protocol.num_regions();
-  size_t region_child_counter = 0;
-  bool create_region = true;
-  ConfigRegionId curr_region = ConfigRegionId::INVALID();
-  for (size_t ichild = 0;
-       ichild < module_manager.configurable_children(top_module).size();
-       ++ichild) {
-    if (true == create_region) {
-      curr_region = module_manager.add_config_region(top_module);
-    }
-
-    /* Add the child to a region */
-    module_manager.add_configurable_child_to_region(
-      top_module, curr_region,
-      module_manager.configurable_children(top_module)[ichild],
-      module_manager.configurable_child_instances(top_module)[ichild], ichild);
-
-    /* See if the current region is full or not:
-     * For the last region, we will keep adding until we finish all the children
-     */
-    region_child_counter++;
-    if (region_child_counter < num_children_per_region) {
-      create_region = false;
-    } else if (size_t(curr_region) <
-               (size_t)config_protocol.num_regions() - 1) {
-      create_region = true;
-      region_child_counter = 0;
+  size_t ichild = 0;
+  for (const size_t& region_size : region_sizes) {
+    ConfigRegionId curr_region = module_manager.add_config_region(top_module);
+    for (size_t ikey = 0; ikey < region_size; ++ikey) {
+      VTR_ASSERT(ichild < num_children);
+      /* Add the child to a region */
+      module_manager.add_configurable_child_to_region(
+        top_module, curr_region,
+        module_manager.configurable_children(top_module)[ichild],
+        module_manager.configurable_child_instances(top_module)[ichild],
+        ichild);
+      ichild++;
     }
   }
 
-  /* Ensure that the number of configurable regions created matches the
-   * definition */
-  VTR_ASSERT((size_t)config_protocol.num_regions() ==
-             module_manager.regions(top_module).size());
+  /* Ensure that all the children have been placed in the regions, whose
+   * number matches the definition */
+  VTR_ASSERT(num_children == ichild);
+  VTR_ASSERT(region_sizes.size() == module_manager.regions(top_module).size());
 }
 
 /********************************************************************
@@ -425,7 +548,7 @@ void organize_top_module_memory_modules(
   const vtr::Matrix<size_t>& grid_instance_ids,
   const DeviceRRGSB& device_rr_gsb, const vtr::Matrix<size_t>& sb_instance_ids,
   const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
-  const bool& compact_routing_hierarchy) {
+  const bool& compact_routing_hierarchy, const bool& balance_config_regions) {
   /* Ensure clean vectors to return */
   VTR_ASSERT(true == module_manager.configurable_children(top_module).empty());
 
@@ -510,18 +633,24 @@ void organize_top_module_memory_modules(
   }
 
   /* Split memory modules into different regions */
+  std::vector<size_t> region_sizes = find_top_module_config_region_sizes(
+    module_manager, top_module, circuit_lib, sram_model, config_protocol,
+    balance_config_regions);
   build_top_module_configurable_regions(module_manager, top_module,
-                                        config_protocol);
+                                        region_sizes);
 }
 
 /********************************************************************
  * Shuffle the configurable children in a random sequence
  *
+ * When balanced regions are required, the shuffling is applied to each
+ * region separately: configurable children are not shuffled from a
+ * region to another, so that the regions keep the balanced number of
+ * configuration bits and the neighbouring tiles they were built with.
+ * Otherwise, all the configurable children are shuffled and the regions
+ * are rebuilt on the shuffled sequence.
+ *
  * TODO: May use a more customized shuffle mechanism
- * TODO: Apply region-based shuffling
- *       The shuffling will be applied to each separated regions
- *       Configurable children will not shuffled from a region
- *       to another, instead they should stay in the same region
  *
  * Note:
  *   - This function should NOT be called
@@ -529,7 +658,8 @@ void organize_top_module_memory_modules(
  ********************************************************************/
 void shuffle_top_module_configurable_children(
   ModuleManager& module_manager, const ModuleId& top_module,
-  const ConfigProtocol& config_protocol) {
+  const CircuitLibrary& circuit_lib, const CircuitModelId& sram_model,
+  const ConfigProtocol& config_protocol, const bool& balance_config_regions) {
   size_t num_keys = module_manager.configurable_children(top_module).size();
   std::vector<size_t> shuffled_keys;
   shuffled_keys.reserve(num_keys);
@@ -537,7 +667,30 @@ void shuffle_top_module_configurable_children(
     shuffled_keys.push_back(ikey);
   }
 
-  std::random_shuffle(shuffled_keys.begin(), shuffled_keys.end());
+  /* Keep the regions which have been built, whose children follow the
+   * sequence of configurable children */
+  std::vector<size_t> region_sizes;
+  if (true == balance_config_regions) {
+    for (const ConfigRegionId& config_region :
+         module_manager.regions(top_module)) {
+      region_sizes.push_back(
+        module_manager.region_configurable_children(top_module, config_region)
+          .size());
+    }
+  }
+
+  if (false == region_sizes.empty()) {
+    size_t key_offset = 0;
+    for (const size_t& region_size : region_sizes) {
+      VTR_ASSERT(key_offset + region_size <= num_keys);
+      std::random_shuffle(shuffled_keys.begin() + key_offset,
+                          shuffled_keys.begin() + key_offset + region_size);
+      key_offset += region_size;
+    }
+    VTR_ASSERT(num_keys == key_offset);
+  } else {
+    std::random_shuffle(shuffled_keys.begin(), shuffled_keys.end());
+  }
 
   /* Cache the configurable children and their instances */
   std::vector<ModuleId> orig_configurable_children =
@@ -559,12 +712,170 @@ void shuffle_top_module_configurable_children(
 
   /* Reset configurable regions */
   module_manager.clear_config_region(top_module);
+  if (true == region_sizes.empty()) {
+    region_sizes = find_top_module_config_region_sizes(
+      module_manager, top_module, circuit_lib, sram_model, config_protocol,
+      false);
+  }
   build_top_module_configurable_regions(module_manager, top_module,
-                                        config_protocol);
+                                        region_sizes);
+}
+
+/********************************************************************
+ * Find the index of a point on a Hilbert curve which covers a square
+ * of the given size, which should be a power of 2
+ *******************************************************************/
+static size_t find_hilbert_curve_index(const size_t& curve_size, size_t x,
+                                       size_t y) {
+  size_t index = 0;
+  for (size_t s = curve_size / 2; s > 0; s /= 2) {
+    size_t rx = (x & s) > 0 ? 1 : 0;
+    size_t ry = (y & s) > 0 ? 1 : 0;
+    index += s * s * ((3 * rx) ^ ry);
+    /* Rotate the quadrant so that the sub-curve is in the base orientation */
+    if (0 == ry) {
+      if (1 == rx) {
+        x = curve_size - 1 - x;
+        y = curve_size - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return index;
+}
+
+/********************************************************************
+ * Order the configurable children of each region along a Hilbert curve
+ * over their coordinates, so that consecutive children are physically
+ * close to each other. This reduces the wirelength of the configuration
+ * chains and BL/WL nets between the children.
+ * Configurable children are not moved from a region to another.
+ * Children without a valid coordinate are kept at the end of their
+ * region, and children sharing a coordinate keep their sequence
+ *
+ * Note:
+ *   - This function should NOT be called
+ *     before allocating any configurable child
+ ********************************************************************/
+void sort_top_module_configurable_children_by_location(
+  ModuleManager& module_manager, const ModuleId& top_module) {
+  vtr::ScopedStartFinishTimer timer(
+    "Order configurable children along a Hilbert curve");
+  OPENFPGA_TRACE_FUNCTION();
+
+  /* The curve should cover all the coordinates */
+  int max_coord = 0;
+  for (const vtr::Point<int>& coord :
+       module_manager.configurable_child_coordinates(top_module)) {
+    max_coord = std::max(max_coord, std::max(coord.x(), coord.y()));
+  }
+  size_t curve_size = 1;
+  while (curve_size <= size_t(max_coord)) {
+    curve_size *= 2;
+  }
+
+  std::vector<ModuleId> sorted_children;
+  std::vector<size_t> sorted_child_instances;
+  std::vector<vtr::Point<int>> sorted_child_coordinates;
+  std::vector<size_t> region_sizes;
+  for (const ConfigRegionId& config_region :
+       module_manager.regions(top_module)) {
+    std::vector<ModuleId> region_children =
+      module_manager.region_configurable_children(top_module, config_region);
+    std::vector<size_t> region_child_instances =
+      module_manager.region_configurable_child_instances(top_module,
+                                                         config_region);
+    std::vector<vtr::Point<int>> region_child_coordinates =
+      module_manager.region_configurable_child_coordinates(top_module,
+                                                           config_region);
+
+    std::vector<size_t> curve_indices;
+    curve_indices.reserve(region_children.size());
+    for (const vtr::Point<int>& coord : region_child_coordinates) {
+      if ((0 > coord.x()) || (0 > coord.y())) {
+        curve_indices.push_back(std::numeric_limits<size_t>::max());
+      } else {
+        curve_indices.push_back(
+          find_hilbert_curve_index(curve_size, coord.x(), coord.y()));
+      }
+    }
+
+    std::vector<size_t> child_orders(region_children.size());
+    for (size_t ichild = 0; ichild < child_orders.size(); ++ichild) {
+      child_orders[ichild] = ichild;
+    }
+    std::stable_sort(child_orders.begin(), child_orders.end(),
+                     [&](const size_t& lhs, const size_t& rhs) {
+                       return curve_indices[lhs] < curve_indices[rhs];
+                     });
+
+    for (const size_t& ichild : child_orders) {
+      sorted_children.push_back(region_children[ichild]);
+      sorted_child_instances.push_back(region_child_instances[ichild]);
+      sorted_child_coordinates.push_back(region_child_coordinates[ichild]);
+    }
+    region_sizes.push_back(region_children.size());
+  }
+  VTR_ASSERT(sorted_children.size() ==
+             module_manager.configurable_children(top_module).size());
+
+  /* Reorganize the configurable children */
+  module_manager.clear_configurable_children(top_module);
+  for (size_t ichild = 0; ichild < sorted_children.size(); ++ichild) {
+    module_manager.add_configurable_child(top_module, sorted_children[ichild],
+                                          sorted_child_instances[ichild],
+                                          sorted_child_coordinates[ichild]);
+  }
+
+  /* Reset configurable regions */
+  module_manager.clear_config_region(top_module);
+  build_top_module_configurable_regions(module_manager, top_module,
+                                        region_sizes);
+}
+
+/********************************************************************
+ * Look-ups to resolve the keys of a fabric key to the child instances
+ * of the top-level module, built in a single pass over the children
+ * - the instance (child module and instance id) of each instance name
+ * - the number of configuration bits of each child module
+ * - the keys which have been already assigned to each instance,
+ *   to detect duplicated keys
+ *******************************************************************/
+struct TopModuleFabricKeyResolver {
+  std::unordered_map<std::string, std::pair<ModuleId, size_t>>
+    instance_name_lookup;
+  std::map<ModuleId, size_t> child_num_config_bits;
+  std::map<ModuleId, std::vector<FabricKeyId>> instance_keys;
+};
+
+static TopModuleFabricKeyResolver build_top_module_fabric_key_resolver(
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol) {
+  TopModuleFabricKeyResolver resolver;
+  for (const ModuleId& child : module_manager.child_modules(top_module)) {
+    size_t num_inst = module_manager.num_instance(top_module, child);
+    for (size_t inst = 0; inst < num_inst; ++inst) {
+      std::string inst_name =
+        module_manager.instance_name(top_module, child, inst);
+      if (inst_name.empty()) {
+        continue;
+      }
+      /* Keep the first match, as an exhaustive search would do */
+      resolver.instance_name_lookup.emplace(inst_name,
+                                            std::make_pair(child, inst));
+    }
+    resolver.child_num_config_bits[child] = find_module_num_config_bits(
+      module_manager, child, circuit_lib, config_protocol.memory_model(),
+      config_protocol.type());
+    resolver.instance_keys[child].resize(num_inst, FabricKeyId::INVALID());
+  }
+  return resolver;
 }
 
 /********************************************************************
  * Load configurable children from a fabric key to top-level module
+ * All the keys are resolved through look-ups which are built once,
+ * so that the runtime scales linearly with the number of keys
  *
  * Note:
  *   - This function will overwrite any exisiting configurable children
@@ -580,6 +891,9 @@ int load_top_module_memory_modules_from_fabric_key(
   /* Ensure a clean start */
   module_manager.clear_configurable_children(top_module);
 
+  TopModuleFabricKeyResolver resolver = build_top_module_fabric_key_resolver(
+    module_manager, top_module, circuit_lib, config_protocol);
+
   size_t curr_configurable_child_id = 0;
 
   for (const FabricRegionId& region : fabric_key.regions()) {
@@ -591,17 +905,16 @@ int load_top_module_memory_modules_from_fabric_key(
       std::pair<ModuleId, size_t> instance_info(ModuleId::INVALID(), 0);
       /* If we have an alias, we try to find a instance in this name */
       if (!fabric_key.key_alias(key).empty()) {
-        /* If we have the key, we can quickly spot instance id.
-         * Otherwise, we have to exhaustively find the module id and instance id
-         */
-        if (!fabric_key.key_name(key).empty()) {
-          instance_info.first =
-            module_manager.find_module(fabric_key.key_name(key));
-          instance_info.second = module_manager.instance_id(
-            top_module, instance_info.first, fabric_key.key_alias(key));
-        } else {
-          instance_info = find_module_manager_instance_module_info(
-            module_manager, top_module, fabric_key.key_alias(key));
+        auto result =
+          resolver.instance_name_lookup.find(fabric_key.key_alias(key));
+        if (result != resolver.instance_name_lookup.end()) {
+          instance_info = result->second;
+        }
+        /* If we have the key, the instance should be under the module */
+        if (!fabric_key.key_name(key).empty() &&
+            instance_info.first !=
+              module_manager.find_module(fabric_key.key_name(key))) {
+          instance_info.first = ModuleId::INVALID();
         }
       } else {
         /* If we do not have an alias, we use the name and value to build the
@@ -611,7 +924,8 @@ int load_top_module_memory_modules_from_fabric_key(
         instance_info.second = fabric_key.key_value(key);
       }
 
-      if (false == module_manager.valid_module_id(instance_info.first)) {
+      auto inst_keys = resolver.instance_keys.find(instance_info.first);
+      if (inst_keys == resolver.instance_keys.end()) {
         if (!fabric_key.key_alias(key).empty()) {
           VTR_LOG_ERROR("Invalid key alias '%s'!\n",
                         fabric_key.key_alias(key).c_str());
@@ -622,8 +936,7 @@ int load_top_module_memory_modules_from_fabric_key(
         return CMD_EXEC_FATAL_ERROR;
       }
 
-      if (false == module_manager.valid_module_instance_id(
-                     top_module, instance_info.first, instance_info.second)) {
+      if (instance_info.second >= inst_keys->second.size()) {
         if (!fabric_key.key_alias(key).empty()) {
           VTR_LOG_ERROR("Invalid key alias '%s'!\n",
                         fabric_key.key_alias(key).c_str());
@@ -634,9 +947,7 @@ int load_top_module_memory_modules_from_fabric_key(
       }
 
       /* If the the child has not configuration bits, error out */
-      if (0 == find_module_num_config_bits(
-                 module_manager, instance_info.first, circuit_lib,
-                 config_protocol.memory_model(), config_protocol.type())) {
+      if (0 == resolver.child_num_config_bits.at(instance_info.first)) {
         if (!fabric_key.key_alias(key).empty()) {
           VTR_LOG_ERROR(
             "Invalid key alias '%s' which has zero configuration bits!\n",
@@ -649,6 +960,20 @@ int load_top_module_memory_modules_from_fabric_key(
         return CMD_EXEC_FATAL_ERROR;
       }
 
+      /* Each instance can be assigned to only one key */
+      FabricKeyId& prev_key = inst_keys->second[instance_info.second];
+      if (FabricKeyId::INVALID() != prev_key) {
+        VTR_LOG_ERROR(
+          "Key '%lu' and key '%lu' point to the same instance '%s'!\n",
+          size_t(prev_key), size_t(key),
+          module_manager
+            .instance_name(top_module, instance_info.first,
+                           instance_info.second)
+            .c_str());
+        return CMD_EXEC_FATAL_ERROR;
+      }
+      prev_key = key;
+
       /* Now we can add the child to configurable children of the top module */
       module_manager.add_configurable_child(top_module, instance_info.first,
                                             instance_info.second,
@@ -1995,6 +2320,7 @@ void add_top_module_nets_memory_config_bus(
   const e_circuit_model_design_tech& mem_tech,
   const TopModuleNumConfigBits& num_config_bits) {
   vtr::ScopedStartFinishTimer timer("Add module nets for configuration buses");
+  OPENFPGA_TRACE_FUNCTION();
 
   switch (mem_tech) {
     case CIRCUIT_MODEL_DESIGN_CMOS:
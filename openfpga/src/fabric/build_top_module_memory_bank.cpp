@@ -2,6 +2,7 @@
  * This file includes functions that are used to organize memories
  * in the top module of FPGA fabric
  *******************************************************************/
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -104,26 +105,11 @@ static void add_module_nets_to_ql_memory_bank_shift_register_module(
         module_manager.find_module_port(net_sink_module_id, sink_port_name);
     }
 
-    /* Get the pin id for source port */
-    BasicPort net_src_port =
-      module_manager.module_port(net_src_module_id, net_src_port_id);
-    /* Get the pin id for sink port */
-    BasicPort net_sink_port =
-      module_manager.module_port(net_sink_module_id, net_sink_port_id);
-    /* Port sizes of source and sink should match */
-    VTR_ASSERT(net_src_port.get_width() == net_sink_port.get_width());
-
     /* Create a net for each pin */
-    for (size_t pin_id = 0; pin_id < net_src_port.pins().size(); ++pin_id) {
-      /* Create a net and add source and sink to it */
-      ModuleNetId net = create_module_source_pin_net(
-        module_manager, parent_module, net_src_module_id, net_src_instance_id,
-        net_src_port_id, net_src_port.pins()[pin_id]);
-      /* Add net sink */
-      module_manager.add_module_net_sink(parent_module, net, net_sink_module_id,
-                                         net_sink_instance_id, net_sink_port_id,
-                                         net_sink_port.pins()[pin_id]);
-    }
+    add_module_bus_nets(module_manager, parent_module, net_src_module_id,
+                        net_src_instance_id, net_src_port_id,
+                        net_sink_module_id, net_sink_instance_id,
+                        net_sink_port_id);
   }
 
   /* For the last memory module:
@@ -146,26 +132,10 @@ static void add_module_nets_to_ql_memory_bank_shift_register_module(
   ModulePortId net_sink_port_id =
     module_manager.find_module_port(net_sink_module_id, sink_port_name);
 
-  /* Get the pin id for source port */
-  BasicPort net_src_port =
-    module_manager.module_port(net_src_module_id, net_src_port_id);
-  /* Get the pin id for sink port */
-  BasicPort net_sink_port =
-    module_manager.module_port(net_sink_module_id, net_sink_port_id);
-  /* Port sizes of source and sink should match */
-  VTR_ASSERT(net_src_port.get_width() == net_sink_port.get_width());
-
   /* Create a net for each pin */
-  for (size_t pin_id = 0; pin_id < net_src_port.pins().size(); ++pin_id) {
-    /* Create a net and add source and sink to it */
-    ModuleNetId net = create_module_source_pin_net(
-      module_manager, parent_module, net_src_module_id, net_src_instance_id,
-      net_src_port_id, net_src_port.pins()[pin_id]);
-    /* Add net sink */
-    module_manager.add_module_net_sink(parent_module, net, net_sink_module_id,
-                                       net_sink_instance_id, net_sink_port_id,
-                                       net_sink_port.pins()[pin_id]);
-  }
+  add_module_bus_nets(module_manager, parent_module, net_src_module_id,
+                      net_src_instance_id, net_src_port_id, net_sink_module_id,
+                      net_sink_instance_id, net_sink_port_id);
 }
 
 /*********************************************************************
@@ -594,15 +564,10 @@ static void add_top_module_nets_cmos_ql_memory_bank_bl_decoder_config_bus(
      * Note that each region has independent data_in connection from the
      * top-level module The pin index is the configuration region index
      */
-    ModuleNetId din_net = create_module_source_pin_net(
-      module_manager, top_module, top_module, 0, din_port,
-      din_port_info.pins()[size_t(config_region)]);
-    VTR_ASSERT(ModuleNetId::INVALID() != din_net);
-
-    /* Configure the net sink */
-    module_manager.add_module_net_sink(
-      top_module, din_net, bl_decoder_module, curr_bl_decoder_instance_id,
-      bl_decoder_din_port, bl_decoder_din_port_info.pins()[0]);
+    module_manager.add_module_nets_between_ports(
+      top_module, top_module, 0, din_port, size_t(config_region),
+      bl_decoder_module, curr_bl_decoder_instance_id, bl_decoder_din_port, 0,
+      1);
 
     /**************************************************************
      * Precompute the BLs and WLs distribution across the FPGA fabric
@@ -667,30 +632,19 @@ static void add_top_module_nets_cmos_ql_memory_bank_bl_decoder_config_bus(
       BasicPort child_bl_port_info =
         module_manager.module_port(child_module, child_bl_port);
 
-      size_t cur_bl_index = 0;
-
-      for (const size_t& sink_bl_pin : child_bl_port_info.pins()) {
-        size_t bl_pin_id = bl_start_index_per_tile[coord.x()] + cur_bl_index;
-        /* Find the BL decoder data index:
-         * It should be the starting index plus an offset which is the residual
-         * when divided by the number of BLs in this tile
-         */
-        VTR_ASSERT(bl_pin_id < bl_decoder_dout_port_info.pins().size());
-
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, bl_decoder_module,
-          curr_bl_decoder_instance_id, bl_decoder_dout_port,
-          bl_decoder_dout_port_info.pins()[bl_pin_id]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-        /* Add net sink */
-        module_manager.add_module_net_sink(top_module, net, child_module,
-                                           child_instance, child_bl_port,
-                                           sink_bl_pin);
-
-        cur_bl_index++;
-      }
+      /* Find the BL decoder data index:
+       * It should be the starting index plus an offset which is the residual
+       * when divided by the number of BLs in this tile
+       */
+      size_t bl_pin_start = bl_start_index_per_tile[coord.x()];
+      VTR_ASSERT(bl_pin_start + child_bl_port_info.get_width() <=
+                 bl_decoder_dout_port_info.get_width());
+
+      /* Create a net for each BL of the child */
+      module_manager.add_module_nets_between_ports(
+        top_module, bl_decoder_module, curr_bl_decoder_instance_id,
+        bl_decoder_dout_port, bl_pin_start, child_module, child_instance,
+        child_bl_port, 0, child_bl_port_info.get_width());
     }
 
     /**************************************************************
@@ -882,26 +836,15 @@ static void add_top_module_nets_cmos_ql_memory_bank_wl_decoder_config_bus(
       BasicPort child_wl_port_info =
         module_manager.module_port(child_module, child_wl_port);
 
-      size_t cur_wl_index = 0;
-
-      for (const size_t& sink_wl_pin : child_wl_port_info.pins()) {
-        size_t wl_pin_id = wl_start_index_per_tile[coord.y()] + cur_wl_index;
-        VTR_ASSERT(wl_pin_id < wl_decoder_dout_port_info.pins().size());
+      size_t wl_pin_start = wl_start_index_per_tile[coord.y()];
+      VTR_ASSERT(wl_pin_start + child_wl_port_info.get_width() <=
+                 wl_decoder_dout_port_info.get_width());
 
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, wl_decoder_module,
-          curr_wl_decoder_instance_id, wl_decoder_dout_port,
-          wl_decoder_dout_port_info.pins()[wl_pin_id]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-        /* Add net sink */
-        module_manager.add_module_net_sink(top_module, net, child_module,
-                                           child_instance, child_wl_port,
-                                           sink_wl_pin);
-
-        cur_wl_index++;
-      }
+      /* Create a net for each WL of the child */
+      module_manager.add_module_nets_between_ports(
+        top_module, wl_decoder_module, curr_wl_decoder_instance_id,
+        wl_decoder_dout_port, wl_pin_start, child_module, child_instance,
+        child_wl_port, 0, child_wl_port_info.get_width());
     }
 
     /**************************************************************
@@ -938,27 +881,15 @@ static void add_top_module_nets_cmos_ql_memory_bank_wl_decoder_config_bus(
         BasicPort child_wlr_port_info =
           module_manager.module_port(child_module, child_wlr_port);
 
-        size_t cur_wlr_index = 0;
-
-        for (const size_t& sink_wlr_pin : child_wlr_port_info.pins()) {
-          size_t wlr_pin_id =
-            wl_start_index_per_tile[coord.y()] + cur_wlr_index;
-          VTR_ASSERT(wlr_pin_id < wl_decoder_data_ren_port_info.pins().size());
-
-          /* Create net */
-          ModuleNetId net = create_module_source_pin_net(
-            module_manager, top_module, wl_decoder_module,
-            curr_wl_decoder_instance_id, wl_decoder_data_ren_port,
-            wl_decoder_data_ren_port_info.pins()[wlr_pin_id]);
-          VTR_ASSERT(ModuleNetId::INVALID() != net);
+        size_t wlr_pin_start = wl_start_index_per_tile[coord.y()];
+        VTR_ASSERT(wlr_pin_start + child_wlr_port_info.get_width() <=
+                   wl_decoder_data_ren_port_info.get_width());
 
-          /* Add net sink */
-          module_manager.add_module_net_sink(top_module, net, child_module,
-                                             child_instance, child_wlr_port,
-                                             sink_wlr_pin);
-
-          cur_wlr_index++;
-        }
+        /* Create a net for each WLR of the child */
+        module_manager.add_module_nets_between_ports(
+          top_module, wl_decoder_module, curr_wl_decoder_instance_id,
+          wl_decoder_data_ren_port, wlr_pin_start, child_module,
+          child_instance, child_wlr_port, 0, child_wlr_port_info.get_width());
       }
     }
 
@@ -1091,25 +1022,15 @@ static void add_top_module_nets_cmos_ql_memory_bank_bl_flatten_config_bus(
       BasicPort child_bl_port_info =
         module_manager.module_port(child_module, child_bl_port);
 
-      size_t cur_bl_index = 0;
-
-      for (const size_t& sink_bl_pin : child_bl_port_info.pins()) {
-        size_t bl_pin_id = bl_start_index_per_tile[coord.x()] + cur_bl_index;
-        VTR_ASSERT(bl_pin_id < top_module_bl_port_info.pins().size());
-
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, top_module, 0, top_module_bl_port,
-          top_module_bl_port_info.pins()[bl_pin_id]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
+      size_t bl_pin_start = bl_start_index_per_tile[coord.x()];
+      VTR_ASSERT(bl_pin_start + child_bl_port_info.get_width() <=
+                 top_module_bl_port_info.get_width());
 
-        /* Add net sink */
-        module_manager.add_module_net_sink(top_module, net, child_module,
-                                           child_instance, child_bl_port,
-                                           sink_bl_pin);
-
-        cur_bl_index++;
-      }
+      /* Create a net for each BL of the child */
+      module_manager.add_module_nets_between_ports(
+        top_module, top_module, 0, top_module_bl_port, bl_pin_start,
+        child_module, child_instance, child_bl_port, 0,
+        child_bl_port_info.get_width());
     }
   }
 }
@@ -1178,25 +1099,15 @@ static void add_top_module_nets_cmos_ql_memory_bank_wl_flatten_config_bus(
       BasicPort child_wl_port_info =
         module_manager.module_port(child_module, child_wl_port);
 
-      size_t cur_wl_index = 0;
-
-      for (const size_t& sink_wl_pin : child_wl_port_info.pins()) {
-        size_t wl_pin_id = wl_start_index_per_tile[coord.y()] + cur_wl_index;
-        VTR_ASSERT(wl_pin_id < top_module_wl_port_info.pins().size());
-
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, top_module, 0, top_module_wl_port,
-          top_module_wl_port_info.pins()[wl_pin_id]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-        /* Add net sink */
-        module_manager.add_module_net_sink(top_module, net, child_module,
-                                           child_instance, child_wl_port,
-                                           sink_wl_pin);
+      size_t wl_pin_start = wl_start_index_per_tile[coord.y()];
+      VTR_ASSERT(wl_pin_start + child_wl_port_info.get_width() <=
+                 top_module_wl_port_info.get_width());
 
-        cur_wl_index++;
-      }
+      /* Create a net for each WL of the child */
+      module_manager.add_module_nets_between_ports(
+        top_module, top_module, 0, top_module_wl_port, wl_pin_start,
+        child_module, child_instance, child_wl_port, 0,
+        child_wl_port_info.get_width());
     }
 
     /**************************************************************
@@ -1230,26 +1141,15 @@ static void add_top_module_nets_cmos_ql_memory_bank_wl_flatten_config_bus(
         BasicPort child_wlr_port_info =
           module_manager.module_port(child_module, child_wlr_port);
 
-        size_t cur_wlr_index = 0;
-
-        for (const size_t& sink_wlr_pin : child_wlr_port_info.pins()) {
-          size_t wlr_pin_id =
-            wl_start_index_per_tile[coord.y()] + cur_wlr_index;
-          VTR_ASSERT(wlr_pin_id < top_module_wlr_port_info.pins().size());
-
-          /* Create net */
-          ModuleNetId net = create_module_source_pin_net(
-            module_manager, top_module, top_module, 0, top_module_wlr_port,
-            top_module_wlr_port_info.pins()[wlr_pin_id]);
-          VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-          /* Add net sink */
-          module_manager.add_module_net_sink(top_module, net, child_module,
-                                             child_instance, child_wlr_port,
-                                             sink_wlr_pin);
+        size_t wlr_pin_start = wl_start_index_per_tile[coord.y()];
+        VTR_ASSERT(wlr_pin_start + child_wlr_port_info.get_width() <=
+                   top_module_wlr_port_info.get_width());
 
-          cur_wlr_index++;
-        }
+        /* Create a net for each WLR of the child */
+        module_manager.add_module_nets_between_ports(
+          top_module, top_module, 0, top_module_wlr_port, wlr_pin_start,
+          child_module, child_instance, child_wlr_port, 0,
+          child_wlr_port_info.get_width());
       }
     }
   }
@@ -1289,19 +1189,12 @@ add_top_module_nets_cmos_ql_memory_bank_bl_shift_register_bank_heads(
       BasicPort sr_module_head_port_info =
         module_manager.module_port(sr_bank_module, sr_module_head_port);
       VTR_ASSERT(sr_module_head_port_info.get_width() == 1);
-      for (size_t ipin = 0; ipin < sr_module_head_port_info.pins().size();
-           ++ipin) {
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, top_module, 0, sr_head_port,
-          sr_head_port_info.pins()[size_t(bank)]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
+      VTR_ASSERT(size_t(bank) < sr_head_port_info.get_width());
 
-        /* Add net sink */
-        module_manager.add_module_net_sink(
-          top_module, net, sr_bank_module, sr_bank_instance,
-          sr_module_head_port, sr_module_head_port_info.pins()[ipin]);
-      }
+      /* Create net */
+      module_manager.add_module_nets_between_ports(
+        top_module, top_module, 0, sr_head_port, size_t(bank), sr_bank_module,
+        sr_bank_instance, sr_module_head_port, 0, 1);
     }
   }
 }
@@ -1340,19 +1233,12 @@ add_top_module_nets_cmos_ql_memory_bank_wl_shift_register_bank_heads(
       BasicPort sr_module_head_port_info =
         module_manager.module_port(sr_bank_module, sr_module_head_port);
       VTR_ASSERT(sr_module_head_port_info.get_width() == 1);
-      for (size_t ipin = 0; ipin < sr_module_head_port_info.pins().size();
-           ++ipin) {
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, top_module, 0, sr_head_port,
-          sr_head_port_info.pins()[size_t(bank)]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
+      VTR_ASSERT(size_t(bank) < sr_head_port_info.get_width());
 
-        /* Add net sink */
-        module_manager.add_module_net_sink(
-          top_module, net, sr_bank_module, sr_bank_instance,
-          sr_module_head_port, sr_module_head_port_info.pins()[ipin]);
-      }
+      /* Create net */
+      module_manager.add_module_nets_between_ports(
+        top_module, top_module, 0, sr_head_port, size_t(bank), sr_bank_module,
+        sr_bank_instance, sr_module_head_port, 0, 1);
     }
   }
 }
@@ -1389,19 +1275,12 @@ add_top_module_nets_cmos_ql_memory_bank_bl_shift_register_bank_tails(
       BasicPort sr_module_tail_port_info =
         module_manager.module_port(sr_bank_module, sr_module_tail_port);
       VTR_ASSERT(sr_module_tail_port_info.get_width() == 1);
-      for (size_t ipin = 0; ipin < sr_module_tail_port_info.pins().size();
-           ++ipin) {
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, sr_bank_module, sr_bank_instance,
-          sr_module_tail_port, sr_module_tail_port_info.pins()[ipin]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
+      VTR_ASSERT(size_t(bank) < sr_tail_port_info.get_width());
 
-        /* Add net sink */
-        module_manager.add_module_net_sink(
-          top_module, net, top_module, 0, sr_tail_port,
-          sr_tail_port_info.pins()[size_t(bank)]);
-      }
+      /* Create net */
+      module_manager.add_module_nets_between_ports(
+        top_module, sr_bank_module, sr_bank_instance, sr_module_tail_port, 0,
+        top_module, 0, sr_tail_port, size_t(bank), 1);
     }
   }
 }
@@ -1438,19 +1317,12 @@ add_top_module_nets_cmos_ql_memory_bank_wl_shift_register_bank_tails(
       BasicPort sr_module_tail_port_info =
         module_manager.module_port(sr_bank_module, sr_module_tail_port);
       VTR_ASSERT(sr_module_tail_port_info.get_width() == 1);
-      for (size_t ipin = 0; ipin < sr_module_tail_port_info.pins().size();
-           ++ipin) {
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, sr_bank_module, sr_bank_instance,
-          sr_module_tail_port, sr_module_tail_port_info.pins()[ipin]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
+      VTR_ASSERT(size_t(bank) < sr_tail_port_info.get_width());
 
-        /* Add net sink */
-        module_manager.add_module_net_sink(
-          top_module, net, top_module, 0, sr_tail_port,
-          sr_tail_port_info.pins()[size_t(bank)]);
-      }
+      /* Create net */
+      module_manager.add_module_nets_between_ports(
+        top_module, sr_bank_module, sr_bank_instance, sr_module_tail_port, 0,
+        top_module, 0, sr_tail_port, size_t(bank), 1);
     }
   }
 }
@@ -2233,17 +2105,58 @@ int load_top_module_shift_register_banks_from_fabric_key(
   return 0;
 }
 
+/********************************************************************
+ * Find the sizes of the shift register banks of a region
+ * - By default, the BLs/WLs are evenly distributed to the given number of
+ *   banks, while the last bank takes all the residual BLs/WLs
+ * - When a maximum bank size is given, banks are added until no bank
+ *   exceeds the size, and the BLs/WLs are balanced among the banks, so
+ *   that the sizes of any two banks differ by at most 1. Since all the banks
+ *   shift in parallel, the longest bank limits the programming speed
+ ********************************************************************/
+static std::vector<size_t> plan_memory_bank_shift_register_bank_sizes(
+  const size_t& num_lines, const size_t& num_banks,
+  const size_t& max_bank_size) {
+  std::vector<size_t> bank_sizes;
+  if (0 == max_bank_size) {
+    size_t regular_sr_bank_size = num_lines / num_banks;
+    for (size_t ibank = 0; ibank < num_banks; ++ibank) {
+      /* For last bank, use all the residual sizes */
+      if (ibank == num_banks - 1) {
+        bank_sizes.push_back(num_lines - ibank * regular_sr_bank_size);
+      } else {
+        bank_sizes.push_back(regular_sr_bank_size);
+      }
+    }
+    return bank_sizes;
+  }
+
+  size_t num_planned_banks = std::max(
+    num_banks, (num_lines + max_bank_size - 1) / max_bank_size);
+  /* No bank should be empty */
+  num_planned_banks =
+    std::max(size_t(1), std::min(num_planned_banks, num_lines));
+  for (size_t ibank = 0; ibank < num_planned_banks; ++ibank) {
+    bank_sizes.push_back(num_lines / num_planned_banks +
+                         (ibank < num_lines % num_planned_banks ? 1 : 0));
+  }
+  return bank_sizes;
+}
+
 /********************************************************************
  * @brief This functions synchronize the settings in configuration protocol
  *(from architecture description) and the existing information (loaded from
  *fabric key files)
+ * The expected number of configuration clock cycles is reported in the same
+ *way as the full testbench, i.e., one cycle to reset plus one cycle per WL,
+ *while each programming cycle shifts the longest bank
  * @note This function should be called AFTER
  *load_top_module_shift_register_banks_from_fabric_key()
  ********************************************************************/
 void sync_memory_bank_shift_register_banks_with_config_protocol_settings(
   ModuleManager& module_manager, MemoryBankShiftRegisterBanks& blwl_sr_banks,
   const ConfigProtocol& config_protocol, const ModuleId& top_module,
-  const CircuitLibrary& circuit_lib) {
+  const CircuitLibrary& circuit_lib, const size_t& max_bank_size) {
   /* ONLY synchronize when the configuration protocol is memory bank using shift
    * registers */
   if (CONFIG_MEM_QL_MEMORY_BANK != config_protocol.type() ||
@@ -2255,6 +2168,11 @@ void sync_memory_bank_shift_register_banks_with_config_protocol_settings(
   /* Fabric key has a higher priority in defining the shift register bank
    * organization */
   if (!blwl_sr_banks.empty()) {
+    if (0 < max_bank_size) {
+      VTR_LOG_WARN(
+        "Shift register banks are defined by the fabric key. The maximum "
+        "size of banks is ignored!\n");
+    }
     return;
   }
 
@@ -2264,22 +2182,22 @@ void sync_memory_bank_shift_register_banks_with_config_protocol_settings(
    * use the settings from the configuration protocol */
   blwl_sr_banks.resize_regions(module_manager.regions(top_module).size());
 
-  /* Based on the number of shift register banks, evenly distribute the BLs in
-   * each region for each shift register bank */
+  size_t max_bl_bank_size = 0;
+  size_t max_wl_bank_size = 0;
+  size_t max_num_wls = 0;
+
+  /* Based on the number of shift register banks, distribute the BLs in each
+   * region for each shift register bank */
   for (const auto& config_region : module_manager.regions(top_module)) {
     size_t num_bls = compute_memory_bank_regional_num_bls(
       module_manager, top_module, config_region, circuit_lib, sram_model);
-    size_t num_bl_banks = config_protocol.bl_num_banks();
-    blwl_sr_banks.reserve_bl_shift_register_banks(config_region, num_bl_banks);
+    std::vector<size_t> bank_sizes = plan_memory_bank_shift_register_bank_sizes(
+      num_bls, config_protocol.bl_num_banks(), max_bank_size);
+    blwl_sr_banks.reserve_bl_shift_register_banks(config_region,
+                                                  bank_sizes.size());
 
-    size_t regular_sr_bank_size = num_bls / num_bl_banks;
     size_t cur_bl_index = 0;
-    for (size_t ibank = 0; ibank < num_bl_banks; ++ibank) {
-      /* For last bank, use all the residual sizes */
-      size_t cur_sr_bank_size = regular_sr_bank_size;
-      if (ibank == num_bl_banks - 1) {
-        cur_sr_bank_size = num_bls - ibank * regular_sr_bank_size;
-      }
+    for (const size_t& cur_sr_bank_size : bank_sizes) {
       /* Create a bank and assign data ports */
       FabricBitLineBankId bank =
         blwl_sr_banks.create_bl_shift_register_bank(config_region);
@@ -2290,27 +2208,24 @@ void sync_memory_bank_shift_register_banks_with_config_protocol_settings(
 
       /* Increment the bl index */
       cur_bl_index += cur_sr_bank_size;
+      max_bl_bank_size = std::max(max_bl_bank_size, cur_sr_bank_size);
     }
 
     VTR_ASSERT(cur_bl_index == num_bls);
   }
 
-  /* Based on the number of shift register banks, evenly distribute the WLs in
-   * each region for each shift register bank */
+  /* Based on the number of shift register banks, distribute the WLs in each
+   * region for each shift register bank */
   for (const auto& config_region : module_manager.regions(top_module)) {
     size_t num_wls = compute_memory_bank_regional_num_wls(
       module_manager, top_module, config_region, circuit_lib, sram_model);
-    size_t num_wl_banks = config_protocol.wl_num_banks();
-    blwl_sr_banks.reserve_wl_shift_register_banks(config_region, num_wl_banks);
+    std::vector<size_t> bank_sizes = plan_memory_bank_shift_register_bank_sizes(
+      num_wls, config_protocol.wl_num_banks(), max_bank_size);
+    blwl_sr_banks.reserve_wl_shift_register_banks(config_region,
+                                                  bank_sizes.size());
 
-    size_t regular_sr_bank_size = num_wls / num_wl_banks;
     size_t cur_wl_index = 0;
-    for (size_t ibank = 0; ibank < num_wl_banks; ++ibank) {
-      /* For last bank, use all the residual sizes */
-      size_t cur_sr_bank_size = regular_sr_bank_size;
-      if (ibank == num_wl_banks - 1) {
-        cur_sr_bank_size = num_wls - ibank * regular_sr_bank_size;
-      }
+    for (const size_t& cur_sr_bank_size : bank_sizes) {
       /* Create a bank and assign data ports */
       FabricWordLineBankId bank =
         blwl_sr_banks.create_wl_shift_register_bank(config_region);
@@ -2321,10 +2236,21 @@ void sync_memory_bank_shift_register_banks_with_config_protocol_settings(
 
       /* Increment the bl index */
       cur_wl_index += cur_sr_bank_size;
+      max_wl_bank_size = std::max(max_wl_bank_size, cur_sr_bank_size);
     }
 
     VTR_ASSERT(cur_wl_index == num_wls);
+    max_num_wls = std::max(max_num_wls, num_wls);
   }
+
+  /* The full testbench clocks the shift registers by (longest bank + 2)
+   * cycles in each programming cycle */
+  VTR_LOG(
+    "Longest shift register banks have %lu BLs and %lu WLs. Expect %lu "
+    "configuration clock cycles, each of which requires %lu shift register "
+    "clock cycles\n",
+    max_bl_bank_size, max_wl_bank_size, 1 + max_num_wls,
+    std::max(max_bl_bank_size, max_wl_bank_size) + 2);
 }
 
 } /* end namespace openfpga */
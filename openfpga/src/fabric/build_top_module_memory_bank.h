@@ -43,7 +43,7 @@ int load_top_module_shift_register_banks_from_fabric_key(
 void sync_memory_bank_shift_register_banks_with_config_protocol_settings(
   ModuleManager& module_manager, MemoryBankShiftRegisterBanks& blwl_sr_banks,
   const ConfigProtocol& config_protocol, const ModuleId& top_module,
-  const CircuitLibrary& circuit_lib);
+  const CircuitLibrary& circuit_lib, const size_t& max_bank_size);
 
 } /* end namespace openfpga */
 
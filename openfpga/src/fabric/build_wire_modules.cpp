@@ -10,6 +10,9 @@
 #include "vtr_log.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_trace.h"
+
 /* Device-level header files */
 #include "build_wire_modules.h"
 #include "module_manager.h"
@@ -60,6 +63,7 @@ static void build_wire_module(ModuleManager& module_manager,
 void build_wire_modules(ModuleManager& module_manager,
                         const CircuitLibrary& circuit_lib) {
   vtr::ScopedStartFinishTimer timer("Build wire modules");
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Print Verilog models for regular wires*/
   for (const auto& wire_model :
@@ -0,0 +1,215 @@
+/******************************************************************************
+ * This file includes member functions for data structure ConfigChildHierarchy
+ ******************************************************************************/
+#include "config_child_hierarchy.h"
+
+#include "vtr_assert.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/**************************************************
+ * Public Aggregators
+ *************************************************/
+ModuleId ConfigChildHierarchy::top_module() const { return top_module_; }
+
+size_t ConfigChildHierarchy::num_nodes() const { return node_ids_.size(); }
+
+ConfigChildHierarchy::node_range ConfigChildHierarchy::nodes() const {
+  return vtr::make_range(node_ids_.begin(), node_ids_.end());
+}
+
+ConfigChildHierarchy::node_range ConfigChildHierarchy::region_nodes(
+  const ConfigRegionId& region) const {
+  if ((size_t(region) >= region_node_ranges_.size()) ||
+      (false == region_node_ranges_[region].first.is_valid())) {
+    return vtr::make_range(node_ids_.end(), node_ids_.end());
+  }
+  return vtr::make_range(
+    node_ids_.begin() + size_t(region_node_ranges_[region].first),
+    node_ids_.begin() + size_t(region_node_ranges_[region].second));
+}
+
+size_t ConfigChildHierarchy::num_bits() const { return num_bits_; }
+
+/**************************************************
+ * Public Accessors
+ *************************************************/
+ModuleId ConfigChildHierarchy::node_module(
+  const ConfigChildNodeId& node) const {
+  VTR_ASSERT(true == valid_node_id(node));
+  return node_modules_[node];
+}
+
+size_t ConfigChildHierarchy::node_instance(
+  const ConfigChildNodeId& node) const {
+  VTR_ASSERT(true == valid_node_id(node));
+  return node_instances_[node];
+}
+
+ConfigChildNodeId ConfigChildHierarchy::node_parent(
+  const ConfigChildNodeId& node) const {
+  VTR_ASSERT(true == valid_node_id(node));
+  return node_parents_[node];
+}
+
+size_t ConfigChildHierarchy::node_depth(const ConfigChildNodeId& node) const {
+  VTR_ASSERT(true == valid_node_id(node));
+  return node_depths_[node];
+}
+
+ConfigRegionId ConfigChildHierarchy::node_region(
+  const ConfigChildNodeId& node) const {
+  VTR_ASSERT(true == valid_node_id(node));
+  return node_regions_[node];
+}
+
+ConfigChildNodeId ConfigChildHierarchy::node_subtree_end(
+  const ConfigChildNodeId& node) const {
+  VTR_ASSERT(true == valid_node_id(node));
+  return node_subtree_ends_[node];
+}
+
+bool ConfigChildHierarchy::node_is_leaf(const ConfigChildNodeId& node) const {
+  VTR_ASSERT(true == valid_node_id(node));
+  return size_t(node_subtree_ends_[node]) == size_t(node) + 1;
+}
+
+std::string ConfigChildHierarchy::node_name(
+  const ConfigChildNodeId& node) const {
+  std::string name;
+  append_node_name(name, node);
+  return name;
+}
+
+void ConfigChildHierarchy::append_node_name(
+  std::string& path, const ConfigChildNodeId& node) const {
+  VTR_ASSERT(true == valid_node_id(node));
+  path.append(names_, name_offsets_[size_t(node)], node_name_length(node));
+}
+
+size_t ConfigChildHierarchy::node_path_offset(
+  const ConfigChildNodeId& node) const {
+  VTR_ASSERT(true == valid_node_id(node));
+  return node_path_offsets_[node];
+}
+
+size_t ConfigChildHierarchy::node_bit_begin(
+  const ConfigChildNodeId& node) const {
+  VTR_ASSERT(true == valid_node_id(node));
+  return node_bit_begins_[node];
+}
+
+size_t ConfigChildHierarchy::node_bit_end(
+  const ConfigChildNodeId& node) const {
+  VTR_ASSERT(true == valid_node_id(node));
+  return node_bit_ends_[node];
+}
+
+/**************************************************
+ * Internal Accessors
+ *************************************************/
+size_t ConfigChildHierarchy::node_name_length(
+  const ConfigChildNodeId& node) const {
+  size_t name_end = size_t(node) + 1 < name_offsets_.size()
+                      ? name_offsets_[size_t(node) + 1]
+                      : names_.size();
+  return name_end - name_offsets_[size_t(node)];
+}
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
+void ConfigChildHierarchy::set_top_module(const ModuleId& top_module) {
+  top_module_ = top_module;
+}
+
+ConfigChildNodeId ConfigChildHierarchy::add_node(
+  const ModuleId& module, const size_t& instance, const std::string& name,
+  const ConfigChildNodeId& parent, const ConfigRegionId& region) {
+  ConfigChildNodeId node = ConfigChildNodeId(node_ids_.size());
+
+  size_t depth = 0;
+  size_t path_offset = 0;
+  if (true == parent.is_valid()) {
+    VTR_ASSERT(true == valid_node_id(parent));
+    /* The subtree of the parent must be open */
+    VTR_ASSERT(false == node_subtree_ends_[parent].is_valid());
+    depth = node_depths_[parent] + 1;
+    path_offset = node_path_offsets_[parent] + node_name_length(parent) + 1;
+  } else {
+    /* The children of the top-level module of a region are consecutive */
+    if (size_t(region) >= region_node_ranges_.size()) {
+      region_node_ranges_.resize(
+        size_t(region) + 1,
+        std::make_pair(ConfigChildNodeId::INVALID(),
+                       ConfigChildNodeId::INVALID()));
+    }
+    std::pair<ConfigChildNodeId, ConfigChildNodeId>& range =
+      region_node_ranges_[region];
+    if (false == range.first.is_valid()) {
+      range.first = node;
+    } else {
+      VTR_ASSERT(range.second == node);
+    }
+  }
+
+  node_ids_.push_back(node);
+  node_modules_.push_back(module);
+  node_instances_.push_back(instance);
+  node_parents_.push_back(parent);
+  node_depths_.push_back(depth);
+  node_regions_.push_back(region);
+  node_subtree_ends_.push_back(ConfigChildNodeId::INVALID());
+  node_path_offsets_.push_back(path_offset);
+  node_bit_begins_.push_back(num_bits_);
+  node_bit_ends_.push_back(num_bits_);
+  name_offsets_.push_back(names_.size());
+  names_ += name;
+
+  return node;
+}
+
+void ConfigChildHierarchy::close_node(const ConfigChildNodeId& node) {
+  VTR_ASSERT(true == valid_node_id(node));
+  VTR_ASSERT(false == node_subtree_ends_[node].is_valid());
+  node_subtree_ends_[node] = ConfigChildNodeId(node_ids_.size());
+  /* A leaf is a configuration bit */
+  if (true == node_is_leaf(node)) {
+    num_bits_++;
+  }
+  node_bit_ends_[node] = num_bits_;
+  if (false == node_parents_[node].is_valid()) {
+    region_node_ranges_[node_regions_[node]].second =
+      node_subtree_ends_[node];
+  }
+}
+
+void ConfigChildHierarchy::clear() {
+  top_module_ = ModuleId::INVALID();
+  node_ids_.clear();
+  node_modules_.clear();
+  node_instances_.clear();
+  node_parents_.clear();
+  node_depths_.clear();
+  node_regions_.clear();
+  node_subtree_ends_.clear();
+  node_path_offsets_.clear();
+  node_bit_begins_.clear();
+  node_bit_ends_.clear();
+  names_.clear();
+  name_offsets_.clear();
+  region_node_ranges_.clear();
+  num_bits_ = 0;
+}
+
+/**************************************************
+ * Public Validators
+ *************************************************/
+bool ConfigChildHierarchy::valid_node_id(const ConfigChildNodeId& node) const {
+  return (size_t(node) < node_ids_.size()) && (node == node_ids_[node]);
+}
+
+bool ConfigChildHierarchy::empty() const { return node_ids_.empty(); }
+
+} /* end namespace openfpga */
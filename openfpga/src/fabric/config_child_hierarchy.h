@@ -0,0 +1,128 @@
+#ifndef CONFIG_CHILD_HIERARCHY_H
+#define CONFIG_CHILD_HIERARCHY_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "module_manager.h"
+#include "vtr_range.h"
+#include "vtr_strong_id.h"
+#include "vtr_vector.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+struct config_child_node_id_tag;
+typedef vtr::StrongId<config_child_node_id_tag> ConfigChildNodeId;
+
+/******************************************************************************
+ * A flattened tree of the configurable children of a top-level module, so
+ * that the writers and the bitstream builders, which walk through the same
+ * tree, make a linear pass instead of their own recursion.
+ *
+ * Each node is an instance of a configurable child under its parent. Nodes
+ * are stored in preorder, i.e., a node is followed by the nodes of its
+ * subtree, which end at node_subtree_end(). The children of the top-level
+ * module are sorted by configuration regions, and the nodes of a region are
+ * consecutive. Decoders, which are configurable children but control the
+ * other children, are not included, so that the leaves are the memory cells.
+ *
+ * The path of a node is the names of the instances from the top-level module
+ * to the node, each followed by a separator of one character, e.g., '/' or
+ * '.'. A node only stores its name and the length of the path of its parent,
+ * so that a walker builds the paths in a single buffer:
+ *
+ *   for (const ConfigChildNodeId& node : hierarchy.nodes()) {
+ *     path.resize(prefix_length + hierarchy.node_path_offset(node));
+ *     hierarchy.append_node_name(path, node);
+ *     path.push_back('/');
+ *   }
+ *
+ * Each leaf is a configuration bit. The bits of a node are the leaves of its
+ * subtree, as a range [begin, end) of the leaves counted in preorder.
+ *
+ * @note The hierarchy should be rebuilt when the module graph is rebuilt
+ ******************************************************************************/
+class ConfigChildHierarchy {
+ public: /* Types and ranges */
+  typedef vtr::vector<ConfigChildNodeId, ConfigChildNodeId>::const_iterator
+    node_iterator;
+  typedef vtr::Range<node_iterator> node_range;
+
+ public: /* Public aggregators */
+  ModuleId top_module() const;
+  size_t num_nodes() const;
+  /* All the nodes in preorder */
+  node_range nodes() const;
+  /* The nodes of a configuration region in preorder */
+  node_range region_nodes(const ConfigRegionId& region) const;
+  /* The number of leaves, i.e., configuration bits */
+  size_t num_bits() const;
+
+ public: /* Public accessors */
+  ModuleId node_module(const ConfigChildNodeId& node) const;
+  size_t node_instance(const ConfigChildNodeId& node) const;
+  /* The parent node, which is invalid for a child of the top-level module */
+  ConfigChildNodeId node_parent(const ConfigChildNodeId& node) const;
+  /* The depth of a node, where the children of the top-level module are 0 */
+  size_t node_depth(const ConfigChildNodeId& node) const;
+  ConfigRegionId node_region(const ConfigChildNodeId& node) const;
+  /* The node next to the subtree of a node in preorder, which is the number
+   * of nodes when the subtree is the last one */
+  ConfigChildNodeId node_subtree_end(const ConfigChildNodeId& node) const;
+  bool node_is_leaf(const ConfigChildNodeId& node) const;
+  /* The instance name of a node, or the default name when the instance is not
+   * named, see append_instance_name() */
+  std::string node_name(const ConfigChildNodeId& node) const;
+  void append_node_name(std::string& path, const ConfigChildNodeId& node) const;
+  /* The length of the path of the parent node */
+  size_t node_path_offset(const ConfigChildNodeId& node) const;
+  /* The range [begin, end) of the configuration bits of a node */
+  size_t node_bit_begin(const ConfigChildNodeId& node) const;
+  size_t node_bit_end(const ConfigChildNodeId& node) const;
+
+ public: /* Public mutators */
+  void set_top_module(const ModuleId& top_module);
+  /* Add a node as the last child of its parent, which must be the last node
+   * whose subtree is not closed. Nodes must be added in preorder */
+  ConfigChildNodeId add_node(const ModuleId& module, const size_t& instance,
+                             const std::string& name,
+                             const ConfigChildNodeId& parent,
+                             const ConfigRegionId& region);
+  /* Close the subtree of a node once all its descendants are added */
+  void close_node(const ConfigChildNodeId& node);
+  void clear();
+
+ public: /* Public validators */
+  bool valid_node_id(const ConfigChildNodeId& node) const;
+  bool empty() const;
+
+ private: /* Internal accessors */
+  size_t node_name_length(const ConfigChildNodeId& node) const;
+
+ private: /* Internal data */
+  ModuleId top_module_;
+  vtr::vector<ConfigChildNodeId, ConfigChildNodeId> node_ids_;
+  vtr::vector<ConfigChildNodeId, ModuleId> node_modules_;
+  vtr::vector<ConfigChildNodeId, size_t> node_instances_;
+  vtr::vector<ConfigChildNodeId, ConfigChildNodeId> node_parents_;
+  vtr::vector<ConfigChildNodeId, size_t> node_depths_;
+  vtr::vector<ConfigChildNodeId, ConfigRegionId> node_regions_;
+  vtr::vector<ConfigChildNodeId, ConfigChildNodeId> node_subtree_ends_;
+  vtr::vector<ConfigChildNodeId, size_t> node_path_offsets_;
+  vtr::vector<ConfigChildNodeId, size_t> node_bit_begins_;
+  vtr::vector<ConfigChildNodeId, size_t> node_bit_ends_;
+  /* Names of all the nodes, packed in a single buffer, where the name of a
+   * node starts at its offset and ends at the offset of the next node */
+  std::string names_;
+  std::vector<size_t> name_offsets_;
+  /* Nodes [begin, end) of each region */
+  vtr::vector<ConfigRegionId, std::pair<ConfigChildNodeId, ConfigChildNodeId>>
+    region_node_ranges_;
+  size_t num_bits_ = 0;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,265 @@
+/********************************************************************
+ * This file includes functions to save the fabric built by build_fabric
+ * into a binary image and to restore it in another run.
+ * Building the module graph is one of the most time-consuming steps of
+ * the flow, while its results only depend on the device and the
+ * architecture. When neither of them is changed between runs, e.g.,
+ * when implementing different benchmarks on the same FPGA, the fabric
+ * can be restored from the image instead of being built again.
+ *
+ * The image is organized as follows:
+ * - A magic header, a format version and the size of a size_t, which
+ *   identify an image written on the same kind of machine
+ * - The digest of the device and the architecture
+ * - Whether the routing hierarchy is compressed and whether the fabric is
+ *   built for bitstream generation only
+ * - The module graph, the decoder library, the BL/WL shift register
+ *   banks, the I/O location map and the global ports, in this order
+ *******************************************************************/
+#include "fabric_binary_image.h"
+
+#include <cstring>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_error.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_binary_image.h"
+#include "openfpga_digest.h"
+#include "openfpga_naming.h"
+#include "openfpga_trace.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Magic header and version of the image.
+ * Increase the version when the data of any object in the image is changed */
+constexpr const char* FABRIC_BINARY_IMAGE_MAGIC = "OFPGAFAB";
+constexpr size_t FABRIC_BINARY_IMAGE_MAGIC_SIZE = 8;
+constexpr uint32_t FABRIC_BINARY_IMAGE_VERSION = 5;
+
+/********************************************************************
+ * Mix a value into a 64-bit FNV-1a digest
+ *******************************************************************/
+static void digest_value(uint64_t& digest, const uint64_t& value) {
+  for (size_t ibyte = 0; ibyte < sizeof(value); ++ibyte) {
+    digest ^= (value >> (8 * ibyte)) & 0xff;
+    digest *= 0x100000001b3ULL;
+  }
+}
+
+static void digest_string(uint64_t& digest, const std::string& str) {
+  digest_value(digest, str.size());
+  for (const char& c : str) {
+    digest ^= static_cast<unsigned char>(c);
+    digest *= 0x100000001b3ULL;
+  }
+}
+
+/********************************************************************
+ * Compute a digest which identifies the inputs of the fabric, i.e., the
+ * routing architecture (given by the digest of the GSB array, which
+ * includes the order of the incoming edges of each GSB, as it sets the
+ * order of the multiplexer inputs), the size of the grid, the circuit
+ * models and the configuration protocol.
+ * The digest only protects against reusing an image on a different
+ * device by mistake. It does not cover the options of build_fabric.
+ *******************************************************************/
+uint64_t compute_fabric_binary_image_digest(
+  const uint64_t& device_rr_gsb_digest, const DeviceGrid& grids,
+  const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol) {
+  uint64_t digest = 0xcbf29ce484222325ULL;
+
+  digest_value(digest, device_rr_gsb_digest);
+  digest_value(digest, grids.width());
+  digest_value(digest, grids.height());
+
+  digest_value(digest, circuit_lib.num_models());
+  for (const CircuitModelId& model : circuit_lib.models()) {
+    digest_string(digest, circuit_lib.model_name(model));
+    digest_value(digest, circuit_lib.model_type(model));
+    for (const CircuitPortId& port : circuit_lib.model_ports(model)) {
+      digest_string(digest, circuit_lib.port_prefix(port));
+      digest_value(digest, circuit_lib.port_type(port));
+      digest_value(digest, circuit_lib.port_size(port));
+    }
+  }
+
+  digest_value(digest, config_protocol.type());
+  digest_value(digest, config_protocol.num_regions());
+
+  return digest;
+}
+
+/********************************************************************
+ * Write the fabric to a binary image
+ *******************************************************************/
+int write_fabric_binary_image(
+  const std::string& fname, const uint64_t& digest,
+  const bool& compress_routing, const bool& bitstream_only,
+  const bool& gsb_nets_deferred, const bool& duplicate_grid_pin,
+  const ModuleManager& module_manager,
+  const DecoderLibrary& decoder_lib,
+  const MemoryBankShiftRegisterBanks& blwl_sr_banks,
+  const IoLocationMap& io_location_map,
+  const FabricGlobalPortInfo& global_ports, const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Write fabric to binary image");
+  OPENFPGA_TRACE_FUNCTION();
+
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output the fabric image!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::string dir_path = format_dir_path(find_path_dir_name(fname));
+  create_directory(dir_path);
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::binary |
+                   std::fstream::trunc);
+  if (false == valid_file_stream(fp)) {
+    VTR_LOG_ERROR("Unable to open fabric image '%s' for writing!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  BinaryImageWriter writer(fp);
+  writer.write_bytes(FABRIC_BINARY_IMAGE_MAGIC,
+                     FABRIC_BINARY_IMAGE_MAGIC_SIZE);
+  write_binary_image(writer, FABRIC_BINARY_IMAGE_VERSION);
+  write_binary_image(writer, static_cast<uint32_t>(sizeof(size_t)));
+  write_binary_image(writer, digest);
+  write_binary_image(writer, compress_routing);
+  write_binary_image(writer, bitstream_only);
+  write_binary_image(writer, gsb_nets_deferred);
+  write_binary_image(writer, duplicate_grid_pin);
+
+  module_manager.write_to_binary_image(writer);
+  decoder_lib.write_to_binary_image(writer);
+  blwl_sr_banks.write_to_binary_image(writer);
+  io_location_map.write_to_binary_image(writer);
+  global_ports.write_to_binary_image(writer);
+
+  fp.close();
+  if (false == valid_file_stream(fp)) {
+    VTR_LOG_ERROR("Fail to write fabric image '%s'!\n", fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  VTR_LOGV(verbose, "Wrote fabric image to '%s' (digest=0x%016lx)\n",
+           fname.c_str(), digest);
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Restore the fabric from a binary image
+ * The image must match the given digest. The objects are only replaced
+ * when the whole image has been read successfully.
+ *******************************************************************/
+int read_fabric_binary_image(const std::string& fname, const uint64_t& digest,
+                             bool& compress_routing, bool& bitstream_only,
+                             bool& gsb_nets_deferred, bool& duplicate_grid_pin,
+                             ModuleManager& module_manager,
+                             DecoderLibrary& decoder_lib,
+                             MemoryBankShiftRegisterBanks& blwl_sr_banks,
+                             IoLocationMap& io_location_map,
+                             FabricGlobalPortInfo& global_ports,
+                             const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Read fabric from binary image");
+  OPENFPGA_TRACE_FUNCTION();
+
+  ModuleManager image_module_manager;
+  DecoderLibrary image_decoder_lib;
+  MemoryBankShiftRegisterBanks image_blwl_sr_banks;
+  IoLocationMap image_io_location_map;
+  FabricGlobalPortInfo image_global_ports;
+  bool image_compress_routing = false;
+  bool image_bitstream_only = false;
+  bool image_gsb_nets_deferred = false;
+  bool image_duplicate_grid_pin = false;
+
+  try {
+    BinaryImageReader reader(fname);
+
+    char magic[FABRIC_BINARY_IMAGE_MAGIC_SIZE];
+    uint32_t version = 0;
+    uint32_t size_of_size_t = 0;
+    uint64_t image_digest = 0;
+    reader.read_bytes(magic, FABRIC_BINARY_IMAGE_MAGIC_SIZE);
+    if (0 != std::memcmp(magic, FABRIC_BINARY_IMAGE_MAGIC,
+                         FABRIC_BINARY_IMAGE_MAGIC_SIZE)) {
+      VTR_LOG_ERROR("Invalid fabric image '%s'!\n", fname.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    read_binary_image(reader, version);
+    read_binary_image(reader, size_of_size_t);
+    if ((FABRIC_BINARY_IMAGE_VERSION != version) ||
+        (sizeof(size_t) != size_of_size_t)) {
+      VTR_LOG_ERROR(
+        "Fabric image '%s' is written by an incompatible version or "
+        "machine!\n",
+        fname.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    read_binary_image(reader, image_digest);
+    if (digest != image_digest) {
+      VTR_LOG_ERROR(
+        "Fabric image '%s' is built for another device, architecture or "
+        "order of the incoming edges of GSBs (digest=0x%016lx while expect "
+        "0x%016lx)!\n",
+        fname.c_str(), image_digest, digest);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    read_binary_image(reader, image_compress_routing);
+    read_binary_image(reader, image_bitstream_only);
+    read_binary_image(reader, image_gsb_nets_deferred);
+    read_binary_image(reader, image_duplicate_grid_pin);
+
+    image_module_manager.read_from_binary_image(reader);
+    image_decoder_lib.read_from_binary_image(reader);
+    image_blwl_sr_banks.read_from_binary_image(reader);
+    image_io_location_map.read_from_binary_image(reader);
+    image_global_ports.read_from_binary_image(reader);
+
+    if (0 != reader.num_remaining_bytes()) {
+      VTR_LOG_ERROR("Unexpected data at the end of fabric image '%s'!\n",
+                    fname.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  } catch (const vtr::VtrError& error) {
+    VTR_LOG_ERROR("%s", error.what());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* The fast lookup of the global ports is not stored in the image */
+  ModuleId top_module =
+    image_module_manager.find_module(generate_fpga_top_module_name());
+  if (true == image_module_manager.valid_module_id(top_module)) {
+    image_global_ports.build_fast_lookup(image_module_manager, top_module);
+  }
+
+  module_manager = std::move(image_module_manager);
+  decoder_lib = std::move(image_decoder_lib);
+  blwl_sr_banks = std::move(image_blwl_sr_banks);
+  io_location_map = std::move(image_io_location_map);
+  global_ports = std::move(image_global_ports);
+  compress_routing = image_compress_routing;
+  bitstream_only = image_bitstream_only;
+  gsb_nets_deferred = image_gsb_nets_deferred;
+  duplicate_grid_pin = image_duplicate_grid_pin;
+
+  VTR_LOGV(verbose, "Read fabric image from '%s' (digest=0x%016lx)\n",
+           fname.c_str(), digest);
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,52 @@
+#ifndef FABRIC_BINARY_IMAGE_H
+#define FABRIC_BINARY_IMAGE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstdint>
+#include <string>
+
+#include "circuit_library.h"
+#include "config_protocol.h"
+#include "decoder_library.h"
+#include "device_grid.h"
+#include "fabric_global_port_info.h"
+#include "io_location_map.h"
+#include "memory_bank_shift_register_banks.h"
+#include "module_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+uint64_t compute_fabric_binary_image_digest(
+  const uint64_t& device_rr_gsb_digest, const DeviceGrid& grids,
+  const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol);
+
+int write_fabric_binary_image(
+  const std::string& fname, const uint64_t& digest,
+  const bool& compress_routing, const bool& bitstream_only,
+  const bool& gsb_nets_deferred, const bool& duplicate_grid_pin,
+  const ModuleManager& module_manager,
+  const DecoderLibrary& decoder_lib,
+  const MemoryBankShiftRegisterBanks& blwl_sr_banks,
+  const IoLocationMap& io_location_map,
+  const FabricGlobalPortInfo& global_ports, const bool& verbose);
+
+int read_fabric_binary_image(const std::string& fname, const uint64_t& digest,
+                             bool& compress_routing, bool& bitstream_only,
+                             bool& gsb_nets_deferred, bool& duplicate_grid_pin,
+                             ModuleManager& module_manager,
+                             DecoderLibrary& decoder_lib,
+                             MemoryBankShiftRegisterBanks& blwl_sr_banks,
+                             IoLocationMap& io_location_map,
+                             FabricGlobalPortInfo& global_ports,
+                             const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,277 @@
+/********************************************************************
+ * This file includes functions to find what has been edited in the
+ * inputs of build_fabric since a previous run, so that the fabric of the
+ * previous run can be reused when nothing has been edited.
+ *
+ * The digests of a run are stored in a text file next to the image of
+ * its fabric, with one digest per line:
+ *   device <digest>
+ *   others <digest>
+ *   tile_annotation <digest>
+ *   circuit_model <name> <digest>
+ * where each digest is a hexadecimal number
+ *******************************************************************/
+#include "fabric_build_digest.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+#include "vtr_vector.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_binary_image.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Write the content of a file, or nothing if the file cannot be read
+ *******************************************************************/
+static void write_file_content_to_binary_image(BinaryImageWriter& writer,
+                                               const std::string& fname) {
+  std::ifstream fp(fname, std::ios::binary);
+  std::stringstream content;
+  if (true == fp.is_open()) {
+    content << fp.rdbuf();
+  }
+  write_binary_image(writer, content.str());
+}
+
+/********************************************************************
+ * Compute the digests of the inputs of build_fabric. Circuit models are
+ * referred by their names rather than by their ids, so that adding a
+ * circuit model does not change the digests of the others.
+ * The device is given by the digest of its routing resources, which
+ * includes the order of the incoming edges of the GSBs, as it sets the
+ * order of the multiplexer inputs, and hence the bitstream.
+ * The options in the ignored list, e.g., the number of threads, do not
+ * change the fabric. The content of a fabric key to load is included
+ * in addition to its file name.
+ *******************************************************************/
+FabricBuildDigest compute_fabric_build_digest(
+  const uint64_t& device_rr_gsb_digest, const DeviceGrid& grids,
+  const Arch& arch, const Command& cmd, const CommandContext& cmd_context,
+  const std::vector<std::string>& ignored_options) {
+  FabricBuildDigest digest;
+  const CircuitLibrary& circuit_lib = arch.circuit_lib;
+
+  digest.device = device_rr_gsb_digest;
+
+  BinaryImageWriter others;
+  write_binary_image(others, grids.width());
+  write_binary_image(others, grids.height());
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      write_binary_image(others, std::string(grids[ix][iy].type->name));
+      write_binary_image(others, grids[ix][iy].width_offset);
+      write_binary_image(others, grids[ix][iy].height_offset);
+    }
+  }
+  arch.config_protocol.write_to_binary_image(others);
+  arch.tech_lib.write_to_binary_image(others);
+  write_binary_image(others, arch.circuit_tech_binding.size());
+  for (const auto& binding : arch.circuit_tech_binding) {
+    write_binary_image(others, circuit_lib.model_name(binding.first));
+    write_binary_image(others, arch.tech_lib.model_name(binding.second));
+  }
+  for (const std::map<std::string, CircuitModelId>* switch2circuit :
+       {&arch.cb_switch2circuit, &arch.sb_switch2circuit,
+        &arch.routing_seg2circuit}) {
+    write_binary_image(others, switch2circuit->size());
+    for (const auto& binding : *switch2circuit) {
+      write_binary_image(others, binding.first);
+      write_binary_image(others, circuit_lib.model_name(binding.second));
+    }
+  }
+  arch.arch_direct.write_to_binary_image(others);
+  write_binary_image(others, arch.pb_type_annotations.size());
+  for (const PbTypeAnnotation& annotation : arch.pb_type_annotations) {
+    annotation.write_to_binary_image(others);
+  }
+
+  for (const CommandOptionId& option : cmd.options()) {
+    std::string option_name = cmd.option_name(option);
+    if (ignored_options.end() != std::find(ignored_options.begin(),
+                                           ignored_options.end(),
+                                           option_name)) {
+      continue;
+    }
+    bool enabled = cmd_context.option_enable(cmd, option);
+    write_binary_image(others, option_name);
+    write_binary_image(others, enabled);
+    if (false == enabled) {
+      continue;
+    }
+    write_binary_image(others, cmd_context.option_value(cmd, option));
+    if (std::string("load_fabric_key") == option_name) {
+      write_file_content_to_binary_image(
+        others, cmd_context.option_value(cmd, option));
+    }
+  }
+  digest.others = others.digest();
+
+  BinaryImageWriter tile_annotation;
+  arch.tile_annotations.write_to_binary_image(tile_annotation);
+  digest.tile_annotation = tile_annotation.digest();
+
+  for (const CircuitModelId& model : circuit_lib.models()) {
+    BinaryImageWriter circuit_model;
+    circuit_lib.write_model_to_binary_image(circuit_model, model);
+    digest.circuit_models[circuit_lib.model_name(model)] =
+      circuit_model.digest();
+  }
+
+  return digest;
+}
+
+/********************************************************************
+ * Write the digests to a text file
+ *******************************************************************/
+int write_fabric_build_digest(const std::string& fname,
+                              const FabricBuildDigest& digest) {
+  std::ofstream fp(fname);
+  if (false == fp.is_open()) {
+    VTR_LOG_ERROR("Unable to write the digests of the fabric to '%s'!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  fp << std::hex;
+  fp << "device " << digest.device << "\n";
+  fp << "others " << digest.others << "\n";
+  fp << "tile_annotation " << digest.tile_annotation << "\n";
+  for (const auto& circuit_model : digest.circuit_models) {
+    fp << "circuit_model " << circuit_model.first << " "
+       << circuit_model.second << "\n";
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Read the digests from a text file written by
+ * write_fabric_build_digest(). Return an error when the file is missing
+ * or is not valid, without any message, as there is simply nothing to
+ * compare with
+ *******************************************************************/
+int read_fabric_build_digest(const std::string& fname,
+                             FabricBuildDigest& digest) {
+  std::ifstream fp(fname);
+  if (false == fp.is_open()) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  digest = FabricBuildDigest();
+  bool device_found = false;
+  bool others_found = false;
+  bool tile_annotation_found = false;
+  std::string line;
+  while (std::getline(fp, line)) {
+    std::istringstream tokens(line);
+    std::string key;
+    tokens >> key;
+    if (std::string("device") == key) {
+      device_found = bool(tokens >> std::hex >> digest.device);
+    } else if (std::string("others") == key) {
+      others_found = bool(tokens >> std::hex >> digest.others);
+    } else if (std::string("tile_annotation") == key) {
+      tile_annotation_found =
+        bool(tokens >> std::hex >> digest.tile_annotation);
+    } else if (std::string("circuit_model") == key) {
+      std::string name;
+      uint64_t model_digest = 0;
+      if (!(tokens >> name >> std::hex >> model_digest)) {
+        return CMD_EXEC_FATAL_ERROR;
+      }
+      digest.circuit_models[name] = model_digest;
+    } else if (false == key.empty()) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+  if ((false == device_found) || (false == others_found) ||
+      (false == tile_annotation_found)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Find the names of the circuit models which have been edited, added or
+ * removed between two runs
+ *******************************************************************/
+std::vector<std::string> find_fabric_build_digest_changed_circuit_models(
+  const FabricBuildDigest& prev_digest, const FabricBuildDigest& curr_digest) {
+  std::vector<std::string> changed_models;
+  for (const auto& circuit_model : curr_digest.circuit_models) {
+    auto result = prev_digest.circuit_models.find(circuit_model.first);
+    if ((prev_digest.circuit_models.end() == result) ||
+        (result->second != circuit_model.second)) {
+      changed_models.push_back(circuit_model.first);
+    }
+  }
+  for (const auto& circuit_model : prev_digest.circuit_models) {
+    if (0 == curr_digest.circuit_models.count(circuit_model.first)) {
+      changed_models.push_back(circuit_model.first);
+    }
+  }
+  return changed_models;
+}
+
+/********************************************************************
+ * Find the modules which depend on a list of circuit models, i.e., the
+ * modules built from the circuit models and all their ancestors.
+ * The modules built from a circuit model are named after it, e.g., the
+ * multiplexers and their memories, so that they are found by the prefix
+ * of their names. This is conservative: a module of another circuit
+ * model whose name has the same prefix is also considered as dependent.
+ *******************************************************************/
+std::vector<ModuleId> find_circuit_model_dependent_modules(
+  const ModuleManager& module_manager,
+  const std::vector<std::string>& circuit_model_names) {
+  /* The parents of each module, which the module manager does not
+   * provide */
+  vtr::vector<ModuleId, std::vector<ModuleId>> parent_modules(
+    module_manager.modules().size());
+  for (const ModuleId& module : module_manager.modules()) {
+    for (const ModuleId& child : module_manager.child_modules(module)) {
+      parent_modules[child].push_back(module);
+    }
+  }
+
+  vtr::vector<ModuleId, bool> dependent(module_manager.modules().size(),
+                                        false);
+  std::vector<ModuleId> stack;
+  for (const ModuleId& module : module_manager.modules()) {
+    std::string module_name = module_manager.module_name(module);
+    for (const std::string& model_name : circuit_model_names) {
+      if (0 == module_name.compare(0, model_name.size(), model_name)) {
+        dependent[module] = true;
+        stack.push_back(module);
+        break;
+      }
+    }
+  }
+  while (false == stack.empty()) {
+    ModuleId module = stack.back();
+    stack.pop_back();
+    for (const ModuleId& parent : parent_modules[module]) {
+      if (false == dependent[parent]) {
+        dependent[parent] = true;
+        stack.push_back(parent);
+      }
+    }
+  }
+
+  std::vector<ModuleId> dependent_modules;
+  for (const ModuleId& module : module_manager.modules()) {
+    if (true == dependent[module]) {
+      dependent_modules.push_back(module);
+    }
+  }
+  return dependent_modules;
+}
+
+} /* end namespace openfpga */
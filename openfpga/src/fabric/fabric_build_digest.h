@@ -0,0 +1,63 @@
+#ifndef FABRIC_BUILD_DIGEST_H
+#define FABRIC_BUILD_DIGEST_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "command.h"
+#include "command_context.h"
+#include "device_grid.h"
+#include "module_manager.h"
+#include "openfpga_arch.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * The digests of the inputs of build_fabric, which are compared with the
+ * ones of a previous run to find what has been edited in the
+ * architecture. Each circuit model has its own digest, so that an edit
+ * can be traced to the modules built from the circuit model. The routing
+ * resources of the device, including the order of the incoming edges of
+ * each GSB, have their own digest. The other inputs, i.e., the grids, the
+ * rest of the architecture and the options of build_fabric, share a single
+ * digest.
+ *******************************************************************/
+struct FabricBuildDigest {
+  uint64_t device = 0;
+  uint64_t others = 0;
+  uint64_t tile_annotation = 0;
+  /* Digest of each circuit model, indexed by its name */
+  std::map<std::string, uint64_t> circuit_models;
+};
+
+FabricBuildDigest compute_fabric_build_digest(
+  const uint64_t& device_rr_gsb_digest, const DeviceGrid& grids,
+  const Arch& arch, const Command& cmd, const CommandContext& cmd_context,
+  const std::vector<std::string>& ignored_options);
+
+int write_fabric_build_digest(const std::string& fname,
+                              const FabricBuildDigest& digest);
+
+int read_fabric_build_digest(const std::string& fname,
+                             FabricBuildDigest& digest);
+
+std::vector<std::string> find_fabric_build_digest_changed_circuit_models(
+  const FabricBuildDigest& prev_digest, const FabricBuildDigest& curr_digest);
+
+std::vector<ModuleId> find_circuit_model_dependent_modules(
+  const ModuleManager& module_manager,
+  const std::vector<std::string>& circuit_model_names);
+
+} /* end namespace openfpga */
+
+#endif
@@ -3,6 +3,7 @@
  ***********************************************************************/
 #include "fabric_global_port_info.h"
 
+#include "module_manager.h"
 #include "vtr_assert.h"
 
 /* namespace openfpga begins */
@@ -90,11 +91,56 @@ size_t FabricGlobalPortInfo::global_port_default_value(
   return global_port_default_values_[global_port_id];
 }
 
+/************************************************************************
+ * Public Accessors : fast lookup
+ ***********************************************************************/
+bool FabricGlobalPortInfo::fast_lookup_built() const {
+  return fast_lookup_built_;
+}
+
+const std::vector<FabricGlobalPortId>&
+FabricGlobalPortInfo::programming_reset_ports() const {
+  VTR_ASSERT(true == fast_lookup_built_);
+  return programming_reset_ports_;
+}
+
+const std::vector<FabricGlobalPortId>&
+FabricGlobalPortInfo::programming_set_ports() const {
+  VTR_ASSERT(true == fast_lookup_built_);
+  return programming_set_ports_;
+}
+
+const std::vector<FabricGlobalPortId>&
+FabricGlobalPortInfo::operating_reset_ports() const {
+  VTR_ASSERT(true == fast_lookup_built_);
+  return operating_reset_ports_;
+}
+
+const std::vector<FabricGlobalPortId>&
+FabricGlobalPortInfo::find_global_ports_by_name(const std::string& name) const {
+  VTR_ASSERT(true == fast_lookup_built_);
+  static const std::vector<FabricGlobalPortId> empty_ports;
+  auto result = global_port_name_lookup_.find(name);
+  if (global_port_name_lookup_.end() == result) {
+    return empty_ports;
+  }
+  return result->second;
+}
+
+const BasicPort& FabricGlobalPortInfo::global_port_top_module_port(
+  const FabricGlobalPortId& global_port_id) const {
+  VTR_ASSERT(true == fast_lookup_built_);
+  VTR_ASSERT(valid_global_port_id(global_port_id));
+  return global_port_top_module_ports_[global_port_id];
+}
+
 /************************************************************************
  * Public Mutators
  ***********************************************************************/
 FabricGlobalPortId FabricGlobalPortInfo::create_global_port(
   const ModulePortId& module_port) {
+  invalidate_fast_lookup();
+
   /* This is a legal name. we can create a new id */
   FabricGlobalPortId port_id = FabricGlobalPortId(global_port_ids_.size());
   global_port_ids_.push_back(port_id);
@@ -122,18 +168,21 @@ void FabricGlobalPortInfo::set_global_port_is_clock(
 void FabricGlobalPortInfo::set_global_port_is_set(
   const FabricGlobalPortId& global_port_id, const bool& is_set) {
   VTR_ASSERT(valid_global_port_id(global_port_id));
+  invalidate_fast_lookup();
   global_port_is_set_[global_port_id] = is_set;
 }
 
 void FabricGlobalPortInfo::set_global_port_is_reset(
   const FabricGlobalPortId& global_port_id, const bool& is_reset) {
   VTR_ASSERT(valid_global_port_id(global_port_id));
+  invalidate_fast_lookup();
   global_port_is_reset_[global_port_id] = is_reset;
 }
 
 void FabricGlobalPortInfo::set_global_port_is_prog(
   const FabricGlobalPortId& global_port_id, const bool& is_prog) {
   VTR_ASSERT(valid_global_port_id(global_port_id));
+  invalidate_fast_lookup();
   global_port_is_prog_[global_port_id] = is_prog;
 }
 
@@ -173,9 +222,53 @@ void FabricGlobalPortInfo::set_global_port_default_value(
   global_port_default_values_[global_port_id] = default_value;
 }
 
+void FabricGlobalPortInfo::build_fast_lookup(
+  const ModuleManager& module_manager, const ModuleId& top_module) {
+  invalidate_fast_lookup();
+
+  global_port_top_module_ports_.resize(global_port_ids_.size());
+  for (const FabricGlobalPortId& global_port : global_ports()) {
+    const BasicPort& module_port =
+      module_manager.module_port(top_module, global_module_ports_[global_port]);
+    global_port_top_module_ports_[global_port] = module_port;
+    global_port_name_lookup_[module_port.get_name()].push_back(global_port);
+
+    if ((false == global_port_is_reset_[global_port]) &&
+        (false == global_port_is_set_[global_port])) {
+      continue;
+    }
+    if (false == global_port_is_prog_[global_port]) {
+      if (true == global_port_is_reset_[global_port]) {
+        operating_reset_ports_.push_back(global_port);
+      }
+      continue;
+    }
+    /* A global port for programming cannot be a reset and a set port */
+    VTR_ASSERT((false == global_port_is_reset_[global_port]) ||
+               (false == global_port_is_set_[global_port]));
+    if (true == global_port_is_reset_[global_port]) {
+      programming_reset_ports_.push_back(global_port);
+    } else {
+      programming_set_ports_.push_back(global_port);
+    }
+  }
+
+  fast_lookup_built_ = true;
+}
+
 /************************************************************************
  * Internal invalidators/validators
  ***********************************************************************/
+/* Invalidators */
+void FabricGlobalPortInfo::invalidate_fast_lookup() {
+  fast_lookup_built_ = false;
+  programming_reset_ports_.clear();
+  programming_set_ports_.clear();
+  operating_reset_ports_.clear();
+  global_port_name_lookup_.clear();
+  global_port_top_module_ports_.clear();
+}
+
 /* Validators */
 bool FabricGlobalPortInfo::valid_global_port_id(
   const FabricGlobalPortId& global_port_id) const {
@@ -183,4 +276,39 @@ bool FabricGlobalPortInfo::valid_global_port_id(
          (global_port_id == global_port_ids_[global_port_id]);
 }
 
+/************************************************************************
+ * Public binary image writer/reader
+ ***********************************************************************/
+void FabricGlobalPortInfo::write_to_binary_image(
+  BinaryImageWriter& writer) const {
+  write_binary_image(writer, global_port_ids_);
+  write_binary_image(writer, global_module_ports_);
+  write_binary_image(writer, global_port_is_clock_);
+  write_binary_image(writer, global_port_is_reset_);
+  write_binary_image(writer, global_port_is_set_);
+  write_binary_image(writer, global_port_is_prog_);
+  write_binary_image(writer, global_port_is_shift_register_);
+  write_binary_image(writer, global_port_is_bl_);
+  write_binary_image(writer, global_port_is_wl_);
+  write_binary_image(writer, global_port_is_config_enable_);
+  write_binary_image(writer, global_port_is_io_);
+  write_binary_image(writer, global_port_default_values_);
+}
+
+void FabricGlobalPortInfo::read_from_binary_image(BinaryImageReader& reader) {
+  invalidate_fast_lookup();
+  read_binary_image(reader, global_port_ids_);
+  read_binary_image(reader, global_module_ports_);
+  read_binary_image(reader, global_port_is_clock_);
+  read_binary_image(reader, global_port_is_reset_);
+  read_binary_image(reader, global_port_is_set_);
+  read_binary_image(reader, global_port_is_prog_);
+  read_binary_image(reader, global_port_is_shift_register_);
+  read_binary_image(reader, global_port_is_bl_);
+  read_binary_image(reader, global_port_is_wl_);
+  read_binary_image(reader, global_port_is_config_enable_);
+  read_binary_image(reader, global_port_is_io_);
+  read_binary_image(reader, global_port_default_values_);
+}
+
 }  // namespace openfpga
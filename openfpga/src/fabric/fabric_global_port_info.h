@@ -5,10 +5,13 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "fabric_global_port_info_fwd.h"
 #include "module_manager_fwd.h"
+#include "openfpga_binary_image.h"
+#include "openfpga_port.h"
 #include "vtr_vector.h"
 
 /* namespace openfpga begins */
@@ -50,6 +53,23 @@ class FabricGlobalPortInfo {
   size_t global_port_default_value(
     const FabricGlobalPortId& global_port_id) const;
 
+ public: /* Public accessors: fast lookup */
+  /* The fast lookup is built by build_fast_lookup() and is invalidated by
+   * any mutator which changes the global ports or their functionalities.
+   * The accessors below are only available when it is built */
+  bool fast_lookup_built() const;
+  /* The global reset/set ports used for programming FPGAs */
+  const std::vector<FabricGlobalPortId>& programming_reset_ports() const;
+  const std::vector<FabricGlobalPortId>& programming_set_ports() const;
+  /* The global reset ports which are not used for programming FPGAs */
+  const std::vector<FabricGlobalPortId>& operating_reset_ports() const;
+  /* The global ports whose port of the top module has a given name */
+  const std::vector<FabricGlobalPortId>& find_global_ports_by_name(
+    const std::string& name) const;
+  /* The port of the top module of a global port */
+  const BasicPort& global_port_top_module_port(
+    const FabricGlobalPortId& global_port_id) const;
+
  public: /* Public mutators */
   /* By default, we do not set it as a clock.
    * Users should set it through the set_global_port_is_clock() function
@@ -75,10 +95,24 @@ class FabricGlobalPortInfo {
                              const bool& is_io);
   void set_global_port_default_value(const FabricGlobalPortId& global_port_id,
                                      const size_t& default_value);
+  /* Categorize the global ports and index them by the names of their ports
+   * in the top module, so that they are found without scanning all the
+   * global ports. Call it once all the global ports are created */
+  void build_fast_lookup(const ModuleManager& module_manager,
+                         const ModuleId& top_module);
 
  public: /* Public validator */
   bool valid_global_port_id(const FabricGlobalPortId& global_port_id) const;
 
+ private: /* Internal invalidators */
+  void invalidate_fast_lookup();
+
+ public: /* Public binary image writer/reader */
+  /* Write all the internal data to a binary image */
+  void write_to_binary_image(BinaryImageWriter& writer) const;
+  /* Replace all the internal data with the data of a binary image */
+  void read_from_binary_image(BinaryImageReader& reader);
+
  private: /* Internal data */
   /* Global port information for tiles */
   vtr::vector<FabricGlobalPortId, FabricGlobalPortId> global_port_ids_;
@@ -93,6 +127,15 @@ class FabricGlobalPortInfo {
   vtr::vector<FabricGlobalPortId, bool> global_port_is_config_enable_;
   vtr::vector<FabricGlobalPortId, bool> global_port_is_io_;
   vtr::vector<FabricGlobalPortId, size_t> global_port_default_values_;
+
+  /* Fast lookup, which is not stored in binary images */
+  bool fast_lookup_built_ = false;
+  std::vector<FabricGlobalPortId> programming_reset_ports_;
+  std::vector<FabricGlobalPortId> programming_set_ports_;
+  std::vector<FabricGlobalPortId> operating_reset_ports_;
+  std::unordered_map<std::string, std::vector<FabricGlobalPortId>>
+    global_port_name_lookup_;
+  vtr::vector<FabricGlobalPortId, BasicPort> global_port_top_module_ports_;
 };
 
 }  // namespace openfpga
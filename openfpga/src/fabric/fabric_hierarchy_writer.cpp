@@ -1,6 +1,9 @@
 /***************************************************************************************
  * Output internal structure of Module Graph hierarchy to file formats
  ***************************************************************************************/
+#include <queue>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -8,8 +11,10 @@
 
 /* Headers from openfpgautil library */
 #include "fabric_hierarchy_writer.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
+#include "openfpga_trace.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
@@ -71,6 +76,70 @@ static int rec_output_module_hierarchy_to_text_file(
   return 0;
 }
 
+/***************************************************************************************
+ * Output the hierarchy under the parent_module to a text file as a DAG, where
+ * each module is a key listing its child modules once, e.g.,
+ *   <parent_module_name>:
+ *     - <child_module_name>
+ *   <child_module_name>:
+ *     - <grandchild_module_name>
+ * Repeated subtrees are referenced by the names of their root modules, so the
+ * output is linear in the number of unique modules rather than instances.
+ * Leaf modules are only listed as children.
+ * We use Breadth-First Search (BFS) here so that each module is expanded at
+ * the lowest depth where it is found, i.e., as deep as the full tree would do
+ ***************************************************************************************/
+static int output_module_hierarchy_dag_to_text_file(
+  std::fstream& fp, const size_t& hie_depth_to_stop,
+  const ModuleManager& module_manager, const ModuleId& parent_module,
+  const bool& verbose) {
+  /* Each module is queued once with the depth where it is first found,
+   * the parent is at depth 0 */
+  std::vector<bool> module_visited(module_manager.num_modules(), false);
+  std::queue<std::pair<ModuleId, size_t>> module_queue;
+  module_visited[size_t(parent_module)] = true;
+  module_queue.push(std::make_pair(parent_module, 0));
+
+  size_t num_expanded_modules = 0;
+  while (!module_queue.empty()) {
+    ModuleId curr_module = module_queue.front().first;
+    size_t curr_depth = module_queue.front().second;
+    module_queue.pop();
+
+    if (false == valid_file_stream(fp)) {
+      return 2;
+    }
+
+    /* Leaf modules and the modules at the stop line are not expanded */
+    if ((0 == module_manager.child_modules(curr_module).size()) ||
+        (hie_depth_to_stop < curr_depth + 1)) {
+      continue;
+    }
+
+    fp << module_manager.module_name(curr_module) << ":\n";
+    num_expanded_modules++;
+
+    for (const ModuleId& child_module :
+         module_manager.child_modules(curr_module)) {
+      if (true != module_manager.valid_module_id(child_module)) {
+        VTR_LOGV_ERROR(verbose, "Unable to find the child module '%u'!\n",
+                       size_t(child_module));
+        return 1;
+      }
+      fp << "  - " << module_manager.module_name(child_module) << "\n";
+      if (false == module_visited[size_t(child_module)]) {
+        module_visited[size_t(child_module)] = true;
+        module_queue.push(std::make_pair(child_module, curr_depth + 1));
+      }
+    }
+  }
+
+  VTR_LOGV(verbose, "Outputted the children of %lu unique modules\n",
+           num_expanded_modules);
+
+  return 0;
+}
+
 /***************************************************************************************
  * Write the hierarchy of modules to a plain text file
  * e.g.,
@@ -78,6 +147,8 @@ static int rec_output_module_hierarchy_to_text_file(
  *      <child_module_name>
  *        ...
  * This file is mainly used by hierarchical P&R flow
+ * When dag is enabled, the children of each unique module are written once
+ * (see output_module_hierarchy_dag_to_text_file())
  *
  * Return 0 if successful
  * Return 1 if there are more serious bugs in the architecture
@@ -86,7 +157,7 @@ static int rec_output_module_hierarchy_to_text_file(
 int write_fabric_hierarchy_to_text_file(const ModuleManager& module_manager,
                                         const std::string& fname,
                                         const size_t& hie_depth_to_stop,
-                                        const bool& verbose) {
+                                        const bool& dag, const bool& verbose) {
   std::string timer_message =
     std::string("Write fabric hierarchy to plain-text file '") + fname +
     std::string("'");
@@ -98,12 +169,13 @@ int write_fabric_hierarchy_to_text_file(const ModuleManager& module_manager,
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Use default name if user does not provide one */
   VTR_ASSERT(true != fname.empty());
 
   /* Create a file handler*/
-  std::fstream fp;
+  BufferedFileStream fp;
   /* Open a file */
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
@@ -126,13 +198,19 @@ int write_fabric_hierarchy_to_text_file(const ModuleManager& module_manager,
     return 0;
   }
 
-  fp << top_module_name << ":"
-     << "\n";
-
-  /* Visit child module recursively and output the hierarchy */
-  int err_code = rec_output_module_hierarchy_to_text_file(
-    fp, hie_depth_to_stop, hie_depth + 1, /* Start with level 1 */
-    module_manager, top_module, verbose);
+  int err_code = 0;
+  if (true == dag) {
+    err_code = output_module_hierarchy_dag_to_text_file(
+      fp, hie_depth_to_stop, module_manager, top_module, verbose);
+  } else {
+    fp << top_module_name << ":"
+       << "\n";
+
+    /* Visit child module recursively and output the hierarchy */
+    err_code = rec_output_module_hierarchy_to_text_file(
+      fp, hie_depth_to_stop, hie_depth + 1, /* Start with level 1 */
+      module_manager, top_module, verbose);
+  }
 
   /* close a file */
   fp.close();
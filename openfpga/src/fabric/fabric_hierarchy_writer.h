@@ -17,7 +17,7 @@ namespace openfpga {
 int write_fabric_hierarchy_to_text_file(const ModuleManager& module_manager,
                                         const std::string& fname,
                                         const size_t& hie_depth_to_stop,
-                                        const bool& verbose);
+                                        const bool& dag, const bool& verbose);
 
 } /* end namespace openfpga */
 
@@ -8,6 +8,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_trace.h"
 
 /* Headers from archopenfpga library */
 #include "fabric_key_writer.h"
@@ -40,6 +41,7 @@ int write_fabric_key_to_xml_file(
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Use default name if user does not provide one */
   VTR_ASSERT(true != fname.empty());
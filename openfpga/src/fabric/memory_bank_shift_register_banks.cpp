@@ -493,6 +493,15 @@ bool MemoryBankShiftRegisterBanks::empty() const {
   return bl_bank_ids_.empty() && wl_bank_ids_.empty();
 }
 
+void MemoryBankShiftRegisterBanks::build_fast_lookups() {
+  if (is_bl_bank_dirty_) {
+    build_bl_port_fast_lookup();
+  }
+  if (is_wl_bank_dirty_) {
+    build_wl_port_fast_lookup();
+  }
+}
+
 void MemoryBankShiftRegisterBanks::build_bl_port_fast_lookup() const {
   bl_ports_to_sr_bank_ids_.resize(bl_bank_data_ports_.size());
   bl_ports_to_sr_bank_ports_.resize(bl_bank_data_ports_.size());
@@ -547,4 +556,50 @@ void MemoryBankShiftRegisterBanks::build_wl_port_fast_lookup() const {
   is_wl_bank_dirty_ = false;
 }
 
+void MemoryBankShiftRegisterBanks::write_to_binary_image(
+  BinaryImageWriter& writer) const {
+  write_binary_image(writer, config_region_ids_);
+  write_binary_image(writer, bl_bank_ids_);
+  write_binary_image(writer, bl_bank_data_ports_);
+  write_binary_image(writer, bl_bank_modules_);
+  write_binary_image(writer, bl_bank_instances_);
+  write_binary_image(writer, bl_bank_sink_child_ids_);
+  write_binary_image(writer, bl_bank_sink_child_pin_ids_);
+  write_binary_image(writer, wl_bank_ids_);
+  write_binary_image(writer, wl_bank_data_ports_);
+  write_binary_image(writer, wl_bank_modules_);
+  write_binary_image(writer, wl_bank_instances_);
+  write_binary_image(writer, wl_bank_sink_child_ids_);
+  write_binary_image(writer, wl_bank_sink_child_pin_ids_);
+  write_binary_image(writer, bl_ports_to_sr_bank_ids_);
+  write_binary_image(writer, bl_ports_to_sr_bank_ports_);
+  write_binary_image(writer, wl_ports_to_sr_bank_ids_);
+  write_binary_image(writer, wl_ports_to_sr_bank_ports_);
+  write_binary_image(writer, is_bl_bank_dirty_);
+  write_binary_image(writer, is_wl_bank_dirty_);
+}
+
+void MemoryBankShiftRegisterBanks::read_from_binary_image(
+  BinaryImageReader& reader) {
+  read_binary_image(reader, config_region_ids_);
+  read_binary_image(reader, bl_bank_ids_);
+  read_binary_image(reader, bl_bank_data_ports_);
+  read_binary_image(reader, bl_bank_modules_);
+  read_binary_image(reader, bl_bank_instances_);
+  read_binary_image(reader, bl_bank_sink_child_ids_);
+  read_binary_image(reader, bl_bank_sink_child_pin_ids_);
+  read_binary_image(reader, wl_bank_ids_);
+  read_binary_image(reader, wl_bank_data_ports_);
+  read_binary_image(reader, wl_bank_modules_);
+  read_binary_image(reader, wl_bank_instances_);
+  read_binary_image(reader, wl_bank_sink_child_ids_);
+  read_binary_image(reader, wl_bank_sink_child_pin_ids_);
+  read_binary_image(reader, bl_ports_to_sr_bank_ids_);
+  read_binary_image(reader, bl_ports_to_sr_bank_ports_);
+  read_binary_image(reader, wl_ports_to_sr_bank_ids_);
+  read_binary_image(reader, wl_ports_to_sr_bank_ports_);
+  read_binary_image(reader, is_bl_bank_dirty_);
+  read_binary_image(reader, is_wl_bank_dirty_);
+}
+
 } /* end namespace openfpga */
@@ -6,6 +6,7 @@
 
 #include "fabric_key.h"
 #include "module_manager.h"
+#include "openfpga_binary_image.h"
 #include "openfpga_port.h"
 #include "vtr_vector.h"
 
@@ -230,6 +231,12 @@ class MemoryBankShiftRegisterBanks {
                                             const size_t& sink_child_id,
                                             const size_t& sink_child_pin_id);
 
+  /** @brief Build the fast look-ups which are otherwise built on demand by
+   * the accessors. After that, the accessors do not modify any internal data,
+   * so that the banks can be shared by multiple threads in read-only mode
+   */
+  void build_fast_lookups();
+
  public: /* Validators */
   bool valid_region_id(const ConfigRegionId& region) const;
   bool valid_bl_bank_id(const ConfigRegionId& region_id,
@@ -238,6 +245,12 @@ class MemoryBankShiftRegisterBanks {
                         const FabricWordLineBankId& bank_id) const;
   bool empty() const;
 
+ public: /* Binary image writer/reader */
+  /* Write all the internal data to a binary image */
+  void write_to_binary_image(BinaryImageWriter& writer) const;
+  /* Replace all the internal data with the data of a binary image */
+  void read_from_binary_image(BinaryImageReader& reader);
+
  private: /* Internal Mutators */
   /** @brief Build the mapping from a BL/WL port to shift register bank and
    * assoicated pins
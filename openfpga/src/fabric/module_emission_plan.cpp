@@ -0,0 +1,212 @@
+/************************************************************************
+ * Member functions for class ModuleEmissionPlan
+ ***********************************************************************/
+#include "module_emission_plan.h"
+
+#include <algorithm>
+
+#include "vtr_assert.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+ModuleEmissionPlan::ModuleEmissionPlan(const ModuleManager& module_manager,
+                                       const ModuleId& module_id)
+  : module_id_(module_id) {
+  VTR_ASSERT(module_manager.valid_module_id(module_id));
+
+  size_t num_nets = module_manager.num_nets(module_id);
+  net_ports_.resize(num_nets);
+  net_module_sources_.resize(num_nets);
+  net_module_sinks_.resize(num_nets);
+  for (const ModuleNetId& net : module_manager.module_nets(module_id)) {
+    build_net_plan(module_manager, net);
+  }
+
+  for (const ModuleId& child : module_manager.child_modules(module_id)) {
+    for (const size_t& instance :
+         module_manager.child_module_instances(module_id, child)) {
+      child_instances_.push_back(std::make_pair(child, instance));
+      build_instance_plan(module_manager, child, instance);
+    }
+  }
+}
+
+/************************************************************************
+ * Public Accessors
+ ***********************************************************************/
+ModuleId ModuleEmissionPlan::module() const { return module_id_; }
+
+const std::vector<ModuleNetId>& ModuleEmissionPlan::local_wire_nets() const {
+  return local_wire_nets_;
+}
+
+const std::vector<ModuleNetId>&
+ModuleEmissionPlan::local_short_connection_nets() const {
+  return local_short_connection_nets_;
+}
+
+const std::vector<ModuleNetId>&
+ModuleEmissionPlan::output_short_connection_nets() const {
+  return output_short_connection_nets_;
+}
+
+const BasicPort& ModuleEmissionPlan::net_port(const ModuleNetId& net) const {
+  VTR_ASSERT(size_t(net) < net_ports_.size());
+  return net_ports_[net];
+}
+
+const std::vector<ModuleNetTerminalPin>&
+ModuleEmissionPlan::net_module_sources(const ModuleNetId& net) const {
+  VTR_ASSERT(size_t(net) < net_module_sources_.size());
+  return net_module_sources_[net];
+}
+
+const std::vector<ModuleNetTerminalPin>& ModuleEmissionPlan::net_module_sinks(
+  const ModuleNetId& net) const {
+  VTR_ASSERT(size_t(net) < net_module_sinks_.size());
+  return net_module_sinks_[net];
+}
+
+const std::vector<std::pair<ModuleId, size_t>>&
+ModuleEmissionPlan::child_instances() const {
+  return child_instances_;
+}
+
+const std::vector<ModuleNetId>& ModuleEmissionPlan::instance_port_nets(
+  const ModuleId& child_module, const size_t& instance_id,
+  const ModulePortId& child_port) const {
+  auto it = instance_port_nets_.find(child_module);
+  VTR_ASSERT(it != instance_port_nets_.end());
+  VTR_ASSERT(instance_id < it->second.size());
+  VTR_ASSERT(size_t(child_port) < it->second[instance_id].size());
+  return it->second[instance_id][child_port];
+}
+
+const std::vector<ModuleInstanceUndrivenPort>&
+ModuleEmissionPlan::undriven_instance_ports() const {
+  return undriven_instance_ports_;
+}
+
+/************************************************************************
+ * Internal builders
+ ***********************************************************************/
+/* Classify a net and name it in a single visit of its sources and sinks.
+ * The naming follows the rules of netlist writers:
+ * 1. If a source of the net is a pin of the module, name it after the port
+ * 2. Otherwise, if a sink of the net is a pin of the module, name it after
+ *    the port
+ * 3. Otherwise, this is a local wire, which is named after the user-defined
+ *    net name, or <src_module_name>_<instance_id>_<src_port_name>
+ * Restriction: a local wire must have a single driver
+ */
+void ModuleEmissionPlan::build_net_plan(const ModuleManager& module_manager,
+                                        const ModuleNetId& net) {
+  ModuleManager::NetTerminalView sources =
+    module_manager.net_source_terminals(module_id_, net);
+  for (size_t isrc = 0; isrc < sources.size(); ++isrc) {
+    ModuleManager::NetTerminal source = sources[isrc];
+    if (module_id_ == source.module) {
+      net_module_sources_[net].push_back({isrc, source.port, source.pin});
+    }
+  }
+
+  ModuleManager::NetTerminalView sinks =
+    module_manager.net_sink_terminals(module_id_, net);
+  for (size_t isink = 0; isink < sinks.size(); ++isink) {
+    ModuleManager::NetTerminal sink = sinks[isink];
+    if (module_id_ == sink.module) {
+      net_module_sinks_[net].push_back({isink, sink.port, sink.pin});
+    }
+  }
+
+  const std::vector<ModuleNetTerminalPin>& module_sources =
+    net_module_sources_[net];
+  const std::vector<ModuleNetTerminalPin>& module_sinks =
+    net_module_sinks_[net];
+
+  if (!module_sources.empty() && !module_sinks.empty()) {
+    local_short_connection_nets_.push_back(net);
+  }
+  if (1 < module_sinks.size()) {
+    output_short_connection_nets_.push_back(net);
+  }
+
+  BasicPort& net_port = net_ports_[net];
+  if (!module_sources.empty() || !module_sinks.empty()) {
+    const ModuleNetTerminalPin& terminal = module_sources.empty()
+                                             ? module_sinks.front()
+                                             : module_sources.front();
+    BasicPort module_port =
+      module_manager.module_port(module_id_, terminal.port);
+    net_port.set(module_port);
+    net_port.set_width(terminal.pin, terminal.pin);
+    net_port.set_origin_port_width(module_port.get_width());
+    return;
+  }
+
+  /* Reach here, this is a local wire */
+  local_wire_nets_.push_back(net);
+
+  /* Each net must only one 1 source */
+  VTR_ASSERT(1 == sources.size());
+
+  ModuleManager::NetTerminal net_src = sources[0];
+  ModuleId net_src_module = net_src.module;
+  size_t net_src_pin = net_src.pin;
+  BasicPort src_module_port =
+    module_manager.module_port(net_src_module, net_src.port);
+
+  /* Load user-defined name if we have it */
+  std::string net_name = module_manager.net_name(module_id_, net);
+  if (true == net_name.empty()) {
+    net_name = module_manager.module_name(net_src_module);
+    net_name +=
+      std::string("_") + std::to_string(net_src.instance) + std::string("_");
+    net_name += src_module_port.get_name();
+  }
+
+  net_port.set_name(net_name);
+  net_port.set_width(net_src_pin, net_src_pin);
+  net_port.set_origin_port_width(src_module_port.get_width());
+}
+
+void ModuleEmissionPlan::build_instance_plan(
+  const ModuleManager& module_manager, const ModuleId& child_module,
+  const size_t& instance_id) {
+  std::vector<vtr::vector<ModulePortId, std::vector<ModuleNetId>>>&
+    child_instances = instance_port_nets_[child_module];
+  if (instance_id >= child_instances.size()) {
+    child_instances.resize(instance_id + 1);
+  }
+
+  vtr::vector<ModulePortId, std::vector<ModuleNetId>>& port_nets =
+    child_instances[instance_id];
+  port_nets.resize(module_manager.module_ports(child_module).size());
+  for (const ModulePortId& child_port :
+       module_manager.module_ports(child_module)) {
+    size_t port_width =
+      module_manager.module_port(child_module, child_port).get_width();
+    port_nets[child_port].reserve(port_width);
+    /* Range of the undriven pins, which is empty as long as the lsb is
+     * out of the port */
+    ModuleInstanceUndrivenPort undriven_port = {
+      child_module, instance_id, child_port, port_width, 0};
+    for (size_t pin = 0; pin < port_width; ++pin) {
+      port_nets[child_port].push_back(module_manager.module_instance_port_net(
+        module_id_, child_module, instance_id, child_port, pin));
+      if (ModuleNetId::INVALID() == port_nets[child_port].back()) {
+        undriven_port.lsb = std::min(undriven_port.lsb, pin);
+        undriven_port.msb = pin;
+      }
+    }
+    if (undriven_port.lsb < port_width) {
+      undriven_instance_ports_.push_back(undriven_port);
+    }
+  }
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,125 @@
+#ifndef MODULE_EMISSION_PLAN_H
+#define MODULE_EMISSION_PLAN_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "module_manager.h"
+#include "openfpga_port.h"
+#include "vtr_vector.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A pin of a port of the module itself, which is a source or a sink
+ * of a net. The terminal id is the index of the source/sink in the net
+ *******************************************************************/
+struct ModuleNetTerminalPin {
+  size_t terminal_id;
+  ModulePortId port;
+  size_t pin;
+};
+
+/********************************************************************
+ * The pins of a port of a child instance which are linked to no net,
+ * i.e., a range [lsb, msb] of the port, which netlist writers declare as
+ * a local wire
+ *******************************************************************/
+struct ModuleInstanceUndrivenPort {
+  ModuleId child_module;
+  size_t instance_id;
+  ModulePortId child_port;
+  size_t lsb;
+  size_t msb;
+};
+
+/********************************************************************
+ * A one-time emission plan of a module for the netlist writers, including
+ * - The nets which are local wires or short connections of the module
+ * - The port (name and pin) that each net is bound to in the module
+ * - The pins of the module ports among the sources/sinks of each net
+ * - The child instances, in the sequence of the module manager
+ * - The net linked to each pin of each child instance
+ * - The undriven pins of the ports of each child instance
+ *
+ * The plan is independent from the netlist language: the Verilog and
+ * SPICE writers are both back ends of it, and only the names of the
+ * undriven local wires are left to each writer.
+ *
+ * All the nets of the module and all the pins of its child instances
+ * are visited only once when the plan is created, so that a netlist
+ * writer can output a module in a linear pass without querying the
+ * module manager net by net.
+ *
+ * @note The plan is a snapshot of the module. It should be created
+ * when the module is complete and discarded once the module is written
+ *******************************************************************/
+class ModuleEmissionPlan {
+ public: /* Constructors */
+  ModuleEmissionPlan(const ModuleManager& module_manager,
+                     const ModuleId& module_id);
+
+ public: /* Public accessors */
+  ModuleId module() const;
+  /* Nets which touch no port of the module */
+  const std::vector<ModuleNetId>& local_wire_nets() const;
+  /* Nets which connect an input port to an output port of the module */
+  const std::vector<ModuleNetId>& local_short_connection_nets() const;
+  /* Nets which drive more than one output port of the module */
+  const std::vector<ModuleNetId>& output_short_connection_nets() const;
+  /* The port of the module that a net is bound to, or the local wire
+   * named after its source when the net touches no port of the module */
+  const BasicPort& net_port(const ModuleNetId& net) const;
+  /* Pins of the module ports among the sources/sinks of a net */
+  const std::vector<ModuleNetTerminalPin>& net_module_sources(
+    const ModuleNetId& net) const;
+  const std::vector<ModuleNetTerminalPin>& net_module_sinks(
+    const ModuleNetId& net) const;
+  /* Child instances as pairs of <child module, instance id> */
+  const std::vector<std::pair<ModuleId, size_t>>& child_instances() const;
+  /* Nets linked to the pins of a port of a child instance.
+   * An invalid net id means that the pin is undriven */
+  const std::vector<ModuleNetId>& instance_port_nets(
+    const ModuleId& child_module, const size_t& instance_id,
+    const ModulePortId& child_port) const;
+  /* Ports of child instances with undriven pins, in the sequence of child
+   * instances and their ports */
+  const std::vector<ModuleInstanceUndrivenPort>& undriven_instance_ports()
+    const;
+
+ private: /* Internal builders */
+  void build_net_plan(const ModuleManager& module_manager,
+                      const ModuleNetId& net);
+  void build_instance_plan(const ModuleManager& module_manager,
+                           const ModuleId& child_module,
+                           const size_t& instance_id);
+
+ private: /* Internal data */
+  ModuleId module_id_;
+
+  std::vector<ModuleNetId> local_wire_nets_;
+  std::vector<ModuleNetId> local_short_connection_nets_;
+  std::vector<ModuleNetId> output_short_connection_nets_;
+
+  vtr::vector<ModuleNetId, BasicPort> net_ports_;
+  vtr::vector<ModuleNetId, std::vector<ModuleNetTerminalPin>>
+    net_module_sources_;
+  vtr::vector<ModuleNetId, std::vector<ModuleNetTerminalPin>>
+    net_module_sinks_;
+
+  std::vector<std::pair<ModuleId, size_t>> child_instances_;
+  /* Nets of each child instance, indexed by [child][instance][port][pin] */
+  std::map<ModuleId,
+           std::vector<vtr::vector<ModulePortId, std::vector<ModuleNetId>>>>
+    instance_port_nets_;
+  std::vector<ModuleInstanceUndrivenPort> undriven_instance_ports_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -4,10 +4,15 @@
 #include "module_manager.h"
 
 #include <algorithm>
+#include <limits>
 #include <numeric>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
 
 #include "circuit_library.h"
+#include "module_net_staging.h"
+#include "openfpga_memory_usage.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -17,6 +22,7 @@ namespace openfpga {
 /******************************************************************************
  * Public Constructors
  ******************************************************************************/
+ModuleManager::ModuleManager() : num_staging_base_modules_(0) {}
 
 /**************************************************
  * Public Accessors : Aggregates
@@ -46,7 +52,7 @@ ModuleManager::module_net_range ModuleManager::module_nets(
 }
 
 /* Find all the child modules under a parent module */
-std::vector<ModuleId> ModuleManager::child_modules(
+const std::vector<ModuleId>& ModuleManager::child_modules(
   const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -54,7 +60,7 @@ std::vector<ModuleId> ModuleManager::child_modules(
 }
 
 /* Find all the instances under a parent module */
-std::vector<size_t> ModuleManager::child_module_instances(
+ModuleManager::instance_range ModuleManager::child_module_instances(
   const ModuleId& parent_module, const ModuleId& child_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -68,16 +74,14 @@ std::vector<size_t> ModuleManager::child_module_instances(
   }
   VTR_ASSERT(child_index != children_[parent_module].size());
 
-  /* Create a vector, with sequentially increasing numbers */
-  std::vector<size_t> instance_range(
-    num_child_instances_[parent_module][child_index], 0);
-  std::iota(instance_range.begin(), instance_range.end(), 0);
-
-  return instance_range;
+  /* Instance ids are sequentially increasing numbers */
+  return vtr::make_range(
+    instance_iterator(0),
+    instance_iterator(num_child_instances_[parent_module][child_index]));
 }
 
 /* Find all the configurable child modules under a parent module */
-std::vector<ModuleId> ModuleManager::configurable_children(
+const std::vector<ModuleId>& ModuleManager::configurable_children(
   const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -86,7 +90,7 @@ std::vector<ModuleId> ModuleManager::configurable_children(
 }
 
 /* Find all the instances of configurable child modules under a parent module */
-std::vector<size_t> ModuleManager::configurable_child_instances(
+const std::vector<size_t>& ModuleManager::configurable_child_instances(
   const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -94,7 +98,8 @@ std::vector<size_t> ModuleManager::configurable_child_instances(
   return configurable_child_instances_[parent_module];
 }
 
-std::vector<vtr::Point<int>> ModuleManager::configurable_child_coordinates(
+const std::vector<vtr::Point<int>>&
+ModuleManager::configurable_child_coordinates(
   const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -103,7 +108,7 @@ std::vector<vtr::Point<int>> ModuleManager::configurable_child_coordinates(
 }
 
 /* Find all the configurable child modules under a parent module */
-std::vector<ModuleId> ModuleManager::io_children(
+const std::vector<ModuleId>& ModuleManager::io_children(
   const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -112,7 +117,7 @@ std::vector<ModuleId> ModuleManager::io_children(
 }
 
 /* Find all the instances of configurable child modules under a parent module */
-std::vector<size_t> ModuleManager::io_child_instances(
+const std::vector<size_t>& ModuleManager::io_child_instances(
   const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -120,7 +125,7 @@ std::vector<size_t> ModuleManager::io_child_instances(
   return io_child_instances_[parent_module];
 }
 
-std::vector<vtr::Point<int>> ModuleManager::io_child_coordinates(
+const std::vector<vtr::Point<int>>& ModuleManager::io_child_coordinates(
   const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -133,8 +138,10 @@ ModuleManager::module_net_src_range ModuleManager::module_net_sources(
   const ModuleId& module, const ModuleNetId& net) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_net_id(module, net));
-  return vtr::make_range(net_src_ids_[module][net].begin(),
-                         net_src_ids_[module][net].end());
+  return vtr::make_range(
+    module_net_src_iterator(ModuleNetSrcId(0), invalid_net_src_ids_),
+    module_net_src_iterator(ModuleNetSrcId(num_net_sources(module, net)),
+                            invalid_net_src_ids_));
 }
 
 /* Find the sink ids of modules */
@@ -142,8 +149,10 @@ ModuleManager::module_net_sink_range ModuleManager::module_net_sinks(
   const ModuleId& module, const ModuleNetId& net) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_net_id(module, net));
-  return vtr::make_range(net_sink_ids_[module][net].begin(),
-                         net_sink_ids_[module][net].end());
+  return vtr::make_range(
+    module_net_sink_iterator(ModuleNetSinkId(0), invalid_net_sink_ids_),
+    module_net_sink_iterator(ModuleNetSinkId(num_net_sinks(module, net)),
+                             invalid_net_sink_ids_));
 }
 
 ModuleManager::region_range ModuleManager::regions(
@@ -224,6 +233,19 @@ size_t ModuleManager::num_nets(const ModuleId& module) const {
   return num_nets_[module];
 }
 
+size_t ModuleManager::num_net_sinks(const ModuleId& module) const {
+  /* Validate the module_id */
+  VTR_ASSERT(valid_module_id(module));
+  if (true == nets_frozen_[module]) {
+    return net_sink_terminals_[module].size();
+  }
+  size_t num_sinks = 0;
+  for (const ModuleNetTerminalSpan& span : net_sink_spans_[module]) {
+    num_sinks += span.size;
+  }
+  return num_sinks;
+}
+
 /* Find the name of a module */
 std::string ModuleManager::module_name(const ModuleId& module_id) const {
   /* Validate the module_id */
@@ -289,12 +311,11 @@ ModulePortId ModuleManager::find_module_port(
   /* Validate the module id */
   VTR_ASSERT(valid_module_id(module_id));
 
-  /* Iterate over the ports of the module */
-  for (const auto& port : port_ids_[module_id]) {
-    if (0 == port_name.compare(ports_[module_id][port].get_name())) {
-      /* Find it, return the id */
-      return port;
-    }
+  /* Use the fast look-up rather than iterating over the ports of the module */
+  auto result = port_name_lookup_[module_id].find(port_name);
+  if (result != port_name_lookup_[module_id].end()) {
+    /* Find it, return the id */
+    return result->second;
   }
   /* Not found, return an invalid id */
   return ModulePortId::INVALID();
@@ -361,6 +382,18 @@ size_t ModuleManager::instance_id(const ModuleId& parent_module,
     find_child_module_index_in_parent_module(parent_module, child_module);
   VTR_ASSERT(child_index < children_[parent_module].size());
 
+  /* Named instances are indexed, use the fast look-up */
+  if (!instance_name.empty()) {
+    const auto& name_lookup =
+      child_instance_name_lookup_[parent_module][child_index];
+    auto result = name_lookup.find(instance_name);
+    if (result != name_lookup.end()) {
+      return result->second;
+    }
+    /* Not found, return an invalid name */
+    return size_t(-1);
+  }
+
   /* Search the instance name list and try to find a match */
   for (size_t name_id = 0;
        name_id < child_instance_names_[parent_module][child_index].size();
@@ -440,8 +473,12 @@ ModuleNetId ModuleManager::module_instance_port_net(
   /* Validate child_pin */
   VTR_ASSERT(child_pin < module_port(child_module, child_port).get_width());
 
-  return net_lookup_[parent_module][child_module][child_instance][child_port]
-                    [child_pin];
+  size_t pin_index = net_lookup_pin_index(
+    parent_module, child_module, child_instance, child_port, child_pin);
+  if (size_t(-1) == pin_index) {
+    return ModuleNetId::INVALID();
+  }
+  return net_lookup_[parent_module].at(child_module).nets[pin_index];
 }
 
 /* Find the name of net */
@@ -453,52 +490,25 @@ std::string ModuleManager::net_name(const ModuleId& module,
   return net_names_[module][net];
 }
 
-/* Find the source modules of a net */
-vtr::vector<ModuleNetSrcId, ModuleId> ModuleManager::net_source_modules(
+/* View on the sources of a net, without copying them */
+ModuleManager::NetTerminalView ModuleManager::net_source_terminals(
   const ModuleId& module, const ModuleNetId& net) const {
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  vtr::vector<ModuleNetSrcId, ModuleId> src_modules;
-  src_modules.reserve(net_src_terminal_ids_[module][net].size());
-  for (const size_t& id : net_src_terminal_ids_[module][net]) {
-    src_modules.push_back(net_terminal_storage_[id].first);
+  NetTerminalView view;
+  view.size_ = num_net_sources(module, net);
+  if (0 == view.size_) {
+    return view;
   }
-
-  return src_modules;
-}
-
-/* Find the ids of source instances of a net */
-vtr::vector<ModuleNetSrcId, size_t> ModuleManager::net_source_instances(
-  const ModuleId& module, const ModuleNetId& net) const {
-  /* Validate module net */
-  VTR_ASSERT(valid_module_net_id(module, net));
-
-  return net_src_instance_ids_[module][net];
-}
-
-/* Find the source ports of a net */
-vtr::vector<ModuleNetSrcId, ModulePortId> ModuleManager::net_source_ports(
-  const ModuleId& module, const ModuleNetId& net) const {
-  /* Validate module net */
-  VTR_ASSERT(valid_module_net_id(module, net));
-
-  vtr::vector<ModuleNetSrcId, ModulePortId> src_ports;
-  src_ports.reserve(net_src_terminal_ids_[module][net].size());
-  for (const size_t& id : net_src_terminal_ids_[module][net]) {
-    src_ports.push_back(net_terminal_storage_[id].second);
+  if (true == nets_frozen_[module]) {
+    view.terminals_ =
+      &net_src_terminals_[module][net_src_offsets_[module][size_t(net)]];
+    return view;
   }
-
-  return src_ports;
-}
-
-/* Find the source pin indices of a net */
-vtr::vector<ModuleNetSrcId, size_t> ModuleManager::net_source_pins(
-  const ModuleId& module, const ModuleNetId& net) const {
-  /* Validate module net */
-  VTR_ASSERT(valid_module_net_id(module, net));
-
-  return net_src_pin_ids_[module][net];
+  view.terminals_ =
+    &net_src_pool_[module][net_src_spans_[module][size_t(net)].offset];
+  return view;
 }
 
 /* Identify if a pin of a port in a module already exists in the net source
@@ -516,15 +526,9 @@ bool ModuleManager::net_source_exist(const ModuleId& module,
    * If a net source has the same src_module, instance_id, src_port and src_pin,
    * we can say that the source has already been added to this net!
    */
-  for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
-    if ((src_module ==
-         net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]]
-           .first) &&
-        (instance_id == net_source_instances(module, net)[net_src]) &&
-        (src_port ==
-         net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]]
-           .second) &&
-        (src_pin == net_source_pins(module, net)[net_src])) {
+  for (const NetTerminal& terminal : net_source_terminals(module, net)) {
+    if ((src_module == terminal.module) && (instance_id == terminal.instance) &&
+        (src_port == terminal.port) && (src_pin == terminal.pin)) {
       return true;
     }
   }
@@ -533,52 +537,25 @@ bool ModuleManager::net_source_exist(const ModuleId& module,
   return false;
 }
 
-/* Find the sink modules of a net */
-vtr::vector<ModuleNetSinkId, ModuleId> ModuleManager::net_sink_modules(
+/* View on the sinks of a net, without copying them */
+ModuleManager::NetTerminalView ModuleManager::net_sink_terminals(
   const ModuleId& module, const ModuleNetId& net) const {
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  vtr::vector<ModuleNetSinkId, ModuleId> sink_modules;
-  sink_modules.reserve(net_sink_terminal_ids_[module][net].size());
-  for (const size_t& id : net_sink_terminal_ids_[module][net]) {
-    sink_modules.push_back(net_terminal_storage_[id].first);
+  NetTerminalView view;
+  view.size_ = num_net_sinks(module, net);
+  if (0 == view.size_) {
+    return view;
   }
-
-  return sink_modules;
-}
-
-/* Find the ids of sink instances of a net */
-vtr::vector<ModuleNetSinkId, size_t> ModuleManager::net_sink_instances(
-  const ModuleId& module, const ModuleNetId& net) const {
-  /* Validate module net */
-  VTR_ASSERT(valid_module_net_id(module, net));
-
-  return net_sink_instance_ids_[module][net];
-}
-
-/* Find the sink ports of a net */
-vtr::vector<ModuleNetSinkId, ModulePortId> ModuleManager::net_sink_ports(
-  const ModuleId& module, const ModuleNetId& net) const {
-  /* Validate module net */
-  VTR_ASSERT(valid_module_net_id(module, net));
-
-  vtr::vector<ModuleNetSinkId, ModulePortId> sink_ports;
-  sink_ports.reserve(net_sink_terminal_ids_[module][net].size());
-  for (const size_t& id : net_sink_terminal_ids_[module][net]) {
-    sink_ports.push_back(net_terminal_storage_[id].second);
+  if (true == nets_frozen_[module]) {
+    view.terminals_ =
+      &net_sink_terminals_[module][net_sink_offsets_[module][size_t(net)]];
+    return view;
   }
-
-  return sink_ports;
-}
-
-/* Find the sink pin indices of a net */
-vtr::vector<ModuleNetSinkId, size_t> ModuleManager::net_sink_pins(
-  const ModuleId& module, const ModuleNetId& net) const {
-  /* Validate module net */
-  VTR_ASSERT(valid_module_net_id(module, net));
-
-  return net_sink_pin_ids_[module][net];
+  view.terminals_ =
+    &net_sink_pool_[module][net_sink_spans_[module][size_t(net)].offset];
+  return view;
 }
 
 /* Identify if a pin of a port in a module already exists in the net sink list*/
@@ -595,15 +572,10 @@ bool ModuleManager::net_sink_exist(const ModuleId& module,
    * If a net sink has the same sink_module, instance_id, sink_port and
    * sink_pin, we can say that the sink has already been added to this net!
    */
-  for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
-    if ((sink_module ==
-         net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]]
-           .first) &&
-        (instance_id == net_sink_instances(module, net)[net_sink]) &&
-        (sink_port ==
-         net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]]
-           .second) &&
-        (sink_pin == net_sink_pins(module, net)[net_sink])) {
+  for (const NetTerminal& terminal : net_sink_terminals(module, net)) {
+    if ((sink_module == terminal.module) &&
+        (instance_id == terminal.instance) && (sink_port == terminal.port) &&
+        (sink_pin == terminal.pin)) {
       return true;
     }
   }
@@ -612,9 +584,132 @@ bool ModuleManager::net_sink_exist(const ModuleId& module,
   return false;
 }
 
+/* Identify if the nets of a module have been frozen */
+bool ModuleManager::module_nets_frozen(const ModuleId& module) const {
+  /* Validate the module_id */
+  VTR_ASSERT(valid_module_id(module));
+  return nets_frozen_[module];
+}
+
+/* Estimate the memory used by the data of a module, in bytes
+ * Note that the memory shared by all the modules is not included
+ */
+size_t ModuleManager::module_memory_usage(const ModuleId& module) const {
+  /* Validate the module_id */
+  VTR_ASSERT(valid_module_id(module));
+
+  /* Module-level data */
+  size_t num_bytes = object_memory_usage(ids_[module]) +
+                     object_memory_usage(names_[module]) +
+                     object_memory_usage(usages_[module]) +
+                     object_memory_usage(parents_[module]) +
+                     object_memory_usage(children_[module]) +
+                     object_memory_usage(num_child_instances_[module]) +
+                     object_memory_usage(child_instance_names_[module]) +
+                     object_memory_usage(child_instance_name_lookup_[module]);
+  num_bytes += object_memory_usage(configurable_children_[module]) +
+               object_memory_usage(configurable_child_instances_[module]) +
+               object_memory_usage(configurable_child_regions_[module]) +
+               object_memory_usage(configurable_child_coordinates_[module]) +
+               object_memory_usage(config_region_ids_[module]) +
+               object_memory_usage(config_region_children_[module]) +
+               object_memory_usage(io_children_[module]) +
+               object_memory_usage(io_child_instances_[module]) +
+               object_memory_usage(io_child_coordinates_[module]);
+
+  /* Port-level data */
+  num_bytes += object_memory_usage(port_ids_[module]) +
+               object_memory_usage(ports_[module]) +
+               object_memory_usage(port_types_[module]) +
+               object_memory_usage(port_is_mappable_io_[module]) +
+               object_memory_usage(port_is_wire_[module]) +
+               object_memory_usage(port_is_register_[module]) +
+               object_memory_usage(port_preproc_flags_[module]) +
+               object_memory_usage(port_lookup_[module]) +
+               object_memory_usage(port_name_lookup_[module]);
+  for (const BasicPort& port : ports_[module]) {
+    num_bytes += heap_memory_usage(port.get_name());
+  }
+
+  /* Graph-level data */
+  num_bytes += object_memory_usage(num_nets_[module]) +
+               object_memory_usage(invalid_net_ids_[module]) +
+               object_memory_usage(net_names_[module]) +
+               object_memory_usage(net_src_spans_[module]) +
+               object_memory_usage(net_src_pool_[module]) +
+               object_memory_usage(net_sink_spans_[module]) +
+               object_memory_usage(net_sink_pool_[module]) +
+               object_memory_usage(net_src_offsets_[module]) +
+               object_memory_usage(net_src_terminals_[module]) +
+               object_memory_usage(net_sink_offsets_[module]) +
+               object_memory_usage(net_sink_terminals_[module]);
+
+  /* Fast look-up for nets */
+  num_bytes += object_memory_usage(port_pin_offsets_[module]) +
+               object_memory_usage(num_pins_[module]) +
+               object_memory_usage(net_lookup_[module]);
+  for (const auto& child_lookup : net_lookup_[module]) {
+    num_bytes += heap_memory_usage(child_lookup.second.nets);
+  }
+
+  return num_bytes;
+}
+
+/* Estimate the memory used by the module manager, in bytes */
+size_t ModuleManager::memory_usage() const {
+  size_t num_bytes = sizeof(ModuleManager);
+  for (const ModuleId& module : ids_) {
+    num_bytes += module_memory_usage(module);
+  }
+  /* Data shared by all the modules */
+  num_bytes += heap_memory_usage(name_id_map_) +
+               heap_memory_usage(invalid_net_src_ids_) +
+               heap_memory_usage(invalid_net_sink_ids_);
+  return num_bytes;
+}
+
 /******************************************************************************
  * Private Accessors
  ******************************************************************************/
+size_t ModuleManager::num_net_sources(const ModuleId& module,
+                                      const ModuleNetId& net) const {
+  if (true == nets_frozen_[module]) {
+    return net_src_offsets_[module][size_t(net) + 1] -
+           net_src_offsets_[module][size_t(net)];
+  }
+  return net_src_spans_[module][size_t(net)].size;
+}
+
+size_t ModuleManager::num_net_sinks(const ModuleId& module,
+                                    const ModuleNetId& net) const {
+  if (true == nets_frozen_[module]) {
+    return net_sink_offsets_[module][size_t(net) + 1] -
+           net_sink_offsets_[module][size_t(net)];
+  }
+  return net_sink_spans_[module][size_t(net)].size;
+}
+
+size_t ModuleManager::net_lookup_pin_index(const ModuleId& parent_module,
+                                           const ModuleId& child_module,
+                                           const size_t& child_instance,
+                                           const ModulePortId& child_port,
+                                           const size_t& child_pin) const {
+  auto result = net_lookup_[parent_module].find(child_module);
+  if (result == net_lookup_[parent_module].end()) {
+    return size_t(-1);
+  }
+  /* Ports added after the table is created are not indexed */
+  size_t pin_offset = port_pin_offsets_[child_module][child_port] + child_pin;
+  if (pin_offset >= result->second.num_pins) {
+    return size_t(-1);
+  }
+  size_t pin_index = child_instance * result->second.num_pins + pin_offset;
+  if (pin_index >= result->second.nets.size()) {
+    return size_t(-1);
+  }
+  return pin_index;
+}
+
 size_t ModuleManager::find_child_module_index_in_parent_module(
   const ModuleId& parent_module, const ModuleId& child_module) const {
   /* validate both module ids */
@@ -654,6 +749,7 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   children_.emplace_back();
   num_child_instances_.emplace_back();
   child_instance_names_.emplace_back();
+  child_instance_name_lookup_.emplace_back();
   configurable_children_.emplace_back();
   configurable_child_instances_.emplace_back();
   configurable_child_regions_.emplace_back();
@@ -677,15 +773,16 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   num_nets_.emplace_back(0);
   invalid_net_ids_.emplace_back();
   net_names_.emplace_back();
-  net_src_ids_.emplace_back();
-  net_src_terminal_ids_.emplace_back();
-  net_src_instance_ids_.emplace_back();
-  net_src_pin_ids_.emplace_back();
+  net_src_spans_.emplace_back();
+  net_src_pool_.emplace_back();
+  net_sink_spans_.emplace_back();
+  net_sink_pool_.emplace_back();
 
-  net_sink_ids_.emplace_back();
-  net_sink_terminal_ids_.emplace_back();
-  net_sink_instance_ids_.emplace_back();
-  net_sink_pin_ids_.emplace_back();
+  nets_frozen_.push_back(false);
+  net_src_offsets_.emplace_back();
+  net_src_terminals_.emplace_back();
+  net_sink_offsets_.emplace_back();
+  net_sink_terminals_.emplace_back();
 
   /* Register in the name-to-id map */
   name_id_map_[name] = module;
@@ -693,11 +790,14 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   /* Build port lookup */
   port_lookup_.emplace_back();
   port_lookup_[module].resize(NUM_MODULE_PORT_TYPES);
+  port_name_lookup_.emplace_back();
 
   /* Build fast look-up for nets */
+  port_pin_offsets_.emplace_back();
+  num_pins_.push_back(0);
   net_lookup_.emplace_back();
   /* Reserve the instance 0 for the module */
-  net_lookup_[module][module].emplace_back();
+  net_lookup_[module][module].num_pins = 0;
 
   /* Return the new id */
   return module;
@@ -723,11 +823,16 @@ ModulePortId ModuleManager::add_port(const ModuleId& module,
 
   /* Update fast look-up for port */
   port_lookup_[module][port_type].push_back(port);
+  /* Keep the first port if the name is already used */
+  port_name_lookup_[module].emplace(port_info.get_name(), port);
 
-  /* Update fast look-up for nets */
-  VTR_ASSERT_SAFE(1 == net_lookup_[module][module].size());
-  net_lookup_[module][module][0][port].resize(port_info.get_width(),
-                                              ModuleNetId::INVALID());
+  /* Update fast look-up for nets: pins of the new port are appended */
+  port_pin_offsets_[module].push_back(num_pins_[module]);
+  num_pins_[module] += port_info.get_width();
+  /* The module itself is the only instance in its own table */
+  ModuleNetLookup& self_lookup = net_lookup_[module][module];
+  self_lookup.num_pins = num_pins_[module];
+  self_lookup.nets.resize(num_pins_[module], ModuleNetId::INVALID());
 
   return port;
 }
@@ -739,7 +844,29 @@ void ModuleManager::set_module_port_name(const ModuleId& module,
   /* Validate the id of module port */
   VTR_ASSERT(valid_module_port_id(module, module_port));
 
+  std::string old_port_name = ports_[module][module_port].get_name();
   ports_[module][module_port].set_name(port_name);
+
+  /* Update fast look-up for port names.
+   * Release the old name. Another port may share the old name,
+   * which should be indexed then */
+  auto old_result = port_name_lookup_[module].find(old_port_name);
+  if ((old_result != port_name_lookup_[module].end()) &&
+      (module_port == old_result->second)) {
+    port_name_lookup_[module].erase(old_result);
+    for (const ModulePortId& port : port_ids_[module]) {
+      if (0 == old_port_name.compare(ports_[module][port].get_name())) {
+        port_name_lookup_[module][old_port_name] = port;
+        break;
+      }
+    }
+  }
+  /* Index the new name, unless a port with a smaller id already uses it */
+  auto new_result = port_name_lookup_[module].find(port_name);
+  if ((new_result == port_name_lookup_[module].end()) ||
+      (size_t(module_port) < size_t(new_result->second))) {
+    port_name_lookup_[module][port_name] = module_port;
+  }
 }
 
 /* Set a name for a module */
@@ -826,6 +953,7 @@ void ModuleManager::add_child_module(const ModuleId& parent_module,
     /* Update the instance name list */
     child_instance_names_[parent_module].emplace_back();
     child_instance_names_[parent_module].back().emplace_back();
+    child_instance_name_lookup_[parent_module].emplace_back();
   } else {
     /* Increase the counter of instances */
     child_instance_id =
@@ -843,14 +971,17 @@ void ModuleManager::add_child_module(const ModuleId& parent_module,
     add_io_child(parent_module, child_module, child_instance_id);
   }
 
-  /* Update fast look-up for nets */
-  size_t instance_id = net_lookup_[parent_module][child_module].size();
-  net_lookup_[parent_module][child_module].emplace_back();
-  /* Find the ports for the child module and update the fast look-up */
-  for (ModulePortId child_port : port_ids_[child_module]) {
-    net_lookup_[parent_module][child_module][instance_id][child_port].resize(
-      ports_[child_module][child_port].get_width(), ModuleNetId::INVALID());
+  /* Update fast look-up for nets: allocate the pins of the new instance */
+  auto result = net_lookup_[parent_module].find(child_module);
+  if (result == net_lookup_[parent_module].end()) {
+    ModuleNetLookup child_lookup;
+    child_lookup.num_pins = num_pins_[child_module];
+    result =
+      net_lookup_[parent_module].emplace(child_module, child_lookup).first;
   }
+  result->second.nets.resize(result->second.nets.size() +
+                               result->second.num_pins,
+                             ModuleNetId::INVALID());
 }
 
 /* Set the instance name of a child module */
@@ -869,8 +1000,37 @@ void ModuleManager::set_child_instance_name(const ModuleId& parent_module,
   /* We must find something! */
   VTR_ASSERT(size_t(-1) != child_index);
   /* Set the name */
+  std::string old_instance_name =
+    child_instance_names_[parent_module][child_index][instance_id];
   child_instance_names_[parent_module][child_index][instance_id] =
     instance_name;
+
+  /* Update fast look-up for instance names.
+   * Release the old name. Another instance may share the old name,
+   * which should be indexed then */
+  std::unordered_map<std::string, size_t>& name_lookup =
+    child_instance_name_lookup_[parent_module][child_index];
+  auto old_result = name_lookup.find(old_instance_name);
+  if ((old_result != name_lookup.end()) &&
+      (instance_id == old_result->second)) {
+    name_lookup.erase(old_result);
+    const std::vector<std::string>& names =
+      child_instance_names_[parent_module][child_index];
+    for (size_t name_id = 0; name_id < names.size(); ++name_id) {
+      if (0 == old_instance_name.compare(names[name_id])) {
+        name_lookup[old_instance_name] = name_id;
+        break;
+      }
+    }
+  }
+  /* Index the new name, unless a smaller instance id already uses it */
+  if (instance_name.empty()) {
+    return;
+  }
+  auto new_result = name_lookup.find(instance_name);
+  if ((new_result == name_lookup.end()) || (instance_id < new_result->second)) {
+    name_lookup[instance_name] = instance_id;
+  }
 }
 
 /* Add a configurable child module to module
@@ -999,23 +1159,20 @@ void ModuleManager::reserve_module_nets(const ModuleId& module,
                                         const size_t& num_nets) {
   /* Validate the module id */
   VTR_ASSERT(valid_module_id(module));
+  /* Frozen nets are read-only */
+  VTR_ASSERT(false == nets_frozen_[module]);
 
   net_names_[module].reserve(num_nets);
-  net_src_ids_[module].reserve(num_nets);
-  net_src_terminal_ids_[module].reserve(num_nets);
-  net_src_instance_ids_[module].reserve(num_nets);
-  net_src_pin_ids_[module].reserve(num_nets);
-
-  net_sink_ids_[module].reserve(num_nets);
-  net_sink_terminal_ids_[module].reserve(num_nets);
-  net_sink_instance_ids_[module].reserve(num_nets);
-  net_sink_pin_ids_[module].reserve(num_nets);
+  net_src_spans_[module].reserve(num_nets);
+  net_sink_spans_[module].reserve(num_nets);
 }
 
 /* Add a net to the connection graph of the module */
 ModuleNetId ModuleManager::create_module_net(const ModuleId& module) {
   /* Validate the module id */
   VTR_ASSERT(valid_module_id(module));
+  /* Frozen nets are read-only */
+  VTR_ASSERT(false == nets_frozen_[module]);
 
   /* Create an new id */
   ModuleNetId net = ModuleNetId(num_nets_[module]);
@@ -1023,20 +1180,14 @@ ModuleNetId ModuleManager::create_module_net(const ModuleId& module) {
 
   /* Allocate net-related data structures */
   net_names_[module].emplace_back();
-  net_src_ids_[module].emplace_back();
-  net_src_terminal_ids_[module].emplace_back();
-  net_src_instance_ids_[module].emplace_back();
-  net_src_pin_ids_[module].emplace_back();
+  net_src_spans_[module].push_back({0, 0, 0});
 
   /* Reserve a source */
   reserve_module_net_sources(module, net, 1);
 
-  net_sink_ids_[module].emplace_back();
-  net_sink_terminal_ids_[module].emplace_back();
-  net_sink_instance_ids_[module].emplace_back();
-  net_sink_pin_ids_[module].emplace_back();
+  net_sink_spans_[module].push_back({0, 0, 0});
 
-  /* Reserve a source */
+  /* Reserve a sink */
   reserve_module_net_sinks(module, net, 1);
 
   return net;
@@ -1056,11 +1207,11 @@ void ModuleManager::reserve_module_net_sources(const ModuleId& module,
                                                const size_t& num_sources) {
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
+  /* Frozen nets are read-only */
+  VTR_ASSERT(false == nets_frozen_[module]);
 
-  net_src_ids_[module][net].reserve(num_sources);
-  net_src_terminal_ids_[module][net].reserve(num_sources);
-  net_src_instance_ids_[module][net].reserve(num_sources);
-  net_src_pin_ids_[module][net].reserve(num_sources);
+  reserve_staged_net_terminals(net_src_spans_[module], net_src_pool_[module],
+                               net, num_sources);
 }
 
 /* Add a source to a net in the connection graph */
@@ -1070,10 +1221,8 @@ ModuleNetSrcId ModuleManager::add_module_net_source(
   const size_t& src_pin) {
   /* Validate the module and net id */
   VTR_ASSERT(valid_module_net_id(module, net));
-
-  /* Create a new id for src node */
-  ModuleNetSrcId net_src = ModuleNetSrcId(net_src_ids_[module][net].size());
-  net_src_ids_[module][net].push_back(net_src);
+  /* Frozen nets are read-only */
+  VTR_ASSERT(false == nets_frozen_[module]);
 
   /* Validate the source module */
   VTR_ASSERT(valid_module_id(src_module));
@@ -1081,39 +1230,28 @@ ModuleNetSrcId ModuleManager::add_module_net_source(
   /* Validate the port exists in the src module */
   VTR_ASSERT(valid_module_port_id(src_module, src_port));
 
-  /* Create pair of module and port
-   * Search in the storage. If found, use the existing pair
-   * Otherwise, add the pair
-   */
-  std::pair<ModuleId, ModulePortId> terminal(src_module, src_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(
-    net_terminal_storage_.begin(), net_terminal_storage_.end(), terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_src_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-    VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-    net_src_terminal_ids_[module][net].push_back(
-      std::distance(net_terminal_storage_.begin(), it));
-  }
-
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t src_instance_id = instance_id;
   if (src_module == module) {
     src_instance_id = 0;
-    net_src_instance_ids_[module][net].push_back(src_instance_id);
   } else {
     /* Check the instance id of the src module */
     VTR_ASSERT(src_instance_id < num_instance(module, src_module));
-    net_src_instance_ids_[module][net].push_back(src_instance_id);
   }
 
   /* Validate the pin id is in the range of the port width */
   VTR_ASSERT(src_pin < module_port(src_module, src_port).get_width());
-  net_src_pin_ids_[module][net].push_back(src_pin);
+
+  /* Create a new id for src node */
+  ModuleNetSrcId net_src = ModuleNetSrcId(add_staged_net_terminal(
+    net_src_spans_[module], net_src_pool_[module], net, src_module,
+    src_instance_id, src_port, src_pin));
 
   /* Update fast look-up for nets */
-  net_lookup_[module][src_module][src_instance_id][src_port][src_pin] = net;
+  size_t pin_index = net_lookup_pin_index(module, src_module, src_instance_id,
+                                          src_port, src_pin);
+  VTR_ASSERT(size_t(-1) != pin_index);
+  net_lookup_[module].at(src_module).nets[pin_index] = net;
 
   return net_src;
 }
@@ -1123,11 +1261,11 @@ void ModuleManager::reserve_module_net_sinks(const ModuleId& module,
                                              const size_t& num_sinks) {
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
+  /* Frozen nets are read-only */
+  VTR_ASSERT(false == nets_frozen_[module]);
 
-  net_sink_ids_[module][net].reserve(num_sinks);
-  net_sink_terminal_ids_[module][net].reserve(num_sinks);
-  net_sink_instance_ids_[module][net].reserve(num_sinks);
-  net_sink_pin_ids_[module][net].reserve(num_sinks);
+  reserve_staged_net_terminals(net_sink_spans_[module], net_sink_pool_[module],
+                               net, num_sinks);
 }
 
 /* Add a sink to a net in the connection graph */
@@ -1137,10 +1275,8 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(
   const size_t& sink_pin) {
   /* Validate the module and net id */
   VTR_ASSERT(valid_module_net_id(module, net));
-
-  /* Create a new id for sink node */
-  ModuleNetSinkId net_sink = ModuleNetSinkId(net_sink_ids_[module][net].size());
-  net_sink_ids_[module][net].push_back(net_sink);
+  /* Frozen nets are read-only */
+  VTR_ASSERT(false == nets_frozen_[module]);
 
   /* Validate the source module */
   VTR_ASSERT(valid_module_id(sink_module));
@@ -1148,43 +1284,377 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(
   /* Validate the port exists in the sink module */
   VTR_ASSERT(valid_module_port_id(sink_module, sink_port));
 
-  /* Create pair of module and port
-   * Search in the storage. If found, use the existing pair
-   * Otherwise, add the pair
-   */
-  std::pair<ModuleId, ModulePortId> terminal(sink_module, sink_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(
-    net_terminal_storage_.begin(), net_terminal_storage_.end(), terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_sink_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-    VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-    net_sink_terminal_ids_[module][net].push_back(
-      std::distance(net_terminal_storage_.begin(), it));
-  }
-
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t sink_instance_id = instance_id;
   if (sink_module == module) {
     sink_instance_id = 0;
-    net_sink_instance_ids_[module][net].push_back(sink_instance_id);
   } else {
     /* Check the instance id of the src module */
     VTR_ASSERT(sink_instance_id < num_instance(module, sink_module));
-    net_sink_instance_ids_[module][net].push_back(sink_instance_id);
   }
 
   /* Validate the pin id is in the range of the port width */
   VTR_ASSERT(sink_pin < module_port(sink_module, sink_port).get_width());
-  net_sink_pin_ids_[module][net].push_back(sink_pin);
+
+  /* Create a new id for sink node */
+  ModuleNetSinkId net_sink = ModuleNetSinkId(add_staged_net_terminal(
+    net_sink_spans_[module], net_sink_pool_[module], net, sink_module,
+    sink_instance_id, sink_port, sink_pin));
 
   /* Update fast look-up for nets */
-  net_lookup_[module][sink_module][sink_instance_id][sink_port][sink_pin] = net;
+  size_t pin_index = net_lookup_pin_index(module, sink_module, sink_instance_id,
+                                          sink_port, sink_pin);
+  VTR_ASSERT(size_t(-1) != pin_index);
+  net_lookup_[module].at(sink_module).nets[pin_index] = net;
 
   return net_sink;
 }
 
+/* Connect a range of pins of a source port to a range of pins of a sink port
+ * in the connection graph */
+void ModuleManager::add_module_nets_between_ports(
+  const ModuleId& module, const ModuleId& src_module,
+  const size_t& src_instance, const ModulePortId& src_port,
+  const size_t& src_pin_start, const ModuleId& sink_module,
+  const size_t& sink_instance, const ModulePortId& sink_port,
+  const size_t& sink_pin_start, const size_t& num_pins) {
+  /* Validate the module id */
+  VTR_ASSERT(valid_module_id(module));
+  /* Frozen nets are read-only */
+  VTR_ASSERT(false == nets_frozen_[module]);
+
+  /* Validate the ports and the pin ranges */
+  VTR_ASSERT(valid_module_port_id(src_module, src_port));
+  VTR_ASSERT(valid_module_port_id(sink_module, sink_port));
+  VTR_ASSERT(src_pin_start + num_pins <=
+             module_port(src_module, src_port).get_width());
+  VTR_ASSERT(sink_pin_start + num_pins <=
+             module_port(sink_module, sink_port).get_width());
+
+  /* if it has the same id as module, our instance id will be by default 0 */
+  size_t src_instance_id = 0;
+  if (src_module != module) {
+    VTR_ASSERT(src_instance < num_instance(module, src_module));
+    src_instance_id = src_instance;
+  }
+  size_t sink_instance_id = 0;
+  if (sink_module != module) {
+    VTR_ASSERT(sink_instance < num_instance(module, sink_module));
+    sink_instance_id = sink_instance;
+  }
+
+  /* The look-ups are shared by all the pins */
+  size_t src_pin_index = net_lookup_pin_index(module, src_module,
+                                              src_instance_id, src_port,
+                                              src_pin_start);
+  size_t sink_pin_index = net_lookup_pin_index(module, sink_module,
+                                               sink_instance_id, sink_port,
+                                               sink_pin_start);
+  if (0 == num_pins) {
+    return;
+  }
+  VTR_ASSERT(size_t(-1) != src_pin_index);
+  VTR_ASSERT(size_t(-1) != sink_pin_index);
+  MappedVector<ModuleNetId>& src_nets =
+    net_lookup_[module].at(src_module).nets;
+  MappedVector<ModuleNetId>& sink_nets =
+    net_lookup_[module].at(sink_module).nets;
+  VTR_ASSERT(src_pin_index + num_pins <= src_nets.size());
+  VTR_ASSERT(sink_pin_index + num_pins <= sink_nets.size());
+
+  for (size_t ipin = 0; ipin < num_pins; ++ipin) {
+    ModuleNetId net = src_nets[src_pin_index + ipin];
+    if (ModuleNetId::INVALID() == net) {
+      net = create_module_net(module);
+      add_staged_net_terminal(net_src_spans_[module], net_src_pool_[module],
+                              net, src_module, src_instance_id, src_port,
+                              src_pin_start + ipin);
+      src_nets[src_pin_index + ipin] = net;
+    }
+    add_staged_net_terminal(net_sink_spans_[module], net_sink_pool_[module],
+                            net, sink_module, sink_instance_id, sink_port,
+                            sink_pin_start + ipin);
+    sink_nets[sink_pin_index + ipin] = net;
+  }
+}
+
+/* Pack the sources and sinks of all the nets in a module into flat arrays */
+void ModuleManager::freeze_module_nets(const ModuleId& module) {
+  /* Validate the module id */
+  VTR_ASSERT(valid_module_id(module));
+  if (true == nets_frozen_[module]) {
+    return;
+  }
+
+  /* Compact the staged slots of the nets, in the sequence of the nets.
+   * The arrays are allocated only once, at their final sizes */
+  auto pack_terminals = [&](const MappedVector<ModuleNetTerminalSpan>& spans,
+                            const MappedVector<ModuleNetTerminal>& pool,
+                            MappedVector<size_t>& offsets,
+                            MappedVector<ModuleNetTerminal>& terminals) {
+    size_t num_terminals = 0;
+    for (const ModuleNetTerminalSpan& span : spans) {
+      num_terminals += span.size;
+    }
+    offsets.reserve(spans.size() + 1);
+    terminals.reserve(num_terminals);
+    for (const ModuleNetTerminalSpan& span : spans) {
+      offsets.push_back(terminals.size());
+      terminals.insert(terminals.end(), pool.begin() + span.offset,
+                       pool.begin() + span.offset + span.size);
+    }
+    offsets.push_back(terminals.size());
+  };
+  VTR_ASSERT(num_nets_[module] == net_src_spans_[module].size());
+  VTR_ASSERT(num_nets_[module] == net_sink_spans_[module].size());
+  pack_terminals(net_src_spans_[module], net_src_pool_[module],
+                 net_src_offsets_[module], net_src_terminals_[module]);
+  pack_terminals(net_sink_spans_[module], net_sink_pool_[module],
+                 net_sink_offsets_[module], net_sink_terminals_[module]);
+
+  /* Release the staged storage */
+  MappedVector<ModuleNetTerminalSpan>().swap(net_src_spans_[module]);
+  MappedVector<ModuleNetTerminal>().swap(net_src_pool_[module]);
+  MappedVector<ModuleNetTerminalSpan>().swap(net_sink_spans_[module]);
+  MappedVector<ModuleNetTerminal>().swap(net_sink_pool_[module]);
+
+  nets_frozen_[module] = true;
+}
+
+/* Freeze the nets of all the modules */
+void ModuleManager::freeze_nets() {
+  for (const ModuleId& module : ids_) {
+    freeze_module_nets(module);
+  }
+}
+
+/******************************************************************************
+ * Public staging
+ ******************************************************************************/
+ModuleManager ModuleManager::create_staging() const {
+  ModuleManager staging(*this);
+  staging.num_staging_base_modules_ = num_modules();
+  return staging;
+}
+
+void ModuleManager::merge_staged_modules(const ModuleManager& staging) {
+  size_t num_base_modules = staging.num_staging_base_modules_;
+  VTR_ASSERT(num_base_modules <= num_modules());
+
+  /* The existing modules can only get new parents in the staging */
+  for (size_t imodule = 0; imodule < num_base_modules; ++imodule) {
+    ModuleId module = ModuleId(imodule);
+    VTR_ASSERT(staging.children_[module].size() == children_[module].size());
+    VTR_ASSERT(staging.port_ids_[module].size() == port_ids_[module].size());
+    VTR_ASSERT(staging.num_nets_[module] == num_nets_[module]);
+  }
+
+  /* Map the modules of the staging to the merged modules. The staged
+   * modules whose names are already used are mapped to the existing ones */
+  vtr::vector<ModuleId, ModuleId> module_map(staging.num_modules(),
+                                             ModuleId::INVALID());
+  std::vector<ModuleId> new_modules;
+  size_t num_merged_modules = num_modules();
+  for (const ModuleId& module : staging.ids_) {
+    if (size_t(module) < num_base_modules) {
+      module_map[module] = module;
+      continue;
+    }
+    auto result = name_id_map_.find(staging.names_[module]);
+    if (result != name_id_map_.end()) {
+      VTR_ASSERT(staging.port_ids_[module].size() ==
+                 port_ids_[result->second].size());
+      module_map[module] = result->second;
+      continue;
+    }
+    module_map[module] = ModuleId(num_merged_modules);
+    num_merged_modules++;
+    new_modules.push_back(module);
+  }
+
+  /* Map the modules of the net terminals of the staging. Only the used
+   * slots of the pool are mapped */
+  auto map_terminals = [&](const MappedVector<ModuleNetTerminalSpan>& spans,
+                           MappedVector<ModuleNetTerminal> pool) {
+    for (const ModuleNetTerminalSpan& span : spans) {
+      for (size_t iterm = span.offset; iterm < span.offset + span.size;
+           ++iterm) {
+        pool[iterm].module = module_map[pool[iterm].module];
+      }
+    }
+    return pool;
+  };
+  auto map_modules = [&](const std::vector<ModuleId>& modules) {
+    std::vector<ModuleId> merged_modules;
+    merged_modules.reserve(modules.size());
+    for (const ModuleId& module : modules) {
+      merged_modules.push_back(module_map[module]);
+    }
+    return merged_modules;
+  };
+
+  /* Append the new modules */
+  for (const ModuleId& module : new_modules) {
+    ModuleId merged_module = ModuleId(ids_.size());
+    VTR_ASSERT(merged_module == module_map[module]);
+    /* The nets are frozen only when the fabric is complete */
+    VTR_ASSERT(false == staging.nets_frozen_[module]);
+
+    ids_.push_back(merged_module);
+    names_.push_back(staging.names_[module]);
+    usages_.push_back(staging.usages_[module]);
+    /* Parents are added below, together with the parents of other modules */
+    parents_.emplace_back();
+    children_.push_back(map_modules(staging.children_[module]));
+    num_child_instances_.push_back(staging.num_child_instances_[module]);
+    child_instance_names_.push_back(staging.child_instance_names_[module]);
+    child_instance_name_lookup_.push_back(
+      staging.child_instance_name_lookup_[module]);
+    configurable_children_.push_back(
+      map_modules(staging.configurable_children_[module]));
+    configurable_child_instances_.push_back(
+      staging.configurable_child_instances_[module]);
+    configurable_child_regions_.push_back(
+      staging.configurable_child_regions_[module]);
+    configurable_child_coordinates_.push_back(
+      staging.configurable_child_coordinates_[module]);
+
+    config_region_ids_.push_back(staging.config_region_ids_[module]);
+    config_region_children_.push_back(staging.config_region_children_[module]);
+
+    io_children_.push_back(map_modules(staging.io_children_[module]));
+    io_child_instances_.push_back(staging.io_child_instances_[module]);
+    io_child_coordinates_.push_back(staging.io_child_coordinates_[module]);
+
+    port_ids_.push_back(staging.port_ids_[module]);
+    ports_.push_back(staging.ports_[module]);
+    port_types_.push_back(staging.port_types_[module]);
+    port_is_wire_.push_back(staging.port_is_wire_[module]);
+    port_is_mappable_io_.push_back(staging.port_is_mappable_io_[module]);
+    port_is_register_.push_back(staging.port_is_register_[module]);
+    port_preproc_flags_.push_back(staging.port_preproc_flags_[module]);
+
+    num_nets_.push_back(staging.num_nets_[module]);
+    invalid_net_ids_.push_back(staging.invalid_net_ids_[module]);
+    net_names_.push_back(staging.net_names_[module]);
+    net_src_spans_.push_back(staging.net_src_spans_[module]);
+    net_src_pool_.push_back(map_terminals(staging.net_src_spans_[module],
+                                          staging.net_src_pool_[module]));
+    net_sink_spans_.push_back(staging.net_sink_spans_[module]);
+    net_sink_pool_.push_back(map_terminals(staging.net_sink_spans_[module],
+                                           staging.net_sink_pool_[module]));
+
+    nets_frozen_.push_back(false);
+    net_src_offsets_.emplace_back();
+    net_src_terminals_.emplace_back();
+    net_sink_offsets_.emplace_back();
+    net_sink_terminals_.emplace_back();
+
+    name_id_map_[names_[merged_module]] = merged_module;
+    port_lookup_.push_back(staging.port_lookup_[module]);
+    port_name_lookup_.push_back(staging.port_name_lookup_[module]);
+
+    port_pin_offsets_.push_back(staging.port_pin_offsets_[module]);
+    num_pins_.push_back(staging.num_pins_[module]);
+    net_lookup_.emplace_back();
+    for (const auto& child_lookup : staging.net_lookup_[module]) {
+      net_lookup_[merged_module].emplace(module_map[child_lookup.first],
+                                         child_lookup.second);
+    }
+  }
+
+  /* Add the staged parents to the merged modules, including the existing
+   * modules which are instanciated by the staged modules */
+  for (const ModuleId& module : staging.ids_) {
+    ModuleId merged_module = module_map[module];
+    for (const ModuleId& parent : staging.parents_[module]) {
+      if (size_t(parent) < num_base_modules) {
+        continue;
+      }
+      ModuleId merged_parent = module_map[parent];
+      if (parents_[merged_module].end() ==
+          std::find(parents_[merged_module].begin(),
+                    parents_[merged_module].end(), merged_parent)) {
+        parents_[merged_module].push_back(merged_parent);
+      }
+    }
+  }
+}
+
+void ModuleManager::merge_staged_nets(const ModuleNetStaging& staging) {
+  ModuleId module = staging.module();
+  VTR_ASSERT(valid_module_id(module));
+  /* Frozen nets are read-only */
+  VTR_ASSERT(false == nets_frozen_[module]);
+  /* The net ids of the staging start from the nets of the module */
+  VTR_ASSERT(staging.num_base_nets() == num_nets_[module]);
+
+  /* Create all the reserved nets at once */
+  size_t num_base_nets = num_nets_[module];
+  size_t num_nets = num_base_nets + staging.num_reserved_nets();
+  net_names_[module].resize(num_nets);
+  net_src_spans_[module].resize(num_nets, {0, 0, 0});
+  net_sink_spans_[module].resize(num_nets, {0, 0, 0});
+  num_nets_[module] = num_nets;
+
+  /* Give the new nets their exact numbers of slots, packed in the sequence
+   * of the nets at the end of the pools, as if the nets were frozen */
+  for (size_t islot = 0; islot < staging.num_slots(); ++islot) {
+    const ModuleNetStagingBlock& block = staging.block(islot);
+    for (const ModuleNetStagedTerminal& src : block.sources()) {
+      if (size_t(src.net) >= num_base_nets) {
+        net_src_spans_[module][size_t(src.net)].capacity++;
+      }
+    }
+    for (const ModuleNetStagedTerminal& sink : block.sinks()) {
+      if (size_t(sink.net) >= num_base_nets) {
+        net_sink_spans_[module][size_t(sink.net)].capacity++;
+      }
+    }
+  }
+  auto allocate_slots = [&](MappedVector<ModuleNetTerminalSpan>& spans,
+                            MappedVector<ModuleNetTerminal>& pool) {
+    size_t offset = pool.size();
+    for (size_t inet = num_base_nets; inet < num_nets; ++inet) {
+      spans[inet].offset = offset;
+      offset += spans[inet].capacity;
+    }
+    pool.resize(offset);
+  };
+  allocate_slots(net_src_spans_[module], net_src_pool_[module]);
+  allocate_slots(net_sink_spans_[module], net_sink_pool_[module]);
+
+  for (size_t islot = 0; islot < staging.num_slots(); ++islot) {
+    const ModuleNetStagingBlock& block = staging.block(islot);
+    /* The ids which are reserved but not used are invalid nets */
+    for (size_t inet = block.num_used_nets(); inet < block.num_nets();
+         ++inet) {
+      invalid_net_ids_[module].insert(
+        ModuleNetId(size_t(block.first_net()) + inet));
+    }
+
+    for (const ModuleNetStagedTerminal& src : block.sources()) {
+      add_staged_net_terminal(net_src_spans_[module], net_src_pool_[module],
+                              src.net, src.module, src.instance, src.port,
+                              src.pin);
+      size_t pin_index = net_lookup_pin_index(module, src.module, src.instance,
+                                              src.port, src.pin);
+      VTR_ASSERT(size_t(-1) != pin_index);
+      net_lookup_[module].at(src.module).nets[pin_index] = src.net;
+    }
+
+    for (const ModuleNetStagedTerminal& sink : block.sinks()) {
+      add_staged_net_terminal(net_sink_spans_[module], net_sink_pool_[module],
+                              sink.net, sink.module, sink.instance, sink.port,
+                              sink.pin);
+      size_t pin_index = net_lookup_pin_index(
+        module, sink.module, sink.instance, sink.port, sink.pin);
+      VTR_ASSERT(size_t(-1) != pin_index);
+      net_lookup_[module].at(sink.module).nets[pin_index] = sink.net;
+    }
+  }
+}
+
 /******************************************************************************
  * Public Deconstructor
  ******************************************************************************/
@@ -1212,6 +1682,48 @@ void ModuleManager::clear_io_children(const ModuleId& parent_module) {
   io_child_coordinates_[parent_module].clear();
 }
 
+/******************************************************************************
+ * Private mutators
+ ******************************************************************************/
+void ModuleManager::reserve_staged_net_terminals(
+  MappedVector<ModuleNetTerminalSpan>& spans,
+  MappedVector<ModuleNetTerminal>& pool, const ModuleNetId& net,
+  const size_t& capacity) {
+  ModuleNetTerminalSpan& span = spans[size_t(net)];
+  if (capacity <= span.capacity) {
+    return;
+  }
+  /* The slots at the end of the pool can grow in place */
+  if ((0 < span.capacity) && (span.offset + span.capacity == pool.size())) {
+    pool.resize(span.offset + capacity);
+    span.capacity = capacity;
+    return;
+  }
+  size_t offset = pool.size();
+  pool.resize(offset + capacity);
+  std::copy(pool.begin() + span.offset, pool.begin() + span.offset + span.size,
+            pool.begin() + offset);
+  span.offset = offset;
+  span.capacity = capacity;
+}
+
+size_t ModuleManager::add_staged_net_terminal(
+  MappedVector<ModuleNetTerminalSpan>& spans,
+  MappedVector<ModuleNetTerminal>& pool, const ModuleNetId& net,
+  const ModuleId& module, const size_t& instance, const ModulePortId& port,
+  const size_t& pin) {
+  VTR_ASSERT(instance <= std::numeric_limits<uint32_t>::max());
+  VTR_ASSERT(pin <= std::numeric_limits<uint32_t>::max());
+  ModuleNetTerminalSpan& span = spans[size_t(net)];
+  if (span.size == span.capacity) {
+    reserve_staged_net_terminals(spans, pool, net,
+                                 std::max<size_t>(1, 2 * span.capacity));
+  }
+  pool[span.offset + span.size] = {module, port, uint32_t(instance),
+                                   uint32_t(pin)};
+  return span.size++;
+}
+
 /******************************************************************************
  * Private validators/invalidators
  ******************************************************************************/
@@ -1257,8 +1769,144 @@ bool ModuleManager::valid_region_id(const ModuleId& module,
 
 void ModuleManager::invalidate_name2id_map() { name_id_map_.clear(); }
 
-void ModuleManager::invalidate_port_lookup() { port_lookup_.clear(); }
+void ModuleManager::invalidate_port_lookup() {
+  port_lookup_.clear();
+  port_name_lookup_.clear();
+}
+
+void ModuleManager::invalidate_net_lookup() {
+  port_pin_offsets_.clear();
+  num_pins_.clear();
+  net_lookup_.clear();
+}
+
+/******************************************************************************
+ * Public binary image writer/reader
+ ******************************************************************************/
+/* Write all the internal data, including the fast look-ups, so that the
+ * module graph can be restored without rebuilding any look-up */
+void ModuleManager::write_to_binary_image(BinaryImageWriter& writer) const {
+  write_binary_image(writer, ids_);
+  write_binary_image(writer, names_);
+  write_binary_image(writer, usages_);
+  write_binary_image(writer, parents_);
+  write_binary_image(writer, children_);
+  write_binary_image(writer, num_child_instances_);
+  write_binary_image(writer, child_instance_names_);
+  write_binary_image(writer, child_instance_name_lookup_);
+  write_binary_image(writer, configurable_children_);
+  write_binary_image(writer, configurable_child_instances_);
+  write_binary_image(writer, configurable_child_regions_);
+  write_binary_image(writer, configurable_child_coordinates_);
+  write_binary_image(writer, config_region_ids_);
+  write_binary_image(writer, config_region_children_);
+  write_binary_image(writer, io_children_);
+  write_binary_image(writer, io_child_instances_);
+  write_binary_image(writer, io_child_coordinates_);
+  write_binary_image(writer, port_ids_);
+  write_binary_image(writer, ports_);
+  write_binary_image(writer, port_types_);
+  write_binary_image(writer, port_is_mappable_io_);
+  write_binary_image(writer, port_is_wire_);
+  write_binary_image(writer, port_is_register_);
+  write_binary_image(writer, port_preproc_flags_);
+  write_binary_image(writer, num_nets_);
+  write_binary_image(writer, invalid_net_ids_);
+  write_binary_image(writer, net_names_);
+  write_binary_image(writer, net_src_spans_);
+  write_binary_image(writer, net_src_pool_);
+  write_binary_image(writer, net_sink_spans_);
+  write_binary_image(writer, net_sink_pool_);
+  write_binary_image(writer, nets_frozen_);
+  write_binary_image(writer, net_src_offsets_);
+  write_binary_image(writer, net_src_terminals_);
+  write_binary_image(writer, net_sink_offsets_);
+  write_binary_image(writer, net_sink_terminals_);
+  write_binary_image(writer, name_id_map_);
+  write_binary_image(writer, port_lookup_);
+  write_binary_image(writer, port_name_lookup_);
+  write_binary_image(writer, port_pin_offsets_);
+  write_binary_image(writer, num_pins_);
+
+  write_binary_image(writer, static_cast<uint64_t>(net_lookup_.size()));
+  for (const auto& module_net_lookup : net_lookup_) {
+    write_binary_image(writer, static_cast<uint64_t>(module_net_lookup.size()));
+    /* Write the child modules in order, so that the image does not depend
+     * on how the hash map is built, e.g., by merging staged modules */
+    std::vector<ModuleId> child_modules;
+    child_modules.reserve(module_net_lookup.size());
+    for (const auto& child_net_lookup : module_net_lookup) {
+      child_modules.push_back(child_net_lookup.first);
+    }
+    std::sort(child_modules.begin(), child_modules.end());
+    for (const ModuleId& child_module : child_modules) {
+      write_binary_image(writer, child_module);
+      const ModuleNetLookup& lookup = module_net_lookup.at(child_module);
+      write_binary_image(writer, static_cast<uint64_t>(lookup.num_pins));
+      write_binary_image(writer, lookup.nets);
+    }
+  }
+}
 
-void ModuleManager::invalidate_net_lookup() { net_lookup_.clear(); }
+/* Replace all the internal data with the data of an image, which must be
+ * written by write_to_binary_image() */
+void ModuleManager::read_from_binary_image(BinaryImageReader& reader) {
+  read_binary_image(reader, ids_);
+  read_binary_image(reader, names_);
+  read_binary_image(reader, usages_);
+  read_binary_image(reader, parents_);
+  read_binary_image(reader, children_);
+  read_binary_image(reader, num_child_instances_);
+  read_binary_image(reader, child_instance_names_);
+  read_binary_image(reader, child_instance_name_lookup_);
+  read_binary_image(reader, configurable_children_);
+  read_binary_image(reader, configurable_child_instances_);
+  read_binary_image(reader, configurable_child_regions_);
+  read_binary_image(reader, configurable_child_coordinates_);
+  read_binary_image(reader, config_region_ids_);
+  read_binary_image(reader, config_region_children_);
+  read_binary_image(reader, io_children_);
+  read_binary_image(reader, io_child_instances_);
+  read_binary_image(reader, io_child_coordinates_);
+  read_binary_image(reader, port_ids_);
+  read_binary_image(reader, ports_);
+  read_binary_image(reader, port_types_);
+  read_binary_image(reader, port_is_mappable_io_);
+  read_binary_image(reader, port_is_wire_);
+  read_binary_image(reader, port_is_register_);
+  read_binary_image(reader, port_preproc_flags_);
+  read_binary_image(reader, num_nets_);
+  read_binary_image(reader, invalid_net_ids_);
+  read_binary_image(reader, net_names_);
+  read_binary_image(reader, net_src_spans_);
+  read_binary_image(reader, net_src_pool_);
+  read_binary_image(reader, net_sink_spans_);
+  read_binary_image(reader, net_sink_pool_);
+  read_binary_image(reader, nets_frozen_);
+  read_binary_image(reader, net_src_offsets_);
+  read_binary_image(reader, net_src_terminals_);
+  read_binary_image(reader, net_sink_offsets_);
+  read_binary_image(reader, net_sink_terminals_);
+  read_binary_image(reader, name_id_map_);
+  read_binary_image(reader, port_lookup_);
+  read_binary_image(reader, port_name_lookup_);
+  read_binary_image(reader, port_pin_offsets_);
+  read_binary_image(reader, num_pins_);
+
+  net_lookup_.clear();
+  net_lookup_.resize(read_binary_image_size(reader));
+  for (auto& module_net_lookup : net_lookup_) {
+    size_t num_children = read_binary_image_size(reader);
+    for (size_t ichild = 0; ichild < num_children; ++ichild) {
+      ModuleId child_module;
+      uint64_t num_pins = 0;
+      read_binary_image(reader, child_module);
+      read_binary_image(reader, num_pins);
+      ModuleNetLookup& child_net_lookup = module_net_lookup[child_module];
+      child_net_lookup.num_pins = num_pins;
+      read_binary_image(reader, child_net_lookup.nets);
+    }
+  }
+}
 
 } /* end namespace openfpga */
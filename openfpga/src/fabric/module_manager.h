@@ -1,20 +1,29 @@
 #ifndef MODULE_MANAGER_H
 #define MODULE_MANAGER_H
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <map>
 #include <string>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "module_manager_fwd.h"
+#include "openfpga_binary_image.h"
+#include "openfpga_mapped_allocator.h"
 #include "openfpga_port.h"
+#include "vtr_assert.h"
 #include "vtr_geometry.h"
 #include "vtr_vector.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+class ModuleNetStaging;
+
 /******************************************************************************
  * This files includes data structures for module management.
  * It keeps a list of modules that have been generated, the port map of the
@@ -69,6 +78,8 @@ class ModuleManager {
   };
 
  public: /* Public Constructors */
+  ModuleManager();
+
  public: /* Type implementations */
   /*
    * This class (forward delcared above) is a template used to represent a
@@ -139,10 +150,8 @@ class ModuleManager {
   typedef vtr::vector<ModulePortId, ModulePortId>::const_iterator
     module_port_iterator;
   typedef lazy_id_iterator<ModuleNetId> module_net_iterator;
-  typedef vtr::vector<ModuleNetSrcId, ModuleNetSrcId>::const_iterator
-    module_net_src_iterator;
-  typedef vtr::vector<ModuleNetSinkId, ModuleNetSinkId>::const_iterator
-    module_net_sink_iterator;
+  typedef lazy_id_iterator<ModuleNetSrcId> module_net_src_iterator;
+  typedef lazy_id_iterator<ModuleNetSinkId> module_net_sink_iterator;
   typedef vtr::vector<ConfigRegionId, ConfigRegionId>::const_iterator
     region_iterator;
 
@@ -153,6 +162,113 @@ class ModuleManager {
   typedef vtr::Range<module_net_sink_iterator> module_net_sink_range;
   typedef vtr::Range<region_iterator> region_range;
 
+  /* Iterator on the ids [0, num_instances) of the instances of a child
+   * module, which are counted instead of being stored */
+  class instance_iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef size_t value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const size_t* pointer;
+    typedef size_t reference;
+
+    explicit instance_iterator(const size_t& instance) : instance_(instance) {}
+    size_t operator*() const { return instance_; }
+    instance_iterator& operator++() {
+      ++instance_;
+      return *this;
+    }
+    bool operator==(const instance_iterator& other) const {
+      return instance_ == other.instance_;
+    }
+    bool operator!=(const instance_iterator& other) const {
+      return instance_ != other.instance_;
+    }
+
+   private:
+    size_t instance_;
+  };
+  typedef vtr::Range<instance_iterator> instance_range;
+
+ private: /* Storage of a net terminal, see net_src_terminals_ */
+  struct ModuleNetTerminal {
+    ModuleId module;
+    ModulePortId port;
+    uint32_t instance;
+    uint32_t pin;
+  };
+  /* Slots of the staged terminals of a net, see net_src_spans_ */
+  struct ModuleNetTerminalSpan {
+    size_t offset;
+    size_t size;
+    size_t capacity;
+  };
+  /* The largest arrays of the nets, e.g., those of the top-level module of a
+   * large fabric, can be backed by files. See ScopedMappedAllocation */
+  template <class T>
+  using MappedVector = std::vector<T, MappedAllocator<T>>;
+
+ public: /* Views on the terminals of nets */
+  /* A source or a sink of a net */
+  struct NetTerminal {
+    ModuleId module;
+    size_t instance;
+    ModulePortId port;
+    size_t pin;
+  };
+
+  /* A read-only view on the sources or the sinks of a net, which refers to
+   * the storage of the module manager instead of copying it, so that the
+   * writers can walk through the nets of a large module without allocating
+   * memory. A view is invalidated when terminals are added to the module,
+   * or when the nets of the module are frozen */
+  class NetTerminalView {
+   public: /* Iterator */
+    class const_iterator {
+     public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef NetTerminal value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const NetTerminal* pointer;
+      typedef NetTerminal reference;
+
+      const_iterator(const NetTerminalView& view, const size_t& index)
+        : view_(&view), index_(index) {}
+      NetTerminal operator*() const { return (*view_)[index_]; }
+      const_iterator& operator++() {
+        ++index_;
+        return *this;
+      }
+      bool operator==(const const_iterator& other) const {
+        return index_ == other.index_;
+      }
+      bool operator!=(const const_iterator& other) const {
+        return index_ != other.index_;
+      }
+
+     private:
+      const NetTerminalView* view_;
+      size_t index_;
+    };
+
+   public: /* Public accessors */
+    size_t size() const { return size_; }
+    bool empty() const { return 0 == size_; }
+    NetTerminal operator[](const size_t& index) const {
+      VTR_ASSERT_SAFE(index < size_);
+      const ModuleNetTerminal& terminal = terminals_[index];
+      return {terminal.module, terminal.instance, terminal.port, terminal.pin};
+    }
+    const_iterator begin() const { return const_iterator(*this, 0); }
+    const_iterator end() const { return const_iterator(*this, size_); }
+
+   private: /* Internal data, filled by the module manager */
+    friend class ModuleManager;
+    /* Terminals of the net, either staged or frozen */
+    const ModuleNetTerminal* terminals_ = nullptr;
+    size_t size_ = 0;
+  };
+
  public: /* Public aggregators */
   /* Find all the modules */
   module_range modules() const;
@@ -160,29 +276,34 @@ class ModuleManager {
   module_port_range module_ports(const ModuleId& module) const;
   /* Find all the nets belonging to a module */
   module_net_range module_nets(const ModuleId& module) const;
+  /* The lists of children below are returned by reference, so that walking
+   * through a hierarchy does not copy them. A reference is invalidated when
+   * children are added to the parent module, or when modules are added */
   /* Find all the child modules under a parent module */
-  std::vector<ModuleId> child_modules(const ModuleId& parent_module) const;
+  const std::vector<ModuleId>& child_modules(
+    const ModuleId& parent_module) const;
   /* Find all the instances under a parent module */
-  std::vector<size_t> child_module_instances(
-    const ModuleId& parent_module, const ModuleId& child_module) const;
+  instance_range child_module_instances(const ModuleId& parent_module,
+                                        const ModuleId& child_module) const;
   /* Find all the configurable child modules under a parent module */
-  std::vector<ModuleId> configurable_children(
+  const std::vector<ModuleId>& configurable_children(
     const ModuleId& parent_module) const;
   /* Find all the instances of configurable child modules under a parent module
    */
-  std::vector<size_t> configurable_child_instances(
+  const std::vector<size_t>& configurable_child_instances(
     const ModuleId& parent_module) const;
   /* Find the coordindate of a configurable child module under a parent module
    */
-  std::vector<vtr::Point<int>> configurable_child_coordinates(
+  const std::vector<vtr::Point<int>>& configurable_child_coordinates(
     const ModuleId& parent_module) const;
 
   /* Find all the I/O child modules under a parent module */
-  std::vector<ModuleId> io_children(const ModuleId& parent_module) const;
+  const std::vector<ModuleId>& io_children(const ModuleId& parent_module) const;
   /* Find all the instances of I/O child modules under a parent module */
-  std::vector<size_t> io_child_instances(const ModuleId& parent_module) const;
+  const std::vector<size_t>& io_child_instances(
+    const ModuleId& parent_module) const;
   /* Find the coordindate of an I/O child module under a parent module */
-  std::vector<vtr::Point<int>> io_child_coordinates(
+  const std::vector<vtr::Point<int>>& io_child_coordinates(
     const ModuleId& parent_module) const;
 
   /* Find the source ids of modules */
@@ -211,6 +332,8 @@ class ModuleManager {
  public: /* Public accessors */
   size_t num_modules() const;
   size_t num_nets(const ModuleId& module) const;
+  /* Return the total number of sinks of the nets of a module */
+  size_t num_net_sinks(const ModuleId& module) const;
   std::string module_name(const ModuleId& module_id) const;
   e_module_usage_type module_usage(const ModuleId& module_id) const;
   std::string module_port_type_str(
@@ -259,45 +382,43 @@ class ModuleManager {
                                        const size_t& child_pin) const;
   /* Find the name of net */
   std::string net_name(const ModuleId& module, const ModuleNetId& net) const;
-  /* Find the source modules of a net */
-  vtr::vector<ModuleNetSrcId, ModuleId> net_source_modules(
-    const ModuleId& module, const ModuleNetId& net) const;
-  /* Find the ids of source instances of a net */
-  vtr::vector<ModuleNetSrcId, size_t> net_source_instances(
-    const ModuleId& module, const ModuleNetId& net) const;
-  /* Find the source ports of a net */
-  vtr::vector<ModuleNetSrcId, ModulePortId> net_source_ports(
-    const ModuleId& module, const ModuleNetId& net) const;
-  /* Find the source pin indices of a net */
-  vtr::vector<ModuleNetSrcId, size_t> net_source_pins(
-    const ModuleId& module, const ModuleNetId& net) const;
+  /* View on the sources of a net, without copying them */
+  NetTerminalView net_source_terminals(const ModuleId& module,
+                                       const ModuleNetId& net) const;
   /* Identify if a pin of a port in a module already exists in the net source
    * list*/
   bool net_source_exist(const ModuleId& module, const ModuleNetId& net,
                         const ModuleId& src_module, const size_t& instance_id,
                         const ModulePortId& src_port, const size_t& src_pin);
 
-  /* Find the sink modules of a net */
-  vtr::vector<ModuleNetSinkId, ModuleId> net_sink_modules(
-    const ModuleId& module, const ModuleNetId& net) const;
-  /* Find the ids of sink instances of a net */
-  vtr::vector<ModuleNetSinkId, size_t> net_sink_instances(
-    const ModuleId& module, const ModuleNetId& net) const;
-  /* Find the sink ports of a net */
-  vtr::vector<ModuleNetSinkId, ModulePortId> net_sink_ports(
-    const ModuleId& module, const ModuleNetId& net) const;
-  /* Find the sink pin indices of a net */
-  vtr::vector<ModuleNetSinkId, size_t> net_sink_pins(
-    const ModuleId& module, const ModuleNetId& net) const;
+  /* View on the sinks of a net, without copying them */
+  NetTerminalView net_sink_terminals(const ModuleId& module,
+                                     const ModuleNetId& net) const;
   /* Identify if a pin of a port in a module already exists in the net sink
    * list*/
   bool net_sink_exist(const ModuleId& module, const ModuleNetId& net,
                       const ModuleId& sink_module, const size_t& instance_id,
                       const ModulePortId& sink_port, const size_t& sink_pin);
+  /* Identify if the nets of a module have been frozen */
+  bool module_nets_frozen(const ModuleId& module) const;
+  /* Estimate the memory used by the data of a module, in bytes */
+  size_t module_memory_usage(const ModuleId& module) const;
+  /* Estimate the memory used by the module manager, in bytes */
+  size_t memory_usage() const;
 
  private: /* Private accessors */
   size_t find_child_module_index_in_parent_module(
     const ModuleId& parent_module, const ModuleId& child_module) const;
+  /* Find the number of sources/sinks of a net */
+  size_t num_net_sources(const ModuleId& module, const ModuleNetId& net) const;
+  size_t num_net_sinks(const ModuleId& module, const ModuleNetId& net) const;
+  /* Find the index of a pin of a child instance in the fast look-up for nets
+   * Return size_t(-1) if the pin is not indexed */
+  size_t net_lookup_pin_index(const ModuleId& parent_module,
+                              const ModuleId& child_module,
+                              const size_t& child_instance,
+                              const ModulePortId& child_port,
+                              const size_t& child_pin) const;
 
  public: /* Public mutators */
   /* Add a module */
@@ -423,6 +544,54 @@ class ModuleManager {
                                       const ModulePortId& sink_port,
                                       const size_t& sink_pin);
 
+  /* Connect a range of pins of a source port to a range of pins of a sink
+   * port, where the pin (src_pin_start + i) drives the pin
+   * (sink_pin_start + i). A net is created for each source pin, unless the
+   * source pin already drives a net, to which the sink is then added.
+   * This is the same as create_module_net(), add_module_net_source() and
+   * add_module_net_sink() on each pair of pins, while the ports, the
+   * instances and the terminals are validated and looked up once per call */
+  void add_module_nets_between_ports(
+    const ModuleId& module, const ModuleId& src_module,
+    const size_t& src_instance, const ModulePortId& src_port,
+    const size_t& src_pin_start, const ModuleId& sink_module,
+    const size_t& sink_instance, const ModulePortId& sink_port,
+    const size_t& sink_pin_start, const size_t& num_pins);
+
+  /* Pack the sources and sinks of all the nets in a module into flat arrays,
+   * and release the per-net storage. This reduces the memory footprint and
+   * speeds up net traversal on large modules, e.g., the top-level module.
+   * Once frozen, nets can no longer be created or extended in the module.
+   * Net names can still be modified.
+   */
+  void freeze_module_nets(const ModuleId& module);
+  /* Freeze the nets of all the modules. Call it when the fabric is built */
+  void freeze_nets();
+
+ public: /* Public staging */
+  /* Create a staging module manager, which starts as a copy of this module
+   * manager. Builders can create modules in a staging module manager, e.g.,
+   * on another thread, while looking up and instanciating the existing
+   * modules as usual. The new modules are then merged back by
+   * merge_staged_modules(). The existing modules must not be modified in
+   * the staging module manager, except being instanciated.
+   */
+  ModuleManager create_staging() const;
+  /* Append the modules created in a staging module manager, in the order of
+   * their creation, so that the ids are deterministic as long as the staging
+   * module managers are merged in a fixed order. A staged module whose name
+   * is already used, e.g., a decoder built by several staging module
+   * managers, is replaced by the existing module, which must have the same
+   * ports. This is what a builder would find if running after the others.
+   */
+  void merge_staged_modules(const ModuleManager& staging);
+  /* Add the nets staged by several threads for a module, including their
+   * sources, sinks and the fast look-ups. The blocks of the staging buffer
+   * are merged in the order of their slots. No net can be created in the
+   * module between the creation of the staging buffer and its merging.
+   */
+  void merge_staged_nets(const ModuleNetStaging& staging);
+
  public: /* Public deconstructors */
   /* This is a strong function which will remove all the configurable children
    * under a given parent module
@@ -457,6 +626,25 @@ class ModuleManager {
   bool valid_region_id(const ModuleId& module,
                        const ConfigRegionId& region) const;
 
+ public: /* Public binary image writer/reader */
+  /* Write all the internal data to a binary image */
+  void write_to_binary_image(BinaryImageWriter& writer) const;
+  /* Replace all the internal data with the data of a binary image */
+  void read_from_binary_image(BinaryImageReader& reader);
+
+ private: /* Private mutators */
+  /* Make room for a number of terminals in the slots of a net */
+  static void reserve_staged_net_terminals(
+    MappedVector<ModuleNetTerminalSpan>& spans,
+    MappedVector<ModuleNetTerminal>& pool, const ModuleNetId& net,
+    const size_t& capacity);
+  /* Append a terminal to the slots of a net, and return its index */
+  static size_t add_staged_net_terminal(
+    MappedVector<ModuleNetTerminalSpan>& spans,
+    MappedVector<ModuleNetTerminal>& pool, const ModuleNetId& net,
+    const ModuleId& module, const size_t& instance, const ModulePortId& port,
+    const size_t& pin);
+
  private: /* Private validators/invalidators */
   void invalidate_name2id_map();
   void invalidate_port_lookup();
@@ -477,6 +665,13 @@ class ModuleManager {
   vtr::vector<ModuleId, std::vector<std::vector<std::string>>>
     child_instance_names_; /* Number of children instance in each child module
                             */
+  /* fast look-up for child instances by name:
+   * [parent_module][child_index][instance_name] -> instance_id
+   * Only named instances are indexed. When several instances share the same
+   * name, the first instance is indexed */
+  vtr::vector<ModuleId,
+              std::vector<std::unordered_map<std::string, size_t>>>
+    child_instance_name_lookup_;
 
   /* Configurable child modules are used to record the position of configurable
    * modules in bitstream The sequence of children in the list denotes which one
@@ -550,34 +745,33 @@ class ModuleManager {
     invalid_net_ids_; /* Invalid net ids */
   vtr::vector<ModuleId, vtr::vector<ModuleNetId, std::string>>
     net_names_; /* Name of net */
-
-  vtr::vector<
-    ModuleId,
-    vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, ModuleNetSrcId>>>
-    net_src_ids_; /* Unique id of the source that drive the net */
-  vtr::vector<ModuleId,
-              vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, size_t>>>
-    net_src_terminal_ids_; /* Pin ids that drive the net */
-  vtr::vector<ModuleId,
-              vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, size_t>>>
-    net_src_instance_ids_; /* Pin ids that drive the net */
-  vtr::vector<ModuleId,
-              vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, size_t>>>
-    net_src_pin_ids_; /* Pin ids that drive the net */
-
-  vtr::vector<
-    ModuleId,
-    vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, ModuleNetSinkId>>>
-    net_sink_ids_; /* Unique ids of the sink that the net drives */
-  vtr::vector<ModuleId,
-              vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, size_t>>>
-    net_sink_terminal_ids_; /* Pin ids that the net drives */
-  vtr::vector<ModuleId,
-              vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, size_t>>>
-    net_sink_instance_ids_; /* Pin ids that drive the net */
-  vtr::vector<ModuleId,
-              vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, size_t>>>
-    net_sink_pin_ids_; /* Pin ids that drive the net */
+  /* Sources and sinks are never removed from a net.
+   * The sets are always empty, required by the lazy iterators */
+  std::unordered_set<ModuleNetSrcId> invalid_net_src_ids_;
+  std::unordered_set<ModuleNetSinkId> invalid_net_sink_ids_;
+
+  /* Staged storage of sources and sinks, used when building a module:
+   * the terminals of a net are contiguous slots of a pool, which is shared
+   * by all the nets of the module. A span [offset, offset + capacity) per
+   * net locates its slots, of which the first size ones are used. A net
+   * which runs out of slots is moved to the end of the pool with twice the
+   * slots, so that the pool only grows by appending. The slots left behind
+   * are not reused. Released when the nets of the module are frozen */
+  vtr::vector<ModuleId, MappedVector<ModuleNetTerminalSpan>> net_src_spans_;
+  vtr::vector<ModuleId, MappedVector<ModuleNetTerminal>> net_src_pool_;
+  vtr::vector<ModuleId, MappedVector<ModuleNetTerminalSpan>> net_sink_spans_;
+  vtr::vector<ModuleId, MappedVector<ModuleNetTerminal>> net_sink_pool_;
+
+  /* Frozen storage of sources and sinks, in a compressed sparse row format:
+   * the terminals of all the nets in a module are packed in a single array,
+   * where the terminals of a net start at the offset of the net and end at
+   * the offset of the next net. The offset arrays have (num_nets + 1) entries
+   */
+  vtr::vector<ModuleId, bool> nets_frozen_;
+  vtr::vector<ModuleId, MappedVector<size_t>> net_src_offsets_;
+  vtr::vector<ModuleId, MappedVector<ModuleNetTerminal>> net_src_terminals_;
+  vtr::vector<ModuleId, MappedVector<size_t>> net_sink_offsets_;
+  vtr::vector<ModuleId, MappedVector<ModuleNetTerminal>> net_sink_terminals_;
 
   /* fast look-up for module */
   std::map<std::string, ModuleId> name_id_map_;
@@ -585,20 +779,32 @@ class ModuleManager {
   typedef vtr::vector<ModuleId, std::vector<std::vector<ModulePortId>>>
     PortLookup;
   mutable PortLookup port_lookup_; /* [module_ids][port_types][port_ids] */
-
-  /* fast look-up for nets */
-  typedef vtr::vector<
-    ModuleId,
-    std::map<ModuleId,
-             std::vector<std::map<ModulePortId, std::vector<ModuleNetId>>>>>
+  /* fast look-up for ports by name: [module_ids][port_name] -> port_id
+   * When several ports share the same name, the first port is indexed */
+  vtr::vector<ModuleId, std::unordered_map<std::string, ModulePortId>>
+    port_name_lookup_;
+
+  /* fast look-up for nets
+   * The pins of a module are numbered port by port: a pin is located by the
+   * base offset of its port plus its index in the port.
+   * For each pair of parent and child modules, the nets of the pins of all
+   * the child instances are stored in a flat array, where a pin is located at
+   * [instance_id * num_pins + port_offset + pin_id]
+   * A module is considered as the instance 0 of itself.
+   */
+  vtr::vector<ModuleId, vtr::vector<ModulePortId, size_t>> port_pin_offsets_;
+  vtr::vector<ModuleId, size_t> num_pins_;
+  struct ModuleNetLookup {
+    size_t num_pins; /* Number of pins per instance when the table is created */
+    MappedVector<ModuleNetId> nets;
+  };
+  typedef vtr::vector<ModuleId, std::unordered_map<ModuleId, ModuleNetLookup>>
     NetLookup;
-  mutable NetLookup
-    net_lookup_; /* [module_ids][module_ids][instance_ids][port_ids][pin_ids] */
+  NetLookup net_lookup_; /* [module_ids][module_ids][pin_index] */
 
-  /* Store pairs of a module and a port, which are frequently used in net
-   * terminals (either source or sink)
-   */
-  std::vector<std::pair<ModuleId, ModulePortId>> net_terminal_storage_;
+  /* Number of modules copied when a staging module manager is created.
+   * Always zero for other module managers */
+  size_t num_staging_base_modules_;
 };
 
 } /* end namespace openfpga */
@@ -0,0 +1,146 @@
+/************************************************************************
+ * Member functions for classes ModuleNetStagingBlock and ModuleNetStaging
+ ***********************************************************************/
+#include "module_net_staging.h"
+
+#include "vtr_assert.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/************************************************************************
+ * ModuleNetStagingBlock: Public Accessors
+ ***********************************************************************/
+ModuleNetId ModuleNetStagingBlock::first_net() const {
+  return ModuleNetId(first_net_);
+}
+
+size_t ModuleNetStagingBlock::num_nets() const { return num_nets_; }
+
+size_t ModuleNetStagingBlock::num_used_nets() const { return num_used_nets_; }
+
+const std::vector<ModuleNetStagedTerminal>& ModuleNetStagingBlock::sources()
+  const {
+  return sources_;
+}
+
+const std::vector<ModuleNetStagedTerminal>& ModuleNetStagingBlock::sinks()
+  const {
+  return sinks_;
+}
+
+/************************************************************************
+ * ModuleNetStagingBlock: Public Mutators
+ ***********************************************************************/
+ModuleNetId ModuleNetStagingBlock::create_net() {
+  /* Only reserved ids can be used */
+  VTR_ASSERT(nullptr != module_manager_);
+  VTR_ASSERT(num_used_nets_ < num_nets_);
+  return ModuleNetId(first_net_ + num_used_nets_++);
+}
+
+void ModuleNetStagingBlock::add_net_source(const ModuleNetId& net,
+                                           const ModuleId& src_module,
+                                           const size_t& instance_id,
+                                           const ModulePortId& src_port,
+                                           const size_t& src_pin) {
+  sources_.push_back(
+    create_terminal(net, src_module, instance_id, src_port, src_pin));
+}
+
+void ModuleNetStagingBlock::add_net_sink(const ModuleNetId& net,
+                                         const ModuleId& sink_module,
+                                         const size_t& instance_id,
+                                         const ModulePortId& sink_port,
+                                         const size_t& sink_pin) {
+  sinks_.push_back(
+    create_terminal(net, sink_module, instance_id, sink_port, sink_pin));
+}
+
+/************************************************************************
+ * ModuleNetStagingBlock: Internal validators
+ ***********************************************************************/
+bool ModuleNetStagingBlock::valid_net_id(const ModuleNetId& net) const {
+  return (size_t(net) >= first_net_) &&
+         (size_t(net) < first_net_ + num_used_nets_);
+}
+
+/* Validate a terminal in the same way as ModuleManager::add_module_net_sink()
+ * does, so that merging the terminals never fails */
+ModuleNetStagedTerminal ModuleNetStagingBlock::create_terminal(
+  const ModuleNetId& net, const ModuleId& module, const size_t& instance_id,
+  const ModulePortId& port, const size_t& pin) const {
+  VTR_ASSERT(true == valid_net_id(net));
+  VTR_ASSERT(true == module_manager_->valid_module_port_id(module, port));
+  VTR_ASSERT(pin < module_manager_->module_port(module, port).get_width());
+
+  /* if it has the same id as module, our instance id will be by default 0 */
+  size_t terminal_instance = 0;
+  if (module != parent_module_) {
+    VTR_ASSERT(instance_id <
+               module_manager_->num_instance(parent_module_, module));
+    terminal_instance = instance_id;
+  }
+
+  return {net, module, terminal_instance, port, pin};
+}
+
+/************************************************************************
+ * ModuleNetStaging: Constructors
+ ***********************************************************************/
+ModuleNetStaging::ModuleNetStaging(const ModuleManager& module_manager,
+                                   const ModuleId& module,
+                                   const size_t& num_slots)
+  : module_manager_(module_manager),
+    module_(module),
+    num_base_nets_(0),
+    num_reserved_nets_(0),
+    blocks_(num_slots) {
+  VTR_ASSERT(true == module_manager.valid_module_id(module));
+  /* Frozen nets are read-only */
+  VTR_ASSERT(false == module_manager.module_nets_frozen(module));
+  num_base_nets_ = module_manager.num_nets(module);
+}
+
+/************************************************************************
+ * ModuleNetStaging: Public Accessors
+ ***********************************************************************/
+ModuleId ModuleNetStaging::module() const { return module_; }
+
+size_t ModuleNetStaging::num_base_nets() const { return num_base_nets_; }
+
+size_t ModuleNetStaging::num_reserved_nets() const {
+  return num_reserved_nets_.load();
+}
+
+size_t ModuleNetStaging::num_slots() const { return blocks_.size(); }
+
+const ModuleNetStagingBlock& ModuleNetStaging::block(
+  const size_t& slot) const {
+  VTR_ASSERT(slot < blocks_.size());
+  return blocks_[slot];
+}
+
+/************************************************************************
+ * ModuleNetStaging: Public Mutators
+ ***********************************************************************/
+ModuleNetStagingBlock& ModuleNetStaging::reserve_block(const size_t& slot,
+                                                       const size_t& num_nets) {
+  VTR_ASSERT(slot < blocks_.size());
+  ModuleNetStagingBlock& block = blocks_[slot];
+  /* A slot can only be reserved once */
+  VTR_ASSERT(nullptr == block.module_manager_);
+
+  block.module_manager_ = &module_manager_;
+  block.parent_module_ = module_;
+  block.first_net_ = num_base_nets_ + num_reserved_nets_.fetch_add(num_nets);
+  block.num_nets_ = num_nets;
+  return block;
+}
+
+ModuleNetStagingBlock& ModuleNetStaging::mutable_block(const size_t& slot) {
+  VTR_ASSERT(slot < blocks_.size());
+  return blocks_[slot];
+}
+
+} /* end namespace openfpga */
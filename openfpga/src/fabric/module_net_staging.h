@@ -0,0 +1,124 @@
+#ifndef MODULE_NET_STAGING_H
+#define MODULE_NET_STAGING_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <atomic>
+#include <vector>
+
+#include "module_manager.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A source or a sink of a net which is staged by a thread
+ *******************************************************************/
+struct ModuleNetStagedTerminal {
+  ModuleNetId net;
+  ModuleId module;
+  size_t instance;
+  ModulePortId port;
+  size_t pin;
+};
+
+/********************************************************************
+ * A block of consecutive net ids reserved by a thread, where the thread
+ * creates nets and records their sources and sinks without touching the
+ * module manager. Only the thread owning the block may modify it
+ *******************************************************************/
+class ModuleNetStagingBlock {
+ public: /* Public accessors */
+  /* The first net id of the block, and the number of ids reserved */
+  ModuleNetId first_net() const;
+  size_t num_nets() const;
+  /* The number of ids which have been used by create_net() */
+  size_t num_used_nets() const;
+  const std::vector<ModuleNetStagedTerminal>& sources() const;
+  const std::vector<ModuleNetStagedTerminal>& sinks() const;
+
+ public: /* Public mutators */
+  /* Take the next net id of the block */
+  ModuleNetId create_net();
+  /* Add a source/sink to a net of the block. The terminals are validated
+   * against the module manager, which is only read */
+  void add_net_source(const ModuleNetId& net, const ModuleId& src_module,
+                      const size_t& instance_id, const ModulePortId& src_port,
+                      const size_t& src_pin);
+  void add_net_sink(const ModuleNetId& net, const ModuleId& sink_module,
+                    const size_t& instance_id, const ModulePortId& sink_port,
+                    const size_t& sink_pin);
+
+ private: /* Internal validators */
+  friend class ModuleNetStaging;
+  bool valid_net_id(const ModuleNetId& net) const;
+  ModuleNetStagedTerminal create_terminal(const ModuleNetId& net,
+                                          const ModuleId& module,
+                                          const size_t& instance_id,
+                                          const ModulePortId& port,
+                                          const size_t& pin) const;
+
+ private: /* Internal data */
+  const ModuleManager* module_manager_ = nullptr;
+  ModuleId parent_module_;
+  size_t first_net_ = 0;
+  size_t num_nets_ = 0;
+  size_t num_used_nets_ = 0;
+  std::vector<ModuleNetStagedTerminal> sources_;
+  std::vector<ModuleNetStagedTerminal> sinks_;
+};
+
+/********************************************************************
+ * A staging buffer of the nets added to a module by several threads at
+ * the same time, e.g., when the connections of a fabric are built in
+ * parallel. The buffer has a number of slots, each of which is owned by
+ * a task. A task reserves a block of net ids in its slot, where the ids
+ * are taken from an atomic counter, and fills the block on its own, so
+ * that no lock is taken when creating nets and adding terminals.
+ * The nets, the terminals and the look-ups of the module manager are
+ * updated afterwards by ModuleManager::merge_staged_nets(), which visits
+ * the slots in sequence.
+ *
+ * @note The net ids follow the order in which the blocks are reserved.
+ * To get the same ids regardless of the number of threads, reserve the
+ * blocks in a fixed order, e.g., before the tasks run, and let the tasks
+ * only fill the blocks. The ids of a block which are not used are
+ * invalid nets after merging.
+ * @note The module manager must not be modified until the buffer is
+ * merged, as the blocks only read the module manager
+ *******************************************************************/
+class ModuleNetStaging {
+ public: /* Constructors */
+  ModuleNetStaging(const ModuleManager& module_manager, const ModuleId& module,
+                   const size_t& num_slots);
+
+ public: /* Public accessors */
+  ModuleId module() const;
+  /* The number of nets of the module when the buffer is created */
+  size_t num_base_nets() const;
+  /* The number of net ids reserved by all the blocks */
+  size_t num_reserved_nets() const;
+  size_t num_slots() const;
+  const ModuleNetStagingBlock& block(const size_t& slot) const;
+
+ public: /* Public mutators */
+  /* Reserve a block of net ids in a slot. Thread-safe as long as each
+   * slot is reserved by only one thread. A slot can be reserved once */
+  ModuleNetStagingBlock& reserve_block(const size_t& slot,
+                                       const size_t& num_nets);
+  /* The block of a slot, which is only modified by the owner of the slot */
+  ModuleNetStagingBlock& mutable_block(const size_t& slot);
+
+ private: /* Internal data */
+  const ModuleManager& module_manager_;
+  ModuleId module_;
+  size_t num_base_nets_;
+  std::atomic<size_t> num_reserved_nets_;
+  /* A block is reserved once it refers to the module manager */
+  std::vector<ModuleNetStagingBlock> blocks_;
+};
+
+} /* end namespace openfpga */
+
+#endif
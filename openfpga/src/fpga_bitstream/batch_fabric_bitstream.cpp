@@ -0,0 +1,197 @@
+/********************************************************************
+ * This file includes functions to build and write the fabric bitstreams
+ * of a batch of designs which are implemented on the same fabric.
+ * The fabric, i.e., the module graph, the circuit library, the
+ * configuration protocol, the BL/WL shift register banks and the global
+ * ports, is shared by all the designs in read-only mode, while each
+ * design owns its architecture bitstream and fabric bitstream.
+ * Therefore, the designs can be processed in parallel, and the memory
+ * only grows with the number of designs in process.
+ *******************************************************************/
+#include "batch_fabric_bitstream.h"
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "openfpga_parallel.h"
+#include "openfpga_tokenizer.h"
+#include "openfpga_trace.h"
+
+/* Headers from fpgabitstream library */
+#include "read_binary_arch_bitstream.h"
+#include "read_xml_arch_bitstream.h"
+
+#include "build_fabric_bitstream.h"
+#include "write_text_fabric_bitstream.h"
+#include "write_xml_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Read the list of designs in a batch. Each line of the list contains
+ * the architecture bitstream of a design and the fabric bitstream to
+ * output, separated by spaces. Empty lines and lines starting with '#'
+ * are skipped
+ *******************************************************************/
+int read_batch_fabric_bitstream_list(
+  const std::string& fname, std::vector<BatchFabricBitstreamFiles>& files) {
+  std::ifstream fp(fname);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open the design list: %s!\n", fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  files.clear();
+  std::string line;
+  size_t line_num = 0;
+  while (getline(fp, line)) {
+    line_num++;
+    StringToken tokenizer(line);
+    std::vector<std::string> tokens = tokenizer.split(std::string(" \t\r"));
+    if (tokens.empty() || '#' == tokens[0].front()) {
+      continue;
+    }
+    if (2 != tokens.size()) {
+      VTR_LOG_ERROR(
+        "Expect an architecture bitstream and a fabric bitstream at line %lu "
+        "of the design list: %s!\n",
+        line_num, fname.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    BatchFabricBitstreamFiles design_files;
+    design_files.arch_bitstream = tokens[0];
+    design_files.fabric_bitstream = tokens[1];
+    files.push_back(design_files);
+  }
+  fp.close();
+
+  if (files.empty()) {
+    VTR_LOG_ERROR("No design is found in the design list: %s!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Build and write the fabric bitstream of a design from its
+ * architecture bitstream. Errors of the readers are thrown as exceptions,
+ * which are caught by the caller
+ *******************************************************************/
+static int write_batch_fabric_bitstream(
+  const BatchFabricBitstreamFiles& design_files,
+  const bool& binary_arch_bitstream, const std::string& file_format,
+  const ModuleManager& module_manager,
+  const ConfigChildHierarchy& config_hierarchy,
+  const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol,
+  const MemoryBankShiftRegisterBanks& blwl_sr_banks,
+  const FabricGlobalPortInfo& global_ports, const bool& fast_configuration,
+  const bool& keep_dont_care_bits, const bool& include_time_stamp,
+  const bool& verbose) {
+  OPENFPGA_TRACE_SCOPE(design_files.fabric_bitstream);
+
+  BitstreamManager bitstream_manager =
+    binary_arch_bitstream
+      ? read_binary_architecture_bitstream(design_files.arch_bitstream.c_str())
+      : read_xml_architecture_bitstream(design_files.arch_bitstream.c_str());
+
+  /* Designs are already processed in parallel, use a single thread for each
+   * of them */
+  FabricBitstream fabric_bitstream = build_fabric_dependent_bitstream(
+    bitstream_manager, module_manager, config_hierarchy, circuit_lib,
+    config_protocol, 1, verbose);
+
+  if (std::string("xml") == file_format) {
+    return write_fabric_bitstream_to_xml_file(
+      bitstream_manager, fabric_bitstream, config_protocol,
+      design_files.fabric_bitstream, include_time_stamp, verbose);
+  }
+  return write_fabric_bitstream_to_text_file(
+    bitstream_manager, fabric_bitstream, blwl_sr_banks, config_protocol,
+    global_ports, design_files.fabric_bitstream, fast_configuration,
+    keep_dont_care_bits, std::string("binary") == file_format,
+    std::string("hex") == file_format, include_time_stamp, 1, verbose);
+}
+
+/********************************************************************
+ * Build and write the fabric bitstreams of all the designs in a batch,
+ * which are distributed to the threads dynamically.
+ * A failure on a design does not stop the other designs. The failed
+ * designs are reported once all the designs are processed.
+ *
+ * Note that the shared objects must not be modified during the batch,
+ * including the fast look-ups which are built on demand, e.g., those of
+ * the BL/WL shift register banks, which should be built in advance.
+ *******************************************************************/
+int write_batch_fabric_bitstreams(
+  const std::vector<BatchFabricBitstreamFiles>& files,
+  const bool& binary_arch_bitstream, const std::string& file_format,
+  const ModuleManager& module_manager,
+  const ConfigChildHierarchy& config_hierarchy,
+  const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol,
+  const MemoryBankShiftRegisterBanks& blwl_sr_banks,
+  const FabricGlobalPortInfo& global_ports, const bool& fast_configuration,
+  const bool& keep_dont_care_bits, const bool& include_time_stamp,
+  const size_t& num_threads, const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Write fabric bitstreams of a batch");
+  OPENFPGA_TRACE_FUNCTION();
+
+  /* Create the directories in advance, so that the threads only write
+   * files */
+  for (const BatchFabricBitstreamFiles& design_files : files) {
+    create_directory(find_path_dir_name(design_files.fabric_bitstream));
+  }
+
+  std::vector<int> status(files.size(), CMD_EXEC_SUCCESS);
+  std::vector<std::string> error_msgs(files.size());
+  parallel_for_dynamic(
+    files.size(), std::min(num_threads, files.size()),
+    [&](const size_t& idesign) {
+      try {
+        status[idesign] = write_batch_fabric_bitstream(
+          files[idesign], binary_arch_bitstream, file_format, module_manager,
+          config_hierarchy, circuit_lib, config_protocol, blwl_sr_banks,
+          global_ports, fast_configuration, keep_dont_care_bits,
+          include_time_stamp, verbose);
+      } catch (const std::exception& error) {
+        status[idesign] = CMD_EXEC_FATAL_ERROR;
+        error_msgs[idesign] = error.what();
+      }
+    });
+
+  size_t num_failures = 0;
+  for (size_t idesign = 0; idesign < files.size(); ++idesign) {
+    if (CMD_EXEC_SUCCESS == status[idesign]) {
+      continue;
+    }
+    num_failures++;
+    VTR_LOG_ERROR("Fail to write fabric bitstream '%s' from '%s'! %s\n",
+                  files[idesign].fabric_bitstream.c_str(),
+                  files[idesign].arch_bitstream.c_str(),
+                  error_msgs[idesign].c_str());
+  }
+
+  VTR_LOG("Wrote fabric bitstreams of %lu/%lu designs with %lu threads\n",
+          files.size() - num_failures, files.size(),
+          std::min(num_threads, files.size()));
+
+  if (0 < num_failures) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,47 @@
+#ifndef BATCH_FABRIC_BITSTREAM_H
+#define BATCH_FABRIC_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include <vector>
+
+#include "circuit_library.h"
+#include "config_child_hierarchy.h"
+#include "config_protocol.h"
+#include "fabric_global_port_info.h"
+#include "memory_bank_shift_register_banks.h"
+#include "module_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* The files of a design in a batch: the architecture bitstream to read
+ * and the fabric bitstream to write */
+struct BatchFabricBitstreamFiles {
+  std::string arch_bitstream;
+  std::string fabric_bitstream;
+};
+
+int read_batch_fabric_bitstream_list(
+  const std::string& fname, std::vector<BatchFabricBitstreamFiles>& files);
+
+int write_batch_fabric_bitstreams(
+  const std::vector<BatchFabricBitstreamFiles>& files,
+  const bool& binary_arch_bitstream, const std::string& file_format,
+  const ModuleManager& module_manager,
+  const ConfigChildHierarchy& config_hierarchy,
+  const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol,
+  const MemoryBankShiftRegisterBanks& blwl_sr_banks,
+  const FabricGlobalPortInfo& global_ports, const bool& fast_configuration,
+  const bool& keep_dont_care_bits, const bool& include_time_stamp,
+  const size_t& num_threads, const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,209 @@
+/******************************************************************************
+ * This file includes member functions for data structure BitstreamTileIndex
+ ******************************************************************************/
+#include "bitstream_tile_index.h"
+
+#include "vtr_assert.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Append bits [begin, begin + num_bits) to ranges of bits, merging them with
+ * the last range when they are consecutive */
+static void append_bits_to_ranges(BitstreamTileIndex::bit_ranges& ranges,
+                                  const size_t& begin,
+                                  const size_t& num_bits) {
+  if (0 == num_bits) {
+    return;
+  }
+  if ((false == ranges.empty()) && (begin == ranges.back().second)) {
+    ranges.back().second += num_bits;
+    return;
+  }
+  ranges.push_back(std::make_pair(begin, begin + num_bits));
+}
+
+/* Expand ranges of bits into bit ids */
+template <class ID>
+static std::vector<ID> expand_bit_ranges(
+  const BitstreamTileIndex::bit_ranges& ranges) {
+  std::vector<ID> bits;
+  for (const auto& range : ranges) {
+    for (size_t ibit = range.first; ibit < range.second; ++ibit) {
+      bits.push_back(ID(ibit));
+    }
+  }
+  return bits;
+}
+
+/**************************************************
+ * Public Aggregators
+ *************************************************/
+size_t BitstreamTileIndex::num_tiles() const { return tile_ids_.size(); }
+
+BitstreamTileIndex::tile_range BitstreamTileIndex::tiles() const {
+  return vtr::make_range(tile_ids_.begin(), tile_ids_.end());
+}
+
+BitstreamTileId BitstreamTileIndex::find_tile(
+  const e_bitstream_tile_type& type, const vtr::Point<size_t>& coord,
+  const size_t& subtile) const {
+  auto result =
+    tile_lookup_.find({{size_t(type), coord.x(), coord.y(), subtile}});
+  if (tile_lookup_.end() == result) {
+    return BitstreamTileId::INVALID();
+  }
+  return result->second;
+}
+
+std::vector<BitstreamTileId> BitstreamTileIndex::find_tiles(
+  const e_bitstream_tile_type& type, const vtr::Point<size_t>& coord) const {
+  std::vector<BitstreamTileId> tiles;
+  /* Subtiles are sorted at the end of the key */
+  auto it = tile_lookup_.lower_bound({{size_t(type), coord.x(), coord.y(), 0}});
+  for (; it != tile_lookup_.end(); ++it) {
+    if ((size_t(type) != it->first[0]) || (coord.x() != it->first[1]) ||
+        (coord.y() != it->first[2])) {
+      break;
+    }
+    tiles.push_back(it->second);
+  }
+  return tiles;
+}
+
+/**************************************************
+ * Public Accessors
+ *************************************************/
+e_bitstream_tile_type BitstreamTileIndex::tile_type(
+  const BitstreamTileId& tile_id) const {
+  VTR_ASSERT(true == valid_tile_id(tile_id));
+  return tile_types_[tile_id];
+}
+
+vtr::Point<size_t> BitstreamTileIndex::tile_coordinate(
+  const BitstreamTileId& tile_id) const {
+  VTR_ASSERT(true == valid_tile_id(tile_id));
+  return tile_coords_[tile_id];
+}
+
+size_t BitstreamTileIndex::tile_subtile(const BitstreamTileId& tile_id) const {
+  VTR_ASSERT(true == valid_tile_id(tile_id));
+  return tile_subtiles_[tile_id];
+}
+
+ConfigBlockId BitstreamTileIndex::tile_block(
+  const BitstreamTileId& tile_id) const {
+  VTR_ASSERT(true == valid_tile_id(tile_id));
+  return tile_blocks_[tile_id];
+}
+
+size_t BitstreamTileIndex::tile_num_config_bits(
+  const BitstreamTileId& tile_id) const {
+  VTR_ASSERT(true == valid_tile_id(tile_id));
+  size_t num_bits = 0;
+  for (const auto& range : tile_config_bit_ranges_[tile_id]) {
+    num_bits += range.second - range.first;
+  }
+  return num_bits;
+}
+
+const BitstreamTileIndex::bit_ranges&
+BitstreamTileIndex::tile_config_bit_ranges(
+  const BitstreamTileId& tile_id) const {
+  VTR_ASSERT(true == valid_tile_id(tile_id));
+  return tile_config_bit_ranges_[tile_id];
+}
+
+std::vector<ConfigBitId> BitstreamTileIndex::tile_config_bits(
+  const BitstreamTileId& tile_id) const {
+  VTR_ASSERT(true == valid_tile_id(tile_id));
+  return expand_bit_ranges<ConfigBitId>(tile_config_bit_ranges_[tile_id]);
+}
+
+bool BitstreamTileIndex::has_fabric_bits() const { return has_fabric_bits_; }
+
+const BitstreamTileIndex::bit_ranges&
+BitstreamTileIndex::tile_fabric_bit_ranges(
+  const BitstreamTileId& tile_id) const {
+  VTR_ASSERT(true == valid_tile_id(tile_id));
+  return tile_fabric_bit_ranges_[tile_id];
+}
+
+std::vector<FabricBitId> BitstreamTileIndex::tile_fabric_bits(
+  const BitstreamTileId& tile_id) const {
+  VTR_ASSERT(true == valid_tile_id(tile_id));
+  return expand_bit_ranges<FabricBitId>(tile_fabric_bit_ranges_[tile_id]);
+}
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
+BitstreamTileId BitstreamTileIndex::add_tile(const e_bitstream_tile_type& type,
+                                             const vtr::Point<size_t>& coord,
+                                             const size_t& subtile,
+                                             const ConfigBlockId& block) {
+  BitstreamTileId tile_id = BitstreamTileId(tile_ids_.size());
+  auto result = tile_lookup_.insert(
+    std::make_pair(std::array<size_t, 4>{{size_t(type), coord.x(), coord.y(),
+                                          subtile}},
+                   tile_id));
+  /* Each tile can only be added once */
+  VTR_ASSERT(true == result.second);
+
+  tile_ids_.push_back(tile_id);
+  tile_types_.push_back(type);
+  tile_coords_.push_back(coord);
+  tile_subtiles_.push_back(subtile);
+  tile_blocks_.push_back(block);
+  tile_config_bit_ranges_.emplace_back();
+  tile_fabric_bit_ranges_.emplace_back();
+
+  return tile_id;
+}
+
+void BitstreamTileIndex::add_tile_config_bits(const BitstreamTileId& tile_id,
+                                              const ConfigBitId& lsb_bit_id,
+                                              const size_t& num_bits) {
+  VTR_ASSERT(true == valid_tile_id(tile_id));
+  append_bits_to_ranges(tile_config_bit_ranges_[tile_id], size_t(lsb_bit_id),
+                        num_bits);
+}
+
+void BitstreamTileIndex::add_tile_fabric_bit(const BitstreamTileId& tile_id,
+                                             const FabricBitId& bit_id) {
+  VTR_ASSERT(true == valid_tile_id(tile_id));
+  append_bits_to_ranges(tile_fabric_bit_ranges_[tile_id], size_t(bit_id), 1);
+}
+
+void BitstreamTileIndex::set_has_fabric_bits(const bool& has_fabric_bits) {
+  has_fabric_bits_ = has_fabric_bits;
+}
+
+void BitstreamTileIndex::clear_fabric_bits() {
+  for (bit_ranges& ranges : tile_fabric_bit_ranges_) {
+    ranges.clear();
+  }
+  has_fabric_bits_ = false;
+}
+
+void BitstreamTileIndex::clear() {
+  tile_ids_.clear();
+  tile_types_.clear();
+  tile_coords_.clear();
+  tile_subtiles_.clear();
+  tile_blocks_.clear();
+  tile_config_bit_ranges_.clear();
+  tile_fabric_bit_ranges_.clear();
+  has_fabric_bits_ = false;
+  tile_lookup_.clear();
+}
+
+/**************************************************
+ * Public Validators
+ *************************************************/
+bool BitstreamTileIndex::valid_tile_id(const BitstreamTileId& tile_id) const {
+  return (size_t(tile_id) < tile_ids_.size()) &&
+         (tile_id == tile_ids_[tile_id]);
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,122 @@
+#ifndef BITSTREAM_TILE_INDEX_H
+#define BITSTREAM_TILE_INDEX_H
+
+#include <array>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bitstream_manager.h"
+#include "fabric_bitstream.h"
+#include "vtr_geometry.h"
+#include "vtr_range.h"
+#include "vtr_strong_id.h"
+#include "vtr_vector.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+struct bitstream_tile_id_tag;
+typedef vtr::StrongId<bitstream_tile_id_tag> BitstreamTileId;
+
+/* Types of the tiles whose configuration bits are indexed */
+enum e_bitstream_tile_type {
+  BITSTREAM_TILE_GRID,
+  BITSTREAM_TILE_SB,
+  BITSTREAM_TILE_CBX,
+  BITSTREAM_TILE_CBY,
+  NUM_BITSTREAM_TILE_TYPES
+};
+constexpr std::array<const char*, NUM_BITSTREAM_TILE_TYPES>
+  BITSTREAM_TILE_TYPE_STRING = {{"grid", "sb", "cbx", "cby"}};
+
+/******************************************************************************
+ * A spatial index from the tiles of a fabric to their configuration bits,
+ * so that the bits of a tile can be found, e.g., to patch or flip them,
+ * without walking through the whole block hierarchy of the bitstream
+ * database.
+ * A tile is identified by its type, its coordinate and its subtile. Each
+ * subtile of a grid is a tile of its own, while routing blocks only have the
+ * subtile 0. Each tile refers to its block in the bitstream database, as well
+ * as the ranges of the configuration bits under the block and the ranges of
+ * their fabric bits. Bits are stored as ranges [begin, end), since the bits
+ * of a tile are mostly consecutive, so that querying a tile is linear in
+ * the number of its bits.
+ *
+ * @note The index should be rebuilt when the bitstream database is rebuilt,
+ * and its fabric bits should be rebuilt when the fabric bitstream is rebuilt
+ ******************************************************************************/
+class BitstreamTileIndex {
+ public: /* Types and ranges */
+  typedef vtr::vector<BitstreamTileId, BitstreamTileId>::const_iterator
+    tile_iterator;
+  typedef vtr::Range<tile_iterator> tile_range;
+  /* Ranges of bit ids [begin, end) */
+  typedef std::vector<std::pair<size_t, size_t>> bit_ranges;
+
+ public: /* Public aggregators */
+  size_t num_tiles() const;
+  tile_range tiles() const;
+  /* Find the tile at a coordinate, return an invalid id if not found */
+  BitstreamTileId find_tile(const e_bitstream_tile_type& type,
+                            const vtr::Point<size_t>& coord,
+                            const size_t& subtile) const;
+  /* Find all the subtiles of a type at a coordinate */
+  std::vector<BitstreamTileId> find_tiles(
+    const e_bitstream_tile_type& type, const vtr::Point<size_t>& coord) const;
+
+ public: /* Public accessors */
+  e_bitstream_tile_type tile_type(const BitstreamTileId& tile_id) const;
+  vtr::Point<size_t> tile_coordinate(const BitstreamTileId& tile_id) const;
+  size_t tile_subtile(const BitstreamTileId& tile_id) const;
+  ConfigBlockId tile_block(const BitstreamTileId& tile_id) const;
+  size_t tile_num_config_bits(const BitstreamTileId& tile_id) const;
+  const bit_ranges& tile_config_bit_ranges(
+    const BitstreamTileId& tile_id) const;
+  std::vector<ConfigBitId> tile_config_bits(
+    const BitstreamTileId& tile_id) const;
+  /* Fabric bits are only available after the fabric bits are built */
+  bool has_fabric_bits() const;
+  const bit_ranges& tile_fabric_bit_ranges(
+    const BitstreamTileId& tile_id) const;
+  std::vector<FabricBitId> tile_fabric_bits(
+    const BitstreamTileId& tile_id) const;
+
+ public: /* Public mutators */
+  BitstreamTileId add_tile(const e_bitstream_tile_type& type,
+                           const vtr::Point<size_t>& coord,
+                           const size_t& subtile, const ConfigBlockId& block);
+  /* Add bits to a tile, which are merged with the last range of the tile
+   * when they are consecutive */
+  void add_tile_config_bits(const BitstreamTileId& tile_id,
+                            const ConfigBitId& lsb_bit_id,
+                            const size_t& num_bits);
+  void add_tile_fabric_bit(const BitstreamTileId& tile_id,
+                           const FabricBitId& bit_id);
+  /* Mark the fabric bits as built, even if no tile has any fabric bit */
+  void set_has_fabric_bits(const bool& has_fabric_bits);
+  /* Remove the fabric bits of all the tiles */
+  void clear_fabric_bits();
+  void clear();
+
+ public: /* Public validators */
+  bool valid_tile_id(const BitstreamTileId& tile_id) const;
+
+ private: /* Internal data */
+  vtr::vector<BitstreamTileId, BitstreamTileId> tile_ids_;
+  vtr::vector<BitstreamTileId, e_bitstream_tile_type> tile_types_;
+  vtr::vector<BitstreamTileId, vtr::Point<size_t>> tile_coords_;
+  vtr::vector<BitstreamTileId, size_t> tile_subtiles_;
+  vtr::vector<BitstreamTileId, ConfigBlockId> tile_blocks_;
+  vtr::vector<BitstreamTileId, bit_ranges> tile_config_bit_ranges_;
+  vtr::vector<BitstreamTileId, bit_ranges> tile_fabric_bit_ranges_;
+  bool has_fabric_bits_ = false;
+
+  /* Fast look-up from <type, x, y, subtile> to tiles */
+  std::map<std::array<size_t, 4>, BitstreamTileId> tile_lookup_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,223 @@
+/********************************************************************
+ * This file includes functions to build the spatial index from the tiles
+ * of a fabric to their configuration bits
+ *******************************************************************/
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+#include "bitstream_manager_utils.h"
+#include "build_bitstream_tile_index.h"
+#include "openfpga_device_grid_utils.h"
+#include "openfpga_naming.h"
+#include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
+#include "vpr_utils.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Add the configuration bits under a block and all its child blocks
+ * to a tile, in the sequence of a Depth-First Search (DFS)
+ *******************************************************************/
+static void rec_add_block_bits_to_bitstream_tile(
+  BitstreamTileIndex& tile_index, const BitstreamTileId& tile_id,
+  const BitstreamManager& bitstream_manager, const ConfigBlockId& block) {
+  size_t num_bits = bitstream_manager.block_num_bits(block);
+  if (0 < num_bits) {
+    tile_index.add_tile_config_bits(
+      tile_id, bitstream_manager.block_lsb_bit(block), num_bits);
+  }
+  for (const ConfigBlockId& child_block :
+       bitstream_manager.block_children(block)) {
+    rec_add_block_bits_to_bitstream_tile(tile_index, tile_id,
+                                         bitstream_manager, child_block);
+  }
+}
+
+/* Add a tile for a block, if the block exists in the bitstream database */
+static void add_bitstream_tile(BitstreamTileIndex& tile_index,
+                               const BitstreamManager& bitstream_manager,
+                               const ConfigBlockId& parent_block,
+                               const std::string& block_name,
+                               const e_bitstream_tile_type& type,
+                               const vtr::Point<size_t>& coord,
+                               const size_t& subtile) {
+  ConfigBlockId block =
+    bitstream_manager.find_child_block(parent_block, block_name);
+  /* Blocks without any configurable child are not in the database */
+  if (false == bitstream_manager.valid_block_id(block)) {
+    return;
+  }
+  BitstreamTileId tile_id = tile_index.add_tile(type, coord, subtile, block);
+  rec_add_block_bits_to_bitstream_tile(tile_index, tile_id, bitstream_manager,
+                                       block);
+}
+
+/********************************************************************
+ * Add a tile for each subtile of a grid. The block of each subtile is the
+ * block of its physical block under the block of the grid
+ *******************************************************************/
+static void add_grid_bitstream_tiles(
+  BitstreamTileIndex& tile_index, const BitstreamManager& bitstream_manager,
+  const ConfigBlockId& top_block, const DeviceGrid& grids,
+  const VprDeviceAnnotation& device_annotation,
+  const vtr::Point<size_t>& grid_coord, const e_side& border_side) {
+  t_physical_tile_type_ptr grid_type =
+    grids[grid_coord.x()][grid_coord.y()].type;
+  std::string grid_block_name = generate_grid_block_instance_name(
+    std::string(GRID_MODULE_NAME_PREFIX), std::string(grid_type->name),
+    is_io_type(grid_type), border_side, grid_coord);
+  ConfigBlockId grid_block =
+    bitstream_manager.find_child_block(top_block, grid_block_name);
+  if (false == bitstream_manager.valid_block_id(grid_block)) {
+    return;
+  }
+
+  for (int z = 0; z < grid_type->capacity; ++z) {
+    int sub_tile_index =
+      device_annotation.physical_tile_z_to_subtile_index(grid_type, z);
+    for (t_logical_block_type_ptr lb_type :
+         grid_type->sub_tiles[sub_tile_index].equivalent_sites) {
+      if (nullptr == lb_type->pb_graph_head) {
+        continue;
+      }
+      add_bitstream_tile(tile_index, bitstream_manager, grid_block,
+                         generate_physical_block_instance_name(
+                           lb_type->pb_graph_head->pb_type, z),
+                         BITSTREAM_TILE_GRID, grid_coord, z);
+    }
+  }
+}
+
+/********************************************************************
+ * Build the index from the tiles of a fabric to their blocks and
+ * configuration bits in the bitstream database.
+ * The blocks are found by the same names as when the bitstream database
+ * is built, i.e., the names of their instances in the top-level module,
+ * so that a bitstream database which is read from a file can also be
+ * indexed.
+ * Each block of a grid, a switch block or a connection block is a tile,
+ * while the blocks which cannot be found, e.g., routing blocks with no
+ * configurable children, are skipped.
+ *******************************************************************/
+BitstreamTileIndex build_bitstream_tile_index(
+  const BitstreamManager& bitstream_manager, const DeviceGrid& grids,
+  const VprDeviceAnnotation& device_annotation,
+  const DeviceRRGSB& device_rr_gsb, const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Build bitstream tile index");
+  OPENFPGA_TRACE_FUNCTION();
+
+  BitstreamTileIndex tile_index;
+
+  std::vector<ConfigBlockId> top_blocks =
+    find_bitstream_manager_top_blocks(bitstream_manager);
+  if (1 != top_blocks.size()) {
+    return tile_index;
+  }
+  const ConfigBlockId& top_block = top_blocks[0];
+
+  /* Core grids */
+  for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
+    for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
+      if ((true == is_empty_type(grids[ix][iy].type)) ||
+          (0 < grids[ix][iy].width_offset) ||
+          (0 < grids[ix][iy].height_offset)) {
+        continue;
+      }
+      add_grid_bitstream_tiles(tile_index, bitstream_manager, top_block,
+                               grids, device_annotation,
+                               vtr::Point<size_t>(ix, iy), NUM_SIDES);
+    }
+  }
+
+  /* I/O grids */
+  std::map<e_side, std::vector<vtr::Point<size_t>>> io_coordinates =
+    generate_perimeter_grid_coordinates(grids);
+  for (const e_side& io_side : FPGA_SIDES_CLOCKWISE) {
+    for (const vtr::Point<size_t>& io_coord : io_coordinates[io_side]) {
+      const t_grid_tile& grid = grids[io_coord.x()][io_coord.y()];
+      if ((true == is_empty_type(grid.type)) || (0 < grid.width_offset) ||
+          (0 < grid.height_offset)) {
+        continue;
+      }
+      add_grid_bitstream_tiles(tile_index, bitstream_manager, top_block,
+                               grids, device_annotation, io_coord, io_side);
+    }
+  }
+
+  /* Switch blocks and connection blocks */
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+      if (true == rr_gsb.is_sb_exist()) {
+        vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+        add_bitstream_tile(tile_index, bitstream_manager, top_block,
+                           generate_switch_block_module_name(sb_coord),
+                           BITSTREAM_TILE_SB, sb_coord, 0);
+      }
+      for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+        if (false == rr_gsb.is_cb_exist(cb_type)) {
+          continue;
+        }
+        vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type),
+                                    rr_gsb.get_cb_y(cb_type));
+        add_bitstream_tile(
+          tile_index, bitstream_manager, top_block,
+          generate_connection_block_module_name(cb_type, cb_coord),
+          (CHANX == cb_type) ? BITSTREAM_TILE_CBX : BITSTREAM_TILE_CBY,
+          cb_coord, 0);
+      }
+    }
+  }
+
+  VTR_LOGV(verbose, "Indexed %lu tiles of the bitstream database\n",
+           tile_index.num_tiles());
+
+  return tile_index;
+}
+
+/********************************************************************
+ * Build the ranges of fabric bits of each tile in the index, by walking
+ * through the fabric bitstream once
+ *******************************************************************/
+void build_bitstream_tile_index_fabric_bits(
+  BitstreamTileIndex& tile_index, const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream, const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Build fabric bits of bitstream tiles");
+  OPENFPGA_TRACE_FUNCTION();
+
+  tile_index.clear_fabric_bits();
+
+  /* Find the tile of each configuration bit */
+  std::vector<BitstreamTileId> bit_tiles(bitstream_manager.num_bits(),
+                                         BitstreamTileId::INVALID());
+  for (const BitstreamTileId& tile_id : tile_index.tiles()) {
+    for (const auto& range : tile_index.tile_config_bit_ranges(tile_id)) {
+      std::fill(bit_tiles.begin() + range.first,
+                bit_tiles.begin() + range.second, tile_id);
+    }
+  }
+
+  for (const FabricBitId& fabric_bit : fabric_bitstream.dense_bits()) {
+    size_t config_bit = size_t(fabric_bitstream.config_bit(fabric_bit));
+    if ((config_bit < bit_tiles.size()) &&
+        (BitstreamTileId::INVALID() != bit_tiles[config_bit])) {
+      tile_index.add_tile_fabric_bit(bit_tiles[config_bit], fabric_bit);
+    }
+  }
+  tile_index.set_has_fabric_bits(true);
+
+  VTR_LOGV(verbose, "Indexed %lu fabric bits for %lu tiles\n",
+           fabric_bitstream.num_bits(), tile_index.num_tiles());
+}
+
+} /* end namespace openfpga */
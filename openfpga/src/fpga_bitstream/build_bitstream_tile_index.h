@@ -0,0 +1,32 @@
+#ifndef BUILD_BITSTREAM_TILE_INDEX_H
+#define BUILD_BITSTREAM_TILE_INDEX_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "bitstream_manager.h"
+#include "bitstream_tile_index.h"
+#include "device_grid.h"
+#include "device_rr_gsb.h"
+#include "fabric_bitstream.h"
+#include "vpr_device_annotation.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+BitstreamTileIndex build_bitstream_tile_index(
+  const BitstreamManager& bitstream_manager, const DeviceGrid& grids,
+  const VprDeviceAnnotation& device_annotation,
+  const DeviceRRGSB& device_rr_gsb, const bool& verbose);
+
+void build_bitstream_tile_index_fabric_bits(
+  BitstreamTileIndex& tile_index, const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream, const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
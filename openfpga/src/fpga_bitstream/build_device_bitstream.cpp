@@ -5,18 +5,25 @@
  * and Look-Up Tables (LUTs) which locate in CLBs and global routing
  *architecture
  *******************************************************************/
+#include <cstdint>
+#include <string>
 #include <vector>
 
 /* Headers from vtrutil library */
+#include "bitstream_manager_utils.h"
 #include "build_device_bitstream.h"
 #include "build_grid_bitstream.h"
 #include "build_routing_bitstream.h"
 #include "memory_utils.h"
 #include "module_manager_utils.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
+#include "openfpga_side_manager.h"
+#include "openfpga_trace.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
+#include "vpr_utils.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
@@ -138,17 +145,25 @@ static size_t rec_estimate_device_bitstream_num_bits(
  * Note: this function create a bitstream which is binding to the module graphs
  * of the FPGA fabric that FPGA-X2P generates!
  * But it can be used to output a generic bitstream for VPR mapping FPGA
+ *
+ * The bitstream of each grid and routing block can be built on multiple
+ * threads. The resulting bitstream is the same regardless of the number of
+ * threads
  *******************************************************************/
 BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                                         const OpenfpgaContext& openfpga_ctx,
-                                        const bool& verbose) {
+                                        const size_t& num_threads,
+                                        const bool& verbose,
+                                        const bool& record_net_ids) {
   std::string timer_message =
     std::string("\nBuild fabric-independent bitstream for implementation '") +
     vpr_ctx.atom().nlist.netlist_name() + std::string("'\n");
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Bitstream manager to be built */
   BitstreamManager bitstream_manager;
+  bitstream_manager.set_record_net_ids(record_net_ids);
 
   /* Create the top-level block for bitstream
    * This is related to the top-level module of fpga
@@ -186,7 +201,7 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
     vpr_ctx.device().grid, vpr_ctx.atom(), openfpga_ctx.vpr_device_annotation(),
     openfpga_ctx.vpr_clustering_annotation(),
     openfpga_ctx.vpr_placement_annotation(),
-    openfpga_ctx.vpr_bitstream_annotation(), verbose);
+    openfpga_ctx.vpr_bitstream_annotation(), num_threads, verbose);
   VTR_LOGV(verbose, "Done\n");
 
   /* Create bitstream from routing architectures */
@@ -196,7 +211,7 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
     openfpga_ctx.arch().circuit_lib, openfpga_ctx.mux_lib(), vpr_ctx.atom(),
     openfpga_ctx.vpr_device_annotation(), openfpga_ctx.vpr_routing_annotation(),
     vpr_ctx.device().rr_graph, openfpga_ctx.device_rr_gsb(),
-    openfpga_ctx.flow_manager().compress_routing());
+    openfpga_ctx.flow_manager().compress_routing(), num_threads);
   VTR_LOGV(verbose, "Done\n");
 
   VTR_LOGV(verbose, "Decoded %lu configuration bits into %lu blocks\n",
@@ -205,7 +220,235 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
   VTR_ASSERT(num_blocks_to_reserve == bitstream_manager.num_blocks());
   VTR_ASSERT(num_bits_to_reserve == bitstream_manager.num_bits());
 
+  /* No more blocks will be added, pack their children */
+  bitstream_manager.compact_child_blocks();
+
   return bitstream_manager;
 }
 
+/********************************************************************
+ * Mix a value into a 64-bit FNV-1a digest
+ *******************************************************************/
+static void digest_value(uint64_t& digest, const uint64_t& value) {
+  for (size_t ibyte = 0; ibyte < sizeof(value); ++ibyte) {
+    digest ^= (value >> (8 * ibyte)) & 0xff;
+    digest *= 0x100000001b3ULL;
+  }
+}
+
+static void digest_string(uint64_t& digest, const std::string& value) {
+  digest_value(digest, value.size());
+  for (const char& c : value) {
+    digest_value(digest, uint64_t(c));
+  }
+}
+
+/********************************************************************
+ * Digest the routing of a node, i.e., its net and the node driving it.
+ * When an atom context is given, the net is also digested by the name of
+ * its atom net, which is recorded in the bitstream
+ *******************************************************************/
+static void digest_rr_node_routing(
+  uint64_t& digest, const VprRoutingAnnotation& routing_annotation,
+  const AtomContext* atom_ctx, const RRNodeId& node) {
+  digest_value(digest, size_t(node));
+  digest_value(digest, size_t(routing_annotation.rr_node_net(node)));
+  digest_value(digest, size_t(routing_annotation.rr_node_prev_node(node)));
+  ClusterNetId net = routing_annotation.rr_node_net(node);
+  if ((nullptr == atom_ctx) || (ClusterNetId::INVALID() == net)) {
+    return;
+  }
+  AtomNetId atom_net = atom_ctx->lookup.atom_net(net);
+  if (true == atom_ctx->nlist.valid_net_id(atom_net)) {
+    digest_string(digest, atom_ctx->nlist.net_name(atom_net));
+  }
+}
+
+/********************************************************************
+ * Take a snapshot of the implementation results which the grids and the
+ * routing blocks of a device bitstream are decoded from, see
+ * DeviceBitstreamSnapshot.
+ * - A grid is digested from the physical pbs of the clusters placed on it
+ * - A GSB is digested from the routing of its channel nodes and its input
+ *   and output pins, which covers the inputs and outputs of all the routing
+ *   multiplexers of its switch block and connection blocks
+ * When the net ids are recorded in the database, the nets are also
+ * digested by their names, as the ids of different netlists, e.g., of the
+ * designs of a design list, may be the same for different names.
+ * The digests are computed on multiple threads, one column at a time
+ *******************************************************************/
+DeviceBitstreamSnapshot build_device_bitstream_snapshot(
+  const VprContext& vpr_ctx, const OpenfpgaContext& openfpga_ctx,
+  const size_t& num_threads, const bool& record_net_ids) {
+  const DeviceGrid& grids = vpr_ctx.device().grid;
+  const DeviceRRGSB& device_rr_gsb = openfpga_ctx.device_rr_gsb();
+  const VprPlacementAnnotation& place_annotation =
+    openfpga_ctx.vpr_placement_annotation();
+  const VprClusteringAnnotation& cluster_annotation =
+    openfpga_ctx.vpr_clustering_annotation();
+  const VprRoutingAnnotation& routing_annotation =
+    openfpga_ctx.vpr_routing_annotation();
+  const AtomContext* atom_ctx =
+    (true == record_net_ids) ? &vpr_ctx.atom() : nullptr;
+  const AtomNetlist* atom_nlist =
+    (true == record_net_ids) ? &vpr_ctx.atom().nlist : nullptr;
+
+  DeviceBitstreamSnapshot snapshot;
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  snapshot.resize(vtr::Point<size_t>(grids.width(), grids.height()),
+                  gsb_range);
+
+  parallel_for(grids.width(), num_threads, [&](const size_t& ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      /* Only the roots of the grids are decoded */
+      if ((true == is_empty_type(grids[ix][iy].type)) ||
+          (0 < grids[ix][iy].width_offset) ||
+          (0 < grids[ix][iy].height_offset)) {
+        continue;
+      }
+      vtr::Point<size_t> coord(ix, iy);
+      uint64_t digest = 0xcbf29ce484222325ULL;
+      for (const ClusterBlockId& cluster :
+           place_annotation.grid_blocks(coord)) {
+        digest_value(digest, size_t(cluster));
+        if (ClusterBlockId::INVALID() != cluster) {
+          digest_value(digest,
+                       cluster_annotation.physical_pb(cluster).digest(
+                         atom_nlist));
+        }
+      }
+      snapshot.set_grid_digest(coord, digest);
+    }
+  });
+
+  parallel_for(gsb_range.x(), num_threads, [&](const size_t& ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+      uint64_t digest = 0xcbf29ce484222325ULL;
+      for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+        e_side side_enum = SideManager(side).get_side();
+        for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_enum);
+             ++itrack) {
+          digest_rr_node_routing(digest, routing_annotation, atom_ctx,
+                                 rr_gsb.get_chan_node(side_enum, itrack));
+        }
+        for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(side_enum);
+             ++inode) {
+          digest_rr_node_routing(digest, routing_annotation, atom_ctx,
+                                 rr_gsb.get_ipin_node(side_enum, inode));
+        }
+        for (size_t inode = 0; inode < rr_gsb.get_num_opin_nodes(side_enum);
+             ++inode) {
+          digest_rr_node_routing(digest, routing_annotation, atom_ctx,
+                                 rr_gsb.get_opin_node(side_enum, inode));
+        }
+      }
+      snapshot.set_gsb_digest(vtr::Point<size_t>(ix, iy), digest);
+    }
+  });
+
+  return snapshot;
+}
+
+/********************************************************************
+ * Update an existing bitstream database with the latest implementation
+ * results, e.g., after a few clusters are re-placed or re-routed.
+ * The implementation results are compared with the snapshot taken when
+ * the database was built or last updated, and only the grids and the
+ * routing blocks whose results are changed are rebuilt. Their bits and
+ * block annotations are copied to the existing blocks, so that all the
+ * block and bit ids are kept. As a result, a fabric bitstream built on
+ * top of the database remains valid and can be patched instead of being
+ * rebuilt. The snapshot is replaced by the one of the latest results.
+ *
+ * Return true if the database is updated in place, or false if it has to
+ * be rebuilt and replaced, e.g., when the device or the option of recording
+ * net ids is changed
+ *******************************************************************/
+bool update_device_bitstream(BitstreamManager& bitstream_manager,
+                             DeviceBitstreamSnapshot& snapshot,
+                             const VprContext& vpr_ctx,
+                             const OpenfpgaContext& openfpga_ctx,
+                             const size_t& num_threads, const bool& verbose,
+                             const bool& record_net_ids) {
+  vtr::ScopedStartFinishTimer timer(
+    "\nUpdate fabric-independent bitstream for implementation '" +
+    vpr_ctx.atom().nlist.netlist_name() + "'\n");
+  OPENFPGA_TRACE_FUNCTION();
+
+  DeviceBitstreamSnapshot new_snapshot = build_device_bitstream_snapshot(
+    vpr_ctx, openfpga_ctx, num_threads, record_net_ids);
+
+  std::vector<ConfigBlockId> top_blocks =
+    find_bitstream_manager_top_blocks(bitstream_manager);
+  bool updated = (1 == top_blocks.size()) &&
+                 (record_net_ids == bitstream_manager.record_net_ids()) &&
+                 (snapshot.grid_size() == new_snapshot.grid_size()) &&
+                 (snapshot.gsb_range() == new_snapshot.gsb_range());
+
+  /* Find the grids and the GSBs whose results are changed */
+  std::vector<vtr::Point<size_t>> grid_coords;
+  std::vector<vtr::Point<size_t>> gsb_coords;
+  if (true == updated) {
+    for (size_t ix = 0; ix < snapshot.grid_size().x(); ++ix) {
+      for (size_t iy = 0; iy < snapshot.grid_size().y(); ++iy) {
+        vtr::Point<size_t> coord(ix, iy);
+        if (snapshot.grid_digest(coord) != new_snapshot.grid_digest(coord)) {
+          grid_coords.push_back(coord);
+        }
+      }
+    }
+    for (size_t ix = 0; ix < snapshot.gsb_range().x(); ++ix) {
+      for (size_t iy = 0; iy < snapshot.gsb_range().y(); ++iy) {
+        vtr::Point<size_t> coord(ix, iy);
+        if (snapshot.gsb_digest(coord) != new_snapshot.gsb_digest(coord)) {
+          gsb_coords.push_back(coord);
+        }
+      }
+    }
+    VTR_LOGV(verbose, "Found %lu grids and %lu GSBs to update\n",
+             grid_coords.size(), gsb_coords.size());
+  }
+
+  size_t num_changed_bits = 0;
+  updated =
+    updated &&
+    update_grid_bitstream(
+      bitstream_manager, top_blocks[0], openfpga_ctx.module_graph(),
+      openfpga_ctx.arch().circuit_lib, openfpga_ctx.mux_lib(),
+      vpr_ctx.device().grid, vpr_ctx.atom(),
+      openfpga_ctx.vpr_device_annotation(),
+      openfpga_ctx.vpr_clustering_annotation(),
+      openfpga_ctx.vpr_placement_annotation(),
+      openfpga_ctx.vpr_bitstream_annotation(), grid_coords, num_threads,
+      num_changed_bits) &&
+    update_routing_bitstream(
+      bitstream_manager, top_blocks[0], openfpga_ctx.module_graph(),
+      openfpga_ctx.arch().circuit_lib, openfpga_ctx.mux_lib(), vpr_ctx.atom(),
+      openfpga_ctx.vpr_device_annotation(),
+      openfpga_ctx.vpr_routing_annotation(), vpr_ctx.device().rr_graph,
+      openfpga_ctx.device_rr_gsb(),
+      openfpga_ctx.flow_manager().compress_routing(), gsb_coords, num_threads,
+      num_changed_bits);
+
+  snapshot = new_snapshot;
+
+  if (false == updated) {
+    VTR_LOG_WARN(
+      "Unable to update the bitstream database in place. Rebuilt the "
+      "database rather than updating it\n");
+    bitstream_manager = build_device_bitstream(
+      vpr_ctx, openfpga_ctx, num_threads, verbose, record_net_ids);
+    return false;
+  }
+
+  VTR_LOG(
+    "Updated %lu out of %lu configuration bits in place, by rebuilding %lu "
+    "grids and %lu GSBs\n",
+    num_changed_bits, bitstream_manager.num_bits(), grid_coords.size(),
+    gsb_coords.size());
+
+  return true;
+}
+
 } /* end namespace openfpga */
@@ -6,6 +6,7 @@
  *******************************************************************/
 #include <vector>
 
+#include "device_bitstream_snapshot.h"
 #include "openfpga_context.h"
 #include "vpr_context.h"
 
@@ -18,7 +19,20 @@ namespace openfpga {
 
 BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                                         const OpenfpgaContext& openfpga_ctx,
-                                        const bool& verbose);
+                                        const size_t& num_threads,
+                                        const bool& verbose,
+                                        const bool& record_net_ids = true);
+
+DeviceBitstreamSnapshot build_device_bitstream_snapshot(
+  const VprContext& vpr_ctx, const OpenfpgaContext& openfpga_ctx,
+  const size_t& num_threads, const bool& record_net_ids = true);
+
+bool update_device_bitstream(BitstreamManager& bitstream_manager,
+                             DeviceBitstreamSnapshot& snapshot,
+                             const VprContext& vpr_ctx,
+                             const OpenfpgaContext& openfpga_ctx,
+                             const size_t& num_threads, const bool& verbose,
+                             const bool& record_net_ids = true);
 
 } /* end namespace openfpga */
 
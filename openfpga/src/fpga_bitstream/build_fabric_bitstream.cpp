@@ -15,17 +15,20 @@
 #include "build_fabric_bitstream.h"
 #include "build_fabric_bitstream_memory_bank.h"
 #include "decoder_library_utils.h"
+#include "fabric_bitstream_utils.h"
 #include "openfpga_decode.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
 /********************************************************************
  * This function aims to build a bitstream for configuration chain-like protocol
- * It will walk through all the configurable children under a module
- * in a recursive way, following a Depth-First Search (DFS) strategy
+ * It will walk through all the configurable children of a configuration
+ * region in the sequence of the flattened hierarchy of configurable children,
+ * which follows a Depth-First Search (DFS) strategy
  * For each configuration child, we use its instance name as a key to spot the
  * configuration bits in bitstream manager.
  * Note that it is guarentee that the instance name in module manager is
@@ -34,81 +37,50 @@ namespace openfpga {
  *we stored in the configurable_children() and configurable_child_instances() of
  *each module of module manager
  *******************************************************************/
-static void rec_build_module_fabric_dependent_chain_bitstream(
-  const BitstreamManager& bitstream_manager, const ConfigBlockId& parent_block,
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const ModuleId& parent_module, const ConfigRegionId& config_region,
-  FabricBitstream& fabric_bitstream,
+static void build_module_fabric_dependent_chain_bitstream(
+  const BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
+  const ConfigChildHierarchy& config_hierarchy,
+  const ConfigRegionId& config_region, FabricBitstream& fabric_bitstream,
   const FabricBitRegionId& fabric_bitstream_region) {
-  /* Depth-first search: if we have any children in the parent_block,
-   * we dive to the next level first!
-   */
-  if (0 < bitstream_manager.block_children(parent_block).size()) {
-    if (parent_module == top_module) {
-      for (size_t child_id = 0; child_id < module_manager
-                                             .region_configurable_children(
-                                               parent_module, config_region)
-                                             .size();
-           ++child_id) {
-        ModuleId child_module = module_manager.region_configurable_children(
-          parent_module, config_region)[child_id];
-        size_t child_instance =
-          module_manager.region_configurable_child_instances(
-            parent_module, config_region)[child_id];
-        /* Get the instance name and ensure it is not empty */
-        std::string instance_name = module_manager.instance_name(
-          parent_module, child_module, child_instance);
-
-        /* Find the child block that matches the instance name! */
-        ConfigBlockId child_block =
-          bitstream_manager.find_child_block(parent_block, instance_name);
-        /* We must have one valid block id! */
-        VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
-
-        /* Go recursively */
-        rec_build_module_fabric_dependent_chain_bitstream(
-          bitstream_manager, child_block, module_manager, top_module,
-          child_module, config_region, fabric_bitstream,
-          fabric_bitstream_region);
-      }
-    } else {
-      for (size_t child_id = 0;
-           child_id <
-           module_manager.configurable_children(parent_module).size();
-           ++child_id) {
-        ModuleId child_module =
-          module_manager.configurable_children(parent_module)[child_id];
-        size_t child_instance =
-          module_manager.configurable_child_instances(parent_module)[child_id];
-        /* Get the instance name and ensure it is not empty */
-        std::string instance_name = module_manager.instance_name(
-          parent_module, child_module, child_instance);
-
-        /* Find the child block that matches the instance name! */
-        ConfigBlockId child_block =
-          bitstream_manager.find_child_block(parent_block, instance_name);
-        /* We must have one valid block id! */
-        VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
-
-        /* Go recursively */
-        rec_build_module_fabric_dependent_chain_bitstream(
-          bitstream_manager, child_block, module_manager, top_module,
-          child_module, config_region, fabric_bitstream,
-          fabric_bitstream_region);
-      }
+  /* The blocks of the ancestors of the node under visit, indexed by depth,
+   * where the top block is the parent of the nodes at depth 0 */
+  std::vector<ConfigBlockId> parent_blocks(1, top_block);
+  std::string instance_name;
+
+  ConfigChildHierarchy::node_range nodes =
+    config_hierarchy.region_nodes(config_region);
+  for (auto it = nodes.begin(); it != nodes.end();) {
+    const ConfigChildNodeId& node = *it;
+    parent_blocks.resize(config_hierarchy.node_depth(node) + 1);
+
+    /* Find the child block that matches the instance name! */
+    instance_name.clear();
+    config_hierarchy.append_node_name(instance_name, node);
+    ConfigBlockId block =
+      bitstream_manager.find_child_block(parent_blocks.back(), instance_name);
+    /* We must have one valid block id! */
+    VTR_ASSERT(true == bitstream_manager.valid_block_id(block));
+
+    /* Depth-first search: if we have any children in the block,
+     * we dive to the next level first!
+     */
+    if (0 < bitstream_manager.block_children(block).size()) {
+      /* Ensure that there should be no configuration bits in the block */
+      VTR_ASSERT(0 == bitstream_manager.block_bits(block).size());
+      parent_blocks.push_back(block);
+      ++it;
+      continue;
     }
-    /* Ensure that there should be no configuration bits in the parent block */
-    VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
-  }
 
-  /* Note that, reach here, it means that this is a leaf node.
-   * We add the configuration bits to the fabric_bitstream,
-   * And then, we can return
-   */
-  for (const ConfigBitId& config_bit :
-       bitstream_manager.block_bits(parent_block)) {
-    FabricBitId fabric_bit = fabric_bitstream.add_bit(config_bit);
-    fabric_bitstream.add_bit_to_region(fabric_bitstream_region, fabric_bit);
+    /* Note that, reach here, it means that this is a leaf block.
+     * We add the configuration bits to the fabric_bitstream,
+     * and skip the configurable children under the block
+     */
+    for (const ConfigBitId& config_bit : bitstream_manager.block_bits(block)) {
+      FabricBitId fabric_bit = fabric_bitstream.add_bit(config_bit);
+      fabric_bitstream.add_bit_to_region(fabric_bitstream_region, fabric_bit);
+    }
+    it += size_t(config_hierarchy.node_subtree_end(node)) - size_t(node);
   }
 }
 
@@ -190,7 +162,7 @@ static void rec_build_module_fabric_dependent_memory_bank_bitstream(
        *   - Use configurable children directly
        *   - no need to exclude decoders as they are not there
        */
-      std::vector<ModuleId> configurable_children =
+      const std::vector<ModuleId>& configurable_children =
         module_manager.configurable_children(parent_module);
 
       size_t num_configurable_children = configurable_children.size();
@@ -482,17 +454,17 @@ static void rec_build_module_fabric_dependent_frame_bitstream(
    * We will find the address bit and add it to addr_code
    * Then we can add the configuration bits to the fabric_bitstream.
    */
-  std::vector<ModuleId> configurable_children;
+  ModuleId decoder_module;
   if (top_module == parent_modules.back()) {
-    configurable_children = module_manager.region_configurable_children(
-      parent_modules.back(), config_region);
+    std::vector<ModuleId> region_children =
+      module_manager.region_configurable_children(parent_modules.back(),
+                                                  config_region);
+    decoder_module = region_children.back();
   } else {
     VTR_ASSERT(top_module != parent_modules.back());
-    configurable_children =
-      module_manager.configurable_children(parent_modules.back());
+    decoder_module =
+      module_manager.configurable_children(parent_modules.back()).back();
   }
-
-  ModuleId decoder_module = configurable_children.back();
   /* Find the address port from the decoder module */
   const ModulePortId& decoder_addr_port_id = module_manager.find_module_port(
     decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
@@ -529,25 +501,34 @@ static void rec_build_module_fabric_dependent_frame_bitstream(
 /********************************************************************
  * Main function to build a fabric-dependent bitstream
  * by considering the configuration protocol types
+ * Configuration regions are independent from each other, so that they
+ * are built in parallel when multiple threads are used.
  *******************************************************************/
 static void build_module_fabric_dependent_bitstream(
   const ConfigProtocol& config_protocol, const CircuitLibrary& circuit_lib,
   const BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
   const ModuleManager& module_manager, const ModuleId& top_module,
+  const ConfigChildHierarchy& config_hierarchy, const size_t& num_threads,
   FabricBitstream& fabric_bitstream) {
+  std::vector<ConfigRegionId> config_regions(
+    module_manager.regions(top_module).begin(),
+    module_manager.regions(top_module).end());
+
   switch (config_protocol.type()) {
     case CONFIG_MEM_STANDALONE: {
       /* Reserve bits before build-up */
       fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
-      for (const ConfigRegionId& config_region :
-           module_manager.regions(top_module)) {
-        FabricBitRegionId fabric_bitstream_region =
-          fabric_bitstream.add_region();
-        rec_build_module_fabric_dependent_chain_bitstream(
-          bitstream_manager, top_block, module_manager, top_module, top_module,
-          config_region, fabric_bitstream, fabric_bitstream_region);
-      }
+      build_fabric_bitstream_regions(
+        fabric_bitstream, config_regions.size(), num_threads,
+        [&](FabricBitstream& region_bitstream, const size_t& iregion) {
+          FabricBitRegionId fabric_bitstream_region =
+            region_bitstream.add_region();
+          build_module_fabric_dependent_chain_bitstream(
+            bitstream_manager, top_block, config_hierarchy,
+            config_regions[iregion], region_bitstream,
+            fabric_bitstream_region);
+        });
 
       break;
     }
@@ -555,15 +536,17 @@ static void build_module_fabric_dependent_bitstream(
       /* Reserve bits before build-up */
       fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
-      for (const ConfigRegionId& config_region :
-           module_manager.regions(top_module)) {
-        FabricBitRegionId fabric_bitstream_region =
-          fabric_bitstream.add_region();
-        rec_build_module_fabric_dependent_chain_bitstream(
-          bitstream_manager, top_block, module_manager, top_module, top_module,
-          config_region, fabric_bitstream, fabric_bitstream_region);
-        fabric_bitstream.reverse_region_bits(fabric_bitstream_region);
-      }
+      build_fabric_bitstream_regions(
+        fabric_bitstream, config_regions.size(), num_threads,
+        [&](FabricBitstream& region_bitstream, const size_t& iregion) {
+          FabricBitRegionId fabric_bitstream_region =
+            region_bitstream.add_region();
+          build_module_fabric_dependent_chain_bitstream(
+            bitstream_manager, top_block, config_hierarchy,
+            config_regions[iregion], region_bitstream,
+            fabric_bitstream_region);
+          region_bitstream.reverse_region_bits(fabric_bitstream_region);
+        });
       break;
     }
     case CONFIG_MEM_MEMORY_BANK: {
@@ -587,46 +570,49 @@ static void build_module_fabric_dependent_bitstream(
       fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
       /* Build bitstreams by region */
-      for (const ConfigRegionId& config_region :
-           module_manager.regions(top_module)) {
-        size_t cur_mem_index = 0;
-
-        /* Find port information for local BL and WL decoder in this region */
-        std::vector<ModuleId> configurable_children =
-          module_manager.region_configurable_children(top_module,
-                                                      config_region);
-        VTR_ASSERT(2 <= configurable_children.size());
-        ModuleId bl_decoder_module =
-          configurable_children[configurable_children.size() - 2];
-        ModuleId wl_decoder_module =
-          configurable_children[configurable_children.size() - 1];
-
-        ModulePortId bl_port = module_manager.find_module_port(
-          bl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
-        BasicPort bl_port_info =
-          module_manager.module_port(bl_decoder_module, bl_port);
-
-        ModulePortId wl_port = module_manager.find_module_port(
-          wl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
-        BasicPort wl_port_info =
-          module_manager.module_port(wl_decoder_module, wl_port);
-
-        /* Build the bitstream for all the blocks in this region */
-        FabricBitRegionId fabric_bitstream_region =
-          fabric_bitstream.add_region();
-        rec_build_module_fabric_dependent_memory_bank_bitstream(
-          bitstream_manager, top_block, module_manager, top_module, top_module,
-          config_region, bl_addr_port_info.get_width(),
-          wl_addr_port_info.get_width(), bl_port_info.get_width(),
-          wl_port_info.get_width(), cur_mem_index, fabric_bitstream,
-          fabric_bitstream_region);
-      }
+      build_fabric_bitstream_regions(
+        fabric_bitstream, config_regions.size(), num_threads,
+        [&](FabricBitstream& region_bitstream, const size_t& iregion) {
+          const ConfigRegionId& config_region = config_regions[iregion];
+          size_t cur_mem_index = 0;
+
+          /* Find port information for local BL and WL decoder in this region
+           */
+          std::vector<ModuleId> configurable_children =
+            module_manager.region_configurable_children(top_module,
+                                                        config_region);
+          VTR_ASSERT(2 <= configurable_children.size());
+          ModuleId bl_decoder_module =
+            configurable_children[configurable_children.size() - 2];
+          ModuleId wl_decoder_module =
+            configurable_children[configurable_children.size() - 1];
+
+          ModulePortId bl_port = module_manager.find_module_port(
+            bl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
+          BasicPort bl_port_info =
+            module_manager.module_port(bl_decoder_module, bl_port);
+
+          ModulePortId wl_port = module_manager.find_module_port(
+            wl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
+          BasicPort wl_port_info =
+            module_manager.module_port(wl_decoder_module, wl_port);
+
+          /* Build the bitstream for all the blocks in this region */
+          FabricBitRegionId fabric_bitstream_region =
+            region_bitstream.add_region();
+          rec_build_module_fabric_dependent_memory_bank_bitstream(
+            bitstream_manager, top_block, module_manager, top_module,
+            top_module, config_region, bl_addr_port_info.get_width(),
+            wl_addr_port_info.get_width(), bl_port_info.get_width(),
+            wl_port_info.get_width(), cur_mem_index, region_bitstream,
+            fabric_bitstream_region);
+        });
       break;
     }
     case CONFIG_MEM_QL_MEMORY_BANK: {
       build_module_fabric_dependent_bitstream_ql_memory_bank(
         config_protocol, circuit_lib, bitstream_manager, top_block,
-        module_manager, top_module, fabric_bitstream);
+        module_manager, top_module, num_threads, fabric_bitstream);
       break;
     }
     case CONFIG_MEM_FRAME_BASED: {
@@ -638,8 +624,8 @@ static void build_module_fabric_dependent_bitstream(
 
       /* Reserve bits before build-up */
       fabric_bitstream.set_use_address(true);
-      fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
       fabric_bitstream.set_address_length(addr_port_info.get_width());
+      fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
       /* Avoid use don't care if there is only a region */
       char bitstream_dont_care_char = DONT_CARE_CHAR;
@@ -668,45 +654,49 @@ static void build_module_fabric_dependent_bitstream(
           std::max(max_decoder_addr_size, decoder_addr_port.get_width());
       }
 
-      for (const ConfigRegionId& config_region :
-           module_manager.regions(top_module)) {
-        std::vector<ModuleId> configurable_children =
-          module_manager.region_configurable_children(top_module,
-                                                      config_region);
-
-        /* Bypass non-configurable regions */
-        if (0 == configurable_children.size()) {
-          continue;
-        }
+      build_fabric_bitstream_regions(
+        fabric_bitstream, config_regions.size(), num_threads,
+        [&](FabricBitstream& region_bitstream, const size_t& iregion) {
+          const ConfigRegionId& config_region = config_regions[iregion];
+          std::vector<ModuleId> configurable_children =
+            module_manager.region_configurable_children(top_module,
+                                                        config_region);
+
+          /* Bypass non-configurable regions */
+          if (0 == configurable_children.size()) {
+            return;
+          }
+
+          /* Find the idle address bit which should be added to the head of
+           * the address bit This depends on the number of address bits
+           * required by this region For example: Top-level address is
+           * addr[0:4] There are 4 decoders in the top-level module, whose
+           * address sizes are decoder A: addr[0:4] decoder B: addr[0:3]
+           * decoder C: addr[0:2] decoder D: addr[0:3] For decoder A, the
+           * address fit well For decoder B, an idle bit should be added '0' +
+           * addr[0:3] For decoder C, two idle bits should be added '00' +
+           * addr[0:2] For decoder D, an idle bit should be added '0' +
+           * addr[0:3]
+           */
+          ModuleId decoder_module = configurable_children.back();
+          ModulePortId decoder_addr_port_id = module_manager.find_module_port(
+            decoder_module, DECODER_ADDRESS_PORT_NAME);
+          BasicPort decoder_addr_port =
+            module_manager.module_port(decoder_module, decoder_addr_port_id);
+          VTR_ASSERT(max_decoder_addr_size >= decoder_addr_port.get_width());
+          std::vector<char> idle_addr_bits(
+            max_decoder_addr_size - decoder_addr_port.get_width(),
+            bitstream_dont_care_char);
 
-        /* Find the idle address bit which should be added to the head of the
-         * address bit This depends on the number of address bits required by
-         * this region For example: Top-level address is addr[0:4] There are 4
-         * decoders in the top-level module, whose address sizes are decoder A:
-         * addr[0:4] decoder B: addr[0:3] decoder C: addr[0:2] decoder D:
-         * addr[0:3] For decoder A, the address fit well For decoder B, an idle
-         * bit should be added '0' + addr[0:3] For decoder C, two idle bits
-         * should be added '00' + addr[0:2] For decoder D, an idle bit should be
-         * added '0' + addr[0:3]
-         */
-        ModuleId decoder_module = configurable_children.back();
-        ModulePortId decoder_addr_port_id = module_manager.find_module_port(
-          decoder_module, DECODER_ADDRESS_PORT_NAME);
-        BasicPort decoder_addr_port =
-          module_manager.module_port(decoder_module, decoder_addr_port_id);
-        VTR_ASSERT(max_decoder_addr_size >= decoder_addr_port.get_width());
-        std::vector<char> idle_addr_bits(
-          max_decoder_addr_size - decoder_addr_port.get_width(),
-          bitstream_dont_care_char);
-
-        FabricBitRegionId fabric_bitstream_region =
-          fabric_bitstream.add_region();
-        rec_build_module_fabric_dependent_frame_bitstream(
-          bitstream_manager, std::vector<ConfigBlockId>(1, top_block),
-          module_manager, top_module, config_region,
-          std::vector<ModuleId>(1, top_module), idle_addr_bits,
-          bitstream_dont_care_char, fabric_bitstream, fabric_bitstream_region);
-      }
+          FabricBitRegionId fabric_bitstream_region =
+            region_bitstream.add_region();
+          rec_build_module_fabric_dependent_frame_bitstream(
+            bitstream_manager, std::vector<ConfigBlockId>(1, top_block),
+            module_manager, top_module, config_region,
+            std::vector<ModuleId>(1, top_module), idle_addr_bits,
+            bitstream_dont_care_char, region_bitstream,
+            fabric_bitstream_region);
+        });
       break;
     }
     default:
@@ -753,14 +743,19 @@ static void build_module_fabric_dependent_bitstream(
  * This function can be called ONLY after the function build_device_bitstream()
  * Note that this function does NOT decode bitstreams from circuit
  *implementation It was done in the function build_device_bitstream()
+ * Configuration regions are built with a number of threads, and the fabric
+ * bitstream is the same regardless of the number of threads
  *******************************************************************/
 FabricBitstream build_fabric_dependent_bitstream(
   const BitstreamManager& bitstream_manager,
-  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
-  const ConfigProtocol& config_protocol, const bool& verbose) {
+  const ModuleManager& module_manager,
+  const ConfigChildHierarchy& config_hierarchy,
+  const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol,
+  const size_t& num_threads, const bool& verbose) {
   FabricBitstream fabric_bitstream;
 
   vtr::ScopedStartFinishTimer timer("\nBuild fabric dependent bitstream\n");
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Get the top module name in module manager, which is our starting point */
   std::string top_module_name = generate_fpga_top_module_name();
@@ -774,11 +769,19 @@ FabricBitstream build_fabric_dependent_bitstream(
   VTR_ASSERT(1 == top_block.size());
   VTR_ASSERT(
     0 == top_module_name.compare(bitstream_manager.block_name(top_block[0])));
+  /* The hierarchy must be built from the same module graph */
+  VTR_ASSERT(top_module == config_hierarchy.top_module());
 
   /* Start build-up formally */
   build_module_fabric_dependent_bitstream(
     config_protocol, circuit_lib, bitstream_manager, top_block[0],
-    module_manager, top_module, fabric_bitstream);
+    module_manager, top_module, config_hierarchy, num_threads,
+    fabric_bitstream);
+
+  /* Count the bit values once for all the writers using fast configuration */
+  fabric_bitstream.build_bit_value_stats(bitstream_manager);
+  fabric_bitstream.set_database_version(
+    bitstream_manager.stamp(), bitstream_manager.update_generation());
 
   VTR_LOGV(verbose, "Built %lu configuration bits for fabric\n",
            fabric_bitstream.num_bits());
@@ -786,4 +789,54 @@ FabricBitstream build_fabric_dependent_bitstream(
   return fabric_bitstream;
 }
 
+/********************************************************************
+ * Update a fabric bitstream in place after the bit values of its
+ * bitstream database are updated, e.g., by update_device_bitstream().
+ * The fabric bitstream must have been built from the same database, i.e.,
+ * its database stamp is the stamp of the database.
+ * The sequence and the addresses of the configuration bits only depend on
+ * the fabric, so they are kept. Only the data input of each bit, which is
+ * a copy of the bit value for the protocols using addresses, is patched.
+ * Other protocols read the bit values from the database directly and
+ * require no update. Nothing is visited if the database has not been
+ * updated since the fabric bitstream was last synchronized.
+ *
+ * Return the number of fabric bits whose data input is changed
+ *******************************************************************/
+size_t update_fabric_dependent_bitstream(
+  FabricBitstream& fabric_bitstream, const BitstreamManager& bitstream_manager,
+  const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("\nUpdate fabric dependent bitstream\n");
+  OPENFPGA_TRACE_FUNCTION();
+
+  VTR_ASSERT(fabric_bitstream.database_stamp() == bitstream_manager.stamp());
+  if (fabric_bitstream.database_update_generation() ==
+      bitstream_manager.update_generation()) {
+    VTR_LOGV(verbose, "Fabric bitstream is up to date\n");
+    return 0;
+  }
+
+  size_t num_changed_bits = 0;
+  if (true == fabric_bitstream.use_address()) {
+    for (const FabricBitId& fabric_bit : fabric_bitstream.dense_bits()) {
+      char din =
+        bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
+      if (din != fabric_bitstream.bit_din(fabric_bit)) {
+        fabric_bitstream.set_bit_din(fabric_bit, din);
+        num_changed_bits++;
+      }
+    }
+  }
+
+  /* The statistics depend on the bit values, which are changed */
+  fabric_bitstream.build_bit_value_stats(bitstream_manager);
+  fabric_bitstream.set_database_version(
+    bitstream_manager.stamp(), bitstream_manager.update_generation());
+
+  VTR_LOGV(verbose, "Updated %lu out of %lu configuration bits for fabric\n",
+           num_changed_bits, fabric_bitstream.num_bits());
+
+  return num_changed_bits;
+}
+
 } /* end namespace openfpga */
@@ -8,6 +8,7 @@
 
 #include "bitstream_manager.h"
 #include "circuit_library.h"
+#include "config_child_hierarchy.h"
 #include "config_protocol.h"
 #include "fabric_bitstream.h"
 #include "module_manager.h"
@@ -21,8 +22,14 @@ namespace openfpga {
 
 FabricBitstream build_fabric_dependent_bitstream(
   const BitstreamManager& bitstream_manager,
-  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
-  const ConfigProtocol& config_protocol, const bool& verbose);
+  const ModuleManager& module_manager,
+  const ConfigChildHierarchy& config_hierarchy,
+  const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol,
+  const size_t& num_threads, const bool& verbose);
+
+size_t update_fabric_dependent_bitstream(
+  FabricBitstream& fabric_bitstream, const BitstreamManager& bitstream_manager,
+  const bool& verbose);
 
 } /* end namespace openfpga */
 
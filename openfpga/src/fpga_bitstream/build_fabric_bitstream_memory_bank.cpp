@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cmath>
 #include <string>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -15,6 +16,7 @@
 #include "bitstream_manager_utils.h"
 #include "build_fabric_bitstream_memory_bank.h"
 #include "decoder_library_utils.h"
+#include "fabric_bitstream_utils.h"
 #include "memory_bank_utils.h"
 #include "memory_utils.h"
 #include "openfpga_decode.h"
@@ -24,6 +26,34 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Encoders of the BL/WL addresses, one per type of BL/WL protocol
+ * - BL/WL decoders: fully encoded
+ * - flatten BL/WLs and shift registers: 1-hot encoded, where the
+ *   unselected bits are given by a default bit
+ * The encoders are selected once per fabric, so that the loop over
+ * configuration bits does not branch on the type of protocol
+ *******************************************************************/
+struct BlwlDecoderAddress {
+  /* Whether an address shorter than the address port is tolerated */
+  static bool tolerant_short_address() { return false; }
+
+  static std::vector<char> encode(const size_t& index, const size_t& addr_size,
+                                  const char& /* default_bit */) {
+    return itobin_charvec(index, addr_size);
+  }
+};
+
+struct BlwlOneHotAddress {
+  /* Whether an address shorter than the address port is tolerated */
+  static bool tolerant_short_address() { return true; }
+
+  static std::vector<char> encode(const size_t& index, const size_t& addr_size,
+                                  const char& default_bit) {
+    return ito1hot_charvec(index, addr_size, default_bit);
+  }
+};
+
 /********************************************************************
  * This function aims to build a bitstream for memory-bank protocol
  * It will walk through all the configurable children under a module
@@ -40,6 +70,7 @@ namespace openfpga {
  * Using this index, we can infer the address codes for both BL and WL decoders.
  * Note that, we must get the number of BLs and WLs before using this function!
  *******************************************************************/
+template <class BlAddress, class WlAddress>
 static void rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
   const BitstreamManager& bitstream_manager, const ConfigBlockId& parent_block,
   const ModuleManager& module_manager, const ModuleId& top_module,
@@ -109,7 +140,8 @@ static void rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
         VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
 
         /* Go recursively */
-        rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
+        rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream<
+          BlAddress, WlAddress>(
           bitstream_manager, child_block, module_manager, top_module,
           child_module, config_region, config_protocol, circuit_lib, sram_model,
           bl_addr_size, wl_addr_size, num_bls_cur_tile, bl_start_index_per_tile,
@@ -122,7 +154,7 @@ static void rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
        *   - Use configurable children directly
        *   - no need to exclude decoders as they are not there
        */
-      std::vector<ModuleId> configurable_children =
+      const std::vector<ModuleId>& configurable_children =
         module_manager.configurable_children(parent_module);
 
       size_t num_configurable_children = configurable_children.size();
@@ -152,7 +184,8 @@ static void rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
         VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
 
         /* Go recursively */
-        rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
+        rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream<
+          BlAddress, WlAddress>(
           bitstream_manager, child_block, module_manager, top_module,
           child_module, config_region, config_protocol, circuit_lib, sram_model,
           bl_addr_size, wl_addr_size, num_bls_cur_tile, bl_start_index_per_tile,
@@ -181,38 +214,23 @@ static void rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
      */
     size_t cur_bl_index = bl_start_index_per_tile.at(tile_coord.x()) +
                           cur_mem_index[tile_coord] % num_bls_cur_tile;
-    std::vector<char> bl_addr_bits_vec;
-    if (BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) {
-      bl_addr_bits_vec = itobin_charvec(cur_bl_index, bl_addr_size);
-    } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type() ||
-               BLWL_PROTOCOL_SHIFT_REGISTER ==
-                 config_protocol.bl_protocol_type()) {
-      bl_addr_bits_vec =
-        ito1hot_charvec(cur_bl_index, bl_addr_size, DONT_CARE_CHAR);
-    }
+    std::vector<char> bl_addr_bits_vec =
+      BlAddress::encode(cur_bl_index, bl_addr_size, DONT_CARE_CHAR);
 
     /* Find WL address */
     size_t cur_wl_index =
       wl_start_index_per_tile.at(tile_coord.y()) +
       std::floor(cur_mem_index[tile_coord] / num_bls_cur_tile);
-    std::vector<char> wl_addr_bits_vec;
-    if (BLWL_PROTOCOL_DECODER == config_protocol.wl_protocol_type()) {
-      wl_addr_bits_vec = itobin_charvec(cur_wl_index, wl_addr_size);
-    } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type() ||
-               BLWL_PROTOCOL_SHIFT_REGISTER ==
-                 config_protocol.wl_protocol_type()) {
-      wl_addr_bits_vec = ito1hot_charvec(cur_wl_index, wl_addr_size);
-    }
+    std::vector<char> wl_addr_bits_vec =
+      WlAddress::encode(cur_wl_index, wl_addr_size, '0');
 
     /* Set BL address */
-    fabric_bitstream.set_bit_bl_address(
-      fabric_bit, bl_addr_bits_vec,
-      BLWL_PROTOCOL_DECODER != config_protocol.bl_protocol_type());
+    fabric_bitstream.set_bit_bl_address(fabric_bit, bl_addr_bits_vec,
+                                        BlAddress::tolerant_short_address());
 
     /* Set WL address */
-    fabric_bitstream.set_bit_wl_address(
-      fabric_bit, wl_addr_bits_vec,
-      BLWL_PROTOCOL_DECODER != config_protocol.wl_protocol_type());
+    fabric_bitstream.set_bit_wl_address(fabric_bit, wl_addr_bits_vec,
+                                        WlAddress::tolerant_short_address());
 
     /* Set data input */
     fabric_bitstream.set_bit_din(fabric_bit,
@@ -226,6 +244,40 @@ static void rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
   }
 }
 
+/* Builder of the bitstream of a configuration region, which is specialized
+ * for a pair of BL and WL protocols */
+typedef decltype(
+  &rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream<
+    BlwlDecoderAddress, BlwlDecoderAddress>)
+  QlMemoryBankRegionalBitstreamBuilder;
+
+/********************************************************************
+ * Find the builder of regional bitstreams specialized for the BL and WL
+ * protocols of a configuration protocol
+ *******************************************************************/
+template <class BlAddress>
+static QlMemoryBankRegionalBitstreamBuilder
+find_ql_memory_bank_regional_bitstream_builder(
+  const e_blwl_protocol_type& wl_protocol_type) {
+  if (BLWL_PROTOCOL_DECODER == wl_protocol_type) {
+    return &rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream<
+      BlAddress, BlwlDecoderAddress>;
+  }
+  return &rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream<
+    BlAddress, BlwlOneHotAddress>;
+}
+
+static QlMemoryBankRegionalBitstreamBuilder
+find_ql_memory_bank_regional_bitstream_builder(
+  const ConfigProtocol& config_protocol) {
+  if (BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) {
+    return find_ql_memory_bank_regional_bitstream_builder<BlwlDecoderAddress>(
+      config_protocol.wl_protocol_type());
+  }
+  return find_ql_memory_bank_regional_bitstream_builder<BlwlOneHotAddress>(
+    config_protocol.wl_protocol_type());
+}
+
 /********************************************************************
  * Main function to build a fabric-dependent bitstream
  * by considering the QuickLogic memory banks
@@ -234,7 +286,7 @@ void build_module_fabric_dependent_bitstream_ql_memory_bank(
   const ConfigProtocol& config_protocol, const CircuitLibrary& circuit_lib,
   const BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
   const ModuleManager& module_manager, const ModuleId& top_module,
-  FabricBitstream& fabric_bitstream) {
+  const size_t& num_threads, FabricBitstream& fabric_bitstream) {
   /* Ensure we are in the correct type of configuration protocol*/
   VTR_ASSERT(config_protocol.type() == CONFIG_MEM_QL_MEMORY_BANK);
 
@@ -335,102 +387,112 @@ void build_module_fabric_dependent_bitstream_ql_memory_bank(
   fabric_bitstream.set_wl_address_length(wl_addr_port_info.get_width());
   fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
-  /* Build bitstreams by region */
-  for (const ConfigRegionId& config_region :
-       module_manager.regions(top_module)) {
-    /* Find port information for local BL and WL decoder in this region */
-    std::vector<ModuleId> configurable_children =
-      module_manager.region_configurable_children(top_module, config_region);
-    VTR_ASSERT(2 <= configurable_children.size());
+  /* Select the builder for the BL/WL protocols once for all the bits */
+  QlMemoryBankRegionalBitstreamBuilder build_regional_bitstream =
+    find_ql_memory_bank_regional_bitstream_builder(config_protocol);
 
-    /* Build the bitstream for all the blocks in this region */
-    FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
+  /* Build bitstreams by region */
+  std::vector<ConfigRegionId> config_regions(
+    module_manager.regions(top_module).begin(),
+    module_manager.regions(top_module).end());
+  build_fabric_bitstream_regions(
+    fabric_bitstream, config_regions.size(), num_threads,
+    [&](FabricBitstream& region_bitstream, const size_t& iregion) {
+      const ConfigRegionId& config_region = config_regions[iregion];
+      /* Find port information for local BL and WL decoder in this region */
+      std::vector<ModuleId> configurable_children =
+        module_manager.region_configurable_children(top_module, config_region);
+      VTR_ASSERT(2 <= configurable_children.size());
 
-    /* Find the BL/WL port (different region may have different sizes of BL/WLs)
-     */
-    ModulePortId cur_bl_addr_port;
-    BasicPort cur_bl_addr_port_info;
-    if (BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) {
-      cur_bl_addr_port = module_manager.find_module_port(
-        top_module, std::string(DECODER_BL_ADDRESS_PORT_NAME));
-      cur_bl_addr_port_info =
-        module_manager.module_port(top_module, cur_bl_addr_port);
-    } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type()) {
-      cur_bl_addr_port = module_manager.find_module_port(
-        top_module, generate_regional_blwl_port_name(
-                      std::string(MEMORY_BL_PORT_NAME), config_region));
-      cur_bl_addr_port_info =
-        module_manager.module_port(top_module, cur_bl_addr_port);
-    } else {
-      VTR_ASSERT(BLWL_PROTOCOL_SHIFT_REGISTER ==
-                 config_protocol.bl_protocol_type());
-      cur_bl_addr_port_info.set_width(compute_memory_bank_regional_num_bls(
-        module_manager, top_module, config_region, circuit_lib,
-        config_protocol.memory_model()));
-    }
+      /* Build the bitstream for all the blocks in this region */
+      FabricBitRegionId fabric_bitstream_region = region_bitstream.add_region();
 
-    ModulePortId cur_wl_addr_port;
-    BasicPort cur_wl_addr_port_info;
-    if (BLWL_PROTOCOL_DECODER == config_protocol.wl_protocol_type()) {
-      cur_wl_addr_port = module_manager.find_module_port(
-        top_module, std::string(DECODER_WL_ADDRESS_PORT_NAME));
-      cur_wl_addr_port_info =
-        module_manager.module_port(top_module, cur_wl_addr_port);
-    } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type()) {
-      cur_wl_addr_port = module_manager.find_module_port(
-        top_module, generate_regional_blwl_port_name(
-                      std::string(MEMORY_WL_PORT_NAME), config_region));
-      cur_wl_addr_port_info =
-        module_manager.module_port(top_module, cur_wl_addr_port);
-    } else {
-      VTR_ASSERT(BLWL_PROTOCOL_SHIFT_REGISTER ==
-                 config_protocol.wl_protocol_type());
-      cur_wl_addr_port_info.set_width(compute_memory_bank_regional_num_wls(
-        module_manager, top_module, config_region, circuit_lib,
-        config_protocol.memory_model()));
-    }
+      /* Find the BL/WL port (different region may have different sizes of
+       * BL/WLs)
+       */
+      ModulePortId cur_bl_addr_port;
+      BasicPort cur_bl_addr_port_info;
+      if (BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) {
+        cur_bl_addr_port = module_manager.find_module_port(
+          top_module, std::string(DECODER_BL_ADDRESS_PORT_NAME));
+        cur_bl_addr_port_info =
+          module_manager.module_port(top_module, cur_bl_addr_port);
+      } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type()) {
+        cur_bl_addr_port = module_manager.find_module_port(
+          top_module, generate_regional_blwl_port_name(
+                        std::string(MEMORY_BL_PORT_NAME), config_region));
+        cur_bl_addr_port_info =
+          module_manager.module_port(top_module, cur_bl_addr_port);
+      } else {
+        VTR_ASSERT(BLWL_PROTOCOL_SHIFT_REGISTER ==
+                   config_protocol.bl_protocol_type());
+        cur_bl_addr_port_info.set_width(compute_memory_bank_regional_num_bls(
+          module_manager, top_module, config_region, circuit_lib,
+          config_protocol.memory_model()));
+      }
 
-    /**************************************************************
-     * Precompute the BLs and WLs distribution across the FPGA fabric
-     * The distribution is a matrix which contains the starting index of BL/WL
-     * for each column or row
-     */
-    std::pair<int, int> child_x_range =
-      compute_memory_bank_regional_configurable_child_x_range(
-        module_manager, top_module, config_region);
-    std::pair<int, int> child_y_range =
-      compute_memory_bank_regional_configurable_child_y_range(
-        module_manager, top_module, config_region);
-
-    std::map<int, size_t> num_bls_per_tile =
-      compute_memory_bank_regional_bitline_numbers_per_tile(
-        module_manager, top_module, config_region, circuit_lib,
-        config_protocol.memory_model());
-    std::map<int, size_t> num_wls_per_tile =
-      compute_memory_bank_regional_wordline_numbers_per_tile(
-        module_manager, top_module, config_region, circuit_lib,
-        config_protocol.memory_model());
+      ModulePortId cur_wl_addr_port;
+      BasicPort cur_wl_addr_port_info;
+      if (BLWL_PROTOCOL_DECODER == config_protocol.wl_protocol_type()) {
+        cur_wl_addr_port = module_manager.find_module_port(
+          top_module, std::string(DECODER_WL_ADDRESS_PORT_NAME));
+        cur_wl_addr_port_info =
+          module_manager.module_port(top_module, cur_wl_addr_port);
+      } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type()) {
+        cur_wl_addr_port = module_manager.find_module_port(
+          top_module, generate_regional_blwl_port_name(
+                        std::string(MEMORY_WL_PORT_NAME), config_region));
+        cur_wl_addr_port_info =
+          module_manager.module_port(top_module, cur_wl_addr_port);
+      } else {
+        VTR_ASSERT(BLWL_PROTOCOL_SHIFT_REGISTER ==
+                   config_protocol.wl_protocol_type());
+        cur_wl_addr_port_info.set_width(compute_memory_bank_regional_num_wls(
+          module_manager, top_module, config_region, circuit_lib,
+          config_protocol.memory_model()));
+      }
 
-    std::map<int, size_t> bl_start_index_per_tile =
-      compute_memory_bank_regional_blwl_start_index_per_tile(child_x_range,
-                                                             num_bls_per_tile);
-    std::map<int, size_t> wl_start_index_per_tile =
-      compute_memory_bank_regional_blwl_start_index_per_tile(child_y_range,
-                                                             num_wls_per_tile);
-
-    vtr::Point<int> temp_coord;
-    std::map<vtr::Point<int>, size_t> cur_mem_index;
-    size_t temp_num_bls_cur_tile = 0;
-    size_t temp_num_wls_cur_tile = 0;
-
-    rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
-      bitstream_manager, top_block, module_manager, top_module, top_module,
-      config_region, config_protocol, circuit_lib,
-      config_protocol.memory_model(), cur_bl_addr_port_info.get_width(),
-      cur_wl_addr_port_info.get_width(), temp_num_bls_cur_tile,
-      bl_start_index_per_tile, temp_num_wls_cur_tile, wl_start_index_per_tile,
-      temp_coord, cur_mem_index, fabric_bitstream, fabric_bitstream_region);
-  }
+      /**************************************************************
+       * Precompute the BLs and WLs distribution across the FPGA fabric
+       * The distribution is a matrix which contains the starting index of BL/WL
+       * for each column or row
+       */
+      std::pair<int, int> child_x_range =
+        compute_memory_bank_regional_configurable_child_x_range(
+          module_manager, top_module, config_region);
+      std::pair<int, int> child_y_range =
+        compute_memory_bank_regional_configurable_child_y_range(
+          module_manager, top_module, config_region);
+
+      std::map<int, size_t> num_bls_per_tile =
+        compute_memory_bank_regional_bitline_numbers_per_tile(
+          module_manager, top_module, config_region, circuit_lib,
+          config_protocol.memory_model());
+      std::map<int, size_t> num_wls_per_tile =
+        compute_memory_bank_regional_wordline_numbers_per_tile(
+          module_manager, top_module, config_region, circuit_lib,
+          config_protocol.memory_model());
+
+      std::map<int, size_t> bl_start_index_per_tile =
+        compute_memory_bank_regional_blwl_start_index_per_tile(
+          child_x_range, num_bls_per_tile);
+      std::map<int, size_t> wl_start_index_per_tile =
+        compute_memory_bank_regional_blwl_start_index_per_tile(
+          child_y_range, num_wls_per_tile);
+
+      vtr::Point<int> temp_coord;
+      std::map<vtr::Point<int>, size_t> cur_mem_index;
+      size_t temp_num_bls_cur_tile = 0;
+      size_t temp_num_wls_cur_tile = 0;
+
+      build_regional_bitstream(
+        bitstream_manager, top_block, module_manager, top_module, top_module,
+        config_region, config_protocol, circuit_lib,
+        config_protocol.memory_model(), cur_bl_addr_port_info.get_width(),
+        cur_wl_addr_port_info.get_width(), temp_num_bls_cur_tile,
+        bl_start_index_per_tile, temp_num_wls_cur_tile, wl_start_index_per_tile,
+        temp_coord, cur_mem_index, region_bitstream, fabric_bitstream_region);
+    });
 }
 
 } /* end namespace openfpga */
@@ -23,7 +23,7 @@ void build_module_fabric_dependent_bitstream_ql_memory_bank(
   const ConfigProtocol& config_protocol, const CircuitLibrary& circuit_lib,
   const BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
   const ModuleManager& module_manager, const ModuleId& top_module,
-  FabricBitstream& fabric_bitstream);
+  const size_t& num_threads, FabricBitstream& fabric_bitstream);
 
 } /* end namespace openfpga */
 
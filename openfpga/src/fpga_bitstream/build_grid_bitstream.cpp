@@ -3,14 +3,22 @@
  * for grids (CLBs, heterogenerous blocks, I/Os, etc.)
  *******************************************************************/
 #include <cmath>
+#include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "vtr_ndmatrix.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_progress.h"
+
 /* Headers from vpr library */
+#include "bitstream_manager_utils.h"
 #include "build_grid_bitstream.h"
 #include "build_mux_bitstream.h"
 #include "circuit_library_utils.h"
@@ -280,6 +288,11 @@ static void build_physical_block_pin_interc_bitstream(
       /* Record path ids, input and output nets */
       bitstream_manager.add_path_id_to_block(mux_mem_block, mux_input_pin_id);
 
+      /* Skip the nets if they are not recorded */
+      if (false == bitstream_manager.record_net_ids()) {
+        break;
+      }
+
       /* Add input nets */
       std::string input_net_ids;
 
@@ -442,23 +455,31 @@ static void build_physical_block_interc_bitstream(
 }
 
 /********************************************************************
- * Generate bitstream for a LUT and add it to bitstream manager
- * This function supports both single-output and fracturable LUTs
+ * Circuit-level information required to build the bitstream of a LUT,
+ * which is the same for all the instances of a physical LUT pb_type
  *******************************************************************/
-static void build_lut_bitstream(BitstreamManager& bitstream_manager,
-                                const ConfigBlockId& parent_configurable_block,
-                                const VprDeviceAnnotation& device_annotation,
-                                const ModuleManager& module_manager,
-                                const CircuitLibrary& circuit_lib,
-                                const MuxLibrary& mux_lib,
-                                const PhysicalPb& physical_pb,
-                                const PhysicalPbId& lut_pb_id,
-                                t_pb_type* lut_pb_type) {
-  /* Ensure a valid physical pritimive pb */
-  if (nullptr == lut_pb_type) {
-    VTR_LOGF_ERROR(__FILE__, __LINE__, "Invalid lut_pb_type!\n");
-    exit(1);
-  }
+struct t_lut_bitstream_info {
+  size_t lut_size;
+  /* The port where truth table is loaded to */
+  CircuitPortId regular_sram_port;
+  /* The port for mode select, which is invalid if the LUT is not fracturable */
+  CircuitPortId mode_select_port;
+  /* Bitstreams of an unused LUT */
+  std::vector<bool> default_bitstream;
+  std::vector<bool> default_mode_select_bitstream;
+  /* Name and size of the memory module associated to the LUT */
+  std::string mem_block_name;
+  size_t mem_block_size;
+};
+
+/********************************************************************
+ * Find the circuit-level information to build the bitstream of a LUT
+ *******************************************************************/
+static t_lut_bitstream_info build_lut_bitstream_info(
+  const VprDeviceAnnotation& device_annotation,
+  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
+  t_pb_type* lut_pb_type) {
+  t_lut_bitstream_info lut_info;
 
   CircuitModelId lut_model =
     device_annotation.pb_type_circuit_model(lut_pb_type);
@@ -470,7 +491,7 @@ static void build_lut_bitstream(BitstreamManager& bitstream_manager,
   std::vector<CircuitPortId> model_input_ports =
     find_lut_circuit_model_input_port(circuit_lib, lut_model, false);
   VTR_ASSERT(1 == model_input_ports.size());
-  size_t lut_size = circuit_lib.port_size(model_input_ports[0]);
+  lut_info.lut_size = circuit_lib.port_size(model_input_ports[0]);
 
   /* Find SRAM ports for truth tables and mode-selection */
   std::vector<CircuitPortId> lut_regular_sram_ports =
@@ -483,36 +504,113 @@ static void build_lut_bitstream(BitstreamManager& bitstream_manager,
    * fracturable or not */
   VTR_ASSERT((0 == lut_mode_select_ports.size()) ||
              (1 == lut_mode_select_ports.size()));
+  lut_info.regular_sram_port = lut_regular_sram_ports[0];
+  lut_info.mode_select_port = CircuitPortId::INVALID();
+  if (1 == lut_mode_select_ports.size()) {
+    lut_info.mode_select_port = lut_mode_select_ports[0];
+    lut_info.default_mode_select_bitstream = generate_mode_select_bitstream(
+      device_annotation.pb_type_mode_bits(lut_pb_type));
+  }
+
+  /* An unused LUT is given an empty truth table, which are full of default
+   * values (defined by users) */
+  VTR_ASSERT(
+    (0 == circuit_lib.port_default_value(lut_info.regular_sram_port)) ||
+    (1 == circuit_lib.port_default_value(lut_info.regular_sram_port)));
+  lut_info.default_bitstream.assign(
+    circuit_lib.port_size(lut_info.regular_sram_port),
+    1 == circuit_lib.port_default_value(lut_info.regular_sram_port));
+
+  /* Find the memory module to check the length of bitstream */
+  std::vector<CircuitModelId> sram_models =
+    find_circuit_sram_models(circuit_lib, lut_model);
+  VTR_ASSERT(1 == sram_models.size());
+  lut_info.mem_block_name = generate_memory_module_name(
+    circuit_lib, lut_model, sram_models[0], std::string(MEMORY_MODULE_POSTFIX));
+  ModuleId mem_module = module_manager.find_module(lut_info.mem_block_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(mem_module));
+  ModulePortId mem_out_port_id = module_manager.find_module_port(
+    mem_module, generate_configurable_memory_data_out_name());
+  lut_info.mem_block_size =
+    module_manager.module_port(mem_module, mem_out_port_id).get_width();
+
+  return lut_info;
+}
+
+/********************************************************************
+ * Find the circuit-level information of all the physical LUT pb_types
+ * under a pb_type by walking through its physical modes
+ *******************************************************************/
+static void rec_build_lut_bitstream_infos(
+  std::map<t_pb_type*, t_lut_bitstream_info>& lut_infos,
+  const VprDeviceAnnotation& device_annotation,
+  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
+  t_pb_type* physical_pb_type) {
+  if (true == is_primitive_pb_type(physical_pb_type)) {
+    CircuitModelId primitive_circuit_model =
+      device_annotation.pb_type_circuit_model(physical_pb_type);
+    if ((CircuitModelId::INVALID() != primitive_circuit_model) &&
+        (CIRCUIT_MODEL_LUT ==
+         circuit_lib.model_type(primitive_circuit_model)) &&
+        (0 == lut_infos.count(physical_pb_type))) {
+      lut_infos[physical_pb_type] = build_lut_bitstream_info(
+        device_annotation, module_manager, circuit_lib, physical_pb_type);
+    }
+    return;
+  }
+
+  t_mode* physical_mode = device_annotation.physical_mode(physical_pb_type);
+  VTR_ASSERT(nullptr != physical_mode);
+  for (int ipb = 0; ipb < physical_mode->num_pb_type_children; ++ipb) {
+    rec_build_lut_bitstream_infos(lut_infos, device_annotation, module_manager,
+                                  circuit_lib,
+                                  &(physical_mode->pb_type_children[ipb]));
+  }
+}
+
+/********************************************************************
+ * Generate bitstream for a LUT and add it to bitstream manager
+ * This function supports both single-output and fracturable LUTs
+ * The circuit-level information of the LUT is found in advance, so that
+ * only the truth tables are decoded for each instance
+ *******************************************************************/
+static void build_lut_bitstream(BitstreamManager& bitstream_manager,
+                                const ConfigBlockId& parent_configurable_block,
+                                const VprDeviceAnnotation& device_annotation,
+                                const CircuitLibrary& circuit_lib,
+                                const MuxLibrary& mux_lib,
+                                const t_lut_bitstream_info& lut_info,
+                                const PhysicalPb& physical_pb,
+                                const PhysicalPbId& lut_pb_id,
+                                t_pb_type* lut_pb_type) {
+  /* Ensure a valid physical pritimive pb */
+  if (nullptr == lut_pb_type) {
+    VTR_LOGF_ERROR(__FILE__, __LINE__, "Invalid lut_pb_type!\n");
+    exit(1);
+  }
 
   std::vector<bool> lut_bitstream;
   /* Generate bitstream for the LUT */
   if (false == physical_pb.valid_pb_id(lut_pb_id)) {
-    /* An empty pb means that this is an unused LUT,
-     * we give an empty truth table, which are full of default values (defined
-     * by users)
-     */
-    for (size_t i = 0; i < circuit_lib.port_size(lut_regular_sram_ports[0]);
-         ++i) {
-      VTR_ASSERT(
-        (0 == circuit_lib.port_default_value(lut_regular_sram_ports[0])) ||
-        (1 == circuit_lib.port_default_value(lut_regular_sram_ports[0])));
-      lut_bitstream.push_back(
-        1 == circuit_lib.port_default_value(lut_regular_sram_ports[0]));
-    }
+    /* An empty pb means that this is an unused LUT */
+    lut_bitstream = lut_info.default_bitstream;
   } else {
     VTR_ASSERT(true == physical_pb.valid_pb_id(lut_pb_id));
 
+    CircuitModelId lut_model =
+      device_annotation.pb_type_circuit_model(lut_pb_type);
     /* Find MUX graph correlated to the LUT */
-    MuxId lut_mux_id = mux_lib.mux_graph(lut_model, (size_t)pow(2., lut_size));
+    MuxId lut_mux_id =
+      mux_lib.mux_graph(lut_model, size_t(1) << lut_info.lut_size);
     const MuxGraph& mux_graph = mux_lib.mux_graph(lut_mux_id);
     /* Ensure the LUT MUX has the expected input and SRAM port sizes */
-    VTR_ASSERT(mux_graph.num_memory_bits() == lut_size);
-    VTR_ASSERT(mux_graph.num_inputs() == (size_t)pow(2., lut_size));
+    VTR_ASSERT(mux_graph.num_memory_bits() == lut_info.lut_size);
+    VTR_ASSERT(mux_graph.num_inputs() == (size_t(1) << lut_info.lut_size));
     /* Generate LUT bitstream */
     lut_bitstream = build_frac_lut_bitstream(
       circuit_lib, mux_graph, device_annotation,
       physical_pb.truth_tables(lut_pb_id),
-      circuit_lib.port_default_value(lut_regular_sram_ports[0]));
+      circuit_lib.port_default_value(lut_info.regular_sram_port));
     /* If the physical pb contains fixed bitstream, overload here */
     if (false == physical_pb.fixed_bitstream(lut_pb_id).empty()) {
       std::string fixed_bitstream = physical_pb.fixed_bitstream(lut_pb_id);
@@ -537,7 +635,7 @@ static void build_lut_bitstream(BitstreamManager& bitstream_manager,
   }
 
   /* Generate bitstream for mode-select ports */
-  if (0 != lut_mode_select_ports.size()) {
+  if (CircuitPortId::INVALID() != lut_info.mode_select_port) {
     std::vector<bool> mode_select_bitstream;
     if (true == physical_pb.valid_pb_id(lut_pb_id)) {
       mode_select_bitstream =
@@ -570,8 +668,7 @@ static void build_lut_bitstream(BitstreamManager& bitstream_manager,
         }
       }
     } else { /* get default mode_bits */
-      mode_select_bitstream = generate_mode_select_bitstream(
-        device_annotation.pb_type_mode_bits(lut_pb_type));
+      mode_select_bitstream = lut_info.default_mode_select_bitstream;
     }
 
     /* Conjunct the mode-select bitstream to the lut bitstream */
@@ -581,22 +678,12 @@ static void build_lut_bitstream(BitstreamManager& bitstream_manager,
   }
 
   /* Ensure the length of bitstream matches the side of memory circuits */
-  std::vector<CircuitModelId> sram_models =
-    find_circuit_sram_models(circuit_lib, lut_model);
-  VTR_ASSERT(1 == sram_models.size());
-  std::string mem_block_name = generate_memory_module_name(
-    circuit_lib, lut_model, sram_models[0], std::string(MEMORY_MODULE_POSTFIX));
-  ModuleId mem_module = module_manager.find_module(mem_block_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(mem_module));
-  ModulePortId mem_out_port_id = module_manager.find_module_port(
-    mem_module, generate_configurable_memory_data_out_name());
-  VTR_ASSERT(
-    lut_bitstream.size() ==
-    module_manager.module_port(mem_module, mem_out_port_id).get_width());
+  VTR_ASSERT(lut_bitstream.size() == lut_info.mem_block_size);
 
   /* Create a block for the bitstream which corresponds to the memory module
    * associated to the LUT */
-  ConfigBlockId mem_block = bitstream_manager.add_block(mem_block_name);
+  ConfigBlockId mem_block =
+    bitstream_manager.add_block(lut_info.mem_block_name);
   bitstream_manager.add_child_block(parent_configurable_block, mem_block);
 
   /* Add the bitstream to the bitstream manager */
@@ -620,9 +707,11 @@ static void rec_build_physical_block_bitstream(
   const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
   const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
   const VprDeviceAnnotation& device_annotation,
-  const VprBitstreamAnnotation& bitstream_annotation, const e_side& border_side,
-  const PhysicalPb& physical_pb, const PhysicalPbId& pb_id,
-  t_pb_graph_node* physical_pb_graph_node, const size_t& pb_graph_node_index) {
+  const VprBitstreamAnnotation& bitstream_annotation,
+  const std::map<t_pb_type*, t_lut_bitstream_info>& lut_infos,
+  const e_side& border_side, const PhysicalPb& physical_pb,
+  const PhysicalPbId& pb_id, t_pb_graph_node* physical_pb_graph_node,
+  const size_t& pb_graph_node_index) {
   /* Get the physical pb_type that is linked to the pb_graph node */
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
 
@@ -672,7 +761,7 @@ static void rec_build_physical_block_bitstream(
         rec_build_physical_block_bitstream(
           bitstream_manager, pb_configurable_block, module_manager, circuit_lib,
           mux_lib, atom_ctx, device_annotation, bitstream_annotation,
-          border_side, physical_pb, child_pb,
+          lut_infos, border_side, physical_pb, child_pb,
           &(physical_pb_graph_node
               ->child_pb_graph_nodes[physical_mode->index][ipb][jpb]),
           jpb);
@@ -691,8 +780,9 @@ static void rec_build_physical_block_bitstream(
          * Mapped logical block information is stored in child_pbs of this pb!!!
          */
         build_lut_bitstream(bitstream_manager, pb_configurable_block,
-                            device_annotation, module_manager, circuit_lib,
-                            mux_lib, physical_pb, pb_id, physical_pb_type);
+                            device_annotation, circuit_lib, mux_lib,
+                            lut_infos.at(physical_pb_type), physical_pb,
+                            pb_id, physical_pb_type);
         break;
       case CIRCUIT_MODEL_FF:
       case CIRCUIT_MODEL_HARDLOGIC:
@@ -732,8 +822,10 @@ static void build_physical_block_bitstream(
   const VprDeviceAnnotation& device_annotation,
   const VprClusteringAnnotation& cluster_annotation,
   const VprPlacementAnnotation& place_annotation,
-  const VprBitstreamAnnotation& bitstream_annotation, const DeviceGrid& grids,
-  const vtr::Point<size_t>& grid_coord, const e_side& border_side) {
+  const VprBitstreamAnnotation& bitstream_annotation,
+  const std::map<t_pb_type*, t_lut_bitstream_info>& lut_infos,
+  const DeviceGrid& grids, const vtr::Point<size_t>& grid_coord,
+  const e_side& border_side) {
   /* Create a block for the grid in bitstream manager */
   t_physical_tile_type_ptr grid_type =
     grids[grid_coord.x()][grid_coord.y()].type;
@@ -789,7 +881,7 @@ static void build_physical_block_bitstream(
         rec_build_physical_block_bitstream(
           bitstream_manager, grid_configurable_block, module_manager,
           circuit_lib, mux_lib, atom_ctx, device_annotation,
-          bitstream_annotation, border_side, PhysicalPb(),
+          bitstream_annotation, lut_infos, border_side, PhysicalPb(),
           PhysicalPbId::INVALID(), lb_type->pb_graph_head, z);
       } else {
         const PhysicalPb& phy_pb = cluster_annotation.physical_pb(
@@ -804,30 +896,24 @@ static void build_physical_block_bitstream(
         rec_build_physical_block_bitstream(
           bitstream_manager, grid_configurable_block, module_manager,
           circuit_lib, mux_lib, atom_ctx, device_annotation,
-          bitstream_annotation, border_side, phy_pb, top_pb_id, pb_graph_head,
-          z);
+          bitstream_annotation, lut_infos, border_side, phy_pb, top_pb_id,
+          pb_graph_head, z);
       }
     }
   }
 }
 
 /********************************************************************
- * Top-level function of this file:
- * Generate bitstreams for all the grids, including
+ * Collect the grids to build bitstream for, and the border side they
+ * locate, including
  * 1. core grids that sit in the center of the fabric
  * 2. side grids (I/O grids) that sit in the borders for the fabric
+ * Return the number of core grids, which are collected first
  *******************************************************************/
-void build_grid_bitstream(
-  BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
-  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
-  const MuxLibrary& mux_lib, const DeviceGrid& grids,
-  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
-  const VprClusteringAnnotation& cluster_annotation,
-  const VprPlacementAnnotation& place_annotation,
-  const VprBitstreamAnnotation& bitstream_annotation, const bool& verbose) {
-  VTR_LOGV(verbose, "Generating bitstream for core grids...");
-
-  /* Generate bitstream for the core logic block one by one */
+static size_t collect_bitstream_grid_coordinates(
+  const DeviceGrid& grids, std::vector<vtr::Point<size_t>>& grid_coords,
+  std::vector<e_side>& grid_border_sides) {
+  /* Collect the core logic block one by one */
   for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
     for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
       /* Bypass EMPTY grid */
@@ -839,23 +925,17 @@ void build_grid_bitstream(
           (0 < grids[ix][iy].height_offset)) {
         continue;
       }
-      /* Add a grid module to top_module*/
-      vtr::Point<size_t> grid_coord(ix, iy);
-      build_physical_block_bitstream(
-        bitstream_manager, top_block, module_manager, circuit_lib, mux_lib,
-        atom_ctx, device_annotation, cluster_annotation, place_annotation,
-        bitstream_annotation, grids, grid_coord, NUM_SIDES);
+      grid_coords.push_back(vtr::Point<size_t>(ix, iy));
+      grid_border_sides.push_back(NUM_SIDES);
     }
   }
-  VTR_LOGV(verbose, "Done\n");
-
-  VTR_LOGV(verbose, "Generating bitstream for I/O grids...");
+  size_t num_core_grids = grid_coords.size();
 
   /* Create the coordinate range for each side of FPGA fabric */
   std::map<e_side, std::vector<vtr::Point<size_t>>> io_coordinates =
     generate_perimeter_grid_coordinates(grids);
 
-  /* Add instances of I/O grids to top_module */
+  /* Collect I/O grids */
   for (const e_side& io_side : FPGA_SIDES_CLOCKWISE) {
     for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
       /* Bypass EMPTY grid */
@@ -868,13 +948,152 @@ void build_grid_bitstream(
           (0 < grids[io_coordinate.x()][io_coordinate.y()].height_offset)) {
         continue;
       }
-      build_physical_block_bitstream(
-        bitstream_manager, top_block, module_manager, circuit_lib, mux_lib,
-        atom_ctx, device_annotation, cluster_annotation, place_annotation,
-        bitstream_annotation, grids, io_coordinate, io_side);
+      grid_coords.push_back(io_coordinate);
+      grid_border_sides.push_back(io_side);
+    }
+  }
+
+  return num_core_grids;
+}
+
+/********************************************************************
+ * Find the circuit-level information of the LUTs of the logical tiles
+ * in the grids, which is shared by all the grids
+ *******************************************************************/
+static std::map<t_pb_type*, t_lut_bitstream_info>
+find_grid_lut_bitstream_infos(
+  const DeviceGrid& grids, const std::vector<vtr::Point<size_t>>& grid_coords,
+  const VprDeviceAnnotation& device_annotation,
+  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib) {
+  std::map<t_pb_type*, t_lut_bitstream_info> lut_infos;
+  std::set<t_physical_tile_type_ptr> visited_grid_types;
+  for (const vtr::Point<size_t>& grid_coord : grid_coords) {
+    t_physical_tile_type_ptr grid_type =
+      grids[grid_coord.x()][grid_coord.y()].type;
+    if (false == visited_grid_types.insert(grid_type).second) {
+      continue;
+    }
+    for (const t_sub_tile& sub_tile : grid_type->sub_tiles) {
+      for (t_logical_block_type_ptr lb_type : sub_tile.equivalent_sites) {
+        if (nullptr == lb_type->pb_graph_head) {
+          continue;
+        }
+        rec_build_lut_bitstream_infos(lut_infos, device_annotation,
+                                      module_manager, circuit_lib,
+                                      lb_type->pb_graph_head->pb_type);
+      }
     }
   }
+
+  return lut_infos;
+}
+
+/********************************************************************
+ * Top-level function of this file:
+ * Generate bitstreams for all the grids, including
+ * 1. core grids that sit in the center of the fabric
+ * 2. side grids (I/O grids) that sit in the borders for the fabric
+ *
+ * Each grid is independent from the others. So the grids to be visited
+ * are collected in sequence first, and their bitstreams can be built
+ * on multiple threads
+ * The circuit-level information of LUTs is found before visiting the
+ * grids, and is shared by all the threads
+ *******************************************************************/
+void build_grid_bitstream(
+  BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
+  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const DeviceGrid& grids,
+  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
+  const VprClusteringAnnotation& cluster_annotation,
+  const VprPlacementAnnotation& place_annotation,
+  const VprBitstreamAnnotation& bitstream_annotation,
+  const size_t& num_threads, const bool& verbose) {
+  /* Grids to build bitstream for, and the border side they locate */
+  std::vector<vtr::Point<size_t>> grid_coords;
+  std::vector<e_side> grid_border_sides;
+  size_t num_core_grids =
+    collect_bitstream_grid_coordinates(grids, grid_coords, grid_border_sides);
+
+  /* Find the LUTs of the logical tiles in the grids */
+  std::map<t_pb_type*, t_lut_bitstream_info> lut_infos =
+    find_grid_lut_bitstream_infos(grids, grid_coords, device_annotation,
+                                  module_manager, circuit_lib);
+
+  VTR_LOGV(verbose,
+           "Generating bitstream for %lu core grids and %lu I/O grids...",
+           num_core_grids, grid_coords.size() - num_core_grids);
+  ScopedProgress progress("Build grid bitstreams", "grids",
+                          grid_coords.size());
+  build_bitstream_manager_child_blocks(
+    bitstream_manager, top_block, grid_coords.size(), num_threads,
+    [&](BitstreamManager& grid_bitstream_manager,
+        const ConfigBlockId& grid_top_block, const size_t& igrid) {
+      build_physical_block_bitstream(
+        grid_bitstream_manager, grid_top_block, module_manager, circuit_lib,
+        mux_lib, atom_ctx, device_annotation, cluster_annotation,
+        place_annotation, bitstream_annotation, lut_infos, grids,
+        grid_coords[igrid], grid_border_sides[igrid]);
+      progress.advance();
+    });
   VTR_LOGV(verbose, "Done\n");
 }
 
+/********************************************************************
+ * Update the bitstreams of some grids in an existing bitstream database,
+ * which is built by build_grid_bitstream(), e.g., after the clusters
+ * placed on them are changed. The grids are given by the coordinates of
+ * their roots. Their bitstreams are rebuilt on multiple threads, and
+ * copied to the existing blocks, so that the block and bit ids are kept.
+ * The number of bits whose values are changed is added to num_changed_bits
+ *
+ * Return false if the blocks rebuilt differ from the existing ones
+ *******************************************************************/
+bool update_grid_bitstream(
+  BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
+  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const DeviceGrid& grids,
+  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
+  const VprClusteringAnnotation& cluster_annotation,
+  const VprPlacementAnnotation& place_annotation,
+  const VprBitstreamAnnotation& bitstream_annotation,
+  const std::vector<vtr::Point<size_t>>& update_coords,
+  const size_t& num_threads, size_t& num_changed_bits) {
+  /* Visit the grids in the same way as building them */
+  std::vector<vtr::Point<size_t>> all_grid_coords;
+  std::vector<e_side> all_grid_border_sides;
+  collect_bitstream_grid_coordinates(grids, all_grid_coords,
+                                     all_grid_border_sides);
+
+  vtr::Matrix<bool> to_update({grids.width(), grids.height()}, false);
+  for (const vtr::Point<size_t>& coord : update_coords) {
+    to_update[coord.x()][coord.y()] = true;
+  }
+  std::vector<vtr::Point<size_t>> grid_coords;
+  std::vector<e_side> grid_border_sides;
+  for (size_t igrid = 0; igrid < all_grid_coords.size(); ++igrid) {
+    const vtr::Point<size_t>& coord = all_grid_coords[igrid];
+    if (true == to_update[coord.x()][coord.y()]) {
+      grid_coords.push_back(coord);
+      grid_border_sides.push_back(all_grid_border_sides[igrid]);
+    }
+  }
+
+  std::map<t_pb_type*, t_lut_bitstream_info> lut_infos =
+    find_grid_lut_bitstream_infos(grids, grid_coords, device_annotation,
+                                  module_manager, circuit_lib);
+
+  return update_bitstream_manager_child_blocks(
+    bitstream_manager, top_block, grid_coords.size(), num_threads,
+    [&](BitstreamManager& grid_bitstream_manager,
+        const ConfigBlockId& grid_top_block, const size_t& igrid) {
+      build_physical_block_bitstream(
+        grid_bitstream_manager, grid_top_block, module_manager, circuit_lib,
+        mux_lib, atom_ctx, device_annotation, cluster_annotation,
+        place_annotation, bitstream_annotation, lut_infos, grids,
+        grid_coords[igrid], grid_border_sides[igrid]);
+    },
+    num_changed_bits);
+}
+
 } /* end namespace openfpga */
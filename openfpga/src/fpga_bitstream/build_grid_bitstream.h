@@ -11,6 +11,7 @@
 #include "device_grid.h"
 #include "module_manager.h"
 #include "mux_library.h"
+#include "vtr_geometry.h"
 #include "vpr_bitstream_annotation.h"
 #include "vpr_clustering_annotation.h"
 #include "vpr_context.h"
@@ -31,7 +32,19 @@ void build_grid_bitstream(
   const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
   const VprClusteringAnnotation& cluster_annotation,
   const VprPlacementAnnotation& place_annotation,
-  const VprBitstreamAnnotation& bitstream_annotation, const bool& verbose);
+  const VprBitstreamAnnotation& bitstream_annotation,
+  const size_t& num_threads, const bool& verbose);
+
+bool update_grid_bitstream(
+  BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
+  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const DeviceGrid& grids,
+  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
+  const VprClusteringAnnotation& cluster_annotation,
+  const VprPlacementAnnotation& place_annotation,
+  const VprBitstreamAnnotation& bitstream_annotation,
+  const std::vector<vtr::Point<size_t>>& update_coords,
+  const size_t& num_threads, size_t& num_changed_bits);
 
 } /* end namespace openfpga */
 
@@ -14,30 +14,47 @@
 #include "build_io_mapping_info.h"
 #include "module_manager_utils.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
 /********************************************************************
- * This function
- * - builds the net-to-I/O mapping
- * - identifies each I/O directionality
- * - return a database containing the above information
+ * Collect the I/O blocks of the benchmark, i.e., its inputs and outputs
+ *******************************************************************/
+static std::vector<AtomBlockId> find_atom_io_blocks(
+  const AtomContext& atom_ctx) {
+  std::vector<AtomBlockId> io_blocks;
+  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
+    if ((AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) ||
+        (AtomBlockType::OUTPAD == atom_ctx.nlist.block_type(atom_blk))) {
+      io_blocks.push_back(atom_blk);
+    }
+  }
+  return io_blocks;
+}
+
+/********************************************************************
+ * Find the pin of the FPGA fabric I/O ports where each I/O block of
+ * the benchmark is mapped to, i.e., a pair of module port and pin index.
+ * The pins are resolved once for all the I/O blocks, so that the writers
+ * of io mapping and testbenches share the same results.
+ * The pin is invalid for the blocks which are not I/Os.
  *
- * TODO: This function duplicates codes from
- *       function:  print_verilog_testbench_connect_fpga_ios() in
- *       source file: verilog_testbench_utils.cpp
- *       Should consider how to merge the codes and share same builder function
+ * The I/O blocks are resolved in parallel. Each block finds all the
+ * fabric I/Os at its location through a single lookup of the I/O
+ * location map, and then picks the first I/O port which fits it.
  *******************************************************************/
-IoMap build_fpga_io_mapping_info(
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const AtomContext& atom_ctx, const PlacementContext& place_ctx,
-  const IoLocationMap& io_location_map,
-  const VprNetlistAnnotation& netlist_annotation,
-  const std::string& io_input_port_name_postfix,
-  const std::string& io_output_port_name_postfix,
-  const std::vector<std::string>& output_port_prefix_to_remove) {
-  IoMap io_map;
+vtr::vector<AtomBlockId, std::pair<ModulePortId, size_t>>
+find_fpga_io_mapped_module_pins(const ModuleManager& module_manager,
+                                const ModuleId& top_module,
+                                const AtomContext& atom_ctx,
+                                const PlacementContext& place_ctx,
+                                const IoLocationMap& io_location_map,
+                                const size_t& num_threads) {
+  vtr::vector<AtomBlockId, std::pair<ModulePortId, size_t>> mapped_pins(
+    atom_ctx.nlist.blocks().size(),
+    std::make_pair(ModulePortId::INVALID(), size_t(-1)));
 
   /* Only mappable i/o ports can be considered */
   std::vector<ModulePortId> module_io_ports;
@@ -55,29 +72,22 @@ IoMap build_fpga_io_mapping_info(
     }
   }
 
-  /* Type mapping between VPR block and Module port */
-  std::map<AtomBlockType, ModuleManager::e_module_port_type>
-    atom_block_type_to_module_port_type;
-  atom_block_type_to_module_port_type[AtomBlockType::INPAD] =
-    ModuleManager::MODULE_GPIN_PORT;
-  atom_block_type_to_module_port_type[AtomBlockType::OUTPAD] =
-    ModuleManager::MODULE_GPOUT_PORT;
-
-  /* Type mapping between VPR block and io mapping direction */
-  std::map<AtomBlockType, IoMap::e_direction>
-    atom_block_type_to_io_map_direction;
-  atom_block_type_to_io_map_direction[AtomBlockType::INPAD] =
-    IoMap::IO_MAP_DIR_INPUT;
-  atom_block_type_to_io_map_direction[AtomBlockType::OUTPAD] =
-    IoMap::IO_MAP_DIR_OUTPUT;
+  std::vector<AtomBlockId> io_blocks = find_atom_io_blocks(atom_ctx);
+  parallel_for(io_blocks.size(), num_threads, [&](const size_t& iblk) {
+    const AtomBlockId& atom_blk = io_blocks[iblk];
 
-  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
-    /* Bypass non-I/O atom blocks ! */
-    if ((AtomBlockType::INPAD != atom_ctx.nlist.block_type(atom_blk)) &&
-        (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk))) {
-      continue;
+    /* Type mapping between VPR block and Module port */
+    ModuleManager::e_module_port_type atom_block_port_type =
+      ModuleManager::MODULE_GPIN_PORT;
+    if (AtomBlockType::OUTPAD == atom_ctx.nlist.block_type(atom_blk)) {
+      atom_block_port_type = ModuleManager::MODULE_GPOUT_PORT;
     }
 
+    const t_pl_loc& blk_loc =
+      place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc;
+    const std::vector<BasicPort>& location_ios =
+      io_location_map.io_ports(blk_loc.x, blk_loc.y, blk_loc.sub_tile);
+
     /* If there is a GPIO port, use it directly
      * Otherwise, should find a GPIN for INPAD
      *         or should find a GPOUT for OUTPAD
@@ -88,12 +98,15 @@ IoMap build_fpga_io_mapping_info(
       const BasicPort& module_io_port =
         module_manager.module_port(top_module, module_io_port_id);
 
-      /* Find the index of the mapped GPIO in top-level FPGA fabric */
-      size_t temp_io_index = io_location_map.io_index(
-        place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.x,
-        place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.y,
-        place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.sub_tile,
-        module_io_port.get_name());
+      /* Find the index of the mapped GPIO in top-level FPGA fabric. The
+       * first I/O found is used, as io_index() does */
+      size_t temp_io_index = size_t(-1);
+      for (const BasicPort& location_io : location_ios) {
+        if (location_io.get_name() == module_io_port.get_name()) {
+          temp_io_index = location_io.get_lsb();
+          break;
+        }
+      }
 
       /* Bypass invalid index (not mapped to this GPIO port) */
       if (size_t(-1) == temp_io_index) {
@@ -109,8 +122,7 @@ IoMap build_fpga_io_mapping_info(
       }
 
       /* If this is an INPAD, we can use an GPIN port (if available) */
-      if (atom_block_type_to_module_port_type[atom_ctx.nlist.block_type(
-            atom_blk)] ==
+      if (atom_block_port_type ==
           module_manager.port_type(top_module, module_io_port_id)) {
         mapped_module_io_info =
           std::make_pair(module_io_port_id, temp_io_index);
@@ -124,12 +136,52 @@ IoMap build_fpga_io_mapping_info(
     VTR_ASSERT(size_t(-1) != mapped_module_io_info.second);
 
     /* Ensure that IO index is in range */
-    BasicPort module_mapped_io_port =
-      module_manager.module_port(top_module, mapped_module_io_info.first);
-    size_t io_index = mapped_module_io_info.second;
+    VTR_ASSERT(mapped_module_io_info.second <
+               module_manager
+                 .module_port(top_module, mapped_module_io_info.first)
+                 .get_width());
+
+    mapped_pins[atom_blk] = mapped_module_io_info;
+  });
+
+  return mapped_pins;
+}
+
+/********************************************************************
+ * This function
+ * - builds the net-to-I/O mapping
+ * - identifies each I/O directionality
+ * - return a database containing the above information
+ *
+ * The mappings of the I/O blocks are built in parallel, and are then
+ * added to the database in the sequence of the blocks
+ *******************************************************************/
+IoMap build_fpga_io_mapping_info(
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const AtomContext& atom_ctx, const PlacementContext& place_ctx,
+  const IoLocationMap& io_location_map,
+  const VprNetlistAnnotation& netlist_annotation,
+  const std::string& io_input_port_name_postfix,
+  const std::string& io_output_port_name_postfix,
+  const std::vector<std::string>& output_port_prefix_to_remove,
+  const size_t& num_threads) {
+  /* Resolve the fabric I/O of each benchmark I/O */
+  vtr::vector<AtomBlockId, std::pair<ModulePortId, size_t>> mapped_pins =
+    find_fpga_io_mapped_module_pins(module_manager, top_module, atom_ctx,
+                                    place_ctx, io_location_map, num_threads);
+
+  std::vector<AtomBlockId> io_blocks = find_atom_io_blocks(atom_ctx);
+  std::vector<BasicPort> module_mapped_io_ports(io_blocks.size());
+  std::vector<BasicPort> benchmark_io_ports(io_blocks.size());
+  parallel_for(io_blocks.size(), num_threads, [&](const size_t& iblk) {
+    const AtomBlockId& atom_blk = io_blocks[iblk];
+
+    BasicPort& module_mapped_io_port = module_mapped_io_ports[iblk];
+    module_mapped_io_port =
+      module_manager.module_port(top_module, mapped_pins[atom_blk].first);
+    size_t io_index = mapped_pins[atom_blk].second;
 
     /* Set the port pin index */
-    VTR_ASSERT(io_index < module_mapped_io_port.get_width());
     module_mapped_io_port.set_width(io_index, io_index);
 
     /* The block may be renamed as it contains special characters which violate
@@ -144,7 +196,7 @@ IoMap build_fpga_io_mapping_info(
      * different postfix in naming due to verification context! Here, we give
      * full customization on naming
      */
-    BasicPort benchmark_io_port;
+    BasicPort& benchmark_io_port = benchmark_io_ports[iblk];
     if (AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) {
       benchmark_io_port.set_name(
         std::string(block_name + io_input_port_name_postfix));
@@ -166,10 +218,16 @@ IoMap build_fpga_io_mapping_info(
         std::string(output_block_name + io_output_port_name_postfix));
       benchmark_io_port.set_width(1);
     }
+  });
 
+  IoMap io_map;
+  io_map.reserve_io_mappings(io_blocks.size());
+  for (size_t iblk = 0; iblk < io_blocks.size(); ++iblk) {
     io_map.create_io_mapping(
-      module_mapped_io_port, benchmark_io_port,
-      atom_block_type_to_io_map_direction[atom_ctx.nlist.block_type(atom_blk)]);
+      module_mapped_io_ports[iblk], benchmark_io_ports[iblk],
+      AtomBlockType::INPAD == atom_ctx.nlist.block_type(io_blocks[iblk])
+        ? IoMap::IO_MAP_DIR_INPUT
+        : IoMap::IO_MAP_DIR_OUTPUT);
   }
 
   return io_map;
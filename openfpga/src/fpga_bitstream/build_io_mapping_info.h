@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "io_location_map.h"
@@ -12,6 +13,7 @@
 #include "module_manager.h"
 #include "vpr_context.h"
 #include "vpr_netlist_annotation.h"
+#include "vtr_vector.h"
 
 /********************************************************************
  * Function declaration
@@ -20,6 +22,14 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+vtr::vector<AtomBlockId, std::pair<ModulePortId, size_t>>
+find_fpga_io_mapped_module_pins(const ModuleManager& module_manager,
+                                const ModuleId& top_module,
+                                const AtomContext& atom_ctx,
+                                const PlacementContext& place_ctx,
+                                const IoLocationMap& io_location_map,
+                                const size_t& num_threads);
+
 IoMap build_fpga_io_mapping_info(
   const ModuleManager& module_manager, const ModuleId& top_module,
   const AtomContext& atom_ctx, const PlacementContext& place_ctx,
@@ -27,7 +37,8 @@ IoMap build_fpga_io_mapping_info(
   const VprNetlistAnnotation& netlist_annotation,
   const std::string& io_input_port_name_postfix,
   const std::string& io_output_port_name_postfix,
-  const std::vector<std::string>& output_port_prefix_to_remove);
+  const std::vector<std::string>& output_port_prefix_to_remove,
+  const size_t& num_threads);
 
 } /* end namespace openfpga */
 
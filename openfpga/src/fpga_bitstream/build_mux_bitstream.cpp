@@ -68,7 +68,7 @@ static std::vector<bool> build_cmos_mux_bitstream(
     find_mux_implementation_num_inputs(circuit_lib, mux_model, mux_size);
   /* Note that the mux graph is indexed using datapath MUX size!!!! */
   MuxId mux_graph_id = mux_lib.mux_graph(mux_model, mux_size);
-  const MuxGraph mux_graph = mux_lib.mux_graph(mux_graph_id);
+  const MuxGraph& mux_graph = mux_lib.mux_graph(mux_graph_id);
 
   size_t datapath_id = path_id;
 
@@ -80,18 +80,15 @@ static std::vector<bool> build_cmos_mux_bitstream(
     VTR_ASSERT(datapath_id < mux_size);
   }
   /* Path id should makes sense */
-  VTR_ASSERT(datapath_id < mux_graph.inputs().size());
+  VTR_ASSERT(datapath_id < mux_graph.num_inputs());
   /* We should have only one output for this MUX! */
-  VTR_ASSERT(1 == mux_graph.outputs().size());
+  VTR_ASSERT(1 == mux_graph.num_outputs());
 
-  /* Generate the memory bits */
-  vtr::vector<MuxMemId, bool> raw_bitstream = mux_graph.decode_memory_bits(
-    MuxInputId(datapath_id), mux_graph.output_id(mux_graph.outputs()[0]));
+  /* Fetch the memory bits, which are decoded by the MUX library */
+  const vtr::vector<MuxMemId, bool>& raw_bitstream =
+    mux_lib.mux_input_memory_bits(mux_graph_id, MuxInputId(datapath_id));
 
-  std::vector<bool> mux_bitstream;
-  for (const bool& bit : raw_bitstream) {
-    mux_bitstream.push_back(bit);
-  }
+  std::vector<bool> mux_bitstream(raw_bitstream.begin(), raw_bitstream.end());
 
   /* Consider local encoder support, we need further encode the bitstream */
   if (false == circuit_lib.mux_use_local_encoder(mux_model)) {
@@ -4,6 +4,7 @@
  * We decode the bitstream from configuration of routing multiplexers
  * which locate in global routing architecture
  *******************************************************************/
+#include <string>
 #include <vector>
 
 /* Headers from vtrutil library */
@@ -11,11 +12,15 @@
 #include "vtr_log.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_progress.h"
+
+#include "bitstream_manager_utils.h"
 #include "build_mux_bitstream.h"
 #include "build_routing_bitstream.h"
 #include "module_manager_utils.h"
 #include "mux_bitstream_constants.h"
 #include "mux_utils.h"
+#include "openfpga_name_cache.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_rr_graph_utils.h"
@@ -26,52 +31,53 @@
 namespace openfpga {
 
 /********************************************************************
- * This function generates bitstream for a routing multiplexer
- * This function will identify if a node indicates a routing multiplexer
- * If not a routing multiplexer, no bitstream is needed here
- * If yes, we will generate the bitstream for the routing multiplexer
+ * Find the input of a routing multiplexer which is used by the routing
+ * results, i.e., the index of the driver node which is the previous node
+ * of the output node in the routed net.
+ * The previous node is annotated once for each node, so the input is
+ * found in a single pass over the drivers.
+ * Two conditions to be considered:
+ * - There is no net mapped to the output node: we use default path id
+ * - There is a net mapped to the output node: we find the path id
  *******************************************************************/
-static void build_switch_block_mux_bitstream(
-  BitstreamManager& bitstream_manager, const ConfigBlockId& mux_mem_block,
-  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
-  const MuxLibrary& mux_lib, const RRGraphView& rr_graph,
-  const RRNodeId& cur_rr_node, const std::vector<RRNodeId>& drive_rr_nodes,
-  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
-  const VprRoutingAnnotation& routing_annotation) {
-  /* Check current rr_node is CHANX or CHANY*/
-  VTR_ASSERT((CHANX == rr_graph.node_type(cur_rr_node)) ||
-             (CHANY == rr_graph.node_type(cur_rr_node)));
-
-  /* Find the input size of the implementation of a routing multiplexer */
-  size_t datapath_mux_size = drive_rr_nodes.size();
-
-  /* Cache input and output nets */
-  std::vector<ClusterNetId> input_nets;
+static int find_routing_mux_path_id(
+  const VprRoutingAnnotation& routing_annotation, const RRNodeId& cur_rr_node,
+  const std::vector<RRNodeId>& drive_rr_nodes) {
   ClusterNetId output_net = routing_annotation.rr_node_net(cur_rr_node);
-  for (size_t inode = 0; inode < drive_rr_nodes.size(); ++inode) {
-    input_nets.push_back(routing_annotation.rr_node_net(drive_rr_nodes[inode]));
+  if (ClusterNetId::INVALID() == output_net) {
+    return DEFAULT_PATH_ID;
   }
-  VTR_ASSERT(input_nets.size() == drive_rr_nodes.size());
 
-  /* Find out which routing path is used in this MUX
-   * Two conditions to be considered:
-   * - There is no net mapped to cur_rr_node: we use default path id
-   * - There is a net mapped to cur_rr_node: we find the path id
-   */
-  int path_id = DEFAULT_PATH_ID;
-  if (ClusterNetId::INVALID() != output_net) {
-    /* We must have a valid previous node that is supposed to drive the source
-     * node! */
-    VTR_ASSERT(routing_annotation.rr_node_prev_node(cur_rr_node));
-    for (size_t inode = 0; inode < drive_rr_nodes.size(); ++inode) {
-      if ((input_nets[inode] == output_net) &&
-          (drive_rr_nodes[inode] ==
-           routing_annotation.rr_node_prev_node(cur_rr_node))) {
-        path_id = (int)inode;
-        break;
-      }
+  /* We must have a valid previous node that is supposed to drive the source
+   * node! */
+  RRNodeId prev_node = routing_annotation.rr_node_prev_node(cur_rr_node);
+  VTR_ASSERT(prev_node);
+  for (size_t inode = 0; inode < drive_rr_nodes.size(); ++inode) {
+    if ((drive_rr_nodes[inode] == prev_node) &&
+        (routing_annotation.rr_node_net(prev_node) == output_net)) {
+      return (int)inode;
     }
   }
+  return DEFAULT_PATH_ID;
+}
+
+/********************************************************************
+ * This function generates bitstream for a routing multiplexer, in either
+ * a Switch Block or a Connection Block, whose output is a given node
+ * and whose inputs are the driver nodes
+ *******************************************************************/
+static void build_routing_mux_bitstream(
+  BitstreamManager& bitstream_manager, const ConfigBlockId& mux_mem_block,
+  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const RRGraphView& rr_graph,
+  const RRNodeId& cur_rr_node, const std::vector<RRNodeId>& drive_rr_nodes,
+  const size_t& datapath_mux_size, const AtomContext& atom_ctx,
+  const VprDeviceAnnotation& device_annotation,
+  const VprRoutingAnnotation& routing_annotation,
+  MuxNameCache& mux_mem_name_cache) {
+  /* Find out which routing path is used in this MUX */
+  int path_id =
+    find_routing_mux_path_id(routing_annotation, cur_rr_node, drive_rr_nodes);
 
   /* Ensure that our path id makes sense! */
   VTR_ASSERT(
@@ -91,9 +97,11 @@ static void build_switch_block_mux_bitstream(
     circuit_lib, mux_model, mux_lib, datapath_mux_size, path_id);
 
   /* Find the module in module manager and ensure the bitstream size matches! */
-  std::string mem_module_name =
-    generate_mux_subckt_name(circuit_lib, mux_model, datapath_mux_size,
+  const std::string& mem_module_name = mux_mem_name_cache.find_or_build(
+    std::make_pair(mux_model, datapath_mux_size), [&](std::string& name) {
+      append_mux_subckt_name(name, circuit_lib, mux_model, datapath_mux_size,
                              std::string(MEMORY_MODULE_POSTFIX));
+    });
   ModuleId mux_mem_module = module_manager.find_module(mem_module_name);
   VTR_ASSERT(true == module_manager.valid_module_id(mux_mem_module));
   ModulePortId mux_mem_out_port_id = module_manager.find_module_port(
@@ -107,15 +115,21 @@ static void build_switch_block_mux_bitstream(
   /* Record path ids, input and output nets */
   bitstream_manager.add_path_id_to_block(mux_mem_block, path_id);
 
+  /* Skip the nets if they are not recorded */
+  if (false == bitstream_manager.record_net_ids()) {
+    return;
+  }
+
   /* Add input nets */
   bool need_splitter = false;
   std::string input_net_ids;
-  for (const ClusterNetId& input_net : input_nets) {
+  for (const RRNodeId& drive_rr_node : drive_rr_nodes) {
     /* Add a space as a splitter*/
     if (true == need_splitter) {
       input_net_ids += std::string(" ");
     }
-    AtomNetId input_atom_net = atom_ctx.lookup.atom_net(input_net);
+    AtomNetId input_atom_net = atom_ctx.lookup.atom_net(
+      routing_annotation.rr_node_net(drive_rr_node));
     if (true == atom_ctx.nlist.valid_net_id(input_atom_net)) {
       input_net_ids += atom_ctx.nlist.net_name(input_atom_net);
     } else {
@@ -127,7 +141,8 @@ static void build_switch_block_mux_bitstream(
 
   /* Add output nets */
   std::string output_net_ids;
-  AtomNetId output_atom_net = atom_ctx.lookup.atom_net(output_net);
+  AtomNetId output_atom_net =
+    atom_ctx.lookup.atom_net(routing_annotation.rr_node_net(cur_rr_node));
   if (true == atom_ctx.nlist.valid_net_id(output_atom_net)) {
     output_net_ids += atom_ctx.nlist.net_name(output_atom_net);
   } else {
@@ -150,11 +165,15 @@ static void build_switch_block_interc_bitstream(
   const MuxLibrary& mux_lib, const RRGraphView& rr_graph,
   const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
   const VprRoutingAnnotation& routing_annotation, const RRGSB& rr_gsb,
-  const e_side& chan_side, const size_t& chan_node_id) {
+  const e_side& chan_side, const size_t& chan_node_id,
+  MuxNameCache& mux_mem_name_cache) {
   std::vector<RRNodeId> driver_rr_nodes;
 
   /* Get the node */
   const RRNodeId& cur_rr_node = rr_gsb.get_chan_node(chan_side, chan_node_id);
+  /* Check current rr_node is CHANX or CHANY*/
+  VTR_ASSERT((CHANX == rr_graph.node_type(cur_rr_node)) ||
+             (CHANY == rr_graph.node_type(cur_rr_node)));
 
   /* Determine if the interc lies inside a channel wire, that is interc between
    * segments */
@@ -180,10 +199,10 @@ static void build_switch_block_interc_bitstream(
     ConfigBlockId mux_mem_block = bitstream_manager.add_block(mem_block_name);
     bitstream_manager.add_child_block(sb_configurable_block, mux_mem_block);
     /* This is a routing multiplexer! Generate bitstream */
-    build_switch_block_mux_bitstream(
+    build_routing_mux_bitstream(
       bitstream_manager, mux_mem_block, module_manager, circuit_lib, mux_lib,
-      rr_graph, cur_rr_node, driver_rr_nodes, atom_ctx, device_annotation,
-      routing_annotation);
+      rr_graph, cur_rr_node, driver_rr_nodes, driver_rr_nodes.size(),
+      atom_ctx, device_annotation, routing_annotation, mux_mem_name_cache);
   } /*Nothing should be done else*/
 }
 
@@ -204,7 +223,7 @@ static void build_switch_block_bitstream(
   const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
   const VprDeviceAnnotation& device_annotation,
   const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
-  const RRGSB& rr_gsb) {
+  const RRGSB& rr_gsb, MuxNameCache& mux_mem_name_cache) {
   /* Iterate over all the multiplexers */
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
     SideManager side_manager(side);
@@ -222,125 +241,9 @@ static void build_switch_block_bitstream(
       build_switch_block_interc_bitstream(
         bitstream_manager, sb_config_block, module_manager, circuit_lib,
         mux_lib, rr_graph, atom_ctx, device_annotation, routing_annotation,
-        rr_gsb, side_manager.get_side(), itrack);
-    }
-  }
-}
-
-/********************************************************************
- * This function generates bitstream for a routing multiplexer
- * in a Connection block
- * This function will identify if a node indicates a routing multiplexer
- * If not a routing multiplexer, no bitstream is needed here
- * If yes, we will generate the bitstream for the routing multiplexer
- *******************************************************************/
-static void build_connection_block_mux_bitstream(
-  BitstreamManager& bitstream_manager, const ConfigBlockId& mux_mem_block,
-  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
-  const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
-  const VprDeviceAnnotation& device_annotation,
-  const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
-  const RRGSB& rr_gsb, const e_side& cb_ipin_side, const size_t& ipin_index) {
-  RRNodeId src_rr_node = rr_gsb.get_ipin_node(cb_ipin_side, ipin_index);
-  /* Find drive_rr_nodes*/
-  size_t datapath_mux_size = rr_graph.node_fan_in(src_rr_node);
-
-  std::vector<RREdgeId> driver_rr_edges =
-    rr_gsb.get_ipin_node_in_edges(rr_graph, cb_ipin_side, ipin_index);
-
-  /* Cache input and output nets */
-  std::vector<ClusterNetId> input_nets;
-  ClusterNetId output_net = routing_annotation.rr_node_net(src_rr_node);
-  for (const RREdgeId& edge : driver_rr_edges) {
-    RRNodeId driver_node = rr_graph.edge_src_node(edge);
-    input_nets.push_back(routing_annotation.rr_node_net(driver_node));
-  }
-
-  /* Configuration bits for MUX*/
-  int path_id = DEFAULT_PATH_ID;
-  int edge_index = 0;
-
-  /* Find which path is connected to the output of this routing multiplexer
-   * Two conditions to be considered:
-   * - There is no net mapped to src_rr_node: we use default path id
-   * - There is a net mapped to src_rr_node: we find the path id
-   */
-  if (ClusterNetId::INVALID() != output_net) {
-    for (const RREdgeId& edge : driver_rr_edges) {
-      RRNodeId driver_node = rr_graph.edge_src_node(edge);
-      /* We must have a valid previous node that is supposed to drive the source
-       * node! */
-      VTR_ASSERT(routing_annotation.rr_node_prev_node(src_rr_node));
-      if ((routing_annotation.rr_node_net(driver_node) == output_net) &&
-          (driver_node == routing_annotation.rr_node_prev_node(src_rr_node))) {
-        path_id = edge_index;
-        break;
-      }
-      edge_index++;
-    }
-  }
-
-  /* Ensure that our path id makes sense! */
-  VTR_ASSERT(
-    (DEFAULT_PATH_ID == path_id) ||
-    ((DEFAULT_PATH_ID < path_id) && (path_id < (int)datapath_mux_size)));
-
-  /* Find the circuit model id of the mux, we need its design technology which
-   * matters the bitstream generation */
-  std::vector<RRSwitchId> driver_switches =
-    get_rr_graph_driver_switches(rr_graph, src_rr_node);
-  VTR_ASSERT(1 == driver_switches.size());
-  CircuitModelId mux_model =
-    device_annotation.rr_switch_circuit_model(driver_switches[0]);
-
-  /* Generate bitstream depend on both technology and structure of this MUX */
-  std::vector<bool> mux_bitstream = build_mux_bitstream(
-    circuit_lib, mux_model, mux_lib, datapath_mux_size, path_id);
-
-  /* Find the module in module manager and ensure the bitstream size matches! */
-  std::string mem_module_name =
-    generate_mux_subckt_name(circuit_lib, mux_model, datapath_mux_size,
-                             std::string(MEMORY_MODULE_POSTFIX));
-  ModuleId mux_mem_module = module_manager.find_module(mem_module_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(mux_mem_module));
-  ModulePortId mux_mem_out_port_id = module_manager.find_module_port(
-    mux_mem_module, generate_configurable_memory_data_out_name());
-  VTR_ASSERT(mux_bitstream.size() ==
-             module_manager.module_port(mux_mem_module, mux_mem_out_port_id)
-               .get_width());
-
-  /* Add the bistream to the bitstream manager */
-  bitstream_manager.add_block_bits(mux_mem_block, mux_bitstream);
-  /* Record path ids, input and output nets */
-  bitstream_manager.add_path_id_to_block(mux_mem_block, path_id);
-
-  /* Add input nets */
-  bool need_splitter = false;
-  std::string input_net_ids;
-  for (const ClusterNetId& input_net : input_nets) {
-    /* Add a space as a splitter*/
-    if (true == need_splitter) {
-      input_net_ids += std::string(" ");
+        rr_gsb, side_manager.get_side(), itrack, mux_mem_name_cache);
     }
-    AtomNetId input_atom_net = atom_ctx.lookup.atom_net(input_net);
-    if (true == atom_ctx.nlist.valid_net_id(input_atom_net)) {
-      input_net_ids += atom_ctx.nlist.net_name(input_atom_net);
-    } else {
-      input_net_ids += std::string("unmapped");
-    }
-    need_splitter = true;
   }
-  bitstream_manager.add_input_net_id_to_block(mux_mem_block, input_net_ids);
-
-  /* Add output nets */
-  std::string output_net_ids;
-  AtomNetId output_atom_net = atom_ctx.lookup.atom_net(output_net);
-  if (true == atom_ctx.nlist.valid_net_id(output_atom_net)) {
-    output_net_ids += atom_ctx.nlist.net_name(output_atom_net);
-  } else {
-    output_net_ids += std::string("unmapped");
-  }
-  bitstream_manager.add_output_net_id_to_block(mux_mem_block, output_net_ids);
 }
 
 /********************************************************************
@@ -357,7 +260,8 @@ static void build_connection_block_interc_bitstream(
   const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
   const VprDeviceAnnotation& device_annotation,
   const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
-  const RRGSB& rr_gsb, const e_side& cb_ipin_side, const size_t& ipin_index) {
+  const RRGSB& rr_gsb, const e_side& cb_ipin_side, const size_t& ipin_index,
+  MuxNameCache& mux_mem_name_cache) {
   RRNodeId src_rr_node = rr_gsb.get_ipin_node(cb_ipin_side, ipin_index);
 
   /* Consider configurable edges only */
@@ -380,10 +284,11 @@ static void build_connection_block_interc_bitstream(
     ConfigBlockId mux_mem_block = bitstream_manager.add_block(mem_block_name);
     bitstream_manager.add_child_block(cb_configurable_block, mux_mem_block);
     /* This is a routing multiplexer! Generate bitstream */
-    build_connection_block_mux_bitstream(
+    build_routing_mux_bitstream(
       bitstream_manager, mux_mem_block, module_manager, circuit_lib, mux_lib,
-      atom_ctx, device_annotation, routing_annotation, rr_graph, rr_gsb,
-      cb_ipin_side, ipin_index);
+      rr_graph, src_rr_node, driver_rr_nodes,
+      rr_graph.node_fan_in(src_rr_node), atom_ctx, device_annotation,
+      routing_annotation, mux_mem_name_cache);
   } /*Nothing should be done else*/
 }
 
@@ -405,7 +310,8 @@ static void build_connection_block_bitstream(
   const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
   const VprDeviceAnnotation& device_annotation,
   const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
-  const RRGSB& rr_gsb, const t_rr_type& cb_type) {
+  const RRGSB& rr_gsb, const t_rr_type& cb_type,
+  MuxNameCache& mux_mem_name_cache) {
   /* Find routing multiplexers on the sides of a Connection block where IPIN
    * nodes locate */
   std::vector<enum e_side> cb_sides = rr_gsb.get_cb_ipin_sides(cb_type);
@@ -418,11 +324,84 @@ static void build_connection_block_bitstream(
       build_connection_block_interc_bitstream(
         bitstream_manager, cb_configurable_block, module_manager, circuit_lib,
         mux_lib, atom_ctx, device_annotation, routing_annotation, rr_graph,
-        rr_gsb, cb_ipin_side, inode);
+        rr_gsb, cb_ipin_side, inode, mux_mem_name_cache);
     }
   }
 }
 
+/********************************************************************
+ * Create bitstream for the X-direction or Y-direction Connection Block
+ * of a General Switch Block (GSB), if it exists and is configurable
+ *******************************************************************/
+static void build_gsb_connection_block_bitstream(
+  BitstreamManager& bitstream_manager,
+  const ConfigBlockId& top_configurable_block,
+  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
+  const VprDeviceAnnotation& device_annotation,
+  const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
+  const t_rr_type& cb_type, const vtr::Point<size_t>& gsb_coord) {
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coord.x(), gsb_coord.y());
+  /* Check if the connection block exists in the device!
+   * Some of them do NOT exist due to heterogeneous blocks (height > 1)
+   * We will skip those modules
+   */
+  if (false == rr_gsb.is_cb_exist(cb_type)) {
+    return;
+  }
+  /* Skip if the cb does not contain any configuration bits! */
+  if (true == connection_block_contain_only_routing_tracks(rr_gsb, cb_type)) {
+    return;
+  }
+
+  /* Find the cb module so that we can precisely reserve child blocks */
+  vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type),
+                              rr_gsb.get_cb_y(cb_type));
+  std::string cb_module_name =
+    generate_connection_block_module_name(cb_type, cb_coord);
+  if (true == compact_routing_hierarchy) {
+    vtr::Point<size_t> unique_cb_coord = gsb_coord;
+    /* Note: use GSB coordinate when inquire for unique modules!!! */
+    const RRGSB& unique_mirror =
+      device_rr_gsb.get_cb_unique_module(cb_type, unique_cb_coord);
+    unique_cb_coord.set_x(unique_mirror.get_cb_x(cb_type));
+    unique_cb_coord.set_y(unique_mirror.get_cb_y(cb_type));
+    cb_module_name =
+      generate_connection_block_module_name(cb_type, unique_cb_coord);
+  }
+  ModuleId cb_module = module_manager.find_module(cb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
+
+  /* Bypass empty blocks which have none configurable children */
+  if (0 == count_module_manager_module_configurable_children(module_manager,
+                                                             cb_module)) {
+    return;
+  }
+
+  /* Create a block for the bitstream which corresponds to the Switch block
+   */
+  ConfigBlockId cb_configurable_block = bitstream_manager.add_block(
+    generate_connection_block_module_name(cb_type, cb_coord));
+  /* Set switch block as a child of top block */
+  bitstream_manager.add_child_block(top_configurable_block,
+                                    cb_configurable_block);
+
+  /* Reserve child blocks for new created block */
+  bitstream_manager.reserve_child_blocks(
+    cb_configurable_block,
+    count_module_manager_module_configurable_children(module_manager,
+                                                      cb_module));
+
+  /* Memory modules of routing multiplexers are shared by many multiplexers
+   * of a block, so their names are built once per block */
+  MuxNameCache mux_mem_name_cache;
+  build_connection_block_bitstream(
+    bitstream_manager, cb_configurable_block, module_manager, circuit_lib,
+    mux_lib, atom_ctx, device_annotation, routing_annotation, rr_graph,
+    rr_gsb, cb_type, mux_mem_name_cache);
+}
+
 /********************************************************************
  * Create bitstream for a X-direction or Y-direction Connection Blocks
  *******************************************************************/
@@ -434,69 +413,90 @@ static void build_connection_block_bitstreams(
   const VprDeviceAnnotation& device_annotation,
   const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
   const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
-  const t_rr_type& cb_type) {
+  const t_rr_type& cb_type, const size_t& num_threads) {
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
-  for (size_t ix = 0; ix < cb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < cb_range.y(); ++iy) {
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      /* Check if the connection block exists in the device!
-       * Some of them do NOT exist due to heterogeneous blocks (height > 1)
-       * We will skip those modules
-       */
-      if (false == rr_gsb.is_cb_exist(cb_type)) {
-        continue;
-      }
-      /* Skip if the cb does not contain any configuration bits! */
-      if (true ==
-          connection_block_contain_only_routing_tracks(rr_gsb, cb_type)) {
-        continue;
-      }
+  ScopedProgress progress(
+    std::string("Build ") + (CHANX == cb_type ? "X" : "Y") +
+      "-direction connection block bitstreams",
+    "GSBs", cb_range.x() * cb_range.y());
+  build_bitstream_manager_child_blocks(
+    bitstream_manager, top_configurable_block, cb_range.x() * cb_range.y(),
+    num_threads,
+    [&](BitstreamManager& cb_bitstream_manager,
+        const ConfigBlockId& cb_top_block, const size_t& igsb) {
+      build_gsb_connection_block_bitstream(
+        cb_bitstream_manager, cb_top_block, module_manager, circuit_lib,
+        mux_lib, atom_ctx, device_annotation, routing_annotation, rr_graph,
+        device_rr_gsb, compact_routing_hierarchy, cb_type,
+        vtr::Point<size_t>(igsb / cb_range.y(), igsb % cb_range.y()));
+      progress.advance();
+    });
+}
 
-      /* Find the cb module so that we can precisely reserve child blocks */
-      vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type),
-                                  rr_gsb.get_cb_y(cb_type));
-      std::string cb_module_name =
-        generate_connection_block_module_name(cb_type, cb_coord);
-      if (true == compact_routing_hierarchy) {
-        vtr::Point<size_t> unique_cb_coord(ix, iy);
-        /* Note: use GSB coordinate when inquire for unique modules!!! */
-        const RRGSB& unique_mirror =
-          device_rr_gsb.get_cb_unique_module(cb_type, unique_cb_coord);
-        unique_cb_coord.set_x(unique_mirror.get_cb_x(cb_type));
-        unique_cb_coord.set_y(unique_mirror.get_cb_y(cb_type));
-        cb_module_name =
-          generate_connection_block_module_name(cb_type, unique_cb_coord);
-      }
-      ModuleId cb_module = module_manager.find_module(cb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
+/********************************************************************
+ * Create bitstream for the Switch Block of a General Switch Block (GSB),
+ * if it exists and is configurable
+ *******************************************************************/
+static void build_gsb_switch_block_bitstream(
+  BitstreamManager& bitstream_manager,
+  const ConfigBlockId& top_configurable_block,
+  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
+  const VprDeviceAnnotation& device_annotation,
+  const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
+  const vtr::Point<size_t>& gsb_coord) {
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coord.x(), gsb_coord.y());
+  /* Check if the switch block exists in the device!
+   * Some of them do NOT exist due to heterogeneous blocks (width > 1)
+   * We will skip those modules
+   */
+  if (false == rr_gsb.is_sb_exist()) {
+    return;
+  }
 
-      /* Bypass empty blocks which have none configurable children */
-      if (0 == count_module_manager_module_configurable_children(module_manager,
-                                                                 cb_module)) {
-        continue;
-      }
+  vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
 
-      /* Create a block for the bitstream which corresponds to the Switch block
-       */
-      ConfigBlockId cb_configurable_block = bitstream_manager.add_block(
-        generate_connection_block_module_name(cb_type, cb_coord));
-      /* Set switch block as a child of top block */
-      bitstream_manager.add_child_block(top_configurable_block,
-                                        cb_configurable_block);
-
-      /* Reserve child blocks for new created block */
-      bitstream_manager.reserve_child_blocks(
-        cb_configurable_block,
-        count_module_manager_module_configurable_children(module_manager,
-                                                          cb_module));
-
-      build_connection_block_bitstream(
-        bitstream_manager, cb_configurable_block, module_manager, circuit_lib,
-        mux_lib, atom_ctx, device_annotation, routing_annotation, rr_graph,
-        rr_gsb, cb_type);
-    }
+  /* Find the sb module so that we can precisely reserve child blocks */
+  std::string sb_module_name = generate_switch_block_module_name(sb_coord);
+  if (true == compact_routing_hierarchy) {
+    vtr::Point<size_t> unique_sb_coord = gsb_coord;
+    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
+    unique_sb_coord.set_x(unique_mirror.get_sb_x());
+    unique_sb_coord.set_y(unique_mirror.get_sb_y());
+    sb_module_name = generate_switch_block_module_name(unique_sb_coord);
+  }
+  ModuleId sb_module = module_manager.find_module(sb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
+
+  /* Bypass empty blocks which have none configurable children */
+  if (0 == count_module_manager_module_configurable_children(module_manager,
+                                                             sb_module)) {
+    return;
   }
+
+  /* Create a block for the bitstream which corresponds to the Switch block
+   */
+  ConfigBlockId sb_configurable_block = bitstream_manager.add_block(
+    generate_switch_block_module_name(sb_coord));
+  /* Set switch block as a child of top block */
+  bitstream_manager.add_child_block(top_configurable_block,
+                                    sb_configurable_block);
+
+  /* Reserve child blocks for new created block */
+  bitstream_manager.reserve_child_blocks(
+    sb_configurable_block,
+    count_module_manager_module_configurable_children(module_manager,
+                                                      sb_module));
+
+  /* Memory modules of routing multiplexers are shared by many multiplexers
+   * of a block, so their names are built once per block */
+  MuxNameCache mux_mem_name_cache;
+  build_switch_block_bitstream(bitstream_manager, sb_configurable_block,
+                               module_manager, circuit_lib, mux_lib, atom_ctx,
+                               device_annotation, routing_annotation, rr_graph,
+                               rr_gsb, mux_mem_name_cache);
 }
 
 /********************************************************************
@@ -504,6 +504,11 @@ static void build_connection_block_bitstreams(
  * Two major tasks:
  * 1. Generate bitstreams for Switch Blocks
  * 2. Generate bitstreams for both X-direction and Y-direction Connection Blocks
+ *
+ * The routing blocks are independent from each other, so the bitstream of
+ * each General Switch Block (GSB) can be built on multiple threads.
+ * GSBs are visited in the sequence of x then y coordinates regardless of the
+ * number of threads
  *******************************************************************/
 void build_routing_bitstream(
   BitstreamManager& bitstream_manager,
@@ -512,7 +517,8 @@ void build_routing_bitstream(
   const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
   const VprDeviceAnnotation& device_annotation,
   const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
-  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy) {
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
+  const size_t& num_threads) {
   /* Generate bitstream for each switch blocks
    * To organize the bitstream in blocks, we create a block for each switch
    * block and give names which are same as they are in top-level module
@@ -520,57 +526,21 @@ void build_routing_bitstream(
    */
   VTR_LOG("Generating bitstream for Switch blocks...");
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
-  for (size_t ix = 0; ix < sb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < sb_range.y(); ++iy) {
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      /* Check if the switch block exists in the device!
-       * Some of them do NOT exist due to heterogeneous blocks (width > 1)
-       * We will skip those modules
-       */
-      if (false == rr_gsb.is_sb_exist()) {
-        continue;
-      }
-
-      vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-
-      /* Find the sb module so that we can precisely reserve child blocks */
-      std::string sb_module_name = generate_switch_block_module_name(sb_coord);
-      if (true == compact_routing_hierarchy) {
-        vtr::Point<size_t> unique_sb_coord(ix, iy);
-        const RRGSB& unique_mirror =
-          device_rr_gsb.get_sb_unique_module(sb_coord);
-        unique_sb_coord.set_x(unique_mirror.get_sb_x());
-        unique_sb_coord.set_y(unique_mirror.get_sb_y());
-        sb_module_name = generate_switch_block_module_name(unique_sb_coord);
-      }
-      ModuleId sb_module = module_manager.find_module(sb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
-
-      /* Bypass empty blocks which have none configurable children */
-      if (0 == count_module_manager_module_configurable_children(module_manager,
-                                                                 sb_module)) {
-        continue;
-      }
-
-      /* Create a block for the bitstream which corresponds to the Switch block
-       */
-      ConfigBlockId sb_configurable_block = bitstream_manager.add_block(
-        generate_switch_block_module_name(sb_coord));
-      /* Set switch block as a child of top block */
-      bitstream_manager.add_child_block(top_configurable_block,
-                                        sb_configurable_block);
-
-      /* Reserve child blocks for new created block */
-      bitstream_manager.reserve_child_blocks(
-        sb_configurable_block,
-        count_module_manager_module_configurable_children(module_manager,
-                                                          sb_module));
-
-      build_switch_block_bitstream(bitstream_manager, sb_configurable_block,
-                                   module_manager, circuit_lib, mux_lib,
-                                   atom_ctx, device_annotation,
-                                   routing_annotation, rr_graph, rr_gsb);
-    }
+  {
+    ScopedProgress progress("Build switch block bitstreams", "GSBs",
+                            sb_range.x() * sb_range.y());
+    build_bitstream_manager_child_blocks(
+      bitstream_manager, top_configurable_block, sb_range.x() * sb_range.y(),
+      num_threads,
+      [&](BitstreamManager& gsb_bitstream_manager,
+          const ConfigBlockId& gsb_top_block, const size_t& igsb) {
+        build_gsb_switch_block_bitstream(
+          gsb_bitstream_manager, gsb_top_block, module_manager, circuit_lib,
+          mux_lib, atom_ctx, device_annotation, routing_annotation, rr_graph,
+          device_rr_gsb, compact_routing_hierarchy,
+          vtr::Point<size_t>(igsb / sb_range.y(), igsb % sb_range.y()));
+        progress.advance();
+      });
   }
   VTR_LOG("Done\n");
 
@@ -584,7 +554,7 @@ void build_routing_bitstream(
   build_connection_block_bitstreams(
     bitstream_manager, top_configurable_block, module_manager, circuit_lib,
     mux_lib, atom_ctx, device_annotation, routing_annotation, rr_graph,
-    device_rr_gsb, compact_routing_hierarchy, CHANX);
+    device_rr_gsb, compact_routing_hierarchy, CHANX, num_threads);
   VTR_LOG("Done\n");
 
   VTR_LOG("Generating bitstream for Y-direction Connection blocks ...");
@@ -592,8 +562,64 @@ void build_routing_bitstream(
   build_connection_block_bitstreams(
     bitstream_manager, top_configurable_block, module_manager, circuit_lib,
     mux_lib, atom_ctx, device_annotation, routing_annotation, rr_graph,
-    device_rr_gsb, compact_routing_hierarchy, CHANY);
+    device_rr_gsb, compact_routing_hierarchy, CHANY, num_threads);
   VTR_LOG("Done\n");
 }
 
+/********************************************************************
+ * Update the bitstreams of the routing blocks of some General Switch
+ * Blocks (GSBs) in an existing bitstream database, which is built by
+ * build_routing_bitstream(), e.g., after the routing through them is
+ * changed. The switch block and the connection blocks of each GSB are
+ * rebuilt on multiple threads, and copied to the existing blocks, so that
+ * the block and bit ids are kept.
+ * The number of bits whose values are changed is added to num_changed_bits
+ *
+ * Return false if the blocks rebuilt differ from the existing ones
+ *******************************************************************/
+bool update_routing_bitstream(
+  BitstreamManager& bitstream_manager,
+  const ConfigBlockId& top_configurable_block,
+  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
+  const VprDeviceAnnotation& device_annotation,
+  const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
+  const std::vector<vtr::Point<size_t>>& gsb_coords,
+  const size_t& num_threads, size_t& num_changed_bits) {
+  if (false == update_bitstream_manager_child_blocks(
+                 bitstream_manager, top_configurable_block, gsb_coords.size(),
+                 num_threads,
+                 [&](BitstreamManager& gsb_bitstream_manager,
+                     const ConfigBlockId& gsb_top_block, const size_t& igsb) {
+                   build_gsb_switch_block_bitstream(
+                     gsb_bitstream_manager, gsb_top_block, module_manager,
+                     circuit_lib, mux_lib, atom_ctx, device_annotation,
+                     routing_annotation, rr_graph, device_rr_gsb,
+                     compact_routing_hierarchy, gsb_coords[igsb]);
+                 },
+                 num_changed_bits)) {
+    return false;
+  }
+
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    if (false == update_bitstream_manager_child_blocks(
+                   bitstream_manager, top_configurable_block,
+                   gsb_coords.size(), num_threads,
+                   [&](BitstreamManager& cb_bitstream_manager,
+                       const ConfigBlockId& cb_top_block, const size_t& igsb) {
+                     build_gsb_connection_block_bitstream(
+                       cb_bitstream_manager, cb_top_block, module_manager,
+                       circuit_lib, mux_lib, atom_ctx, device_annotation,
+                       routing_annotation, rr_graph, device_rr_gsb,
+                       compact_routing_hierarchy, cb_type, gsb_coords[igsb]);
+                   },
+                   num_changed_bits)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 } /* end namespace openfpga */
@@ -32,7 +32,19 @@ void build_routing_bitstream(
   const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
   const VprDeviceAnnotation& device_annotation,
   const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
-  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy);
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
+  const size_t& num_threads);
+
+bool update_routing_bitstream(
+  BitstreamManager& bitstream_manager,
+  const ConfigBlockId& top_configurable_block,
+  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
+  const VprDeviceAnnotation& device_annotation,
+  const VprRoutingAnnotation& routing_annotation, const RRGraphView& rr_graph,
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
+  const std::vector<vtr::Point<size_t>>& gsb_coords,
+  const size_t& num_threads, size_t& num_changed_bits);
 
 } /* end namespace openfpga */
 
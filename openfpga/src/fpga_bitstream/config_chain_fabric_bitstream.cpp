@@ -0,0 +1,41 @@
+#include "config_chain_fabric_bitstream.h"
+
+#include <algorithm>
+
+#include "vtr_assert.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+ConfigChainFabricBitstream::ConfigChainFabricBitstream(
+  const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream)
+  : bitstream_manager_(bitstream_manager),
+    fabric_bitstream_(fabric_bitstream),
+    num_rows_(0) {
+  /* Find the longest bitstream */
+  for (const FabricBitRegionId& region : fabric_bitstream_.regions()) {
+    num_rows_ =
+      std::max(num_rows_, fabric_bitstream_.region_bits(region).size());
+  }
+  region_offsets_.resize(fabric_bitstream_.num_regions(), 0);
+  for (const FabricBitRegionId& region : fabric_bitstream_.regions()) {
+    region_offsets_[region] =
+      num_rows_ - fabric_bitstream_.region_bits(region).size();
+  }
+}
+
+size_t ConfigChainFabricBitstream::num_rows() const { return num_rows_; }
+
+bool ConfigChainFabricBitstream::bit_value(
+  const size_t& row, const FabricBitRegionId& region) const {
+  VTR_ASSERT(row < num_rows_);
+  if (row < region_offsets_[region]) {
+    return false;
+  }
+  const FabricBitId& bit_id =
+    fabric_bitstream_.region_bits(region)[row - region_offsets_[region]];
+  return bitstream_manager_.bit_value(fabric_bitstream_.config_bit(bit_id));
+}
+
+} /* end namespace openfpga */
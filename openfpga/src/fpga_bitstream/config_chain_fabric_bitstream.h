@@ -0,0 +1,48 @@
+#ifndef CONFIG_CHAIN_FABRIC_BITSTREAM_H
+#define CONFIG_CHAIN_FABRIC_BITSTREAM_H
+
+#include <vector>
+
+#include "bitstream_manager.h"
+#include "fabric_bitstream.h"
+#include "vtr_vector.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/******************************************************************************
+ * This files includes data structures that provides a downloadable format of
+ *fabric bitstream which is compatible with configuration chain protocol
+ * The bitstreams of all the regions are aligned to the longest one, where
+ *logic '0' bits are deposited to the head of shorter bitstreams. Each row
+ *consists of the bits of all the regions which are loaded at the same cycle
+ *   Region 0: 000000001111101010 <- max. bitstream length
+ *   Region 1:     00000011010101 <- add zeros to the head
+ * The bits are found from the fabric bitstream on the fly, row by row, so that
+ *the bitstream is not copied in memory
+ * @note The fabric bitstream and bitstream manager should be kept unchanged
+ *as long as this data structure is used
+ ******************************************************************************/
+class ConfigChainFabricBitstream {
+ public: /* Constructors */
+  ConfigChainFabricBitstream(const BitstreamManager& bitstream_manager,
+                             const FabricBitstream& fabric_bitstream);
+
+ public: /* Accessors */
+  /* @brief Return the number of rows, i.e., the longest regional bitstream */
+  size_t num_rows() const;
+
+  /* @brief Return the value of a bit in a row for a region */
+  bool bit_value(const size_t& row, const FabricBitRegionId& region) const;
+
+ private: /* Internal data */
+  const BitstreamManager& bitstream_manager_;
+  const FabricBitstream& fabric_bitstream_;
+  size_t num_rows_;
+  /* Number of '0' bits deposited to the head of the bitstream of each region */
+  vtr::vector<FabricBitRegionId, size_t> region_offsets_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * This file includes member functions for data structure
+ * DeviceBitstreamSnapshot
+ ******************************************************************************/
+#include "device_bitstream_snapshot.h"
+
+#include "vtr_assert.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/******************************************************************************
+ * Public Accessors
+ ******************************************************************************/
+bool DeviceBitstreamSnapshot::empty() const {
+  return grid_digests_.empty() && gsb_digests_.empty();
+}
+
+vtr::Point<size_t> DeviceBitstreamSnapshot::grid_size() const {
+  if (true == grid_digests_.empty()) {
+    return vtr::Point<size_t>(0, 0);
+  }
+  return vtr::Point<size_t>(grid_digests_.dim_size(0),
+                            grid_digests_.dim_size(1));
+}
+
+vtr::Point<size_t> DeviceBitstreamSnapshot::gsb_range() const {
+  if (true == gsb_digests_.empty()) {
+    return vtr::Point<size_t>(0, 0);
+  }
+  return vtr::Point<size_t>(gsb_digests_.dim_size(0), gsb_digests_.dim_size(1));
+}
+
+uint64_t DeviceBitstreamSnapshot::grid_digest(
+  const vtr::Point<size_t>& coord) const {
+  VTR_ASSERT(coord.x() < grid_size().x() && coord.y() < grid_size().y());
+  return grid_digests_[coord.x()][coord.y()];
+}
+
+uint64_t DeviceBitstreamSnapshot::gsb_digest(
+  const vtr::Point<size_t>& coord) const {
+  VTR_ASSERT(coord.x() < gsb_range().x() && coord.y() < gsb_range().y());
+  return gsb_digests_[coord.x()][coord.y()];
+}
+
+/******************************************************************************
+ * Public Mutators
+ ******************************************************************************/
+void DeviceBitstreamSnapshot::resize(const vtr::Point<size_t>& grid_size,
+                                     const vtr::Point<size_t>& gsb_range) {
+  grid_digests_.resize({grid_size.x(), grid_size.y()}, 0);
+  gsb_digests_.resize({gsb_range.x(), gsb_range.y()}, 0);
+}
+
+void DeviceBitstreamSnapshot::set_grid_digest(const vtr::Point<size_t>& coord,
+                                              const uint64_t& digest) {
+  VTR_ASSERT(coord.x() < grid_size().x() && coord.y() < grid_size().y());
+  grid_digests_[coord.x()][coord.y()] = digest;
+}
+
+void DeviceBitstreamSnapshot::set_gsb_digest(const vtr::Point<size_t>& coord,
+                                             const uint64_t& digest) {
+  VTR_ASSERT(coord.x() < gsb_range().x() && coord.y() < gsb_range().y());
+  gsb_digests_[coord.x()][coord.y()] = digest;
+}
+
+void DeviceBitstreamSnapshot::clear() {
+  grid_digests_.clear();
+  gsb_digests_.clear();
+}
+
+} /* end namespace openfpga */
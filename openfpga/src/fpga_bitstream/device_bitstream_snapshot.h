@@ -0,0 +1,51 @@
+#ifndef DEVICE_BITSTREAM_SNAPSHOT_H
+#define DEVICE_BITSTREAM_SNAPSHOT_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstdint>
+
+#include "vtr_geometry.h"
+#include "vtr_ndmatrix.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/******************************************************************************
+ * A snapshot of the implementation results which a device bitstream is
+ * decoded from, so that the grids and routing blocks whose results are
+ * changed can be found when the bitstream is updated.
+ * - The bitstream of a grid is decoded from the physical pbs of the
+ *   clusters placed on it. Each grid, identified by the coordinate of its
+ *   root, keeps a digest of its physical pbs.
+ * - The bitstream of the switch block and the connection blocks of a
+ *   General Switch Block (GSB) is decoded from the routing of its nodes.
+ *   Each GSB keeps a digest of the nets and the previous nodes of its nodes.
+ * A digest of 0 means that the grid or the GSB has no result to decode
+ ******************************************************************************/
+class DeviceBitstreamSnapshot {
+ public: /* Public accessors */
+  bool empty() const;
+  vtr::Point<size_t> grid_size() const;
+  vtr::Point<size_t> gsb_range() const;
+  uint64_t grid_digest(const vtr::Point<size_t>& coord) const;
+  uint64_t gsb_digest(const vtr::Point<size_t>& coord) const;
+
+ public: /* Public mutators */
+  /* Allocate the digests of all the grids and GSBs, which are 0 */
+  void resize(const vtr::Point<size_t>& grid_size,
+              const vtr::Point<size_t>& gsb_range);
+  void set_grid_digest(const vtr::Point<size_t>& coord,
+                       const uint64_t& digest);
+  void set_gsb_digest(const vtr::Point<size_t>& coord, const uint64_t& digest);
+  void clear();
+
+ private: /* Internal data */
+  vtr::Matrix<uint64_t> grid_digests_;
+  vtr::Matrix<uint64_t> gsb_digests_;
+};
+
+} /* end namespace openfpga */
+
+#endif
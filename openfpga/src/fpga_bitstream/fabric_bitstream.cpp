@@ -4,8 +4,11 @@
 #include "fabric_bitstream.h"
 
 #include <algorithm>
+#include <array>
+#include <limits>
 
-#include "openfpga_decode.h"
+#include "bitstream_manager.h"
+#include "openfpga_memory_usage.h"
 #include "vtr_assert.h"
 
 /* begin namespace openfpga */
@@ -19,12 +22,16 @@ FabricBitstream::FabricBitstream() {
   invalid_bit_ids_.clear();
   address_length_ = 0;
   wl_address_length_ = 0;
+  address_stride_ = 0;
+  wl_address_stride_ = 0;
 
   num_regions_ = 0;
   invalid_region_ids_.clear();
 
   use_address_ = false;
   use_wl_address_ = false;
+
+  clear_bit_value_stats();
 }
 
 /**************************************************
@@ -39,6 +46,12 @@ FabricBitstream::fabric_bit_range FabricBitstream::bits() const {
     fabric_bit_iterator(FabricBitId(num_bits_), invalid_bit_ids_));
 }
 
+FabricBitstream::fabric_bit_dense_range FabricBitstream::dense_bits() const {
+  VTR_ASSERT(true == invalid_bit_ids_.empty());
+  return vtr::make_range(fabric_bit_dense_iterator(FabricBitId(0)),
+                         fabric_bit_dense_iterator(FabricBitId(num_bits_)));
+}
+
 size_t FabricBitstream::num_regions() const { return num_regions_; }
 
 /* Find all the configuration bits */
@@ -49,7 +62,7 @@ FabricBitstream::fabric_bit_region_range FabricBitstream::regions() const {
                                invalid_region_ids_));
 }
 
-std::vector<FabricBitId> FabricBitstream::region_bits(
+const std::vector<FabricBitId>& FabricBitstream::region_bits(
   const FabricBitRegionId& region_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_region_id(region_id));
@@ -73,20 +86,9 @@ std::vector<char> FabricBitstream::bit_address(
   VTR_ASSERT(true == valid_bit_id(bit_id));
   VTR_ASSERT(true == use_address_);
 
-  /* Decode address bits */
-  std::vector<char> addr_bits;
-  addr_bits.reserve(address_length_);
-  for (size_t curr_idx = 0; curr_idx < bit_address_1bits_[bit_id].size();
-       curr_idx++) {
-    size_t curr_addr_len =
-      std::min(size_t(64), address_length_ - curr_idx * 64);
-    std::vector<char> curr_addr_vec =
-      decode_address_bits(bit_address_1bits_[bit_id][curr_idx],
-                          bit_address_xbits_[bit_id][curr_idx], curr_addr_len);
-    addr_bits.insert(addr_bits.end(), curr_addr_vec.begin(),
-                     curr_addr_vec.end());
-  }
-  return addr_bits;
+  return pool_address(bit_id, bit_address_1bits_, bit_address_xbits_,
+                      bit_address_num_words_, address_stride_,
+                      address_length_);
 }
 
 std::vector<char> FabricBitstream::bit_bl_address(
@@ -101,20 +103,41 @@ std::vector<char> FabricBitstream::bit_wl_address(
   VTR_ASSERT(true == use_address_);
   VTR_ASSERT(true == use_wl_address_);
 
-  /* Decode address bits */
-  std::vector<char> addr_bits;
-  addr_bits.reserve(wl_address_length_);
-  for (size_t curr_idx = 0; curr_idx < bit_wl_address_1bits_[bit_id].size();
-       curr_idx++) {
-    size_t curr_addr_len =
-      std::min(size_t(64), wl_address_length_ - curr_idx * 64);
-    std::vector<char> curr_addr_vec = decode_address_bits(
-      bit_wl_address_1bits_[bit_id][curr_idx],
-      bit_wl_address_xbits_[bit_id][curr_idx], curr_addr_len);
-    addr_bits.insert(addr_bits.end(), curr_addr_vec.begin(),
-                     curr_addr_vec.end());
-  }
-  return addr_bits;
+  return pool_address(bit_id, bit_wl_address_1bits_, bit_wl_address_xbits_,
+                      bit_wl_address_num_words_, wl_address_stride_,
+                      wl_address_length_);
+}
+
+size_t FabricBitstream::bit_address_words(
+  const FabricBitId& bit_id, std::vector<uint64_t>& words_1,
+  std::vector<uint64_t>& words_x) const {
+  /* Ensure a valid id */
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == use_address_);
+
+  return pool_address_words(bit_id, bit_address_1bits_, bit_address_xbits_,
+                            bit_address_num_words_, address_stride_,
+                            address_length_, words_1, words_x);
+}
+
+size_t FabricBitstream::bit_bl_address_words(
+  const FabricBitId& bit_id, std::vector<uint64_t>& words_1,
+  std::vector<uint64_t>& words_x) const {
+  return bit_address_words(bit_id, words_1, words_x);
+}
+
+size_t FabricBitstream::bit_wl_address_words(
+  const FabricBitId& bit_id, std::vector<uint64_t>& words_1,
+  std::vector<uint64_t>& words_x) const {
+  /* Ensure a valid id */
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == use_address_);
+  VTR_ASSERT(true == use_wl_address_);
+
+  return pool_address_words(bit_id, bit_wl_address_1bits_,
+                            bit_wl_address_xbits_, bit_wl_address_num_words_,
+                            wl_address_stride_, wl_address_length_, words_1,
+                            words_x);
 }
 
 char FabricBitstream::bit_din(const FabricBitId& bit_id) const {
@@ -129,38 +152,93 @@ bool FabricBitstream::use_address() const { return use_address_; }
 
 bool FabricBitstream::use_wl_address() const { return use_wl_address_; }
 
+size_t FabricBitstream::address_length() const { return address_length_; }
+
+size_t FabricBitstream::wl_address_length() const {
+  return wl_address_length_;
+}
+
+/* Estimate the memory used by the fabric bitstream, in bytes */
+size_t FabricBitstream::memory_usage() const {
+  return sizeof(FabricBitstream) + heap_memory_usage(invalid_region_ids_) +
+         heap_memory_usage(region_bit_ids_) +
+         heap_memory_usage(invalid_bit_ids_) +
+         heap_memory_usage(config_bit_ids_) +
+         heap_memory_usage(bit_address_1bits_) +
+         heap_memory_usage(bit_address_xbits_) +
+         heap_memory_usage(bit_address_num_words_) +
+         heap_memory_usage(bit_wl_address_1bits_) +
+         heap_memory_usage(bit_wl_address_xbits_) +
+         heap_memory_usage(bit_wl_address_num_words_) +
+         heap_memory_usage(bit_dins_) +
+         heap_memory_usage(region_num_leading_bits_of_value_);
+}
+
+bool FabricBitstream::has_bit_value_stats() const {
+  return has_bit_value_stats_;
+}
+
+size_t FabricBitstream::num_bits_of_value(const bool& bit_value) const {
+  VTR_ASSERT(true == has_bit_value_stats_);
+  return num_bits_of_value_[size_t(bit_value)];
+}
+
+size_t FabricBitstream::num_leading_bits_of_value(const bool& bit_value) const {
+  VTR_ASSERT(true == has_bit_value_stats_);
+  return num_leading_bits_of_value_[size_t(bit_value)];
+}
+
+size_t FabricBitstream::region_num_leading_bits_of_value(
+  const FabricBitRegionId& region_id, const bool& bit_value) const {
+  VTR_ASSERT(true == has_bit_value_stats_);
+  VTR_ASSERT(true == valid_region_id(region_id));
+  return region_num_leading_bits_of_value_[region_id][size_t(bit_value)];
+}
+
+size_t FabricBitstream::region_max_num_bits() const {
+  VTR_ASSERT(true == has_bit_value_stats_);
+  return region_max_num_bits_;
+}
+
+size_t FabricBitstream::database_stamp() const { return database_stamp_; }
+
+size_t FabricBitstream::database_update_generation() const {
+  return database_update_generation_;
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
 void FabricBitstream::reserve_bits(const size_t& num_bits) {
   config_bit_ids_.reserve(num_bits);
 
+  /* Only the bit-one pools are reserved, as the others are optional */
   if (true == use_address_) {
-    bit_address_1bits_.reserve(num_bits);
-    bit_address_xbits_.reserve(num_bits);
+    bit_address_1bits_.reserve(num_bits * address_stride_);
     bit_dins_.reserve(num_bits);
 
     if (true == use_wl_address_) {
-      bit_wl_address_1bits_.reserve(num_bits);
-      bit_wl_address_xbits_.reserve(num_bits);
+      bit_wl_address_1bits_.reserve(num_bits * wl_address_stride_);
     }
   }
 }
 
 FabricBitId FabricBitstream::add_bit(const ConfigBitId& config_bit_id) {
+  clear_bit_value_stats();
+
   FabricBitId bit = FabricBitId(num_bits_);
   /* Add a new bit, and allocate associated data structures */
   num_bits_++;
   config_bit_ids_.push_back(config_bit_id);
 
   if (true == use_address_) {
-    bit_address_1bits_.emplace_back();
-    bit_address_xbits_.emplace_back();
+    add_pool_address(bit_address_1bits_, bit_address_xbits_,
+                     bit_address_num_words_, address_stride_);
     bit_dins_.emplace_back();
 
     if (true == use_wl_address_) {
-      bit_wl_address_1bits_.emplace_back();
-      bit_wl_address_xbits_.emplace_back();
+      add_pool_address(bit_wl_address_1bits_, bit_wl_address_xbits_,
+                       bit_wl_address_num_words_, wl_address_stride_);
     }
   }
 
@@ -177,16 +255,8 @@ void FabricBitstream::set_bit_address(const FabricBitId& bit_id,
   } else {
     VTR_ASSERT(address_length_ == address.size());
   }
-  /* Split the address into several 64 vectors */
-  for (size_t start_idx = 0; start_idx < address.size();
-       start_idx = start_idx + 64) {
-    size_t curr_end_idx = std::min(address.size(), start_idx + 64);
-    std::vector<char> curr_addr_vec64(address.begin() + start_idx,
-                                      address.begin() + curr_end_idx);
-    /* Encode bit '1' and bit 'x' into two numbers */
-    bit_address_1bits_[bit_id].push_back(encode_address_1bits(curr_addr_vec64));
-    bit_address_xbits_[bit_id].push_back(encode_address_xbits(curr_addr_vec64));
-  }
+  set_pool_address(bit_id, address, bit_address_1bits_, bit_address_xbits_,
+                   bit_address_num_words_, address_stride_);
 }
 
 void FabricBitstream::set_bit_bl_address(const FabricBitId& bit_id,
@@ -206,18 +276,9 @@ void FabricBitstream::set_bit_wl_address(const FabricBitId& bit_id,
   } else {
     VTR_ASSERT(wl_address_length_ == address.size());
   }
-  /* Split the address into several 64 vectors */
-  for (size_t start_idx = 0; start_idx < address.size();
-       start_idx = start_idx + 64) {
-    size_t curr_end_idx = std::min(address.size(), start_idx + 64);
-    std::vector<char> curr_addr_vec64(address.begin() + start_idx,
-                                      address.begin() + curr_end_idx);
-    /* Encode bit '1' and bit 'x' into two numbers */
-    bit_wl_address_1bits_[bit_id].push_back(
-      encode_address_1bits(curr_addr_vec64));
-    bit_wl_address_xbits_[bit_id].push_back(
-      encode_address_xbits(curr_addr_vec64));
-  }
+  set_pool_address(bit_id, address, bit_wl_address_1bits_,
+                   bit_wl_address_xbits_, bit_wl_address_num_words_,
+                   wl_address_stride_);
 }
 
 void FabricBitstream::set_bit_din(const FabricBitId& bit_id, const char& din) {
@@ -234,8 +295,10 @@ void FabricBitstream::set_use_address(const bool& enable) {
 }
 
 void FabricBitstream::set_address_length(const size_t& length) {
-  if (true == use_address_) {
+  /* Add a lock, only can be modified when num bits are zero*/
+  if ((true == use_address_) && (0 == num_bits_)) {
     address_length_ = length;
+    address_stride_ = num_address_words(length);
   }
 }
 
@@ -251,8 +314,10 @@ void FabricBitstream::set_use_wl_address(const bool& enable) {
 }
 
 void FabricBitstream::set_wl_address_length(const size_t& length) {
-  if (true == use_address_) {
+  /* Add a lock, only can be modified when num bits are zero*/
+  if ((true == use_address_) && (0 == num_bits_)) {
     wl_address_length_ = length;
+    wl_address_stride_ = num_address_words(length);
   }
 }
 
@@ -261,6 +326,8 @@ void FabricBitstream::reserve_regions(const size_t& num_regions) {
 }
 
 FabricBitRegionId FabricBitstream::add_region() {
+  clear_bit_value_stats();
+
   FabricBitRegionId region = FabricBitRegionId(num_regions_);
   /* Add a new bit, and allocate associated data structures */
   num_regions_++;
@@ -274,20 +341,68 @@ void FabricBitstream::add_bit_to_region(const FabricBitRegionId& region_id,
   VTR_ASSERT(true == valid_region_id(region_id));
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
+  clear_bit_value_stats();
   region_bit_ids_[region_id].push_back(bit_id);
 }
 
 void FabricBitstream::reverse() {
+  clear_bit_value_stats();
+
   std::reverse(config_bit_ids_.begin(), config_bit_ids_.end());
 
   if (true == use_address_) {
-    std::reverse(bit_address_1bits_.begin(), bit_address_1bits_.end());
-    std::reverse(bit_address_xbits_.begin(), bit_address_xbits_.end());
+    reverse_pool_addresses(bit_address_1bits_, address_stride_);
+    reverse_pool_addresses(bit_address_xbits_, address_stride_);
+    std::reverse(bit_address_num_words_.begin(), bit_address_num_words_.end());
     std::reverse(bit_dins_.begin(), bit_dins_.end());
 
     if (true == use_wl_address_) {
-      std::reverse(bit_wl_address_1bits_.begin(), bit_wl_address_1bits_.end());
-      std::reverse(bit_wl_address_xbits_.begin(), bit_wl_address_xbits_.end());
+      reverse_pool_addresses(bit_wl_address_1bits_, wl_address_stride_);
+      reverse_pool_addresses(bit_wl_address_xbits_, wl_address_stride_);
+      std::reverse(bit_wl_address_num_words_.begin(),
+                   bit_wl_address_num_words_.end());
+    }
+  }
+}
+
+void FabricBitstream::append(const FabricBitstream& other) {
+  VTR_ASSERT(use_address_ == other.use_address_);
+  VTR_ASSERT(use_wl_address_ == other.use_wl_address_);
+  VTR_ASSERT(address_length_ == other.address_length_);
+  VTR_ASSERT(wl_address_length_ == other.wl_address_length_);
+  VTR_ASSERT(true == other.invalid_bit_ids_.empty());
+
+  clear_bit_value_stats();
+
+  size_t bit_offset = num_bits_;
+  for (const FabricBitId& bit : other.dense_bits()) {
+    config_bit_ids_.push_back(other.config_bit_ids_[bit]);
+  }
+
+  if (true == use_address_) {
+    append_pool_addresses(bit_address_1bits_, bit_address_xbits_,
+                          bit_address_num_words_, other.bit_address_1bits_,
+                          other.bit_address_xbits_,
+                          other.bit_address_num_words_, other.num_bits_,
+                          address_stride_);
+    for (const FabricBitId& bit : other.dense_bits()) {
+      bit_dins_.push_back(other.bit_dins_[bit]);
+    }
+
+    if (true == use_wl_address_) {
+      append_pool_addresses(
+        bit_wl_address_1bits_, bit_wl_address_xbits_, bit_wl_address_num_words_,
+        other.bit_wl_address_1bits_, other.bit_wl_address_xbits_,
+        other.bit_wl_address_num_words_, other.num_bits_, wl_address_stride_);
+    }
+  }
+  num_bits_ += other.num_bits_;
+
+  for (const FabricBitRegionId& other_region : other.regions()) {
+    FabricBitRegionId region = add_region();
+    region_bit_ids_[region].reserve(other.region_bits(other_region).size());
+    for (const FabricBitId& bit : other.region_bits(other_region)) {
+      region_bit_ids_[region].push_back(FabricBitId(bit_offset + size_t(bit)));
     }
   }
 }
@@ -295,10 +410,60 @@ void FabricBitstream::reverse() {
 void FabricBitstream::reverse_region_bits(const FabricBitRegionId& region_id) {
   VTR_ASSERT(true == valid_region_id(region_id));
 
+  clear_bit_value_stats();
   std::reverse(region_bit_ids_[region_id].begin(),
                region_bit_ids_[region_id].end());
 }
 
+void FabricBitstream::build_bit_value_stats(
+  const BitstreamManager& bitstream_manager) {
+  clear_bit_value_stats();
+
+  /* Count the bits of each value, and the leading bits of the first value
+   * until the other value is met */
+  bool head = true;
+  for (const FabricBitId& bit : dense_bits()) {
+    bool bit_value = bitstream_manager.bit_value(config_bit_ids_[bit]);
+    num_bits_of_value_[size_t(bit_value)]++;
+    if ((true == head) && (0 < num_bits_of_value_[size_t(!bit_value)])) {
+      head = false;
+    }
+    if (true == head) {
+      num_leading_bits_of_value_[size_t(bit_value)]++;
+    }
+  }
+
+  region_num_leading_bits_of_value_.resize(num_regions_, {0, 0});
+  for (const FabricBitRegionId& region : regions()) {
+    const std::vector<FabricBitId>& curr_region_bits = region_bit_ids_[region];
+    region_max_num_bits_ =
+      std::max(region_max_num_bits_, curr_region_bits.size());
+    if (true == curr_region_bits.empty()) {
+      continue;
+    }
+    /* Only the value of the first bit can have leading bits */
+    bool first_value =
+      bitstream_manager.bit_value(config_bit_ids_[curr_region_bits.front()]);
+    size_t num_leading_bits = 0;
+    for (const FabricBitId& bit : curr_region_bits) {
+      if (first_value != bitstream_manager.bit_value(config_bit_ids_[bit])) {
+        break;
+      }
+      num_leading_bits++;
+    }
+    region_num_leading_bits_of_value_[region][size_t(first_value)] =
+      num_leading_bits;
+  }
+
+  has_bit_value_stats_ = true;
+}
+
+void FabricBitstream::set_database_version(const size_t& stamp,
+                                           const size_t& update_generation) {
+  database_stamp_ = stamp;
+  database_update_generation_ = update_generation;
+}
+
 /******************************************************************************
  * Public Validators
  ******************************************************************************/
@@ -311,48 +476,259 @@ bool FabricBitstream::valid_region_id(
   return (size_t(region_id) < num_regions_);
 }
 
-uint64_t FabricBitstream::encode_address_1bits(
-  const std::vector<char>& address) const {
-  /* Convert all the 'x' bit into 0 */
-  std::vector<char> binary_address = address;
-  for (char& bit : binary_address) {
-    if (bit == 'x') {
-      bit = '0';
+/******************************************************************************
+ * Private APIs: bit value statistics
+ ******************************************************************************/
+void FabricBitstream::clear_bit_value_stats() {
+  has_bit_value_stats_ = false;
+  num_bits_of_value_ = {0, 0};
+  num_leading_bits_of_value_ = {0, 0};
+  region_num_leading_bits_of_value_.clear();
+  region_max_num_bits_ = 0;
+}
+
+/******************************************************************************
+ * Address characters are encoded and decoded by groups of 8, which are
+ * packed into a 64-bit word, character i in byte i, so that the characters
+ * of a group are compared and produced together with word operations
+ * rather than one by one
+ ******************************************************************************/
+/* Each byte of a pattern of characters '0', '1' and 'x' */
+constexpr uint64_t ADDRESS_CHARS_0 = 0x3030303030303030ULL;
+constexpr uint64_t ADDRESS_CHARS_1 = 0x3131313131313131ULL;
+constexpr uint64_t ADDRESS_CHARS_X = 0x7878787878787878ULL;
+
+/* Spread the 8 bits of each byte value to the lowest bits of 8 bytes */
+static const std::array<uint64_t, 256>& address_byte_spread_table() {
+  static const std::array<uint64_t, 256> table = [] {
+    std::array<uint64_t, 256> spread;
+    for (size_t byte = 0; byte < spread.size(); ++byte) {
+      spread[byte] = 0;
+      for (size_t ibit = 0; ibit < 8; ++ibit) {
+        if (byte & (size_t(1) << ibit)) {
+          spread[byte] |= uint64_t(1) << (8 * ibit);
+        }
+      }
     }
+    return spread;
+  }();
+  return table;
+}
+
+/* Pack 8 characters into a word. Compilers turn it into a single load */
+static uint64_t load_address_chars(const char* chars) {
+  uint64_t word = 0;
+  for (size_t ichar = 0; ichar < 8; ++ichar) {
+    word |= uint64_t(static_cast<unsigned char>(chars[ichar])) << (8 * ichar);
+  }
+  return word;
+}
+
+static void store_address_chars(char* chars, const uint64_t& word,
+                                const size_t& num_chars) {
+  for (size_t ichar = 0; ichar < num_chars; ++ichar) {
+    chars[ichar] = static_cast<char>((word >> (8 * ichar)) & 0xff);
+  }
+}
+
+/* Set the highest bit of each byte of a word which equals the byte of a
+ * pattern. There is no carry between bytes, so that the result is exact */
+static uint64_t match_address_chars(const uint64_t& word,
+                                    const uint64_t& pattern) {
+  constexpr uint64_t LOW_7_BITS = 0x7f7f7f7f7f7f7f7fULL;
+  uint64_t diff = word ^ pattern;
+  return ~(((diff & LOW_7_BITS) + LOW_7_BITS) | diff | LOW_7_BITS);
+}
+
+/* Gather the highest bit of each byte into 8 bits, byte i into bit i */
+static uint64_t gather_address_chars(const uint64_t& mask) {
+  return ((mask >> 7) * 0x0102040810204080ULL) >> 56;
+}
+
+/* Encode up to 64 characters of an address into bits '1' and bits 'x' */
+static void encode_address_chars(const char* chars, const size_t& num_chars,
+                                 uint64_t& word_1bits, uint64_t& word_xbits) {
+  word_1bits = 0;
+  word_xbits = 0;
+  size_t ichar = 0;
+  for (; ichar + 8 <= num_chars; ichar += 8) {
+    uint64_t group = load_address_chars(chars + ichar);
+    word_1bits |=
+      gather_address_chars(match_address_chars(group, ADDRESS_CHARS_1))
+      << ichar;
+    word_xbits |=
+      gather_address_chars(match_address_chars(group, ADDRESS_CHARS_X))
+      << ichar;
+  }
+  for (; ichar < num_chars; ++ichar) {
+    if ('1' == chars[ichar]) {
+      word_1bits |= (uint64_t(1) << ichar);
+    } else if ('x' == chars[ichar]) {
+      word_xbits |= (uint64_t(1) << ichar);
+    }
+  }
+}
+
+/* Decode up to 64 characters of an address: 'x' overwrites any bit '0' and
+ * '1' */
+static void decode_address_chars(char* chars, const size_t& num_chars,
+                                 const uint64_t& word_1bits,
+                                 const uint64_t& word_xbits) {
+  const std::array<uint64_t, 256>& spread = address_byte_spread_table();
+  for (size_t ichar = 0; ichar < num_chars; ichar += 8) {
+    uint64_t group = ADDRESS_CHARS_0 | spread[(word_1bits >> ichar) & 0xff];
+    uint64_t mask_x = spread[(word_xbits >> ichar) & 0xff] * 0xff;
+    group = (group & ~mask_x) | (ADDRESS_CHARS_X & mask_x);
+    store_address_chars(chars + ichar, group,
+                        std::min(size_t(8), num_chars - ichar));
+  }
+}
+
+/******************************************************************************
+ * Private APIs: address pools
+ ******************************************************************************/
+size_t FabricBitstream::num_address_words(const size_t& addr_len) const {
+  return (addr_len + 63) / 64;
+}
+
+void FabricBitstream::add_pool_address(std::vector<uint64_t>& bits_1,
+                                       std::vector<uint64_t>& bits_x,
+                                       std::vector<uint16_t>& num_words,
+                                       const size_t& stride) const {
+  bits_1.resize(bits_1.size() + stride, 0);
+  /* Optional data is only allocated when it has been used */
+  if (false == bits_x.empty()) {
+    bits_x.resize(bits_x.size() + stride, 0);
+  }
+  if (false == num_words.empty()) {
+    num_words.push_back(stride);
   }
-  /* Convert the binary address to a number */
-  return (uint64_t)bintoi_charvec(binary_address);
 }
 
-uint64_t FabricBitstream::encode_address_xbits(
-  const std::vector<char>& address) const {
-  /* Convert all the '1' bit into 0 and Convert all the 'x' bit into 1 */
-  std::vector<char> binary_address = address;
-  for (char& bit : binary_address) {
-    if (bit == '1') {
-      bit = '0';
+void FabricBitstream::set_pool_address(const FabricBitId& bit_id,
+                                       const std::vector<char>& address,
+                                       std::vector<uint64_t>& bits_1,
+                                       std::vector<uint64_t>& bits_x,
+                                       std::vector<uint16_t>& num_words,
+                                       const size_t& stride) const {
+  size_t offset = size_t(bit_id) * stride;
+  /* Encode bit '1' and bit 'x' into two numbers for each 64 bits */
+  for (size_t iword = 0; iword < stride; ++iword) {
+    uint64_t word_1bits = 0;
+    uint64_t word_xbits = 0;
+    if (iword * 64 < address.size()) {
+      encode_address_chars(address.data() + iword * 64,
+                           std::min(size_t(64), address.size() - iword * 64),
+                           word_1bits, word_xbits);
     }
-    if (bit == 'x') {
-      bit = '1';
+    bits_1[offset + iword] = word_1bits;
+    if (false == bits_x.empty()) {
+      bits_x[offset + iword] = word_xbits;
+    } else if (0 != word_xbits) {
+      /* First don't care bit: allocate the pool for all the bits */
+      bits_x.reserve(bits_1.capacity());
+      bits_x.resize(bits_1.size(), 0);
+      bits_x[offset + iword] = word_xbits;
     }
   }
-  /* Convert the binary address to a number */
-  return (uint64_t)bintoi_charvec(binary_address);
+
+  /* A short address only occupies the words covering its length */
+  size_t curr_num_words = num_address_words(address.size());
+  if (true == num_words.empty() && curr_num_words != stride) {
+    VTR_ASSERT(stride <= std::numeric_limits<uint16_t>::max());
+    num_words.resize(num_bits_, stride);
+  }
+  if (false == num_words.empty()) {
+    num_words[size_t(bit_id)] = curr_num_words;
+  }
 }
 
-std::vector<char> FabricBitstream::decode_address_bits(
-  const size_t& bit1, const size_t& bitx, const size_t& addr_len) const {
-  /* Decode the bit1 number to a binary vector */
-  std::vector<char> ret_vec = itobin_charvec(bit1, addr_len);
-  /* Decode the bitx number to a binary vector */
-  std::vector<char> bitx_vec = itobin_charvec(bitx, addr_len);
-  /* Combine the two vectors: 'x' overwrite any bit '0' and '1' */
-  for (size_t ibit = 0; ibit < ret_vec.size(); ++ibit) {
-    if (bitx_vec[ibit] == '1') {
-      ret_vec[ibit] = 'x';
+std::vector<char> FabricBitstream::pool_address(
+  const FabricBitId& bit_id, const std::vector<uint64_t>& bits_1,
+  const std::vector<uint64_t>& bits_x, const std::vector<uint16_t>& num_words,
+  const size_t& stride, const size_t& addr_len) const {
+  size_t offset = size_t(bit_id) * stride;
+  size_t curr_num_words = stride;
+  if (false == num_words.empty()) {
+    curr_num_words = num_words[size_t(bit_id)];
+  }
+
+  /* Decode address bits: 'x' overwrite any bit '0' and '1' */
+  std::vector<char> addr_bits(std::min(addr_len, curr_num_words * 64));
+  for (size_t iword = 0; iword < curr_num_words; ++iword) {
+    size_t curr_addr_len = std::min(size_t(64), addr_len - iword * 64);
+    uint64_t word_1bits = bits_1[offset + iword];
+    uint64_t word_xbits = bits_x.empty() ? 0 : bits_x[offset + iword];
+    decode_address_chars(addr_bits.data() + iword * 64, curr_addr_len,
+                         word_1bits, word_xbits);
+  }
+  return addr_bits;
+}
+
+size_t FabricBitstream::pool_address_words(
+  const FabricBitId& bit_id, const std::vector<uint64_t>& bits_1,
+  const std::vector<uint64_t>& bits_x, const std::vector<uint16_t>& num_words,
+  const size_t& stride, const size_t& addr_len, std::vector<uint64_t>& words_1,
+  std::vector<uint64_t>& words_x) const {
+  size_t offset = size_t(bit_id) * stride;
+  size_t curr_num_words = stride;
+  if (false == num_words.empty()) {
+    curr_num_words = num_words[size_t(bit_id)];
+  }
+
+  words_1.assign(bits_1.begin() + offset,
+                 bits_1.begin() + offset + curr_num_words);
+  if (true == bits_x.empty()) {
+    words_x.clear();
+  } else {
+    words_x.assign(bits_x.begin() + offset,
+                   bits_x.begin() + offset + curr_num_words);
+  }
+  return std::min(addr_len, curr_num_words * 64);
+}
+
+void FabricBitstream::append_pool_addresses(
+  std::vector<uint64_t>& bits_1, std::vector<uint64_t>& bits_x,
+  std::vector<uint16_t>& num_words, const std::vector<uint64_t>& other_bits_1,
+  const std::vector<uint64_t>& other_bits_x,
+  const std::vector<uint16_t>& other_num_words, const size_t& num_other_bits,
+  const size_t& stride) const {
+  /* Optional data is allocated as soon as either pool has used it */
+  if ((true == bits_x.empty()) && (false == other_bits_x.empty())) {
+    bits_x.resize(bits_1.size(), 0);
+  }
+  if ((true == num_words.empty()) && (false == other_num_words.empty())) {
+    num_words.resize(num_bits_, stride);
+  }
+
+  bits_1.insert(bits_1.end(), other_bits_1.begin(), other_bits_1.end());
+  if (false == bits_x.empty()) {
+    if (true == other_bits_x.empty()) {
+      bits_x.resize(bits_1.size(), 0);
+    } else {
+      bits_x.insert(bits_x.end(), other_bits_x.begin(), other_bits_x.end());
+    }
+  }
+  if (false == num_words.empty()) {
+    if (true == other_num_words.empty()) {
+      num_words.resize(num_bits_ + num_other_bits, stride);
+    } else {
+      num_words.insert(num_words.end(), other_num_words.begin(),
+                       other_num_words.end());
     }
   }
-  return ret_vec;
+}
+
+void FabricBitstream::reverse_pool_addresses(std::vector<uint64_t>& pool,
+                                             const size_t& stride) const {
+  if (0 == stride) {
+    return;
+  }
+  /* Reverse the whole pool, and then restore the word order in each address */
+  std::reverse(pool.begin(), pool.end());
+  for (size_t offset = 0; offset < pool.size(); offset += stride) {
+    std::reverse(pool.begin() + offset, pool.begin() + offset + stride);
+  }
 }
 
 } /* end namespace openfpga */
@@ -30,12 +30,14 @@
 #ifndef FABRIC_BITSTREAM_H
 #define FABRIC_BITSTREAM_H
 
+#include <array>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "bitstream_manager_fwd.h"
 #include "fabric_bitstream_fwd.h"
+#include "openfpga_dense_id_iterator.h"
 #include "vtr_vector.h"
 
 /* begin namespace openfpga */
@@ -112,6 +114,8 @@ class FabricBitstream {
   typedef lazy_id_iterator<FabricBitRegionId> fabric_bit_region_iterator;
 
   typedef vtr::Range<fabric_bit_iterator> fabric_bit_range;
+  typedef dense_id_iterator<FabricBitId> fabric_bit_dense_iterator;
+  typedef vtr::Range<fabric_bit_dense_iterator> fabric_bit_dense_range;
   typedef vtr::Range<fabric_bit_region_iterator> fabric_bit_region_range;
 
  public: /* Public constructor */
@@ -121,11 +125,15 @@ class FabricBitstream {
   /* Find all the configuration bits */
   size_t num_bits() const;
   fabric_bit_range bits() const;
+  /* Find all the configuration bits, without checking invalid ids.
+   * Bits are never removed, so this is always safe and faster than bits()
+   */
+  fabric_bit_dense_range dense_bits() const;
 
   /* Find all the configuration regions */
   size_t num_regions() const;
   fabric_bit_region_range regions() const;
-  std::vector<FabricBitId> region_bits(
+  const std::vector<FabricBitId>& region_bits(
     const FabricBitRegionId& region_id) const;
 
  public: /* Public Accessors */
@@ -137,6 +145,21 @@ class FabricBitstream {
   std::vector<char> bit_bl_address(const FabricBitId& bit_id) const;
   std::vector<char> bit_wl_address(const FabricBitId& bit_id) const;
 
+  /* Find the address of bitstream as 64-bit words, without decoding it into
+   * characters: address bit i is bit (i % 64) of word (i / 64), in the words
+   * of bits '1' and in the words of don't care bits 'x'. The words of bits
+   * 'x' are empty when no address has a don't care bit.
+   * Return the length of the address, i.e., the size of bit_address() */
+  size_t bit_address_words(const FabricBitId& bit_id,
+                           std::vector<uint64_t>& words_1,
+                           std::vector<uint64_t>& words_x) const;
+  size_t bit_bl_address_words(const FabricBitId& bit_id,
+                              std::vector<uint64_t>& words_1,
+                              std::vector<uint64_t>& words_x) const;
+  size_t bit_wl_address_words(const FabricBitId& bit_id,
+                              std::vector<uint64_t>& words_1,
+                              std::vector<uint64_t>& words_x) const;
+
   /* Find the data-in of bitstream */
   char bit_din(const FabricBitId& bit_id) const;
 
@@ -144,6 +167,35 @@ class FabricBitstream {
   bool use_address() const;
   bool use_wl_address() const;
 
+  /* Find the (maximum) length of the addresses of bits */
+  size_t address_length() const;
+  size_t wl_address_length() const;
+
+  /* Estimate the memory used by the fabric bitstream, in bytes */
+  size_t memory_usage() const;
+
+  /* Statistics on the bit values, which are used by fast configuration.
+   * They are only available after build_bit_value_stats() is called,
+   * and are cleared by any mutator changing the sequence of bits
+   */
+  bool has_bit_value_stats() const;
+  /* Number of bits in the given value */
+  size_t num_bits_of_value(const bool& bit_value) const;
+  /* Number of bits in the given value at the head of the bitstream,
+   * i.e., before the first bit in the other value */
+  size_t num_leading_bits_of_value(const bool& bit_value) const;
+  /* Number of bits in the given value at the head of a region */
+  size_t region_num_leading_bits_of_value(const FabricBitRegionId& region_id,
+                                          const bool& bit_value) const;
+  /* Number of bits of the longest region */
+  size_t region_max_num_bits() const;
+
+  /* The stamp and the update generation of the bitstream database that the
+   * fabric bitstream is in sync with, see BitstreamManager::stamp() and
+   * BitstreamManager::update_generation(). The stamp is 0 if unknown */
+  size_t database_stamp() const;
+  size_t database_update_generation() const;
+
  public: /* Public Mutators */
   /* Reserve config bits */
   void reserve_bits(const size_t& num_bits);
@@ -182,12 +234,20 @@ class FabricBitstream {
    */
   void reverse();
 
+  /* Append the bits and regions of another fabric bitstream to the tail.
+   * The bit ids of the other fabric bitstream are shifted by the number of
+   * bits in this fabric bitstream, and its regions are added in sequence.
+   * Both fabric bitstreams must use the same address settings
+   */
+  void append(const FabricBitstream& other);
+
   /* Enable the use of address-related data
    * When this is enabled, data allocation will be applied to these data
    * and users can access/modify the data
    * Otherwise, it will NOT be allocated and accessible.
    *
-   * This function is only applicable before any bits are added
+   * These functions are only applicable before any bits are added,
+   * including the address lengths which size the address pools
    */
   void set_use_address(const bool& enable);
   void set_address_length(const size_t& length);
@@ -199,15 +259,65 @@ class FabricBitstream {
   void set_use_wl_address(const bool& enable);
   void set_wl_address_length(const size_t& length);
 
+  /* Count the bit values of the whole bitstream and each region in one pass,
+   * using the values of the bitstream database.
+   * Must be called again after the bit values of the database are changed
+   */
+  void build_bit_value_stats(const BitstreamManager& bitstream_manager);
+
+  /* Record the version of the bitstream database that the fabric bitstream
+   * is built from or updated with */
+  void set_database_version(const size_t& stamp,
+                            const size_t& update_generation);
+
  public: /* Public Validators */
   bool valid_bit_id(const FabricBitId& bit_id) const;
   bool valid_region_id(const FabricBitRegionId& bit_id) const;
 
  private: /* Private APIs */
-  uint64_t encode_address_1bits(const std::vector<char>& address) const;
-  uint64_t encode_address_xbits(const std::vector<char>& address) const;
-  std::vector<char> decode_address_bits(const size_t& bit1, const size_t& bitx,
-                                        const size_t& addr_len) const;
+  /* Invalidate the statistics on the bit values */
+  void clear_bit_value_stats();
+  /* Number of 64-bit words required to encode an address */
+  size_t num_address_words(const size_t& addr_len) const;
+  /* Allocate the (all-zero) address of a new bit in an address pool */
+  void add_pool_address(std::vector<uint64_t>& bits_1,
+                        std::vector<uint64_t>& bits_x,
+                        std::vector<uint16_t>& num_words,
+                        const size_t& stride) const;
+  /* Encode an address of a bit into an address pool */
+  void set_pool_address(const FabricBitId& bit_id,
+                        const std::vector<char>& address,
+                        std::vector<uint64_t>& bits_1,
+                        std::vector<uint64_t>& bits_x,
+                        std::vector<uint16_t>& num_words,
+                        const size_t& stride) const;
+  /* Decode the address of a bit from an address pool */
+  std::vector<char> pool_address(const FabricBitId& bit_id,
+                                 const std::vector<uint64_t>& bits_1,
+                                 const std::vector<uint64_t>& bits_x,
+                                 const std::vector<uint16_t>& num_words,
+                                 const size_t& stride,
+                                 const size_t& addr_len) const;
+  /* Copy the words of the address of a bit from an address pool */
+  size_t pool_address_words(const FabricBitId& bit_id,
+                            const std::vector<uint64_t>& bits_1,
+                            const std::vector<uint64_t>& bits_x,
+                            const std::vector<uint16_t>& num_words,
+                            const size_t& stride, const size_t& addr_len,
+                            std::vector<uint64_t>& words_1,
+                            std::vector<uint64_t>& words_x) const;
+  /* Append the addresses of another address pool to an address pool */
+  void append_pool_addresses(std::vector<uint64_t>& bits_1,
+                             std::vector<uint64_t>& bits_x,
+                             std::vector<uint16_t>& num_words,
+                             const std::vector<uint64_t>& other_bits_1,
+                             const std::vector<uint64_t>& other_bits_x,
+                             const std::vector<uint16_t>& other_num_words,
+                             const size_t& num_other_bits,
+                             const size_t& stride) const;
+  /* Reverse the sequence of addresses in an address pool */
+  void reverse_pool_addresses(std::vector<uint64_t>& pool,
+                              const size_t& stride) const;
 
  private: /* Internal data */
   /* Unique id of a region in the Bitstream */
@@ -242,14 +352,41 @@ class FabricBitstream {
    *
    * Note that when the length of address vector is more than 64, we use
    * multiple 64-bit data to store the encoded values
+   *
+   * Since the address length is fixed before any bit is added, the
+   * encoded values of all the bits are packed into a single pool
+   * with a fixed stride, i.e., the words of bit i are stored in
+   * [i * stride, (i + 1) * stride). Two compressions are applied:
+   * - The bit-x pool is allocated only when the first address containing
+   *   a don't care bit is added, and it is empty otherwise.
+   *   Most protocols use fully encoded addresses, which never need it.
+   * - The number of words actually set for each bit is only stored when
+   *   the first short address is added, and it is empty otherwise.
    */
-  vtr::vector<FabricBitId, std::vector<uint64_t>> bit_address_1bits_;
-  vtr::vector<FabricBitId, std::vector<uint64_t>> bit_address_xbits_;
-  vtr::vector<FabricBitId, std::vector<uint64_t>> bit_wl_address_1bits_;
-  vtr::vector<FabricBitId, std::vector<uint64_t>> bit_wl_address_xbits_;
+  size_t address_stride_;
+  size_t wl_address_stride_;
+  std::vector<uint64_t> bit_address_1bits_;
+  std::vector<uint64_t> bit_address_xbits_;
+  std::vector<uint16_t> bit_address_num_words_;
+  std::vector<uint64_t> bit_wl_address_1bits_;
+  std::vector<uint64_t> bit_wl_address_xbits_;
+  std::vector<uint16_t> bit_wl_address_num_words_;
 
   /* Data input (Din) bits: this is designed for memory decoders */
   vtr::vector<FabricBitId, char> bit_dins_;
+
+  /* Statistics on the bit values, indexed by the bit value [0|1] */
+  bool has_bit_value_stats_;
+  std::array<size_t, 2> num_bits_of_value_;
+  std::array<size_t, 2> num_leading_bits_of_value_;
+  vtr::vector<FabricBitRegionId, std::array<size_t, 2>>
+    region_num_leading_bits_of_value_;
+  size_t region_max_num_bits_;
+
+  /* Version of the bitstream database that the fabric bitstream is in sync
+   * with */
+  size_t database_stamp_ = 0;
+  size_t database_update_generation_ = 0;
 };
 
 } /* end namespace openfpga */
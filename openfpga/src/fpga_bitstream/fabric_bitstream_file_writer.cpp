@@ -0,0 +1,185 @@
+/******************************************************************************
+ * This file includes member functions for data structure
+ * FabricBitstreamFileWriter
+ ******************************************************************************/
+#include "fabric_bitstream_file_writer.h"
+
+#include "vtr_assert.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr const char* FabricBitstreamFileWriter::BINARY_MAGIC;
+constexpr uint32_t FabricBitstreamFileWriter::BINARY_VERSION;
+
+/**************************************************
+ * Public Constructors
+ *************************************************/
+FabricBitstreamFileWriter::FabricBitstreamFileWriter(std::fstream& fp,
+                                                     const bool& binary,
+                                                     const bool& hex)
+  : fp_(fp),
+    binary_(binary),
+    hex_(hex),
+    byte_(0),
+    num_byte_bits_(0),
+    num_row_bits_(0) {
+  VTR_ASSERT(!(binary_ && hex_));
+}
+
+/**************************************************
+ * Public Accessors
+ *************************************************/
+bool FabricBitstreamFileWriter::binary() const { return binary_; }
+
+bool FabricBitstreamFileWriter::hex() const { return hex_; }
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
+void FabricBitstreamFileWriter::write_comment(const std::string& comment) {
+  if (binary_) {
+    return;
+  }
+  fp_ << comment << '\n';
+}
+
+/* The header is organized as follows, where all the integers are
+ * unsigned and in little endian
+ *   <magic 4 bytes><version 4 bytes>
+ *   <config protocol 4 bytes><bl protocol 4 bytes><wl protocol 4 bytes>
+ *   <reserved 4 bytes>
+ *   <num_regions 8 bytes><num_rows 8 bytes><num_skipped_rows 8 bytes>
+ *   <address_width 8 bytes><bl_address_width 8 bytes>
+ *   <wl_address_width 8 bytes><din_width 8 bytes>
+ *   <bl_word_size 8 bytes><wl_word_size 8 bytes>
+ */
+void FabricBitstreamFileWriter::write_header(
+  const ConfigProtocol& config_protocol,
+  const FabricBitstreamFileHeader& header) {
+  if (!binary_) {
+    return;
+  }
+  fp_.write(BINARY_MAGIC, 4);
+  write_binary_uint(BINARY_VERSION, 4);
+  write_binary_uint(config_protocol.type(), 4);
+  write_binary_uint(config_protocol.bl_protocol_type(), 4);
+  write_binary_uint(config_protocol.wl_protocol_type(), 4);
+  write_binary_uint(0, 4);
+  write_binary_uint(header.num_regions, 8);
+  write_binary_uint(header.num_rows, 8);
+  write_binary_uint(header.num_skipped_rows, 8);
+  write_binary_uint(header.address_width, 8);
+  write_binary_uint(header.bl_address_width, 8);
+  write_binary_uint(header.wl_address_width, 8);
+  write_binary_uint(header.din_width, 8);
+  write_binary_uint(header.bl_word_size, 8);
+  write_binary_uint(header.wl_word_size, 8);
+}
+
+void FabricBitstreamFileWriter::write_bit(const bool& bit) {
+  if (binary_) {
+    add_binary_bit(bit);
+  } else if (hex_) {
+    hex_row_bits_.push_back(bit);
+    num_row_bits_++;
+  } else {
+    fp_ << (bit ? '1' : '0');
+    num_row_bits_++;
+  }
+}
+
+void FabricBitstreamFileWriter::write_bits(const std::string& bits) {
+  if (binary_) {
+    for (const char& bit : bits) {
+      add_binary_bit('1' == bit);
+    }
+  } else if (hex_) {
+    for (const char& bit : bits) {
+      hex_row_bits_.push_back('1' == bit);
+    }
+    num_row_bits_ += bits.size();
+  } else {
+    fp_ << bits;
+    num_row_bits_ += bits.size();
+  }
+}
+
+void FabricBitstreamFileWriter::write_bits(const std::vector<bool>& bits) {
+  for (const bool& bit : bits) {
+    write_bit(bit);
+  }
+}
+
+void FabricBitstreamFileWriter::end_row() {
+  if (binary_) {
+    /* Pad the row to a byte boundary */
+    if (0 < num_byte_bits_) {
+      fp_.put(static_cast<char>(byte_));
+      byte_ = 0;
+      num_byte_bits_ = 0;
+    }
+  } else if (hex_) {
+    write_hex_row();
+    fp_ << '\n';
+  } else {
+    fp_ << '\n';
+  }
+  num_row_bits_ = 0;
+}
+
+void FabricBitstreamFileWriter::end_file() {
+  if (binary_) {
+    if (0 < num_row_bits_) {
+      end_row();
+    }
+    return;
+  }
+  end_row();
+}
+
+/**************************************************
+ * Internal Mutators
+ *************************************************/
+void FabricBitstreamFileWriter::add_binary_bit(const bool& bit) {
+  VTR_ASSERT_SAFE(binary_);
+  if (bit) {
+    byte_ |= static_cast<unsigned char>(1 << num_byte_bits_);
+  }
+  num_byte_bits_++;
+  num_row_bits_++;
+  if (8 == num_byte_bits_) {
+    fp_.put(static_cast<char>(byte_));
+    byte_ = 0;
+    num_byte_bits_ = 0;
+  }
+}
+
+/* Each group of 4 bits, counted from the end of the row, is a hexadecimal
+ * digit, where the first bit of the group is the most significant */
+void FabricBitstreamFileWriter::write_hex_row() {
+  VTR_ASSERT_SAFE(hex_);
+  static const char* hex_digits = "0123456789abcdef";
+  size_t num_pad_bits = (4 - hex_row_bits_.size() % 4) % 4;
+  unsigned digit = 0;
+  size_t num_digit_bits = num_pad_bits;
+  for (const bool& bit : hex_row_bits_) {
+    digit = (digit << 1) | (bit ? 1 : 0);
+    num_digit_bits++;
+    if (4 == num_digit_bits) {
+      fp_ << hex_digits[digit];
+      digit = 0;
+      num_digit_bits = 0;
+    }
+  }
+  hex_row_bits_.clear();
+}
+
+void FabricBitstreamFileWriter::write_binary_uint(const uint64_t& value,
+                                                  const size_t& num_bytes) {
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    fp_.put(static_cast<char>((value >> (8 * ibyte)) & 0xff));
+  }
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,107 @@
+#ifndef FABRIC_BITSTREAM_FILE_WRITER_H
+#define FABRIC_BITSTREAM_FILE_WRITER_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "config_protocol.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Information required by a bitstream downloader to interpret the rows
+ * of a fabric bitstream in binary format.
+ * Fields which are not applicable to a configuration protocol are zero.
+ *******************************************************************/
+struct FabricBitstreamFileHeader {
+  size_t num_regions = 0;
+  size_t num_rows = 0;
+  /* Number of rows skipped by fast configuration */
+  size_t num_skipped_rows = 0;
+  /* Address width of frame-based protocol */
+  size_t address_width = 0;
+  size_t bl_address_width = 0;
+  size_t wl_address_width = 0;
+  size_t din_width = 0;
+  /* Word sizes of shift-register banks */
+  size_t bl_word_size = 0;
+  size_t wl_word_size = 0;
+};
+
+/********************************************************************
+ * A streaming writer for the rows of a fabric bitstream file, which
+ * hides the difference between the plain text and binary formats
+ * - In plain text, each bit is a '0'|'1'|'x' character and each row
+ *   ends with a new line. Comments are written as they are.
+ * - In hex, which is a plain text to be loaded by $readmemh, each row is
+ *   a hexadecimal number whose most significant bit is the first bit of
+ *   the row, i.e., the row is padded with zeros at the beginning to a
+ *   multiple of 4 bits. Comments are written as they are, and don't care
+ *   bits are written as '0'.
+ * - In binary, a fixed-size header (see write_header()) is followed by
+ *   the rows, where each row is packed LSB first into bytes and padded
+ *   with zeros to a byte boundary. Comments are not written, and
+ *   don't care bits are written as '0'.
+ * The writer never flushes the file stream by itself, so that the
+ * output is fully buffered by the stream
+ *******************************************************************/
+class FabricBitstreamFileWriter {
+ public: /* Public constants */
+  /* Magic number and version at the beginning of a binary file */
+  static constexpr const char* BINARY_MAGIC = "OFBS";
+  static constexpr uint32_t BINARY_VERSION = 1;
+
+ public: /* Constructors */
+  FabricBitstreamFileWriter(std::fstream& fp, const bool& binary,
+                            const bool& hex);
+
+ public: /* Public accessors */
+  bool binary() const;
+  bool hex() const;
+
+ public: /* Public mutators */
+  /* Write a comment line, which is skipped in binary format */
+  void write_comment(const std::string& comment);
+  /* Write the header, which is only available in binary format */
+  void write_header(const ConfigProtocol& config_protocol,
+                    const FabricBitstreamFileHeader& header);
+  void write_bit(const bool& bit);
+  /* Write a string of '0'|'1'|'x' characters */
+  void write_bits(const std::string& bits);
+  void write_bits(const std::vector<bool>& bits);
+  void end_row();
+  /* Finish the file, including the last row if it is not ended yet.
+   * In plain text, a new line is always added at the end of the file */
+  void end_file();
+
+ private: /* Internal mutators */
+  /* Add a bit to the current row in binary format */
+  void add_binary_bit(const bool& bit);
+  /* Write an unsigned integer in little endian */
+  void write_binary_uint(const uint64_t& value, const size_t& num_bytes);
+  /* Write the current row as a hexadecimal number in hex format */
+  void write_hex_row();
+
+ private: /* Internal data */
+  std::fstream& fp_;
+  bool binary_;
+  bool hex_;
+  /* Byte under construction in binary format and the number of bits in it */
+  unsigned char byte_;
+  size_t num_byte_bits_;
+  /* Number of bits written to the current row */
+  size_t num_row_bits_;
+  /* Bits of the current row in hex format, which can only be converted
+   * when the row ends */
+  std::vector<bool> hex_row_bits_;
+};
+
+} /* end namespace openfpga */
+
+#endif
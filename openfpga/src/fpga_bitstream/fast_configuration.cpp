@@ -75,14 +75,20 @@ bool find_bit_value_to_skip_for_fast_configuration(
   size_t num_ones_to_skip = 0;
   size_t num_zeros_to_skip = 0;
 
-  /* Branch on the type of configuration protocol */
+  /* Branch on the type of configuration protocol.
+   * Use the statistics of the fabric bitstream when they are available */
   switch (config_protocol_type) {
     case CONFIG_MEM_STANDALONE:
       break;
     case CONFIG_MEM_SCAN_CHAIN: {
+      if (true == fabric_bitstream.has_bit_value_stats()) {
+        num_ones_to_skip = fabric_bitstream.num_leading_bits_of_value(true);
+        num_zeros_to_skip = fabric_bitstream.num_leading_bits_of_value(false);
+        break;
+      }
       /* We can only skip the ones/zeros at the beginning of the bitstream */
       /* Count how many logic '1' bits we can skip */
-      for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+      for (const FabricBitId& bit_id : fabric_bitstream.dense_bits()) {
         if (false ==
             bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
           break;
@@ -92,7 +98,7 @@ bool find_bit_value_to_skip_for_fast_configuration(
         num_ones_to_skip++;
       }
       /* Count how many logic '0' bits we can skip */
-      for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+      for (const FabricBitId& bit_id : fabric_bitstream.dense_bits()) {
         if (true ==
             bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
           break;
@@ -106,8 +112,13 @@ bool find_bit_value_to_skip_for_fast_configuration(
     case CONFIG_MEM_QL_MEMORY_BANK:
     case CONFIG_MEM_MEMORY_BANK:
     case CONFIG_MEM_FRAME_BASED: {
+      if (true == fabric_bitstream.has_bit_value_stats()) {
+        num_ones_to_skip = fabric_bitstream.num_bits_of_value(true);
+        num_zeros_to_skip = fabric_bitstream.num_bits_of_value(false);
+        break;
+      }
       /* Count how many logic '1' and logic '0' bits we can skip */
-      for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
+      for (const FabricBitId& bit_id : fabric_bitstream.dense_bits()) {
         if (false ==
             bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
           num_zeros_to_skip++;
@@ -29,7 +29,7 @@ size_t MemoryBankFlattenFabricBitstream::wl_vector_size() const {
   return wl_vec_size;
 }
 
-std::vector<std::string> MemoryBankFlattenFabricBitstream::bl_vector(
+const std::vector<std::string>& MemoryBankFlattenFabricBitstream::bl_vector(
   const std::vector<std::string>& wl_vec) const {
   return bitstream_.at(wl_vec);
 }
@@ -43,6 +43,16 @@ MemoryBankFlattenFabricBitstream::wl_vectors() const {
   return wl_vecs;
 }
 
+MemoryBankFlattenFabricBitstream::blwl_iterator
+MemoryBankFlattenFabricBitstream::begin() const {
+  return bitstream_.begin();
+}
+
+MemoryBankFlattenFabricBitstream::blwl_iterator
+MemoryBankFlattenFabricBitstream::end() const {
+  return bitstream_.end();
+}
+
 void MemoryBankFlattenFabricBitstream::add_blwl_vectors(
   const std::vector<std::string>& bl_vec,
   const std::vector<std::string>& wl_vec) {
@@ -18,6 +18,10 @@ namespace openfpga {
  *compatible protocols
  ******************************************************************************/
 class MemoryBankFlattenFabricBitstream {
+ public: /* Types */
+  typedef std::map<std::vector<std::string>,
+                   std::vector<std::string>>::const_iterator blwl_iterator;
+
  public: /* Accessors */
   /* @brief Return the length of bitstream */
   size_t size() const;
@@ -29,12 +33,18 @@ class MemoryBankFlattenFabricBitstream {
   size_t wl_vector_size() const;
 
   /* @brief Return the BL vectors with a given WL key */
-  std::vector<std::string> bl_vector(
+  const std::vector<std::string>& bl_vector(
     const std::vector<std::string>& wl_vec) const;
 
   /* @brief Return all the WL vectors in a downloaded sequence */
   std::vector<std::vector<std::string>> wl_vectors() const;
 
+  /* @brief Iterate over the (WL, BL) vector pairs in a downloaded sequence,
+   * which is cheaper than wl_vectors() and bl_vector() as nothing is copied
+   */
+  blwl_iterator begin() const;
+  blwl_iterator end() const;
+
  public: /* Mutators */
   /* @brief add a pair of BL/WL vectors to the bitstream database */
   void add_blwl_vectors(const std::vector<std::string>& bl_vec,
@@ -1,5 +1,7 @@
 #include "memory_bank_shift_register_fabric_bitstream.h"
 
+#include <utility>
+
 #include "vtr_assert.h"
 
 /* begin namespace openfpga */
@@ -55,6 +57,13 @@ std::vector<std::string> MemoryBankShiftRegisterFabricBitstream::wl_vectors(
   return bitstream_word_wls_[word_id];
 }
 
+void MemoryBankShiftRegisterFabricBitstream::reserve_words(
+  const size_t& num_words) {
+  bitstream_word_ids_.reserve(num_words);
+  bitstream_word_bls_.reserve(num_words);
+  bitstream_word_wls_.reserve(num_words);
+}
+
 MemoryBankShiftRegisterFabricBitstreamWordId
 MemoryBankShiftRegisterFabricBitstream::create_word() {
   /* Create a new id*/
@@ -84,6 +93,20 @@ void MemoryBankShiftRegisterFabricBitstream::add_wl_vectors(
   return bitstream_word_wls_[word_id].push_back(wl_vec);
 }
 
+void MemoryBankShiftRegisterFabricBitstream::set_bl_vectors(
+  const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
+  std::vector<std::string>&& bl_vectors) {
+  VTR_ASSERT(valid_word_id(word_id));
+  bitstream_word_bls_[word_id] = std::move(bl_vectors);
+}
+
+void MemoryBankShiftRegisterFabricBitstream::set_wl_vectors(
+  const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
+  std::vector<std::string>&& wl_vectors) {
+  VTR_ASSERT(valid_word_id(word_id));
+  bitstream_word_wls_[word_id] = std::move(wl_vectors);
+}
+
 bool MemoryBankShiftRegisterFabricBitstream::valid_word_id(
   const MemoryBankShiftRegisterFabricBitstreamWordId& word_id) const {
   return (size_t(word_id) < bitstream_word_ids_.size()) &&
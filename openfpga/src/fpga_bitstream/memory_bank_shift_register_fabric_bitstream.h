@@ -58,9 +58,24 @@ class MemoryBankShiftRegisterFabricBitstream {
     const MemoryBankShiftRegisterFabricBitstreamWordId& word_id) const;
 
  public: /* Mutators */
+  /* @brief Reserve a number of words */
+  void reserve_words(const size_t& num_words);
+
   /* @brief Create a new word */
   MemoryBankShiftRegisterFabricBitstreamWordId create_word();
 
+  /* @brief Replace all the BLs of a given word. Different words can be set
+   * by different threads */
+  void set_bl_vectors(
+    const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
+    std::vector<std::string>&& bl_vectors);
+
+  /* @brief Replace all the WLs of a given word. Different words can be set
+   * by different threads */
+  void set_wl_vectors(
+    const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
+    std::vector<std::string>&& wl_vectors);
+
   /* @brief Add BLs to a given word */
   void add_bl_vectors(
     const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
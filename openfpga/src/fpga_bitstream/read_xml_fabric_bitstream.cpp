@@ -0,0 +1,547 @@
+/********************************************************************
+ * This file includes functions that read a fabric-dependent bitstream
+ * from an XML file, which is written by write_fabric_bitstream_to_xml_file()
+ *******************************************************************/
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_decode.h"
+#include "openfpga_mapped_file.h"
+#include "openfpga_trace.h"
+
+#include "bitstream_manager_utils.h"
+#include "openfpga_naming.h"
+#include "read_xml_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* A range of characters in the content of a memory-mapped file */
+typedef std::pair<const char*, const char*> XmlTextRange;
+
+/********************************************************************
+ * A tag of an XML file, whose name and attributes refer to the content
+ * of the file rather than being copied
+ *******************************************************************/
+struct XmlTag {
+  XmlTextRange name;
+  /* True for a closing tag, e.g., </region> */
+  bool closing;
+  /* Pairs of <attribute name, attribute value> */
+  std::vector<std::pair<XmlTextRange, XmlTextRange>> attributes;
+};
+
+/********************************************************************
+ * A configuration bit read from the XML file, before the fabric
+ * bitstream is built
+ *******************************************************************/
+struct XmlFabricBit {
+  size_t id;
+  ConfigBitId config_bit;
+  /* Address of frame-based protocols, or BL address of memory banks */
+  XmlTextRange address;
+  XmlTextRange wl_address;
+};
+
+static bool xml_text_equal(const XmlTextRange& text, const char* str) {
+  size_t len = std::strlen(str);
+  return (size_t(text.second - text.first) == len) &&
+         (0 == std::strncmp(text.first, str, len));
+}
+
+static bool is_xml_space(const char& c) {
+  return (' ' == c) || ('\t' == c) || ('\n' == c) || ('\r' == c);
+}
+
+/* The line number of a character, which is only counted to report errors */
+static size_t find_xml_line_number(const char* begin, const char* pos) {
+  return 1 + std::count(begin, pos, '\n');
+}
+
+/********************************************************************
+ * Find the next tag from a given character, skipping texts and comments.
+ * The character is moved after the tag.
+ * Return false if no more tag is found or the tag is malformed, where
+ * the character is left at the end of the file or at the malformed tag
+ *******************************************************************/
+static bool read_next_xml_tag(const char*& cur, const char* end, XmlTag& tag,
+                              bool& malformed) {
+  malformed = false;
+  while (cur != end) {
+    cur = std::find(cur, end, '<');
+    if (cur == end) {
+      return false;
+    }
+    /* Skip comments and declarations */
+    if ((4 <= end - cur) && (0 == std::strncmp(cur, "<!--", 4))) {
+      const char* comment_end = std::search(cur, end, "-->", "-->" + 3);
+      cur = (comment_end == end) ? end : comment_end + 3;
+      continue;
+    }
+    if ((2 <= end - cur) && ('?' == cur[1])) {
+      const char* decl_end = std::search(cur, end, "?>", "?>" + 2);
+      cur = (decl_end == end) ? end : decl_end + 2;
+      continue;
+    }
+    break;
+  }
+  if (cur == end) {
+    return false;
+  }
+
+  const char* tag_begin = cur;
+  ++cur;
+  tag.closing = (cur != end) && ('/' == *cur);
+  if (tag.closing) {
+    ++cur;
+  }
+  const char* name_begin = cur;
+  while ((cur != end) && (false == is_xml_space(*cur)) && ('>' != *cur) &&
+         ('/' != *cur)) {
+    ++cur;
+  }
+  tag.name = std::make_pair(name_begin, cur);
+  tag.attributes.clear();
+
+  while (cur != end) {
+    while ((cur != end) && (true == is_xml_space(*cur))) {
+      ++cur;
+    }
+    if ((cur != end) && ('/' == *cur)) {
+      ++cur;
+    }
+    if ((cur != end) && ('>' == *cur)) {
+      ++cur;
+      return true;
+    }
+    /* Attribute in the form of name="value" */
+    const char* attr_begin = cur;
+    while ((cur != end) && ('=' != *cur) && ('>' != *cur)) {
+      ++cur;
+    }
+    if ((cur == end) || ('>' == *cur) || (end - cur < 2) || ('"' != cur[1])) {
+      break;
+    }
+    XmlTextRange attr_name(attr_begin, cur);
+    cur += 2;
+    const char* value_begin = cur;
+    cur = std::find(cur, end, '"');
+    if (cur == end) {
+      break;
+    }
+    tag.attributes.emplace_back(attr_name, XmlTextRange(value_begin, cur));
+    ++cur;
+  }
+
+  cur = tag_begin;
+  malformed = true;
+  return false;
+}
+
+static bool find_xml_attribute(const XmlTag& tag, const char* name,
+                               XmlTextRange& value) {
+  for (const auto& attr : tag.attributes) {
+    if (true == xml_text_equal(attr.first, name)) {
+      value = attr.second;
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Convert a text into a non-negative integer, return false if invalid */
+static bool xml_text_to_size(const XmlTextRange& text, size_t& value) {
+  if (text.first == text.second) {
+    return false;
+  }
+  value = 0;
+  for (const char* c = text.first; c != text.second; ++c) {
+    if ((*c < '0') || (*c > '9')) {
+      return false;
+    }
+    value = 10 * value + size_t(*c - '0');
+  }
+  return true;
+}
+
+/********************************************************************
+ * Resolve the hierarchical path of a configuration bit, e.g.,
+ *   fpga_top.grid_clb_1__1_.mem_out[3]
+ * into the configuration bit of the bitstream database.
+ * Consecutive bits usually share the same parent block, so that the
+ * parent block of the last path is cached and only its path is compared
+ *******************************************************************/
+class XmlConfigBitResolver {
+ public: /* Constructors */
+  explicit XmlConfigBitResolver(const BitstreamManager& bitstream_manager)
+    : bitstream_manager_(bitstream_manager),
+      mem_out_name_(generate_configurable_memory_data_out_name()),
+      cached_prefix_(nullptr, nullptr) {
+    std::vector<ConfigBlockId> top_blocks =
+      find_bitstream_manager_top_blocks(bitstream_manager_);
+    if (1 == top_blocks.size()) {
+      top_block_ = top_blocks[0];
+    }
+  }
+
+ public: /* Public accessors */
+  /* Return an invalid id if the path does not match any bit */
+  ConfigBitId resolve(const XmlTextRange& path) {
+    /* Split the path into the parent block and the bit */
+    const char* dot = path.second;
+    while ((dot != path.first) && ('.' != *(dot - 1))) {
+      --dot;
+    }
+    if (dot == path.first) {
+      return ConfigBitId::INVALID();
+    }
+    XmlTextRange prefix(path.first, dot - 1);
+    if ((false == bitstream_manager_.valid_block_id(cached_block_)) ||
+        (size_t(prefix.second - prefix.first) !=
+         size_t(cached_prefix_.second - cached_prefix_.first)) ||
+        (0 != std::strncmp(prefix.first, cached_prefix_.first,
+                           prefix.second - prefix.first))) {
+      ConfigBlockId block = resolve_block(prefix);
+      if (false == bitstream_manager_.valid_block_id(block)) {
+        return ConfigBitId::INVALID();
+      }
+      cached_block_ = block;
+      cached_prefix_ = prefix;
+      cached_bits_ = bitstream_manager_.block_bits(block);
+    }
+
+    /* The bit is in the form of <mem_out_name>[<index>] */
+    XmlTextRange leaf(dot, path.second);
+    size_t name_len = mem_out_name_.size();
+    if ((size_t(leaf.second - leaf.first) < name_len + 3) ||
+        (0 != std::strncmp(leaf.first, mem_out_name_.c_str(), name_len)) ||
+        ('[' != leaf.first[name_len]) || (']' != *(leaf.second - 1))) {
+      return ConfigBitId::INVALID();
+    }
+    size_t index = 0;
+    if ((false == xml_text_to_size(XmlTextRange(leaf.first + name_len + 1,
+                                                leaf.second - 1),
+                                   index)) ||
+        (index >= cached_bits_.size())) {
+      return ConfigBitId::INVALID();
+    }
+    return cached_bits_[index];
+  }
+
+ private: /* Internal functions */
+  ConfigBlockId resolve_block(const XmlTextRange& path) {
+    ConfigBlockId block = ConfigBlockId::INVALID();
+    const char* seg_begin = path.first;
+    while (seg_begin <= path.second) {
+      const char* seg_end = std::find(seg_begin, path.second, '.');
+      block_name_.assign(seg_begin, seg_end);
+      if (false == bitstream_manager_.valid_block_id(block)) {
+        if ((false == bitstream_manager_.valid_block_id(top_block_)) ||
+            (block_name_ != bitstream_manager_.block_name(top_block_))) {
+          return ConfigBlockId::INVALID();
+        }
+        block = top_block_;
+      } else {
+        block = bitstream_manager_.find_child_block(block, block_name_);
+        if (false == bitstream_manager_.valid_block_id(block)) {
+          return ConfigBlockId::INVALID();
+        }
+      }
+      seg_begin = seg_end + 1;
+    }
+    return block;
+  }
+
+ private: /* Internal data */
+  const BitstreamManager& bitstream_manager_;
+  std::string mem_out_name_;
+  ConfigBlockId top_block_;
+  /* Parent block of the last path and its bits */
+  ConfigBlockId cached_block_;
+  XmlTextRange cached_prefix_;
+  std::vector<ConfigBitId> cached_bits_;
+  /* A buffer to look up child blocks by name */
+  std::string block_name_;
+};
+
+/* Convert an address into bits, return false if it has invalid bits */
+static bool xml_text_to_address(const XmlTextRange& text,
+                                std::vector<char>& address) {
+  address.assign(text.first, text.second);
+  for (const char& addr_bit : address) {
+    if (('0' != addr_bit) && ('1' != addr_bit) &&
+        (DONT_CARE_CHAR != addr_bit)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/********************************************************************
+ * Read the fabric bitstream from an XML file, which is written by
+ * write_fabric_bitstream_to_xml_file(), so that the fabric bitstream does
+ * not have to be built again from the fabric.
+ * The file is memory-mapped and parsed in place: the names and values of
+ * attributes are only compared with the content of the file, without being
+ * copied. The configuration bits are resolved from their paths in the
+ * bitstream database, which should be built or read before, and their
+ * values should match the bitstream database.
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int read_xml_fabric_bitstream(const std::string& fname,
+                              const BitstreamManager& bitstream_manager,
+                              const ConfigProtocol& config_protocol,
+                              FabricBitstream& fabric_bitstream,
+                              const bool& verbose) {
+  std::string timer_message =
+    std::string("Read fabric bitstream from xml file '") + fname +
+    std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
+
+  MappedFile file(fname.c_str());
+  if (false == file.is_open()) {
+    VTR_LOG_ERROR("Fail to open fabric bitstream file '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  bool use_bl_wl_address = false;
+  bool use_frame_address = false;
+  switch (config_protocol.type()) {
+    case CONFIG_MEM_STANDALONE:
+    case CONFIG_MEM_SCAN_CHAIN:
+      break;
+    case CONFIG_MEM_QL_MEMORY_BANK:
+    case CONFIG_MEM_MEMORY_BANK:
+      use_bl_wl_address = true;
+      break;
+    case CONFIG_MEM_FRAME_BASED:
+      use_frame_address = true;
+      break;
+    default:
+      VTR_LOGF_ERROR(__FILE__, __LINE__,
+                     "Invalid configuration protocol type!\n");
+      return 1;
+  }
+
+  XmlConfigBitResolver resolver(bitstream_manager);
+  std::vector<XmlFabricBit> bits;
+  /* Ids of the bits in each region, in the sequence of the file */
+  std::vector<std::vector<size_t>> region_bits;
+  bool in_bit = false;
+
+  XmlTag tag;
+  bool malformed = false;
+  const char* cur = file.begin();
+  const char* tag_begin = cur;
+  std::string error_message;
+  while (true == error_message.empty()) {
+    /* Skip the spaces, so that errors are reported at the tag */
+    while ((cur != file.end()) && (true == is_xml_space(*cur))) {
+      ++cur;
+    }
+    tag_begin = cur;
+    if (false == read_next_xml_tag(cur, file.end(), tag, malformed)) {
+      if (true == malformed) {
+        tag_begin = cur;
+        error_message = "Malformed XML tag";
+      }
+      break;
+    }
+    tag_begin = std::find(tag_begin, cur, '<');
+
+    if (true == xml_text_equal(tag.name, "region")) {
+      if (true == tag.closing) {
+        continue;
+      }
+      XmlTextRange id_text;
+      size_t region_id = 0;
+      if ((false == find_xml_attribute(tag, "id", id_text)) ||
+          (false == xml_text_to_size(id_text, region_id)) ||
+          (region_id != region_bits.size())) {
+        error_message = "Expect regions with ids in sequence";
+        break;
+      }
+      region_bits.emplace_back();
+    } else if (true == xml_text_equal(tag.name, "bit")) {
+      in_bit = !tag.closing;
+      if (true == tag.closing) {
+        continue;
+      }
+      if (true == region_bits.empty()) {
+        error_message = "Expect a bit inside a region";
+        break;
+      }
+      XmlTextRange id_text, value_text, path_text;
+      XmlFabricBit bit;
+      if ((false == find_xml_attribute(tag, "id", id_text)) ||
+          (false == xml_text_to_size(id_text, bit.id)) ||
+          (false == find_xml_attribute(tag, "value", value_text)) ||
+          (false == find_xml_attribute(tag, "path", path_text))) {
+        error_message = "Expect a bit with attributes 'id', 'value' and 'path'";
+        break;
+      }
+      bit.config_bit = resolver.resolve(path_text);
+      if (false == bitstream_manager.valid_bit_id(bit.config_bit)) {
+        error_message = "Path of the bit is not found in bitstream database";
+        break;
+      }
+      if ((false == xml_text_equal(value_text, "0")) &&
+          (false == xml_text_equal(value_text, "1"))) {
+        error_message = "Expect a bit value of '0' or '1'";
+        break;
+      }
+      if (bitstream_manager.bit_value(bit.config_bit) !=
+          xml_text_equal(value_text, "1")) {
+        error_message = "Bit value does not match the bitstream database";
+        break;
+      }
+      bit.address = XmlTextRange(nullptr, nullptr);
+      bit.wl_address = XmlTextRange(nullptr, nullptr);
+      region_bits.back().push_back(bit.id);
+      bits.push_back(bit);
+    } else if ((true == xml_text_equal(tag.name, "bl")) ||
+               (true == xml_text_equal(tag.name, "wl")) ||
+               (true == xml_text_equal(tag.name, "frame"))) {
+      XmlTextRange address;
+      if ((false == in_bit) ||
+          (false == find_xml_attribute(tag, "address", address))) {
+        error_message = "Expect an address with attribute 'address' in a bit";
+        break;
+      }
+      if (true == xml_text_equal(tag.name, "wl")) {
+        bits.back().wl_address = address;
+      } else {
+        bits.back().address = address;
+      }
+    }
+  }
+
+  /* Each bit id should appear once, so that the bits can be added by id */
+  std::vector<size_t> bit_indices(bits.size(), bits.size());
+  if (true == error_message.empty()) {
+    for (size_t ibit = 0; ibit < bits.size(); ++ibit) {
+      if ((bits[ibit].id >= bits.size()) ||
+          (bits.size() != bit_indices[bits[ibit].id])) {
+        error_message = "Expect bits with unique ids in range [0, " +
+                        std::to_string(bits.size()) + ")";
+        tag_begin = file.end();
+        break;
+      }
+      bit_indices[bits[ibit].id] = ibit;
+    }
+  }
+
+  /* Addresses are required by the configuration protocol */
+  size_t address_length = 0;
+  size_t wl_address_length = 0;
+  for (const XmlFabricBit& bit : bits) {
+    if (false == error_message.empty()) {
+      break;
+    }
+    if (((true == use_bl_wl_address) || (true == use_frame_address)) &&
+        (nullptr == bit.address.first)) {
+      error_message = "Expect an address for bit " + std::to_string(bit.id);
+    }
+    if ((true == use_bl_wl_address) && (nullptr == bit.wl_address.first)) {
+      error_message = "Expect a WL address for bit " + std::to_string(bit.id);
+    }
+    if (false == error_message.empty()) {
+      tag_begin = file.end();
+      break;
+    }
+    address_length = std::max(address_length,
+                              size_t(bit.address.second - bit.address.first));
+    wl_address_length = std::max(
+      wl_address_length, size_t(bit.wl_address.second - bit.wl_address.first));
+  }
+
+  if (false == error_message.empty()) {
+    if (tag_begin == file.end()) {
+      VTR_LOG_ERROR("%s in fabric bitstream file '%s'!\n",
+                    error_message.c_str(), fname.c_str());
+    } else {
+      VTR_LOG_ERROR("%s at line %lu of fabric bitstream file '%s'!\n",
+                    error_message.c_str(),
+                    find_xml_line_number(file.begin(), tag_begin),
+                    fname.c_str());
+    }
+    return 1;
+  }
+
+  /* Build the fabric bitstream in the sequence of bit ids */
+  fabric_bitstream = FabricBitstream();
+  if (true == use_bl_wl_address) {
+    fabric_bitstream.set_use_address(true);
+    fabric_bitstream.set_use_wl_address(true);
+    fabric_bitstream.set_bl_address_length(address_length);
+    fabric_bitstream.set_wl_address_length(wl_address_length);
+  } else if (true == use_frame_address) {
+    fabric_bitstream.set_use_address(true);
+    fabric_bitstream.set_address_length(address_length);
+  }
+  fabric_bitstream.reserve_bits(bits.size());
+
+  std::vector<char> address;
+  for (const size_t& ibit : bit_indices) {
+    const XmlFabricBit& bit = bits[ibit];
+    FabricBitId fabric_bit = fabric_bitstream.add_bit(bit.config_bit);
+    VTR_ASSERT(size_t(fabric_bit) == bit.id);
+    if (false == fabric_bitstream.use_address()) {
+      continue;
+    }
+    bool valid_address = xml_text_to_address(bit.address, address);
+    if ((true == valid_address) && (true == use_frame_address)) {
+      fabric_bitstream.set_bit_address(fabric_bit, address, true);
+    }
+    if ((true == valid_address) && (true == use_bl_wl_address)) {
+      fabric_bitstream.set_bit_bl_address(fabric_bit, address, true);
+      valid_address = xml_text_to_address(bit.wl_address, address);
+      if (true == valid_address) {
+        fabric_bitstream.set_bit_wl_address(fabric_bit, address, true);
+      }
+    }
+    if (false == valid_address) {
+      VTR_LOG_ERROR(
+        "Invalid address of bit %lu in fabric bitstream file '%s'! Expect "
+        "bits in [0|1|%c]\n",
+        bit.id, fname.c_str(), DONT_CARE_CHAR);
+      fabric_bitstream = FabricBitstream();
+      return 1;
+    }
+    fabric_bitstream.set_bit_din(fabric_bit,
+                                 bitstream_manager.bit_value(bit.config_bit));
+  }
+
+  fabric_bitstream.reserve_regions(region_bits.size());
+  for (const std::vector<size_t>& bit_ids : region_bits) {
+    FabricBitRegionId region = fabric_bitstream.add_region();
+    for (const size_t& bit_id : bit_ids) {
+      fabric_bitstream.add_bit_to_region(region, FabricBitId(bit_id));
+    }
+  }
+
+  /* Count the bit values once for all the writers using fast configuration */
+  fabric_bitstream.build_bit_value_stats(bitstream_manager);
+
+  VTR_LOGV(verbose,
+           "Read %lu configuration bits in %lu regions from XML file: %s\n",
+           fabric_bitstream.num_bits(), fabric_bitstream.num_regions(),
+           fname.c_str());
+
+  return 0;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,28 @@
+#ifndef READ_XML_FABRIC_BITSTREAM_H
+#define READ_XML_FABRIC_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+#include "bitstream_manager.h"
+#include "config_protocol.h"
+#include "fabric_bitstream.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int read_xml_fabric_bitstream(const std::string& fname,
+                              const BitstreamManager& bitstream_manager,
+                              const ConfigProtocol& config_protocol,
+                              FabricBitstream& fabric_bitstream,
+                              const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
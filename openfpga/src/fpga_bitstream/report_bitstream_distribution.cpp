@@ -11,9 +11,11 @@
 #include "vtr_time.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_tokenizer.h"
+#include "openfpga_trace.h"
 #include "openfpga_version.h"
 #include "report_arch_bitstream_distribution.h"
 #include "report_bitstream_distribution.h"
@@ -30,19 +32,19 @@ static void report_bitstream_distribution_xml_file_head(
   std::fstream& fp, const bool& include_time_stamp) {
   valid_file_stream(fp);
 
-  fp << "<!-- " << std::endl;
-  fp << "\t- Report Bitstream Distribution" << std::endl;
+  fp << "<!-- " << '\n';
+  fp << "\t- Report Bitstream Distribution" << '\n';
 
   if (include_time_stamp) {
     auto end = std::chrono::system_clock::now();
     std::time_t end_time = std::chrono::system_clock::to_time_t(end);
     /* Note that version is also a type of time stamp */
-    fp << "\t- Version: " << openfpga::VERSION << std::endl;
+    fp << "\t- Version: " << openfpga::VERSION << '\n';
     fp << "\t- Date: " << std::ctime(&end_time);
   }
 
-  fp << "--> " << std::endl;
-  fp << std::endl;
+  fp << "--> " << '\n';
+  fp << '\n';
 }
 
 /********************************************************************
@@ -53,7 +55,8 @@ int report_bitstream_distribution(const std::string& fname,
                                   const BitstreamManager& bitstream_manager,
                                   const FabricBitstream& fabric_bitstream,
                                   const bool& include_time_stamp,
-                                  const size_t& max_hierarchy_level) {
+                                  const size_t& max_hierarchy_level,
+                                  const size_t& num_threads) {
   /* Ensure that we have a valid file name */
   if (true == fname.empty()) {
     VTR_LOG_ERROR(
@@ -66,9 +69,10 @@ int report_bitstream_distribution(const std::string& fname,
     std::string("Report bitstream distribution into XML file '") + fname +
     std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(fname.c_str(), fp);
@@ -78,7 +82,7 @@ int report_bitstream_distribution(const std::string& fname,
 
   int curr_level = 0;
   write_tab_to_file(fp, curr_level);
-  fp << "<bitstream_distribution>" << std::endl;
+  fp << "<bitstream_distribution>" << '\n';
 
   int status = 0;
   status =
@@ -87,9 +91,9 @@ int report_bitstream_distribution(const std::string& fname,
     return status;
   }
   status = report_architecture_bitstream_distribution(
-    fp, bitstream_manager, max_hierarchy_level, curr_level + 1);
+    fp, bitstream_manager, max_hierarchy_level, curr_level + 1, num_threads);
 
-  fp << "</bitstream_distribution>" << std::endl;
+  fp << "</bitstream_distribution>" << '\n';
 
   /* Close file handler */
   fp.close();
@@ -0,0 +1,74 @@
+/********************************************************************
+ * This file includes functions to report the configuration bits of
+ * tiles, which are found from the bitstream tile index
+ *******************************************************************/
+#include <string>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+#include "report_bitstream_tile.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Convert ranges of bits into a string, e.g., [0, 32) [64, 96) */
+static std::string bit_ranges_to_string(
+  const BitstreamTileIndex::bit_ranges& ranges) {
+  std::string ranges_str;
+  for (const auto& range : ranges) {
+    if (false == ranges_str.empty()) {
+      ranges_str += " ";
+    }
+    ranges_str += "[" + std::to_string(range.first) + ", " +
+                  std::to_string(range.second) + ")";
+  }
+  return ranges_str;
+}
+
+/********************************************************************
+ * Report the block, the configuration bits and the fabric bits of
+ * tiles, as well as the values of the configuration bits on request.
+ * The bits are only visited through the ranges of each tile, so the
+ * cost is linear in the number of bits of the tiles
+ *******************************************************************/
+void report_bitstream_tiles(const BitstreamManager& bitstream_manager,
+                            const BitstreamTileIndex& tile_index,
+                            const std::vector<BitstreamTileId>& tiles,
+                            const bool& show_values) {
+  for (const BitstreamTileId& tile_id : tiles) {
+    std::string block_path =
+      bitstream_manager.block_path(tile_index.tile_block(tile_id));
+    vtr::Point<size_t> coord = tile_index.tile_coordinate(tile_id);
+    VTR_LOG("Tile %s (%lu, %lu) subtile %lu: %s\n",
+            BITSTREAM_TILE_TYPE_STRING[tile_index.tile_type(tile_id)],
+            coord.x(), coord.y(), tile_index.tile_subtile(tile_id),
+            block_path.c_str());
+
+    const BitstreamTileIndex::bit_ranges& config_bit_ranges =
+      tile_index.tile_config_bit_ranges(tile_id);
+    VTR_LOG("\tConfiguration bits: %lu in %s\n",
+            tile_index.tile_num_config_bits(tile_id),
+            bit_ranges_to_string(config_bit_ranges).c_str());
+    if (true == tile_index.has_fabric_bits()) {
+      VTR_LOG(
+        "\tFabric bits: %s\n",
+        bit_ranges_to_string(tile_index.tile_fabric_bit_ranges(tile_id))
+          .c_str());
+    }
+
+    if (true == show_values) {
+      std::string values;
+      values.reserve(tile_index.tile_num_config_bits(tile_id));
+      for (const auto& range : config_bit_ranges) {
+        for (size_t ibit = range.first; ibit < range.second; ++ibit) {
+          values.push_back(
+            bitstream_manager.bit_value(ConfigBitId(ibit)) ? '1' : '0');
+        }
+      }
+      VTR_LOG("\tValues: %s\n", values.c_str());
+    }
+  }
+}
+
+} /* end namespace openfpga */
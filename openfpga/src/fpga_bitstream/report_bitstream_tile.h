@@ -0,0 +1,26 @@
+#ifndef REPORT_BITSTREAM_TILE_H
+#define REPORT_BITSTREAM_TILE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <vector>
+
+#include "bitstream_manager.h"
+#include "bitstream_tile_index.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void report_bitstream_tiles(const BitstreamManager& bitstream_manager,
+                            const BitstreamTileIndex& tile_index,
+                            const std::vector<BitstreamTileId>& tiles,
+                            const bool& show_values);
+
+} /* end namespace openfpga */
+
+#endif
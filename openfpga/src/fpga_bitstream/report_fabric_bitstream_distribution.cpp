@@ -15,6 +15,7 @@
 #include "openfpga_digest.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_tokenizer.h"
+#include "openfpga_trace.h"
 #include "openfpga_version.h"
 #include "report_fabric_bitstream_distribution.h"
 
@@ -40,10 +41,10 @@ static void report_region_bitstream_distribution_to_xml_file(
   fp << " id=\"" << size_t(region) << "\"";
   fp << " number_of_bits=\"" << fabric_bitstream.region_bits(region).size()
      << "\"";
-  fp << ">" << std::endl;
+  fp << ">" << '\n';
 
   write_tab_to_file(fp, hierarchy_level);
-  fp << "</region>" << std::endl;
+  fp << "</region>" << '\n';
 }
 
 /********************************************************************
@@ -56,6 +57,7 @@ int report_fabric_bitstream_distribution(
   std::string timer_message =
     std::string("Report fabric bitstream distribution");
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   valid_file_stream(fp);
 
@@ -63,11 +65,11 @@ int report_fabric_bitstream_distribution(
   int curr_level = hierarchy_level;
   for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
     write_tab_to_file(fp, curr_level);
-    fp << "<regions>" << std::endl;
+    fp << "<regions>" << '\n';
     report_region_bitstream_distribution_to_xml_file(fp, fabric_bitstream,
                                                      region, curr_level + 1);
     write_tab_to_file(fp, curr_level);
-    fp << "</regions>" << std::endl;
+    fp << "</regions>" << '\n';
   }
 
   return 0;
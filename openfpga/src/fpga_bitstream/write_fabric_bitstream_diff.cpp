@@ -0,0 +1,273 @@
+/********************************************************************
+ * This file includes functions that output the difference between
+ * a fabric-dependent bitstream and a reference one, which contains
+ * only the addresses to be reprogrammed in a partial reconfiguration
+ *******************************************************************/
+#include <chrono>
+#include <ctime>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "fabric_bitstream_file_writer.h"
+#include "fabric_bitstream_utils.h"
+#include "openfpga_buffered_stream.h"
+#include "openfpga_digest.h"
+#include "openfpga_version.h"
+#include "write_fabric_bitstream_diff.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Find the indices of the rows in a bitstream which should be
+ * reprogrammed to turn a reference bitstream into it.
+ * A row is reprogrammed when its address does not exist in the reference
+ * or when its data inputs are different from the reference.
+ * Both bitstreams are sorted by addresses, so that a linear merge is
+ * sufficient to find all the changes
+ *******************************************************************/
+template <class T>
+static std::vector<size_t> find_fabric_bitstream_diff_rows(
+  const T& fabric_bits_by_addr, const T& ref_fabric_bits_by_addr) {
+  std::vector<size_t> diff_rows;
+
+  auto ref_it = ref_fabric_bits_by_addr.begin();
+  for (size_t irow = 0; irow < fabric_bits_by_addr.size(); ++irow) {
+    const auto& addr_din_pair = fabric_bits_by_addr[irow];
+    /* Bypass the addresses which only exist in the reference */
+    while (ref_it != ref_fabric_bits_by_addr.end() &&
+           ref_it->first < addr_din_pair.first) {
+      ++ref_it;
+    }
+    if (ref_it == ref_fabric_bits_by_addr.end() ||
+        addr_din_pair.first < ref_it->first ||
+        addr_din_pair.second != ref_it->second) {
+      diff_rows.push_back(irow);
+    }
+  }
+
+  return diff_rows;
+}
+
+/********************************************************************
+ * Write the changed rows of a frame-based fabric bitstream
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+static int write_frame_based_fabric_bitstream_diff_to_text_file(
+  FabricBitstreamFileWriter& writer, const ConfigProtocol& config_protocol,
+  const FabricBitstream& fabric_bitstream,
+  const FabricBitstream& ref_fabric_bitstream, const bool& verbose) {
+  FrameFabricBitstream fabric_bits_by_addr =
+    build_frame_based_fabric_bitstream_by_address(fabric_bitstream);
+  FrameFabricBitstream ref_fabric_bits_by_addr =
+    build_frame_based_fabric_bitstream_by_address(ref_fabric_bitstream);
+
+  std::vector<size_t> diff_rows =
+    find_fabric_bitstream_diff_rows(fabric_bits_by_addr, ref_fabric_bits_by_addr);
+  VTR_LOGV(verbose, "Found %lu/%lu configuration frames to be reprogrammed\n",
+           diff_rows.size(), fabric_bits_by_addr.size());
+
+  /* The address sizes and data input sizes are the same across any element,
+   * just get it from the 1st element to save runtime
+   */
+  size_t addr_size = fabric_bits_by_addr.begin()->first.size();
+  size_t din_size = fabric_bits_by_addr.begin()->second.size();
+
+  /* Output information about how to intepret the bitstream */
+  writer.write_comment("// Bitstream length: " +
+                       std::to_string(diff_rows.size()));
+  writer.write_comment("// Bitstream width (LSB -> MSB): <address " +
+                       std::to_string(addr_size) + " bits><data input " +
+                       std::to_string(din_size) + " bits>");
+  FabricBitstreamFileHeader header;
+  header.num_regions = fabric_bitstream.num_regions();
+  header.num_rows = diff_rows.size();
+  header.num_skipped_rows = fabric_bits_by_addr.size() - diff_rows.size();
+  header.address_width = addr_size;
+  header.din_width = din_size;
+  writer.write_header(config_protocol, header);
+
+  for (const size_t& irow : diff_rows) {
+    writer.write_bits(fabric_bits_by_addr[irow].first);
+    writer.write_bits(fabric_bits_by_addr[irow].second);
+    writer.end_row();
+  }
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the changed rows of a memory-bank fabric bitstream, where
+ * each row is addressed by a pair of BL and WL addresses
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+static int write_memory_bank_fabric_bitstream_diff_to_text_file(
+  FabricBitstreamFileWriter& writer, const ConfigProtocol& config_protocol,
+  const FabricBitstream& fabric_bitstream,
+  const FabricBitstream& ref_fabric_bitstream, const bool& verbose) {
+  MemoryBankFabricBitstream fabric_bits_by_addr =
+    build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
+  MemoryBankFabricBitstream ref_fabric_bits_by_addr =
+    build_memory_bank_fabric_bitstream_by_address(ref_fabric_bitstream);
+
+  std::vector<size_t> diff_rows =
+    find_fabric_bitstream_diff_rows(fabric_bits_by_addr, ref_fabric_bits_by_addr);
+  VTR_LOGV(verbose,
+           "Found %lu/%lu configuration addresses to be reprogrammed\n",
+           diff_rows.size(), fabric_bits_by_addr.size());
+
+  /* The address sizes and data input sizes are the same across any element,
+   * just get it from the 1st element to save runtime
+   */
+  size_t bl_addr_size = fabric_bits_by_addr.begin()->first.first.size();
+  size_t wl_addr_size = fabric_bits_by_addr.begin()->first.second.size();
+  size_t din_size = fabric_bits_by_addr.begin()->second.size();
+
+  /* Output information about how to intepret the bitstream */
+  writer.write_comment("// Bitstream length: " +
+                       std::to_string(diff_rows.size()));
+  writer.write_comment("// Bitstream width (LSB -> MSB): <bl_address " +
+                       std::to_string(bl_addr_size) + " bits><wl_address " +
+                       std::to_string(wl_addr_size) + " bits><data input " +
+                       std::to_string(din_size) + " bits>");
+  FabricBitstreamFileHeader header;
+  header.num_regions = fabric_bitstream.num_regions();
+  header.num_rows = diff_rows.size();
+  header.num_skipped_rows = fabric_bits_by_addr.size() - diff_rows.size();
+  header.bl_address_width = bl_addr_size;
+  header.wl_address_width = wl_addr_size;
+  header.din_width = din_size;
+  writer.write_header(config_protocol, header);
+
+  for (const size_t& irow : diff_rows) {
+    writer.write_bits(fabric_bits_by_addr[irow].first.first);
+    writer.write_bits(fabric_bits_by_addr[irow].first.second);
+    writer.write_bits(fabric_bits_by_addr[irow].second);
+    writer.end_row();
+  }
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the difference between a fabric bitstream and a reference
+ * fabric bitstream to a plain text file, or to a binary file
+ * when binary is enabled.
+ * Only the addresses whose data inputs are different from the reference
+ * are outputted, so that a fabric already programmed by the reference
+ * can be partially reconfigured.
+ * Notes:
+ *   - Only the protocols where each address can be programmed individually
+ *     are supported, i.e., frame-based and memory bank with BL decoders
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_fabric_bitstream_diff_to_text_file(
+  const FabricBitstream& fabric_bitstream,
+  const FabricBitstream& ref_fabric_bitstream,
+  const ConfigProtocol& config_protocol, const std::string& fname,
+  const bool& binary, const bool& include_time_stamp, const bool& verbose) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR(
+      "Received empty file name to output bitstream difference!\n\tPlease "
+      "specify a valid file name.\n");
+    return 1;
+  }
+
+  bool is_addressable = false;
+  switch (config_protocol.type()) {
+    case CONFIG_MEM_FRAME_BASED:
+    case CONFIG_MEM_MEMORY_BANK:
+      is_addressable = true;
+      break;
+    case CONFIG_MEM_QL_MEMORY_BANK:
+      is_addressable =
+        (BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type());
+      break;
+    default:
+      break;
+  }
+  if (false == is_addressable) {
+    VTR_LOG_ERROR(
+      "Bitstream difference is only applicable to frame-based and memory "
+      "bank configuration protocols using decoders!\n");
+    return 1;
+  }
+
+  if (fabric_bitstream.num_bits() != ref_fabric_bitstream.num_bits()) {
+    VTR_LOG_ERROR(
+      "Mismatch in the number of configuration bits between the fabric "
+      "bitstream (%lu) and the reference (%lu)!\n",
+      fabric_bitstream.num_bits(), ref_fabric_bitstream.num_bits());
+    return 1;
+  }
+
+  std::string timer_message =
+    std::string("Write difference of fabric bitstream into ") +
+    std::string(binary ? "binary" : "plain text") + std::string(" file '") +
+    fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  if (binary) {
+    fp.open(fname,
+            std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  } else {
+    fp.open(fname, std::fstream::out | std::fstream::trunc);
+  }
+
+  check_file_stream(fname.c_str(), fp);
+
+  FabricBitstreamFileWriter writer(fp, binary, false);
+
+  /* Write file head */
+  writer.write_comment("// Fabric bitstream difference");
+  if (include_time_stamp) {
+    auto end = std::chrono::system_clock::now();
+    std::time_t end_time = std::chrono::system_clock::to_time_t(end);
+    /* Note that version is also a type of time stamp */
+    writer.write_comment(std::string("// Version: ") + openfpga::VERSION);
+    /* The date string ends with a new line already */
+    std::string date(std::ctime(&end_time));
+    if (!date.empty() && '\n' == date.back()) {
+      date.pop_back();
+    }
+    writer.write_comment("// Date: " + date);
+  }
+
+  int status = 0;
+  if (CONFIG_MEM_FRAME_BASED == config_protocol.type()) {
+    status = write_frame_based_fabric_bitstream_diff_to_text_file(
+      writer, config_protocol, fabric_bitstream, ref_fabric_bitstream,
+      verbose);
+  } else {
+    status = write_memory_bank_fabric_bitstream_diff_to_text_file(
+      writer, config_protocol, fabric_bitstream, ref_fabric_bitstream,
+      verbose);
+  }
+
+  /* Print an end to the file here */
+  writer.end_file();
+
+  /* Close file handler */
+  fp.close();
+
+  return status;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,28 @@
+#ifndef WRITE_FABRIC_BITSTREAM_DIFF_H
+#define WRITE_FABRIC_BITSTREAM_DIFF_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include <vector>
+
+#include "config_protocol.h"
+#include "fabric_bitstream.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int write_fabric_bitstream_diff_to_text_file(
+  const FabricBitstream& fabric_bitstream,
+  const FabricBitstream& ref_fabric_bitstream,
+  const ConfigProtocol& config_protocol, const std::string& fname,
+  const bool& binary, const bool& include_time_stamp, const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
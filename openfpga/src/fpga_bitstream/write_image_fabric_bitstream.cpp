@@ -0,0 +1,176 @@
+/********************************************************************
+ * This file includes functions that output a fabric-dependent
+ * bitstream database to a programming image, i.e., a raw binary file
+ * which can be loaded to a memory and streamed to the configuration
+ * ports of a fabric without any conversion
+ *******************************************************************/
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "fabric_bitstream_utils.h"
+#include "fast_configuration.h"
+#include "openfpga_buffered_stream.h"
+#include "openfpga_digest.h"
+#include "openfpga_trace.h"
+#include "write_image_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Write the fabric bitstream fitting a configuration chain protocol
+ * to a programming image
+ *
+ * Each row of the image is the data to be shifted into the
+ * configuration chains of all the regions in one clock cycle. A row is
+ * packed into words, where region r is the bit (r % word_size) of the
+ * word (r / word_size), so that the data input of each region is a
+ * fixed lane of the words. The unused lanes of the last word are '0'.
+ * Words are written in little endian and rows are written from the
+ * first bit to be shifted in, without any header.
+ *
+ *    Row 0:  | word 0: <region 31> ... <region 1><region 0> | word 1: ...
+ *    Row 1:  | word 0: <region 31> ... <region 1><region 0> | word 1: ...
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+static int write_config_chain_fabric_bitstream_to_image_file(
+  std::fstream& fp, const size_t& word_size, const bool& fast_configuration,
+  const bool& bit_value_to_skip, const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream, const bool& verbose) {
+  ConfigChainFabricBitstream regional_bitstreams =
+    build_config_chain_fabric_bitstream_by_region(bitstream_manager,
+                                                  fabric_bitstream);
+  size_t regional_bitstream_max_size = regional_bitstreams.num_rows();
+
+  /* For fast configuration, the bitstream size counts from the first bit '1' */
+  size_t num_bits_to_skip = 0;
+  if (true == fast_configuration) {
+    num_bits_to_skip =
+      find_configuration_chain_fabric_bitstream_size_to_be_skipped(
+        fabric_bitstream, bitstream_manager, bit_value_to_skip);
+    VTR_ASSERT(num_bits_to_skip < regional_bitstream_max_size);
+    VTR_LOG(
+      "Fast configuration will skip %g% (%lu/%lu) of configuration "
+      "bitstream.\n",
+      100. * (float)num_bits_to_skip / (float)regional_bitstream_max_size,
+      num_bits_to_skip, regional_bitstream_max_size);
+  }
+
+  /* Lane of each region in the words of a row */
+  size_t num_words_per_row =
+    (fabric_bitstream.num_regions() + word_size - 1) / word_size;
+  size_t num_bytes_per_word = word_size / 8;
+  std::vector<FabricBitRegionId> regions;
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    regions.push_back(region);
+  }
+
+  std::vector<uint64_t> row_words(num_words_per_row, 0);
+  for (size_t ibit = num_bits_to_skip; ibit < regional_bitstream_max_size;
+       ++ibit) {
+    std::fill(row_words.begin(), row_words.end(), 0);
+    for (size_t ilane = 0; ilane < regions.size(); ++ilane) {
+      if (true == regional_bitstreams.bit_value(ibit, regions[ilane])) {
+        row_words[ilane / word_size] |= uint64_t(1) << (ilane % word_size);
+      }
+    }
+    for (const uint64_t& word : row_words) {
+      for (size_t ibyte = 0; ibyte < num_bytes_per_word; ++ibyte) {
+        fp.put(static_cast<char>((word >> (8 * ibyte)) & 0xff));
+      }
+    }
+  }
+
+  VTR_LOGV(verbose,
+           "Programming image includes %lu rows of %lu %lu-bit words for "
+           "%lu regions\n",
+           regional_bitstream_max_size - num_bits_to_skip, num_words_per_row,
+           word_size, regions.size());
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the fabric bitstream to a programming image
+ * Only the configuration chain protocol is supported now, whose
+ * regions are shifted in parallel.
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_fabric_bitstream_to_image_file(
+  const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream,
+  const ConfigProtocol& config_protocol,
+  const FabricGlobalPortInfo& global_ports, const std::string& fname,
+  const size_t& word_size, const bool& fast_configuration,
+  const bool& verbose) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR(
+      "Received empty file name to output bitstream!\n\tPlease specify a valid "
+      "file name.\n");
+  }
+
+  if (CONFIG_MEM_SCAN_CHAIN != config_protocol.type()) {
+    VTR_LOG_ERROR(
+      "Programming image is only supported by configuration protocol '%s'!\n",
+      CONFIG_PROTOCOL_TYPE_STRING[CONFIG_MEM_SCAN_CHAIN]);
+    return 1;
+  }
+  VTR_ASSERT(32 == word_size || 64 == word_size);
+
+  std::string timer_message =
+    std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) +
+    std::string(" fabric bitstream into programming image '") + fname +
+    std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
+
+  bool apply_fast_configuration =
+    is_fast_configuration_applicable(global_ports) && fast_configuration;
+  if (fast_configuration && apply_fast_configuration != fast_configuration) {
+    VTR_LOG_WARN("Disable fast configuration even it is enabled by user\n");
+  }
+
+  bool bit_value_to_skip = false;
+  if (apply_fast_configuration) {
+    bit_value_to_skip = find_bit_value_to_skip_for_fast_configuration(
+      config_protocol.type(), global_ports, bitstream_manager,
+      fabric_bitstream);
+  }
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(fname,
+          std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  check_file_stream(fname.c_str(), fp);
+
+  int status = write_config_chain_fabric_bitstream_to_image_file(
+    fp, word_size, apply_fast_configuration, bit_value_to_skip,
+    bitstream_manager, fabric_bitstream, verbose);
+
+  /* Close file handler */
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Outputted %lu configuration bits to programming image: %s\n",
+           fabric_bitstream.num_bits(), fname.c_str());
+
+  return status;
+}
+
+} /* end namespace openfpga */
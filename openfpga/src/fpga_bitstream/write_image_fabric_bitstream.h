@@ -0,0 +1,31 @@
+#ifndef WRITE_IMAGE_FABRIC_BITSTREAM_H
+#define WRITE_IMAGE_FABRIC_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+#include "bitstream_manager.h"
+#include "config_protocol.h"
+#include "fabric_bitstream.h"
+#include "fabric_global_port_info.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int write_fabric_bitstream_to_image_file(
+  const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream,
+  const ConfigProtocol& config_protocol,
+  const FabricGlobalPortInfo& global_ports, const std::string& fname,
+  const size_t& word_size, const bool& fast_configuration,
+  const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -1,6 +1,6 @@
 /********************************************************************
  * This file includes functions that output a fabric-dependent
- * bitstream database to files in plain text
+ * bitstream database to files in plain text or in binary
  *******************************************************************/
 #include <chrono>
 #include <ctime>
@@ -13,11 +13,14 @@
 
 /* Headers from openfpgautil library */
 #include "bitstream_manager_utils.h"
+#include "fabric_bitstream_file_writer.h"
 #include "fabric_bitstream_utils.h"
 #include "fast_configuration.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_decode.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
+#include "openfpga_trace.h"
 #include "openfpga_version.h"
 #include "write_text_fabric_bitstream.h"
 
@@ -28,17 +31,20 @@ namespace openfpga {
  * This function write header information to a bitstream file
  *******************************************************************/
 static void write_fabric_bitstream_text_file_head(
-  std::fstream& fp, const bool& include_time_stamp) {
-  valid_file_stream(fp);
-
-  fp << "// Fabric bitstream" << std::endl;
+  FabricBitstreamFileWriter& writer, const bool& include_time_stamp) {
+  writer.write_comment("// Fabric bitstream");
 
   if (include_time_stamp) {
     auto end = std::chrono::system_clock::now();
     std::time_t end_time = std::chrono::system_clock::to_time_t(end);
     /* Note that version is also a type of time stamp */
-    fp << "// Version: " << openfpga::VERSION << std::endl;
-    fp << "// Date: " << std::ctime(&end_time);
+    writer.write_comment(std::string("// Version: ") + openfpga::VERSION);
+    /* The date string ends with a new line already */
+    std::string date(std::ctime(&end_time));
+    if (!date.empty() && '\n' == date.back()) {
+      date.pop_back();
+    }
+    writer.write_comment("// Date: " + date);
   }
 }
 
@@ -50,18 +56,22 @@ static void write_fabric_bitstream_text_file_head(
  *  - 1 if critical errors occured
  *******************************************************************/
 static int write_flatten_fabric_bitstream_to_text_file(
-  std::fstream& fp, const BitstreamManager& bitstream_manager,
+  FabricBitstreamFileWriter& writer, const ConfigProtocol& config_protocol,
+  const BitstreamManager& bitstream_manager,
   const FabricBitstream& fabric_bitstream) {
-  if (false == valid_file_stream(fp)) {
-    return 1;
-  }
-
   /* Output bitstream size information */
-  fp << "// Bitstream length: " << fabric_bitstream.num_bits() << std::endl;
+  writer.write_comment("// Bitstream length: " +
+                       std::to_string(fabric_bitstream.num_bits()));
+  FabricBitstreamFileHeader header;
+  header.num_regions = fabric_bitstream.num_regions();
+  header.num_rows = 1;
+  header.din_width = fabric_bitstream.num_bits();
+  writer.write_header(config_protocol, header);
 
   /* Output bitstream data */
-  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
-    fp << bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
+  for (const FabricBitId& fabric_bit : fabric_bitstream.dense_bits()) {
+    writer.write_bit(
+      bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)));
   }
 
   return 0;
@@ -76,16 +86,16 @@ static int write_flatten_fabric_bitstream_to_text_file(
  *  - 1 if critical errors occured
  *******************************************************************/
 static int write_config_chain_fabric_bitstream_to_text_file(
-  std::fstream& fp, const bool& fast_configuration,
+  FabricBitstreamFileWriter& writer, const ConfigProtocol& config_protocol,
+  const bool& fast_configuration,
   const bool& bit_value_to_skip, const BitstreamManager& bitstream_manager,
   const FabricBitstream& fabric_bitstream) {
   int status = 0;
 
-  size_t regional_bitstream_max_size =
-    find_fabric_regional_bitstream_max_size(fabric_bitstream);
   ConfigChainFabricBitstream regional_bitstreams =
     build_config_chain_fabric_bitstream_by_region(bitstream_manager,
                                                   fabric_bitstream);
+  size_t regional_bitstream_max_size = regional_bitstreams.num_rows();
 
   /* For fast configuration, the bitstream size counts from the first bit '1' */
   size_t num_bits_to_skip = 0;
@@ -102,19 +112,26 @@ static int write_config_chain_fabric_bitstream_to_text_file(
   }
 
   /* Output bitstream size information */
-  fp << "// Bitstream length: "
-     << regional_bitstream_max_size - num_bits_to_skip << std::endl;
-  fp << "// Bitstream width (LSB -> MSB): " << fabric_bitstream.num_regions()
-     << std::endl;
+  writer.write_comment(
+    "// Bitstream length: " +
+    std::to_string(regional_bitstream_max_size - num_bits_to_skip));
+  writer.write_comment("// Bitstream width (LSB -> MSB): " +
+                       std::to_string(fabric_bitstream.num_regions()));
+  FabricBitstreamFileHeader header;
+  header.num_regions = fabric_bitstream.num_regions();
+  header.num_rows = regional_bitstream_max_size - num_bits_to_skip;
+  header.num_skipped_rows = num_bits_to_skip;
+  header.din_width = fabric_bitstream.num_regions();
+  writer.write_header(config_protocol, header);
 
   /* Output bitstream data */
   for (size_t ibit = num_bits_to_skip; ibit < regional_bitstream_max_size;
        ++ibit) {
-    for (const auto& region_bitstream : regional_bitstreams) {
-      fp << region_bitstream[ibit];
+    for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+      writer.write_bit(regional_bitstreams.bit_value(ibit, region));
     }
     if (ibit < regional_bitstream_max_size - 1) {
-      fp << std::endl;
+      writer.end_row();
     }
   }
 
@@ -130,7 +147,8 @@ static int write_config_chain_fabric_bitstream_to_text_file(
  *  - 1 if critical errors occured
  *******************************************************************/
 static int write_memory_bank_fabric_bitstream_to_text_file(
-  std::fstream& fp, const bool& fast_configuration,
+  FabricBitstreamFileWriter& writer, const ConfigProtocol& config_protocol,
+  const bool& fast_configuration,
   const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream) {
   int status = 0;
 
@@ -150,7 +168,7 @@ static int write_memory_bank_fabric_bitstream_to_text_file(
     num_bits_to_skip =
       fabric_bits_by_addr.size() -
       find_memory_bank_fast_configuration_fabric_bitstream_size(
-        fabric_bitstream, bit_value_to_skip);
+        fabric_bits_by_addr, bit_value_to_skip);
     VTR_ASSERT(num_bits_to_skip < fabric_bits_by_addr.size());
     VTR_LOG(
       "Fast configuration will skip %g% (%lu/%lu) of configuration "
@@ -160,13 +178,21 @@ static int write_memory_bank_fabric_bitstream_to_text_file(
   }
 
   /* Output information about how to intepret the bitstream */
-  fp << "// Bitstream length: " << fabric_bits_by_addr.size() - num_bits_to_skip
-     << std::endl;
-  fp << "// Bitstream width (LSB -> MSB): ";
-  fp << "<bl_address " << bl_addr_size << " bits>";
-  fp << "<wl_address " << wl_addr_size << " bits>";
-  fp << "<data input " << din_size << " bits>";
-  fp << std::endl;
+  writer.write_comment(
+    "// Bitstream length: " +
+    std::to_string(fabric_bits_by_addr.size() - num_bits_to_skip));
+  writer.write_comment("// Bitstream width (LSB -> MSB): <bl_address " +
+                       std::to_string(bl_addr_size) + " bits><wl_address " +
+                       std::to_string(wl_addr_size) + " bits><data input " +
+                       std::to_string(din_size) + " bits>");
+  FabricBitstreamFileHeader header;
+  header.num_regions = fabric_bitstream.num_regions();
+  header.num_rows = fabric_bits_by_addr.size() - num_bits_to_skip;
+  header.num_skipped_rows = num_bits_to_skip;
+  header.bl_address_width = bl_addr_size;
+  header.wl_address_width = wl_addr_size;
+  header.din_width = din_size;
+  writer.write_header(config_protocol, header);
 
   for (const auto& addr_din_pair : fabric_bits_by_addr) {
     /* When fast configuration is enabled,
@@ -175,21 +201,19 @@ static int write_memory_bank_fabric_bitstream_to_text_file(
      * skipped, the programming cycle can be skipped!
      */
     if (true == fast_configuration) {
-      if (addr_din_pair.second ==
-          std::vector<bool>(addr_din_pair.second.size(), bit_value_to_skip)) {
+      if (true == is_fabric_din_all_of_value(addr_din_pair.second,
+                                             bit_value_to_skip)) {
         continue;
       }
     }
 
     /* Write BL address code */
-    fp << addr_din_pair.first.first;
+    writer.write_bits(addr_din_pair.first.first);
     /* Write WL address code */
-    fp << addr_din_pair.first.second;
+    writer.write_bits(addr_din_pair.first.second);
     /* Write data input */
-    for (const bool& din_value : addr_din_pair.second) {
-      fp << din_value;
-    }
-    fp << std::endl;
+    writer.write_bits(addr_din_pair.second);
+    writer.end_row();
   }
 
   return status;
@@ -204,7 +228,8 @@ static int write_memory_bank_fabric_bitstream_to_text_file(
  *  - 1 if critical errors occured
  *******************************************************************/
 static int write_memory_bank_flatten_fabric_bitstream_to_text_file(
-  std::fstream& fp, const bool& fast_configuration,
+  FabricBitstreamFileWriter& writer, const ConfigProtocol& config_protocol,
+  const bool& fast_configuration,
   const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream,
   const bool& keep_dont_care_bits) {
   int status = 0;
@@ -224,22 +249,28 @@ static int write_memory_bank_flatten_fabric_bitstream_to_text_file(
   size_t wl_addr_size = fabric_bits.wl_vector_size();
 
   /* Output information about how to intepret the bitstream */
-  fp << "// Bitstream length: " << fabric_bits.size() << std::endl;
-  fp << "// Bitstream width (LSB -> MSB): ";
-  fp << "<bl_address " << bl_addr_size << " bits>";
-  fp << "<wl_address " << wl_addr_size << " bits>";
-  fp << std::endl;
-
-  for (const auto& wl_vec : fabric_bits.wl_vectors()) {
+  writer.write_comment("// Bitstream length: " +
+                       std::to_string(fabric_bits.size()));
+  writer.write_comment("// Bitstream width (LSB -> MSB): <bl_address " +
+                       std::to_string(bl_addr_size) + " bits><wl_address " +
+                       std::to_string(wl_addr_size) + " bits>");
+  FabricBitstreamFileHeader header;
+  header.num_regions = fabric_bitstream.num_regions();
+  header.num_rows = fabric_bits.size();
+  header.bl_address_width = bl_addr_size;
+  header.wl_address_width = wl_addr_size;
+  writer.write_header(config_protocol, header);
+
+  for (const auto& wl_bl_vec : fabric_bits) {
     /* Write BL address code */
-    for (const auto& bl_unit : fabric_bits.bl_vector(wl_vec)) {
-      fp << bl_unit;
+    for (const auto& bl_unit : wl_bl_vec.second) {
+      writer.write_bits(bl_unit);
     }
     /* Write WL address code */
-    for (const auto& wl_unit : wl_vec) {
-      fp << wl_unit;
+    for (const auto& wl_unit : wl_bl_vec.first) {
+      writer.write_bits(wl_unit);
     }
-    fp << std::endl;
+    writer.end_row();
   }
 
   return status;
@@ -254,10 +285,11 @@ static int write_memory_bank_flatten_fabric_bitstream_to_text_file(
  *  - 1 if critical errors occured
  *******************************************************************/
 static int write_memory_bank_shift_register_fabric_bitstream_to_text_file(
-  std::fstream& fp, const bool& fast_configuration,
+  FabricBitstreamFileWriter& writer, const ConfigProtocol& config_protocol,
+  const bool& fast_configuration,
   const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks,
-  const bool& keep_dont_care_bits) {
+  const bool& keep_dont_care_bits, const size_t& num_threads) {
   int status = 0;
 
   char dont_care_bit = '0';
@@ -267,36 +299,48 @@ static int write_memory_bank_shift_register_fabric_bitstream_to_text_file(
   MemoryBankShiftRegisterFabricBitstream fabric_bits =
     build_memory_bank_shift_register_fabric_bitstream(
       fabric_bitstream, blwl_sr_banks, fast_configuration, bit_value_to_skip,
-      dont_care_bit);
+      dont_care_bit, num_threads);
 
   /* Output information about how to intepret the bitstream */
-  fp << "// Bitstream word count: " << fabric_bits.num_words() << std::endl;
-  fp << "// Bitstream bl word size: " << fabric_bits.bl_word_size()
-     << std::endl;
-  fp << "// Bitstream wl word size: " << fabric_bits.wl_word_size()
-     << std::endl;
-  fp << "// Bitstream width (LSB -> MSB): ";
-  fp << "<bl shift register heads " << fabric_bits.bl_width() << " bits>";
-  fp << "<wl shift register heads " << fabric_bits.wl_width() << " bits>";
-  fp << std::endl;
+  writer.write_comment("// Bitstream word count: " +
+                       std::to_string(fabric_bits.num_words()));
+  writer.write_comment("// Bitstream bl word size: " +
+                       std::to_string(fabric_bits.bl_word_size()));
+  writer.write_comment("// Bitstream wl word size: " +
+                       std::to_string(fabric_bits.wl_word_size()));
+  writer.write_comment(
+    "// Bitstream width (LSB -> MSB): <bl shift register heads " +
+    std::to_string(fabric_bits.bl_width()) +
+    " bits><wl shift register heads " + std::to_string(fabric_bits.wl_width()) +
+    " bits>");
+  /* Each word consists of the BL rows followed by the WL rows */
+  FabricBitstreamFileHeader header;
+  header.num_regions = fabric_bitstream.num_regions();
+  header.num_rows = fabric_bits.num_words() *
+                    (fabric_bits.bl_word_size() + fabric_bits.wl_word_size());
+  header.bl_address_width = fabric_bits.bl_width();
+  header.wl_address_width = fabric_bits.wl_width();
+  header.bl_word_size = fabric_bits.bl_word_size();
+  header.wl_word_size = fabric_bits.wl_word_size();
+  writer.write_header(config_protocol, header);
 
   size_t word_cnt = 0;
 
   for (const auto& word : fabric_bits.words()) {
-    fp << "// Word " << word_cnt << std::endl;
+    writer.write_comment("// Word " + std::to_string(word_cnt));
 
     /* Write BL address code */
-    fp << "// BL part " << std::endl;
+    writer.write_comment("// BL part ");
     for (const auto& bl_vec : fabric_bits.bl_vectors(word)) {
-      fp << bl_vec;
-      fp << std::endl;
+      writer.write_bits(bl_vec);
+      writer.end_row();
     }
 
     /* Write WL address code */
-    fp << "// WL part " << std::endl;
+    writer.write_comment("// WL part ");
     for (const auto& wl_vec : fabric_bits.wl_vectors(word)) {
-      fp << wl_vec;
-      fp << std::endl;
+      writer.write_bits(wl_vec);
+      writer.end_row();
     }
 
     word_cnt++;
@@ -314,8 +358,9 @@ static int write_memory_bank_shift_register_fabric_bitstream_to_text_file(
  *  - 1 if critical errors occured
  *******************************************************************/
 static int write_frame_based_fabric_bitstream_to_text_file(
-  std::fstream& fp, const bool& fast_configuration,
-  const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream) {
+  FabricBitstreamFileWriter& writer, const ConfigProtocol& config_protocol,
+  const bool& fast_configuration, const bool& bit_value_to_skip,
+  const FabricBitstream& fabric_bitstream, const bool& verbose) {
   int status = 0;
 
   FrameFabricBitstream fabric_bits_by_addr =
@@ -333,7 +378,7 @@ static int write_frame_based_fabric_bitstream_to_text_file(
     num_bits_to_skip =
       fabric_bits_by_addr.size() -
       find_frame_based_fast_configuration_fabric_bitstream_size(
-        fabric_bitstream, bit_value_to_skip);
+        fabric_bits_by_addr, bit_value_to_skip);
     VTR_ASSERT(num_bits_to_skip < fabric_bits_by_addr.size());
     VTR_LOG(
       "Fast configuration will skip %g% (%lu/%lu) of configuration "
@@ -342,11 +387,32 @@ static int write_frame_based_fabric_bitstream_to_text_file(
       num_bits_to_skip, fabric_bits_by_addr.size());
   }
 
+  /* Report how many writes would be saved if a write could program all the
+   * addresses matching an address mask with the same data inputs */
+  if (true == verbose) {
+    size_t num_multicast_writes =
+      find_frame_based_multicast_fabric_bitstream_size(
+        fabric_bits_by_addr, fast_configuration, bit_value_to_skip);
+    VTR_LOG(
+      "Multicast writes with address masks would program the %lu rows of "
+      "configuration bitstream in %lu writes.\n",
+      fabric_bits_by_addr.size() - num_bits_to_skip, num_multicast_writes);
+  }
+
   /* Output information about how to intepret the bitstream */
-  fp << "// Bitstream length: " << fabric_bits_by_addr.size() - num_bits_to_skip
-     << std::endl;
-  fp << "// Bitstream width (LSB -> MSB): <address " << addr_size
-     << " bits><data input " << din_size << " bits>" << std::endl;
+  writer.write_comment(
+    "// Bitstream length: " +
+    std::to_string(fabric_bits_by_addr.size() - num_bits_to_skip));
+  writer.write_comment("// Bitstream width (LSB -> MSB): <address " +
+                       std::to_string(addr_size) + " bits><data input " +
+                       std::to_string(din_size) + " bits>");
+  FabricBitstreamFileHeader header;
+  header.num_regions = fabric_bitstream.num_regions();
+  header.num_rows = fabric_bits_by_addr.size() - num_bits_to_skip;
+  header.num_skipped_rows = num_bits_to_skip;
+  header.address_width = addr_size;
+  header.din_width = din_size;
+  writer.write_header(config_protocol, header);
 
   for (const auto& addr_din_pair : fabric_bits_by_addr) {
     /* When fast configuration is enabled,
@@ -355,32 +421,33 @@ static int write_frame_based_fabric_bitstream_to_text_file(
      * skipped, the programming cycle can be skipped!
      */
     if (true == fast_configuration) {
-      if (addr_din_pair.second ==
-          std::vector<bool>(addr_din_pair.second.size(), bit_value_to_skip)) {
+      if (true == is_fabric_din_all_of_value(addr_din_pair.second,
+                                             bit_value_to_skip)) {
         continue;
       }
     }
 
     /* Write address code */
-    fp << addr_din_pair.first;
+    writer.write_bits(addr_din_pair.first);
 
     /* Write data input */
-    for (const bool& din_value : addr_din_pair.second) {
-      fp << din_value;
-    }
-    fp << std::endl;
+    writer.write_bits(addr_din_pair.second);
+    writer.end_row();
   }
 
   return status;
 }
 
 /********************************************************************
- * Write the fabric bitstream to a plain text file
+ * Write the fabric bitstream to a plain text file, or to a binary file
+ * when binary is enabled
  * Notes:
  *   - This is the final bitstream which is loadable to the FPGA fabric
  *     (Verilog netlists etc.)
  *   - Do NOT include any comments or other characters that the 0|1 bitstream
  *content in this file
+ *   - The binary file starts with a header describing the rows, which are
+ *     packed into bytes. Don't care bits are not supported in binary
  *
  * Return:
  *  - 0 if succeed
@@ -393,7 +460,8 @@ int write_fabric_bitstream_to_text_file(
   const ConfigProtocol& config_protocol,
   const FabricGlobalPortInfo& global_ports, const std::string& fname,
   const bool& fast_configuration, const bool& keep_dont_care_bits,
-  const bool& include_time_stamp, const bool& verbose) {
+  const bool& binary, const bool& hex, const bool& include_time_stamp,
+  const size_t& num_threads, const bool& verbose) {
   /* Ensure that we have a valid file name */
   if (true == fname.empty()) {
     VTR_LOG_ERROR(
@@ -403,16 +471,33 @@ int write_fabric_bitstream_to_text_file(
 
   std::string timer_message =
     std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) +
-    std::string(" fabric bitstream into plain text file '") + fname +
-    std::string("'");
+    std::string(" fabric bitstream into ") +
+    std::string(binary ? "binary" : (hex ? "hex" : "plain text")) +
+    std::string(" file '") + fname + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  if (binary) {
+    fp.open(fname,
+            std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  } else {
+    fp.open(fname, std::fstream::out | std::fstream::trunc);
+  }
 
   check_file_stream(fname.c_str(), fp);
 
+  FabricBitstreamFileWriter writer(fp, binary, hex);
+
+  bool apply_keep_dont_care_bits = keep_dont_care_bits && !binary && !hex;
+  if (keep_dont_care_bits && !apply_keep_dont_care_bits) {
+    VTR_LOG_WARN(
+      "Don't care bits are written as '0' in %s format even it is "
+      "enabled by user\n",
+      binary ? "binary" : "hex");
+  }
+
   bool apply_fast_configuration =
     is_fast_configuration_applicable(global_ports) && fast_configuration;
   if (fast_configuration && apply_fast_configuration != fast_configuration) {
@@ -427,19 +512,19 @@ int write_fabric_bitstream_to_text_file(
   }
 
   /* Write file head */
-  write_fabric_bitstream_text_file_head(fp, include_time_stamp);
+  write_fabric_bitstream_text_file_head(writer, include_time_stamp);
 
   /* Output fabric bitstream to the file */
   int status = 0;
   switch (config_protocol.type()) {
     case CONFIG_MEM_STANDALONE:
       status = write_flatten_fabric_bitstream_to_text_file(
-        fp, bitstream_manager, fabric_bitstream);
+        writer, config_protocol, bitstream_manager, fabric_bitstream);
       break;
     case CONFIG_MEM_SCAN_CHAIN:
       status = write_config_chain_fabric_bitstream_to_text_file(
-        fp, apply_fast_configuration, bit_value_to_skip, bitstream_manager,
-        fabric_bitstream);
+        writer, config_protocol, apply_fast_configuration, bit_value_to_skip,
+        bitstream_manager, fabric_bitstream);
       break;
     case CONFIG_MEM_QL_MEMORY_BANK: {
       /* Bitstream organization depends on the BL/WL protocols
@@ -453,28 +538,31 @@ int write_fabric_bitstream_to_text_file(
        */
       if (BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) {
         status = write_memory_bank_fabric_bitstream_to_text_file(
-          fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream);
+          writer, config_protocol, apply_fast_configuration, bit_value_to_skip,
+          fabric_bitstream);
       } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type()) {
         status = write_memory_bank_flatten_fabric_bitstream_to_text_file(
-          fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream,
-          keep_dont_care_bits);
+          writer, config_protocol, apply_fast_configuration, bit_value_to_skip,
+          fabric_bitstream, apply_keep_dont_care_bits);
       } else {
         VTR_ASSERT(BLWL_PROTOCOL_SHIFT_REGISTER ==
                    config_protocol.bl_protocol_type());
         status = write_memory_bank_shift_register_fabric_bitstream_to_text_file(
-          fp, apply_fast_configuration, bit_value_to_skip,
-
-          fabric_bitstream, blwl_sr_banks, keep_dont_care_bits);
+          writer, config_protocol, apply_fast_configuration, bit_value_to_skip,
+          fabric_bitstream, blwl_sr_banks, apply_keep_dont_care_bits,
+          num_threads);
       }
       break;
     }
     case CONFIG_MEM_MEMORY_BANK:
       status = write_memory_bank_fabric_bitstream_to_text_file(
-        fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream);
+        writer, config_protocol, apply_fast_configuration, bit_value_to_skip,
+        fabric_bitstream);
       break;
     case CONFIG_MEM_FRAME_BASED:
       status = write_frame_based_fabric_bitstream_to_text_file(
-        fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream);
+        writer, config_protocol, apply_fast_configuration, bit_value_to_skip,
+        fabric_bitstream, verbose);
       break;
     default:
       VTR_LOGF_ERROR(__FILE__, __LINE__,
@@ -483,13 +571,15 @@ int write_fabric_bitstream_to_text_file(
   }
 
   /* Print an end to the file here */
-  fp << std::endl;
+  writer.end_file();
 
   /* Close file handler */
   fp.close();
 
-  VTR_LOGV(verbose, "Outputted %lu configuration bits to plain text file: %s\n",
-           fabric_bitstream.bits().size(), fname.c_str());
+  VTR_LOGV(verbose, "Outputted %lu configuration bits to %s file: %s\n",
+           fabric_bitstream.num_bits(),
+           binary ? "binary" : (hex ? "hex" : "plain text"),
+           fname.c_str());
 
   return status;
 }
@@ -12,11 +12,12 @@
 #include "vtr_time.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
+#include "openfpga_trace.h"
 
 /* Headers from archopenfpga library */
 
-#include "bitstream_manager_utils.h"
 #include "openfpga_naming.h"
 #include "write_xml_fabric_bitstream.h"
 
@@ -30,10 +31,10 @@ static void write_fabric_bitstream_xml_file_head(
   std::fstream& fp, const bool& include_time_stamp) {
   valid_file_stream(fp);
 
-  fp << "<!--" << std::endl;
-  fp << "\t- Fabric bitstream" << std::endl;
-  fp << "\t- Author: Xifan TANG" << std::endl;
-  fp << "\t- Organization: University of Utah" << std::endl;
+  fp << "<!--" << '\n';
+  fp << "\t- Fabric bitstream" << '\n';
+  fp << "\t- Author: Xifan TANG" << '\n';
+  fp << "\t- Organization: University of Utah" << '\n';
 
   auto end = std::chrono::system_clock::now();
   std::time_t end_time = std::chrono::system_clock::to_time_t(end);
@@ -41,8 +42,8 @@ static void write_fabric_bitstream_xml_file_head(
     fp << "\t- Date: " << std::ctime(&end_time);
   }
 
-  fp << "-->" << std::endl;
-  fp << std::endl;
+  fp << "-->" << '\n';
+  fp << '\n';
 }
 
 /********************************************************************
@@ -86,18 +87,12 @@ static int write_fabric_config_bit_to_xml_file(
   const ConfigBitId& config_bit = fabric_bitstream.config_bit(fabric_bit);
   const ConfigBlockId& config_block =
     bitstream_manager.bit_parent_block(config_bit);
-  std::vector<ConfigBlockId> block_hierarchy =
-    find_bitstream_manager_block_hierarchy(bitstream_manager, config_block);
-  std::string hie_path;
-  for (const ConfigBlockId& temp_block : block_hierarchy) {
-    hie_path += bitstream_manager.block_name(temp_block);
-    hie_path += std::string(".");
-  }
+  std::string hie_path = bitstream_manager.block_path(config_block);
+  hie_path += std::string(".");
   hie_path += generate_configurable_memory_data_out_name();
   hie_path += std::string("[");
   hie_path +=
-    std::to_string(find_bitstream_manager_config_bit_index_in_parent_block(
-      bitstream_manager, config_bit));
+    std::to_string(bitstream_manager.bit_index_in_parent_block(config_bit));
   hie_path += std::string("]");
 
   fp << " path=\"" << hie_path << "\">\n";
@@ -213,9 +208,10 @@ int write_fabric_bitstream_to_xml_file(
     std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) +
     std::string(" fabric bitstream into xml file '") + fname + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(fname.c_str(), fp);
@@ -244,7 +240,7 @@ int write_fabric_bitstream_to_xml_file(
   fp.close();
 
   VTR_LOGV(verbose, "Outputted %lu configuration bits to XML file: %s\n",
-           fabric_bitstream.bits().size(), fname.c_str());
+           fabric_bitstream.num_bits(), fname.c_str());
 
   return status;
 }
@@ -2,6 +2,7 @@
  * This file includes functions that output io mapping information
  * to files in XML format
  *******************************************************************/
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <fstream>
@@ -12,7 +13,10 @@
 #include "vtr_time.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
+#include "openfpga_trace.h"
 
 /* Headers from archopenfpga library */
 #include "build_io_mapping_info.h"
@@ -30,61 +34,55 @@ static void write_io_mapping_xml_file_head(std::fstream& fp,
                                            const bool& include_time_stamp) {
   valid_file_stream(fp);
 
-  fp << "<!--" << std::endl;
-  fp << "\t- I/O mapping" << std::endl;
+  fp << "<!--" << '\n';
+  fp << "\t- I/O mapping" << '\n';
 
   if (include_time_stamp) {
     auto end = std::chrono::system_clock::now();
     std::time_t end_time = std::chrono::system_clock::to_time_t(end);
     /* Note that version is also a type of time stamp */
-    fp << "\t- Version: " << openfpga::VERSION << std::endl;
+    fp << "\t- Version: " << openfpga::VERSION << '\n';
     fp << "\t- Date: " << std::ctime(&end_time);
   }
 
-  fp << "-->" << std::endl;
-  fp << std::endl;
+  fp << "-->" << '\n';
+  fp << '\n';
 }
 
+/* Number of I/O mappings formatted by each task */
+constexpr size_t IO_MAPPING_CHUNK_SIZE = 4096;
+
 /********************************************************************
- * Write an io mapping pair to an XML file
- *
- * Return:
- *  - 0 if succeed
- *  - 1 if critical errors occured
+ * Append an io mapping pair in XML format to a buffer
  *******************************************************************/
-static int write_io_mapping_pair_to_xml_file(std::fstream& fp,
-                                             const IoMap& io_map,
-                                             const IoMapId& io_map_id,
-                                             int xml_hierarchy_depth) {
-  if (false == valid_file_stream(fp)) {
-    return 1;
-  }
-
-  write_tab_to_file(fp, xml_hierarchy_depth);
+static void append_io_mapping_pair_to_xml(std::string& buffer,
+                                          const IoMap& io_map,
+                                          const IoMapId& io_map_id,
+                                          int xml_hierarchy_depth) {
+  buffer.append(xml_hierarchy_depth, '\t');
 
   BasicPort io_port = io_map.io_port(io_map_id);
-  fp << "<io ";
-  fp << "name=\"" << io_port.get_name().c_str() << "[" << io_port.get_lsb()
-     << ":" << io_port.get_msb() << "]"
-     << "\"";
+  buffer += "<io name=\"";
+  buffer += io_port.get_name();
+  buffer += "[";
+  buffer += std::to_string(io_port.get_lsb());
+  buffer += ":";
+  buffer += std::to_string(io_port.get_msb());
+  buffer += "]\"";
 
   VTR_ASSERT(1 == io_map.io_net(io_map_id).get_width());
-  fp << " net=\"" << io_map.io_net(io_map_id).get_name().c_str() << "\"";
+  buffer += " net=\"";
+  buffer += io_map.io_net(io_map_id).get_name();
+  buffer += "\"";
 
   if (io_map.is_io_input(io_map_id)) {
-    fp << " dir=\""
-       << "input"
-       << "\"";
+    buffer += " dir=\"input\"";
   } else {
     VTR_ASSERT_SAFE(io_map.is_io_output(io_map_id));
-    fp << " dir=\""
-       << "output"
-       << "\"";
+    buffer += " dir=\"output\"";
   }
 
-  fp << "/>\n";
-
-  return 0;
+  buffer += "/>\n";
 }
 
 /********************************************************************
@@ -93,6 +91,10 @@ static int write_io_mapping_pair_to_xml_file(std::fstream& fp,
  *   - This file is designed for users to learn
  *     - what nets are mapped to each I/O is mapped, io[0] -> netA
  *     - what directionality is applied to each I/O, io[0] -> input
+ *   - The mappings are formatted in chunks by parallel tasks, which fill
+ *     their own preallocated buffers. The buffers are written to the file
+ *     in sequence, so that the file does not depend on the number of
+ *     threads
  *
  * Return:
  *  - 0 if succeed
@@ -100,6 +102,7 @@ static int write_io_mapping_pair_to_xml_file(std::fstream& fp,
  *******************************************************************/
 int write_io_mapping_to_xml_file(const IoMap& io_map, const std::string& fname,
                                  const bool& include_time_stamp,
+                                 const size_t& num_threads,
                                  const bool& verbose) {
   /* Ensure that we have a valid file name */
   if (true == fname.empty()) {
@@ -112,9 +115,10 @@ int write_io_mapping_to_xml_file(const IoMap& io_map, const std::string& fname,
   std::string timer_message =
     std::string("Write I/O mapping into xml file '") + fname + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(fname.c_str(), fp);
@@ -125,28 +129,39 @@ int write_io_mapping_to_xml_file(const IoMap& io_map, const std::string& fname,
   int xml_hierarchy_depth = 0;
   fp << "<io_mapping>\n";
 
-  /* Output fabric bitstream to the file */
-  int status = 0;
-  int io_map_cnt = 0;
-  for (const auto& io_map_id : io_map.io_map()) {
-    status = write_io_mapping_pair_to_xml_file(fp, io_map, io_map_id,
-                                               xml_hierarchy_depth + 1);
-    io_map_cnt++;
-    if (1 == status) {
-      break;
+  /* Output the io mappings to the file */
+  std::vector<IoMapId> io_map_ids(io_map.io_map().begin(),
+                                  io_map.io_map().end());
+  size_t num_chunks =
+    (io_map_ids.size() + IO_MAPPING_CHUNK_SIZE - 1) / IO_MAPPING_CHUNK_SIZE;
+  std::vector<std::string> chunk_buffers(num_chunks);
+  parallel_for(num_chunks, num_threads, [&](const size_t& ichunk) {
+    size_t begin = ichunk * IO_MAPPING_CHUNK_SIZE;
+    size_t end = std::min(io_map_ids.size(), begin + IO_MAPPING_CHUNK_SIZE);
+    std::string& buffer = chunk_buffers[ichunk];
+    /* Most of the lines are shorter than this */
+    buffer.reserve((end - begin) * 80);
+    for (size_t imap = begin; imap < end; ++imap) {
+      append_io_mapping_pair_to_xml(buffer, io_map, io_map_ids[imap],
+                                    xml_hierarchy_depth + 1);
     }
+  });
+  for (std::string& buffer : chunk_buffers) {
+    fp.write(buffer.data(), buffer.size());
+    /* Release the memory as soon as a chunk is written */
+    std::string().swap(buffer);
   }
 
   /* Print an end to the file here */
   fp << "</io_mapping>\n";
 
-  VTR_LOGV(verbose, "Outputted %d I/O mapping to file '%s'\n", io_map_cnt,
-           fname.c_str());
+  VTR_LOGV(verbose, "Outputted %lu I/O mapping to file '%s'\n",
+           io_map_ids.size(), fname.c_str());
 
   /* Close file handler */
   fp.close();
 
-  return status;
+  return 0;
 }
 
 } /* end namespace openfpga */
@@ -42,16 +42,16 @@ static void rec_print_analysis_sdc_disable_unused_pb_graph_nodes(
   /* Disable all the ports of current module (parent_module)!
    * Hierarchy name already includes the instance name of parent_module
    */
-  fp << "#######################################" << std::endl;
+  fp << "#######################################" << '\n';
   fp << "# Disable all the ports for pb_graph_node "
      << physical_pb_graph_node->pb_type->name << "["
-     << physical_pb_graph_node->placement_index << "]" << std::endl;
-  fp << "#######################################" << std::endl;
+     << physical_pb_graph_node->placement_index << "]" << '\n';
+  fp << "#######################################" << '\n';
 
   fp << "set_disable_timing ";
   fp << hierarchy_name;
   fp << "*";
-  fp << std::endl;
+  fp << '\n';
 
   /* Return if this is the primitive pb_type */
   if (true == is_primitive_pb_type(physical_pb_type)) {
@@ -75,9 +75,7 @@ static void rec_print_analysis_sdc_disable_unused_pb_graph_nodes(
     for (int inst = 0; inst < physical_mode->pb_type_children[ichild].num_pb;
          ++inst) {
       std::string child_instance_name =
-        module_manager.instance_name(parent_module, child_module,
-                                     module_manager.child_module_instances(
-                                       parent_module, child_module)[inst]);
+        module_manager.instance_name(parent_module, child_module, inst);
       /* Must have a valid instance name!!! */
       VTR_ASSERT(false == child_instance_name.empty());
 
@@ -128,7 +126,7 @@ static void disable_pb_graph_node_unused_pin(
   fp << "set_disable_timing ";
   fp << hierarchy_name;
   fp << generate_sdc_port(port_to_disable);
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -145,11 +143,11 @@ static void disable_pb_graph_node_unused_pins(
   const PhysicalPbId& pb_id = physical_pb.find_pb(physical_pb_graph_node);
   VTR_ASSERT(true == physical_pb.valid_pb_id(pb_id));
 
-  fp << "#######################################" << std::endl;
+  fp << "#######################################" << '\n';
   fp << "# Disable unused pins for pb_graph_node "
      << physical_pb_graph_node->pb_type->name << "["
-     << physical_pb_graph_node->placement_index << "]" << std::endl;
-  fp << "#######################################" << std::endl;
+     << physical_pb_graph_node->placement_index << "]" << '\n';
+  fp << "#######################################" << '\n';
 
   /* Disable unused input pins */
   for (int iport = 0; iport < physical_pb_graph_node->num_input_ports;
@@ -196,11 +194,11 @@ static void disable_pb_graph_node_unused_mux_inputs(
   const ModuleManager& module_manager, const ModuleId& parent_module,
   const std::string& hierarchy_name, t_pb_graph_node* physical_pb_graph_node,
   const PhysicalPb& physical_pb) {
-  fp << "#######################################" << std::endl;
+  fp << "#######################################" << '\n';
   fp << "# Disable unused mux_inputs for pb_graph_node "
      << physical_pb_graph_node->pb_type->name << "["
-     << physical_pb_graph_node->placement_index << "]" << std::endl;
-  fp << "#######################################" << std::endl;
+     << physical_pb_graph_node->placement_index << "]" << '\n';
+  fp << "#######################################" << '\n';
 
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
 
@@ -489,9 +487,7 @@ static void rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(
                                 .num_pb;
          ++inst) {
       std::string child_instance_name =
-        module_manager.instance_name(parent_module, child_module,
-                                     module_manager.child_module_instances(
-                                       parent_module, child_module)[inst]);
+        module_manager.instance_name(parent_module, child_module, inst);
       /* Must have a valid instance name!!! */
       VTR_ASSERT(false == child_instance_name.empty());
 
@@ -558,19 +554,19 @@ static void print_analysis_sdc_disable_pb_block_unused_resources(
   VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
 
   /* Print comments */
-  fp << "#######################################" << std::endl;
+  fp << "#######################################" << '\n';
 
   if (true == unused_block) {
     fp << "# Disable Timing for unused grid[" << grid_coordinate.x() << "]["
-       << grid_coordinate.y() << "][" << grid_z << "]" << std::endl;
+       << grid_coordinate.y() << "][" << grid_z << "]" << '\n';
   } else {
     VTR_ASSERT_SAFE(false == unused_block);
     fp << "# Disable Timing for unused resources in grid["
        << grid_coordinate.x() << "][" << grid_coordinate.y() << "][" << grid_z
-       << "]" << std::endl;
+       << "]" << '\n';
   }
 
-  fp << "#######################################" << std::endl;
+  fp << "#######################################" << '\n';
 
   std::string hierarchy_name =
     grid_instance_name + std::string("/") + pb_instance_name + std::string("/");
@@ -632,10 +628,10 @@ static void print_analysis_sdc_disable_unused_grid(
   VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
 
   /* Print comments */
-  fp << "#######################################" << std::endl;
+  fp << "#######################################" << '\n';
   fp << "# Disable Timing for grid[" << grid_coordinate.x() << "]["
-     << grid_coordinate.y() << "]" << std::endl;
-  fp << "#######################################" << std::endl;
+     << grid_coordinate.y() << "]" << '\n';
+  fp << "#######################################" << '\n';
 
   /* For used grid, find the unused rr_node in the local rr_graph
    * and then disable each port which is not used
@@ -683,17 +679,19 @@ static void print_analysis_sdc_disable_unused_grid(
  *
  *******************************************************************/
 void print_analysis_sdc_disable_unused_grids(
-  std::fstream& fp, const DeviceGrid& grids,
-  const VprDeviceAnnotation& device_annotation,
+  std::fstream& fp, const std::string& sdc_fname, const size_t& num_threads,
+  const DeviceGrid& grids, const VprDeviceAnnotation& device_annotation,
   const VprClusteringAnnotation& cluster_annotation,
   const VprPlacementAnnotation& place_annotation,
   const ModuleManager& module_manager) {
+  /* Grids to be processed, as pairs of <coordinate, border side> */
+  std::vector<std::pair<vtr::Point<size_t>, e_side>> grid_sections;
+
   /* Process unused core grids */
   for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
     for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
-      print_analysis_sdc_disable_unused_grid(
-        fp, vtr::Point<size_t>(ix, iy), grids, device_annotation,
-        cluster_annotation, place_annotation, module_manager, NUM_SIDES);
+      grid_sections.push_back(
+        std::make_pair(vtr::Point<size_t>(ix, iy), NUM_SIDES));
     }
   }
 
@@ -705,11 +703,18 @@ void print_analysis_sdc_disable_unused_grids(
   /* Add instances of I/O grids to top_module */
   for (const e_side& io_side : FPGA_SIDES_CLOCKWISE) {
     for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
-      print_analysis_sdc_disable_unused_grid(
-        fp, io_coordinate, grids, device_annotation, cluster_annotation,
-        place_annotation, module_manager, io_side);
+      grid_sections.push_back(std::make_pair(io_coordinate, io_side));
     }
   }
+
+  print_sdc_sections(
+    fp, sdc_fname, grid_sections.size(), num_threads,
+    [&](std::fstream& section_fp, const size_t& igrid) {
+      print_analysis_sdc_disable_unused_grid(
+        section_fp, grid_sections[igrid].first, grids, device_annotation,
+        cluster_annotation, place_annotation, module_manager,
+        grid_sections[igrid].second);
+    });
 }
 
 } /* end namespace openfpga */
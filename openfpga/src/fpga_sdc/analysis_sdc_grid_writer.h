@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <fstream>
+#include <string>
 #include <vector>
 
 #include "device_grid.h"
@@ -21,8 +22,8 @@
 namespace openfpga {
 
 void print_analysis_sdc_disable_unused_grids(
-  std::fstream& fp, const DeviceGrid& grids,
-  const VprDeviceAnnotation& device_annotation,
+  std::fstream& fp, const std::string& sdc_fname, const size_t& num_threads,
+  const DeviceGrid& grids, const VprDeviceAnnotation& device_annotation,
   const VprClusteringAnnotation& cluster_annotation,
   const VprPlacementAnnotation& place_annotation,
   const ModuleManager& module_manager);
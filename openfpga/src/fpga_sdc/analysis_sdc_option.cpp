@@ -16,6 +16,8 @@ AnalysisSdcOption::AnalysisSdcOption(const std::string& sdc_dir) {
   time_unit_ = 1.;
   time_stamp_ = true;
   generate_sdc_analysis_ = false;
+  num_threads_ = 1;
+  used_routing_pins_ = false;
 }
 
 /********************************************************************
@@ -29,6 +31,12 @@ float AnalysisSdcOption::time_unit() const { return time_unit_; }
 
 bool AnalysisSdcOption::time_stamp() const { return time_stamp_; }
 
+size_t AnalysisSdcOption::num_threads() const { return num_threads_; }
+
+bool AnalysisSdcOption::used_routing_pins() const {
+  return used_routing_pins_;
+}
+
 bool AnalysisSdcOption::generate_sdc_analysis() const {
   return generate_sdc_analysis_;
 }
@@ -57,4 +65,12 @@ void AnalysisSdcOption::set_generate_sdc_analysis(
   generate_sdc_analysis_ = generate_sdc_analysis;
 }
 
+void AnalysisSdcOption::set_num_threads(const size_t& num_threads) {
+  num_threads_ = num_threads;
+}
+
+void AnalysisSdcOption::set_used_routing_pins(const bool& used_routing_pins) {
+  used_routing_pins_ = used_routing_pins;
+}
+
 } /* end namespace openfpga */
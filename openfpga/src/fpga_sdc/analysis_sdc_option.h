@@ -6,6 +6,7 @@
  * in purpose of analyzing users' implementations
  ********************************************************************/
 
+#include <cstddef>
 #include <string>
 
 /* begin namespace openfpga */
@@ -21,6 +22,8 @@ class AnalysisSdcOption {
   float time_unit() const;
   bool generate_sdc_analysis() const;
   bool time_stamp() const;
+  size_t num_threads() const;
+  bool used_routing_pins() const;
 
  public: /* Public mutators */
   void set_sdc_dir(const std::string& sdc_dir);
@@ -28,6 +31,8 @@ class AnalysisSdcOption {
   void set_time_stamp(const bool& time_stamp);
   void set_time_unit(const float& time_unit);
   void set_generate_sdc_analysis(const bool& generate_sdc_analysis);
+  void set_num_threads(const size_t& num_threads);
+  void set_used_routing_pins(const bool& used_routing_pins);
 
  private: /* Internal data */
   std::string sdc_dir_;
@@ -35,6 +40,11 @@ class AnalysisSdcOption {
   bool flatten_names_;
   float time_unit_;
   bool time_stamp_;
+  /* Number of threads to write the constraints of grids, SBs and CBs */
+  size_t num_threads_;
+  /* Constrain the routing by collecting the used routing pins only, rather
+   * than disabling each unused routing resource */
+  bool used_routing_pins_;
 };
 
 } /* end namespace openfpga */
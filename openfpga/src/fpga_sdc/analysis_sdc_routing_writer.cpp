@@ -4,6 +4,8 @@
  * using a benchmark
  *******************************************************************/
 #include <map>
+#include <string>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -65,9 +67,9 @@ static void print_analysis_sdc_disable_cb_unused_resources(
   VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
 
   /* Print comments */
-  fp << "##################################################" << std::endl;
-  fp << "# Disable timing for Connection block " << cb_module_name << std::endl;
-  fp << "##################################################" << std::endl;
+  fp << "##################################################" << '\n';
+  fp << "# Disable timing for Connection block " << cb_module_name << '\n';
+  fp << "##################################################" << '\n';
 
   /* Disable all the input port (routing tracks), which are not used by
    * benchmark */
@@ -97,7 +99,7 @@ static void print_analysis_sdc_disable_cb_unused_resources(
     fp << "set_disable_timing ";
     fp << cb_instance_name << "/";
     fp << generate_sdc_port(chan_port);
-    fp << std::endl;
+    fp << '\n';
   }
 
   /* Disable all the output port (routing tracks), which are not used by
@@ -128,7 +130,7 @@ static void print_analysis_sdc_disable_cb_unused_resources(
     fp << "set_disable_timing ";
     fp << cb_instance_name << "/";
     fp << generate_sdc_port(chan_port);
-    fp << std::endl;
+    fp << '\n';
   }
 
   /* Build a map between mux_instance name and net_num */
@@ -189,7 +191,7 @@ static void print_analysis_sdc_disable_cb_unused_resources(
       fp << cb_instance_name << "/";
       fp << generate_sdc_port(
         module_manager.module_port(cb_module, module_port));
-      fp << std::endl;
+      fp << '\n';
     }
   }
 
@@ -239,7 +241,8 @@ static void print_analysis_sdc_disable_cb_unused_resources(
  * and disable unused ports for each of them
  *******************************************************************/
 static void print_analysis_sdc_disable_unused_cb_ports(
-  std::fstream& fp, const AtomContext& atom_ctx,
+  std::fstream& fp, const std::string& sdc_fname, const size_t& num_threads,
+  const AtomContext& atom_ctx,
   const ModuleManager& module_manager,
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const VprRoutingAnnotation& routing_annotation,
@@ -248,6 +251,7 @@ static void print_analysis_sdc_disable_unused_cb_ports(
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
+  std::vector<const RRGSB*> cb_gsbs;
   for (size_t ix = 0; ix < cb_range.x(); ++ix) {
     for (size_t iy = 0; iy < cb_range.y(); ++iy) {
       /* Check if the connection block exists in the device!
@@ -259,12 +263,18 @@ static void print_analysis_sdc_disable_unused_cb_ports(
         continue;
       }
 
-      print_analysis_sdc_disable_cb_unused_resources(
-        fp, atom_ctx, module_manager, device_annotation, grids, rr_graph,
-        routing_annotation, device_rr_gsb, rr_gsb, cb_type,
-        compact_routing_hierarchy);
+      cb_gsbs.push_back(&rr_gsb);
     }
   }
+
+  print_sdc_sections(
+    fp, sdc_fname, cb_gsbs.size(), num_threads,
+    [&](std::fstream& section_fp, const size_t& icb) {
+      print_analysis_sdc_disable_cb_unused_resources(
+        section_fp, atom_ctx, module_manager, device_annotation, grids,
+        rr_graph, routing_annotation, device_rr_gsb, *(cb_gsbs[icb]), cb_type,
+        compact_routing_hierarchy);
+    });
 }
 
 /********************************************************************
@@ -272,18 +282,21 @@ static void print_analysis_sdc_disable_unused_cb_ports(
  * and disable unused ports for each of them
  *******************************************************************/
 void print_analysis_sdc_disable_unused_cbs(
-  std::fstream& fp, const AtomContext& atom_ctx,
+  std::fstream& fp, const std::string& sdc_fname, const size_t& num_threads,
+  const AtomContext& atom_ctx,
   const ModuleManager& module_manager,
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const VprRoutingAnnotation& routing_annotation,
   const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy) {
   print_analysis_sdc_disable_unused_cb_ports(
-    fp, atom_ctx, module_manager, device_annotation, grids, rr_graph,
-    routing_annotation, device_rr_gsb, CHANX, compact_routing_hierarchy);
+    fp, sdc_fname, num_threads, atom_ctx, module_manager, device_annotation,
+    grids, rr_graph, routing_annotation, device_rr_gsb, CHANX,
+    compact_routing_hierarchy);
 
   print_analysis_sdc_disable_unused_cb_ports(
-    fp, atom_ctx, module_manager, device_annotation, grids, rr_graph,
-    routing_annotation, device_rr_gsb, CHANY, compact_routing_hierarchy);
+    fp, sdc_fname, num_threads, atom_ctx, module_manager, device_annotation,
+    grids, rr_graph, routing_annotation, device_rr_gsb, CHANY,
+    compact_routing_hierarchy);
 }
 
 /********************************************************************
@@ -324,9 +337,9 @@ static void print_analysis_sdc_disable_sb_unused_resources(
   VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
 
   /* Print comments */
-  fp << "##################################################" << std::endl;
-  fp << "# Disable timing for Switch block " << sb_module_name << std::endl;
-  fp << "##################################################" << std::endl;
+  fp << "##################################################" << '\n';
+  fp << "# Disable timing for Switch block " << sb_module_name << '\n';
+  fp << "##################################################" << '\n';
 
   /* Build a map between mux_instance name and net_num */
   std::map<std::string, AtomNetId> mux_instance_to_net_map;
@@ -391,7 +404,7 @@ static void print_analysis_sdc_disable_sb_unused_resources(
       fp << "set_disable_timing ";
       fp << sb_instance_name << "/";
       fp << generate_sdc_port(sb_port);
-      fp << std::endl;
+      fp << '\n';
     }
   }
 
@@ -440,7 +453,7 @@ static void print_analysis_sdc_disable_sb_unused_resources(
       fp << sb_instance_name << "/";
       fp << generate_sdc_port(
         module_manager.module_port(sb_module, module_port));
-      fp << std::endl;
+      fp << '\n';
     }
   }
 
@@ -564,7 +577,8 @@ static void print_analysis_sdc_disable_sb_unused_resources(
  * and disable unused ports for each of them
  *******************************************************************/
 void print_analysis_sdc_disable_unused_sbs(
-  std::fstream& fp, const AtomContext& atom_ctx,
+  std::fstream& fp, const std::string& sdc_fname, const size_t& num_threads,
+  const AtomContext& atom_ctx,
   const ModuleManager& module_manager,
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const VprRoutingAnnotation& routing_annotation,
@@ -572,6 +586,7 @@ void print_analysis_sdc_disable_unused_sbs(
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
+  std::vector<const RRGSB*> sb_gsbs;
   for (size_t ix = 0; ix < sb_range.x(); ++ix) {
     for (size_t iy = 0; iy < sb_range.y(); ++iy) {
       /* Check if the connection block exists in the device!
@@ -583,11 +598,360 @@ void print_analysis_sdc_disable_unused_sbs(
         continue;
       }
 
+      sb_gsbs.push_back(&rr_gsb);
+    }
+  }
+
+  print_sdc_sections(
+    fp, sdc_fname, sb_gsbs.size(), num_threads,
+    [&](std::fstream& section_fp, const size_t& isb) {
       print_analysis_sdc_disable_sb_unused_resources(
-        fp, atom_ctx, module_manager, device_annotation, grids, rr_graph,
-        routing_annotation, device_rr_gsb, rr_gsb, compact_routing_hierarchy);
+        section_fp, atom_ctx, module_manager, device_annotation, grids,
+        rr_graph, routing_annotation, device_rr_gsb, *(sb_gsbs[isb]),
+        compact_routing_hierarchy);
+    });
+}
+
+/* Name of the Tcl variable which collects the used routing pins */
+constexpr const char* ANALYSIS_SDC_USED_ROUTING_PINS_VARIABLE =
+  "used_routing_pins";
+
+/********************************************************************
+ * Print a list of used routing pins, which are added to the collection
+ * of used routing pins
+ *******************************************************************/
+static void print_analysis_sdc_used_routing_pins(
+  std::fstream& fp, const std::vector<std::string>& used_pins) {
+  for (const std::string& used_pin : used_pins) {
+    fp << "lappend " << ANALYSIS_SDC_USED_ROUTING_PINS_VARIABLE << " {";
+    fp << used_pin << "}";
+    fp << '\n';
+  }
+}
+
+/********************************************************************
+ * Collect the routing pins of a connection block which are used by the
+ * benchmark:
+ * 1. the used input ports (routing tracks)
+ * 2. the inputs of routing multiplexers which are driven by the
+ *    routing tracks of the same net
+ * The output ports (grid input pins) are not collected, as only the input
+ * pins are disabled
+ *******************************************************************/
+static void print_analysis_sdc_cb_used_resources(
+  std::fstream& fp, const AtomContext& atom_ctx,
+  const ModuleManager& module_manager, const RRGraphView& rr_graph,
+  const VprRoutingAnnotation& routing_annotation,
+  const DeviceRRGSB& device_rr_gsb, const RRGSB& rr_gsb,
+  const t_rr_type& cb_type, const bool& compact_routing_hierarchy) {
+  /* Validate file stream */
+  valid_file_stream(fp);
+
+  vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type),
+                                    rr_gsb.get_cb_y(cb_type));
+
+  std::string cb_instance_name =
+    generate_connection_block_module_name(cb_type, gsb_coordinate);
+
+  /* If we use the compact routing hierarchy, we need to find the module name
+   * !*/
+  vtr::Point<size_t> cb_coordinate(rr_gsb.get_cb_x(cb_type),
+                                   rr_gsb.get_cb_y(cb_type));
+  if (true == compact_routing_hierarchy) {
+    vtr::Point<size_t> cb_coord(rr_gsb.get_x(), rr_gsb.get_y());
+    /* Note: use GSB coordinate when inquire for unique modules!!! */
+    const RRGSB& unique_mirror =
+      device_rr_gsb.get_cb_unique_module(cb_type, cb_coord);
+    cb_coordinate.set_x(unique_mirror.get_cb_x(cb_type));
+    cb_coordinate.set_y(unique_mirror.get_cb_y(cb_type));
+  }
+
+  ModuleId cb_module = module_manager.find_module(
+    generate_connection_block_module_name(cb_type, cb_coordinate));
+  VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
+
+  /* Build a map between the instance names of used multiplexers and nets */
+  std::map<std::string, AtomNetId> mux_instance_to_net_map;
+  for (const enum e_side& cb_ipin_side : rr_gsb.get_cb_ipin_sides(cb_type)) {
+    for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(cb_ipin_side);
+         ++inode) {
+      RRNodeId ipin_node = rr_gsb.get_ipin_node(cb_ipin_side, inode);
+      if (true == is_rr_node_to_be_disable_for_analysis(routing_annotation,
+                                                        ipin_node)) {
+        continue;
+      }
+      std::string mux_instance_name = generate_cb_mux_instance_name(
+        CONNECTION_BLOCK_MUX_INSTANCE_PREFIX,
+        get_rr_graph_single_node_side(rr_graph, ipin_node), inode,
+        std::string(""));
+      mux_instance_to_net_map[mux_instance_name] =
+        atom_ctx.lookup.atom_net(routing_annotation.rr_node_net(ipin_node));
+    }
+  }
+
+  std::vector<std::string> used_pins;
+  for (size_t itrack = 0; itrack < rr_gsb.get_cb_chan_width(cb_type);
+       ++itrack) {
+    const RRNodeId& chan_node =
+      rr_gsb.get_chan_node(rr_gsb.get_cb_chan_side(cb_type), itrack);
+    /* Check if this node is used by benchmark  */
+    if (true ==
+        is_rr_node_to_be_disable_for_analysis(routing_annotation, chan_node)) {
+      continue;
+    }
+
+    ModulePortId module_port;
+    for (const PORTS& port_direction : {IN_PORT, OUT_PORT}) {
+      std::string port_name = generate_cb_module_track_port_name(
+        cb_type, port_direction, 0 == itrack % 2);
+
+      /* Ensure we have this port in the module! */
+      module_port = module_manager.find_module_port(cb_module, port_name);
+      VTR_ASSERT(true ==
+                 module_manager.valid_module_port_id(cb_module, module_port));
+      BasicPort chan_port(
+        module_manager.module_port(cb_module, module_port).get_name(),
+        itrack / 2, itrack / 2);
+      used_pins.push_back(cb_instance_name + "/" +
+                          generate_sdc_port(chan_port));
     }
+
+    /* The multiplexers are driven by the last port, the same as
+     * print_analysis_sdc_disable_cb_unused_resources() */
+    AtomNetId mapped_atom_net =
+      atom_ctx.lookup.atom_net(routing_annotation.rr_node_net(chan_node));
+    find_analysis_module_input_pin_used_net_sinks(
+      module_manager, cb_module, cb_instance_name, module_port, itrack / 2,
+      mapped_atom_net, mux_instance_to_net_map, used_pins);
   }
+
+  print_analysis_sdc_used_routing_pins(fp, used_pins);
+}
+
+/********************************************************************
+ * Collect the routing pins of a switch block which are used by the
+ * benchmark:
+ * 1. the used input ports (routing tracks and grid output pins)
+ * 2. the inputs of routing multiplexers which are driven by the
+ *    input ports of the same net
+ * The output ports (routing tracks) are not collected, as only the input
+ * pins are disabled
+ *******************************************************************/
+static void print_analysis_sdc_sb_used_resources(
+  std::fstream& fp, const AtomContext& atom_ctx,
+  const ModuleManager& module_manager,
+  const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
+  const RRGraphView& rr_graph, const VprRoutingAnnotation& routing_annotation,
+  const DeviceRRGSB& device_rr_gsb, const RRGSB& rr_gsb,
+  const bool& compact_routing_hierarchy) {
+  /* Validate file stream */
+  valid_file_stream(fp);
+
+  vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+
+  std::string sb_instance_name =
+    generate_switch_block_module_name(gsb_coordinate);
+
+  /* If we use the compact routing hierarchy, the names of the ports are
+   * found in the unique mirror
+   * Note: use GSB coordinate when inquire for unique modules!!! */
+  const RRGSB& port_gsb =
+    (true == compact_routing_hierarchy)
+      ? device_rr_gsb.get_sb_unique_module(
+          vtr::Point<size_t>(rr_gsb.get_x(), rr_gsb.get_y()))
+      : rr_gsb;
+
+  ModuleId sb_module = module_manager.find_module(
+    generate_switch_block_module_name(
+      vtr::Point<size_t>(port_gsb.get_sb_x(), port_gsb.get_sb_y())));
+  VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
+
+  /* Build a map between the instance names of used multiplexers and nets */
+  std::map<std::string, AtomNetId> mux_instance_to_net_map;
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    for (size_t itrack = 0;
+         itrack < rr_gsb.get_chan_width(side_manager.get_side()); ++itrack) {
+      const RRNodeId& chan_node =
+        rr_gsb.get_chan_node(side_manager.get_side(), itrack);
+      if ((OUT_PORT != rr_gsb.get_chan_node_direction(side_manager.get_side(),
+                                                      itrack)) ||
+          (true == is_rr_node_to_be_disable_for_analysis(routing_annotation,
+                                                         chan_node))) {
+        continue;
+      }
+      std::string mux_instance_name = generate_sb_memory_instance_name(
+        SWITCH_BLOCK_MUX_INSTANCE_PREFIX, side_manager.get_side(), itrack,
+        std::string(""));
+      mux_instance_to_net_map[mux_instance_name] =
+        atom_ctx.lookup.atom_net(routing_annotation.rr_node_net(chan_node));
+    }
+  }
+
+  std::vector<std::string> used_pins;
+
+  /* Iterate over input ports coming from grid output pins */
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+
+    for (size_t inode = 0;
+         inode < rr_gsb.get_num_opin_nodes(side_manager.get_side()); ++inode) {
+      const RRNodeId& opin_node =
+        rr_gsb.get_opin_node(side_manager.get_side(), inode);
+      /* Check if this node is used by benchmark  */
+      if (true == is_rr_node_to_be_disable_for_analysis(routing_annotation,
+                                                        opin_node)) {
+        continue;
+      }
+
+      const RRNodeId& port_opin_node =
+        port_gsb.get_opin_node(side_manager.get_side(), inode);
+      std::string port_name = generate_sb_module_grid_port_name(
+        side_manager.get_side(),
+        get_rr_graph_single_node_side(rr_graph, port_opin_node), grids,
+        device_annotation, rr_graph, port_opin_node);
+
+      /* Ensure we have this port in the module! */
+      ModulePortId module_port =
+        module_manager.find_module_port(sb_module, port_name);
+      VTR_ASSERT(true ==
+                 module_manager.valid_module_port_id(sb_module, module_port));
+      used_pins.push_back(
+        sb_instance_name + "/" +
+        generate_sdc_port(module_manager.module_port(sb_module, module_port)));
+
+      AtomNetId mapped_atom_net =
+        atom_ctx.lookup.atom_net(routing_annotation.rr_node_net(opin_node));
+      for (const size_t& pin :
+           module_manager.module_port(sb_module, module_port).pins()) {
+        find_analysis_module_input_pin_used_net_sinks(
+          module_manager, sb_module, sb_instance_name, module_port, pin,
+          mapped_atom_net, mux_instance_to_net_map, used_pins);
+      }
+    }
+  }
+
+  /* Iterate over input ports coming from routing tracks */
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+
+    for (size_t itrack = 0;
+         itrack < rr_gsb.get_chan_width(side_manager.get_side()); ++itrack) {
+      const RRNodeId& chan_node =
+        rr_gsb.get_chan_node(side_manager.get_side(), itrack);
+      /* Skip output ports and the tracks unused by benchmark */
+      if ((OUT_PORT == rr_gsb.get_chan_node_direction(side_manager.get_side(),
+                                                      itrack)) ||
+          (true == is_rr_node_to_be_disable_for_analysis(routing_annotation,
+                                                         chan_node))) {
+        continue;
+      }
+
+      std::string port_name = generate_sb_module_track_port_name(
+        rr_graph.node_type(
+          port_gsb.get_chan_node(side_manager.get_side(), itrack)),
+        side_manager.get_side(),
+        port_gsb.get_chan_node_direction(side_manager.get_side(), itrack));
+
+      /* Ensure we have this port in the module! */
+      ModulePortId module_port =
+        module_manager.find_module_port(sb_module, port_name);
+      VTR_ASSERT(true ==
+                 module_manager.valid_module_port_id(sb_module, module_port));
+      BasicPort sb_port(
+        module_manager.module_port(sb_module, module_port).get_name(),
+        itrack / 2, itrack / 2);
+      used_pins.push_back(sb_instance_name + "/" + generate_sdc_port(sb_port));
+
+      AtomNetId mapped_atom_net =
+        atom_ctx.lookup.atom_net(routing_annotation.rr_node_net(chan_node));
+      find_analysis_module_input_pin_used_net_sinks(
+        module_manager, sb_module, sb_instance_name, module_port, itrack / 2,
+        mapped_atom_net, mux_instance_to_net_map, used_pins);
+    }
+  }
+
+  print_analysis_sdc_used_routing_pins(fp, used_pins);
+}
+
+/********************************************************************
+ * Disable timing for the unused routing resources of all the switch
+ * blocks and connection blocks in a device, in a complement way:
+ * the input pins of routing modules and their routing multiplexers which
+ * are used by the benchmark are collected in a Tcl list, and all the other
+ * input pins are disabled by a single command on collections, e.g.,
+ *   set used_routing_pins [list]
+ *   lappend used_routing_pins {sb_1__1_/chanx_left_in[0]}
+ *   ...
+ *   set_disable_timing [remove_from_collection [get_pins ...] \
+ *                       [get_pins $used_routing_pins]]
+ * Only the used routing resources are written, so that the size of the
+ * SDC file scales with the benchmark rather than with the fabric
+ *******************************************************************/
+void print_analysis_sdc_disable_unused_routing_by_used_pins(
+  std::fstream& fp, const std::string& sdc_fname, const size_t& num_threads,
+  const AtomContext& atom_ctx, const ModuleManager& module_manager,
+  const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
+  const RRGraphView& rr_graph, const VprRoutingAnnotation& routing_annotation,
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy) {
+  /* Validate file stream */
+  valid_file_stream(fp);
+
+  /* Print comments */
+  fp << "##################################################" << '\n';
+  fp << "# Collect routing pins used by the benchmark      " << '\n';
+  fp << "##################################################" << '\n';
+  fp << "set " << ANALYSIS_SDC_USED_ROUTING_PINS_VARIABLE << " [list]";
+  fp << '\n';
+
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  std::vector<const RRGSB*> gsbs;
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      gsbs.push_back(&device_rr_gsb.get_gsb(ix, iy));
+    }
+  }
+
+  print_sdc_sections(
+    fp, sdc_fname, gsbs.size(), num_threads,
+    [&](std::fstream& section_fp, const size_t& igsb) {
+      const RRGSB& rr_gsb = *(gsbs[igsb]);
+      /* Some of the routing modules do NOT exist due to heterogeneous
+       * blocks (height > 1), we will skip those modules */
+      for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+        if (false == rr_gsb.is_cb_exist(cb_type)) {
+          continue;
+        }
+        print_analysis_sdc_cb_used_resources(
+          section_fp, atom_ctx, module_manager, rr_graph, routing_annotation,
+          device_rr_gsb, rr_gsb, cb_type, compact_routing_hierarchy);
+      }
+      if (true == rr_gsb.is_sb_exist()) {
+        print_analysis_sdc_sb_used_resources(
+          section_fp, atom_ctx, module_manager, device_annotation, grids,
+          rr_graph, routing_annotation, device_rr_gsb, rr_gsb,
+          compact_routing_hierarchy);
+      }
+    });
+
+  /* Add an empty line as a splitter */
+  fp << '\n';
+
+  /* Print comments */
+  fp << "##################################################" << '\n';
+  fp << "# Disable timing for unused routing pins          " << '\n';
+  fp << "##################################################" << '\n';
+  /* Consider the input pins of the routing modules in the top-level module
+   * and of their children, e.g., routing multiplexers */
+  fp << "set_disable_timing [remove_from_collection";
+  fp << " [get_pins -quiet -filter \"direction == in\"";
+  fp << " {sb_*/* sb_*/*/* cbx_*/* cbx_*/*/* cby_*/* cby_*/*/*}]";
+  fp << " [get_pins -quiet $" << ANALYSIS_SDC_USED_ROUTING_PINS_VARIABLE
+     << "]]";
+  fp << '\n';
+
+  /* Add an empty line as a splitter */
+  fp << '\n';
 }
 
 } /* end namespace openfpga */
@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <fstream>
+#include <string>
 #include <vector>
 
 #include "device_grid.h"
@@ -21,19 +22,28 @@
 namespace openfpga {
 
 void print_analysis_sdc_disable_unused_cbs(
-  std::fstream& fp, const AtomContext& atom_ctx,
+  std::fstream& fp, const std::string& sdc_fname, const size_t& num_threads,
+  const AtomContext& atom_ctx,
   const ModuleManager& module_manager,
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const VprRoutingAnnotation& routing_annotation,
   const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy);
 
 void print_analysis_sdc_disable_unused_sbs(
-  std::fstream& fp, const AtomContext& atom_ctx,
+  std::fstream& fp, const std::string& sdc_fname, const size_t& num_threads,
+  const AtomContext& atom_ctx,
   const ModuleManager& module_manager,
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const VprRoutingAnnotation& routing_annotation,
   const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy);
 
+void print_analysis_sdc_disable_unused_routing_by_used_pins(
+  std::fstream& fp, const std::string& sdc_fname, const size_t& num_threads,
+  const AtomContext& atom_ctx, const ModuleManager& module_manager,
+  const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
+  const RRGraphView& rr_graph, const VprRoutingAnnotation& routing_annotation,
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy);
+
 } /* end namespace openfpga */
 
 #endif
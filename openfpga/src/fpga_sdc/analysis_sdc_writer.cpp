@@ -16,9 +16,11 @@
 #include "analysis_sdc_writer.h"
 #include "mux_utils.h"
 #include "openfpga_atom_netlist_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "openfpga_port.h"
+#include "openfpga_trace.h"
 #include "sdc_memory_utils.h"
 #include "sdc_writer_naming.h"
 #include "sdc_writer_utils.h"
@@ -43,9 +45,9 @@ static void print_analysis_sdc_io_delays(
   valid_file_stream(fp);
 
   /* Print comments */
-  fp << "##################################################" << std::endl;
-  fp << "# Create clock                                    " << std::endl;
-  fp << "##################################################" << std::endl;
+  fp << "##################################################" << '\n';
+  fp << "# Create clock                                    " << '\n';
+  fp << "##################################################" << '\n';
 
   /* Get clock port from the global port */
   std::vector<BasicPort> operating_clock_ports;
@@ -74,10 +76,10 @@ static void print_analysis_sdc_io_delays(
        << critical_path_delay / time_unit;
     fp << " -waveform {0 " << std::setprecision(10)
        << critical_path_delay / (2 * time_unit) << "}";
-    fp << std::endl;
+    fp << '\n';
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << '\n';
   }
 
   /* There should be only one operating clock!
@@ -98,9 +100,9 @@ static void print_analysis_sdc_io_delays(
       find_atom_netlist_clock_port_names(atom_ctx.nlist, netlist_annotation);
 
     /* Print comments */
-    fp << "##################################################" << std::endl;
-    fp << "# Create input and output delays for used I/Os    " << std::endl;
-    fp << "##################################################" << std::endl;
+    fp << "##################################################" << '\n';
+    fp << "# Create input and output delays for used I/Os    " << '\n';
+    fp << "##################################################" << '\n';
 
     for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
       /* Bypass non-I/O atom blocks ! */
@@ -156,12 +158,12 @@ static void print_analysis_sdc_io_delays(
     }
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << '\n';
 
     /* Print comments */
-    fp << "##################################################" << std::endl;
-    fp << "# Disable timing for unused I/Os    " << std::endl;
-    fp << "##################################################" << std::endl;
+    fp << "##################################################" << '\n';
+    fp << "# Disable timing for unused I/Os    " << '\n';
+    fp << "##################################################" << '\n';
 
     /* Wire the unused iopads to a constant */
     for (size_t io_index = 0; io_index < io_used.size(); ++io_index) {
@@ -178,7 +180,7 @@ static void print_analysis_sdc_io_delays(
     }
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << '\n';
   }
 }
 
@@ -193,9 +195,9 @@ static void print_analysis_sdc_disable_global_ports(
   valid_file_stream(fp);
 
   /* Print comments */
-  fp << "##################################################" << std::endl;
-  fp << "# Disable timing for global ports                 " << std::endl;
-  fp << "##################################################" << std::endl;
+  fp << "##################################################" << '\n';
+  fp << "# Disable timing for global ports                 " << '\n';
+  fp << "##################################################" << '\n';
 
   for (const FabricGlobalPortId& global_port :
        fabric_global_port_info.global_ports()) {
@@ -241,9 +243,10 @@ void print_analysis_sdc(const AnalysisSdcOption& option,
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate file stream */
@@ -280,24 +283,38 @@ void print_analysis_sdc(const AnalysisSdcOption& option,
     fp, option.flatten_names(), openfpga_ctx.module_graph(), top_module,
     format_dir_path(openfpga_ctx.module_graph().module_name(top_module)));
 
-  /* Disable timing for unused routing resources in connection blocks */
-  print_analysis_sdc_disable_unused_cbs(
-    fp, vpr_ctx.atom(), openfpga_ctx.module_graph(),
-    openfpga_ctx.vpr_device_annotation(), vpr_ctx.device().grid,
-    vpr_ctx.device().rr_graph, openfpga_ctx.vpr_routing_annotation(),
-    openfpga_ctx.device_rr_gsb(), compact_routing_hierarchy);
-
-  /* Disable timing for unused routing resources in switch blocks */
-  print_analysis_sdc_disable_unused_sbs(
-    fp, vpr_ctx.atom(), openfpga_ctx.module_graph(),
-    openfpga_ctx.vpr_device_annotation(), vpr_ctx.device().grid,
-    vpr_ctx.device().rr_graph, openfpga_ctx.vpr_routing_annotation(),
-    openfpga_ctx.device_rr_gsb(), compact_routing_hierarchy);
+  if (true == option.used_routing_pins()) {
+    /* Disable timing for unused routing resources in switch blocks and
+     * connection blocks, by collecting the used routing pins only */
+    print_analysis_sdc_disable_unused_routing_by_used_pins(
+      fp, sdc_fname, option.num_threads(), vpr_ctx.atom(),
+      openfpga_ctx.module_graph(), openfpga_ctx.vpr_device_annotation(),
+      vpr_ctx.device().grid, vpr_ctx.device().rr_graph,
+      openfpga_ctx.vpr_routing_annotation(), openfpga_ctx.device_rr_gsb(),
+      compact_routing_hierarchy);
+  } else {
+    /* Disable timing for unused routing resources in connection blocks */
+    print_analysis_sdc_disable_unused_cbs(
+      fp, sdc_fname, option.num_threads(), vpr_ctx.atom(),
+      openfpga_ctx.module_graph(), openfpga_ctx.vpr_device_annotation(),
+      vpr_ctx.device().grid, vpr_ctx.device().rr_graph,
+      openfpga_ctx.vpr_routing_annotation(), openfpga_ctx.device_rr_gsb(),
+      compact_routing_hierarchy);
+
+    /* Disable timing for unused routing resources in switch blocks */
+    print_analysis_sdc_disable_unused_sbs(
+      fp, sdc_fname, option.num_threads(), vpr_ctx.atom(),
+      openfpga_ctx.module_graph(), openfpga_ctx.vpr_device_annotation(),
+      vpr_ctx.device().grid, vpr_ctx.device().rr_graph,
+      openfpga_ctx.vpr_routing_annotation(), openfpga_ctx.device_rr_gsb(),
+      compact_routing_hierarchy);
+  }
 
   /* Disable timing for unused routing resources in grids (programmable blocks)
    */
   print_analysis_sdc_disable_unused_grids(
-    fp, vpr_ctx.device().grid, openfpga_ctx.vpr_device_annotation(),
+    fp, sdc_fname, option.num_threads(), vpr_ctx.device().grid,
+    openfpga_ctx.vpr_device_annotation(),
     openfpga_ctx.vpr_clustering_annotation(),
     openfpga_ctx.vpr_placement_annotation(), openfpga_ctx.module_graph());
 
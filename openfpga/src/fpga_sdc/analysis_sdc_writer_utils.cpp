@@ -64,12 +64,10 @@ void disable_analysis_module_input_pin_net_sinks(
                module_manager.valid_module_net_id(parent_module, module_net));
 
   /* Touch each sink of the net! */
-  for (const ModuleNetSinkId& sink_id :
-       module_manager.module_net_sinks(parent_module, module_net)) {
-    ModuleId sink_module =
-      module_manager.net_sink_modules(parent_module, module_net)[sink_id];
-    size_t sink_instance =
-      module_manager.net_sink_instances(parent_module, module_net)[sink_id];
+  for (const ModuleManager::NetTerminal& sink :
+       module_manager.net_sink_terminals(parent_module, module_net)) {
+    ModuleId sink_module = sink.module;
+    size_t sink_instance = sink.instance;
 
     /* Skip when sink module is the parent module,
      * the output ports of parent modules have been disabled/enabled already!
@@ -101,12 +99,8 @@ void disable_analysis_module_input_pin_net_sinks(
       continue;
     }
 
-    BasicPort sink_port = module_manager.module_port(
-      sink_module,
-      module_manager.net_sink_ports(parent_module, module_net)[sink_id]);
-    sink_port.set_width(
-      module_manager.net_sink_pins(parent_module, module_net)[sink_id],
-      module_manager.net_sink_pins(parent_module, module_net)[sink_id]);
+    BasicPort sink_port = module_manager.module_port(sink_module, sink.port);
+    sink_port.set_width(sink.pin, sink.pin);
 
     VTR_ASSERT(!sink_instance_name.empty());
     /* Get the input id that is used! Disable the unused inputs! */
@@ -114,7 +108,7 @@ void disable_analysis_module_input_pin_net_sinks(
     fp << parent_instance_name << "/";
     fp << sink_instance_name << "/";
     fp << generate_sdc_port(sink_port);
-    fp << std::endl;
+    fp << '\n';
   }
 }
 
@@ -199,12 +193,10 @@ void disable_analysis_module_output_pin_net_sinks(
              module_manager.valid_module_net_id(parent_module, module_net));
 
   /* Touch each sink of the net! */
-  for (const ModuleNetSinkId& sink_id :
-       module_manager.module_net_sinks(parent_module, module_net)) {
-    ModuleId sink_module =
-      module_manager.net_sink_modules(parent_module, module_net)[sink_id];
-    size_t sink_instance =
-      module_manager.net_sink_instances(parent_module, module_net)[sink_id];
+  for (const ModuleManager::NetTerminal& sink :
+       module_manager.net_sink_terminals(parent_module, module_net)) {
+    ModuleId sink_module = sink.module;
+    size_t sink_instance = sink.instance;
 
     /* Skip when sink module is the parent module,
      * the output ports of parent modules have been disabled/enabled already!
@@ -236,12 +228,8 @@ void disable_analysis_module_output_pin_net_sinks(
       continue;
     }
 
-    BasicPort sink_port = module_manager.module_port(
-      sink_module,
-      module_manager.net_sink_ports(parent_module, module_net)[sink_id]);
-    sink_port.set_width(
-      module_manager.net_sink_pins(parent_module, module_net)[sink_id],
-      module_manager.net_sink_pins(parent_module, module_net)[sink_id]);
+    BasicPort sink_port = module_manager.module_port(sink_module, sink.port);
+    sink_port.set_width(sink.pin, sink.pin);
 
     VTR_ASSERT(!sink_instance_name.empty());
     /* Get the input id that is used! Disable the unused inputs! */
@@ -249,7 +237,60 @@ void disable_analysis_module_output_pin_net_sinks(
     fp << parent_instance_name << "/";
     fp << sink_instance_name << "/";
     fp << generate_sdc_port(sink_port);
-    fp << std::endl;
+    fp << '\n';
+  }
+}
+
+/********************************************************************
+ * Find the inputs of routing multiplexers which are used by the benchmark,
+ * i.e., the complement of disable_analysis_module_input_pin_net_sinks()
+ * Here, we start from an input of a routing module, and traverse forward to
+ * the sink ports of the module net whose source is the input. A sink port
+ * is used when its multiplexer instance is mapped to the same net as the
+ * input. The full names of the used sink ports are added to a list.
+ *******************************************************************/
+void find_analysis_module_input_pin_used_net_sinks(
+  const ModuleManager& module_manager, const ModuleId& parent_module,
+  const std::string& parent_instance_name,
+  const ModulePortId& module_input_port, const size_t& module_input_pin,
+  const AtomNetId& mapped_net,
+  const std::map<std::string, AtomNetId>& mux_instance_to_net_map,
+  std::vector<std::string>& used_pins) {
+  /* An unused input drives no used multiplexer input */
+  if (AtomNetId::INVALID() == mapped_net) {
+    return;
+  }
+
+  /* Find the module net which sources from this port! */
+  ModuleNetId module_net = module_manager.module_instance_port_net(
+    parent_module, parent_module, 0, module_input_port, module_input_pin);
+  VTR_ASSERT(true ==
+             module_manager.valid_module_net_id(parent_module, module_net));
+
+  /* Touch each sink of the net! */
+  for (const ModuleManager::NetTerminal& sink :
+       module_manager.net_sink_terminals(parent_module, module_net)) {
+    ModuleId sink_module = sink.module;
+    size_t sink_instance = sink.instance;
+
+    /* Skip when sink module is the parent module */
+    if (sink_module == parent_module) {
+      continue;
+    }
+
+    const std::string& sink_instance_name =
+      module_manager.instance_name(parent_module, sink_module, sink_instance);
+    std::map<std::string, AtomNetId>::const_iterator it =
+      mux_instance_to_net_map.find(sink_instance_name);
+    if ((it == mux_instance_to_net_map.end()) || (mapped_net != it->second)) {
+      continue;
+    }
+
+    BasicPort sink_port = module_manager.module_port(sink_module, sink.port);
+    sink_port.set_width(sink.pin, sink.pin);
+
+    used_pins.push_back(parent_instance_name + "/" + sink_instance_name + "/" +
+                        generate_sdc_port(sink_port));
   }
 }
 
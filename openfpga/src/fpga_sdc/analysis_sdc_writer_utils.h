@@ -7,6 +7,7 @@
 #include <fstream>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "atom_netlist_fwd.h"
 #include "module_manager.h"
@@ -44,6 +45,14 @@ void disable_analysis_module_output_pin_net_sinks(
   const AtomNetId& mapped_net,
   const std::map<std::string, AtomNetId> mux_instance_to_net_map);
 
+void find_analysis_module_input_pin_used_net_sinks(
+  const ModuleManager& module_manager, const ModuleId& parent_module,
+  const std::string& parent_instance_name,
+  const ModulePortId& module_input_port, const size_t& module_input_pin,
+  const AtomNetId& mapped_net,
+  const std::map<std::string, AtomNetId>& mux_instance_to_net_map,
+  std::vector<std::string>& used_pins);
+
 } /* end namespace openfpga */
 
 #endif
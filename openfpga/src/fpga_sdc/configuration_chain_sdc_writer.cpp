@@ -9,6 +9,10 @@
 #include <ctime>
 #include <fstream>
 #include <iomanip>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -17,10 +21,12 @@
 
 /* Headers from openfpgautil library */
 #include "configuration_chain_sdc_writer.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "openfpga_port.h"
 #include "openfpga_scale.h"
+#include "openfpga_trace.h"
 #include "sdc_writer_utils.h"
 
 /* begin namespace openfpga */
@@ -36,86 +42,111 @@ namespace openfpga {
  *    | CCFF |---------------------->| CCFF |
  *    +------+                       +------+
  *
- * This function will be executed in a recursive way,
- * using a Depth-First Search (DFS) strategy
- * It will iterate over all the configurable children under each module
- * and print a SDC command
+ * This function visits the configurable children in the sequence of the
+ * flattened hierarchy of configurable children, i.e., a Depth-First Search
+ * (DFS), and prints a SDC command between each pair of successive leaf
+ * modules, i.e., each hop of the chain
  *
+ * The hierarchical path of the current module is kept in a single buffer,
+ * where the instance name of a node is appended to the path of its parent,
+ * so that the modules under the same parent share the prefix of their paths.
+ *
+ * When unique module pairs are required, a hop is constrained by a SDC
+ * command with regular expressions, which match any instance of the
+ * same modules with default instance names. Only the first hop of each
+ * pair of patterns is printed.
  *******************************************************************/
-static void rec_print_pnr_sdc_constrain_configurable_chain(
+static void print_pnr_sdc_constrain_configurable_chain_hops(
   std::fstream& fp, const float& tmax, const float& tmin,
-  const ModuleManager& module_manager, const ModuleId& parent_module,
-  const std::string& parent_module_path, std::string& previous_module_path,
-  ModuleId& previous_module) {
-  /* For each configurable child, we will go one level down in priority */
-  for (size_t child_index = 0;
-       child_index < module_manager.configurable_children(parent_module).size();
-       ++child_index) {
-    std::string child_module_path = parent_module_path;
-    ModuleId child_module_id =
-      module_manager.configurable_children(parent_module)[child_index];
-    size_t child_instance_id =
-      module_manager.configurable_child_instances(parent_module)[child_index];
-    std::string child_instance_name;
-    if (true ==
-        module_manager
-          .instance_name(parent_module, child_module_id, child_instance_id)
-          .empty()) {
-      child_instance_name = generate_instance_name(
-        module_manager.module_name(child_module_id), child_instance_id);
-    } else {
-      child_instance_name = module_manager.instance_name(
-        parent_module, child_module_id, child_instance_id);
-    }
+  const ModuleManager& module_manager,
+  const ConfigChildHierarchy& config_hierarchy,
+  const bool& unique_module_pairs) {
+  /* Validate file stream */
+  valid_file_stream(fp);
 
-    child_module_path += child_instance_name;
+  ModuleId top_module = config_hierarchy.top_module();
+  std::string module_path =
+    format_dir_path(module_manager.module_name(top_module));
+  size_t top_path_length = module_path.length();
 
-    child_module_path = format_dir_path(child_module_path);
+  std::string previous_module_path;
+  std::string previous_instance_pattern;
+  ModuleId previous_module = ModuleId::INVALID();
+  std::set<std::pair<std::string, std::string>> printed_module_pairs;
 
-    rec_print_pnr_sdc_constrain_configurable_chain(
-      fp, tmax, tmin, module_manager, child_module_id, child_module_path,
-      previous_module_path, previous_module);
-  }
+  for (const ConfigChildNodeId& node : config_hierarchy.nodes()) {
+    module_path.resize(top_path_length +
+                       config_hierarchy.node_path_offset(node));
+    config_hierarchy.append_node_name(module_path, node);
+    module_path += '/';
 
-  /* If there is no configurable children any more, this is a leaf module, print
-   * a SDC command for disable timing */
-  if (0 < module_manager.configurable_children(parent_module).size()) {
-    return;
-  }
+    /* Only leaf modules are in the chain */
+    if (false == config_hierarchy.node_is_leaf(node)) {
+      continue;
+    }
 
-  /* Validate file stream */
-  valid_file_stream(fp);
+    ModuleId curr_module = config_hierarchy.node_module(node);
+    std::string instance_pattern;
+    if (true == unique_module_pairs) {
+      ConfigChildNodeId parent_node = config_hierarchy.node_parent(node);
+      ModuleId parent_module = parent_node.is_valid()
+                                 ? config_hierarchy.node_module(parent_node)
+                                 : top_module;
+      instance_pattern = config_hierarchy.node_name(node);
+      if (true == module_manager
+                    .instance_name(parent_module, curr_module,
+                                   config_hierarchy.node_instance(node))
+                    .empty()) {
+        instance_pattern =
+          module_manager.module_name(curr_module) + std::string("_[0-9]+_");
+      }
+    }
 
-  /* Disable timing for each output port of this module */
-  if (!previous_module_path.empty()) {
-    bool first_port = true;
-    for (const BasicPort& output_port : module_manager.module_ports_by_type(
-           previous_module, ModuleManager::MODULE_OUTPUT_PORT)) {
+    /* Print a SDC command for the hop from the previous leaf module */
+    if (ModuleId::INVALID() != previous_module) {
       /* Only the first output port will be considered,
        * being consistent with build_memory_module.cpp:395
        */
-      if (false == first_port) {
-        continue;
+      std::vector<BasicPort> output_ports = module_manager.module_ports_by_type(
+        previous_module, ModuleManager::MODULE_OUTPUT_PORT);
+      bool print_hop = !output_ports.empty();
+      if ((true == print_hop) && (true == unique_module_pairs)) {
+        print_hop = printed_module_pairs
+                      .insert(std::make_pair(previous_instance_pattern,
+                                             instance_pattern))
+                      .second;
       }
-
-      for (const BasicPort& input_port : module_manager.module_ports_by_type(
-             parent_module, ModuleManager::MODULE_INPUT_PORT)) {
+      std::vector<BasicPort> input_ports = module_manager.module_ports_by_type(
+        curr_module, ModuleManager::MODULE_INPUT_PORT);
+      if (false == print_hop) {
+        input_ports.clear();
+      }
+      for (const BasicPort& input_port : input_ports) {
+        if (true == unique_module_pairs) {
+          print_pnr_sdc_regexp_constrain_max_delay(
+            fp, ".*/" + previous_instance_pattern, output_ports[0].get_name(),
+            ".*/" + instance_pattern, input_port.get_name(), tmax);
+
+          print_pnr_sdc_regexp_constrain_min_delay(
+            fp, ".*/" + previous_instance_pattern, output_ports[0].get_name(),
+            ".*/" + instance_pattern, input_port.get_name(), tmin);
+          continue;
+        }
         print_pnr_sdc_constrain_max_delay(
-          fp, previous_module_path, output_port.get_name(), parent_module_path,
+          fp, previous_module_path, output_ports[0].get_name(), module_path,
           input_port.get_name(), tmax);
 
         print_pnr_sdc_constrain_min_delay(
-          fp, previous_module_path, output_port.get_name(), parent_module_path,
+          fp, previous_module_path, output_ports[0].get_name(), module_path,
           input_port.get_name(), tmin);
       }
-
-      first_port = false;
     }
-  }
 
-  /* Update previous module */
-  previous_module_path = parent_module_path;
-  previous_module = parent_module;
+    /* Update previous module */
+    previous_module_path = module_path;
+    previous_instance_pattern = instance_pattern;
+    previous_module = curr_module;
+  }
 }
 
 /********************************************************************
@@ -126,7 +157,8 @@ static void rec_print_pnr_sdc_constrain_configurable_chain(
 void print_pnr_sdc_constrain_configurable_chain(
   const std::string& sdc_fname, const float& time_unit, const float& max_delay,
   const float& min_delay, const bool& include_time_stamp,
-  const ModuleManager& module_manager) {
+  const bool& unique_module_pairs, const ModuleManager& module_manager,
+  const ConfigChildHierarchy& config_hierarchy) {
   /* Create the directory */
   create_directory(find_path_dir_name(sdc_fname));
 
@@ -135,9 +167,10 @@ void print_pnr_sdc_constrain_configurable_chain(
     std::string("Write SDC to constrain configurable chain for P&R flow '") +
     sdc_fname + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -153,15 +186,13 @@ void print_pnr_sdc_constrain_configurable_chain(
   std::string top_module_name = generate_fpga_top_module_name();
   ModuleId top_module = module_manager.find_module(top_module_name);
   VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+  /* The hierarchy must be built from the same module graph */
+  VTR_ASSERT(top_module == config_hierarchy.top_module());
 
-  /* Go recursively in the module manager, starting from the top-level module:
-   * instance id of the top-level module is 0 by default */
-  std::string previous_module_path;
-  ModuleId previous_module = ModuleId::INVALID();
-  rec_print_pnr_sdc_constrain_configurable_chain(
-    fp, max_delay, min_delay, module_manager, top_module,
-    format_dir_path(module_manager.module_name(top_module)),
-    previous_module_path, previous_module);
+  /* Go through the configurable children of the top-level module */
+  print_pnr_sdc_constrain_configurable_chain_hops(
+    fp, max_delay, min_delay, module_manager, config_hierarchy,
+    unique_module_pairs);
 
   /* Close file handler */
   fp.close();
@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 
+#include "config_child_hierarchy.h"
 #include "module_manager.h"
 
 /********************************************************************
@@ -19,7 +20,8 @@ namespace openfpga {
 void print_pnr_sdc_constrain_configurable_chain(
   const std::string& sdc_fname, const float& time_unit, const float& max_delay,
   const float& min_delay, const bool& include_time_stamp,
-  const ModuleManager& module_manager);
+  const bool& unique_module_pairs, const ModuleManager& module_manager,
+  const ConfigChildHierarchy& config_hierarchy);
 
 } /* end namespace openfpga */
 
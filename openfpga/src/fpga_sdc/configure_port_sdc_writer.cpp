@@ -21,11 +21,13 @@
 /* Headers from openfpgautil library */
 #include "circuit_library_utils.h"
 #include "configure_port_sdc_writer.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "openfpga_port.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_scale.h"
+#include "openfpga_trace.h"
 #include "sdc_mux_utils.h"
 #include "sdc_writer_naming.h"
 #include "sdc_writer_utils.h"
@@ -43,7 +45,7 @@ namespace openfpga {
  *   1: fatal error occurred
  *******************************************************************/
 static int print_sdc_disable_lut_configure_ports(
-  std::fstream& fp, const bool& flatten_names,
+  std::fstream& fp, const bool& flatten_names, const bool& module_scoped,
   const CircuitLibrary& circuit_lib, const ModuleManager& module_manager,
   const ModuleId& top_module) {
   if (false == valid_file_stream(fp)) {
@@ -64,10 +66,9 @@ static int print_sdc_disable_lut_configure_ports(
       module_manager.find_module(programmable_module_name);
     VTR_ASSERT(true == module_manager.valid_module_id(programmable_module));
 
-    /* Go recursively in the module manager,
-     * starting from the top-level module: instance id of the top-level module
-     * is 0 by default Disable all the outputs of child modules that matches the
-     * mux_module id
+    /* Go through the module manager, starting from the top-level module,
+     * and disable the configure ports of child modules that matches the
+     * programmable module id
      */
     for (const CircuitPortId& sram_port :
          circuit_lib.model_ports_by_type(model, CIRCUIT_MODEL_PORT_SRAM)) {
@@ -77,10 +78,9 @@ static int print_sdc_disable_lut_configure_ports(
                   programmable_module, module_manager.find_module_port(
                                          programmable_module, sram_port_name)));
       if (CMD_EXEC_FATAL_ERROR ==
-          rec_print_sdc_disable_timing_for_module_ports(
-            fp, flatten_names, module_manager, top_module, programmable_module,
-            format_dir_path(module_manager.module_name(top_module)),
-            sram_port_name)) {
+          print_sdc_disable_timing_for_module_ports(
+            fp, flatten_names, module_scoped, module_manager, top_module,
+            programmable_module, sram_port_name)) {
         return CMD_EXEC_FATAL_ERROR;
       }
 
@@ -93,10 +93,9 @@ static int print_sdc_disable_lut_configure_ports(
         continue;
       }
       if (CMD_EXEC_FATAL_ERROR ==
-          rec_print_sdc_disable_timing_for_module_ports(
-            fp, flatten_names, module_manager, top_module, programmable_module,
-            format_dir_path(module_manager.module_name(top_module)),
-            sram_inv_port_name)) {
+          print_sdc_disable_timing_for_module_ports(
+            fp, flatten_names, module_scoped, module_manager, top_module,
+            programmable_module, sram_inv_port_name)) {
         return CMD_EXEC_FATAL_ERROR;
       }
     }
@@ -115,7 +114,7 @@ static int print_sdc_disable_lut_configure_ports(
  *   1: fatal error occurred
  *******************************************************************/
 static int print_sdc_disable_non_mux_circuit_configure_ports(
-  std::fstream& fp, const bool& flatten_names,
+  std::fstream& fp, const bool& flatten_names, const bool& module_scoped,
   const CircuitLibrary& circuit_lib, const ModuleManager& module_manager,
   const ModuleId& top_module) {
   if (false == valid_file_stream(fp)) {
@@ -147,10 +146,9 @@ static int print_sdc_disable_non_mux_circuit_configure_ports(
       module_manager.find_module(programmable_module_name);
     VTR_ASSERT(true == module_manager.valid_module_id(programmable_module));
 
-    /* Go recursively in the module manager,
-     * starting from the top-level module: instance id of the top-level module
-     * is 0 by default Disable all the outputs of child modules that matches the
-     * mux_module id
+    /* Go through the module manager, starting from the top-level module,
+     * and disable the configure ports of child modules that matches the
+     * programmable module id
      */
     for (const CircuitPortId& sram_port :
          find_circuit_mode_select_sram_ports(circuit_lib, model)) {
@@ -160,10 +158,9 @@ static int print_sdc_disable_non_mux_circuit_configure_ports(
                   programmable_module, module_manager.find_module_port(
                                          programmable_module, sram_port_name)));
       if (CMD_EXEC_FATAL_ERROR ==
-          rec_print_sdc_disable_timing_for_module_ports(
-            fp, flatten_names, module_manager, top_module, programmable_module,
-            format_dir_path(module_manager.module_name(top_module)),
-            sram_port_name)) {
+          print_sdc_disable_timing_for_module_ports(
+            fp, flatten_names, module_scoped, module_manager, top_module,
+            programmable_module, sram_port_name)) {
         return CMD_EXEC_FATAL_ERROR;
       }
     }
@@ -181,9 +178,9 @@ static int print_sdc_disable_non_mux_circuit_configure_ports(
  *******************************************************************/
 int print_sdc_disable_timing_configure_ports(
   const std::string& sdc_fname, const bool& flatten_names,
-  const MuxLibrary& mux_lib, const CircuitLibrary& circuit_lib,
-  const ModuleManager& module_manager, const bool& include_time_stamp,
-  const bool& verbose) {
+  const bool& module_scoped, const MuxLibrary& mux_lib,
+  const CircuitLibrary& circuit_lib, const ModuleManager& module_manager,
+  const bool& include_time_stamp, const bool& verbose) {
   /* Create the directory */
   create_directory(find_path_dir_name(sdc_fname));
 
@@ -194,9 +191,10 @@ int print_sdc_disable_timing_configure_ports(
       "cells for P&R flow '") +
     sdc_fname + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -215,8 +213,9 @@ int print_sdc_disable_timing_configure_ports(
   /* Disable timing for the configure ports of all the Look-Up Tables */
   VTR_LOGV(verbose, "Write disable timing for Look-Up Tables...");
   if (CMD_EXEC_FATAL_ERROR ==
-      print_sdc_disable_lut_configure_ports(fp, flatten_names, circuit_lib,
-                                            module_manager, top_module)) {
+      print_sdc_disable_lut_configure_ports(fp, flatten_names, module_scoped,
+                                            circuit_lib, module_manager,
+                                            top_module)) {
     VTR_LOGF_ERROR(__FILE__, __LINE__, "Fatal errors occurred\n");
     return CMD_EXEC_FATAL_ERROR;
   }
@@ -226,7 +225,8 @@ int print_sdc_disable_timing_configure_ports(
   VTR_LOGV(verbose, "Write disable timing for routing multiplexers...");
   if (CMD_EXEC_FATAL_ERROR ==
       print_sdc_disable_routing_multiplexer_configure_ports(
-        fp, flatten_names, mux_lib, circuit_lib, module_manager, top_module)) {
+        fp, flatten_names, module_scoped, mux_lib, circuit_lib, module_manager,
+        top_module)) {
     VTR_LOGF_ERROR(__FILE__, __LINE__, "Fatal errors occurred\n");
     return CMD_EXEC_FATAL_ERROR;
   }
@@ -236,7 +236,8 @@ int print_sdc_disable_timing_configure_ports(
   VTR_LOGV(verbose, "Write disable timing for other programmable modules...");
   if (CMD_EXEC_FATAL_ERROR ==
       print_sdc_disable_non_mux_circuit_configure_ports(
-        fp, flatten_names, circuit_lib, module_manager, top_module)) {
+        fp, flatten_names, module_scoped, circuit_lib, module_manager,
+        top_module)) {
     VTR_LOGF_ERROR(__FILE__, __LINE__, "Fatal errors occurred\n");
     return CMD_EXEC_FATAL_ERROR;
   }
@@ -20,9 +20,9 @@ namespace openfpga {
 
 int print_sdc_disable_timing_configure_ports(
   const std::string& sdc_fname, const bool& flatten_names,
-  const MuxLibrary& mux_lib, const CircuitLibrary& circuit_lib,
-  const ModuleManager& module_manager, const bool& include_time_stamp,
-  const bool& verbose);
+  const bool& module_scoped, const MuxLibrary& mux_lib,
+  const CircuitLibrary& circuit_lib, const ModuleManager& module_manager,
+  const bool& include_time_stamp, const bool& verbose);
 
 } /* end namespace openfpga */
 
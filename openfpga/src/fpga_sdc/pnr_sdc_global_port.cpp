@@ -18,9 +18,11 @@
 #include "vtr_time.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_port.h"
 #include "openfpga_scale.h"
+#include "openfpga_trace.h"
 #include "pnr_sdc_global_port.h"
 #include "sdc_writer_naming.h"
 #include "sdc_writer_utils.h"
@@ -46,7 +48,7 @@ static void print_pnr_sdc_clock_port(std::fstream& fp,
   fp << " -period " << std::setprecision(10) << clock_period;
   fp << " -waveform {0 " << std::setprecision(10) << clock_period / 2 << "}";
   fp << " [get_ports {" << generate_sdc_port(port_to_constrain) << "}]";
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -76,14 +78,14 @@ static void print_pnr_sdc_global_clock_ports(
     if (true == fabric_global_port_info.global_port_is_prog(global_port)) {
       clock_period = 1. / sim_setting.programming_clock_frequency();
       /* Print comments */
-      fp << "##################################################" << std::endl;
-      fp << "# Create programmable clock                       " << std::endl;
-      fp << "##################################################" << std::endl;
+      fp << "##################################################" << '\n';
+      fp << "# Create programmable clock                       " << '\n';
+      fp << "##################################################" << '\n';
     } else {
       /* Print comments */
-      fp << "##################################################" << std::endl;
-      fp << "# Create clock                                    " << std::endl;
-      fp << "##################################################" << std::endl;
+      fp << "##################################################" << '\n';
+      fp << "# Create clock                                    " << '\n';
+      fp << "##################################################" << '\n';
     }
 
     BasicPort clock_port = module_manager.module_port(
@@ -129,9 +131,9 @@ static void print_pnr_sdc_global_non_clock_ports(
     }
 
     /* Print comments */
-    fp << "##################################################" << std::endl;
-    fp << "# Constrain other global ports                    " << std::endl;
-    fp << "##################################################" << std::endl;
+    fp << "##################################################" << '\n';
+    fp << "# Constrain other global ports                    " << '\n';
+    fp << "##################################################" << '\n';
 
     /* Reach here, it means a non-clock global port and we need print
      * constraints */
@@ -175,9 +177,10 @@ void print_pnr_sdc_global_ports(const PnrSdcOption& options,
     std::string("Write SDC for constraining clocks for P&R flow '") +
     sdc_fname + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -9,6 +9,7 @@
  *******************************************************************/
 #include <ctime>
 #include <fstream>
+#include <map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -17,14 +18,17 @@
 
 /* Headers from openfpgautil library */
 #include "mux_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_interconnect_types.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "openfpga_physical_tile_utils.h"
 #include "openfpga_port.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_scale.h"
 #include "openfpga_side_manager.h"
+#include "openfpga_trace.h"
 #include "pb_graph_utils.h"
 #include "pb_type_utils.h"
 #include "pnr_sdc_grid_writer.h"
@@ -269,7 +273,7 @@ static void print_pnr_sdc_constrain_pb_graph_node_timing(
                         std::string(SDC_FILE_NAME_POSTFIX));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -389,7 +393,7 @@ static void print_pnr_sdc_constrain_primitive_pb_graph_node(
                         std::string(SDC_FILE_NAME_POSTFIX));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -476,28 +480,36 @@ static void print_pnr_sdc_constrain_primitive_pb_graph_node(
 }
 
 /********************************************************************
- * Recursively print SDC timing constraints for a pb_type
- * This function will generate a SDC file for each pb_type,
+ * A SDC file to be written for a pb_type, which is a pb_graph_node
+ * under a given hierarchical path
+ *******************************************************************/
+struct PnrSdcPbGraphTask {
+  std::string module_path;
+  t_pb_graph_node* pb_graph_node;
+};
+
+/********************************************************************
+ * Recursively collect the SDC files to be written for a pb_type
+ * A SDC file is required for each pb_type,
  * constraining the pin-to-pin timing
  *******************************************************************/
-static void rec_print_pnr_sdc_constrain_pb_graph_timing(
-  const PnrSdcOption& options, const std::string& module_path,
-  const ModuleManager& module_manager,
-  const VprDeviceAnnotation& device_annotation,
-  t_pb_graph_node* parent_pb_graph_node) {
+static void rec_collect_pnr_sdc_constrain_pb_graph_timing_tasks(
+  const std::string& module_path, const VprDeviceAnnotation& device_annotation,
+  t_pb_graph_node* parent_pb_graph_node,
+  std::vector<PnrSdcPbGraphTask>& tasks) {
   /* Validate pb_graph node */
   if (nullptr == parent_pb_graph_node) {
     VTR_LOGF_ERROR(__FILE__, __LINE__, "Invalid parent_pb_graph_node.\n");
     exit(1);
   }
 
+  tasks.push_back({module_path, parent_pb_graph_node});
+
   /* Get the pb_type */
   t_pb_type* parent_pb_type = parent_pb_graph_node->pb_type;
 
-  /* Constrain the primitive node if a timing matrix is defined */
+  /* The primitive node has no child to visit */
   if (true == is_primitive_pb_type(parent_pb_type)) {
-    print_pnr_sdc_constrain_primitive_pb_graph_node(
-      options, module_path, module_manager, parent_pb_graph_node);
     return;
   }
 
@@ -506,24 +518,42 @@ static void rec_print_pnr_sdc_constrain_pb_graph_timing(
    */
   t_mode* physical_mode = device_annotation.physical_mode(parent_pb_type);
 
-  /* Write a SDC file for this pb_type */
-  print_pnr_sdc_constrain_pb_graph_node_timing(
-    options, module_path, module_manager, parent_pb_graph_node, physical_mode);
-
   /* Go recursively to the lower level in the pb_graph
    * Note that we assume a full hierarchical P&R, we will only visit
    * pb_graph_node of unique pb_type
    */
   for (int ipb = 0; ipb < physical_mode->num_pb_type_children; ++ipb) {
-    rec_print_pnr_sdc_constrain_pb_graph_timing(
-      options,
+    rec_collect_pnr_sdc_constrain_pb_graph_timing_tasks(
       format_dir_path(module_path +
                       generate_physical_block_instance_name(
                         &(physical_mode->pb_type_children[ipb]), ipb)),
-      module_manager, device_annotation,
+      device_annotation,
       &(parent_pb_graph_node
-          ->child_pb_graph_nodes[physical_mode->index][ipb][0]));
+          ->child_pb_graph_nodes[physical_mode->index][ipb][0]),
+      tasks);
+  }
+}
+
+/********************************************************************
+ * Print the SDC file of a pb_type
+ * - The primitive node is constrained if a timing matrix is defined
+ * - Other nodes are constrained by the interconnection of their
+ *   physical mode
+ *******************************************************************/
+static void print_pnr_sdc_constrain_pb_graph_task(
+  const PnrSdcOption& options, const ModuleManager& module_manager,
+  const VprDeviceAnnotation& device_annotation,
+  const PnrSdcPbGraphTask& task) {
+  t_pb_type* pb_type = task.pb_graph_node->pb_type;
+  if (true == is_primitive_pb_type(pb_type)) {
+    print_pnr_sdc_constrain_primitive_pb_graph_node(
+      options, task.module_path, module_manager, task.pb_graph_node);
+    return;
   }
+
+  print_pnr_sdc_constrain_pb_graph_node_timing(
+    options, task.module_path, module_manager, task.pb_graph_node,
+    device_annotation.physical_mode(pb_type));
 }
 
 /********************************************************************
@@ -536,10 +566,12 @@ void print_pnr_sdc_constrain_grid_timing(
   /* Start time count */
   vtr::ScopedStartFinishTimer timer(
     "Write SDC for constraining grid timing for P&R flow");
+  OPENFPGA_TRACE_FUNCTION();
 
   std::string root_path =
     format_dir_path(module_manager.module_name(top_module));
 
+  std::vector<PnrSdcPbGraphTask> tasks;
   for (const t_physical_tile_type& physical_tile :
        device_ctx.physical_tile_types) {
     /* Bypass empty type or nullptr */
@@ -585,9 +617,8 @@ void print_pnr_sdc_constrain_grid_timing(
                                             pb_graph_head->pb_type,
                                             pb_graph_head->placement_index));
 
-          rec_print_pnr_sdc_constrain_pb_graph_timing(
-            options, module_path, module_manager, device_annotation,
-            pb_graph_head);
+          rec_collect_pnr_sdc_constrain_pb_graph_timing_tasks(
+            module_path, device_annotation, pb_graph_head, tasks);
         }
       } else {
         /* For CLB and heterogenenous blocks */
@@ -604,12 +635,33 @@ void print_pnr_sdc_constrain_grid_timing(
                                           pb_graph_head->pb_type,
                                           pb_graph_head->placement_index));
 
-        rec_print_pnr_sdc_constrain_pb_graph_timing(
-          options, module_path, module_manager, device_annotation,
-          pb_graph_head);
+        rec_collect_pnr_sdc_constrain_pb_graph_timing_tasks(
+          module_path, device_annotation, pb_graph_head, tasks);
       }
     }
   }
+
+  /* A pb_type may be visited under different grids, e.g., I/O blocks on
+   * different sides, while its SDC file is named after the pb_type.
+   * Keep only the last visit of each pb_type, whose file remains when
+   * the files are written in sequence, so that no file is written by
+   * two threads */
+  std::map<t_pb_type*, size_t> last_pb_type_tasks;
+  for (size_t itask = 0; itask < tasks.size(); ++itask) {
+    last_pb_type_tasks[tasks[itask].pb_graph_node->pb_type] = itask;
+  }
+  std::vector<PnrSdcPbGraphTask> unique_tasks;
+  for (size_t itask = 0; itask < tasks.size(); ++itask) {
+    if (itask == last_pb_type_tasks[tasks[itask].pb_graph_node->pb_type]) {
+      unique_tasks.push_back(tasks[itask]);
+    }
+  }
+
+  parallel_for_dynamic(
+    unique_tasks.size(), options.num_threads(), [&](const size_t& itask) {
+      print_pnr_sdc_constrain_pb_graph_task(
+        options, module_manager, device_annotation, unique_tasks[itask]);
+    });
 }
 
 } /* end namespace openfpga */
@@ -6,6 +6,7 @@
  * in purpose of constraining physical design of FPGA fabric in back-end flow
  ********************************************************************/
 
+#include <cstddef>
 #include <string>
 
 /* begin namespace openfpga */
@@ -32,6 +33,7 @@ class PnrSdcOption {
   bool constrain_switch_block_outputs() const;
   bool constrain_zero_delay_paths() const;
   bool time_stamp() const;
+  size_t num_threads() const;
 
  public: /* Public mutators */
   void set_sdc_dir(const std::string& sdc_dir);
@@ -53,6 +55,7 @@ class PnrSdcOption {
   void set_constrain_switch_block_outputs(const bool& constrain_sb_outputs);
   void set_constrain_zero_delay_paths(const bool& constrain_zero_delay_paths);
   void set_time_stamp(const bool& enable);
+  void set_num_threads(const size_t& num_threads);
 
  private: /* Internal data */
   std::string sdc_dir_;
@@ -70,6 +73,8 @@ class PnrSdcOption {
   bool constrain_switch_block_outputs_;
   bool constrain_zero_delay_paths_;
   bool time_stamp_;
+  /* Number of threads to write the SDC files of grids, SBs and CBs */
+  size_t num_threads_;
 };
 
 } /* end namespace openfpga */
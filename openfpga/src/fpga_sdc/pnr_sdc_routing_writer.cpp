@@ -19,12 +19,15 @@
 /* Headers from openfpgautil library */
 #include "build_routing_module_utils.h"
 #include "mux_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "openfpga_port.h"
 #include "openfpga_rr_graph_utils.h"
 #include "openfpga_scale.h"
 #include "openfpga_side_manager.h"
+#include "openfpga_trace.h"
 #include "pnr_sdc_routing_writer.h"
 #include "sdc_writer_naming.h"
 #include "sdc_writer_utils.h"
@@ -40,6 +43,16 @@ static float find_pnr_sdc_switch_tmax(const t_rr_switch_inf& switch_inf) {
   return switch_inf.R * switch_inf.Cout + switch_inf.Tdel;
 }
 
+/********************************************************************
+ * A SDC file to be written for a routing block, i.e., a SB or a CB.
+ * The cb_type is only used by CBs
+ *******************************************************************/
+struct PnrSdcRoutingTask {
+  std::string module_path;
+  const RRGSB* rr_gsb;
+  t_rr_type cb_type;
+};
+
 /********************************************************************
  * Set timing constraints between the inputs and outputs of a routing
  * multiplexer in a Switch Block
@@ -142,7 +155,7 @@ static void print_pnr_sdc_constrain_sb_timing(
                         std::string(SDC_FILE_NAME_POSTFIX));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate file stream */
@@ -190,6 +203,22 @@ static void print_pnr_sdc_constrain_sb_timing(
   fp.close();
 }
 
+/********************************************************************
+ * Write the SDC files of a list of switch blocks on multiple threads.
+ * Each task writes its own file, so that tasks are independent
+ *******************************************************************/
+static void print_pnr_sdc_constrain_sb_timing_tasks(
+  const PnrSdcOption& options, const ModuleManager& module_manager,
+  const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
+  const RRGraphView& rr_graph, const std::vector<PnrSdcRoutingTask>& tasks) {
+  parallel_for_dynamic(
+    tasks.size(), options.num_threads(), [&](const size_t& itask) {
+      print_pnr_sdc_constrain_sb_timing(
+        options, tasks[itask].module_path, module_manager, device_annotation,
+        grids, rr_graph, *(tasks[itask].rr_gsb));
+    });
+}
+
 /********************************************************************
  * Print SDC timing constraints for Switch blocks
  * This function is designed for flatten routing hierarchy
@@ -202,11 +231,13 @@ void print_pnr_sdc_flatten_routing_constrain_sb_timing(
   /* Start time count */
   vtr::ScopedStartFinishTimer timer(
     "Write SDC for constrain Switch Block timing for P&R flow");
+  OPENFPGA_TRACE_FUNCTION();
 
   std::string root_path = module_manager.module_name(top_module);
 
   /* Get the range of SB array */
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
+  std::vector<PnrSdcRoutingTask> tasks;
   /* Go for each SB */
   for (size_t ix = 0; ix < sb_range.x(); ++ix) {
     for (size_t iy = 0; iy < sb_range.y(); ++iy) {
@@ -224,11 +255,13 @@ void print_pnr_sdc_flatten_routing_constrain_sb_timing(
 
       std::string module_path = format_dir_path(root_path) + sb_instance_name;
 
-      print_pnr_sdc_constrain_sb_timing(options, module_path, module_manager,
-                                        device_annotation, grids, rr_graph,
-                                        rr_gsb);
+      tasks.push_back({module_path, &rr_gsb, NUM_RR_TYPES});
     }
   }
+
+  print_pnr_sdc_constrain_sb_timing_tasks(options, module_manager,
+                                          device_annotation, grids, rr_graph,
+                                          tasks);
 }
 
 /********************************************************************
@@ -243,9 +276,11 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(
   /* Start time count */
   vtr::ScopedStartFinishTimer timer(
     "Write SDC for constrain Switch Block timing for P&R flow");
+  OPENFPGA_TRACE_FUNCTION();
 
   std::string root_path = module_manager.module_name(top_module);
 
+  std::vector<PnrSdcRoutingTask> tasks;
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
     const RRGSB& rr_gsb = device_rr_gsb.get_sb_unique_module(isb);
     if (false == rr_gsb.is_sb_exist()) {
@@ -264,10 +299,12 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(
 
     std::string module_path = format_dir_path(root_path) + sb_module_name;
 
-    print_pnr_sdc_constrain_sb_timing(options, module_path, module_manager,
-                                      device_annotation, grids, rr_graph,
-                                      rr_gsb);
+    tasks.push_back({module_path, &rr_gsb, NUM_RR_TYPES});
   }
+
+  print_pnr_sdc_constrain_sb_timing_tasks(options, module_manager,
+                                          device_annotation, grids, rr_graph,
+                                          tasks);
 }
 
 /********************************************************************
@@ -389,7 +426,7 @@ static void print_pnr_sdc_constrain_cb_timing(
     std::string(SDC_FILE_NAME_POSTFIX));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate file stream */
@@ -485,14 +522,29 @@ static void print_pnr_sdc_constrain_cb_timing(
 }
 
 /********************************************************************
- * Iterate over all the connection blocks in a device
- * and print SDC file for each of them
+ * Write the SDC files of a list of connection blocks on multiple threads.
+ * Each task writes its own file, so that tasks are independent
  *******************************************************************/
-static void print_pnr_sdc_flatten_routing_constrain_cb_timing(
+static void print_pnr_sdc_constrain_cb_timing_tasks(
   const PnrSdcOption& options, const ModuleManager& module_manager,
-  const ModuleId& top_module, const VprDeviceAnnotation& device_annotation,
-  const DeviceGrid& grids, const RRGraphView& rr_graph,
-  const DeviceRRGSB& device_rr_gsb, const t_rr_type& cb_type) {
+  const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
+  const RRGraphView& rr_graph, const std::vector<PnrSdcRoutingTask>& tasks) {
+  parallel_for_dynamic(
+    tasks.size(), options.num_threads(), [&](const size_t& itask) {
+      print_pnr_sdc_constrain_cb_timing(
+        options, tasks[itask].module_path, module_manager, device_annotation,
+        grids, rr_graph, *(tasks[itask].rr_gsb), tasks[itask].cb_type);
+    });
+}
+
+/********************************************************************
+ * Iterate over all the connection blocks in a device
+ * and collect a SDC file to be written for each of them
+ *******************************************************************/
+static void collect_pnr_sdc_flatten_routing_constrain_cb_tasks(
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const DeviceRRGSB& device_rr_gsb, const t_rr_type& cb_type,
+  std::vector<PnrSdcRoutingTask>& tasks) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
@@ -521,9 +573,7 @@ static void print_pnr_sdc_flatten_routing_constrain_cb_timing(
 
       std::string module_path = format_dir_path(root_path) + cb_instance_name;
 
-      print_pnr_sdc_constrain_cb_timing(options, module_path, module_manager,
-                                        device_annotation, grids, rr_graph,
-                                        rr_gsb, cb_type);
+      tasks.push_back({module_path, &rr_gsb, cb_type});
     }
   }
 }
@@ -540,14 +590,18 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(
   /* Start time count */
   vtr::ScopedStartFinishTimer timer(
     "Write SDC for constrain Connection Block timing for P&R flow");
+  OPENFPGA_TRACE_FUNCTION();
 
-  print_pnr_sdc_flatten_routing_constrain_cb_timing(
-    options, module_manager, top_module, device_annotation, grids, rr_graph,
-    device_rr_gsb, CHANX);
+  std::vector<PnrSdcRoutingTask> tasks;
+  collect_pnr_sdc_flatten_routing_constrain_cb_tasks(
+    module_manager, top_module, device_rr_gsb, CHANX, tasks);
 
-  print_pnr_sdc_flatten_routing_constrain_cb_timing(
-    options, module_manager, top_module, device_annotation, grids, rr_graph,
-    device_rr_gsb, CHANY);
+  collect_pnr_sdc_flatten_routing_constrain_cb_tasks(
+    module_manager, top_module, device_rr_gsb, CHANY, tasks);
+
+  print_pnr_sdc_constrain_cb_timing_tasks(options, module_manager,
+                                          device_annotation, grids, rr_graph,
+                                          tasks);
 }
 
 /********************************************************************
@@ -562,9 +616,12 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(
   /* Start time count */
   vtr::ScopedStartFinishTimer timer(
     "Write SDC for constrain Connection Block timing for P&R flow");
+  OPENFPGA_TRACE_FUNCTION();
 
   std::string root_path = module_manager.module_name(top_module);
 
+  std::vector<PnrSdcRoutingTask> tasks;
+
   /* Print SDC for unique X-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX);
        ++icb) {
@@ -582,9 +639,7 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(
 
     std::string module_path = format_dir_path(root_path) + cb_module_name;
 
-    print_pnr_sdc_constrain_cb_timing(options, module_path, module_manager,
-                                      device_annotation, grids, rr_graph,
-                                      unique_mirror, CHANX);
+    tasks.push_back({module_path, &unique_mirror, CHANX});
   }
 
   /* Print SDC for unique Y-direction connection block modules */
@@ -604,10 +659,12 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(
 
     std::string module_path = format_dir_path(root_path) + cb_module_name;
 
-    print_pnr_sdc_constrain_cb_timing(options, module_path, module_manager,
-                                      device_annotation, grids, rr_graph,
-                                      unique_mirror, CHANY);
+    tasks.push_back({module_path, &unique_mirror, CHANY});
   }
+
+  print_pnr_sdc_constrain_cb_timing_tasks(options, module_manager,
+                                          device_annotation, grids, rr_graph,
+                                          tasks);
 }
 
 } /* end namespace openfpga */
@@ -11,6 +11,7 @@
 #include <ctime>
 #include <fstream>
 #include <iomanip>
+#include <set>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -19,9 +20,11 @@
 
 /* Headers from openfpgautil library */
 #include "mux_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "openfpga_port.h"
+#include "openfpga_trace.h"
 #include "openfpga_wildcard_string.h"
 #include "pnr_sdc_global_port.h"
 #include "pnr_sdc_grid_writer.h"
@@ -55,9 +58,10 @@ static void print_pnr_sdc_constrain_configurable_memory_outputs(
       "Write SDC to disable configurable memory outputs for P&R flow '") +
     sdc_fname + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -77,6 +81,54 @@ static void print_pnr_sdc_constrain_configurable_memory_outputs(
   fp.close();
 }
 
+/********************************************************************
+ * Disable the timing at the outputs of a Switch block instance
+ *
+ * When wildcards are allowed, both the instance name and the port names
+ * are adapted to wildcard names, e.g., fpga_top/sb_*__*_/chanx_left_out
+ * Such a pattern covers the outputs of all the Switch block instances
+ * whose names differ only by their coordinates. Each pattern is output
+ * only once across the fabric, no matter which module or instance it
+ * comes from, so that the size of the SDC file depends on the number of
+ * unique patterns rather than the number of instances.
+ * The set of disabled pins is the same as listing every instance
+ *******************************************************************/
+static void print_pnr_sdc_disable_switch_block_instance_outputs(
+  std::fstream& fp, const bool& flatten_names,
+  const ModuleManager& module_manager, const ModuleId& sb_module,
+  const std::string& root_path, const std::string& sb_instance_name,
+  std::set<std::string>& disabled_patterns) {
+  std::string module_path = root_path;
+  if (false == flatten_names) {
+    /* Try to adapt to a wildcard name: replace all the numbers with a
+     * wildcard character '*' */
+    module_path += WildCardString(sb_instance_name).data();
+  } else {
+    module_path += sb_instance_name;
+  }
+  module_path = format_dir_path(module_path);
+
+  /* Disable the outputs of the module */
+  for (const BasicPort& output_port : module_manager.module_ports_by_type(
+         sb_module, ModuleManager::MODULE_OUTPUT_PORT)) {
+    std::string port_name = output_port.get_name();
+    if (false == flatten_names) {
+      port_name = WildCardString(output_port.get_name()).data();
+    }
+
+    /* If the pattern has been output, we can skip this */
+    if (false == disabled_patterns.insert(module_path + port_name).second) {
+      continue;
+    }
+
+    fp << "set_disable_timing ";
+    fp << module_path;
+    fp << port_name << '\n';
+
+    fp << '\n';
+  }
+}
+
 /********************************************************************
  * Break combinational loops in FPGA fabric, which mainly come from
  * loops of multiplexers.
@@ -96,9 +148,10 @@ static void print_pnr_sdc_flatten_routing_disable_switch_block_outputs(
     std::string("Write SDC to disable switch block outputs for P&R flow '") +
     sdc_fname + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -110,11 +163,8 @@ static void print_pnr_sdc_flatten_routing_disable_switch_block_outputs(
   std::string root_path =
     format_dir_path(module_manager.module_name(top_module));
 
-  /* Build wildcard names for the instance names of multiple-instanced-blocks
-   * (MIB) We will find all the instance names and see there are common prefix
-   * If so, we can use wildcards
-   */
-  std::map<ModuleId, std::vector<std::string>> wildcard_names;
+  /* Patterns which have been output */
+  std::set<std::string> disabled_patterns;
 
   /* Get the range of SB array */
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
@@ -127,8 +177,6 @@ static void print_pnr_sdc_flatten_routing_disable_switch_block_outputs(
         continue;
       }
 
-      std::string module_path = root_path;
-
       vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
       std::string sb_instance_name =
         generate_switch_block_module_name(gsb_coordinate);
@@ -136,65 +184,9 @@ static void print_pnr_sdc_flatten_routing_disable_switch_block_outputs(
       ModuleId sb_module = module_manager.find_module(sb_instance_name);
       VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
 
-      if (false == flatten_names) {
-        /* Try to adapt to a wildcard name: replace all the numbers with a
-         * wildcard character '*' */
-        WildCardString wildcard_str(sb_instance_name);
-        /* If the wildcard name is already in the list, we can skip this
-         * Otherwise, we have to
-         *   - output this instance
-         *   - record the wildcard name in the map
-         */
-        if ((0 < wildcard_names.count(sb_module)) &&
-            (wildcard_names.at(sb_module).end() !=
-             std::find(wildcard_names.at(sb_module).begin(),
-                       wildcard_names.at(sb_module).end(),
-                       wildcard_str.data()))) {
-          continue;
-        }
-
-        module_path += wildcard_str.data();
-
-        wildcard_names[sb_module].push_back(wildcard_str.data());
-      } else {
-        module_path += sb_instance_name;
-      }
-
-      module_path = format_dir_path(module_path);
-
-      std::vector<std::string> port_wildcard_names;
-
-      /* Disable the outputs of the module */
-      for (const BasicPort& output_port : module_manager.module_ports_by_type(
-             sb_module, ModuleManager::MODULE_OUTPUT_PORT)) {
-        std::string port_name = output_port.get_name();
-
-        if (false == flatten_names) {
-          /* Try to adapt to a wildcard name: replace all the numbers with a
-           * wildcard character '*' */
-          WildCardString port_wildcard_str(output_port.get_name());
-          /* If the wildcard name is already in the list, we can skip this
-           * Otherwise, we have to
-           *   - output this port
-           *   - record the wildcard name in the vector
-           */
-          if (port_wildcard_names.end() !=
-              std::find(port_wildcard_names.begin(), port_wildcard_names.end(),
-                        port_wildcard_str.data())) {
-            continue;
-          }
-
-          port_name = port_wildcard_str.data();
-
-          port_wildcard_names.push_back(port_wildcard_str.data());
-        }
-
-        fp << "set_disable_timing ";
-        fp << module_path;
-        fp << port_name << std::endl;
-
-        fp << std::endl;
-      }
+      print_pnr_sdc_disable_switch_block_instance_outputs(
+        fp, flatten_names, module_manager, sb_module, root_path,
+        sb_instance_name, disabled_patterns);
     }
   }
 
@@ -221,9 +213,10 @@ static void print_pnr_sdc_compact_routing_disable_switch_block_outputs(
     std::string("Write SDC to disable switch block outputs for P&R flow '") +
     sdc_fname + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -235,11 +228,8 @@ static void print_pnr_sdc_compact_routing_disable_switch_block_outputs(
   std::string root_path =
     format_dir_path(module_manager.module_name(top_module));
 
-  /* Build wildcard names for the instance names of multiple-instanced-blocks
-   * (MIB) We will find all the instance names and see there are common prefix
-   * If so, we can use wildcards
-   */
-  std::map<ModuleId, std::vector<std::string>> wildcard_names;
+  /* Patterns which have been output */
+  std::set<std::string> disabled_patterns;
 
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
@@ -256,73 +246,15 @@ static void print_pnr_sdc_compact_routing_disable_switch_block_outputs(
     ModuleId sb_module = module_manager.find_module(sb_module_name);
     VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
 
-    std::string module_path = root_path;
-
     /* Find all the instances in the top-level module */
     for (const size_t& instance_id :
          module_manager.child_module_instances(top_module, sb_module)) {
       std::string sb_instance_name =
         module_manager.instance_name(top_module, sb_module, instance_id);
 
-      if (false == flatten_names) {
-        /* Try to adapt to a wildcard name: replace all the numbers with a
-         * wildcard character '*' */
-        WildCardString wildcard_str(sb_instance_name);
-        /* If the wildcard name is already in the list, we can skip this
-         * Otherwise, we have to
-         *   - output this instance
-         *   - record the wildcard name in the map
-         */
-        if ((0 < wildcard_names.count(sb_module)) &&
-            (wildcard_names.at(sb_module).end() !=
-             std::find(wildcard_names.at(sb_module).begin(),
-                       wildcard_names.at(sb_module).end(),
-                       wildcard_str.data()))) {
-          continue;
-        }
-
-        module_path += wildcard_str.data();
-
-        wildcard_names[sb_module].push_back(wildcard_str.data());
-      } else {
-        module_path += sb_instance_name;
-      }
-
-      module_path = format_dir_path(module_path);
-
-      std::vector<std::string> port_wildcard_names;
-
-      /* Disable the outputs of the module */
-      for (const BasicPort& output_port : module_manager.module_ports_by_type(
-             sb_module, ModuleManager::MODULE_OUTPUT_PORT)) {
-        std::string port_name = output_port.get_name();
-
-        if (false == flatten_names) {
-          /* Try to adapt to a wildcard name: replace all the numbers with a
-           * wildcard character '*' */
-          WildCardString port_wildcard_str(output_port.get_name());
-          /* If the wildcard name is already in the list, we can skip this
-           * Otherwise, we have to
-           *   - output this port
-           *   - record the wildcard name in the vector
-           */
-          if (port_wildcard_names.end() !=
-              std::find(port_wildcard_names.begin(), port_wildcard_names.end(),
-                        port_wildcard_str.data())) {
-            continue;
-          }
-
-          port_name = port_wildcard_str.data();
-
-          port_wildcard_names.push_back(port_wildcard_str.data());
-        }
-
-        fp << "set_disable_timing ";
-        fp << module_path;
-        fp << port_name << std::endl;
-
-        fp << std::endl;
-      }
+      print_pnr_sdc_disable_switch_block_instance_outputs(
+        fp, flatten_names, module_manager, sb_module, root_path,
+        sb_instance_name, disabled_patterns);
     }
   }
 
@@ -7,10 +7,12 @@
 #include "vtr_time.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "openfpga_physical_tile_utils.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "pb_type_utils.h"
 #include "sdc_hierarchy_writer.h"
 #include "sdc_writer_naming.h"
@@ -45,12 +47,13 @@ void print_pnr_sdc_routing_sb_hierarchy(const std::string& sdc_dir,
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Use default name if user does not provide one */
   VTR_ASSERT(true != fname.empty());
 
   /* Create a file handler*/
-  std::fstream fp;
+  BufferedFileStream fp;
   /* Open a file */
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
@@ -131,12 +134,13 @@ void print_pnr_sdc_routing_cb_hierarchy(const std::string& sdc_dir,
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Use default name if user does not provide one */
   VTR_ASSERT(true != fname.empty());
 
   /* Create a file handler*/
-  std::fstream fp;
+  BufferedFileStream fp;
   /* Open a file */
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
@@ -285,12 +289,13 @@ void print_pnr_sdc_grid_hierarchy(const std::string& sdc_dir,
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Use default name if user does not provide one */
   VTR_ASSERT(true != fname.empty());
 
   /* Create a file handler*/
-  std::fstream fp;
+  BufferedFileStream fp;
   /* Open a file */
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
@@ -14,9 +14,11 @@
 /* Headers from openfpgautil library */
 #include "circuit_library_utils.h"
 #include "mux_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "sdc_mux_utils.h"
 #include "sdc_writer_naming.h"
 #include "sdc_writer_utils.h"
@@ -44,9 +46,10 @@ void print_sdc_disable_routing_multiplexer_outputs(
       "Write SDC to disable routing multiplexer outputs for P&R flow '") +
     sdc_fname + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(sdc_fname.c_str(), fp);
@@ -105,9 +108,9 @@ void print_sdc_disable_routing_multiplexer_outputs(
  *   1: fatal error occurred
  *******************************************************************/
 int print_sdc_disable_routing_multiplexer_configure_ports(
-  std::fstream& fp, const bool& flatten_names, const MuxLibrary& mux_lib,
-  const CircuitLibrary& circuit_lib, const ModuleManager& module_manager,
-  const ModuleId& top_module) {
+  std::fstream& fp, const bool& flatten_names, const bool& module_scoped,
+  const MuxLibrary& mux_lib, const CircuitLibrary& circuit_lib,
+  const ModuleManager& module_manager, const ModuleId& top_module) {
   if (false == valid_file_stream(fp)) {
     return CMD_EXEC_FATAL_ERROR;
   }
@@ -145,10 +148,9 @@ int print_sdc_disable_routing_multiplexer_configure_ports(
                            mux_module, module_manager.find_module_port(
                                          mux_module, mux_sram_port_name)));
       if (CMD_EXEC_FATAL_ERROR ==
-          rec_print_sdc_disable_timing_for_module_ports(
-            fp, flatten_names, module_manager, top_module, mux_module,
-            format_dir_path(module_manager.module_name(top_module)),
-            mux_sram_port_name)) {
+          print_sdc_disable_timing_for_module_ports(
+            fp, flatten_names, module_scoped, module_manager, top_module,
+            mux_module, mux_sram_port_name)) {
         return CMD_EXEC_FATAL_ERROR;
       }
 
@@ -158,10 +160,9 @@ int print_sdc_disable_routing_multiplexer_configure_ports(
                            mux_module, module_manager.find_module_port(
                                          mux_module, mux_sram_inv_port_name)));
       if (CMD_EXEC_FATAL_ERROR ==
-          rec_print_sdc_disable_timing_for_module_ports(
-            fp, flatten_names, module_manager, top_module, mux_module,
-            format_dir_path(module_manager.module_name(top_module)),
-            mux_sram_inv_port_name)) {
+          print_sdc_disable_timing_for_module_ports(
+            fp, flatten_names, module_scoped, module_manager, top_module,
+            mux_module, mux_sram_inv_port_name)) {
         return CMD_EXEC_FATAL_ERROR;
       }
     }
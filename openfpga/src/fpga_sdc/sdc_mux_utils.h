@@ -25,9 +25,9 @@ void print_sdc_disable_routing_multiplexer_outputs(
   const ModuleId& top_module);
 
 int print_sdc_disable_routing_multiplexer_configure_ports(
-  std::fstream& fp, const bool& flatten_names, const MuxLibrary& mux_lib,
-  const CircuitLibrary& circuit_lib, const ModuleManager& module_manager,
-  const ModuleId& top_module);
+  std::fstream& fp, const bool& flatten_names, const bool& module_scoped,
+  const MuxLibrary& mux_lib, const CircuitLibrary& circuit_lib,
+  const ModuleManager& module_manager, const ModuleId& top_module);
 
 } /* end namespace openfpga */
 
@@ -1,17 +1,23 @@
 /********************************************************************
  * This file include most utilized functions to be used in SDC writers
  *******************************************************************/
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <ctime>
 #include <iomanip>
 #include <map>
+#include <set>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "openfpga_wildcard_string.h"
 #include "sdc_writer_utils.h"
 
@@ -25,12 +31,12 @@ void print_sdc_file_header(std::fstream& fp, const std::string& usage,
                            const bool& include_time_stamp) {
   valid_file_stream(fp);
 
-  fp << "#############################################" << std::endl;
-  fp << "#\tSynopsys Design Constraints (SDC)" << std::endl;
-  fp << "#\tFor FPGA fabric " << std::endl;
-  fp << "#\tDescription: " << usage << std::endl;
-  fp << "#\tAuthor: Xifan TANG " << std::endl;
-  fp << "#\tOrganization: University of Utah " << std::endl;
+  fp << "#############################################" << '\n';
+  fp << "#\tSynopsys Design Constraints (SDC)" << '\n';
+  fp << "#\tFor FPGA fabric " << '\n';
+  fp << "#\tDescription: " << usage << '\n';
+  fp << "#\tAuthor: Xifan TANG " << '\n';
+  fp << "#\tOrganization: University of Utah " << '\n';
 
   if (include_time_stamp) {
     auto end = std::chrono::system_clock::now();
@@ -38,8 +44,8 @@ void print_sdc_file_header(std::fstream& fp, const std::string& usage,
     fp << "#\tDate: " << std::ctime(&end_time);
   }
 
-  fp << "#############################################" << std::endl;
-  fp << std::endl;
+  fp << "#############################################" << '\n';
+  fp << '\n';
 }
 
 /********************************************************************
@@ -48,11 +54,11 @@ void print_sdc_file_header(std::fstream& fp, const std::string& usage,
 void print_sdc_timescale(std::fstream& fp, const std::string& timescale) {
   valid_file_stream(fp);
 
-  fp << "#############################################" << std::endl;
-  fp << "#\tDefine time unit " << std::endl;
-  fp << "#############################################" << std::endl;
-  fp << "set_units -time " << timescale << std::endl;
-  fp << std::endl;
+  fp << "#############################################" << '\n';
+  fp << "#\tDefine time unit " << '\n';
+  fp << "#############################################" << '\n';
+  fp << "set_units -time " << timescale << '\n';
+  fp << '\n';
 }
 
 /********************************************************************
@@ -112,7 +118,7 @@ void print_pnr_sdc_constrain_max_delay(std::fstream& fp,
 
   fp << " " << std::setprecision(10) << delay;
 
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -150,7 +156,7 @@ void print_pnr_sdc_regexp_constrain_max_delay(
 
   fp << " " << std::setprecision(10) << delay;
 
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -183,7 +189,45 @@ void print_pnr_sdc_constrain_min_delay(std::fstream& fp,
 
   fp << " " << std::setprecision(10) << delay;
 
-  fp << std::endl;
+  fp << '\n';
+}
+
+/********************************************************************
+ * Constrain a path between two ports of a module with a given minimum timing
+ *value This function use regular expression and get_pins which are from
+ *open-source SDC 2.1 format
+ *******************************************************************/
+void print_pnr_sdc_regexp_constrain_min_delay(
+  std::fstream& fp, const std::string& src_instance_name,
+  const std::string& src_port_name, const std::string& des_instance_name,
+  const std::string& des_port_name, const float& delay) {
+  /* Validate file stream */
+  valid_file_stream(fp);
+
+  fp << "set_min_delay";
+
+  fp << " -from ";
+  fp << "[get_pins -regexp \"";
+  if (!src_instance_name.empty()) {
+    fp << format_dir_path(src_instance_name);
+  }
+  fp << src_port_name;
+
+  fp << "\"]";
+
+  fp << " -to ";
+  fp << "[get_pins -regexp \"";
+
+  if (!des_instance_name.empty()) {
+    fp << format_dir_path(des_instance_name);
+  }
+  fp << des_port_name;
+
+  fp << "\"]";
+
+  fp << " " << std::setprecision(10) << delay;
+
+  fp << '\n';
 }
 
 /********************************************************************
@@ -238,7 +282,7 @@ void print_sdc_disable_port_timing(std::fstream& fp, const BasicPort& port) {
 
   fp << generate_sdc_port(port);
 
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -265,7 +309,7 @@ void print_sdc_set_port_input_delay(std::fstream& fp, const BasicPort& port,
 
   fp << generate_sdc_port(port);
 
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -292,7 +336,7 @@ void print_sdc_set_port_output_delay(std::fstream& fp, const BasicPort& port,
 
   fp << generate_sdc_port(port);
 
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -399,11 +443,215 @@ int rec_print_sdc_disable_timing_for_module_ports(
       fp << child_module_path
          << module_manager.module_port(module_to_disable, port_to_disable)
               .get_name();
-      fp << std::endl;
+      fp << '\n';
+    }
+  }
+
+  return 0; /* Success */
+}
+
+/********************************************************************
+ * Find if a module includes a given module at any level of its hierarchy
+ * The results are cached, so that each unique module is searched once
+ *******************************************************************/
+static bool module_includes_module(const ModuleManager& module_manager,
+                                   const ModuleId& parent_module,
+                                   const ModuleId& module_to_find,
+                                   std::map<ModuleId, bool>& includes_module) {
+  auto result = includes_module.find(parent_module);
+  if (includes_module.end() != result) {
+    return result->second;
+  }
+  bool found = false;
+  for (const ModuleId& child_module :
+       module_manager.child_modules(parent_module)) {
+    if ((module_to_find == child_module) ||
+        (true == module_includes_module(module_manager, child_module,
+                                        module_to_find, includes_module))) {
+      found = true;
+      break;
+    }
+  }
+  includes_module[parent_module] = found;
+  return found;
+}
+
+/********************************************************************
+ * Print SDC commands to disable a given port of modules
+ * once per module definition, rather than once per instance in the fabric
+ * For each unique module which has the modules to disable as its children,
+ * the commands are scoped to the module with 'current_design', e.g.,
+ *   current_design sb_1__1_
+ *   set_disable_timing mux_2level_size4_*_/sram
+ * Only the unique children which include the modules to disable are
+ * visited, so that the size of the SDC file scales with the number of
+ * unique modules rather than the number of instances.
+ * The current design is restored to the top-level module in the end.
+ *
+ * Return code:
+ *   0: success
+ *   1: fatal error occurred
+ *******************************************************************/
+static int print_sdc_module_scoped_disable_timing_for_module_ports(
+  std::fstream& fp, const bool& flatten_names,
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleId& module_to_disable, const std::string& disable_port_name) {
+  if (false == valid_file_stream(fp)) {
+    return 1;
+  }
+
+  ModulePortId port_to_disable =
+    module_manager.find_module_port(module_to_disable, disable_port_name);
+  if (ModulePortId::INVALID() == port_to_disable) {
+    return 1; /* FATAL ERRORS */
+  }
+  const std::string& port_name =
+    module_manager.module_port(module_to_disable, port_to_disable).get_name();
+
+  std::map<ModuleId, bool> includes_module;
+  /* Visit the unique modules in a Breadth-First Search (BFS) */
+  std::vector<ModuleId> modules_to_visit(1, top_module);
+  std::set<ModuleId> visited_modules{top_module};
+  bool current_design_changed = false;
+  for (size_t imodule = 0; imodule < modules_to_visit.size(); ++imodule) {
+    ModuleId parent_module = modules_to_visit[imodule];
+    bool current_design_printed = false;
+    std::vector<std::string> wildcard_names;
+    for (const ModuleId& child_module :
+         module_manager.child_modules(parent_module)) {
+      if (module_to_disable != child_module) {
+        if ((true == module_includes_module(module_manager, child_module,
+                                            module_to_disable,
+                                            includes_module)) &&
+            (true == visited_modules.insert(child_module).second)) {
+          modules_to_visit.push_back(child_module);
+        }
+        continue;
+      }
+
+      for (const size_t& child_instance :
+           module_manager.child_module_instances(parent_module,
+                                                 child_module)) {
+        std::string child_instance_name = module_manager.instance_name(
+          parent_module, child_module, child_instance);
+        if (true == child_instance_name.empty()) {
+          child_instance_name = generate_instance_name(
+            module_manager.module_name(child_module), child_instance);
+        }
+
+        if (false == flatten_names) {
+          /* Try to adapt to a wildcard name and skip the instances which
+           * are already covered by the wildcard name */
+          WildCardString wildcard_str(child_instance_name);
+          if (wildcard_names.end() != std::find(wildcard_names.begin(),
+                                                wildcard_names.end(),
+                                                wildcard_str.data())) {
+            continue;
+          }
+          child_instance_name = wildcard_str.data();
+          wildcard_names.push_back(child_instance_name);
+        }
+
+        if (false == current_design_printed) {
+          fp << "current_design " << module_manager.module_name(parent_module);
+          fp << '\n';
+          current_design_printed = true;
+          current_design_changed = true;
+        }
+        fp << "set_disable_timing ";
+        fp << format_dir_path(child_instance_name) << port_name;
+        fp << '\n';
+      }
     }
   }
 
+  if (true == current_design_changed) {
+    fp << "current_design " << module_manager.module_name(top_module);
+    fp << '\n';
+  }
+
   return 0; /* Success */
 }
 
+/********************************************************************
+ * Print SDC commands to disable a given port of modules
+ * under a top-level module, either per instance or, when module_scoped
+ * is true, per module definition
+ *
+ * Return code:
+ *   0: success
+ *   1: fatal error occurred
+ *******************************************************************/
+int print_sdc_disable_timing_for_module_ports(
+  std::fstream& fp, const bool& flatten_names, const bool& module_scoped,
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleId& module_to_disable, const std::string& disable_port_name) {
+  if (true == module_scoped) {
+    return print_sdc_module_scoped_disable_timing_for_module_ports(
+      fp, flatten_names, module_manager, top_module, module_to_disable,
+      disable_port_name);
+  }
+  /* Instance id of the top-level module is 0 by default */
+  return rec_print_sdc_disable_timing_for_module_ports(
+    fp, flatten_names, module_manager, top_module, module_to_disable,
+    format_dir_path(module_manager.module_name(top_module)),
+    disable_port_name);
+}
+
+/********************************************************************
+ * Print a number of sections, indexed by [0, num_sections), to a SDC file
+ * in the sequence of their indices.
+ * When multiple threads are used, each thread writes a contiguous range
+ * of sections to a partial file <sdc_fname>.part<i>, and the partial files
+ * are then appended to the SDC file in order and removed. As a result,
+ * the SDC file is the same regardless of the number of threads.
+ * Sections must be independent from each other
+ *******************************************************************/
+void print_sdc_sections(
+  std::fstream& fp, const std::string& sdc_fname, const size_t& num_sections,
+  const size_t& num_threads,
+  const std::function<void(std::fstream&, const size_t&)>& print_section) {
+  valid_file_stream(fp);
+
+  size_t num_parts = std::min(num_threads, num_sections);
+  if (1 >= num_parts) {
+    for (size_t isec = 0; isec < num_sections; ++isec) {
+      print_section(fp, isec);
+    }
+    return;
+  }
+
+  size_t chunk_size = (num_sections + num_parts - 1) / num_parts;
+  std::vector<std::string> part_fnames(num_parts);
+  for (size_t ipart = 0; ipart < num_parts; ++ipart) {
+    part_fnames[ipart] =
+      sdc_fname + std::string(".part") + std::to_string(ipart);
+  }
+
+  parallel_for(num_parts, num_threads, [&](const size_t& ipart) {
+    BufferedFileStream part_fp;
+    /* Parts are read back as they are, and only the final file is
+     * compressed */
+    part_fp.set_compressible(false);
+    part_fp.open(part_fnames[ipart], std::fstream::out | std::fstream::trunc);
+    check_file_stream(part_fnames[ipart].c_str(), part_fp);
+    size_t begin = ipart * chunk_size;
+    size_t end = std::min(begin + chunk_size, num_sections);
+    for (size_t isec = begin; isec < end; ++isec) {
+      print_section(part_fp, isec);
+    }
+    part_fp.close();
+  });
+
+  for (const std::string& part_fname : part_fnames) {
+    std::ifstream part_fp(part_fname);
+    /* Appending an empty part would set the failbit of the SDC file */
+    if (part_fp.peek() != std::ifstream::traits_type::eof()) {
+      fp << part_fp.rdbuf();
+    }
+    part_fp.close();
+    std::remove(part_fname.c_str());
+  }
+}
+
 } /* end namespace openfpga */
@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <fstream>
+#include <functional>
 #include <string>
 
 #include "module_manager.h"
@@ -36,6 +37,11 @@ void print_pnr_sdc_regexp_constrain_max_delay(
   const std::string& src_port_name, const std::string& des_instance_name,
   const std::string& des_port_name, const float& delay);
 
+void print_pnr_sdc_regexp_constrain_min_delay(
+  std::fstream& fp, const std::string& src_instance_name,
+  const std::string& src_port_name, const std::string& des_instance_name,
+  const std::string& des_port_name, const float& delay);
+
 void print_pnr_sdc_constrain_min_delay(std::fstream& fp,
                                        const std::string& src_instance_name,
                                        const std::string& src_port_name,
@@ -73,6 +79,16 @@ int rec_print_sdc_disable_timing_for_module_ports(
   const ModuleId& module_to_disable, const std::string& parent_module_path,
   const std::string& disable_port_name);
 
+int print_sdc_disable_timing_for_module_ports(
+  std::fstream& fp, const bool& flatten_names, const bool& module_scoped,
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleId& module_to_disable, const std::string& disable_port_name);
+
+void print_sdc_sections(
+  std::fstream& fp, const std::string& sdc_fname, const size_t& num_sections,
+  const size_t& num_threads,
+  const std::function<void(std::fstream&, const size_t&)>& print_section);
+
 } /* end namespace openfpga */
 
 #endif
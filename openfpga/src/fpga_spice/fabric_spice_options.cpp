@@ -15,7 +15,10 @@ FabricSpiceOption::FabricSpiceOption() {
   output_directory_.clear();
   explicit_port_mapping_ = false;
   compress_routing_ = false;
+  merge_transistor_bins_ = false;
+  top_partition_size_ = 0;
   verbose_output_ = false;
+  num_threads_ = 1;
 }
 
 /**************************************************
@@ -31,8 +34,18 @@ bool FabricSpiceOption::explicit_port_mapping() const {
 
 bool FabricSpiceOption::compress_routing() const { return compress_routing_; }
 
+bool FabricSpiceOption::merge_transistor_bins() const {
+  return merge_transistor_bins_;
+}
+
+size_t FabricSpiceOption::top_partition_size() const {
+  return top_partition_size_;
+}
+
 bool FabricSpiceOption::verbose_output() const { return verbose_output_; }
 
+size_t FabricSpiceOption::num_threads() const { return num_threads_; }
+
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
@@ -48,8 +61,21 @@ void FabricSpiceOption::set_compress_routing(const bool& enabled) {
   compress_routing_ = enabled;
 }
 
+void FabricSpiceOption::set_merge_transistor_bins(const bool& enabled) {
+  merge_transistor_bins_ = enabled;
+}
+
+void FabricSpiceOption::set_top_partition_size(
+  const size_t& partition_size) {
+  top_partition_size_ = partition_size;
+}
+
 void FabricSpiceOption::set_verbose_output(const bool& enabled) {
   verbose_output_ = enabled;
 }
 
+void FabricSpiceOption::set_num_threads(const size_t& num_threads) {
+  num_threads_ = num_threads;
+}
+
 } /* end namespace openfpga */
@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <cstddef>
 #include <string>
 
 /* Begin namespace openfpga */
@@ -21,19 +22,28 @@ class FabricSpiceOption {
   std::string output_directory() const;
   bool explicit_port_mapping() const;
   bool compress_routing() const;
+  bool merge_transistor_bins() const;
+  size_t top_partition_size() const;
   bool verbose_output() const;
+  size_t num_threads() const;
 
  public: /* Public mutators */
   void set_output_directory(const std::string& output_dir);
   void set_explicit_port_mapping(const bool& enabled);
   void set_compress_routing(const bool& enabled);
+  void set_merge_transistor_bins(const bool& enabled);
+  void set_top_partition_size(const size_t& partition_size);
   void set_verbose_output(const bool& enabled);
+  void set_num_threads(const size_t& num_threads);
 
  private: /* Internal Data */
   std::string output_directory_;
   bool explicit_port_mapping_;
   bool compress_routing_;
+  bool merge_transistor_bins_;
+  size_t top_partition_size_;
   bool verbose_output_;
+  size_t num_threads_;
 };
 
 } /* End namespace openfpga*/
@@ -13,6 +13,7 @@
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "spice_auxiliary_netlists.h"
 #include "spice_constants.h"
 #include "spice_grid.h"
@@ -49,6 +50,7 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
                       const DeviceRRGSB& device_rr_gsb,
                       const FabricSpiceOption& options) {
   vtr::ScopedStartFinishTimer timer("Write SPICE netlists for FPGA fabric\n");
+  OPENFPGA_TRACE_FUNCTION();
 
   std::string src_dir_path = format_dir_path(options.output_directory());
 
@@ -81,8 +83,9 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
    */
   int status = CMD_EXEC_SUCCESS;
 
-  status = print_spice_submodule(netlist_manager, module_manager, openfpga_arch,
-                                 mux_lib, submodule_dir_path);
+  status = print_spice_submodule(
+    netlist_manager, module_manager, openfpga_arch, mux_lib,
+    submodule_dir_path, options.merge_transistor_bins(), options.num_threads());
 
   if (CMD_EXEC_SUCCESS != status) {
     return status;
@@ -91,19 +94,28 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
   /* Generate routing blocks */
   if (true == options.compress_routing()) {
     print_spice_unique_routing_modules(netlist_manager, module_manager,
-                                       device_rr_gsb, rr_dir_path);
+                                       device_rr_gsb, rr_dir_path,
+                                       options.num_threads());
   } else {
     VTR_ASSERT(false == options.compress_routing());
     print_spice_flatten_routing_modules(netlist_manager, module_manager,
-                                        device_rr_gsb, rr_dir_path);
+                                        device_rr_gsb, rr_dir_path,
+                                        options.num_threads());
   }
 
   /* Generate grids */
   print_spice_grids(netlist_manager, module_manager, device_ctx,
-                    device_annotation, lb_dir_path, options.verbose_output());
+                    device_annotation, lb_dir_path, options.num_threads(),
+                    options.verbose_output());
 
   /* Generate FPGA fabric */
-  print_spice_top_module(netlist_manager, module_manager, src_dir_path);
+  if (0 < options.top_partition_size()) {
+    print_spice_partitioned_top_module(netlist_manager, module_manager,
+                                       src_dir_path,
+                                       options.top_partition_size());
+  } else {
+    print_spice_top_module(netlist_manager, module_manager, src_dir_path);
+  }
 
   /* Generate an netlist including all the fabric-related netlists */
   print_spice_fabric_include_netlist(
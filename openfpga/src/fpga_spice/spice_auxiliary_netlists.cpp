@@ -10,6 +10,7 @@
 
 /* Headers from openfpgautil library */
 #include "circuit_library_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "spice_auxiliary_netlists.h"
@@ -36,7 +37,7 @@ void print_spice_fabric_include_netlist(const NetlistManager& netlist_manager,
     src_dir + std::string(FABRIC_INCLUDE_SPICE_NETLIST_FILE_NAME);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
@@ -58,7 +59,7 @@ void print_spice_fabric_include_netlist(const NetlistManager& netlist_manager,
        netlist_manager.netlists_by_type(NetlistManager::SUBMODULE_NETLIST)) {
     print_spice_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << '\n';
 
   /* Include all the CLB, heterogeneous block modules */
   print_spice_comment(fp, std::string("Include logic block netlists"));
@@ -66,7 +67,7 @@ void print_spice_fabric_include_netlist(const NetlistManager& netlist_manager,
        netlist_manager.netlists_by_type(NetlistManager::LOGIC_BLOCK_NETLIST)) {
     print_spice_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << '\n';
 
   /* Include all the routing architecture modules */
   print_spice_comment(fp, std::string("Include routing module netlists"));
@@ -74,7 +75,7 @@ void print_spice_fabric_include_netlist(const NetlistManager& netlist_manager,
          NetlistManager::ROUTING_MODULE_NETLIST)) {
     print_spice_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << '\n';
 
   /* Include FPGA top module */
   print_spice_comment(fp, std::string("Include fabric top-level netlists"));
@@ -82,7 +83,7 @@ void print_spice_fabric_include_netlist(const NetlistManager& netlist_manager,
        netlist_manager.netlists_by_type(NetlistManager::TOP_MODULE_NETLIST)) {
     print_spice_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << '\n';
 
   /* Close the file stream */
   fp.close();
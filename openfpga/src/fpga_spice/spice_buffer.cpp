@@ -325,7 +325,7 @@ static int print_spice_regular_inverter_pmos_modeling(
   std::fstream& fp, const std::string& trans_name_postfix,
   const std::string& input_port_name, const std::string& output_port_name,
   const TechnologyLibrary& tech_lib, const TechnologyModelId& tech_model,
-  const float& trans_width) {
+  const float& trans_width, const size_t& multiplier) {
   if (false == valid_file_stream(fp)) {
     return CMD_EXEC_FATAL_ERROR;
   }
@@ -339,6 +339,9 @@ static int print_spice_regular_inverter_pmos_modeling(
   fp << tech_lib.transistor_model_name(tech_model, TECH_LIB_TRANSISTOR_PMOS)
      << TRANSISTOR_WRAPPER_POSTFIX;
   fp << " W=" << std::setprecision(10) << trans_width;
+  if (1 < multiplier) {
+    fp << " M=" << multiplier;
+  }
   fp << "\n";
 
   return CMD_EXEC_SUCCESS;
@@ -360,7 +363,7 @@ static int print_spice_regular_inverter_nmos_modeling(
   std::fstream& fp, const std::string& trans_name_postfix,
   const std::string& input_port_name, const std::string& output_port_name,
   const TechnologyLibrary& tech_lib, const TechnologyModelId& tech_model,
-  const float& trans_width) {
+  const float& trans_width, const size_t& multiplier) {
   if (false == valid_file_stream(fp)) {
     return CMD_EXEC_FATAL_ERROR;
   }
@@ -373,11 +376,75 @@ static int print_spice_regular_inverter_nmos_modeling(
   fp << tech_lib.transistor_model_name(tech_model, TECH_LIB_TRANSISTOR_NMOS)
      << TRANSISTOR_WRAPPER_POSTFIX;
   fp << " W=" << std::setprecision(10) << trans_width;
+  if (1 < multiplier) {
+    fp << " M=" << multiplier;
+  }
   fp << "\n";
 
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * Generate the SPICE modeling for the PMOS or NMOS part of a regular
+ * inverter, whose total width is split into bins.
+ * Try to size transistors to the max width for each bin to compact
+ * layout. The last bin may not reach the max width.
+ *
+ * When the bins are merged, all the bins of the max width are modeled by
+ * a single transistor with a multiplier M, rather than one transistor per
+ * bin, which shrinks the netlists of large inverters and buffers.
+ *******************************************************************/
+static int print_spice_regular_inverter_transistor_bins(
+  std::fstream& fp, const std::string& trans_name_prefix,
+  const std::string& input_port_name, const std::string& output_port_name,
+  const TechnologyLibrary& tech_lib, const TechnologyModelId& tech_model,
+  const e_tech_lib_transistor_type& trans_type, const float& total_width,
+  const bool& merge_bins) {
+  float regular_bin_width =
+    tech_lib.transistor_model_max_width(tech_model, trans_type);
+  int num_bins = std::ceil(total_width / regular_bin_width);
+  float last_bin_width = std::fmod(total_width, regular_bin_width);
+  int num_regular_bins = num_bins;
+  if (0. != last_bin_width) {
+    num_regular_bins = num_bins - 1;
+  }
+
+  auto print_bin = [&](const int& ibin, const float& trans_width,
+                       const size_t& multiplier) {
+    std::string trans_name_postfix = trans_name_prefix + std::to_string(ibin);
+    if (TECH_LIB_TRANSISTOR_PMOS == trans_type) {
+      return print_spice_regular_inverter_pmos_modeling(
+        fp, trans_name_postfix, input_port_name, output_port_name, tech_lib,
+        tech_model, trans_width, multiplier);
+    }
+    return print_spice_regular_inverter_nmos_modeling(
+      fp, trans_name_postfix, input_port_name, output_port_name, tech_lib,
+      tech_model, trans_width, multiplier);
+  };
+
+  int status = CMD_EXEC_SUCCESS;
+  if ((true == merge_bins) && (0 < num_regular_bins)) {
+    status = print_bin(0, regular_bin_width, num_regular_bins);
+  } else {
+    for (int ibin = 0; ibin < num_regular_bins; ++ibin) {
+      status = print_bin(ibin, regular_bin_width, 1);
+      if (CMD_EXEC_FATAL_ERROR == status) {
+        return status;
+      }
+    }
+  }
+  if (CMD_EXEC_FATAL_ERROR == status) {
+    return status;
+  }
+
+  /* For last bin, we need an irregular width */
+  if (num_regular_bins < num_bins) {
+    status = print_bin(num_regular_bins, last_bin_width, 1);
+  }
+
+  return status;
+}
+
 /********************************************************************
  * Generate the SPICE subckt for a regular inverter
  *
@@ -405,7 +472,7 @@ static int print_spice_regular_inverter_subckt(
   std::fstream& fp, const ModuleManager& module_manager,
   const ModuleId& module_id, const CircuitLibrary& circuit_lib,
   const CircuitModelId& circuit_model, const TechnologyLibrary& tech_lib,
-  const TechnologyModelId& tech_model) {
+  const TechnologyModelId& tech_model, const bool& merge_bins) {
   if (false == valid_file_stream(fp)) {
     return CMD_EXEC_FATAL_ERROR;
   }
@@ -433,62 +500,27 @@ static int print_spice_regular_inverter_subckt(
 
   int status = CMD_EXEC_SUCCESS;
 
-  /* Consider use size/bin to compact layout:
-   * Try to size transistors to the max width for each bin
-   * The last bin may not reach the max width
-   */
-  float regular_pmos_bin_width =
-    tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
-  float total_pmos_width =
+  status = print_spice_regular_inverter_transistor_bins(
+    fp, std::string(), circuit_lib.port_prefix(input_ports[0]),
+    circuit_lib.port_prefix(output_ports[0]), tech_lib, tech_model,
+    TECH_LIB_TRANSISTOR_PMOS,
     circuit_lib.buffer_size(circuit_model) *
-    tech_lib.model_pn_ratio(tech_model) *
-    tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
-  int num_pmos_bins = std::ceil(total_pmos_width / regular_pmos_bin_width);
-  float last_pmos_bin_width =
-    std::fmod(total_pmos_width, regular_pmos_bin_width);
-  for (int ibin = 0; ibin < num_pmos_bins; ++ibin) {
-    float curr_bin_width = regular_pmos_bin_width;
-    /* For last bin, we need an irregular width */
-    if ((ibin == num_pmos_bins - 1) && (0. != last_pmos_bin_width)) {
-      curr_bin_width = last_pmos_bin_width;
-    }
-
-    status = print_spice_regular_inverter_pmos_modeling(
-      fp, std::to_string(ibin), circuit_lib.port_prefix(input_ports[0]),
-      circuit_lib.port_prefix(output_ports[0]), tech_lib, tech_model,
-      curr_bin_width);
-    if (CMD_EXEC_FATAL_ERROR == status) {
-      return status;
-    }
+      tech_lib.model_pn_ratio(tech_model) *
+      tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_PMOS),
+    merge_bins);
+  if (CMD_EXEC_FATAL_ERROR == status) {
+    return status;
   }
 
-  /* Consider use size/bin to compact layout:
-   * Try to size transistors to the max width for each bin
-   * The last bin may not reach the max width
-   */
-  float regular_nmos_bin_width =
-    tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
-  float total_nmos_width =
+  status = print_spice_regular_inverter_transistor_bins(
+    fp, std::string(), circuit_lib.port_prefix(input_ports[0]),
+    circuit_lib.port_prefix(output_ports[0]), tech_lib, tech_model,
+    TECH_LIB_TRANSISTOR_NMOS,
     circuit_lib.buffer_size(circuit_model) *
-    tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
-  int num_nmos_bins = std::ceil(total_nmos_width / regular_nmos_bin_width);
-  float last_nmos_bin_width =
-    std::fmod(total_nmos_width, regular_nmos_bin_width);
-
-  for (int ibin = 0; ibin < num_nmos_bins; ++ibin) {
-    float curr_bin_width = regular_nmos_bin_width;
-    /* For last bin, we need an irregular width */
-    if ((ibin == num_nmos_bins - 1) && (0. != last_nmos_bin_width)) {
-      curr_bin_width = last_nmos_bin_width;
-    }
-
-    status = print_spice_regular_inverter_nmos_modeling(
-      fp, std::to_string(ibin), circuit_lib.port_prefix(input_ports[0]),
-      circuit_lib.port_prefix(output_ports[0]), tech_lib, tech_model,
-      curr_bin_width);
-    if (CMD_EXEC_FATAL_ERROR == status) {
-      return status;
-    }
+      tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_NMOS),
+    merge_bins);
+  if (CMD_EXEC_FATAL_ERROR == status) {
+    return status;
   }
 
   print_spice_subckt_end(fp, module_manager.module_name(module_id));
@@ -506,7 +538,8 @@ int print_spice_inverter_subckt(std::fstream& fp,
                                 const CircuitLibrary& circuit_lib,
                                 const CircuitModelId& circuit_model,
                                 const TechnologyLibrary& tech_lib,
-                                const TechnologyModelId& tech_model) {
+                                const TechnologyModelId& tech_model,
+                                const bool& merge_bins) {
   int status = CMD_EXEC_SUCCESS;
   if (true == circuit_lib.is_power_gated(circuit_model)) {
     status = print_spice_powergated_inverter_subckt(
@@ -514,9 +547,9 @@ int print_spice_inverter_subckt(std::fstream& fp,
       tech_model);
   } else {
     VTR_ASSERT_SAFE(false == circuit_lib.is_power_gated(circuit_model));
-    status = print_spice_regular_inverter_subckt(fp, module_manager, module_id,
-                                                 circuit_lib, circuit_model,
-                                                 tech_lib, tech_model);
+    status = print_spice_regular_inverter_subckt(
+      fp, module_manager, module_id, circuit_lib, circuit_model, tech_lib,
+      tech_model, merge_bins);
   }
 
   return status;
@@ -739,7 +772,7 @@ static int print_spice_regular_buffer_subckt(
   std::fstream& fp, const ModuleManager& module_manager,
   const ModuleId& module_id, const CircuitLibrary& circuit_lib,
   const CircuitModelId& circuit_model, const TechnologyLibrary& tech_lib,
-  const TechnologyModelId& tech_model) {
+  const TechnologyModelId& tech_model, const bool& merge_bins) {
   if (false == valid_file_stream(fp)) {
     return CMD_EXEC_FATAL_ERROR;
   }
@@ -796,68 +829,31 @@ static int print_spice_regular_buffer_subckt(
       input_port_name += std::string("_level") + std::to_string(level - 1);
     }
 
-    /* Consider use size/bin to compact layout:
-     * Try to size transistors to the max width for each bin
-     * The last bin may not reach the max width
-     */
-    float regular_pmos_bin_width =
-      tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
-    float total_pmos_width =
-      buffer_widths[level] * tech_lib.model_pn_ratio(tech_model) *
-      tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
-    int num_pmos_bins = std::ceil(total_pmos_width / regular_pmos_bin_width);
-    float last_pmos_bin_width =
-      std::fmod(total_pmos_width, regular_pmos_bin_width);
+    std::string name_prefix =
+      std::string("level") + std::to_string(level) + std::string("_bin");
 
-    for (int ibin = 0; ibin < num_pmos_bins; ++ibin) {
-      float curr_bin_width = regular_pmos_bin_width;
-      /* For last bin, we need an irregular width */
-      if ((ibin == num_pmos_bins - 1) && (0. != last_pmos_bin_width)) {
-        curr_bin_width = last_pmos_bin_width;
-      }
-
-      std::string name_postfix = std::string("level") + std::to_string(level) +
-                                 std::string("_bin") + std::to_string(ibin);
-
-      status = print_spice_regular_inverter_pmos_modeling(
-        fp, name_postfix, circuit_lib.port_prefix(input_ports[0]),
-        circuit_lib.port_prefix(output_ports[0]), tech_lib, tech_model,
-        curr_bin_width);
-      if (CMD_EXEC_FATAL_ERROR == status) {
-        return status;
-      }
+    status = print_spice_regular_inverter_transistor_bins(
+      fp, name_prefix, circuit_lib.port_prefix(input_ports[0]),
+      circuit_lib.port_prefix(output_ports[0]), tech_lib, tech_model,
+      TECH_LIB_TRANSISTOR_PMOS,
+      buffer_widths[level] * tech_lib.model_pn_ratio(tech_model) *
+        tech_lib.transistor_model_min_width(tech_model,
+                                            TECH_LIB_TRANSISTOR_PMOS),
+      merge_bins);
+    if (CMD_EXEC_FATAL_ERROR == status) {
+      return status;
     }
 
-    /* Consider use size/bin to compact layout:
-     * Try to size transistors to the max width for each bin
-     * The last bin may not reach the max width
-     */
-    float regular_nmos_bin_width =
-      tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
-    float total_nmos_width =
+    status = print_spice_regular_inverter_transistor_bins(
+      fp, name_prefix, circuit_lib.port_prefix(input_ports[0]),
+      circuit_lib.port_prefix(output_ports[0]), tech_lib, tech_model,
+      TECH_LIB_TRANSISTOR_NMOS,
       buffer_widths[level] *
-      tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
-    int num_nmos_bins = std::ceil(total_nmos_width / regular_nmos_bin_width);
-    float last_nmos_bin_width =
-      std::fmod(total_nmos_width, regular_nmos_bin_width);
-
-    for (int ibin = 0; ibin < num_nmos_bins; ++ibin) {
-      float curr_bin_width = regular_nmos_bin_width;
-      /* For last bin, we need an irregular width */
-      if ((ibin == num_nmos_bins - 1) && (0. != last_nmos_bin_width)) {
-        curr_bin_width = last_nmos_bin_width;
-      }
-
-      std::string name_postfix = std::string("level") + std::to_string(level) +
-                                 std::string("_bin") + std::to_string(ibin);
-
-      status = print_spice_regular_inverter_nmos_modeling(
-        fp, name_postfix, circuit_lib.port_prefix(input_ports[0]),
-        circuit_lib.port_prefix(output_ports[0]), tech_lib, tech_model,
-        curr_bin_width);
-      if (CMD_EXEC_FATAL_ERROR == status) {
-        return status;
-      }
+        tech_lib.transistor_model_min_width(tech_model,
+                                            TECH_LIB_TRANSISTOR_NMOS),
+      merge_bins);
+    if (CMD_EXEC_FATAL_ERROR == status) {
+      return status;
     }
   }
 
@@ -876,7 +872,8 @@ int print_spice_buffer_subckt(std::fstream& fp,
                               const CircuitLibrary& circuit_lib,
                               const CircuitModelId& circuit_model,
                               const TechnologyLibrary& tech_lib,
-                              const TechnologyModelId& tech_model) {
+                              const TechnologyModelId& tech_model,
+                              const bool& merge_bins) {
   int status = CMD_EXEC_SUCCESS;
   if (true == circuit_lib.is_power_gated(circuit_model)) {
     status = print_spice_powergated_buffer_subckt(fp, module_manager, module_id,
@@ -884,9 +881,9 @@ int print_spice_buffer_subckt(std::fstream& fp,
                                                   tech_lib, tech_model);
   } else {
     VTR_ASSERT_SAFE(false == circuit_lib.is_power_gated(circuit_model));
-    status = print_spice_regular_buffer_subckt(fp, module_manager, module_id,
-                                               circuit_lib, circuit_model,
-                                               tech_lib, tech_model);
+    status = print_spice_regular_buffer_subckt(
+      fp, module_manager, module_id, circuit_lib, circuit_model, tech_lib,
+      tech_model, merge_bins);
   }
 
   return status;
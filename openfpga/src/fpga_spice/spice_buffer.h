@@ -24,7 +24,8 @@ int print_spice_inverter_subckt(std::fstream& fp,
                                 const CircuitLibrary& circuit_lib,
                                 const CircuitModelId& circuit_model,
                                 const TechnologyLibrary& tech_lib,
-                                const TechnologyModelId& tech_model);
+                                const TechnologyModelId& tech_model,
+                                const bool& merge_bins);
 
 int print_spice_buffer_subckt(std::fstream& fp,
                               const ModuleManager& module_manager,
@@ -32,7 +33,8 @@ int print_spice_buffer_subckt(std::fstream& fp,
                               const CircuitLibrary& circuit_lib,
                               const CircuitModelId& circuit_model,
                               const TechnologyLibrary& tech_lib,
-                              const TechnologyModelId& tech_model);
+                              const TechnologyModelId& tech_model,
+                              const bool& merge_bins);
 
 } /* end namespace openfpga */
 
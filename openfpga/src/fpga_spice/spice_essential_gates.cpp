@@ -17,6 +17,7 @@
 
 /* Headers from openfpgautil library */
 #include "circuit_library_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "spice_buffer.h"
@@ -86,7 +87,7 @@ int print_spice_supply_wrappers(NetlistManager& netlist_manager,
   std::string spice_fname =
     submodule_dir + std::string(SUPPLY_WRAPPER_SPICE_FILE_NAME);
 
-  std::fstream fp;
+  BufferedFileStream fp;
 
   /* Create the file stream */
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
@@ -128,7 +129,7 @@ int print_spice_essential_gates(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
   const CircuitLibrary& circuit_lib, const TechnologyLibrary& tech_lib,
   const std::map<CircuitModelId, TechnologyModelId>& circuit_tech_binding,
-  const std::string& submodule_dir) {
+  const std::string& submodule_dir, const bool& merge_transistor_bins) {
   int status = CMD_EXEC_SUCCESS;
 
   /* Iterate over the circuit models */
@@ -175,7 +176,7 @@ int print_spice_essential_gates(
                               circuit_lib.model_name(circuit_model) +
                               std::string(SPICE_NETLIST_FILE_POSTFIX);
 
-    std::fstream fp;
+    BufferedFileStream fp;
 
     /* Create the file stream */
     fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
@@ -195,16 +196,16 @@ int print_spice_essential_gates(
     if (CIRCUIT_MODEL_INVBUF == circuit_lib.model_type(circuit_model)) {
       if (CIRCUIT_MODEL_BUF_INV == circuit_lib.buffer_type(circuit_model)) {
         VTR_ASSERT(true == module_manager.valid_module_id(module_id));
-        status = print_spice_inverter_subckt(fp, module_manager, module_id,
-                                             circuit_lib, circuit_model,
-                                             tech_lib, tech_model);
+        status = print_spice_inverter_subckt(
+          fp, module_manager, module_id, circuit_lib, circuit_model, tech_lib,
+          tech_model, merge_transistor_bins);
         netlist_filled = true;
       } else {
         VTR_ASSERT(CIRCUIT_MODEL_BUF_BUF ==
                    circuit_lib.buffer_type(circuit_model));
-        status =
-          print_spice_buffer_subckt(fp, module_manager, module_id, circuit_lib,
-                                    circuit_model, tech_lib, tech_model);
+        status = print_spice_buffer_subckt(
+          fp, module_manager, module_id, circuit_lib, circuit_model, tech_lib,
+          tech_model, merge_transistor_bins);
         netlist_filled = true;
       }
 
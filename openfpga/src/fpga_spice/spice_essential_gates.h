@@ -27,7 +27,7 @@ int print_spice_essential_gates(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
   const CircuitLibrary& circuit_lib, const TechnologyLibrary& tech_lib,
   const std::map<CircuitModelId, TechnologyModelId>& circuit_tech_binding,
-  const std::string& submodule_dir);
+  const std::string& submodule_dir, const bool& merge_transistor_bins);
 
 } /* end namespace openfpga */
 
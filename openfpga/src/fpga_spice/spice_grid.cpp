@@ -4,6 +4,7 @@
  *******************************************************************/
 /* System header files */
 #include <fstream>
+#include <functional>
 #include <vector>
 
 /* Headers from vtrutil library */
@@ -15,6 +16,7 @@
 #include "physical_types.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_side_manager.h"
 
@@ -83,7 +85,7 @@ static void print_spice_primitive_block(
   VTR_LOGV(verbose, "\n");
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -189,7 +191,7 @@ static void rec_print_spice_logical_tile(
   VTR_LOGV(verbose, "\n");
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -297,7 +299,7 @@ static void print_spice_physical_tile_netlist(
   }
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -323,7 +325,7 @@ static void print_spice_physical_tile_netlist(
                                       module_manager.module_name(grid_module)));
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Close file handler */
   fp.close();
@@ -342,15 +344,17 @@ static void print_spice_physical_tile_netlist(
  * 1. Only one module for each I/O on each border side (IO_TYPE)
  * 2. Only one module for each CLB (FILL_TYPE)
  * 3. Only one module for each heterogeneous block
+ * Each tile is written by a separated task, so that the files are
+ * written with the number of threads given
  ****************************************************************************/
 void print_spice_grids(NetlistManager& netlist_manager,
                        const ModuleManager& module_manager,
                        const DeviceContext& device_ctx,
                        const VprDeviceAnnotation& device_annotation,
-                       const std::string& subckt_dir, const bool& verbose) {
-  /* Create a vector to contain all the Verilog netlist names that have been
-   * generated in this function */
-  std::vector<std::string> netlist_names;
+                       const std::string& subckt_dir,
+                       const size_t& num_threads, const bool& verbose) {
+  /* Create a list of tasks, each of which writes SPICE netlists */
+  std::vector<std::function<void(NetlistManager&)>> print_tasks;
 
   /* Enumerate the types of logical tiles, and build a module for each
    * Write modules for all the pb_types/pb_graph_nodes
@@ -367,10 +371,16 @@ void print_spice_grids(NetlistManager& netlist_manager,
     if (nullptr == logical_tile.pb_graph_head) {
       continue;
     }
-    print_spice_logical_tile_netlist(netlist_manager, module_manager,
-                                     device_annotation, subckt_dir,
-                                     logical_tile.pb_graph_head, verbose);
+    t_pb_graph_node* pb_graph_head = logical_tile.pb_graph_head;
+    print_tasks.push_back(
+      [&, pb_graph_head](NetlistManager& task_netlist_manager) {
+        print_spice_logical_tile_netlist(task_netlist_manager, module_manager,
+                                         device_annotation, subckt_dir,
+                                         pb_graph_head, verbose);
+      });
   }
+  print_spice_netlists(netlist_manager, print_tasks, num_threads);
+  print_tasks.clear();
   VTR_LOG("Writing logical tiles...");
   VTR_LOG("Done\n");
 
@@ -383,6 +393,7 @@ void print_spice_grids(NetlistManager& netlist_manager,
   VTR_LOGV(verbose, "\n");
   for (const t_physical_tile_type& physical_tile :
        device_ctx.physical_tile_types) {
+    t_physical_tile_type_ptr phy_block_type = &physical_tile;
     /* Bypass empty type or nullptr */
     if (true == is_empty_type(&physical_tile)) {
       continue;
@@ -399,17 +410,26 @@ void print_spice_grids(NetlistManager& netlist_manager,
       std::set<e_side> io_type_sides =
         find_physical_io_tile_located_sides(device_ctx.grid, &physical_tile);
       for (const e_side& io_type_side : io_type_sides) {
-        print_spice_physical_tile_netlist(netlist_manager, module_manager,
-                                          subckt_dir, &physical_tile,
-                                          io_type_side);
+        print_tasks.push_back(
+          [&, phy_block_type, io_type_side](
+            NetlistManager& task_netlist_manager) {
+            print_spice_physical_tile_netlist(task_netlist_manager,
+                                              module_manager, subckt_dir,
+                                              phy_block_type, io_type_side);
+          });
       }
       continue;
     } else {
       /* For CLB and heterogenenous blocks */
-      print_spice_physical_tile_netlist(netlist_manager, module_manager,
-                                        subckt_dir, &physical_tile, NUM_SIDES);
+      print_tasks.push_back(
+        [&, phy_block_type](NetlistManager& task_netlist_manager) {
+          print_spice_physical_tile_netlist(task_netlist_manager,
+                                            module_manager, subckt_dir,
+                                            phy_block_type, NUM_SIDES);
+        });
     }
   }
+  print_spice_netlists(netlist_manager, print_tasks, num_threads);
   VTR_LOG("Building physical tiles...");
   VTR_LOG("Done\n");
   VTR_LOG("\n");
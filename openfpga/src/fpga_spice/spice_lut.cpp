@@ -9,6 +9,7 @@
 #include "vtr_log.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 
 /* Headers from openfpgashell library */
@@ -37,7 +38,7 @@ int print_spice_submodule_luts(NetlistManager& netlist_manager,
 
   std::string spice_fname = submodule_dir + std::string(LUTS_SPICE_FILE_NAME);
 
-  std::fstream fp;
+  BufferedFileStream fp;
 
   /* Create the file stream */
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
@@ -4,6 +4,7 @@
  * circuit models, such as IOPADs, LUTs, etc.
  ********************************************************************/
 #include <algorithm>
+#include <set>
 #include <string>
 
 /* Headers from vtrutil library */
@@ -11,11 +12,13 @@
 #include "vtr_log.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 
 /* Headers from openfpgashell library */
 #include "circuit_library_utils.h"
 #include "command_exit_codes.h"
+#include "memory_utils.h"
 #include "module_manager.h"
 #include "mux_graph.h"
 #include "mux_utils.h"
@@ -28,6 +31,26 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/*********************************************************************
+ * Generate SPICE sub-circuits for the memory tiles which compose a memory
+ * module, if any. Each tile is written only once, before the first
+ * memory module using it
+ ********************************************************************/
+static void print_spice_memory_tile_modules(
+  const ModuleManager& module_manager, std::fstream& fp,
+  const ModuleId& mem_module, std::set<ModuleId>& written_tile_modules) {
+  for (const ModuleId& tile_module :
+       find_memory_tile_modules(module_manager, mem_module)) {
+    if (false == written_tile_modules.insert(tile_module).second) {
+      continue;
+    }
+    write_spice_subckt_to_file(fp, module_manager, tile_module);
+
+    /* Add an empty line as a splitter */
+    fp << '\n';
+  }
+}
+
 /*********************************************************************
  * Generate Verilog modules for the memories that are used
  * by multiplexers
@@ -45,7 +68,8 @@ static void print_spice_mux_memory_module(const ModuleManager& module_manager,
                                           const CircuitLibrary& circuit_lib,
                                           std::fstream& fp,
                                           const CircuitModelId& mux_model,
-                                          const MuxGraph& mux_graph) {
+                                          const MuxGraph& mux_graph,
+                                          std::set<ModuleId>& written_tiles) {
   /* Multiplexers built with different technology is in different organization
    */
   switch (circuit_lib.design_tech_type(mux_model)) {
@@ -58,11 +82,13 @@ static void print_spice_mux_memory_module(const ModuleManager& module_manager,
         std::string(SPICE_MEM_POSTFIX));
       ModuleId mem_module = module_manager.find_module(module_name);
       VTR_ASSERT(true == module_manager.valid_module_id(mem_module));
+      print_spice_memory_tile_modules(module_manager, fp, mem_module,
+                                      written_tiles);
       /* Write the module content in Verilog format */
       write_spice_subckt_to_file(fp, module_manager, mem_module);
 
       /* Add an empty line as a splitter */
-      fp << std::endl;
+      fp << '\n';
       break;
     }
     case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -107,7 +133,7 @@ int print_spice_submodule_memories(NetlistManager& netlist_manager,
                           std::string(MEMORIES_SPICE_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -118,6 +144,9 @@ int print_spice_submodule_memories(NetlistManager& netlist_manager,
 
   print_spice_file_header(fp, "Memories used in FPGA");
 
+  /* Memory tiles which have been written */
+  std::set<ModuleId> written_tile_modules;
+
   /* Create the memory circuits for the multiplexer */
   for (auto mux : mux_lib.muxes()) {
     const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
@@ -131,7 +160,7 @@ int print_spice_submodule_memories(NetlistManager& netlist_manager,
     }
     /* Create a Verilog module for the memories used by the multiplexer */
     print_spice_mux_memory_module(module_manager, circuit_lib, fp, mux_model,
-                                  mux_graph);
+                                  mux_graph, written_tile_modules);
   }
 
   /* Create the memory circuits for non-MUX circuit models.
@@ -177,11 +206,13 @@ int print_spice_submodule_memories(NetlistManager& netlist_manager,
 
     ModuleId mem_module = module_manager.find_module(module_name);
     VTR_ASSERT(true == module_manager.valid_module_id(mem_module));
+    print_spice_memory_tile_modules(module_manager, fp, mem_module,
+                                    written_tile_modules);
     /* Write the module content in Verilog format */
     write_spice_subckt_to_file(fp, module_manager, mem_module);
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << '\n';
   }
 
   /* Close the file stream */
@@ -20,6 +20,7 @@
 #include "circuit_types.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 
 /* Headers from openfpgashell library */
@@ -75,7 +76,7 @@ static void generate_spice_mux_branch_subckt(
       VTR_ASSERT(true == module_manager.valid_module_id(mux_module));
       write_spice_subckt_to_file(fp, module_manager, mux_module);
       /* Add an empty line as a splitter */
-      fp << std::endl;
+      fp << '\n';
       break;
     }
     case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -120,7 +121,7 @@ static void generate_spice_mux_subckt(const ModuleManager& module_manager,
       VTR_ASSERT(true == module_manager.valid_module_id(mux_module));
       write_spice_subckt_to_file(fp, module_manager, mux_module);
       /* Add an empty line as a splitter */
-      fp << std::endl;
+      fp << '\n';
       break;
     }
     case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -152,7 +153,7 @@ static int print_spice_submodule_mux_primitives(
                           std::string(MUX_PRIMITIVES_SPICE_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -173,13 +174,12 @@ static int print_spice_submodule_mux_primitives(
   /* Generate basis sub-circuit for unique branches shared by the multiplexers
    */
   for (auto mux : mux_lib.muxes()) {
-    const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
     CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux);
-    /* Create a mux graph for the branch circuit */
-    std::vector<MuxGraph> branch_mux_graphs =
-      mux_graph.build_mux_branch_graphs();
+    /* Get the mux graphs of the branch circuits */
+    const std::vector<MuxGraph>& branch_mux_graphs =
+      mux_lib.mux_branch_graphs(mux);
     /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes */
-    for (auto branch_mux_graph : branch_mux_graphs) {
+    for (const MuxGraph& branch_mux_graph : branch_mux_graphs) {
       generate_spice_mux_branch_subckt(module_manager, circuit_lib, fp,
                                        mux_circuit_model, branch_mux_graph,
                                        branch_mux_module_is_outputted);
@@ -212,7 +212,7 @@ static int print_spice_submodule_mux_top_subckt(
   std::string spice_fname(submodule_dir + std::string(MUXES_SPICE_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -2,12 +2,16 @@
  * This file includes functions that are used for
  * SPICE generation of FPGA routing architecture (global routing)
  *********************************************************************/
+#include <functional>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 
 /* Include FPGA-Verilog header files*/
@@ -88,7 +92,7 @@ static void print_spice_routing_connection_box_unique_module(
       cb_type, gsb_coordinate, std::string(SPICE_NETLIST_FILE_POSTFIX)));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -108,7 +112,7 @@ static void print_spice_routing_connection_box_unique_module(
   write_spice_subckt_to_file(fp, module_manager, cb_module);
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Close file handler */
   fp.close();
@@ -191,7 +195,7 @@ static void print_spice_routing_switch_box_unique_module(
                             std::string(SPICE_NETLIST_FILE_POSTFIX)));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -222,12 +226,12 @@ static void print_spice_routing_switch_box_unique_module(
 
 /********************************************************************
  * Iterate over all the connection blocks in a device
- * and build a module for each of them
+ * and create a task to write a module for each of them
  *******************************************************************/
-static void print_spice_flatten_connection_block_modules(
-  NetlistManager& netlist_manager, const ModuleManager& module_manager,
-  const DeviceRRGSB& device_rr_gsb, const std::string& subckt_dir,
-  const t_rr_type& cb_type) {
+static void add_spice_flatten_connection_block_module_tasks(
+  std::vector<std::function<void(NetlistManager&)>>& print_tasks,
+  const ModuleManager& module_manager, const DeviceRRGSB& device_rr_gsb,
+  const std::string& subckt_dir, const t_rr_type& cb_type) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
@@ -241,8 +245,13 @@ static void print_spice_flatten_connection_block_modules(
       if (true != rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
-      print_spice_routing_connection_box_unique_module(
-        netlist_manager, module_manager, subckt_dir, rr_gsb, cb_type);
+      const RRGSB* task_rr_gsb = &rr_gsb;
+      print_tasks.push_back(
+        [&, task_rr_gsb, cb_type](NetlistManager& task_netlist_manager) {
+          print_spice_routing_connection_box_unique_module(
+            task_netlist_manager, module_manager, subckt_dir, *task_rr_gsb,
+            cb_type);
+        });
     }
   }
 }
@@ -255,14 +264,16 @@ static void print_spice_flatten_connection_block_modules(
  * Covering:
  * 1. Connection blocks
  * 2. Switch blocks
+ * Each module is written to a separated file, so that the files are
+ * written with the number of threads given
  *******************************************************************/
 void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
                                          const ModuleManager& module_manager,
                                          const DeviceRRGSB& device_rr_gsb,
-                                         const std::string& subckt_dir) {
-  /* Create a vector to contain all the Verilog netlist names that have been
-   * generated in this function */
-  std::vector<std::string> netlist_names;
+                                         const std::string& subckt_dir,
+                                         const size_t& num_threads) {
+  /* Create a list of tasks, each of which writes a SPICE netlist */
+  std::vector<std::function<void(NetlistManager&)>> print_tasks;
 
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
@@ -273,16 +284,22 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
       if (true != rr_gsb.is_sb_exist()) {
         continue;
       }
-      print_spice_routing_switch_box_unique_module(
-        netlist_manager, module_manager, subckt_dir, rr_gsb);
+      const RRGSB* task_rr_gsb = &rr_gsb;
+      print_tasks.push_back(
+        [&, task_rr_gsb](NetlistManager& task_netlist_manager) {
+          print_spice_routing_switch_box_unique_module(
+            task_netlist_manager, module_manager, subckt_dir, *task_rr_gsb);
+        });
     }
   }
 
-  print_spice_flatten_connection_block_modules(
-    netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANX);
+  add_spice_flatten_connection_block_module_tasks(
+    print_tasks, module_manager, device_rr_gsb, subckt_dir, CHANX);
 
-  print_spice_flatten_connection_block_modules(
-    netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANY);
+  add_spice_flatten_connection_block_module_tasks(
+    print_tasks, module_manager, device_rr_gsb, subckt_dir, CHANY);
+
+  print_spice_netlists(netlist_manager, print_tasks, num_threads);
 
   /*
   VTR_LOG("Writing header file for routing submodules '%s'...",
@@ -304,39 +321,44 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
  *
  * Note: this function SHOULD be called only when
  * the option compact_routing_hierarchy is turned on!!!
+ * Each module is written to a separated file, so that the files are
+ * written with the number of threads given
  *******************************************************************/
 void print_spice_unique_routing_modules(NetlistManager& netlist_manager,
                                         const ModuleManager& module_manager,
                                         const DeviceRRGSB& device_rr_gsb,
-                                        const std::string& subckt_dir) {
-  /* Create a vector to contain all the Verilog netlist names that have been
-   * generated in this function */
-  std::vector<std::string> netlist_names;
+                                        const std::string& subckt_dir,
+                                        const size_t& num_threads) {
+  /* Create a list of tasks, each of which writes a SPICE netlist */
+  std::vector<std::function<void(NetlistManager&)>> print_tasks;
 
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    print_spice_routing_switch_box_unique_module(
-      netlist_manager, module_manager, subckt_dir, unique_mirror);
+    const RRGSB* unique_mirror = &device_rr_gsb.get_sb_unique_module(isb);
+    print_tasks.push_back(
+      [&, unique_mirror](NetlistManager& task_netlist_manager) {
+        print_spice_routing_switch_box_unique_module(
+          task_netlist_manager, module_manager, subckt_dir, *unique_mirror);
+      });
   }
 
-  /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX);
-       ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    print_spice_routing_connection_box_unique_module(
-      netlist_manager, module_manager, subckt_dir, unique_mirror, CHANX);
+  /* Build unique X-direction and Y-direction connection block modules */
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(cb_type);
+         ++icb) {
+      const RRGSB* unique_mirror =
+        &device_rr_gsb.get_cb_unique_module(cb_type, icb);
+
+      print_tasks.push_back(
+        [&, unique_mirror, cb_type](NetlistManager& task_netlist_manager) {
+          print_spice_routing_connection_box_unique_module(
+            task_netlist_manager, module_manager, subckt_dir, *unique_mirror,
+            cb_type);
+        });
+    }
   }
 
-  /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY);
-       ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    print_spice_routing_connection_box_unique_module(
-      netlist_manager, module_manager, subckt_dir, unique_mirror, CHANY);
-  }
+  print_spice_netlists(netlist_manager, print_tasks, num_threads);
 
   /*
   VTR_LOG("Writing header file for routing submodules '%s'...",
@@ -13,6 +13,7 @@
 #include "vtr_assert.h"
 
 /* Headers from openfpgautil library */
+#include "module_emission_plan.h"
 #include "module_manager_utils.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
@@ -47,89 +48,6 @@ static std::string generate_spice_undriven_local_wire_name(
   return wire_name;
 }
 
-/********************************************************************
- * Name a net for a local wire for a SPICE subckt
- * 1. If this is a local wire, name it after the
- *<src_module_name>_<instance_id>_<src_port_name>
- * 2. If this is not a local wire, name it after the port name of parent module
- *
- * In addition, it will assign the pin index as well
- *
- * Restriction: this function requires each net has single driver
- * which is definitely always true in circuits.
- *******************************************************************/
-static BasicPort generate_spice_port_for_module_net(
-  const ModuleManager& module_manager, const ModuleId& module_id,
-  const ModuleNetId& module_net) {
-  /* Check all the sink modules of the net,
-   * if we have a source module is the current module, this is not local wire
-   */
-  for (ModuleNetSrcId src_id :
-       module_manager.module_net_sources(module_id, module_net)) {
-    if (module_id ==
-        module_manager.net_source_modules(module_id, module_net)[src_id]) {
-      /* Here, this is not a local wire, return the port name of the src_port */
-      ModulePortId net_src_port =
-        module_manager.net_source_ports(module_id, module_net)[src_id];
-      size_t src_pin_index =
-        module_manager.net_source_pins(module_id, module_net)[src_id];
-      return BasicPort(
-        module_manager.module_port(module_id, net_src_port).get_name(),
-        src_pin_index, src_pin_index);
-    }
-  }
-
-  /* Check all the sink modules of the net */
-  for (ModuleNetSinkId sink_id :
-       module_manager.module_net_sinks(module_id, module_net)) {
-    if (module_id ==
-        module_manager.net_sink_modules(module_id, module_net)[sink_id]) {
-      /* Here, this is not a local wire, return the port name of the sink_port
-       */
-      ModulePortId net_sink_port =
-        module_manager.net_sink_ports(module_id, module_net)[sink_id];
-      size_t sink_pin_index =
-        module_manager.net_sink_pins(module_id, module_net)[sink_id];
-      return BasicPort(
-        module_manager.module_port(module_id, net_sink_port).get_name(),
-        sink_pin_index, sink_pin_index);
-    }
-  }
-
-  /* Reach here, this is a local wire */
-  std::string net_name;
-
-  /* Each net must only one 1 source */
-  VTR_ASSERT(1 ==
-             module_manager.net_source_modules(module_id, module_net).size());
-
-  /* Get the source module */
-  ModuleId net_src_module =
-    module_manager.net_source_modules(module_id, module_net)[ModuleNetSrcId(0)];
-  /* Get the instance id */
-  size_t net_src_instance = module_manager.net_source_instances(
-    module_id, module_net)[ModuleNetSrcId(0)];
-  /* Get the port id */
-  ModulePortId net_src_port =
-    module_manager.net_source_ports(module_id, module_net)[ModuleNetSrcId(0)];
-  /* Get the pin id */
-  size_t net_src_pin =
-    module_manager.net_source_pins(module_id, module_net)[ModuleNetSrcId(0)];
-
-  /* Load user-defined name if we have it */
-  if (false == module_manager.net_name(module_id, module_net).empty()) {
-    net_name = module_manager.net_name(module_id, module_net);
-  } else {
-    net_name = module_manager.module_name(net_src_module);
-    net_name +=
-      std::string("_") + std::to_string(net_src_instance) + std::string("_");
-    net_name +=
-      module_manager.module_port(net_src_module, net_src_port).get_name();
-  }
-
-  return BasicPort(net_name, net_src_pin, net_src_pin);
-}
-
 /********************************************************************
  * Print a SPICE wire connection
  * We search all the sinks of the net,
@@ -139,30 +57,21 @@ static BasicPort generate_spice_port_for_module_net(
  *******************************************************************/
 static void print_spice_subckt_output_short_connection(
   std::fstream& fp, const ModuleManager& module_manager,
-  const ModuleId& module_id, const ModuleNetId& module_net) {
+  const ModuleEmissionPlan& emission_plan, const ModuleNetId& module_net) {
   /* Ensure a valid file stream */
   VTR_ASSERT(true == valid_file_stream(fp));
 
+  ModuleId module_id = emission_plan.module();
   bool first_port = true;
   BasicPort src_port;
 
   /* We have found a module input, now check all the sink modules of the net */
-  for (ModuleNetSinkId net_sink :
-       module_manager.module_net_sinks(module_id, module_net)) {
-    ModuleId sink_module =
-      module_manager.net_sink_modules(module_id, module_net)[net_sink];
-    if (module_id != sink_module) {
-      continue;
-    }
-
+  for (const ModuleNetTerminalPin& net_sink :
+       emission_plan.net_module_sinks(module_net)) {
     /* Find the sink port and pin information */
-    ModulePortId sink_port_id =
-      module_manager.net_sink_ports(module_id, module_net)[net_sink];
-    size_t sink_pin =
-      module_manager.net_sink_pins(module_id, module_net)[net_sink];
     BasicPort sink_port(
-      module_manager.module_port(module_id, sink_port_id).get_name(), sink_pin,
-      sink_pin);
+      module_manager.module_port(module_id, net_sink.port).get_name(),
+      net_sink.pin, net_sink.pin);
 
     /* For the first module output, this is the source port, we do nothing and
      * go to the next */
@@ -195,48 +104,31 @@ static void print_spice_subckt_output_short_connection(
  *******************************************************************/
 static void print_spice_subckt_local_short_connection(
   std::fstream& fp, const ModuleManager& module_manager,
-  const ModuleId& module_id, const ModuleNetId& module_net) {
+  const ModuleEmissionPlan& emission_plan, const ModuleNetId& module_net) {
   /* Ensure a valid file stream */
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  for (ModuleNetSrcId net_src :
-       module_manager.module_net_sources(module_id, module_net)) {
-    ModuleId src_module =
-      module_manager.net_source_modules(module_id, module_net)[net_src];
-    if (module_id != src_module) {
-      continue;
-    }
+  ModuleId module_id = emission_plan.module();
+  for (const ModuleNetTerminalPin& net_src :
+       emission_plan.net_module_sources(module_net)) {
     /* Find the source port and pin information */
     print_spice_comment(
-      fp, std::string("Net source id " + std::to_string(size_t(net_src))));
-    ModulePortId src_port_id =
-      module_manager.net_source_ports(module_id, module_net)[net_src];
-    size_t src_pin =
-      module_manager.net_source_pins(module_id, module_net)[net_src];
+      fp, std::string("Net source id " + std::to_string(net_src.terminal_id)));
     BasicPort src_port(
-      module_manager.module_port(module_id, src_port_id).get_name(), src_pin,
-      src_pin);
+      module_manager.module_port(module_id, net_src.port).get_name(),
+      net_src.pin, net_src.pin);
 
     /* We have found a module input, now check all the sink modules of the net
      */
-    for (ModuleNetSinkId net_sink :
-         module_manager.module_net_sinks(module_id, module_net)) {
-      ModuleId sink_module =
-        module_manager.net_sink_modules(module_id, module_net)[net_sink];
-      if (module_id != sink_module) {
-        continue;
-      }
-
+    for (const ModuleNetTerminalPin& net_sink :
+         emission_plan.net_module_sinks(module_net)) {
       /* Find the sink port and pin information */
       print_spice_comment(
-        fp, std::string("Net sink id " + std::to_string(size_t(net_sink))));
-      ModulePortId sink_port_id =
-        module_manager.net_sink_ports(module_id, module_net)[net_sink];
-      size_t sink_pin =
-        module_manager.net_sink_pins(module_id, module_net)[net_sink];
+        fp,
+        std::string("Net sink id " + std::to_string(net_sink.terminal_id)));
       BasicPort sink_port(
-        module_manager.module_port(module_id, sink_port_id).get_name(),
-        sink_pin, sink_pin);
+        module_manager.module_port(module_id, net_sink.port).get_name(),
+        net_sink.pin, net_sink.pin);
 
       /* We need to print a wire connection here */
       VTR_ASSERT(src_port.get_width() == sink_port.get_width());
@@ -270,18 +162,14 @@ static void print_spice_subckt_local_short_connection(
  *******************************************************************/
 static void print_spice_subckt_local_short_connections(
   std::fstream& fp, const ModuleManager& module_manager,
-  const ModuleId& module_id) {
-  /* Local wires come from the child modules */
-  for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
-    /* We only care the nets that indicate short connections */
-    if (false == module_net_include_local_short_connection(
-                   module_manager, module_id, module_net)) {
-      continue;
-    }
+  const ModuleEmissionPlan& emission_plan) {
+  /* We only care the nets that indicate short connections */
+  for (const ModuleNetId& module_net :
+       emission_plan.local_short_connection_nets()) {
     print_spice_comment(fp, std::string("Local connection due to Wire " +
                                         std::to_string(size_t(module_net))));
-    print_spice_subckt_local_short_connection(fp, module_manager, module_id,
-                                              module_net);
+    print_spice_subckt_local_short_connection(fp, module_manager,
+                                              emission_plan, module_net);
   }
 }
 
@@ -303,16 +191,12 @@ static void print_spice_subckt_local_short_connections(
  *******************************************************************/
 static void print_spice_subckt_output_short_connections(
   std::fstream& fp, const ModuleManager& module_manager,
-  const ModuleId& module_id) {
-  /* Local wires come from the child modules */
-  for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
-    /* We only care the nets that indicate short connections */
-    if (false == module_net_include_output_short_connection(
-                   module_manager, module_id, module_net)) {
-      continue;
-    }
-    print_spice_subckt_output_short_connection(fp, module_manager, module_id,
-                                               module_net);
+  const ModuleEmissionPlan& emission_plan) {
+  /* We only care the nets that indicate short connections */
+  for (const ModuleNetId& module_net :
+       emission_plan.output_short_connection_nets()) {
+    print_spice_subckt_output_short_connection(fp, module_manager,
+                                               emission_plan, module_net);
   }
 }
 
@@ -333,14 +217,15 @@ static void print_spice_subckt_output_short_connections(
  *    +-----------------------------+
  *
  *******************************************************************/
-static void write_spice_instance_to_file(std::fstream& fp,
-                                         const ModuleManager& module_manager,
-                                         const ModuleId& parent_module,
-                                         const ModuleId& child_module,
-                                         const size_t& instance_id) {
+void write_spice_instance_to_file(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleEmissionPlan& emission_plan, const ModuleId& child_module,
+  const size_t& instance_id) {
   /* Ensure a valid file stream */
   VTR_ASSERT(true == valid_file_stream(fp));
 
+  ModuleId parent_module = emission_plan.module();
+
   /* Print instance name:
    * if we have an instance name, use it;
    * if not, we use a default name <name>_<num_instance_in_parent_module>
@@ -371,11 +256,12 @@ static void write_spice_instance_to_file(std::fstream& fp,
         module_manager.module_port(child_module, child_port_id);
 
       /* Create the port name and width to be used by the instance */
-      std::vector<BasicPort> instance_ports;
+      const std::vector<ModuleNetId>& port_nets =
+        emission_plan.instance_port_nets(child_module, instance_id,
+                                         child_port_id);
       for (size_t child_pin : child_port.pins()) {
         /* Find the net linked to the pin */
-        ModuleNetId net = module_manager.module_instance_port_net(
-          parent_module, child_module, instance_id, child_port_id, child_pin);
+        ModuleNetId net = port_nets[child_pin];
         BasicPort instance_port;
         if (ModuleNetId::INVALID() == net) {
           /* We give the same port name as child module, this case happens to
@@ -386,8 +272,7 @@ static void write_spice_instance_to_file(std::fstream& fp,
           instance_port.set_width(child_pin, child_pin);
         } else {
           /* Find the name for this child port */
-          instance_port = generate_spice_port_for_module_net(
-            module_manager, parent_module, net);
+          instance_port = emission_plan.net_port(net);
         }
 
         if (true == new_line) {
@@ -419,7 +304,7 @@ static void write_spice_instance_to_file(std::fstream& fp,
         new_line = false;
         if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
           pin_cnt = 0;
-          fp << std::endl;
+          fp << '\n';
           new_line = true;
           fit_one_line = false;
         }
@@ -445,7 +330,7 @@ static void write_spice_instance_to_file(std::fstream& fp,
   new_line = false;
   if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
     pin_cnt = 0;
-    fp << std::endl;
+    fp << '\n';
     new_line = true;
     fit_one_line = false;
   }
@@ -455,14 +340,34 @@ static void write_spice_instance_to_file(std::fstream& fp,
    * a clean format
    */
   if (false == fit_one_line) {
-    fp << std::endl;
+    fp << '\n';
     fp << "+";
   }
   write_space_to_file(fp, 1);
   fp << module_manager.module_name(child_module);
 
   /* Print an end to the instance */
-  fp << std::endl;
+  fp << '\n';
+}
+
+/********************************************************************
+ * Write the short connections of a SPICE sub-circuit to a file, which are
+ * not covered by its instances
+ *******************************************************************/
+void write_spice_subckt_short_connections_to_file(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleEmissionPlan& emission_plan) {
+  /* Print local connection (from module inputs to output! */
+  print_spice_comment(fp, std::string("BEGIN Local short connections"));
+  print_spice_subckt_local_short_connections(fp, module_manager,
+                                             emission_plan);
+  print_spice_comment(fp, std::string("END Local short connections"));
+
+  print_spice_comment(fp, std::string("BEGIN Local output short connections"));
+  print_spice_subckt_output_short_connections(fp, module_manager,
+                                              emission_plan);
+
+  print_spice_comment(fp, std::string("END Local output short connections"));
 }
 
 /********************************************************************
@@ -482,32 +387,28 @@ void write_spice_subckt_to_file(std::fstream& fp,
   print_spice_subckt_definition(fp, module_manager, module_id);
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 
-  /* Print local connection (from module inputs to output! */
-  print_spice_comment(fp, std::string("BEGIN Local short connections"));
-  print_spice_subckt_local_short_connections(fp, module_manager, module_id);
-  print_spice_comment(fp, std::string("END Local short connections"));
+  /* Visit the nets and instances of the module only once */
+  ModuleEmissionPlan emission_plan(module_manager, module_id);
 
-  print_spice_comment(fp, std::string("BEGIN Local output short connections"));
-  print_spice_subckt_output_short_connections(fp, module_manager, module_id);
-
-  print_spice_comment(fp, std::string("END Local output short connections"));
+  write_spice_subckt_short_connections_to_file(fp, module_manager,
+                                               emission_plan);
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Print instances */
   for (ModuleId child_module : module_manager.child_modules(module_id)) {
     for (size_t instance :
          module_manager.child_module_instances(module_id, child_module)) {
       /* Print an instance */
-      write_spice_instance_to_file(fp, module_manager, module_id, child_module,
-                                   instance);
+      write_spice_instance_to_file(fp, module_manager, emission_plan,
+                                   child_module, instance);
       /* Print an empty line as splitter */
-      fp << std::endl;
+      fp << '\n';
     }
   }
 
@@ -515,7 +416,7 @@ void write_spice_subckt_to_file(std::fstream& fp,
   print_spice_subckt_end(fp, module_manager.module_name(module_id));
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 } /* end namespace openfpga */
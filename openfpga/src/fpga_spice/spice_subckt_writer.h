@@ -6,6 +6,7 @@
  *******************************************************************/
 #include <fstream>
 
+#include "module_emission_plan.h"
 #include "module_manager.h"
 
 /********************************************************************
@@ -15,6 +16,15 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+void write_spice_instance_to_file(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleEmissionPlan& emission_plan, const ModuleId& child_module,
+  const size_t& instance_id);
+
+void write_spice_subckt_short_connections_to_file(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleEmissionPlan& emission_plan);
+
 void write_spice_subckt_to_file(std::fstream& fp,
                                 const ModuleManager& module_manager,
                                 const ModuleId& module_id);
@@ -3,6 +3,9 @@
  * and print them to files
  ********************************************************************/
 
+#include <functional>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -16,6 +19,7 @@
 #include "spice_mux.h"
 #include "spice_submodule.h"
 #include "spice_transistor_wrapper.h"
+#include "spice_writer_utils.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
@@ -29,30 +33,31 @@ namespace openfpga {
  * 4. TODO: Local encoders for routing multiplexers
  * 5. Wires
  * 6. Configuration memory blocks
+ *
+ * The writers only read the module manager, so that they run concurrently
+ * with the number of threads given. Each writer reports its status in
+ * a dedicated slot, and the first fatal error, in the sequence of writers,
+ * is returned
  ********************************************************************/
 int print_spice_submodule(NetlistManager& netlist_manager,
                           const ModuleManager& module_manager,
                           const Arch& openfpga_arch, const MuxLibrary& mux_lib,
-                          const std::string& submodule_dir) {
-  int status = CMD_EXEC_SUCCESS;
+                          const std::string& submodule_dir,
+                          const bool& merge_transistor_bins,
+                          const size_t& num_threads) {
+  std::vector<std::function<int(NetlistManager&)>> writers;
 
   /* Transistor wrapper */
-  status = print_spice_transistor_wrapper(
-    netlist_manager, openfpga_arch.tech_lib, submodule_dir);
-
-  /* Error out if fatal errors have been reported */
-  if (CMD_EXEC_SUCCESS != status) {
-    return CMD_EXEC_FATAL_ERROR;
-  }
+  writers.push_back([&](NetlistManager& task_netlist_manager) {
+    return print_spice_transistor_wrapper(
+      task_netlist_manager, openfpga_arch.tech_lib, submodule_dir);
+  });
 
   /* Constant modules: VDD and GND */
-  status =
-    print_spice_supply_wrappers(netlist_manager, module_manager, submodule_dir);
-
-  /* Error out if fatal errors have been reported */
-  if (CMD_EXEC_SUCCESS != status) {
-    return CMD_EXEC_FATAL_ERROR;
-  }
+  writers.push_back([&](NetlistManager& task_netlist_manager) {
+    return print_spice_supply_wrappers(task_netlist_manager, module_manager,
+                                       submodule_dir);
+  });
 
   /* Logic gates:
    *   - AND/OR,
@@ -60,49 +65,56 @@ int print_spice_submodule(NetlistManager& netlist_manager,
    *   - transmission-gate/pass-transistor
    *   - wires
    */
-  status = print_spice_essential_gates(
-    netlist_manager, module_manager, openfpga_arch.circuit_lib,
-    openfpga_arch.tech_lib, openfpga_arch.circuit_tech_binding, submodule_dir);
-
-  /* Error out if fatal errors have been reported */
-  if (CMD_EXEC_SUCCESS != status) {
-    return CMD_EXEC_FATAL_ERROR;
-  }
+  writers.push_back([&](NetlistManager& task_netlist_manager) {
+    return print_spice_essential_gates(
+      task_netlist_manager, module_manager, openfpga_arch.circuit_lib,
+      openfpga_arch.tech_lib, openfpga_arch.circuit_tech_binding,
+      submodule_dir, merge_transistor_bins);
+  });
 
   /* TODO: local decoders for routing multiplexers */
 
   /* Routing multiplexers */
-  status =
-    print_spice_submodule_muxes(netlist_manager, module_manager, mux_lib,
-                                openfpga_arch.circuit_lib, submodule_dir);
-
-  /* Error out if fatal errors have been reported */
-  if (CMD_EXEC_SUCCESS != status) {
-    return CMD_EXEC_FATAL_ERROR;
-  }
+  writers.push_back([&](NetlistManager& task_netlist_manager) {
+    return print_spice_submodule_muxes(task_netlist_manager, module_manager,
+                                       mux_lib, openfpga_arch.circuit_lib,
+                                       submodule_dir);
+  });
 
   /* Look-Up Tables */
-  status = print_spice_submodule_luts(netlist_manager, module_manager,
-                                      openfpga_arch.circuit_lib, submodule_dir);
-
-  /* Error out if fatal errors have been reported */
-  if (CMD_EXEC_SUCCESS != status) {
-    return CMD_EXEC_FATAL_ERROR;
-  }
+  writers.push_back([&](NetlistManager& task_netlist_manager) {
+    return print_spice_submodule_luts(task_netlist_manager, module_manager,
+                                      openfpga_arch.circuit_lib,
+                                      submodule_dir);
+  });
 
   /* Memories */
-  status =
-    print_spice_submodule_memories(netlist_manager, module_manager, mux_lib,
-                                   openfpga_arch.circuit_lib, submodule_dir);
+  writers.push_back([&](NetlistManager& task_netlist_manager) {
+    return print_spice_submodule_memories(task_netlist_manager,
+                                          module_manager, mux_lib,
+                                          openfpga_arch.circuit_lib,
+                                          submodule_dir);
+  });
 
-  /* Error out if fatal errors have been reported */
-  if (CMD_EXEC_SUCCESS != status) {
-    return CMD_EXEC_FATAL_ERROR;
+  /* TODO: architecture decoders */
+
+  std::vector<int> writer_status(writers.size(), CMD_EXEC_SUCCESS);
+  std::vector<std::function<void(NetlistManager&)>> print_tasks;
+  for (size_t iwriter = 0; iwriter < writers.size(); ++iwriter) {
+    print_tasks.push_back([&, iwriter](NetlistManager& task_netlist_manager) {
+      writer_status[iwriter] = writers[iwriter](task_netlist_manager);
+    });
   }
+  print_spice_netlists(netlist_manager, print_tasks, num_threads);
 
-  /* TODO: architecture decoders */
+  /* Error out if fatal errors have been reported */
+  for (const int& status : writer_status) {
+    if (CMD_EXEC_SUCCESS != status) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
 
-  return status;
+  return CMD_EXEC_SUCCESS;
 }
 
 } /* end namespace openfpga */
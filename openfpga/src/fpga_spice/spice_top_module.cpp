@@ -5,12 +5,17 @@
 #include <algorithm>
 #include <fstream>
 #include <map>
+#include <string>
+#include <utility>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
 /* Headers from openfpgautil library */
+#include "module_emission_plan.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "spice_constants.h"
@@ -50,7 +55,7 @@ void print_spice_top_module(NetlistManager& netlist_manager,
           spice_fname.c_str());
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -61,7 +66,7 @@ void print_spice_top_module(NetlistManager& netlist_manager,
   write_spice_subckt_to_file(fp, module_manager, top_module);
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Close file handler */
   fp.close();
@@ -75,4 +80,299 @@ void print_spice_top_module(NetlistManager& netlist_manager,
   VTR_LOG("Done\n");
 }
 
+/********************************************************************
+ * Generate the name of the sub-circuit of a region of the top-level module
+ *******************************************************************/
+static std::string generate_spice_top_region_name(
+  const std::string& top_module_name, const std::pair<int, int>& region) {
+  return top_module_name + std::string("_region_") +
+         std::to_string(region.first) + std::string("__") +
+         std::to_string(region.second) + std::string("_");
+}
+
+/********************************************************************
+ * Print the pins of a SPICE subckt definition or instance, followed by
+ * the supply ports, with a limited number of pins per line
+ * Return true if all the pins fit one line
+ *******************************************************************/
+static bool print_spice_region_pins(std::fstream& fp,
+                                    const std::string& head_line,
+                                    const std::vector<std::string>& pins) {
+  fp << head_line;
+
+  std::string port_whitespace(head_line.length() - 2, ' ');
+  bool fit_one_line = true;
+  size_t pin_cnt = 0;
+  auto print_pin = [&](const std::string& pin) {
+    if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
+      fp << '\n';
+      fp << "+ " << port_whitespace;
+      pin_cnt = 0;
+      fit_one_line = false;
+    }
+    if (0 != pin_cnt) {
+      write_space_to_file(fp, 1);
+    }
+    fp << pin;
+    pin_cnt++;
+  };
+
+  for (const std::string& pin : pins) {
+    print_pin(pin);
+  }
+  /* TODO: the supply ports should be derived from module manager */
+  print_pin(std::string(SPICE_SUBCKT_VDD_PORT_NAME));
+  print_pin(std::string(SPICE_SUBCKT_GND_PORT_NAME));
+
+  return fit_one_line;
+}
+
+/********************************************************************
+ * Print the top-level module for the FPGA fabric in SPICE format, where
+ * the child instances are partitioned into regions of tiles, so that
+ * parallel circuit simulators can partition the netlist along them.
+ *
+ * - Each region of partition_size x partition_size tiles is written as
+ *   a sub-circuit in its own netlist. The instances are assigned to the
+ *   regions by their coordinates as configurable children of the
+ *   top-level module, which are the tile coordinates doubled, so that
+ *   routing blocks sit between grids.
+ * - The nets whose pins all lie in the same region are internal to the
+ *   sub-circuit. The other nets are the interface of the regions: they
+ *   become ports of the sub-circuits of all the regions they reach.
+ * - A stitching top-level module, with the same ports as the original
+ *   one, instantiates the regions as well as the instances without any
+ *   coordinate, and ties the interface nets together.
+ *
+ * The number of interface nets, i.e., the cut size, is reported.
+ *******************************************************************/
+void print_spice_partitioned_top_module(NetlistManager& netlist_manager,
+                                        const ModuleManager& module_manager,
+                                        const std::string& spice_dir,
+                                        const size_t& partition_size) {
+  VTR_ASSERT(0 < partition_size);
+
+  std::string top_module_name = generate_fpga_top_module_name();
+  ModuleId top_module = module_manager.find_module(top_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  /* Find the region of each instance which has a coordinate */
+  std::map<std::pair<ModuleId, size_t>, std::pair<int, int>>
+    instance_region_coords;
+  std::map<std::pair<int, int>, size_t> region_ids;
+  std::vector<ModuleId> config_children =
+    module_manager.configurable_children(top_module);
+  std::vector<size_t> config_child_instances =
+    module_manager.configurable_child_instances(top_module);
+  std::vector<vtr::Point<int>> config_child_coords =
+    module_manager.configurable_child_coordinates(top_module);
+  for (size_t ichild = 0; ichild < config_children.size(); ++ichild) {
+    const vtr::Point<int>& coord = config_child_coords[ichild];
+    if ((0 > coord.x()) || (0 > coord.y())) {
+      continue;
+    }
+    int tile_region_size = 2 * partition_size;
+    std::pair<int, int> region(coord.x() / tile_region_size,
+                               coord.y() / tile_region_size);
+    instance_region_coords[std::make_pair(config_children[ichild],
+                                          config_child_instances[ichild])] =
+      region;
+    region_ids[region] = 0;
+  }
+  /* Regions are sorted by their coordinates */
+  std::vector<std::pair<int, int>> region_coords;
+  for (auto& region : region_ids) {
+    region.second = region_coords.size();
+    region_coords.push_back(region.first);
+  }
+  /* The last partition is the stitching top-level module */
+  size_t num_regions = region_coords.size();
+  size_t stitch_id = num_regions;
+  auto find_partition = [&](const ModuleId& module, const size_t& instance) {
+    auto result =
+      instance_region_coords.find(std::make_pair(module, instance));
+    if (instance_region_coords.end() == result) {
+      return stitch_id;
+    }
+    return region_ids.at(result->second);
+  };
+
+  std::vector<std::vector<std::pair<ModuleId, size_t>>> partition_instances(
+    num_regions + 1);
+  for (const ModuleId& child : module_manager.child_modules(top_module)) {
+    for (const size_t& instance :
+         module_manager.child_module_instances(top_module, child)) {
+      partition_instances[find_partition(child, instance)].push_back(
+        std::make_pair(child, instance));
+    }
+  }
+
+  /* Find the interface nets of each region */
+  ModuleEmissionPlan emission_plan(module_manager, top_module);
+  std::vector<std::vector<std::string>> region_pins(num_regions);
+  size_t num_cut_nets = 0;
+  for (const ModuleNetId& net : module_manager.module_nets(top_module)) {
+    std::vector<size_t> net_partitions;
+    for (const ModuleManager::NetTerminal& src :
+         module_manager.net_source_terminals(top_module, net)) {
+      if (top_module == src.module) {
+        net_partitions.push_back(stitch_id);
+      } else {
+        net_partitions.push_back(find_partition(src.module, src.instance));
+      }
+    }
+    for (const ModuleManager::NetTerminal& sink :
+         module_manager.net_sink_terminals(top_module, net)) {
+      if (top_module == sink.module) {
+        net_partitions.push_back(stitch_id);
+      } else {
+        net_partitions.push_back(find_partition(sink.module, sink.instance));
+      }
+    }
+    std::sort(net_partitions.begin(), net_partitions.end());
+    net_partitions.erase(
+      std::unique(net_partitions.begin(), net_partitions.end()),
+      net_partitions.end());
+
+    /* Nets inside a region, or only in the stitching module, are not cut */
+    if (1 >= net_partitions.size()) {
+      continue;
+    }
+    num_cut_nets++;
+    /* Use the same net name as the instances */
+    const BasicPort& net_port = emission_plan.net_port(net);
+    std::string net_name = generate_spice_port(net_port, true);
+    for (const size_t& partition : net_partitions) {
+      if (stitch_id != partition) {
+        region_pins[partition].push_back(net_name);
+      }
+    }
+  }
+
+  size_t num_interface_pins = 0;
+  for (const std::vector<std::string>& pins : region_pins) {
+    num_interface_pins += pins.size();
+  }
+
+  /* Write each region to a netlist */
+  for (size_t iregion = 0; iregion < num_regions; ++iregion) {
+    std::string region_name =
+      generate_spice_top_region_name(top_module_name, region_coords[iregion]);
+    std::string spice_fname(spice_dir + region_name +
+                            std::string(SPICE_NETLIST_FILE_POSTFIX));
+
+    VTR_LOG("Writing SPICE netlist for region '%s' of top-level module '%s'...",
+            region_name.c_str(), spice_fname.c_str());
+
+    BufferedFileStream fp;
+    fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
+
+    check_file_stream(spice_fname.c_str(), fp);
+
+    print_spice_file_header(
+      fp, std::string("Region of top-level SPICE subckt for FPGA"));
+
+    print_spice_comment(fp, std::string("SPICE module for " + region_name));
+    print_spice_region_pins(fp, ".subckt " + region_name + " ",
+                            region_pins[iregion]);
+    fp << '\n';
+
+    /* Print an empty line as splitter */
+    fp << '\n';
+
+    for (const auto& instance : partition_instances[iregion]) {
+      write_spice_instance_to_file(fp, module_manager, emission_plan,
+                                   instance.first, instance.second);
+      /* Print an empty line as splitter */
+      fp << '\n';
+    }
+
+    print_spice_subckt_end(fp, region_name);
+
+    fp.close();
+
+    NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id,
+                                     NetlistManager::TOP_MODULE_NETLIST);
+
+    VTR_LOG("Done\n");
+  }
+
+  /* Write the stitching top-level module */
+  std::string spice_fname(
+    spice_dir +
+    generate_fpga_top_netlist_name(std::string(SPICE_NETLIST_FILE_POSTFIX)));
+
+  VTR_LOG("Writing SPICE netlist for top-level module of FPGA fabric '%s'...",
+          spice_fname.c_str());
+
+  BufferedFileStream fp;
+  fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(spice_fname.c_str(), fp);
+
+  print_spice_file_header(
+    fp, std::string("Partitioned top-level SPICE subckt for FPGA"));
+  print_spice_comment(fp, std::to_string(num_regions) + " regions, " +
+                            std::to_string(num_cut_nets) + " cut nets, " +
+                            std::to_string(num_interface_pins) +
+                            " interface pins");
+
+  print_spice_subckt_definition(fp, module_manager, top_module);
+
+  /* Print an empty line as splitter */
+  fp << '\n';
+
+  write_spice_subckt_short_connections_to_file(fp, module_manager,
+                                               emission_plan);
+  /* Print an empty line as splitter */
+  fp << '\n';
+
+  for (const auto& instance : partition_instances[stitch_id]) {
+    write_spice_instance_to_file(fp, module_manager, emission_plan,
+                                 instance.first, instance.second);
+    /* Print an empty line as splitter */
+    fp << '\n';
+  }
+
+  for (size_t iregion = 0; iregion < num_regions; ++iregion) {
+    std::string region_name =
+      generate_spice_top_region_name(top_module_name, region_coords[iregion]);
+    bool fit_one_line = print_spice_region_pins(
+      fp, "X " + region_name + " ", region_pins[iregion]);
+    /* For a clean format, the module name is in a new line if the pins
+     * cannot fit one line */
+    if (false == fit_one_line) {
+      fp << '\n';
+      fp << "+";
+    }
+    write_space_to_file(fp, 1);
+    fp << region_name;
+    fp << '\n';
+    /* Print an empty line as splitter */
+    fp << '\n';
+  }
+
+  print_spice_subckt_end(fp, top_module_name);
+
+  /* Add an empty line as a splitter */
+  fp << '\n';
+
+  fp.close();
+
+  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
+  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+  netlist_manager.set_netlist_type(nlist_id,
+                                   NetlistManager::TOP_MODULE_NETLIST);
+
+  VTR_LOG("Done\n");
+
+  VTR_LOG(
+    "Partitioned top-level module into %lu regions of %lux%lu tiles: %lu "
+    "cut nets, %lu interface pins\n",
+    num_regions, partition_size, partition_size, num_cut_nets,
+    num_interface_pins);
+}
+
 } /* end namespace openfpga */
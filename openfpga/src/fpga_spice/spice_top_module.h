@@ -20,6 +20,11 @@ void print_spice_top_module(NetlistManager& netlist_manager,
                             const ModuleManager& module_manager,
                             const std::string& spice_dir);
 
+void print_spice_partitioned_top_module(NetlistManager& netlist_manager,
+                                        const ModuleManager& module_manager,
+                                        const std::string& spice_dir,
+                                        const size_t& partition_size);
+
 } /* end namespace openfpga */
 
 #endif
@@ -15,6 +15,7 @@
 
 /* Headers from openfpgautil library */
 #include "circuit_library_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "spice_constants.h"
 #include "spice_transistor_wrapper.h"
@@ -76,7 +77,7 @@ int print_spice_transistor_wrapper(NetlistManager& netlist_manager,
   std::string spice_fname =
     submodule_dir + std::string(TRANSISTORS_SPICE_FILE_NAME);
 
-  std::fstream fp;
+  BufferedFileStream fp;
 
   /* Create the file stream */
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
@@ -7,6 +7,7 @@
 #include <fstream>
 #include <iomanip>
 #include <string>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -17,6 +18,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 #include "spice_constants.h"
 #include "spice_writer_utils.h"
 
@@ -33,14 +35,14 @@ void print_spice_file_header(std::fstream& fp, const std::string& usage) {
   auto end = std::chrono::system_clock::now();
   std::time_t end_time = std::chrono::system_clock::to_time_t(end);
 
-  fp << "*********************************************" << std::endl;
-  fp << "*\tFPGA-SPICE Netlist" << std::endl;
-  fp << "*\tDescription: " << usage << std::endl;
-  fp << "*\tAuthor: Xifan TANG" << std::endl;
-  fp << "*\tOrganization: University of Utah" << std::endl;
+  fp << "*********************************************" << '\n';
+  fp << "*\tFPGA-SPICE Netlist" << '\n';
+  fp << "*\tDescription: " << usage << '\n';
+  fp << "*\tAuthor: Xifan TANG" << '\n';
+  fp << "*\tOrganization: University of Utah" << '\n';
   fp << "*\tDate: " << std::ctime(&end_time);
-  fp << "*********************************************" << std::endl;
-  fp << std::endl;
+  fp << "*********************************************" << '\n';
+  fp << '\n';
 }
 
 /********************************************************************
@@ -50,7 +52,7 @@ void print_spice_include_netlist(std::fstream& fp,
                                  const std::string& netlist_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << ".include \"" << netlist_name << "\"" << std::endl;
+  fp << ".include \"" << netlist_name << "\"" << '\n';
 }
 
 /************************************************
@@ -60,9 +62,9 @@ void print_spice_comment(std::fstream& fp, const std::string& comment) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
   std::string comment_cover(comment.length() + 4, '*');
-  fp << comment_cover << std::endl;
-  fp << "* " << comment << " *" << std::endl;
-  fp << comment_cover << std::endl;
+  fp << comment_cover << '\n';
+  fp << "* " << comment << " *" << '\n';
+  fp << comment_cover << '\n';
 }
 
 /************************************************
@@ -147,7 +149,7 @@ void print_spice_subckt_definition(std::fstream& fp,
         new_line = false;
         if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
           pin_cnt = 0;
-          fp << std::endl;
+          fp << '\n';
           new_line = true;
         }
       }
@@ -169,7 +171,7 @@ void print_spice_subckt_definition(std::fstream& fp,
     fp << SPICE_SUBCKT_GND_PORT_NAME;
   }
 
-  fp << std::endl;
+  fp << '\n';
 }
 
 /************************************************
@@ -178,10 +180,10 @@ void print_spice_subckt_definition(std::fstream& fp,
 void print_spice_subckt_end(std::fstream& fp, const std::string& module_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << ".ends" << std::endl;
+  fp << ".ends" << '\n';
   print_spice_comment(
     fp, std::string("***** END SPICE module for " + module_name + " *****"));
-  fp << std::endl;
+  fp << '\n';
 }
 
 /************************************************
@@ -197,7 +199,7 @@ void print_spice_resistor(std::fstream& fp, const std::string& input_port,
   fp << " " << input_port;
   fp << " " << output_port;
   fp << " " << std::setprecision(10) << resistance;
-  fp << std::endl;
+  fp << '\n';
 }
 
 /************************************************
@@ -213,7 +215,7 @@ void print_spice_capacitor(std::fstream& fp, const std::string& input_port,
   fp << " " << input_port;
   fp << " " << output_port;
   fp << " " << std::setprecision(10) << capacitance;
-  fp << std::endl;
+  fp << '\n';
 }
 
 /************************************************
@@ -317,7 +319,7 @@ void print_spice_subckt_instance(
         new_line = false;
         if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
           pin_cnt = 0;
-          fp << std::endl;
+          fp << '\n';
           new_line = true;
           fit_one_line = false;
         }
@@ -343,7 +345,7 @@ void print_spice_subckt_instance(
   new_line = false;
   if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
     pin_cnt = 0;
-    fp << std::endl;
+    fp << '\n';
     new_line = true;
     fit_one_line = false;
   }
@@ -353,14 +355,43 @@ void print_spice_subckt_instance(
    * a clean format
    */
   if (false == fit_one_line) {
-    fp << std::endl;
+    fp << '\n';
     fp << "+";
   }
   write_space_to_file(fp, 1);
   fp << module_manager.module_name(module_id);
 
   /* Print an end to the instance */
-  fp << std::endl;
+  fp << '\n';
+}
+
+/********************************************************************
+ * Print a number of SPICE netlists, each of which is written by a task
+ * that registers its netlists in the netlist manager given.
+ * Tasks only read the module manager, so that they can run concurrently,
+ * each with its own netlist manager. The netlists are then registered
+ * in the sequence of tasks, which is the same as running them in sequence.
+ *******************************************************************/
+void print_spice_netlists(
+  NetlistManager& netlist_manager,
+  const std::vector<std::function<void(NetlistManager&)>>& print_tasks,
+  const size_t& num_threads) {
+  if ((1 >= num_threads) || (1 >= print_tasks.size())) {
+    for (const auto& print_task : print_tasks) {
+      print_task(netlist_manager);
+    }
+    return;
+  }
+
+  std::vector<NetlistManager> task_netlist_managers(print_tasks.size());
+  parallel_for_dynamic(print_tasks.size(), num_threads,
+                       [&](const size_t& itask) {
+                         print_tasks[itask](task_netlist_managers[itask]);
+                       });
+
+  for (const NetlistManager& task_netlist_manager : task_netlist_managers) {
+    netlist_manager.add_netlists(task_netlist_manager);
+  }
 }
 
 } /* end namespace openfpga */
@@ -10,11 +10,13 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <fstream>
+#include <functional>
 #include <string>
 #include <vector>
 
 #include "circuit_library.h"
 #include "module_manager.h"
+#include "netlist_manager.h"
 #include "openfpga_port.h"
 
 /********************************************************************
@@ -66,6 +68,11 @@ void print_spice_subckt_instance(
   const ModuleId& module_id, const std::string& instance_name,
   const std::map<std::string, BasicPort>& port2port_name_map);
 
+void print_spice_netlists(
+  NetlistManager& netlist_manager,
+  const std::vector<std::function<void(NetlistManager&)>>& print_tasks,
+  const size_t& num_threads);
+
 } /* end namespace openfpga */
 
 #endif
@@ -17,10 +17,20 @@ FabricVerilogOption::FabricVerilogOption() {
   include_timing_ = false;
   explicit_port_mapping_ = false;
   compress_routing_ = false;
+  gsb_nets_deferred_ = false;
+  duplicate_grid_pin_ = false;
+  dedup_routing_modules_ = false;
+  parameterized_decoders_ = false;
   print_user_defined_template_ = false;
   default_net_type_ = VERILOG_DEFAULT_NET_TYPE_NONE;
   time_stamp_ = true;
   use_relative_path_ = false;
+  num_threads_ = 1;
+  num_top_module_slices_ = 1;
+  only_top_module_slice_ = false;
+  top_module_slice_ = 0;
+  skip_top_module_slices_ = false;
+  incremental_ = false;
   verbose_output_ = false;
 }
 
@@ -45,6 +55,22 @@ bool FabricVerilogOption::explicit_port_mapping() const {
 
 bool FabricVerilogOption::compress_routing() const { return compress_routing_; }
 
+bool FabricVerilogOption::gsb_nets_deferred() const {
+  return gsb_nets_deferred_;
+}
+
+bool FabricVerilogOption::duplicate_grid_pin() const {
+  return duplicate_grid_pin_;
+}
+
+bool FabricVerilogOption::dedup_routing_modules() const {
+  return dedup_routing_modules_;
+}
+
+bool FabricVerilogOption::parameterized_decoders() const {
+  return parameterized_decoders_;
+}
+
 bool FabricVerilogOption::print_user_defined_template() const {
   return print_user_defined_template_;
 }
@@ -53,6 +79,26 @@ e_verilog_default_net_type FabricVerilogOption::default_net_type() const {
   return default_net_type_;
 }
 
+size_t FabricVerilogOption::num_threads() const { return num_threads_; }
+
+size_t FabricVerilogOption::num_top_module_slices() const {
+  return num_top_module_slices_;
+}
+
+bool FabricVerilogOption::only_top_module_slice() const {
+  return only_top_module_slice_;
+}
+
+size_t FabricVerilogOption::top_module_slice() const {
+  return top_module_slice_;
+}
+
+bool FabricVerilogOption::skip_top_module_slices() const {
+  return skip_top_module_slices_;
+}
+
+bool FabricVerilogOption::incremental() const { return incremental_; }
+
 bool FabricVerilogOption::verbose_output() const { return verbose_output_; }
 
 /******************************************************************************
@@ -82,6 +128,22 @@ void FabricVerilogOption::set_compress_routing(const bool& enabled) {
   compress_routing_ = enabled;
 }
 
+void FabricVerilogOption::set_gsb_nets_deferred(const bool& enabled) {
+  gsb_nets_deferred_ = enabled;
+}
+
+void FabricVerilogOption::set_duplicate_grid_pin(const bool& enabled) {
+  duplicate_grid_pin_ = enabled;
+}
+
+void FabricVerilogOption::set_dedup_routing_modules(const bool& enabled) {
+  dedup_routing_modules_ = enabled;
+}
+
+void FabricVerilogOption::set_parameterized_decoders(const bool& enabled) {
+  parameterized_decoders_ = enabled;
+}
+
 void FabricVerilogOption::set_print_user_defined_template(const bool& enabled) {
   print_user_defined_template_ = enabled;
 }
@@ -106,6 +168,27 @@ void FabricVerilogOption::set_default_net_type(
   }
 }
 
+void FabricVerilogOption::set_num_threads(const size_t& num_threads) {
+  num_threads_ = num_threads;
+}
+
+void FabricVerilogOption::set_num_top_module_slices(const size_t& num_slices) {
+  num_top_module_slices_ = num_slices;
+}
+
+void FabricVerilogOption::set_top_module_slice(const size_t& slice) {
+  only_top_module_slice_ = true;
+  top_module_slice_ = slice;
+}
+
+void FabricVerilogOption::set_skip_top_module_slices(const bool& enabled) {
+  skip_top_module_slices_ = enabled;
+}
+
+void FabricVerilogOption::set_incremental(const bool& enabled) {
+  incremental_ = enabled;
+}
+
 void FabricVerilogOption::set_verbose_output(const bool& enabled) {
   verbose_output_ = enabled;
 }
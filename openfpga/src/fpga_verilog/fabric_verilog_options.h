@@ -26,8 +26,18 @@ class FabricVerilogOption {
   bool include_timing() const;
   bool explicit_port_mapping() const;
   bool compress_routing() const;
+  bool gsb_nets_deferred() const;
+  bool duplicate_grid_pin() const;
+  bool dedup_routing_modules() const;
+  bool parameterized_decoders() const;
   e_verilog_default_net_type default_net_type() const;
   bool print_user_defined_template() const;
+  size_t num_threads() const;
+  size_t num_top_module_slices() const;
+  bool only_top_module_slice() const;
+  size_t top_module_slice() const;
+  bool skip_top_module_slices() const;
+  bool incremental() const;
   bool verbose_output() const;
 
  public: /* Public mutators */
@@ -37,8 +47,17 @@ class FabricVerilogOption {
   void set_include_timing(const bool& enabled);
   void set_explicit_port_mapping(const bool& enabled);
   void set_compress_routing(const bool& enabled);
+  void set_gsb_nets_deferred(const bool& enabled);
+  void set_duplicate_grid_pin(const bool& enabled);
+  void set_dedup_routing_modules(const bool& enabled);
+  void set_parameterized_decoders(const bool& enabled);
   void set_print_user_defined_template(const bool& enabled);
   void set_default_net_type(const std::string& default_net_type);
+  void set_num_threads(const size_t& num_threads);
+  void set_num_top_module_slices(const size_t& num_slices);
+  void set_top_module_slice(const size_t& slice);
+  void set_skip_top_module_slices(const bool& enabled);
+  void set_incremental(const bool& enabled);
   void set_verbose_output(const bool& enabled);
 
  private: /* Internal Data */
@@ -46,10 +65,30 @@ class FabricVerilogOption {
   bool include_timing_;
   bool explicit_port_mapping_;
   bool compress_routing_;
+  /* The nets between grids and routing blocks are not in the module graph,
+   * and are generated when writing the top module */
+  bool gsb_nets_deferred_;
+  bool duplicate_grid_pin_;
+  /* Write mirrored routing modules as wrappers of their unique mirrors */
+  bool dedup_routing_modules_;
+  /* Write the decoders as instances of parameterized decoders */
+  bool parameterized_decoders_;
   bool print_user_defined_template_;
   e_verilog_default_net_type default_net_type_;
   bool time_stamp_;
   bool use_relative_path_;
+  size_t num_threads_;
+  /* Number of files that the instances of the top module are split into */
+  size_t num_top_module_slices_;
+  /* Only write a slice of the top module, so that the slices can be
+   * written by a number of processes, e.g., on different machines */
+  bool only_top_module_slice_;
+  size_t top_module_slice_;
+  /* Write all the netlists except the slices of the top module, which are
+   * written by other processes */
+  bool skip_top_module_slices_;
+  /* Keep the netlist files whose contents are unchanged */
+  bool incremental_;
   bool verbose_output_;
 };
 
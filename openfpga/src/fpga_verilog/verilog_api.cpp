@@ -1,6 +1,8 @@
 /********************************************************************
  * This file include top-level function of FPGA-Verilog
  ********************************************************************/
+#include <algorithm>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "circuit_library_utils.h"
@@ -11,8 +13,10 @@
 
 /* Headers from openfpgautil library */
 #include "device_rr_gsb.h"
+#include "fabric_bitstream_utils.h"
 #include "openfpga_digest.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "verilog_auxiliary_netlists.h"
 #include "verilog_constants.h"
 #include "verilog_formal_random_top_testbench.h"
@@ -59,6 +63,7 @@ void fpga_fabric_verilog(
   const VprDeviceAnnotation &device_annotation,
   const DeviceRRGSB &device_rr_gsb, const FabricVerilogOption &options) {
   vtr::ScopedStartFinishTimer timer("Write Verilog netlists for FPGA fabric\n");
+  OPENFPGA_TRACE_FUNCTION();
 
   std::string src_dir_path = format_dir_path(options.output_directory());
 
@@ -82,7 +87,8 @@ void fpga_fabric_verilog(
   create_directory(rr_dir_path);
 
   /* Print Verilog files containing preprocessing flags */
-  print_verilog_preprocessing_flags_netlist(std::string(src_dir_path), options);
+  bool defines_changed = print_verilog_preprocessing_flags_netlist(
+    std::string(src_dir_path), options);
 
   /* Generate primitive Verilog modules, which are corner stones of FPGA fabric
    * Note that this function MUST be called before Verilog generation of
@@ -116,12 +122,22 @@ void fpga_fabric_verilog(
   /* Generate FPGA fabric */
   print_verilog_top_module(netlist_manager,
                            const_cast<const ModuleManager &>(module_manager),
+                           device_ctx, device_annotation, device_rr_gsb,
                            src_dir_path, options);
 
   /* Generate an netlist including all the fabric-related netlists */
-  print_verilog_fabric_include_netlist(
+  bool include_netlist_changed = print_verilog_fabric_include_netlist(
     const_cast<const NetlistManager &>(netlist_manager), src_dir_path,
-    circuit_lib, options.use_relative_path(), options.time_stamp());
+    circuit_lib, options.use_relative_path(), options.time_stamp(),
+    options.incremental());
+
+  /* List the netlists which are changed, for incremental compilation of
+   * downstream tools */
+  if (true == options.incremental()) {
+    print_verilog_fabric_manifest(
+      const_cast<const NetlistManager &>(netlist_manager), src_dir_path,
+      options.use_relative_path(), defines_changed, include_netlist_changed);
+  }
 
   /* Given a brief stats on how many Verilog modules have been written to files
    */
@@ -129,6 +145,32 @@ void fpga_fabric_verilog(
            module_manager.num_modules());
 }
 
+/********************************************************************
+ * A top-level function of FPGA-Verilog which only writes a slice of the
+ * instances of the top-level module, when the slices are distributed
+ * among a number of processes, e.g., on different machines.
+ * The other netlists, including the top-level netlist, are written by
+ * fpga_fabric_verilog() with the slices skipped
+ * Return:
+ *  - CMD_EXEC_SUCCESS if succeed
+ *  - CMD_EXEC_FATAL_ERROR if the slice is out of range
+ ********************************************************************/
+int fpga_fabric_verilog_top_module_slice(const ModuleManager &module_manager,
+                                         const FabricVerilogOption &options) {
+  vtr::ScopedStartFinishTimer timer(
+    "Write Verilog netlist for a slice of FPGA fabric\n");
+  OPENFPGA_TRACE_FUNCTION();
+
+  std::string src_dir_path = format_dir_path(options.output_directory());
+  create_directory(src_dir_path);
+
+  if (0 != print_verilog_top_module_slice(module_manager, src_dir_path,
+                                          options)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
 /********************************************************************
  * A top-level function of FPGA-Verilog which focuses on full testbench
  *generation This function will generate
@@ -151,6 +193,7 @@ int fpga_verilog_full_testbench(
   const VerilogTestbenchOption &options) {
   vtr::ScopedStartFinishTimer timer(
     "Write Verilog full testbenches for FPGA fabric\n");
+  OPENFPGA_TRACE_FUNCTION();
 
   std::string src_dir_path = format_dir_path(options.output_directory());
 
@@ -166,11 +209,20 @@ int fpga_verilog_full_testbench(
   std::string top_testbench_file_path =
     src_dir_path + netlist_name +
     std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_FILE_POSTFIX);
+  /* The memory image of the backdoor loader, only written when required */
+  std::string backdoor_bitstream_file_path =
+    src_dir_path + netlist_name +
+    std::string(AUTOCHECK_TOP_TESTBENCH_BACKDOOR_BITSTREAM_FILE_POSTFIX);
+  /* The netlist shared by the testbenches of all the designs, only written
+   * when required */
+  std::string fabric_testbench_file_path =
+    src_dir_path + std::string(FABRIC_TESTBENCH_VERILOG_FILE_NAME);
   print_verilog_full_testbench(
     module_manager, bitstream_manager, fabric_bitstream, blwl_sr_banks,
     circuit_lib, config_protocol, fabric_global_port_info, atom_ctx, place_ctx,
     pin_constraints, bus_group, bitstream_file, io_location_map,
     netlist_annotation, netlist_name, top_testbench_file_path,
+    backdoor_bitstream_file_path, fabric_testbench_file_path,
     simulation_setting, options);
 
   /* Generate a Verilog file including all the netlists that have been generated
@@ -198,6 +250,7 @@ int fpga_verilog_preconfigured_fabric_wrapper(
   const VerilogTestbenchOption &options) {
   vtr::ScopedStartFinishTimer timer(
     "Write a wrapper module for a preconfigured FPGA fabric\n");
+  OPENFPGA_TRACE_FUNCTION();
 
   std::string src_dir_path = format_dir_path(options.output_directory());
 
@@ -213,11 +266,16 @@ int fpga_verilog_preconfigured_fabric_wrapper(
   std::string formal_verification_top_netlist_file_path =
     src_dir_path + netlist_name +
     std::string(FORMAL_VERIFICATION_VERILOG_FILE_POSTFIX);
+  /* The memory image of the bitstream, only written when required */
+  std::string formal_verification_bitstream_file_path =
+    src_dir_path + netlist_name +
+    std::string(FORMAL_VERIFICATION_BITSTREAM_FILE_POSTFIX);
   status = print_verilog_preconfig_top_module(
     module_manager, bitstream_manager, config_protocol, circuit_lib,
     fabric_global_port_info, atom_ctx, place_ctx, pin_constraints, bus_group,
     io_location_map, netlist_annotation, netlist_name,
-    formal_verification_top_netlist_file_path, options);
+    formal_verification_top_netlist_file_path,
+    formal_verification_bitstream_file_path, options);
 
   return status;
 }
@@ -238,6 +296,7 @@ int fpga_verilog_preconfigured_testbench(
   const VerilogTestbenchOption &options) {
   vtr::ScopedStartFinishTimer timer(
     "Write Verilog testbenches for a preconfigured FPGA fabric\n");
+  OPENFPGA_TRACE_FUNCTION();
 
   std::string src_dir_path = format_dir_path(options.output_directory());
 
@@ -272,13 +331,15 @@ int fpga_verilog_preconfigured_testbench(
  ********************************************************************/
 int fpga_verilog_simulation_task_info(
   const ModuleManager &module_manager,
-  const BitstreamManager &bitstream_manager, const AtomContext &atom_ctx,
+  const BitstreamManager &bitstream_manager,
+  const FabricBitstream &fabric_bitstream, const AtomContext &atom_ctx,
   const PlacementContext &place_ctx, const IoLocationMap &io_location_map,
   const SimulationSetting &simulation_setting,
   const ConfigProtocol &config_protocol,
   const VerilogTestbenchOption &options) {
   vtr::ScopedStartFinishTimer timer(
     "Write interchangeable simulation task configuration\n");
+  OPENFPGA_TRACE_FUNCTION();
 
   std::string src_dir_path = format_dir_path(options.output_directory());
 
@@ -289,13 +350,45 @@ int fpga_verilog_simulation_task_info(
   /* Create directories */
   create_directory(src_dir_path);
 
+  /* By default, each configuration bit takes a programming clock cycle.
+   * QL memory banks program their regions concurrently through the BL/WL
+   * ports of each region, so that the programming ends with the longest
+   * region, while the other regions stay idle once they are done */
+  size_t num_program_clock_cycles = bitstream_manager.num_bits();
+  std::vector<size_t> num_region_program_clock_cycles;
+  if ((CONFIG_MEM_QL_MEMORY_BANK == config_protocol.type()) &&
+      (0 < fabric_bitstream.num_bits())) {
+    if (BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) {
+      /* The regions share the same addresses */
+      num_program_clock_cycles =
+        1 + build_memory_bank_fabric_bitstream_by_address(fabric_bitstream)
+              .size();
+    } else {
+      num_region_program_clock_cycles =
+        find_memory_bank_regional_flatten_fabric_bitstream_sizes(
+          fabric_bitstream);
+      num_program_clock_cycles = 0;
+      for (size_t& region_cycles : num_region_program_clock_cycles) {
+        /* The first cycle resets the fabric */
+        region_cycles += 1;
+        num_program_clock_cycles =
+          std::max(num_program_clock_cycles, region_cycles);
+      }
+    }
+    VTR_LOGV(options.verbose_output(),
+             "Regions are programmed concurrently in %lu programming clock "
+             "cycles rather than %lu cycles in sequence\n",
+             num_program_clock_cycles, bitstream_manager.num_bits());
+  }
+
   /* Generate exchangeable files which contains simulation settings */
   std::string simulation_ini_file_name = options.simulation_ini_path();
   VTR_ASSERT(true != options.simulation_ini_path().empty());
   print_verilog_simulation_info(
     simulation_ini_file_name, options, netlist_name, src_dir_path, atom_ctx,
     place_ctx, io_location_map, module_manager, config_protocol.type(),
-    bitstream_manager.num_bits(), simulation_setting.num_clock_cycles(),
+    num_program_clock_cycles, num_region_program_clock_cycles,
+    simulation_setting.num_clock_cycles(),
     simulation_setting.programming_clock_frequency(),
     simulation_setting.default_operating_clock_frequency());
 
@@ -44,6 +44,9 @@ void fpga_fabric_verilog(
   const VprDeviceAnnotation& device_annotation,
   const DeviceRRGSB& device_rr_gsb, const FabricVerilogOption& options);
 
+int fpga_fabric_verilog_top_module_slice(const ModuleManager& module_manager,
+                                         const FabricVerilogOption& options);
+
 int fpga_verilog_full_testbench(
   const ModuleManager& module_manager,
   const BitstreamManager& bitstream_manager,
@@ -78,7 +81,8 @@ int fpga_verilog_preconfigured_testbench(
 
 int fpga_verilog_simulation_task_info(
   const ModuleManager& module_manager,
-  const BitstreamManager& bitstream_manager, const AtomContext& atom_ctx,
+  const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream, const AtomContext& atom_ctx,
   const PlacementContext& place_ctx, const IoLocationMap& io_location_map,
   const SimulationSetting& simulation_setting,
   const ConfigProtocol& config_protocol, const VerilogTestbenchOption& options);
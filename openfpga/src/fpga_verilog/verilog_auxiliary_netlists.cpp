@@ -7,9 +7,11 @@
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
+#include "vtr_log.h"
 
 /* Headers from openfpgautil library */
 #include "circuit_library_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "verilog_auxiliary_netlists.h"
@@ -28,12 +30,14 @@ namespace openfpga {
  * that have been generated  and user-defined.
  * This does NOT include any testbenches!
  * Some netlists are open to compile under specific preprocessing flags
+ * Return true if the file is changed
  *******************************************************************/
-void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
+bool print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
                                           const std::string& src_dir_path,
                                           const CircuitLibrary& circuit_lib,
                                           const bool& use_relative_path,
-                                          const bool& include_time_stamp) {
+                                          const bool& include_time_stamp,
+                                          const bool& incremental) {
   /* If we force the use of relative path, the src dir path should NOT be
    * included in any output */
   std::string src_dir = src_dir_path;
@@ -44,8 +48,8 @@ void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
     src_dir_path + std::string(FABRIC_INCLUDE_VERILOG_NETLIST_FILE_NAME);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc, incremental);
 
   /* Validate the file stream */
   check_file_stream(verilog_fpath.c_str(), fp);
@@ -59,7 +63,7 @@ void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
     fp, std::string("------ Include defines: preproc flags -----"));
   print_verilog_include_netlist(
     fp, std::string(src_dir + std::string(DEFINES_VERILOG_FILE_NAME)));
-  fp << std::endl;
+  fp << '\n';
 
   /* Include all the user-defined netlists */
   print_verilog_comment(
@@ -76,7 +80,7 @@ void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
        netlist_manager.netlists_by_type(NetlistManager::SUBMODULE_NETLIST)) {
     print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << '\n';
 
   /* Include all the CLB, heterogeneous block modules */
   print_verilog_comment(
@@ -85,7 +89,7 @@ void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
        netlist_manager.netlists_by_type(NetlistManager::LOGIC_BLOCK_NETLIST)) {
     print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << '\n';
 
   /* Include all the routing architecture modules */
   print_verilog_comment(
@@ -94,7 +98,7 @@ void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
          NetlistManager::ROUTING_MODULE_NETLIST)) {
     print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << '\n';
 
   /* Include FPGA top module */
   print_verilog_comment(
@@ -103,10 +107,12 @@ void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
        netlist_manager.netlists_by_type(NetlistManager::TOP_MODULE_NETLIST)) {
     print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << '\n';
 
   /* Close the file stream */
   fp.close();
+
+  return fp.file_changed();
 }
 
 /********************************************************************
@@ -127,7 +133,7 @@ void print_verilog_full_testbench_include_netlists(
   bool no_self_checking = options.no_self_checking();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
@@ -154,12 +160,12 @@ void print_verilog_full_testbench_include_netlists(
     VTR_ASSERT_SAFE(false == fabric_netlist_file.empty());
     print_verilog_include_netlist(fp, fabric_netlist_file);
   }
-  fp << std::endl;
+  fp << '\n';
 
   /* Include reference benchmark netlist only when auto-check flag is enabled */
   if (!no_self_checking) {
     print_verilog_include_netlist(fp, std::string(reference_benchmark_file));
-    fp << std::endl;
+    fp << '\n';
   }
 
   /* Include top-level testbench only when auto-check flag is enabled */
@@ -189,7 +195,7 @@ void print_verilog_preconfigured_testbench_include_netlists(
   bool no_self_checking = options.no_self_checking();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
@@ -216,12 +222,12 @@ void print_verilog_preconfigured_testbench_include_netlists(
     VTR_ASSERT_SAFE(false == fabric_netlist_file.empty());
     print_verilog_include_netlist(fp, fabric_netlist_file);
   }
-  fp << std::endl;
+  fp << '\n';
 
   /* Include reference benchmark netlist only when auto-check flag is enabled */
   if (!no_self_checking) {
     print_verilog_include_netlist(fp, std::string(reference_benchmark_file));
-    fp << std::endl;
+    fp << '\n';
   }
 
   /* Include formal verification netlists */
@@ -241,14 +247,16 @@ void print_verilog_preconfigured_testbench_include_netlists(
 /********************************************************************
  * Print a Verilog file containing preprocessing flags
  * which are used enable/disable some features in FPGA Verilog modules
+ * Return true if the file is changed
  *******************************************************************/
-void print_verilog_preprocessing_flags_netlist(
+bool print_verilog_preprocessing_flags_netlist(
   const std::string& src_dir, const FabricVerilogOption& fabric_verilog_opts) {
   std::string verilog_fname = src_dir + std::string(DEFINES_VERILOG_FILE_NAME);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc,
+          fabric_verilog_opts.incremental());
 
   /* Validate the file stream */
   check_file_stream(verilog_fname.c_str(), fp);
@@ -263,11 +271,85 @@ void print_verilog_preprocessing_flags_netlist(
   /* To enable timing */
   if (true == fabric_verilog_opts.include_timing()) {
     print_verilog_define_flag(fp, std::string(VERILOG_TIMING_PREPROC_FLAG), 1);
-    fp << std::endl;
+    fp << '\n';
+  }
+
+  /* Close the file stream */
+  fp.close();
+
+  return fp.file_changed();
+}
+
+/********************************************************************
+ * Print a line of the manifest for a netlist, where the path of the
+ * netlist is relative to the source directory when relative paths are
+ * forced
+ *******************************************************************/
+static void print_verilog_fabric_manifest_entry(std::fstream& fp,
+                                                const std::string& src_dir_path,
+                                                const std::string& netlist_path,
+                                                const bool& use_relative_path,
+                                                const bool& changed) {
+  std::string netlist_fpath = netlist_path;
+  if (use_relative_path) {
+    netlist_fpath = src_dir_path + netlist_path;
+  }
+  fp << (changed ? "changed " : "unchanged ")
+     << format_file_digest(compute_file_digest(netlist_fpath)) << " "
+     << netlist_path << '\n';
+}
+
+/********************************************************************
+ * Print a manifest of the fabric netlists, which lists for each netlist
+ * if its file has been changed by this run, the digest of its content
+ * and its path, e.g.,
+ *   changed 0123456789abcdef sub_module/luts.v
+ *   unchanged fedcba9876543210 routing/sb_1__1_.v
+ * The paths are the same as the ones to include the netlists, so that
+ * downstream tools can only recompile the changed netlists
+ *******************************************************************/
+void print_verilog_fabric_manifest(const NetlistManager& netlist_manager,
+                                   const std::string& src_dir_path,
+                                   const bool& use_relative_path,
+                                   const bool& defines_changed,
+                                   const bool& include_netlist_changed) {
+  std::string src_dir = src_dir_path;
+  if (use_relative_path) {
+    src_dir.clear();
   }
+  std::string manifest_fpath =
+    src_dir_path + std::string(FABRIC_VERILOG_MANIFEST_FILE_NAME);
+
+  /* Create the file stream */
+  BufferedFileStream fp;
+  fp.open(manifest_fpath, std::fstream::out | std::fstream::trunc);
+
+  /* Validate the file stream */
+  check_file_stream(manifest_fpath.c_str(), fp);
+
+  size_t num_changed_netlists = 0;
+  print_verilog_fabric_manifest_entry(
+    fp, src_dir_path, src_dir + std::string(DEFINES_VERILOG_FILE_NAME),
+    use_relative_path, defines_changed);
+  num_changed_netlists += defines_changed;
+  for (const NetlistId& nlist_id : netlist_manager.netlists()) {
+    print_verilog_fabric_manifest_entry(
+      fp, src_dir_path, netlist_manager.netlist_name(nlist_id),
+      use_relative_path, netlist_manager.netlist_changed(nlist_id));
+    num_changed_netlists += netlist_manager.netlist_changed(nlist_id);
+  }
+  print_verilog_fabric_manifest_entry(
+    fp, src_dir_path,
+    src_dir + std::string(FABRIC_INCLUDE_VERILOG_NETLIST_FILE_NAME),
+    use_relative_path, include_netlist_changed);
+  num_changed_netlists += include_netlist_changed;
 
   /* Close the file stream */
   fp.close();
+
+  VTR_LOG("Changed %lu out of %lu fabric netlists, listed in manifest '%s'\n",
+          num_changed_netlists, netlist_manager.netlists().size() + 2,
+          manifest_fpath.c_str());
 }
 
 } /* end namespace openfpga */
@@ -18,11 +18,12 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
-void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
+bool print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
                                           const std::string& src_dir_path,
                                           const CircuitLibrary& circuit_lib,
                                           const bool& use_relative_path,
-                                          const bool& include_time_stamp);
+                                          const bool& include_time_stamp,
+                                          const bool& incremental);
 
 void print_verilog_full_testbench_include_netlists(
   const std::string& src_dir_path, const std::string& circuit_name,
@@ -32,9 +33,15 @@ void print_verilog_preconfigured_testbench_include_netlists(
   const std::string& src_dir_path, const std::string& circuit_name,
   const VerilogTestbenchOption& options);
 
-void print_verilog_preprocessing_flags_netlist(
+bool print_verilog_preprocessing_flags_netlist(
   const std::string& src_dir, const FabricVerilogOption& fabric_verilog_opts);
 
+void print_verilog_fabric_manifest(const NetlistManager& netlist_manager,
+                                   const std::string& src_dir_path,
+                                   const bool& use_relative_path,
+                                   const bool& defines_changed,
+                                   const bool& include_netlist_changed);
+
 } /* end namespace openfpga */
 
 #endif
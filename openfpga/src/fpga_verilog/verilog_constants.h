@@ -1,6 +1,8 @@
 #ifndef VERILOG_CONSTANTS_H
 #define VERILOG_CONSTANTS_H
 
+#include <cstddef>
+
 /* global parameters for dumping synthesizable verilog */
 
 constexpr const char* VERILOG_NETLIST_FILE_POSTFIX = ".v";
@@ -13,17 +15,25 @@ constexpr const char* MODELSIM_SIMULATION_TIME_UNIT = "ms";
 
 constexpr const char* FABRIC_INCLUDE_VERILOG_NETLIST_FILE_NAME =
   "fabric_netlists.v";
+constexpr const char* FABRIC_VERILOG_MANIFEST_FILE_NAME =
+  "fabric_netlists.manifest";
 constexpr const char* TOP_VERILOG_TESTBENCH_INCLUDE_NETLIST_FILE_NAME_POSTFIX =
   "_include_netlists.v";
 constexpr const char* VERILOG_TOP_POSTFIX = "_top.v";
 constexpr const char* FORMAL_VERIFICATION_VERILOG_FILE_POSTFIX =
   "_top_formal_verification.v";
+constexpr const char* FORMAL_VERIFICATION_BITSTREAM_FILE_POSTFIX =
+  "_top_formal_verification_bitstream.mem";
 constexpr const char* TOP_TESTBENCH_VERILOG_FILE_POSTFIX =
   "_top_tb.v"; /* !!! must be consist with the modelsim_testbench_module_postfix
                 */
 constexpr const char* AUTOCHECK_TOP_TESTBENCH_VERILOG_FILE_POSTFIX =
   "_autocheck_top_tb.v"; /* !!! must be consist with the
                             modelsim_autocheck_testbench_module_postfix */
+constexpr const char* AUTOCHECK_TOP_TESTBENCH_BACKDOOR_BITSTREAM_FILE_POSTFIX =
+  "_autocheck_top_tb_backdoor_bitstream.mem";
+constexpr const char* FABRIC_TESTBENCH_VERILOG_FILE_NAME =
+  "fabric_autocheck_top_tb.v";
 constexpr const char* RANDOM_TOP_TESTBENCH_VERILOG_FILE_POSTFIX =
   "_formal_random_top_tb.v";
 constexpr const char* DEFINES_VERILOG_FILE_NAME = "fpga_defines.v";
@@ -57,10 +67,18 @@ constexpr const char* FORMAL_VERIFICATION_TOP_MODULE_POSTFIX =
 constexpr const char* FORMAL_VERIFICATION_TOP_MODULE_PORT_POSTFIX = "_fm";
 constexpr const char* FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME =
   "U0_formal_verification";
+constexpr const char* FORMAL_VERIFICATION_TOP_MODULE_BITSTREAM_MEM_NAME =
+  "preconfig_bitstream_mem";
 
 constexpr const char* FORMAL_RANDOM_TOP_TESTBENCH_POSTFIX =
   "_top_formal_verification_random_tb";
 
+constexpr const char* TESTBENCH_STIMULUS_VECTORS_NAME = "__stimulus_vectors__";
+constexpr const char* TESTBENCH_STIMULUS_VECTOR_INDEX_NAME =
+  "__stimulus_vector_index__";
+/* Number of bits provided by each call of $urandom */
+constexpr size_t VERILOG_URANDOM_WIDTH = 32;
+
 #define VERILOG_DEFAULT_SIGNAL_INIT_VALUE 0
 
 #endif
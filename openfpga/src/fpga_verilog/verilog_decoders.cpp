@@ -10,6 +10,7 @@
 /* Headers from openfpgautil library */
 #include "decoder_library_utils.h"
 #include "module_manager.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_decode.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
@@ -119,25 +120,25 @@ static void print_verilog_mux_local_decoder_module(
 
   fp << "\t"
      << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port)
-     << ")" << std::endl;
+     << ")" << '\n';
   fp << "\t"
      << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")"
-     << std::endl;
+     << '\n';
   /* Create a string for addr and data */
   for (size_t i = 0; i < data_size; ++i) {
     fp << "\t\t" << generate_verilog_constant_values(itobin_vec(i, addr_size));
     fp << " : ";
     fp << generate_verilog_port_constant_values(data_port,
                                                 ito1hot_vec(i, data_size));
-    fp << ";" << std::endl;
+    fp << ";" << '\n';
   }
   fp << "\t\t"
      << "default : ";
   fp << generate_verilog_port_constant_values(
     data_port, ito1hot_vec(data_size - 1, data_size));
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
   fp << "\t"
-     << "endcase" << std::endl;
+     << "endcase" << '\n';
 
   print_verilog_wire_connection(fp, data_inv_port, data_port, true);
 
@@ -186,8 +187,9 @@ void print_verilog_submodule_mux_local_decoders(
   std::string verilog_fpath(submodule_dir + verilog_fname);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc,
+          options.incremental());
 
   check_file_stream(verilog_fpath.c_str(), fp);
 
@@ -212,12 +214,11 @@ void print_verilog_submodule_mux_local_decoders(
       continue;
     }
 
-    const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
-    /* Create a mux graph for the branch circuit */
-    std::vector<MuxGraph> branch_mux_graphs =
-      mux_graph.build_mux_branch_graphs();
+    /* Get the mux graphs of the branch circuits */
+    const std::vector<MuxGraph>& branch_mux_graphs =
+      mux_lib.mux_branch_graphs(mux);
     /* Add the decoder to the decoder library */
-    for (auto branch_mux_graph : branch_mux_graphs) {
+    for (const MuxGraph& branch_mux_graph : branch_mux_graphs) {
       /* The decoder size depends on the number of memories of a branch MUX.
        * Note that only when there are >=2 memories, a decoder is needed
        */
@@ -250,6 +251,7 @@ void print_verilog_submodule_mux_local_decoders(
   }
   VTR_ASSERT(nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  netlist_manager.set_netlist_changed(nlist_id, fp.file_changed());
 
   VTR_LOG("Done\n");
 }
@@ -363,7 +365,7 @@ static void print_verilog_arch_decoder_module(
       fp << " or "
          << "~" << generate_verilog_port(VERILOG_PORT_CONKT, readback_port);
     }
-    fp << ") begin" << std::endl;
+    fp << ") begin" << '\n';
     fp << "\tif ((" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port)
        << " == 1'b1) && (";
     if (readback_port_id) {
@@ -371,20 +373,20 @@ static void print_verilog_arch_decoder_module(
          << " == 1'b0) && (";
     }
     fp << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << " == 1'b0))";
-    fp << " begin" << std::endl;
+    fp << " begin" << '\n';
     fp << "\t\t"
        << generate_verilog_port_constant_values(data_port,
                                                 std::vector<size_t>(1, 1))
-       << ";" << std::endl;
+       << ";" << '\n';
     fp << "\t"
-       << "end else begin" << std::endl;
+       << "end else begin" << '\n';
     fp << "\t\t"
        << generate_verilog_port_constant_values(data_port,
                                                 std::vector<size_t>(1, 0))
-       << ";" << std::endl;
+       << ";" << '\n';
     fp << "\t"
-       << "end" << std::endl;
-    fp << "end" << std::endl;
+       << "end" << '\n';
+    fp << "end" << '\n';
 
     /* Output logics for data readback output */
     if (data_ren_port_id) {
@@ -396,27 +398,27 @@ static void print_verilog_arch_decoder_module(
         fp << " or "
            << generate_verilog_port(VERILOG_PORT_CONKT, readback_port);
       }
-      fp << ") begin" << std::endl;
+      fp << ") begin" << '\n';
       fp << "\tif ((" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port)
          << " == 1'b1) && (";
       fp << generate_verilog_port(VERILOG_PORT_CONKT, readback_port)
          << " == 1'b1) && (";
       fp << generate_verilog_port(VERILOG_PORT_CONKT, addr_port)
          << " == 1'b0))";
-      fp << " begin" << std::endl;
+      fp << " begin" << '\n';
       fp << "\t\t"
          << generate_verilog_port_constant_values(data_ren_port,
                                                   std::vector<size_t>(1, 1))
-         << ";" << std::endl;
+         << ";" << '\n';
       fp << "\t"
-         << "end else begin" << std::endl;
+         << "end else begin" << '\n';
       fp << "\t\t"
          << generate_verilog_port_constant_values(data_ren_port,
                                                   std::vector<size_t>(1, 0))
-         << ";" << std::endl;
+         << ";" << '\n';
       fp << "\t"
-         << "end" << std::endl;
-      fp << "end" << std::endl;
+         << "end" << '\n';
+      fp << "end" << '\n';
     }
 
     /* Depend on if the inverted data output port is needed or not */
@@ -460,7 +462,7 @@ static void print_verilog_arch_decoder_module(
        << "~" << generate_verilog_port(VERILOG_PORT_CONKT, readback_port);
   }
   fp << " or " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
-  fp << ") begin" << std::endl;
+  fp << ") begin" << '\n';
   if (readback_port_id) {
     fp << "\tif (";
     fp << "(" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port)
@@ -468,14 +470,14 @@ static void print_verilog_arch_decoder_module(
     fp << "&&";
     fp << "(" << generate_verilog_port(VERILOG_PORT_CONKT, readback_port)
        << " == 1'b0) ";
-    fp << ") begin" << std::endl;
+    fp << ") begin" << '\n';
   } else {
     fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port)
-       << " == 1'b1) begin" << std::endl;
+       << " == 1'b1) begin" << '\n';
   }
   fp << "\t\t"
      << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")"
-     << std::endl;
+     << '\n';
   /* Create a string for addr and data */
   for (size_t i = 0; i < data_size; ++i) {
     fp << "\t\t\t"
@@ -483,7 +485,7 @@ static void print_verilog_arch_decoder_module(
     fp << " : ";
     fp << generate_verilog_port_constant_values(data_port,
                                                 ito1hot_vec(i, data_size));
-    fp << ";" << std::endl;
+    fp << ";" << '\n';
   }
   /* Different from MUX decoder, we assign default values which is all zero */
   fp << "\t\t\t"
@@ -491,24 +493,24 @@ static void print_verilog_arch_decoder_module(
   fp << " : ";
   fp << generate_verilog_port_constant_values(
     data_port, ito1hot_vec(data_size, data_size));
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t\t"
-     << "endcase" << std::endl;
+     << "endcase" << '\n';
   fp << "\t"
-     << "end" << std::endl;
+     << "end" << '\n';
 
   /* If enable is not active, we should give all zero */
   fp << "\t"
-     << "else begin" << std::endl;
+     << "else begin" << '\n';
   fp << "\t\t"
      << generate_verilog_port_constant_values(
           data_port, ito1hot_vec(data_size, data_size));
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
   fp << "\t"
-     << "end" << std::endl;
+     << "end" << '\n';
 
-  fp << "end" << std::endl;
+  fp << "end" << '\n';
 
   /* Output logics for data readback output */
   if (data_ren_port_id) {
@@ -519,17 +521,17 @@ static void print_verilog_arch_decoder_module(
       fp << " or " << generate_verilog_port(VERILOG_PORT_CONKT, readback_port);
     }
     fp << " or " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
-    fp << ") begin" << std::endl;
+    fp << ") begin" << '\n';
     fp << "\tif (";
     fp << "(" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port)
        << " == 1'b1) ";
     fp << "&&";
     fp << "(" << generate_verilog_port(VERILOG_PORT_CONKT, readback_port)
        << " == 1'b1) ";
-    fp << ") begin" << std::endl;
+    fp << ") begin" << '\n';
     fp << "\t\t"
        << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port)
-       << ")" << std::endl;
+       << ")" << '\n';
     /* Create a string for addr and data */
     for (size_t i = 0; i < data_size; ++i) {
       fp << "\t\t\t"
@@ -537,7 +539,7 @@ static void print_verilog_arch_decoder_module(
       fp << " : ";
       fp << generate_verilog_port_constant_values(data_ren_port,
                                                   ito1hot_vec(i, data_size));
-      fp << ";" << std::endl;
+      fp << ";" << '\n';
     }
     /* Different from MUX decoder, we assign default values which is all zero */
     fp << "\t\t\t"
@@ -545,24 +547,24 @@ static void print_verilog_arch_decoder_module(
     fp << " : ";
     fp << generate_verilog_port_constant_values(
       data_ren_port, ito1hot_vec(data_size, data_size));
-    fp << ";" << std::endl;
+    fp << ";" << '\n';
 
     fp << "\t\t"
-       << "endcase" << std::endl;
+       << "endcase" << '\n';
     fp << "\t"
-       << "end" << std::endl;
+       << "end" << '\n';
 
     /* If enable is not active, we should give all zero */
     fp << "\t"
-       << "else begin" << std::endl;
+       << "else begin" << '\n';
     fp << "\t\t"
        << generate_verilog_port_constant_values(
             data_ren_port, ito1hot_vec(data_size, data_size));
-    fp << ";" << std::endl;
+    fp << ";" << '\n';
     fp << "\t"
-       << "end" << std::endl;
+       << "end" << '\n';
 
-    fp << "end" << std::endl;
+    fp << "end" << '\n';
   }
 
   if (true == decoder_lib.use_data_inv_port(decoder)) {
@@ -667,20 +669,20 @@ static void print_verilog_arch_decoder_with_data_in_module(
   if (1 == data_size) {
     fp << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
     fp << " or " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
-    fp << ") begin" << std::endl;
+    fp << ") begin" << '\n';
     fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port)
-       << " == 1'b1) begin" << std::endl;
+       << " == 1'b1) begin" << '\n';
     fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, din_port) << ";"
-       << std::endl;
+       << '\n';
     fp << "\t"
-       << "end else begin" << std::endl;
+       << "end else begin" << '\n';
     fp << "\t\t"
        << generate_verilog_port_constant_values(data_port,
                                                 std::vector<size_t>(1, 0))
-       << ";" << std::endl;
+       << ";" << '\n';
     fp << "\t"
-       << "end" << std::endl;
-    fp << "end" << std::endl;
+       << "end" << '\n';
+    fp << "end" << '\n';
 
     /* Depend on if the inverted data output port is needed or not */
     if (true == decoder_lib.use_data_inv_port(decoder)) {
@@ -703,19 +705,19 @@ static void print_verilog_arch_decoder_with_data_in_module(
   fp << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
   fp << ", " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
   fp << ", " << generate_verilog_port(VERILOG_PORT_CONKT, din_port);
-  fp << ") begin" << std::endl;
+  fp << ") begin" << '\n';
 
   fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port)
-     << " == 1'b1) begin" << std::endl;
+     << " == 1'b1) begin" << '\n';
   fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port);
   fp << " = ";
   std::string high_res_str =
     "{" + std::to_string(data_port.get_width()) + "{1'bz}}";
   fp << high_res_str;
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
   fp << "\t\t"
      << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")"
-     << std::endl;
+     << '\n';
   /* Create a string for addr and data */
   for (size_t i = 0; i < data_size; ++i) {
     BasicPort cur_data_port(data_port.get_name(), i, i);
@@ -725,7 +727,7 @@ static void print_verilog_arch_decoder_with_data_in_module(
     fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_data_port);
     fp << " = ";
     fp << generate_verilog_port(VERILOG_PORT_CONKT, din_port);
-    fp << ";" << std::endl;
+    fp << ";" << '\n';
   }
   /* Different from MUX decoder, we assign default values which is all zero */
   fp << "\t\t\t"
@@ -734,24 +736,24 @@ static void print_verilog_arch_decoder_with_data_in_module(
   fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port);
   fp << " = ";
   fp << high_res_str;
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t\t"
-     << "endcase" << std::endl;
+     << "endcase" << '\n';
   fp << "\t"
-     << "end" << std::endl;
+     << "end" << '\n';
 
   /* If enable is not active, we should give all zero */
   fp << "\t"
-     << "else begin" << std::endl;
+     << "else begin" << '\n';
   fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port);
   fp << " = ";
   fp << high_res_str;
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
   fp << "\t"
-     << "end" << std::endl;
+     << "end" << '\n';
 
-  fp << "end" << std::endl;
+  fp << "end" << '\n';
 
   if (true == decoder_lib.use_data_inv_port(decoder)) {
     print_verilog_wire_connection(fp, data_inv_port, data_port, true);
@@ -766,6 +768,184 @@ static void print_verilog_arch_decoder_with_data_in_module(
   print_verilog_module_end(fp, module_name);
 }
 
+/***************************************************************************************
+ * Create a parameterized Verilog module which implements the decoders of
+ * print_verilog_arch_decoder_module() and
+ * print_verilog_arch_decoder_with_data_in_module() for any size, where the
+ * sizes are the parameters ADDR_SIZE and DATA_SIZE
+ *
+ * Rather than a truth table, the data output is indexed by the address.
+ * Since the first bit of the address port is the least significant bit of
+ * the address codes, the address is reversed into an index first.
+ * Addresses which are out of the data range select nothing, as the default
+ * case of the truth tables.
+ * - Without data_in, the selected data output is '1' and the others are
+ *   '0'. When the readback port is '1', the selected bit of the read-enable
+ *   output is driven instead.
+ * - With data_in, the selected data output is driven by data_in and the
+ *   others are in high impedance.
+ ***************************************************************************************/
+static void print_verilog_arch_decoder_template_module(
+  std::fstream& fp, const bool& use_data_in,
+  const e_verilog_default_net_type& default_net_type) {
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  std::string module_name =
+    generate_memory_decoder_template_subckt_name(use_data_in);
+  std::string enable_name(DECODER_ENABLE_PORT_NAME);
+  std::string addr_name(DECODER_ADDRESS_PORT_NAME);
+  std::string din_name(DECODER_DATA_IN_PORT_NAME);
+  std::string readback_name(DECODER_READBACK_PORT_NAME);
+  std::string data_name(DECODER_DATA_OUT_PORT_NAME);
+  std::string data_inv_name(DECODER_DATA_OUT_INV_PORT_NAME);
+  std::string data_ren_name(DECODER_DATA_READ_ENABLE_PORT_NAME);
+
+  print_verilog_default_net_type_declaration(fp, default_net_type);
+
+  fp << "module " << module_name << "(" << enable_name << ", " << addr_name;
+  if (true == use_data_in) {
+    fp << ", " << din_name;
+  } else {
+    fp << ", " << readback_name;
+  }
+  fp << ", " << data_name << ", " << data_inv_name;
+  if (false == use_data_in) {
+    fp << ", " << data_ren_name;
+  }
+  fp << ");" << '\n';
+  fp << "parameter ADDR_SIZE = 1;" << '\n';
+  fp << "parameter DATA_SIZE = 2;" << '\n';
+  fp << "input " << enable_name << ";" << '\n';
+  fp << "input [0:ADDR_SIZE-1] " << addr_name << ";" << '\n';
+  if (true == use_data_in) {
+    fp << "input " << din_name << ";" << '\n';
+  } else {
+    fp << "input " << readback_name << ";" << '\n';
+  }
+  fp << "output reg [0:DATA_SIZE-1] " << data_name << ";" << '\n';
+  fp << "output [0:DATA_SIZE-1] " << data_inv_name << ";" << '\n';
+  fp << "wire [0:DATA_SIZE-1] " << data_inv_name << ";" << '\n';
+  if (false == use_data_in) {
+    fp << "output reg [0:DATA_SIZE-1] " << data_ren_name << ";" << '\n';
+  }
+  fp << '\n';
+
+  print_verilog_comment(
+    fp, std::string("----- BEGIN Verilog codes for Decoder convert "
+                    "ADDR_SIZE-bit addr to DATA_SIZE-bit data -----"));
+
+  fp << "reg [ADDR_SIZE-1:0] addr_index;" << '\n';
+  fp << "integer ibit;" << '\n';
+  fp << "always@(*) begin" << '\n';
+  fp << "\tfor (ibit = 0; ibit < ADDR_SIZE; ibit = ibit + 1) begin" << '\n';
+  fp << "\t\taddr_index[ibit] = " << addr_name << "[ibit];" << '\n';
+  fp << "\tend" << '\n';
+  if (true == use_data_in) {
+    fp << "\t" << data_name << " = {DATA_SIZE{1'bz}};" << '\n';
+    fp << "\tif ((" << enable_name
+       << " == 1'b1) && (addr_index < DATA_SIZE)) begin" << '\n';
+    fp << "\t\t" << data_name << "[addr_index] = " << din_name << ";"
+       << '\n';
+    fp << "\tend" << '\n';
+  } else {
+    fp << "\t" << data_name << " = {DATA_SIZE{1'b0}};" << '\n';
+    fp << "\t" << data_ren_name << " = {DATA_SIZE{1'b0}};" << '\n';
+    fp << "\tif ((" << enable_name
+       << " == 1'b1) && (addr_index < DATA_SIZE)) begin" << '\n';
+    fp << "\t\tif (" << readback_name << " == 1'b0) begin" << '\n';
+    fp << "\t\t\t" << data_name << "[addr_index] = 1'b1;" << '\n';
+    fp << "\t\tend else begin" << '\n';
+    fp << "\t\t\t" << data_ren_name << "[addr_index] = 1'b1;" << '\n';
+    fp << "\t\tend" << '\n';
+    fp << "\tend" << '\n';
+  }
+  fp << "end" << '\n';
+  fp << "assign " << data_inv_name << " = ~" << data_name << ";" << '\n';
+
+  print_verilog_comment(
+    fp, std::string("----- END Verilog codes for Decoder convert "
+                    "ADDR_SIZE-bit addr to DATA_SIZE-bit data -----"));
+
+  print_verilog_module_end(fp, module_name);
+}
+
+/***************************************************************************************
+ * Create a Verilog module for a decoder used as a configuration protocol,
+ * which is an instance of the parameterized decoder
+ * (see print_verilog_arch_decoder_template_module()) with the sizes of the
+ * decoder. The ports which the decoder does not have are tied to '0' or left
+ * unconnected.
+ ***************************************************************************************/
+static void print_verilog_arch_decoder_wrapper_module(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const DecoderLibrary& decoder_lib, const DecoderId& decoder,
+  const e_verilog_default_net_type& default_net_type) {
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  size_t addr_size = decoder_lib.addr_size(decoder);
+  size_t data_size = decoder_lib.data_size(decoder);
+  bool use_data_in = decoder_lib.use_data_in(decoder);
+
+  std::string module_name =
+    use_data_in
+      ? generate_memory_decoder_with_data_in_subckt_name(addr_size, data_size)
+      : generate_memory_decoder_subckt_name(addr_size, data_size);
+  ModuleId module_id = module_manager.find_module(module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(module_id));
+
+  /* The outputs are driven by the instance, so none of them is registered */
+  print_verilog_default_net_type_declaration(fp, default_net_type);
+  print_verilog_module_definition(fp, module_manager, module_id);
+  for (const BasicPort& port : module_manager.module_ports_by_type(
+         module_id, ModuleManager::MODULE_INPUT_PORT)) {
+    fp << generate_verilog_port(VERILOG_PORT_INPUT, port) << ";" << '\n';
+  }
+  for (const BasicPort& port : module_manager.module_ports_by_type(
+         module_id, ModuleManager::MODULE_OUTPUT_PORT)) {
+    fp << generate_verilog_port(VERILOG_PORT_OUTPUT, port) << ";" << '\n';
+    if (VERILOG_DEFAULT_NET_TYPE_WIRE != default_net_type) {
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, port) << ";" << '\n';
+    }
+  }
+  fp << '\n';
+
+  /* Instanciate the parameterized decoder, where the ports are mapped by
+   * names as the template has more ports than the decoder */
+  std::string template_name =
+    generate_memory_decoder_template_subckt_name(use_data_in);
+  fp << "\t" << template_name << " #(.ADDR_SIZE(" << addr_size
+     << "), .DATA_SIZE(" << data_size << ")) " << template_name << "_0 (";
+  std::vector<std::string> port_names = {
+    DECODER_ENABLE_PORT_NAME, DECODER_ADDRESS_PORT_NAME,
+    DECODER_DATA_OUT_PORT_NAME, DECODER_DATA_OUT_INV_PORT_NAME};
+  if (true == use_data_in) {
+    port_names.push_back(DECODER_DATA_IN_PORT_NAME);
+  } else {
+    port_names.push_back(DECODER_READBACK_PORT_NAME);
+    port_names.push_back(DECODER_DATA_READ_ENABLE_PORT_NAME);
+  }
+  for (size_t iport = 0; iport < port_names.size(); ++iport) {
+    if (0 < iport) {
+      fp << ",";
+    }
+    fp << '\n' << "\t\t." << port_names[iport] << "(";
+    ModulePortId port_id =
+      module_manager.find_module_port(module_id, port_names[iport]);
+    if (true == module_manager.valid_module_port_id(module_id, port_id)) {
+      BasicPort port = module_manager.module_port(module_id, port_id);
+      fp << generate_verilog_port(VERILOG_PORT_CONKT, port);
+    } else if (std::string(DECODER_READBACK_PORT_NAME) == port_names[iport]) {
+      /* Without readback, the decoder always drives the data outputs */
+      fp << "1'b0";
+    }
+    fp << ")";
+  }
+  fp << ");" << '\n';
+
+  /* Put an end to the Verilog module */
+  print_verilog_module_end(fp, module_name);
+}
+
 /***************************************************************************************
  * This function will generate all the unique Verilog modules of decoders for
  * configuration protocols in a FPGA fabric
@@ -775,6 +955,10 @@ static void print_verilog_arch_decoder_with_data_in_module(
  *and the local decoders should be synthesized before running the back-end flow
  *for FPGA fabric See more details in the function print_verilog_arch_decoder()
  *for more details
+ * When parameterized decoders are required, the decoders are written as
+ * instances of a parameterized decoder per type, whose body does not grow
+ * with the size of decoders. Decoders with a single data output keep their
+ * own modules, which are already as small as an instance.
  ***************************************************************************************/
 void print_verilog_submodule_arch_decoders(
   const ModuleManager& module_manager, NetlistManager& netlist_manager,
@@ -784,8 +968,9 @@ void print_verilog_submodule_arch_decoders(
   std::string verilog_fpath(submodule_dir + verilog_fname);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc,
+          options.incremental());
 
   check_file_stream(verilog_fpath.c_str(), fp);
 
@@ -797,9 +982,27 @@ void print_verilog_submodule_arch_decoders(
   print_verilog_file_header(fp, "Decoders for fabric configuration protocol",
                             options.time_stamp());
 
+  /* Write a parameterized decoder of each type used by the decoders */
+  if (true == options.parameterized_decoders()) {
+    for (const bool& use_data_in : {false, true}) {
+      for (const auto& decoder : decoder_lib.decoders()) {
+        if ((use_data_in == decoder_lib.use_data_in(decoder)) &&
+            (1 < decoder_lib.data_size(decoder))) {
+          print_verilog_arch_decoder_template_module(
+            fp, use_data_in, options.default_net_type());
+          break;
+        }
+      }
+    }
+  }
+
   /* Generate Verilog modules for the found unique local encoders */
   for (const auto& decoder : decoder_lib.decoders()) {
-    if (true == decoder_lib.use_data_in(decoder)) {
+    if ((true == options.parameterized_decoders()) &&
+        (1 < decoder_lib.data_size(decoder))) {
+      print_verilog_arch_decoder_wrapper_module(
+        fp, module_manager, decoder_lib, decoder, options.default_net_type());
+    } else if (true == decoder_lib.use_data_in(decoder)) {
       print_verilog_arch_decoder_with_data_in_module(
         fp, module_manager, decoder_lib, decoder, options.default_net_type());
     } else {
@@ -820,6 +1023,7 @@ void print_verilog_submodule_arch_decoders(
   }
   VTR_ASSERT(nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  netlist_manager.set_netlist_changed(nlist_id, fp.file_changed());
 
   VTR_LOG("Done\n");
 }
@@ -13,6 +13,7 @@
 /* Headers from openfpgautil library */
 #include "module_manager.h"
 #include "module_manager_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "openfpga_port.h"
@@ -40,8 +41,7 @@ static void print_verilog_power_gated_invbuf_body(
     fp, std::string("----- Verilog codes of a power-gated inverter -----"));
 
   /* Create a sensitive list */
-  fp << "\treg " << circuit_lib.port_lib_name(output_port) << "_reg;"
-     << std::endl;
+  fp << "\treg " << circuit_lib.port_lib_name(output_port) << "_reg;" << '\n';
 
   fp << "\talways @(";
   /* Power-gate port first*/
@@ -53,7 +53,7 @@ static void print_verilog_power_gated_invbuf_body(
     fp << circuit_lib.port_lib_name(power_gate_port);
     fp << ", ";
   }
-  fp << circuit_lib.port_lib_name(input_port) << ") begin" << std::endl;
+  fp << circuit_lib.port_lib_name(input_port) << ") begin" << '\n';
 
   /* Dump the case of power-gated */
   fp << "\t\tif (";
@@ -66,7 +66,7 @@ static void print_verilog_power_gated_invbuf_body(
     }
     for (const auto& power_gate_pin : circuit_lib.pins(power_gate_port)) {
       if (0 < port_cnt) {
-        fp << std::endl << "\t\t&&";
+        fp << '\n' << "\t\t&&";
       }
       fp << "(";
 
@@ -84,7 +84,7 @@ static void print_verilog_power_gated_invbuf_body(
     }
   }
 
-  fp << ") begin" << std::endl;
+  fp << ") begin" << '\n';
   fp << "\t\t\tassign " << circuit_lib.port_lib_name(output_port) << "_reg = ";
 
   /* Branch on the type of inverter/buffer:
@@ -100,14 +100,14 @@ static void print_verilog_power_gated_invbuf_body(
     fp << "~";
   }
 
-  fp << circuit_lib.port_lib_name(input_port) << ";" << std::endl;
-  fp << "\t\tend else begin" << std::endl;
+  fp << circuit_lib.port_lib_name(input_port) << ";" << '\n';
+  fp << "\t\tend else begin" << '\n';
   fp << "\t\t\tassign " << circuit_lib.port_lib_name(output_port)
-     << "_reg = 1'bz;" << std::endl;
-  fp << "\t\tend" << std::endl;
-  fp << "\tend" << std::endl;
+     << "_reg = 1'bz;" << '\n';
+  fp << "\t\tend" << '\n';
+  fp << "\tend" << '\n';
   fp << "\tassign " << circuit_lib.port_lib_name(output_port) << " = "
-     << circuit_lib.port_lib_name(output_port) << "_reg;" << std::endl;
+     << circuit_lib.port_lib_name(output_port) << "_reg;" << '\n';
 }
 
 /************************************************
@@ -141,7 +141,7 @@ static void print_verilog_invbuf_body(std::fstream& fp,
     fp << "~";
   }
 
-  fp << circuit_lib.port_lib_name(input_port) << ";" << std::endl;
+  fp << circuit_lib.port_lib_name(input_port) << ";" << '\n';
 }
 
 /************************************************
@@ -284,7 +284,7 @@ static void print_verilog_passgate_module(
   fp << "\tassign " << circuit_lib.port_lib_name(output_ports[0]) << " = ";
   fp << circuit_lib.port_lib_name(input_ports[1]) << " ? "
      << circuit_lib.port_lib_name(input_ports[0]);
-  fp << " : 1'bz;" << std::endl;
+  fp << " : 1'bz;" << '\n';
 
   /* Print timing info */
   print_verilog_submodule_timing(fp, circuit_lib, circuit_model);
@@ -351,7 +351,7 @@ static void print_verilog_and_or_gate_body(
           port_cnt++;
         }
       }
-      fp << ";" << std::endl;
+      fp << ";" << '\n';
     }
   }
 }
@@ -427,7 +427,7 @@ static void print_verilog_mux2_gate_body(
   fp << generate_verilog_port(VERILOG_PORT_CONKT, in0_port_info);
   fp << " : ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, in1_port_info);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 }
 
 /************************************************
@@ -545,10 +545,11 @@ void print_verilog_submodule_essentials(const ModuleManager& module_manager,
   std::string verilog_fname(ESSENTIALS_VERILOG_FILE_NAME);
   std::string verilog_fpath = submodule_dir + verilog_fname;
 
-  std::fstream fp;
+  BufferedFileStream fp;
 
   /* Create the file stream */
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc,
+          options.incremental());
   /* Check if the file stream if valid or not */
   check_file_stream(verilog_fpath.c_str(), fp);
 
@@ -600,6 +601,7 @@ void print_verilog_submodule_essentials(const ModuleManager& module_manager,
   }
   VTR_ASSERT(nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  netlist_manager.set_netlist_changed(nlist_id, fp.file_changed());
 
   VTR_LOG("Done\n");
 }
@@ -16,9 +16,11 @@
 /* Headers from openfpgautil library */
 #include "fabric_global_port_info_utils.h"
 #include "openfpga_atom_netlist_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_port.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "simulation_utils.h"
 #include "verilog_constants.h"
 #include "verilog_formal_random_top_testbench.h"
@@ -63,7 +65,7 @@ static void print_verilog_top_random_testbench_ports(
 
   /* Print the declaration for the module */
   fp << "module " << circuit_name << FORMAL_RANDOM_TOP_TESTBENCH_POSTFIX << ";"
-     << std::endl;
+     << '\n';
 
   /* Create a clock port if the benchmark does not have one!
    * The clock is used for counting and synchronizing input stimulus
@@ -75,11 +77,11 @@ static void print_verilog_top_random_testbench_ports(
                     "does not contain one -------"));
   for (const BasicPort& clock_port : clock_ports) {
     fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, clock_port) << ";"
-       << std::endl;
+       << '\n';
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_testbench_shared_ports(
     fp, module_manager, FabricGlobalPortInfo(), PinConstraints(), atom_ctx,
@@ -92,9 +94,9 @@ static void print_verilog_top_random_testbench_ports(
    */
   if (!options.no_self_checking()) {
     print_verilog_comment(fp, std::string("----- Error counter -------"));
-    fp << "\tinteger " << ERROR_COUNTER << "= 0;" << std::endl;
+    fp << "\tinteger " << ERROR_COUNTER << "= 0;" << '\n';
     /* Add an empty line as splitter */
-    fp << std::endl;
+    fp << '\n';
   }
 }
 
@@ -123,7 +125,7 @@ static void print_verilog_top_random_testbench_benchmark_instance(
     fp, std::string("----- End reference Benchmark Instanication -------"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -154,7 +156,7 @@ static void print_verilog_random_testbench_fpga_instance(
     fp, std::string("----- End FPGA Fabric Instanication -------"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -213,13 +215,13 @@ static void print_verilog_random_testbench_reset_stimuli(
       initial_value = 0;
     }
 
-    fp << "initial" << std::endl;
-    fp << "\tbegin" << std::endl;
+    fp << "initial" << '\n';
+    fp << "\tbegin" << '\n';
     fp << "\t";
     std::vector<size_t> initial_values(reset_port.get_width(), initial_value);
     fp << "\t";
     fp << generate_verilog_port_constant_values(reset_port, initial_values);
-    fp << ";" << std::endl;
+    fp << ";" << '\n';
 
     /* Flip the reset at the second negative edge of the clock port
      * So the generic reset stimuli is applicable to both synchronous reset and
@@ -228,18 +230,16 @@ static void print_verilog_random_testbench_reset_stimuli(
      * can be sensed in the 1st rising/falling edge of the clock signal
      */
     fp << "\t@(negedge "
-       << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << ");"
-       << std::endl;
+       << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << ");" << '\n';
     fp << "\t@(negedge "
-       << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << ");"
-       << std::endl;
+       << generate_verilog_port(VERILOG_PORT_CONKT, clock_port) << ");" << '\n';
     print_verilog_register_connection(fp, reset_port, reset_port, true);
-    fp << "\tend" << std::endl;
+    fp << "\tend" << '\n';
   }
 
   print_verilog_comment(fp, "----- End reset signal generation -----");
 
-  fp << std::endl;
+  fp << '\n';
 }
 
 /*********************************************************************
@@ -280,9 +280,10 @@ void print_verilog_random_top_testbench(
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
@@ -335,7 +336,8 @@ void print_verilog_random_top_testbench(
     fp, atom_ctx, netlist_annotation, module_manager, global_ports,
     pin_constraints, clock_port_names, std::string(),
     std::string(CHECKFLAG_PORT_POSTFIX), clock_ports,
-    options.no_self_checking());
+    options.no_self_checking(), options.vectorized_stimulus(),
+    options.stimulus_vector_file(), simulation_parameters.num_clock_cycles());
 
   if (!options.no_self_checking()) {
     print_verilog_testbench_check(
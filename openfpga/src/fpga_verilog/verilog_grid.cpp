@@ -4,6 +4,7 @@
  *******************************************************************/
 /* System header files */
 #include <fstream>
+#include <functional>
 #include <vector>
 
 /* Headers from vtrutil library */
@@ -15,6 +16,7 @@
 #include "physical_types.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_side_manager.h"
 
@@ -87,8 +89,9 @@ static void print_verilog_primitive_block(
   VTR_LOGV(verbose, "\n");
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc,
+          options.incremental());
 
   check_file_stream(verilog_fpath.c_str(), fp);
 
@@ -128,6 +131,7 @@ static void print_verilog_primitive_block(
   VTR_ASSERT(nlist_id);
   netlist_manager.set_netlist_type(nlist_id,
                                    NetlistManager::LOGIC_BLOCK_NETLIST);
+  netlist_manager.set_netlist_changed(nlist_id, fp.file_changed());
 
   VTR_LOGV(verbose, "Done\n");
 }
@@ -201,8 +205,9 @@ static void rec_print_verilog_logical_tile(
   VTR_LOGV(verbose, "\n");
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc,
+          options.incremental());
 
   check_file_stream(verilog_fpath.c_str(), fp);
 
@@ -251,6 +256,7 @@ static void rec_print_verilog_logical_tile(
   VTR_ASSERT(nlist_id);
   netlist_manager.set_netlist_type(nlist_id,
                                    NetlistManager::LOGIC_BLOCK_NETLIST);
+  netlist_manager.set_netlist_changed(nlist_id, fp.file_changed());
 
   VTR_LOGV(verbose, "Done\n");
 }
@@ -318,8 +324,9 @@ static void print_verilog_physical_tile_netlist(
   }
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc,
+          options.incremental());
 
   check_file_stream(verilog_fpath.c_str(), fp);
 
@@ -350,7 +357,7 @@ static void print_verilog_physical_tile_netlist(
                     module_manager.module_name(grid_module) + " -----"));
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Close file handler */
   fp.close();
@@ -365,6 +372,7 @@ static void print_verilog_physical_tile_netlist(
   VTR_ASSERT(nlist_id);
   netlist_manager.set_netlist_type(nlist_id,
                                    NetlistManager::LOGIC_BLOCK_NETLIST);
+  netlist_manager.set_netlist_changed(nlist_id, fp.file_changed());
 
   VTR_LOG("Done\n");
 }
@@ -374,15 +382,16 @@ static void print_verilog_physical_tile_netlist(
  * 1. Only one module for each I/O on each border side (IO_TYPE)
  * 2. Only one module for each CLB (FILL_TYPE)
  * 3. Only one module for each heterogeneous block
+ * Each tile is written by a separated task, so that the files are
+ * written with the number of threads in the options
  ****************************************************************************/
 void print_verilog_grids(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
   const DeviceContext& device_ctx, const VprDeviceAnnotation& device_annotation,
   const std::string& subckt_dir, const std::string& subckt_dir_name,
   const FabricVerilogOption& options, const bool& verbose) {
-  /* Create a vector to contain all the Verilog netlist names that have been
-   * generated in this function */
-  std::vector<std::string> netlist_names;
+  /* Create a list of tasks, each of which writes Verilog netlists */
+  std::vector<std::function<void(NetlistManager&)>> print_tasks;
 
   /* Enumerate the types of logical tiles, and build a module for each
    * Write modules for all the pb_types/pb_graph_nodes
@@ -399,10 +408,16 @@ void print_verilog_grids(
     if (nullptr == logical_tile.pb_graph_head) {
       continue;
     }
-    print_verilog_logical_tile_netlist(
-      netlist_manager, module_manager, device_annotation, subckt_dir,
-      subckt_dir_name, logical_tile.pb_graph_head, options, verbose);
+    t_pb_graph_node* pb_graph_head = logical_tile.pb_graph_head;
+    print_tasks.push_back(
+      [&, pb_graph_head](NetlistManager& task_netlist_manager) {
+        print_verilog_logical_tile_netlist(
+          task_netlist_manager, module_manager, device_annotation, subckt_dir,
+          subckt_dir_name, pb_graph_head, options, verbose);
+      });
   }
+  print_verilog_netlists(netlist_manager, print_tasks, options.num_threads());
+  print_tasks.clear();
   VTR_LOG("Writing logical tiles...");
   VTR_LOG("Done\n");
 
@@ -415,6 +430,7 @@ void print_verilog_grids(
   VTR_LOGV(verbose, "\n");
   for (const t_physical_tile_type& physical_tile :
        device_ctx.physical_tile_types) {
+    t_physical_tile_type_ptr phy_block_type = &physical_tile;
     /* Bypass empty type or nullptr */
     if (true == is_empty_type(&physical_tile)) {
       continue;
@@ -431,18 +447,26 @@ void print_verilog_grids(
       std::set<e_side> io_type_sides =
         find_physical_io_tile_located_sides(device_ctx.grid, &physical_tile);
       for (const e_side& io_type_side : io_type_sides) {
-        print_verilog_physical_tile_netlist(
-          netlist_manager, module_manager, subckt_dir, subckt_dir_name,
-          &physical_tile, io_type_side, options);
+        print_tasks.push_back(
+          [&, phy_block_type, io_type_side](
+            NetlistManager& task_netlist_manager) {
+            print_verilog_physical_tile_netlist(
+              task_netlist_manager, module_manager, subckt_dir,
+              subckt_dir_name, phy_block_type, io_type_side, options);
+          });
       }
       continue;
     } else {
       /* For CLB and heterogenenous blocks */
-      print_verilog_physical_tile_netlist(netlist_manager, module_manager,
-                                          subckt_dir, subckt_dir_name,
-                                          &physical_tile, NUM_SIDES, options);
+      print_tasks.push_back(
+        [&, phy_block_type](NetlistManager& task_netlist_manager) {
+          print_verilog_physical_tile_netlist(
+            task_netlist_manager, module_manager, subckt_dir, subckt_dir_name,
+            phy_block_type, NUM_SIDES, options);
+        });
     }
   }
+  print_verilog_netlists(netlist_manager, print_tasks, options.num_threads());
   VTR_LOG("Building physical tiles...");
   VTR_LOG("Done\n");
   VTR_LOG("\n");
@@ -12,6 +12,7 @@
 #include "module_manager.h"
 #include "mux_graph.h"
 #include "mux_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "verilog_constants.h"
@@ -35,10 +36,11 @@ void print_verilog_submodule_luts(const ModuleManager& module_manager,
   std::string verilog_fname(LUTS_VERILOG_FILE_NAME);
   std::string verilog_fpath(submodule_dir + verilog_fname);
 
-  std::fstream fp;
+  BufferedFileStream fp;
 
   /* Create the file stream */
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc,
+          options.incremental());
   /* Check if the file stream if valid or not */
   check_file_stream(verilog_fpath.c_str(), fp);
 
@@ -77,6 +79,7 @@ void print_verilog_submodule_luts(const ModuleManager& module_manager,
   }
   VTR_ASSERT(nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  netlist_manager.set_netlist_changed(nlist_id, fp.file_changed());
 
   VTR_LOG("Done\n");
 }
@@ -4,6 +4,7 @@
  * circuit models, such as IOPADs, LUTs, etc.
  ********************************************************************/
 #include <algorithm>
+#include <set>
 #include <string>
 
 /* Headers from vtrutil library */
@@ -12,9 +13,11 @@
 
 /* Headers from openfpgautil library */
 #include "circuit_library_utils.h"
+#include "memory_utils.h"
 #include "module_manager.h"
 #include "mux_graph.h"
 #include "mux_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "verilog_constants.h"
@@ -25,6 +28,29 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/*********************************************************************
+ * Generate Verilog modules for the memory tiles which compose a memory
+ * module, if any. Tiles are shared by memory modules, so each tile is
+ * written only once, before the first memory module using it
+ ********************************************************************/
+static void print_verilog_memory_tile_modules(
+  const ModuleManager& module_manager, std::fstream& fp,
+  const ModuleId& mem_module, std::set<ModuleId>& written_tile_modules,
+  const bool& explicit_port_mapping, const FabricVerilogOption& options) {
+  for (const ModuleId& tile_module :
+       find_memory_tile_modules(module_manager, mem_module)) {
+    if (false == written_tile_modules.insert(tile_module).second) {
+      continue;
+    }
+    write_verilog_module_to_file(fp, module_manager, tile_module,
+                                 explicit_port_mapping,
+                                 options.default_net_type());
+
+    /* Add an empty line as a splitter */
+    fp << '\n';
+  }
+}
+
 /*********************************************************************
  * Generate Verilog modules for the memories that are used
  * by multiplexers
@@ -41,6 +67,7 @@ namespace openfpga {
 static void print_verilog_mux_memory_module(
   const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
   std::fstream& fp, const CircuitModelId& mux_model, const MuxGraph& mux_graph,
+  std::set<ModuleId>& written_tile_modules,
   const FabricVerilogOption& options) {
   /* Multiplexers built with different technology is in different organization
    */
@@ -54,6 +81,11 @@ static void print_verilog_mux_memory_module(
         std::string(VERILOG_MEM_POSTFIX));
       ModuleId mem_module = module_manager.find_module(module_name);
       VTR_ASSERT(true == module_manager.valid_module_id(mem_module));
+      print_verilog_memory_tile_modules(
+        module_manager, fp, mem_module, written_tile_modules,
+        options.explicit_port_mapping() ||
+          circuit_lib.dump_explicit_port_map(mux_model),
+        options);
       /* Write the module content in Verilog format */
       write_verilog_module_to_file(
         fp, module_manager, mem_module,
@@ -62,7 +94,7 @@ static void print_verilog_mux_memory_module(
         options.default_net_type());
 
       /* Add an empty line as a splitter */
-      fp << std::endl;
+      fp << '\n';
       break;
     }
     case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -107,8 +139,9 @@ void print_verilog_submodule_memories(const ModuleManager& module_manager,
   std::string verilog_fpath(submodule_dir + verilog_fname);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc,
+          options.incremental());
 
   check_file_stream(verilog_fpath.c_str(), fp);
 
@@ -119,6 +152,9 @@ void print_verilog_submodule_memories(const ModuleManager& module_manager,
 
   print_verilog_file_header(fp, "Memories used in FPGA", options.time_stamp());
 
+  /* Memory tiles which have been written */
+  std::set<ModuleId> written_tile_modules;
+
   /* Create the memory circuits for the multiplexer */
   for (auto mux : mux_lib.muxes()) {
     const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
@@ -132,7 +168,7 @@ void print_verilog_submodule_memories(const ModuleManager& module_manager,
     }
     /* Create a Verilog module for the memories used by the multiplexer */
     print_verilog_mux_memory_module(module_manager, circuit_lib, fp, mux_model,
-                                    mux_graph, options);
+                                    mux_graph, written_tile_modules, options);
   }
 
   /* Create the memory circuits for non-MUX circuit models.
@@ -178,6 +214,11 @@ void print_verilog_submodule_memories(const ModuleManager& module_manager,
 
     ModuleId mem_module = module_manager.find_module(module_name);
     VTR_ASSERT(true == module_manager.valid_module_id(mem_module));
+    print_verilog_memory_tile_modules(
+      module_manager, fp, mem_module, written_tile_modules,
+      options.explicit_port_mapping() ||
+        circuit_lib.dump_explicit_port_map(model),
+      options);
     /* Write the module content in Verilog format */
     write_verilog_module_to_file(fp, module_manager, mem_module,
                                  options.explicit_port_mapping() ||
@@ -185,7 +226,7 @@ void print_verilog_submodule_memories(const ModuleManager& module_manager,
                                  options.default_net_type());
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << '\n';
   }
 
   /* Close the file stream */
@@ -200,6 +241,7 @@ void print_verilog_submodule_memories(const ModuleManager& module_manager,
   }
   VTR_ASSERT(nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  netlist_manager.set_netlist_changed(nlist_id, fp.file_changed());
 
   VTR_LOG("Done\n");
 }
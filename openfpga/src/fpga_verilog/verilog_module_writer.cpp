@@ -13,6 +13,7 @@
 #include "vtr_assert.h"
 
 /* Headers from openfpgautil library */
+#include "module_emission_plan.h"
 #include "module_manager_utils.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
@@ -28,7 +29,7 @@ namespace openfpga {
  * Generate the name of a local wire for a undriven port inside Verilog
  * module
  *******************************************************************/
-static std::string generate_verilog_undriven_local_wire_name(
+std::string generate_verilog_undriven_local_wire_name(
   const ModuleManager& module_manager, const ModuleId& parent,
   const ModuleId& child, const size_t& instance_id,
   const ModulePortId& child_port_id) {
@@ -47,98 +48,6 @@ static std::string generate_verilog_undriven_local_wire_name(
   return wire_name;
 }
 
-/********************************************************************
- * Name a net for a local wire for a verilog module
- * 1. If this is a local wire, name it after the
- *<src_module_name>_<instance_id>_<src_port_name>
- * 2. If this is not a local wire, name it after the port name of parent module
- *
- * In addition, it will assign the pin index as well
- *
- * Restriction: this function requires each net has single driver
- * which is definitely always true in circuits.
- *******************************************************************/
-static BasicPort generate_verilog_port_for_module_net(
-  const ModuleManager& module_manager, const ModuleId& module_id,
-  const ModuleNetId& module_net) {
-  BasicPort port_to_return;
-  /* Check all the sink modules of the net,
-   * if we have a source module is the current module, this is not local wire
-   */
-  for (ModuleNetSrcId src_id :
-       module_manager.module_net_sources(module_id, module_net)) {
-    if (module_id ==
-        module_manager.net_source_modules(module_id, module_net)[src_id]) {
-      /* Here, this is not a local wire, return the port name of the src_port */
-      ModulePortId net_src_port =
-        module_manager.net_source_ports(module_id, module_net)[src_id];
-      size_t src_pin_index =
-        module_manager.net_source_pins(module_id, module_net)[src_id];
-      port_to_return.set(module_manager.module_port(module_id, net_src_port));
-      port_to_return.set_width(src_pin_index, src_pin_index);
-      port_to_return.set_origin_port_width(
-        module_manager.module_port(module_id, net_src_port).get_width());
-      return port_to_return;
-    }
-  }
-
-  /* Check all the sink modules of the net */
-  for (ModuleNetSinkId sink_id :
-       module_manager.module_net_sinks(module_id, module_net)) {
-    if (module_id ==
-        module_manager.net_sink_modules(module_id, module_net)[sink_id]) {
-      /* Here, this is not a local wire, return the port name of the sink_port
-       */
-      ModulePortId net_sink_port =
-        module_manager.net_sink_ports(module_id, module_net)[sink_id];
-      size_t sink_pin_index =
-        module_manager.net_sink_pins(module_id, module_net)[sink_id];
-      port_to_return.set(module_manager.module_port(module_id, net_sink_port));
-      port_to_return.set_width(sink_pin_index, sink_pin_index);
-      port_to_return.set_origin_port_width(
-        module_manager.module_port(module_id, net_sink_port).get_width());
-      return port_to_return;
-    }
-  }
-
-  /* Reach here, this is a local wire */
-  std::string net_name;
-
-  /* Each net must only one 1 source */
-  VTR_ASSERT(1 ==
-             module_manager.net_source_modules(module_id, module_net).size());
-
-  /* Get the source module */
-  ModuleId net_src_module =
-    module_manager.net_source_modules(module_id, module_net)[ModuleNetSrcId(0)];
-  /* Get the instance id */
-  size_t net_src_instance = module_manager.net_source_instances(
-    module_id, module_net)[ModuleNetSrcId(0)];
-  /* Get the port id */
-  ModulePortId net_src_port =
-    module_manager.net_source_ports(module_id, module_net)[ModuleNetSrcId(0)];
-  /* Get the pin id */
-  size_t net_src_pin =
-    module_manager.net_source_pins(module_id, module_net)[ModuleNetSrcId(0)];
-
-  /* Load user-defined name if we have it */
-  if (false == module_manager.net_name(module_id, module_net).empty()) {
-    net_name = module_manager.net_name(module_id, module_net);
-  } else {
-    net_name = module_manager.module_name(net_src_module);
-    net_name +=
-      std::string("_") + std::to_string(net_src_instance) + std::string("_");
-    net_name +=
-      module_manager.module_port(net_src_module, net_src_port).get_name();
-  }
-
-  port_to_return.set_name(net_name);
-  port_to_return.set_width(net_src_pin, net_src_pin);
-  port_to_return.set_origin_port_width(
-    module_manager.module_port(net_src_module, net_src_port).get_width());
-  return port_to_return;
-}
-
 /********************************************************************
  * Find all the nets that are going to be local wires
  * And organize it in a vector of ports
@@ -147,11 +56,12 @@ static BasicPort generate_verilog_port_for_module_net(
  *******************************************************************/
 static std::map<std::string, std::vector<BasicPort>>
 find_verilog_module_local_wires(const ModuleManager& module_manager,
-                                const ModuleId& module_id) {
+                                const ModuleEmissionPlan& emission_plan) {
+  ModuleId module_id = emission_plan.module();
   std::map<std::string, std::vector<BasicPort>> local_wires;
 
   /* Local wires come from the child modules */
-  for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
+  for (const ModuleNetId& module_net : emission_plan.local_wire_nets()) {
     /* Bypass dangling nets:
      * Xifan Tang: I comment this part because it will shadow our problems in
      * creating module graph Indeed this make a robust and a smooth Verilog
@@ -159,20 +69,15 @@ find_verilog_module_local_wires(const ModuleManager& module_manager,
      * !!!
      */
     /*
-    if ( (0 == module_manager.net_source_modules(module_id, module_net).size())
-      && (0 == module_manager.net_source_modules(module_id, module_net).size())
+    if ( (0 == module_manager.net_source_terminals(module_id, module_net).size())
+      && (0 == module_manager.net_sink_terminals(module_id, module_net).size())
     ) { continue;
     }
     */
 
-    /* We only care local wires */
-    if (false ==
-        module_net_is_local_wire(module_manager, module_id, module_net)) {
-      continue;
-    }
     /* Find the name for this local wire */
-    BasicPort local_wire_candidate = generate_verilog_port_for_module_net(
-      module_manager, module_id, module_net);
+    const BasicPort& local_wire_candidate =
+      emission_plan.net_port(module_net);
     /* Cache the net name, try to find it in the cache.
      * If you can find one, it means this port may be mergeable, try to do
      * merging. If merge fail, add to the local wire list If you cannot find
@@ -206,40 +111,19 @@ find_verilog_module_local_wires(const ModuleManager& module_manager,
     }
   }
 
-  /* Local wires could also happen for undriven ports of child module */
-  for (const ModuleId& child : module_manager.child_modules(module_id)) {
-    for (size_t instance :
-         module_manager.child_module_instances(module_id, child)) {
-      for (const ModulePortId& child_port_id :
-           module_manager.module_ports(child)) {
-        BasicPort child_port = module_manager.module_port(child, child_port_id);
-        std::vector<size_t> undriven_pins;
-        for (size_t child_pin : child_port.pins()) {
-          /* Find the net linked to the pin */
-          ModuleNetId net = module_manager.module_instance_port_net(
-            module_id, child, instance, child_port_id, child_pin);
-          /* We only care undriven ports */
-          if (ModuleNetId::INVALID() == net) {
-            undriven_pins.push_back(child_pin);
-          }
-        }
-        if (true == undriven_pins.empty()) {
-          continue;
-        }
-        /* Reach here, we need a local wire, we will create a port only for the
-         * undriven pins of the port! */
-        BasicPort instance_port;
-        instance_port.set_name(generate_verilog_undriven_local_wire_name(
-          module_manager, module_id, child, instance, child_port_id));
-        /* We give the same port name as child module, this case happens to
-         * global ports */
-        instance_port.set_width(
-          *std::min_element(undriven_pins.begin(), undriven_pins.end()),
-          *std::max_element(undriven_pins.begin(), undriven_pins.end()));
-
-        local_wires[instance_port.get_name()].push_back(instance_port);
-      }
-    }
+  /* Local wires could also happen for undriven ports of child module,
+   * we will create a port only for the undriven pins of the port! */
+  for (const ModuleInstanceUndrivenPort& undriven_port :
+       emission_plan.undriven_instance_ports()) {
+    BasicPort instance_port;
+    instance_port.set_name(generate_verilog_undriven_local_wire_name(
+      module_manager, module_id, undriven_port.child_module,
+      undriven_port.instance_id, undriven_port.child_port));
+    /* We give the same port name as child module, this case happens to
+     * global ports */
+    instance_port.set_width(undriven_port.lsb, undriven_port.msb);
+
+    local_wires[instance_port.get_name()].push_back(instance_port);
   }
 
   return local_wires;
@@ -254,30 +138,21 @@ find_verilog_module_local_wires(const ModuleManager& module_manager,
  *******************************************************************/
 static void print_verilog_module_output_short_connection(
   std::fstream& fp, const ModuleManager& module_manager,
-  const ModuleId& module_id, const ModuleNetId& module_net) {
+  const ModuleEmissionPlan& emission_plan, const ModuleNetId& module_net) {
   /* Ensure a valid file stream */
   VTR_ASSERT(true == valid_file_stream(fp));
 
+  ModuleId module_id = emission_plan.module();
   bool first_port = true;
   BasicPort src_port;
 
   /* We have found a module input, now check all the sink modules of the net */
-  for (ModuleNetSinkId net_sink :
-       module_manager.module_net_sinks(module_id, module_net)) {
-    ModuleId sink_module =
-      module_manager.net_sink_modules(module_id, module_net)[net_sink];
-    if (module_id != sink_module) {
-      continue;
-    }
-
+  for (const ModuleNetTerminalPin& net_sink :
+       emission_plan.net_module_sinks(module_net)) {
     /* Find the sink port and pin information */
-    ModulePortId sink_port_id =
-      module_manager.net_sink_ports(module_id, module_net)[net_sink];
-    size_t sink_pin =
-      module_manager.net_sink_pins(module_id, module_net)[net_sink];
     BasicPort sink_port(
-      module_manager.module_port(module_id, sink_port_id).get_name(), sink_pin,
-      sink_pin);
+      module_manager.module_port(module_id, net_sink.port).get_name(),
+      net_sink.pin, net_sink.pin);
 
     /* For the first module output, this is the source port, we do nothing and
      * go to the next */
@@ -302,50 +177,32 @@ static void print_verilog_module_output_short_connection(
  *******************************************************************/
 static void print_verilog_module_local_short_connection(
   std::fstream& fp, const ModuleManager& module_manager,
-  const ModuleId& module_id, const ModuleNetId& module_net) {
+  const ModuleEmissionPlan& emission_plan, const ModuleNetId& module_net) {
   /* Ensure a valid file stream */
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  for (ModuleNetSrcId net_src :
-       module_manager.module_net_sources(module_id, module_net)) {
-    ModuleId src_module =
-      module_manager.net_source_modules(module_id, module_net)[net_src];
-    if (module_id != src_module) {
-      continue;
-    }
+  ModuleId module_id = emission_plan.module();
+  for (const ModuleNetTerminalPin& net_src :
+       emission_plan.net_module_sources(module_net)) {
     /* Find the source port and pin information */
     print_verilog_comment(
-      fp, std::string("----- Net source id " + std::to_string(size_t(net_src)) +
-                      " -----"));
-    ModulePortId src_port_id =
-      module_manager.net_source_ports(module_id, module_net)[net_src];
-    size_t src_pin =
-      module_manager.net_source_pins(module_id, module_net)[net_src];
+      fp, std::string("----- Net source id " +
+                      std::to_string(net_src.terminal_id) + " -----"));
     BasicPort src_port(
-      module_manager.module_port(module_id, src_port_id).get_name(), src_pin,
-      src_pin);
+      module_manager.module_port(module_id, net_src.port).get_name(),
+      net_src.pin, net_src.pin);
 
     /* We have found a module input, now check all the sink modules of the net
      */
-    for (ModuleNetSinkId net_sink :
-         module_manager.module_net_sinks(module_id, module_net)) {
-      ModuleId sink_module =
-        module_manager.net_sink_modules(module_id, module_net)[net_sink];
-      if (module_id != sink_module) {
-        continue;
-      }
-
+    for (const ModuleNetTerminalPin& net_sink :
+         emission_plan.net_module_sinks(module_net)) {
       /* Find the sink port and pin information */
       print_verilog_comment(
         fp, std::string("----- Net sink id " +
-                        std::to_string(size_t(net_sink)) + " -----"));
-      ModulePortId sink_port_id =
-        module_manager.net_sink_ports(module_id, module_net)[net_sink];
-      size_t sink_pin =
-        module_manager.net_sink_pins(module_id, module_net)[net_sink];
+                        std::to_string(net_sink.terminal_id) + " -----"));
       BasicPort sink_port(
-        module_manager.module_port(module_id, sink_port_id).get_name(),
-        sink_pin, sink_pin);
+        module_manager.module_port(module_id, net_sink.port).get_name(),
+        net_sink.pin, net_sink.pin);
 
       /* We need to print a wire connection here */
       print_verilog_wire_connection(fp, sink_port, src_port, false);
@@ -371,19 +228,15 @@ static void print_verilog_module_local_short_connection(
  *******************************************************************/
 static void print_verilog_module_local_short_connections(
   std::fstream& fp, const ModuleManager& module_manager,
-  const ModuleId& module_id) {
-  /* Local wires come from the child modules */
-  for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
-    /* We only care the nets that indicate short connections */
-    if (false == module_net_include_local_short_connection(
-                   module_manager, module_id, module_net)) {
-      continue;
-    }
+  const ModuleEmissionPlan& emission_plan) {
+  /* We only care the nets that indicate short connections */
+  for (const ModuleNetId& module_net :
+       emission_plan.local_short_connection_nets()) {
     print_verilog_comment(
       fp, std::string("----- Local connection due to Wire " +
                       std::to_string(size_t(module_net)) + " -----"));
-    print_verilog_module_local_short_connection(fp, module_manager, module_id,
-                                                module_net);
+    print_verilog_module_local_short_connection(fp, module_manager,
+                                                emission_plan, module_net);
   }
 }
 
@@ -405,16 +258,12 @@ static void print_verilog_module_local_short_connections(
  *******************************************************************/
 static void print_verilog_module_output_short_connections(
   std::fstream& fp, const ModuleManager& module_manager,
-  const ModuleId& module_id) {
-  /* Local wires come from the child modules */
-  for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
-    /* We only care the nets that indicate short connections */
-    if (false == module_net_include_output_short_connection(
-                   module_manager, module_id, module_net)) {
-      continue;
-    }
-    print_verilog_module_output_short_connection(fp, module_manager, module_id,
-                                                 module_net);
+  const ModuleEmissionPlan& emission_plan) {
+  /* We only care the nets that indicate short connections */
+  for (const ModuleNetId& module_net :
+       emission_plan.output_short_connection_nets()) {
+    print_verilog_module_output_short_connection(fp, module_manager,
+                                                 emission_plan, module_net);
   }
 }
 
@@ -435,15 +284,15 @@ static void print_verilog_module_output_short_connections(
  *    +-----------------------------+
  *
  *******************************************************************/
-static void write_verilog_instance_to_file(std::fstream& fp,
-                                           const ModuleManager& module_manager,
-                                           const ModuleId& parent_module,
-                                           const ModuleId& child_module,
-                                           const size_t& instance_id,
-                                           const bool& use_explicit_port_map) {
+static void write_verilog_instance_to_file(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleEmissionPlan& emission_plan, const ModuleId& child_module,
+  const size_t& instance_id, const bool& use_explicit_port_map) {
   /* Ensure a valid file stream */
   VTR_ASSERT(true == valid_file_stream(fp));
 
+  ModuleId parent_module = emission_plan.module();
+
   /* Print module name */
   fp << "\t" << module_manager.module_name(child_module) << " ";
   /* Print instance name:
@@ -455,10 +304,10 @@ static void write_verilog_instance_to_file(std::fstream& fp,
         .empty()) {
     fp << generate_instance_name(module_manager.module_name(child_module),
                                  instance_id)
-       << " (" << std::endl;
+       << " (" << '\n';
   } else {
     fp << module_manager.instance_name(parent_module, child_module, instance_id)
-       << " (" << std::endl;
+       << " (" << '\n';
   }
 
   /* Print each port with/without explicit port map */
@@ -476,6 +325,8 @@ static void write_verilog_instance_to_file(std::fstream& fp,
 
   /* Port sequence: global, inout, input, output and clock ports, */
   size_t port_cnt = 0;
+  /* Ports of the instance, reused by all the ports of the child module */
+  std::vector<BasicPort> instance_ports;
   for (const auto& kv : port_type2type_map) {
     for (const ModulePortId& child_port_id :
          module_manager.module_port_ids_by_type(child_module, kv.first)) {
@@ -483,7 +334,7 @@ static void write_verilog_instance_to_file(std::fstream& fp,
         module_manager.module_port(child_module, child_port_id);
       if (0 != port_cnt) {
         /* Do not dump a comma for the first port */
-        fp << "," << std::endl;
+        fp << "," << '\n';
       }
       /* Print port */
       fp << "\t\t";
@@ -493,12 +344,13 @@ static void write_verilog_instance_to_file(std::fstream& fp,
       }
 
       /* Create the port name and width to be used by the instance */
-      std::vector<BasicPort> instance_ports;
-      std::vector<bool> instance_ports_is_single_bit;
+      const std::vector<ModuleNetId>& port_nets =
+        emission_plan.instance_port_nets(child_module, instance_id,
+                                         child_port_id);
+      instance_ports.clear();
       for (size_t child_pin : child_port.pins()) {
         /* Find the net linked to the pin */
-        ModuleNetId net = module_manager.module_instance_port_net(
-          parent_module, child_module, instance_id, child_port_id, child_pin);
+        ModuleNetId net = port_nets[child_pin];
         BasicPort instance_port;
         if (ModuleNetId::INVALID() == net) {
           /* We give the same port name as child module, this case happens to
@@ -507,23 +359,16 @@ static void write_verilog_instance_to_file(std::fstream& fp,
             module_manager, parent_module, child_module, instance_id,
             child_port_id));
           instance_port.set_width(child_pin, child_pin);
-          instance_port.set_origin_port_width(
-            module_manager.module_port(child_module, child_port_id)
-              .get_width());
+          instance_port.set_origin_port_width(child_port.get_width());
         } else {
           /* Find the name for this child port */
-          instance_port = generate_verilog_port_for_module_net(
-            module_manager, parent_module, net);
+          instance_port = emission_plan.net_port(net);
         }
         /* Create the port information for the net */
         instance_ports.push_back(instance_port);
       }
-      /* Try to merge the ports */
-      std::vector<BasicPort> merged_ports =
-        combine_verilog_ports(instance_ports);
-
-      /* Print a verilog port by combining the instance ports */
-      fp << generate_verilog_ports(merged_ports);
+      /* Print a verilog port by merging the instance ports */
+      print_verilog_ports(fp, instance_ports);
 
       /* if explicit port map is required, output the pair of branket */
       if (true == use_explicit_port_map) {
@@ -534,35 +379,30 @@ static void write_verilog_instance_to_file(std::fstream& fp,
   }
 
   /* Print an end to the instance */
-  fp << ");" << std::endl;
+  fp << ");" << '\n';
 }
 
 /********************************************************************
- * Write a Verilog module to a file
- * This is a key function, maybe most frequently called in our Verilog writer
- * Note that file stream must be valid
+ * Write the head of a Verilog module to a file, including the module
+ * declaration, the local wires and the short connections
  *******************************************************************/
-void write_verilog_module_to_file(
+void write_verilog_module_head_to_file(
   std::fstream& fp, const ModuleManager& module_manager,
-  const ModuleId& module_id, const bool& use_explicit_port_map,
+  const ModuleEmissionPlan& emission_plan,
   const e_verilog_default_net_type& default_net_type) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  /* Ensure we have a valid module_id */
-  VTR_ASSERT(module_manager.valid_module_id(module_id));
-
   /* Print module declaration */
-  print_verilog_module_declaration(fp, module_manager, module_id,
+  print_verilog_module_declaration(fp, module_manager, emission_plan.module(),
                                    default_net_type);
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Print internal wires */
   std::map<std::string, std::vector<BasicPort>> local_wires =
-    find_verilog_module_local_wires(module_manager, module_id);
-  for (std::pair<std::string, std::vector<BasicPort>> port_group :
-       local_wires) {
+    find_verilog_module_local_wires(module_manager, emission_plan);
+  for (const auto& port_group : local_wires) {
     for (const BasicPort& local_wire : port_group.second) {
       /* When default net type is wire, we can skip single-bit wires whose LSB
        * is 0 */
@@ -570,51 +410,157 @@ void write_verilog_module_to_file(
           (1 == local_wire.get_width()) && (0 == local_wire.get_lsb())) {
         continue;
       }
-      fp << generate_verilog_port(VERILOG_PORT_WIRE, local_wire) << ";"
-         << std::endl;
+      print_verilog_port(fp, VERILOG_PORT_WIRE, local_wire);
+      fp << ";" << '\n';
     }
   }
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Print local connection (from module inputs to output! */
   print_verilog_comment(
     fp, std::string("----- BEGIN Local short connections -----"));
-  print_verilog_module_local_short_connections(fp, module_manager, module_id);
+  print_verilog_module_local_short_connections(fp, module_manager,
+                                               emission_plan);
   print_verilog_comment(fp,
                         std::string("----- END Local short connections -----"));
 
   print_verilog_comment(
     fp, std::string("----- BEGIN Local output short connections -----"));
-  print_verilog_module_output_short_connections(fp, module_manager, module_id);
+  print_verilog_module_output_short_connections(fp, module_manager,
+                                                emission_plan);
 
   print_verilog_comment(
     fp, std::string("----- END Local output short connections -----"));
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
+}
 
-  /* Print instances */
-  for (ModuleId child_module : module_manager.child_modules(module_id)) {
-    for (size_t instance :
-         module_manager.child_module_instances(module_id, child_module)) {
-      /* Print an instance */
-      write_verilog_instance_to_file(fp, module_manager, module_id,
-                                     child_module, instance,
-                                     use_explicit_port_map);
-      /* Print an empty line as splitter */
-      fp << std::endl;
-    }
+/********************************************************************
+ * Write a range [first, last) of the child instances of a Verilog module
+ * to a file. The range is indexed in the child instances of the plan
+ *******************************************************************/
+void write_verilog_module_instances_to_file(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleEmissionPlan& emission_plan, const size_t& first,
+  const size_t& last, const bool& use_explicit_port_map) {
+  VTR_ASSERT(true == valid_file_stream(fp));
+  VTR_ASSERT(first <= last);
+  VTR_ASSERT(last <= emission_plan.child_instances().size());
+
+  for (size_t iinst = first; iinst < last; ++iinst) {
+    const std::pair<ModuleId, size_t>& child_instance =
+      emission_plan.child_instances()[iinst];
+    /* Print an instance */
+    write_verilog_instance_to_file(fp, module_manager, emission_plan,
+                                   child_instance.first, child_instance.second,
+                                   use_explicit_port_map);
+    /* Print an empty line as splitter */
+    fp << '\n';
   }
+}
+
+/********************************************************************
+ * Write the end of a Verilog module to a file
+ *******************************************************************/
+void write_verilog_module_tail_to_file(std::fstream& fp,
+                                       const ModuleManager& module_manager,
+                                       const ModuleId& module_id) {
+  VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Print an end for the module */
   print_verilog_module_end(fp, module_manager.module_name(module_id));
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
+
+  /* Print an empty line as splitter */
+  fp << '\n';
+}
+
+/********************************************************************
+ * Write a Verilog module to a file
+ * This is a key function, maybe most frequently called in our Verilog writer
+ * Note that file stream must be valid
+ *******************************************************************/
+void write_verilog_module_to_file(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleId& module_id, const bool& use_explicit_port_map,
+  const e_verilog_default_net_type& default_net_type) {
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  /* Ensure we have a valid module_id */
+  VTR_ASSERT(module_manager.valid_module_id(module_id));
+
+  /* Visit the nets and instances of the module only once */
+  ModuleEmissionPlan emission_plan(module_manager, module_id);
+
+  write_verilog_module_head_to_file(fp, module_manager, emission_plan,
+                                    default_net_type);
+
+  /* Print instances */
+  write_verilog_module_instances_to_file(
+    fp, module_manager, emission_plan, 0,
+    emission_plan.child_instances().size(), use_explicit_port_map);
+
+  write_verilog_module_tail_to_file(fp, module_manager, module_id);
+}
+
+/********************************************************************
+ * Write a Verilog module as a thin wrapper of another module, which has
+ * the same ports. The wrapper contains only an instance of the core
+ * module, whose ports are connected to the ports of the wrapper by names
+ *
+ *    wrapper module
+ *    +-----------------------------+
+ *    |       +--------------+      |
+ *  a-|------>|      core    |----->|-b
+ *    |       |    module    |      |
+ *    |       +--------------+      |
+ *    +-----------------------------+
+ *
+ *******************************************************************/
+void write_verilog_module_wrapper_to_file(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleId& module_id, const ModuleId& core_module,
+  const e_verilog_default_net_type& default_net_type) {
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  /* Ensure we have valid modules with the same ports */
+  VTR_ASSERT(module_manager.valid_module_id(module_id));
+  VTR_ASSERT(module_manager.valid_module_id(core_module));
+  VTR_ASSERT(modules_have_same_ports(module_manager, module_id, core_module));
+
+  /* Print module declaration */
+  print_verilog_module_declaration(fp, module_manager, module_id,
+                                   default_net_type);
+
+  /* Print an empty line as splitter */
+  fp << '\n';
+
+  /* Print the instance of the core module */
+  fp << "\t" << module_manager.module_name(core_module) << " ";
+  fp << generate_instance_name(module_manager.module_name(core_module), 0)
+     << " (" << '\n';
+  size_t port_cnt = 0;
+  for (const ModulePortId& port_id : module_manager.module_ports(core_module)) {
+    BasicPort port = module_manager.module_port(core_module, port_id);
+    if (0 != port_cnt) {
+      /* Do not dump a comma for the first port */
+      fp << "," << '\n';
+    }
+    fp << "\t\t." << port.get_name() << "(";
+    print_verilog_port(fp, VERILOG_PORT_CONKT, port);
+    fp << ")";
+    port_cnt++;
+  }
+  fp << ");" << '\n';
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
+
+  write_verilog_module_tail_to_file(fp, module_manager, module_id);
 }
 
 } /* end namespace openfpga */
@@ -5,7 +5,9 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <fstream>
+#include <string>
 
+#include "module_emission_plan.h"
 #include "module_manager.h"
 #include "verilog_port_types.h"
 
@@ -16,11 +18,35 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+std::string generate_verilog_undriven_local_wire_name(
+  const ModuleManager& module_manager, const ModuleId& parent,
+  const ModuleId& child, const size_t& instance_id,
+  const ModulePortId& child_port_id);
+
+void write_verilog_module_head_to_file(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleEmissionPlan& emission_plan,
+  const e_verilog_default_net_type& default_net_type);
+
+void write_verilog_module_instances_to_file(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleEmissionPlan& emission_plan, const size_t& first,
+  const size_t& last, const bool& use_explicit_port_map);
+
+void write_verilog_module_tail_to_file(std::fstream& fp,
+                                       const ModuleManager& module_manager,
+                                       const ModuleId& module_id);
+
 void write_verilog_module_to_file(
   std::fstream& fp, const ModuleManager& module_manager,
   const ModuleId& module_id, const bool& use_explicit_port_map,
   const e_verilog_default_net_type& default_net_type);
 
+void write_verilog_module_wrapper_to_file(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleId& module_id, const ModuleId& core_module,
+  const e_verilog_default_net_type& default_net_type);
+
 } /* end namespace openfpga */
 
 #endif
@@ -25,6 +25,7 @@
 #include "module_manager.h"
 #include "mux_graph.h"
 #include "mux_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "verilog_constants.h"
@@ -54,14 +55,14 @@ static void generate_verilog_cmos_mux_branch_body_behavioral(
   BasicPort outreg_port("out_reg", mux_graph.num_outputs());
   /* Print the port */
   fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, outreg_port) << ";"
-     << std::endl;
+     << '\n';
 
   /* Generate the case-switch table */
   fp << "\talways @(" << generate_verilog_port(VERILOG_PORT_CONKT, input_port)
      << ", " << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << ")"
-     << std::endl;
+     << '\n';
   fp << "\tcase (" << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << ")"
-     << std::endl;
+     << '\n';
 
   /* Output the netlist following the connections in mux_graph */
   /* Iterate over the inputs */
@@ -100,7 +101,7 @@ static void generate_verilog_cmos_mux_branch_body_behavioral(
       fp << case_code << ": "
          << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << " <= ";
       fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_input_port) << ";"
-         << std::endl;
+         << '\n';
     }
   }
 
@@ -108,16 +109,15 @@ static void generate_verilog_cmos_mux_branch_body_behavioral(
   std::string default_case(mux_graph.num_outputs(), 'z');
   fp << "\t\tdefault: "
      << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << " <= ";
-  fp << mux_graph.num_outputs() << "'b" << default_case << ";" << std::endl;
+  fp << mux_graph.num_outputs() << "'b" << default_case << ";" << '\n';
 
   /* End the case */
-  fp << "\tendcase" << std::endl;
+  fp << "\tendcase" << '\n';
 
   /* Wire registers to output ports */
   fp << "\tassign " << generate_verilog_port(VERILOG_PORT_CONKT, output_port)
      << " = ";
-  fp << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << ";"
-     << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << ";" << '\n';
 }
 
 /*********************************************************************
@@ -447,7 +447,7 @@ static void generate_verilog_rram_mux_branch_body_behavioral(
   BasicPort outreg_port("out_reg", mux_graph.num_inputs());
   /* Print the port */
   fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, outreg_port) << ";"
-     << std::endl;
+     << '\n';
 
   /* Print the internal logics */
   fp << "\t"
@@ -456,7 +456,7 @@ static void generate_verilog_rram_mux_branch_body_behavioral(
   fp << ", ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, wl_port);
   fp << ")";
-  fp << " begin" << std::endl;
+  fp << " begin" << '\n';
 
   /* Only when the last bit of wl is enabled,
    * the propagating path can be changed
@@ -509,7 +509,7 @@ static void generate_verilog_rram_mux_branch_body_behavioral(
   }
 
   /* Finish the if clause */
-  fp << ") begin" << std::endl;
+  fp << ") begin" << '\n';
 
   for (const auto& mux_input : mux_graph.inputs()) {
     /* First if clause need tabs */
@@ -522,25 +522,25 @@ static void generate_verilog_rram_mux_branch_body_behavioral(
                            size_t(mux_graph.input_id(mux_input)),
                            size_t(mux_graph.input_id(mux_input)));
     fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_blb_port);
-    fp << ") begin" << std::endl;
+    fp << ") begin" << '\n';
     fp << "\t\t\t\t"
        << "assign ";
     fp << outreg_port.get_name();
-    fp << " = " << size_t(mux_graph.input_id(mux_input)) << ";" << std::endl;
+    fp << " = " << size_t(mux_graph.input_id(mux_input)) << ";" << '\n';
     fp << "\t\t\t"
        << "end else ";
   }
-  fp << "begin" << std::endl;
+  fp << "begin" << '\n';
   fp << "\t\t\t\t"
      << "assign ";
   fp << outreg_port.get_name();
-  fp << " = 0;" << std::endl;
+  fp << " = 0;" << '\n';
   fp << "\t\t\t"
-     << "end" << std::endl;
+     << "end" << '\n';
   fp << "\t\t"
-     << "end" << std::endl;
+     << "end" << '\n';
   fp << "\t"
-     << "end" << std::endl;
+     << "end" << '\n';
 
   fp << "\t"
      << "assign ";
@@ -548,7 +548,7 @@ static void generate_verilog_rram_mux_branch_body_behavioral(
   fp << " = ";
   fp << input_port.get_name() << "[";
   fp << outreg_port.get_name();
-  fp << "];" << std::endl;
+  fp << "];" << '\n';
 }
 
 /*********************************************************************
@@ -680,7 +680,7 @@ static void generate_verilog_mux_branch_module(
             circuit_lib.dump_explicit_port_map(mux_model),
           default_net_type);
         /* Add an empty line as a splitter */
-        fp << std::endl;
+        fp << '\n';
       } else {
         /* Behavioral verilog requires customized generation */
         print_verilog_cmos_mux_branch_module_behavioral(
@@ -778,7 +778,7 @@ static void generate_verilog_cmos_mux_module_input_buffers(
       print_verilog_comment(
         fp, std::string("---- END short-wire a multiplexing structure input to "
                         "a constant value -----"));
-      fp << std::endl;
+      fp << '\n';
       continue; /* Finish here */
     }
 
@@ -795,7 +795,7 @@ static void generate_verilog_cmos_mux_module_input_buffers(
       print_verilog_comment(
         fp, std::string("---- END short-wire a multiplexing structure input to "
                         "MUX module input -----"));
-      fp << std::endl;
+      fp << '\n';
       continue; /* Finish here */
     }
 
@@ -817,7 +817,7 @@ static void generate_verilog_cmos_mux_module_input_buffers(
     print_verilog_comment(
       fp,
       std::string("---- END Instanciation of an input buffer module -----"));
-    fp << std::endl;
+    fp << '\n';
   }
 }
 
@@ -894,7 +894,7 @@ static void generate_verilog_cmos_mux_module_output_buffers(
         print_verilog_comment(
           fp, std::string("---- END short-wire a multiplexing structure output "
                           "to MUX module output -----"));
-        fp << std::endl;
+        fp << '\n';
         continue; /* Finish here */
       }
 
@@ -917,7 +917,7 @@ static void generate_verilog_cmos_mux_module_output_buffers(
       print_verilog_comment(
         fp,
         std::string("---- END Instanciation of an output buffer module -----"));
-      fp << std::endl;
+      fp << '\n';
     }
   }
 }
@@ -964,7 +964,7 @@ static void generate_verilog_rram_mux_module_multiplexing_structure(
     BasicPort internal_wire_port(generate_mux_node_name(level, false),
                                  mux_graph.num_nodes_at_level(level));
     fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, internal_wire_port)
-       << ";" << std::endl;
+       << ";" << '\n';
     /* Identify if an intermediate buffer is needed */
     if (false == inter_buffer_location_map[level]) {
       continue;
@@ -973,12 +973,12 @@ static void generate_verilog_rram_mux_module_multiplexing_structure(
                                           mux_graph.num_nodes_at_level(level));
     fp << "\t"
        << generate_verilog_port(VERILOG_PORT_WIRE, internal_wire_buffered_port)
-       << std::endl;
+       << '\n';
   }
   print_verilog_comment(
     fp,
     std::string("---- END Internal wires of a RRAM-based MUX module -----"));
-  fp << std::endl;
+  fp << '\n';
 
   /* Iterate over all the internal nodes and output nodes in the mux graph */
   for (const auto& node : mux_graph.non_input_nodes()) {
@@ -1057,8 +1057,7 @@ static void generate_verilog_rram_mux_module_multiplexing_structure(
       /* Print a local wire for the merged ports */
       fp << "\t"
          << generate_verilog_local_wire(instance_input_port,
-                                        branch_node_input_ports)
-         << std::endl;
+                                        branch_node_input_ports) << '\n';
     } else {
       /* Safety check */
       VTR_ASSERT(1 == combine_verilog_ports(branch_node_input_ports).size());
@@ -1122,8 +1121,7 @@ static void generate_verilog_rram_mux_module_multiplexing_structure(
       /* Print a local wire for the merged ports */
       fp << "\t"
          << generate_verilog_local_wire(instance_blb_port,
-                                        branch_node_blb_ports)
-         << std::endl;
+                                        branch_node_blb_ports) << '\n';
     } else {
       /* Safety check */
       VTR_ASSERT(1 == combine_verilog_ports(branch_node_blb_ports).size());
@@ -1172,7 +1170,7 @@ static void generate_verilog_rram_mux_module_multiplexing_structure(
       /* Print a local wire for the merged ports */
       fp << "\t"
          << generate_verilog_local_wire(instance_wl_port, branch_node_wl_ports)
-         << std::endl;
+         << '\n';
     } else {
       /* Safety check */
       VTR_ASSERT(1 == combine_verilog_ports(branch_node_wl_ports).size());
@@ -1200,7 +1198,7 @@ static void generate_verilog_rram_mux_module_multiplexing_structure(
     print_verilog_comment(
       fp, std::string(
             "---- END Instanciation of a branch RRAM-based MUX module -----"));
-    fp << std::endl;
+    fp << '\n';
 
     if (false == inter_buffer_location_map[output_node_level]) {
       continue; /* No need for intermediate buffers */
@@ -1231,13 +1229,13 @@ static void generate_verilog_rram_mux_module_multiplexing_structure(
     print_verilog_comment(
       fp, std::string(
             "---- END Instanciation of an intermediate buffer module -----"));
-    fp << std::endl;
+    fp << '\n';
   }
 
   print_verilog_comment(
     fp,
     std::string("---- END Internal Logic of a RRAM-based MUX module -----"));
-  fp << std::endl;
+  fp << '\n';
 }
 
 /*********************************************************************
@@ -1423,7 +1421,7 @@ static void generate_verilog_mux_module(
            circuit_lib.pass_gate_logic_model(mux_model))),
         default_net_type);
       /* Add an empty line as a splitter */
-      fp << std::endl;
+      fp << '\n';
       break;
     }
     case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -1454,8 +1452,9 @@ static void print_verilog_submodule_mux_primitives(
   std::string verilog_fpath(submodule_dir + verilog_fname);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc,
+          options.incremental());
 
   check_file_stream(verilog_fpath.c_str(), fp);
 
@@ -1475,13 +1474,12 @@ static void print_verilog_submodule_mux_primitives(
   /* Generate basis sub-circuit for unique branches shared by the multiplexers
    */
   for (auto mux : mux_lib.muxes()) {
-    const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
     CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux);
-    /* Create a mux graph for the branch circuit */
-    std::vector<MuxGraph> branch_mux_graphs =
-      mux_graph.build_mux_branch_graphs();
+    /* Get the mux graphs of the branch circuits */
+    const std::vector<MuxGraph>& branch_mux_graphs =
+      mux_lib.mux_branch_graphs(mux);
     /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes */
-    for (auto branch_mux_graph : branch_mux_graphs) {
+    for (const MuxGraph& branch_mux_graph : branch_mux_graphs) {
       generate_verilog_mux_branch_module(
         module_manager, circuit_lib, fp, mux_circuit_model, branch_mux_graph,
         options.explicit_port_mapping(), options.default_net_type(),
@@ -1501,6 +1499,7 @@ static void print_verilog_submodule_mux_primitives(
   }
   VTR_ASSERT(nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  netlist_manager.set_netlist_changed(nlist_id, fp.file_changed());
 
   VTR_LOG("Done\n");
 }
@@ -1519,8 +1518,9 @@ static void print_verilog_submodule_mux_top_modules(
   std::string verilog_fpath(submodule_dir + verilog_fname);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc,
+          options.incremental());
 
   check_file_stream(verilog_fpath.c_str(), fp);
 
@@ -1553,6 +1553,7 @@ static void print_verilog_submodule_mux_top_modules(
   }
   VTR_ASSERT(nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  netlist_manager.set_netlist_changed(nlist_id, fp.file_changed());
 
   VTR_LOG("Done\n");
 }
@@ -2,6 +2,7 @@
  * This file includes functions that are used to generate
  * a Verilog module of a pre-configured FPGA fabric
  *******************************************************************/
+#include <algorithm>
 #include <fstream>
 
 /* Headers from vtrutil library */
@@ -11,12 +12,13 @@
 #include "vtr_time.h"
 
 /* Headers from openfpgautil library */
-#include "bitstream_manager_utils.h"
 #include "openfpga_atom_netlist_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "openfpga_port.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "verilog_constants.h"
 #include "verilog_preconfig_top_module.h"
 #include "verilog_testbench_utils.h"
@@ -40,7 +42,7 @@ static void print_verilog_preconfig_top_module_ports(
   /* Module declaration */
   fp << "module " << circuit_name
      << std::string(FORMAL_VERIFICATION_TOP_MODULE_POSTFIX);
-  fp << " (" << std::endl;
+  fp << " (" << '\n';
 
   /* Port type-to-type mapping */
   std::map<AtomBlockType, enum e_dump_verilog_port_type> port_type2type_map;
@@ -114,7 +116,7 @@ static void print_verilog_preconfig_top_module_ports(
     BasicPort module_port = port_list[iport];
     AtomBlockType port_type = port_types[iport];
     if (0 < port_counter) {
-      fp << "," << std::endl;
+      fp << "," << '\n';
     }
 
     fp << generate_verilog_port(port_type2type_map[port_type], module_port,
@@ -124,10 +126,10 @@ static void print_verilog_preconfig_top_module_ports(
     port_counter++;
   }
 
-  fp << ");" << std::endl;
+  fp << ");" << '\n';
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -153,11 +155,10 @@ static void print_verilog_preconfig_top_module_internal_wires(
     module_port.set_name(
       module_port.get_name() +
       std::string(FORMAL_VERIFICATION_TOP_MODULE_PORT_POSTFIX));
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";"
-       << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << '\n';
   }
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -295,7 +296,7 @@ static int print_verilog_preconfig_top_module_connect_global_ports(
     fp, std::string("----- End Connect Global ports of FPGA top module -----"));
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 
   return CMD_EXEC_SUCCESS;
 }
@@ -316,31 +317,16 @@ static void print_verilog_preconfig_top_module_force_bitstream(
     fp, std::string(
           "----- Begin assign bitstream to configuration memories -----"));
 
-  fp << "initial begin" << std::endl;
+  fp << "initial begin" << '\n';
 
   for (const ConfigBlockId &config_block_id : bitstream_manager.blocks()) {
     /* We only cares blocks with configuration bits */
     if (0 == bitstream_manager.block_bits(config_block_id).size()) {
       continue;
     }
-    /* Build the hierarchical path of the configuration bit in modules */
-    std::vector<ConfigBlockId> block_hierarchy =
-      find_bitstream_manager_block_hierarchy(bitstream_manager,
-                                             config_block_id);
-    /* Drop the first block, which is the top module, it should be replaced by
-     * the instance name here */
-    /* Ensure that this is the module we want to drop! */
-    VTR_ASSERT(0 ==
-               module_manager.module_name(top_module)
-                 .compare(bitstream_manager.block_name(block_hierarchy[0])));
-    block_hierarchy.erase(block_hierarchy.begin());
-    /* Build the full hierarchy path */
-    std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-    for (const ConfigBlockId &temp_block : block_hierarchy) {
-      bit_hierarchy_path += std::string(".");
-      bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-    }
-    bit_hierarchy_path += std::string(".");
+    std::string bit_hierarchy_path = find_fpga_instance_config_block_path(
+      module_manager, top_module, bitstream_manager, config_block_id,
+      std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME));
 
     /* Find the bit index in the parent block */
     BasicPort config_data_port(
@@ -374,7 +360,7 @@ static void print_verilog_preconfig_top_module_force_bitstream(
     }
   }
 
-  fp << "end" << std::endl;
+  fp << "end" << '\n';
 
   print_verilog_comment(
     fp,
@@ -396,31 +382,16 @@ static void print_verilog_preconfig_top_module_deposit_bitstream(
     fp, std::string(
           "----- Begin deposit bitstream to configuration memories -----"));
 
-  fp << "initial begin" << std::endl;
+  fp << "initial begin" << '\n';
 
   for (const ConfigBlockId &config_block_id : bitstream_manager.blocks()) {
     /* We only cares blocks with configuration bits */
     if (0 == bitstream_manager.block_bits(config_block_id).size()) {
       continue;
     }
-    /* Build the hierarchical path of the configuration bit in modules */
-    std::vector<ConfigBlockId> block_hierarchy =
-      find_bitstream_manager_block_hierarchy(bitstream_manager,
-                                             config_block_id);
-    /* Drop the first block, which is the top module, it should be replaced by
-     * the instance name here */
-    /* Ensure that this is the module we want to drop! */
-    VTR_ASSERT(0 ==
-               module_manager.module_name(top_module)
-                 .compare(bitstream_manager.block_name(block_hierarchy[0])));
-    block_hierarchy.erase(block_hierarchy.begin());
-    /* Build the full hierarchy path */
-    std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-    for (const ConfigBlockId &temp_block : block_hierarchy) {
-      bit_hierarchy_path += std::string(".");
-      bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-    }
-    bit_hierarchy_path += std::string(".");
+    std::string bit_hierarchy_path = find_fpga_instance_config_block_path(
+      module_manager, top_module, bitstream_manager, config_block_id,
+      std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME));
 
     /* Find the bit index in the parent block */
     BasicPort config_data_port(
@@ -456,7 +427,7 @@ static void print_verilog_preconfig_top_module_deposit_bitstream(
                                                config_datab_values);
   }
 
-  fp << "end" << std::endl;
+  fp << "end" << '\n';
 
   print_verilog_comment(
     fp,
@@ -473,7 +444,9 @@ static void print_verilog_preconfig_top_module_load_bitstream(
   std::fstream &fp, const ModuleManager &module_manager,
   const ModuleId &top_module, const CircuitLibrary &circuit_lib,
   const CircuitModelId &mem_model, const BitstreamManager &bitstream_manager,
-  const e_embedded_bitstream_hdl_type &embedded_bitstream_hdl_type) {
+  const e_embedded_bitstream_hdl_type &embedded_bitstream_hdl_type,
+  const bool &bitstream_memory_image, const std::string &image_fname,
+  const std::string &image_include_path) {
   /* Skip the datab port if there is only 1 output port in memory model
    * Currently, it assumes that the data output port is always defined while
    * datab is optional If we see only 1 port, we assume datab is not defined by
@@ -491,8 +464,18 @@ static void print_verilog_preconfig_top_module_load_bitstream(
     fp,
     std::string("----- Begin load bitstream to configuration memories -----"));
 
-  /* Use assign syntax for Icarus simulator */
-  if (EMBEDDED_BITSTREAM_HDL_IVERILOG == embedded_bitstream_hdl_type) {
+  /* Load the bit values from a memory image, if specified */
+  if ((true == bitstream_memory_image) &&
+      ((EMBEDDED_BITSTREAM_HDL_IVERILOG == embedded_bitstream_hdl_type) ||
+       (EMBEDDED_BITSTREAM_HDL_MODELSIM == embedded_bitstream_hdl_type))) {
+    print_verilog_testbench_memory_image_bitstream(
+      fp, module_manager, top_module, bitstream_manager,
+      std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME),
+      std::string(FORMAL_VERIFICATION_TOP_MODULE_BITSTREAM_MEM_NAME),
+      std::string(), output_datab_bits, embedded_bitstream_hdl_type,
+      image_fname, image_include_path);
+    /* Use assign syntax for Icarus simulator */
+  } else if (EMBEDDED_BITSTREAM_HDL_IVERILOG == embedded_bitstream_hdl_type) {
     print_verilog_preconfig_top_module_force_bitstream(
       fp, module_manager, top_module, bitstream_manager, output_datab_bits);
     /* Use deposit syntax for other simulators */
@@ -547,6 +530,7 @@ int print_verilog_preconfig_top_module(
   const BusGroup &bus_group, const IoLocationMap &io_location_map,
   const VprNetlistAnnotation &netlist_annotation,
   const std::string &circuit_name, const std::string &verilog_fname,
+  const std::string &bitstream_image_fname,
   const VerilogTestbenchOption &options) {
   std::string timer_message =
     std::string(
@@ -557,9 +541,10 @@ int print_verilog_preconfig_top_module(
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
@@ -620,15 +605,21 @@ int print_verilog_preconfig_top_module(
 
   /* Assign FPGA internal SRAM/Memory ports to bitstream values, only output
    * when needed */
+  std::string bitstream_image_include_path = bitstream_image_fname;
+  if (true == options.use_relative_path()) {
+    bitstream_image_include_path = find_path_file_name(bitstream_image_fname);
+  }
   print_verilog_preconfig_top_module_load_bitstream(
     fp, module_manager, top_module, circuit_lib, sram_model, bitstream_manager,
-    options.embedded_bitstream_hdl_type());
+    options.embedded_bitstream_hdl_type(), options.bitstream_memory_image(),
+    bitstream_image_fname, bitstream_image_include_path);
 
   /* Add signal initialization:
    * Bypass writing codes to files due to the autogenerated codes are very
    * large.
    */
-  if (true == options.include_signal_init()) {
+  if ((true == options.include_signal_init()) &&
+      (false == options.signal_init_per_module())) {
     print_verilog_testbench_signal_initialization(
       fp, std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME), circuit_lib,
       module_manager, top_module, false);
@@ -639,6 +630,15 @@ int print_verilog_preconfig_top_module(
     fp, std::string(circuit_name) +
           std::string(FORMAL_VERIFICATION_TOP_MODULE_POSTFIX));
 
+  /* Add signal initialization per primitive module, which is bound to the
+   * primitive modules outside the wrapper module
+   */
+  if ((true == options.include_signal_init()) &&
+      (true == options.signal_init_per_module())) {
+    print_verilog_testbench_signal_initialization_per_module(
+      fp, circuit_lib, module_manager, false);
+  }
+
   /* Close the file stream */
   fp.close();
 
@@ -35,6 +35,7 @@ int print_verilog_preconfig_top_module(
   const BusGroup& bus_group, const IoLocationMap& io_location_map,
   const VprNetlistAnnotation& netlist_annotation,
   const std::string& circuit_name, const std::string& verilog_fname,
+  const std::string& bitstream_image_fname,
   const VerilogTestbenchOption& options);
 
 } /* end namespace openfpga */
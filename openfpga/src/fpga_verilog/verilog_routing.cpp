@@ -2,14 +2,21 @@
  * This file includes functions that are used for
  * Verilog generation of FPGA routing architecture (global routing)
  *********************************************************************/
+#include <functional>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 
+/* Headers from openfpga library */
+#include "module_manager_utils.h"
+
 /* Include FPGA-Verilog header files*/
 #include "openfpga_naming.h"
 #include "verilog_constants.h"
@@ -78,7 +85,7 @@ namespace openfpga {
 static void print_verilog_routing_connection_box_unique_module(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
   const std::string& subckt_dir, const std::string& subckt_dir_name,
-  const RRGSB& rr_gsb, const t_rr_type& cb_type,
+  const RRGSB& rr_gsb, const t_rr_type& cb_type, const ModuleId& core_module,
   const FabricVerilogOption& options) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type),
@@ -88,8 +95,9 @@ static void print_verilog_routing_connection_box_unique_module(
   std::string verilog_fpath(subckt_dir + verilog_fname);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc,
+          options.incremental());
 
   check_file_stream(verilog_fpath.c_str(), fp);
 
@@ -106,13 +114,19 @@ static void print_verilog_routing_connection_box_unique_module(
     generate_connection_block_module_name(cb_type, gsb_coordinate));
   VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
 
-  /* Write the verilog module */
-  write_verilog_module_to_file(fp, module_manager, cb_module,
-                               options.explicit_port_mapping(),
-                               options.default_net_type());
+  /* Write the verilog module, or a wrapper when it mirrors a core module */
+  if (true == module_manager.valid_module_id(core_module)) {
+    write_verilog_module_wrapper_to_file(fp, module_manager, cb_module,
+                                         core_module,
+                                         options.default_net_type());
+  } else {
+    write_verilog_module_to_file(fp, module_manager, cb_module,
+                                 options.explicit_port_mapping(),
+                                 options.default_net_type());
+  }
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Close file handler */
   fp.close();
@@ -127,6 +141,7 @@ static void print_verilog_routing_connection_box_unique_module(
   VTR_ASSERT(nlist_id);
   netlist_manager.set_netlist_type(nlist_id,
                                    NetlistManager::ROUTING_MODULE_NETLIST);
+  netlist_manager.set_netlist_changed(nlist_id, fp.file_changed());
 }
 
 /*********************************************************************
@@ -192,7 +207,8 @@ static void print_verilog_routing_connection_box_unique_module(
 static void print_verilog_routing_switch_box_unique_module(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
   const std::string& subckt_dir, const std::string& subckt_dir_name,
-  const RRGSB& rr_gsb, const FabricVerilogOption& options) {
+  const RRGSB& rr_gsb, const ModuleId& core_module,
+  const FabricVerilogOption& options) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
   std::string verilog_fname(generate_routing_block_netlist_name(
@@ -201,8 +217,9 @@ static void print_verilog_routing_switch_box_unique_module(
   std::string verilog_fpath(subckt_dir + verilog_fname);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc,
+          options.incremental());
 
   check_file_stream(verilog_fpath.c_str(), fp);
 
@@ -219,10 +236,16 @@ static void print_verilog_routing_switch_box_unique_module(
     generate_switch_block_module_name(gsb_coordinate));
   VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
 
-  /* Write the verilog module */
-  write_verilog_module_to_file(fp, module_manager, sb_module,
-                               options.explicit_port_mapping(),
-                               options.default_net_type());
+  /* Write the verilog module, or a wrapper when it mirrors a core module */
+  if (true == module_manager.valid_module_id(core_module)) {
+    write_verilog_module_wrapper_to_file(fp, module_manager, sb_module,
+                                         core_module,
+                                         options.default_net_type());
+  } else {
+    write_verilog_module_to_file(fp, module_manager, sb_module,
+                                 options.explicit_port_mapping(),
+                                 options.default_net_type());
+  }
 
   /* Close file handler */
   fp.close();
@@ -237,17 +260,77 @@ static void print_verilog_routing_switch_box_unique_module(
   VTR_ASSERT(nlist_id);
   netlist_manager.set_netlist_type(nlist_id,
                                    NetlistManager::ROUTING_MODULE_NETLIST);
+  netlist_manager.set_netlist_changed(nlist_id, fp.file_changed());
 }
 
 /********************************************************************
- * Iterate over all the connection blocks in a device
- * and build a module for each of them
+ * Find the core module of a module in a flatten routing hierarchy,
+ * i.e., the module of the unique mirror of the routing block.
+ * Return an invalid id if the module is a unique mirror by itself,
+ * or if its ports differ from the unique mirror, so that its body
+ * should be written
  *******************************************************************/
-static void print_verilog_flatten_connection_block_modules(
-  NetlistManager& netlist_manager, const ModuleManager& module_manager,
-  const DeviceRRGSB& device_rr_gsb, const std::string& subckt_dir,
-  const std::string& subckt_dir_name, const t_rr_type& cb_type,
+static ModuleId find_verilog_flatten_routing_core_module(
+  const ModuleManager& module_manager, const std::string& module_name,
+  const std::string& core_module_name) {
+  if (module_name == core_module_name) {
+    return ModuleId::INVALID();
+  }
+  ModuleId module = module_manager.find_module(module_name);
+  ModuleId core_module = module_manager.find_module(core_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(module));
+  VTR_ASSERT(true == module_manager.valid_module_id(core_module));
+  if (false == modules_have_same_ports(module_manager, module, core_module)) {
+    return ModuleId::INVALID();
+  }
+  return core_module;
+}
+
+static ModuleId find_verilog_flatten_switch_block_core_module(
+  const ModuleManager& module_manager, const DeviceRRGSB& device_rr_gsb,
+  const vtr::Point<size_t>& gsb_coord, const FabricVerilogOption& options) {
+  if (false == options.dedup_routing_modules()) {
+    return ModuleId::INVALID();
+  }
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coord);
+  const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(gsb_coord);
+  return find_verilog_flatten_routing_core_module(
+    module_manager,
+    generate_switch_block_module_name(
+      vtr::Point<size_t>(rr_gsb.get_sb_x(), rr_gsb.get_sb_y())),
+    generate_switch_block_module_name(vtr::Point<size_t>(
+      unique_mirror.get_sb_x(), unique_mirror.get_sb_y())));
+}
+
+static ModuleId find_verilog_flatten_connection_block_core_module(
+  const ModuleManager& module_manager, const DeviceRRGSB& device_rr_gsb,
+  const vtr::Point<size_t>& gsb_coord, const t_rr_type& cb_type,
   const FabricVerilogOption& options) {
+  if (false == options.dedup_routing_modules()) {
+    return ModuleId::INVALID();
+  }
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coord);
+  const RRGSB& unique_mirror =
+    device_rr_gsb.get_cb_unique_module(cb_type, gsb_coord);
+  return find_verilog_flatten_routing_core_module(
+    module_manager,
+    generate_connection_block_module_name(
+      cb_type, vtr::Point<size_t>(rr_gsb.get_cb_x(cb_type),
+                                  rr_gsb.get_cb_y(cb_type))),
+    generate_connection_block_module_name(
+      cb_type, vtr::Point<size_t>(unique_mirror.get_cb_x(cb_type),
+                                  unique_mirror.get_cb_y(cb_type))));
+}
+
+/********************************************************************
+ * Iterate over all the connection blocks in a device
+ * and add a task to build a module for each of them
+ *******************************************************************/
+static void add_verilog_flatten_connection_block_module_tasks(
+  std::vector<std::function<void(NetlistManager&)>>& print_tasks,
+  const ModuleManager& module_manager, const DeviceRRGSB& device_rr_gsb,
+  const std::string& subckt_dir, const std::string& subckt_dir_name,
+  const t_rr_type& cb_type, const FabricVerilogOption& options) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
@@ -261,9 +344,16 @@ static void print_verilog_flatten_connection_block_modules(
       if (true != rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
-      print_verilog_routing_connection_box_unique_module(
-        netlist_manager, module_manager, subckt_dir, subckt_dir_name, rr_gsb,
-        cb_type, options);
+      const RRGSB* task_rr_gsb = &rr_gsb;
+      ModuleId core_module = find_verilog_flatten_connection_block_core_module(
+        module_manager, device_rr_gsb, vtr::Point<size_t>(ix, iy), cb_type,
+        options);
+      print_tasks.push_back([&, task_rr_gsb, cb_type, core_module](
+                              NetlistManager& task_netlist_manager) {
+        print_verilog_routing_connection_box_unique_module(
+          task_netlist_manager, module_manager, subckt_dir, subckt_dir_name,
+          *task_rr_gsb, cb_type, core_module, options);
+      });
     }
   }
 }
@@ -273,9 +363,14 @@ static void print_verilog_flatten_connection_block_modules(
  * Print all the modules for global routing architecture of a FPGA fabric
  * in Verilog format  in a flatten way:
  *   Each connection block and switch block will be generated as a unique module
+ *   When routing modules are deduplicated, only the module of each unique
+ *   mirror is written with its body, while the other modules are written as
+ *   thin wrappers of the module of their unique mirrors
  * Covering:
  * 1. Connection blocks
  * 2. Switch blocks
+ * Each module is written to a separated file, so that the files are
+ * written with the number of threads in the options
  *******************************************************************/
 void print_verilog_flatten_routing_modules(NetlistManager& netlist_manager,
                                            const ModuleManager& module_manager,
@@ -283,9 +378,8 @@ void print_verilog_flatten_routing_modules(NetlistManager& netlist_manager,
                                            const std::string& subckt_dir,
                                            const std::string& subckt_dir_name,
                                            const FabricVerilogOption& options) {
-  /* Create a vector to contain all the Verilog netlist names that have been
-   * generated in this function */
-  std::vector<std::string> netlist_names;
+  /* Create a list of tasks, each of which writes a Verilog netlist */
+  std::vector<std::function<void(NetlistManager&)>> print_tasks;
 
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
@@ -296,19 +390,27 @@ void print_verilog_flatten_routing_modules(NetlistManager& netlist_manager,
       if (true != rr_gsb.is_sb_exist()) {
         continue;
       }
-      print_verilog_routing_switch_box_unique_module(
-        netlist_manager, module_manager, subckt_dir, subckt_dir_name, rr_gsb,
-        options);
+      const RRGSB* task_rr_gsb = &rr_gsb;
+      ModuleId core_module = find_verilog_flatten_switch_block_core_module(
+        module_manager, device_rr_gsb, vtr::Point<size_t>(ix, iy), options);
+      print_tasks.push_back(
+        [&, task_rr_gsb, core_module](NetlistManager& task_netlist_manager) {
+          print_verilog_routing_switch_box_unique_module(
+            task_netlist_manager, module_manager, subckt_dir, subckt_dir_name,
+            *task_rr_gsb, core_module, options);
+        });
     }
   }
 
-  print_verilog_flatten_connection_block_modules(
-    netlist_manager, module_manager, device_rr_gsb, subckt_dir, subckt_dir_name,
+  add_verilog_flatten_connection_block_module_tasks(
+    print_tasks, module_manager, device_rr_gsb, subckt_dir, subckt_dir_name,
     CHANX, options);
 
-  print_verilog_flatten_connection_block_modules(
-    netlist_manager, module_manager, device_rr_gsb, subckt_dir, subckt_dir_name,
+  add_verilog_flatten_connection_block_module_tasks(
+    print_tasks, module_manager, device_rr_gsb, subckt_dir, subckt_dir_name,
     CHANY, options);
+
+  print_verilog_netlists(netlist_manager, print_tasks, options.num_threads());
 }
 
 /********************************************************************
@@ -320,6 +422,8 @@ void print_verilog_flatten_routing_modules(NetlistManager& netlist_manager,
  *
  * Note: this function SHOULD be called only when
  * the option compact_routing_hierarchy is turned on!!!
+ * Each module is written to a separated file, so that the files are
+ * written with the number of threads in the options
  *******************************************************************/
 void print_verilog_unique_routing_modules(NetlistManager& netlist_manager,
                                           const ModuleManager& module_manager,
@@ -327,37 +431,37 @@ void print_verilog_unique_routing_modules(NetlistManager& netlist_manager,
                                           const std::string& subckt_dir,
                                           const std::string& subckt_dir_name,
                                           const FabricVerilogOption& options) {
-  /* Create a vector to contain all the Verilog netlist names that have been
-   * generated in this function */
-  std::vector<std::string> netlist_names;
+  /* Create a list of tasks, each of which writes a Verilog netlist */
+  std::vector<std::function<void(NetlistManager&)>> print_tasks;
 
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    print_verilog_routing_switch_box_unique_module(
-      netlist_manager, module_manager, subckt_dir, subckt_dir_name,
-      unique_mirror, options);
+    const RRGSB* unique_mirror = &device_rr_gsb.get_sb_unique_module(isb);
+    print_tasks.push_back(
+      [&, unique_mirror](NetlistManager& task_netlist_manager) {
+        print_verilog_routing_switch_box_unique_module(
+          task_netlist_manager, module_manager, subckt_dir, subckt_dir_name,
+          *unique_mirror, ModuleId::INVALID(), options);
+      });
   }
 
-  /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX);
-       ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    print_verilog_routing_connection_box_unique_module(
-      netlist_manager, module_manager, subckt_dir, subckt_dir_name,
-      unique_mirror, CHANX, options);
+  /* Build unique X-direction and Y-direction connection block modules */
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(cb_type);
+         ++icb) {
+      const RRGSB* unique_mirror =
+        &device_rr_gsb.get_cb_unique_module(cb_type, icb);
+
+      print_tasks.push_back(
+        [&, unique_mirror, cb_type](NetlistManager& task_netlist_manager) {
+          print_verilog_routing_connection_box_unique_module(
+            task_netlist_manager, module_manager, subckt_dir, subckt_dir_name,
+            *unique_mirror, cb_type, ModuleId::INVALID(), options);
+        });
+    }
   }
 
-  /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY);
-       ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    print_verilog_routing_connection_box_unique_module(
-      netlist_manager, module_manager, subckt_dir, subckt_dir_name,
-      unique_mirror, CHANY, options);
-  }
+  print_verilog_netlists(netlist_manager, print_tasks, options.num_threads());
 
   VTR_LOG("\n");
 }
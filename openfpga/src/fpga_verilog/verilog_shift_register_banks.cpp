@@ -15,6 +15,7 @@
 #include "module_manager.h"
 #include "mux_graph.h"
 #include "mux_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "verilog_constants.h"
@@ -39,8 +40,9 @@ void print_verilog_submodule_shift_register_banks(
   std::string verilog_fpath(submodule_dir + verilog_fname);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc,
+          options.incremental());
 
   check_file_stream(verilog_fpath.c_str(), fp);
 
@@ -61,7 +63,7 @@ void print_verilog_submodule_shift_register_banks(
                                  options.default_net_type());
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << '\n';
   }
 
   for (const ModuleId& sr_module : blwl_sr_banks.wl_bank_unique_modules()) {
@@ -72,7 +74,7 @@ void print_verilog_submodule_shift_register_banks(
                                  options.default_net_type());
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << '\n';
   }
 
   /* Close the file stream */
@@ -87,6 +89,7 @@ void print_verilog_submodule_shift_register_banks(
   }
   VTR_ASSERT(nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  netlist_manager.set_netlist_changed(nlist_id, fp.file_changed());
 
   VTR_LOG("Done\n");
 }
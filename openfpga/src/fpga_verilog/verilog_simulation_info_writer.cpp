@@ -5,6 +5,8 @@
 #include <cmath>
 #include <ctime>
 #include <map>
+#include <string>
+#include <vector>
 #define MINI_CASE_SENSITIVE
 #include "ini.h"
 
@@ -17,6 +19,7 @@
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_scale.h"
+#include "openfpga_trace.h"
 #include "simulation_utils.h"
 #include "verilog_constants.h"
 #include "verilog_simulation_info_writer.h"
@@ -34,8 +37,10 @@ void print_verilog_simulation_info(
   const AtomContext& atom_ctx, const PlacementContext& place_ctx,
   const IoLocationMap& io_location_map, const ModuleManager& module_manager,
   const e_config_protocol_type& config_protocol_type,
-  const size_t& num_program_clock_cycles, const int& num_operating_clock_cycles,
-  const float& prog_clock_freq, const float& op_clock_freq) {
+  const size_t& num_program_clock_cycles,
+  const std::vector<size_t>& num_region_program_clock_cycles,
+  const int& num_operating_clock_cycles, const float& prog_clock_freq,
+  const float& op_clock_freq) {
   std::string timer_message =
     std::string("Write exchangeable file containing simulation information '") +
     ini_fname + std::string("'");
@@ -47,6 +52,7 @@ void print_verilog_simulation_info(
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Use default name if user does not provide one */
   VTR_ASSERT(true != ini_fname.empty());
@@ -93,6 +99,21 @@ void print_verilog_simulation_info(
     std::string(TOP_VERILOG_TESTBENCH_INCLUDE_NETLIST_FILE_NAME_POSTFIX));
   ini["SIMULATION_DECK"]["CONFIG_PROTOCOL"] =
     std::string(CONFIG_PROTOCOL_TYPE_STRING[config_protocol_type]);
+  ini["SIMULATION_DECK"]["NUM_PROG_CLOCK_CYCLES"] =
+    std::to_string(num_program_clock_cycles);
+
+  /* Regions which are programmed concurrently, as a comma-separated list of
+   * the programming clock cycles of each region */
+  if (false == num_region_program_clock_cycles.empty()) {
+    std::string region_cycles;
+    for (const size_t& cycles : num_region_program_clock_cycles) {
+      if (false == region_cycles.empty()) {
+        region_cycles += ",";
+      }
+      region_cycles += std::to_string(cycles);
+    }
+    ini["SIMULATION_DECK"]["REGION_PROG_CLOCK_CYCLES"] = region_cycles;
+  }
 
   /* Information required by UVM */
   if (CONFIG_MEM_FRAME_BASED == config_protocol_type) {
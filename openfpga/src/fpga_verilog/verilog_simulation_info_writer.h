@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <string>
+#include <vector>
 
 #include "config_protocol.h"
 #include "io_location_map.h"
@@ -25,8 +26,10 @@ void print_verilog_simulation_info(
   const AtomContext& atom_ctx, const PlacementContext& place_ctx,
   const IoLocationMap& io_location_map, const ModuleManager& module_manager,
   const e_config_protocol_type& config_protocol_type,
-  const size_t& num_program_clock_cycles, const int& num_operating_clock_cycles,
-  const float& prog_clock_freq, const float& op_clock_freq);
+  const size_t& num_program_clock_cycles,
+  const std::vector<size_t>& num_region_program_clock_cycles,
+  const int& num_operating_clock_cycles, const float& prog_clock_freq,
+  const float& op_clock_freq);
 
 } /* end namespace openfpga */
 
@@ -3,6 +3,9 @@
  * and print them to files
  ********************************************************************/
 
+#include <functional>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "verilog_submodule.h"
 
@@ -31,6 +34,11 @@ namespace openfpga {
  * 4. Wires
  * 5. Configuration memory blocks
  * 6. Verilog template
+ *
+ * The netlists are written by groups of writers, which run concurrently
+ * with the number of threads in the options. The writer of routing
+ * multiplexers may add modules to the module manager, so that it runs
+ * alone between the groups
  ********************************************************************/
 void print_verilog_submodule(
   ModuleManager& module_manager, NetlistManager& netlist_manager,
@@ -38,52 +46,77 @@ void print_verilog_submodule(
   const DecoderLibrary& decoder_lib, const CircuitLibrary& circuit_lib,
   const std::string& submodule_dir, const std::string& submodule_dir_name,
   const FabricVerilogOption& fpga_verilog_opts) {
-  print_verilog_submodule_essentials(
-    const_cast<const ModuleManager&>(module_manager), netlist_manager,
-    submodule_dir, submodule_dir_name, circuit_lib, fpga_verilog_opts);
+  const ModuleManager& const_module_manager =
+    const_cast<const ModuleManager&>(module_manager);
+
+  std::vector<std::function<void(NetlistManager&)>> print_tasks;
+  print_tasks.push_back([&](NetlistManager& task_netlist_manager) {
+    print_verilog_submodule_essentials(const_module_manager,
+                                       task_netlist_manager, submodule_dir,
+                                       submodule_dir_name, circuit_lib,
+                                       fpga_verilog_opts);
+  });
 
   /* Decoders for architecture */
-  print_verilog_submodule_arch_decoders(
-    const_cast<const ModuleManager&>(module_manager), netlist_manager,
-    decoder_lib, submodule_dir, submodule_dir_name, fpga_verilog_opts);
+  print_tasks.push_back([&](NetlistManager& task_netlist_manager) {
+    print_verilog_submodule_arch_decoders(
+      const_module_manager, task_netlist_manager, decoder_lib, submodule_dir,
+      submodule_dir_name, fpga_verilog_opts);
+  });
 
   /* Routing multiplexers */
   /* NOTE: local decoders generation must go before the MUX generation!!!
    *       because local decoders modules will be instanciated in the MUX
    * modules
    */
-  print_verilog_submodule_mux_local_decoders(
-    const_cast<const ModuleManager&>(module_manager), netlist_manager, mux_lib,
-    circuit_lib, submodule_dir, submodule_dir_name, fpga_verilog_opts);
+  print_tasks.push_back([&](NetlistManager& task_netlist_manager) {
+    print_verilog_submodule_mux_local_decoders(
+      const_module_manager, task_netlist_manager, mux_lib, circuit_lib,
+      submodule_dir, submodule_dir_name, fpga_verilog_opts);
+  });
+  print_verilog_netlists(netlist_manager, print_tasks,
+                         fpga_verilog_opts.num_threads());
+  print_tasks.clear();
+
   print_verilog_submodule_muxes(module_manager, netlist_manager, mux_lib,
                                 circuit_lib, submodule_dir, submodule_dir_name,
                                 fpga_verilog_opts);
 
   /* LUTes */
-  print_verilog_submodule_luts(const_cast<const ModuleManager&>(module_manager),
-                               netlist_manager, circuit_lib, submodule_dir,
-                               submodule_dir_name, fpga_verilog_opts);
+  print_tasks.push_back([&](NetlistManager& task_netlist_manager) {
+    print_verilog_submodule_luts(const_module_manager, task_netlist_manager,
+                                 circuit_lib, submodule_dir,
+                                 submodule_dir_name, fpga_verilog_opts);
+  });
 
   /* Hard wires */
-  print_verilog_submodule_wires(
-    const_cast<const ModuleManager&>(module_manager), netlist_manager,
-    circuit_lib, submodule_dir, submodule_dir_name, fpga_verilog_opts);
+  print_tasks.push_back([&](NetlistManager& task_netlist_manager) {
+    print_verilog_submodule_wires(const_module_manager, task_netlist_manager,
+                                  circuit_lib, submodule_dir,
+                                  submodule_dir_name, fpga_verilog_opts);
+  });
 
   /* Memories */
-  print_verilog_submodule_memories(
-    const_cast<const ModuleManager&>(module_manager), netlist_manager, mux_lib,
-    circuit_lib, submodule_dir, submodule_dir_name, fpga_verilog_opts);
+  print_tasks.push_back([&](NetlistManager& task_netlist_manager) {
+    print_verilog_submodule_memories(const_module_manager,
+                                     task_netlist_manager, mux_lib,
+                                     circuit_lib, submodule_dir,
+                                     submodule_dir_name, fpga_verilog_opts);
+  });
 
   /* Shift register banks */
-  print_verilog_submodule_shift_register_banks(
-    const_cast<const ModuleManager&>(module_manager), netlist_manager,
-    blwl_sr_banks, submodule_dir, submodule_dir_name, fpga_verilog_opts);
+  print_tasks.push_back([&](NetlistManager& task_netlist_manager) {
+    print_verilog_submodule_shift_register_banks(
+      const_module_manager, task_netlist_manager, blwl_sr_banks,
+      submodule_dir, submodule_dir_name, fpga_verilog_opts);
+  });
+  print_verilog_netlists(netlist_manager, print_tasks,
+                         fpga_verilog_opts.num_threads());
 
   /* Dump template for all the modules */
   if (true == fpga_verilog_opts.print_user_defined_template()) {
-    print_verilog_submodule_templates(
-      const_cast<const ModuleManager&>(module_manager), circuit_lib,
-      submodule_dir, fpga_verilog_opts);
+    print_verilog_submodule_templates(const_module_manager, circuit_lib,
+                                      submodule_dir, fpga_verilog_opts);
   }
 }
 
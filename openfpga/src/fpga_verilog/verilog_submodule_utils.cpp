@@ -12,6 +12,7 @@
 #include "vtr_log.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_port.h"
 
@@ -55,11 +56,11 @@ void print_verilog_submodule_timing(std::fstream& fp,
   /* Ensure a valid file handler*/
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << std::endl;
-  fp << "`ifdef " << VERILOG_TIMING_PREPROC_FLAG << std::endl;
+  fp << '\n';
+  fp << "`ifdef " << VERILOG_TIMING_PREPROC_FLAG << '\n';
   print_verilog_comment(
     fp, std::string("------ BEGIN Pin-to-pin Timing constraints -----"));
-  fp << "\tspecify" << std::endl;
+  fp << "\tspecify" << '\n';
 
   /* Read out pin-to-pin delays by finding out all the edges belonging to a
    * circuit model */
@@ -92,13 +93,13 @@ void print_verilog_submodule_timing(std::fstream& fp,
        << circuit_lib.timing_edge_delay(timing_edge, CIRCUIT_MODEL_DELAY_FALL) /
             VERILOG_SIM_TIMESCALE
        << ")";
-    fp << ";" << std::endl;
+    fp << ";" << '\n';
   }
 
-  fp << "\tendspecify" << std::endl;
+  fp << "\tendspecify" << '\n';
   print_verilog_comment(
     fp, std::string("------ END Pin-to-pin Timing constraints -----"));
-  fp << "`endif" << std::endl;
+  fp << "`endif" << '\n';
 }
 
 /*********************************************************************
@@ -168,7 +169,7 @@ static void print_one_verilog_template_module(
     fp, std::string("----- Internal logic should start here -----"));
 
   /* Add some empty lines as placeholders for the internal logic*/
-  fp << std::endl << std::endl;
+  fp << '\n' << '\n';
 
   print_verilog_comment(
     fp, std::string("----- Internal logic should end here -----"));
@@ -177,7 +178,7 @@ static void print_one_verilog_template_module(
   print_verilog_module_end(fp, module_name);
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /*********************************************************************
@@ -195,7 +196,7 @@ void print_verilog_submodule_templates(const ModuleManager& module_manager,
                             USER_DEFINED_TEMPLATE_VERILOG_FILE_NAME);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
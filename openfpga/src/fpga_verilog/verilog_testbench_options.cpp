@@ -22,8 +22,15 @@ VerilogTestbenchOption::VerilogTestbenchOption() {
   simulation_ini_path_.clear();
   explicit_port_mapping_ = false;
   include_signal_init_ = false;
+  signal_init_per_module_ = false;
+  hex_bitstream_ = false;
+  backdoor_configuration_ = false;
+  reuse_fabric_testbench_ = false;
+  vectorized_stimulus_ = false;
+  stimulus_vector_file_.clear();
   default_net_type_ = VERILOG_DEFAULT_NET_TYPE_NONE;
   embedded_bitstream_hdl_type_ = EMBEDDED_BITSTREAM_HDL_MODELSIM;
+  bitstream_memory_image_ = false;
   time_unit_ = 1E-3;
   time_stamp_ = true;
   use_relative_path_ = false;
@@ -77,6 +84,10 @@ bool VerilogTestbenchOption::include_signal_init() const {
   return include_signal_init_;
 }
 
+bool VerilogTestbenchOption::signal_init_per_module() const {
+  return signal_init_per_module_;
+}
+
 bool VerilogTestbenchOption::no_self_checking() const {
   return reference_benchmark_file_path_.empty();
 }
@@ -92,6 +103,28 @@ VerilogTestbenchOption::embedded_bitstream_hdl_type() const {
   return embedded_bitstream_hdl_type_;
 }
 
+bool VerilogTestbenchOption::bitstream_memory_image() const {
+  return bitstream_memory_image_;
+}
+
+bool VerilogTestbenchOption::hex_bitstream() const { return hex_bitstream_; }
+
+bool VerilogTestbenchOption::backdoor_configuration() const {
+  return backdoor_configuration_;
+}
+
+bool VerilogTestbenchOption::reuse_fabric_testbench() const {
+  return reuse_fabric_testbench_;
+}
+
+bool VerilogTestbenchOption::vectorized_stimulus() const {
+  return vectorized_stimulus_;
+}
+
+std::string VerilogTestbenchOption::stimulus_vector_file() const {
+  return stimulus_vector_file_;
+}
+
 bool VerilogTestbenchOption::time_stamp() const { return time_stamp_; }
 
 bool VerilogTestbenchOption::use_relative_path() const {
@@ -165,6 +198,10 @@ void VerilogTestbenchOption::set_include_signal_init(const bool& enabled) {
   include_signal_init_ = enabled;
 }
 
+void VerilogTestbenchOption::set_signal_init_per_module(const bool& enabled) {
+  signal_init_per_module_ = enabled;
+}
+
 void VerilogTestbenchOption::set_default_net_type(
   const std::string& default_net_type) {
   /* Decode from net type string */;
@@ -210,6 +247,31 @@ void VerilogTestbenchOption::set_embedded_bitstream_hdl_type(
   }
 }
 
+void VerilogTestbenchOption::set_bitstream_memory_image(const bool& enabled) {
+  bitstream_memory_image_ = enabled;
+}
+
+void VerilogTestbenchOption::set_hex_bitstream(const bool& enabled) {
+  hex_bitstream_ = enabled;
+}
+
+void VerilogTestbenchOption::set_backdoor_configuration(const bool& enabled) {
+  backdoor_configuration_ = enabled;
+}
+
+void VerilogTestbenchOption::set_reuse_fabric_testbench(const bool& enabled) {
+  reuse_fabric_testbench_ = enabled;
+}
+
+void VerilogTestbenchOption::set_vectorized_stimulus(const bool& enabled) {
+  vectorized_stimulus_ = enabled;
+}
+
+void VerilogTestbenchOption::set_stimulus_vector_file(
+  const std::string& stimulus_vector_file) {
+  stimulus_vector_file_ = stimulus_vector_file;
+}
+
 void VerilogTestbenchOption::set_time_unit(const float& time_unit) {
   time_unit_ = time_unit;
 }
@@ -47,9 +47,16 @@ class VerilogTestbenchOption {
   std::string simulation_ini_path() const;
   bool explicit_port_mapping() const;
   bool include_signal_init() const;
+  bool signal_init_per_module() const;
   bool no_self_checking() const;
   e_verilog_default_net_type default_net_type() const;
   e_embedded_bitstream_hdl_type embedded_bitstream_hdl_type() const;
+  bool bitstream_memory_image() const;
+  bool hex_bitstream() const;
+  bool backdoor_configuration() const;
+  bool reuse_fabric_testbench() const;
+  bool vectorized_stimulus() const;
+  std::string stimulus_vector_file() const;
   float time_unit() const;
   bool time_stamp() const;
   bool use_relative_path() const;
@@ -83,10 +90,17 @@ class VerilogTestbenchOption {
   void set_print_simulation_ini(const std::string& simulation_ini_path);
   void set_explicit_port_mapping(const bool& enabled);
   void set_include_signal_init(const bool& enabled);
+  void set_signal_init_per_module(const bool& enabled);
   void set_default_net_type(const std::string& default_net_type);
   void set_time_unit(const float& time_unit);
   void set_embedded_bitstream_hdl_type(
     const std::string& embedded_bitstream_hdl_type);
+  void set_bitstream_memory_image(const bool& enabled);
+  void set_hex_bitstream(const bool& enabled);
+  void set_backdoor_configuration(const bool& enabled);
+  void set_reuse_fabric_testbench(const bool& enabled);
+  void set_vectorized_stimulus(const bool& enabled);
+  void set_stimulus_vector_file(const std::string& stimulus_vector_file);
   void set_time_stamp(const bool& enabled);
   void set_use_relative_path(const bool& enabled);
   void set_verbose_output(const bool& enabled);
@@ -103,8 +117,25 @@ class VerilogTestbenchOption {
   std::string simulation_ini_path_;
   bool explicit_port_mapping_;
   bool include_signal_init_;
+  /* Initialize the signals once per primitive module, using bind directives,
+   * rather than once per primitive instance */
+  bool signal_init_per_module_;
   e_verilog_default_net_type default_net_type_;
   e_embedded_bitstream_hdl_type embedded_bitstream_hdl_type_;
+  /* Load the embedded bitstream from a memory image file */
+  bool bitstream_memory_image_;
+  /* Load the bitstream file in hex format by '$readmemh' */
+  bool hex_bitstream_;
+  /* Impose the bitstream on the configuration memories of the full
+   * testbench in zero time, rather than through the configuration protocol */
+  bool backdoor_configuration_;
+  /* Share the fabric-invariant codes of full testbenches between designs
+   * through a netlist which is written only once */
+  bool reuse_fabric_testbench_;
+  /* Generate the random stimulus of all the inputs in packed vectors */
+  bool vectorized_stimulus_;
+  /* Apply the stimulus from precomputed vectors when the path is not empty */
+  std::string stimulus_vector_file_;
   float time_unit_;
   bool time_stamp_;
   bool use_relative_path_;
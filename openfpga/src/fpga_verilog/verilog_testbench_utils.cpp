@@ -13,9 +13,12 @@
 #include "vtr_assert.h"
 
 /* Headers from openfpgautil library */
+#include "bitstream_manager_utils.h"
+#include "build_io_mapping_info.h"
 #include "fabric_global_port_info_utils.h"
 #include "module_manager_utils.h"
 #include "openfpga_atom_netlist_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "openfpga_port.h"
@@ -66,7 +69,7 @@ void print_verilog_testbench_fpga_instance(std::fstream& fp,
                                 explicit_port_mapping);
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -85,7 +88,7 @@ void print_verilog_testbench_benchmark_instance(
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  fp << "\t" << module_name << " " << instance_name << "(" << std::endl;
+  fp << "\t" << module_name << " " << instance_name << "(" << '\n';
 
   /* Consider all the unique port names */
   std::vector<std::string> port_names;
@@ -141,7 +144,7 @@ void print_verilog_testbench_benchmark_instance(
   for (size_t iport = 0; iport < port_names.size(); ++iport) {
     /* The first port does not need a comma */
     if (0 < port_counter) {
-      fp << "," << std::endl;
+      fp << "," << '\n';
     }
 
     fp << "\t\t";
@@ -161,6 +164,11 @@ void print_verilog_testbench_benchmark_instance(
         if (!bus_group.is_big_endian(bus_id)) {
           std::reverse(bus_pins.begin(), bus_pins.end());
         }
+        /* For clock ports, skip postfix */
+        bool is_clock_port =
+          clock_port_names.end() != std::find(clock_port_names.begin(),
+                                              clock_port_names.end(),
+                                              port_names[iport]);
         for (const BusPinId& pin : bus_pins) {
           if (0 < pin_counter) {
             fp << ", ";
@@ -178,10 +186,7 @@ void print_verilog_testbench_benchmark_instance(
 
           fp << bus_group.pin_name(pin);
 
-          /* For clock ports, skip postfix */
-          if (clock_port_names.end() == std::find(clock_port_names.begin(),
-                                                  clock_port_names.end(),
-                                                  port_names[iport])) {
+          if (false == is_clock_port) {
             fp << input_port_postfix;
           }
 
@@ -249,7 +254,7 @@ void print_verilog_testbench_benchmark_instance(
     /* Update the counter */
     port_counter++;
   }
-  fp << "\n\t);" << std::endl;
+  fp << "\n\t);" << '\n';
 }
 
 /********************************************************************
@@ -297,13 +302,10 @@ void print_verilog_testbench_connect_fpga_ios(
       std::vector<bool>(module_io_port.get_width(), false);
   }
 
-  /* Type mapping between VPR block and Module port */
-  std::map<AtomBlockType, ModuleManager::e_module_port_type>
-    atom_block_type_to_module_port_type;
-  atom_block_type_to_module_port_type[AtomBlockType::INPAD] =
-    ModuleManager::MODULE_GPIN_PORT;
-  atom_block_type_to_module_port_type[AtomBlockType::OUTPAD] =
-    ModuleManager::MODULE_GPOUT_PORT;
+  /* Resolve the fabric I/O of each benchmark I/O */
+  vtr::vector<AtomBlockId, std::pair<ModulePortId, size_t>> mapped_pins =
+    find_fpga_io_mapped_module_pins(module_manager, top_module, atom_ctx,
+                                    place_ctx, io_location_map, 1);
 
   /* See if this I/O should be wired to a benchmark input/output */
   /* Add signals from blif benchmark and short-wire them to FPGA I/O PADs
@@ -319,58 +321,13 @@ void print_verilog_testbench_connect_fpga_ios(
       continue;
     }
 
-    /* If there is a GPIO port, use it directly
-     * Otherwise, should find a GPIN for INPAD
-     *         or should find a GPOUT for OUTPAD
-     */
-    std::pair<ModulePortId, size_t> mapped_module_io_info =
-      std::make_pair(ModulePortId::INVALID(), -1);
-    for (const ModulePortId& module_io_port_id : module_io_ports) {
-      const BasicPort& module_io_port =
-        module_manager.module_port(top_module, module_io_port_id);
-
-      /* Find the index of the mapped GPIO in top-level FPGA fabric */
-      size_t temp_io_index = io_location_map.io_index(
-        place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.x,
-        place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.y,
-        place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.sub_tile,
-        module_io_port.get_name());
-
-      /* Bypass invalid index (not mapped to this GPIO port) */
-      if (size_t(-1) == temp_io_index) {
-        continue;
-      }
-
-      /* If the port is an GPIO port, just use it */
-      if (ModuleManager::MODULE_GPIO_PORT ==
-          module_manager.port_type(top_module, module_io_port_id)) {
-        mapped_module_io_info =
-          std::make_pair(module_io_port_id, temp_io_index);
-        break;
-      }
-
-      /* If this is an INPAD, we can use an GPIN port (if available) */
-      if (atom_block_type_to_module_port_type[atom_ctx.nlist.block_type(
-            atom_blk)] ==
-          module_manager.port_type(top_module, module_io_port_id)) {
-        mapped_module_io_info =
-          std::make_pair(module_io_port_id, temp_io_index);
-        break;
-      }
-    }
-
-    /* We must find a valid one */
-    VTR_ASSERT(true == module_manager.valid_module_port_id(
-                         top_module, mapped_module_io_info.first));
-    VTR_ASSERT(size_t(-1) != mapped_module_io_info.second);
-
-    /* Ensure that IO index is in range */
+    const std::pair<ModulePortId, size_t>& mapped_module_io_info =
+      mapped_pins[atom_blk];
     BasicPort module_mapped_io_port =
       module_manager.module_port(top_module, mapped_module_io_info.first);
     size_t io_index = mapped_module_io_info.second;
 
     /* Set the port pin index */
-    VTR_ASSERT(io_index < module_mapped_io_port.get_width());
     module_mapped_io_port.set_name(module_mapped_io_port.get_name() +
                                    net_name_postfix);
     module_mapped_io_port.set_width(io_index, io_index);
@@ -442,7 +399,7 @@ void print_verilog_testbench_connect_fpga_ios(
     io_used[mapped_module_io_info.first][io_index] = true;
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << '\n';
   }
 
   /* Wire the unused iopads to a constant */
@@ -477,7 +434,7 @@ void print_verilog_testbench_connect_fpga_ios(
     }
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << '\n';
   }
 }
 
@@ -499,50 +456,50 @@ void print_verilog_timeout_and_vcd(
   print_verilog_comment(
     fp, std::string("----- Begin output waveform to VCD file-------"));
 
-  fp << "\tinitial begin" << std::endl;
-  fp << "\t\t$dumpfile(\"" << vcd_fname << "\");" << std::endl;
-  fp << "\t\t$dumpvars(1, " << module_name << ");" << std::endl;
-  fp << "\tend" << std::endl;
+  fp << "\tinitial begin" << '\n';
+  fp << "\t\t$dumpfile(\"" << vcd_fname << "\");" << '\n';
+  fp << "\t\t$dumpvars(1, " << module_name << ");" << '\n';
+  fp << "\tend" << '\n';
 
   print_verilog_comment(
     fp, std::string("----- END output waveform to VCD file -------"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 
   BasicPort sim_start_port(simulation_start_counter_name, 1);
 
-  fp << "initial begin" << std::endl;
+  fp << "initial begin" << '\n';
 
   if (!no_self_checking) {
     fp << "\t" << generate_verilog_port(VERILOG_PORT_CONKT, sim_start_port)
-       << " <= 1'b1;" << std::endl;
+       << " <= 1'b1;" << '\n';
   }
 
-  fp << "\t$timeformat(-9, 2, \"ns\", 20);" << std::endl;
-  fp << "\t$display(\"Simulation start\");" << std::endl;
+  fp << "\t$timeformat(-9, 2, \"ns\", 20);" << '\n';
+  fp << "\t$display(\"Simulation start\");" << '\n';
   print_verilog_comment(
     fp,
     std::string("----- Can be changed by the user for his/her need -------"));
-  fp << "\t#" << std::setprecision(10) << simulation_time << std::endl;
+  fp << "\t#" << std::setprecision(10) << simulation_time << '\n';
 
   if (!no_self_checking) {
-    fp << "\tif(" << error_counter_name << " == 0) begin" << std::endl;
-    fp << "\t\t$display(\"Simulation Succeed\");" << std::endl;
-    fp << "\tend else begin" << std::endl;
+    fp << "\tif(" << error_counter_name << " == 0) begin" << '\n';
+    fp << "\t\t$display(\"Simulation Succeed\");" << '\n';
+    fp << "\tend else begin" << '\n';
     fp << "\t\t$display(\"Simulation Failed with " << std::string("%d")
-       << " error(s)\", " << error_counter_name << ");" << std::endl;
-    fp << "\tend" << std::endl;
+       << " error(s)\", " << error_counter_name << ");" << '\n';
+    fp << "\tend" << '\n';
   } else {
     VTR_ASSERT_SAFE(no_self_checking);
-    fp << "\t$display(\"Simulation Succeed\");" << std::endl;
+    fp << "\t$display(\"Simulation Succeed\");" << '\n';
   }
 
-  fp << "\t$finish;" << std::endl;
-  fp << "end" << std::endl;
+  fp << "\t$finish;" << '\n';
+  fp << "end" << '\n';
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -597,8 +554,8 @@ void print_verilog_testbench_check(
   BasicPort sim_start_port(simulation_start_counter_name, 1);
 
   fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, sim_start_port) << ";"
-     << std::endl;
-  fp << std::endl;
+     << '\n';
+  fp << '\n';
 
   /* TODO: This is limitation when multiple clock signals exist
    * Ideally, all the input signals are generated by different clock edges,
@@ -609,19 +566,19 @@ void print_verilog_testbench_check(
 
   fp << "\talways@(negedge "
      << generate_verilog_port(VERILOG_PORT_CONKT, clock_ports[0]) << ") begin"
-     << std::endl;
+     << '\n';
   fp << "\t\tif (1'b1 == "
      << generate_verilog_port(VERILOG_PORT_CONKT, sim_start_port) << ") begin"
-     << std::endl;
+     << '\n';
   fp << "\t\t";
   print_verilog_register_connection(fp, sim_start_port, sim_start_port, true);
-  fp << "\t\tend else " << std::endl;
+  fp << "\t\tend else " << '\n';
   /* If there is a config done signal specified, consider it as a trigger on
    * checking */
   if (!config_done_name.empty()) {
     fp << "if (1'b1 == " << config_done_name << ") ";
   }
-  fp << "begin" << std::endl;
+  fp << "begin" << '\n';
 
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
     /* Bypass non-I/O atom blocks ! */
@@ -642,20 +599,20 @@ void print_verilog_testbench_check(
       fp << "\t\t\tif(!(" << block_name << fpga_port_postfix;
       fp << " === " << block_name << benchmark_port_postfix;
       fp << ") && !(" << block_name << benchmark_port_postfix;
-      fp << " === 1'bx)) begin" << std::endl;
+      fp << " === 1'bx)) begin" << '\n';
       fp << "\t\t\t\t" << block_name << check_flag_port_postfix << " <= 1'b1;"
-         << std::endl;
-      fp << "\t\t\tend else begin" << std::endl;
+         << '\n';
+      fp << "\t\t\tend else begin" << '\n';
       fp << "\t\t\t\t" << block_name << check_flag_port_postfix << "<= 1'b0;"
-         << std::endl;
-      fp << "\t\t\tend" << std::endl;
+         << '\n';
+      fp << "\t\t\tend" << '\n';
     }
   }
-  fp << "\t\tend" << std::endl;
-  fp << "\tend" << std::endl;
+  fp << "\t\tend" << '\n';
+  fp << "\tend" << '\n';
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
     /* Only care about output atom blocks ! */
@@ -672,22 +629,22 @@ void print_verilog_testbench_check(
     block_name = remove_atom_block_name_prefix(block_name);
 
     fp << "\talways@(posedge " << block_name << check_flag_port_postfix
-       << ") begin" << std::endl;
+       << ") begin" << '\n';
     fp << "\t\tif(" << block_name << check_flag_port_postfix << ") begin"
-       << std::endl;
+       << '\n';
     fp << "\t\t\t" << error_counter_name << " = " << error_counter_name
-       << " + 1;" << std::endl;
+       << " + 1;" << '\n';
     fp << "\t\t\t$display(\"Mismatch on " << block_name << fpga_port_postfix
-       << " at time = " << std::string("%t") << "\", $realtime);" << std::endl;
-    fp << "\t\tend" << std::endl;
-    fp << "\tend" << std::endl;
+       << " at time = " << std::string("%t") << "\", $realtime);" << '\n';
+    fp << "\t\tend" << '\n';
+    fp << "\tend" << '\n';
 
     /* Add an empty line as splitter */
-    fp << std::endl;
+    fp << '\n';
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -740,28 +697,52 @@ void print_verilog_testbench_clock_stimuli(
       }
     }
 
-    fp << "\tinitial begin" << std::endl;
+    fp << "\tinitial begin" << '\n';
     /* Create clock stimuli */
     fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, clock_port)
-       << " <= 1'b0;" << std::endl;
-    fp << "\t\twhile(1) begin" << std::endl;
-    fp << "\t\t\t#" << std::setprecision(10) << clk_freq_to_use << std::endl;
+       << " <= 1'b0;" << '\n';
+    fp << "\t\twhile(1) begin" << '\n';
+    fp << "\t\t\t#" << std::setprecision(10) << clk_freq_to_use << '\n';
     fp << "\t\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, clock_port);
     fp << " <= !";
     fp << generate_verilog_port(VERILOG_PORT_CONKT, clock_port);
-    fp << ";" << std::endl;
-    fp << "\t\tend" << std::endl;
+    fp << ";" << '\n';
+    fp << "\t\tend" << '\n';
 
-    fp << "\tend" << std::endl;
+    fp << "\tend" << '\n';
 
     /* Add an empty line as splitter */
-    fp << std::endl;
+    fp << '\n';
+  }
+}
+
+/********************************************************************
+ * Print the concatenation of a group of input ports, e.g., {a, b, c}
+ *******************************************************************/
+static std::string generate_verilog_testbench_input_concatenation(
+  const std::vector<std::string>& input_names, const size_t& begin,
+  const size_t& end) {
+  std::string concat("{");
+  for (size_t iname = begin; iname < end; ++iname) {
+    if (iname != begin) {
+      concat += ", ";
+    }
+    concat += input_names[iname];
   }
+  concat += "}";
+  return concat;
 }
 
 /********************************************************************
  * Generate random stimulus for the input ports (non-clock signals)
  * For clock signals, please use print_verilog_testbench_clock_stimuli
+ * The stimulus can be generated in three ways:
+ * - By default, a '$random' call per input port
+ * - When vectorized, a '$urandom' call per group of 32 input ports,
+ *   assigned to the concatenation of the ports
+ * - When a stimulus vector file is provided, the vectors are loaded by
+ *   '$readmemh' and applied to the concatenation of all the input ports,
+ *   one vector per clock cycle. The first input port is the MSB.
  *******************************************************************/
 void print_verilog_testbench_random_stimuli(
   std::fstream& fp, const AtomContext& atom_ctx,
@@ -771,18 +752,17 @@ void print_verilog_testbench_random_stimuli(
   const std::vector<std::string>& clock_port_names,
   const std::string& input_port_postfix,
   const std::string& check_flag_port_postfix,
-  const std::vector<BasicPort>& clock_ports, const bool& no_self_checking) {
+  const std::vector<BasicPort>& clock_ports, const bool& no_self_checking,
+  const bool& vectorized_stimulus, const std::string& stimulus_vector_file,
+  const size_t& num_stimulus_vectors) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  print_verilog_comment(fp, std::string("----- Input Initialization -------"));
-
-  fp << "\tinitial begin" << std::endl;
-
+  /* Find the input ports which require stimulus */
+  std::vector<std::string> input_names;
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
-    /* Bypass non-I/O atom blocks ! */
-    if ((AtomBlockType::INPAD != atom_ctx.nlist.block_type(atom_blk)) &&
-        (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk))) {
+    /* Bypass non-input atom blocks ! */
+    if (AtomBlockType::INPAD != atom_ctx.nlist.block_type(atom_blk)) {
       continue;
     }
 
@@ -792,9 +772,6 @@ void print_verilog_testbench_random_stimuli(
     if (true == netlist_annotation.is_block_renamed(atom_blk)) {
       block_name = netlist_annotation.block_name(atom_blk);
     }
-    if (AtomBlockType::OUTPAD == atom_ctx.nlist.block_type(atom_blk)) {
-      block_name = remove_atom_block_name_prefix(block_name);
-    }
 
     /* Bypass clock ports because their stimulus cannot be random */
     if (clock_port_names.end() != std::find(clock_port_names.begin(),
@@ -812,17 +789,45 @@ void print_verilog_testbench_random_stimuli(
       continue;
     }
 
-    /* TODO: find the clock inputs will be initialized later */
-    if (AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) {
-      fp << "\t\t" << block_name + input_port_postfix << " <= 1'b0;"
-         << std::endl;
-    }
+    input_names.push_back(block_name + input_port_postfix);
+  }
+
+  bool use_stimulus_vectors =
+    !stimulus_vector_file.empty() && !input_names.empty();
+  BasicPort stimulus_vectors(std::string(TESTBENCH_STIMULUS_VECTORS_NAME),
+                             input_names.size());
+  if (true == use_stimulus_vectors) {
+    VTR_ASSERT(0 < num_stimulus_vectors);
+    print_verilog_comment(
+      fp, std::string("----- Stimulus vectors of inputs " +
+                      generate_verilog_testbench_input_concatenation(
+                        input_names, 0, input_names.size()) +
+                      " -------"));
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, stimulus_vectors)
+       << "[0:" << num_stimulus_vectors - 1 << "];" << '\n';
+    fp << "\tinteger " << TESTBENCH_STIMULUS_VECTOR_INDEX_NAME << ";" << '\n';
+    fp << '\n';
+  }
+
+  print_verilog_comment(fp, std::string("----- Input Initialization -------"));
+
+  fp << "\tinitial begin" << '\n';
+
+  /* TODO: find the clock inputs will be initialized later */
+  for (const std::string& input_name : input_names) {
+    fp << "\t\t" << input_name << " <= 1'b0;" << '\n';
+  }
+
+  if (true == use_stimulus_vectors) {
+    fp << "\t\t$readmemh(\"" << stimulus_vector_file << "\", "
+       << TESTBENCH_STIMULUS_VECTORS_NAME << ");" << '\n';
+    fp << "\t\t" << TESTBENCH_STIMULUS_VECTOR_INDEX_NAME << " = 0;" << '\n';
   }
 
   /* Set 0 to registers for checking flags */
   if (!no_self_checking) {
     /* Add an empty line as splitter */
-    fp << std::endl;
+    fp << '\n';
 
     for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
       /* Bypass non-I/O atom blocks ! */
@@ -842,15 +847,15 @@ void print_verilog_testbench_random_stimuli(
       BasicPort output_port(std::string(block_name + check_flag_port_postfix),
                             1);
       fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, output_port)
-         << " <= 1'b0;" << std::endl;
+         << " <= 1'b0;" << '\n';
     }
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << '\n';
   /* Finish initialization */
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(fp, std::string("----- Input Stimulus -------"));
   /* TODO: This is limitation when multiple clock signals exist
@@ -861,52 +866,38 @@ void print_verilog_testbench_random_stimuli(
   VTR_ASSERT(1 <= clock_ports.size());
   fp << "\talways@(negedge "
      << generate_verilog_port(VERILOG_PORT_CONKT, clock_ports[0]) << ") begin"
-     << std::endl;
-
-  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
-    /* Bypass non-I/O atom blocks ! */
-    if ((AtomBlockType::INPAD != atom_ctx.nlist.block_type(atom_blk)) &&
-        (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk))) {
-      continue;
+     << '\n';
+
+  if (true == use_stimulus_vectors) {
+    /* Apply a vector per clock cycle, and restart when all are applied */
+    fp << "\t\t"
+       << generate_verilog_testbench_input_concatenation(input_names, 0,
+                                                         input_names.size())
+       << " <= " << TESTBENCH_STIMULUS_VECTORS_NAME << "["
+       << TESTBENCH_STIMULUS_VECTOR_INDEX_NAME << "];" << '\n';
+    fp << "\t\t" << TESTBENCH_STIMULUS_VECTOR_INDEX_NAME << " <= ("
+       << TESTBENCH_STIMULUS_VECTOR_INDEX_NAME << " + 1) % "
+       << num_stimulus_vectors << ";" << '\n';
+  } else if (true == vectorized_stimulus) {
+    /* Each call of $urandom drives a group of inputs */
+    for (size_t begin = 0; begin < input_names.size();
+         begin += VERILOG_URANDOM_WIDTH) {
+      size_t end = std::min(begin + VERILOG_URANDOM_WIDTH, input_names.size());
+      fp << "\t\t"
+         << generate_verilog_testbench_input_concatenation(input_names, begin,
+                                                           end)
+         << " <= $urandom;" << '\n';
     }
-
-    /* The block may be renamed as it contains special characters which violate
-     * Verilog syntax */
-    std::string block_name = atom_ctx.nlist.block_name(atom_blk);
-    if (true == netlist_annotation.is_block_renamed(atom_blk)) {
-      block_name = netlist_annotation.block_name(atom_blk);
-    }
-    if (AtomBlockType::OUTPAD == atom_ctx.nlist.block_type(atom_blk)) {
-      block_name = remove_atom_block_name_prefix(block_name);
-    }
-
-    /* Bypass clock ports because their stimulus cannot be random */
-    if (clock_port_names.end() != std::find(clock_port_names.begin(),
-                                            clock_port_names.end(),
-                                            block_name)) {
-      continue;
-    }
-
-    /* Bypass any constained net that are mapped to a global port of the FPGA
-     * fabric because their stimulus cannot be random
-     */
-    if (true ==
-        port_is_fabric_global_reset_port(global_ports, module_manager,
-                                         pin_constraints.net_pin(block_name))) {
-      continue;
-    }
-
-    /* TODO: find the clock inputs will be initialized later */
-    if (AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) {
-      fp << "\t\t" << block_name + input_port_postfix << " <= $random;"
-         << std::endl;
+  } else {
+    for (const std::string& input_name : input_names) {
+      fp << "\t\t" << input_name << " <= $random;" << '\n';
     }
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << '\n';
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -960,15 +951,15 @@ void print_verilog_testbench_shared_ports(
         port_is_fabric_global_reset_port(global_ports, module_manager,
                                          pin_constraints.net_pin(block_name))) {
       fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, input_port) << ";"
-         << std::endl;
+         << '\n';
     } else {
       fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, input_port) << ";"
-         << std::endl;
+         << '\n';
     }
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Instantiate wires for FPGA fabric outputs */
   print_verilog_comment(fp, std::string("----- FPGA fabric outputs -------"));
@@ -991,11 +982,11 @@ void print_verilog_testbench_shared_ports(
     BasicPort output_port(std::string(block_name + fpga_output_port_postfix),
                           1);
     fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, output_port) << ";"
-       << std::endl;
+       << '\n';
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 
   if (no_self_checking) {
     return;
@@ -1021,11 +1012,11 @@ void print_verilog_testbench_shared_ports(
     BasicPort output_port(
       std::string(block_name + benchmark_output_port_postfix), 1);
     fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, output_port) << ";"
-       << std::endl;
+       << '\n';
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Instantiate register for output comparison */
   print_verilog_comment(
@@ -1047,11 +1038,45 @@ void print_verilog_testbench_shared_ports(
     /* Each logical block assumes a single-width port */
     BasicPort output_port(std::string(block_name + check_flag_port_postfix), 1);
     fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, output_port) << ";"
-       << std::endl;
+       << '\n';
   }
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
+}
+
+/********************************************************************
+ * Print the $deposit statements which initialize the input ports of
+ * a primitive circuit model, whose instance is at the given path
+ *******************************************************************/
+static void print_verilog_testbench_primitive_port_deposits(
+  std::fstream& fp, const std::string& primitive_path,
+  const CircuitLibrary& circuit_lib,
+  const std::vector<CircuitPortId>& circuit_input_ports,
+  const bool& deposit_random_values) {
+  fp << "\tinitial begin" << '\n';
+
+  for (const auto& input_port : circuit_input_ports) {
+    /* Only for formal verification: deposite a zero signal values */
+    /* Initialize each input port */
+    BasicPort input_port_info(circuit_lib.port_lib_name(input_port),
+                              circuit_lib.port_size(input_port));
+    input_port_info.set_origin_port_width(input_port_info.get_width());
+    fp << "\t\t$deposit(";
+    fp << primitive_path << ".";
+    fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port_info, false);
+
+    if (!deposit_random_values) {
+      fp << ", " << circuit_lib.port_size(input_port) << "'b"
+         << std::string(circuit_lib.port_size(input_port), '0');
+      fp << ");" << '\n';
+    } else {
+      VTR_ASSERT_SAFE(deposit_random_values);
+      fp << ", $random % 2 ? 1'b1 : 1'b0);" << '\n';
+    }
+  }
+
+  fp << "\tend" << '\n';
 }
 
 /********************************************************************
@@ -1064,7 +1089,7 @@ void print_verilog_testbench_shared_ports(
  *******************************************************************/
 static void rec_print_verilog_testbench_primitive_module_signal_initialization(
   std::fstream& fp, const std::string& hie_path,
-  const CircuitLibrary& circuit_lib, const CircuitModelId& circuit_model,
+  const CircuitLibrary& circuit_lib,
   const std::vector<CircuitPortId>& circuit_input_ports,
   const ModuleManager& module_manager, const ModuleId& parent_module,
   const ModuleId& primitive_module, const bool& deposit_random_values) {
@@ -1096,9 +1121,8 @@ static void rec_print_verilog_testbench_primitive_module_signal_initialization(
 
       if (child_module != primitive_module) {
         rec_print_verilog_testbench_primitive_module_signal_initialization(
-          fp, child_hie_path, circuit_lib, circuit_model, circuit_input_ports,
-          module_manager, child_module, primitive_module,
-          deposit_random_values);
+          fp, child_hie_path, circuit_lib, circuit_input_ports, module_manager,
+          child_module, primitive_module, deposit_random_values);
       } else {
         /* If the child module is the primitive module,
          * we output the signal initialization codes for the input ports
@@ -1107,30 +1131,9 @@ static void rec_print_verilog_testbench_primitive_module_signal_initialization(
 
         print_verilog_comment(
           fp, std::string("------ BEGIN driver initialization -----"));
-        fp << "\tinitial begin" << std::endl;
-
-        for (const auto& input_port : circuit_input_ports) {
-          /* Only for formal verification: deposite a zero signal values */
-          /* Initialize each input port */
-          BasicPort input_port_info(circuit_lib.port_lib_name(input_port),
-                                    circuit_lib.port_size(input_port));
-          input_port_info.set_origin_port_width(input_port_info.get_width());
-          fp << "\t\t$deposit(";
-          fp << child_hie_path << ".";
-          fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port_info,
-                                      false);
-
-          if (!deposit_random_values) {
-            fp << ", " << circuit_lib.port_size(input_port) << "'b"
-               << std::string(circuit_lib.port_size(input_port), '0');
-            fp << ");" << std::endl;
-          } else {
-            VTR_ASSERT_SAFE(deposit_random_values);
-            fp << ", $random % 2 ? 1'b1 : 1'b0);" << std::endl;
-          }
-        }
-
-        fp << "\tend" << std::endl;
+        print_verilog_testbench_primitive_port_deposits(
+          fp, child_hie_path, circuit_lib, circuit_input_ports,
+          deposit_random_values);
         print_verilog_comment(
           fp, std::string("------ END driver initialization -----"));
       }
@@ -1139,26 +1142,54 @@ static void rec_print_verilog_testbench_primitive_module_signal_initialization(
 }
 
 /********************************************************************
- * Print signal initialization for Verilog testbenches
- * which aim to deposit initial values for the input ports of primitive circuit
- *models:
- * - Passgate
- * - Logic gates (ONLY for MUX2)
+ * Print signal initialization for a primitive module, which is bound to
+ * all the instances of the module with a SystemVerilog bind directive.
+ * The initialization module refers to the ports of the primitive instance
+ * through an upward name reference, i.e., <primitive_module>.<port>
+ * As a result, the codes are printed once per primitive module, rather than
+ * once per primitive instance
  *******************************************************************/
-void print_verilog_testbench_signal_initialization(
-  std::fstream& fp, const std::string& top_instance_name,
-  const CircuitLibrary& circuit_lib, const ModuleManager& module_manager,
-  const ModuleId& top_module, const bool& deposit_random_values) {
+static void print_verilog_testbench_primitive_module_signal_initialization_bind(
+  std::fstream& fp, const CircuitLibrary& circuit_lib,
+  const std::vector<CircuitPortId>& circuit_input_ports,
+  const ModuleManager& module_manager, const ModuleId& primitive_module,
+  const bool& deposit_random_values) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
+  std::string primitive_module_name =
+    module_manager.module_name(primitive_module);
+  std::string init_module_name =
+    primitive_module_name + std::string("_signal_init");
+
+  print_verilog_comment(
+    fp, std::string("------ BEGIN driver initialization of module " +
+                    primitive_module_name + " -----"));
+  fp << "module " << init_module_name << ";" << '\n';
+  print_verilog_testbench_primitive_port_deposits(
+    fp, primitive_module_name, circuit_lib, circuit_input_ports,
+    deposit_random_values);
+  fp << "endmodule" << '\n';
+  fp << "bind " << primitive_module_name << " " << init_module_name << " "
+     << init_module_name << "_inst();" << '\n';
+  print_verilog_comment(
+    fp, std::string("------ END driver initialization of module " +
+                    primitive_module_name + " -----"));
+}
+
+/********************************************************************
+ * Collect the circuit models whose input ports require signal
+ * initialization, as well as these input ports:
+ * - Passgate
+ * - Logic gates (ONLY for MUX2)
+ *******************************************************************/
+static std::vector<CircuitModelId> find_signal_init_circuit_models(
+  const CircuitLibrary& circuit_lib,
+  std::map<CircuitModelId, std::vector<CircuitPortId>>&
+    signal_init_circuit_ports) {
   /* Collect circuit models that need signal initialization */
   std::vector<CircuitModelId> signal_init_circuit_models;
 
-  /* Collect the input ports that require signal initialization */
-  std::map<CircuitModelId, std::vector<CircuitPortId>>
-    signal_init_circuit_ports;
-
   for (const CircuitModelId& model :
        circuit_lib.models_by_type(CIRCUIT_MODEL_PASSGATE)) {
     signal_init_circuit_models.push_back(model);
@@ -1186,13 +1217,36 @@ void print_verilog_testbench_signal_initialization(
     }
   }
 
+  return signal_init_circuit_models;
+}
+
+/********************************************************************
+ * Print signal initialization for Verilog testbenches
+ * which aim to deposit initial values for the input ports of primitive circuit
+ *models:
+ * - Passgate
+ * - Logic gates (ONLY for MUX2)
+ *******************************************************************/
+void print_verilog_testbench_signal_initialization(
+  std::fstream& fp, const std::string& top_instance_name,
+  const CircuitLibrary& circuit_lib, const ModuleManager& module_manager,
+  const ModuleId& top_module, const bool& deposit_random_values) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  /* Collect the input ports that require signal initialization */
+  std::map<CircuitModelId, std::vector<CircuitPortId>>
+    signal_init_circuit_ports;
+  std::vector<CircuitModelId> signal_init_circuit_models =
+    find_signal_init_circuit_models(circuit_lib, signal_init_circuit_ports);
+
   /* If there is no circuit model in the list, return directly */
   if (signal_init_circuit_models.empty()) {
     return;
   }
 
   /* Add signal initialization Verilog codes */
-  fp << std::endl;
+  fp << '\n';
   for (const CircuitModelId& signal_init_circuit_model :
        signal_init_circuit_models) {
     /* Find the module id corresponding to the circuit model from module graph
@@ -1203,10 +1257,212 @@ void print_verilog_testbench_signal_initialization(
 
     /* Find all the instances created by the circuit model across the fabric*/
     rec_print_verilog_testbench_primitive_module_signal_initialization(
-      fp, top_instance_name, circuit_lib, signal_init_circuit_model,
+      fp, top_instance_name, circuit_lib,
       signal_init_circuit_ports.at(signal_init_circuit_model), module_manager,
       top_module, primitive_module, deposit_random_values);
   }
 }
 
+/********************************************************************
+ * Print signal initialization for Verilog testbenches, once per primitive
+ * module rather than once per primitive instance.
+ * The same input ports are initialized as
+ * print_verilog_testbench_signal_initialization(), through an
+ * initialization module bound to each primitive module.
+ * Note that the codes should be printed outside any module, e.g., after the
+ * testbench module ends, and require a SystemVerilog simulator
+ *******************************************************************/
+void print_verilog_testbench_signal_initialization_per_module(
+  std::fstream& fp, const CircuitLibrary& circuit_lib,
+  const ModuleManager& module_manager, const bool& deposit_random_values) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  /* Collect the input ports that require signal initialization */
+  std::map<CircuitModelId, std::vector<CircuitPortId>>
+    signal_init_circuit_ports;
+  std::vector<CircuitModelId> signal_init_circuit_models =
+    find_signal_init_circuit_models(circuit_lib, signal_init_circuit_ports);
+
+  /* If there is no circuit model in the list, return directly */
+  if (signal_init_circuit_models.empty()) {
+    return;
+  }
+
+  /* Add signal initialization Verilog codes */
+  fp << '\n';
+  for (const CircuitModelId& signal_init_circuit_model :
+       signal_init_circuit_models) {
+    /* Find the module id corresponding to the circuit model from module graph
+     */
+    ModuleId primitive_module = module_manager.find_module(
+      circuit_lib.model_name(signal_init_circuit_model));
+    VTR_ASSERT(true == module_manager.valid_module_id(primitive_module));
+
+    print_verilog_testbench_primitive_module_signal_initialization_bind(
+      fp, circuit_lib, signal_init_circuit_ports.at(signal_init_circuit_model),
+      module_manager, primitive_module, deposit_random_values);
+  }
+}
+
+/********************************************************************
+ * Build the hierarchical path of a configuration block in a testbench,
+ * which ends with a dot, e.g.,
+ *   <fpga_instance_name>.<block>.<block>.
+ * The first block of the hierarchy is the top module, which is
+ * replaced by the instance name of the FPGA fabric
+ *******************************************************************/
+std::string find_fpga_instance_config_block_path(
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const BitstreamManager& bitstream_manager,
+  const ConfigBlockId& config_block_id, const std::string& fpga_instance_name) {
+  /* Drop the first block, which is the top module, it should be replaced by
+   * the instance name here */
+  /* Ensure that this is the module we want to drop! */
+  VTR_ASSERT(0 == module_manager.module_name(top_module)
+                    .compare(bitstream_manager.block_name(
+                      bitstream_manager.block_top(config_block_id))));
+  /* Build the full hierarchy path */
+  std::string bit_hierarchy_path(fpga_instance_name);
+  if (true == bitstream_manager.block_parent(config_block_id).is_valid()) {
+    bit_hierarchy_path.push_back('.');
+    bitstream_manager.append_block_path(bit_hierarchy_path, config_block_id,
+                                        true);
+  }
+  bit_hierarchy_path.push_back('.');
+
+  return bit_hierarchy_path;
+}
+
+/********************************************************************
+ * Impose the bitstream on the configuration memories of an FPGA
+ * instance through a memory image file, which is loaded by '$readmemb'.
+ * Each line of the image contains the bits of a configuration block,
+ * in the sequence of blocks, padded with '0' to the widest block:
+ *
+ *   reg [0:<width>-1] <mem_name>[0:<num_blocks>-1];
+ *   initial begin
+ *     <load_event>
+ *     $readmemb("<image>", <mem_name>);
+ *     force <block_path>.mem_out[0:<w>-1] = <mem_name>[<i>][0:<w>-1];
+ *     ...
+ *   end
+ *
+ * The load event, e.g., '@(posedge config_done);', is optional and
+ * delays the loading until the event happens.
+ * The bit values are kept out of the netlist, so that its size only
+ * depends on the number of configuration blocks.
+ * Verilog does not allow to index a hierarchical path at run time,
+ * so that each block still has a statement with its path
+ *******************************************************************/
+void print_verilog_testbench_memory_image_bitstream(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleId& top_module, const BitstreamManager& bitstream_manager,
+  const std::string& fpga_instance_name, const std::string& mem_name,
+  const std::string& load_event, const bool& output_datab_bits,
+  const e_embedded_bitstream_hdl_type& embedded_bitstream_hdl_type,
+  const std::string& image_fname, const std::string& image_include_path) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  /* Collect the blocks with configuration bits and the widest one */
+  std::vector<ConfigBlockId> image_blocks;
+  size_t image_width = 0;
+  for (const ConfigBlockId& config_block_id : bitstream_manager.blocks()) {
+    size_t num_block_bits = bitstream_manager.block_num_bits(config_block_id);
+    if (0 == num_block_bits) {
+      continue;
+    }
+    image_blocks.push_back(config_block_id);
+    image_width = std::max(image_width, num_block_bits);
+  }
+
+  if (true == image_blocks.empty()) {
+    return;
+  }
+
+  /* Write the memory image */
+  BufferedFileStream image_fp;
+  image_fp.open(image_fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(image_fname.c_str(), image_fp);
+
+  std::string image_line;
+  for (const ConfigBlockId& config_block_id : image_blocks) {
+    image_line.clear();
+    for (const ConfigBitId config_bit :
+         bitstream_manager.block_bits(config_block_id)) {
+      image_line.push_back(bitstream_manager.bit_value(config_bit) ? '1'
+                                                                    : '0');
+    }
+    image_line.resize(image_width, '0');
+    image_fp << image_line << '\n';
+  }
+  image_fp.close();
+
+  /* Declare the memory and load the image */
+  print_verilog_comment(
+    fp, std::string(
+          "----- Begin load bitstream image to configuration memories -----"));
+
+  fp << "reg [0:" << image_width - 1 << "] " << mem_name << "[0:"
+     << image_blocks.size() - 1 << "];" << '\n';
+
+  fp << "initial begin" << '\n';
+  if (false == load_event.empty()) {
+    fp << "\t" << load_event << '\n';
+  }
+  fp << "\t$readmemb(\"" << image_include_path << "\", " << mem_name << ");"
+     << '\n';
+
+  for (size_t iblk = 0; iblk < image_blocks.size(); ++iblk) {
+    const ConfigBlockId& config_block_id = image_blocks[iblk];
+    std::string bit_hierarchy_path = find_fpga_instance_config_block_path(
+      module_manager, top_module, bitstream_manager, config_block_id,
+      fpga_instance_name);
+    size_t num_block_bits = bitstream_manager.block_num_bits(config_block_id);
+
+    /* The word of the image to be imposed, e.g., mem[<i>][0:<w>-1] */
+    std::string mem_word = mem_name + std::string("[") +
+                           std::to_string(iblk) + std::string("][0:") +
+                           std::to_string(num_block_bits - 1) +
+                           std::string("]");
+
+    BasicPort config_data_port(
+      bit_hierarchy_path + generate_configurable_memory_data_out_name(),
+      num_block_bits);
+    BasicPort config_datab_port(
+      bit_hierarchy_path +
+        generate_configurable_memory_inverted_data_out_name(),
+      num_block_bits);
+
+    if (EMBEDDED_BITSTREAM_HDL_IVERILOG == embedded_bitstream_hdl_type) {
+      fp << "\tforce "
+         << generate_verilog_port(VERILOG_PORT_CONKT, config_data_port)
+         << " = " << mem_word << ";" << '\n';
+      if (true == output_datab_bits) {
+        fp << "\tforce "
+           << generate_verilog_port(VERILOG_PORT_CONKT, config_datab_port)
+           << " = ~" << mem_word << ";" << '\n';
+      }
+    } else {
+      VTR_ASSERT(EMBEDDED_BITSTREAM_HDL_MODELSIM ==
+                 embedded_bitstream_hdl_type);
+      fp << "\t$deposit("
+         << generate_verilog_port(VERILOG_PORT_CONKT, config_data_port)
+         << ", " << mem_word << ");" << '\n';
+      if (true == output_datab_bits) {
+        fp << "\t$deposit("
+           << generate_verilog_port(VERILOG_PORT_CONKT, config_datab_port)
+           << ", ~" << mem_word << ");" << '\n';
+      }
+    }
+  }
+
+  fp << "end" << '\n';
+
+  print_verilog_comment(
+    fp, std::string(
+          "----- End load bitstream image to configuration memories -----"));
+}
+
 } /* end namespace openfpga */
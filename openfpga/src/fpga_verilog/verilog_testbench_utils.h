@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+#include "bitstream_manager.h"
 #include "bus_group.h"
 #include "circuit_library.h"
 #include "fabric_global_port_info.h"
@@ -15,6 +16,7 @@
 #include "module_manager.h"
 #include "pin_constraints.h"
 #include "simulation_setting.h"
+#include "verilog_testbench_options.h"
 #include "vpr_context.h"
 #include "vpr_netlist_annotation.h"
 
@@ -88,7 +90,9 @@ void print_verilog_testbench_random_stimuli(
   const std::vector<std::string>& clock_port_names,
   const std::string& input_port_postfix,
   const std::string& check_flag_port_postfix,
-  const std::vector<BasicPort>& clock_ports, const bool& no_self_checking);
+  const std::vector<BasicPort>& clock_ports, const bool& no_self_checking,
+  const bool& vectorized_stimulus, const std::string& stimulus_vector_file,
+  const size_t& num_stimulus_vectors);
 
 void print_verilog_testbench_shared_ports(
   std::fstream& fp, const ModuleManager& module_manager,
@@ -106,6 +110,23 @@ void print_verilog_testbench_signal_initialization(
   const CircuitLibrary& circuit_lib, const ModuleManager& module_manager,
   const ModuleId& top_module, const bool& deposit_random_values);
 
+void print_verilog_testbench_signal_initialization_per_module(
+  std::fstream& fp, const CircuitLibrary& circuit_lib,
+  const ModuleManager& module_manager, const bool& deposit_random_values);
+
+std::string find_fpga_instance_config_block_path(
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const BitstreamManager& bitstream_manager,
+  const ConfigBlockId& config_block_id, const std::string& fpga_instance_name);
+
+void print_verilog_testbench_memory_image_bitstream(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleId& top_module, const BitstreamManager& bitstream_manager,
+  const std::string& fpga_instance_name, const std::string& mem_name,
+  const std::string& load_event, const bool& output_datab_bits,
+  const e_embedded_bitstream_hdl_type& embedded_bitstream_hdl_type,
+  const std::string& image_fname, const std::string& image_include_path);
+
 } /* end namespace openfpga */
 
 #endif
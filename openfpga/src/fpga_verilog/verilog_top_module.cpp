@@ -5,14 +5,21 @@
 #include <algorithm>
 #include <fstream>
 #include <map>
+#include <string>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "vtr_time.h"
 
 /* Headers from openfpgautil library */
+#include "build_top_module.h"
+#include "build_top_module_connection.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "verilog_constants.h"
 #include "verilog_module_writer.h"
 #include "verilog_top_module.h"
@@ -21,6 +28,190 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Find the number of slices that the instances of the top-level module
+ * are split into. Do not create empty slices
+ *******************************************************************/
+static size_t find_num_top_module_slices(
+  const ModuleEmissionPlan& emission_plan,
+  const FabricVerilogOption& options) {
+  return std::max(size_t(1),
+                  std::min(options.num_top_module_slices(),
+                           emission_plan.child_instances().size()));
+}
+
+/********************************************************************
+ * Print a slice of the instances of the top-level module into a netlist.
+ * The instances are balanced among the slices.
+ * Return true if the netlist is changed
+ *******************************************************************/
+static bool print_verilog_top_module_instance_slice(
+  const std::string& slice_fpath, const ModuleManager& module_manager,
+  const ModuleEmissionPlan& emission_plan, const size_t& islice,
+  const size_t& num_slices, const FabricVerilogOption& options) {
+  size_t num_instances = emission_plan.child_instances().size();
+
+  BufferedFileStream fp;
+  fp.open(slice_fpath, std::fstream::out | std::fstream::trunc, true);
+
+  check_file_stream(slice_fpath.c_str(), fp);
+
+  print_verilog_file_header(
+    fp,
+    std::string("Slice ") + std::to_string(islice) +
+      std::string(" of the instances of top-level Verilog module for FPGA"),
+    options.time_stamp());
+
+  write_verilog_module_instances_to_file(
+    fp, module_manager, emission_plan, islice * num_instances / num_slices,
+    (islice + 1) * num_instances / num_slices,
+    options.explicit_port_mapping());
+
+  fp.close();
+
+  return fp.file_changed();
+}
+
+/********************************************************************
+ * Print the instances of the top-level module into a number of slice
+ * netlists, which are written in parallel. Each slice contains a
+ * contiguous range of the instances, in the sequence of the module graph.
+ * A slice is written in incremental mode, which replaces the netlist
+ * of a previous run only when the content changes. As a result, the
+ * netlists of unchanged slices are kept and can be reused by tools
+ * (note that time stamps in the netlists change at each run).
+ * The slices are added to the netlist manager, in the sequence of
+ * the instances.
+ * Return the paths to include the slices in the top-level netlist
+ *******************************************************************/
+static std::vector<std::string> print_verilog_top_module_instance_slices(
+  NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  const ModuleEmissionPlan& emission_plan, const std::string& verilog_dir,
+  const FabricVerilogOption& options) {
+  size_t num_slices = find_num_top_module_slices(emission_plan, options);
+
+  std::vector<std::string> include_paths(num_slices);
+  std::vector<char> slice_replaced(num_slices, 0);
+  parallel_for(num_slices, options.num_threads(), [&](const size_t& islice) {
+    std::string slice_fname(generate_fpga_top_netlist_name(
+      std::string("_slice_") + std::to_string(islice) +
+      std::string(VERILOG_NETLIST_FILE_POSTFIX)));
+    std::string slice_fpath(verilog_dir + slice_fname);
+
+    /* The slices may be written by other processes, which report their
+     * own changes */
+    if (false == options.skip_top_module_slices()) {
+      slice_replaced[islice] = print_verilog_top_module_instance_slice(
+        slice_fpath, module_manager, emission_plan, islice, num_slices,
+        options);
+    }
+
+    if (options.use_relative_path()) {
+      include_paths[islice] = slice_fname;
+    } else {
+      include_paths[islice] = slice_fpath;
+    }
+  });
+
+  for (size_t islice = 0; islice < num_slices; ++islice) {
+    NetlistId nlist_id = netlist_manager.add_netlist(include_paths[islice]);
+    VTR_ASSERT(nlist_id);
+    netlist_manager.set_netlist_type(nlist_id,
+                                     NetlistManager::TOP_MODULE_SLICE_NETLIST);
+    netlist_manager.set_netlist_changed(nlist_id, slice_replaced[islice]);
+  }
+
+  if (true == options.skip_top_module_slices()) {
+    VTR_LOGV(options.verbose_output(),
+             "Skipped %lu netlists of top-level module slices\n", num_slices);
+    return include_paths;
+  }
+
+  size_t num_reused_slices =
+    std::count(slice_replaced.begin(), slice_replaced.end(), 0);
+  VTR_LOGV(options.verbose_output(),
+           "Reused %lu out of %lu netlists of top-level module slices\n",
+           num_reused_slices, num_slices);
+
+  return include_paths;
+}
+
+/********************************************************************
+ * Find the Verilog port of a pin of an instance in the top-level module,
+ * which is the net of the pin if any, or the local wire of the undriven
+ * pin otherwise
+ *******************************************************************/
+static BasicPort find_verilog_top_module_instance_pin(
+  const ModuleManager& module_manager, const ModuleEmissionPlan& emission_plan,
+  const ModuleId& child_module, const size_t& instance_id,
+  const ModulePortId& child_port, const size_t& child_pin) {
+  ModuleNetId net = emission_plan.instance_port_nets(
+    child_module, instance_id, child_port)[child_pin];
+  if (ModuleNetId::INVALID() != net) {
+    return emission_plan.net_port(net);
+  }
+  BasicPort instance_pin(
+    generate_verilog_undriven_local_wire_name(module_manager,
+                                              emission_plan.module(),
+                                              child_module, instance_id,
+                                              child_port),
+    child_pin, child_pin);
+  instance_pin.set_origin_port_width(
+    module_manager.module_port(child_module, child_port).get_width());
+  return instance_pin;
+}
+
+/********************************************************************
+ * Print the connections between the grids and the routing blocks of the
+ * top-level module, when they are deferred by build_fabric and hence not
+ * stored as nets in the module graph. The connections are found by the
+ * same enumerator which adds the nets to the module graph, and each of
+ * them is written as an assignment from the pin of the source instance to
+ * the pin of the sink instance as soon as it is found. Only the
+ * connections of a column of GSBs are held in memory at a time.
+ *******************************************************************/
+static void print_verilog_top_module_gsb_connections(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleEmissionPlan& emission_plan, const DeviceContext& device_ctx,
+  const VprDeviceAnnotation& device_annotation,
+  const DeviceRRGSB& device_rr_gsb, const FabricVerilogOption& options) {
+  vtr::ScopedStartFinishTimer timer(
+    "Write connections between grids and GSBs");
+
+  vtr::Matrix<size_t> grid_instance_ids;
+  vtr::Matrix<size_t> sb_instance_ids;
+  std::map<t_rr_type, vtr::Matrix<size_t>> cb_instance_ids;
+  find_top_module_instance_ids(module_manager, emission_plan.module(),
+                               device_ctx.grid, device_rr_gsb,
+                               options.compress_routing(), grid_instance_ids,
+                               sb_instance_ids, cb_instance_ids);
+
+  print_verilog_comment(
+    fp, std::string("----- BEGIN Connections between grids and GSBs -----"));
+  size_t num_connections = 0;
+  for_each_top_module_gsb_connection(
+    module_manager, device_annotation, device_ctx.grid, grid_instance_ids,
+    device_ctx.rr_graph, device_rr_gsb, sb_instance_ids, cb_instance_ids,
+    options.compress_routing(), options.duplicate_grid_pin(),
+    options.num_threads(), [&](const TopModulePinConnection& connection) {
+      BasicPort src_pin = find_verilog_top_module_instance_pin(
+        module_manager, emission_plan, connection.src_module,
+        connection.src_instance, connection.src_port, connection.src_pin);
+      BasicPort sink_pin = find_verilog_top_module_instance_pin(
+        module_manager, emission_plan, connection.sink_module,
+        connection.sink_instance, connection.sink_port, connection.sink_pin);
+      print_verilog_wire_connection(fp, sink_pin, src_pin, false);
+      ++num_connections;
+    });
+  print_verilog_comment(
+    fp, std::string("----- END Connections between grids and GSBs -----"));
+  fp << '\n';
+
+  VTR_LOGV(options.verbose_output(),
+           "Wrote %lu connections between grids and GSBs\n",
+           num_connections);
+}
+
 /********************************************************************
  * Print the top-level module for the FPGA fabric in Verilog format
  * This function will
@@ -34,6 +225,9 @@ namespace openfpga {
  *******************************************************************/
 void print_verilog_top_module(NetlistManager& netlist_manager,
                               const ModuleManager& module_manager,
+                              const DeviceContext& device_ctx,
+                              const VprDeviceAnnotation& device_annotation,
+                              const DeviceRRGSB& device_rr_gsb,
                               const std::string& verilog_dir,
                               const FabricVerilogOption& options) {
   /* Create a module as the top-level fabric, and add it to the module manager
@@ -52,8 +246,9 @@ void print_verilog_top_module(NetlistManager& netlist_manager,
           verilog_fpath.c_str());
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc,
+          options.incremental());
 
   check_file_stream(verilog_fpath.c_str(), fp);
 
@@ -61,12 +256,46 @@ void print_verilog_top_module(NetlistManager& netlist_manager,
     fp, std::string("Top-level Verilog module for FPGA"), options.time_stamp());
 
   /* Write the module content in Verilog format */
-  write_verilog_module_to_file(fp, module_manager, top_module,
-                               options.explicit_port_mapping(),
-                               options.default_net_type());
+  if (1 < options.num_top_module_slices()) {
+    /* The instances are written to slice netlists, which are included
+     * in the body of the module */
+    ModuleEmissionPlan emission_plan(module_manager, top_module);
+    std::vector<std::string> slice_paths =
+      print_verilog_top_module_instance_slices(
+        netlist_manager, module_manager, emission_plan, verilog_dir, options);
+    write_verilog_module_head_to_file(fp, module_manager, emission_plan,
+                                      options.default_net_type());
+    for (const std::string& slice_path : slice_paths) {
+      print_verilog_include_netlist(fp, slice_path);
+    }
+    fp << '\n';
+    if (true == options.gsb_nets_deferred()) {
+      print_verilog_top_module_gsb_connections(
+        fp, module_manager, emission_plan, device_ctx, device_annotation,
+        device_rr_gsb, options);
+    }
+    write_verilog_module_tail_to_file(fp, module_manager, top_module);
+  } else if (true == options.gsb_nets_deferred()) {
+    /* The connections are written after the instances */
+    ModuleEmissionPlan emission_plan(module_manager, top_module);
+    write_verilog_module_head_to_file(fp, module_manager, emission_plan,
+                                      options.default_net_type());
+    write_verilog_module_instances_to_file(
+      fp, module_manager, emission_plan, 0,
+      emission_plan.child_instances().size(),
+      options.explicit_port_mapping());
+    print_verilog_top_module_gsb_connections(fp, module_manager, emission_plan,
+                                             device_ctx, device_annotation,
+                                             device_rr_gsb, options);
+    write_verilog_module_tail_to_file(fp, module_manager, top_module);
+  } else {
+    write_verilog_module_to_file(fp, module_manager, top_module,
+                                 options.explicit_port_mapping(),
+                                 options.default_net_type());
+  }
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Close file handler */
   fp.close();
@@ -81,8 +310,56 @@ void print_verilog_top_module(NetlistManager& netlist_manager,
   VTR_ASSERT(nlist_id);
   netlist_manager.set_netlist_type(nlist_id,
                                    NetlistManager::TOP_MODULE_NETLIST);
+  netlist_manager.set_netlist_changed(nlist_id, fp.file_changed());
 
   VTR_LOG("Done\n");
 }
 
+/********************************************************************
+ * Print only a slice of the instances of the top-level module, which is
+ * the work of a process when the slices are distributed among a number
+ * of processes. Each process restores the same fabric, e.g., from a
+ * binary image, and writes its own slice, while the top-level netlist
+ * which includes all the slices is written by a process which skips the
+ * slices. Since the slice netlists are named after their indices, the
+ * netlists are the same as the ones written by a single process.
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the slice is out of range
+ *******************************************************************/
+int print_verilog_top_module_slice(const ModuleManager& module_manager,
+                                   const std::string& verilog_dir,
+                                   const FabricVerilogOption& options) {
+  std::string top_module_name = generate_fpga_top_module_name();
+  ModuleId top_module = module_manager.find_module(top_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  ModuleEmissionPlan emission_plan(module_manager, top_module);
+  size_t num_slices = find_num_top_module_slices(emission_plan, options);
+  size_t islice = options.top_module_slice();
+  if (islice >= num_slices) {
+    VTR_LOG_ERROR(
+      "Invalid top-level module slice %lu! Expect a slice in [0, %lu)\n",
+      islice, num_slices);
+    return 1;
+  }
+
+  std::string slice_fpath(
+    verilog_dir + generate_fpga_top_netlist_name(
+                    std::string("_slice_") + std::to_string(islice) +
+                    std::string(VERILOG_NETLIST_FILE_POSTFIX)));
+
+  VTR_LOG("Writing Verilog netlist for slice %lu of top-level module '%s'...",
+          islice, slice_fpath.c_str());
+
+  bool changed = print_verilog_top_module_instance_slice(
+    slice_fpath, module_manager, emission_plan, islice, num_slices, options);
+
+  VTR_LOG("Done\n");
+  VTR_LOGV(options.verbose_output() && options.incremental() && !changed,
+           "Reused the netlist of top-level module slice %lu\n", islice);
+
+  return 0;
+}
+
 } /* end namespace openfpga */
@@ -6,9 +6,12 @@
  *******************************************************************/
 #include <string>
 
+#include "device_rr_gsb.h"
 #include "fabric_verilog_options.h"
 #include "module_manager.h"
 #include "netlist_manager.h"
+#include "vpr_context.h"
+#include "vpr_device_annotation.h"
 
 /********************************************************************
  * Function declaration
@@ -19,9 +22,16 @@ namespace openfpga {
 
 void print_verilog_top_module(NetlistManager& netlist_manager,
                               const ModuleManager& module_manager,
+                              const DeviceContext& device_ctx,
+                              const VprDeviceAnnotation& device_annotation,
+                              const DeviceRRGSB& device_rr_gsb,
                               const std::string& verilog_dir,
                               const FabricVerilogOption& options);
 
+int print_verilog_top_module_slice(const ModuleManager& module_manager,
+                                   const std::string& verilog_dir,
+                                   const FabricVerilogOption& options);
+
 } /* end namespace openfpga */
 
 #endif
@@ -20,10 +20,12 @@
 #include "fabric_global_port_info_utils.h"
 #include "fast_configuration.h"
 #include "openfpga_atom_netlist_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "openfpga_port.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "simulation_utils.h"
 #include "verilog_constants.h"
 #include "verilog_testbench_utils.h"
@@ -58,14 +60,14 @@ static void print_verilog_top_testbench_flatten_memory_port(
   ModulePortId bl_port_id = module_manager.find_module_port(
     top_module, std::string(MEMORY_BL_PORT_NAME));
   BasicPort bl_port = module_manager.module_port(top_module, bl_port_id);
-  fp << generate_verilog_port(VERILOG_PORT_REG, bl_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, bl_port) << ";" << '\n';
 
   /* Print the port for Word-Line */
   print_verilog_comment(fp, std::string("---- Word Line ports -----"));
   ModulePortId wl_port_id = module_manager.find_module_port(
     top_module, std::string(MEMORY_WL_PORT_NAME));
   BasicPort wl_port = module_manager.module_port(top_module, wl_port_id);
-  fp << generate_verilog_port(VERILOG_PORT_REG, wl_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, wl_port) << ";" << '\n';
 }
 
 /********************************************************************
@@ -84,7 +86,7 @@ static void print_verilog_top_testbench_config_chain_port(
   BasicPort config_chain_head_port =
     module_manager.module_port(top_module, cc_head_port_id);
   fp << generate_verilog_port(VERILOG_PORT_REG, config_chain_head_port) << ";"
-     << std::endl;
+     << '\n';
 
   /* Print the tail of configuration-chains here */
   print_verilog_comment(fp, std::string("---- Configuration-chain tail -----"));
@@ -93,7 +95,7 @@ static void print_verilog_top_testbench_config_chain_port(
   BasicPort config_chain_tail_port =
     module_manager.module_port(top_module, cc_tail_port_id);
   fp << generate_verilog_port(VERILOG_PORT_WIRE, config_chain_tail_port) << ";"
-     << std::endl;
+     << '\n';
 }
 
 /********************************************************************
@@ -113,8 +115,7 @@ static void print_verilog_top_testbench_memory_bank_port(
   BasicPort bl_addr_port =
     module_manager.module_port(top_module, bl_addr_port_id);
 
-  fp << generate_verilog_port(VERILOG_PORT_REG, bl_addr_port) << ";"
-     << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, bl_addr_port) << ";" << '\n';
 
   /* Print the address port for the Word-Line decoder here */
   print_verilog_comment(
@@ -124,8 +125,7 @@ static void print_verilog_top_testbench_memory_bank_port(
   BasicPort wl_addr_port =
     module_manager.module_port(top_module, wl_addr_port_id);
 
-  fp << generate_verilog_port(VERILOG_PORT_REG, wl_addr_port) << ";"
-     << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, wl_addr_port) << ";" << '\n';
 
   /* Print the data-input port for the frame-based decoder here */
   print_verilog_comment(
@@ -133,7 +133,7 @@ static void print_verilog_top_testbench_memory_bank_port(
   ModulePortId din_port_id = module_manager.find_module_port(
     top_module, std::string(DECODER_DATA_IN_PORT_NAME));
   BasicPort din_port = module_manager.module_port(top_module, din_port_id);
-  fp << generate_verilog_port(VERILOG_PORT_REG, din_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, din_port) << ";" << '\n';
 
   /* Print the optional readback port for the decoder here */
   print_verilog_comment(
@@ -144,7 +144,7 @@ static void print_verilog_top_testbench_memory_bank_port(
     BasicPort readback_port =
       module_manager.module_port(top_module, readback_port_id);
     fp << generate_verilog_port(VERILOG_PORT_WIRE, readback_port) << ";"
-       << std::endl;
+       << '\n';
     /* Disable readback in full testbenches */
     print_verilog_wire_constant_values(
       fp, readback_port, std::vector<size_t>(readback_port.get_width(), 0));
@@ -163,9 +163,9 @@ static void print_verilog_top_testbench_memory_bank_port(
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
 
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, en_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, en_port) << ";" << '\n';
   fp << generate_verilog_port(VERILOG_PORT_REG, en_register_port) << ";"
-     << std::endl;
+     << '\n';
 
   write_tab_to_file(fp, 1);
   fp << "assign ";
@@ -174,7 +174,7 @@ static void print_verilog_top_testbench_memory_bank_port(
   fp << "~" << generate_verilog_port(VERILOG_PORT_CONKT, en_register_port);
   fp << " & ";
   fp << "~" << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 }
 
 /********************************************************************
@@ -193,7 +193,7 @@ static void print_verilog_top_testbench_frame_decoder_port(
     top_module, std::string(DECODER_ADDRESS_PORT_NAME));
   BasicPort addr_port = module_manager.module_port(top_module, addr_port_id);
 
-  fp << generate_verilog_port(VERILOG_PORT_REG, addr_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, addr_port) << ";" << '\n';
 
   /* Print the data-input port for the frame-based decoder here */
   print_verilog_comment(
@@ -201,7 +201,7 @@ static void print_verilog_top_testbench_frame_decoder_port(
   ModulePortId din_port_id = module_manager.find_module_port(
     top_module, std::string(DECODER_DATA_IN_PORT_NAME));
   BasicPort din_port = module_manager.module_port(top_module, din_port_id);
-  fp << generate_verilog_port(VERILOG_PORT_REG, din_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, din_port) << ";" << '\n';
 
   /* Generate enable signal waveform here:
    * which is a 90 degree phase shift than the programming clock
@@ -216,9 +216,9 @@ static void print_verilog_top_testbench_frame_decoder_port(
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
 
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, en_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, en_port) << ";" << '\n';
   fp << generate_verilog_port(VERILOG_PORT_REG, en_register_port) << ";"
-     << std::endl;
+     << '\n';
 
   write_tab_to_file(fp, 1);
   fp << "assign ";
@@ -227,7 +227,7 @@ static void print_verilog_top_testbench_frame_decoder_port(
   fp << "~" << generate_verilog_port(VERILOG_PORT_CONKT, en_register_port);
   fp << " & ";
   fp << "~" << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 }
 
 /********************************************************************
@@ -748,7 +748,7 @@ static void print_verilog_top_testbench_benchmark_clock_ports(
                       clock_source_to_connect.get_name() + " -------"));
     BasicPort clock_port(clock_port_name, 1);
     fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, clock_port) << ";"
-       << std::endl;
+       << '\n';
     print_verilog_wire_connection(fp, clock_port, clock_source_to_connect,
                                   false);
   }
@@ -789,7 +789,7 @@ static void print_verilog_top_testbench_ports(
   /* Print module definition */
   fp << "module " << circuit_name
      << std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   /* Print regular local wires:
    * 1. global ports, i.e., reset, set and clock signals
@@ -800,38 +800,34 @@ static void print_verilog_top_testbench_ports(
     fp, std::string("----- Local wires for global ports of FPGA fabric -----"));
   for (const BasicPort& module_port : module_manager.module_ports_by_type(
          top_module, ModuleManager::MODULE_GLOBAL_PORT)) {
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";"
-       << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << '\n';
   }
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Datapath I/Os of top-level module  */
   print_verilog_comment(
     fp, std::string("----- Local wires for I/Os of FPGA fabric -----"));
   for (const BasicPort& module_port : module_manager.module_ports_by_type(
          top_module, ModuleManager::MODULE_GPIO_PORT)) {
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";"
-       << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << '\n';
   }
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 
   for (const BasicPort& module_port : module_manager.module_ports_by_type(
          top_module, ModuleManager::MODULE_GPIN_PORT)) {
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";"
-       << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << '\n';
   }
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 
   for (const BasicPort& module_port : module_manager.module_ports_by_type(
          top_module, ModuleManager::MODULE_GPOUT_PORT)) {
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";"
-       << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, module_port) << ";" << '\n';
   }
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Add local wires/registers that drive stimulus
    * We create these general purpose ports here,
@@ -840,18 +836,18 @@ static void print_verilog_top_testbench_ports(
   /* Configuration done port */
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << generate_verilog_port(VERILOG_PORT_REG, config_done_port) << ";"
-     << std::endl;
+     << '\n';
 
   /* Programming clock */
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
   fp << generate_verilog_port(VERILOG_PORT_WIRE, prog_clock_port) << ";"
-     << std::endl;
+     << '\n';
   BasicPort prog_clock_register_port(
     std::string(std::string(TOP_TB_PROG_CLOCK_PORT_NAME) +
                 std::string(TOP_TB_CLOCK_REG_POSTFIX)),
     1);
   fp << generate_verilog_port(VERILOG_PORT_REG, prog_clock_register_port) << ";"
-     << std::endl;
+     << '\n';
 
   /* Multiple operating clocks based on the simulation settings */
   for (const SimulationClockId& sim_clock :
@@ -861,12 +857,12 @@ static void print_verilog_top_testbench_ports(
       simulation_parameters.clock_name(sim_clock));
     BasicPort sim_clock_port(sim_clock_port_name, 1);
     fp << generate_verilog_port(VERILOG_PORT_WIRE, sim_clock_port) << ";"
-       << std::endl;
+       << '\n';
     BasicPort sim_clock_register_port(
       std::string(sim_clock_port_name + std::string(TOP_TB_CLOCK_REG_POSTFIX)),
       1);
     fp << generate_verilog_port(VERILOG_PORT_REG, sim_clock_register_port)
-       << ";" << std::endl;
+       << ";" << '\n';
   }
 
   /* FIXME: Actually, for multi-clock implementations, input and output ports
@@ -877,28 +873,25 @@ static void print_verilog_top_testbench_ports(
    * generator
    */
   BasicPort op_clock_port(std::string(TOP_TB_OP_CLOCK_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, op_clock_port) << ";"
-     << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, op_clock_port) << ";" << '\n';
   BasicPort op_clock_register_port(
     std::string(std::string(TOP_TB_OP_CLOCK_PORT_NAME) +
                 std::string(TOP_TB_CLOCK_REG_POSTFIX)),
     1);
   fp << generate_verilog_port(VERILOG_PORT_REG, op_clock_register_port) << ";"
-     << std::endl;
+     << '\n';
 
   /* Programming set and reset */
   BasicPort prog_reset_port(std::string(TOP_TB_PROG_RESET_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, prog_reset_port) << ";"
-     << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, prog_reset_port) << ";" << '\n';
   BasicPort prog_set_port(std::string(TOP_TB_PROG_SET_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, prog_set_port) << ";"
-     << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, prog_set_port) << ";" << '\n';
 
   /* Global set and reset */
   BasicPort reset_port(std::string(TOP_TB_RESET_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, reset_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, reset_port) << ";" << '\n';
   BasicPort set_port(std::string(TOP_TB_SET_PORT_NAME), 1);
-  fp << generate_verilog_port(VERILOG_PORT_REG, set_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_REG, set_port) << ";" << '\n';
 
   /* Configuration ports depend on the organization of SRAMs */
   print_verilog_top_testbench_config_protocol_port(fp, config_protocol,
@@ -926,7 +919,7 @@ static void print_verilog_top_testbench_ports(
     print_verilog_comment(
       fp, std::string("----- Error counter: Deposit an error for config_done "
                       "signal is not raised at the beginning -----"));
-    fp << "\tinteger " << TOP_TESTBENCH_ERROR_COUNTER << "= 1;" << std::endl;
+    fp << "\tinteger " << TOP_TESTBENCH_ERROR_COUNTER << "= 1;" << '\n';
   }
 }
 
@@ -987,14 +980,14 @@ static size_t calculate_num_config_clock_cycles(
     case CONFIG_MEM_QL_MEMORY_BANK: {
       if (BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) {
         /* For fast configuration, we will skip all the zero data points */
-        num_config_clock_cycles =
-          1 + build_memory_bank_fabric_bitstream_by_address(fabric_bitstream)
-                .size();
+        MemoryBankFabricBitstream fabric_bits_by_addr =
+          build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
+        num_config_clock_cycles = 1 + fabric_bits_by_addr.size();
         if (true == fast_configuration) {
           size_t full_num_config_clock_cycles = num_config_clock_cycles;
           num_config_clock_cycles =
             1 + find_memory_bank_fast_configuration_fabric_bitstream_size(
-                  fabric_bitstream, bit_value_to_skip);
+                  fabric_bits_by_addr, bit_value_to_skip);
           VTR_LOG(
             "Fast configuration reduces number of configuration clock cycles "
             "from %lu to %lu (compression_rate = %f%)\n",
@@ -1005,28 +998,24 @@ static size_t calculate_num_config_clock_cycles(
         }
       } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type()) {
         num_config_clock_cycles =
-          1 + build_memory_bank_flatten_fabric_bitstream(
-                fabric_bitstream, fast_configuration, bit_value_to_skip)
-                .size();
+          1 + find_memory_bank_flatten_fabric_bitstream_size(fabric_bitstream);
       } else if (BLWL_PROTOCOL_SHIFT_REGISTER ==
                  config_protocol.bl_protocol_type()) {
         num_config_clock_cycles =
-          1 + build_memory_bank_flatten_fabric_bitstream(
-                fabric_bitstream, fast_configuration, bit_value_to_skip)
-                .size();
+          1 + find_memory_bank_flatten_fabric_bitstream_size(fabric_bitstream);
       }
       break;
     }
     case CONFIG_MEM_MEMORY_BANK: {
       /* For fast configuration, we will skip all the zero data points */
-      num_config_clock_cycles =
-        1 +
-        build_memory_bank_fabric_bitstream_by_address(fabric_bitstream).size();
+      MemoryBankFabricBitstream fabric_bits_by_addr =
+        build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
+      num_config_clock_cycles = 1 + fabric_bits_by_addr.size();
       if (true == fast_configuration) {
         size_t full_num_config_clock_cycles = num_config_clock_cycles;
         num_config_clock_cycles =
           1 + find_memory_bank_fast_configuration_fabric_bitstream_size(
-                fabric_bitstream, bit_value_to_skip);
+                fabric_bits_by_addr, bit_value_to_skip);
         VTR_LOG(
           "Fast configuration reduces number of configuration clock cycles "
           "from %lu to %lu (compression_rate = %f%)\n",
@@ -1038,14 +1027,14 @@ static size_t calculate_num_config_clock_cycles(
       break;
     }
     case CONFIG_MEM_FRAME_BASED: {
-      num_config_clock_cycles =
-        1 +
-        build_frame_based_fabric_bitstream_by_address(fabric_bitstream).size();
+      FrameFabricBitstream fabric_bits_by_addr =
+        build_frame_based_fabric_bitstream_by_address(fabric_bitstream);
+      num_config_clock_cycles = 1 + fabric_bits_by_addr.size();
       if (true == fast_configuration) {
         size_t full_num_config_clock_cycles = num_config_clock_cycles;
         num_config_clock_cycles =
           1 + find_frame_based_fast_configuration_fabric_bitstream_size(
-                fabric_bitstream, bit_value_to_skip);
+                fabric_bits_by_addr, bit_value_to_skip);
         VTR_LOG(
           "Fast configuration reduces number of configuration clock cycles "
           "from %lu to %lu (compression_rate = %f%)\n",
@@ -1095,7 +1084,7 @@ static void print_verilog_top_testbench_benchmark_instance(
     fp, std::string("----- End reference Benchmark Instanication -------"));
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -1148,7 +1137,7 @@ static void print_verilog_top_testbench_generic_stimulus(
     num_config_clock_cycles * prog_clock_period / timescale, 0);
   print_verilog_comment(fp,
                         "----- End configuration done signal generation -----");
-  fp << std::endl;
+  fp << '\n';
 
   /* Generate stimuli waveform for programming clock signals */
   print_verilog_comment(
@@ -1158,7 +1147,7 @@ static void print_verilog_top_testbench_generic_stimulus(
     0.5 * prog_clock_period / timescale, std::string());
   print_verilog_comment(
     fp, "----- End raw programming clock signal generation -----");
-  fp << std::endl;
+  fp << '\n';
 
   /* Programming clock should be only enabled during programming phase.
    * When configuration is done (config_done is enabled), programming clock
@@ -1176,9 +1165,9 @@ static void print_verilog_top_testbench_generic_stimulus(
      << ")";
   fp << " & (~" << generate_verilog_port(VERILOG_PORT_CONKT, prog_reset_port)
      << ")";
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
-  fp << std::endl;
+  fp << '\n';
 
   /* Generate stimuli waveform for multiple user-defined operating clock signals
    */
@@ -1216,9 +1205,9 @@ static void print_verilog_top_testbench_generic_stimulus(
     fp << " = "
        << generate_verilog_port(VERILOG_PORT_CONKT, sim_clock_register_port);
     fp << " & " << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port);
-    fp << ";" << std::endl;
+    fp << ";" << '\n';
 
-    fp << std::endl;
+    fp << '\n';
   }
 
   /* Generate stimuli waveform for operating clock signals */
@@ -1241,9 +1230,9 @@ static void print_verilog_top_testbench_generic_stimulus(
   fp << " = "
      << generate_verilog_port(VERILOG_PORT_CONKT, op_clock_register_port);
   fp << " & " << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
-  fp << std::endl;
+  fp << '\n';
 
   /* Reset signal for configuration circuit:
    * only enable during the first clock cycle in programming phase
@@ -1255,7 +1244,7 @@ static void print_verilog_top_testbench_generic_stimulus(
   print_verilog_comment(fp,
                         "----- End programming reset signal generation -----");
 
-  fp << std::endl;
+  fp << '\n';
 
   /* Programming set signal for configuration circuit : always disabled */
   print_verilog_comment(fp,
@@ -1265,7 +1254,7 @@ static void print_verilog_top_testbench_generic_stimulus(
   print_verilog_comment(fp,
                         "----- End programming set signal generation -----");
 
-  fp << std::endl;
+  fp << '\n';
 
   /* Operating reset signals: only enabled during the first clock cycle in
    * operation phase */
@@ -1295,7 +1284,7 @@ static void print_verilog_top_testbench_generic_stimulus(
   print_verilog_comment(
     fp, "----- End operating set signal generation: always disabled -----");
 
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -1361,8 +1350,8 @@ static int print_verilog_top_testbench_configuration_protocol_stimulus(
  *******************************************************************/
 static void print_verilog_full_testbench_vanilla_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const FabricBitstream& fabric_bitstream) {
+  const bool& hex_bitstream, const ModuleManager& module_manager,
+  const ModuleId& top_module, const FabricBitstream& fabric_bitstream) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -1387,7 +1376,7 @@ static void print_verilog_full_testbench_vanilla_bitstream(
     fp, "----- Virtual memory to store the bitstream from external file -----");
   fp << "reg [0:`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE << " - 1] ";
   fp << TOP_TB_BITSTREAM_MEM_REG_NAME << "[0:0];";
-  fp << std::endl;
+  fp << '\n';
 
   /* Initial value should be the first configuration bits
    * In the rest of programming cycles,
@@ -1400,54 +1389,54 @@ static void print_verilog_full_testbench_vanilla_bitstream(
 
   print_verilog_comment(
     fp, "----- Begin bitstream loading during configuration phase -----");
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial" << '\n';
+  fp << "\tbegin" << '\n';
   print_verilog_comment(fp, "----- Configuration chain default input -----");
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(bl_port, initial_bl_values);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(wl_port, initial_wl_values);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   print_verilog_comment(
     fp, "----- Preload bitstream file to a virtual memory -----");
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", "
-     << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
-  fp << std::endl;
+  fp << (hex_bitstream ? "$readmemh" : "$readmemb") << "(\""
+     << bitstream_file << "\", " << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  fp << '\n';
 
   fp << "\t\t@(negedge "
      << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ") begin"
-     << std::endl;
+     << '\n';
 
   /* Enable all the WLs */
   std::vector<size_t> enabled_wl_values(wl_port.get_width(), 1);
   fp << "\t\t\t";
   fp << generate_verilog_port_constant_values(wl_port, enabled_wl_values);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t\t\t";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, bl_port);
   fp << " <= ";
   fp << TOP_TB_BITSTREAM_MEM_REG_NAME << "[0]";
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
-  fp << "\t\tend" << std::endl;
+  fp << "\t\tend" << '\n';
 
   /* Disable all the WLs */
   fp << "\t\t@(negedge "
      << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");"
-     << std::endl;
+     << '\n';
 
   fp << "\t\t\t";
   fp << generate_verilog_port_constant_values(wl_port, initial_wl_values);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   /* Raise the flag of configuration done when bitstream loading is complete */
   fp << "\t\t@(negedge "
      << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ");"
-     << std::endl;
+     << '\n';
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << "\t\t\t";
@@ -1456,9 +1445,9 @@ static void print_verilog_full_testbench_vanilla_bitstream(
   std::vector<size_t> config_done_enable_values(config_done_port.get_width(),
                                                 1);
   fp << generate_verilog_constant_values(config_done_enable_values);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << '\n';
   print_verilog_comment(
     fp, "----- End bitstream loading during configuration phase -----");
 }
@@ -1476,9 +1465,9 @@ static void print_verilog_full_testbench_vanilla_bitstream(
  *******************************************************************/
 static void print_verilog_full_testbench_configuration_chain_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
+  const bool& hex_bitstream, const size_t& bitstream_length,
   const bool& fast_configuration, const bool& bit_value_to_skip,
   const ModuleManager& module_manager, const ModuleId& top_module,
-  const BitstreamManager& bitstream_manager,
   const FabricBitstream& fabric_bitstream) {
   /* Validate the file stream */
   valid_file_stream(fp);
@@ -1486,22 +1475,13 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
   print_verilog_comment(
     fp, "----- Begin bitstream loading during configuration phase -----");
 
-  /* Find the longest bitstream */
-  size_t regional_bitstream_max_size =
-    find_fabric_regional_bitstream_max_size(fabric_bitstream);
-
-  /* For fast configuration, the bitstream size counts from the first bit '1' */
-  size_t num_bits_to_skip = 0;
-  if (true == fast_configuration) {
-    num_bits_to_skip =
-      find_configuration_chain_fabric_bitstream_size_to_be_skipped(
-        fabric_bitstream, bitstream_manager, bit_value_to_skip);
-  }
-  VTR_ASSERT(num_bits_to_skip < regional_bitstream_max_size);
+  /* The bitstream size is given, which counts from the first bit '1' for
+   * fast configuration */
+  VTR_ASSERT(0 < bitstream_length);
 
   /* Define a constant for the bitstream length */
   print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_LENGTH_VARIABLE),
-                            regional_bitstream_max_size - num_bits_to_skip);
+                            bitstream_length);
   print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_WIDTH_VARIABLE),
                             fabric_bitstream.num_regions());
 
@@ -1523,38 +1503,37 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
   fp << "reg [0:`" << TOP_TB_BITSTREAM_WIDTH_VARIABLE << " - 1] ";
   fp << TOP_TB_BITSTREAM_MEM_REG_NAME << "[0:`"
      << TOP_TB_BITSTREAM_LENGTH_VARIABLE << " - 1];";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "reg [$clog2(`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE << "):0] "
-     << TOP_TB_BITSTREAM_INDEX_REG_NAME << ";" << std::endl;
+     << TOP_TB_BITSTREAM_INDEX_REG_NAME << ";" << '\n';
 
   BasicPort bit_skip_reg(TOP_TB_BITSTREAM_SKIP_FLAG_REG_NAME, 1);
   print_verilog_comment(
     fp, "----- Registers used for fast configuration logic -----");
   fp << "reg [$clog2(`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE << "):0] "
-     << TOP_TB_BITSTREAM_ITERATOR_REG_NAME << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_REG, bit_skip_reg) << ";"
-     << std::endl;
+     << TOP_TB_BITSTREAM_ITERATOR_REG_NAME << ";" << '\n';
+  fp << generate_verilog_port(VERILOG_PORT_REG, bit_skip_reg) << ";" << '\n';
 
   print_verilog_comment(
     fp, "----- Preload bitstream file to a virtual memory -----");
-  fp << "initial begin" << std::endl;
+  fp << "initial begin" << '\n';
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", "
-     << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
-  fp << std::endl;
+  fp << (hex_bitstream ? "$readmemh" : "$readmemb") << "(\""
+     << bitstream_file << "\", " << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  fp << '\n';
 
   print_verilog_comment(fp, "----- Configuration chain default input -----");
   fp << "\t";
   fp << generate_verilog_port_constant_values(config_chain_head_port,
                                               initial_values, true);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME << " <= 0";
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   std::vector<size_t> bit_skip_values(bit_skip_reg.get_width(),
                                       fast_configuration ? 1 : 0);
@@ -1562,7 +1541,7 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
   fp << generate_verilog_port_constant_values(bit_skip_reg, bit_skip_values,
                                               true);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << "for (" << TOP_TB_BITSTREAM_ITERATOR_REG_NAME << " = 0; ";
@@ -1571,7 +1550,7 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
   fp << TOP_TB_BITSTREAM_ITERATOR_REG_NAME << " = "
      << TOP_TB_BITSTREAM_ITERATOR_REG_NAME << " + 1)";
   fp << " begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << "if (";
@@ -1582,7 +1561,7 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
      << TOP_TB_BITSTREAM_ITERATOR_REG_NAME << "]";
   fp << ")";
   fp << " begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t\t";
   fp << "if (";
@@ -1591,37 +1570,37 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
   fp << " == ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, bit_skip_reg) << ")";
   fp << " begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t\t\t";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME;
   fp << " <= ";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME << " + 1";
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t\t\t";
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << "end else begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t\t";
   fp << generate_verilog_port_constant_values(
     bit_skip_reg, std::vector<size_t>(bit_skip_reg.get_width(), 0), true);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t\t";
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME) +
                               std::string(TOP_TB_CLOCK_REG_POSTFIX),
@@ -1633,7 +1612,7 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
   fp << " @(negedge "
      << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ")";
   fp << " begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << "if (";
@@ -1641,14 +1620,14 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
   fp << " >= ";
   fp << "`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE;
   fp << ") begin";
-  fp << std::endl;
+  fp << '\n';
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << "\t\t";
   std::vector<size_t> config_done_final_values(config_done_port.get_width(), 1);
   fp << generate_verilog_port_constant_values(config_done_port,
                                               config_done_final_values, true);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
   fp << "end else if (";
@@ -1658,27 +1637,27 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
   fp << " < ";
   fp << "`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE;
   fp << ") begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, config_chain_head_port);
   fp << " <= ";
   fp << TOP_TB_BITSTREAM_MEM_REG_NAME << "[" << TOP_TB_BITSTREAM_INDEX_REG_NAME
      << "]";
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t\t";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME;
   fp << " <= ";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME << " + 1";
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(
     fp, "----- End bitstream loading during configuration phase -----");
@@ -1690,25 +1669,14 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
  *******************************************************************/
 static void print_verilog_full_testbench_memory_bank_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const bool& fast_configuration, const bool& bit_value_to_skip,
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const FabricBitstream& fabric_bitstream) {
+  const bool& hex_bitstream, const size_t& bitstream_length,
+  const ModuleManager& module_manager, const ModuleId& top_module) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  /* Reorganize the fabric bitstream by the same address across regions */
-  MemoryBankFabricBitstream fabric_bits_by_addr =
-    build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
-
-  /* For fast configuration, identify the final bitstream size to be used */
-  size_t num_bits_to_skip = 0;
-  if (true == fast_configuration) {
-    num_bits_to_skip =
-      fabric_bits_by_addr.size() -
-      find_memory_bank_fast_configuration_fabric_bitstream_size(
-        fabric_bitstream, bit_value_to_skip);
-  }
-  VTR_ASSERT(num_bits_to_skip < fabric_bits_by_addr.size());
+  /* The bitstream is organized by the same address across regions, whose
+   * size, considering fast configuration, is given */
+  VTR_ASSERT(0 < bitstream_length);
 
   /* Feed address and data input pair one by one
    * Note: the first cycle is reserved for programming reset
@@ -1733,7 +1701,7 @@ static void print_verilog_full_testbench_memory_bank_bitstream(
 
   /* Define a constant for the bitstream length */
   print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_LENGTH_VARIABLE),
-                            fabric_bits_by_addr.size() - num_bits_to_skip);
+                            bitstream_length);
   print_verilog_define_flag(
     fp, std::string(TOP_TB_BITSTREAM_WIDTH_VARIABLE),
     bl_addr_port.get_width() + wl_addr_port.get_width() + din_port.get_width());
@@ -1744,46 +1712,46 @@ static void print_verilog_full_testbench_memory_bank_bitstream(
   fp << "reg [0:`" << TOP_TB_BITSTREAM_WIDTH_VARIABLE << " - 1] ";
   fp << TOP_TB_BITSTREAM_MEM_REG_NAME << "[0:`"
      << TOP_TB_BITSTREAM_LENGTH_VARIABLE << " - 1];";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "reg [$clog2(`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE << "):0] "
-     << TOP_TB_BITSTREAM_INDEX_REG_NAME << ";" << std::endl;
+     << TOP_TB_BITSTREAM_INDEX_REG_NAME << ";" << '\n';
 
   print_verilog_comment(
     fp, "----- Preload bitstream file to a virtual memory -----");
-  fp << "initial begin" << std::endl;
+  fp << "initial begin" << '\n';
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", "
-     << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
-  fp << std::endl;
+  fp << (hex_bitstream ? "$readmemh" : "$readmemb") << "(\""
+     << bitstream_file << "\", " << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  fp << '\n';
 
   print_verilog_comment(fp, "----- Bit-Line Address port default input -----");
   fp << "\t";
   fp << generate_verilog_port_constant_values(bl_addr_port,
                                               initial_bl_addr_values);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(fp, "----- Word-Line Address port default input -----");
   fp << "\t";
   fp << generate_verilog_port_constant_values(wl_addr_port,
                                               initial_wl_addr_values);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(fp, "----- Data-input port default input -----");
   fp << "\t";
   fp << generate_verilog_port_constant_values(din_port, initial_din_values);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME << " <= 0";
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(
     fp, "----- Begin bitstream loading during configuration phase -----");
@@ -1794,7 +1762,7 @@ static void print_verilog_full_testbench_memory_bank_bitstream(
   fp << " @(negedge "
      << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ")";
   fp << " begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << "if (";
@@ -1802,18 +1770,18 @@ static void print_verilog_full_testbench_memory_bank_bitstream(
   fp << " >= ";
   fp << "`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE;
   fp << ") begin";
-  fp << std::endl;
+  fp << '\n';
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << "\t\t";
   std::vector<size_t> config_done_final_values(config_done_port.get_width(), 1);
   fp << generate_verilog_port_constant_values(config_done_port,
                                               config_done_final_values, true);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
   fp << "end else begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << "{";
@@ -1826,20 +1794,20 @@ static void print_verilog_full_testbench_memory_bank_bitstream(
   fp << " <= ";
   fp << TOP_TB_BITSTREAM_MEM_REG_NAME << "[" << TOP_TB_BITSTREAM_INDEX_REG_NAME
      << "]";
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t\t";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME;
   fp << " <= ";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME << " + 1";
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(
     fp, "----- End bitstream loading during configuration phase -----");
@@ -1851,25 +1819,14 @@ static void print_verilog_full_testbench_memory_bank_bitstream(
  *******************************************************************/
 static void print_verilog_full_testbench_frame_decoder_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const bool& fast_configuration, const bool& bit_value_to_skip,
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const FabricBitstream& fabric_bitstream) {
+  const bool& hex_bitstream, const size_t& bitstream_length,
+  const ModuleManager& module_manager, const ModuleId& top_module) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  /* Reorganize the fabric bitstream by the same address across regions */
-  FrameFabricBitstream fabric_bits_by_addr =
-    build_frame_based_fabric_bitstream_by_address(fabric_bitstream);
-
-  /* For fast configuration, identify the final bitstream size to be used */
-  size_t num_bits_to_skip = 0;
-  if (true == fast_configuration) {
-    num_bits_to_skip =
-      fabric_bits_by_addr.size() -
-      find_frame_based_fast_configuration_fabric_bitstream_size(
-        fabric_bitstream, bit_value_to_skip);
-  }
-  VTR_ASSERT(num_bits_to_skip < fabric_bits_by_addr.size());
+  /* The bitstream is organized by the same address across regions, whose
+   * size, considering fast configuration, is given */
+  VTR_ASSERT(0 < bitstream_length);
 
   /* Feed address and data input pair one by one
    * Note: the first cycle is reserved for programming reset
@@ -1887,7 +1844,7 @@ static void print_verilog_full_testbench_frame_decoder_bitstream(
 
   /* Define a constant for the bitstream length */
   print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_LENGTH_VARIABLE),
-                            fabric_bits_by_addr.size() - num_bits_to_skip);
+                            bitstream_length);
   print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_WIDTH_VARIABLE),
                             addr_port.get_width() + din_port.get_width());
 
@@ -1897,38 +1854,38 @@ static void print_verilog_full_testbench_frame_decoder_bitstream(
   fp << "reg [0:`" << TOP_TB_BITSTREAM_WIDTH_VARIABLE << " - 1] ";
   fp << TOP_TB_BITSTREAM_MEM_REG_NAME << "[0:`"
      << TOP_TB_BITSTREAM_LENGTH_VARIABLE << " - 1];";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "reg [$clog2(`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE << "):0] "
-     << TOP_TB_BITSTREAM_INDEX_REG_NAME << ";" << std::endl;
+     << TOP_TB_BITSTREAM_INDEX_REG_NAME << ";" << '\n';
 
   print_verilog_comment(
     fp, "----- Preload bitstream file to a virtual memory -----");
-  fp << "initial begin" << std::endl;
+  fp << "initial begin" << '\n';
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", "
-     << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
-  fp << std::endl;
+  fp << (hex_bitstream ? "$readmemh" : "$readmemb") << "(\""
+     << bitstream_file << "\", " << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  fp << '\n';
 
   print_verilog_comment(fp, "----- Address port default input -----");
   fp << "\t";
   fp << generate_verilog_port_constant_values(addr_port, initial_addr_values);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(fp, "----- Data-input port default input -----");
   fp << "\t";
   fp << generate_verilog_port_constant_values(din_port, initial_din_values);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME << " <= 0";
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(
     fp, "----- Begin bitstream loading during configuration phase -----");
@@ -1939,7 +1896,7 @@ static void print_verilog_full_testbench_frame_decoder_bitstream(
   fp << " @(negedge "
      << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ")";
   fp << " begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << "if (";
@@ -1947,18 +1904,18 @@ static void print_verilog_full_testbench_frame_decoder_bitstream(
   fp << " >= ";
   fp << "`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE;
   fp << ") begin";
-  fp << std::endl;
+  fp << '\n';
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << "\t\t";
   std::vector<size_t> config_done_final_values(config_done_port.get_width(), 1);
   fp << generate_verilog_port_constant_values(config_done_port,
                                               config_done_final_values, true);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
   fp << "end else begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << "{";
@@ -1969,20 +1926,20 @@ static void print_verilog_full_testbench_frame_decoder_bitstream(
   fp << " <= ";
   fp << TOP_TB_BITSTREAM_MEM_REG_NAME << "[" << TOP_TB_BITSTREAM_INDEX_REG_NAME
      << "]";
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t\t";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME;
   fp << " <= ";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME << " + 1";
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(
     fp, "----- End bitstream loading during configuration phase -----");
@@ -1996,38 +1953,40 @@ static void print_verilog_full_testbench_frame_decoder_bitstream(
  *******************************************************************/
 static void print_verilog_full_testbench_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const ConfigProtocol& config_protocol, const bool& fast_configuration,
+  const bool& hex_bitstream, const ConfigProtocol& config_protocol,
+  const size_t& bitstream_length, const bool& fast_configuration,
   const bool& bit_value_to_skip, const ModuleManager& module_manager,
-  const ModuleId& top_module, const BitstreamManager& bitstream_manager,
-  const FabricBitstream& fabric_bitstream,
+  const ModuleId& top_module, const FabricBitstream& fabric_bitstream,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks) {
   /* Branch on the type of configuration protocol */
   switch (config_protocol.type()) {
     case CONFIG_MEM_STANDALONE:
       print_verilog_full_testbench_vanilla_bitstream(
-        fp, bitstream_file, module_manager, top_module, fabric_bitstream);
+        fp, bitstream_file, hex_bitstream, module_manager, top_module,
+        fabric_bitstream);
 
       break;
     case CONFIG_MEM_SCAN_CHAIN:
       print_verilog_full_testbench_configuration_chain_bitstream(
-        fp, bitstream_file, fast_configuration, bit_value_to_skip,
-        module_manager, top_module, bitstream_manager, fabric_bitstream);
+        fp, bitstream_file, hex_bitstream, bitstream_length,
+        fast_configuration, bit_value_to_skip, module_manager, top_module,
+        fabric_bitstream);
       break;
     case CONFIG_MEM_MEMORY_BANK:
       print_verilog_full_testbench_memory_bank_bitstream(
-        fp, bitstream_file, fast_configuration, bit_value_to_skip,
-        module_manager, top_module, fabric_bitstream);
+        fp, bitstream_file, hex_bitstream, bitstream_length, module_manager,
+        top_module);
       break;
     case CONFIG_MEM_QL_MEMORY_BANK:
       print_verilog_full_testbench_ql_memory_bank_bitstream(
-        fp, bitstream_file, config_protocol, fast_configuration,
-        bit_value_to_skip, module_manager, top_module, fabric_bitstream,
-        blwl_sr_banks);
+        fp, bitstream_file, hex_bitstream, config_protocol, bitstream_length,
+        fast_configuration, bit_value_to_skip, module_manager, top_module,
+        fabric_bitstream, blwl_sr_banks);
       break;
     case CONFIG_MEM_FRAME_BASED:
       print_verilog_full_testbench_frame_decoder_bitstream(
-        fp, bitstream_file, fast_configuration, bit_value_to_skip,
-        module_manager, top_module, fabric_bitstream);
+        fp, bitstream_file, hex_bitstream, bitstream_length, module_manager,
+        top_module);
 
       break;
     default:
@@ -2037,6 +1996,99 @@ static void print_verilog_full_testbench_bitstream(
   }
 }
 
+/********************************************************************
+ * Print the codes of the full testbench which only depend on the FPGA
+ * fabric, i.e., the FPGA instance and the signal initialization per
+ * instance, to a netlist which is included by the full testbench.
+ * The netlist is written only when it does not exist, so that the full
+ * testbenches of many designs share it and it is written only once.
+ * Note that the netlist should be removed when the fabric or the
+ * options of the full testbench are changed.
+ *******************************************************************/
+static void print_verilog_full_testbench_fabric_netlist(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleId& top_module, const CircuitLibrary& circuit_lib,
+  const std::string& fabric_testbench_fname,
+  const VerilogTestbenchOption& options) {
+  std::ifstream existing_fp(fabric_testbench_fname);
+  if (true == existing_fp.good()) {
+    VTR_LOG("Reuse the existing fabric testbench netlist '%s'\n",
+            fabric_testbench_fname.c_str());
+  } else {
+    BufferedFileStream fabric_fp;
+    fabric_fp.open(fabric_testbench_fname,
+                   std::fstream::out | std::fstream::trunc);
+    check_file_stream(fabric_testbench_fname.c_str(), fabric_fp);
+
+    print_verilog_comment(
+      fabric_fp,
+      std::string("----- FPGA Verilog full testbench codes shared by all the "
+                  "designs -----"));
+    print_verilog_testbench_fpga_instance(
+      fabric_fp, module_manager, top_module,
+      std::string(TOP_TESTBENCH_FPGA_INSTANCE_NAME), std::string(),
+      options.explicit_port_mapping());
+
+    if ((true == options.include_signal_init()) &&
+        (false == options.signal_init_per_module())) {
+      print_verilog_testbench_signal_initialization(
+        fabric_fp, std::string(TOP_TESTBENCH_FPGA_INSTANCE_NAME), circuit_lib,
+        module_manager, top_module, true);
+    }
+
+    fabric_fp.close();
+  }
+  existing_fp.close();
+
+  std::string fabric_testbench_include_path = fabric_testbench_fname;
+  if (true == options.use_relative_path()) {
+    fabric_testbench_include_path = find_path_file_name(fabric_testbench_fname);
+  }
+  print_verilog_include_netlist(fp, fabric_testbench_include_path);
+  fp << '\n';
+}
+
+/********************************************************************
+ * Impose the bitstream on the configuration memories of the FPGA fabric
+ * through a backdoor, i.e., hierarchical paths to the configuration
+ * blocks, once the configuration phase is done. Therefore, the
+ * configuration protocol is bypassed and the configuration phase can be
+ * cut down to a few clock cycles.
+ * The bit values are loaded from a memory image, whose lines follow the
+ * configuration blocks of the bitstream manager.
+ * We branch here for different simulators:
+ * 1. iVerilog Icarus prefers using 'force' syntax to impose the values
+ * 2. Mentor Modelsim prefers using '$deposit' syntax to do so
+ *******************************************************************/
+static void print_verilog_full_testbench_backdoor_bitstream(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleId& top_module, const CircuitLibrary& circuit_lib,
+  const ConfigProtocol& config_protocol,
+  const BitstreamManager& bitstream_manager,
+  const e_embedded_bitstream_hdl_type& embedded_bitstream_hdl_type,
+  const std::string& image_fname, const std::string& image_include_path) {
+  /* Skip the datab port if there is only 1 output port in memory model,
+   * following the same rule as the pre-configured wrapper */
+  CircuitModelId mem_model = config_protocol.memory_model();
+  VTR_ASSERT(true == circuit_lib.valid_model_id(mem_model));
+  bool output_datab_bits = true;
+  if (1 == circuit_lib.model_ports_by_type(mem_model, CIRCUIT_MODEL_PORT_OUTPUT)
+             .size()) {
+    output_datab_bits = false;
+  }
+
+  std::string load_event =
+    std::string("@(posedge ") + std::string(TOP_TB_CONFIG_DONE_PORT_NAME) +
+    std::string(");");
+
+  print_verilog_testbench_memory_image_bitstream(
+    fp, module_manager, top_module, bitstream_manager,
+    std::string(TOP_TESTBENCH_FPGA_INSTANCE_NAME),
+    std::string(TOP_TB_BACKDOOR_BITSTREAM_MEM_NAME), load_event,
+    output_datab_bits, embedded_bitstream_hdl_type, image_fname,
+    image_include_path);
+}
+
 /********************************************************************
  * Connect proper stimuli to the reset port
  * This function is designed to drive the reset port of a benchmark module
@@ -2113,17 +2165,16 @@ static void print_verilog_top_testbench_check(
   write_tab_to_file(fp, 1);
   fp << "always@(posedge "
      << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port) << ") begin"
-     << std::endl;
+     << '\n';
 
   write_tab_to_file(fp, 2);
-  fp << error_counter_name << " = " << error_counter_name << " - 1;"
-     << std::endl;
+  fp << error_counter_name << " = " << error_counter_name << " - 1;" << '\n';
 
   write_tab_to_file(fp, 1);
-  fp << "end" << std::endl;
+  fp << "end" << '\n';
 
   /* Add an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -2157,6 +2208,8 @@ int print_verilog_full_testbench(
   const IoLocationMap& io_location_map,
   const VprNetlistAnnotation& netlist_annotation,
   const std::string& circuit_name, const std::string& verilog_fname,
+  const std::string& backdoor_bitstream_fname,
+  const std::string& fabric_testbench_fname,
   const SimulationSetting& simulation_parameters,
   const VerilogTestbenchOption& options) {
   bool fast_configuration = options.fast_configuration();
@@ -2169,9 +2222,10 @@ int print_verilog_full_testbench(
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
@@ -2233,9 +2287,19 @@ int print_verilog_full_testbench(
     config_protocol, apply_fast_configuration, bit_value_to_skip,
     bitstream_manager, fabric_bitstream);
 
+  /* The backdoor loader imposes the bitstream in zero time, so that the
+   * configuration phase is cut down to the programming reset cycle and a
+   * cycle to impose the bitstream. The stimulus of the configuration
+   * protocol is kept as it is, while its clock stops with the phase */
+  size_t num_sim_config_clock_cycles = num_config_clock_cycles;
+  if (true == options.backdoor_configuration()) {
+    num_sim_config_clock_cycles = std::min(
+      num_config_clock_cycles, TOP_TB_BACKDOOR_NUM_CONFIG_CLOCK_CYCLES);
+  }
+
   /* Generate stimuli for general control signals */
   print_verilog_top_testbench_generic_stimulus(
-    fp, simulation_parameters, num_config_clock_cycles, prog_clock_period,
+    fp, simulation_parameters, num_sim_config_clock_cycles, prog_clock_period,
     default_op_clock_period, VERILOG_SIM_TIMESCALE);
 
   /* Generate stimuli for programming interface */
@@ -2279,11 +2343,18 @@ int print_verilog_full_testbench(
     fp, module_manager, top_module, pin_constraints, global_ports,
     simulation_parameters, active_global_prog_reset, active_global_prog_set);
 
-  /* Instanciate FPGA top-level module */
-  print_verilog_testbench_fpga_instance(
-    fp, module_manager, top_module,
-    std::string(TOP_TESTBENCH_FPGA_INSTANCE_NAME), std::string(),
-    explicit_port_mapping);
+  /* Instanciate FPGA top-level module, or include it from the netlist which
+   * is shared by the full testbenches of all the designs */
+  if (true == options.reuse_fabric_testbench()) {
+    print_verilog_full_testbench_fabric_netlist(
+      fp, module_manager, top_module, circuit_lib, fabric_testbench_fname,
+      options);
+  } else {
+    print_verilog_testbench_fpga_instance(
+      fp, module_manager, top_module,
+      std::string(TOP_TESTBENCH_FPGA_INSTANCE_NAME), std::string(),
+      explicit_port_mapping);
+  }
 
   /* Connect I/Os to benchmark I/Os or constant driver */
   print_verilog_testbench_connect_fpga_ios(
@@ -2301,16 +2372,34 @@ int print_verilog_full_testbench(
   }
 
   /* load bitstream to FPGA fabric in a configuration phase */
+  /* The bitstream to load is sized once when estimating the number of
+   * configuration clock cycles, where the first cycle is for reset */
   print_verilog_full_testbench_bitstream(
-    fp, bitstream_file, config_protocol, apply_fast_configuration,
-    bit_value_to_skip, module_manager, top_module, bitstream_manager,
-    fabric_bitstream, blwl_sr_banks);
+    fp, bitstream_file, options.hex_bitstream(), config_protocol,
+    num_config_clock_cycles - 1, apply_fast_configuration, bit_value_to_skip,
+    module_manager, top_module, fabric_bitstream, blwl_sr_banks);
+
+  /* Impose the bitstream on the configuration memories through the backdoor
+   */
+  if (true == options.backdoor_configuration()) {
+    std::string backdoor_bitstream_include_path = backdoor_bitstream_fname;
+    if (true == options.use_relative_path()) {
+      backdoor_bitstream_include_path =
+        find_path_file_name(backdoor_bitstream_fname);
+    }
+    print_verilog_full_testbench_backdoor_bitstream(
+      fp, module_manager, top_module, circuit_lib, config_protocol,
+      bitstream_manager, options.embedded_bitstream_hdl_type(),
+      backdoor_bitstream_fname, backdoor_bitstream_include_path);
+  }
 
   /* Add signal initialization:
    * Bypass writing codes to files due to the autogenerated codes are very
-   * large.
+   * large. The shared fabric netlist already includes them
    */
-  if (true == options.include_signal_init()) {
+  if ((true == options.include_signal_init()) &&
+      (false == options.signal_init_per_module()) &&
+      (false == options.reuse_fabric_testbench())) {
     print_verilog_testbench_signal_initialization(
       fp, std::string(TOP_TESTBENCH_FPGA_INSTANCE_NAME), circuit_lib,
       module_manager, top_module, true);
@@ -2328,7 +2417,8 @@ int print_verilog_full_testbench(
     std::string(TOP_TESTBENCH_CHECKFLAG_PORT_POSTFIX),
     std::vector<BasicPort>(
       1, BasicPort(std::string(TOP_TB_OP_CLOCK_PORT_NAME), 1)),
-    options.no_self_checking());
+    options.no_self_checking(), options.vectorized_stimulus(),
+    options.stimulus_vector_file(), simulation_parameters.num_clock_cycles());
 
   if (!options.no_self_checking()) {
     /* Add output autocheck */
@@ -2349,7 +2439,7 @@ int print_verilog_full_testbench(
 
   /* Find simulation time */
   float simulation_time = find_simulation_time_period(
-    VERILOG_SIM_TIMESCALE, num_config_clock_cycles,
+    VERILOG_SIM_TIMESCALE, num_sim_config_clock_cycles,
     1. / simulation_parameters.programming_clock_frequency(),
     simulation_parameters.num_clock_cycles(),
     1. / simulation_parameters.default_operating_clock_frequency());
@@ -2372,6 +2462,15 @@ int print_verilog_full_testbench(
     fp, std::string(circuit_name) +
           std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX));
 
+  /* Add signal initialization per primitive module, which is bound to the
+   * primitive modules outside the testbench module
+   */
+  if ((true == options.include_signal_init()) &&
+      (true == options.signal_init_per_module())) {
+    print_verilog_testbench_signal_initialization_per_module(
+      fp, circuit_lib, module_manager, true);
+  }
+
   /* Close the file stream */
   fp.close();
 
@@ -41,6 +41,8 @@ int print_verilog_full_testbench(
   const IoLocationMap& io_location_map,
   const VprNetlistAnnotation& netlist_annotation,
   const std::string& circuit_name, const std::string& verilog_fname,
+  const std::string& backdoor_bitstream_fname,
+  const std::string& fabric_testbench_fname,
   const SimulationSetting& simulation_parameters,
   const VerilogTestbenchOption& options);
 
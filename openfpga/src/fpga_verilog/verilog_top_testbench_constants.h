@@ -1,6 +1,8 @@
 #ifndef VERILOG_TOP_TESTBENCH_CONSTANTS
 #define VERILOG_TOP_TESTBENCH_CONSTANTS
 
+#include <cstddef>
+
 /* begin namespace openfpga */
 namespace openfpga {
 
@@ -34,6 +36,10 @@ constexpr const char* TOP_TB_BITSTREAM_MEM_REG_NAME = "bit_mem";
 constexpr const char* TOP_TB_BITSTREAM_INDEX_REG_NAME = "bit_index";
 constexpr const char* TOP_TB_BITSTREAM_ITERATOR_REG_NAME = "ibit";
 constexpr const char* TOP_TB_BITSTREAM_SKIP_FLAG_REG_NAME = "skip_bits";
+constexpr const char* TOP_TB_BACKDOOR_BITSTREAM_MEM_NAME =
+  "backdoor_bitstream_mem";
+/* Programming reset cycle and the cycle to impose the bitstream */
+constexpr size_t TOP_TB_BACKDOOR_NUM_CONFIG_CLOCK_CYCLES = 2;
 
 constexpr const char* AUTOCHECK_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX =
   "_autocheck_top_tb";
@@ -69,8 +69,7 @@ void print_verilog_top_testbench_ql_memory_bank_port(
     BasicPort bl_addr_port =
       module_manager.module_port(top_module, bl_addr_port_id);
 
-    fp << generate_verilog_port(VERILOG_PORT_REG, bl_addr_port) << ";"
-       << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_REG, bl_addr_port) << ";" << '\n';
   } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type()) {
     print_verilog_comment(fp, std::string("---- Bit-Line ports -----"));
     for (const ConfigRegionId& region : module_manager.regions(top_module)) {
@@ -78,8 +77,7 @@ void print_verilog_top_testbench_ql_memory_bank_port(
         top_module, generate_regional_blwl_port_name(
                       std::string(MEMORY_BL_PORT_NAME), region));
       BasicPort bl_port = module_manager.module_port(top_module, bl_port_id);
-      fp << generate_verilog_port(VERILOG_PORT_REG, bl_port) << ";"
-         << std::endl;
+      fp << generate_verilog_port(VERILOG_PORT_REG, bl_port) << ";" << '\n';
     }
   } else {
     VTR_ASSERT(BLWL_PROTOCOL_SHIFT_REGISTER ==
@@ -92,7 +90,7 @@ void print_verilog_top_testbench_ql_memory_bank_port(
       BasicPort sr_head_port =
         module_manager.module_port(top_module, sr_head_port_id);
       fp << generate_verilog_port(VERILOG_PORT_REG, sr_head_port) << ";"
-         << std::endl;
+         << '\n';
 
       ModulePortId sr_tail_port_id = module_manager.find_module_port(
         top_module, generate_regional_blwl_port_name(
@@ -100,26 +98,24 @@ void print_verilog_top_testbench_ql_memory_bank_port(
       BasicPort sr_tail_port =
         module_manager.module_port(top_module, sr_tail_port_id);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, sr_tail_port) << ";"
-         << std::endl;
+         << '\n';
     }
 
     /* BL Shift register clock and registers */
     BasicPort virtual_sr_clock_port(
       std::string(TOP_TB_VIRTUAL_BL_SHIFT_REGISTER_CLOCK_PORT_NAME), 1);
     fp << generate_verilog_port(VERILOG_PORT_REG, virtual_sr_clock_port) << ";"
-       << std::endl;
+       << '\n';
     BasicPort sr_clock_port(
       std::string(TOP_TB_BL_SHIFT_REGISTER_CLOCK_PORT_NAME), 1);
-    fp << generate_verilog_port(VERILOG_PORT_REG, sr_clock_port) << ";"
-       << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_REG, sr_clock_port) << ";" << '\n';
 
     /* Register to enable/disable bl/wl shift register clocks */
     BasicPort start_bl_sr_port(TOP_TB_START_BL_SHIFT_REGISTER_PORT_NAME, 1);
     fp << generate_verilog_port(VERILOG_PORT_REG, start_bl_sr_port) << ";"
-       << std::endl;
+       << '\n';
     /* Register to count bl/wl shift register clocks */
-    fp << "integer " << TOP_TB_BL_SHIFT_REGISTER_COUNT_PORT_NAME << ";"
-       << std::endl;
+    fp << "integer " << TOP_TB_BL_SHIFT_REGISTER_COUNT_PORT_NAME << ";" << '\n';
   }
 
   /* Print the address port for the Word-Line decoder here */
@@ -131,8 +127,7 @@ void print_verilog_top_testbench_ql_memory_bank_port(
     BasicPort wl_addr_port =
       module_manager.module_port(top_module, wl_addr_port_id);
 
-    fp << generate_verilog_port(VERILOG_PORT_REG, wl_addr_port) << ";"
-       << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_REG, wl_addr_port) << ";" << '\n';
   } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type()) {
     print_verilog_comment(fp, std::string("---- Word-Line ports -----"));
     for (const ConfigRegionId& region : module_manager.regions(top_module)) {
@@ -140,8 +135,7 @@ void print_verilog_top_testbench_ql_memory_bank_port(
         top_module, generate_regional_blwl_port_name(
                       std::string(MEMORY_WL_PORT_NAME), region));
       BasicPort wl_port = module_manager.module_port(top_module, wl_port_id);
-      fp << generate_verilog_port(VERILOG_PORT_REG, wl_port) << ";"
-         << std::endl;
+      fp << generate_verilog_port(VERILOG_PORT_REG, wl_port) << ";" << '\n';
     }
   } else {
     VTR_ASSERT(BLWL_PROTOCOL_SHIFT_REGISTER ==
@@ -154,7 +148,7 @@ void print_verilog_top_testbench_ql_memory_bank_port(
       BasicPort sr_head_port =
         module_manager.module_port(top_module, sr_head_port_id);
       fp << generate_verilog_port(VERILOG_PORT_REG, sr_head_port) << ";"
-         << std::endl;
+         << '\n';
 
       ModulePortId sr_tail_port_id = module_manager.find_module_port(
         top_module, generate_regional_blwl_port_name(
@@ -162,26 +156,24 @@ void print_verilog_top_testbench_ql_memory_bank_port(
       BasicPort sr_tail_port =
         module_manager.module_port(top_module, sr_tail_port_id);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, sr_tail_port) << ";"
-         << std::endl;
+         << '\n';
     }
 
     /* WL Shift register clock and registers */
     BasicPort virtual_sr_clock_port(
       std::string(TOP_TB_VIRTUAL_WL_SHIFT_REGISTER_CLOCK_PORT_NAME), 1);
     fp << generate_verilog_port(VERILOG_PORT_REG, virtual_sr_clock_port) << ";"
-       << std::endl;
+       << '\n';
     BasicPort sr_clock_port(
       std::string(TOP_TB_WL_SHIFT_REGISTER_CLOCK_PORT_NAME), 1);
-    fp << generate_verilog_port(VERILOG_PORT_REG, sr_clock_port) << ";"
-       << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_REG, sr_clock_port) << ";" << '\n';
 
     /* Register to enable/disable bl/wl shift register clocks */
     BasicPort start_wl_sr_port(TOP_TB_START_WL_SHIFT_REGISTER_PORT_NAME, 1);
     fp << generate_verilog_port(VERILOG_PORT_REG, start_wl_sr_port) << ";"
-       << std::endl;
+       << '\n';
     /* Register to count bl/wl shift register clocks */
-    fp << "integer " << TOP_TB_WL_SHIFT_REGISTER_COUNT_PORT_NAME << ";"
-       << std::endl;
+    fp << "integer " << TOP_TB_WL_SHIFT_REGISTER_COUNT_PORT_NAME << ";" << '\n';
   }
 
   /* Print the data-input port: only available when BL has a decoder */
@@ -191,7 +183,7 @@ void print_verilog_top_testbench_ql_memory_bank_port(
     ModulePortId din_port_id = module_manager.find_module_port(
       top_module, std::string(DECODER_DATA_IN_PORT_NAME));
     BasicPort din_port = module_manager.module_port(top_module, din_port_id);
-    fp << generate_verilog_port(VERILOG_PORT_REG, din_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_REG, din_port) << ";" << '\n';
   }
 
   /* Print the optional readback port for the decoder here */
@@ -204,7 +196,7 @@ void print_verilog_top_testbench_ql_memory_bank_port(
       BasicPort readback_port =
         module_manager.module_port(top_module, readback_port_id);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, readback_port) << ";"
-         << std::endl;
+         << '\n';
       /* Disable readback in full testbenches */
       print_verilog_wire_constant_values(
         fp, readback_port, std::vector<size_t>(readback_port.get_width(), 0));
@@ -218,8 +210,7 @@ void print_verilog_top_testbench_ql_memory_bank_port(
       if (wlr_port_id) {
         BasicPort wlr_port =
           module_manager.module_port(top_module, wlr_port_id);
-        fp << generate_verilog_port(VERILOG_PORT_WIRE, wlr_port) << ";"
-           << std::endl;
+        fp << generate_verilog_port(VERILOG_PORT_WIRE, wlr_port) << ";" << '\n';
         /* Disable readback in full testbenches */
         print_verilog_wire_constant_values(
           fp, wlr_port, std::vector<size_t>(wlr_port.get_width(), 0));
@@ -243,9 +234,9 @@ void print_verilog_top_testbench_ql_memory_bank_port(
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
 
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, en_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, en_port) << ";" << '\n';
   fp << generate_verilog_port(VERILOG_PORT_REG, en_register_port) << ";"
-     << std::endl;
+     << '\n';
 
   write_tab_to_file(fp, 1);
   fp << "assign ";
@@ -254,7 +245,7 @@ void print_verilog_top_testbench_ql_memory_bank_port(
   fp << "~" << generate_verilog_port(VERILOG_PORT_CONKT, en_register_port);
   fp << " & ";
   fp << "~" << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 }
 
 void print_verilog_top_testbench_global_shift_register_clock_ports_stimuli(
@@ -325,17 +316,17 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_virtual_clock_generat
   fp << " @(posedge "
      << generate_verilog_port(VERILOG_PORT_CONKT, start_sr_port) << ")";
   fp << " begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << generate_verilog_port_constant_values(
     sr_clock_port, std::vector<size_t>(sr_clock_port.get_width(), 0), true);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
   fp << "while (" << generate_verilog_port(VERILOG_PORT_CONKT, start_sr_port)
      << ") begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << "#" << sr_clock_period << " ";
@@ -343,15 +334,15 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_virtual_clock_generat
 
   fp << "\t";
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << generate_verilog_port_constant_values(
     sr_clock_port, std::vector<size_t>(sr_clock_port.get_width(), 0), true);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 }
 
 /**
@@ -369,22 +360,22 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_clock_generator(
   fp << " @(posedge "
      << generate_verilog_port(VERILOG_PORT_CONKT, start_sr_port) << ")";
   fp << " begin";
-  fp << std::endl;
+  fp << '\n';
 
   /* Skip the first the clock cycle which is reserved for reset */
   fp << "\t";
-  fp << "#" << sr_clock_period * 2. << ";" << std::endl;
-  fp << std::endl;
+  fp << "#" << sr_clock_period * 2. << ";" << '\n';
+  fp << '\n';
 
   fp << "\t";
   fp << generate_verilog_port_constant_values(
     sr_clock_port, std::vector<size_t>(sr_clock_port.get_width(), 0), true);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
   fp << "while (" << generate_verilog_port(VERILOG_PORT_CONKT, start_sr_port)
      << ") begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << "#" << sr_clock_period << " ";
@@ -392,15 +383,15 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_clock_generator(
 
   fp << "\t";
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << generate_verilog_port_constant_values(
     sr_clock_port, std::vector<size_t>(sr_clock_port.get_width(), 0), true);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 }
 
 /**
@@ -450,8 +441,8 @@ static int constrain_blwl_shift_register_clock_period_from_simulation_settings(
 int print_verilog_top_testbench_configuration_protocol_ql_memory_bank_stimulus(
   std::fstream& fp, const ConfigProtocol& config_protocol,
   const SimulationSetting& sim_settings, const ModuleManager& module_manager,
-  const ModuleId& top_module, const bool& fast_configuration,
-  const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream,
+  const ModuleId& top_module, const bool& /* fast_configuration */,
+  const bool& /* bit_value_to_skip */, const FabricBitstream& fabric_bitstream,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks,
   const float& prog_clock_period, const float& timescale) {
   ModulePortId en_port_id = module_manager.find_module_port(
@@ -485,9 +476,15 @@ int print_verilog_top_testbench_configuration_protocol_ql_memory_bank_stimulus(
   if ((CONFIG_MEM_QL_MEMORY_BANK == config_protocol.type()) &&
       (BLWL_PROTOCOL_SHIFT_REGISTER == config_protocol.bl_protocol_type()) &&
       (BLWL_PROTOCOL_SHIFT_REGISTER == config_protocol.wl_protocol_type())) {
-    MemoryBankShiftRegisterFabricBitstream fabric_bits_by_addr =
-      build_memory_bank_shift_register_fabric_bitstream(
-        fabric_bitstream, blwl_sr_banks, fast_configuration, bit_value_to_skip);
+    /* Only the sizes of the bitstream are required here */
+    size_t num_words = 0;
+    size_t bl_width = 0;
+    size_t wl_width = 0;
+    size_t bl_word_size = 0;
+    size_t wl_word_size = 0;
+    find_memory_bank_shift_register_fabric_bitstream_sizes(
+      fabric_bitstream, blwl_sr_banks, num_words, bl_width, wl_width,
+      bl_word_size, wl_word_size);
 
     /* Compute the auto-tuned clock period first, this is the lower bound of the
      * shift register clock periods:
@@ -498,12 +495,10 @@ int print_verilog_top_testbench_configuration_protocol_ql_memory_bank_stimulus(
      *   TODO: To figure out what is the min. slack required here. See something
      * strange in HDL simulation
      */
-    float bl_sr_clock_period = 0.25 * prog_clock_period /
-                               (fabric_bits_by_addr.bl_word_size() + 2) /
-                               timescale;
-    float wl_sr_clock_period = 0.25 * prog_clock_period /
-                               (fabric_bits_by_addr.wl_word_size() + 2) /
-                               timescale;
+    float bl_sr_clock_period =
+      0.25 * prog_clock_period / (bl_word_size + 2) / timescale;
+    float wl_sr_clock_period =
+      0.25 * prog_clock_period / (wl_word_size + 2) / timescale;
 
     VTR_LOG("Precomputed clock frequency (=%g %s) for %s.\n",
             1. / (2. * bl_sr_clock_period * timescale) / 1e6,
@@ -558,16 +553,15 @@ int print_verilog_top_testbench_configuration_protocol_ql_memory_bank_stimulus(
  * BL/WLs */
 static void print_verilog_full_testbench_ql_memory_bank_flatten_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const bool& fast_configuration, const bool& bit_value_to_skip,
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const FabricBitstream& fabric_bitstream) {
+  const bool& hex_bitstream, const size_t& bitstream_length,
+  const ModuleManager& module_manager, const ModuleId& top_module) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  /* Reorganize the fabric bitstream by the same address across regions */
-  MemoryBankFlattenFabricBitstream fabric_bits_by_addr =
-    build_memory_bank_flatten_fabric_bitstream(
-      fabric_bitstream, fast_configuration, bit_value_to_skip);
+  /* The length of the fabric bitstream reorganized by the same address
+   * across regions is given. The bitstream itself is loaded from the
+   * bitstream file */
+  VTR_ASSERT(0 < bitstream_length);
 
   /* Feed address and data input pair one by one
    * Note: the first cycle is reserved for programming reset
@@ -604,7 +598,7 @@ static void print_verilog_full_testbench_ql_memory_bank_flatten_bitstream(
 
   /* Define a constant for the bitstream length */
   print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_LENGTH_VARIABLE),
-                            fabric_bits_by_addr.size());
+                            bitstream_length);
   print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_WIDTH_VARIABLE),
                             bl_port_width + wl_port_width);
 
@@ -614,38 +608,38 @@ static void print_verilog_full_testbench_ql_memory_bank_flatten_bitstream(
   fp << "reg [0:`" << TOP_TB_BITSTREAM_WIDTH_VARIABLE << " - 1] ";
   fp << TOP_TB_BITSTREAM_MEM_REG_NAME << "[0:`"
      << TOP_TB_BITSTREAM_LENGTH_VARIABLE << " - 1];";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "reg [$clog2(`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE << "):0] "
-     << TOP_TB_BITSTREAM_INDEX_REG_NAME << ";" << std::endl;
+     << TOP_TB_BITSTREAM_INDEX_REG_NAME << ";" << '\n';
 
   print_verilog_comment(
     fp, "----- Preload bitstream file to a virtual memory -----");
-  fp << "initial begin" << std::endl;
+  fp << "initial begin" << '\n';
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", "
-     << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
-  fp << std::endl;
+  fp << (hex_bitstream ? "$readmemh" : "$readmemb") << "(\""
+     << bitstream_file << "\", " << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  fp << '\n';
 
   print_verilog_comment(fp, "----- Bit-Line Address port default input -----");
   fp << "\t";
   fp << generate_verilog_ports_constant_values(bl_ports, initial_bl_values);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(fp, "----- Word-Line Address port default input -----");
   fp << "\t";
   fp << generate_verilog_ports_constant_values(wl_ports, initial_wl_values);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME << " <= 0";
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(
     fp, "----- Begin bitstream loading during configuration phase -----");
@@ -656,7 +650,7 @@ static void print_verilog_full_testbench_ql_memory_bank_flatten_bitstream(
   fp << " @(negedge "
      << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ")";
   fp << " begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << "if (";
@@ -664,18 +658,18 @@ static void print_verilog_full_testbench_ql_memory_bank_flatten_bitstream(
   fp << " >= ";
   fp << "`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE;
   fp << ") begin";
-  fp << std::endl;
+  fp << '\n';
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << "\t\t";
   std::vector<size_t> config_done_final_values(config_done_port.get_width(), 1);
   fp << generate_verilog_port_constant_values(config_done_port,
                                               config_done_final_values, true);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
   fp << "end else begin";
-  fp << std::endl;
+  fp << '\n';
 
   std::vector<BasicPort> blwl_ports = bl_ports;
   blwl_ports.insert(blwl_ports.end(), wl_ports.begin(), wl_ports.end());
@@ -684,20 +678,20 @@ static void print_verilog_full_testbench_ql_memory_bank_flatten_bitstream(
   fp << " <= ";
   fp << TOP_TB_BITSTREAM_MEM_REG_NAME << "[" << TOP_TB_BITSTREAM_INDEX_REG_NAME
      << "]";
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t\t";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME;
   fp << " <= ";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME << " + 1";
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(
     fp, "----- End bitstream loading during configuration phase -----");
@@ -708,17 +702,22 @@ static void print_verilog_full_testbench_ql_memory_bank_flatten_bitstream(
 static void
 print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const bool& fast_configuration, const bool& bit_value_to_skip,
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const FabricBitstream& fabric_bitstream,
+  const bool& hex_bitstream, const ModuleManager& module_manager,
+  const ModuleId& top_module, const FabricBitstream& fabric_bitstream,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  /* Reorganize the fabric bitstream by the same address across regions */
-  MemoryBankShiftRegisterFabricBitstream fabric_bits_by_addr =
-    build_memory_bank_shift_register_fabric_bitstream(
-      fabric_bitstream, blwl_sr_banks, fast_configuration, bit_value_to_skip);
+  /* Find the sizes of the fabric bitstream reorganized by the same address
+   * across regions. The bitstream itself is loaded from the bitstream file */
+  size_t num_words = 0;
+  size_t bl_width = 0;
+  size_t wl_width = 0;
+  size_t bl_word_size = 0;
+  size_t wl_word_size = 0;
+  find_memory_bank_shift_register_fabric_bitstream_sizes(
+    fabric_bitstream, blwl_sr_banks, num_words, bl_width, wl_width,
+    bl_word_size, wl_word_size);
 
   /* Feed address and data input pair one by one
    * Note: the first cycle is reserved for programming reset
@@ -747,20 +746,20 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
   for (const BasicPort& bl_head_port : bl_head_ports) {
     bl_head_port_width += bl_head_port.get_width();
   }
-  VTR_ASSERT(bl_head_port_width == fabric_bits_by_addr.bl_width());
+  VTR_ASSERT(bl_head_port_width == bl_width);
 
   size_t wl_head_port_width = 0;
   for (const BasicPort& wl_head_port : wl_head_ports) {
     wl_head_port_width += wl_head_port.get_width();
   }
-  VTR_ASSERT(wl_head_port_width == fabric_bits_by_addr.wl_width());
+  VTR_ASSERT(wl_head_port_width == wl_width);
 
   std::vector<size_t> initial_bl_head_values(bl_head_port_width, 0);
   std::vector<size_t> initial_wl_head_values(wl_head_port_width, 0);
 
   /* Define a constant for the bitstream length */
   print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_LENGTH_VARIABLE),
-                            fabric_bits_by_addr.num_words());
+                            num_words);
   print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_WIDTH_VARIABLE),
                             std::max(bl_head_port_width, wl_head_port_width));
   print_verilog_define_flag(
@@ -769,12 +768,10 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
   print_verilog_define_flag(
     fp, std::string(TOP_TB_BITSTREAM_WL_HEAD_WIDTH_VARIABLE),
     wl_head_port_width);
-  print_verilog_define_flag(fp,
-                            std::string(TOP_TB_BITSTREAM_BL_WORD_SIZE_VARIABLE),
-                            fabric_bits_by_addr.bl_word_size());
-  print_verilog_define_flag(fp,
-                            std::string(TOP_TB_BITSTREAM_WL_WORD_SIZE_VARIABLE),
-                            fabric_bits_by_addr.wl_word_size());
+  print_verilog_define_flag(
+    fp, std::string(TOP_TB_BITSTREAM_BL_WORD_SIZE_VARIABLE), bl_word_size);
+  print_verilog_define_flag(
+    fp, std::string(TOP_TB_BITSTREAM_WL_WORD_SIZE_VARIABLE), wl_word_size);
 
   /* Declare local variables for bitstream loading in Verilog */
   print_verilog_comment(
@@ -784,37 +781,37 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
   fp << TOP_TB_BITSTREAM_LENGTH_VARIABLE << "*(`"
      << TOP_TB_BITSTREAM_BL_WORD_SIZE_VARIABLE;
   fp << " + `" << TOP_TB_BITSTREAM_WL_WORD_SIZE_VARIABLE << ") - 1];";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "reg [$clog2(`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE << "):0] "
-     << TOP_TB_BITSTREAM_INDEX_REG_NAME << ";" << std::endl;
+     << TOP_TB_BITSTREAM_INDEX_REG_NAME << ";" << '\n';
 
   print_verilog_comment(
     fp, "----- Preload bitstream file to a virtual memory -----");
-  fp << "initial begin" << std::endl;
+  fp << "initial begin" << '\n';
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", "
-     << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
-  fp << std::endl;
+  fp << (hex_bitstream ? "$readmemh" : "$readmemb") << "(\""
+     << bitstream_file << "\", " << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  fp << '\n';
 
   print_verilog_comment(fp, "----- Bit-Line head port default input -----");
   fp << "\t";
   fp << generate_verilog_ports_constant_values(bl_head_ports,
                                                initial_bl_head_values);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(fp, "----- Word-Line head port default input -----");
   fp << "\t";
   fp << generate_verilog_ports_constant_values(wl_head_ports,
                                                initial_wl_head_values);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME << " <= 0";
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   BasicPort start_bl_sr_port(TOP_TB_START_BL_SHIFT_REGISTER_PORT_NAME, 1);
   BasicPort start_wl_sr_port(TOP_TB_START_WL_SHIFT_REGISTER_PORT_NAME, 1);
@@ -824,14 +821,14 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
     start_bl_sr_port, std::vector<size_t>(start_bl_sr_port.get_width(), 0),
     true);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << generate_verilog_port_constant_values(
     start_wl_sr_port, std::vector<size_t>(start_wl_sr_port.get_width(), 0),
     true);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   BasicPort bl_sr_clock_port(TOP_TB_BL_SHIFT_REGISTER_CLOCK_PORT_NAME, 1);
   BasicPort wl_sr_clock_port(TOP_TB_WL_SHIFT_REGISTER_CLOCK_PORT_NAME, 1);
@@ -841,14 +838,14 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
     bl_sr_clock_port, std::vector<size_t>(bl_sr_clock_port.get_width(), 0),
     true);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << generate_verilog_port_constant_values(
     wl_sr_clock_port, std::vector<size_t>(wl_sr_clock_port.get_width(), 0),
     true);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   BasicPort virtual_bl_sr_clock_port(
     TOP_TB_VIRTUAL_BL_SHIFT_REGISTER_CLOCK_PORT_NAME, 1);
@@ -860,17 +857,17 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
     virtual_bl_sr_clock_port,
     std::vector<size_t>(virtual_bl_sr_clock_port.get_width(), 0), true);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << generate_verilog_port_constant_values(
     virtual_wl_sr_clock_port,
     std::vector<size_t>(virtual_wl_sr_clock_port.get_width(), 0), true);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME) +
                               std::string(TOP_TB_CLOCK_REG_POSTFIX),
@@ -882,7 +879,7 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
   fp << " @(negedge "
      << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ")";
   fp << " begin";
-  fp << std::endl;
+  fp << '\n';
 
   /* Finished all the configuration words, raise the configuration done signal
    */
@@ -892,18 +889,18 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
   fp << " >= ";
   fp << "`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE;
   fp << ") begin";
-  fp << std::endl;
+  fp << '\n';
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << "\t\t";
   std::vector<size_t> config_done_final_values(config_done_port.get_width(), 1);
   fp << generate_verilog_port_constant_values(config_done_port,
                                               config_done_final_values, true);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
   fp << "end else begin";
-  fp << std::endl;
+  fp << '\n';
 
   /* When there are still configuration words to be load, start the BL and WL
    * shift register clock */
@@ -912,35 +909,35 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
     start_bl_sr_port, std::vector<size_t>(start_bl_sr_port.get_width(), 1),
     true);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(
     start_wl_sr_port, std::vector<size_t>(start_wl_sr_port.get_width(), 1),
     true);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << TOP_TB_BL_SHIFT_REGISTER_COUNT_PORT_NAME << " = 0;";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << TOP_TB_WL_SHIFT_REGISTER_COUNT_PORT_NAME << " = 0;";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME;
   fp << " <= ";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME << " + 1";
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   /* Load data to BL shift register chains */
   fp << "always";
@@ -948,7 +945,7 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
      << generate_verilog_port(VERILOG_PORT_CONKT, virtual_bl_sr_clock_port)
      << ")";
   fp << " begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << "if (";
@@ -956,16 +953,16 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
   fp << " >= ";
   fp << "`" << TOP_TB_BITSTREAM_BL_WORD_SIZE_VARIABLE << " - 1";
   fp << ") begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(
     start_bl_sr_port, std::vector<size_t>(start_bl_sr_port.get_width(), 0),
     true);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
-  fp << "end" << std::endl;
+  fp << "end" << '\n';
 
   fp << "\t";
   fp << "if (";
@@ -973,14 +970,14 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
   fp << " >= ";
   fp << "`" << TOP_TB_BITSTREAM_BL_WORD_SIZE_VARIABLE;
   fp << ") begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << TOP_TB_BL_SHIFT_REGISTER_COUNT_PORT_NAME << " = 0;";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
-  fp << "end else begin" << std::endl;
+  fp << "end else begin" << '\n';
 
   fp << "\t\t";
   fp << generate_verilog_ports(bl_head_ports);
@@ -990,19 +987,19 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
      << TOP_TB_BITSTREAM_BL_WORD_SIZE_VARIABLE << " + `"
      << TOP_TB_BITSTREAM_WL_WORD_SIZE_VARIABLE << ") + "
      << TOP_TB_BL_SHIFT_REGISTER_COUNT_PORT_NAME;
-  fp << "];" << std::endl;
+  fp << "];" << '\n';
 
   fp << "\t\t";
   fp << TOP_TB_BL_SHIFT_REGISTER_COUNT_PORT_NAME << " = ";
   fp << TOP_TB_BL_SHIFT_REGISTER_COUNT_PORT_NAME << " + 1;";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   /* Load data to WL shift register chains */
   fp << "always";
@@ -1010,7 +1007,7 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
      << generate_verilog_port(VERILOG_PORT_CONKT, virtual_wl_sr_clock_port)
      << ")";
   fp << " begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << "if (";
@@ -1018,16 +1015,16 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
   fp << " >= ";
   fp << "`" << TOP_TB_BITSTREAM_WL_WORD_SIZE_VARIABLE << " - 1";
   fp << ") begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(
     start_wl_sr_port, std::vector<size_t>(start_wl_sr_port.get_width(), 0),
     true);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
-  fp << "end" << std::endl;
+  fp << "end" << '\n';
 
   fp << "\t";
   fp << "if (";
@@ -1035,14 +1032,14 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
   fp << " >= ";
   fp << "`" << TOP_TB_BITSTREAM_WL_WORD_SIZE_VARIABLE;
   fp << ") begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << TOP_TB_WL_SHIFT_REGISTER_COUNT_PORT_NAME << " = 0;";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
-  fp << "end else begin" << std::endl;
+  fp << "end else begin" << '\n';
 
   fp << "\t\t";
   fp << generate_verilog_ports(wl_head_ports);
@@ -1053,19 +1050,19 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
      << TOP_TB_BITSTREAM_WL_WORD_SIZE_VARIABLE << ") + `"
      << TOP_TB_BITSTREAM_BL_WORD_SIZE_VARIABLE << " + "
      << TOP_TB_WL_SHIFT_REGISTER_COUNT_PORT_NAME;
-  fp << "];" << std::endl;
+  fp << "];" << '\n';
 
   fp << "\t\t";
   fp << TOP_TB_WL_SHIFT_REGISTER_COUNT_PORT_NAME << " = ";
   fp << TOP_TB_WL_SHIFT_REGISTER_COUNT_PORT_NAME << " + 1;";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(
     fp, "----- End bitstream loading during configuration phase -----");
@@ -1075,25 +1072,14 @@ print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
  * decoders */
 static void print_verilog_full_testbench_ql_memory_bank_decoder_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const bool& fast_configuration, const bool& bit_value_to_skip,
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const FabricBitstream& fabric_bitstream) {
+  const bool& hex_bitstream, const size_t& bitstream_length,
+  const ModuleManager& module_manager, const ModuleId& top_module) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  /* Reorganize the fabric bitstream by the same address across regions */
-  MemoryBankFabricBitstream fabric_bits_by_addr =
-    build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
-
-  /* For fast configuration, identify the final bitstream size to be used */
-  size_t num_bits_to_skip = 0;
-  if (true == fast_configuration) {
-    num_bits_to_skip =
-      fabric_bits_by_addr.size() -
-      find_memory_bank_fast_configuration_fabric_bitstream_size(
-        fabric_bitstream, bit_value_to_skip);
-  }
-  VTR_ASSERT(num_bits_to_skip < fabric_bits_by_addr.size());
+  /* The bitstream is organized by the same address across regions, whose
+   * size, considering fast configuration, is given */
+  VTR_ASSERT(0 < bitstream_length);
 
   /* Feed address and data input pair one by one
    * Note: the first cycle is reserved for programming reset
@@ -1118,7 +1104,7 @@ static void print_verilog_full_testbench_ql_memory_bank_decoder_bitstream(
 
   /* Define a constant for the bitstream length */
   print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_LENGTH_VARIABLE),
-                            fabric_bits_by_addr.size() - num_bits_to_skip);
+                            bitstream_length);
   print_verilog_define_flag(
     fp, std::string(TOP_TB_BITSTREAM_WIDTH_VARIABLE),
     bl_addr_port.get_width() + wl_addr_port.get_width() + din_port.get_width());
@@ -1129,46 +1115,46 @@ static void print_verilog_full_testbench_ql_memory_bank_decoder_bitstream(
   fp << "reg [0:`" << TOP_TB_BITSTREAM_WIDTH_VARIABLE << " - 1] ";
   fp << TOP_TB_BITSTREAM_MEM_REG_NAME << "[0:`"
      << TOP_TB_BITSTREAM_LENGTH_VARIABLE << " - 1];";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "reg [$clog2(`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE << "):0] "
-     << TOP_TB_BITSTREAM_INDEX_REG_NAME << ";" << std::endl;
+     << TOP_TB_BITSTREAM_INDEX_REG_NAME << ";" << '\n';
 
   print_verilog_comment(
     fp, "----- Preload bitstream file to a virtual memory -----");
-  fp << "initial begin" << std::endl;
+  fp << "initial begin" << '\n';
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", "
-     << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
-  fp << std::endl;
+  fp << (hex_bitstream ? "$readmemh" : "$readmemb") << "(\""
+     << bitstream_file << "\", " << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  fp << '\n';
 
   print_verilog_comment(fp, "----- Bit-Line Address port default input -----");
   fp << "\t";
   fp << generate_verilog_port_constant_values(bl_addr_port,
                                               initial_bl_addr_values);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(fp, "----- Word-Line Address port default input -----");
   fp << "\t";
   fp << generate_verilog_port_constant_values(wl_addr_port,
                                               initial_wl_addr_values);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(fp, "----- Data-input port default input -----");
   fp << "\t";
   fp << generate_verilog_port_constant_values(din_port, initial_din_values);
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME << " <= 0";
   fp << ";";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(
     fp, "----- Begin bitstream loading during configuration phase -----");
@@ -1179,7 +1165,7 @@ static void print_verilog_full_testbench_ql_memory_bank_decoder_bitstream(
   fp << " @(negedge "
      << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ")";
   fp << " begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t";
   fp << "if (";
@@ -1187,18 +1173,18 @@ static void print_verilog_full_testbench_ql_memory_bank_decoder_bitstream(
   fp << " >= ";
   fp << "`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE;
   fp << ") begin";
-  fp << std::endl;
+  fp << '\n';
 
   BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
   fp << "\t\t";
   std::vector<size_t> config_done_final_values(config_done_port.get_width(), 1);
   fp << generate_verilog_port_constant_values(config_done_port,
                                               config_done_final_values, true);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
   fp << "end else begin";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "\t\t";
   fp << "{";
@@ -1211,20 +1197,20 @@ static void print_verilog_full_testbench_ql_memory_bank_decoder_bitstream(
   fp << " <= ";
   fp << TOP_TB_BITSTREAM_MEM_REG_NAME << "[" << TOP_TB_BITSTREAM_INDEX_REG_NAME
      << "]";
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t\t";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME;
   fp << " <= ";
   fp << TOP_TB_BITSTREAM_INDEX_REG_NAME << " + 1";
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   fp << "\t";
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   fp << "end";
-  fp << std::endl;
+  fp << '\n';
 
   print_verilog_comment(
     fp, "----- End bitstream loading during configuration phase -----");
@@ -1232,27 +1218,28 @@ static void print_verilog_full_testbench_ql_memory_bank_decoder_bitstream(
 
 void print_verilog_full_testbench_ql_memory_bank_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const ConfigProtocol& config_protocol, const bool& fast_configuration,
-  const bool& bit_value_to_skip, const ModuleManager& module_manager,
+  const bool& hex_bitstream, const ConfigProtocol& config_protocol,
+  const size_t& bitstream_length, const bool& /* fast_configuration */,
+  const bool& /* bit_value_to_skip */, const ModuleManager& module_manager,
   const ModuleId& top_module, const FabricBitstream& fabric_bitstream,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks) {
   if ((BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) &&
       (BLWL_PROTOCOL_DECODER == config_protocol.wl_protocol_type())) {
     print_verilog_full_testbench_ql_memory_bank_decoder_bitstream(
-      fp, bitstream_file, fast_configuration, bit_value_to_skip, module_manager,
-      top_module, fabric_bitstream);
+      fp, bitstream_file, hex_bitstream, bitstream_length, module_manager,
+      top_module);
   } else if ((BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type()) &&
              (BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type())) {
     print_verilog_full_testbench_ql_memory_bank_flatten_bitstream(
-      fp, bitstream_file, fast_configuration, bit_value_to_skip, module_manager,
-      top_module, fabric_bitstream);
+      fp, bitstream_file, hex_bitstream, bitstream_length, module_manager,
+      top_module);
   } else if ((BLWL_PROTOCOL_SHIFT_REGISTER ==
               config_protocol.bl_protocol_type()) &&
              (BLWL_PROTOCOL_SHIFT_REGISTER ==
               config_protocol.wl_protocol_type())) {
     print_verilog_full_testbench_ql_memory_bank_shift_register_bitstream(
-      fp, bitstream_file, fast_configuration, bit_value_to_skip, module_manager,
-      top_module, fabric_bitstream, blwl_sr_banks);
+      fp, bitstream_file, hex_bitstream, module_manager, top_module,
+      fabric_bitstream, blwl_sr_banks);
   }
 }
 
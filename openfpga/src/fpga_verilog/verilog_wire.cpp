@@ -12,6 +12,7 @@
 /* Headers from openfpgautil library */
 #include "module_manager.h"
 #include "module_manager_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "verilog_constants.h"
@@ -81,9 +82,9 @@ static void print_verilog_wire_module(
 
   /* Print wire declaration for the inputs and outputs */
   fp << generate_verilog_port(VERILOG_PORT_WIRE, module_input_port) << ";"
-     << std::endl;
+     << '\n';
   fp << generate_verilog_port(VERILOG_PORT_WIRE, module_output_port) << ";"
-     << std::endl;
+     << '\n';
 
   /* Direct shortcut */
   print_verilog_wire_connection(fp, module_output_port, module_input_port,
@@ -96,7 +97,7 @@ static void print_verilog_wire_module(
   print_verilog_module_end(fp, circuit_lib.model_name(wire_model));
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -112,8 +113,9 @@ void print_verilog_submodule_wires(const ModuleManager& module_manager,
   std::string verilog_fpath(submodule_dir + verilog_fname);
 
   /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  BufferedFileStream fp;
+  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc,
+          options.incremental());
 
   check_file_stream(verilog_fpath.c_str(), fp);
 
@@ -149,6 +151,7 @@ void print_verilog_submodule_wires(const ModuleManager& module_manager,
   }
   VTR_ASSERT(nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  netlist_manager.set_netlist_changed(nlist_id, fp.file_changed());
 
   VTR_LOG("Done\n");
 }
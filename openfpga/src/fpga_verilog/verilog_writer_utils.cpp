@@ -17,8 +17,11 @@
 
 /* Headers from openfpgautil library */
 #include "circuit_library_utils.h"
+#include "openfpga_buffered_stream.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
+#include "openfpga_progress.h"
 #include "verilog_constants.h"
 #include "verilog_writer_utils.h"
 
@@ -32,10 +35,10 @@ void print_verilog_default_net_type_declaration(
   std::fstream& fp, const e_verilog_default_net_type& default_net_type) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "//----- Default net type -----" << std::endl;
+  fp << "//----- Default net type -----" << '\n';
   fp << "`default_nettype " << VERILOG_DEFAULT_NET_TYPE_STRING[default_net_type]
-     << std::endl;
-  fp << std::endl;
+     << '\n';
+  fp << '\n';
 }
 
 /************************************************
@@ -46,11 +49,11 @@ void print_verilog_file_header(std::fstream& fp, const std::string& usage,
                                const bool& include_time_stamp) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "//-------------------------------------------" << std::endl;
-  fp << "//\tFPGA Synthesizable Verilog Netlist" << std::endl;
-  fp << "//\tDescription: " << usage << std::endl;
-  fp << "//\tAuthor: Xifan TANG" << std::endl;
-  fp << "//\tOrganization: University of Utah" << std::endl;
+  fp << "//-------------------------------------------" << '\n';
+  fp << "//\tFPGA Synthesizable Verilog Netlist" << '\n';
+  fp << "//\tDescription: " << usage << '\n';
+  fp << "//\tAuthor: Xifan TANG" << '\n';
+  fp << "//\tOrganization: University of Utah" << '\n';
 
   if (include_time_stamp) {
     auto end = std::chrono::system_clock::now();
@@ -58,11 +61,11 @@ void print_verilog_file_header(std::fstream& fp, const std::string& usage,
     fp << "//\tDate: " << std::ctime(&end_time);
   }
 
-  fp << "//-------------------------------------------" << std::endl;
+  fp << "//-------------------------------------------" << '\n';
 
-  fp << "//----- Time scale -----" << std::endl;
-  fp << "`timescale 1ns / 1ps" << std::endl;
-  fp << std::endl;
+  fp << "//----- Time scale -----" << '\n';
+  fp << "`timescale 1ns / 1ps" << '\n';
+  fp << '\n';
 }
 
 /********************************************************************
@@ -72,7 +75,7 @@ void print_verilog_include_netlist(std::fstream& fp,
                                    const std::string& netlist_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`include \"" << netlist_name << "\"" << std::endl;
+  fp << "`include \"" << netlist_name << "\"" << '\n';
 }
 
 /********************************************************************
@@ -82,7 +85,7 @@ void print_verilog_define_flag(std::fstream& fp, const std::string& flag_name,
                                const int& flag_value) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`define " << flag_name << " " << flag_value << std::endl;
+  fp << "`define " << flag_name << " " << flag_value << '\n';
 }
 
 /************************************************
@@ -103,7 +106,7 @@ void print_verilog_include_defines_preproc_file(
 void print_verilog_comment(std::fstream& fp, const std::string& comment) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "// " << comment << std::endl;
+  fp << "// " << comment << '\n';
 }
 
 /************************************************
@@ -113,7 +116,7 @@ void print_verilog_preprocessing_flag(std::fstream& fp,
                                       const std::string& preproc_flag) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`ifdef " << preproc_flag << std::endl;
+  fp << "`ifdef " << preproc_flag << '\n';
 }
 
 /************************************************
@@ -122,7 +125,7 @@ void print_verilog_preprocessing_flag(std::fstream& fp,
 void print_verilog_endif(std::fstream& fp) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`endif" << std::endl;
+  fp << "`endif" << '\n';
 }
 
 /************************************************
@@ -164,7 +167,7 @@ void print_verilog_module_definition(std::fstream& fp,
          module_manager.module_ports_by_type(module_id, kv.first)) {
       if (0 != port_cnt) {
         /* Do not dump a comma for the first port */
-        fp << "," << std::endl;
+        fp << "," << '\n';
       }
 
       if (true == printed_ifdef) {
@@ -199,7 +202,7 @@ void print_verilog_module_definition(std::fstream& fp,
       port_cnt++;
     }
   }
-  fp << ");" << std::endl;
+  fp << ");" << '\n';
 }
 
 /************************************************
@@ -240,9 +243,9 @@ void print_verilog_module_ports(
 
       /* Print port */
       fp << "//----- " << module_manager.module_port_type_str(kv.first)
-         << " -----" << std::endl;
+         << " -----" << '\n';
       fp << generate_verilog_port(kv.second, port);
-      fp << ";" << std::endl;
+      fp << ";" << '\n';
 
       if (false == preproc_flag.empty()) {
         /* Print an endif to pair the ifdef */
@@ -254,8 +257,8 @@ void print_verilog_module_ports(
   /* Output any port that is also wire connection when default net type is not
    * wire! */
   if (VERILOG_DEFAULT_NET_TYPE_WIRE != default_net_type) {
-    fp << std::endl;
-    fp << "//----- BEGIN wire-connection ports -----" << std::endl;
+    fp << '\n';
+    fp << "//----- BEGIN wire-connection ports -----" << '\n';
     for (const auto& kv : port_type2type_map) {
       for (const auto& port :
            module_manager.module_ports_by_type(module_id, kv.first)) {
@@ -277,7 +280,7 @@ void print_verilog_module_ports(
 
         /* Print port */
         fp << generate_verilog_port(VERILOG_PORT_WIRE, port);
-        fp << ";" << std::endl;
+        fp << ";" << '\n';
 
         if (false == preproc_flag.empty()) {
           /* Print an endif to pair the ifdef */
@@ -285,13 +288,13 @@ void print_verilog_module_ports(
         }
       }
     }
-    fp << "//----- END wire-connection ports -----" << std::endl;
-    fp << std::endl;
+    fp << "//----- END wire-connection ports -----" << '\n';
+    fp << '\n';
   }
 
   /* Output any port that is registered */
-  fp << std::endl;
-  fp << "//----- BEGIN Registered ports -----" << std::endl;
+  fp << '\n';
+  fp << "//----- BEGIN Registered ports -----" << '\n';
   for (const auto& kv : port_type2type_map) {
     for (const auto& port :
          module_manager.module_ports_by_type(module_id, kv.first)) {
@@ -313,7 +316,7 @@ void print_verilog_module_ports(
 
       /* Print port */
       fp << generate_verilog_port(VERILOG_PORT_REG, port);
-      fp << ";" << std::endl;
+      fp << ";" << '\n';
 
       if (false == preproc_flag.empty()) {
         /* Print an endif to pair the ifdef */
@@ -321,8 +324,8 @@ void print_verilog_module_ports(
       }
     }
   }
-  fp << "//----- END Registered ports -----" << std::endl;
-  fp << std::endl;
+  fp << "//----- END Registered ports -----" << '\n';
+  fp << '\n';
 }
 
 /************************************************
@@ -383,7 +386,7 @@ void print_verilog_module_instance(
   /* Print module name */
   fp << "\t" << module_manager.module_name(module_id) << " ";
   /* Print instance name */
-  fp << instance_name << " (" << std::endl;
+  fp << instance_name << " (" << '\n';
 
   /* Print each port with/without explicit port map */
   /* port type2type mapping */
@@ -405,7 +408,7 @@ void print_verilog_module_instance(
          module_manager.module_ports_by_type(module_id, kv.first)) {
       if (0 != port_cnt) {
         /* Do not dump a comma for the first port */
-        fp << "," << std::endl;
+        fp << "," << '\n';
       }
       /* Print port */
       fp << "\t\t";
@@ -425,11 +428,11 @@ void print_verilog_module_instance(
           module_manager.module_port(module_id, module_port_id);
         VTR_ASSERT(module_port.get_width() ==
                    port2port_name_map.at(port.get_name()).get_width());
-        fp << generate_verilog_port(kv.second,
-                                    port2port_name_map.at(port.get_name()));
+        print_verilog_port(fp, kv.second,
+                           port2port_name_map.at(port.get_name()));
       } else {
         /* Not found, we give the default port name */
-        fp << generate_verilog_port(kv.second, port);
+        print_verilog_port(fp, kv.second, port);
       }
       /* if explicit port map is required, output the pair of branket */
       if (true == use_explicit_port_map) {
@@ -440,7 +443,7 @@ void print_verilog_module_instance(
   }
 
   /* Print an end to the instance */
-  fp << ");" << std::endl;
+  fp << ");" << '\n';
 }
 
 /************************************************
@@ -474,10 +477,10 @@ void print_verilog_module_end(std::fstream& fp,
                               const std::string& module_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "endmodule" << std::endl;
+  fp << "endmodule" << '\n';
   print_verilog_comment(
     fp, std::string("----- END Verilog module for " + module_name + " -----"));
-  fp << std::endl;
+  fp << '\n';
 
   /* Reset default net type to be none */
   print_verilog_default_net_type_declaration(fp, VERILOG_DEFAULT_NET_TYPE_NONE);
@@ -533,6 +536,46 @@ std::string generate_verilog_port(
   return verilog_line;
 }
 
+/************************************************
+ * Print a Verilog port to a stream, in the same format as
+ * generate_verilog_port(), without creating any temporary string.
+ * This is the one to use when writing the pins of instances
+ ***********************************************/
+void print_verilog_port(std::ostream& fp,
+                        const enum e_dump_verilog_port_type& verilog_port_type,
+                        const BasicPort& port_info,
+                        const bool& must_print_port_size,
+                        const bool& big_endian) {
+  /* Ensure the port type is valid */
+  VTR_ASSERT(verilog_port_type < NUM_VERILOG_PORT_TYPES);
+
+  if (VERILOG_PORT_CONKT == verilog_port_type) {
+    fp << port_info.get_name();
+    /* Same simplications as generate_verilog_port() */
+    if ((false == must_print_port_size) && (1 == port_info.get_width()) &&
+        (0 == port_info.get_lsb()) &&
+        (1 == port_info.get_origin_port_width())) {
+      return;
+    }
+    if (1 == port_info.get_width()) {
+      fp << '[' << port_info.get_lsb() << ']';
+      return;
+    }
+  } else {
+    fp << VERILOG_PORT_TYPE_STRING[verilog_port_type] << ' ';
+  }
+
+  if (big_endian) {
+    fp << '[' << port_info.get_lsb() << ':' << port_info.get_msb() << ']';
+  } else {
+    fp << '[' << port_info.get_msb() << ':' << port_info.get_lsb() << ']';
+  }
+
+  if (VERILOG_PORT_CONKT != verilog_port_type) {
+    fp << ' ' << port_info.get_name();
+  }
+}
+
 /********************************************************************
  * Evaluate if two Verilog ports can be merged:
  * If the port name is same, it can merged
@@ -649,6 +692,48 @@ std::string generate_verilog_ports(const std::vector<BasicPort>& merged_ports) {
   return verilog_line;
 }
 
+/************************************************
+ * Print a list of verilog ports to a stream, in the same format as
+ * generate_verilog_ports(combine_verilog_ports(ports)).
+ * Neighbouring ports are merged on the fly when they form a contiguous
+ * bus, so that no list of merged ports is created. A contiguous bus,
+ * which is the most common case, is printed as a single port.
+ ***********************************************/
+void print_verilog_ports(std::ostream& fp,
+                         const std::vector<BasicPort>& ports) {
+  VTR_ASSERT(0 < ports.size());
+
+  /* Find if the ports can be merged into a single one, which
+   * should not be wrapped in a concatenation */
+  size_t num_merged_ports = 1;
+  for (size_t iport = 1; iport < ports.size(); ++iport) {
+    if ((false == ports[iport].mergeable(ports[iport - 1])) ||
+        (ports[iport - 1].get_msb() + 1 != ports[iport].get_lsb())) {
+      num_merged_ports++;
+    }
+  }
+
+  if (1 < num_merged_ports) {
+    fp << '{';
+  }
+  BasicPort merged_port = ports[0];
+  for (size_t iport = 1; iport < ports.size(); ++iport) {
+    /* Same rules as combine_verilog_ports() */
+    if ((true == ports[iport].mergeable(merged_port)) &&
+        (merged_port.get_msb() + 1 == ports[iport].get_lsb())) {
+      merged_port.set_msb(ports[iport].get_msb());
+      continue;
+    }
+    print_verilog_port(fp, VERILOG_PORT_CONKT, merged_port, false);
+    fp << ", ";
+    merged_port = ports[iport];
+  }
+  print_verilog_port(fp, VERILOG_PORT_CONKT, merged_port, false);
+  if (1 < num_merged_ports) {
+    fp << '}';
+  }
+}
+
 /********************************************************************
  * Generate a bus port (could be used to create a local wire)
  * for a list of Verilog ports
@@ -758,6 +843,32 @@ std::string generate_verilog_constant_values(
   return str;
 }
 
+/********************************************************************
+ * Print a constant value to a stream, in the same format as
+ * generate_verilog_constant_values()
+ *******************************************************************/
+void print_verilog_constant_values(std::ostream& fp,
+                                   const std::vector<size_t>& const_values,
+                                   const bool& short_constant) {
+  VTR_ASSERT(!const_values.empty());
+
+  bool same_values = (true == short_constant) && (1 < const_values.size());
+  size_t first_val = const_values.back();
+  for (size_t ival = 0; (true == same_values) && (ival < const_values.size());
+       ++ival) {
+    same_values = (first_val == const_values[ival]);
+  }
+
+  if (true == same_values) {
+    fp << '{' << const_values.size() << "{1'b" << first_val << "}}";
+    return;
+  }
+  fp << const_values.size() << "'b";
+  for (const auto& val : const_values) {
+    fp << val;
+  }
+}
+
 /********************************************************************
  * Generate a verilog port with a deposit of constant values
  ********************************************************************/
@@ -818,8 +929,10 @@ void print_verilog_wire_constant_values(
 
   fp << "\t";
   fp << "assign ";
-  fp << generate_verilog_port_constant_values(output_port, const_values);
-  fp << ";" << std::endl;
+  print_verilog_port(fp, VERILOG_PORT_CONKT, output_port);
+  fp << " = ";
+  print_verilog_constant_values(fp, const_values);
+  fp << ";" << '\n';
 }
 
 /********************************************************************
@@ -833,10 +946,10 @@ void print_verilog_deposit_wire_constant_values(
 
   fp << "\t";
   fp << "$deposit(";
-  fp << generate_verilog_port(VERILOG_PORT_CONKT, output_port);
+  print_verilog_port(fp, VERILOG_PORT_CONKT, output_port);
   fp << ", ";
-  fp << generate_verilog_constant_values(const_values);
-  fp << ");" << std::endl;
+  print_verilog_constant_values(fp, const_values);
+  fp << ");" << '\n';
 }
 
 /********************************************************************
@@ -851,8 +964,10 @@ void print_verilog_force_wire_constant_values(
 
   fp << "\t";
   fp << "force ";
-  fp << generate_verilog_port_constant_values(output_port, const_values);
-  fp << ";" << std::endl;
+  print_verilog_port(fp, VERILOG_PORT_CONKT, output_port);
+  fp << " = ";
+  print_verilog_constant_values(fp, const_values);
+  fp << ";" << '\n';
 }
 
 /********************************************************************
@@ -871,15 +986,15 @@ void print_verilog_wire_connection(std::fstream& fp,
 
   fp << "\t";
   fp << "assign ";
-  fp << generate_verilog_port(VERILOG_PORT_CONKT, output_port);
+  print_verilog_port(fp, VERILOG_PORT_CONKT, output_port);
   fp << " = ";
 
   if (true == inverted) {
     fp << "~";
   }
 
-  fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port);
-  fp << ";" << std::endl;
+  print_verilog_port(fp, VERILOG_PORT_CONKT, input_port);
+  fp << ";" << '\n';
 }
 
 /********************************************************************
@@ -897,15 +1012,15 @@ void print_verilog_register_connection(std::fstream& fp,
   VTR_ASSERT(input_port.get_width() == output_port.get_width());
 
   fp << "\t";
-  fp << generate_verilog_port(VERILOG_PORT_CONKT, output_port);
+  print_verilog_port(fp, VERILOG_PORT_CONKT, output_port);
   fp << " <= ";
 
   if (true == inverted) {
     fp << "~";
   }
 
-  fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port);
-  fp << ";" << std::endl;
+  print_verilog_port(fp, VERILOG_PORT_CONKT, input_port);
+  fp << ";" << '\n';
 }
 
 /********************************************************************
@@ -1078,7 +1193,7 @@ void print_verilog_local_sram_wires(std::fstream& fp,
       BasicPort ccff_config_bus_port(generate_local_config_bus_port_name(),
                                      port_size);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, ccff_config_bus_port)
-         << ";" << std::endl;
+         << ";" << '\n';
       /* Connect first CCFF to the head */
       /* Head is always a 1-bit port */
       BasicPort ccff_head_port(
@@ -1115,7 +1230,7 @@ void print_verilog_local_sram_wires(std::fstream& fp,
       /* Print local wire definition */
       for (const auto& sram_port : sram_ports) {
         fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_port) << ";"
-           << std::endl;
+           << '\n';
       }
 
       break;
@@ -1205,13 +1320,13 @@ void print_verilog_local_config_bus(
                               prefix, instance_id, CIRCUIT_MODEL_PORT_INPUT),
                             num_conf_bits);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, config_port) << ";"
-         << std::endl;
+         << '\n';
       BasicPort inverted_config_port(
         generate_local_sram_port_name(prefix, instance_id,
                                       CIRCUIT_MODEL_PORT_OUTPUT),
         num_conf_bits);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_config_port)
-         << ";" << std::endl;
+         << ";" << '\n';
       break;
     }
     default:
@@ -1279,24 +1394,22 @@ static void print_verilog_rram_mux_config_bus(
         generate_reserved_sram_port_name(CIRCUIT_MODEL_PORT_BL),
         num_reserved_conf_bits);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_bl_bus) << ";"
-         << std::endl;
+         << '\n';
       BasicPort reserved_wl_bus(
         generate_reserved_sram_port_name(CIRCUIT_MODEL_PORT_WL),
         num_reserved_conf_bits);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_wl_bus) << ";"
-         << std::endl;
+         << '\n';
 
       /* Print configuration bus to group BL/WLs */
       BasicPort bl_bus(generate_mux_config_bus_port_name(circuit_lib, mux_model,
                                                          mux_size, 0, false),
                        num_conf_bits + num_reserved_conf_bits);
-      fp << generate_verilog_port(VERILOG_PORT_WIRE, bl_bus) << ";"
-         << std::endl;
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, bl_bus) << ";" << '\n';
       BasicPort wl_bus(generate_mux_config_bus_port_name(circuit_lib, mux_model,
                                                          mux_size, 1, false),
                        num_conf_bits + num_reserved_conf_bits);
-      fp << generate_verilog_port(VERILOG_PORT_WIRE, wl_bus) << ";"
-         << std::endl;
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, wl_bus) << ";" << '\n';
 
       /* Print bus to group SRAM outputs, this is to interface memory cells to
        * routing multiplexers */
@@ -1305,13 +1418,13 @@ static void print_verilog_rram_mux_config_bus(
                                     mux_instance_id, CIRCUIT_MODEL_PORT_INPUT),
         num_conf_bits);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_output_bus) << ";"
-         << std::endl;
+         << '\n';
       BasicPort inverted_sram_output_bus(
         generate_mux_sram_port_name(circuit_lib, mux_model, mux_size,
                                     mux_instance_id, CIRCUIT_MODEL_PORT_OUTPUT),
         num_conf_bits);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_sram_output_bus)
-         << ";" << std::endl;
+         << ";" << '\n';
 
       /* Get the SRAM model of the mux_model */
       std::vector<CircuitModelId> sram_models =
@@ -1443,13 +1556,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp, const BasicPort& port,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial" << '\n';
+  fp << "\tbegin" << '\n';
   fp << "\t";
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   /* if flip_value is the same as initial value, we do not need to flip the
    * signal ! */
@@ -1459,13 +1572,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp, const BasicPort& port,
     std::vector<size_t> port_flip_values(port.get_width(), flip_value);
     fp << "\t";
     fp << generate_verilog_port_constant_values(port, port_flip_values);
-    fp << ";" << std::endl;
+    fp << ";" << '\n';
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << '\n';
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -1487,21 +1600,21 @@ void print_verilog_shifted_clock_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
+  fp << "initial" << '\n';
 
   write_tab_to_file(fp, 1);
-  fp << "begin" << std::endl;
+  fp << "begin" << '\n';
 
   write_tab_to_file(fp, 1);
   std::vector<size_t> initial_values(port.get_width(), initial_value);
 
   write_tab_to_file(fp, 1);
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   write_tab_to_file(fp, 2);
   fp << "#" << std::setprecision(10) << initial_delay;
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   write_tab_to_file(fp, 2);
   fp << "forever ";
@@ -1509,13 +1622,13 @@ void print_verilog_shifted_clock_stimuli(std::fstream& fp,
   fp << " = ";
   fp << "#" << std::setprecision(10) << pulse_width;
   fp << " ~" << generate_verilog_port(VERILOG_PORT_CONKT, port);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   write_tab_to_file(fp, 1);
-  fp << "end" << std::endl;
+  fp << "end" << '\n';
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -1539,17 +1652,17 @@ void print_verilog_pulse_stimuli(std::fstream& fp, const BasicPort& port,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial" << '\n';
+  fp << "\tbegin" << '\n';
   fp << "\t";
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
   /* Set a wait condition if specified */
   if (false == wait_condition.empty()) {
-    fp << "\twait(" << wait_condition << ")" << std::endl;
+    fp << "\twait(" << wait_condition << ")" << '\n';
   }
 
   /* Number of flip conditions and values should match */
@@ -1560,13 +1673,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp, const BasicPort& port,
     std::vector<size_t> port_flip_value(port.get_width(), flip_values[ipulse]);
     fp << "\t";
     fp << generate_verilog_port_constant_values(port, port_flip_value);
-    fp << ";" << std::endl;
+    fp << ";" << '\n';
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << '\n';
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -1589,25 +1702,25 @@ void print_verilog_clock_stimuli(std::fstream& fp, const BasicPort& port,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial" << '\n';
+  fp << "\tbegin" << '\n';
 
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << '\n';
   fp << "always";
 
   /* Set a wait condition if specified */
   if (true == wait_condition.empty()) {
-    fp << std::endl;
+    fp << '\n';
   } else {
-    fp << " wait(" << wait_condition << ")" << std::endl;
+    fp << " wait(" << wait_condition << ")" << '\n';
   }
 
-  fp << "\tbegin" << std::endl;
+  fp << "\tbegin" << '\n';
   fp << "\t\t"
      << "#" << std::setprecision(10) << pulse_width;
 
@@ -1616,12 +1729,12 @@ void print_verilog_clock_stimuli(std::fstream& fp, const BasicPort& port,
   fp << " = ";
   fp << "~";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, port);
-  fp << ";" << std::endl;
+  fp << ";" << '\n';
 
-  fp << "\tend" << std::endl;
+  fp << "\tend" << '\n';
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -1636,7 +1749,7 @@ void print_verilog_netlist_include_header_file(
                             std::string(header_file_name));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   VTR_ASSERT(true == valid_file_stream(fp));
@@ -1647,11 +1760,45 @@ void print_verilog_netlist_include_header_file(
 
   /* Output file names */
   for (const std::string& netlist_name : netlists_to_be_included) {
-    fp << "`include \"" << netlist_name << "\"" << std::endl;
+    fp << "`include \"" << netlist_name << "\"" << '\n';
   }
 
   /* close file stream */
   fp.close();
 }
 
+/********************************************************************
+ * Print a number of Verilog netlists, each of which is written by a task
+ * that registers its netlists in the netlist manager given.
+ * Tasks are independent from each other, as they only read the module
+ * manager, so that they can run concurrently, each with its own netlist
+ * manager. The netlists are then registered in the sequence of tasks,
+ * which is the same as running the tasks in sequence.
+ *******************************************************************/
+void print_verilog_netlists(
+  NetlistManager& netlist_manager,
+  const std::vector<std::function<void(NetlistManager&)>>& print_tasks,
+  const size_t& num_threads) {
+  ScopedProgress progress("Write Verilog netlists", "tasks",
+                          print_tasks.size());
+  if ((1 >= num_threads) || (1 >= print_tasks.size())) {
+    for (const auto& print_task : print_tasks) {
+      print_task(netlist_manager);
+      progress.advance();
+    }
+    return;
+  }
+
+  std::vector<NetlistManager> task_netlist_managers(print_tasks.size());
+  parallel_for_dynamic(print_tasks.size(), num_threads,
+                       [&](const size_t& itask) {
+                         print_tasks[itask](task_netlist_managers[itask]);
+                         progress.advance();
+                       });
+
+  for (const NetlistManager& task_netlist_manager : task_netlist_managers) {
+    netlist_manager.add_netlists(task_netlist_manager);
+  }
+}
+
 } /* end namespace openfpga */
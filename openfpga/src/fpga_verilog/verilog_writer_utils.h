@@ -10,11 +10,14 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <fstream>
+#include <functional>
+#include <ostream>
 #include <string>
 #include <vector>
 
 #include "circuit_library.h"
 #include "module_manager.h"
+#include "netlist_manager.h"
 #include "openfpga_port.h"
 #include "verilog_port_types.h"
 
@@ -88,6 +91,12 @@ std::string generate_verilog_port(
   const BasicPort& port_info, const bool& must_print_port_size = true,
   const bool& big_endian = true);
 
+void print_verilog_port(std::ostream& fp,
+                        const enum e_dump_verilog_port_type& dump_port_type,
+                        const BasicPort& port_info,
+                        const bool& must_print_port_size = true,
+                        const bool& big_endian = true);
+
 bool two_verilog_ports_mergeable(const BasicPort& portA,
                                  const BasicPort& portB);
 
@@ -99,6 +108,9 @@ std::vector<BasicPort> combine_verilog_ports(
 
 std::string generate_verilog_ports(const std::vector<BasicPort>& merged_ports);
 
+void print_verilog_ports(std::ostream& fp,
+                         const std::vector<BasicPort>& ports);
+
 BasicPort generate_verilog_bus_port(const std::vector<BasicPort>& input_ports,
                                     const std::string& bus_port_name);
 
@@ -108,6 +120,10 @@ std::string generate_verilog_local_wire(
 std::string generate_verilog_constant_values(
   const std::vector<size_t>& const_values, const bool& short_constant = true);
 
+void print_verilog_constant_values(std::ostream& fp,
+                                   const std::vector<size_t>& const_values,
+                                   const bool& short_constant = true);
+
 std::string generate_verilog_port_constant_values(
   const BasicPort& output_port, const std::vector<size_t>& const_values,
   const bool& is_register = false);
@@ -196,6 +212,11 @@ void print_verilog_netlist_include_header_file(
   const char* subckt_dir, const char* header_file_name,
   const bool& include_time_stamp);
 
+void print_verilog_netlists(
+  NetlistManager& netlist_manager,
+  const std::vector<std::function<void(NetlistManager&)>>& print_tasks,
+  const size_t& num_threads);
+
 } /* end namespace openfpga */
 
 #endif
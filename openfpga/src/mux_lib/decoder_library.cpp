@@ -69,21 +69,34 @@ DecoderId DecoderLibrary::find_decoder(const size_t& addr_size,
                                        const bool& use_data_in,
                                        const bool& use_data_inv_port,
                                        const bool& use_readback) const {
-  for (auto decoder : decoders()) {
-    if ((addr_size == addr_sizes_[decoder]) &&
-        (data_size == data_sizes_[decoder]) &&
-        (use_enable == use_enable_[decoder]) &&
-        (use_data_in == use_data_in_[decoder]) &&
-        (use_data_inv_port == use_data_inv_port_[decoder]) &&
-        (use_readback == use_readback_[decoder])) {
-      return decoder;
-    }
+  auto result = decoder_lookup_.find(
+    decoder_key(addr_size, data_size, use_enable, use_data_in,
+                use_data_inv_port, use_readback));
+  if (result != decoder_lookup_.end()) {
+    return result->second;
   }
 
   /* Not found, return an invalid id by default */
   return DecoderId::INVALID();
 }
 
+/***************************************************************************************
+ * Private Accessors
+ **************************************************************************************/
+uint64_t DecoderLibrary::decoder_key(const size_t& addr_size,
+                                     const size_t& data_size,
+                                     const bool& use_enable,
+                                     const bool& use_data_in,
+                                     const bool& use_data_inv_port,
+                                     const bool& use_readback) {
+  /* The address size is the log2 of the data size, so 8 bits are enough */
+  VTR_ASSERT(addr_size < (1ULL << 8));
+  VTR_ASSERT(uint64_t(data_size) < (1ULL << 52));
+  return (uint64_t(data_size) << 12) | (uint64_t(addr_size) << 4) |
+         (uint64_t(use_enable) << 3) | (uint64_t(use_data_in) << 2) |
+         (uint64_t(use_data_inv_port) << 1) | uint64_t(use_readback);
+}
+
 /***************************************************************************************
  * Public Validators
  **************************************************************************************/
@@ -114,7 +127,51 @@ DecoderId DecoderLibrary::add_decoder(const size_t& addr_size,
   use_data_inv_port_.push_back(use_data_inv_port);
   use_readback_.push_back(use_readback);
 
+  /* Keep the first decoder of a specification in the look-up */
+  decoder_lookup_.emplace(decoder_key(addr_size, data_size, use_enable,
+                                      use_data_in, use_data_inv_port,
+                                      use_readback),
+                          decoder);
+
   return decoder;
 }
 
+/***************************************************************************************
+ * Private Mutators
+ **************************************************************************************/
+void DecoderLibrary::build_decoder_lookup() {
+  decoder_lookup_.clear();
+  for (const DecoderId& decoder : decoders()) {
+    decoder_lookup_.emplace(
+      decoder_key(addr_sizes_[decoder], data_sizes_[decoder],
+                  use_enable_[decoder], use_data_in_[decoder],
+                  use_data_inv_port_[decoder], use_readback_[decoder]),
+      decoder);
+  }
+}
+
+/***************************************************************************************
+ * Public binary image writer/reader
+ **************************************************************************************/
+void DecoderLibrary::write_to_binary_image(BinaryImageWriter& writer) const {
+  write_binary_image(writer, decoder_ids_);
+  write_binary_image(writer, addr_sizes_);
+  write_binary_image(writer, data_sizes_);
+  write_binary_image(writer, use_enable_);
+  write_binary_image(writer, use_data_in_);
+  write_binary_image(writer, use_data_inv_port_);
+  write_binary_image(writer, use_readback_);
+}
+
+void DecoderLibrary::read_from_binary_image(BinaryImageReader& reader) {
+  read_binary_image(reader, decoder_ids_);
+  read_binary_image(reader, addr_sizes_);
+  read_binary_image(reader, data_sizes_);
+  read_binary_image(reader, use_enable_);
+  read_binary_image(reader, use_data_in_);
+  read_binary_image(reader, use_data_inv_port_);
+  read_binary_image(reader, use_readback_);
+  build_decoder_lookup();
+}
+
 } /* End namespace openfpga*/
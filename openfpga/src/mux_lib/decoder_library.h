@@ -22,7 +22,11 @@
 #ifndef DECODER_LIBRARY_H
 #define DECODER_LIBRARY_H
 
+#include <cstdint>
+#include <unordered_map>
+
 #include "decoder_library_fwd.h"
+#include "openfpga_binary_image.h"
 #include "vtr_range.h"
 #include "vtr_vector.h"
 
@@ -79,6 +83,22 @@ class DecoderLibrary {
                         const bool& use_data_inv_port,
                         const bool& use_readback);
 
+ public: /* Public binary image writer/reader */
+  /* Write all the internal data to a binary image */
+  void write_to_binary_image(BinaryImageWriter& writer) const;
+  /* Replace all the internal data with the data of a binary image */
+  void read_from_binary_image(BinaryImageReader& reader);
+
+ private: /* Private accessors */
+  /* Pack the specification of a decoder into a key of the fast look-up */
+  static uint64_t decoder_key(const size_t& addr_size, const size_t& data_size,
+                              const bool& use_enable, const bool& use_data_in,
+                              const bool& use_data_inv_port,
+                              const bool& use_readback);
+
+ private: /* Private mutators */
+  void build_decoder_lookup();
+
  private: /* Internal Data */
   vtr::vector<DecoderId, DecoderId> decoder_ids_;
   vtr::vector<DecoderId, size_t> addr_sizes_;
@@ -87,6 +107,10 @@ class DecoderLibrary {
   vtr::vector<DecoderId, bool> use_data_in_;
   vtr::vector<DecoderId, bool> use_data_inv_port_;
   vtr::vector<DecoderId, bool> use_readback_;
+
+  /* fast look-up for decoders: [decoder_key] -> the first decoder added with
+   * the specification */
+  std::unordered_map<uint64_t, DecoderId> decoder_lookup_;
 };
 
 } /* End namespace openfpga*/
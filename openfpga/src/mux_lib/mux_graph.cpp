@@ -104,7 +104,7 @@ size_t MuxGraph::num_inputs() const {
   VTR_ASSERT_SAFE(valid_mux_graph());
   /* Sum up the number of INPUT nodes in each level */
   size_t num_inputs = 0;
-  for (auto node_per_level : node_lookup_) {
+  for (const auto& node_per_level : node_lookup_) {
     num_inputs += node_per_level[MUX_INPUT_NODE].size();
   }
   return num_inputs;
@@ -116,7 +116,7 @@ std::vector<MuxNodeId> MuxGraph::inputs() const {
   /* need to check if the graph is valid or not */
   VTR_ASSERT_SAFE(valid_mux_graph());
   /* Add the input nodes in each level */
-  for (auto node_per_level : node_lookup_) {
+  for (const auto& node_per_level : node_lookup_) {
     input_nodes.insert(input_nodes.end(),
                        node_per_level[MUX_INPUT_NODE].begin(),
                        node_per_level[MUX_INPUT_NODE].end());
@@ -130,7 +130,7 @@ size_t MuxGraph::num_outputs() const {
   VTR_ASSERT_SAFE(valid_mux_graph());
   /* Sum up the number of INPUT nodes in each level */
   size_t num_outputs = 0;
-  for (auto node_per_level : node_lookup_) {
+  for (const auto& node_per_level : node_lookup_) {
     num_outputs += node_per_level[MUX_OUTPUT_NODE].size();
   }
   return num_outputs;
@@ -142,7 +142,7 @@ std::vector<MuxNodeId> MuxGraph::outputs() const {
   /* need to check if the graph is valid or not */
   VTR_ASSERT_SAFE(valid_mux_graph());
   /* Add the output nodes in each level */
-  for (auto node_per_level : node_lookup_) {
+  for (const auto& node_per_level : node_lookup_) {
     output_nodes.insert(output_nodes.end(),
                         node_per_level[MUX_OUTPUT_NODE].begin(),
                         node_per_level[MUX_OUTPUT_NODE].end());
@@ -238,14 +238,16 @@ size_t MuxGraph::node_index_at_level(const MuxNodeId& node) const {
 }
 
 /* Find the  input edges for a node */
-std::vector<MuxEdgeId> MuxGraph::node_in_edges(const MuxNodeId& node) const {
+const std::vector<MuxEdgeId>& MuxGraph::node_in_edges(
+  const MuxNodeId& node) const {
   /* validate the node */
   VTR_ASSERT(valid_node_id(node));
   return node_in_edges_[node];
 }
 
 /* Find the input nodes for a edge */
-std::vector<MuxNodeId> MuxGraph::edge_src_nodes(const MuxEdgeId& edge) const {
+const std::vector<MuxNodeId>& MuxGraph::edge_src_nodes(
+  const MuxEdgeId& edge) const {
   /* validate the edge */
   VTR_ASSERT(valid_edge_id(edge));
   return edge_src_nodes_[edge];
@@ -948,7 +950,7 @@ void MuxGraph::build_multilevel_mux_graph(const size_t& mux_size,
 
         /* Sort the nodes by the levels and offset */
         size_t input_cnt = 0;
-        for (auto lvl_nodes : node_lookup) {
+        for (const auto& lvl_nodes : node_lookup) {
           for (MuxNodeId cand_node : lvl_nodes) {
             if (MUX_INPUT_NODE != node_types_[cand_node]) {
               continue;
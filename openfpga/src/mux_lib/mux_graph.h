@@ -102,10 +102,10 @@ class MuxGraph {
   size_t node_level(const MuxNodeId& node) const;
   /* Find the index of a node at its level */
   size_t node_index_at_level(const MuxNodeId& node) const;
-  /* Find the input edges for a node */
-  std::vector<MuxEdgeId> node_in_edges(const MuxNodeId& node) const;
-  /* Find the input nodes for a edge */
-  std::vector<MuxNodeId> edge_src_nodes(const MuxEdgeId& edge) const;
+  /* Find the input edges for a node, without copying them */
+  const std::vector<MuxEdgeId>& node_in_edges(const MuxNodeId& node) const;
+  /* Find the input nodes for a edge, without copying them */
+  const std::vector<MuxNodeId>& edge_src_nodes(const MuxEdgeId& edge) const;
   /* Find the mem that control the edge */
   MuxMemId find_edge_mem(const MuxEdgeId& edge) const;
   /* Identify if the edge is controlled by the inverted output of a mem */
@@ -5,6 +5,8 @@
 
 #include "mux_library.h"
 
+#include "mux_utils.h"
+#include "openfpga_parallel.h"
 #include "vtr_assert.h"
 
 /* begin namespace openfpga */
@@ -37,7 +39,22 @@ MuxId MuxLibrary::mux_graph(const CircuitModelId& circuit_model,
 
 const MuxGraph& MuxLibrary::mux_graph(const MuxId& mux_id) const {
   VTR_ASSERT_SAFE(valid_mux_id(mux_id));
-  return mux_graphs_[mux_id];
+  return structure_graphs_[mux_structure_ids_[mux_id]];
+}
+
+const std::vector<MuxGraph>& MuxLibrary::mux_branch_graphs(
+  const MuxId& mux_id) const {
+  VTR_ASSERT_SAFE(valid_mux_id(mux_id));
+  return structure_branch_graphs_[mux_structure_ids_[mux_id]];
+}
+
+const vtr::vector<MuxMemId, bool>& MuxLibrary::mux_input_memory_bits(
+  const MuxId& mux_id, const MuxInputId& input_id) const {
+  VTR_ASSERT_SAFE(valid_mux_id(mux_id));
+  size_t structure_id = mux_structure_ids_[mux_id];
+  VTR_ASSERT(size_t(input_id) <
+             structure_input_memory_bits_[structure_id].size());
+  return structure_input_memory_bits_[structure_id][input_id];
 }
 
 /* Get a mux circuit model id */
@@ -51,11 +68,44 @@ size_t MuxLibrary::max_mux_size() const {
   /* Iterate over all the mux graphs and find their sizes */
   size_t max_mux_size = 0;
   for (const auto& mux : mux_ids_) {
-    max_mux_size = std::max(max_mux_size, mux_graphs_[mux].num_inputs());
+    max_mux_size = std::max(max_mux_size, mux_graph(mux).num_inputs());
   }
   return max_mux_size;
 }
 
+/**************************************************
+ * Private accessors
+ *************************************************/
+/* Find the structure of the graph to be built for a mux, following the
+ * same rules as MuxGraph::build_mux_graph() */
+MuxLibrary::MuxStructureKey MuxLibrary::find_mux_structure_key(
+  const CircuitLibrary& circuit_lib, const CircuitModelId& circuit_model,
+  const size_t& mux_size) {
+  size_t impl_mux_size =
+    find_mux_implementation_num_inputs(circuit_lib, circuit_model, mux_size);
+  enum e_circuit_model_structure impl_structure =
+    find_mux_implementation_structure(circuit_lib, circuit_model,
+                                      impl_mux_size);
+
+  size_t num_levels = 1;
+  if (CIRCUIT_MODEL_STRUCTURE_TREE == impl_structure) {
+    num_levels = find_treelike_mux_num_levels(impl_mux_size);
+  } else if (CIRCUIT_MODEL_STRUCTURE_MULTILEVEL == impl_structure) {
+    num_levels = circuit_lib.mux_num_levels(circuit_model);
+  }
+
+  /* The outputs of fracturable LUTs depend on the ports of the model */
+  CircuitModelId frac_lut_model = CircuitModelId::INVALID();
+  if ((CIRCUIT_MODEL_LUT == circuit_lib.model_type(circuit_model)) &&
+      (true == circuit_lib.is_lut_fracturable(circuit_model))) {
+    frac_lut_model = circuit_model;
+  }
+
+  return std::make_tuple(impl_mux_size, impl_structure, num_levels,
+                         circuit_lib.pass_gate_logic_model(circuit_model),
+                         frac_lut_model);
+}
+
 /**************************************************
  * Private mutators:
  *************************************************/
@@ -63,22 +113,94 @@ size_t MuxLibrary::max_mux_size() const {
 void MuxLibrary::add_mux(const CircuitLibrary& circuit_lib,
                          const CircuitModelId& circuit_model,
                          const size_t& mux_size) {
-  /* First, check if there is already an existing graph */
-  if (valid_mux_size(circuit_model, mux_size)) {
-    return;
+  add_muxes(circuit_lib, {std::make_pair(circuit_model, mux_size)}, 1);
+}
+
+/* Add a list of muxes to the library. Mux ids are assigned in the order
+ * of the list, while the graphs of the new mux structures, which are
+ * independent from each other, are built in parallel */
+void MuxLibrary::add_muxes(
+  const CircuitLibrary& circuit_lib,
+  const std::vector<std::pair<CircuitModelId, size_t>>& muxes,
+  const size_t& num_threads) {
+  size_t num_old_structures = structure_graphs_.size();
+  /* The first mux of each new structure, used to build its graph */
+  std::vector<std::pair<CircuitModelId, size_t>> new_structure_muxes;
+  /* Structures whose input memory bits should be decoded */
+  std::vector<size_t> decode_structure_ids;
+  std::vector<bool> structure_to_decode(num_old_structures, false);
+
+  for (const auto& mux_to_add : muxes) {
+    const CircuitModelId& circuit_model = mux_to_add.first;
+    const size_t& mux_size = mux_to_add.second;
+    /* First, check if there is already an existing graph */
+    if (valid_mux_size(circuit_model, mux_size)) {
+      continue;
+    }
+
+    /* create a new id for the mux */
+    MuxId mux = MuxId(mux_ids_.size());
+    /* Push to the node list */
+    mux_ids_.push_back(mux);
+    /* Share the mux graph with the muxes of the same structure, or build it
+     * later if it is a new structure */
+    MuxStructureKey structure_key =
+      find_mux_structure_key(circuit_lib, circuit_model, mux_size);
+    auto result = structure_lookup_.emplace(
+      structure_key, num_old_structures + new_structure_muxes.size());
+    if (true == result.second) {
+      new_structure_muxes.push_back(mux_to_add);
+      structure_to_decode.push_back(false);
+    }
+    size_t structure_id = result.first->second;
+    mux_structure_ids_.push_back(structure_id);
+
+    /* Decode the memory bits of each input for routing multiplexers */
+    if ((CIRCUIT_MODEL_MUX == circuit_lib.model_type(circuit_model)) &&
+        (false == structure_to_decode[structure_id]) &&
+        ((structure_id >= num_old_structures) ||
+         (true == structure_input_memory_bits_[structure_id].empty()))) {
+      structure_to_decode[structure_id] = true;
+      decode_structure_ids.push_back(structure_id);
+    }
+    /* Recorde mux cirucit model id */
+    mux_circuit_models_.push_back(circuit_model);
+
+    /* update mux_lookup*/
+    mux_lookup_[circuit_model][mux_size] = mux;
   }
 
-  /* create a new id for the mux */
-  MuxId mux = MuxId(mux_ids_.size());
-  /* Push to the node list */
-  mux_ids_.push_back(mux);
-  /* Add a mux graph */
-  mux_graphs_.push_back(MuxGraph(circuit_lib, circuit_model, mux_size));
-  /* Recorde mux cirucit model id */
-  mux_circuit_models_.push_back(circuit_model);
-
-  /* update mux_lookup*/
-  mux_lookup_[circuit_model][mux_size] = mux;
+  /* Build the graphs of the new structures */
+  size_t num_structures = num_old_structures + new_structure_muxes.size();
+  structure_graphs_.resize(num_structures);
+  structure_branch_graphs_.resize(num_structures);
+  structure_input_memory_bits_.resize(num_structures);
+  parallel_for_dynamic(
+    new_structure_muxes.size(), num_threads, [&](const size_t& imux) {
+      size_t structure_id = num_old_structures + imux;
+      structure_graphs_[structure_id] =
+        MuxGraph(circuit_lib, new_structure_muxes[imux].first,
+                 new_structure_muxes[imux].second);
+      structure_branch_graphs_[structure_id] =
+        structure_graphs_[structure_id].build_mux_branch_graphs();
+    });
+
+  /* Decode the memory bits of each input */
+  parallel_for_dynamic(
+    decode_structure_ids.size(), num_threads, [&](const size_t& istruct) {
+      size_t structure_id = decode_structure_ids[istruct];
+      const MuxGraph& structure_graph = structure_graphs_[structure_id];
+      vtr::vector<MuxInputId, vtr::vector<MuxMemId, bool>>&
+        input_memory_bits = structure_input_memory_bits_[structure_id];
+      VTR_ASSERT(1 == structure_graph.num_outputs());
+      MuxOutputId output_id =
+        structure_graph.output_id(structure_graph.outputs()[0]);
+      input_memory_bits.reserve(structure_graph.num_inputs());
+      for (size_t input = 0; input < structure_graph.num_inputs(); ++input) {
+        input_memory_bits.push_back(
+          structure_graph.decode_memory_bits(MuxInputId(input), output_id));
+      }
+    });
 }
 
 /**************************************************
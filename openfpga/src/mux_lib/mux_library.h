@@ -11,6 +11,9 @@
 #define MUX_LIBRARY_H
 
 #include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "mux_graph.h"
 #include "mux_library_fwd.h"
@@ -32,6 +35,13 @@ class MuxLibrary {
   MuxId mux_graph(const CircuitModelId& circuit_model,
                   const size_t& mux_size) const;
   const MuxGraph& mux_graph(const MuxId& mux_id) const;
+  /* Get the graphs of the unique branches of a mux, which are shared by
+   * all the muxes of the same structure */
+  const std::vector<MuxGraph>& mux_branch_graphs(const MuxId& mux_id) const;
+  /* Get the memory bits which route an input of a routing multiplexer to its
+   * output, as decoded by MuxGraph::decode_memory_bits() */
+  const vtr::vector<MuxMemId, bool>& mux_input_memory_bits(
+    const MuxId& mux_id, const MuxInputId& input_id) const;
   /* Get a mux circuit model id */
   CircuitModelId mux_circuit_model(const MuxId& mux_id) const;
   /* Find the mux sizes */
@@ -41,6 +51,11 @@ class MuxLibrary {
   /* Add a mux to the library */
   void add_mux(const CircuitLibrary& circuit_lib,
                const CircuitModelId& circuit_model, const size_t& mux_size);
+  /* Add a list of muxes to the library, building the graphs of new mux
+   * structures with the given number of threads */
+  void add_muxes(const CircuitLibrary& circuit_lib,
+                 const std::vector<std::pair<CircuitModelId, size_t>>& muxes,
+                 const size_t& num_threads);
 
  public: /* Public validators */
   bool valid_mux_id(const MuxId& mux) const;
@@ -51,6 +66,20 @@ class MuxLibrary {
   bool valid_mux_size(const CircuitModelId& circuit_model,
                       const size_t& mux_size) const;
 
+ private: /* Private types */
+  /* The parameters which define the structure of a mux graph:
+   * the implemented number of inputs, the structure, the number of levels,
+   * the pass-gate logic model and, for fracturable LUTs only, the circuit
+   * model whose output ports define the extra outputs */
+  typedef std::tuple<size_t, e_circuit_model_structure, size_t,
+                     CircuitModelId, CircuitModelId>
+    MuxStructureKey;
+
+ private: /* Private accessors */
+  static MuxStructureKey find_mux_structure_key(
+    const CircuitLibrary& circuit_lib, const CircuitModelId& circuit_model,
+    const size_t& mux_size);
+
  private: /* Private mutators: mux_lookup */
   void build_mux_lookup();
   /* Invalidate (empty) the mux fast lookup*/
@@ -59,11 +88,23 @@ class MuxLibrary {
  private: /* Internal data */
   /* MUX graph-based desription */
   vtr::vector<MuxId, MuxId> mux_ids_; /* Unique identifier for each mux graph */
-  vtr::vector<MuxId, MuxGraph>
-    mux_graphs_; /* Graphs describing MUX internal structures */
+  vtr::vector<MuxId, size_t>
+    mux_structure_ids_; /* Structure describing MUX internal structures */
   vtr::vector<MuxId, CircuitModelId>
     mux_circuit_models_; /* circuit model id in circuit library */
 
+  /* Graphs of the unique MUX structures, shared by the muxes of different
+   * circuit models and sizes which are implemented in the same way.
+   * The graphs of their unique branches are extracted once as well */
+  std::vector<MuxGraph> structure_graphs_;
+  std::vector<std::vector<MuxGraph>> structure_branch_graphs_;
+  /* Memory bits of each input of the structures used by routing
+   * multiplexers, which are decoded once rather than for each instance:
+   * [structure_id][input_id] */
+  std::vector<vtr::vector<MuxInputId, vtr::vector<MuxMemId, bool>>>
+    structure_input_memory_bits_;
+  std::map<MuxStructureKey, size_t> structure_lookup_;
+
   /* Local encoder description */
   // vtr::vector<MuxLocalDecoderId, Decoder> mux_local_encoders_; /* Graphs
   // describing MUX internal structures */
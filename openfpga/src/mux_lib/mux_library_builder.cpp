@@ -1,13 +1,21 @@
 /********************************************************************
  * This file includes the functions of builders for MuxLibrary.
  *******************************************************************/
+#include <algorithm>
 #include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+#include "openfpga_trace.h"
+
 /* Headers from readarchopenfpga library */
 #include "circuit_library.h"
 #include "circuit_library_utils.h"
@@ -23,19 +31,18 @@
 namespace openfpga {
 
 /********************************************************************
- * Update MuxLibrary with the unique multiplexer structures
- * found in the global routing architecture
+ * Find the multiplexers required by the routing tracks and input pins
+ * in a range of rr_nodes. Each multiplexer is listed once, in the order
+ * of its first appearance in the range.
+ * Return the first rr_node without circuit model, if any
  *******************************************************************/
-static void build_routing_arch_mux_library(
-  const RRGraphView& rr_graph, const CircuitLibrary& circuit_lib,
-  const VprDeviceAnnotation& vpr_device_annotation, MuxLibrary& mux_lib) {
-  /* The routing path is.
-   * OPIN ----> CHAN ----> ... ----> CHAN ----> IPIN
-   * Each edge is a switch, for IPIN, the switch is a connection block,
-   * for the rest is a switch box
-   */
-  /* Count the sizes of muliplexers in routing architecture */
-  for (const RRNodeId& node : rr_graph.nodes()) {
+static RRNodeId find_rr_node_range_muxes(
+  const RRGraphView& rr_graph, const VprDeviceAnnotation& vpr_device_annotation,
+  const size_t& node_begin, const size_t& node_end,
+  std::vector<std::pair<CircuitModelId, size_t>>& muxes) {
+  std::set<std::pair<CircuitModelId, size_t>> found_muxes;
+  for (size_t inode = node_begin; inode < node_end; ++inode) {
+    const RRNodeId node = RRNodeId(inode);
     switch (rr_graph.node_type(node)) {
       case IPIN:
       case CHANX:
@@ -54,19 +61,13 @@ static void build_routing_arch_mux_library(
           vpr_device_annotation.rr_switch_circuit_model(driver_switches[0]);
         /* we should select a circuit model for the routing resource switch */
         if (CircuitModelId::INVALID() == rr_switch_circuit_model) {
-          VTR_LOG_ERROR(
-            "Unable to find the circuit model for rr_switch '%s'!\n",
-            rr_graph.rr_switch_inf(driver_switches[0]).name);
-          VTR_LOG("Node type: %s\n", rr_graph.node_type_string(node));
-          VTR_LOG("Node coordinate: %s\n",
-                  rr_graph.node_coordinate_to_string(node).c_str());
-          exit(1);
+          return node;
+        }
+        std::pair<CircuitModelId, size_t> mux = std::make_pair(
+          rr_switch_circuit_model, rr_graph.node_in_edges(node).size());
+        if (true == found_muxes.insert(mux).second) {
+          muxes.push_back(mux);
         }
-
-        VTR_ASSERT(CircuitModelId::INVALID() != rr_switch_circuit_model);
-        /* Add the mux to mux_library */
-        mux_lib.add_mux(circuit_lib, rr_switch_circuit_model,
-                        rr_graph.node_in_edges(node).size());
         break;
       }
       default:
@@ -74,18 +75,63 @@ static void build_routing_arch_mux_library(
         break;
     }
   }
+  return RRNodeId::INVALID();
+}
+
+/********************************************************************
+ * Find the multiplexers required by the global routing architecture
+ * The rr_nodes are split into contiguous ranges which are scanned in
+ * parallel. Merging the ranges in order keeps the multiplexers in the
+ * order of their first appearance in the rr_graph
+ *******************************************************************/
+static void build_routing_arch_mux_library(
+  const RRGraphView& rr_graph, const VprDeviceAnnotation& vpr_device_annotation,
+  const size_t& num_threads,
+  std::vector<std::pair<CircuitModelId, size_t>>& muxes) {
+  /* The routing path is.
+   * OPIN ----> CHAN ----> ... ----> CHAN ----> IPIN
+   * Each edge is a switch, for IPIN, the switch is a connection block,
+   * for the rest is a switch box
+   */
+  size_t num_nodes = rr_graph.num_nodes();
+  size_t num_ranges = std::max(std::min(num_threads, num_nodes), size_t(1));
+  std::vector<std::vector<std::pair<CircuitModelId, size_t>>> range_muxes(
+    num_ranges);
+  std::vector<RRNodeId> range_error_nodes(num_ranges, RRNodeId::INVALID());
+  parallel_for(num_ranges, num_threads, [&](const size_t& irange) {
+    range_error_nodes[irange] = find_rr_node_range_muxes(
+      rr_graph, vpr_device_annotation, irange * num_nodes / num_ranges,
+      (irange + 1) * num_nodes / num_ranges, range_muxes[irange]);
+  });
+
+  for (size_t irange = 0; irange < num_ranges; ++irange) {
+    const RRNodeId& node = range_error_nodes[irange];
+    if (RRNodeId::INVALID() != node) {
+      std::vector<RRSwitchId> driver_switches =
+        get_rr_graph_driver_switches(rr_graph, node);
+      VTR_LOG_ERROR("Unable to find the circuit model for rr_switch '%s'!\n",
+                    rr_graph.rr_switch_inf(driver_switches[0]).name);
+      VTR_LOG("Node type: %s\n", rr_graph.node_type_string(node));
+      VTR_LOG("Node coordinate: %s\n",
+              rr_graph.node_coordinate_to_string(node).c_str());
+      exit(1);
+    }
+    /* Duplicated muxes across ranges are skipped by the mux library */
+    muxes.insert(muxes.end(), range_muxes[irange].begin(),
+                 range_muxes[irange].end());
+  }
 }
 
 /********************************************************************
  * For a given pin of a pb_graph_node
  * - Identify the interconnect implementation
  * - Find the number of inputs for the interconnect implementation
- * - Update the mux_library is the implementation is multiplexers
+ * - Collect the mux if the implementation is multiplexers
  ********************************************************************/
 static void build_pb_graph_pin_interconnect_mux_library(
   t_pb_graph_pin* pb_graph_pin, t_mode* interconnect_mode,
-  const CircuitLibrary& circuit_lib,
-  const VprDeviceAnnotation& vpr_device_annotation, MuxLibrary& mux_lib) {
+  const VprDeviceAnnotation& vpr_device_annotation,
+  std::vector<std::pair<CircuitModelId, size_t>>& muxes) {
   /* Find the interconnect in the physical mode that drives this pin */
   t_interconnect* physical_interc =
     pb_graph_pin_interc(pb_graph_pin, interconnect_mode);
@@ -99,8 +145,8 @@ static void build_pb_graph_pin_interconnect_mux_library(
   const CircuitModelId& interc_circuit_model =
     vpr_device_annotation.interconnect_circuit_model(physical_interc);
   VTR_ASSERT(CircuitModelId::INVALID() != interc_circuit_model);
-  /* Add the mux model to library */
-  mux_lib.add_mux(circuit_lib, interc_circuit_model, mux_size);
+  /* Add the mux model to the list */
+  muxes.push_back(std::make_pair(interc_circuit_model, mux_size));
 }
 
 /********************************************************************
@@ -108,8 +154,9 @@ static void build_pb_graph_pin_interconnect_mux_library(
  * found in programmable logic blocks
  ********************************************************************/
 static void rec_build_vpr_physical_pb_graph_node_mux_library(
-  t_pb_graph_node* pb_graph_node, const CircuitLibrary& circuit_lib,
-  const VprDeviceAnnotation& vpr_device_annotation, MuxLibrary& mux_lib) {
+  t_pb_graph_node* pb_graph_node,
+  const VprDeviceAnnotation& vpr_device_annotation,
+  std::vector<std::pair<CircuitModelId, size_t>>& muxes) {
   /* Find the number of inputs for each interconnect of this pb_graph_node
    * This is only applicable to each interconnect which will be implemented with
    * multiplexers
@@ -125,7 +172,7 @@ static void rec_build_vpr_physical_pb_graph_node_mux_library(
     for (int ipin = 0; ipin < pb_graph_node->num_input_pins[iport]; ++ipin) {
       build_pb_graph_pin_interconnect_mux_library(
         &(pb_graph_node->input_pins[iport][ipin]), parent_physical_mode,
-        circuit_lib, vpr_device_annotation, mux_lib);
+        vpr_device_annotation, muxes);
     }
   }
 
@@ -133,7 +180,7 @@ static void rec_build_vpr_physical_pb_graph_node_mux_library(
     for (int ipin = 0; ipin < pb_graph_node->num_clock_pins[iport]; ++ipin) {
       build_pb_graph_pin_interconnect_mux_library(
         &(pb_graph_node->clock_pins[iport][ipin]), parent_physical_mode,
-        circuit_lib, vpr_device_annotation, mux_lib);
+        vpr_device_annotation, muxes);
     }
   }
 
@@ -152,8 +199,8 @@ static void rec_build_vpr_physical_pb_graph_node_mux_library(
   for (int iport = 0; iport < pb_graph_node->num_output_ports; ++iport) {
     for (int ipin = 0; ipin < pb_graph_node->num_output_pins[iport]; ++ipin) {
       build_pb_graph_pin_interconnect_mux_library(
-        &(pb_graph_node->output_pins[iport][ipin]), physical_mode, circuit_lib,
-        vpr_device_annotation, mux_lib);
+        &(pb_graph_node->output_pins[iport][ipin]), physical_mode,
+        vpr_device_annotation, muxes);
     }
   }
 
@@ -163,7 +210,7 @@ static void rec_build_vpr_physical_pb_graph_node_mux_library(
          ++jpb) {
       rec_build_vpr_physical_pb_graph_node_mux_library(
         &(pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][jpb]),
-        circuit_lib, vpr_device_annotation, mux_lib);
+        vpr_device_annotation, muxes);
     }
   }
 }
@@ -172,8 +219,9 @@ static void rec_build_vpr_physical_pb_graph_node_mux_library(
  * Update MuxLibrary with the unique multiplexers required by
  * LUTs in the circuit library
  ********************************************************************/
-static void build_lut_mux_library(MuxLibrary& mux_lib,
-                                  const CircuitLibrary& circuit_lib) {
+static void build_lut_mux_library(
+  std::vector<std::pair<CircuitModelId, size_t>>& muxes,
+  const CircuitLibrary& circuit_lib) {
   /* Find all the circuit models which are LUTs in the circuit library */
   for (const auto& circuit_model : circuit_lib.models()) {
     /* Bypass non-LUT circuit models */
@@ -188,8 +236,8 @@ static void build_lut_mux_library(MuxLibrary& mux_lib,
     /* MUX size = 2^lut_size */
     size_t lut_mux_size =
       (size_t)pow(2., (double)(circuit_lib.port_size(input_ports[0])));
-    /* Add mux to the mux library */
-    mux_lib.add_mux(circuit_lib, circuit_model, lut_mux_size);
+    /* Add mux to the list */
+    muxes.push_back(std::make_pair(circuit_model, lut_mux_size));
   }
 }
 
@@ -199,19 +247,25 @@ static void build_lut_mux_library(MuxLibrary& mux_lib,
  * blocks and Configurable Logic Blocks In additional to multiplexers, this
  * function also consider crossbars. All the statistics are stored in a linked
  * list, as a return value
+ * The multiplexers are collected in order, and the graphs of the unique
+ * multiplexer structures are then built in parallel
  */
 MuxLibrary build_device_mux_library(const DeviceContext& vpr_device_ctx,
-                                    const OpenfpgaContext& openfpga_ctx) {
+                                    const OpenfpgaContext& openfpga_ctx,
+                                    const size_t& num_threads) {
   vtr::ScopedStartFinishTimer timer("Build a library of physical multiplexers");
+  OPENFPGA_TRACE_FUNCTION();
 
   /* MuxLibrary to store the information of Multiplexers*/
   MuxLibrary mux_lib;
+  /* Multiplexers to be added to the library, in the order of appearance */
+  std::vector<std::pair<CircuitModelId, size_t>> muxes;
 
   /* Step 1: We should check the multiplexer spice models defined in routing
    * architecture.*/
   build_routing_arch_mux_library(vpr_device_ctx.rr_graph,
-                                 openfpga_ctx.arch().circuit_lib,
-                                 openfpga_ctx.vpr_device_annotation(), mux_lib);
+                                 openfpga_ctx.vpr_device_annotation(),
+                                 num_threads, muxes);
 
   /* Step 2: Count the sizes of multiplexers in complex logic blocks */
   for (const t_logical_block_type& lb_type :
@@ -221,12 +275,14 @@ MuxLibrary build_device_mux_library(const DeviceContext& vpr_device_ctx,
       continue;
     }
     rec_build_vpr_physical_pb_graph_node_mux_library(
-      lb_type.pb_graph_head, openfpga_ctx.arch().circuit_lib,
-      openfpga_ctx.vpr_device_annotation(), mux_lib);
+      lb_type.pb_graph_head, openfpga_ctx.vpr_device_annotation(), muxes);
   }
 
   /* Step 3: count the size of multiplexer that will be used in LUTs*/
-  build_lut_mux_library(mux_lib, openfpga_ctx.arch().circuit_lib);
+  build_lut_mux_library(muxes, openfpga_ctx.arch().circuit_lib);
+
+  /* Step 4: build the graphs of the unique multiplexers */
+  mux_lib.add_muxes(openfpga_ctx.arch().circuit_lib, muxes, num_threads);
 
   VTR_LOG("Built a multiplexer library of %lu physical multiplexers.\n",
           mux_lib.muxes().size());
@@ -1,6 +1,8 @@
 /* SWIG interface file for OpenFPGA shell APIs */
 %module openfpga_shell
 
+%include "std_string.i"
+
 %{
 #include "openfpga_shell.h"
 %}
@@ -5,7 +5,11 @@
 /* Headers from vtrutil library */
 #include "build_physical_lb_rr_graph.h"
 
+#include <vector>
+
 #include "check_lb_rr_graph.h"
+#include "openfpga_parallel.h"
+#include "openfpga_trace.h"
 #include "pb_type_utils.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -300,8 +304,8 @@ static void rec_build_physical_lb_rr_edge_for_pb_graph_node(
  *physical modes only
  ***************************************************************************************/
 static LbRRGraph build_lb_type_physical_lb_rr_graph(
-  t_pb_graph_node* pb_graph_head, const VprDeviceAnnotation& device_annotation,
-  const bool& verbose) {
+  t_pb_graph_node* pb_graph_head,
+  const VprDeviceAnnotation& device_annotation) {
   LbRRGraph lb_rr_graph;
 
   /* TODO: ensure we have an empty lb_rr_graph */
@@ -397,47 +401,61 @@ static LbRRGraph build_lb_type_physical_lb_rr_graph(
     }
   }
 
-  VTR_LOGV(verbose, "\n\tNumber of nodes: %lu\n", lb_rr_graph.nodes().size());
-
-  VTR_LOGV(verbose, "\tNumber of edges: %lu\n", lb_rr_graph.edges().size());
-
   return lb_rr_graph;
 }
 
 /***************************************************************************************
  * This functio will create physical lb_rr_graph for each pb_graph considering
  *physical modes only the lb_rr_graph willbe added to device annotation
+ * The graphs of logical tiles are built and checked by a number of threads,
+ * and then added to device annotation in the sequence of logical tiles
  ***************************************************************************************/
 void build_physical_lb_rr_graphs(const DeviceContext& device_ctx,
                                  VprDeviceAnnotation& device_annotation,
+                                 const size_t& num_threads,
                                  const bool& verbose) {
   vtr::ScopedStartFinishTimer timer(
     "Build routing resource graph for the physical implementation of logical "
     "tile");
+  OPENFPGA_TRACE_FUNCTION();
 
+  std::vector<t_pb_graph_node*> pb_graph_heads;
   for (const t_logical_block_type& lb_type : device_ctx.logical_block_types) {
     /* By pass nullptr for pb_graph head */
     if (nullptr == lb_type.pb_graph_head) {
       continue;
     }
+    pb_graph_heads.push_back(lb_type.pb_graph_head);
+  }
 
-    VTR_LOGV(verbose,
-             "Building routing resource graph for logical tile '%s'...",
-             lb_type.pb_graph_head->pb_type->name);
-
-    const LbRRGraph& lb_rr_graph = build_lb_type_physical_lb_rr_graph(
-      lb_type.pb_graph_head,
-      const_cast<const VprDeviceAnnotation&>(device_annotation), verbose);
-    /* Check the rr_graph */
-    if (false == lb_rr_graph.validate()) {
-      exit(1);
-    }
-    if (false == check_lb_rr_graph(lb_rr_graph)) {
+  /* The graphs are independent from each other, and the device annotation
+   * is only read when building them */
+  std::vector<LbRRGraph> lb_rr_graphs(pb_graph_heads.size());
+  std::vector<char> lb_rr_graph_passed(pb_graph_heads.size(), false);
+  parallel_for_dynamic(
+    pb_graph_heads.size(), num_threads, [&](const size_t& igraph) {
+      lb_rr_graphs[igraph] = build_lb_type_physical_lb_rr_graph(
+        pb_graph_heads[igraph],
+        const_cast<const VprDeviceAnnotation&>(device_annotation));
+      /* Check the rr_graph */
+      lb_rr_graph_passed[igraph] = lb_rr_graphs[igraph].validate() &&
+                                   check_lb_rr_graph(lb_rr_graphs[igraph]);
+      /* The graph is read-only from now on */
+      lb_rr_graphs[igraph].freeze();
+    });
+
+  for (size_t igraph = 0; igraph < pb_graph_heads.size(); ++igraph) {
+    const LbRRGraph& lb_rr_graph = lb_rr_graphs[igraph];
+    VTR_LOGV(verbose, "Built routing resource graph for logical tile '%s'\n",
+             pb_graph_heads[igraph]->pb_type->name);
+    VTR_LOGV(verbose, "\tNumber of nodes: %lu\n", lb_rr_graph.nodes().size());
+    VTR_LOGV(verbose, "\tNumber of edges: %lu\n", lb_rr_graph.edges().size());
+    if (false == lb_rr_graph_passed[igraph]) {
       exit(1);
     }
     VTR_LOGV(verbose, "Check routing resource graph for logical tile passed\n");
 
-    device_annotation.add_physical_lb_rr_graph(lb_type.pb_graph_head,
+    device_annotation.add_physical_lb_rr_graph(pb_graph_heads[igraph],
                                                lb_rr_graph);
   }
 
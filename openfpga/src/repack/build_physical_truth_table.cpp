@@ -8,6 +8,8 @@
 
 #include "lut_utils.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
+#include "openfpga_trace.h"
 #include "pb_type_utils.h"
 #include "physical_pb.h"
 #include "vtr_assert.h"
@@ -19,6 +21,8 @@ namespace openfpga {
 
 /***************************************************************************************
  * Create pin rotation map for a LUT
+ * The pins of a port share the same circuit port and atom port, which are
+ * found once per port
  ***************************************************************************************/
 static std::vector<int> generate_lut_rotated_input_pin_map(
   const std::vector<AtomNetId>& input_nets, const AtomContext& atom_ctx,
@@ -31,42 +35,45 @@ static std::vector<int> generate_lut_rotated_input_pin_map(
   std::vector<int> rotated_pin_map(input_nets.size(), -1);
 
   for (int iport = 0; iport < pb_graph_node->num_input_ports; ++iport) {
-    for (int ipin = 0; ipin < pb_graph_node->num_input_pins[iport]; ++ipin) {
-      /* Skip the input pin that do not drive by LUT MUXes */
-      CircuitPortId circuit_port = device_annotation.pb_circuit_port(
-        pb_graph_node->input_pins[iport][ipin].port);
-      if (true == circuit_lib.port_is_harden_lut_port(circuit_port)) {
-        continue;
-      }
+    if (0 == pb_graph_node->num_input_pins[iport]) {
+      continue;
+    }
+    t_port* pb_type_in_port = pb_graph_node->input_pins[iport][0].port;
 
-      /* The lut pb_graph_node may not be the primitive node
-       * because VPR adds two default modes to its LUT pb_type
-       * If so, we will use the LUT mode of the pb_graph node
-       */
-      t_port* lut_pb_type_in_port = pb_graph_node->input_pins[iport][ipin].port;
-      if (0 != pb_graph_node->pb_type->num_modes) {
-        VTR_ASSERT(2 == pb_graph_node->pb_type->num_modes);
-        VTR_ASSERT(1 == pb_graph_node->pb_type->modes[VPR_PB_TYPE_LUT_MODE]
-                          .num_pb_type_children);
-        lut_pb_type_in_port =
-          &(pb_graph_node->pb_type->modes[VPR_PB_TYPE_LUT_MODE]
-              .pb_type_children[0]
-              .ports[iport]);
-        VTR_ASSERT(
-          std::string(lut_pb_type_in_port->name) ==
-          std::string(pb_graph_node->input_pins[iport][ipin].port->name));
-        VTR_ASSERT(lut_pb_type_in_port->num_pins ==
-                   pb_graph_node->input_pins[iport][ipin].port->num_pins);
-      }
+    /* Skip the input port that do not drive by LUT MUXes */
+    CircuitPortId circuit_port =
+      device_annotation.pb_circuit_port(pb_type_in_port);
+    if (true == circuit_lib.port_is_harden_lut_port(circuit_port)) {
+      continue;
+    }
 
-      /* Port exists (some LUTs may have no input and hence no port in the atom
-       * netlist) */
-      AtomPortId atom_port = atom_ctx.nlist.find_atom_port(
-        atom_blk, lut_pb_type_in_port->model_port);
-      if (!atom_port) {
-        continue;
-      }
+    /* The lut pb_graph_node may not be the primitive node
+     * because VPR adds two default modes to its LUT pb_type
+     * If so, we will use the LUT mode of the pb_graph node
+     */
+    t_port* lut_pb_type_in_port = pb_type_in_port;
+    if (0 != pb_graph_node->pb_type->num_modes) {
+      VTR_ASSERT(2 == pb_graph_node->pb_type->num_modes);
+      VTR_ASSERT(1 == pb_graph_node->pb_type->modes[VPR_PB_TYPE_LUT_MODE]
+                        .num_pb_type_children);
+      lut_pb_type_in_port =
+        &(pb_graph_node->pb_type->modes[VPR_PB_TYPE_LUT_MODE]
+            .pb_type_children[0]
+            .ports[iport]);
+      VTR_ASSERT(std::string(lut_pb_type_in_port->name) ==
+                 std::string(pb_type_in_port->name));
+      VTR_ASSERT(lut_pb_type_in_port->num_pins == pb_type_in_port->num_pins);
+    }
 
+    /* Port exists (some LUTs may have no input and hence no port in the atom
+     * netlist) */
+    AtomPortId atom_port = atom_ctx.nlist.find_atom_port(
+      atom_blk, lut_pb_type_in_port->model_port);
+    if (!atom_port) {
+      continue;
+    }
+
+    for (int ipin = 0; ipin < pb_graph_node->num_input_pins[iport]; ++ipin) {
       for (AtomPinId atom_pin : atom_ctx.nlist.port_pins(atom_port)) {
         AtomNetId atom_pin_net = atom_ctx.nlist.pin_net(atom_pin);
         if (atom_pin_net == input_nets[ipin]) {
@@ -226,16 +233,23 @@ static void build_physical_pb_lut_truth_tables(
  * Note that the truth table built here is different from the atom
  * netlists in VPR context. We consider fracturable LUT features
  * and LUTs operating as wires
+ * Each clustered block only modifies its own physical pb, so the blocks
+ * are processed on multiple threads
  ***************************************************************************************/
 void build_physical_lut_truth_tables(
   VprClusteringAnnotation& cluster_annotation, const AtomContext& atom_ctx,
   const ClusteringContext& cluster_ctx,
   const VprDeviceAnnotation& device_annotation,
-  const CircuitLibrary& circuit_lib, const bool& verbose) {
+  const CircuitLibrary& circuit_lib, const size_t& num_threads,
+  const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build truth tables for physical LUTs");
+  OPENFPGA_TRACE_FUNCTION();
 
-  for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
-    PhysicalPb& physical_pb = cluster_annotation.mutable_physical_pb(blk_id);
+  std::vector<ClusterBlockId> blocks(cluster_ctx.clb_nlist.blocks().begin(),
+                                     cluster_ctx.clb_nlist.blocks().end());
+  parallel_for_dynamic(blocks.size(), num_threads, [&](const size_t& iblk) {
+    PhysicalPb& physical_pb =
+      cluster_annotation.mutable_physical_pb(blocks[iblk]);
     /* Find the LUT physical pb id */
     for (const PhysicalPbId& primitive_pb : physical_pb.primitive_pbs()) {
       CircuitModelId circuit_model = device_annotation.pb_type_circuit_model(
@@ -251,7 +265,7 @@ void build_physical_lut_truth_tables(
                                          device_annotation, circuit_lib,
                                          verbose);
     }
-  }
+  });
 }
 
 } /* end namespace openfpga */
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Memember functions for data structure LbRouteCache
+ ******************************************************************************/
+#include "lb_route_cache.h"
+
+#include "vtr_assert.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/**************************************************
+ * Public Constructors
+ *************************************************/
+LbRouteCache::LbRouteCache(const size_t& max_num_results)
+  : max_num_results_(max_num_results), num_hits_(0) {}
+
+/**************************************************
+ * Public Accessors
+ *************************************************/
+size_t LbRouteCache::num_hits() const { return num_hits_; }
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
+const LbRouteCache::net_routed_nodes* LbRouteCache::find(
+  const LbRRGraph& lb_rr_graph, const LbRouter& lb_router) {
+  auto result =
+    results_.find(std::make_pair(&lb_rr_graph, net_signature(lb_router)));
+  if (results_.end() == result) {
+    return nullptr;
+  }
+  num_hits_++;
+  return &(result->second);
+}
+
+void LbRouteCache::add(const LbRRGraph& lb_rr_graph,
+                       const LbRouter& lb_router) {
+  VTR_ASSERT(true == lb_router.is_routed());
+  if (max_num_results_ <= results_.size()) {
+    return;
+  }
+  net_routed_nodes routed_nodes;
+  for (const LbRouter::NetId& net : lb_router.nets()) {
+    routed_nodes.push_back(lb_router.net_routed_nodes(net));
+  }
+  results_.emplace(std::make_pair(&lb_rr_graph, net_signature(lb_router)),
+                   routed_nodes);
+}
+
+/**************************************************
+ * Internal builders
+ *************************************************/
+/* The signature lists, for each net, the number of sources, the sources,
+ * the number of sinks and the sinks */
+std::vector<size_t> LbRouteCache::net_signature(const LbRouter& lb_router) {
+  std::vector<size_t> signature;
+  for (const LbRouter::NetId& net : lb_router.nets()) {
+    const std::vector<LbRRNodeId>& sources = lb_router.net_sources(net);
+    signature.push_back(sources.size());
+    for (const LbRRNodeId& source : sources) {
+      signature.push_back(size_t(source));
+    }
+    const std::vector<LbRRNodeId>& sinks = lb_router.net_sinks(net);
+    signature.push_back(sinks.size());
+    for (const LbRRNodeId& sink : sinks) {
+      signature.push_back(size_t(sink));
+    }
+  }
+  return signature;
+}
+
+} /* end namespace openfpga */
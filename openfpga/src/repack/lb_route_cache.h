@@ -0,0 +1,66 @@
+#ifndef LB_ROUTE_CACHE_H
+#define LB_ROUTE_CACHE_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "lb_router.h"
+#include "lb_rr_graph.h"
+#include "vtr_vector.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * LbRouteCache object stores the routing results of logical blocks,
+ * so that a logical block whose nets are the same as a block which has
+ * been routed reuses the results without running the router.
+ *
+ * Results are keyed by the lb_rr_graph and a signature of the nets to
+ * route, i.e., the source and sink nodes of each net in the sequence of
+ * the nets. The router is deterministic, so that the nets of the same
+ * signature are always routed on the same nodes, regardless of the atom
+ * nets that they implement.
+ *
+ * The number of results is capped to limit the memory footprint.
+ * A cache is not thread-safe. Each thread should own its cache.
+ *******************************************************************/
+class LbRouteCache {
+ public: /* Types */
+  /* Routed nodes of each net, in the sequence of the nets of a router */
+  typedef vtr::vector<LbRouter::NetId, std::vector<LbRRNodeId>>
+    net_routed_nodes;
+
+ public: /* Public constructors */
+  explicit LbRouteCache(const size_t& max_num_results);
+
+ public: /* Public accessors */
+  /* Return the number of results which have been reused */
+  size_t num_hits() const;
+
+ public: /* Public mutators */
+  /* Find the routing results for the nets of a router, which is not routed
+   * yet. Return nullptr if the nets have never been routed */
+  const net_routed_nodes* find(const LbRRGraph& lb_rr_graph,
+                               const LbRouter& lb_router);
+  /* Store the routing results of a router, which has routed its nets */
+  void add(const LbRRGraph& lb_rr_graph, const LbRouter& lb_router);
+
+ private: /* Internal builders */
+  static std::vector<size_t> net_signature(const LbRouter& lb_router);
+
+ private: /* Internal data */
+  std::map<std::pair<const LbRRGraph*, std::vector<size_t>>,
+           net_routed_nodes>
+    results_;
+  size_t max_num_results_;
+  size_t num_hits_;
+};
+
+} /* End namespace openfpga*/
+
+#endif
@@ -19,6 +19,8 @@ namespace openfpga {
  *************************************************/
 LbRouter::LbRouter(const LbRRGraph& lb_rr_graph,
                    t_logical_block_type_ptr lb_type) {
+  /* The router reads edges from the compressed sparse rows of the graph */
+  VTR_ASSERT(true == lb_rr_graph.frozen());
   routing_status_.resize(lb_rr_graph.nodes().size());
   explored_node_tb_.resize(lb_rr_graph.nodes().size());
   explore_id_index_ = 1;
@@ -32,8 +34,13 @@ LbRouter::LbRouter(const LbRRGraph& lb_rr_graph,
   params_.hist_fac = 0.3;
 
   is_routed_ = false;
+  num_overused_nodes_ = 0;
 
   pres_con_fac_ = 1;
+
+  num_route_iterations_ = 0;
+  num_expanded_nodes_ = 0;
+  num_heap_pushes_ = 0;
 }
 
 /**************************************************
@@ -48,12 +55,26 @@ AtomNetId LbRouter::net_atom_net_id(const NetId& net) const {
   return lb_net_atom_net_ids_[net];
 }
 
+const std::vector<LbRRNodeId>& LbRouter::net_sources(const NetId& net) const {
+  VTR_ASSERT(true == valid_net_id(net));
+  return lb_net_sources_[net];
+}
+
+const std::vector<LbRRNodeId>& LbRouter::net_sinks(const NetId& net) const {
+  VTR_ASSERT(true == valid_net_id(net));
+  return lb_net_sinks_[net];
+}
+
 std::vector<LbRRNodeId> LbRouter::find_congested_rr_nodes(
   const LbRRGraph& lb_rr_graph) const {
   /* Validate if the rr_graph is the one we used to initialize the router */
   VTR_ASSERT(true == matched_lb_rr_graph(lb_rr_graph));
 
   std::vector<LbRRNodeId> congested_rr_nodes;
+  if (0 == num_overused_nodes_) {
+    return congested_rr_nodes;
+  }
+  congested_rr_nodes.reserve(num_overused_nodes_);
 
   for (const LbRRNodeId& inode : lb_rr_graph.nodes()) {
     if (routing_status_[inode].occ > lb_rr_graph.node_capacity(inode)) {
@@ -66,6 +87,12 @@ std::vector<LbRRNodeId> LbRouter::find_congested_rr_nodes(
 
 bool LbRouter::is_routed() const { return is_routed_; }
 
+size_t LbRouter::num_route_iterations() const { return num_route_iterations_; }
+
+size_t LbRouter::num_expanded_nodes() const { return num_expanded_nodes_; }
+
+size_t LbRouter::num_heap_pushes() const { return num_heap_pushes_; }
+
 std::vector<LbRRNodeId> LbRouter::net_routed_nodes(const NetId& net) const {
   VTR_ASSERT(true == is_routed());
   VTR_ASSERT(true == valid_net_id(net));
@@ -73,8 +100,8 @@ std::vector<LbRRNodeId> LbRouter::net_routed_nodes(const NetId& net) const {
   std::vector<LbRRNodeId> routed_nodes;
 
   for (size_t isrc = 0; isrc < lb_net_sources_[net].size(); ++isrc) {
-    t_trace* rt_tree = lb_net_rt_trees_[net][isrc];
-    if (nullptr == rt_tree) {
+    TraceId rt_tree = lb_net_rt_trees_[net][isrc];
+    if (TraceId::INVALID() == rt_tree) {
       return routed_nodes;
     }
     /* Walk through the routing tree of the net */
@@ -91,6 +118,11 @@ bool LbRouter::is_route_success(const LbRRGraph& lb_rr_graph) const {
   /* Validate if the rr_graph is the one we used to initialize the router */
   VTR_ASSERT(true == matched_lb_rr_graph(lb_rr_graph));
 
+  /* Only search the graph to report the overused node */
+  if (0 == num_overused_nodes_) {
+    return true;
+  }
+
   for (const LbRRNodeId& inode : lb_rr_graph.nodes()) {
     if (routing_status_[inode].occ > lb_rr_graph.node_capacity(inode)) {
       VTR_LOGV(lb_rr_graph.node_pb_graph_pin(inode),
@@ -105,34 +137,34 @@ bool LbRouter::is_route_success(const LbRRGraph& lb_rr_graph) const {
   return true;
 }
 
-LbRouter::t_trace* LbRouter::find_node_in_rt(t_trace* rt,
-                                             const LbRRNodeId& rt_index) {
-  t_trace* cur;
-  if (rt->current_node == rt_index) {
+LbRouter::TraceId LbRouter::find_node_in_rt(
+  const TraceId& rt, const LbRRNodeId& rt_index) const {
+  if (traces_[rt].current_node == rt_index) {
     return rt;
-  } else {
-    for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-      cur = find_node_in_rt(&rt->next_nodes[i], rt_index);
-      if (cur != nullptr) {
-        return cur;
-      }
+  }
+  for (TraceId next = traces_[rt].first_next_node; TraceId::INVALID() != next;
+       next = traces_[next].next_sibling) {
+    TraceId cur = find_node_in_rt(next, rt_index);
+    if (TraceId::INVALID() != cur) {
+      return cur;
     }
   }
-  return nullptr;
+  return TraceId::INVALID();
 }
 
 bool LbRouter::route_has_conflict(const LbRRGraph& lb_rr_graph,
-                                  t_trace* rt) const {
+                                  const TraceId& rt) const {
   t_mode* cur_mode = nullptr;
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-    std::vector<LbRREdgeId> edges =
-      lb_rr_graph.find_edge(rt->current_node, rt->next_nodes[i].current_node);
+  for (TraceId next = traces_[rt].first_next_node; TraceId::INVALID() != next;
+       next = traces_[next].next_sibling) {
+    std::vector<LbRREdgeId> edges = lb_rr_graph.find_edge(
+      traces_[rt].current_node, traces_[next].current_node);
     VTR_ASSERT(1 == edges.size());
     t_mode* new_mode = lb_rr_graph.edge_mode(edges[0]);
     if (cur_mode != nullptr && cur_mode != new_mode) {
       return true;
     }
-    if (route_has_conflict(lb_rr_graph, &rt->next_nodes[i]) == true) {
+    if (route_has_conflict(lb_rr_graph, next) == true) {
       return true;
     }
     cur_mode = new_mode;
@@ -142,14 +174,15 @@ bool LbRouter::route_has_conflict(const LbRRGraph& lb_rr_graph,
 }
 
 void LbRouter::rec_collect_trace_nodes(
-  const t_trace* trace, std::vector<LbRRNodeId>& routed_nodes) const {
+  const TraceId& trace, std::vector<LbRRNodeId>& routed_nodes) const {
   if (routed_nodes.end() == std::find(routed_nodes.begin(), routed_nodes.end(),
-                                      trace->current_node)) {
-    routed_nodes.push_back(trace->current_node);
+                                      traces_[trace].current_node)) {
+    routed_nodes.push_back(traces_[trace].current_node);
   }
 
-  for (const t_trace& next : trace->next_nodes) {
-    rec_collect_trace_nodes(&next, routed_nodes);
+  for (TraceId next = traces_[trace].first_next_node;
+       TraceId::INVALID() != next; next = traces_[next].next_sibling) {
+    rec_collect_trace_nodes(next, routed_nodes);
   }
 }
 
@@ -170,7 +203,8 @@ LbRouter::NetId LbRouter::create_net_to_route(
 
   lb_net_sources_.push_back(sources);
   lb_net_sinks_.push_back(terminals);
-  lb_net_rt_trees_.push_back(std::vector<t_trace*>(sources.size(), nullptr));
+  lb_net_rt_trees_.push_back(
+    std::vector<TraceId>(sources.size(), TraceId::INVALID()));
 
   return net;
 }
@@ -247,8 +281,8 @@ bool LbRouter::try_route_net(
 
     commit_remove_rt(lb_rr_graph, lb_net_rt_trees_[net_idx][isrc], RT_REMOVE,
                      mode_map);
-    free_net_rt(lb_net_rt_trees_[net_idx][isrc]);
-    lb_net_rt_trees_[net_idx][isrc] = nullptr;
+    /* The ripped-up route tree is left in the pool */
+    lb_net_rt_trees_[net_idx][isrc] = TraceId::INVALID();
     add_source_to_rt(net_idx, isrc);
 
     /* Route each sink of net */
@@ -415,6 +449,10 @@ bool LbRouter::try_route(const LbRRGraph& lb_rr_graph,
   reset_net_rt();
   reset_routing_status();
 
+  num_route_iterations_ = 0;
+  num_expanded_nodes_ = 0;
+  num_heap_pushes_ = 0;
+
   std::unordered_map<const t_pb_graph_node*, const t_mode*> mode_map;
 
   /* Iteratively remove congestion until a successful route is found.
@@ -423,6 +461,7 @@ bool LbRouter::try_route(const LbRRGraph& lb_rr_graph,
   pres_con_fac_ = params_.pres_fac;
   for (int iter = 0;
        iter < params_.max_iterations && !is_routed_ && !is_impossible; iter++) {
+    num_route_iterations_++;
     unsigned int inet;
     /* Iterate across all nets internal to logic block */
     for (inet = 0; inet < lb_net_ids_.size() && !is_impossible; inet++) {
@@ -476,6 +515,30 @@ bool LbRouter::try_route(const LbRRGraph& lb_rr_graph,
   return is_routed_;
 }
 
+/* Only the contents are cleared, while the storage sized to the lb_rr_graph
+ * is kept for the next logic block. The traceback of explored nodes is not
+ * cleared here, as it is always reset when starting a routing */
+void LbRouter::reset() {
+  clear_nets();
+
+  for (t_routing_status& status : routing_status_) {
+    status = t_routing_status();
+  }
+  explore_id_index_ = 1;
+  reset_illegal_modes();
+
+  mode_status_ = t_mode_selection_status();
+  pq_.clear();
+
+  is_routed_ = false;
+  pres_con_fac_ = 1;
+  num_overused_nodes_ = 0;
+
+  num_route_iterations_ = 0;
+  num_expanded_nodes_ = 0;
+  num_heap_pushes_ = 0;
+}
+
 /**************************************************
  * Private mutators
  *************************************************/
@@ -606,15 +669,15 @@ bool LbRouter::check_edge_for_route_conflicts(
 }
 
 void LbRouter::commit_remove_rt(
-  const LbRRGraph& lb_rr_graph, t_trace* rt, const e_commit_remove& op,
+  const LbRRGraph& lb_rr_graph, const TraceId& rt, const e_commit_remove& op,
   std::unordered_map<const t_pb_graph_node*, const t_mode*>& mode_map) {
   int incr;
 
-  if (nullptr == rt) {
+  if (TraceId::INVALID() == rt) {
     return;
   }
 
-  LbRRNodeId inode = rt->current_node;
+  LbRRNodeId inode = traces_[rt].current_node;
 
   /* Determine if node is being used or removed */
   if (op == RT_COMMIT) {
@@ -629,18 +692,29 @@ void LbRouter::commit_remove_rt(
     explored_node_tb_[inode].inet = NetId::INVALID();
   }
 
+  bool was_overused =
+    routing_status_[inode].occ > lb_rr_graph.node_capacity(inode);
   routing_status_[inode].occ += incr;
   VTR_ASSERT(routing_status_[inode].occ >= 0);
+  bool is_overused =
+    routing_status_[inode].occ > lb_rr_graph.node_capacity(inode);
+  if (!was_overused && is_overused) {
+    num_overused_nodes_++;
+  } else if (was_overused && !is_overused) {
+    VTR_ASSERT(0 < num_overused_nodes_);
+    num_overused_nodes_--;
+  }
 
   t_pb_graph_pin* driver_pin = lb_rr_graph.node_pb_graph_pin(inode);
 
   /* Recursively update route tree */
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
+  for (TraceId next = traces_[rt].first_next_node; TraceId::INVALID() != next;
+       next = traces_[next].next_sibling) {
     // Check to see if there is no mode conflict between previous nets.
     // A conflict is present if there are differing modes between a
     // pb_graph_node and its children.
     if (op == RT_COMMIT && mode_status_.try_expand_all_modes) {
-      const LbRRNodeId& node = rt->next_nodes[i].current_node;
+      const LbRRNodeId& node = traces_[next].current_node;
       t_pb_graph_pin* pin = lb_rr_graph.node_pb_graph_pin(node);
 
       if (check_edge_for_route_conflicts(mode_map, driver_pin, pin)) {
@@ -648,19 +722,25 @@ void LbRouter::commit_remove_rt(
       }
     }
 
-    commit_remove_rt(lb_rr_graph, &rt->next_nodes[i], op, mode_map);
+    commit_remove_rt(lb_rr_graph, next, op, mode_map);
   }
 }
 
-bool LbRouter::is_skip_route_net(const LbRRGraph& lb_rr_graph, t_trace* rt) {
+bool LbRouter::is_skip_route_net(const LbRRGraph& lb_rr_graph,
+                                 const TraceId& rt) {
   /* Validate if the rr_graph is the one we used to initialize the router */
   VTR_ASSERT(true == matched_lb_rr_graph(lb_rr_graph));
 
-  if (rt == nullptr) {
+  if (rt == TraceId::INVALID()) {
     return false; /* Net is not routed, therefore must route net */
   }
 
-  LbRRNodeId inode = rt->current_node;
+  /* No node is overused, so that the route tree has no conflict for sure */
+  if (0 == num_overused_nodes_) {
+    return true;
+  }
+
+  LbRRNodeId inode = traces_[rt].current_node;
 
   /* Determine if node is overused */
   if (routing_status_[inode].occ > lb_rr_graph.node_capacity(inode)) {
@@ -669,8 +749,9 @@ bool LbRouter::is_skip_route_net(const LbRRGraph& lb_rr_graph, t_trace* rt) {
   }
 
   /* Recursively check that rest of route tree does not have a conflict */
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-    if (!is_skip_route_net(lb_rr_graph, &rt->next_nodes[i])) {
+  for (TraceId next = traces_[rt].first_next_node; TraceId::INVALID() != next;
+       next = traces_[next].next_sibling) {
+    if (!is_skip_route_net(lb_rr_graph, next)) {
       return false;
     }
   }
@@ -679,11 +760,10 @@ bool LbRouter::is_skip_route_net(const LbRRGraph& lb_rr_graph, t_trace* rt) {
   return true;
 }
 
-bool LbRouter::add_to_rt(t_trace* rt, const LbRRNodeId& node_index,
+bool LbRouter::add_to_rt(const TraceId& rt, const LbRRNodeId& node_index,
                          const NetId& irt_net) {
   std::vector<LbRRNodeId> trace_forward;
-  t_trace* link_node;
-  t_trace curr_node;
+  TraceId link_node;
 
   /* Store path all the way back to route tree */
   LbRRNodeId rt_index = node_index;
@@ -695,7 +775,7 @@ bool LbRouter::add_to_rt(t_trace* rt, const LbRRNodeId& node_index,
 
   /* Find rt_index on the route tree */
   link_node = find_node_in_rt(rt, rt_index);
-  if (link_node == nullptr) {
+  if (link_node == TraceId::INVALID()) {
     VTR_LOG("Link node is nullptr. Routing impossible");
     return true;
   }
@@ -704,9 +784,9 @@ bool LbRouter::add_to_rt(t_trace* rt, const LbRRNodeId& node_index,
   LbRRNodeId trace_index;
   while (!trace_forward.empty()) {
     trace_index = trace_forward.back();
-    curr_node.current_node = trace_index;
-    link_node->next_nodes.push_back(curr_node);
-    link_node = &link_node->next_nodes.back();
+    TraceId curr_node = create_trace(trace_index);
+    add_trace_next_node(link_node, curr_node);
+    link_node = curr_node;
     trace_forward.pop_back();
   }
 
@@ -715,30 +795,47 @@ bool LbRouter::add_to_rt(t_trace* rt, const LbRRNodeId& node_index,
 
 void LbRouter::add_source_to_rt(const NetId& inet, const size_t& isrc) {
   /* TODO: Validate net id */
-  VTR_ASSERT(nullptr == lb_net_rt_trees_[inet][isrc]);
-  lb_net_rt_trees_[inet][isrc] = new t_trace;
-  lb_net_rt_trees_[inet][isrc]->current_node = lb_net_sources_[inet][isrc];
+  VTR_ASSERT(TraceId::INVALID() == lb_net_rt_trees_[inet][isrc]);
+  lb_net_rt_trees_[inet][isrc] = create_trace(lb_net_sources_[inet][isrc]);
+}
+
+LbRouter::TraceId LbRouter::create_trace(const LbRRNodeId& node) {
+  TraceId trace = TraceId(traces_.size());
+  traces_.emplace_back();
+  traces_[trace].current_node = node;
+  return trace;
+}
+
+void LbRouter::add_trace_next_node(const TraceId& trace,
+                                   const TraceId& next_node) {
+  if (TraceId::INVALID() == traces_[trace].last_next_node) {
+    traces_[trace].first_next_node = next_node;
+  } else {
+    traces_[traces_[trace].last_next_node].next_sibling = next_node;
+  }
+  traces_[trace].last_next_node = next_node;
 }
 
-void LbRouter::expand_rt_rec(t_trace* rt, const LbRRNodeId& prev_index,
+void LbRouter::expand_rt_rec(const TraceId& rt, const LbRRNodeId& prev_index,
                              const NetId& irt_net,
                              const int& explore_id_index) {
   t_expansion_node enode;
 
   /* Perhaps should use a cost other than zero */
   enode.cost = 0;
-  enode.node_index = rt->current_node;
+  enode.node_index = traces_[rt].current_node;
   enode.prev_index = prev_index;
   pq_.push(enode);
+  num_heap_pushes_++;
   explored_node_tb_[enode.node_index].inet = irt_net;
   explored_node_tb_[enode.node_index].explored_id = OPEN;
   explored_node_tb_[enode.node_index].enqueue_id = explore_id_index;
   explored_node_tb_[enode.node_index].enqueue_cost = 0;
   explored_node_tb_[enode.node_index].prev_index = prev_index;
 
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-    expand_rt_rec(&rt->next_nodes[i], rt->current_node, irt_net,
-                  explore_id_index);
+  for (TraceId next = traces_[rt].first_next_node; TraceId::INVALID() != next;
+       next = traces_[next].next_sibling) {
+    expand_rt_rec(next, traces_[rt].current_node, irt_net, explore_id_index);
   }
 }
 
@@ -760,17 +857,23 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph, t_mode* mode,
   int usage;
   float incr_cost;
 
-  for (const LbRREdgeId& iedge : lb_rr_graph.node_out_edges(cur_inode, mode)) {
+  /* Read the fan-out of the node linearly from the frozen graph */
+  size_t end_slot = lb_rr_graph.node_out_edge_end(cur_inode);
+  for (size_t slot = lb_rr_graph.node_out_edge_begin(cur_inode);
+       slot < end_slot; ++slot) {
+    if (mode != lb_rr_graph.out_edge_mode(slot)) {
+      continue;
+    }
     /* Init new expansion node */
     enode.prev_index = cur_inode;
-    enode.node_index = lb_rr_graph.edge_sink_node(iedge);
+    enode.node_index = lb_rr_graph.out_edge_sink_node(slot);
     enode.cost = cur_cost;
 
     /* Determine incremental cost of using expansion node */
     usage = routing_status_[enode.node_index].occ + 1 -
             lb_rr_graph.node_capacity(enode.node_index);
     incr_cost = lb_rr_graph.node_intrinsic_cost(enode.node_index);
-    incr_cost += lb_rr_graph.edge_intrinsic_cost(iedge);
+    incr_cost += lb_rr_graph.out_edge_intrinsic_cost(slot);
     incr_cost +=
       params_.hist_fac * routing_status_[enode.node_index].historical_usage;
     if (usage > 0) {
@@ -797,7 +900,7 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph, t_mode* mode,
                         ->parent_node->pb_type->modes[0]);
       }
     }
-    if (lb_rr_graph.node_out_edges(enode.node_index, next_mode).size() > 1) {
+    if (lb_rr_graph.node_num_out_edges(enode.node_index, next_mode) > 1) {
       fanout_factor = 0.85 + (0.25 / net_fanout);
     } else {
       fanout_factor = 1.15 - (0.25 / net_fanout);
@@ -810,6 +913,7 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph, t_mode* mode,
     if (explored_node_tb_[enode.node_index].enqueue_id == explore_id_index_) {
       if (enode.cost < explored_node_tb_[enode.node_index].enqueue_cost) {
         pq_.push(enode);
+        num_heap_pushes_++;
         /*
         if (nullptr != lb_rr_graph.node_pb_graph_pin(enode.node_index)) {
           VTR_LOG("Added node '%s' to priority queue\n",
@@ -821,6 +925,7 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph, t_mode* mode,
       explored_node_tb_[enode.node_index].enqueue_id = explore_id_index_;
       explored_node_tb_[enode.node_index].enqueue_cost = enode.cost;
       pq_.push(enode);
+      num_heap_pushes_++;
       /*
       if (nullptr != lb_rr_graph.node_pb_graph_pin(enode.node_index)) {
         VTR_LOG("Added node '%s' to priority queue\n",
@@ -877,8 +982,10 @@ void LbRouter::expand_node_all_modes(const LbRRGraph& lb_rr_graph,
   t_mode* cur_mode = routing_status_[cur_inode].mode;
   auto* pin = lb_rr_graph.node_pb_graph_pin(cur_inode);
 
-  for (const LbRREdgeId& edge : lb_rr_graph.node_out_edges(cur_inode)) {
-    t_mode* mode = lb_rr_graph.edge_mode(edge);
+  size_t end_slot = lb_rr_graph.node_out_edge_end(cur_inode);
+  for (size_t slot = lb_rr_graph.node_out_edge_begin(cur_inode);
+       slot < end_slot; ++slot) {
+    t_mode* mode = lb_rr_graph.out_edge_mode(slot);
     /* If a mode has been forced, only add edges from that mode, otherwise add
      * edges from all modes. */
     if (cur_mode != nullptr && mode != cur_mode) {
@@ -952,6 +1059,7 @@ bool LbRouter::try_expand_nodes(const AtomNetlist& atom_nlist,
          */
         explored_node_tb_[exp_inode].explored_id = explore_id_index_;
         explored_node_tb_[exp_inode].prev_index = exp_node.prev_index;
+        num_expanded_nodes_++;
         if (exp_inode != lb_net_sinks_[lb_net][itarget]) {
           if (!try_other_modes) {
             expand_node(lb_rr_graph, exp_node, lb_net_sinks_[lb_net].size());
@@ -1058,10 +1166,12 @@ void LbRouter::reset_explored_node_tb() {
 void LbRouter::reset_net_rt() {
   for (const NetId& inet : lb_net_ids_) {
     for (size_t isrc = 0; isrc < lb_net_sources_[inet].size(); ++isrc) {
-      free_net_rt(lb_net_rt_trees_[inet][isrc]);
-      lb_net_rt_trees_[inet][isrc] = nullptr;
+      lb_net_rt_trees_[inet][isrc] = TraceId::INVALID();
     }
   }
+  /* Trace nodes are plain data, so that the pool is cleared at once while
+   * its storage is kept for the next routing */
+  traces_.clear();
 }
 
 void LbRouter::reset_routing_status() {
@@ -1069,10 +1179,10 @@ void LbRouter::reset_routing_status() {
     status.historical_usage = 0;
     status.occ = 0;
   }
+  num_overused_nodes_ = 0;
 }
 
 void LbRouter::clear_nets() {
-  /* TODO: Trace should no longer use pointers */
   reset_net_rt();
 
   lb_net_ids_.clear();
@@ -1084,25 +1194,6 @@ void LbRouter::clear_nets() {
   lb_net_rt_trees_.clear();
 }
 
-void LbRouter::free_net_rt(t_trace* lb_trace) {
-  if (lb_trace != nullptr) {
-    for (unsigned int i = 0; i < lb_trace->next_nodes.size(); i++) {
-      free_lb_trace(&lb_trace->next_nodes[i]);
-    }
-    lb_trace->next_nodes.clear();
-    delete lb_trace;
-  }
-}
-
-void LbRouter::free_lb_trace(t_trace* lb_trace) {
-  if (lb_trace != nullptr) {
-    for (unsigned int i = 0; i < lb_trace->next_nodes.size(); i++) {
-      free_lb_trace(&lb_trace->next_nodes[i]);
-    }
-    lb_trace->next_nodes.clear();
-  }
-}
-
 void LbRouter::reset_illegal_modes() { illegal_modes_.clear(); }
 
 } /* end namespace openfpga */
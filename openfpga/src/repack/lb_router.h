@@ -72,6 +72,8 @@ class LbRouter {
  public: /* Strong ids */
   struct net_id_tag;
   typedef vtr::StrongId<net_id_tag> NetId;
+  struct trace_id_tag;
+  typedef vtr::StrongId<trace_id_tag> TraceId;
 
  public: /* Types and ranges */
   typedef vtr::vector<NetId, NetId>::const_iterator net_iterator;
@@ -100,11 +102,15 @@ class LbRouter {
    *cluster_ctx.blocks. A net is implemented using routing resource nodes. The
    *t_lb_trace data structure records one of the nodes used by the net and the
    *connections to other nodes
+   * All the trace nodes are stored in a pool of the router and linked by
+   * their ids. The nodes driven by a node are linked as a list, in the
+   * sequence that they are added to the route tree
    ***************************************************************************/
   struct t_trace {
     LbRRNodeId current_node; /* current t_lb_type_rr_node used by net */
-    std::vector<t_trace>
-      next_nodes; /* index of previous edge that drives current node */
+    TraceId first_next_node; /* first node driven by current node */
+    TraceId last_next_node;  /* last node driven by current node */
+    TraceId next_sibling;    /* next node driven by the same node */
   };
 
   /**************************************************************************
@@ -208,6 +214,7 @@ class LbRouter {
   enum e_commit_remove { RT_COMMIT, RT_REMOVE };
 
  public: /* Public constructors */
+  /* The lb_rr_graph must be frozen */
   LbRouter(const LbRRGraph& lb_rr_graph, t_logical_block_type_ptr lb_type);
 
  public: /* Public accessors */
@@ -217,6 +224,10 @@ class LbRouter {
   /* Return the atom net id for a net to be routed */
   AtomNetId net_atom_net_id(const NetId& net) const;
 
+  /* Return the source and sink nodes of a net to be routed */
+  const std::vector<LbRRNodeId>& net_sources(const NetId& net) const;
+  const std::vector<LbRRNodeId>& net_sinks(const NetId& net) const;
+
   /**
    * Find all the routing resource nodes that are over-used, which they are used
    * more than their capacity This function is call to collect the nodes and
@@ -233,6 +244,13 @@ class LbRouter {
    */
   std::vector<LbRRNodeId> net_routed_nodes(const NetId& net) const;
 
+  /* Statistics of the last run of try_route(): the number of iterations,
+   * the number of nodes which are expanded and the number of pushes to the
+   * priority queue */
+  size_t num_route_iterations() const;
+  size_t num_expanded_nodes() const;
+  size_t num_heap_pushes() const;
+
  public: /* Public mutators */
   /**
    * Add net to be routed
@@ -261,6 +279,12 @@ class LbRouter {
   bool try_route(const LbRRGraph& lb_rr_graph, const AtomNetlist& atom_nlist,
                  const bool& verbosity);
 
+  /**
+   * Clear the nets and the routing results, so that the router can be reused
+   * to route another logic block on the same lb_rr_graph, as if it were new
+   */
+  void reset();
+
  private: /* Private accessors */
   /**
    * Report if the routing is successfully done on a logical block routing
@@ -270,14 +294,15 @@ class LbRouter {
 
   /**
    * Try to find a node in the routing traces recursively
-   * If not found, will return an empty pointer
+   * If not found, will return an invalid id
    */
-  t_trace* find_node_in_rt(t_trace* rt, const LbRRNodeId& rt_index);
+  TraceId find_node_in_rt(const TraceId& rt, const LbRRNodeId& rt_index) const;
 
-  bool route_has_conflict(const LbRRGraph& lb_rr_graph, t_trace* rt) const;
+  bool route_has_conflict(const LbRRGraph& lb_rr_graph,
+                          const TraceId& rt) const;
 
   /* Recursively find all the nodes in the trace */
-  void rec_collect_trace_nodes(const t_trace* trace,
+  void rec_collect_trace_nodes(const TraceId& trace,
                                std::vector<LbRRNodeId>& routed_nodes) const;
 
  private: /* Private mutators */
@@ -296,13 +321,17 @@ class LbRouter {
     std::unordered_map<const t_pb_graph_node*, const t_mode*>& mode_map,
     const t_pb_graph_pin* driver_pin, const t_pb_graph_pin* pin);
   void commit_remove_rt(
-    const LbRRGraph& lb_rr_graph, t_trace* rt, const e_commit_remove& op,
+    const LbRRGraph& lb_rr_graph, const TraceId& rt, const e_commit_remove& op,
     std::unordered_map<const t_pb_graph_node*, const t_mode*>& mode_map);
-  bool is_skip_route_net(const LbRRGraph& lb_rr_graph, t_trace* rt);
-  bool add_to_rt(t_trace* rt, const LbRRNodeId& node_index,
+  bool is_skip_route_net(const LbRRGraph& lb_rr_graph, const TraceId& rt);
+  bool add_to_rt(const TraceId& rt, const LbRRNodeId& node_index,
                  const NetId& irt_net);
   void add_source_to_rt(const NetId& inet, const size_t& isrc);
-  void expand_rt_rec(t_trace* rt, const LbRRNodeId& prev_index,
+  /* Create a trace node from the pool, which drives no other node */
+  TraceId create_trace(const LbRRNodeId& node);
+  /* Add a node to the nodes driven by a trace node */
+  void add_trace_next_node(const TraceId& trace, const TraceId& next_node);
+  void expand_rt_rec(const TraceId& rt, const LbRRNodeId& prev_index,
                      const NetId& irt_net, const int& explore_id_index);
   void expand_rt(const NetId& inet, const NetId& irt_net, const size_t& isrc);
   void expand_edges(const LbRRGraph& lb_rr_graph, t_mode* mode,
@@ -347,8 +376,6 @@ class LbRouter {
   void reset_illegal_modes();
 
   void clear_nets();
-  void free_net_rt(t_trace* lb_trace);
-  void free_lb_trace(t_trace* lb_trace);
 
  private: /* Stores all data needed by intra-logic cluster_ctx.blocks router */
   /* Logical Netlist Info */
@@ -372,7 +399,13 @@ class LbRouter {
   vtr::vector<NetId, std::vector<LbRRNodeId>> lb_net_sinks_;
 
   /* Route tree head for each source of each net */
-  vtr::vector<NetId, std::vector<t_trace*>> lb_net_rt_trees_;
+  vtr::vector<NetId, std::vector<TraceId>> lb_net_rt_trees_;
+
+  /* Pool of the trace nodes of all the route trees.
+   * Nodes are never freed one by one. The route tree of a net which is
+   * ripped up is simply left in the pool, and the whole pool is cleared
+   * when starting a routing or when the nets are cleared */
+  vtr::vector<TraceId, t_trace> traces_;
 
   /* Logical-to-physical mapping info */
   vtr::vector<LbRRNodeId, t_routing_status>
@@ -413,6 +446,16 @@ class LbRouter {
 
   /* current congestion factor */
   float pres_con_fac_;
+
+  /* Number of nodes whose occupancy exceeds their capacity, which is updated
+   * whenever a route tree is committed or removed. Routing trees are only
+   * searched for conflicts when there are overused nodes */
+  size_t num_overused_nodes_;
+
+  /* Statistics of the last run of try_route() */
+  size_t num_route_iterations_;
+  size_t num_expanded_nodes_;
+  size_t num_heap_pushes_;
 };
 
 } /* end namespace openfpga */
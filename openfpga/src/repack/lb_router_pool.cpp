@@ -0,0 +1,29 @@
+/******************************************************************************
+ * Memember functions for data structure LbRouterPool
+ ******************************************************************************/
+#include "lb_router_pool.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/**************************************************
+ * Public Accessors
+ *************************************************/
+size_t LbRouterPool::num_routers() const { return routers_.size(); }
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
+LbRouter& LbRouterPool::router(const LbRRGraph& lb_rr_graph,
+                               t_logical_block_type_ptr lb_type) {
+  auto result = routers_.find(&lb_rr_graph);
+  if (routers_.end() == result) {
+    result =
+      routers_.emplace(&lb_rr_graph, LbRouter(lb_rr_graph, lb_type)).first;
+    return result->second;
+  }
+  result->second.reset();
+  return result->second;
+}
+
+} /* end namespace openfpga */
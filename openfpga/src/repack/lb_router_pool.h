@@ -0,0 +1,48 @@
+#ifndef LB_ROUTER_POOL_H
+#define LB_ROUTER_POOL_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <map>
+
+#include "lb_router.h"
+#include "lb_rr_graph.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * LbRouterPool object keeps one LbRouter for each lb_rr_graph, so that
+ * the clustered blocks of the same type are repacked by the same router.
+ * The internal data of a router, which are sized to its lb_rr_graph,
+ * are allocated when the router is created for the first block, and
+ * are reused by the following blocks.
+ *
+ * A pool is not thread-safe. Each thread should own its pool.
+ *
+ * Example:
+ *  LbRouterPool lb_router_pool;
+ *  for (ClusterBlockId blk_id : clb_nlist.blocks()) {
+ *    LbRouter& lb_router = lb_router_pool.router(lb_rr_graph, lb_type);
+ *    // Add nets and route ...
+ *  }
+ *******************************************************************/
+class LbRouterPool {
+ public: /* Public accessors */
+  /* Return the number of routers which have been created */
+  size_t num_routers() const;
+
+ public: /* Public mutators */
+  /* Return the router of a lb_rr_graph, which is created when the graph is
+   * first seen. The router is reset, so that it has no nets to route */
+  LbRouter& router(const LbRRGraph& lb_rr_graph,
+                   t_logical_block_type_ptr lb_type);
+
+ private: /* Internal data */
+  std::map<const LbRRGraph*, LbRouter> routers_;
+};
+
+} /* End namespace openfpga*/
+
+#endif
@@ -68,6 +68,37 @@ LbRouter::NetId add_lb_router_net_to_route(
   return lb_net;
 }
 
+/***************************************************************************************
+ * Load the routing results of a net to a physical pb data structure
+ ***************************************************************************************/
+static void save_lb_router_net_results_to_physical_pb(
+  PhysicalPb& phy_pb, const LbRRGraph& lb_rr_graph,
+  const std::vector<LbRRNodeId>& routed_nodes, const AtomNetId& atom_net,
+  const AtomNetlist& atom_netlist, const bool& verbose) {
+  for (const LbRRNodeId& node : routed_nodes) {
+    t_pb_graph_pin* pb_graph_pin = lb_rr_graph.node_pb_graph_pin(node);
+    if (nullptr == pb_graph_pin) {
+      continue;
+    }
+    /* Find the pb id */
+    const PhysicalPbId& pb_id = phy_pb.find_pb(pb_graph_pin->parent_node);
+    VTR_ASSERT(true == phy_pb.valid_pb_id(pb_id));
+
+    /* Print info to help debug */
+    VTR_LOGV(verbose, "Save net '%s' to physical pb_graph_pin '%s.%s[%d]'\n",
+             atom_netlist.net_name(atom_net).c_str(),
+             pb_graph_pin->parent_node->pb_type->name,
+             pb_graph_pin->port->name, pb_graph_pin->pin_number);
+
+    if (AtomNetId::INVALID() ==
+        phy_pb.pb_graph_pin_atom_net(pb_id, pb_graph_pin)) {
+      phy_pb.set_pb_graph_pin_atom_net(pb_id, pb_graph_pin, atom_net);
+    } else {
+      VTR_ASSERT(atom_net == phy_pb.pb_graph_pin_atom_net(pb_id, pb_graph_pin));
+    }
+  }
+}
+
 /***************************************************************************************
  * Load the routing results (routing tree) from lb router to
  * a physical pb data structure
@@ -79,32 +110,28 @@ void save_lb_router_results_to_physical_pb(PhysicalPb& phy_pb,
                                            const bool& verbose) {
   /* Get mapping routing nodes per net */
   for (const LbRouter::NetId& net : lb_router.nets()) {
-    std::vector<LbRRNodeId> routed_nodes = lb_router.net_routed_nodes(net);
-    for (const LbRRNodeId& node : routed_nodes) {
-      t_pb_graph_pin* pb_graph_pin = lb_rr_graph.node_pb_graph_pin(node);
-      if (nullptr == pb_graph_pin) {
-        continue;
-      }
-      /* Find the pb id */
-      const PhysicalPbId& pb_id = phy_pb.find_pb(pb_graph_pin->parent_node);
-      VTR_ASSERT(true == phy_pb.valid_pb_id(pb_id));
-
-      const AtomNetId& atom_net = lb_router.net_atom_net_id(net);
-
-      /* Print info to help debug */
-      VTR_LOGV(verbose, "Save net '%s' to physical pb_graph_pin '%s.%s[%d]'\n",
-               atom_netlist.net_name(atom_net).c_str(),
-               pb_graph_pin->parent_node->pb_type->name,
-               pb_graph_pin->port->name, pb_graph_pin->pin_number);
-
-      if (AtomNetId::INVALID() ==
-          phy_pb.pb_graph_pin_atom_net(pb_id, pb_graph_pin)) {
-        phy_pb.set_pb_graph_pin_atom_net(pb_id, pb_graph_pin, atom_net);
-      } else {
-        VTR_ASSERT(atom_net ==
-                   phy_pb.pb_graph_pin_atom_net(pb_id, pb_graph_pin));
-      }
-    }
+    save_lb_router_net_results_to_physical_pb(
+      phy_pb, lb_rr_graph, lb_router.net_routed_nodes(net),
+      lb_router.net_atom_net_id(net), atom_netlist, verbose);
+  }
+}
+
+/***************************************************************************************
+ * Load the routing results, which are found by routing the same nets on
+ * another logical block, to a physical pb data structure.
+ * The routed nodes are given for each net of the lb router
+ ***************************************************************************************/
+void save_lb_router_results_to_physical_pb(
+  PhysicalPb& phy_pb, const LbRouter& lb_router,
+  const vtr::vector<LbRouter::NetId, std::vector<LbRRNodeId>>&
+    net_routed_nodes,
+  const LbRRGraph& lb_rr_graph, const AtomNetlist& atom_netlist,
+  const bool& verbose) {
+  VTR_ASSERT(lb_router.nets().size() == net_routed_nodes.size());
+  for (const LbRouter::NetId& net : lb_router.nets()) {
+    save_lb_router_net_results_to_physical_pb(
+      phy_pb, lb_rr_graph, net_routed_nodes[net],
+      lb_router.net_atom_net_id(net), atom_netlist, verbose);
   }
 }
 
@@ -28,6 +28,13 @@ void save_lb_router_results_to_physical_pb(PhysicalPb& phy_pb,
                                            const AtomNetlist& atom_netlist,
                                            const bool& verbose);
 
+void save_lb_router_results_to_physical_pb(
+  PhysicalPb& phy_pb, const LbRouter& lb_router,
+  const vtr::vector<LbRouter::NetId, std::vector<LbRRNodeId>>&
+    net_routed_nodes,
+  const LbRRGraph& lb_rr_graph, const AtomNetlist& atom_netlist,
+  const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
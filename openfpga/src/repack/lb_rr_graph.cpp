@@ -14,6 +14,7 @@ namespace openfpga {
  * Public Constructors
  *************************************************/
 LbRRGraph::LbRRGraph() {
+  frozen_ = false;
   ext_source_node_ = LbRRNodeId::INVALID();
   ext_sink_node_ = LbRRNodeId::INVALID();
 }
@@ -139,6 +140,62 @@ t_mode* LbRRGraph::edge_mode(const LbRREdgeId& edge) const {
   return edge_modes_[edge];
 }
 
+bool LbRRGraph::frozen() const { return frozen_; }
+
+size_t LbRRGraph::node_out_edge_begin(const LbRRNodeId& node) const {
+  VTR_ASSERT(true == frozen_);
+  VTR_ASSERT_SAFE(true == valid_node_id(node));
+  return out_edge_offsets_[size_t(node)];
+}
+
+size_t LbRRGraph::node_out_edge_end(const LbRRNodeId& node) const {
+  VTR_ASSERT(true == frozen_);
+  VTR_ASSERT_SAFE(true == valid_node_id(node));
+  return out_edge_offsets_[size_t(node) + 1];
+}
+
+LbRREdgeId LbRRGraph::out_edge(const size_t& slot) const {
+  VTR_ASSERT_SAFE(slot < out_edges_.size());
+  return out_edges_[slot];
+}
+
+LbRRNodeId LbRRGraph::out_edge_sink_node(const size_t& slot) const {
+  VTR_ASSERT_SAFE(slot < out_edge_sink_nodes_.size());
+  return out_edge_sink_nodes_[slot];
+}
+
+float LbRRGraph::out_edge_intrinsic_cost(const size_t& slot) const {
+  VTR_ASSERT_SAFE(slot < out_edge_intrinsic_costs_.size());
+  return out_edge_intrinsic_costs_[slot];
+}
+
+t_mode* LbRRGraph::out_edge_mode(const size_t& slot) const {
+  VTR_ASSERT_SAFE(slot < out_edge_modes_.size());
+  return out_edge_modes_[slot];
+}
+
+size_t LbRRGraph::node_num_out_edges(const LbRRNodeId& node,
+                                     t_mode* mode) const {
+  size_t num_out_edges = 0;
+  if (true == frozen_) {
+    size_t end_slot = node_out_edge_end(node);
+    for (size_t slot = node_out_edge_begin(node); slot < end_slot; ++slot) {
+      if (mode == out_edge_modes_[slot]) {
+        num_out_edges++;
+      }
+    }
+    return num_out_edges;
+  }
+
+  VTR_ASSERT(true == valid_node_id(node));
+  for (const LbRREdgeId& edge : node_out_edges_[node]) {
+    if (mode == edge_mode(edge)) {
+      num_out_edges++;
+    }
+  }
+  return num_out_edges;
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
@@ -176,6 +233,8 @@ LbRRNodeId LbRRGraph::create_node(const e_lb_rr_type& type) {
   node_in_edges_.emplace_back();
   node_out_edges_.emplace_back();
 
+  frozen_ = false;
+
   return node;
 }
 
@@ -249,6 +308,8 @@ LbRREdgeId LbRRGraph::create_edge(const LbRRNodeId& source,
   node_out_edges_[source].push_back(edge);
   node_in_edges_[sink].push_back(edge);
 
+  frozen_ = false;
+
   return edge;
 }
 
@@ -256,6 +317,34 @@ void LbRRGraph::set_edge_intrinsic_cost(const LbRREdgeId& edge,
                                         const float& cost) {
   VTR_ASSERT(true == valid_edge_id(edge));
   edge_intrinsic_costs_[edge] = cost;
+  frozen_ = false;
+}
+
+void LbRRGraph::freeze() {
+  out_edge_offsets_.clear();
+  out_edges_.clear();
+  out_edge_sink_nodes_.clear();
+  out_edge_intrinsic_costs_.clear();
+  out_edge_modes_.clear();
+
+  out_edge_offsets_.reserve(node_ids_.size() + 1);
+  out_edges_.reserve(edge_ids_.size());
+  out_edge_sink_nodes_.reserve(edge_ids_.size());
+  out_edge_intrinsic_costs_.reserve(edge_ids_.size());
+  out_edge_modes_.reserve(edge_ids_.size());
+
+  for (const LbRRNodeId& node : nodes()) {
+    out_edge_offsets_.push_back(out_edges_.size());
+    for (const LbRREdgeId& edge : node_out_edges_[node]) {
+      out_edges_.push_back(edge);
+      out_edge_sink_nodes_.push_back(edge_sink_nodes_[edge]);
+      out_edge_intrinsic_costs_.push_back(edge_intrinsic_costs_[edge]);
+      out_edge_modes_.push_back(edge_modes_[edge]);
+    }
+  }
+  out_edge_offsets_.push_back(out_edges_.size());
+
+  frozen_ = true;
 }
 
 /******************************************************************************
@@ -235,6 +235,29 @@ class LbRRGraph {
   float edge_intrinsic_cost(const LbRREdgeId& edge) const;
   t_mode* edge_mode(const LbRREdgeId& edge) const;
 
+  /* Compressed sparse rows of outgoing edges, which are only available when
+   * the graph is frozen. The outgoing edges of a node are stored in the slots
+   * [node_out_edge_begin(), node_out_edge_end()) in the same sequence as
+   * node_out_edges(), so that routers can read them linearly
+   *  -----------------------------------------------------------------
+   *    Example: iterate over the fan-out of a node
+   *      for (size_t slot = lb_rr_graph.node_out_edge_begin(node);
+   *           slot < lb_rr_graph.node_out_edge_end(node); ++slot) {
+   *        LbRRNodeId sink = lb_rr_graph.out_edge_sink_node(slot);
+   *      }
+   */
+  bool frozen() const;
+  size_t node_out_edge_begin(const LbRRNodeId& node) const;
+  size_t node_out_edge_end(const LbRRNodeId& node) const;
+  LbRREdgeId out_edge(const size_t& slot) const;
+  LbRRNodeId out_edge_sink_node(const size_t& slot) const;
+  float out_edge_intrinsic_cost(const size_t& slot) const;
+  t_mode* out_edge_mode(const size_t& slot) const;
+
+  /* Get the number of outgoing edges of a node in a mode, without creating
+   * the list of edges */
+  size_t node_num_out_edges(const LbRRNodeId& node, t_mode* mode) const;
+
  public: /* Mutators */
   /* Reserve the lists of nodes, edges, switches etc. to be memory efficient.
    * This function is mainly used to reserve memory space inside RRGraph,
@@ -281,6 +304,11 @@ class LbRRGraph {
                          t_mode* mode);
   void set_edge_intrinsic_cost(const LbRREdgeId& edge, const float& cost);
 
+  /* Pack the outgoing edges into compressed sparse rows. This should be
+   * called once the graph is built. Any further change on nodes or edges
+   * unfreezes the graph */
+  void freeze();
+
  public: /* Public validators */
   /* Validate is the node id does exist in the RRGraph */
   bool valid_node_id(const LbRRNodeId& node) const;
@@ -332,6 +360,15 @@ class LbRRGraph {
   vtr::vector<LbRREdgeId, float> edge_intrinsic_costs_;
   vtr::vector<LbRREdgeId, t_mode*> edge_modes_;
 
+  /* Compressed sparse rows of outgoing edges, which are built by freeze()
+   * The offsets are indexed by nodes, with an extra offset for the end */
+  bool frozen_;
+  std::vector<size_t> out_edge_offsets_;
+  std::vector<LbRREdgeId> out_edges_;
+  std::vector<LbRRNodeId> out_edge_sink_nodes_;
+  std::vector<float> out_edge_intrinsic_costs_;
+  std::vector<t_mode*> out_edge_modes_;
+
   /* Fast look-up to search a node by its type, coordinator and ptc_num
    * Indexing of fast look-up: [0..NUM_TYPES-1][t_pb_graph_pin*]
    */
@@ -3,12 +3,29 @@
  ******************************************************************************/
 #include "physical_pb.h"
 
+#include <cstdint>
+
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Mix a value into a 64-bit FNV-1a digest */
+static void digest_value(uint64_t& digest, const uint64_t& value) {
+  for (size_t ibyte = 0; ibyte < sizeof(value); ++ibyte) {
+    digest ^= (value >> (8 * ibyte)) & 0xff;
+    digest *= 0x100000001b3ULL;
+  }
+}
+
+static void digest_string(uint64_t& digest, const std::string& value) {
+  digest_value(digest, value.size());
+  for (const char& c : value) {
+    digest_value(digest, uint64_t(c));
+  }
+}
+
 /**************************************************
  * Public Accessors
  *************************************************/
@@ -124,6 +141,56 @@ size_t PhysicalPb::fixed_mode_select_bitstream_offset(
   return fixed_mode_select_bitstream_offsets_[pb];
 }
 
+uint64_t PhysicalPb::digest(const AtomNetlist* atom_nlist) const {
+  uint64_t digest = 0xcbf29ce484222325ULL;
+
+  digest_value(digest, pb_ids_.size());
+  for (const PhysicalPbId& pb : pbs()) {
+    digest_value(digest, reinterpret_cast<uintptr_t>(pb_graph_nodes_[pb]));
+    digest_value(digest, size_t(parent_pbs_[pb]));
+    digest_string(digest, names_[pb]);
+    digest_value(digest, atom_blocks_[pb].size());
+    for (const AtomBlockId& atom_block : atom_blocks_[pb]) {
+      digest_value(digest, size_t(atom_block));
+    }
+    digest_value(digest, pin_atom_nets_[pb].size());
+    for (const auto& pin_net : pin_atom_nets_[pb]) {
+      digest_value(digest, reinterpret_cast<uintptr_t>(pin_net.first));
+      digest_value(digest, size_t(pin_net.second));
+      if ((nullptr != atom_nlist) &&
+          (true == atom_nlist->valid_net_id(pin_net.second))) {
+        digest_string(digest, atom_nlist->net_name(pin_net.second));
+      }
+    }
+    digest_value(digest, wire_lut_outputs_[pb].size());
+    for (const auto& wire_lut_output : wire_lut_outputs_[pb]) {
+      digest_value(digest, reinterpret_cast<uintptr_t>(wire_lut_output.first));
+      digest_value(digest, wire_lut_output.second);
+    }
+    digest_value(digest, truth_tables_[pb].size());
+    for (const auto& truth_table : truth_tables_[pb]) {
+      digest_value(digest, reinterpret_cast<uintptr_t>(truth_table.first));
+      digest_value(digest, truth_table.second.size());
+      for (const auto& row : truth_table.second) {
+        digest_value(digest, row.size());
+        for (const vtr::LogicValue& value : row) {
+          digest_value(digest, size_t(value));
+        }
+      }
+    }
+    digest_value(digest, mode_bits_[pb].size());
+    for (const size_t& mode_bit : mode_bits_[pb]) {
+      digest_value(digest, mode_bit);
+    }
+    digest_string(digest, fixed_bitstreams_[pb]);
+    digest_value(digest, fixed_bitstream_offsets_[pb]);
+    digest_string(digest, fixed_mode_select_bitstreams_[pb]);
+    digest_value(digest, fixed_mode_select_bitstream_offsets_[pb]);
+  }
+
+  return digest;
+}
+
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
@@ -59,6 +59,14 @@ class PhysicalPb {
   size_t fixed_bitstream_offset(const PhysicalPbId& pb) const;
   std::string fixed_mode_select_bitstream(const PhysicalPbId& pb) const;
   size_t fixed_mode_select_bitstream_offset(const PhysicalPbId& pb) const;
+  /* A digest of all the mapping results, which changes when any result
+   * which a bitstream is decoded from is changed. It is only comparable
+   * between physical pbs created in the same process, as it relies on
+   * the addresses of the pb_graph nodes and pins. When an atom netlist is
+   * given, the nets are also digested by their names in the netlist, which
+   * are recorded in bitstreams and may differ between netlists with the
+   * same net ids */
+  uint64_t digest(const AtomNetlist* atom_nlist = nullptr) const;
 
  public: /* Public mutators */
   PhysicalPbId create_pb(const t_pb_graph_node* pb_graph_node);
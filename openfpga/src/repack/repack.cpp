@@ -2,24 +2,52 @@
  * This file includes functions that are used to redo packing for physical pbs
  ***************************************************************************************/
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <tuple>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_progress.h"
+#include "openfpga_trace.h"
+
 /* Headers from vpr library */
 #include "build_physical_lb_rr_graph.h"
+#include "lb_route_cache.h"
 #include "lb_router.h"
+#include "lb_router_pool.h"
 #include "lb_router_utils.h"
+#include "openfpga_parallel.h"
 #include "pb_graph_utils.h"
 #include "pb_type_utils.h"
 #include "physical_pb_utils.h"
 #include "repack.h"
+#include "repack_stats.h"
 #include "vpr_utils.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Maximum number of routing results that a worker caches */
+constexpr size_t MAX_NUM_CACHED_LB_ROUTES = 4096;
+
+/* The pins of a clustered block whose pb_route carries each atom net, in an
+ * ascending order */
+typedef std::map<AtomNetId, std::vector<int>> t_net_pb_route_pins;
+
+/* The sink pins routed from a pair of <source pin, packing source pin> for an
+ * atom net in a clustered block */
+typedef std::map<
+  std::tuple<const t_pb_graph_pin*, const t_pb_graph_pin*, AtomNetId>,
+  std::vector<t_pb_graph_pin*>>
+  t_routed_sink_pb_pins_cache;
+
 /***************************************************************************************
  * Try to find sink pb graph pins through walking through the fan-out edges from
  * the source pb graph pin
@@ -220,14 +248,25 @@ static void rec_find_routed_sink_pb_graph_pins(
 /***************************************************************************************
  * A wrapper for the recursive function rec_find_route_sink_pb_graph_pins(),
  * we ensure that we provide a clear sink node lists
+ * The sink pins only depend on the source pins and the net in a clustered
+ * block, so that they are searched once and then found in the cache given
  ***************************************************************************************/
 static std::vector<t_pb_graph_pin*> find_routed_pb_graph_pins_atom_net(
   const t_pb* pb, const t_pb_graph_pin* source_pb_pin,
   const t_pb_graph_pin* packing_source_pb_pin, const AtomNetId& atom_net_id,
   const VprDeviceAnnotation& device_annotation,
   const std::map<const t_pb_graph_pin*, AtomNetId>& pb_pin_mapped_nets,
-  t_pb_graph_pin** pb_graph_pin_lookup_from_index) {
-  std::vector<t_pb_graph_pin*> sink_pb_pins;
+  t_pb_graph_pin** pb_graph_pin_lookup_from_index,
+  t_routed_sink_pb_pins_cache& routed_sink_pb_pins_cache) {
+  auto cache_key =
+    std::make_tuple(source_pb_pin, packing_source_pb_pin, atom_net_id);
+  auto cached_result = routed_sink_pb_pins_cache.find(cache_key);
+  if (cached_result != routed_sink_pb_pins_cache.end()) {
+    return cached_result->second;
+  }
+
+  std::vector<t_pb_graph_pin*>& sink_pb_pins =
+    routed_sink_pb_pins_cache[cache_key];
 
   /* Try to directly search for sink pb_pins from the source_pb_pin,
    * which is the actual source pin to be routed from
@@ -255,6 +294,38 @@ static std::vector<t_pb_graph_pin*> find_routed_pb_graph_pins_atom_net(
   return sink_pb_pins;
 }
 
+/***************************************************************************************
+ * Find the pins whose pb_route carries each atom net in a clustered block,
+ * through a single walk over the pb_route, so that searching the routing
+ * traces of a net does not visit all the pins of the clustered block
+ ***************************************************************************************/
+static t_net_pb_route_pins build_net_pb_route_pins(const t_pb* pb) {
+  t_net_pb_route_pins net_pb_route_pins;
+  for (const auto& pb_route : pb->pb_route) {
+    /* Bypass unused pins */
+    if ((pb_route.first >= pb->pb_graph_node->total_pb_pins) ||
+        (AtomNetId::INVALID() == pb_route.second.atom_net_id)) {
+      continue;
+    }
+    net_pb_route_pins[pb_route.second.atom_net_id].push_back(pb_route.first);
+  }
+  /* Keep the same sequence as walking through all the pins */
+  for (auto& net_pins : net_pb_route_pins) {
+    std::sort(net_pins.second.begin(), net_pins.second.end());
+  }
+  return net_pb_route_pins;
+}
+
+static const std::vector<int>& find_net_pb_route_pins(
+  const t_net_pb_route_pins& net_pb_route_pins, const AtomNetId& atom_net_id) {
+  static const std::vector<int> empty_pins;
+  auto result = net_pb_route_pins.find(atom_net_id);
+  if (result == net_pb_route_pins.end()) {
+    return empty_pins;
+  }
+  return result->second;
+}
+
 /***************************************************************************************
  * This function will find the actual routing traces of the demanded net
  * There is a specific search space applied when searching the routing traces:
@@ -266,24 +337,13 @@ static std::vector<t_pb_graph_pin*> find_routed_pb_graph_pins_atom_net(
  ***************************************************************************************/
 static std::vector<int> find_pb_route_by_atom_net(
   const t_pb* pb, const t_pb_graph_pin* source_pb_pin,
-  const AtomNetId& atom_net_id) {
+  const AtomNetId& atom_net_id, const t_net_pb_route_pins& net_pb_route_pins) {
   VTR_ASSERT(true == source_pb_pin->parent_node->is_root());
 
   std::vector<int> pb_route_indices;
 
-  std::vector<int> candidate_pool;
-  for (int pin = 0; pin < pb->pb_graph_node->total_pb_pins; ++pin) {
-    /* Bypass unused pins */
-    if ((0 == pb->pb_route.count(pin)) ||
-        (AtomNetId::INVALID() == pb->pb_route.at(pin).atom_net_id)) {
-      continue;
-    }
-    /* Get the driver pb pin id, it must be valid */
-    if (atom_net_id != pb->pb_route.at(pin).atom_net_id) {
-      continue;
-    }
-    candidate_pool.push_back(pin);
-  }
+  const std::vector<int>& candidate_pool =
+    find_net_pb_route_pins(net_pb_route_pins, atom_net_id);
 
   for (int pin : candidate_pool) {
     if (source_pb_pin->port == pb->pb_route.at(pin).pb_graph_pin->port) {
@@ -319,7 +379,7 @@ static std::vector<int> find_pb_route_by_atom_net_exclude_blacklist(
   const t_pb* pb, const t_pb_graph_pin* source_pb_pin,
   const AtomNetId& atom_net_id,
   const std::map<AtomNetId, bool>& ignored_atom_nets,
-  const RepackOption& options) {
+  const t_net_pb_route_pins& net_pb_route_pins, const RepackOption& options) {
   VTR_ASSERT(true == source_pb_pin->parent_node->is_root());
 
   std::vector<int> pb_route_indices;
@@ -327,16 +387,8 @@ static std::vector<int> find_pb_route_by_atom_net_exclude_blacklist(
   auto result = ignored_atom_nets.find(atom_net_id);
 
   std::vector<int> candidate_pool;
-  for (int pin = 0; pin < pb->pb_graph_node->total_pb_pins; ++pin) {
-    /* Bypass unused pins */
-    if ((0 == pb->pb_route.count(pin)) ||
-        (AtomNetId::INVALID() == pb->pb_route.at(pin).atom_net_id)) {
-      continue;
-    }
-    /* Get the driver pb pin id, it must be valid */
-    if (atom_net_id != pb->pb_route.at(pin).atom_net_id) {
-      continue;
-    }
+  for (const int& pin :
+       find_net_pb_route_pins(net_pb_route_pins, atom_net_id)) {
     BasicPort curr_pin(
       std::string(pb->pb_route.at(pin).pb_graph_pin->port->name),
       pb->pb_route.at(pin).pb_graph_pin->pin_number,
@@ -379,21 +431,13 @@ static std::vector<int> find_pb_route_by_atom_net_exclude_blacklist(
  ***************************************************************************************/
 static std::vector<int> find_pb_route_remapped_source_pb_pin(
   const t_pb* pb, const t_pb_graph_pin* source_pb_pin,
-  const AtomNetId& atom_net_id) {
+  const AtomNetId& atom_net_id, const t_net_pb_route_pins& net_pb_route_pins) {
   VTR_ASSERT(true == source_pb_pin->parent_node->is_root());
 
   std::vector<int> pb_route_indices;
 
-  for (int pin = 0; pin < pb->pb_graph_node->total_pb_pins; ++pin) {
-    /* Bypass unused pins */
-    if ((0 == pb->pb_route.count(pin)) ||
-        (AtomNetId::INVALID() == pb->pb_route.at(pin).atom_net_id)) {
-      continue;
-    }
-    /* Get the driver pb pin id, it must be valid */
-    if (atom_net_id != pb->pb_route.at(pin).atom_net_id) {
-      continue;
-    }
+  for (const int& pin :
+       find_net_pb_route_pins(net_pb_route_pins, atom_net_id)) {
     /* Only care the pin has the same parent port as source_pb_pin
      * Due to that the source_pb_pin may be swapped during routing
      * the pb_route is out-of-date
@@ -480,8 +524,9 @@ static std::vector<LbRRNodeId> find_lb_net_physical_sink_lb_rr_nodes(
 /***************************************************************************************
  * Create nets to be routed, including the source nodes and terminals
  * And add them to the logical block router
+ * Return the number of pins whose nets are decided by design constraints
  ***************************************************************************************/
-static void add_lb_router_nets(
+static size_t add_lb_router_nets(
   LbRouter& lb_router, t_logical_block_type_ptr lb_type,
   const LbRRGraph& lb_rr_graph, const AtomContext& atom_ctx,
   const VprDeviceAnnotation& device_annotation,
@@ -489,8 +534,10 @@ static void add_lb_router_nets(
   const VprClusteringAnnotation& clustering_annotation,
   const ClusterBlockId& block_id, const RepackOption& options) {
   size_t net_counter = 0;
+  size_t num_constrained_pins = 0;
   bool verbose = options.verbose_output();
-  RepackDesignConstraints design_constraints = options.design_constraints();
+  const RepackDesignConstraints& design_constraints =
+    options.design_constraints();
 
   /* Two spots to find source nodes for each nets
    *  - nets that appear in the inputs of a clustered block
@@ -511,6 +558,10 @@ static void add_lb_router_nets(
   t_pb_graph_pin** pb_graph_pin_lookup_from_index =
     alloc_and_load_pb_graph_pin_lookup_from_index(lb_type);
 
+  /* Build the fast look-ups for the routing traces of each net */
+  t_net_pb_route_pins net_pb_route_pins = build_net_pb_route_pins(pb);
+  t_routed_sink_pb_pins_cache routed_sink_pb_pins_cache;
+
   /* Build a fast look-up between pb_graph_pin and atom net id which it is
    * mapped to Note that, we only care the pb_graph_pin at the root
    * pb_graph_node where pb_graph_pin may be remapped to a new net due to
@@ -583,7 +634,8 @@ static void add_lb_router_nets(
       AtomNetId atom_net_id = pb_pin_mapped_nets[source_pb_pin];
 
       std::vector<int> pb_route_indices =
-        find_pb_route_by_atom_net(pb, source_pb_pin, atom_net_id);
+        find_pb_route_by_atom_net(pb, source_pb_pin, atom_net_id,
+                                  net_pb_route_pins);
       VTR_ASSERT(1 == pb_route_indices.size());
       int pb_route_index = pb_route_indices[0];
       t_pb_graph_pin* packing_source_pb_pin =
@@ -595,8 +647,8 @@ static void add_lb_router_nets(
       std::vector<t_pb_graph_pin*> sink_pb_graph_pins =
         find_routed_pb_graph_pins_atom_net(
           pb, source_pb_pin, packing_source_pb_pin, atom_net_id,
-          device_annotation, pb_pin_mapped_nets,
-          pb_graph_pin_lookup_from_index);
+          device_annotation, pb_pin_mapped_nets, pb_graph_pin_lookup_from_index,
+          routed_sink_pb_pins_cache);
       std::vector<LbRRNodeId> sink_lb_rr_nodes =
         find_lb_net_physical_sink_lb_rr_nodes(lb_rr_graph, sink_pb_graph_pins,
                                               device_annotation);
@@ -696,6 +748,13 @@ static void add_lb_router_nets(
                constrained_net_name.c_str());
     }
 
+    /* Count the pins whose constraints are accepted */
+    if ((!design_constraints.unconstrained_net(constrained_net_name)) &&
+        ((design_constraints.unmapped_net(constrained_net_name)) ||
+         (atom_ctx.nlist.valid_net_id(constrained_atom_net_id)))) {
+      num_constrained_pins++;
+    }
+
     /* Bypass unmapped pins. There are 4 conditions to consider
      * +======+=================+=============+================================+
      * | Case | Packing results | Constraints | Decision to route              |
@@ -748,13 +807,14 @@ static void add_lb_router_nets(
       VTR_LOGV(verbose,
                "Search remapped routing traces for the unconstrained net\n");
       pb_route_indices = find_pb_route_remapped_source_pb_pin(
-        pb, source_pb_pin, atom_net_id_to_route);
+        pb, source_pb_pin, atom_net_id_to_route, net_pb_route_pins);
     } else {
       /* If this is a constrained net but the source pin is not the pin that the
        * net is constrained to, w*/
       VTR_LOGV(verbose, "Search routing traces for the constrained net\n");
       pb_route_indices = find_pb_route_by_atom_net_exclude_blacklist(
-        pb, source_pb_pin, atom_net_id_to_route, ignored_atom_nets, options);
+        pb, source_pb_pin, atom_net_id_to_route, ignored_atom_nets,
+        net_pb_route_pins, options);
     }
     /* It could happen that the constrained net is NOT used in this clb, we just
      * skip it for routing For example, a clkB net is never mapped to any ports
@@ -790,7 +850,8 @@ static void add_lb_router_nets(
     std::vector<t_pb_graph_pin*> sink_pb_graph_pins =
       find_routed_pb_graph_pins_atom_net(
         pb, source_pb_pin, packing_source_pb_pin, atom_net_id_to_route,
-        device_annotation, pb_pin_mapped_nets, pb_graph_pin_lookup_from_index);
+        device_annotation, pb_pin_mapped_nets, pb_graph_pin_lookup_from_index,
+        routed_sink_pb_pins_cache);
     std::vector<LbRRNodeId> sink_lb_rr_nodes =
       find_lb_net_physical_sink_lb_rr_nodes(lb_rr_graph, sink_pb_graph_pins,
                                             device_annotation);
@@ -870,7 +931,8 @@ static void add_lb_router_nets(
     std::vector<t_pb_graph_pin*> sink_pb_graph_pins =
       find_routed_pb_graph_pins_atom_net(
         pb, physical_source_pb_pin, source_pb_pin, atom_net_id,
-        device_annotation, pb_pin_mapped_nets, pb_graph_pin_lookup_from_index);
+        device_annotation, pb_pin_mapped_nets, pb_graph_pin_lookup_from_index,
+        routed_sink_pb_pins_cache);
 
     std::vector<LbRRNodeId> sink_lb_rr_nodes =
       find_lb_net_physical_sink_lb_rr_nodes(lb_rr_graph, sink_pb_graph_pins,
@@ -900,6 +962,8 @@ static void add_lb_router_nets(
   free_pb_graph_pin_lookup_from_index(pb_graph_pin_lookup_from_index);
 
   VTR_LOGV(verbose, "Added %lu nets to be routed.\n", net_counter);
+
+  return num_constrained_pins;
 }
 
 /***************************************************************************************
@@ -910,16 +974,23 @@ static void add_lb_router_nets(
  * - Create nets to be routed, including the source nodes and terminals
  *   This should consider the net remapping in the clustering_annotation
  * - Run the router to finish the repacking
- * - Output routing results to data structure PhysicalPb and store it in
- *clustering annotation
+ * - Output routing results to data structure PhysicalPb
+ * The router of the lb_rr_graph is taken from the pool given, so that it is
+ * reused across the clustered blocks of the same type
+ * A clustered block whose nets have been routed for another block reuses
+ * the routing results in the cache given without running the router
+ * The statistics of repacking are stored in the cluster_stats given
  ***************************************************************************************/
-static void repack_cluster(const AtomContext& atom_ctx,
-                           const ClusteringContext& clustering_ctx,
-                           const VprDeviceAnnotation& device_annotation,
-                           VprClusteringAnnotation& clustering_annotation,
-                           const VprBitstreamAnnotation& bitstream_annotation,
-                           const ClusterBlockId& block_id,
-                           const RepackOption& options) {
+static void repack_cluster(
+  const AtomContext& atom_ctx, const ClusteringContext& clustering_ctx,
+  const VprDeviceAnnotation& device_annotation,
+  const VprClusteringAnnotation& clustering_annotation,
+  const VprBitstreamAnnotation& bitstream_annotation,
+  const ClusterBlockId& block_id, const RepackOption& options,
+  LbRouterPool& lb_router_pool, LbRouteCache& lb_route_cache,
+  PhysicalPb& phy_pb, t_repack_cluster_stats& cluster_stats) {
+  vtr::Timer cluster_timer;
+
   /* Get the pb graph that current clustered block is mapped to */
   t_logical_block_type_ptr lb_type =
     clustering_ctx.clb_nlist.block_type(block_id);
@@ -937,52 +1008,74 @@ static void repack_cluster(const AtomContext& atom_ctx,
   VTR_LOGV(verbose, "\n");
 
   /* Initialize the router */
-  LbRouter lb_router(lb_rr_graph, lb_type);
+  LbRouter& lb_router = lb_router_pool.router(lb_rr_graph, lb_type);
 
   /* Add nets to be routed with source and terminals */
-  add_lb_router_nets(
+  cluster_stats.num_constrained_pins = add_lb_router_nets(
     lb_router, lb_type, lb_rr_graph, atom_ctx, device_annotation,
-    clustering_ctx,
-    const_cast<const VprClusteringAnnotation&>(clustering_annotation), block_id,
-    options);
+    clustering_ctx, clustering_annotation, block_id, options);
+  cluster_stats.block_name = clustering_ctx.clb_nlist.block_name(block_id);
+  cluster_stats.pb_type_name = std::string(lb_type->pb_type->name);
+  cluster_stats.num_nets = lb_router.nets().size();
+
+  const LbRouteCache::net_routed_nodes* cached_routed_nodes =
+    lb_route_cache.find(lb_rr_graph, lb_router);
+  if (nullptr != cached_routed_nodes) {
+    VTR_LOGV(verbose, "Reuse routing results of identical nets\n");
+    cluster_stats.reused_routing = true;
+  } else {
+    /* Initialize the modes to expand routing trees with the physical modes in
+     * device annotation This is a must-do before running the routeri in the
+     * purpose of repacking!!!
+     */
+    lb_router.set_physical_pb_modes(lb_rr_graph, device_annotation);
 
-  /* Initialize the modes to expand routing trees with the physical modes in
-   * device annotation This is a must-do before running the routeri in the
-   * purpose of repacking!!!
-   */
-  lb_router.set_physical_pb_modes(lb_rr_graph, device_annotation);
+    /* Run the router */
+    bool route_success =
+      lb_router.try_route(lb_rr_graph, atom_ctx.nlist, verbose);
 
-  /* Run the router */
-  bool route_success =
-    lb_router.try_route(lb_rr_graph, atom_ctx.nlist, verbose);
+    if (false == route_success) {
+      VTR_LOGV(verbose, "Reroute failed\n");
+      exit(1);
+    }
+    VTR_ASSERT(true == route_success);
+    VTR_LOGV(verbose, "Reroute succeed\n");
+    cluster_stats.num_route_iterations = lb_router.num_route_iterations();
+    cluster_stats.num_expanded_nodes = lb_router.num_expanded_nodes();
+    cluster_stats.num_heap_pushes = lb_router.num_heap_pushes();
 
-  if (false == route_success) {
-    VTR_LOGV(verbose, "Reroute failed\n");
-    exit(1);
+    lb_route_cache.add(lb_rr_graph, lb_router);
   }
-  VTR_ASSERT(true == route_success);
-  VTR_LOGV(verbose, "Reroute succeed\n");
 
   /* Annotate routing results to physical pb */
-  PhysicalPb phy_pb;
   alloc_physical_pb_from_pb_graph(phy_pb, pb_graph_head, device_annotation);
   rec_update_physical_pb_from_operating_pb(
     phy_pb, clustering_ctx.clb_nlist.block_pb(block_id),
     clustering_ctx.clb_nlist.block_pb(block_id)->pb_route, atom_ctx,
     device_annotation, bitstream_annotation, verbose);
   /* Save routing results */
-  save_lb_router_results_to_physical_pb(phy_pb, lb_router, lb_rr_graph,
-                                        atom_ctx.nlist, verbose);
+  if (nullptr != cached_routed_nodes) {
+    save_lb_router_results_to_physical_pb(phy_pb, lb_router,
+                                          *cached_routed_nodes, lb_rr_graph,
+                                          atom_ctx.nlist, verbose);
+  } else {
+    save_lb_router_results_to_physical_pb(phy_pb, lb_router, lb_rr_graph,
+                                          atom_ctx.nlist, verbose);
+  }
   VTR_LOGV(verbose, "Saved results in physical pb\n");
 
-  /* Add the pb to clustering context */
-  clustering_annotation.add_physical_pb(block_id, phy_pb);
+  cluster_stats.wall_time = cluster_timer.elapsed_sec();
 
   VTR_LOG("Done\n");
 }
 
 /***************************************************************************************
  * Repack each clustered blocks in the clustering context
+ * Clustered blocks are repacked by a number of workers, each of which claims
+ * the next block to repack and owns a pool of routers, one for each type of
+ * logical tile, as well as a cache of routing results.
+ * The physical pbs are allocated in the clustering annotation before, so
+ * that each worker builds the physical pb of its block in place
  ***************************************************************************************/
 static void repack_clusters(const AtomContext& atom_ctx,
                             const ClusteringContext& clustering_ctx,
@@ -992,11 +1085,47 @@ static void repack_clusters(const AtomContext& atom_ctx,
                             const RepackOption& options) {
   vtr::ScopedStartFinishTimer timer(
     "Repack clustered blocks to physical implementation of logical tile");
+  OPENFPGA_TRACE_FUNCTION();
 
+  std::vector<ClusterBlockId> blocks;
   for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
-    repack_cluster(atom_ctx, clustering_ctx, device_annotation,
-                   clustering_annotation, bitstream_annotation, blk_id,
-                   options);
+    blocks.push_back(blk_id);
+  }
+  std::vector<t_repack_cluster_stats> cluster_stats(blocks.size());
+
+  clustering_annotation.init_physical_pbs(clustering_ctx.clb_nlist);
+
+  const VprClusteringAnnotation& const_clustering_annotation =
+    const_cast<const VprClusteringAnnotation&>(clustering_annotation);
+  size_t num_workers =
+    std::max(size_t(1), std::min(options.num_threads(), blocks.size()));
+  std::atomic<size_t> next_block(0);
+  std::atomic<size_t> num_cache_hits(0);
+  {
+    ScopedProgress progress("Repack clustered blocks", "clusters",
+                            blocks.size());
+    parallel_for(num_workers, num_workers, [&](const size_t&) {
+      LbRouterPool lb_router_pool;
+      LbRouteCache lb_route_cache(MAX_NUM_CACHED_LB_ROUTES);
+      for (size_t iblk = next_block.fetch_add(1); iblk < blocks.size();
+           iblk = next_block.fetch_add(1)) {
+        repack_cluster(atom_ctx, clustering_ctx, device_annotation,
+                       const_clustering_annotation, bitstream_annotation,
+                       blocks[iblk], options, lb_router_pool, lb_route_cache,
+                       clustering_annotation.mutable_physical_pb(blocks[iblk]),
+                       cluster_stats[iblk]);
+        progress.advance();
+      }
+      num_cache_hits += lb_route_cache.num_hits();
+    });
+  }
+  VTR_LOG("Reused routing results for %lu out of %lu clustered blocks\n",
+          num_cache_hits.load(), blocks.size());
+
+  /* Report statistics when required */
+  if (false == options.stats_file().empty()) {
+    write_repack_stats_to_csv_file(options.stats_file(), cluster_stats);
+    print_repack_stats_summary(cluster_stats);
   }
 }
 
@@ -1013,6 +1142,7 @@ static void identify_physical_pb_wire_lut_created_by_repack(
   const VprDeviceAnnotation& device_annotation,
   const CircuitLibrary& circuit_lib, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Identify wire LUTs created by repacking");
+  OPENFPGA_TRACE_FUNCTION();
   int wire_lut_counter = 0;
 
   for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
@@ -1057,7 +1187,7 @@ void pack_physical_pbs(const DeviceContext& device_ctx,
                        const RepackOption& options) {
   /* build the routing resource graph for each logical tile */
   build_physical_lb_rr_graphs(device_ctx, device_annotation,
-                              options.verbose_output());
+                              options.num_threads(), options.verbose_output());
 
   /* Call the LbRouter to re-pack each clustered block to physical
    * implementation */
@@ -18,6 +18,7 @@ namespace openfpga {
  * Public Constructors
  *************************************************/
 RepackOption::RepackOption() {
+  num_threads_ = 1;
   verbose_output_ = false;
   num_parse_errors_ = 0;
 }
@@ -25,7 +26,7 @@ RepackOption::RepackOption() {
 /**************************************************
  * Public Accessors
  *************************************************/
-RepackDesignConstraints RepackOption::design_constraints() const {
+const RepackDesignConstraints& RepackOption::design_constraints() const {
   return design_constraints_;
 }
 
@@ -46,6 +47,10 @@ bool RepackOption::is_pin_ignore_global_nets(const std::string& pb_type_name,
   return false;
 }
 
+size_t RepackOption::num_threads() const { return num_threads_; }
+
+std::string RepackOption::stats_file() const { return stats_file_; }
+
 bool RepackOption::verbose_output() const { return verbose_output_; }
 
 /******************************************************************************
@@ -120,6 +125,14 @@ void RepackOption::set_ignore_global_nets_on_pins(const std::string& content) {
   }
 }
 
+void RepackOption::set_num_threads(const size_t& num_threads) {
+  num_threads_ = num_threads;
+}
+
+void RepackOption::set_stats_file(const std::string& stats_file) {
+  stats_file_ = stats_file;
+}
+
 void RepackOption::set_verbose_output(const bool& enabled) {
   verbose_output_ = enabled;
 }
@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -21,16 +22,22 @@ class RepackOption {
   RepackOption();
 
  public: /* Public accessors */
-  RepackDesignConstraints design_constraints() const;
+  const RepackDesignConstraints& design_constraints() const;
   /* Identify if a pin should ignore all the global nets */
   bool is_pin_ignore_global_nets(const std::string& pb_type_name,
                                  const BasicPort& pin) const;
+  size_t num_threads() const;
+  /* File path to report the statistics of repacking each clustered block.
+   * Empty means no report */
+  std::string stats_file() const;
   bool verbose_output() const;
 
  public: /* Public mutators */
   void set_design_constraints(
     const RepackDesignConstraints& design_constraints);
   void set_ignore_global_nets_on_pins(const std::string& content);
+  void set_num_threads(const size_t& num_threads);
+  void set_stats_file(const std::string& stats_file);
   void set_verbose_output(const bool& enabled);
 
  public: /* Public validators */
@@ -48,6 +55,8 @@ class RepackOption {
    */
   std::map<std::string, std::vector<BasicPort>> ignore_global_nets_on_pins_;
 
+  size_t num_threads_;
+  std::string stats_file_;
   bool verbose_output_;
 
   /* A flag to indicate if the data parse is invalid or not */
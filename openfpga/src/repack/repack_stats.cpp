@@ -0,0 +1,139 @@
+/********************************************************************
+ * This file includes functions to report the statistics of repacking
+ * clustered blocks, which are used to find the clustered blocks and the
+ * pb_types that are slow to repack
+ *******************************************************************/
+#include "repack_stats.h"
+
+#include <algorithm>
+#include <map>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_buffered_stream.h"
+#include "openfpga_digest.h"
+#include "openfpga_trace.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Quote a field of a CSV file when it contains special characters
+ *******************************************************************/
+static std::string csv_field(const std::string& field) {
+  if (std::string::npos == field.find_first_of(",\"\n")) {
+    return field;
+  }
+  std::string quoted("\"");
+  for (const char& c : field) {
+    if ('"' == c) {
+      quoted.push_back('"');
+    }
+    quoted.push_back(c);
+  }
+  quoted.push_back('"');
+  return quoted;
+}
+
+/********************************************************************
+ * Write the statistics of each clustered block to a CSV file, one line
+ * per clustered block in the sequence of the statistics given
+ * Return 0 if successful
+ *******************************************************************/
+int write_repack_stats_to_csv_file(
+  const std::string& fname, const std::vector<t_repack_cluster_stats>& stats) {
+  std::string timer_message =
+    std::string("Write repacking statistics to file '") + fname +
+    std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+  OPENFPGA_TRACE_FUNCTION();
+
+  VTR_ASSERT(true != fname.empty());
+
+  std::string dir_path = format_dir_path(find_path_dir_name(fname));
+  create_directory(dir_path);
+
+  BufferedFileStream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(fname.c_str(), fp);
+
+  fp << "block,pb_type,num_nets,num_constrained_pins,reused_routing,"
+     << "num_route_iterations,num_expanded_nodes,num_heap_pushes,wall_time"
+     << "\n";
+  for (const t_repack_cluster_stats& cluster_stats : stats) {
+    fp << csv_field(cluster_stats.block_name) << ","
+       << csv_field(cluster_stats.pb_type_name) << ","
+       << cluster_stats.num_nets << "," << cluster_stats.num_constrained_pins
+       << "," << (cluster_stats.reused_routing ? 1 : 0) << ","
+       << cluster_stats.num_route_iterations << ","
+       << cluster_stats.num_expanded_nodes << ","
+       << cluster_stats.num_heap_pushes << "," << cluster_stats.wall_time
+       << "\n";
+  }
+
+  fp.close();
+
+  return 0;
+}
+
+/********************************************************************
+ * Print a summary of the statistics for each pb_type, in the
+ * alphabetical order of pb_types
+ *******************************************************************/
+void print_repack_stats_summary(
+  const std::vector<t_repack_cluster_stats>& stats) {
+  struct t_pb_type_summary {
+    size_t num_blocks = 0;
+    size_t num_reused_blocks = 0;
+    size_t num_constrained_blocks = 0;
+    size_t num_nets = 0;
+    size_t max_route_iterations = 0;
+    size_t num_expanded_nodes = 0;
+    size_t num_heap_pushes = 0;
+    float wall_time = 0.;
+    float max_wall_time = 0.;
+    std::string slowest_block;
+  };
+  std::map<std::string, t_pb_type_summary> summaries;
+  for (const t_repack_cluster_stats& cluster_stats : stats) {
+    t_pb_type_summary& summary = summaries[cluster_stats.pb_type_name];
+    summary.num_blocks++;
+    if (cluster_stats.reused_routing) {
+      summary.num_reused_blocks++;
+    }
+    if (0 < cluster_stats.num_constrained_pins) {
+      summary.num_constrained_blocks++;
+    }
+    summary.num_nets += cluster_stats.num_nets;
+    summary.max_route_iterations = std::max(
+      summary.max_route_iterations, cluster_stats.num_route_iterations);
+    summary.num_expanded_nodes += cluster_stats.num_expanded_nodes;
+    summary.num_heap_pushes += cluster_stats.num_heap_pushes;
+    summary.wall_time += cluster_stats.wall_time;
+    if (summary.slowest_block.empty() ||
+        cluster_stats.wall_time > summary.max_wall_time) {
+      summary.max_wall_time = cluster_stats.wall_time;
+      summary.slowest_block = cluster_stats.block_name;
+    }
+  }
+
+  VTR_LOG("Repacking statistics per pb_type:\n");
+  for (const auto& kv : summaries) {
+    const t_pb_type_summary& summary = kv.second;
+    VTR_LOG(
+      "\t'%s': %lu blocks (%lu reused routing, %lu constrained), %lu nets, "
+      "max. %lu iterations, %lu expanded nodes, %lu heap pushes, %g s in "
+      "total, slowest block '%s' (%g s)\n",
+      kv.first.c_str(), summary.num_blocks, summary.num_reused_blocks,
+      summary.num_constrained_blocks, summary.num_nets,
+      summary.max_route_iterations, summary.num_expanded_nodes,
+      summary.num_heap_pushes, summary.wall_time,
+      summary.slowest_block.c_str(), summary.max_wall_time);
+  }
+}
+
+} /* end namespace openfpga */
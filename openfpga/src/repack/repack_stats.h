@@ -0,0 +1,45 @@
+#ifndef REPACK_STATS_H
+#define REPACK_STATS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include <vector>
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Statistics of repacking a clustered block
+ *******************************************************************/
+struct t_repack_cluster_stats {
+  std::string block_name;
+  std::string pb_type_name;
+  /* Number of nets to route */
+  size_t num_nets = 0;
+  /* Number of pins whose nets are decided by design constraints */
+  size_t num_constrained_pins = 0;
+  /* True if the routing results of another block are reused */
+  bool reused_routing = false;
+  /* Effort of the router, which are zero when routing results are reused */
+  size_t num_route_iterations = 0;
+  size_t num_expanded_nodes = 0;
+  size_t num_heap_pushes = 0;
+  /* Wall time of repacking the block in seconds */
+  float wall_time = 0.;
+};
+
+int write_repack_stats_to_csv_file(
+  const std::string& fname, const std::vector<t_repack_cluster_stats>& stats);
+
+void print_repack_stats_summary(
+  const std::vector<t_repack_cluster_stats>& stats);
+
+} /* end namespace openfpga */
+
+#endif
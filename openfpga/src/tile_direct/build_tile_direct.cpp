@@ -3,15 +3,23 @@
  * between tiles (programmable blocks)
  ***************************************************************************************/
 
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
 #include "openfpga_port.h"
 #include "openfpga_port_parser.h"
 #include "openfpga_tokenizer.h"
+#include "openfpga_trace.h"
 
 /* Headers from vpr library */
 #include "build_tile_direct.h"
@@ -153,27 +161,85 @@ static bool is_grid_coordinate_exist_in_device(
 }
 
 /********************************************************************
- * Find the coordinate of a grid in a specific column
+ * The coordinates of the grids of a tile type
+ * - coords: all the coordinates, ordered by x and then by y
+ * - columns: [x] the y of the grids in column x, in ascending order
+ * - rows: [y] the x of the grids in row y, in ascending order
+ *******************************************************************/
+struct t_tile_type_grid_index {
+  std::vector<vtr::Point<size_t>> coords;
+  std::vector<std::vector<size_t>> columns;
+  std::vector<std::vector<size_t>> rows;
+};
+
+/* Grid coordinates indexed by the name of tile types */
+typedef std::unordered_map<std::string, t_tile_type_grid_index>
+  t_tile_type_grid_lookup;
+
+/********************************************************************
+ * Index the coordinates of the grids by their tile types, so that the
+ * grids of a tile type can be found without scanning the device grid
+ *******************************************************************/
+static t_tile_type_grid_lookup build_tile_type_grid_lookup(
+  const DeviceGrid& grids) {
+  t_tile_type_grid_lookup grid_lookup;
+  for (size_t x = 0; x < grids.width(); ++x) {
+    for (size_t y = 0; y < grids.height(); ++y) {
+      t_tile_type_grid_index& grid_index =
+        grid_lookup[std::string(grids[x][y].type->name)];
+      if (true == grid_index.coords.empty()) {
+        grid_index.columns.resize(grids.width());
+        grid_index.rows.resize(grids.height());
+      }
+      grid_index.coords.push_back(vtr::Point<size_t>(x, y));
+      grid_index.columns[x].push_back(y);
+      grid_index.rows[y].push_back(x);
+    }
+  }
+  return grid_lookup;
+}
+
+/********************************************************************
+ * Find the coordinate of a grid in a specific column (or row)
  * with a given type
- * This function will return the coordinate of the grid that satifies
- * the type requirement
+ * Only the core grids, i.e., from y = 1 to y = ny (x = 1 to x = nx for a
+ * row), are considered. The search starts from y = 1 (x = 1) and goes
+ * upward (rightward), unless it is reversed.
+ * This function will return the coordinate of the first grid that satifies
+ * the type requirement, or an invalid coordinate if there is none
  *******************************************************************/
 static vtr::Point<size_t> find_grid_coordinate_given_type(
-  const DeviceGrid& grids,
-  const std::vector<vtr::Point<size_t>>& candidate_coords,
-  const std::string& wanted_grid_type_name) {
-  for (vtr::Point<size_t> coord : candidate_coords) {
-    /* If the next column is not longer in device range, we can return */
-    if (false == is_grid_coordinate_exist_in_device(grids, coord)) {
-      continue;
+  const DeviceGrid& grids, const t_tile_type_grid_index& wanted_grid_index,
+  const bool& search_column, const size_t& line, const bool& reverse) {
+  const std::vector<size_t>& line_grids =
+    search_column ? wanted_grid_index.columns[line]
+                  : wanted_grid_index.rows[line];
+  size_t low = 1;
+  size_t high = search_column ? grids.height() - 2 : grids.width() - 2;
+
+  std::vector<size_t>::const_iterator it;
+  if (false == reverse) {
+    it = std::lower_bound(line_grids.begin(), line_grids.end(), low);
+    if ((it == line_grids.end()) || (*it > high)) {
+      it = line_grids.end();
     }
-    if (wanted_grid_type_name ==
-        std::string(grids[coord.x()][coord.y()].type->name)) {
-      return coord;
+  } else {
+    it = std::upper_bound(line_grids.begin(), line_grids.end(), high);
+    if ((it == line_grids.begin()) || (*std::prev(it) < low)) {
+      it = line_grids.end();
+    } else {
+      --it;
     }
   }
-  /* Return an valid coordinate */
-  return vtr::Point<size_t>(grids.width(), grids.height());
+
+  if (it == line_grids.end()) {
+    /* Return an valid coordinate */
+    return vtr::Point<size_t>(grids.width(), grids.height());
+  }
+  if (true == search_column) {
+    return vtr::Point<size_t>(line, *it);
+  }
+  return vtr::Point<size_t>(*it, line);
 }
 
 /********************************************************************
@@ -181,13 +247,21 @@ static vtr::Point<size_t> find_grid_coordinate_given_type(
  * considering intra column/row direct connections in core grids
  *******************************************************************/
 static vtr::Point<size_t> find_inter_direct_destination_coordinate(
-  const DeviceGrid& grids, const vtr::Point<size_t>& src_coord,
-  const std::string des_tile_type_name, const ArchDirect& arch_direct,
-  const ArchDirectId& arch_direct_id) {
+  const DeviceGrid& grids, const t_tile_type_grid_lookup& grid_lookup,
+  const vtr::Point<size_t>& src_coord, const std::string des_tile_type_name,
+  const ArchDirect& arch_direct, const ArchDirectId& arch_direct_id) {
   vtr::Point<size_t> des_coord(grids.width(), grids.height());
 
+  /* No grid of the wanted type in the device */
+  auto des_grid_index = grid_lookup.find(des_tile_type_name);
+  if (des_grid_index == grid_lookup.end()) {
+    return des_coord;
+  }
+
   std::vector<size_t> first_search_space;
-  std::vector<size_t> second_search_space;
+  /* The grids in the second search space are ordered from 1 to ny (nx),
+   * and are visited in reverse order for the positive direction */
+  bool reverse_second_search_space = false;
 
   /* Cross column connection from Bottom to Top on Right
    * The next column may NOT have the grid type we want!
@@ -233,9 +307,6 @@ static vtr::Point<size_t> find_inter_direct_destination_coordinate(
      *  | Grid | 1
      *  +------+
      */
-    for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
-      second_search_space.push_back(iy);
-    }
 
     /* For negative direction, our second search space will be in y-direction:
      *
@@ -249,9 +320,8 @@ static vtr::Point<size_t> find_inter_direct_destination_coordinate(
      *  | Grid | 1
      *  +------+
      */
-    if (POSITIVE_DIR == arch_direct.y_dir(arch_direct_id)) {
-      std::reverse(second_search_space.begin(), second_search_space.end());
-    }
+    reverse_second_search_space =
+      (POSITIVE_DIR == arch_direct.y_dir(arch_direct_id));
   }
 
   /* Cross row connection from Bottom to Top on Right
@@ -304,9 +374,6 @@ static vtr::Point<size_t> find_inter_direct_destination_coordinate(
      *  | Grid |<------| Grid |
      *  +------+       +------+
      */
-    for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
-      second_search_space.push_back(ix);
-    }
 
     /* For negative direction,
      * our second search space will be in x-direction:
@@ -316,24 +383,16 @@ static vtr::Point<size_t> find_inter_direct_destination_coordinate(
      *  | Grid |------>| Grid |
      *  +------+       +------+
      */
-    if (POSITIVE_DIR == arch_direct.x_dir(arch_direct_id)) {
-      std::reverse(second_search_space.begin(), second_search_space.end());
-    }
+    reverse_second_search_space =
+      (POSITIVE_DIR == arch_direct.x_dir(arch_direct_id));
   }
 
   for (size_t ix : first_search_space) {
-    std::vector<vtr::Point<size_t>> next_col_row_coords;
-    for (size_t iy : second_search_space) {
-      if (INTER_COLUMN == arch_direct.type(arch_direct_id)) {
-        next_col_row_coords.push_back(vtr::Point<size_t>(ix, iy));
-      } else {
-        VTR_ASSERT(INTER_ROW == arch_direct.type(arch_direct_id));
-        /* For cross-row connection, our search space is flipped */
-        next_col_row_coords.push_back(vtr::Point<size_t>(iy, ix));
-      }
-    }
+    /* For cross-row connection, our search space is flipped */
     vtr::Point<size_t> des_coord_cand = find_grid_coordinate_given_type(
-      grids, next_col_row_coords, des_tile_type_name);
+      grids, des_grid_index->second,
+      INTER_COLUMN == arch_direct.type(arch_direct_id), ix,
+      reverse_second_search_space);
     /* For a valid coordinate, we can return */
     if (true == is_grid_coordinate_exist_in_device(grids, des_coord_cand)) {
       return des_coord_cand;
@@ -356,6 +415,58 @@ static void report_direct_from_port_and_to_port_mismatch(
     to_tile_port.get_lsb(), to_tile_port.get_msb());
 }
 
+/***************************************************************************************
+ * A tile-to-tile direct connection found for a direct definition, which is
+ * added to the TileDirect after all the direct definitions are processed
+ ***************************************************************************************/
+struct t_tile_direct_conn {
+  vtr::Point<size_t> from_grid_coord;
+  e_side from_side;
+  size_t from_pin;
+  vtr::Point<size_t> to_grid_coord;
+  e_side to_side;
+  size_t to_pin;
+};
+
+/***************************************************************************************
+ * Find the tile-to-tile direct connections between the pins of a source and
+ * a destination grid. Return false if the sizes of the pins do not match
+ ***************************************************************************************/
+static bool find_grid_pin_tile_directs(
+  const DeviceContext& device_ctx, const vtr::Point<size_t>& from_grid_coord,
+  const e_side& from_side, const std::vector<size_t>& from_pins,
+  const vtr::Point<size_t>& to_grid_coord, const BasicPort& to_tile_port,
+  std::vector<t_tile_direct_conn>& conns) {
+  /* Search all the sides, the to pin may locate any side!
+   * Note: the vpr_direct.to_side is NUM_SIDES, which is unintialized
+   * This should be reported to VPR!!!
+   */
+  for (const e_side& to_side : {TOP, RIGHT, BOTTOM, LEFT}) {
+    /* Try to find the pin in this tile */
+    std::vector<size_t> to_pins = find_physical_tile_pin_id(
+      device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].type,
+      device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].width_offset,
+      device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].height_offset,
+      to_tile_port, to_side);
+    /* If nothing found, we can continue */
+    if (0 == to_pins.size()) {
+      continue;
+    }
+
+    /* If from port and to port do not match in sizes, error out */
+    if (from_pins.size() != to_pins.size()) {
+      return false;
+    }
+
+    /* Now add the tile direct */
+    for (size_t ipin = 0; ipin < from_pins.size(); ++ipin) {
+      conns.push_back({from_grid_coord, from_side, from_pins[ipin],
+                       to_grid_coord, to_side, to_pins[ipin]});
+    }
+  }
+  return true;
+}
+
 /***************************************************************************************
  * Build the point-to-point direct connections based on
  *   - original VPR arch definition
@@ -379,11 +490,12 @@ static void report_direct_from_port_and_to_port_mismatch(
  *     |      |
  *     +------+
  *
+ * Return false if the from port and to port do not match
  ***************************************************************************************/
-static void build_inner_column_row_tile_direct(
-  TileDirect& tile_direct, const t_direct_inf& vpr_direct,
-  const DeviceContext& device_ctx, const ArchDirectId& arch_direct_id,
-  const bool& verbose) {
+static bool build_inner_column_row_tile_direct(
+  std::vector<t_tile_direct_conn>& conns, const t_direct_inf& vpr_direct,
+  const DeviceContext& device_ctx,
+  const t_tile_type_grid_lookup& grid_lookup) {
   /* Get the source tile and pin information */
   std::string from_tile_name =
     parse_direct_tile_name(std::string(vpr_direct.from_pin));
@@ -398,94 +510,59 @@ static void build_inner_column_row_tile_direct(
     parse_direct_port(std::string(vpr_direct.to_pin)));
   const BasicPort& to_tile_port = to_tile_port_parser.port();
 
-  /* Walk through the device fabric and find the grid that fit the source */
-  for (size_t x = 0; x < device_ctx.grid.width(); ++x) {
-    for (size_t y = 0; y < device_ctx.grid.height(); ++y) {
-      /* Bypass empty grid */
-      if (true == is_empty_type(device_ctx.grid[x][y].type)) {
+  /* Walk through the grids that fit the source */
+  auto from_grid_index = grid_lookup.find(from_tile_name);
+  if (from_grid_index == grid_lookup.end()) {
+    return true;
+  }
+  for (const vtr::Point<size_t>& from_grid_coord :
+       from_grid_index->second.coords) {
+    size_t x = from_grid_coord.x();
+    size_t y = from_grid_coord.y();
+    /* Bypass empty grid */
+    if (true == is_empty_type(device_ctx.grid[x][y].type)) {
+      continue;
+    }
+
+    /* Search all the sides, the from pin may locate any side!
+     * Note: the vpr_direct.from_side is NUM_SIDES, which is unintialized
+     * This should be reported to VPR!!!
+     */
+    for (const e_side& from_side : {TOP, RIGHT, BOTTOM, LEFT}) {
+      /* Try to find the pin in this tile */
+      std::vector<size_t> from_pins = find_physical_tile_pin_id(
+        device_ctx.grid[x][y].type, device_ctx.grid[x][y].width_offset,
+        device_ctx.grid[x][y].height_offset, from_tile_port, from_side);
+      /* If nothing found, we can continue */
+      if (0 == from_pins.size()) {
         continue;
       }
 
-      /* Bypass the grid that does not fit the from_tile name */
-      if (from_tile_name != std::string(device_ctx.grid[x][y].type->name)) {
+      /* We should try to the sink grid for inner-column/row direct
+       * connections */
+      vtr::Point<size_t> to_grid_coord(x + vpr_direct.x_offset,
+                                       y + vpr_direct.y_offset);
+      if (false ==
+          is_grid_coordinate_exist_in_device(device_ctx.grid, to_grid_coord)) {
         continue;
       }
 
-      /* Search all the sides, the from pin may locate any side!
-       * Note: the vpr_direct.from_side is NUM_SIDES, which is unintialized
-       * This should be reported to VPR!!!
-       */
-      for (const e_side& from_side : {TOP, RIGHT, BOTTOM, LEFT}) {
-        /* Try to find the pin in this tile */
-        std::vector<size_t> from_pins = find_physical_tile_pin_id(
-          device_ctx.grid[x][y].type, device_ctx.grid[x][y].width_offset,
-          device_ctx.grid[x][y].height_offset, from_tile_port, from_side);
-        /* If nothing found, we can continue */
-        if (0 == from_pins.size()) {
-          continue;
-        }
-
-        /* We should try to the sink grid for inner-column/row direct
-         * connections */
-        vtr::Point<size_t> from_grid_coord(x, y);
-        vtr::Point<size_t> to_grid_coord(x + vpr_direct.x_offset,
-                                         y + vpr_direct.y_offset);
-        if (false == is_grid_coordinate_exist_in_device(device_ctx.grid,
-                                                        to_grid_coord)) {
-          continue;
-        }
-
-        /* Bypass the grid that does not fit the from_tile name */
-        if (to_tile_name !=
-            std::string(device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()]
-                          .type->name)) {
-          continue;
-        }
-
-        /* Search all the sides, the to pin may locate any side!
-         * Note: the vpr_direct.to_side is NUM_SIDES, which is unintialized
-         * This should be reported to VPR!!!
-         */
-        for (const e_side& to_side : {TOP, RIGHT, BOTTOM, LEFT}) {
-          /* Try to find the pin in this tile */
-          std::vector<size_t> to_pins = find_physical_tile_pin_id(
-            device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].type,
-            device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].width_offset,
-            device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].height_offset,
-            to_tile_port, to_side);
-          /* If nothing found, we can continue */
-          if (0 == to_pins.size()) {
-            continue;
-          }
-
-          /* If from port and to port do not match in sizes, error out */
-          if (from_pins.size() != to_pins.size()) {
-            report_direct_from_port_and_to_port_mismatch(
-              vpr_direct, from_tile_port, to_tile_port);
-            exit(1);
-          }
+      /* Bypass the grid that does not fit the from_tile name */
+      if (to_tile_name !=
+          std::string(
+            device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].type->name)) {
+        continue;
+      }
 
-          /* Now add the tile direct */
-          for (size_t ipin = 0; ipin < from_pins.size(); ++ipin) {
-            VTR_LOGV(verbose,
-                     "Built a inner-column/row tile-to-tile direct from "
-                     "%s[%lu][%lu].%s[%lu] at side '%s' to "
-                     "%s[%lu][%lu].%s[%lu] at side '%s'\n",
-                     from_tile_name.c_str(), x, y,
-                     from_tile_port.get_name().c_str(), from_pins[ipin],
-                     SIDE_STRING[from_side], to_tile_name.c_str(),
-                     to_grid_coord.x(), to_grid_coord.y(),
-                     to_tile_port.get_name().c_str(), to_pins[ipin],
-                     SIDE_STRING[to_side]);
-            TileDirectId tile_direct_id = tile_direct.add_direct(
-              from_grid_coord, from_side, from_pins[ipin], to_grid_coord,
-              to_side, to_pins[ipin]);
-            tile_direct.set_arch_direct_id(tile_direct_id, arch_direct_id);
-          }
-        }
+      if (false == find_grid_pin_tile_directs(device_ctx, from_grid_coord,
+                                              from_side, from_pins,
+                                              to_grid_coord, to_tile_port,
+                                              conns)) {
+        return false;
       }
     }
   }
+  return true;
 }
 
 /********************************************************************
@@ -520,11 +597,12 @@ static void build_inner_column_row_tile_direct(
  * Note that: this will only apply to the core grids!
  *            I/Os or any blocks on the border of fabric are NOT supported!
  *
+ * Return false if the from port and to port do not match
  *******************************************************************/
-static void build_inter_column_row_tile_direct(
-  TileDirect& tile_direct, const t_direct_inf& vpr_direct,
-  const DeviceContext& device_ctx, const ArchDirect& arch_direct,
-  const ArchDirectId& arch_direct_id, const bool& verbose) {
+static bool build_inter_column_row_tile_direct(
+  std::vector<t_tile_direct_conn>& conns, const t_direct_inf& vpr_direct,
+  const DeviceContext& device_ctx, const t_tile_type_grid_lookup& grid_lookup,
+  const ArchDirect& arch_direct, const ArchDirectId& arch_direct_id) {
   /* Get the source tile and pin information */
   std::string from_tile_name =
     parse_direct_tile_name(std::string(vpr_direct.from_pin));
@@ -543,8 +621,15 @@ static void build_inter_column_row_tile_direct(
    * connection here */
   if ((INTER_COLUMN != arch_direct.type(arch_direct_id)) &&
       (INTER_ROW != arch_direct.type(arch_direct_id))) {
-    return;
+    return true;
   }
+
+  /* No grid fits the from_tile name */
+  auto from_grid_index = grid_lookup.find(from_tile_name);
+  if (from_grid_index == grid_lookup.end()) {
+    return true;
+  }
+
   /* For cross-column connection, we will search the first valid grid in each
    * column from y = 1 to y = ny
    *
@@ -559,110 +644,7 @@ static void build_inter_column_row_tile_direct(
    *   | Grid |  y=1
    *   +------+
    *
-   */
-  if (INTER_COLUMN == arch_direct.type(arch_direct_id)) {
-    for (size_t ix = 1; ix < device_ctx.grid.width() - 1; ++ix) {
-      std::vector<vtr::Point<size_t>> next_col_src_grid_coords;
-      /* For negative y- direction, we should start from y = ny */
-      for (size_t iy = 1; iy < device_ctx.grid.height() - 1; ++iy) {
-        next_col_src_grid_coords.push_back(vtr::Point<size_t>(ix, iy));
-      }
-      /* For positive y- direction, we should start from y = 1 */
-      if (NEGATIVE_DIR == arch_direct.y_dir(arch_direct_id)) {
-        std::reverse(next_col_src_grid_coords.begin(),
-                     next_col_src_grid_coords.end());
-      }
-
-      /* Bypass the grid that does not fit the from_tile name */
-      vtr::Point<size_t> from_grid_coord = find_grid_coordinate_given_type(
-        device_ctx.grid, next_col_src_grid_coords, from_tile_name);
-      /* Skip if we do not have a valid coordinate for source CLB/heterogeneous
-       * block */
-      if (false == is_grid_coordinate_exist_in_device(device_ctx.grid,
-                                                      from_grid_coord)) {
-        continue;
-      }
-
-      /* Search all the sides, the from pin may locate any side!
-       * Note: the vpr_direct.from_side is NUM_SIDES, which is unintialized
-       * This should be reported to VPR!!!
-       */
-      for (const e_side& from_side : {TOP, RIGHT, BOTTOM, LEFT}) {
-        /* Try to find the pin in this tile */
-        std::vector<size_t> from_pins = find_physical_tile_pin_id(
-          device_ctx.grid[from_grid_coord.x()][from_grid_coord.y()].type,
-          device_ctx.grid[from_grid_coord.x()][from_grid_coord.y()]
-            .width_offset,
-          device_ctx.grid[from_grid_coord.x()][from_grid_coord.y()]
-            .height_offset,
-          from_tile_port, from_side);
-        /* If nothing found, we can continue */
-        if (0 == from_pins.size()) {
-          continue;
-        }
-
-        /* For a valid coordinate, we can find the coordinate of the destination
-         * clb */
-        vtr::Point<size_t> to_grid_coord =
-          find_inter_direct_destination_coordinate(
-            device_ctx.grid, from_grid_coord, to_tile_name, arch_direct,
-            arch_direct_id);
-        /* If destination clb is valid, we should add something */
-        if (false == is_grid_coordinate_exist_in_device(device_ctx.grid,
-                                                        to_grid_coord)) {
-          continue;
-        }
-
-        /* Search all the sides, the to pin may locate any side!
-         * Note: the vpr_direct.to_side is NUM_SIDES, which is unintialized
-         * This should be reported to VPR!!!
-         */
-        for (const e_side& to_side : {TOP, RIGHT, BOTTOM, LEFT}) {
-          /* Try to find the pin in this tile */
-          std::vector<size_t> to_pins = find_physical_tile_pin_id(
-            device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].type,
-            device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].width_offset,
-            device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].height_offset,
-            to_tile_port, to_side);
-          /* If nothing found, we can continue */
-          if (0 == to_pins.size()) {
-            continue;
-          }
-
-          /* If from port and to port do not match in sizes, error out */
-          if (from_pins.size() != to_pins.size()) {
-            report_direct_from_port_and_to_port_mismatch(
-              vpr_direct, from_tile_port, to_tile_port);
-            exit(1);
-          }
-
-          /* Now add the tile direct */
-          for (size_t ipin = 0; ipin < from_pins.size(); ++ipin) {
-            VTR_LOGV(verbose,
-                     "Built a inter-column/row tile-to-tile direct from "
-                     "%s[%lu][%lu].%s[%lu] at side '%s' to "
-                     "%s[%lu][%lu].%s[%lu] at side '%s'\n",
-                     from_tile_name.c_str(), from_grid_coord.x(),
-                     from_grid_coord.y(), from_tile_port.get_name().c_str(),
-                     from_pins[ipin], SIDE_STRING[from_side],
-                     to_tile_name.c_str(), to_grid_coord.x(), to_grid_coord.y(),
-                     to_tile_port.get_name().c_str(), to_pins[ipin],
-                     SIDE_STRING[to_side]);
-
-            TileDirectId tile_direct_id = tile_direct.add_direct(
-              from_grid_coord, from_side, from_pins[ipin], to_grid_coord,
-              to_side, to_pins[ipin]);
-            tile_direct.set_arch_direct_id(tile_direct_id, arch_direct_id);
-          }
-        }
-      }
-    }
-    return; /* Go to next direct type */
-  }
-
-  /* Reach here, it must be a cross-row connection */
-  VTR_ASSERT(INTER_ROW == arch_direct.type(arch_direct_id));
-  /* For cross-row connection, we will search the first valid grid in each
+   * For cross-row connection, we will search the first valid grid in each
    * column from x = 1 to x = nx
    *
    *     x=1                    x=nx
@@ -671,20 +653,17 @@ static void build_inter_column_row_tile_direct(
    *   +------+               +------+
    *
    */
-  for (size_t iy = 1; iy < device_ctx.grid.height() - 1; ++iy) {
-    std::vector<vtr::Point<size_t>> next_col_src_grid_coords;
-    /* For negative x- direction, we should start from x = nx */
-    for (size_t ix = 1; ix < device_ctx.grid.width() - 1; ++ix) {
-      next_col_src_grid_coords.push_back(vtr::Point<size_t>(ix, iy));
-    }
-    /* For positive x- direction, we should start from x = 1 */
-    if (POSITIVE_DIR == arch_direct.x_dir(arch_direct_id)) {
-      std::reverse(next_col_src_grid_coords.begin(),
-                   next_col_src_grid_coords.end());
-    }
-
+  bool search_column = (INTER_COLUMN == arch_direct.type(arch_direct_id));
+  /* For negative y- direction, we should start from y = ny
+   * For positive x- direction, we should start from x = nx */
+  bool reverse = search_column
+                   ? (NEGATIVE_DIR == arch_direct.y_dir(arch_direct_id))
+                   : (POSITIVE_DIR == arch_direct.x_dir(arch_direct_id));
+  size_t num_lines =
+    search_column ? device_ctx.grid.width() : device_ctx.grid.height();
+  for (size_t iline = 1; iline < num_lines - 1; ++iline) {
     vtr::Point<size_t> from_grid_coord = find_grid_coordinate_given_type(
-      device_ctx.grid, next_col_src_grid_coords, from_tile_name);
+      device_ctx.grid, from_grid_index->second, search_column, iline, reverse);
     /* Skip if we do not have a valid coordinate for source CLB/heterogeneous
      * block */
     if (false ==
@@ -711,92 +690,143 @@ static void build_inter_column_row_tile_direct(
       /* For a valid coordinate, we can find the coordinate of the destination
        * clb */
       vtr::Point<size_t> to_grid_coord =
-        find_inter_direct_destination_coordinate(device_ctx.grid,
-                                                 from_grid_coord, to_tile_name,
-                                                 arch_direct, arch_direct_id);
+        find_inter_direct_destination_coordinate(
+          device_ctx.grid, grid_lookup, from_grid_coord, to_tile_name,
+          arch_direct, arch_direct_id);
       /* If destination clb is valid, we should add something */
       if (false ==
           is_grid_coordinate_exist_in_device(device_ctx.grid, to_grid_coord)) {
         continue;
       }
 
-      /* Search all the sides, the to pin may locate any side!
-       * Note: the vpr_direct.to_side is NUM_SIDES, which is unintialized
-       * This should be reported to VPR!!!
-       */
-      for (const e_side& to_side : {TOP, RIGHT, BOTTOM, LEFT}) {
-        /* Try to find the pin in this tile */
-        std::vector<size_t> to_pins = find_physical_tile_pin_id(
-          device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].type,
-          device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].width_offset,
-          device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].height_offset,
-          to_tile_port, to_side);
-        /* If nothing found, we can continue */
-        if (0 == to_pins.size()) {
-          continue;
-        }
-
-        /* If from port and to port do not match in sizes, error out */
-        if (from_pins.size() != to_pins.size()) {
-          report_direct_from_port_and_to_port_mismatch(
-            vpr_direct, from_tile_port, to_tile_port);
-          exit(1);
-        }
-
-        /* Now add the tile direct */
-        for (size_t ipin = 0; ipin < from_pins.size(); ++ipin) {
-          VTR_LOGV(verbose,
-                   "Built a inter-column/row tile-to-tile direct from "
-                   "%s[%lu][%lu].%s[%lu] at side '%s' to %s[%lu][%lu].%s[%lu] "
-                   "at side '%s'\n",
-                   from_tile_name.c_str(), from_grid_coord.x(),
-                   from_grid_coord.y(), from_tile_port.get_name().c_str(),
-                   from_pins[ipin], SIDE_STRING[from_side],
-                   to_tile_name.c_str(), to_grid_coord.x(), to_grid_coord.y(),
-                   to_tile_port.get_name().c_str(), to_pins[ipin],
-                   SIDE_STRING[to_side]);
-
-          TileDirectId tile_direct_id =
-            tile_direct.add_direct(from_grid_coord, from_side, from_pins[ipin],
-                                   to_grid_coord, to_side, to_pins[ipin]);
-          tile_direct.set_arch_direct_id(tile_direct_id, arch_direct_id);
-        }
+      if (false == find_grid_pin_tile_directs(device_ctx, from_grid_coord,
+                                              from_side, from_pins,
+                                              to_grid_coord, to_tile_port,
+                                              conns)) {
+        return false;
       }
     }
   }
+  return true;
+}
+
+/***************************************************************************************
+ * Add the tile-to-tile direct connections found for a direct definition
+ * to the TileDirect
+ ***************************************************************************************/
+static void add_tile_directs(TileDirect& tile_direct,
+                             const std::vector<t_tile_direct_conn>& conns,
+                             const t_direct_inf& vpr_direct,
+                             const ArchDirectId& arch_direct_id,
+                             const char* direct_type_name,
+                             const bool& verbose) {
+  std::string from_tile_name =
+    parse_direct_tile_name(std::string(vpr_direct.from_pin));
+  std::string from_port_name =
+    PortParser(parse_direct_port(std::string(vpr_direct.from_pin)))
+      .port()
+      .get_name();
+  std::string to_tile_name =
+    parse_direct_tile_name(std::string(vpr_direct.to_pin));
+  std::string to_port_name =
+    PortParser(parse_direct_port(std::string(vpr_direct.to_pin)))
+      .port()
+      .get_name();
+
+  for (const t_tile_direct_conn& conn : conns) {
+    VTR_LOGV(verbose,
+             "Built a %s tile-to-tile direct from %s[%lu][%lu].%s[%lu] at side "
+             "'%s' to %s[%lu][%lu].%s[%lu] at side '%s'\n",
+             direct_type_name, from_tile_name.c_str(), conn.from_grid_coord.x(),
+             conn.from_grid_coord.y(), from_port_name.c_str(), conn.from_pin,
+             SIDE_STRING[conn.from_side], to_tile_name.c_str(),
+             conn.to_grid_coord.x(), conn.to_grid_coord.y(),
+             to_port_name.c_str(), conn.to_pin, SIDE_STRING[conn.to_side]);
+    TileDirectId tile_direct_id =
+      tile_direct.add_direct(conn.from_grid_coord, conn.from_side,
+                             conn.from_pin, conn.to_grid_coord, conn.to_side,
+                             conn.to_pin);
+    tile_direct.set_arch_direct_id(tile_direct_id, arch_direct_id);
+  }
+}
+
+/***************************************************************************************
+ * Report the port mismatch of a direct definition and error out
+ ***************************************************************************************/
+static void report_direct_port_mismatch_and_exit(
+  const t_direct_inf& vpr_direct) {
+  report_direct_from_port_and_to_port_mismatch(
+    vpr_direct,
+    PortParser(parse_direct_port(std::string(vpr_direct.from_pin))).port(),
+    PortParser(parse_direct_port(std::string(vpr_direct.to_pin))).port());
+  exit(1);
 }
 
 /***************************************************************************************
  * Top-level functions that build the point-to-point direct connections
  * between tiles (programmable blocks)
+ * The direct definitions are processed in parallel, and their connections
+ * are added to the TileDirect in the order of the definitions
  ***************************************************************************************/
 TileDirect build_device_tile_direct(const DeviceContext& device_ctx,
                                     const ArchDirect& arch_direct,
+                                    const size_t& num_threads,
                                     const bool& verbose) {
   vtr::ScopedStartFinishTimer timer(
     "Build the annotation about direct connection between tiles");
+  OPENFPGA_TRACE_FUNCTION();
 
   TileDirect tile_direct;
 
   /* Walk through each direct definition in the VPR arch */
-  for (int idirect = 0; idirect < device_ctx.arch->num_directs; ++idirect) {
-    ArchDirectId arch_direct_id =
+  size_t num_directs = device_ctx.arch->num_directs;
+  std::vector<ArchDirectId> arch_direct_ids(num_directs);
+  for (size_t idirect = 0; idirect < num_directs; ++idirect) {
+    arch_direct_ids[idirect] =
       arch_direct.direct(std::string(device_ctx.arch->Directs[idirect].name));
-    if (ArchDirectId::INVALID() == arch_direct_id) {
+    if (ArchDirectId::INVALID() == arch_direct_ids[idirect]) {
       VTR_LOG_ERROR(
         "Unable to find an annotation in openfpga architecture XML for "
         "<direct> '%s'!\n",
         device_ctx.arch->Directs[idirect].name);
       exit(1);
     }
+  }
+
+  t_tile_type_grid_lookup grid_lookup =
+    build_tile_type_grid_lookup(device_ctx.grid);
+
+  std::vector<std::vector<t_tile_direct_conn>> inner_conns(num_directs);
+  std::vector<std::vector<t_tile_direct_conn>> inter_conns(num_directs);
+  /* Use char rather than bool to avoid the packed vector<bool> */
+  std::vector<char> inner_status(num_directs, true);
+  std::vector<char> inter_status(num_directs, true);
+  parallel_for_dynamic(num_directs, num_threads, [&](const size_t& idirect) {
     /* Build from original VPR arch definition */
-    build_inner_column_row_tile_direct(tile_direct,
-                                       device_ctx.arch->Directs[idirect],
-                                       device_ctx, arch_direct_id, verbose);
+    inner_status[idirect] = build_inner_column_row_tile_direct(
+      inner_conns[idirect], device_ctx.arch->Directs[idirect], device_ctx,
+      grid_lookup);
+    if (false == bool(inner_status[idirect])) {
+      return;
+    }
     /* Build from OpenFPGA arch definition */
-    build_inter_column_row_tile_direct(
-      tile_direct, device_ctx.arch->Directs[idirect], device_ctx, arch_direct,
-      arch_direct_id, verbose);
+    inter_status[idirect] = build_inter_column_row_tile_direct(
+      inter_conns[idirect], device_ctx.arch->Directs[idirect], device_ctx,
+      grid_lookup, arch_direct, arch_direct_ids[idirect]);
+  });
+
+  for (size_t idirect = 0; idirect < num_directs; ++idirect) {
+    const t_direct_inf& vpr_direct = device_ctx.arch->Directs[idirect];
+    add_tile_directs(tile_direct, inner_conns[idirect], vpr_direct,
+                     arch_direct_ids[idirect], "inner-column/row", verbose);
+    if (false == bool(inner_status[idirect])) {
+      report_direct_port_mismatch_and_exit(vpr_direct);
+    }
+    add_tile_directs(tile_direct, inter_conns[idirect], vpr_direct,
+                     arch_direct_ids[idirect], "inter-column/row", verbose);
+    if (false == bool(inter_status[idirect])) {
+      report_direct_port_mismatch_and_exit(vpr_direct);
+    }
   }
 
   VTR_LOG(
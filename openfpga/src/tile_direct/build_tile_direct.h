@@ -18,6 +18,7 @@ namespace openfpga {
 
 TileDirect build_device_tile_direct(const DeviceContext& device_ctx,
                                     const ArchDirect& arch_direct,
+                                    const size_t& num_threads,
                                     const bool& verbose);
 
 } /* end namespace openfpga */
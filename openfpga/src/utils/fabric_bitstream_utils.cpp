@@ -6,6 +6,8 @@
  ***********************************************************************/
 
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -15,7 +17,9 @@
 /* Headers from openfpgautil library */
 #include "fabric_bitstream_utils.h"
 #include "openfpga_decode.h"
+#include "openfpga_parallel.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
@@ -25,6 +29,9 @@ namespace openfpga {
  *******************************************************************/
 size_t find_fabric_regional_bitstream_max_size(
   const FabricBitstream& fabric_bitstream) {
+  if (true == fabric_bitstream.has_bit_value_stats()) {
+    return fabric_bitstream.region_max_num_bits();
+  }
   size_t regional_bitstream_max_size = 0;
   /* Find the longest regional bitstream */
   for (const auto& region : fabric_bitstream.regions()) {
@@ -55,12 +62,18 @@ size_t find_configuration_chain_fabric_bitstream_size_to_be_skipped(
   size_t num_bits_to_skip = size_t(-1);
   for (const auto& region : fabric_bitstream.regions()) {
     size_t curr_region_num_bits_to_skip = 0;
-    for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
-      if (bit_value_to_skip !=
-          bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
-        break;
+    if (true == fabric_bitstream.has_bit_value_stats()) {
+      curr_region_num_bits_to_skip =
+        fabric_bitstream.region_num_leading_bits_of_value(region,
+                                                          bit_value_to_skip);
+    } else {
+      for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
+        if (bit_value_to_skip !=
+            bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
+          break;
+        }
+        curr_region_num_bits_to_skip++;
       }
-      curr_region_num_bits_to_skip++;
     }
     /* For regional bitstream which is short than the longest region bitstream,
      * The number of bits to skip
@@ -84,35 +97,142 @@ size_t find_configuration_chain_fabric_bitstream_size_to_be_skipped(
  *   Region 1:     00000011010101 <- shorter bitstream than the max.; add zeros
  *to the head Region 2:   0010101111000110 <- shorter bitstream than the max.;
  *add zeros to the head
+ * The aligned bitstream is not built in memory, but is found row by row when
+ *it is visited
  *******************************************************************/
 ConfigChainFabricBitstream build_config_chain_fabric_bitstream_by_region(
   const BitstreamManager& bitstream_manager,
   const FabricBitstream& fabric_bitstream) {
-  /* Find the longest bitstream */
-  size_t regional_bitstream_max_size =
-    find_fabric_regional_bitstream_max_size(fabric_bitstream);
+  return ConfigChainFabricBitstream(bitstream_manager, fabric_bitstream);
+}
 
-  ConfigChainFabricBitstream regional_bitstreams;
-  regional_bitstreams.reserve(fabric_bitstream.regions().size());
-  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
-    std::vector<bool> curr_regional_bitstream;
-    curr_regional_bitstream.resize(regional_bitstream_max_size, false);
-    /* Starting index should consider the offset between the current bitstream
-     * size and the maximum size of regional bitstream
-     */
-    size_t offset =
-      regional_bitstream_max_size - fabric_bitstream.region_bits(region).size();
-    for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
-      curr_regional_bitstream[offset] =
-        bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id));
-      offset++;
+/********************************************************************
+ * Addresses organized by the bitstreams below are packed into integer keys
+ * with 2 bits per address bit, 32 address bits per 64-bit word from the
+ * most significant bit: '0' -> 1, '1' -> 2, 'x' -> 3, while 0 pads the
+ * keys of short addresses. Comparing the words of two keys in sequence is
+ * the same as comparing the two address strings, so that sorting the keys
+ * gives the same sequence as a std::map on the strings.
+ *******************************************************************/
+static size_t find_address_key_stride(const size_t& addr_len) {
+  return (addr_len + 31) / 32;
+}
+
+static void encode_address_key(const std::vector<char>& addr,
+                               std::vector<uint64_t>& keys,
+                               const size_t& offset) {
+  for (size_t ibit = 0; ibit < addr.size(); ++ibit) {
+    uint64_t code = 3;
+    if ('0' == addr[ibit]) {
+      code = 1;
+    } else if ('1' == addr[ibit]) {
+      code = 2;
+    }
+    keys[offset + ibit / 32] |= code << (62 - 2 * (ibit % 32));
+  }
+}
+
+/* Reverse the lowest 32 bits of a word */
+static uint64_t reverse_address_key_bits(uint64_t bits) {
+  bits = ((bits >> 1) & 0x55555555ULL) | ((bits & 0x55555555ULL) << 1);
+  bits = ((bits >> 2) & 0x33333333ULL) | ((bits & 0x33333333ULL) << 2);
+  bits = ((bits >> 4) & 0x0f0f0f0fULL) | ((bits & 0x0f0f0f0fULL) << 4);
+  bits = ((bits >> 8) & 0x00ff00ffULL) | ((bits & 0x00ff00ffULL) << 8);
+  bits = ((bits >> 16) & 0x0000ffffULL) | ((bits & 0x0000ffffULL) << 16);
+  return bits;
+}
+
+/* Move bit i of the lowest 32 bits of a word to bit 2i */
+static uint64_t spread_address_key_bits(uint64_t bits) {
+  bits = (bits | (bits << 16)) & 0x0000ffff0000ffffULL;
+  bits = (bits | (bits << 8)) & 0x00ff00ff00ff00ffULL;
+  bits = (bits | (bits << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  bits = (bits | (bits << 2)) & 0x3333333333333333ULL;
+  bits = (bits | (bits << 1)) & 0x5555555555555555ULL;
+  return bits;
+}
+
+/* Same as encode_address_key() but from the words of an address, see
+ * FabricBitstream::bit_address_words(), so that the 32 bits of a key word
+ * are encoded together: the high bit of a code is set for '1' and 'x' while
+ * the low bit is set for '0' and 'x' */
+static void encode_address_key_words(const std::vector<uint64_t>& words_1,
+                                     const std::vector<uint64_t>& words_x,
+                                     const size_t& addr_len,
+                                     std::vector<uint64_t>& keys,
+                                     const size_t& offset) {
+  for (size_t ikey = 0; 32 * ikey < addr_len; ++ikey) {
+    size_t num_bits = std::min(size_t(32), addr_len - 32 * ikey);
+    uint64_t valid_bits = (uint64_t(1) << num_bits) - 1;
+    size_t shift = 32 * (ikey % 2);
+    uint64_t bits_1 = (words_1[ikey / 2] >> shift) & 0xffffffffULL;
+    uint64_t bits_x = 0;
+    if (false == words_x.empty()) {
+      bits_x = (words_x[ikey / 2] >> shift) & 0xffffffffULL;
     }
-    VTR_ASSERT(offset == regional_bitstream_max_size);
+    uint64_t high_bits = (bits_1 | bits_x) & valid_bits;
+    uint64_t low_bits = (~bits_1 | bits_x) & valid_bits;
+    keys[offset + ikey] |=
+      (spread_address_key_bits(reverse_address_key_bits(high_bits)) << 1) |
+      spread_address_key_bits(reverse_address_key_bits(low_bits));
+  }
+}
 
-    /* Add the adapt sub-bitstream */
-    regional_bitstreams.push_back(curr_regional_bitstream);
+static std::string decode_address_key(const uint64_t* key,
+                                      const size_t& stride) {
+  std::string addr;
+  for (size_t ibit = 0; ibit < stride * 32; ++ibit) {
+    uint64_t code = (key[ibit / 32] >> (62 - 2 * (ibit % 32))) & 3;
+    if (0 == code) {
+      break;
+    }
+    addr.push_back(1 == code ? '0' : (2 == code ? '1' : DONT_CARE_CHAR));
+  }
+  return addr;
+}
+
+/********************************************************************
+ * Sort the entries (a packed address key, a region and a data input each)
+ * by their keys and merge the entries with the same key into a row, whose
+ * data inputs are indexed by regions and default to '0'.
+ * Entries with the same key keep their sequence, so that a later entry
+ * overwrites an earlier one of the same region, as the map insertion did.
+ * The rows are reported in the sequence of keys
+ *******************************************************************/
+static void merge_address_keys(
+  const std::vector<uint64_t>& keys, const size_t& stride,
+  const std::vector<FabricBitRegionId>& regions, const std::vector<bool>& dins,
+  const size_t& num_regions,
+  const std::function<void(const uint64_t*, std::vector<bool>&&)>& add_row) {
+  std::vector<size_t> entries(regions.size());
+  for (size_t ientry = 0; ientry < entries.size(); ++ientry) {
+    entries[ientry] = ientry;
+  }
+  auto key_begin = [&](const size_t& ientry) {
+    return keys.begin() + ientry * stride;
+  };
+  std::stable_sort(entries.begin(), entries.end(),
+                   [&](const size_t& lhs, const size_t& rhs) {
+                     return std::lexicographical_compare(
+                       key_begin(lhs), key_begin(lhs) + stride, key_begin(rhs),
+                       key_begin(rhs) + stride);
+                   });
+
+  size_t group_start = 0;
+  while (group_start < entries.size()) {
+    std::vector<bool> row_dins(num_regions, false);
+    size_t group_end = group_start;
+    while ((group_end < entries.size()) &&
+           std::equal(key_begin(entries[group_start]),
+                      key_begin(entries[group_start]) + stride,
+                      key_begin(entries[group_end]))) {
+      row_dins[size_t(regions[entries[group_end]])] =
+        dins[entries[group_end]];
+      group_end++;
+    }
+    add_row(&keys[entries[group_start] * stride], std::move(row_dins));
+    group_start = group_end;
   }
-  return regional_bitstreams;
 }
 
 /********************************************************************
@@ -122,44 +242,77 @@ ConfigChainFabricBitstream build_config_chain_fabric_bitstream_by_region(
  *region. Template: <address> <din_values_from_different_regions> An example:
  *   000000 1011
  *
- * Note: the std::map may cause large memory footprint for large bitstream
- *databases!
+ * The addresses are packed into integer keys, which are sorted and merged
+ * rather than inserted into a map one bit after another
  *******************************************************************/
 FrameFabricBitstream build_frame_based_fabric_bitstream_by_address(
   const FabricBitstream& fabric_bitstream) {
-  FrameFabricBitstream fabric_bits_by_addr;
+  size_t stride = find_address_key_stride(fabric_bitstream.address_length());
+
+  std::vector<uint64_t> keys;
+  std::vector<FabricBitRegionId> regions;
+  std::vector<bool> dins;
+  keys.reserve(fabric_bitstream.num_bits() * stride);
+  regions.reserve(fabric_bitstream.num_bits());
+  dins.reserve(fabric_bitstream.num_bits());
+  auto add_entry = [&](const std::vector<char>& addr,
+                       const FabricBitRegionId& region, const bool& din) {
+    keys.resize(keys.size() + stride, 0);
+    encode_address_key(addr, keys, keys.size() - stride);
+    regions.push_back(region);
+    dins.push_back(din);
+  };
+
+  std::vector<uint64_t> words_1;
+  std::vector<uint64_t> words_x;
   for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
     for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
-      /* Create string for address */
-      std::string addr_str;
-      for (const char& addr_bit : fabric_bitstream.bit_address(bit_id)) {
-        addr_str.push_back(addr_bit);
+      bool din = fabric_bitstream.bit_din(bit_id);
+      /* Addresses without don't care bits are encoded from their words */
+      size_t addr_len =
+        fabric_bitstream.bit_address_words(bit_id, words_1, words_x);
+      if (words_x.end() == std::find_if(words_x.begin(), words_x.end(),
+                                        [](const uint64_t& word) {
+                                          return 0 != word;
+                                        })) {
+        keys.resize(keys.size() + stride, 0);
+        encode_address_key_words(words_1, words_x, addr_len, keys,
+                                 keys.size() - stride);
+        regions.push_back(region);
+        dins.push_back(din);
+        continue;
       }
-
+      std::vector<char> addr = fabric_bitstream.bit_address(bit_id);
       /* Expand all the don't care bits */
       for (const std::string& curr_addr_str :
-           expand_dont_care_bin_str(addr_str)) {
-        /* Place the config bit */
-        auto result = fabric_bits_by_addr.find(curr_addr_str);
-        if (result == fabric_bits_by_addr.end()) {
-          /* This is a new bit, resize the vector to the number of regions
-           * and deposit '0' to all the bits
-           */
-          fabric_bits_by_addr[curr_addr_str] =
-            std::vector<bool>(fabric_bitstream.regions().size(), false);
-          fabric_bits_by_addr[curr_addr_str][size_t(region)] =
-            fabric_bitstream.bit_din(bit_id);
-        } else {
-          VTR_ASSERT_SAFE(result != fabric_bits_by_addr.end());
-          result->second[size_t(region)] = fabric_bitstream.bit_din(bit_id);
-        }
+           expand_dont_care_bin_str(std::string(addr.begin(), addr.end()))) {
+        add_entry(std::vector<char>(curr_addr_str.begin(), curr_addr_str.end()),
+                  region, din);
       }
     }
   }
 
+  FrameFabricBitstream fabric_bits_by_addr;
+  merge_address_keys(keys, stride, regions, dins,
+                     fabric_bitstream.regions().size(),
+                     [&](const uint64_t* key, std::vector<bool>&& row_dins) {
+                       fabric_bits_by_addr.emplace_back(
+                         decode_address_key(key, stride), std::move(row_dins));
+                     });
+
   return fabric_bits_by_addr;
 }
 
+/********************************************************************
+ * Identify if all the data input bits of an address, i.e., one from each
+ * region, are in the given value. The search stops at the first bit in
+ * the other value, and no temporary vector is created for the comparison
+ *******************************************************************/
+bool is_fabric_din_all_of_value(const std::vector<bool>& din,
+                                const bool& bit_value) {
+  return din.end() == std::find(din.begin(), din.end(), !bit_value);
+}
+
 /********************************************************************
  * For fast configuration, the number of bits to be skipped
  * the rule to skip any configuration bit should consider the whole data input
@@ -177,21 +330,21 @@ FrameFabricBitstream build_frame_based_fabric_bitstream_by_address(
  *******************************************************************/
 size_t find_frame_based_fast_configuration_fabric_bitstream_size(
   const FabricBitstream& fabric_bitstream, const bool& bit_value_to_skip) {
-  FrameFabricBitstream fabric_bits_by_addr =
-    build_frame_based_fabric_bitstream_by_address(fabric_bitstream);
+  return find_frame_based_fast_configuration_fabric_bitstream_size(
+    build_frame_based_fabric_bitstream_by_address(fabric_bitstream),
+    bit_value_to_skip);
+}
 
+/* Same as above, but reuse a bitstream which is already organized by
+ * addresses, so that callers which need both sizes build it only once */
+size_t find_frame_based_fast_configuration_fabric_bitstream_size(
+  const FrameFabricBitstream& fabric_bits_by_addr,
+  const bool& bit_value_to_skip) {
   size_t num_bits = 0;
 
   for (const auto& addr_din_pair : fabric_bits_by_addr) {
-    bool skip_curr_bits = true;
-    for (const bool& bit : addr_din_pair.second) {
-      if (bit_value_to_skip != bit) {
-        skip_curr_bits = false;
-        break;
-      }
-    }
-
-    if (false == skip_curr_bits) {
+    if (false ==
+        is_fabric_din_all_of_value(addr_din_pair.second, bit_value_to_skip)) {
       num_bits++;
     }
   }
@@ -199,6 +352,67 @@ size_t find_frame_based_fast_configuration_fabric_bitstream_size(
   return num_bits;
 }
 
+/********************************************************************
+ * Find the number of writes to program a frame-based bitstream, if a write
+ * could carry an address mask and program all the addresses matching the
+ * mask with the same data inputs, i.e., a multicast.
+ * The addresses with the same data inputs are merged into masked addresses
+ * where masked bits are don't care bits, e.g., 0100 and 0110 into 01x0,
+ * until no pair of masked addresses differs in a single bit. Each masked
+ * address covers exactly the addresses of its data inputs, so that the
+ * merging is greedy but always safe. The rows skipped by fast configuration
+ * are not written
+ *******************************************************************/
+size_t find_frame_based_multicast_fabric_bitstream_size(
+  const FrameFabricBitstream& fabric_bits_by_addr,
+  const bool& fast_configuration, const bool& bit_value_to_skip) {
+  /* Group the addresses by their data inputs */
+  std::unordered_map<std::vector<bool>, std::vector<std::string>> addr_groups;
+  for (const auto& addr_din_pair : fabric_bits_by_addr) {
+    if ((true == fast_configuration) &&
+        (true ==
+         is_fabric_din_all_of_value(addr_din_pair.second, bit_value_to_skip))) {
+      continue;
+    }
+    addr_groups[addr_din_pair.second].push_back(addr_din_pair.first);
+  }
+
+  size_t num_writes = 0;
+  for (auto& addr_group : addr_groups) {
+    std::vector<std::string>& masked_addrs = addr_group.second;
+    bool merged = true;
+    while (true == merged) {
+      merged = false;
+      std::unordered_set<std::string> unused_addrs(masked_addrs.begin(),
+                                                   masked_addrs.end());
+      std::vector<std::string> next_masked_addrs;
+      for (const std::string& addr : masked_addrs) {
+        if (0 == unused_addrs.erase(addr)) {
+          continue;
+        }
+        std::string merged_addr = addr;
+        for (size_t ibit = 0; ibit < addr.size(); ++ibit) {
+          if (DONT_CARE_CHAR == addr[ibit]) {
+            continue;
+          }
+          std::string partner = addr;
+          partner[ibit] = ('0' == addr[ibit]) ? '1' : '0';
+          if (1 == unused_addrs.erase(partner)) {
+            merged_addr[ibit] = DONT_CARE_CHAR;
+            merged = true;
+            break;
+          }
+        }
+        next_masked_addrs.push_back(merged_addr);
+      }
+      masked_addrs.swap(next_masked_addrs);
+    }
+    num_writes += masked_addrs.size();
+  }
+
+  return num_writes;
+}
+
 /********************************************************************
  * Reorganize the fabric bitstream for memory banks which use BL and WL decoders
  * by the same address across regions:
@@ -206,73 +420,59 @@ size_t find_frame_based_fast_configuration_fabric_bitstream_size(
  *region. Template: <bl_address> <wl_address>
  *<din_values_from_different_regions> An example: 000000  00000 1011
  *
- * Note: the std::map may cause large memory footprint for large bitstream
- *databases!
+ * The key of a bit packs its BL address followed by its WL address, so that
+ * the keys are sorted by BL addresses first, as the (BL, WL) pairs of a map
  *******************************************************************/
 MemoryBankFabricBitstream build_memory_bank_fabric_bitstream_by_address(
   const FabricBitstream& fabric_bitstream) {
-  MemoryBankFabricBitstream fabric_bits_by_addr;
+  size_t bl_stride =
+    find_address_key_stride(fabric_bitstream.address_length());
+  size_t wl_stride =
+    find_address_key_stride(fabric_bitstream.wl_address_length());
+  size_t stride = bl_stride + wl_stride;
+
+  std::vector<uint64_t> keys(fabric_bitstream.num_bits() * stride, 0);
+  std::vector<FabricBitRegionId> regions;
+  std::vector<bool> dins;
+  regions.reserve(fabric_bitstream.num_bits());
+  dins.reserve(fabric_bitstream.num_bits());
+  std::vector<uint64_t> words_1;
+  std::vector<uint64_t> words_x;
   for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
     for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
-      /* Create string for BL address */
-      std::string bl_addr_str;
-      for (const char& addr_bit : fabric_bitstream.bit_bl_address(bit_id)) {
-        bl_addr_str.push_back(addr_bit);
-      }
-
-      /* Create string for WL address */
-      std::string wl_addr_str;
-      for (const char& addr_bit : fabric_bitstream.bit_wl_address(bit_id)) {
-        wl_addr_str.push_back(addr_bit);
-      }
-
-      /* Place the config bit */
-      auto result =
-        fabric_bits_by_addr.find(std::make_pair(bl_addr_str, wl_addr_str));
-      if (result == fabric_bits_by_addr.end()) {
-        /* This is a new bit, resize the vector to the number of regions
-         * and deposit '0' to all the bits
-         */
-        fabric_bits_by_addr[std::make_pair(bl_addr_str, wl_addr_str)] =
-          std::vector<bool>(fabric_bitstream.regions().size(), false);
-        fabric_bits_by_addr[std::make_pair(bl_addr_str, wl_addr_str)]
-                           [size_t(region)] = fabric_bitstream.bit_din(bit_id);
-      } else {
-        VTR_ASSERT_SAFE(result != fabric_bits_by_addr.end());
-        result->second[size_t(region)] = fabric_bitstream.bit_din(bit_id);
-      }
+      size_t offset = regions.size() * stride;
+      size_t bl_len =
+        fabric_bitstream.bit_bl_address_words(bit_id, words_1, words_x);
+      encode_address_key_words(words_1, words_x, bl_len, keys, offset);
+      size_t wl_len =
+        fabric_bitstream.bit_wl_address_words(bit_id, words_1, words_x);
+      encode_address_key_words(words_1, words_x, wl_len, keys,
+                               offset + bl_stride);
+      regions.push_back(region);
+      dins.push_back(fabric_bitstream.bit_din(bit_id));
     }
   }
+  /* Bits which are not in any region are not organized */
+  keys.resize(regions.size() * stride);
+
+  MemoryBankFabricBitstream fabric_bits_by_addr;
+  merge_address_keys(
+    keys, stride, regions, dins, fabric_bitstream.regions().size(),
+    [&](const uint64_t* key, std::vector<bool>&& row_dins) {
+      fabric_bits_by_addr.emplace_back(
+        std::make_pair(decode_address_key(key, bl_stride),
+                       decode_address_key(key + bl_stride, wl_stride)),
+        std::move(row_dins));
+    });
 
   return fabric_bits_by_addr;
 }
 
 MemoryBankFlattenFabricBitstream build_memory_bank_flatten_fabric_bitstream(
-  const FabricBitstream& fabric_bitstream, const bool& fast_configuration,
+  const FabricBitstream& fabric_bitstream, const bool& /* fast_configuration */,
   const bool& bit_value_to_skip, const char& dont_care_bit) {
-  /* If fast configuration is not enabled, we need all the wl address even some
-   * of them have all-dont-care-bits BLs */
-  if (!fast_configuration) {
-    vtr::vector<FabricBitRegionId, std::map<std::string, std::string>>
-      fabric_bits_per_region;
-    fabric_bits_per_region.resize(fabric_bitstream.num_regions());
-    for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
-      for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
-        /* Create string for BL address with complete don't care bits */
-        std::string bl_addr_str(fabric_bitstream.bit_bl_address(bit_id).size(),
-                                dont_care_bit);
-
-        /* Create string for WL address */
-        std::string wl_addr_str;
-        for (const char& addr_bit : fabric_bitstream.bit_wl_address(bit_id)) {
-          wl_addr_str.push_back(addr_bit);
-        }
-
-        /* Deposit the config bit */
-        fabric_bits_per_region[region][wl_addr_str] = bl_addr_str;
-      }
-    }
-  }
+  /* Note that all the WL addresses are kept even when fast configuration is
+   * enabled, as the BLs to be skipped are only converted to zeros */
 
   /* Build the bitstream by each region, here we use (WL, BL) pairs when storing
    * bitstreams */
@@ -309,25 +509,11 @@ MemoryBankFlattenFabricBitstream build_memory_bank_flatten_fabric_bitstream(
     }
   }
 
-  /* Find all the keys for the hash tables containing bitstream of each region
-   */
-  vtr::vector<FabricBitRegionId, std::vector<std::string>>
-    fabric_bits_per_region_keys;
-  fabric_bits_per_region_keys.resize(fabric_bitstream.num_regions());
-  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
-    /* Pre-allocate memory, because the key size may be large */
-    fabric_bits_per_region_keys[region].reserve(
-      fabric_bits_per_region[region].size());
-    for (const auto& pair : fabric_bits_per_region[region]) {
-      fabric_bits_per_region_keys[region].push_back(pair.first);
-    }
-  }
-
   /* Find the maxium key size */
   size_t max_key_size = 0;
   for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
     max_key_size =
-      std::max(max_key_size, fabric_bits_per_region_keys[region].size());
+      std::max(max_key_size, fabric_bits_per_region[region].size());
   }
 
   /* Find the BL/WL sizes per region; Pair convention is (BL, WL)
@@ -347,7 +533,10 @@ MemoryBankFlattenFabricBitstream build_memory_bank_flatten_fabric_bitstream(
   }
 
   /* Combine the bitstream from different region into a unique one. Now we
-   * follow the convention: use (WL, BL) pairs */
+   * follow the convention: use (WL, BL) pairs
+   * The bitstream of each region is visited in the sequence of WL addresses,
+   * and each (WL, BL) pair is released once it is added to the final
+   * bitstream, so that the bitstream is not duplicated in memory */
   MemoryBankFlattenFabricBitstream fabric_bits;
   for (size_t ikey = 0; ikey < max_key_size; ikey++) {
     /* Prepare the final BL/WL vectors to be added to the bitstream database */
@@ -359,10 +548,11 @@ MemoryBankFlattenFabricBitstream build_memory_bank_flatten_fabric_bitstream(
        * bound for the key list in this region, we append an all-'x' string for
        * both BL and WLs
        */
-      if (ikey < fabric_bits_per_region_keys[region].size()) {
-        cur_wl_vectors.push_back(fabric_bits_per_region_keys[region][ikey]);
-        cur_bl_vectors.push_back(fabric_bits_per_region[region].at(
-          fabric_bits_per_region_keys[region][ikey]));
+      if (!fabric_bits_per_region[region].empty()) {
+        auto first_pair = fabric_bits_per_region[region].begin();
+        cur_wl_vectors.push_back(first_pair->first);
+        cur_bl_vectors.push_back(std::move(first_pair->second));
+        fabric_bits_per_region[region].erase(first_pair);
       } else {
         cur_wl_vectors.push_back(
           std::string(max_blwl_sizes_per_region[region].second, dont_care_bit));
@@ -377,220 +567,225 @@ MemoryBankFlattenFabricBitstream build_memory_bank_flatten_fabric_bitstream(
   return fabric_bits;
 }
 
-/********************************************************************
- * Reshape a list of vectors by aligning all of them to the first element
- * For example:
- * - Align vectors to the last element
- *
- *   index ---------------------->
- *   vector 0: 000000001111101010
- *   vector 1:     00000011010101
- *   vector 2:   0010101111000110
- *
- * - Fill void in each vector with desired bits (Here assume fill 'x'
- *   index ---------------------->
- *   vector 0: 000000001111101010
- *   vector 1: 00000011010101xxxx
- *   vector 2: 0010101111000110xx
- *
- * - Rotate the array by 90 degree
- *   index ----------------------->
- *   vector 0: 000
- *   vector 1: 000
- *   vector 2: 001
- *   ...
- *   vector N: 0xx
- *
- *******************************************************************/
-static std::vector<std::string> reshape_bitstream_vectors_to_first_element(
-  const std::vector<std::string>& bitstream_vectors,
-  const char& default_bit_to_fill) {
-  /* Find the max sizes of BL bits, this determines the size of shift register
-   * chain */
-  size_t max_vec_size = 0;
-  for (const auto& vec : bitstream_vectors) {
-    max_vec_size = std::max(max_vec_size, vec.size());
-  }
-  /* Reshape the BL vectors */
-  std::vector<std::string> reshaped_vectors(bitstream_vectors.size(),
-                                            std::string());
-  size_t col_cnt = 0;
-  for (const auto& vec : bitstream_vectors) {
-    reshaped_vectors[col_cnt] += vec;
-    reshaped_vectors[col_cnt] +=
-      std::string(max_vec_size - vec.size(), default_bit_to_fill);
-    col_cnt++;
+size_t find_memory_bank_flatten_fabric_bitstream_size(
+  const FabricBitstream& fabric_bitstream) {
+  size_t max_key_size = 0;
+  for (const size_t& region_size :
+       find_memory_bank_regional_flatten_fabric_bitstream_sizes(
+         fabric_bitstream)) {
+    max_key_size = std::max(max_key_size, region_size);
   }
+  return max_key_size;
+}
 
-  /* Add the BL word to final bitstream */
-  std::vector<std::string> rotated_vectors;
-  for (size_t irow = 0; irow < max_vec_size; ++irow) {
-    std::string cur_vec;
-    for (size_t icol = 0; icol < reshaped_vectors.size(); ++icol) {
-      cur_vec.push_back(reshaped_vectors[icol][irow]);
+std::vector<size_t> find_memory_bank_regional_flatten_fabric_bitstream_sizes(
+  const FabricBitstream& fabric_bitstream) {
+  std::vector<size_t> region_sizes;
+  region_sizes.reserve(fabric_bitstream.num_regions());
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    std::unordered_set<std::string> wl_addr_strs;
+    for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
+      std::vector<char> wl_addr = fabric_bitstream.bit_wl_address(bit_id);
+      wl_addr_strs.insert(std::string(wl_addr.begin(), wl_addr.end()));
     }
-    rotated_vectors.push_back(cur_vec);
+    region_sizes.push_back(wl_addr_strs.size());
   }
-
-  return rotated_vectors;
+  return region_sizes;
 }
 
-/** @brief Split each BL vector in a configuration region into multiple shift
- * register banks For example Original vector: 1xxx010xxx1 Resulting vector (2
- * register register banks): 1xxx0 10xxx1
- */
-static std::vector<std::string> redistribute_bl_vectors_to_shift_register_banks(
-  const std::vector<std::string> bl_vectors,
-  const MemoryBankShiftRegisterBanks& blwl_sr_banks,
-  const char& dont_care_bit) {
-  std::vector<std::string> multi_bank_bl_vec;
-
-  /* Resize the vector by counting the dimension */
-  /* Compute the start index of each region */
-  vtr::vector<ConfigRegionId, size_t> region_start_index;
-  region_start_index.resize(blwl_sr_banks.regions().size(), 0);
-  size_t total_num_banks = 0;
-  for (const auto& region : blwl_sr_banks.regions()) {
-    region_start_index[region] = total_num_banks;
-    total_num_banks += blwl_sr_banks.bl_banks(region).size();
-  }
-  multi_bank_bl_vec.resize(total_num_banks);
+/* Position of each BL/WL in shift register banks:
+ * [region][BL/WL index] -> (index of the bank among the banks of all the
+ * regions, offset of the data line in the bank) */
+typedef vtr::vector<ConfigRegionId, std::vector<std::pair<size_t, size_t>>>
+  ShiftRegisterBankPositions;
 
-  /* Resize each bank to be memory efficient */
-  size_t vec_start_index = 0;
+/********************************************************************
+ * Find the position of each BL in the shift register banks
+ * The positions only depend on the fabric, so that they are found once
+ * rather than for every bit of every word of the bitstream
+ *******************************************************************/
+static ShiftRegisterBankPositions find_bl_shift_register_bank_positions(
+  const MemoryBankShiftRegisterBanks& blwl_sr_banks, size_t& num_banks,
+  size_t& max_bank_size) {
+  ShiftRegisterBankPositions positions;
+  positions.resize(blwl_sr_banks.regions().size());
+  num_banks = 0;
+  max_bank_size = 0;
   for (const auto& region : blwl_sr_banks.regions()) {
     for (const auto& bank : blwl_sr_banks.bl_banks(region)) {
-      size_t bank_size = blwl_sr_banks.bl_bank_size(region, bank);
-      multi_bank_bl_vec[vec_start_index].resize(bank_size, dont_care_bit);
-      vec_start_index++;
-    }
-  }
-
-  for (const std::string& region_bl_vec : bl_vectors) {
-    ConfigRegionId region = ConfigRegionId(&region_bl_vec - &bl_vectors[0]);
-    for (size_t ibit = 0; ibit < region_bl_vec.size(); ++ibit) {
-      /* Find the shift register bank id and the offset in data lines */
-      BasicPort bl_port(std::string(MEMORY_BL_PORT_NAME), ibit, ibit);
-      FabricBitLineBankId bank_id =
-        blwl_sr_banks.find_bl_shift_register_bank_id(region, bl_port);
-      BasicPort sr_port =
-        blwl_sr_banks.find_bl_shift_register_bank_data_port(region, bl_port);
-      VTR_ASSERT(1 == sr_port.get_width());
-
-      size_t vec_index = region_start_index[region] + size_t(bank_id);
-      multi_bank_bl_vec[vec_index][sr_port.get_lsb()] = region_bl_vec[ibit];
+      size_t offset = 0;
+      for (const BasicPort& port :
+           blwl_sr_banks.bl_bank_data_ports(region, bank)) {
+        for (const size_t& bl_index : port.pins()) {
+          if (bl_index >= positions[region].size()) {
+            positions[region].resize(bl_index + 1,
+                                     std::make_pair(size_t(-1), size_t(-1)));
+          }
+          positions[region][bl_index] = std::make_pair(num_banks, offset);
+          offset++;
+        }
+      }
+      max_bank_size =
+        std::max(max_bank_size, blwl_sr_banks.bl_bank_size(region, bank));
+      num_banks++;
     }
   }
-
-  return multi_bank_bl_vec;
+  return positions;
 }
 
-/** @brief Split each WL vector in a configuration region into multiple shift
- * register banks For example Original vector: 1xxx010xxx1 Resulting vector (2
- * register register banks): 1xxx0 10xxx1
- */
-static std::vector<std::string> redistribute_wl_vectors_to_shift_register_banks(
-  const std::vector<std::string> wl_vectors,
-  const MemoryBankShiftRegisterBanks& blwl_sr_banks,
-  const char& dont_care_bit) {
-  std::vector<std::string> multi_bank_wl_vec;
-
-  /* Resize the vector by counting the dimension */
-  /* Compute the start index of each region */
-  vtr::vector<ConfigRegionId, size_t> region_start_index;
-  region_start_index.resize(blwl_sr_banks.regions().size(), 0);
-  size_t total_num_banks = 0;
-  for (const auto& region : blwl_sr_banks.regions()) {
-    region_start_index[region] = total_num_banks;
-    total_num_banks += blwl_sr_banks.wl_banks(region).size();
-  }
-  multi_bank_wl_vec.resize(total_num_banks);
-
-  /* Resize each bank to be memory efficient */
-  size_t vec_start_index = 0;
+/********************************************************************
+ * Find the position of each WL in the shift register banks
+ * Same principle as the find_bl_shift_register_bank_positions()
+ *******************************************************************/
+static ShiftRegisterBankPositions find_wl_shift_register_bank_positions(
+  const MemoryBankShiftRegisterBanks& blwl_sr_banks, size_t& num_banks,
+  size_t& max_bank_size) {
+  ShiftRegisterBankPositions positions;
+  positions.resize(blwl_sr_banks.regions().size());
+  num_banks = 0;
+  max_bank_size = 0;
   for (const auto& region : blwl_sr_banks.regions()) {
     for (const auto& bank : blwl_sr_banks.wl_banks(region)) {
-      size_t bank_size = blwl_sr_banks.wl_bank_size(region, bank);
-      multi_bank_wl_vec[vec_start_index].resize(bank_size, dont_care_bit);
-      vec_start_index++;
+      size_t offset = 0;
+      for (const BasicPort& port :
+           blwl_sr_banks.wl_bank_data_ports(region, bank)) {
+        for (const size_t& wl_index : port.pins()) {
+          if (wl_index >= positions[region].size()) {
+            positions[region].resize(wl_index + 1,
+                                     std::make_pair(size_t(-1), size_t(-1)));
+          }
+          positions[region][wl_index] = std::make_pair(num_banks, offset);
+          offset++;
+        }
+      }
+      max_bank_size =
+        std::max(max_bank_size, blwl_sr_banks.wl_bank_size(region, bank));
+      num_banks++;
     }
   }
+  return positions;
+}
 
-  for (const std::string& region_wl_vec : wl_vectors) {
-    ConfigRegionId region = ConfigRegionId(&region_wl_vec - &wl_vectors[0]);
-    for (size_t ibit = 0; ibit < region_wl_vec.size(); ++ibit) {
-      /* Find the shift register bank id and the offset in data lines */
-      BasicPort wl_port(std::string(MEMORY_WL_PORT_NAME), ibit, ibit);
-      FabricWordLineBankId bank_id =
-        blwl_sr_banks.find_wl_shift_register_bank_id(region, wl_port);
-      BasicPort sr_port =
-        blwl_sr_banks.find_wl_shift_register_bank_data_port(region, wl_port);
-      VTR_ASSERT(1 == sr_port.get_width());
-
-      size_t vec_index = region_start_index[region] + size_t(bank_id);
-      multi_bank_wl_vec[vec_index][sr_port.get_lsb()] = region_wl_vec[ibit];
+/********************************************************************
+ * Split the BL (or WL) vector of each configuration region into the shift
+ * register banks, and rotate the banks so that each vector holds one bit
+ * of every bank, which can be loaded through the heads in parallel.
+ * For example, with 3 banks
+ *   bank 0: 000000001111101010
+ *   bank 1: 00000011010101
+ *   bank 2: 0010101111000110
+ *
+ * - Fill void in each bank with desired bits (Here assume fill 'x'
+ *   bank 0: 000000001111101010
+ *   bank 1: 00000011010101xxxx
+ *   bank 2: 0010101111000110xx
+ *
+ * - Rotate the array by 90 degree
+ *   vector 0: 000
+ *   vector 1: 000
+ *   vector 2: 001
+ *   ...
+ *   vector N: 0xx
+ *
+ * - Reverse the vectors due to the shift register chain nature: first-in
+ *   first-out
+ *
+ * Each bit is written to its place in the rotated vectors directly
+ *******************************************************************/
+static std::vector<std::string> build_shift_register_bank_vectors(
+  const std::vector<std::string>& region_vectors,
+  const ShiftRegisterBankPositions& positions, const size_t& num_banks,
+  const size_t& max_bank_size, const char& dont_care_bit) {
+  std::vector<std::string> bank_vectors(max_bank_size,
+                                        std::string(num_banks, dont_care_bit));
+  for (size_t iregion = 0; iregion < region_vectors.size(); ++iregion) {
+    const std::string& region_vec = region_vectors[iregion];
+    const std::vector<std::pair<size_t, size_t>>& region_positions =
+      positions[ConfigRegionId(iregion)];
+    VTR_ASSERT(region_vec.size() <= region_positions.size());
+    for (size_t ibit = 0; ibit < region_vec.size(); ++ibit) {
+      const std::pair<size_t, size_t>& position = region_positions[ibit];
+      VTR_ASSERT(size_t(-1) != position.first);
+      bank_vectors[max_bank_size - 1 - position.second][position.first] =
+        region_vec[ibit];
     }
   }
-
-  return multi_bank_wl_vec;
+  return bank_vectors;
 }
 
+/********************************************************************
+ * Words are independent from each other, which are built with a number of
+ * threads. The resulting bitstream does not depend on the number of threads
+ *******************************************************************/
 MemoryBankShiftRegisterFabricBitstream
 build_memory_bank_shift_register_fabric_bitstream(
   const FabricBitstream& fabric_bitstream,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks,
   const bool& fast_configuration, const bool& bit_value_to_skip,
-  const char& dont_care_bit) {
+  const char& dont_care_bit, const size_t& num_threads) {
   vtr::ScopedStartFinishTimer timer(
     "Reshape fabric bitstream for memory bank using shift registers");
+  OPENFPGA_TRACE_FUNCTION();
   MemoryBankFlattenFabricBitstream raw_fabric_bits =
     build_memory_bank_flatten_fabric_bitstream(
       fabric_bitstream, fast_configuration, bit_value_to_skip, dont_care_bit);
   MemoryBankShiftRegisterFabricBitstream fabric_bits;
 
-  /* Iterate over each word */
-  for (const auto& wl_vec : raw_fabric_bits.wl_vectors()) {
-    std::vector<std::string> bl_vec = raw_fabric_bits.bl_vector(wl_vec);
-
-    MemoryBankShiftRegisterFabricBitstreamWordId word_id =
-      fabric_bits.create_word();
-
-    /* Redistribute the BL vector to multiple banks */
-    std::vector<std::string> multi_bank_bl_vec =
-      redistribute_bl_vectors_to_shift_register_banks(bl_vec, blwl_sr_banks,
-                                                      dont_care_bit);
-
-    std::vector<std::string> reshaped_bl_vectors =
-      reshape_bitstream_vectors_to_first_element(multi_bank_bl_vec,
-                                                 dont_care_bit);
-    /* Reverse the vectors due to the shift register chain nature: first-in
-     * first-out */
-    std::reverse(reshaped_bl_vectors.begin(), reshaped_bl_vectors.end());
-    /* Add the BL word to final bitstream */
-    for (const auto& reshaped_bl_vec : reshaped_bl_vectors) {
-      fabric_bits.add_bl_vectors(word_id, reshaped_bl_vec);
-    }
-
-    /* Redistribute the WL vector to multiple banks */
-    std::vector<std::string> multi_bank_wl_vec =
-      redistribute_wl_vectors_to_shift_register_banks(wl_vec, blwl_sr_banks,
-                                                      dont_care_bit);
-
-    std::vector<std::string> reshaped_wl_vectors =
-      reshape_bitstream_vectors_to_first_element(multi_bank_wl_vec,
-                                                 dont_care_bit);
-    /* Reverse the vectors due to the shift register chain nature: first-in
-     * first-out */
-    std::reverse(reshaped_wl_vectors.begin(), reshaped_wl_vectors.end());
-    /* Add the BL word to final bitstream */
-    for (const auto& reshaped_wl_vec : reshaped_wl_vectors) {
-      fabric_bits.add_wl_vectors(word_id, reshaped_wl_vec);
-    }
+  size_t num_bl_banks = 0;
+  size_t max_bl_bank_size = 0;
+  ShiftRegisterBankPositions bl_positions =
+    find_bl_shift_register_bank_positions(blwl_sr_banks, num_bl_banks,
+                                          max_bl_bank_size);
+  size_t num_wl_banks = 0;
+  size_t max_wl_bank_size = 0;
+  ShiftRegisterBankPositions wl_positions =
+    find_wl_shift_register_bank_positions(blwl_sr_banks, num_wl_banks,
+                                          max_wl_bank_size);
+
+  /* Create all the words first, so that each thread fills its own words */
+  std::vector<MemoryBankFlattenFabricBitstream::blwl_iterator> raw_words;
+  raw_words.reserve(raw_fabric_bits.size());
+  for (auto it = raw_fabric_bits.begin(); it != raw_fabric_bits.end(); ++it) {
+    raw_words.push_back(it);
   }
+  fabric_bits.reserve_words(raw_words.size());
+  std::vector<MemoryBankShiftRegisterFabricBitstreamWordId> word_ids;
+  word_ids.reserve(raw_words.size());
+  for (size_t iword = 0; iword < raw_words.size(); ++iword) {
+    word_ids.push_back(fabric_bits.create_word());
+  }
+
+  parallel_for(raw_words.size(), num_threads, [&](const size_t& iword) {
+    const std::vector<std::string>& wl_vec = raw_words[iword]->first;
+    const std::vector<std::string>& bl_vec = raw_words[iword]->second;
+
+    fabric_bits.set_bl_vectors(
+      word_ids[iword],
+      build_shift_register_bank_vectors(bl_vec, bl_positions, num_bl_banks,
+                                        max_bl_bank_size, dont_care_bit));
+    fabric_bits.set_wl_vectors(
+      word_ids[iword],
+      build_shift_register_bank_vectors(wl_vec, wl_positions, num_wl_banks,
+                                        max_wl_bank_size, dont_care_bit));
+  });
 
   return fabric_bits;
 }
 
+/********************************************************************
+ * The number of words is the same as the bitstream for flatten BL/WLs,
+ * while the widths and word sizes only depend on the shift register banks
+ *******************************************************************/
+void find_memory_bank_shift_register_fabric_bitstream_sizes(
+  const FabricBitstream& fabric_bitstream,
+  const MemoryBankShiftRegisterBanks& blwl_sr_banks, size_t& num_words,
+  size_t& bl_width, size_t& wl_width, size_t& bl_word_size,
+  size_t& wl_word_size) {
+  num_words = find_memory_bank_flatten_fabric_bitstream_size(fabric_bitstream);
+  find_bl_shift_register_bank_positions(blwl_sr_banks, bl_width, bl_word_size);
+  find_wl_shift_register_bank_positions(blwl_sr_banks, wl_width, wl_word_size);
+}
+
 /********************************************************************
  * For fast configuration, the number of bits to be skipped
  * the rule to skip any configuration bit should consider the whole data input
@@ -608,21 +803,21 @@ build_memory_bank_shift_register_fabric_bitstream(
  *******************************************************************/
 size_t find_memory_bank_fast_configuration_fabric_bitstream_size(
   const FabricBitstream& fabric_bitstream, const bool& bit_value_to_skip) {
-  MemoryBankFabricBitstream fabric_bits_by_addr =
-    build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
+  return find_memory_bank_fast_configuration_fabric_bitstream_size(
+    build_memory_bank_fabric_bitstream_by_address(fabric_bitstream),
+    bit_value_to_skip);
+}
 
+/* Same as above, but reuse a bitstream which is already organized by
+ * addresses, so that callers which need both sizes build it only once */
+size_t find_memory_bank_fast_configuration_fabric_bitstream_size(
+  const MemoryBankFabricBitstream& fabric_bits_by_addr,
+  const bool& bit_value_to_skip) {
   size_t num_bits = 0;
 
   for (const auto& addr_din_pair : fabric_bits_by_addr) {
-    bool skip_curr_bits = true;
-    for (const bool& bit : addr_din_pair.second) {
-      if (bit_value_to_skip != bit) {
-        skip_curr_bits = false;
-        break;
-      }
-    }
-
-    if (false == skip_curr_bits) {
+    if (false ==
+        is_fabric_din_all_of_value(addr_din_pair.second, bit_value_to_skip)) {
       num_bits++;
     }
   }
@@ -630,4 +825,42 @@ size_t find_memory_bank_fast_configuration_fabric_bitstream_size(
   return num_bits;
 }
 
+/********************************************************************
+ * Build the configuration regions of a fabric bitstream with a number of
+ * tasks, each of which adds its regions to the fabric bitstream given.
+ * When multiple threads are used, the tasks, which must be independent
+ * from each other, run concurrently on their own fabric bitstreams with
+ * the same address settings. These fabric bitstreams are then appended
+ * in the sequence of tasks, so that the resulting bit and region ids are
+ * the same as running the tasks in sequence.
+ *
+ * Note that the fabric bitstream should not contain any bit or region yet
+ *******************************************************************/
+void build_fabric_bitstream_regions(
+  FabricBitstream& fabric_bitstream, const size_t& num_tasks,
+  const size_t& num_threads,
+  const std::function<void(FabricBitstream&, const size_t&)>& build_task) {
+  VTR_ASSERT(0 == fabric_bitstream.num_bits());
+  VTR_ASSERT(0 == fabric_bitstream.num_regions());
+
+  if ((1 >= num_threads) || (1 >= num_tasks)) {
+    for (size_t itask = 0; itask < num_tasks; ++itask) {
+      build_task(fabric_bitstream, itask);
+    }
+    return;
+  }
+
+  /* Copying the empty fabric bitstream inherits its address settings */
+  std::vector<FabricBitstream> task_bitstreams(num_tasks, fabric_bitstream);
+  parallel_for_dynamic(num_tasks, num_threads, [&](const size_t& itask) {
+    build_task(task_bitstreams[itask], itask);
+  });
+
+  for (size_t itask = 0; itask < num_tasks; ++itask) {
+    fabric_bitstream.append(task_bitstreams[itask]);
+    /* Release the memory as early as possible */
+    task_bitstreams[itask] = FabricBitstream();
+  }
+}
+
 } /* end namespace openfpga */
@@ -8,10 +8,14 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <array>
+#include <functional>
 #include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "bitstream_manager.h"
+#include "config_chain_fabric_bitstream.h"
 #include "fabric_bitstream.h"
 #include "memory_bank_flatten_fabric_bitstream.h"
 #include "memory_bank_shift_register_banks.h"
@@ -31,22 +35,31 @@ size_t find_configuration_chain_fabric_bitstream_size_to_be_skipped(
   const FabricBitstream& fabric_bitstream,
   const BitstreamManager& bitstream_manager, const bool& bit_value_to_skip);
 
-/* Alias to a specific organization of bitstreams for frame-based configuration
- * protocol */
-typedef std::vector<std::vector<bool>> ConfigChainFabricBitstream;
 ConfigChainFabricBitstream build_config_chain_fabric_bitstream_by_region(
   const BitstreamManager& bitstream_manager,
   const FabricBitstream& fabric_bitstream);
 
 /* Alias to a specific organization of bitstreams for frame-based configuration
- * protocol */
-typedef std::map<std::string, std::vector<bool>> FrameFabricBitstream;
+ * protocol: (address, data inputs of regions) sorted by unique addresses */
+typedef std::vector<std::pair<std::string, std::vector<bool>>>
+  FrameFabricBitstream;
 FrameFabricBitstream build_frame_based_fabric_bitstream_by_address(
   const FabricBitstream& fabric_bitstream);
 
+bool is_fabric_din_all_of_value(const std::vector<bool>& din,
+                                const bool& bit_value);
+
 size_t find_frame_based_fast_configuration_fabric_bitstream_size(
   const FabricBitstream& fabric_bitstream, const bool& bit_value_to_skip);
 
+size_t find_frame_based_fast_configuration_fabric_bitstream_size(
+  const FrameFabricBitstream& fabric_bits_by_addr,
+  const bool& bit_value_to_skip);
+
+size_t find_frame_based_multicast_fabric_bitstream_size(
+  const FrameFabricBitstream& fabric_bits_by_addr,
+  const bool& fast_configuration, const bool& bit_value_to_skip);
+
 /********************************************************************
  * @ brief Reorganize the fabric bitstream for memory banks which use flatten BL
  *and WLs For each configuration region, we will merge BL address (which are
@@ -71,6 +84,17 @@ MemoryBankFlattenFabricBitstream build_memory_bank_flatten_fabric_bitstream(
   const FabricBitstream& fabric_bitstream, const bool& fast_configuration,
   const bool& bit_value_to_skip, const char& dont_care_bit = 'x');
 
+/* Find the size of the bitstream built by
+ * build_memory_bank_flatten_fabric_bitstream(), i.e., the largest number of WL
+ * addresses among the regions, without building the bitstream */
+size_t find_memory_bank_flatten_fabric_bitstream_size(
+  const FabricBitstream& fabric_bitstream);
+
+/* Find the number of WL addresses of each region, i.e., the number of words
+ * to program each region when the regions are programmed concurrently */
+std::vector<size_t> find_memory_bank_regional_flatten_fabric_bitstream_sizes(
+  const FabricBitstream& fabric_bitstream);
+
 /********************************************************************
  * @ brief Reorganize the fabric bitstream for memory banks which use shift
  *register to manipulate BL and WLs For each configuration region, we will merge
@@ -104,11 +128,23 @@ build_memory_bank_shift_register_fabric_bitstream(
   const FabricBitstream& fabric_bitstream,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks,
   const bool& fast_configuration, const bool& bit_value_to_skip,
-  const char& dont_care_bit = 'x');
+  const char& dont_care_bit = 'x', const size_t& num_threads = 1);
+
+/* Find the sizes of the bitstream built by
+ * build_memory_bank_shift_register_fabric_bitstream(), i.e., the number of
+ * words, the widths (number of shift register banks) and the word sizes
+ * (largest bank size) of BLs and WLs, without building the bitstream */
+void find_memory_bank_shift_register_fabric_bitstream_sizes(
+  const FabricBitstream& fabric_bitstream,
+  const MemoryBankShiftRegisterBanks& blwl_sr_banks, size_t& num_words,
+  size_t& bl_width, size_t& wl_width, size_t& bl_word_size,
+  size_t& wl_word_size);
 
 /* Alias to a specific organization of bitstreams for memory bank configuration
- * protocol */
-typedef std::map<std::pair<std::string, std::string>, std::vector<bool>>
+ * protocol: ((BL address, WL address), data inputs of regions) sorted by
+ * unique address pairs */
+typedef std::vector<
+  std::pair<std::pair<std::string, std::string>, std::vector<bool>>>
   MemoryBankFabricBitstream;
 MemoryBankFabricBitstream build_memory_bank_fabric_bitstream_by_address(
   const FabricBitstream& fabric_bitstream);
@@ -116,6 +152,15 @@ MemoryBankFabricBitstream build_memory_bank_fabric_bitstream_by_address(
 size_t find_memory_bank_fast_configuration_fabric_bitstream_size(
   const FabricBitstream& fabric_bitstream, const bool& bit_value_to_skip);
 
+size_t find_memory_bank_fast_configuration_fabric_bitstream_size(
+  const MemoryBankFabricBitstream& fabric_bits_by_addr,
+  const bool& bit_value_to_skip);
+
+void build_fabric_bitstream_regions(
+  FabricBitstream& fabric_bitstream, const size_t& num_tasks,
+  const size_t& num_threads,
+  const std::function<void(FabricBitstream&, const size_t&)>& build_task);
+
 } /* end namespace openfpga */
 
 #endif
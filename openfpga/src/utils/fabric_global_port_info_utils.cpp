@@ -21,6 +21,10 @@ namespace openfpga {
  *******************************************************************/
 std::vector<FabricGlobalPortId> find_fabric_global_programming_reset_ports(
   const FabricGlobalPortInfo& fabric_global_port_info) {
+  if (true == fabric_global_port_info.fast_lookup_built()) {
+    return fabric_global_port_info.programming_reset_ports();
+  }
+
   /* Try to find global reset ports for programming */
   std::vector<FabricGlobalPortId> global_prog_reset_ports;
   for (const FabricGlobalPortId& global_port :
@@ -46,6 +50,10 @@ std::vector<FabricGlobalPortId> find_fabric_global_programming_reset_ports(
  *******************************************************************/
 std::vector<FabricGlobalPortId> find_fabric_global_programming_set_ports(
   const FabricGlobalPortInfo& fabric_global_port_info) {
+  if (true == fabric_global_port_info.fast_lookup_built()) {
+    return fabric_global_port_info.programming_set_ports();
+  }
+
   /* Try to find global set ports for programming */
   std::vector<FabricGlobalPortId> global_prog_set_ports;
   for (const FabricGlobalPortId& global_port :
@@ -73,6 +81,20 @@ std::vector<FabricGlobalPortId> find_fabric_global_programming_set_ports(
 bool port_is_fabric_global_reset_port(
   const FabricGlobalPortInfo& fabric_global_port_info,
   const ModuleManager& module_manager, const BasicPort& port) {
+  if (true == fabric_global_port_info.fast_lookup_built()) {
+    for (const FabricGlobalPortId& fabric_global_port_id :
+         fabric_global_port_info.operating_reset_ports()) {
+      const BasicPort& module_global_port =
+        fabric_global_port_info.global_port_top_module_port(
+          fabric_global_port_id);
+      if ((true == module_global_port.mergeable(port)) &&
+          (true == module_global_port.contained(port))) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   /* Find the top_module: the fabric global ports are always part of the ports
    * of the top module */
   ModuleId top_module =
@@ -106,6 +128,19 @@ bool port_is_fabric_global_reset_port(
 FabricGlobalPortId find_fabric_global_port(
   const FabricGlobalPortInfo& fabric_global_port_info,
   const ModuleManager& module_manager, const BasicPort& port) {
+  /* Only the global ports of the same name can contain the port */
+  if (true == fabric_global_port_info.fast_lookup_built()) {
+    for (const FabricGlobalPortId& fabric_global_port_id :
+         fabric_global_port_info.find_global_ports_by_name(port.get_name())) {
+      if (true == fabric_global_port_info
+                    .global_port_top_module_port(fabric_global_port_id)
+                    .contained(port)) {
+        return fabric_global_port_id;
+      }
+    }
+    return FabricGlobalPortId::INVALID();
+  }
+
   /* Find the top_module: the fabric global ports are always part of the ports
    * of the top module */
   ModuleId top_module =
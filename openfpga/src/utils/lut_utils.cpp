@@ -3,6 +3,7 @@
  * especially their truth tables, in the OpenFPGA context
  *******************************************************************/
 #include <cmath>
+#include <cstdint>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -374,6 +375,62 @@ static void rec_build_lut_bitstream_per_line(
   }
 }
 
+/********************************************************************
+ * The bitstream of a LUT with up to 6 inputs fits in a 64-bit word,
+ * where bit <j> is the sram bit selected by the input combination <j>.
+ * The mask of input <i> marks the input combinations whose bit <i> is set
+ *******************************************************************/
+constexpr size_t MAX_PACKED_LUT_SIZE = 6;
+constexpr uint64_t PACKED_LUT_INPUT_MASKS[MAX_PACKED_LUT_SIZE] = {
+  0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+  0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL};
+
+/********************************************************************
+ * Apply a truth table line to the bitstream of a LUT packed in a word
+ * The sram bits covered by the line are found by masking the word input by
+ * input, so that don't cares are expanded without any recursion.
+ * The sram bits follow the same convention as
+ * rec_build_lut_bitstream_per_line(): an input at logic '0' selects the
+ * sram bits whose bit of the input is set
+ * The line may be shorter than the LUT, where missing inputs are don't cares
+ *******************************************************************/
+static void build_packed_lut_bitstream_per_line(
+  uint64_t& lut_word, const uint64_t& lut_mask,
+  const std::vector<vtr::LogicValue>& tt_line) {
+  VTR_ASSERT(0 < tt_line.size());
+  VTR_ASSERT(tt_line.size() - 1 <= MAX_PACKED_LUT_SIZE);
+
+  uint64_t cover = lut_mask;
+  for (size_t i = 0; i < tt_line.size() - 1; ++i) {
+    switch (tt_line[i]) {
+      case vtr::LogicValue::FALSE:
+        cover &= PACKED_LUT_INPUT_MASKS[i];
+        break;
+      case vtr::LogicValue::TRUE:
+        cover &= ~PACKED_LUT_INPUT_MASKS[i];
+        break;
+      case vtr::LogicValue::DONT_CARE:
+        break;
+      default:
+        VTR_LOGF_ERROR(__FILE__, __LINE__,
+                       "Invalid truth_table bit '%s', should be [0|1|]!\n",
+                       vtr::LOGIC_VALUE_STRING[size_t(tt_line[i])]);
+        exit(1);
+    }
+  }
+
+  if (vtr::LogicValue::TRUE == tt_line.back()) {
+    lut_word |= cover; /* on set*/
+  } else if (vtr::LogicValue::FALSE == tt_line.back()) {
+    lut_word &= ~cover; /* off set */
+  } else {
+    VTR_LOGF_ERROR(__FILE__, __LINE__,
+                   "Invalid truth_table_line ending '%s'!\n",
+                   vtr::LOGIC_VALUE_STRING[size_t(tt_line.back())]);
+    exit(1);
+  }
+}
+
 /********************************************************************
  * Generate the bitstream for a single-output LUT with a given truth table
  * As truth tables may come from different logic blocks, truth tables could be
@@ -412,6 +469,24 @@ static std::vector<bool> build_single_output_lut_bitstream(
     off_set = !on_set;
   }
 
+  /* A LUT with up to 6 inputs is decoded in a word, where the base of an
+   * off set is all '1' */
+  if ((lut_size <= MAX_PACKED_LUT_SIZE) &&
+      (bitstream_size == (size_t(1) << lut_size))) {
+    uint64_t lut_mask = (MAX_PACKED_LUT_SIZE == lut_size)
+                          ? ~uint64_t(0)
+                          : ((uint64_t(1) << bitstream_size) - 1);
+    uint64_t lut_word = off_set ? lut_mask : 0;
+    for (const std::vector<vtr::LogicValue>& tt_line : truth_table) {
+      VTR_ASSERT(tt_line.size() - 1 <= lut_size);
+      build_packed_lut_bitstream_per_line(lut_word, lut_mask, tt_line);
+    }
+    for (size_t bit = 0; bit < bitstream_size; ++bit) {
+      lut_bitstream[bit] = (1 == ((lut_word >> bit) & 1));
+    }
+    return lut_bitstream;
+  }
+
   /* Read in truth table lines, decode one by one */
   for (const std::vector<vtr::LogicValue>& tt_line : truth_table) {
     /* Complete the truth table line by line*/
@@ -5,6 +5,8 @@
 /* Headers from vtrutil library */
 #include "memory_utils.h"
 
+#include <algorithm>
+
 #include "decoder_library_utils.h"
 #include "openfpga_naming.h"
 #include "vtr_assert.h"
@@ -490,4 +492,27 @@ size_t estimate_num_configurable_children_to_skip_by_config_protocol(
   return num_child_to_skip;
 }
 
+/********************************************************************
+ * Find the memory tiles which compose a memory module, i.e., the
+ * configurable children which are memory modules themselves rather than
+ * memory cells. Each tile is returned once, in the order of the chain.
+ * A memory module which is built flat has no tiles.
+ *******************************************************************/
+std::vector<ModuleId> find_memory_tile_modules(
+  const ModuleManager& module_manager, const ModuleId& mem_module) {
+  std::vector<ModuleId> tile_modules;
+  for (const ModuleId& child :
+       module_manager.configurable_children(mem_module)) {
+    if (module_manager.configurable_children(child).empty()) {
+      continue;
+    }
+    if (tile_modules.end() !=
+        std::find(tile_modules.begin(), tile_modules.end(), child)) {
+      continue;
+    }
+    tile_modules.push_back(child);
+  }
+  return tile_modules;
+}
+
 } /* end namespace openfpga */
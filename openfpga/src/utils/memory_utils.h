@@ -53,6 +53,9 @@ size_t generate_pb_sram_port_size(const e_config_protocol_type sram_orgz_type,
 size_t estimate_num_configurable_children_to_skip_by_config_protocol(
   const ConfigProtocol& config_protocol, size_t curr_region_num_config_child);
 
+std::vector<ModuleId> find_memory_tile_modules(
+  const ModuleManager& module_manager, const ModuleId& mem_module);
+
 } /* end namespace openfpga */
 
 #endif
@@ -587,6 +587,34 @@ void add_pb_type_ports_to_module_manager(ModuleManager& module_manager,
   }
 }
 
+/********************************************************************
+ * Identify if two modules have the same list of ports, i.e., the ports
+ * have the same names, widths and types in the same sequence.
+ * Such two modules can be used in place of each other in their parents
+ *******************************************************************/
+bool modules_have_same_ports(const ModuleManager& module_manager,
+                             const ModuleId& module_a,
+                             const ModuleId& module_b) {
+  if (module_manager.module_ports(module_a).size() !=
+      module_manager.module_ports(module_b).size()) {
+    return false;
+  }
+
+  for (const ModulePortId& port : module_manager.module_ports(module_a)) {
+    BasicPort port_a = module_manager.module_port(module_a, port);
+    BasicPort port_b = module_manager.module_port(module_b, port);
+    if ((port_a.get_name() != port_b.get_name()) ||
+        (port_a.get_lsb() != port_b.get_lsb()) ||
+        (port_a.get_msb() != port_b.get_msb()) ||
+        (module_manager.port_type(module_a, port) !=
+         module_manager.port_type(module_b, port))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 /********************************************************************
  * Identify if a net is a local wire inside a module:
  * A net is a local wire if it connects between two instances,
@@ -599,18 +627,18 @@ bool module_net_is_local_wire(const ModuleManager& module_manager,
   /* Check all the sink modules of the net,
    * if we have a source module is the current module, this is not local wire
    */
-  for (ModuleId src_module :
-       module_manager.net_source_modules(module_id, module_net)) {
-    if (module_id == src_module) {
+  for (const ModuleManager::NetTerminal& src :
+       module_manager.net_source_terminals(module_id, module_net)) {
+    if (module_id == src.module) {
       /* Here, this is not a local wire */
       return false;
     }
   }
 
   /* Check all the sink modules of the net */
-  for (ModuleId sink_module :
-       module_manager.net_sink_modules(module_id, module_net)) {
-    if (module_id == sink_module) {
+  for (const ModuleManager::NetTerminal& sink :
+       module_manager.net_sink_terminals(module_id, module_net)) {
+    if (module_id == sink.module) {
       /* Here, this is not a local wire */
       return false;
     }
@@ -639,9 +667,9 @@ bool module_net_include_output_short_connection(
   const ModuleNetId& module_net) {
   /* Check all the sink modules of the net */
   size_t contain_num_module_output = 0;
-  for (ModuleId sink_module :
-       module_manager.net_sink_modules(module_id, module_net)) {
-    if (module_id == sink_module) {
+  for (const ModuleManager::NetTerminal& sink :
+       module_manager.net_sink_terminals(module_id, module_net)) {
+    if (module_id == sink.module) {
       contain_num_module_output++;
     }
   }
@@ -672,9 +700,9 @@ bool module_net_include_local_short_connection(
    * if we have a source module is the current module, this is not local wire
    */
   bool contain_module_input = false;
-  for (ModuleId src_module :
-       module_manager.net_source_modules(module_id, module_net)) {
-    if (module_id == src_module) {
+  for (const ModuleManager::NetTerminal& src :
+       module_manager.net_source_terminals(module_id, module_net)) {
+    if (module_id == src.module) {
       contain_module_input = true;
       break;
     }
@@ -682,9 +710,9 @@ bool module_net_include_local_short_connection(
 
   /* Check all the sink modules of the net */
   bool contain_module_output = false;
-  for (ModuleId sink_module :
-       module_manager.net_sink_modules(module_id, module_net)) {
-    if (module_id == sink_module) {
+  for (const ModuleManager::NetTerminal& sink :
+       module_manager.net_sink_terminals(module_id, module_net)) {
+    if (module_id == sink.module) {
       contain_module_output = true;
       break;
     }
@@ -2472,17 +2500,10 @@ void add_module_bus_nets(
   }
 
   /* Create a net for each pin */
-  for (size_t pin_id = 0; pin_id < src_port.pins().size(); ++pin_id) {
-    ModuleNetId net = create_module_source_pin_net(
-      module_manager, cur_module_id, src_module_id, src_instance_id,
-      src_module_port_id, src_port.pins()[pin_id]);
-    VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-    /* Configure the net sink */
-    module_manager.add_module_net_sink(cur_module_id, net, des_module_id,
-                                       des_instance_id, des_module_port_id,
-                                       des_port.pins()[pin_id]);
-  }
+  module_manager.add_module_nets_between_ports(
+    cur_module_id, src_module_id, src_instance_id, src_module_port_id, 0,
+    des_module_id, des_instance_id, des_module_port_id, 0,
+    src_port.get_width());
 }
 
 /********************************************************************
@@ -81,6 +81,10 @@ void add_pb_type_ports_to_module_manager(ModuleManager& module_manager,
                                          const ModuleId& module_id,
                                          t_pb_type* cur_pb_type);
 
+bool modules_have_same_ports(const ModuleManager& module_manager,
+                             const ModuleId& module_a,
+                             const ModuleId& module_b);
+
 bool module_net_is_local_wire(const ModuleManager& module_manager,
                               const ModuleId& module_id,
                               const ModuleNetId& module_net);
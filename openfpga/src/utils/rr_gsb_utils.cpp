@@ -2,6 +2,8 @@
  * This file includes most utilized functions for data structure
  * DeviceRRGSB
  *******************************************************************/
+#include <algorithm>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -281,6 +283,148 @@ bool is_sb_mirror(const RRGraphView& rr_graph,
   return true;
 }
 
+/** @brief Find the side maps of the rotations and reflections of a switch
+ * block, i.e., the 8 symmetries of a square, where the identity comes first.
+ * The sides are numbered clockwise, so that a rotation by k quarters maps
+ * side s to side (s + k) % 4 while a reflection maps side s to (k - s) % 4
+ */
+std::vector<t_rr_gsb_side_map> get_rr_gsb_rotation_reflection_side_maps() {
+  std::vector<t_rr_gsb_side_map> side_maps;
+  for (size_t reflect = 0; reflect < 2; ++reflect) {
+    for (size_t quarter = 0; quarter < NUM_SIDES; ++quarter) {
+      t_rr_gsb_side_map side_map;
+      for (size_t side = 0; side < NUM_SIDES; ++side) {
+        size_t mapped_side = (0 == reflect)
+                               ? (side + quarter) % NUM_SIDES
+                               : (quarter + NUM_SIDES - side) % NUM_SIDES;
+        side_map[side] = SideManager(mapped_side).get_side();
+      }
+      side_maps.push_back(side_map);
+    }
+  }
+  return side_maps;
+}
+
+/** @brief Check if the drivers of a routing track of a switch block are the
+ * same as those of the track of another switch block, once the sides of the
+ * drivers are mapped. Unlike is_sb_node_mirror(), routing tracks may drive
+ * each other across CHANX and CHANY, since a rotation swaps them
+ */
+static bool is_sb_node_side_map_mirror(
+  const RRGraphView& rr_graph, const VprDeviceAnnotation& device_annotation,
+  const RRGSB& base, const RRGSB& cand, const t_rr_gsb_side_map& side_map,
+  const e_side& node_side, const size_t& track_id) {
+  e_side cand_node_side = side_map[size_t(node_side)];
+  bool is_short_conkt =
+    base.is_sb_node_passing_wire(rr_graph, node_side, track_id);
+  if (is_short_conkt !=
+      cand.is_sb_node_passing_wire(rr_graph, cand_node_side, track_id)) {
+    return false;
+  }
+  if (true == is_short_conkt) {
+    return true;
+  }
+
+  std::vector<RREdgeId> node_in_edges =
+    base.get_chan_node_in_edges(rr_graph, node_side, track_id);
+  std::vector<RREdgeId> cand_node_in_edges =
+    cand.get_chan_node_in_edges(rr_graph, cand_node_side, track_id);
+  if (node_in_edges.size() != cand_node_in_edges.size()) {
+    return false;
+  }
+
+  for (size_t iedge = 0; iedge < node_in_edges.size(); ++iedge) {
+    RREdgeId src_edge = node_in_edges[iedge];
+    RREdgeId src_cand_edge = cand_node_in_edges[iedge];
+    RRNodeId src_node = rr_graph.edge_src_node(src_edge);
+    RRNodeId src_cand_node = rr_graph.edge_src_node(src_cand_edge);
+    t_rr_type src_type = rr_graph.node_type(src_node);
+    t_rr_type src_cand_type = rr_graph.node_type(src_cand_node);
+    bool src_is_chan = (CHANX == src_type) || (CHANY == src_type);
+    bool src_cand_is_chan =
+      (CHANX == src_cand_type) || (CHANY == src_cand_type);
+    if ((src_is_chan != src_cand_is_chan) ||
+        ((false == src_is_chan) && (src_type != src_cand_type))) {
+      return false;
+    }
+    if (device_annotation.rr_switch_circuit_model(
+          rr_graph.edge_switch(src_edge)) !=
+        device_annotation.rr_switch_circuit_model(
+          rr_graph.edge_switch(src_cand_edge))) {
+      return false;
+    }
+    int src_node_id, des_node_id;
+    enum e_side src_node_side, des_node_side;
+    base.get_node_side_and_index(rr_graph, src_node, OUT_PORT, src_node_side,
+                                 src_node_id);
+    cand.get_node_side_and_index(rr_graph, src_cand_node, OUT_PORT,
+                                 des_node_side, des_node_id);
+    if (src_node_id != des_node_id) {
+      return false;
+    }
+    if (side_map[size_t(src_node_side)] != des_node_side) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/** @brief Identify if a switch block is the same as another one once its sides
+ * are mapped to the sides of the other one, e.g., rotated or reflected.
+ * Each side of the base switch block should have the same routing tracks and
+ * output pins as the mapped side of the candidate, where the routing tracks
+ * keep their indices, and each track should have the same drivers, where the
+ * sides of the drivers are mapped as well. When so, the candidate is an
+ * instance of the module of the base switch block, where the pins of each side
+ * are connected to the pins of the mapped side.
+ * With the identity map, this is a stricter version of is_sb_mirror(), which
+ * also checks the segments of all the routing tracks
+ */
+bool is_sb_side_map_mirror(const RRGraphView& rr_graph,
+                           const VprDeviceAnnotation& device_annotation,
+                           const RRGSB& base, const RRGSB& cand,
+                           const t_rr_gsb_side_map& side_map) {
+  if (base.get_num_sides() != cand.get_num_sides()) {
+    return false;
+  }
+
+  for (size_t side = 0; side < base.get_num_sides(); ++side) {
+    e_side base_side = SideManager(side).get_side();
+    e_side cand_side = side_map[side];
+    if (base.get_chan_width(base_side) != cand.get_chan_width(cand_side)) {
+      return false;
+    }
+    if (base.get_num_opin_nodes(base_side) !=
+        cand.get_num_opin_nodes(cand_side)) {
+      return false;
+    }
+    for (size_t itrack = 0; itrack < base.get_chan_width(base_side);
+         ++itrack) {
+      if (base.get_chan_node_direction(base_side, itrack) !=
+          cand.get_chan_node_direction(cand_side, itrack)) {
+        return false;
+      }
+      if (device_annotation.rr_segment_circuit_model(
+            base.get_chan_node_segment(base_side, itrack)) !=
+          device_annotation.rr_segment_circuit_model(
+            cand.get_chan_node_segment(cand_side, itrack))) {
+        return false;
+      }
+      if (OUT_PORT != base.get_chan_node_direction(base_side, itrack)) {
+        continue;
+      }
+      if (false == is_sb_node_side_map_mirror(rr_graph, device_annotation,
+                                              base, cand, side_map, base_side,
+                                              itrack)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 /** @brief Check if two ipin_nodes have a similar set of drive_rr_nodes for each
  * drive_rr_node:
  * 1. CHANX or CHANY: should have the same side and index
@@ -386,4 +530,176 @@ bool is_cb_mirror(const RRGraphView& rr_graph,
   return true;
 }
 
+/** @brief Mix a value into a running hash (boost::hash_combine recipe) */
+static void hash_combine_value(size_t& seed, const size_t& value) {
+  seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+/** @brief Mix the driver topology of a list of input edges into a hash.
+ * Only the properties which are compared by is_sb_node_mirror() and
+ * is_cb_node_mirror() are considered: source node type, switch circuit model
+ * and the side/index of the source node inside the GSB
+ */
+static void hash_combine_in_edges(size_t& seed, const RRGraphView& rr_graph,
+                                  const VprDeviceAnnotation& device_annotation,
+                                  const RRGSB& rr_gsb,
+                                  const std::vector<RREdgeId>& in_edges,
+                                  const e_side& chan_side,
+                                  const bool& chan_src_by_index) {
+  hash_combine_value(seed, in_edges.size());
+  for (const RREdgeId& edge : in_edges) {
+    RRNodeId src_node = rr_graph.edge_src_node(edge);
+    hash_combine_value(seed, size_t(rr_graph.node_type(src_node)));
+    hash_combine_value(seed, size_t(device_annotation.rr_switch_circuit_model(
+                               rr_graph.edge_switch(edge))));
+    int src_node_id = -1;
+    enum e_side src_node_side = NUM_SIDES;
+    if (chan_src_by_index && ((CHANX == rr_graph.node_type(src_node)) ||
+                              (CHANY == rr_graph.node_type(src_node)))) {
+      src_node_id = rr_gsb.get_chan_node_index(chan_side, src_node);
+    } else {
+      rr_gsb.get_node_side_and_index(rr_graph, src_node, OUT_PORT,
+                                     src_node_side, src_node_id);
+    }
+    hash_combine_value(seed, size_t(src_node_side));
+    hash_combine_value(seed, size_t(src_node_id));
+  }
+}
+
+/** @brief Compute a hash of a switch block which does not change when the
+ * sides of the switch block are rotated or reflected. The hash is consistent
+ * with is_sb_side_map_mirror(): each side is hashed on its own, without the
+ * sides of the drivers, and the hashes of the sides are sorted.
+ */
+size_t compute_sb_side_map_invariant_hash(
+  const RRGraphView& rr_graph, const VprDeviceAnnotation& device_annotation,
+  const RRGSB& rr_gsb) {
+  std::vector<size_t> side_seeds;
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    e_side side_enum = SideManager(side).get_side();
+    size_t side_seed = 0;
+    hash_combine_value(side_seed, rr_gsb.get_chan_width(side_enum));
+    hash_combine_value(side_seed, rr_gsb.get_num_opin_nodes(side_enum));
+    for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_enum);
+         ++itrack) {
+      hash_combine_value(
+        side_seed, size_t(rr_gsb.get_chan_node_direction(side_enum, itrack)));
+      hash_combine_value(
+        side_seed, size_t(device_annotation.rr_segment_circuit_model(
+                     rr_gsb.get_chan_node_segment(side_enum, itrack))));
+      if (OUT_PORT != rr_gsb.get_chan_node_direction(side_enum, itrack)) {
+        continue;
+      }
+      bool is_short_conkt =
+        rr_gsb.is_sb_node_passing_wire(rr_graph, side_enum, itrack);
+      hash_combine_value(side_seed, size_t(is_short_conkt));
+      if (true == is_short_conkt) {
+        continue;
+      }
+      std::vector<RREdgeId> in_edges =
+        rr_gsb.get_chan_node_in_edges(rr_graph, side_enum, itrack);
+      hash_combine_value(side_seed, in_edges.size());
+      for (const RREdgeId& edge : in_edges) {
+        hash_combine_value(side_seed,
+                           size_t(device_annotation.rr_switch_circuit_model(
+                             rr_graph.edge_switch(edge))));
+      }
+    }
+    side_seeds.push_back(side_seed);
+  }
+  std::sort(side_seeds.begin(), side_seeds.end());
+
+  size_t seed = 0;
+  hash_combine_value(seed, rr_gsb.get_num_sides());
+  for (const size_t& side_seed : side_seeds) {
+    hash_combine_value(seed, side_seed);
+  }
+  return seed;
+}
+
+/** @brief Compute a structural hash for each side of the Switch Block part of
+ * a GSB. The hashes are consistent with is_sb_mirror() where the GSB is the
+ * base: when the GSB is a mirror of another one, each side has the same hash
+ * as the side of the other GSB, so that the full mirror check is only
+ * required between GSBs whose sides share hash values.
+ * is_sb_mirror() does not compare the sides where the base GSB has no routing
+ * segments. The hash of such a side is 0, which matches any side, while the
+ * other sides never hash to 0.
+ */
+std::vector<size_t> compute_sb_side_structural_hashes(
+  const RRGraphView& rr_graph, const VprDeviceAnnotation& device_annotation,
+  const RRGSB& rr_gsb) {
+  std::vector<size_t> side_hashes(rr_gsb.get_num_sides(), 0);
+
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    e_side side_enum = side_manager.get_side();
+    /* Sides without any segment are not checked by is_sb_side_mirror() */
+    if (rr_gsb.get_chan_segment_ids(side_enum).empty()) {
+      continue;
+    }
+    size_t seed = 0;
+    hash_combine_value(seed, rr_gsb.get_chan_width(side_enum));
+    for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_enum);
+         ++itrack) {
+      hash_combine_value(
+        seed, size_t(rr_gsb.get_chan_node_direction(side_enum, itrack)));
+      if (OUT_PORT != rr_gsb.get_chan_node_direction(side_enum, itrack)) {
+        continue;
+      }
+      bool is_short_conkt =
+        rr_gsb.is_sb_node_passing_wire(rr_graph, side_enum, itrack);
+      hash_combine_value(seed, size_t(is_short_conkt));
+      if (true == is_short_conkt) {
+        continue;
+      }
+      hash_combine_in_edges(
+        seed, rr_graph, device_annotation, rr_gsb,
+        rr_gsb.get_chan_node_in_edges(rr_graph, side_enum, itrack), side_enum,
+        false);
+    }
+    hash_combine_value(seed, rr_gsb.get_num_opin_nodes(side_enum));
+    side_hashes[side] = (0 == seed) ? 1 : seed;
+  }
+
+  return side_hashes;
+}
+
+/** @brief Compute a structural hash for a Connection Block part of a GSB.
+ * The hash is consistent with is_cb_mirror(): two GSBs whose connection
+ * blocks are mirrors always have the same hash.
+ */
+size_t compute_cb_structural_hash(const RRGraphView& rr_graph,
+                                  const VprDeviceAnnotation& device_annotation,
+                                  const RRGSB& rr_gsb,
+                                  const t_rr_type& cb_type) {
+  size_t seed = 0;
+  hash_combine_value(seed, rr_gsb.get_cb_chan_width(cb_type));
+
+  enum e_side chan_side = rr_gsb.get_cb_chan_side(cb_type);
+  const RRChan& chan = rr_gsb.chan(chan_side);
+  hash_combine_value(seed, size_t(chan.get_type()));
+  hash_combine_value(seed, chan.get_chan_width());
+  for (size_t inode = 0; inode < chan.get_chan_width(); ++inode) {
+    hash_combine_value(seed, size_t(rr_graph.node_type(chan.get_node(inode))));
+    hash_combine_value(seed,
+                       size_t(rr_graph.node_direction(chan.get_node(inode))));
+    hash_combine_value(seed, size_t(device_annotation.rr_segment_circuit_model(
+                               chan.get_node_segment(inode))));
+  }
+
+  for (const e_side& ipin_side : rr_gsb.get_cb_ipin_sides(cb_type)) {
+    hash_combine_value(seed, rr_gsb.get_num_ipin_nodes(ipin_side));
+    for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(ipin_side);
+         ++inode) {
+      hash_combine_in_edges(
+        seed, rr_graph, device_annotation, rr_gsb,
+        rr_gsb.get_ipin_node_in_edges(rr_graph, ipin_side, inode), chan_side,
+        true);
+    }
+  }
+
+  return seed;
+}
+
 } /* end namespace openfpga */
@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <array>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,10 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* A map from the sides of a GSB to the sides of another GSB, indexed by
+ * side, e.g., the rotations and reflections of a switch block */
+typedef std::array<e_side, NUM_SIDES> t_rr_gsb_side_map;
+
 bool connection_block_contain_only_routing_tracks(const RRGSB& rr_gsb,
                                                   const t_rr_type& cb_type);
 
@@ -34,6 +39,26 @@ bool is_cb_mirror(const RRGraphView& rr_graph,
                   const RRGSB& base, const RRGSB& cand,
                   const t_rr_type& cb_type);
 
+std::vector<t_rr_gsb_side_map> get_rr_gsb_rotation_reflection_side_maps();
+
+bool is_sb_side_map_mirror(const RRGraphView& rr_graph,
+                           const VprDeviceAnnotation& device_annotation,
+                           const RRGSB& base, const RRGSB& cand,
+                           const t_rr_gsb_side_map& side_map);
+
+size_t compute_sb_side_map_invariant_hash(
+  const RRGraphView& rr_graph, const VprDeviceAnnotation& device_annotation,
+  const RRGSB& rr_gsb);
+
+std::vector<size_t> compute_sb_side_structural_hashes(
+  const RRGraphView& rr_graph, const VprDeviceAnnotation& device_annotation,
+  const RRGSB& rr_gsb);
+
+size_t compute_cb_structural_hash(const RRGraphView& rr_graph,
+                                  const VprDeviceAnnotation& device_annotation,
+                                  const RRGSB& rr_gsb,
+                                  const t_rr_type& cb_type);
+
 } /* end namespace openfpga */
 
 #endif
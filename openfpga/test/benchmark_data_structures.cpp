@@ -0,0 +1,311 @@
+/********************************************************************
+ * Micro-benchmarks for the core data structures of OpenFPGA:
+ * 1. net creation and look-up in module manager
+ * 2. adding bits and blocks to bitstream manager
+ * 3. addressing bits in fabric bitstream
+ * 4. decoding memory bits of multiplexer graphs
+ * 5. parsing ports and tokenizing strings
+ * 6. finding circuit models by name in circuit library
+ *
+ * Usage: benchmark_data_structures <openfpga_arch.xml> [<scale>]
+ * The scale (1 by default) multiplies the sizes of all the benchmarks,
+ * so that the numbers can be held against a larger fabric
+ *******************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_port_parser.h"
+#include "openfpga_tokenizer.h"
+
+/* Headers from readarchopenfpga library */
+#include "read_xml_openfpga_arch.h"
+
+/* Headers from fpgabitstream library */
+#include "bitstream_manager.h"
+
+/* Headers from openfpga */
+#include "fabric_bitstream.h"
+#include "module_manager.h"
+#include "mux_graph.h"
+
+using namespace openfpga;
+
+/********************************************************************
+ * Report the run-time of a benchmark, in total and per operation.
+ * The checksum is reported as well, so that the compiler cannot
+ * optimize away the operations under benchmark
+ *******************************************************************/
+static void report_benchmark(
+  const std::string& name, const size_t& num_ops,
+  const std::chrono::steady_clock::time_point& start_time,
+  const size_t& checksum) {
+  auto end_time = std::chrono::steady_clock::now();
+  double elapsed_ns = std::chrono::duration<double, std::nano>(
+                        end_time - start_time)
+                        .count();
+  VTR_LOG("%-40s %12lu ops %12.3f ms %10.2f ns/op (checksum: %lu)\n",
+          name.c_str(), num_ops, elapsed_ns / 1e6,
+          elapsed_ns / std::max(num_ops, size_t(1)), checksum);
+}
+
+/********************************************************************
+ * Build a parent module with a number of child instances, which are
+ * chained by nets, as done for the switch blocks and connection blocks
+ * of a fabric. Then look up the nets from the pins of each instance
+ *******************************************************************/
+static void benchmark_module_manager(const size_t& num_instances) {
+  const size_t port_width = 16;
+
+  ModuleManager module_manager;
+  ModuleId child_module = module_manager.add_module("child");
+  ModulePortId in_port =
+    module_manager.add_port(child_module, BasicPort("in", port_width),
+                            ModuleManager::MODULE_INPUT_PORT);
+  ModulePortId out_port =
+    module_manager.add_port(child_module, BasicPort("out", port_width),
+                            ModuleManager::MODULE_OUTPUT_PORT);
+  ModuleId parent_module = module_manager.add_module("parent");
+
+  auto start_time = std::chrono::steady_clock::now();
+  for (size_t inst = 0; inst < num_instances; ++inst) {
+    module_manager.add_child_module(parent_module, child_module, false);
+  }
+  report_benchmark("ModuleManager::add_child_module", num_instances,
+                   start_time, module_manager.num_instance(parent_module,
+                                                           child_module));
+
+  size_t num_nets = (num_instances - 1) * port_width;
+  start_time = std::chrono::steady_clock::now();
+  module_manager.reserve_module_nets(parent_module, num_nets);
+  for (size_t inst = 0; inst < num_instances - 1; ++inst) {
+    for (size_t pin = 0; pin < port_width; ++pin) {
+      ModuleNetId net = module_manager.create_module_net(parent_module);
+      module_manager.add_module_net_source(parent_module, net, child_module,
+                                           inst, out_port, pin);
+      module_manager.add_module_net_sink(parent_module, net, child_module,
+                                         inst + 1, in_port, pin);
+    }
+  }
+  report_benchmark("ModuleManager::create_module_net", num_nets, start_time,
+                   module_manager.module_nets(parent_module).size());
+
+  size_t checksum = 0;
+  start_time = std::chrono::steady_clock::now();
+  for (size_t inst = 1; inst < num_instances; ++inst) {
+    for (size_t pin = 0; pin < port_width; ++pin) {
+      ModuleNetId net = module_manager.module_instance_port_net(
+        parent_module, child_module, inst, in_port, pin);
+      VTR_ASSERT(true ==
+                 module_manager.valid_module_net_id(parent_module, net));
+      checksum += size_t(net);
+    }
+  }
+  report_benchmark("ModuleManager::module_instance_port_net", num_nets,
+                   start_time, checksum);
+}
+
+/********************************************************************
+ * Build a bitstream of blocks, where each block contains a number of
+ * bits, either bit by bit or in one go
+ *******************************************************************/
+static void benchmark_bitstream_manager(const size_t& num_blocks) {
+  const size_t block_size = 64;
+  size_t num_bits = num_blocks * block_size;
+
+  BitstreamManager bit_by_bit_manager;
+  bit_by_bit_manager.reserve_blocks(num_blocks + 1);
+  bit_by_bit_manager.reserve_bits(num_bits);
+  ConfigBlockId top_block = bit_by_bit_manager.add_block("top");
+
+  auto start_time = std::chrono::steady_clock::now();
+  for (size_t iblk = 0; iblk < num_blocks; ++iblk) {
+    ConfigBlockId block =
+      bit_by_bit_manager.add_block("block_" + std::to_string(iblk));
+    bit_by_bit_manager.add_child_block(top_block, block);
+    for (size_t ibit = 0; ibit < block_size; ++ibit) {
+      bit_by_bit_manager.add_bit(block, 0 == (iblk + ibit) % 3);
+    }
+  }
+  report_benchmark("BitstreamManager::add_bit", num_bits, start_time,
+                   bit_by_bit_manager.num_bits());
+
+  std::vector<bool> block_bitstream(block_size);
+  for (size_t ibit = 0; ibit < block_size; ++ibit) {
+    block_bitstream[ibit] = (0 == ibit % 3);
+  }
+
+  BitstreamManager block_manager;
+  block_manager.reserve_blocks(num_blocks + 1);
+  block_manager.reserve_bits(num_bits);
+  top_block = block_manager.add_block("top");
+
+  start_time = std::chrono::steady_clock::now();
+  for (size_t iblk = 0; iblk < num_blocks; ++iblk) {
+    ConfigBlockId block =
+      block_manager.add_block("block_" + std::to_string(iblk));
+    block_manager.add_child_block(top_block, block);
+    block_manager.add_block_bits(block, block_bitstream);
+  }
+  report_benchmark("BitstreamManager::add_block_bits", num_bits, start_time,
+                   block_manager.num_bits());
+}
+
+/********************************************************************
+ * Assign an address to each bit of a fabric bitstream, as done for
+ * the memory banks and frame-based configuration protocols
+ *******************************************************************/
+static void benchmark_fabric_bitstream(const size_t& num_bits) {
+  size_t address_length = 1;
+  while ((size_t(1) << address_length) < num_bits) {
+    ++address_length;
+  }
+
+  FabricBitstream fabric_bitstream;
+  fabric_bitstream.set_use_address(true);
+  fabric_bitstream.set_address_length(address_length);
+  fabric_bitstream.reserve_bits(num_bits);
+  for (size_t ibit = 0; ibit < num_bits; ++ibit) {
+    fabric_bitstream.add_bit(ConfigBitId(ibit));
+  }
+
+  std::vector<char> address(address_length, '0');
+  auto start_time = std::chrono::steady_clock::now();
+  for (size_t ibit = 0; ibit < num_bits; ++ibit) {
+    for (size_t iaddr = 0; iaddr < address_length; ++iaddr) {
+      address[iaddr] = ((ibit >> iaddr) & 1) ? '1' : '0';
+    }
+    fabric_bitstream.set_bit_address(FabricBitId(ibit), address);
+  }
+  report_benchmark("FabricBitstream::set_bit_address", num_bits, start_time,
+                   fabric_bitstream.num_bits());
+}
+
+/********************************************************************
+ * Build the graphs of the multiplexers defined in the circuit library
+ * at typical sizes of routing multiplexers, and decode the memory bits
+ * to route each input to the output
+ *******************************************************************/
+static void benchmark_mux_graph(const CircuitLibrary& circuit_lib,
+                                const size_t& num_repeats) {
+  const std::vector<size_t> mux_sizes = {4, 8, 16, 32, 64};
+
+  std::vector<MuxGraph> mux_graphs;
+  auto start_time = std::chrono::steady_clock::now();
+  for (const CircuitModelId& mux_model :
+       circuit_lib.models_by_type(CIRCUIT_MODEL_MUX)) {
+    for (const size_t& mux_size : mux_sizes) {
+      mux_graphs.push_back(MuxGraph(circuit_lib, mux_model, mux_size));
+    }
+  }
+  report_benchmark("MuxGraph::MuxGraph", mux_graphs.size(), start_time,
+                   mux_graphs.size());
+
+  size_t num_ops = 0;
+  size_t checksum = 0;
+  start_time = std::chrono::steady_clock::now();
+  for (size_t irep = 0; irep < num_repeats; ++irep) {
+    for (const MuxGraph& mux_graph : mux_graphs) {
+      for (size_t input = 0; input < mux_graph.num_inputs(); ++input) {
+        vtr::vector<MuxMemId, bool> mem_bits =
+          mux_graph.decode_memory_bits(MuxInputId(input), MuxOutputId(0));
+        checksum += mem_bits.size();
+        ++num_ops;
+      }
+    }
+  }
+  report_benchmark("MuxGraph::decode_memory_bits", num_ops, start_time,
+                   checksum);
+}
+
+/********************************************************************
+ * Parse ports and split strings in the formats which are commonly
+ * seen in architecture files, fabric keys and pin constraints
+ *******************************************************************/
+static void benchmark_string_parsers(const size_t& num_strings) {
+  std::vector<std::string> port_names;
+  std::vector<std::string> tokens;
+  port_names.reserve(num_strings);
+  tokens.reserve(num_strings);
+  for (size_t istr = 0; istr < num_strings; ++istr) {
+    port_names.push_back("gfpga_pad_GPIO_PAD[" + std::to_string(istr) + ":" +
+                         std::to_string(istr + 7) + "]");
+    tokens.push_back("grid_clb_" + std::to_string(istr) + "_" +
+                     std::to_string(istr % 16) + "_" +
+                     std::to_string(istr % 32));
+  }
+
+  size_t checksum = 0;
+  auto start_time = std::chrono::steady_clock::now();
+  for (const std::string& port_name : port_names) {
+    PortParser port_parser(port_name);
+    checksum += port_parser.port().get_width();
+  }
+  report_benchmark("PortParser::PortParser", num_strings, start_time,
+                   checksum);
+
+  checksum = 0;
+  start_time = std::chrono::steady_clock::now();
+  for (const std::string& token : tokens) {
+    StringToken tokenizer(token);
+    checksum += tokenizer.split('_').size();
+  }
+  report_benchmark("StringToken::split", num_strings, start_time, checksum);
+}
+
+/********************************************************************
+ * Find each circuit model of the circuit library by its name, as done
+ * when linking the architecture and building the fabric
+ *******************************************************************/
+static void benchmark_circuit_library(const CircuitLibrary& circuit_lib,
+                                      const size_t& num_repeats) {
+  std::vector<std::string> model_names;
+  for (const CircuitModelId& model : circuit_lib.models()) {
+    model_names.push_back(circuit_lib.model_name(model));
+  }
+
+  size_t num_ops = 0;
+  size_t checksum = 0;
+  auto start_time = std::chrono::steady_clock::now();
+  for (size_t irep = 0; irep < num_repeats; ++irep) {
+    for (const std::string& model_name : model_names) {
+      CircuitModelId model = circuit_lib.model(model_name);
+      VTR_ASSERT(CircuitModelId::INVALID() != model);
+      checksum += size_t(model);
+      ++num_ops;
+    }
+  }
+  report_benchmark("CircuitLibrary::model", num_ops, start_time, checksum);
+}
+
+int main(int argc, const char** argv) {
+  /* Ensure we have only one or two arguments */
+  VTR_ASSERT((2 == argc) || (3 == argc));
+
+  size_t scale = 1;
+  if (3 == argc) {
+    scale = std::strtoul(argv[2], nullptr, 10);
+    VTR_ASSERT(0 < scale);
+  }
+
+  /* Parse the circuit library from an XML file */
+  const openfpga::Arch& openfpga_arch = read_xml_openfpga_arch(argv[1]);
+  VTR_LOG("Parsed %lu circuit models from XML into circuit library.\n",
+          openfpga_arch.circuit_lib.num_models());
+
+  benchmark_module_manager(10000 * scale);
+  benchmark_bitstream_manager(100000 * scale);
+  benchmark_fabric_bitstream(1000000 * scale);
+  benchmark_mux_graph(openfpga_arch.circuit_lib, 100 * scale);
+  benchmark_string_parsers(100000 * scale);
+  benchmark_circuit_library(openfpga_arch.circuit_lib, 100000 * scale);
+
+  return 0;
+}
@@ -0,0 +1,39 @@
+#!/bin/bash
+
+set -e
+source openfpga.sh
+PYTHON_EXEC=python3.8
+###############################################
+# OpenFPGA Shell with VPR8
+##############################################
+echo -e "Fast flow regression tests";
+
+echo -e "Testing restoring the fabric saved by another run";
+run-task fast_flow/save_load_context $@
+
+echo -e "Testing the commands sent to a shell server";
+run-task fast_flow/server $@
+
+echo -e "Testing the commands of a script running concurrently";
+run-task fast_flow/script_jobs $@
+
+echo -e "Testing the outputs restored from the command cache";
+run-task fast_flow/command_cache $@
+
+echo -e "Testing the binary OpenFPGA architecture";
+run-task fast_flow/binary_arch $@
+
+echo -e "Testing the binary architecture and fabric bitstreams";
+run-task fast_flow/binary_bitstream $@
+
+echo -e "Testing the bitstreams updated for a list of designs";
+run-task fast_flow/incremental_bitstream $@
+
+echo -e "Testing the bitstreams updated for designs whose nets are named differently";
+run-task fast_flow/incremental_bitstream_netlists $@
+
+echo -e "Testing the fabric restored from the fabric cache";
+run-task fast_flow/fabric_cache $@
+
+echo -e "Testing the arrays of nets backed by files";
+run-task fast_flow/out_of_core $@
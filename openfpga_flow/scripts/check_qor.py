@@ -19,6 +19,10 @@ import csv
 #####################################################################
 csv_name_tag = "name"
 csv_metric_tag = "metric"
+# Metrics of the runtime and memory of OpenFPGA commands, collected from
+# their profiles by the task runner, e.g., openfpga_build_fabric_wall_time
+perf_metric_prefix = "openfpga_"
+perf_metric_suffixes = ("_wall_time", "_peak_rss_kb")
 
 #####################################################################
 # Initialize logger
@@ -53,6 +57,21 @@ parser.add_argument(
     default="0.5,1.5",
     help="Specify the tolerance when checking metrics. Format <lower_bound>,<upper_bound>",
 )
+# Performance metrics only fail when they exceed the golden results
+parser.add_argument(
+    "--perf_check_tolerance",
+    default=None,
+    help="Specify the upper bound when checking the runtime and memory of OpenFPGA commands, "
+    + "e.g., 1.5 fails a command which runs 50% slower than the golden results. "
+    + "When not specified, they are checked by --check_tolerance",
+)
+# Short runtimes are dominated by noise, e.g., the load of a CI machine
+parser.add_argument(
+    "--perf_check_min_time",
+    default="1.0",
+    help="Specify the minimum wall time (in seconds) in golden results to be checked. "
+    + "Commands which are faster in golden results are not checked",
+)
 args = parser.parse_args()
 
 #####################################################################
@@ -106,6 +125,23 @@ for row in ref_csv_content:
 #####################################################################
 lower_bound_factor = float(args.check_tolerance.split(",")[0])
 upper_bound_factor = float(args.check_tolerance.split(",")[1])
+perf_min_time = float(args.perf_check_min_time)
+
+
+def is_perf_metric(metric):
+    return metric.startswith(perf_metric_prefix) and metric.endswith(perf_metric_suffixes)
+
+
+def find_metric_bounds(metric, ref_value):
+    """
+    Find the range [lower, upper] of a metric, or None if it is not checked
+    """
+    if not is_perf_metric(metric) or args.perf_check_tolerance is None:
+        return (lower_bound_factor * ref_value, upper_bound_factor * ref_value)
+    if metric.endswith("_wall_time") and ref_value < perf_min_time:
+        return None
+    return (0.0, float(args.perf_check_tolerance) * ref_value)
+
 
 #####################################################################
 # Parse the csv file to check
@@ -117,13 +153,33 @@ with open(args.check_csv_file, newline="") as check_csv_file:
     for row in results_to_check:
         # Start from line 1 and check information
         for metric_to_check in metric_checklist:
+            ref_value = ref_results[row[csv_name_tag]].get(metric_to_check)
+            # Golden results of performance may be added later than the checklist
+            if is_perf_metric(metric_to_check) and not ref_value:
+                logging.warning(
+                    "Benchmark "
+                    + str(row[csv_name_tag])
+                    + " has no golden result of '"
+                    + str(metric_to_check)
+                    + "', skip checking"
+                )
+                continue
+            if row.get(metric_to_check) in (None, ""):
+                logging.error(
+                    "Benchmark "
+                    + str(row[csv_name_tag])
+                    + " has no result of '"
+                    + str(metric_to_check)
+                    + "'"
+                )
+                check_error_count += 1
+                continue
+            bounds = find_metric_bounds(metric_to_check, float(ref_value))
+            if bounds is None:
+                continue
             # Check if the metric is in a range
-            if (
-                lower_bound_factor * float(ref_results[row[csv_name_tag]][metric_to_check])
-                > float(row[metric_to_check])
-            ) or (
-                upper_bound_factor * float(ref_results[row[csv_name_tag]][metric_to_check])
-                < float(row[metric_to_check])
+            if (bounds[0] > float(row[metric_to_check])) or (
+                bounds[1] < float(row[metric_to_check])
             ):
                 # Check QoR failed, error out
                 logging.error(
@@ -135,12 +191,12 @@ with open(args.check_csv_file, newline="") as check_csv_file:
                     + "Found: "
                     + str(row[metric_to_check])
                     + " but expected: "
-                    + str(ref_results[row[csv_name_tag]][metric_to_check])
+                    + str(ref_value)
                     + " outside range ["
-                    + str(lower_bound_factor * 100)
-                    + "%, "
-                    + str(upper_bound_factor * 100)
-                    + "%]"
+                    + str(bounds[0])
+                    + ", "
+                    + str(bounds[1])
+                    + "]"
                 )
                 check_error_count += 1
             # Pass this metric check, increase counter
@@ -0,0 +1,149 @@
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+# Script Name   : run_determinism_check.py
+# Description   : This script runs an OpenFPGA task with a single thread and
+#                 with multiple threads, and checks that every generated
+#                 artifact, e.g., Verilog, SPICE, SDC, bitstreams and fabric
+#                 keys, is identical between the runs
+# Args          : python3 run_determinism_check.py --help
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+import os
+import sys
+import re
+import argparse
+import subprocess
+import logging
+
+if sys.version_info[0] < 3:
+    raise Exception("run_determinism_check script must be using Python 3")
+
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+# Initialise general paths for the script
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+flow_script_dir = os.path.dirname(os.path.abspath(__file__))
+openfpga_base_dir = os.path.abspath(os.path.join(flow_script_dir, os.pardir, os.pardir))
+repo_task_dir = os.path.join(openfpga_base_dir, "openfpga_flow", "tasks")
+
+# Extensions of the artifacts generated by OpenFPGA, which are compared
+artifact_extensions = [".v", ".vh", ".sv", ".sp", ".spice", ".sdc", ".bit", ".bin", ".xml", ".txt"]
+
+# Lines which change from one run to another, e.g., the dates in the
+# headers of files, are not compared
+volatile_line_pattern = re.compile(r"Date\s*:")
+
+LOG_FORMAT = "%(levelname)5s (%(threadName)15s) - %(message)s"
+logging.basicConfig(level=logging.INFO, stream=sys.stdout, format=LOG_FORMAT)
+logger = logging.getLogger("OpenFPGA_Determinism_Logs")
+
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+# Reading command-line argument
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+parser = argparse.ArgumentParser()
+parser.add_argument("task", type=str, help="Task to run, as accepted by run_fpga_task.py")
+parser.add_argument(
+    "--num_threads",
+    type=int,
+    default=os.cpu_count(),
+    help="Number of threads of the multi-threaded run, by default all the available threads",
+)
+parser.add_argument(
+    "--extensions",
+    type=str,
+    nargs="+",
+    default=artifact_extensions,
+    help="Extensions of the files to compare",
+)
+parser.add_argument("--debug", action="store_true", help="Run script in debug mode")
+args = parser.parse_args()
+
+
+def find_task_dir(task):
+    """
+    Find the directory of a task, in the same way as run_fpga_task.py
+    """
+    task_path = task.replace("\\", "/").split("/")
+    local_task = os.path.join(*task_path)
+    abs_task = os.path.abspath("/" + local_task)
+    for task_dir in [local_task, abs_task, os.path.join(repo_task_dir, *task_path)]:
+        if os.path.isdir(task_dir):
+            return os.path.abspath(task_dir)
+    logger.error("Task directory of '%s' not found" % task)
+    sys.exit(1)
+
+
+def run_task(task_dir, num_threads):
+    """
+    Run the task where the commands of OpenFPGA use the given number of
+    threads by default, and return the run directory
+    """
+    env = os.environ.copy()
+    env["OPENFPGA_NUM_THREADS"] = str(num_threads)
+    logger.info("Running task '%s' with %d thread(s)" % (task_dir, num_threads))
+    command = [sys.executable, os.path.join(flow_script_dir, "run_fpga_task.py"), task_dir]
+    if args.debug:
+        command += ["--debug"]
+    process = subprocess.run(command, env=env)
+    if 0 != process.returncode:
+        logger.error("Task failed with %d thread(s)" % num_threads)
+        sys.exit(1)
+    return os.path.realpath(os.path.join(task_dir, "latest"))
+
+
+def find_artifacts(run_dir):
+    """
+    Find the artifacts generated in a run directory, as paths relative to it
+    """
+    artifacts = []
+    for root, _, files in os.walk(run_dir):
+        for fname in files:
+            if os.path.splitext(fname)[1] in args.extensions:
+                artifacts.append(os.path.relpath(os.path.join(root, fname), run_dir))
+    return sorted(artifacts)
+
+
+def read_artifact(run_dir, artifact):
+    """
+    Read an artifact, where the volatile lines are removed and the path of
+    the run directory is replaced, as it differs between runs
+    """
+    with open(os.path.join(run_dir, artifact), "rb") as fp:
+        content = fp.read()
+    try:
+        text = content.decode("utf-8")
+    except UnicodeDecodeError:
+        return content
+    text = text.replace(run_dir, "<run_dir>")
+    lines = [line for line in text.splitlines() if not volatile_line_pattern.search(line)]
+    return "\n".join(lines)
+
+
+def main():
+    task_dir = find_task_dir(args.task)
+    serial_run_dir = run_task(task_dir, 1)
+    parallel_run_dir = run_task(task_dir, args.num_threads)
+
+    serial_artifacts = find_artifacts(serial_run_dir)
+    parallel_artifacts = find_artifacts(parallel_run_dir)
+    num_mismatches = 0
+    for artifact in sorted(set(serial_artifacts) ^ set(parallel_artifacts)):
+        logger.error("Artifact '%s' is only generated by one of the runs" % artifact)
+        num_mismatches += 1
+    for artifact in sorted(set(serial_artifacts) & set(parallel_artifacts)):
+        if read_artifact(serial_run_dir, artifact) != read_artifact(parallel_run_dir, artifact):
+            logger.error(
+                "Artifact '%s' differs between 1 and %d threads" % (artifact, args.num_threads)
+            )
+            num_mismatches += 1
+
+    logger.info(
+        "Compared %d artifacts of '%s' and '%s'"
+        % (len(serial_artifacts), serial_run_dir, parallel_run_dir)
+    )
+    if 0 != num_mismatches:
+        logger.error("Found %d nondeterministic artifacts" % num_mismatches)
+        sys.exit(1)
+    logger.info("All the artifacts are identical")
+
+
+if __name__ == "__main__":
+    main()
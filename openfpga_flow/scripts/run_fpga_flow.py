@@ -11,6 +11,8 @@ import os
 import sys
 import shutil
 import time
+import filecmp
+import socket
 import traceback
 from datetime import timedelta
 import shlex
@@ -95,6 +97,37 @@ parser.add_argument(
     default=os.path.join("openfpga_flow", "openfpga_shell_scripts", "example_script.openfpga"),
     help="Sample openfpga shell script",
 )
+parser.add_argument(
+    "--openfpga_shell_options",
+    type=str,
+    default="",
+    help="Extra options to launch openfpga shell, e.g., '--script_jobs 4'",
+)
+parser.add_argument(
+    "--openfpga_rerun_shell_template",
+    type=str,
+    default=None,
+    help="Openfpga shell script to run in a fresh shell after the first one",
+)
+parser.add_argument(
+    "--openfpga_rerun_shell_options",
+    type=str,
+    default="",
+    help="Extra options to launch openfpga shell for the rerun",
+)
+parser.add_argument(
+    "--openfpga_rerun_mode",
+    type=str,
+    default="shell",
+    choices=["shell", "server"],
+    help="Run the rerun script in script mode, or send its commands to a shell server",
+)
+parser.add_argument(
+    "--openfpga_compare_outputs",
+    type=str,
+    default="",
+    help="Files or directories written by both runs, which should be identical",
+)
 parser.add_argument("--openfpga_arch_file", type=str, help="Openfpga architecture file for shell")
 parser.add_argument(
     "--arch_variable_file", type=str, default=None, help="Openfpga architecture file for shell"
@@ -548,6 +581,16 @@ def prepare_run_directory(run_dir):
         else:
             shutil.copy(args.openfpga_shell_template, args.top_module + "_template.openfpga")
 
+    if args.openfpga_rerun_shell_template:
+        if not os.path.isfile(args.openfpga_rerun_shell_template):
+            clean_up_and_exit(
+                "Provided openfpga_rerun_shell_template"
+                + f" {args.openfpga_rerun_shell_template} file not found"
+            )
+        shutil.copy(
+            args.openfpga_rerun_shell_template, args.top_module + "_rerun_template.openfpga"
+        )
+
     # Create benchmark dir in run_dir and copy flattern architecture file
     os.mkdir("benchmark")
     try:
@@ -872,10 +915,8 @@ def collect_files_for_vpr():
     shutil.copy(args.base_verilog, args.top_module + "_output_verilog.v")
 
 
-def run_openfpga_shell():
-    ExecTime["VPRStart"] = time.time()
-    # bench_blif, fixed_chan_width, logfile, route_only=False
-    tmpl = Template(open(args.top_module + "_template.openfpga", encoding="utf-8").read())
+def write_openfpga_shell_script(template_file, script_file):
+    tmpl = Template(open(template_file, encoding="utf-8").read())
 
     path_variables = script_env_vars["PATH"]
     path_variables["TOP_MODULE"] = args.top_module
@@ -889,12 +930,170 @@ def run_openfpga_shell():
         tmpVar = OpenFPGAArgs[indx][2:].upper()
         path_variables[tmpVar] = OpenFPGAArgs[indx + 1]
 
-    with open(args.top_module + "_run.openfpga", "w", encoding="utf-8") as archfile:
+    with open(script_file, "w", encoding="utf-8") as archfile:
         archfile.write(tmpl.safe_substitute(path_variables))
-    command = [cad_tools["openfpga_shell_path"], "-batch", "-f", args.top_module + "_run.openfpga"]
+
+
+def run_openfpga_shell():
+    ExecTime["VPRStart"] = time.time()
+    # bench_blif, fixed_chan_width, logfile, route_only=False
+    write_openfpga_shell_script(
+        args.top_module + "_template.openfpga", args.top_module + "_run.openfpga"
+    )
+    # Always profile the commands, so that the runtime and memory of OpenFPGA
+    # can be checked against golden results in the same way as QoR
+    command = [
+        cad_tools["openfpga_shell_path"],
+        "-batch",
+        "-f",
+        args.top_module + "_run.openfpga",
+        "--profile",
+        "openfpga_profile.json",
+    ] + shlex.split(args.openfpga_shell_options)
     run_command("OpenFPGA Shell Run", "openfpgashell.log", command)
     ExecTime["VPREnd"] = time.time()
     extract_vpr_stats("openfpgashell.log")
+    extract_openfpga_profile("openfpga_profile.json")
+    if args.openfpga_rerun_shell_template:
+        run_openfpga_shell_rerun()
+
+
+def run_openfpga_shell_rerun():
+    """
+    Run another script in the same directory after the first one, in a fresh
+    shell or through a shell server, e.g., to restore the data saved by the
+    first run, or to check that a shell option does not change the outputs.
+    The outputs to compare are moved aside before the rerun, with a suffix
+    '_ref', and should be identical to the outputs of the rerun
+    """
+    outputs = shlex.split(args.openfpga_compare_outputs)
+    for eachoutput in outputs:
+        if not os.path.exists(eachoutput):
+            clean_up_and_exit("Output %s is not written by the first run" % eachoutput)
+        shutil.move(eachoutput, eachoutput + "_ref")
+
+    script_file = args.top_module + "_rerun.openfpga"
+    write_openfpga_shell_script(args.top_module + "_rerun_template.openfpga", script_file)
+    options = shlex.split(args.openfpga_rerun_shell_options)
+    if args.openfpga_rerun_mode == "server":
+        run_openfpga_server("openfpgashell_rerun.log", script_file, options)
+    else:
+        command = [cad_tools["openfpga_shell_path"], "-batch", "-f", script_file] + options
+        run_command("OpenFPGA Shell Rerun", "openfpgashell_rerun.log", command)
+
+    for eachoutput in outputs:
+        if not os.path.exists(eachoutput):
+            clean_up_and_exit("Output %s is not written by the rerun" % eachoutput)
+        mismatches = compare_outputs(eachoutput + "_ref", eachoutput)
+        for eachfile in mismatches:
+            logger.error("Output %s differs from the first run" % eachfile)
+        if mismatches:
+            clean_up_and_exit("Rerun changed the outputs in %s" % eachoutput)
+    if outputs:
+        logger.info("Rerun outputs are identical to the first run: %s" % " ".join(outputs))
+
+
+def compare_outputs(ref_path, path):
+    """
+    Compare the contents of two files or directories, and return the paths
+    which are missing in either of them or have different contents
+    """
+    if os.path.isfile(ref_path) or os.path.isfile(path):
+        if os.path.isfile(ref_path) and os.path.isfile(path):
+            if filecmp.cmp(ref_path, path, shallow=False):
+                return []
+        return [path]
+    dircmp = filecmp.dircmp(ref_path, path)
+    mismatches = [os.path.join(path, name) for name in dircmp.left_only + dircmp.right_only]
+    for name in dircmp.common_files + dircmp.common_dirs + dircmp.common_funny:
+        mismatches += compare_outputs(os.path.join(ref_path, name), os.path.join(path, name))
+    return mismatches
+
+
+def run_openfpga_server(logfile, script_file, options):
+    """
+    Launch openfpga shell as a server, send the command lines of a script
+    from a client in a batch, and check the exit code of each command.
+    The server is stopped by an 'exit' line, which is appended when the
+    script does not end with it
+    """
+    logger.info("Launching OpenFPGA Shell Server")
+    socket_file = os.path.abspath("openfpga_server.sock")
+    command = [cad_tools["openfpga_shell_path"], "--server", socket_file] + options
+    with open(script_file, encoding="utf-8") as fp:
+        lines = [line.strip() for line in fp]
+    lines = [line for line in lines if line and not line.startswith("#")]
+    if not lines or lines[-1] != "exit":
+        lines.append("exit")
+
+    with open(logfile, "w") as output:
+        output.write(" ".join(command) + "\n")
+        output.flush()
+        server = subprocess.Popen(command, stdout=output, stderr=subprocess.STDOUT)
+        client = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        failures = []
+        transcript = []
+        try:
+            for _ in range(600):
+                if server.poll() is not None:
+                    clean_up_and_exit("OpenFPGA Shell Server quits before accepting clients")
+                try:
+                    client.connect(socket_file)
+                    break
+                except (FileNotFoundError, ConnectionRefusedError):
+                    time.sleep(0.1)
+            else:
+                server.kill()
+                clean_up_and_exit("Failed to connect to OpenFPGA Shell Server")
+            client.sendall(("\n".join(lines) + "\n").encode())
+            # The socket is only closed once the responses are closed
+            with client.makefile("rb") as responses:
+                for line in lines:
+                    header = responses.readline().decode().split()
+                    status, wall_time, cpu_time, num_bytes = header
+                    transcript.append("> %s\n" % line)
+                    transcript.append(responses.read(int(num_bytes)).decode(errors="replace"))
+                    transcript.append("(exit code %s, %s s)\n" % (status, wall_time))
+                    if int(status):
+                        failures.append(line)
+        finally:
+            client.close()
+        returncode = server.wait()
+        # The responses follow the log of the server
+        output.write("".join(transcript))
+
+    for eachline in failures:
+        logger.error("OpenFPGA Shell Server failed to run '%s'" % eachline)
+    if failures or returncode:
+        clean_up_and_exit("Failed to run OpenFPGA Shell Server task")
+    logger.info("OpenFPGA Shell Server is written in file %s" % logfile)
+
+
+def extract_openfpga_profile(profile_file, r_filename="openfpga_profile"):
+    """
+    Extract the wall time and the peak memory of each OpenFPGA command
+    from the profile written by the shell.
+    A command which is run several times reports the sum of its wall times
+    and the maximum of its peak memory
+    """
+    if not os.path.isfile(profile_file):
+        logger.warning("No OpenFPGA profile found in file %s" % profile_file)
+        return
+    with open(profile_file, encoding="utf-8") as fp:
+        profile = json.load(fp)
+    resultDict = {}
+    for command in profile["commands"]:
+        time_key = "openfpga_%s_wall_time" % command["name"]
+        rss_key = "openfpga_%s_peak_rss_kb" % command["name"]
+        resultDict[time_key] = resultDict.get(time_key, 0.0) + command["wall_time"]
+        resultDict[rss_key] = max(resultDict.get(rss_key, 0), command["peak_rss_kb"])
+
+    dummyparser = ConfigParser()
+    dummyparser.read_dict({"RESULTS": resultDict})
+
+    with open(r_filename + ".result", "w") as configfile:
+        dummyparser.write(configfile)
+    logger.info("OpenFPGA profile extracted in file %s" % (r_filename + ".result"))
 
 
 def extract_vpr_stats(logfile, r_filename="vpr_stat", parse_section="vpr"):
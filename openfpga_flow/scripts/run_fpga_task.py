@@ -478,7 +478,11 @@ def create_run_command(curr_job_dir, archfile, benchmark_obj, param, task_conf):
 
     if task_gc.get("run_engine") == "openfpga_shell":
         for eachKey in task_OFPGAc.keys():
-            command += [f"--{eachKey}", task_OFPGAc.get(f"{eachKey}")]
+            if eachKey.endswith("_shell_options"):
+                # Shell options start with dashes, so they are joined with the key
+                command += [f"--{eachKey}={task_OFPGAc.get(eachKey)}"]
+            else:
+                command += [f"--{eachKey}", task_OFPGAc.get(f"{eachKey}")]
 
     if benchmark_obj.get("activity_file"):
         command += ["--activity_file", benchmark_obj.get("activity_file")]
@@ -598,7 +602,8 @@ def run_actions(job_list):
 
 def collect_results(job_run_list):
     """
-    Collect performance numbers from vpr_stat.result file
+    Collect performance numbers from vpr_stat.result file, and the runtime
+    and memory of OpenFPGA commands from openfpga_profile.result file
     """
     task_result = []
     for run in job_run_list:
@@ -618,6 +623,11 @@ def collect_results(job_run_list):
         result["name"] = run["name"]
         result["TotalRunTime"] = int(run["endtime"] - run["starttime"])
         result.update(vpr_res["RESULTS"])
+        profile_result_file = os.path.join(run["run_dir"], "openfpga_profile.result")
+        if os.path.isfile(profile_result_file):
+            profile_res = ConfigParser(allow_no_value=True, interpolation=ExtendedInterpolation())
+            profile_res.read_file(open(profile_result_file, encoding="UTF-8"))
+            result.update(profile_res["RESULTS"])
         task_result.append(result)
 
     colnames = []
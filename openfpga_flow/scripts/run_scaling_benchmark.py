@@ -0,0 +1,228 @@
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+# Script Name   : run_scaling_benchmark.py
+# Description   : This script sweeps synthetic tileable architectures over
+#                 array sizes, runs the standard OpenFPGA shell flow on each
+#                 of them and records the runtime and memory of every shell
+#                 command to a CSV file
+# Args          : python3 run_scaling_benchmark.py --help
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+import os
+import sys
+import csv
+import json
+import argparse
+import subprocess
+import time
+import xml.etree.ElementTree as ET
+from string import Template
+
+if sys.version_info[0] < 3:
+    raise Exception("run_scaling_benchmark script must be using Python 3")
+
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+# Initialise general paths for the script
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+flow_script_dir = os.path.dirname(os.path.abspath(__file__))
+openfpga_base_dir = os.path.abspath(os.path.join(flow_script_dir, os.pardir, os.pardir))
+openfpga_flow_dir = os.path.join(openfpga_base_dir, "openfpga_flow")
+
+# Architectures which can be swept, as pairs of VPR and OpenFPGA
+# architecture files. The VPR architectures must be tileable and use an
+# auto layout, which is turned into a fixed layout for each size
+scaling_archs = {
+    "k4_N4": (
+        os.path.join(openfpga_flow_dir, "vpr_arch", "k4_N4_tileable_40nm.xml"),
+        os.path.join(openfpga_flow_dir, "openfpga_arch", "k4_N4_40nm_cc_openfpga.xml"),
+    ),
+    "k6_N10": (
+        os.path.join(openfpga_flow_dir, "vpr_arch", "k6_N10_tileable_40nm.xml"),
+        os.path.join(openfpga_flow_dir, "openfpga_arch", "k6_N10_40nm_openfpga.xml"),
+    ),
+}
+
+csv_fields = [
+    "arch",
+    "width",
+    "height",
+    "command",
+    "command_line",
+    "status",
+    "wall_time",
+    "cpu_time",
+    "peak_rss_delta_kb",
+    "process_peak_rss_kb",
+]
+
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+# Reading command-line argument
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+parser = argparse.ArgumentParser()
+parser.add_argument(
+    "--openfpga",
+    type=str,
+    default=os.path.join(openfpga_base_dir, "build", "openfpga", "openfpga"),
+    help="Path to the OpenFPGA executable",
+)
+parser.add_argument(
+    "--arch",
+    type=str,
+    nargs="+",
+    default=list(scaling_archs.keys()),
+    choices=list(scaling_archs.keys()),
+    help="Architectures to sweep",
+)
+parser.add_argument(
+    "--sizes",
+    type=int,
+    nargs="+",
+    default=[8, 16, 32, 64, 128],
+    help="Sizes of the arrays of logic blocks to sweep, e.g., 8 for 8x8",
+)
+parser.add_argument(
+    "--chan_width", type=int, default=100, help="Routing channel width of all the fabrics"
+)
+parser.add_argument(
+    "--benchmark",
+    type=str,
+    default=os.path.join(openfpga_flow_dir, "benchmarks", "micro_benchmark", "and2", "and2"),
+    help="BLIF netlist and activity file of the design to implement, without extension",
+)
+parser.add_argument(
+    "--shell_script",
+    type=str,
+    default=os.path.join(
+        openfpga_flow_dir, "openfpga_shell_scripts", "scaling_benchmark_script.openfpga"
+    ),
+    help="Template of the OpenFPGA shell script to run on each fabric",
+)
+parser.add_argument(
+    "--run_dir", type=str, default="scaling_benchmark", help="Directory to run the flows"
+)
+parser.add_argument(
+    "--csv", type=str, default="scaling_benchmark.csv", help="CSV file to record the profiles"
+)
+parser.add_argument(
+    "--timeout", type=int, default=24 * 60 * 60, help="Timeout of each flow run in seconds"
+)
+args = parser.parse_args()
+
+
+def write_fixed_layout_arch(vpr_arch_file, layout_name, size, out_file):
+    """
+    Write a copy of a VPR architecture, where a fixed layout is added
+    with the same structure as the auto layout. The fixed layout includes
+    a ring of I/Os around an array of logic blocks of the given size
+    """
+    tree = ET.parse(vpr_arch_file)
+    layout = tree.getroot().find("layout")
+    auto_layout = layout.find("auto_layout")
+    if auto_layout is None:
+        raise Exception("No auto layout found in architecture '%s'" % vpr_arch_file)
+    fixed_layout = ET.SubElement(
+        layout,
+        "fixed_layout",
+        {"name": layout_name, "width": str(size + 2), "height": str(size + 2)},
+    )
+    for child in auto_layout:
+        fixed_layout.append(child)
+    tree.write(out_file)
+
+
+def run_openfpga_flow(arch_name, size):
+    """
+    Run the OpenFPGA shell flow on a fabric of the given size, and
+    return the profiles of the commands and the peak memory of the run
+    """
+    vpr_arch_file, openfpga_arch_file = scaling_archs[arch_name]
+    layout_name = "%dx%d" % (size, size)
+    run_dir = os.path.abspath(os.path.join(args.run_dir, arch_name, layout_name))
+    os.makedirs(run_dir, exist_ok=True)
+
+    fixed_vpr_arch_file = os.path.join(run_dir, os.path.basename(vpr_arch_file))
+    write_fixed_layout_arch(vpr_arch_file, layout_name, size, fixed_vpr_arch_file)
+
+    profile_file = os.path.join(run_dir, "cmd_profile.json")
+    path_variables = {
+        "VPR_ARCH_FILE": fixed_vpr_arch_file,
+        "VPR_TESTBENCH_BLIF": args.benchmark + ".blif",
+        "ACTIVITY_FILE": args.benchmark + ".act",
+        "OPENFPGA_ARCH_FILE": openfpga_arch_file,
+        "OPENFPGA_SIM_SETTING_FILE": os.path.join(
+            openfpga_flow_dir, "openfpga_simulation_settings", "auto_sim_openfpga.xml"
+        ),
+        "OPENFPGA_VPR_DEVICE_LAYOUT": layout_name,
+        "OPENFPGA_VPR_ROUTE_CHAN_WIDTH": str(args.chan_width),
+        "OPENFPGA_PROFILE_FILE": profile_file,
+    }
+    with open(args.shell_script, encoding="utf-8") as tmpl_file:
+        tmpl = Template(tmpl_file.read())
+    shell_script = os.path.join(run_dir, "scaling_benchmark_run.openfpga")
+    with open(shell_script, "w", encoding="utf-8") as script_file:
+        script_file.write(tmpl.safe_substitute(path_variables))
+
+    print("Running %s on a %s fabric in '%s'" % (arch_name, layout_name, run_dir))
+    start_time = time.time()
+    with open(os.path.join(run_dir, "openfpgashell.log"), "w") as log_file:
+        process = subprocess.Popen(
+            [os.path.abspath(args.openfpga), "-batch", "-f", shell_script],
+            cwd=run_dir,
+            stdout=log_file,
+            stderr=subprocess.STDOUT,
+        )
+        # Wait for the process by ourselves, so that the resource usage is
+        # the one of this run only, rather than all the children
+        while True:
+            pid, exit_status, rusage = os.wait4(process.pid, os.WNOHANG)
+            if 0 != pid:
+                break
+            if time.time() - start_time > args.timeout:
+                process.kill()
+            time.sleep(1)
+
+    if os.WIFEXITED(exit_status):
+        exit_code = os.WEXITSTATUS(exit_status)
+    else:
+        exit_code = -os.WTERMSIG(exit_status)
+    if 0 != exit_code:
+        print("Flow failed with exit code %d, see '%s'" % (exit_code, run_dir))
+    profiles = []
+    if os.path.isfile(profile_file):
+        with open(profile_file, encoding="utf-8") as json_file:
+            profiles = json.load(json_file)["commands"]
+    # ru_maxrss is in KiB on Linux
+    return profiles, rusage.ru_maxrss
+
+
+def main():
+    num_failures = 0
+    with open(args.csv, "w", newline="") as csv_file:
+        writer = csv.DictWriter(csv_file, fieldnames=csv_fields)
+        writer.writeheader()
+        for arch_name in args.arch:
+            for size in args.sizes:
+                profiles, peak_rss = run_openfpga_flow(arch_name, size)
+                if not profiles:
+                    num_failures += 1
+                for profile in profiles:
+                    writer.writerow(
+                        {
+                            "arch": arch_name,
+                            "width": size,
+                            "height": size,
+                            "command": profile["name"],
+                            "command_line": profile["command_line"],
+                            "status": profile["status"],
+                            "wall_time": profile["wall_time"],
+                            "cpu_time": profile["cpu_time"],
+                            "peak_rss_delta_kb": profile["peak_rss_delta_kb"],
+                            "process_peak_rss_kb": peak_rss,
+                        }
+                    )
+                csv_file.flush()
+    print("Wrote the profiles to '%s'" % args.csv)
+    sys.exit(1 if num_failures else 0)
+
+
+if __name__ == "__main__":
+    main()